@@ -15,9 +15,11 @@
 
 import argparse
 import json
+import math
 import os
 import pathlib
 import re
+import statistics
 import subprocess
 import sys
 import tempfile
@@ -27,6 +29,10 @@ from collections import defaultdict
 
 _OUTPUT_NUM_COLS = 100
 
+# Minimum number of samples on each side for the significance test. With
+# fewer, only the threshold is applied.
+_MIN_SAMPLES = 5
+
 
 # Cosmetic helper functions.
 # GitHub Actions does not provide a tty but can still display colors
@@ -73,6 +79,60 @@ def fmt_runtime(time_ns):
         return "{:.2f}ms".format(time_usec / 1000)
 
 
+def samples_path(json_path):
+    """Path of the per-repetition samples written next to a result file."""
+    path = pathlib.Path(json_path)
+    return path.with_name(path.stem + ".samples.jsonl")
+
+
+def perf_path(json_path):
+    """Path of the hardware counters written next to a result file."""
+    path = pathlib.Path(json_path)
+    return path.with_name(path.stem + ".perf.jsonl")
+
+
+def read_jsonl(path):
+    if not path.exists():
+        return []
+    with open(path) as f:
+        return [json.loads(line) for line in f if line.strip()]
+
+
+def mann_whitney_p_value(xs, ys):
+    """
+    Two-sided p-value of the Mann-Whitney U test that 'xs' and 'ys' come from
+    the same distribution. Uses the normal approximation with tie and
+    continuity corrections, which is adequate from about 5 samples per side.
+    Unlike a t-test it does not assume normally distributed run times, which
+    are usually skewed by outliers.
+    """
+    n1 = len(xs)
+    n2 = len(ys)
+    combined = sorted([(x, 0) for x in xs] + [(y, 1) for y in ys])
+    n = n1 + n2
+
+    # Ranks start at 1. Equal values get the average of their ranks.
+    rank_sum = 0.0
+    tie_term = 0
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        rank = (i + j) / 2 + 1
+        rank_sum += rank * sum(1 for k in range(i, j + 1) if combined[k][1] == 0)
+        ties = j - i + 1
+        tie_term += ties**3 - ties
+        i = j + 1
+
+    u = rank_sum - n1 * (n1 + 1) / 2
+    variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = max(abs(u - n1 * n2 / 2) - 0.5, 0) / math.sqrt(variance)
+    return math.erfc(z / math.sqrt(2))
+
+
 def get_retry_name(args, file_name):
     """
     Extract the subdir name between the base path and file name, and use that
@@ -99,8 +159,19 @@ def compare_file(args, target_data, baseline_data):
                 output_map[(row[0], row[1])][retry] = row[2]
         return output_map
 
+    def preprocess_samples(input_map):
+        output_map = defaultdict(dict)
+        for file_name in input_map:
+            retry = get_retry_name(args, file_name)
+            for sample in read_jsonl(samples_path(file_name)):
+                handle = (sample["file"], sample["name"])
+                output_map[handle][retry] = sample["times_ns"]
+        return output_map
+
     baseline_map = preprocess_data(baseline_data)
     target_map = preprocess_data(target_data)
+    baseline_samples = preprocess_samples(baseline_data)
+    target_samples = preprocess_samples(target_data)
 
     passes = []
     faster = []
@@ -128,6 +199,15 @@ def compare_file(args, target_data, baseline_data):
             else:
                 delta = (1 - (baseline_result / target_result)) * -1
 
+            # With enough repetitions on both sides, a delta over the threshold
+            # only counts if it is also statistically significant.
+            p_value = None
+            baseline_times = baseline_samples[handle].get(retry, [])
+            target_times = target_samples[handle].get(retry, [])
+            if min(len(baseline_times), len(target_times)) >= _MIN_SAMPLES:
+                p_value = mann_whitney_p_value(baseline_times, target_times)
+            significant = p_value is None or p_value < args.significance
+
             # Set status message based on the delta and number of retries.
             if not is_last:
                 if delta > 0:
@@ -136,6 +216,9 @@ def compare_file(args, target_data, baseline_data):
                     status = color_yellow("✗ Redo")
 
             # If there are no more retries and this exceeded the threshold.
+            elif abs(delta) > args.threshold and not significant:
+                status = color_yellow("~ Noise")
+                passes.append((handle[0], handle[1], delta))
             elif abs(delta) > args.threshold:
                 if delta > 0:
                     status = color_green("🗲 Pass")
@@ -151,6 +234,8 @@ def compare_file(args, target_data, baseline_data):
             suffix = "({} vs {}) {:+.2f}%".format(
                 fmt_runtime(baseline_result), fmt_runtime(target_result), delta * 100
             )
+            if p_value is not None:
+                suffix += " p={:.3f}".format(p_value)
             bm_handle = get_benchmark_handle(*handle)
 
             # Add retry information.
@@ -166,6 +251,35 @@ def compare_file(args, target_data, baseline_data):
     return passes, faster, failures
 
 
+def compare_perf(target_files, baseline_files):
+    """
+    Prints the change of the median of each hardware counter of a binary. This
+    is informational and does not fail the comparison, since the counters
+    cover the whole binary and not single benchmarks.
+    """
+
+    def medians(files):
+        values = defaultdict(list)
+        for file_name in files:
+            for repetition in read_jsonl(perf_path(file_name)):
+                for event, value in repetition["counters"].items():
+                    if value is not None:
+                        values[event].append(value)
+        return {event: statistics.median(v) for event, v in values.items()}
+
+    baseline = medians(baseline_files)
+    target = medians(target_files)
+    for event in sorted(set(baseline) & set(target)):
+        if baseline[event] == 0:
+            continue
+        change = target[event] / baseline[event] - 1
+        print(
+            "    {}: {:.4g} vs {:.4g} {:+.2f}%".format(
+                event, baseline[event], target[event], change * 100
+            )
+        )
+
+
 def find_json_files(path: pathlib.Path, recursive=False):
     """Finds json files in a given directory. Supports recursive searchs."""
     pattern = "*.json"
@@ -221,6 +335,7 @@ def compare(args):
         baseline_data = read_json_files(baseline_map[file_name])
 
         passes, faster, failures = compare_file(args, target_data, baseline_data)
+        compare_perf(contender_path, baseline_map[file_name])
         all_passes += passes
         all_faster += faster
         all_failures += failures
@@ -285,21 +400,121 @@ def _normalize_path(binary_path: str) -> pathlib.Path:
     return path
 
 
+def read_perf_stat(path):
+    """Parses the CSV output of 'perf stat -x,' into {event: value}."""
+    counters = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if len(fields) < 3 or line.startswith("#"):
+                continue
+            try:
+                counters[fields[2]] = float(fields[0])
+            except ValueError:
+                # '<not counted>' or '<not supported>'.
+                counters[fields[2]] = None
+    return counters
+
+
+def merge_repetitions(repetitions):
+    """
+    Merges the results of several runs of a binary. Returns rows in the folly
+    format with the median time of each benchmark and the times of each run.
+    """
+    times = defaultdict(list)
+    rows = {}
+    for data in repetitions:
+        for row in data:
+            handle = (row[0], row[1])
+            times[handle].append(row[2])
+            rows.setdefault(handle, list(row))
+
+    merged = []
+    samples = []
+    for handle, row in rows.items():
+        row[2] = statistics.median(times[handle])
+        merged.append(row)
+        if row[1] != "-":
+            samples.append(
+                {"file": handle[0], "name": handle[1], "times_ns": times[handle]}
+            )
+    return merged, samples
+
+
+def run_binary(binary_path, out_path, run_options, repetitions, perf_events):
+    """
+    Runs 'binary_path' 'repetitions' times and writes the median results to
+    'out_path'. With more than one repetition, writes the time of each run to
+    the samples file. If 'perf_events' is set, runs the binary under 'perf
+    stat' and writes the counters of each run to the perf file.
+    """
+    results = []
+    perf_counters = []
+    with tempfile.TemporaryDirectory() as temp_dir:
+        for repetition in range(repetitions):
+            json_path = pathlib.Path(temp_dir) / f"{repetition}.json"
+            run_command = [binary_path, "--bm_json_verbose", json_path]
+            run_command.extend(run_options)
+            if perf_events:
+                perf_out = pathlib.Path(temp_dir) / f"{repetition}.perf"
+                run_command = [
+                    "perf",
+                    "stat",
+                    "-x",
+                    ",",
+                    "-e",
+                    perf_events,
+                    "-o",
+                    perf_out,
+                    "--",
+                ] + run_command
+
+            try:
+                print(run_command)
+                subprocess.run(run_command, check=True)
+            except subprocess.CalledProcessError as e:
+                print(e.stderr.decode("utf-8"))
+                raise e
+
+            with open(json_path) as f:
+                results.append(json.load(f))
+            if perf_events:
+                perf_counters.append(
+                    {"repetition": repetition, "counters": read_perf_stat(perf_out)}
+                )
+
+    merged, samples = merge_repetitions(results)
+    with open(out_path, "w") as f:
+        json.dump(merged, f)
+    if repetitions > 1:
+        with open(samples_path(out_path), "w") as f:
+            for sample in samples:
+                f.write(json.dumps(sample) + "\n")
+    if perf_counters:
+        with open(perf_path(out_path), "w") as f:
+            for counters in perf_counters:
+                f.write(json.dumps(counters) + "\n")
+
+
 def run_all_benchmarks(
     output_dir,
-    binary_path=None,
+    binary_paths=None,
     binary_filter=None,
     bm_filter=None,
     bm_max_secs=None,
     bm_max_trials=None,
     bm_estimate_time=False,
+    repetitions=1,
+    perf_events=None,
 ):
-    if binary_path:
-        binary_path = _normalize_path(binary_path)
+    if binary_paths:
+        binary_paths = [_normalize_path(path) for path in binary_paths]
     else:
-        binary_path = _default_binary_path()
+        binary_paths = [_default_binary_path()]
 
-    binaries = _find_binaries(binary_path)
+    binaries = []
+    for binary_path in binary_paths:
+        binaries += _find_binaries(binary_path)
     output_dir_path = pathlib.Path(output_dir)
     output_dir_path.mkdir(parents=True, exist_ok=True)
 
@@ -309,11 +524,7 @@ def run_all_benchmarks(
 
         out_path = output_dir_path / f"{binary_path.name}.json"
         print(f"Executing and dumping results for '{binary_path}' to '{out_path}':")
-        run_command = [
-            binary_path,
-            "--bm_json_verbose",
-            out_path,
-        ]
+        run_command = []
 
         if bm_max_secs:
             run_command.extend(["--bm_max_secs", str(bm_max_secs)])
@@ -327,12 +538,7 @@ def run_all_benchmarks(
         if bm_estimate_time:
             run_command.append("--bm_estimate_time")
 
-        try:
-            print(run_command)
-            subprocess.run(run_command, check=True)
-        except subprocess.CalledProcessError as e:
-            print(e.stderr.decode("utf-8"))
-            raise e
+        run_binary(binary_path, out_path, run_command, repetitions, perf_events)
 
 
 def upload_results(args):
@@ -402,12 +608,14 @@ def run(args):
     output_dir = args.output_path or tempfile.mkdtemp()
     kwargs = {
         "output_dir": output_dir,
-        "binary_path": args.binary_path,
+        "binary_paths": args.binary_path,
         "binary_filter": args.binary_filter,
         "bm_filter": args.bm_filter,
         "bm_max_secs": args.bm_max_secs,
         "bm_max_trials": args.bm_max_trials,
         "bm_estimate_time": args.bm_estimate_time,
+        "repetitions": args.repetitions,
+        "perf_events": args.perf_events,
     }
 
     # In case we only want to rerun failed benchmarks from rerun_json_input.
@@ -443,8 +651,9 @@ def parse_args():
     parser_run.add_argument(
         "--binary_path",
         default=None,
-        help="Directory where benchmark binaries are stored. "
-        "Defaults to release build directory.",
+        nargs="+",
+        help="Directories where benchmark binaries are stored. "
+        "Defaults to the basic benchmarks of the release build directory.",
     )
     parser_run.add_argument(
         "--output_path",
@@ -482,6 +691,20 @@ def parse_args():
         action="store_true",
         help="Use folly benchmark --bm_estimate_time flag.",
     )
+    parser_run.add_argument(
+        "--repetitions",
+        default=1,
+        type=int,
+        help="Number of times to run each binary. The result of a benchmark is "
+        "the median and the time of each run is saved for the significance "
+        "test of 'compare'.",
+    )
+    parser_run.add_argument(
+        "--perf_events",
+        default=None,
+        help="Comma separated hardware events to count with 'perf stat' for "
+        "each binary, e.g. 'cycles,instructions,cache-misses,branch-misses'.",
+    )
     parser_run.add_argument(
         "--rerun_json_input",
         default=None,
@@ -514,6 +737,14 @@ def parse_args():
         "Variations larger than this threshold will be reported as failures. "
         "Default 0.05 (5%%).",
     )
+    parser_compare.add_argument(
+        "--significance",
+        type=float,
+        default=0.05,
+        help="Significance level of the Mann-Whitney U test when both sides "
+        "have at least {} repetitions. Variations over the threshold that are "
+        "not significant are reported as noise. Default 0.05.".format(_MIN_SAMPLES),
+    )
     parser_compare.add_argument(
         "--rerun_json_output",
         default=None,
@@ -0,0 +1,79 @@
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import importlib.util
+import tempfile
+import unittest
+from pathlib import Path
+
+# The script name is not a valid module name.
+_spec = importlib.util.spec_from_file_location(
+    "benchmark_runner", Path(__file__).parent.parent / "benchmark-runner.py"
+)
+benchmark_runner = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(benchmark_runner)
+
+
+class BenchmarkRunnerTest(unittest.TestCase):
+    def test_mann_whitney(self):
+        p_value = benchmark_runner.mann_whitney_p_value
+        # Disjoint samples are significant at 5%, interleaved ones are not.
+        self.assertAlmostEqual(
+            p_value([1, 2, 3, 4, 5], [6, 7, 8, 9, 10]), 0.0122, places=3
+        )
+        self.assertGreater(p_value([1, 3, 5, 7, 9], [2, 4, 6, 8, 10]), 0.5)
+        # The test is symmetric.
+        self.assertEqual(
+            p_value([10, 12, 11, 14, 13], [20, 11, 22, 21, 23]),
+            p_value([20, 11, 22, 21, 23], [10, 12, 11, 14, 13]),
+        )
+        # All equal values.
+        self.assertEqual(p_value([5, 5, 5, 5, 5], [5, 5, 5, 5, 5]), 1.0)
+
+    def test_merge_repetitions(self):
+        repetitions = [
+            [["a.cpp", "bm1", 10.0], ["a.cpp", "-", 0], ["a.cpp", "bm2", 5.0]],
+            [["a.cpp", "bm1", 30.0], ["a.cpp", "-", 0], ["a.cpp", "bm2", 6.0]],
+            [["a.cpp", "bm1", 20.0], ["a.cpp", "-", 0], ["a.cpp", "bm2", 4.0]],
+        ]
+        merged, samples = benchmark_runner.merge_repetitions(repetitions)
+        self.assertEqual(
+            merged,
+            [["a.cpp", "bm1", 20.0], ["a.cpp", "-", 0], ["a.cpp", "bm2", 5.0]],
+        )
+        self.assertEqual(
+            samples,
+            [
+                {"file": "a.cpp", "name": "bm1", "times_ns": [10.0, 30.0, 20.0]},
+                {"file": "a.cpp", "name": "bm2", "times_ns": [5.0, 6.0, 4.0]},
+            ],
+        )
+
+    def test_read_perf_stat(self):
+        with tempfile.TemporaryDirectory() as temp_dir:
+            path = Path(temp_dir) / "0.perf"
+            path.write_text(
+                "# started on Mon Jan  1 00:00:00 2024\n"
+                "\n"
+                "1000,,cycles,100.00,100.00,,\n"
+                "<not counted>,,cache-misses,0.00,100.00,,\n"
+            )
+            self.assertEqual(
+                benchmark_runner.read_perf_stat(path),
+                {"cycles": 1000.0, "cache-misses": None},
+            )
+
+
+if __name__ == "__main__":
+    unittest.main()
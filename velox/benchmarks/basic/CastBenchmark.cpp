@@ -60,6 +60,39 @@ int main(int argc, char** argv) {
         return Timestamp(1695859694 + j / 1000, j % 1000 * 1'000'000);
       });
 
+  auto bigintStringInput =
+      vectorMaker.flatVector<std::string>(vectorSize, [&](auto j) {
+        return std::to_string(j * 1'234'567'891LL - 500'000'000'000LL);
+      });
+  auto doubleStringInput =
+      vectorMaker.flatVector<std::string>(vectorSize, [&](auto j) {
+        return fmt::format("{}.{:02}", j * 37 - 10'000, j % 100);
+      });
+  auto dateStringInput =
+      vectorMaker.flatVector<std::string>(vectorSize, [&](auto j) {
+        return fmt::format(
+            "{}-{:02}-{:02}", 1990 + j % 40, 1 + j % 12, 1 + j % 28);
+      });
+  auto timestampStringInput =
+      vectorMaker.flatVector<std::string>(vectorSize, [&](auto j) {
+        return fmt::format(
+            "{}-{:02}-{:02} {:02}:{:02}:{:02}.{:03}",
+            1990 + j % 40,
+            1 + j % 12,
+            1 + j % 28,
+            j % 24,
+            j % 60,
+            (j * 7) % 60,
+            j % 1000);
+      });
+
+  // Integers where every 'n'th string is not a number.
+  auto makeErrorRateInput = [&](int32_t n) {
+    return vectorMaker.flatVector<std::string>(vectorSize, [&](auto j) {
+      return n > 0 && j % n == 0 ? fmt::format("{}x", j) : std::to_string(j);
+    });
+  };
+
   invalidInput->resize(vectorSize);
   validInput->resize(vectorSize);
   nanInput->resize(vectorSize);
@@ -125,6 +158,45 @@ int main(int argc, char** argv) {
       .withIterations(100)
       .disableTesting();
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar",
+          vectorMaker.rowVector(
+              {"bigint", "double", "date", "timestamp"},
+              {bigintStringInput,
+               doubleStringInput,
+               dateStringInput,
+               timestampStringInput}))
+      .addExpression("cast_varchar_as_bigint", "cast(bigint as bigint)")
+      .addExpression("cast_varchar_as_double", "cast(double as double)")
+      .addExpression("cast_varchar_as_date", "cast(date as date)")
+      .addExpression(
+          "cast_varchar_as_timestamp", "cast(timestamp as timestamp)")
+      .withIterations(100)
+      .disableTesting();
+
+  // Errors under TRY and TRY_CAST at 0%, 10% and 50% invalid strings.
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_error_rate",
+          vectorMaker.rowVector(
+              {"errors_0", "errors_10", "errors_50"},
+              {makeErrorRateInput(0),
+               makeErrorRateInput(10),
+               makeErrorRateInput(2)}))
+      .addExpression("try_cast_errors_0", "try_cast(errors_0 as bigint)")
+      .addExpression("try_cast_errors_10", "try_cast(errors_10 as bigint)")
+      .addExpression("try_cast_errors_50", "try_cast(errors_50 as bigint)")
+      .addExpression("tryexpr_cast_errors_0", "try(cast(errors_0 as bigint))")
+      .addExpression(
+          "tryexpr_cast_errors_10", "try(cast(errors_10 as bigint))")
+      .addExpression(
+          "tryexpr_cast_errors_50", "try(cast(errors_50 as bigint))")
+      .addExpression(
+          "tryexpr_cast_double_errors_50", "try(cast(errors_50 as double))")
+      .withIterations(100)
+      .disableTesting();
+
   benchmarkBuilder.registerBenchmarks();
   folly::runBenchmarks();
   return 0;
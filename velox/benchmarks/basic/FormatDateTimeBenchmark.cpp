@@ -39,7 +39,41 @@ int main(int argc, char** argv) {
       .addBenchmarkSet(
           "Benchmark format_datetime",
           vectorMaker.rowVector({fuzzer.fuzz(TIMESTAMP())}))
-      .addExpression("", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
+      .addExpression(
+          "fixed_width", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
+      .addExpression("fixed_width_date", "format_datetime(c0, 'yyyy-MM-dd')")
+      .addExpression(
+          "variable_width", "format_datetime(c0, 'yyyy-M-d H:m:s EEE')")
+      .disableTesting();
+
+  // Timestamps within the years that format to 4 digits.
+  auto timestamps = vectorMaker.flatVector<Timestamp>(
+      options.vectorSize, [](auto row) {
+        return Timestamp(
+            static_cast<int64_t>(row) * 1'234'567'891 % 4'000'000'000,
+            row * 1'000'000);
+      });
+  auto strings = vectorMaker.flatVector<std::string>(
+      options.vectorSize, [](auto row) {
+        return fmt::format(
+            "2023-{:02}-{:02} {:02}:{:02}:{:02}",
+            row % 12 + 1,
+            row % 28 + 1,
+            row % 24,
+            row % 60,
+            row % 59);
+      });
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "Benchmark format and parse datetime",
+          vectorMaker.rowVector({timestamps, strings}))
+      .addExpression(
+          "format_fixed_width", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss')")
+      .addExpression(
+          "format_variable_width", "format_datetime(c0, 'yyyy-M-d H:m:s')")
+      .addExpression("parse_fixed_width", "date_parse(c1, '%Y-%m-%d %H:%i:%s')")
+      .addExpression(
+          "parse_joda_fixed_width", "parse_datetime(c1, 'yyyy-MM-dd HH:mm:ss')")
       .disableTesting();
 
   benchmarkBuilder.registerBenchmarks();
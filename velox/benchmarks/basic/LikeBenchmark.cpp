@@ -117,6 +117,17 @@ int main(int argc, char** argv) {
           "generic", vectorMaker.rowVector({"col0"}, {substringInput}))
       .addExpression("generic", R"(like(col0, '%a%b%c'))");
 
+  // Non-constant patterns that need a regular expression. The compiled
+  // expressions are shared by the function instances through Re2Cache.
+  auto patterns = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) { return fmt::format("%a%b%c{}%", row % 10); });
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "non_constant",
+          vectorMaker.rowVector({"col0", "col1"}, {substringInput, patterns}))
+      .addExpression("like", R"(like(col0, col1))")
+      .addExpression("regexp_like", R"(regexp_like(col0, col1))");
+
   benchmarkBuilder.registerBenchmarks();
   benchmarkBuilder.testBenchmarks();
   folly::runBenchmarks();
@@ -149,6 +149,15 @@ class SimpleArithmeticBenchmark
     run(expression, kIterationsLarge, largeRowVector_);
   }
 
+  // Runs 'expression' with QueryConfig::kExprFusionEnabled.
+  void runLargeFused(const std::string& expression) {
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kExprFusionEnabled, "true"}});
+    run(expression, kIterationsLarge, largeRowVector_);
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kExprFusionEnabled, "false"}});
+  }
+
   // Runs `expression` `times` thousand times.
   size_t
   run(const std::string& expression, size_t times, const RowVectorPtr& input) {
@@ -316,6 +325,20 @@ BENCHMARK(multiplyNestedDeepLarge) {
       "multiply(a, multiply(a, b)))");
 }
 
+BENCHMARK_RELATIVE(multiplyNestedDeepFusedLarge) {
+  benchmark->runLargeFused(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))");
+}
+
+BENCHMARK(multiplyNestedConstantLarge) {
+  benchmark->runLarge("multiply(multiply(a, cast(2 as double)), b)");
+}
+
+BENCHMARK_RELATIVE(multiplyNestedConstantFusedLarge) {
+  benchmark->runLargeFused("multiply(multiply(a, cast(2 as double)), b)");
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(multiplyOutputVoidLarge) {
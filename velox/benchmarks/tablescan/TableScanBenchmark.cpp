@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#ifdef VELOX_ENABLE_PARQUET
+#include "velox/dwio/parquet/writer/Writer.h"
+#endif
+
+DEFINE_string(
+    data_path,
+    "",
+    "Directory for the generated files. May be on any registered file "
+    "system, e.g. s3://bucket/dir when built with S3 support. A temporary "
+    "local directory if empty");
+DEFINE_int64(num_rows, 4'000'000, "Number of rows in each table");
+DEFINE_int32(rows_per_vector, 10'000, "Rows in each generated vector");
+DEFINE_int32(num_files, 4, "Number of files in each table");
+DEFINE_int32(num_splits_per_file, 1, "Number of splits per file");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_int32(num_io_threads, 8, "Threads for speculative IO");
+DEFINE_string(formats, "dwrf,parquet", "Comma separated file formats");
+DEFINE_string(
+    encodings,
+    "dictionary,direct",
+    "Comma separated encodings. 'dictionary' uses dictionary encoding for "
+    "all columns where the writer supports it, 'direct' for none");
+DEFINE_string(
+    compressions,
+    "none,snappy,zstd",
+    "Comma separated compression codecs");
+DEFINE_string(
+    selectivities,
+    "0.001,0.01,0.1,0.5,1",
+    "Comma separated fractions of rows that pass the filter");
+DEFINE_int32(
+    cache_gb,
+    0,
+    "GB of process memory for cache and query. If non-0, uses mmap to "
+    "allocate and also runs each case with the in-process data cache");
+DEFINE_string(ssd_path, "", "Directory for local SSD cache");
+DEFINE_int32(
+    ssd_cache_gb,
+    0,
+    "Size of local SSD cache in GB. If non-0 together with --cache_gb, also "
+    "runs each case with the RAM cache cleared before each run, so that "
+    "reads hit the SSD cache");
+
+/// Benchmarks TableScan over the combinations of file format, encoding,
+/// compression and cache of --formats, --encodings, --compressions,
+/// --cache_gb and --ssd_cache_gb. Writes one table per format, encoding and
+/// compression of random data made by VectorFuzzer and scans it with a
+/// filter on a uniformly distributed key for each of --selectivities. All
+/// columns are consumed by a checksum aggregation so that the lazy columns
+/// are loaded. Reports the raw input bytes and rows scanned per second and
+/// the process CPU time per raw input byte, which includes the IO and
+/// decompression threads.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::test;
+
+namespace {
+
+// Keys are uniformly distributed in [0, kKeyRange).
+constexpr int64_t kKeyRange = 1'000'000;
+
+enum class CacheMode { kNone, kMemory, kSsd };
+
+std::string cacheModeName(CacheMode mode) {
+  switch (mode) {
+    case CacheMode::kNone:
+      return "nocache";
+    case CacheMode::kMemory:
+      return "memory";
+    case CacheMode::kSsd:
+      return "ssd";
+  }
+  VELOX_UNREACHABLE();
+}
+
+struct TableSpec {
+  dwio::common::FileFormat format;
+  bool dictionary;
+  common::CompressionKind compression;
+
+  std::string name() const {
+    return fmt::format(
+        "{}_{}_{}",
+        dwio::common::toString(format),
+        dictionary ? "dictionary" : "direct",
+        common::compressionKindToString(compression));
+  }
+};
+
+struct Counters {
+  int64_t runs{0};
+  int64_t micros{0};
+  int64_t rawInputBytes{0};
+  int64_t rawInputRows{0};
+  int64_t outputRows{0};
+  int64_t cpuNanos{0};
+
+  std::string toString() const {
+    if (runs == 0 || micros == 0) {
+      return "N/A";
+    }
+    const double seconds = micros / 1.0e6;
+    return fmt::format(
+        "{}/s {:.2f}M rows/s {:.2f} CPU ns/byte, {} rows selected",
+        succinctBytes(rawInputBytes / seconds),
+        rawInputRows / seconds / 1.0e6,
+        rawInputBytes == 0 ? 0.0
+                           : cpuNanos / static_cast<double>(rawInputBytes),
+        outputRows / runs);
+  }
+};
+
+struct ScanCase {
+  std::string title;
+  const TableSpec* table;
+  CacheMode cacheMode;
+  double selectivity;
+  core::PlanNodePtr plan;
+  Counters counters;
+};
+
+int64_t processCpuNanos() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  auto tvNanos = [](struct timeval tv) {
+    return tv.tv_sec * 1'000'000'000L + tv.tv_usec * 1'000L;
+  };
+  return tvNanos(usage.ru_utime) + tvNanos(usage.ru_stime);
+}
+
+class TableScanBenchmark : public VectorTestBase {
+ public:
+  TableScanBenchmark()
+      : rowType_(ROW(
+            {"c0", "c1", "c2", "c3", "c4", "c5"},
+            {BIGINT(), INTEGER(), DOUBLE(), VARCHAR(), VARCHAR(), BIGINT()})) {
+    if (FLAGS_cache_gb) {
+      std::unique_ptr<cache::SsdCache> ssdCache;
+      if (FLAGS_ssd_cache_gb) {
+        constexpr int32_t kNumSsdShards = 16;
+        cacheExecutor_ =
+            std::make_unique<folly::IOThreadPoolExecutor>(kNumSsdShards);
+        ssdCache = std::make_unique<cache::SsdCache>(
+            FLAGS_ssd_path,
+            static_cast<uint64_t>(FLAGS_ssd_cache_gb) << 30,
+            kNumSsdShards,
+            cacheExecutor_.get());
+      }
+      cache_ = cache::AsyncDataCache::create(
+          memory::memoryManager()->allocator(), std::move(ssdCache));
+      cache::AsyncDataCache::setInstance(cache_.get());
+    }
+
+    ioExecutor_ =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        std::thread::hardware_concurrency());
+    connectorProperties_ = std::make_shared<const core::MemConfig>();
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId, connectorProperties_, ioExecutor_.get());
+    connector::registerConnector(hiveConnector);
+
+    if (FLAGS_data_path.empty()) {
+      tempDirectory_ = TempDirectoryPath::create();
+      dataPath_ = tempDirectory_->path;
+    } else {
+      dataPath_ = FLAGS_data_path;
+    }
+  }
+
+  ~TableScanBenchmark() {
+    if (cache_) {
+      cache_->shutdown();
+      cache::AsyncDataCache::setInstance(nullptr);
+    }
+    connector::unregisterConnector(kHiveConnectorId);
+  }
+
+  /// Generates the data and writes a table for each combination of format,
+  /// encoding and compression. Adds a benchmark for each table, cache mode
+  /// and selectivity.
+  void makeBenchmarks() {
+    auto vectors = makeVectors();
+    for (const auto& format : split(FLAGS_formats)) {
+      for (const auto& encoding : split(FLAGS_encodings)) {
+        VELOX_USER_CHECK(
+            encoding == "dictionary" || encoding == "direct",
+            "Unknown encoding: {}",
+            encoding);
+        for (const auto& compression : split(FLAGS_compressions)) {
+          tables_.push_back(std::make_unique<TableSpec>(TableSpec{
+              dwio::common::toFileFormat(format),
+              encoding == "dictionary",
+              common::stringToCompressionKind(compression)}));
+          writeTable(*tables_.back(), vectors);
+        }
+      }
+    }
+
+    std::vector<CacheMode> cacheModes{CacheMode::kNone};
+    if (cache_) {
+      cacheModes.push_back(CacheMode::kMemory);
+      if (cache_->ssdCache()) {
+        cacheModes.push_back(CacheMode::kSsd);
+      }
+    }
+    for (const auto& table : tables_) {
+      for (auto cacheMode : cacheModes) {
+        for (const auto& selectivity : split(FLAGS_selectivities)) {
+          auto scan = std::make_unique<ScanCase>();
+          scan->table = table.get();
+          scan->cacheMode = cacheMode;
+          scan->selectivity = folly::to<double>(selectivity);
+          scan->title = fmt::format(
+              "{}_{}_{}%",
+              table->name(),
+              cacheModeName(cacheMode),
+              scan->selectivity * 100);
+          scan->plan = makePlan(scan->selectivity);
+          auto* scanPtr = scan.get();
+          folly::addBenchmark(__FILE__, scan->title, [this, scanPtr]() {
+            run(*scanPtr);
+            return 1;
+          });
+          cases_.push_back(std::move(scan));
+        }
+      }
+    }
+  }
+
+  void printCounters() const {
+    std::cout << "*** Results:" << std::endl;
+    for (const auto& scan : cases_) {
+      std::cout << scan->title << ": " << scan->counters.toString()
+                << std::endl;
+    }
+  }
+
+ private:
+  static std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> values;
+    folly::split(',', list, values, true);
+    return values;
+  }
+
+  std::vector<RowVectorPtr> makeVectors() {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_rows_per_vector;
+    options.nullRatio = 0.05;
+    options.stringLength = 20;
+    options.stringVariableLength = true;
+    VectorFuzzer fuzzer(options, pool());
+
+    // Low cardinality values that dictionary encoding applies to.
+    auto stringValues = fuzzer.fuzzFlat(VARCHAR(), 1'000);
+    auto bigintValues = fuzzer.fuzzFlat(BIGINT(), 1'000);
+
+    std::vector<RowVectorPtr> vectors;
+    for (auto numRows = 0; numRows < FLAGS_num_rows;
+         numRows += FLAGS_rows_per_vector) {
+      const auto size = std::min<int64_t>(
+          FLAGS_rows_per_vector, FLAGS_num_rows - numRows);
+      auto indices = makeIndices(size, [&](auto /*row*/) {
+        return folly::Random::rand32(stringValues->size(), rng_);
+      });
+      vectors.push_back(makeRowVector(
+          rowType_->names(),
+          {makeFlatVector<int64_t>(
+               size,
+               [&](auto /*row*/) {
+                 return folly::Random::rand64(kKeyRange, rng_);
+               }),
+           fuzzer.fuzzFlat(INTEGER(), size),
+           fuzzer.fuzzFlat(DOUBLE(), size),
+           fuzzer.fuzzFlat(VARCHAR(), size),
+           BaseVector::wrapInDictionary(nullptr, indices, size, stringValues),
+           BaseVector::wrapInDictionary(
+               nullptr, indices, size, bigintValues)}));
+    }
+    return vectors;
+  }
+
+  std::string filePath(const TableSpec& table, int32_t file) const {
+    return fmt::format("{}/{}_{}", dataPath_, table.name(), file);
+  }
+
+  // Writes the vectors round-robin into --num_files files.
+  void writeTable(
+      const TableSpec& table,
+      const std::vector<RowVectorPtr>& vectors) {
+    auto writerPool = rootPool_->addAggregateChild("TableScanBenchmark.Writer");
+    for (auto file = 0; file < FLAGS_num_files; ++file) {
+      auto sink = dwio::common::FileSink::create(
+          filePath(table, file),
+          {.connectorProperties = connectorProperties_,
+           .pool = writerPool.get()});
+      auto writer = makeWriter(table, std::move(sink), writerPool.get());
+      for (auto i = file; i < vectors.size(); i += FLAGS_num_files) {
+        writer->write(vectors[i]);
+      }
+      writer->close();
+    }
+  }
+
+  std::unique_ptr<dwio::common::Writer> makeWriter(
+      const TableSpec& table,
+      std::unique_ptr<dwio::common::FileSink> sink,
+      memory::MemoryPool* pool) {
+    switch (table.format) {
+      case dwio::common::FileFormat::DWRF: {
+        auto config = std::make_shared<dwrf::Config>();
+        config->set(dwrf::Config::COMPRESSION, table.compression);
+        // A key size threshold of 1 keeps the dictionary for any number of
+        // distinct values, 0 never tries it.
+        const float threshold = table.dictionary ? 1.0 : 0.0;
+        config->set(
+            dwrf::Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD, threshold);
+        config->set(
+            dwrf::Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD, threshold);
+        dwrf::WriterOptions options;
+        options.config = config;
+        options.schema = rowType_;
+        options.memoryPool = pool;
+        return std::make_unique<dwrf::Writer>(std::move(sink), options);
+      }
+#ifdef VELOX_ENABLE_PARQUET
+      case dwio::common::FileFormat::PARQUET: {
+        parquet::WriterOptions options;
+        options.enableDictionary = table.dictionary;
+        options.compression = table.compression;
+        options.memoryPool = pool;
+        return std::make_unique<parquet::Writer>(
+            std::move(sink), options, rowType_);
+      }
+#endif
+      default:
+        VELOX_USER_FAIL(
+            "Unsupported file format: {}",
+            dwio::common::toString(table.format));
+    }
+  }
+
+  core::PlanNodePtr makePlan(double selectivity) const {
+    std::vector<std::string> aggregates{"count(1)"};
+    for (const auto& name : rowType_->names()) {
+      aggregates.push_back(fmt::format("checksum({})", name));
+    }
+    return PlanBuilder()
+        .tableScan(
+            rowType_,
+            {fmt::format(
+                "c0 < {}", static_cast<int64_t>(selectivity * kKeyRange))})
+        .singleAggregation({}, aggregates)
+        .planNode();
+  }
+
+  void run(ScanCase& scan) {
+    std::vector<exec::Split> splits;
+    {
+      folly::BenchmarkSuspender suspender;
+      if (scan.cacheMode == CacheMode::kSsd) {
+        cache_->clear();
+      }
+      for (auto file = 0; file < FLAGS_num_files; ++file) {
+        for (auto& split : HiveConnectorTestBase::makeHiveConnectorSplits(
+                 filePath(*scan.table, file),
+                 FLAGS_num_splits_per_file,
+                 scan.table->format)) {
+          splits.emplace_back(std::move(split));
+        }
+      }
+    }
+    auto queryCtx = std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        core::QueryConfig({}),
+        std::unordered_map<std::string, std::shared_ptr<Config>>{},
+        scan.cacheMode == CacheMode::kNone ? nullptr : cache_.get());
+
+    std::shared_ptr<Task> task;
+    uint64_t micros = 0;
+    const auto cpuNanos = processCpuNanos();
+    {
+      MicrosecondTimer timer(&micros);
+      auto result = AssertQueryBuilder(scan.plan)
+                        .queryCtx(queryCtx)
+                        .maxDrivers(FLAGS_num_drivers)
+                        .splits(std::move(splits))
+                        .copyResults(pool(), task);
+      scan.counters.outputRows +=
+          result->childAt(0)->as<SimpleVector<int64_t>>()->valueAt(0);
+    }
+    scan.counters.cpuNanos += processCpuNanos() - cpuNanos;
+    scan.counters.micros += micros;
+    ++scan.counters.runs;
+
+    const auto planStats = toPlanStats(task->taskStats());
+    const auto& scanStats = planStats.at(scan.plan->sources()[0]->id());
+    scan.counters.rawInputBytes += scanStats.rawInputBytes;
+    scan.counters.rawInputRows += scanStats.rawInputRows;
+  }
+
+  const RowTypePtr rowType_;
+  folly::Random::DefaultGenerator rng_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::shared_ptr<const Config> connectorProperties_;
+  std::shared_ptr<TempDirectoryPath> tempDirectory_;
+  std::string dataPath_;
+  std::vector<std::unique_ptr<TableSpec>> tables_;
+  std::vector<std::unique_ptr<ScanCase>> cases_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  if (FLAGS_cache_gb) {
+    memory::MemoryManagerOptions options;
+    options.useMmapAllocator = true;
+    options.allocatorCapacity = FLAGS_cache_gb * (1LL << 30);
+    options.useMmapArena = true;
+    options.mmapArenaCapacityRatio = 1;
+    memory::MemoryManager::initialize(options);
+  } else {
+    memory::MemoryManager::initialize({});
+  }
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+  filesystems::registerLocalFileSystem();
+
+  auto bm = std::make_unique<TableScanBenchmark>();
+  bm->makeBenchmarks();
+  folly::runBenchmarks();
+  bm->printCounters();
+  bm.reset();
+  return 0;
+}
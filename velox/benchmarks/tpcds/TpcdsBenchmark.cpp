@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+DEFINE_double(scale_factor, 1, "TPC-DS scale factor of the generated data");
+DEFINE_int32(
+    run_query_verbose,
+    -1,
+    "Run a given query and print execution statistics");
+DEFINE_bool(
+    include_custom_stats,
+    false,
+    "Include custom statistics along with execution statistics");
+DEFINE_bool(include_results, false, "Include results in the output");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_int32(num_splits, 16, "Number of splits per table");
+DEFINE_int32(num_repeats, 1, "Number of times to run each query");
+
+namespace {
+
+const std::string kTpcdsConnectorId = "test-tpcds";
+
+class TpcdsBenchmark {
+ public:
+  void initialize() {
+    memory::MemoryManager::testingSetInstance({});
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    parse::registerTypeResolver();
+
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+    queryBuilder_ = std::make_unique<TpcdsQueryBuilder>(FLAGS_scale_factor);
+  }
+
+  // Runs query 'queryId' FLAGS_num_repeats times and returns the cursor and
+  // the results of the last run.
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
+      const TpcdsPlan& tpcdsPlan) {
+    for (int32_t repeat = 0;; ++repeat) {
+      CursorParameters params;
+      params.maxDrivers = FLAGS_num_drivers;
+      params.planNode = tpcdsPlan.plan;
+      bool noMoreSplits = false;
+      auto addSplits = [&](Task* task) {
+        if (noMoreSplits) {
+          return;
+        }
+        for (const auto& scanNodeId : tpcdsPlan.scanNodeIds) {
+          for (int32_t i = 0; i < FLAGS_num_splits; ++i) {
+            task->addSplit(
+                scanNodeId,
+                Split(std::make_shared<connector::tpcds::TpcdsConnectorSplit>(
+                    kTpcdsConnectorId, FLAGS_num_splits, i)));
+          }
+          task->noMoreSplits(scanNodeId);
+        }
+        noMoreSplits = true;
+      };
+      auto result = readCursor(params, addSplits);
+      VELOX_CHECK(waitForTaskCompletion(result.first->task().get()));
+      if (repeat + 1 >= FLAGS_num_repeats) {
+        return result;
+      }
+    }
+  }
+
+  void runVerbose(int queryId, std::ostream& out) {
+    const auto tpcdsPlan = queryBuilder_->getQueryPlan(queryId);
+    auto [cursor, results] = run(tpcdsPlan);
+    if (FLAGS_include_results) {
+      out << "Results:" << std::endl;
+      for (const auto& vector : results) {
+        for (vector_size_t i = 0; i < vector->size(); ++i) {
+          out << vector->toString(i) << std::endl;
+        }
+      }
+      out << std::endl;
+    }
+    const auto stats = cursor->task()->taskStats();
+    out << fmt::format(
+               "Execution time: {}",
+               succinctMillis(
+                   stats.executionEndTimeMs - stats.executionStartTimeMs))
+        << std::endl;
+    out << printPlanWithStats(
+               *tpcdsPlan.plan, stats, FLAGS_include_custom_stats)
+        << std::endl;
+  }
+
+  void runQuery(int queryId) {
+    run(queryBuilder_->getQueryPlan(queryId));
+  }
+
+ private:
+  std::unique_ptr<TpcdsQueryBuilder> queryBuilder_;
+};
+
+TpcdsBenchmark benchmark;
+
+} // namespace
+
+BENCHMARK(q3) {
+  benchmark.runQuery(3);
+}
+
+BENCHMARK(q7) {
+  benchmark.runQuery(7);
+}
+
+BENCHMARK(q27) {
+  benchmark.runQuery(27);
+}
+
+BENCHMARK(q42) {
+  benchmark.runQuery(42);
+}
+
+BENCHMARK(q52) {
+  benchmark.runQuery(52);
+}
+
+BENCHMARK(q55) {
+  benchmark.runQuery(55);
+}
+
+BENCHMARK(q98) {
+  benchmark.runQuery(98);
+}
+
+int main(int argc, char** argv) {
+  gflags::SetUsageMessage(
+      "This program benchmarks TPC-DS queries over generated data. Run "
+      "'velox_tpcds_benchmark -helpon=TpcdsBenchmark' for available "
+      "options.\n");
+  folly::Init init{&argc, &argv, false};
+  benchmark.initialize();
+  if (FLAGS_run_query_verbose == -1) {
+    folly::runBenchmarks();
+  } else {
+    benchmark.runVerbose(FLAGS_run_query_verbose, std::cout);
+  }
+  return 0;
+}
@@ -15,6 +15,7 @@
  */
 
 #include <deque>
+#include <thread>
 
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
@@ -33,6 +34,10 @@ DEFINE_int64(
     memory_free_every_n_operations,
     5,
     "Specifies memory free for every N operations. If it is 5, then we free one of existing memory allocation for every 5 memory operations");
+DEFINE_int32(
+    memory_allocation_threads,
+    8,
+    "The number of threads allocating from the same pool in the concurrent benchmarks");
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -432,6 +437,49 @@ BENCHMARK_RELATIVE_MULTI(MmapReallocateMix64) {
   MemoryPoolAllocationBenchMark benchmark(Type::kMmap, 64, 128, 32 << 20);
   return benchmark.runReallocate();
 }
+
+// Allocates and frees small blocks from one leaf pool on
+// 'FLAGS_memory_allocation_threads' threads. Measures the contention on the
+// usage accounting of the pool.
+size_t runConcurrentAllocate(bool reservationCacheEnabled) {
+  folly::BenchmarkSuspender suspender;
+  auto manager = std::make_shared<MemoryManager>(MemoryManagerOptions{
+      .reservationCacheEnabled = reservationCacheEnabled});
+  auto pool = manager->addLeafPool("ConcurrentAllocate");
+  std::vector<std::thread> threads;
+  threads.reserve(FLAGS_memory_allocation_threads);
+  suspender.dismiss();
+  for (auto i = 0; i < FLAGS_memory_allocation_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      folly::Random::DefaultGenerator rng(FLAGS_allocation_size_seed + i);
+      std::deque<std::pair<void*, size_t>> allocations;
+      for (auto iter = 0; iter < FLAGS_memory_allocation_count; ++iter) {
+        if (iter % FLAGS_memory_free_every_n_operations == 0 &&
+            !allocations.empty()) {
+          pool->free(allocations.front().first, allocations.front().second);
+          allocations.pop_front();
+        }
+        const size_t size = 64 + folly::Random::rand32(1024, rng);
+        allocations.emplace_back(pool->allocate(size), size);
+      }
+      for (auto& allocation : allocations) {
+        pool->free(allocation.first, allocation.second);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return FLAGS_memory_allocation_count * FLAGS_memory_allocation_threads;
+}
+
+BENCHMARK_MULTI(ConcurrentAllocateSmall) {
+  return runConcurrentAllocate(false);
+}
+
+BENCHMARK_RELATIVE_MULTI(ConcurrentAllocateSmallReservationCache) {
+  return runConcurrentAllocate(true);
+}
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -130,6 +130,30 @@ class AsyncSource {
     return std::move(item_);
   }
 
+  // Drops the item. If the item is being made on the executor, waits for it to
+  // be made. If it has not started, it will not be made. Used when the owner
+  // of resources referenced by 'make' goes away. Must not be called while
+  // another thread waits in move().
+  void close() {
+    ContinueFuture wait;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      make_ = nullptr;
+      if (making_) {
+        VELOX_CHECK_NULL(promise_);
+        promise_ = std::make_unique<ContinuePromise>();
+        wait = promise_->getSemiFuture();
+      }
+    }
+    if (wait.valid()) {
+      auto& exec = folly::QueuedImmediateExecutor::instance();
+      std::move(wait).via(&exec).wait();
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    item_.reset();
+    exception_ = nullptr;
+  }
+
   // If true, move() will not block. But there is no guarantee that somebody
   // else will not get the item first.
   bool hasValue() const {
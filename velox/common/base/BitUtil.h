@@ -28,6 +28,10 @@
 #include <x86intrin.h>
 #endif
 
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
 namespace facebook {
 namespace velox {
 namespace bits {
@@ -317,17 +321,49 @@ inline void fillBits(uint64_t* bits, int32_t begin, int32_t end, bool value) {
       [bits, value](int32_t idx) { bits[idx] = value ? -1 : 0; });
 }
 
+namespace detail {
+// Returns the number of set bits in words [beginWord, endWord) of 'bits'.
+// Counts 8 words at a time with VPOPCNTQ if compiled for it.
+inline int32_t
+countBitsInWords(const uint64_t* bits, int32_t beginWord, int32_t endWord) {
+  int64_t count = 0;
+  auto i = beginWord;
+#ifdef __AVX512VPOPCNTDQ__
+  auto counts = _mm512_setzero_si512();
+  for (; i + 8 <= endWord; i += 8) {
+    counts = _mm512_add_epi64(
+        counts, _mm512_popcnt_epi64(_mm512_loadu_si512(bits + i)));
+  }
+  count = _mm512_reduce_add_epi64(counts);
+#endif
+  for (; i < endWord; ++i) {
+    count += __builtin_popcountll(bits[i]);
+  }
+  return count;
+}
+} // namespace detail
+
 inline int32_t countBits(const uint64_t* bits, int32_t begin, int32_t end) {
+  if (begin >= end) {
+    return 0;
+  }
+  const int32_t firstWord = roundUp(begin, 64);
+  const int32_t lastWord = end & ~63L;
+  if (lastWord < firstWord) {
+    return __builtin_popcountll(
+        bits[lastWord / 64] &
+        (lowMask(end - lastWord) & highMask(firstWord - begin)));
+  }
   int32_t count = 0;
-  forEachWord(
-      begin,
-      end,
-      [&count, bits](int32_t idx, uint64_t mask) {
-        count += __builtin_popcountll(bits[idx] & mask);
-      },
-      [&count, bits](int32_t idx) {
-        count += __builtin_popcountll(bits[idx]);
-      });
+  if (begin != firstWord) {
+    count += __builtin_popcountll(
+        bits[begin / 64] & highMask(firstWord - begin));
+  }
+  count += detail::countBitsInWords(bits, firstWord / 64, lastWord / 64);
+  if (end != lastWord) {
+    count +=
+        __builtin_popcountll(bits[lastWord / 64] & lowMask(end - lastWord));
+  }
   return count;
 }
 
@@ -546,6 +582,103 @@ findLastUnsetBit(const uint64_t* bits, int32_t begin, int32_t end) {
   return findLastBit(bits, begin, end, false);
 }
 
+namespace detail {
+template <bool isOr, bool negate>
+inline uint64_t combineWords(uint64_t left, uint64_t right) {
+  const uint64_t rightWord = negate ? ~right : right;
+  return isOr ? left | rightWord : left & rightWord;
+}
+
+#if defined(__AVX512F__)
+template <bool isOr, bool negate>
+inline __m512i combineWords(__m512i left, __m512i right) {
+  if constexpr (negate) {
+    // left | ~right as a ternary function of (left, right, right).
+    return isOr ? _mm512_ternarylogic_epi64(left, right, right, 0xf3)
+                : _mm512_andnot_si512(right, left);
+  } else {
+    return isOr ? _mm512_or_si512(left, right) : _mm512_and_si512(left, right);
+  }
+}
+#elif defined(__AVX2__)
+template <bool isOr, bool negate>
+inline __m256i combineWords(__m256i left, __m256i right) {
+  if constexpr (negate) {
+    if constexpr (isOr) {
+      return _mm256_or_si256(
+          left, _mm256_xor_si256(right, _mm256_set1_epi64x(-1)));
+    }
+    return _mm256_andnot_si256(right, left);
+  } else {
+    return isOr ? _mm256_or_si256(left, right) : _mm256_and_si256(left, right);
+  }
+}
+#endif
+
+// Sets words [beginWord, endWord) of 'target' to the AND or OR of the words
+// of 'left' and of 'right' or its negation. Uses 512 or 256 bit registers if
+// compiled for AVX-512 or AVX2. 'target' may be 'left'.
+template <bool isOr, bool negate>
+inline void combineWordRange(
+    uint64_t* target,
+    const uint64_t* left,
+    const uint64_t* right,
+    int32_t beginWord,
+    int32_t endWord) {
+  auto i = beginWord;
+#if defined(__AVX512F__)
+  for (; i + 8 <= endWord; i += 8) {
+    _mm512_storeu_si512(
+        target + i,
+        combineWords<isOr, negate>(
+            _mm512_loadu_si512(left + i), _mm512_loadu_si512(right + i)));
+  }
+#elif defined(__AVX2__)
+  for (; i + 4 <= endWord; i += 4) {
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(target + i),
+        combineWords<isOr, negate>(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i))));
+  }
+#endif
+  for (; i < endWord; ++i) {
+    target[i] = combineWords<isOr, negate>(left[i], right[i]);
+  }
+}
+
+template <bool isOr, bool negate>
+inline void combineRange(
+    uint64_t* target,
+    const uint64_t* left,
+    const uint64_t* right,
+    int32_t begin,
+    int32_t end) {
+  if (begin >= end) {
+    return;
+  }
+  auto partialWord = [&](int32_t idx, uint64_t mask) {
+    target[idx] = (target[idx] & ~mask) |
+        (mask & combineWords<isOr, negate>(left[idx], right[idx]));
+  };
+  const int32_t firstWord = roundUp(begin, 64);
+  const int32_t lastWord = end & ~63L;
+  if (lastWord < firstWord) {
+    partialWord(
+        lastWord / 64, lowMask(end - lastWord) & highMask(firstWord - begin));
+    return;
+  }
+  if (begin != firstWord) {
+    partialWord(begin / 64, highMask(firstWord - begin));
+  }
+  combineWordRange<isOr, negate>(
+      target, left, right, firstWord / 64, lastWord / 64);
+  if (end != lastWord) {
+    partialWord(lastWord / 64, lowMask(end - lastWord));
+  }
+}
+} // namespace detail
+
 template <bool negate>
 inline void andRange(
     uint64_t* target,
@@ -553,16 +686,7 @@ inline void andRange(
     const uint64_t* right,
     int32_t begin,
     int32_t end) {
-  forEachWord(
-      begin,
-      end,
-      [target, left, right](int32_t idx, uint64_t mask) {
-        target[idx] = (target[idx] & ~mask) |
-            (mask & left[idx] & (negate ? ~right[idx] : right[idx]));
-      },
-      [target, left, right](int32_t idx) {
-        target[idx] = left[idx] & (negate ? ~right[idx] : right[idx]);
-      });
+  detail::combineRange<false, negate>(target, left, right, begin, end);
 }
 
 template <bool negate>
@@ -572,16 +696,7 @@ inline void orRange(
     const uint64_t* right,
     int32_t begin,
     int32_t end) {
-  forEachWord(
-      begin,
-      end,
-      [target, left, right](int32_t idx, uint64_t mask) {
-        target[idx] = (target[idx] & ~mask) |
-            (mask & (left[idx] | (negate ? ~right[idx] : right[idx])));
-      },
-      [target, left, right](int32_t idx) {
-        target[idx] = left[idx] | (negate ? ~right[idx] : right[idx]);
-      });
+  detail::combineRange<true, negate>(target, left, right, begin, end);
 }
 
 // Bit-wise AND: target = left AND right
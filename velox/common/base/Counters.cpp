@@ -46,6 +46,24 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricCacheShrinkTimeMs, 10'000, 0, 100'000, 50, 90, 99, 100);
 
+  // Tracks the latency of reads from SSD cache files in range of [0, 100ms]
+  // with 20 buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricSsdCacheReadLatencyUs, 5'000, 0, 100'000, 50, 90, 99, 100);
+
+  // Tracks the latency of reads from storage on cache misses in range of [0,
+  // 10s] with 100 buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricStorageReadLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+
+  /// ================== Exchange Counters =================
+
+  // Tracks the time from sending a request to an exchange source to receiving
+  // the response in range of [0, 10s] with 100 buckets and reports P50, P90,
+  // P99, and P100. Includes the time the source waits for data to arrive.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricExchangeRequestLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+
   /// ================== Memory Arbitration Counters =================
 
   // Tracks memory reclaim exec time in range of [0, 600s] with 20 buckets and
@@ -98,6 +116,17 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricArbitratorQueueTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
 
+  // The distribution of the amount of time to acquire the arbitrator lock in
+  // range of [0, 100ms] with 20 buckets. It is configured to report the
+  // latency at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorLockWaitTimeUs, 5'000, 0, 100'000, 50, 90, 99, 100);
+
+  // The number of memory pool capacity growths from the free capacity of the
+  // arbitrator which bypass the serialized memory arbitration.
+  DEFINE_METRIC(
+      kMetricArbitratorFastGrowCount, facebook::velox::StatType::COUNT);
+
   // The distribution of the amount of time it take to complete a single
   // arbitration request stays queued in range of [0, 600s] with 20
   // buckets. It is configured to report the latency at P50, P90, P99,
@@ -168,8 +197,34 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricSpillWriteTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
 
+  // The number of spill reads from storage, which is the number of read calls
+  // to velox filesystem.
+  DEFINE_METRIC(kMetricSpillReadsCount, facebook::velox::StatType::COUNT);
+
+  // The number of bytes read from spilled files.
+  DEFINE_METRIC(kMetricSpillReadBytes, facebook::velox::StatType::SUM);
+
+  // The distribution of the amount of time spent on reading spilled data from
+  // disk in range of [0, 600s] with 20 buckets. It is configured to report the
+  // latency at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricSpillReadTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
+
+  // The distribution of the amount of time spent on deserializing spilled rows
+  // read from disk in range of [0, 600s] with 20 buckets. It is configured to
+  // report the latency at P50, P90, P99, and P100 percentiles. Note: If
+  // compression is enabled, this includes the decompression time.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricSpillDeserializationTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
+
   // Tracks the number of times that we hit the max spill level limit.
   DEFINE_METRIC(
       kMetricMaxSpillLevelExceededCount, facebook::velox::StatType::COUNT);
+
+  // Tracks the bytes decompressed by the registered decompression offload
+  // backend and on CPU.
+  DEFINE_METRIC(
+      kMetricDecompressOffloadedBytes, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(kMetricDecompressCpuBytes, facebook::velox::StatType::SUM);
 }
 } // namespace facebook::velox
@@ -31,6 +31,21 @@ constexpr folly::StringPiece kMetricCacheShrinkCount{
 
 constexpr folly::StringPiece kMetricCacheShrinkTimeMs{"velox.cache_shrink_ms"};
 
+constexpr folly::StringPiece kMetricSsdCacheReadLatencyUs{
+    "velox.ssd_cache_read_latency_us"};
+
+constexpr folly::StringPiece kMetricStorageReadLatencyMs{
+    "velox.storage_read_latency_ms"};
+
+constexpr folly::StringPiece kMetricExchangeRequestLatencyMs{
+    "velox.exchange_request_latency_ms"};
+
+constexpr folly::StringPiece kMetricDecompressOffloadedBytes{
+    "velox.decompress_offloaded_bytes"};
+
+constexpr folly::StringPiece kMetricDecompressCpuBytes{
+    "velox.decompress_cpu_bytes"};
+
 constexpr folly::StringPiece kMetricMaxSpillLevelExceededCount{
     "velox.spill_max_level_exceeded_count"};
 
@@ -67,6 +82,12 @@ constexpr folly::StringPiece kMetricArbitratorFailuresCount{
 constexpr folly::StringPiece kMetricArbitratorQueueTimeMs{
     "velox.arbitrator_queue_time_ms"};
 
+constexpr folly::StringPiece kMetricArbitratorLockWaitTimeUs{
+    "velox.arbitrator_lock_wait_time_us"};
+
+constexpr folly::StringPiece kMetricArbitratorFastGrowCount{
+    "velox.arbitrator_fast_grow_count"};
+
 constexpr folly::StringPiece kMetricArbitratorArbitrationTimeMs{
     "velox.arbitrator_arbitration_time_ms"};
 
@@ -101,4 +122,13 @@ constexpr folly::StringPiece kMetricSpillFlushTimeMs{
 
 constexpr folly::StringPiece kMetricSpillWriteTimeMs{
     "velox.spill_write_time_ms"};
+
+constexpr folly::StringPiece kMetricSpillReadsCount{"velox.spill_reads_count"};
+
+constexpr folly::StringPiece kMetricSpillReadBytes{"velox.spill_read_bytes"};
+
+constexpr folly::StringPiece kMetricSpillReadTimeMs{"velox.spill_read_time_ms"};
+
+constexpr folly::StringPiece kMetricSpillDeserializationTimeMs{
+    "velox.spill_deserialization_time_ms"};
 } // namespace facebook::velox
@@ -16,22 +16,89 @@
 
 #include <folly/ThreadLocal.h>
 
+#include <cmath>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/SuccinctPrinter.h"
 
 namespace facebook::velox {
 
+// static
+int32_t RuntimeHistogram::bucketIndex(int64_t value) {
+  if (value < kNumSubBuckets) {
+    return std::max<int64_t>(value, 0);
+  }
+  const int32_t shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+  return kNumSubBuckets * (shift + 1) +
+      ((value >> shift) & (kNumSubBuckets - 1));
+}
+
+// static
+int64_t RuntimeHistogram::bucketLowerBound(int32_t index) {
+  if (index < kNumSubBuckets) {
+    return index;
+  }
+  const int32_t shift = index / kNumSubBuckets - 1;
+  return static_cast<int64_t>(kNumSubBuckets + index % kNumSubBuckets)
+      << shift;
+}
+
+void RuntimeHistogram::add(int64_t value) {
+  const auto index = bucketIndex(value);
+  if (index >= buckets_.size()) {
+    buckets_.resize(index + 1);
+  }
+  ++buckets_[index];
+  ++count_;
+}
+
+void RuntimeHistogram::merge(const RuntimeHistogram& other) {
+  if (other.buckets_.size() > buckets_.size()) {
+    buckets_.resize(other.buckets_.size());
+  }
+  for (auto i = 0; i < other.buckets_.size(); ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+}
+
+int64_t RuntimeHistogram::percentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const auto rank = std::max<int64_t>(
+      1, static_cast<int64_t>(std::ceil(percentile / 100 * count_)));
+  int64_t numBelow = 0;
+  for (auto i = 0; i < buckets_.size(); ++i) {
+    numBelow += buckets_[i];
+    if (numBelow >= rank) {
+      return i + 1 == kNumBuckets ? std::numeric_limits<int64_t>::max()
+                                  : bucketLowerBound(i + 1) - 1;
+    }
+  }
+  return std::numeric_limits<int64_t>::max();
+}
+
 void RuntimeMetric::addValue(int64_t value) {
   sum += value;
   count++;
   min = std::min(min, value);
   max = std::max(max, value);
+  if (histogram.has_value()) {
+    histogram->add(value);
+  }
+}
+
+int64_t RuntimeMetric::percentile(double percentile) const {
+  VELOX_CHECK(histogram.has_value());
+  return std::min(histogram->percentile(percentile), max);
 }
 
 void RuntimeMetric::aggregate() {
   count = std::min(count, static_cast<int64_t>(1));
   min = max = sum;
+  histogram.reset();
 }
 
 void RuntimeMetric::merge(const RuntimeMetric& other)
@@ -46,6 +113,10 @@ void RuntimeMetric::merge(const RuntimeMetric& other)
   count += other.count;
   min = std::min(min, other.min);
   max = std::max(max, other.max);
+  if (other.histogram.has_value()) {
+    enableHistogram();
+    histogram->merge(*other.histogram);
+  }
 }
 
 void RuntimeMetric::printMetric(std::stringstream& stream) const {
@@ -65,6 +136,24 @@ void RuntimeMetric::printMetric(std::stringstream& stream) const {
       stream << " sum: " << sum << ", count: " << count << ", min: " << min
              << ", max: " << max;
   }
+  if (!histogram.has_value() || histogram->count() == 0) {
+    return;
+  }
+  const auto p50 = percentile(50);
+  const auto p99 = percentile(99);
+  switch (unit) {
+    case RuntimeCounter::Unit::kNanos:
+      stream << ", p50: " << succinctNanos(p50)
+             << ", p99: " << succinctNanos(p99);
+      break;
+    case RuntimeCounter::Unit::kBytes:
+      stream << ", p50: " << succinctBytes(p50)
+             << ", p99: " << succinctBytes(p99);
+      break;
+    case RuntimeCounter::Unit::kNone:
+    default:
+      stream << ", p50: " << p50 << ", p99: " << p99;
+  }
 }
 
 // Thread local runtime stat writers.
@@ -19,7 +19,9 @@
 #include <fmt/format.h>
 #include <folly/CppAttributes.h>
 #include <limits>
+#include <optional>
 #include <sstream>
+#include <vector>
 
 namespace facebook::velox {
 
@@ -27,9 +29,56 @@ struct RuntimeCounter {
   enum class Unit { kNone, kNanos, kBytes };
   int64_t value;
   Unit unit{Unit::kNone};
+  // If true, the RuntimeMetric that 'this' is added to keeps a histogram of
+  // the values to report percentiles.
+  bool histogram{false};
 
   explicit RuntimeCounter(int64_t _value, Unit _unit = Unit::kNone)
       : value(_value), unit(_unit) {}
+
+  /// Returns a counter whose RuntimeMetric reports percentiles, e.g. for
+  /// latencies where the tail matters more than the average.
+  static RuntimeCounter withHistogram(int64_t value, Unit unit) {
+    RuntimeCounter counter(value, unit);
+    counter.histogram = true;
+    return counter;
+  }
+};
+
+/// Log-linear histogram of non-negative values. Values below
+/// 2^kSubBucketBits are counted exactly. Each larger power of two is split
+/// into 2^kSubBucketBits buckets of equal width, so that the width of a
+/// bucket is at most 1/8 of its values. Buckets are allocated up to the
+/// largest value added, which takes a few hundred bytes for latencies in
+/// nanoseconds. Histograms are merged by adding the counts of the buckets.
+class RuntimeHistogram {
+ public:
+  void add(int64_t value);
+
+  void merge(const RuntimeHistogram& other);
+
+  /// Returns the largest value of the bucket that contains the value at
+  /// 'percentile', which is in [0, 100]. Returns 0 if empty.
+  int64_t percentile(double percentile) const;
+
+  int64_t count() const {
+    return count_;
+  }
+
+  static int32_t bucketIndex(int64_t value);
+
+  /// Returns the smallest value that falls into bucket 'index'.
+  static int64_t bucketLowerBound(int32_t index);
+
+ private:
+  static constexpr int32_t kSubBucketBits = 3;
+  static constexpr int32_t kNumSubBuckets = 1 << kSubBucketBits;
+  // Enough buckets for std::numeric_limits<int64_t>::max().
+  static constexpr int32_t kNumBuckets =
+      kNumSubBuckets * (64 - kSubBucketBits);
+
+  std::vector<int64_t> buckets_;
+  int64_t count_{0};
 };
 
 struct RuntimeMetric {
@@ -39,6 +88,8 @@ struct RuntimeMetric {
   int64_t count{0};
   int64_t min{std::numeric_limits<int64_t>::max()};
   int64_t max{std::numeric_limits<int64_t>::min()};
+  // Set if the percentiles of the values are reported.
+  std::optional<RuntimeHistogram> histogram;
 
   explicit RuntimeMetric(
       RuntimeCounter::Unit _unit = RuntimeCounter::Unit::kNone)
@@ -51,8 +102,19 @@ struct RuntimeMetric {
 
   void addValue(int64_t value);
 
+  /// Keeps a histogram of the values added after this call.
+  void enableHistogram() {
+    if (!histogram.has_value()) {
+      histogram.emplace();
+    }
+  }
+
+  /// Returns the value at 'percentile' in [0, 100], within the precision of
+  /// the histogram and at most 'max'. The histogram must be enabled.
+  int64_t percentile(double percentile) const;
+
   /// Aggregate sets 'min' and 'max' to 'sum', also sets 'count' to 1 if
-  /// positive.
+  /// positive. The histogram is dropped.
   void aggregate();
 
   void printMetric(std::stringstream& stream) const;
@@ -60,8 +122,13 @@ struct RuntimeMetric {
   void merge(const RuntimeMetric& other);
 
   std::string toString() const {
-    return fmt::format(
-        "sum:{}, count:{}, min:{}, max:{}", sum, count, min, max);
+    auto result =
+        fmt::format("sum:{}, count:{}, min:{}, max:{}", sum, count, min, max);
+    if (histogram.has_value() && histogram->count() > 0) {
+      result += fmt::format(
+          ", p50:{}, p99:{}", percentile(50), percentile(99));
+    }
+    return result;
   }
 };
 
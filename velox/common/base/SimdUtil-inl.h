@@ -218,6 +218,26 @@ int32_t indicesOfSetBits(
       } while (word);
       row += 64;
     } else {
+#if XSIMD_WITH_AVX512F
+      if constexpr (std::is_base_of_v<xsimd::avx512f, A>) {
+        // Writes the indices of the set bits of 16 bits at a time with
+        // VPCOMPRESSD.
+        const auto offsets = _mm512_setr_epi32(
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        for (auto i = 0; i < 4; ++i) {
+          const uint16_t mask = word >> (i * 16);
+          if (mask) {
+            _mm512_mask_compressstoreu_epi32(
+                result,
+                mask,
+                _mm512_add_epi32(offsets, _mm512_set1_epi32(row)));
+            result += __builtin_popcount(mask);
+          }
+          row += 16;
+        }
+        continue;
+      }
+#endif
       for (auto byteCnt = 0; byteCnt < 8; ++byteCnt) {
         uint8_t byte = word;
         word = word >> 8;
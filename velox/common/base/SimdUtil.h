@@ -488,6 +488,52 @@ inline bool isDense(const T* values, int32_t size) {
   return (values[size - 1] - values[0] == size - 1);
 }
 
+// Sets 'result[i]' to 'op(args[i]...)' for i in [0, size). 'op' is called
+// with batches of the arguments and with single values for the tail, e.g. a
+// generic lambda. The arguments must have the width of T. 'result' may be
+// the same as an argument. Types without SIMD registers are done one value
+// at a time.
+template <typename T, typename Op, typename... TArgs>
+inline void transform(Op op, int32_t size, T* result, const TArgs*... args) {
+  static_assert(((sizeof(TArgs) == sizeof(T)) && ...));
+  int32_t i = 0;
+  if constexpr (xsimd::has_simd_register<T>::value) {
+    constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      const xsimd::batch<T> batch =
+          op(xsimd::batch<TArgs>::load_unaligned(args + i)...);
+      batch.store_unaligned(result + i);
+    }
+  }
+  for (; i < size; ++i) {
+    result[i] = op(args[i]...);
+  }
+}
+
+// Sets bit i of 'result' to 'op(args[i]...)' for i in [0, size). 'op' is
+// called with batches of the arguments to get a batch_bool and with single
+// values for the tail. The arguments must all have the width of T.
+template <typename T, typename Op, typename... TArgs>
+inline void
+transformToBits(Op op, int32_t size, uint64_t* result, const TArgs*... args) {
+  static_assert(((sizeof(TArgs) == sizeof(T)) && ...));
+  int32_t i = 0;
+  if constexpr (xsimd::has_simd_register<T>::value) {
+    constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      const uint64_t mask =
+          toBitMask(op(xsimd::batch<TArgs>::load_unaligned(args + i)...));
+      if (i % 64 == 0) {
+        result[i / 64] = 0;
+      }
+      result[i / 64] |= mask << (i % 64);
+    }
+  }
+  for (; i < size; ++i) {
+    bits::setBit(result, i, op(args[i]...));
+  }
+}
+
 // Reinterpret batch of U into batch of T.
 template <typename T, typename U, typename A = xsimd::default_arch>
 xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
@@ -35,7 +35,10 @@ SpillConfig::SpillConfig(
     uint64_t _writerFlushThresholdSize,
     int32_t _testSpillPct,
     const std::string& _compressionKind,
-    const std::string& _fileCreateConfig)
+    const std::string& _fileCreateConfig,
+    std::optional<PrefixSortConfig> _prefixSortConfig,
+    uint64_t _readAheadBytes,
+    uint32_t _maxMergeFanIn)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -54,11 +57,16 @@ SpillConfig::SpillConfig(
       writerFlushThresholdSize(_writerFlushThresholdSize),
       testSpillPct(_testSpillPct),
       compressionKind(common::stringToCompressionKind(_compressionKind)),
-      fileCreateConfig(_fileCreateConfig) {
+      fileCreateConfig(_fileCreateConfig),
+      prefixSortConfig(_prefixSortConfig),
+      readAheadBytes(_readAheadBytes),
+      maxMergeFanIn(_maxMergeFanIn) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
       "Spillable memory reservation growth pct should not be lower than minimum available pct");
+  VELOX_USER_CHECK_NE(
+      maxMergeFanIn, 1, "Max spill merge fan-in should be zero or at least 2");
 }
 
 int32_t SpillConfig::joinSpillLevel(uint8_t startBitOffset) const {
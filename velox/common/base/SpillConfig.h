@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
@@ -62,7 +63,10 @@ struct SpillConfig {
       uint64_t _writerFlushThresholdSize,
       int32_t _testSpillPct,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
+      uint64_t _readAheadBytes = 0,
+      uint32_t _maxMergeFanIn = 0);
 
   /// Returns the hash join spilling level with given 'startBitOffset'.
   ///
@@ -146,5 +150,19 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// Prefix-sort config used to sort the spill runs. If not set, the spill
+  /// runs are sorted by comparing the rows in the row container.
+  std::optional<PrefixSortConfig> prefixSortConfig;
+
+  /// The max bytes of the batches read ahead from spill files on 'executor'
+  /// when merging sorted spill runs. 0 means no read ahead.
+  uint64_t readAheadBytes{0};
+
+  /// The max number of sorted spill runs merged at a time. If a spill has more
+  /// runs, groups of them are merged into longer runs first, in as many levels
+  /// as needed. This bounds the merge streams and their read buffers held in
+  /// memory at once. 0 means no limit.
+  uint32_t maxMergeFanIn{0};
 };
 } // namespace facebook::velox::common
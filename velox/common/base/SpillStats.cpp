@@ -77,6 +77,12 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillFlushTimeUs += other.spillFlushTimeUs;
   spillWriteTimeUs += other.spillWriteTimeUs;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
+  spillReads += other.spillReads;
+  spillReadBytes += other.spillReadBytes;
+  spillReadTimeUs += other.spillReadTimeUs;
+  spillDeserializationTimeUs += other.spillDeserializationTimeUs;
+  spillMergeLevels += other.spillMergeLevels;
+  spillMergeRuns += other.spillMergeRuns;
   return *this;
 }
 
@@ -97,6 +103,13 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWriteTimeUs = spillWriteTimeUs - other.spillWriteTimeUs;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
+  result.spillReads = spillReads - other.spillReads;
+  result.spillReadBytes = spillReadBytes - other.spillReadBytes;
+  result.spillReadTimeUs = spillReadTimeUs - other.spillReadTimeUs;
+  result.spillDeserializationTimeUs =
+      spillDeserializationTimeUs - other.spillDeserializationTimeUs;
+  result.spillMergeLevels = spillMergeLevels - other.spillMergeLevels;
+  result.spillMergeRuns = spillMergeRuns - other.spillMergeRuns;
   return result;
 }
 
@@ -125,6 +138,12 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillFlushTimeUs);
   UPDATE_COUNTER(spillWriteTimeUs);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
+  UPDATE_COUNTER(spillReads);
+  UPDATE_COUNTER(spillReadBytes);
+  UPDATE_COUNTER(spillReadTimeUs);
+  UPDATE_COUNTER(spillDeserializationTimeUs);
+  UPDATE_COUNTER(spillMergeLevels);
+  UPDATE_COUNTER(spillMergeRuns);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -160,7 +179,13 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillWrites,
              spillFlushTimeUs,
              spillWriteTimeUs,
-             spillMaxLevelExceededCount) ==
+             spillMaxLevelExceededCount,
+             spillReads,
+             spillReadBytes,
+             spillReadTimeUs,
+             spillDeserializationTimeUs,
+             spillMergeLevels,
+             spillMergeRuns) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -174,7 +199,13 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillWrites,
              other.spillFlushTimeUs,
              other.spillWriteTimeUs,
-             spillMaxLevelExceededCount);
+             spillMaxLevelExceededCount,
+             other.spillReads,
+             other.spillReadBytes,
+             other.spillReadTimeUs,
+             other.spillDeserializationTimeUs,
+             other.spillMergeLevels,
+             other.spillMergeRuns);
 }
 
 void SpillStats::reset() {
@@ -191,11 +222,17 @@ void SpillStats::reset() {
   spillFlushTimeUs = 0;
   spillWriteTimeUs = 0;
   spillMaxLevelExceededCount = 0;
+  spillReads = 0;
+  spillReadBytes = 0;
+  spillReadTimeUs = 0;
+  spillDeserializationTimeUs = 0;
+  spillMergeLevels = 0;
+  spillMergeRuns = 0;
 }
 
 std::string SpillStats::toString() const {
   return fmt::format(
-      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}]",
+      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}] spillReads[{}] spillReadBytes[{}] spillReadTime[{}] spillDeserializationTime[{}] spillMergeLevels[{}] spillMergeRuns[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
@@ -208,7 +245,13 @@ std::string SpillStats::toString() const {
       spillWrites,
       succinctMicros(spillFlushTimeUs),
       succinctMicros(spillWriteTimeUs),
-      spillMaxLevelExceededCount);
+      spillMaxLevelExceededCount,
+      spillReads,
+      succinctBytes(spillReadBytes),
+      succinctMicros(spillReadTimeUs),
+      succinctMicros(spillDeserializationTimeUs),
+      spillMergeLevels,
+      spillMergeRuns);
 }
 
 void updateGlobalSpillRunStats(uint64_t numRuns) {
@@ -256,6 +299,24 @@ void updateGlobalSpillWriteStats(
   statsLocked->spillWriteTimeUs += writeTimeUs;
 }
 
+void updateGlobalSpillReadStats(
+    uint64_t spillReads,
+    uint64_t spillReadBytes,
+    uint64_t spillReadTimeUs,
+    uint64_t spillDeserializationTimeUs) {
+  RECORD_METRIC_VALUE(kMetricSpillReadsCount, spillReads);
+  RECORD_METRIC_VALUE(kMetricSpillReadBytes, spillReadBytes);
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricSpillReadTimeMs, spillReadTimeUs / 1'000);
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricSpillDeserializationTimeMs, spillDeserializationTimeUs / 1'000);
+  auto statsLocked = localSpillStats().wlock();
+  statsLocked->spillReads += spillReads;
+  statsLocked->spillReadBytes += spillReadBytes;
+  statsLocked->spillReadTimeUs += spillReadTimeUs;
+  statsLocked->spillDeserializationTimeUs += spillDeserializationTimeUs;
+}
+
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes) {
   RECORD_METRIC_VALUE(kMetricSpilledInputBytes, spilledInputBytes);
   auto statsLocked = localSpillStats().wlock();
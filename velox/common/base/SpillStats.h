@@ -55,6 +55,26 @@ struct SpillStats {
   /// The number of times that an hash build operator exceeds the max spill
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
+  /// The number of reads from spill files.
+  uint64_t spillReads{0};
+  /// The number of bytes read from spill files.
+  ///
+  /// NOTE: if compression is enabled, this counts the compressed bytes.
+  uint64_t spillReadBytes{0};
+  /// The time spent on reading from spill files.
+  uint64_t spillReadTimeUs{0};
+  /// The time spent on deserializing the rows read from spill files. If
+  /// compression is enabled, this includes the decompression time.
+  uint64_t spillDeserializationTimeUs{0};
+  /// The number of levels of merges that combined sorted spill runs into
+  /// longer runs before the final merge because of the max merge fan-in.
+  ///
+  /// NOTE: when we sum up the stats from a group of spill operators, it is
+  /// the total number of merge levels of all the operators.
+  uint64_t spillMergeLevels{0};
+  /// The number of sorted spill runs written by the merges counted in
+  /// 'spillMergeLevels'.
+  uint64_t spillMergeRuns{0};
 
   SpillStats(
       uint64_t _spillRuns,
@@ -126,6 +146,15 @@ void updateGlobalSpillWriteStats(
     uint64_t flushTimeUs,
     uint64_t writeTimeUs);
 
+/// Updates the stats for spill file reads including the number of reads, the
+/// read bytes, the time spent on reads and the time spent on deserializing the
+/// read data.
+void updateGlobalSpillReadStats(
+    uint64_t spillReads,
+    uint64_t spillReadBytes,
+    uint64_t spillReadTimeUs,
+    uint64_t spillDeserializationTimeUs);
+
 /// Increment the spill memory bytes.
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes);
 
@@ -20,6 +20,7 @@
 #include <optional>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 DECLARE_bool(bmi2); // NOLINT
 
 namespace facebook {
@@ -186,6 +187,99 @@ BENCHMARK_RELATIVE_MULTI(forEachBitFirstBitFalse) {
   return kNumRuns;
 }
 
+// Bitmaps of 'numBits' bits with about 'pctSet'% of bits set. The ranges
+// start at bit 3 so that the first and last words are partial.
+struct Bitmaps {
+  explicit Bitmaps(int32_t pctSet)
+      : left(bits::nwords(numBits)),
+        right(bits::nwords(numBits)),
+        target(bits::nwords(numBits)),
+        indices(numBits + simd::kPadding) {
+    for (auto i = 0; i < numBits; ++i) {
+      bits::setBit(left.data(), i, (i * 7'919) % 100 < pctSet);
+      bits::setBit(right.data(), i, (i * 104'729) % 100 < pctSet);
+    }
+  }
+
+  std::vector<uint64_t> left;
+  std::vector<uint64_t> right;
+  std::vector<uint64_t> target;
+  std::vector<int32_t> indices;
+};
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(andBits) {
+  folly::BenchmarkSuspender suspender;
+  Bitmaps bitmaps(50);
+  suspender.dismiss();
+  for (auto i = 0; i < kNumRuns; ++i) {
+    bits::andBits(
+        bitmaps.target.data(),
+        bitmaps.left.data(),
+        bitmaps.right.data(),
+        3,
+        numBits);
+    folly::doNotOptimizeAway(bitmaps.target);
+  }
+  return kNumRuns;
+}
+
+BENCHMARK_MULTI(orWithNegatedBits) {
+  folly::BenchmarkSuspender suspender;
+  Bitmaps bitmaps(50);
+  suspender.dismiss();
+  for (auto i = 0; i < kNumRuns; ++i) {
+    bits::orWithNegatedBits(
+        bitmaps.target.data(),
+        bitmaps.left.data(),
+        bitmaps.right.data(),
+        3,
+        numBits);
+    folly::doNotOptimizeAway(bitmaps.target);
+  }
+  return kNumRuns;
+}
+
+BENCHMARK_MULTI(countBits) {
+  folly::BenchmarkSuspender suspender;
+  Bitmaps bitmaps(50);
+  suspender.dismiss();
+  int32_t count = 0;
+  for (auto i = 0; i < kNumRuns; ++i) {
+    count += bits::countBits(bitmaps.left.data(), 3, numBits);
+  }
+  folly::doNotOptimizeAway(count);
+  return kNumRuns;
+}
+
+void BM_indicesOfSetBits(uint32_t iterations, int32_t pctSet) {
+  folly::BenchmarkSuspender suspender;
+  Bitmaps bitmaps(pctSet);
+  suspender.dismiss();
+  int32_t count = 0;
+  for (uint32_t i = 0; i < iterations; ++i) {
+    count += simd::indicesOfSetBits(
+        bitmaps.left.data(), 3, numBits, bitmaps.indices.data());
+  }
+  folly::doNotOptimizeAway(count);
+}
+
+BENCHMARK_MULTI(indicesOfSetBits90Pct) {
+  BM_indicesOfSetBits(kNumRuns, 90);
+  return kNumRuns;
+}
+
+BENCHMARK_MULTI(indicesOfSetBits50Pct) {
+  BM_indicesOfSetBits(kNumRuns, 50);
+  return kNumRuns;
+}
+
+BENCHMARK_MULTI(indicesOfSetBits10Pct) {
+  BM_indicesOfSetBits(kNumRuns, 10);
+  return kNumRuns;
+}
+
 } // namespace test
 } // namespace velox
 } // namespace facebook
@@ -47,6 +47,37 @@ TEST(AsyncSourceTest, basic) {
   EXPECT_TRUE(error.hasValue());
 }
 
+TEST(AsyncSourceTest, close) {
+  // A Gizmo that is not started is not made.
+  int32_t numMade = 0;
+  AsyncSource<Gizmo> notStarted([&]() {
+    ++numMade;
+    return std::make_unique<Gizmo>(1);
+  });
+  notStarted.close();
+  notStarted.prepare();
+  EXPECT_EQ(nullptr, notStarted.move());
+  EXPECT_EQ(0, numMade);
+
+  // close() waits for a Gizmo being made.
+  std::atomic<bool> started{false};
+  std::atomic<bool> made{false};
+  AsyncSource<Gizmo> making([&]() {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // NOLINT
+    made = true;
+    return std::make_unique<Gizmo>(2);
+  });
+  std::thread thread([&]() { making.prepare(); });
+  while (!started) {
+    std::this_thread::yield();
+  }
+  making.close();
+  EXPECT_TRUE(made);
+  EXPECT_FALSE(making.hasValue());
+  thread.join();
+}
+
 TEST(AsyncSourceTest, threads) {
   constexpr int32_t kNumThreads = 10;
   constexpr int32_t kNumGizmos = 2000;
@@ -267,6 +267,71 @@ TEST_F(BitUtilTest, booleans) {
   EXPECT_FALSE(isBitSet(&result[0], 209) || isBitSet(&result[0], 222));
 }
 
+TEST_F(BitUtilTest, combineRanges) {
+  // 20 words so that the ranges cover full vector registers.
+  constexpr int32_t kNumWords = 20;
+  constexpr int32_t kNumBits = kNumWords * 64;
+  std::vector<uint64_t> left(kNumWords);
+  std::vector<uint64_t> right(kNumWords);
+  std::vector<uint64_t> initial(kNumWords);
+  for (auto i = 0; i < kNumWords; ++i) {
+    left[i] = 0x0123456789abcdef * (i + 1);
+    right[i] = 0xfedcba9876543210 ^ (left[i] << i);
+    initial[i] = 0x5555aaaa5555aaaa + i;
+  }
+  auto check = [&](auto op, auto expected, int32_t begin, int32_t end) {
+    auto result = initial;
+    op(result.data(), left.data(), right.data(), begin, end);
+    for (auto i = 0; i < kNumBits; ++i) {
+      const bool value = i >= begin && i < end
+          ? expected(isBitSet(left.data(), i), isBitSet(right.data(), i))
+          : isBitSet(initial.data(), i);
+      ASSERT_EQ(isBitSet(result.data(), i), value)
+          << "bit " << i << " of [" << begin << ", " << end << ")";
+    }
+  };
+  auto checkAll = [&](int32_t begin, int32_t end) {
+    check(
+        [](auto... args) { andRange<false>(args...); },
+        [](bool l, bool r) { return l && r; },
+        begin,
+        end);
+    check(
+        [](auto... args) { andRange<true>(args...); },
+        [](bool l, bool r) { return l && !r; },
+        begin,
+        end);
+    check(
+        [](auto... args) { orRange<false>(args...); },
+        [](bool l, bool r) { return l || r; },
+        begin,
+        end);
+    check(
+        [](auto... args) { orRange<true>(args...); },
+        [](bool l, bool r) { return l || !r; },
+        begin,
+        end);
+    // In place, the bits outside of the range keep the values of 'left'.
+    auto inPlace = left;
+    andRange<true>(inPlace.data(), inPlace.data(), right.data(), begin, end);
+    for (auto i = 0; i < kNumBits; ++i) {
+      const bool leftBit = isBitSet(left.data(), i);
+      const bool value = i >= begin && i < end
+          ? leftBit && !isBitSet(right.data(), i)
+          : leftBit;
+      ASSERT_EQ(isBitSet(inPlace.data(), i), value) << "bit " << i;
+    }
+    EXPECT_EQ(
+        countBits(left.data(), begin, end),
+        simpleCountBits(left.data(), begin, end));
+  };
+  for (auto begin : {0, 3, 64, 100}) {
+    for (auto end : {101, 500, 1000, kNumBits - 64, kNumBits - 1, kNumBits}) {
+      checkAll(begin, end);
+    }
+  }
+}
+
 TEST_F(BitUtilTest, testBits) {
   uint64_t data[] = {0x0, 0x0, 0x0, 0x0, 0x0};
   auto totalBits = sizeof(data) * 8;
@@ -73,4 +73,47 @@ TEST_F(RuntimeMetricsTest, basic) {
   testMetric(rm3, 0, 0, 0, 0);
 };
 
+TEST_F(RuntimeMetricsTest, histogram) {
+  for (int64_t value = 0; value < 100'000; ++value) {
+    const auto index = RuntimeHistogram::bucketIndex(value);
+    ASSERT_LE(RuntimeHistogram::bucketLowerBound(index), value);
+    ASSERT_GT(RuntimeHistogram::bucketLowerBound(index + 1), value);
+  }
+  ASSERT_GT(
+      RuntimeHistogram::bucketIndex(std::numeric_limits<int64_t>::max()),
+      RuntimeHistogram::bucketIndex(int64_t(1) << 62));
+
+  RuntimeMetric rm1(RuntimeCounter::Unit::kNanos);
+  rm1.enableHistogram();
+  for (auto i = 1; i <= 98; ++i) {
+    rm1.addValue(1'000 + i);
+  }
+  RuntimeMetric rm2(RuntimeCounter::Unit::kNanos);
+  rm2.enableHistogram();
+  rm2.addValue(1'000'000);
+  rm2.addValue(2'000'000);
+  rm1.merge(rm2);
+  testMetric(rm1, 98 * 1'000 + 98 * 99 / 2 + 3'000'000, 100, 1'001, 2'000'000);
+
+  // Percentiles are within 1/8 of the values.
+  ASSERT_GE(rm1.percentile(50), 1'050);
+  ASSERT_LE(rm1.percentile(50), 1'050 * 9 / 8);
+  ASSERT_GE(rm1.percentile(99), 1'000'000);
+  ASSERT_LE(rm1.percentile(99), 1'000'000 * 9 / 8);
+  ASSERT_EQ(rm1.percentile(100), 2'000'000);
+
+  std::stringstream stream;
+  rm1.printMetric(stream);
+  ASSERT_NE(stream.str().find(", p50: "), std::string::npos);
+  ASSERT_NE(rm1.toString().find(", p99:"), std::string::npos);
+
+  // A metric without histogram takes the histogram of a merged metric.
+  RuntimeMetric rm3(RuntimeCounter::Unit::kNanos);
+  rm3.merge(rm1);
+  ASSERT_EQ(rm3.percentile(99), rm1.percentile(99));
+
+  rm1.aggregate();
+  ASSERT_FALSE(rm1.histogram.has_value());
+}
+
 } // namespace facebook::velox
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/CachePolicy.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 
@@ -23,6 +24,10 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/compression/Compression.h"
+#include "velox/common/memory/MmapAllocator.h"
+
+#include <folly/executors/InlineExecutor.h>
 
 namespace facebook::velox::cache {
 
@@ -46,6 +51,10 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
+    // A prefetched entry is admitted at its first retrieval.
+    if (!isPrefetch_) {
+      shard_->admitLocked(*this);
+    }
   }
   if (promise != nullptr) {
     promise->setValue(true);
@@ -99,6 +108,7 @@ memory::MachinePageCount AsyncDataCacheEntry::setPrefetch(bool flag) {
 void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   VELOX_CHECK(isExclusive());
   setSsdFile(nullptr, 0);
+  compressible_ = false;
   key_ = std::move(key);
   auto* cache = shard_->cache();
   ClockTimer t(shard_->allocClocks());
@@ -155,6 +165,7 @@ CachePin CacheShard::findOrCreate(
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
   AsyncDataCacheEntry* entryToInit = nullptr;
+  CompressedEntry compressed;
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
@@ -175,7 +186,9 @@ CachePin CacheShard::findOrCreate(
         if (found->isPrefetch()) {
           found->isFirstUse_ = true;
           found->setPrefetch(false);
+          admitLocked(*found);
         } else {
+          policy_->recordAccess(key);
           ++numHit_;
           hitBytes_ += found->size();
         }
@@ -197,6 +210,18 @@ CachePin CacheShard::findOrCreate(
       found->key_.fileNum.clear();
     }
 
+    policy_->recordAccess(key);
+    auto compressedIt = compressedMap_.find(key);
+    if (compressedIt != compressedMap_.end()) {
+      auto position = compressedIt->second;
+      compressedMap_.erase(compressedIt);
+      compressedBytes_ -= position->data->computeChainDataLength();
+      compressedSourceBytes_ -= position->size;
+      if (position->size >= size) {
+        compressed = std::move(*position);
+      }
+      compressedLru_.erase(position);
+    }
     auto newEntry = getFreeEntry();
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
@@ -210,13 +235,62 @@ CachePin CacheShard::findOrCreate(
       emptySlots_.pop_back();
       entries_[index] = std::move(newEntry);
     }
-    ++numNew_;
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
-    entryToInit->size_ = size;
-    entryToInit->isFirstUse_ = true;
+    if (compressed.data == nullptr) {
+      ++numNew_;
+      entryToInit->size_ = size;
+      entryToInit->isFirstUse_ = true;
+    } else {
+      // Decompressing saves the IO, so this counts as a hit.
+      ++numHit_;
+      ++numCompressedHit_;
+      hitBytes_ += compressed.size;
+      entryToInit->size_ = compressed.size;
+      entryToInit->isFirstUse_ = false;
+    }
+  }
+  if (compressed.data == nullptr) {
+    return initEntry(key, entryToInit);
   }
-  return initEntry(key, entryToInit);
+  entryToInit->initialize(std::move(compressed.key));
+  CachePin pin;
+  pin.setEntry(entryToInit);
+  if (decompressEntry(compressed, entryToInit)) {
+    entryToInit->setExclusiveToShared();
+  }
+  return pin;
+}
+
+bool CacheShard::decompressEntry(
+    const CompressedEntry& compressed,
+    AsyncDataCacheEntry* entry) {
+  std::unique_ptr<folly::IOBuf> data;
+  try {
+    data = common::compressionKindToCodec(common::CompressionKind_LZ4)
+               ->uncompress(compressed.data.get(), compressed.size);
+  } catch (const std::exception& e) {
+    VELOX_CACHE_LOG(WARNING) << "Failed to decompress cache entry "
+                             << entry->toString() << ": " << e.what();
+    return false;
+  }
+  const auto bytes = data->coalesce();
+  if (bytes.size() != compressed.size) {
+    return false;
+  }
+  auto& allocation = entry->data();
+  uint64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < bytes.size(); ++i) {
+    const auto run = allocation.runAt(i);
+    const auto runBytes =
+        std::min<uint64_t>(run.numBytes(), bytes.size() - offset);
+    ::memcpy(run.data<char>(), bytes.data() + offset, runBytes);
+    offset += runBytes;
+  }
+  entry->setGroupId(compressed.groupId);
+  entry->setTrackingId(compressed.trackingId);
+  entry->setCompressible(true);
+  return true;
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
@@ -272,14 +346,7 @@ bool CoalescedLoad::loadOrFuture(folly::SemiFuture<bool>* wait) {
   }
   // Outside of 'mutex_'.
   try {
-    const auto pins = loadData(!wait);
-    for (const auto& pin : pins) {
-      auto* entry = pin.checkedEntry();
-      VELOX_CHECK(entry->key().fileNum.hasValue());
-      VELOX_CHECK(entry->isExclusive());
-      entry->setExclusiveToShared();
-    }
-    setEndState(State::kLoaded);
+    setLoaded(loadData(!wait));
   } catch (std::exception&) {
     try {
       setEndState(State::kCancelled);
@@ -291,6 +358,61 @@ bool CoalescedLoad::loadOrFuture(folly::SemiFuture<bool>* wait) {
   return true;
 }
 
+// static
+void CoalescedLoad::loadAsync(
+    std::shared_ptr<CoalescedLoad> load,
+    std::function<void()> onDone) {
+  {
+    std::lock_guard<std::mutex> l(load->mutex_);
+    if (load->state_ != State::kPlanned) {
+      if (onDone) {
+        onDone();
+      }
+      return;
+    }
+    load->state_ = State::kLoading;
+  }
+  folly::SemiFuture<std::vector<CachePin>> pins(std::vector<CachePin>{});
+  try {
+    pins = load->loadDataAsync(true);
+  } catch (const std::exception& e) {
+    pins = folly::makeSemiFuture<std::vector<CachePin>>(
+        folly::exception_wrapper(std::current_exception(), e));
+  }
+  // The continuation runs on the thread that completes the IO and keeps
+  // 'load' alive until then.
+  std::move(pins)
+      .via(&folly::InlineExecutor::instance())
+      .thenTry([load, onDone = std::move(onDone)](
+                   folly::Try<std::vector<CachePin>>&& result) {
+        try {
+          load->setLoaded(result.value());
+        } catch (const std::exception& e) {
+          VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
+              << "Failed prefetch " << load->toString() << ": " << e.what();
+          load->setEndState(State::kCancelled);
+        }
+        if (onDone) {
+          onDone();
+        }
+      });
+}
+
+folly::SemiFuture<std::vector<CachePin>> CoalescedLoad::loadDataAsync(
+    bool isPrefetch) {
+  return folly::makeSemiFuture(loadData(isPrefetch));
+}
+
+void CoalescedLoad::setLoaded(const std::vector<CachePin>& pins) {
+  for (const auto& pin : pins) {
+    auto* entry = pin.checkedEntry();
+    VELOX_CHECK(entry->key().fileNum.hasValue());
+    VELOX_CHECK(entry->isExclusive());
+    entry->setExclusiveToShared();
+  }
+  setEndState(State::kLoaded);
+}
+
 void CoalescedLoad::setEndState(State endState) {
   std::lock_guard<std::mutex> l(mutex_);
   state_ = endState;
@@ -345,11 +467,18 @@ uint64_t CacheShard::evict(
   const bool skipSsdSaveable = ssdCache && ssdCache->writeInProgress();
   auto now = accessTime();
   std::vector<memory::Allocation> toFree;
+  std::vector<CompressCandidate> toCompress;
+  const bool compress =
+      !evictAllUnpinned && cache_->compressedShardBytes() > 0;
   int64_t tinyEvicted = 0;
   int64_t largeEvicted = 0;
   int32_t evictSaveableSkipped = 0;
   {
     std::lock_guard<std::mutex> l(mutex_);
+    if (evictAllUnpinned) {
+      // Out of memory or clearing the cache. The compressed tier goes too.
+      trimCompressedLocked(0);
+    }
     const size_t size = entries_.size();
     if (size == 0) {
       return 0;
@@ -386,13 +515,27 @@ uint64_t CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (score = policy_->score(*candidate, now)) >= evictionThreshold_)) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
         }
         largeEvicted += candidate->data_.byteSize();
-        if (pagesToAcquire > 0) {
+        if (compress && candidate->compressible_ &&
+            candidate->key_.fileNum.hasValue() &&
+            candidate->ssdFile_ == nullptr &&
+            candidate->data().numPages() > 0) {
+          // The data is compressed after leaving the mutex and then freed or
+          // acquired.
+          toCompress.push_back(CompressCandidate{
+              CompressedEntry{
+                  candidate->key_,
+                  candidate->size_,
+                  candidate->groupId_,
+                  candidate->trackingId_,
+                  nullptr},
+              std::move(candidate->data())});
+        } else if (pagesToAcquire > 0) {
           const auto candidatePages = candidate->data().numPages();
           pagesToAcquire = candidatePages > pagesToAcquire
               ? 0
@@ -421,6 +564,21 @@ uint64_t CacheShard::evict(
     }
   }
 
+  if (!toCompress.empty()) {
+    compressEvicted(toCompress);
+    for (auto& candidate : toCompress) {
+      if (pagesToAcquire > 0) {
+        const auto candidatePages = candidate.data.numPages();
+        pagesToAcquire = candidatePages > pagesToAcquire
+            ? 0
+            : pagesToAcquire - candidatePages;
+        acquired.appendMove(candidate.data);
+      } else {
+        toFree.push_back(std::move(candidate.data));
+      }
+    }
+  }
+
   ClockTimer t(allocClocks_);
   freeAllocations(toFree);
   cache_->incrementCachedPages(
@@ -441,6 +599,71 @@ uint64_t CacheShard::evict(
   return largeEvicted + tinyEvicted;
 }
 
+void CacheShard::compressEvicted(std::vector<CompressCandidate>& candidates) {
+  // A compressed entry is kept only if it saves at least a quarter.
+  constexpr int32_t kMaxCompressedPct = 75;
+  auto codec = common::compressionKindToCodec(common::CompressionKind_LZ4);
+  for (auto& candidate : candidates) {
+    auto& entry = candidate.entry;
+    std::unique_ptr<folly::IOBuf> chain;
+    uint64_t offset = 0;
+    for (auto i = 0; i < candidate.data.numRuns() && offset < entry.size;
+         ++i) {
+      const auto run = candidate.data.runAt(i);
+      const auto runBytes =
+          std::min<uint64_t>(run.numBytes(), entry.size - offset);
+      auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), runBytes);
+      if (chain == nullptr) {
+        chain = std::move(buffer);
+      } else {
+        chain->prependChain(std::move(buffer));
+      }
+      offset += runBytes;
+    }
+    try {
+      entry.data = codec->compress(chain.get());
+    } catch (const std::exception& e) {
+      VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
+          << "Failed to compress evicted cache entry: " << e.what();
+      continue;
+    }
+    if (entry.data->computeChainDataLength() * 100 >
+        static_cast<uint64_t>(entry.size) * kMaxCompressedPct) {
+      entry.data.reset();
+    }
+  }
+
+  const auto maxBytes = cache_->compressedShardBytes();
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& candidate : candidates) {
+    auto& entry = candidate.entry;
+    if (entry.data == nullptr) {
+      continue;
+    }
+    const RawFileCacheKey key{entry.key.fileNum.id(), entry.key.offset};
+    // The key may have been loaded again while compressing.
+    if (entryMap_.count(key) > 0 || compressedMap_.count(key) > 0) {
+      continue;
+    }
+    compressedBytes_ += entry.data->computeChainDataLength();
+    compressedSourceBytes_ += entry.size;
+    compressedLru_.push_front(std::move(entry));
+    compressedMap_[key] = compressedLru_.begin();
+  }
+  trimCompressedLocked(maxBytes);
+}
+
+void CacheShard::trimCompressedLocked(uint64_t maxBytes) {
+  while (compressedBytes_ > maxBytes && !compressedLru_.empty()) {
+    auto& last = compressedLru_.back();
+    compressedMap_.erase(
+        RawFileCacheKey{last.key.fileNum.id(), last.key.offset});
+    compressedBytes_ -= last.data->computeChainDataLength();
+    compressedSourceBytes_ -= last.size;
+    compressedLru_.pop_back();
+  }
+}
+
 void CacheShard::tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry) {
   freeEntries_.push_back(std::move(entry));
   // If we have too many free entries, we free up half of them to save space.
@@ -465,7 +688,7 @@ void CacheShard::calibrateThreshold() {
   evictionThreshold_ = percentile<int32_t>(
       [&]() -> int32_t {
         AsyncDataCacheEntry* element = iter->get();
-        int32_t score = element ? element->score(now) : 0;
+        int32_t score = element ? policy_->score(*element, now) : 0;
         if (entryIndex + step >= entries_.size()) {
           entryIndex = (entryIndex + step) % entries_.size();
           iter = entries_.begin() + entryIndex;
@@ -479,6 +702,13 @@ void CacheShard::calibrateThreshold() {
       80);
 }
 
+void CacheShard::admitLocked(AsyncDataCacheEntry& entry) {
+  if (!policy_->admit(entry)) {
+    entry.makeEvictable();
+    ++numNotAdmitted_;
+  }
+}
+
 void CacheShard::updateStats(CacheStats& stats) {
   std::lock_guard<std::mutex> l(mutex_);
   for (auto& entry : entries_) {
@@ -509,12 +739,42 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numHit += numHit_;
   stats.hitBytes += hitBytes_;
   stats.numNew += numNew_;
+  stats.numNotAdmitted += numNotAdmitted_;
+  stats.policyName = policy_->name();
   stats.numEvict += numEvict_;
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
   stats.numAgedOut += numAgedOut_;
   stats.sumEvictScore += sumEvictScore_;
   stats.allocClocks += allocClocks_;
+  stats.numCompressed += compressedLru_.size();
+  stats.compressedBytes += compressedBytes_;
+  stats.compressedSourceBytes += compressedSourceBytes_;
+  stats.numCompressedHit += numCompressedHit_;
+}
+
+void CacheShard::appendRegions(
+    AccessTime now,
+    int32_t minUses,
+    std::vector<std::pair<int32_t, CachedRegion>>& regions) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (entry == nullptr || !entry->key_.fileNum.hasValue() ||
+        entry->isExclusive() || entry->accessStats_.numUses < minUses) {
+      continue;
+    }
+    auto path = fileIds().string(entry->key_.fileNum.id());
+    if (path.empty()) {
+      continue;
+    }
+    regions.emplace_back(
+        entry->score(now),
+        CachedRegion{
+            std::move(path),
+            entry->key_.offset,
+            entry->size_,
+            entry->accessStats_.numUses});
+  }
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
@@ -576,6 +836,18 @@ bool CacheShard::removeFileEntries(
       tryAddFreeEntry(std::move(cacheEntry));
       cacheEntry = nullptr;
     }
+
+    for (auto it = compressedLru_.begin(); it != compressedLru_.end();) {
+      if (filesToRemove.count(it->key.fileNum.id()) == 0) {
+        ++it;
+        continue;
+      }
+      compressedMap_.erase(
+          RawFileCacheKey{it->key.fileNum.id(), it->key.offset});
+      compressedBytes_ -= it->data->computeChainDataLength();
+      compressedSourceBytes_ -= it->size;
+      it = compressedLru_.erase(it);
+    }
   }
   VELOX_CACHE_LOG(INFO) << "Removed " << toFree.size()
                         << " AsyncDataCache entries.";
@@ -590,10 +862,19 @@ bool CacheShard::removeFileEntries(
 
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache)
-    : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
-  for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this));
+    std::unique_ptr<SsdCache> ssdCache,
+    CachePolicyFactory policyFactory,
+    int32_t numaNodes)
+    : allocator_(allocator),
+      ssdCache_(std::move(ssdCache)),
+      numaNodes_(numaNodes),
+      cachedPages_(0) {
+  VELOX_CHECK_GT(numaNodes_, 0);
+  for (auto i = 0; i < kNumShards * numaNodes_; ++i) {
+    shards_.push_back(std::make_unique<CacheShard>(
+        this,
+        policyFactory ? policyFactory()
+                      : std::make_unique<ClockCachePolicy>()));
   }
 }
 
@@ -602,8 +883,11 @@ AsyncDataCache::~AsyncDataCache() {}
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache) {
-  auto cache = std::make_shared<AsyncDataCache>(allocator, std::move(ssdCache));
+    std::unique_ptr<SsdCache> ssdCache,
+    CachePolicyFactory policyFactory,
+    int32_t numaNodes) {
+  auto cache = std::make_shared<AsyncDataCache>(
+      allocator, std::move(ssdCache), std::move(policyFactory), numaNodes);
   allocator->registerCache(cache);
   return cache;
 }
@@ -633,19 +917,50 @@ void AsyncDataCache::shutdown() {
 void CacheShard::shutdown() {
   entries_.clear();
   freeEntries_.clear();
+  trimCompressedLocked(0);
 }
 
 CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
-  const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->findOrCreate(key, size, wait);
+  if (numaNodes_ == 1) {
+    return shard(key, 0).findOrCreate(key, size, wait);
+  }
+  // Look in the shards of the other nodes before creating the entry in the
+  // local ones. The lookups are rare compared to the reads of the found
+  // entries, so that the extra shard mutexes do not matter.
+  const auto local = localNode();
+  auto* owner = &shard(key, local);
+  bool remote = false;
+  if (!owner->exists(key)) {
+    for (auto i = 1; i < numaNodes_; ++i) {
+      auto& other = shard(key, (local + i) % numaNodes_);
+      if (other.exists(key)) {
+        owner = &other;
+        remote = true;
+        break;
+      }
+    }
+  }
+  auto pin = owner->findOrCreate(key, size, wait);
+  if (!pin.empty() && pin.checkedEntry()->isShared()) {
+    ++(remote ? numRemoteHit_ : numLocalHit_);
+  }
+  return pin;
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
-  int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->exists(key);
+  for (auto node = 0; node < numaNodes_; ++node) {
+    if (shard(key, node).exists(key)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int32_t AsyncDataCache::localNode() const {
+  return memory::MmapAllocator::currentNumaNode() % numaNodes_;
 }
 
 bool AsyncDataCache::makeSpace(
@@ -727,10 +1042,10 @@ bool AsyncDataCache::makeSpace(
     // Evict from next shard. If we have gone through all shards once
     // and still have not made the allocation, we go to desperate mode
     // with 'evictAllUnpinned' set to true.
-    shards_[shardCounter_ & (kShardMask)]->evict(
+    shards_[static_cast<uint32_t>(shardCounter_) % shards_.size()]->evict(
         memory::AllocationTraits::pageBytes(
             std::max<uint64_t>(kMinEvictPages, numPages) * sizeMultiplier),
-        nthAttempt >= kNumShards,
+        nthAttempt >= static_cast<int32_t>(shards_.size()),
         numPagesToAcquire,
         acquired);
     if (numPages < kSmallSizePages && sizeMultiplier < 4) {
@@ -756,7 +1071,8 @@ uint64_t AsyncDataCache::shrink(uint64_t targetBytes) {
     MicrosecondTimer timer(&shrinkTimeUs);
     for (int shard = 0; shard < shards_.size(); ++shard) {
       memory::Allocation unused;
-      evictedBytes += shards_[shardCounter_++ & (kShardMask)]->evict(
+      const auto index = static_cast<uint32_t>(shardCounter_++);
+      evictedBytes += shards_[index % shards_.size()]->evict(
           std::max<uint64_t>(minBytesToEvict, targetBytes - evictedBytes),
           // Cache shrink is triggered when server is under low memory pressure
           // so need to free up memory as soon as possible. So we always avoid
@@ -864,11 +1180,41 @@ bool AsyncDataCache::removeFileEntries(
   return success;
 }
 
+std::vector<CachedRegion> AsyncDataCache::hottestRegions(
+    int32_t maxRegions,
+    int32_t minUses) const {
+  std::vector<std::pair<int32_t, CachedRegion>> scored;
+  const auto now = accessTime();
+  for (const auto& shard : shards_) {
+    shard->appendRegions(now, minUses, scored);
+  }
+  // The lowest retention score is the hottest. Ties go to the most used.
+  const auto numRegions = std::min<size_t>(maxRegions, scored.size());
+  std::partial_sort(
+      scored.begin(),
+      scored.begin() + numRegions,
+      scored.end(),
+      [](const auto& left, const auto& right) {
+        if (left.first != right.first) {
+          return left.first < right.first;
+        }
+        return left.second.numUses > right.second.numUses;
+      });
+  std::vector<CachedRegion> regions;
+  regions.reserve(numRegions);
+  for (auto i = 0; i < numRegions; ++i) {
+    regions.push_back(std::move(scored[i].second));
+  }
+  return regions;
+}
+
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
   for (auto& shard : shards_) {
     shard->updateStats(stats);
   }
+  stats.numLocalHit = numLocalHit_;
+  stats.numRemoteHit = numRemoteHit_;
   if (ssdCache_ != nullptr) {
     stats.ssdStats = std::make_shared<SsdCacheStats>(ssdCache_->stats());
   }
@@ -920,12 +1266,27 @@ std::string CacheStats::toString() const {
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
       << "\n"
+      // Cache policy stats.
+      << "Cache policy: " << policyName
+      << " hit ratio: " << fmt::format("{:.2f}%", hitRatio() * 100)
+      << " not admitted: " << numNotAdmitted << "\n"
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
-      << " bytes: " << succinctBytes(prefetchBytes)
-      << "\n"
-      // Cache timing stats.
-      << "Alloc Megaclocks " << (allocClocks >> 20);
+      << " bytes: " << succinctBytes(prefetchBytes) << "\n";
+  if (numCompressed > 0 || numCompressedHit > 0) {
+    // Compressed tier stats.
+    out << "Compressed entries: " << numCompressed
+        << " bytes: " << succinctBytes(compressedBytes)
+        << " uncompressed: " << succinctBytes(compressedSourceBytes)
+        << " hit: " << numCompressedHit << "\n";
+  }
+  if (numLocalHit > 0 || numRemoteHit > 0) {
+    // NUMA node stats.
+    out << "NUMA local hit: " << numLocalHit << " remote hit: " << numRemoteHit
+        << "\n";
+  }
+  // Cache timing stats.
+  out << "Alloc Megaclocks " << (allocClocks >> 20);
   return out.str();
 }
 
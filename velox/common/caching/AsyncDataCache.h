@@ -17,11 +17,13 @@
 #pragma once
 
 #include <deque>
+#include <list>
 
 #include <fmt/format.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
+#include <folly/io/IOBuf.h>
 #include "folly/GLog.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
@@ -194,6 +196,10 @@ class AsyncDataCacheEntry {
     return accessStats_.score(now, size_);
   }
 
+  const AccessStats& accessStats() const {
+    return accessStats_;
+  }
+
   bool isShared() const {
     return numPins_ > 0;
   }
@@ -251,6 +257,17 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  /// Marks 'this' as worth keeping compressed in memory after
+  /// eviction. Set by the reader from the read density of the stream of
+  /// 'this'. See AsyncDataCache::setCompressedTier().
+  void setCompressible(bool compressible) {
+    compressible_ = compressible;
+  }
+
+  bool compressible() const {
+    return compressible_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -325,6 +342,10 @@ class AsyncDataCacheEntry {
   // True if this should be saved to SSD.
   std::atomic<bool> ssdSaveable_{false};
 
+  // True if 'this' may be kept in the compressed tier of 'shard_' after
+  // eviction.
+  bool compressible_{false};
+
   friend class CacheShard;
   friend class CachePin;
 };
@@ -430,6 +451,22 @@ class CoalescedLoad {
   /// the other thread to be done.
   bool loadOrFuture(folly::SemiFuture<bool>* wait);
 
+  /// Starts a prefetch of 'load' if it is planned. If 'load' has native
+  /// asynchronous reads (hasLoadDataAsync()), returns without waiting for the
+  /// IO, so that the calling thread can keep many loads in flight. Otherwise
+  /// loads on the calling thread. Threads waiting in loadOrFuture() are
+  /// continued when the load is done. A failed load is cancelled and its
+  /// error is not rethrown, so that the readers load their data themselves.
+  /// 'onDone' is called when the load is ended or if it was not planned.
+  static void loadAsync(
+      std::shared_ptr<CoalescedLoad> load,
+      std::function<void()> onDone = nullptr);
+
+  /// Returns true if loadDataAsync() does not wait for IO.
+  virtual bool hasLoadDataAsync() const {
+    return false;
+  }
+
   State state() const {
     tsan_lock_guard<std::mutex> l(mutex_);
     return state_;
@@ -456,6 +493,16 @@ class CoalescedLoad {
   // users of the cache.
   virtual std::vector<CachePin> loadData(bool isPrefetch) = 0;
 
+  // Like loadData() but returns the pins via SemiFuture. The default calls
+  // loadData(). Overridden by loads that issue asynchronous reads, e.g. with
+  // ReadFile::preadvAsync().
+  virtual folly::SemiFuture<std::vector<CachePin>> loadDataAsync(
+      bool isPrefetch);
+
+  // Sets the exclusive pins returned by loadData() to shared and the state
+  // to loaded.
+  void setLoaded(const std::vector<CachePin>& pins);
+
   // Sets a final state and resumes waiting threads.
   void setEndState(State endState);
 
@@ -471,6 +518,49 @@ class CoalescedLoad {
   std::vector<int32_t> sizes_;
 };
 
+/// Admission and eviction policy of a CacheShard. Each shard has its own
+/// instance and calls it under the shard mutex, so implementations need no
+/// synchronization of their own. The base class retains all entries and
+/// ranks them by AccessStats::score().
+class CachePolicy {
+ public:
+  virtual ~CachePolicy() = default;
+
+  /// Name for stats, e.g. "clock" or "tinylfu".
+  virtual std::string_view name() const = 0;
+
+  /// Records a lookup of 'key' that hits an entry or creates a new one. The
+  /// first retrieval of a prefetched entry is not recorded since the
+  /// prefetch already was.
+  virtual void recordAccess(RawFileCacheKey /*key*/) {}
+
+  /// Returns true if 'entry' should be retained in competition with other
+  /// entries after its first use. An entry that is not admitted is made
+  /// evictable as soon as it is unpinned.
+  virtual bool admit(const AsyncDataCacheEntry& /*entry*/) {
+    return true;
+  }
+
+  /// Retention score of 'entry'. A higher number means less worth retaining.
+  /// See AccessStats::score().
+  virtual int32_t score(const AsyncDataCacheEntry& entry, AccessTime now)
+      const {
+    return entry.score(now);
+  }
+};
+
+/// A cached range of a file. See AsyncDataCache::hottestRegions().
+struct CachedRegion {
+  std::string path;
+  uint64_t offset;
+  int32_t size;
+  // Number of hits on the entry of the region.
+  int32_t numUses;
+};
+
+/// Makes the CachePolicy of each shard of an AsyncDataCache.
+using CachePolicyFactory = std::function<std::unique_ptr<CachePolicy>()>;
+
 // Struct for CacheShard stats. Stats from all shards are added into
 // this struct to provide a snapshot of state.
 struct CacheStats {
@@ -502,6 +592,9 @@ struct CacheStats {
   int64_t hitBytes{0};
   // Number of new entries created.
   int64_t numNew{0};
+  // Number of new entries that were not admitted by the CachePolicy and were
+  // made evictable after their first use.
+  int64_t numNotAdmitted{0};
   // Number of times a valid entry was removed in order to make space.
   int64_t numEvict{0};
   // Number of entries considered for evicting.
@@ -518,12 +611,38 @@ struct CacheStats {
   // lifetime for entries in cache.
   int64_t sumEvictScore{0};
 
+  // Number of evicted entries held compressed in memory.
+  int32_t numCompressed{0};
+  // Compressed and uncompressed size of the entries in 'numCompressed'.
+  int64_t compressedBytes{0};
+  int64_t compressedSourceBytes{0};
+  // Number of misses served by decompressing an entry instead of loading
+  // it. These are also counted in 'numHit'.
+  int64_t numCompressedHit{0};
+
+  // Hits found in the shards of the NUMA node of the requesting thread and
+  // hits found in the shards of another node. Counted only if the cache has
+  // shards per NUMA node.
+  int64_t numLocalHit{0};
+  int64_t numRemoteHit{0};
+
   // Total size of shared/exclusive pinned entries.
   int64_t sharedPinnedBytes{0};
   int64_t exclusivePinnedBytes{0};
 
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
+  // Name of the CachePolicy of the shards.
+  std::string policyName;
+
+  /// Returns the fraction of lookups that hit. Comparable between caches with
+  /// different policies.
+  double hitRatio() const {
+    return numHit + numNew == 0
+        ? 0
+        : static_cast<double>(numHit) / (numHit + numNew);
+  }
+
   std::string toString() const;
 };
 
@@ -533,7 +652,8 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* cache) : cache_(cache) {}
+  CacheShard(AsyncDataCache* cache, std::unique_ptr<CachePolicy> policy)
+      : cache_(cache), policy_(std::move(policy)) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -597,10 +717,39 @@ class CacheShard {
     return allocClocks_;
   }
 
+  /// Appends the regions of shared or unpinned entries with at least
+  /// 'minUses' hits to 'regions', each with its retention score at 'now'.
+  void appendRegions(
+      AccessTime now,
+      int32_t minUses,
+      std::vector<std::pair<int32_t, CachedRegion>>& regions) const;
+
+  /// Applies the admission of the CachePolicy to 'entry' after its first use.
+  /// Must be called inside the shard mutex.
+  void admitLocked(AsyncDataCacheEntry& entry);
+
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
 
+  // An evicted entry held compressed in memory. See
+  // AsyncDataCache::setCompressedTier().
+  struct CompressedEntry {
+    // Holds an owning reference to the file number.
+    FileCacheKey key;
+    // Uncompressed size.
+    int32_t size{0};
+    uint64_t groupId{0};
+    TrackingId trackingId;
+    std::unique_ptr<folly::IOBuf> data;
+  };
+
+  // An entry being evicted and the data to compress for it.
+  struct CompressCandidate {
+    CompressedEntry entry;
+    memory::Allocation data;
+  };
+
   void calibrateThreshold();
 
   void removeEntryLocked(AsyncDataCacheEntry* entry);
@@ -617,8 +766,26 @@ class CacheShard {
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
 
+  // Compresses the evicted allocations in 'candidates' into the compressed
+  // tier. The allocations are left as they are for the caller to free.
+  void compressEvicted(std::vector<CompressCandidate>& candidates);
+
+  // Drops entries from the end of 'compressedLru_' until the compressed
+  // size is at most 'maxBytes'.
+  void trimCompressedLocked(uint64_t maxBytes);
+
+  // Decompresses 'compressed' into 'entry' and makes 'entry' shared. Returns
+  // false if 'compressed' could not be decompressed, in which case 'entry'
+  // stays exclusive.
+  bool decompressEntry(
+      const CompressedEntry& compressed,
+      AsyncDataCacheEntry* entry);
+
   AsyncDataCache* const cache_;
 
+  // Decides admission and eviction order. Accessed under 'mutex_'.
+  const std::unique_ptr<CachePolicy> policy_;
+
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
@@ -643,6 +810,8 @@ class CacheShard {
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
   uint64_t numNew_{0};
+  // Count of entries not admitted by 'policy_'.
+  uint64_t numNotAdmitted_{0};
   // Count of entries evicted.
   uint64_t numEvict_{0};
   // Count of entries considered for eviction. This divided by
@@ -656,19 +825,40 @@ class CacheShard {
   // Tracker of time spent in allocating/freeing MemoryAllocator space
   // for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
+
+  // Compressed tier, most recently added first, and the position of each key
+  // in it.
+  std::list<CompressedEntry> compressedLru_;
+  folly::F14FastMap<RawFileCacheKey, std::list<CompressedEntry>::iterator>
+      compressedMap_;
+  // Compressed and uncompressed size of 'compressedLru_'.
+  uint64_t compressedBytes_{0};
+  uint64_t compressedSourceBytes_{0};
+  // Count of misses served from 'compressedLru_'.
+  uint64_t numCompressedHit_{0};
 };
 
 class AsyncDataCache : public memory::Cache {
  public:
+  /// 'policyFactory' makes the CachePolicy of each shard. If not set, the
+  /// shards use ClockCachePolicy. If 'numaNodes' is more than 1, each NUMA
+  /// node has its own set of shards. New entries go to the shards of the node
+  /// of the creating thread, see memory::MmapAllocator::currentNumaNode(),
+  /// which is also the node the MmapAllocator allocates their memory on. A
+  /// lookup tries the shards of the other nodes before creating an entry.
   AsyncDataCache(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CachePolicyFactory policyFactory = nullptr,
+      int32_t numaNodes = 1);
 
   ~AsyncDataCache() override;
 
   static std::shared_ptr<AsyncDataCache> create(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CachePolicyFactory policyFactory = nullptr,
+      int32_t numaNodes = 1);
 
   static AsyncDataCache* getInstance();
 
@@ -714,6 +904,18 @@ class AsyncDataCache : public memory::Cache {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  int32_t numaNodes() const {
+    return numaNodes_;
+  }
+
+  /// Returns up to 'maxRegions' regions of entries with at least 'minUses'
+  /// hits, hottest first. Regions are identified by file path since file
+  /// numbers do not survive a restart. Used for saving the hot set for
+  /// CachePrewarmer.
+  std::vector<CachedRegion> hottestRegions(
+      int32_t maxRegions,
+      int32_t minUses = 1) const;
+
   /// Returns snapshot of the aggregated stats from all shards and the stats of
   /// SSD cache if used.
   CacheStats refreshStats() const;
@@ -757,6 +959,28 @@ class AsyncDataCache : public memory::Cache {
     return verifyHook_;
   }
 
+  /// Keeps evicted entries LZ4 compressed in up to 'maxBytes' of memory
+  /// outside of 'allocator_'. Only entries marked compressible by the reader
+  /// that are not backed by SSD are kept, and only if compression saves at
+  /// least a quarter of their size. A miss on a compressed entry is served
+  /// by decompressing it into a new entry, which is returned in shared
+  /// mode. 0 disables the tier. Must be set before the cache is used.
+  void setCompressedTier(uint64_t maxBytes, int32_t minReadPct) {
+    compressedTierBytes_ = maxBytes;
+    compressMinReadPct_ = minReadPct;
+  }
+
+  /// Returns the compressed tier budget of each shard.
+  uint64_t compressedShardBytes() const {
+    return compressedTierBytes_ / shards_.size();
+  }
+
+  /// Returns true if data from a stream where 'readPct' percent of the
+  /// references are read should be kept compressed after eviction.
+  bool isCompressible(int32_t readPct) const {
+    return compressedTierBytes_ > 0 && readPct >= compressMinReadPct_;
+  }
+
   // Looks up a pin for each in 'keys' and skips all loading or
   // loaded pins. Calls processPin for each exclusive
   // pin. processPin must move its argument if it wants to use it
@@ -798,6 +1022,16 @@ class AsyncDataCache : public memory::Cache {
   static constexpr int32_t kNumShards = 4; // Must be power of 2.
   static constexpr int32_t kShardMask = kNumShards - 1;
 
+  // Returns the shard of 'key' in the shard set of 'node'.
+  CacheShard& shard(RawFileCacheKey key, int32_t node) const {
+    return *shards_
+        [node * kNumShards +
+         (std::hash<RawFileCacheKey>()(key) & (kShardMask))];
+  }
+
+  // Returns the NUMA node of the calling thread.
+  int32_t localNode() const;
+
   // True if 'acquired' has more pages than 'numPages' or allocator has space
   // for numPages - acquired pages of more allocation.
   bool canTryAllocate(int32_t numPages, const memory::Allocation& acquired)
@@ -810,7 +1044,11 @@ class AsyncDataCache : public memory::Cache {
 
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  const int32_t numaNodes_;
+  // 'kNumShards' shards for each of 'numaNodes_'.
   std::vector<std::unique_ptr<CacheShard>> shards_;
+  std::atomic<int64_t> numLocalHit_{0};
+  std::atomic<int64_t> numRemoteHit_{0};
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
   // Number of pages that are allocated and not yet loaded or loaded
@@ -830,6 +1068,12 @@ class AsyncDataCache : public memory::Cache {
   CacheStats stats_;
 
   std::function<void(const AsyncDataCacheEntry&)> verifyHook_;
+
+  // Budget of the compressed tier, divided between the shards, and the
+  // minimum read percentage of the streams whose entries go there.
+  uint64_t compressedTierBytes_{0};
+  int32_t compressMinReadPct_{0};
+
   // Count of skipped saves to 'ssdCache_' due to 'ssdCache_' being
   // busy with write.
   tsan_atomic<int32_t> numSkippedSaves_{0};
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CachePolicy.h"
+
+#include <folly/hash/Hash.h>
+
+namespace facebook::velox::cache {
+
+CountMinSketch::CountMinSketch(int32_t width)
+    : mask_(bits::nextPowerOfTwo(std::max(width, 16)) - 1),
+      // TinyLFU halves the counts after 10 times the number of tracked
+      // items increments.
+      sampleSize_(10L * (mask_ + 1)),
+      counters_(kDepth * (mask_ + 1)) {}
+
+int32_t CountMinSketch::counterIndex(uint64_t hash, int32_t row) const {
+  // Derive an independent hash for each row.
+  const auto rowHash =
+      folly::hash::twang_mix64(hash + row * 0x9e3779b97f4a7c15ULL);
+  return row * (mask_ + 1) + (rowHash & mask_);
+}
+
+void CountMinSketch::increment(uint64_t hash) {
+  for (auto row = 0; row < kDepth; ++row) {
+    auto& counter = counters_[counterIndex(hash, row)];
+    if (counter < kMaxCount) {
+      ++counter;
+    }
+  }
+  if (++numIncrements_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t CountMinSketch::estimate(uint64_t hash) const {
+  int32_t count = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    count = std::min<int32_t>(count, counters_[counterIndex(hash, row)]);
+  }
+  return count;
+}
+
+void CountMinSketch::age() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  numIncrements_ /= 2;
+}
+
+int32_t TinyLfuCachePolicy::frequency(const AsyncDataCacheEntry& entry) const {
+  return sketch_.estimate(std::hash<RawFileCacheKey>()(
+      RawFileCacheKey{entry.key().fileNum.id(), entry.key().offset}));
+}
+
+bool TinyLfuCachePolicy::admit(const AsyncDataCacheEntry& entry) {
+  return frequency(entry) >= minAdmitFrequency_;
+}
+
+int32_t TinyLfuCachePolicy::score(
+    const AsyncDataCacheEntry& entry,
+    AccessTime now) const {
+  const auto& stats = entry.accessStats();
+  if (!stats.lastUse) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  return (now - stats.lastUse) / (1 + frequency(entry));
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// Approximate count of occurrences of 64 bit hashes. Each hash increments
+/// one counter in each of 'kDepth' rows and the estimate is the smallest of
+/// these. The counters saturate at 'kMaxCount' and are halved after a number
+/// of increments proportional to the width, so that the counts reflect recent
+/// history.
+class CountMinSketch {
+ public:
+  static constexpr int32_t kDepth = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  /// Makes a sketch with 'width' counters per row, rounded up to a power of
+  /// 2.
+  explicit CountMinSketch(int32_t width);
+
+  void increment(uint64_t hash);
+
+  /// Returns an upper bound of the number of increments of 'hash' since
+  /// halving, capped at kMaxCount.
+  int32_t estimate(uint64_t hash) const;
+
+  int32_t width() const {
+    return mask_ + 1;
+  }
+
+  /// Number of increments after which the counters are halved.
+  int64_t sampleSize() const {
+    return sampleSize_;
+  }
+
+ private:
+  // Halves all counters.
+  void age();
+
+  int32_t counterIndex(uint64_t hash, int32_t row) const;
+
+  const uint32_t mask_;
+  const int64_t sampleSize_;
+  // 'kDepth' rows of 'mask_' + 1 counters.
+  std::vector<uint8_t> counters_;
+  // Increments since the last halving.
+  int64_t numIncrements_{0};
+};
+
+/// The default policy that admits all entries and evicts by
+/// AccessStats::score().
+class ClockCachePolicy : public CachePolicy {
+ public:
+  std::string_view name() const override {
+    return "clock";
+  }
+};
+
+/// TinyLFU admission with frequency based eviction. A count-min sketch keeps
+/// the recent access frequency of keys, including keys no longer cached. A
+/// new entry is admitted only if its key has been accessed at least
+/// 'minAdmitFrequency' times, so that a scan touching data once does not
+/// displace data that is read repeatedly. The retention score divides the
+/// time since last use by the frequency in the sketch instead of the uses
+/// since the entry was loaded.
+class TinyLfuCachePolicy : public CachePolicy {
+ public:
+  static constexpr int32_t kDefaultSketchWidth = 1 << 16;
+
+  explicit TinyLfuCachePolicy(
+      int32_t sketchWidth = kDefaultSketchWidth,
+      int32_t minAdmitFrequency = 2)
+      : sketch_(sketchWidth), minAdmitFrequency_(minAdmitFrequency) {}
+
+  std::string_view name() const override {
+    return "tinylfu";
+  }
+
+  void recordAccess(RawFileCacheKey key) override {
+    sketch_.increment(std::hash<RawFileCacheKey>()(key));
+  }
+
+  bool admit(const AsyncDataCacheEntry& entry) override;
+
+  int32_t score(const AsyncDataCacheEntry& entry, AccessTime now)
+      const override;
+
+  const CountMinSketch& sketch() const {
+    return sketch_;
+  }
+
+ private:
+  int32_t frequency(const AsyncDataCacheEntry& entry) const;
+
+  CountMinSketch sketch_;
+  const int32_t minAdmitFrequency_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/CachePrewarmer.h"
+
+#include <folly/String.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::cache {
+namespace {
+constexpr std::string_view kHistoryMagic{"CPW1"};
+
+template <typename T>
+void appendValue(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Reads a T at 'offset' of 'data' and advances 'offset'. Returns false if
+// 'data' is too short.
+template <typename T>
+bool readValue(std::string_view data, uint64_t& offset, T& value) {
+  if (offset + sizeof(T) > data.size()) {
+    return false;
+  }
+  ::memcpy(&value, data.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+} // namespace
+
+CachePrewarmer::CachePrewarmer(
+    AsyncDataCache* cache,
+    FileOpener openFile,
+    Options options)
+    : cache_(cache), openFile_(std::move(openFile)), options_(options) {
+  VELOX_CHECK_NOT_NULL(cache_);
+  VELOX_CHECK_NOT_NULL(openFile_);
+  VELOX_CHECK_GT(options_.maxCachePct, 0);
+}
+
+CachePrewarmer::~CachePrewarmer() {
+  stop();
+}
+
+// static
+void CachePrewarmer::saveHistory(
+    const std::vector<CachedRegion>& regions,
+    const std::string& path) {
+  std::string data(kHistoryMagic);
+  appendValue<int32_t>(data, regions.size());
+  for (const auto& region : regions) {
+    appendValue<int32_t>(data, region.path.size());
+    data.append(region.path);
+    appendValue(data, region.offset);
+    appendValue(data, region.size);
+    appendValue(data, region.numUses);
+  }
+  // Writes a new file and renames it over the old one, so that a crash while
+  // saving does not lose the previous history.
+  const auto tempPath = path + ".tmp";
+  std::remove(tempPath.c_str());
+  {
+    LocalWriteFile file(tempPath);
+    file.append(data);
+    file.close();
+  }
+  VELOX_CHECK_EQ(
+      std::rename(tempPath.c_str(), path.c_str()),
+      0,
+      "Failed to rename {} to {}: {}",
+      tempPath,
+      path,
+      folly::errnoStr(errno));
+}
+
+// static
+std::vector<CachedRegion> CachePrewarmer::loadHistory(
+    const std::string& path) {
+  std::string data;
+  try {
+    LocalReadFile file(path);
+    data = file.pread(0, file.size());
+  } catch (const std::exception& e) {
+    VELOX_CACHE_LOG(INFO) << "No cache history at " << path << ": "
+                          << e.what();
+    return {};
+  }
+  std::vector<CachedRegion> regions;
+  uint64_t offset = kHistoryMagic.size();
+  int32_t numRegions;
+  if (std::string_view(data).substr(0, kHistoryMagic.size()) !=
+          kHistoryMagic ||
+      !readValue(data, offset, numRegions) || numRegions < 0) {
+    VELOX_CACHE_LOG(WARNING) << "Ignoring corrupt cache history " << path;
+    return {};
+  }
+  regions.reserve(numRegions);
+  for (auto i = 0; i < numRegions; ++i) {
+    CachedRegion region;
+    int32_t pathSize;
+    if (!readValue(data, offset, pathSize) || pathSize < 0 ||
+        offset + pathSize > data.size()) {
+      break;
+    }
+    region.path = data.substr(offset, pathSize);
+    offset += pathSize;
+    if (!readValue(data, offset, region.offset) ||
+        !readValue(data, offset, region.size) ||
+        !readValue(data, offset, region.numUses) || region.size <= 0) {
+      break;
+    }
+    regions.push_back(std::move(region));
+  }
+  if (regions.size() != numRegions) {
+    VELOX_CACHE_LOG(WARNING) << "Cache history " << path << " is truncated to "
+                             << regions.size() << " of " << numRegions
+                             << " regions";
+  }
+  return regions;
+}
+
+void CachePrewarmer::start(std::vector<CachedRegion> regions) {
+  VELOX_CHECK(!thread_.joinable(), "CachePrewarmer is already started");
+  thread_ = std::thread([this, regions = std::move(regions)]() mutable {
+    run(std::move(regions));
+  });
+}
+
+void CachePrewarmer::stop() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stopped_ = true;
+  }
+  stopCv_.notify_all();
+  wait();
+}
+
+void CachePrewarmer::wait() {
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+CachePrewarmer::Stats CachePrewarmer::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+bool CachePrewarmer::cacheFull() const {
+  const auto* allocator = cache_->allocator();
+  return allocator->numAllocated() * 100 >=
+      memory::AllocationTraits::numPages(allocator->capacity()) *
+      options_.maxCachePct;
+}
+
+void CachePrewarmer::run(std::vector<CachedRegion> regions) {
+  // Files are opened once. nullptr is a file that could not be opened.
+  folly::F14FastMap<std::string, std::shared_ptr<ReadFile>> files;
+  const auto startMicros = getCurrentTimeMicro();
+  uint64_t bytesLoaded = 0;
+  for (const auto& region : regions) {
+    if (cacheFull()) {
+      VELOX_CACHE_LOG(INFO) << "Stopping cache prewarm on full cache";
+      break;
+    }
+    auto it = files.find(region.path);
+    if (it == files.end()) {
+      std::shared_ptr<ReadFile> file;
+      try {
+        file = openFile_(region.path);
+      } catch (const std::exception& e) {
+        VELOX_CACHE_LOG(WARNING)
+            << "Failed to open " << region.path << " for prewarm: " << e.what();
+      }
+      it = files.emplace(region.path, std::move(file)).first;
+    }
+    bytesLoaded += loadRegion(region, it->second.get());
+
+    std::unique_lock<std::mutex> l(mutex_);
+    if (stopped_) {
+      return;
+    }
+    if (options_.maxBytesPerSec == 0) {
+      continue;
+    }
+    // Waits until the average rate since start is within the limit.
+    const uint64_t targetMicros =
+        bytesLoaded * 1'000'000 / options_.maxBytesPerSec;
+    const uint64_t elapsedMicros = getCurrentTimeMicro() - startMicros;
+    if (targetMicros > elapsedMicros) {
+      stopCv_.wait_for(
+          l, std::chrono::microseconds(targetMicros - elapsedMicros), [&]() {
+            return stopped_;
+          });
+      if (stopped_) {
+        return;
+      }
+    }
+  }
+}
+
+uint64_t CachePrewarmer::loadRegion(
+    const CachedRegion& region,
+    ReadFile* file) {
+  StringIdLease fileNum(fileIds(), region.path);
+  const RawFileCacheKey key{fileNum.id(), region.offset};
+  auto* ssdCache = cache_->ssdCache();
+  SsdPin ssdPin;
+  if (ssdCache != nullptr) {
+    ssdPin = ssdCache->file(key.fileNum).find(key);
+    if (!ssdPin.empty() && ssdPin.run().size() < region.size) {
+      ssdPin.clear();
+    }
+  }
+  if (ssdPin.empty() && file == nullptr) {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numErrors;
+    return 0;
+  }
+
+  CachePin pin;
+  try {
+    pin = cache_->findOrCreate(key, region.size);
+  } catch (const std::exception& e) {
+    // No space in cache.
+    VELOX_CACHE_LOG(WARNING) << "Failed to make prewarm entry: " << e.what();
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numErrors;
+    return 0;
+  }
+  if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numCached;
+    return 0;
+  }
+  auto* entry = pin.checkedEntry();
+  entry->setPrefetch(true);
+  const bool fromSsd = !ssdPin.empty();
+  try {
+    if (fromSsd) {
+      auto* ssdFile = ssdPin.file();
+      std::vector<SsdPin> ssdPins;
+      ssdPins.push_back(std::move(ssdPin));
+      std::vector<CachePin> pins;
+      pins.push_back(std::move(pin));
+      ssdFile->load(ssdPins, pins);
+      pin = std::move(pins[0]);
+    } else {
+      std::vector<folly::Range<char*>> buffers;
+      if (entry->tinyData() != nullptr) {
+        buffers.emplace_back(entry->tinyData(), region.size);
+      } else {
+        const auto& data = entry->data();
+        uint64_t offset = 0;
+        for (auto i = 0; i < data.numRuns() && offset < region.size; ++i) {
+          const auto run = data.runAt(i);
+          const auto runBytes =
+              std::min<uint64_t>(run.numBytes(), region.size - offset);
+          buffers.emplace_back(run.data<char>(), runBytes);
+          offset += runBytes;
+        }
+      }
+      file->preadv(region.offset, buffers);
+    }
+  } catch (const std::exception& e) {
+    // The exclusive entry is dropped with 'pin'.
+    VELOX_CACHE_LOG(WARNING) << "Failed to prewarm " << region.path << " at "
+                             << region.offset << ": " << e.what();
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numErrors;
+    return 0;
+  }
+  entry->setExclusiveToShared();
+  std::lock_guard<std::mutex> l(mutex_);
+  ++stats_.numLoaded;
+  if (fromSsd) {
+    ++stats_.numSsdLoaded;
+  }
+  stats_.bytesLoaded += region.size;
+  return region.size;
+}
+
+} // namespace facebook::velox::cache
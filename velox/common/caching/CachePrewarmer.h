@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/file/File.h"
+
+namespace facebook::velox::cache {
+
+/// Reloads the hot set of an AsyncDataCache after a restart, so that a new
+/// or restarted worker does not start with an empty cache. The hot set is
+/// the list of AsyncDataCache::hottestRegions(), saved to a local file by
+/// saveHistory() and read back by loadHistory(). start() then loads the
+/// regions hottest first on a background thread. A region found in the SSD
+/// cache is read from SSD, other regions are read from storage through the
+/// ReadFile made by 'openFile'. Loading is throttled to
+/// Options::maxBytesPerSec so as not to compete with queries, and stops when
+/// the cache is filled to Options::maxCachePct. The loaded entries are
+/// marked prefetched, so they are evicted early if they are not hit.
+class CachePrewarmer {
+ public:
+  struct Options {
+    /// Maximum bytes per second loaded. 0 means no limit.
+    uint64_t maxBytesPerSec{64 << 20};
+
+    /// Stops loading when the cache uses this percentage of the capacity of
+    /// its allocator.
+    int32_t maxCachePct{80};
+  };
+
+  struct Stats {
+    /// Regions loaded from storage or SSD.
+    int64_t numLoaded{0};
+    /// Regions loaded from SSD. Also counted in 'numLoaded'.
+    int64_t numSsdLoaded{0};
+    /// Regions that were already cached or being loaded.
+    int64_t numCached{0};
+    /// Regions that failed to load, e.g. because the file is gone.
+    int64_t numErrors{0};
+    int64_t bytesLoaded{0};
+  };
+
+  /// Opens the file of a region. May return nullptr or throw if the file is
+  /// not accessible.
+  using FileOpener =
+      std::function<std::shared_ptr<ReadFile>(const std::string& path)>;
+
+  CachePrewarmer(AsyncDataCache* cache, FileOpener openFile, Options options);
+
+  ~CachePrewarmer();
+
+  /// Writes 'regions' to the local file 'path', replacing a previous file.
+  static void saveHistory(
+      const std::vector<CachedRegion>& regions,
+      const std::string& path);
+
+  /// Reads the regions saved by saveHistory(). Returns an empty list if
+  /// 'path' does not exist or is corrupt.
+  static std::vector<CachedRegion> loadHistory(const std::string& path);
+
+  /// Starts loading 'regions' in order on a background thread. May be called
+  /// once.
+  void start(std::vector<CachedRegion> regions);
+
+  /// Stops loading after the region being loaded.
+  void stop();
+
+  /// Waits until all regions are loaded or loading is stopped.
+  void wait();
+
+  Stats stats() const;
+
+ private:
+  void run(std::vector<CachedRegion> regions);
+
+  // Loads 'region' from SSD or 'file'. 'file' may be nullptr if the file
+  // could not be opened. Returns the bytes loaded.
+  uint64_t loadRegion(const CachedRegion& region, ReadFile* file);
+
+  // True if the cache is full enough to stop loading.
+  bool cacheFull() const;
+
+  AsyncDataCache* const cache_;
+  const FileOpener openFile_;
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  // Signaled by stop() to interrupt throttling.
+  std::condition_variable stopCv_;
+  bool stopped_{false};
+  Stats stats_;
+
+  std::thread thread_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/FileMetadataCache.h"
+
+namespace facebook::velox::cache {
+
+std::shared_ptr<const FileMetadata> FileMetadataCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++numMisses_;
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::insert(
+    const std::string& key,
+    std::shared_ptr<const FileMetadata> metadata) {
+  const auto size = metadata->memoryUsage() + key.size();
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeLocked(it->second);
+  }
+  if (size > maxBytes_) {
+    return;
+  }
+  while (curBytes_ + size > maxBytes_) {
+    removeLocked(std::prev(lru_.end()));
+    ++numEvictions_;
+  }
+  lru_.push_front(Entry{key, std::move(metadata), size});
+  entries_[key] = lru_.begin();
+  curBytes_ += size;
+}
+
+void FileMetadataCache::removeLocked(std::list<Entry>::iterator it) {
+  curBytes_ -= it->size;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  curBytes_ = 0;
+}
+
+FileMetadataCacheStats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  FileMetadataCacheStats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEvictions = numEvictions_;
+  stats.numEntries = entries_.size();
+  stats.curBytes = curBytes_;
+  stats.maxBytes = maxBytes_;
+  return stats;
+}
+
+} // namespace facebook::velox::cache
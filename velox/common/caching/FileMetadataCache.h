@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <fmt/format.h>
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::cache {
+
+/// Parsed metadata of a file, e.g. the footer of a DWRF or Parquet file.
+/// Immutable once inserted into a FileMetadataCache.
+class FileMetadata {
+ public:
+  virtual ~FileMetadata() = default;
+
+  /// Returns the number of bytes charged to the cache for 'this'.
+  virtual uint64_t memoryUsage() const = 0;
+};
+
+struct FileMetadataCacheStats {
+  uint64_t numHits{0};
+  uint64_t numMisses{0};
+  uint64_t numEvictions{0};
+  uint64_t numEntries{0};
+  uint64_t curBytes{0};
+  uint64_t maxBytes{0};
+
+  std::string toString() const {
+    return fmt::format(
+        "hits {} misses {} evictions {} entries {} bytes {}/{}",
+        numHits,
+        numMisses,
+        numEvictions,
+        numEntries,
+        curBytes,
+        maxBytes);
+  }
+};
+
+/// LRU cache of parsed file metadata shared by the readers of all queries.
+/// The key identifies a version of a file, e.g. its path plus modification
+/// time or etag, so that a rewritten file does not hit a stale entry. The
+/// total memoryUsage() of the entries is kept under 'maxBytes'. Thread-safe.
+class FileMetadataCache {
+ public:
+  explicit FileMetadataCache(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Returns the metadata for 'key' or nullptr if not cached.
+  std::shared_ptr<const FileMetadata> find(const std::string& key);
+
+  /// Adds 'metadata' for 'key', replacing the previous entry. Evicts the least
+  /// recently used entries to stay within the size limit. Metadata larger
+  /// than the limit is not cached.
+  void insert(
+      const std::string& key,
+      std::shared_ptr<const FileMetadata> metadata);
+
+  void clear();
+
+  FileMetadataCacheStats stats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const FileMetadata> metadata;
+    uint64_t size;
+  };
+
+  // Removes the entry at 'it'.
+  void removeLocked(std::list<Entry>::iterator it);
+
+  const uint64_t maxBytes_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<std::string, std::list<Entry>::iterator> entries_;
+  uint64_t curBytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::cache
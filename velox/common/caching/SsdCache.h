@@ -43,13 +43,18 @@ class SsdCache {
   /// write) feature if the underlying filesystem (such as brtfs) supports it.
   /// This prevents the actual cache space usage on disk from exceeding the
   /// 'maxBytes' limit and stop working.
+  /// If 'useIoUring' is true, the files are read and written with io_uring.
+  /// The coalesced reads of a load and the writes of a batch of entries are
+  /// then each issued as one submission. Falls back to pread/pwrite if
+  /// io_uring is not supported.
   SsdCache(
       std::string_view filePrefix,
       uint64_t maxBytes,
       int32_t numShards,
       folly::Executor* executor,
       int64_t checkpointIntervalBytes = 0,
-      bool disableFileCow = false);
+      bool disableFileCow = false,
+      bool useIoUring = false);
 
   /// Returns the shard corresponding to 'fileId'. 'fileId' is a file id from
   /// e.g. FileCacheKey.
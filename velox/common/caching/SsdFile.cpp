@@ -17,25 +17,40 @@
 #include "velox/common/caching/SsdFile.h"
 
 #include <folly/Executor.h>
+#include <folly/ScopeGuard.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/Crc.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
 #include <linux/fs.h>
 #endif // linux
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
-#include <fstream>
+#include <cstdlib>
 #include <numeric>
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_uint64(
+    ssd_max_write_bytes_per_sec,
+    0,
+    "If not 0, the maximum rate of writes to each SSD cache file");
+DEFINE_int32(
+    ssd_write_read_priority_ms,
+    0,
+    "Maximum time a write to an SSD cache file waits for the reads of the "
+    "file in progress to finish");
 
 namespace facebook::velox::cache {
 
@@ -124,7 +139,8 @@ SsdFile::SsdFile(
     int32_t maxRegions,
     int64_t checkpointIntervalBytes,
     bool disableFileCow,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    bool useIoUring)
     : fileName_(filename),
       maxRegions_(maxRegions),
       shardId_(shardId),
@@ -152,6 +168,14 @@ SsdFile::SsdFile(
   }
 
   readFile_ = std::make_unique<LocalReadFile>(fd_);
+  if (useIoUring) {
+    if (SsdIoUring::isSupported()) {
+      ioUring_ = std::make_unique<SsdIoUring>(fd_);
+    } else {
+      VELOX_SSD_CACHE_LOG(WARNING)
+          << "io_uring is not supported, using pread/pwrite for " << fileName_;
+    }
+  }
   uint64_t size = lseek(fd_, 0, SEEK_END);
   numRegions_ = size / kRegionSize;
   if (numRegions_ > maxRegions_) {
@@ -168,11 +192,16 @@ SsdFile::SsdFile(
   regionSizes_.resize(maxRegions_);
   erasedRegionSizes_.resize(maxRegions_);
   regionPins_.resize(maxRegions_);
+  pendingRecovery_.resize(maxRegions_);
   if (checkpointIntervalBytes_) {
     initializeCheckpoint();
   }
 }
 
+SsdFile::~SsdFile() {
+  stopRecovery();
+}
+
 void SsdFile::pinRegion(uint64_t offset) {
   std::lock_guard<std::shared_mutex> l(mutex_);
   pinRegionLocked(offset);
@@ -213,6 +242,7 @@ bool SsdFile::erase(RawFileCacheKey key) {
   if (it == entries_.end()) {
     return false;
   }
+  regionBytesErasedLocked(regionIndex(it->second.offset()), it->second.size());
   entries_.erase(it);
   return true;
 }
@@ -224,6 +254,10 @@ CoalesceIoStats SsdFile::load(
   if (pins.empty()) {
     return CoalesceIoStats();
   }
+  ++numReadsInProgress_;
+  SCOPE_EXIT {
+    --numReadsInProgress_;
+  };
   int payloadTotal = 0;
   for (auto i = 0; i < pins.size(); ++i) {
     const auto runSize = ssdPins[i].run().size();
@@ -243,7 +277,9 @@ CoalesceIoStats SsdFile::load(
 
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
-  // gap. For longer payloads this is ~50-100K.
+  // gap. For longer payloads this is ~50-100K. With io_uring, the coalesced
+  // reads are collected and submitted as one batch.
+  std::vector<SsdIoUring::Request> reads;
   auto stats = readPins(
       pins,
       payloadTotal / pins.size() < 10000 ? 25000 : 50000,
@@ -257,9 +293,29 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (ioUring_ != nullptr) {
+          addReadRequest(offset, buffers, reads);
+        } else {
+          read(offset, buffers);
+        }
       });
 
+  if (!reads.empty()) {
+    submitIo(reads);
+    for (const auto& request : reads) {
+      if (FOLLY_UNLIKELY(request.result != static_cast<int64_t>(request.bytes()))) {
+        ++stats_.readSsdErrors;
+        VELOX_FAIL(
+            "IOERR: Failed to read {} from SSD file {} at offset {}: {}",
+            succinctBytes(request.bytes()),
+            fileName_,
+            request.offset,
+            request.result < 0 ? folly::errnoStr(-request.result)
+                               : "short read");
+      }
+    }
+  }
+
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
   }
@@ -270,11 +326,56 @@ void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
   process::TraceContext trace("SsdFile::read");
-  readFile_->preadv(offset, buffers);
+  uint64_t latencyUs{0};
+  {
+    MicrosecondTimer timer(&latencyUs);
+    readFile_->preadv(offset, buffers);
+  }
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricSsdCacheReadLatencyUs, latencyUs);
+}
+
+// static
+void SsdFile::addReadRequest(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    std::vector<SsdIoUring::Request>& requests) {
+  // Gaps are under the coalesce distance of load(), so most take a single
+  // iovec. The contents are discarded, so all gaps of all requests in flight
+  // share the buffer.
+  static thread_local std::vector<char> droppedBytes(64 * 1024);
+  auto& request = requests.emplace_back();
+  request.offset = offset;
+  request.iovecs.reserve(buffers.size());
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      request.iovecs.push_back({range.data(), range.size()});
+      continue;
+    }
+    auto skipSize = range.size();
+    while (skipSize > 0) {
+      const auto bytes = std::min<size_t>(droppedBytes.size(), skipSize);
+      request.iovecs.push_back({droppedBytes.data(), bytes});
+      skipSize -= bytes;
+    }
+  }
+}
+
+void SsdFile::submitIo(std::vector<SsdIoUring::Request>& requests) {
+  process::TraceContext trace("SsdFile::submitIo");
+  uint64_t latencyUs{0};
+  {
+    MicrosecondTimer timer(&latencyUs);
+    ioUring_->submit(requests);
+  }
+  ++stats_.ioUringSubmissions;
+  stats_.ioUringRequests += requests.size();
+  ++stats_.ioUringQueueDepth[SsdCacheStats::ioHistogramBucket(
+      std::min<uint64_t>(requests.size(), ioUring_->queueDepth()))];
+  ++stats_.ioUringLatencyUs[SsdCacheStats::ioHistogramBucket(latencyUs)];
 }
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<uint64_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -289,13 +390,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -329,8 +429,14 @@ bool SsdFile::growOrEvictLocked() {
                << newSize;
   }
 
+  // Mostly erased regions lose few entries when evicted, even if hot.
+  std::vector<int32_t> livePct(maxRegions_, 100);
+  for (auto region = 0; region < numRegions_; ++region) {
+    livePct[region] = (regionSizes_[region] - erasedRegionSizes_[region]) *
+        100 / kRegionSize;
+  }
   auto candidates =
-      tracker_.findEvictionCandidates(3, numRegions_, regionPins_);
+      tracker_.findEvictionCandidates(3, numRegions_, regionPins_, livePct);
   if (candidates.empty()) {
     suspended_ = true;
     return false;
@@ -361,6 +467,8 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
     tracker_.regionCleared(region);
     regionSizes_[region] = 0;
     erasedRegionSizes_[region] = 0;
+    // The entries of the region in a checkpoint being recovered are stale.
+    pendingRecovery_[region] = false;
   }
 }
 
@@ -369,17 +477,26 @@ void SsdFile::write(std::vector<CachePin>& pins) {
   // Sorts the pins by their file/offset. In this way what is adjacent in
   // storage is likely adjacent on SSD.
   std::sort(pins.begin(), pins.end());
+  std::vector<uint64_t> sizes;
+  sizes.reserve(pins.size());
   for (const auto& pin : pins) {
     auto* entry = pin.checkedEntry();
     VELOX_CHECK_NULL(entry->ssdFile());
+    sizes.push_back(entry->size());
   }
+  compactRegions();
 
+  // With io_uring, the writes for all the runs of space are submitted as one
+  // batch after the space is allocated. 'writePins' has the first pin and the
+  // number of pins of each write.
+  std::vector<SsdIoUring::Request> writes;
+  std::vector<std::pair<int32_t, int32_t>> writePins;
   int32_t storeIndex = 0;
   while (storeIndex < pins.size()) {
-    auto space = getSpace(pins, storeIndex);
+    auto space = getSpace(sizes, storeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
-      return;
+      break;
     }
 
     auto [offset, available] = space.value();
@@ -397,6 +514,17 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       ++numWritten;
     }
     VELOX_CHECK_GE(fileSize_, offset + bytes);
+    throttleWrite(bytes);
+
+    if (ioUring_ != nullptr) {
+      auto& request = writes.emplace_back();
+      request.write = true;
+      request.offset = offset;
+      request.iovecs = std::move(iovecs);
+      writePins.emplace_back(storeIndex, numWritten);
+      storeIndex += numWritten;
+      continue;
+    }
 
     const auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
     if (rc != bytes) {
@@ -411,25 +539,28 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       return;
     }
 
-    {
-      std::lock_guard<std::shared_mutex> l(mutex_);
-      for (auto i = storeIndex; i < storeIndex + numWritten; ++i) {
-        auto* entry = pins[i].checkedEntry();
-        entry->setSsdFile(this, offset);
-        const auto size = entry->size();
-        FileCacheKey key = {
-            entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
-        if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size));
-        }
-        offset += size;
-        ++stats_.entriesWritten;
-        stats_.bytesWritten += size;
-        bytesAfterCheckpoint_ += size;
+    addWrittenEntries(pins, storeIndex, numWritten, offset);
+    storeIndex += numWritten;
+  }
+
+  if (!writes.empty()) {
+    submitIo(writes);
+    for (auto i = 0; i < writes.size(); ++i) {
+      const auto& request = writes[i];
+      if (request.result != static_cast<int64_t>(request.bytes())) {
+        VELOX_SSD_CACHE_LOG(ERROR)
+            << "Failed to write to SSD, file name: " << fileName_
+            << ", fd: " << fd_ << ", size: " << request.iovecs.size()
+            << ", offset: " << request.offset << ", error: "
+            << (request.result < 0 ? folly::errnoStr(-request.result)
+                                   : "short write");
+        ++stats_.writeSsdErrors;
+        // The entries of a failed write are not added to the cache.
+        continue;
       }
+      addWrittenEntries(
+          pins, writePins[i].first, writePins[i].second, request.offset);
     }
-    storeIndex += numWritten;
   }
 
   if ((checkpointIntervalBytes_ > 0) &&
@@ -438,6 +569,37 @@ void SsdFile::write(std::vector<CachePin>& pins) {
   }
 }
 
+void SsdFile::addWrittenEntries(
+    const std::vector<CachePin>& pins,
+    int32_t begin,
+    int32_t numWritten,
+    uint64_t offset) {
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  for (auto i = begin; i < begin + numWritten; ++i) {
+    auto* entry = pins[i].checkedEntry();
+    entry->setSsdFile(this, offset);
+    const auto size = entry->size();
+    FileCacheKey key = {
+        entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      // The previous copy of the entry is no longer referenced.
+      regionBytesErasedLocked(
+          regionIndex(it->second.offset()), it->second.size());
+      it->second = SsdRun(offset, size);
+    } else {
+      entries_.emplace(std::move(key), SsdRun(offset, size));
+    }
+    if (FLAGS_ssd_verify_write) {
+      verifyWrite(*entry, SsdRun(offset, size));
+    }
+    offset += size;
+    ++stats_.entriesWritten;
+    stats_.bytesWritten += size;
+    bytesAfterCheckpoint_ += size;
+  }
+}
+
 namespace {
 int32_t indexOfFirstMismatch(char* x, char* y, int n) {
   for (auto i = 0; i < n; ++i) {
@@ -507,6 +669,18 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+  stats.checkpointRegionsRecovered += stats_.checkpointRegionsRecovered;
+  stats.checkpointRegionsDiscarded += stats_.checkpointRegionsDiscarded;
+  stats.writeThrottleUs += stats_.writeThrottleUs;
+  stats.regionsCompacted += stats_.regionsCompacted;
+  stats.bytesCompacted += stats_.bytesCompacted;
+
+  stats.ioUringSubmissions += stats_.ioUringSubmissions;
+  stats.ioUringRequests += stats_.ioUringRequests;
+  for (auto i = 0; i < SsdCacheStats::kNumIoHistogramBuckets; ++i) {
+    stats.ioUringQueueDepth[i] += stats_.ioUringQueueDepth[i];
+    stats.ioUringLatencyUs[i] += stats_.ioUringLatencyUs[i];
+  }
 }
 
 void SsdFile::clear() {
@@ -514,12 +688,16 @@ void SsdFile::clear() {
   entries_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
+  std::fill(pendingRecovery_.begin(), pendingRecovery_.end(), false);
+  regionsToCompact_.clear();
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
 }
 
 void SsdFile::deleteFile() {
   process::TraceContext trace("SsdFile::deleteFile");
+  stopRecovery();
+  ioUring_.reset();
   if (fd_) {
     close(fd_);
     fd_ = 0;
@@ -566,17 +744,20 @@ bool SsdFile::removeFileEntries(
     }
 
     entriesAgedOut++;
-    erasedRegionSizes_[region] += ssdRun.size();
+    regionBytesErasedLocked(region, ssdRun.size());
 
     it = entries_.erase(it);
   }
 
+  // Regions with no live entries are reused right away. The others are
+  // compacted by the next write.
   std::vector<int32_t> toFree;
-  toFree.reserve(numRegions_);
-  for (auto region = 0; region < numRegions_; region++) {
-    if (erasedRegionSizes_[region] >
-        regionSizes_[region] * kMaxErasedSizePct / 100) {
-      toFree.push_back(region);
+  for (auto it = regionsToCompact_.begin(); it != regionsToCompact_.end();) {
+    if (erasedRegionSizes_[*it] >= regionSizes_[*it]) {
+      toFree.push_back(*it);
+      it = regionsToCompact_.erase(it);
+    } else {
+      ++it;
     }
   }
   if (toFree.size() > 0) {
@@ -597,6 +778,164 @@ bool SsdFile::removeFileEntries(
   return true;
 }
 
+void SsdFile::regionBytesErasedLocked(int32_t region, uint64_t size) {
+  erasedRegionSizes_[region] += size;
+  if (static_cast<uint64_t>(erasedRegionSizes_[region]) * 100 <=
+      static_cast<uint64_t>(regionSizes_[region]) * kMaxErasedSizePct) {
+    return;
+  }
+  if (std::find(writableRegions_.begin(), writableRegions_.end(), region) !=
+          writableRegions_.end() ||
+      std::find(regionsToCompact_.begin(), regionsToCompact_.end(), region) !=
+          regionsToCompact_.end()) {
+    return;
+  }
+  regionsToCompact_.push_back(region);
+}
+
+void SsdFile::throttleWrite(uint64_t bytes) {
+  constexpr uint64_t kReadWaitUs = 100;
+  const uint64_t maxReadWaitUs = FLAGS_ssd_write_read_priority_ms * 1'000;
+  uint64_t waitUs = 0;
+  // Reads are cache hits that a query waits for, whereas writes can be late.
+  while (numReadsInProgress_ > 0 && waitUs < maxReadWaitUs) {
+    std::this_thread::sleep_for(std::chrono::microseconds(kReadWaitUs));
+    waitUs += kReadWaitUs;
+  }
+  if (FLAGS_ssd_max_write_bytes_per_sec > 0) {
+    auto nowUs = getCurrentTimeMicro();
+    if (nextWriteUs_ > nowUs) {
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(nextWriteUs_ - nowUs));
+      waitUs += nextWriteUs_ - nowUs;
+      nowUs = nextWriteUs_;
+    }
+    nextWriteUs_ =
+        nowUs + bytes * 1'000'000 / FLAGS_ssd_max_write_bytes_per_sec;
+  }
+  stats_.writeThrottleUs += waitUs;
+}
+
+void SsdFile::compactRegions() {
+  std::vector<int32_t> regions;
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    regions.swap(regionsToCompact_);
+  }
+  std::vector<int32_t> retry;
+  for (const auto region : regions) {
+    if (!compactRegion(region)) {
+      retry.push_back(region);
+    }
+  }
+  if (!retry.empty()) {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    regionsToCompact_.insert(
+        regionsToCompact_.end(), retry.begin(), retry.end());
+  }
+}
+
+bool SsdFile::compactRegion(int32_t region) {
+  process::TraceContext trace("SsdFile::compactRegion");
+  std::vector<std::pair<FileCacheKey, SsdRun>> live;
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    if (static_cast<uint64_t>(erasedRegionSizes_[region]) * 100 <=
+        static_cast<uint64_t>(regionSizes_[region]) * kMaxErasedSizePct) {
+      // The region was evicted or cleared after it was queued.
+      return true;
+    }
+    if (pendingRecovery_[region]) {
+      return false;
+    }
+    for (const auto& [key, run] : entries_) {
+      if (regionIndex(run.offset()) == region) {
+        live.emplace_back(key, run);
+      }
+    }
+    // The pin keeps the region from being evicted while its entries move.
+    pinRegionLocked(region * kRegionSize);
+  }
+  SCOPE_EXIT {
+    unpinRegion(region * kRegionSize);
+  };
+  std::sort(live.begin(), live.end(), [](const auto& left, const auto& right) {
+    return left.second.offset() < right.second.offset();
+  });
+
+  std::vector<uint64_t> sizes;
+  sizes.reserve(live.size());
+  uint64_t totalBytes = 0;
+  for (const auto& [key, run] : live) {
+    sizes.push_back(run.size());
+    totalBytes += run.size();
+  }
+  // O_DIRECT needs page aligned buffers.
+  constexpr uint64_t kAlignment = 4096;
+  std::unique_ptr<char, decltype(&std::free)> buffer(
+      static_cast<char*>(std::aligned_alloc(
+          kAlignment,
+          bits::roundUp(std::max<uint64_t>(totalBytes, 1), kAlignment))),
+      &std::free);
+  uint64_t bufferOffset = 0;
+  for (const auto& [key, run] : live) {
+    read(
+        run.offset(),
+        {folly::Range<char*>(buffer.get() + bufferOffset, run.size())});
+    bufferOffset += run.size();
+  }
+
+  // New offset of each moved entry.
+  std::vector<uint64_t> newOffsets;
+  newOffsets.reserve(live.size());
+  bufferOffset = 0;
+  int32_t index = 0;
+  while (index < live.size()) {
+    auto space = getSpace(sizes, index);
+    if (!space.has_value()) {
+      break;
+    }
+    auto [offset, available] = space.value();
+    throttleWrite(available);
+    const auto rc =
+        folly::pwrite(fd_, buffer.get() + bufferOffset, available, offset);
+    if (rc != available) {
+      ++stats_.writeSsdErrors;
+      break;
+    }
+    bufferOffset += available;
+    while (index < live.size() && available > 0) {
+      newOffsets.push_back(offset);
+      offset += sizes[index];
+      available -= sizes[index];
+      ++index;
+    }
+  }
+
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  for (auto i = 0; i < newOffsets.size(); ++i) {
+    auto it = entries_.find(live[i].first);
+    if (it != entries_.end() && it->second.bits() == live[i].second.bits()) {
+      it->second = SsdRun(newOffsets[i], live[i].second.size());
+    } else {
+      // The entry was erased or rewritten while being moved.
+      regionBytesErasedLocked(
+          regionIndex(newOffsets[i]), live[i].second.size());
+    }
+  }
+  if (newOffsets.size() < live.size()) {
+    // No space or a write error. The entries not moved stay in place.
+    return true;
+  }
+  logEviction({region});
+  clearRegionEntriesLocked({region});
+  writableRegions_.push_back(region);
+  ++stats_.regionsCompacted;
+  stats_.bytesCompacted += totalBytes;
+  bytesAfterCheckpoint_ += totalBytes;
+  return true;
+}
+
 void SsdFile::logEviction(const std::vector<int32_t>& regions) {
   if (checkpointIntervalBytes_ > 0) {
     const int32_t rc = ::write(
@@ -647,19 +986,27 @@ void SsdFile::checkpointError(int32_t rc, const std::string& error) {
 }
 
 namespace {
-template <typename T>
-inline char* asChar(T ptr) {
-  return reinterpret_cast<char*>(ptr);
-}
-
-template <typename T>
-inline const char* asChar(const T* ptr) {
-  return reinterpret_cast<const char*>(ptr);
+// Returns the CRC32 of 'size' bytes at 'data'.
+uint32_t checksum(const char* data, uint64_t size) {
+  constexpr uint64_t kMaxChunk = 1 << 30;
+  bits::Crc32 crc;
+  for (uint64_t offset = 0; offset < size; offset += kMaxChunk) {
+    crc.process_bytes(data + offset, std::min(kMaxChunk, size - offset));
+  }
+  return crc.checksum();
 }
 } // namespace
 
 void SsdFile::checkpoint(bool force) {
   process::TraceContext trace("SsdFile::checkpoint");
+  if (recovering_) {
+    // The checkpoint being recovered is mapped and is not overwritten before
+    // all its entries are installed.
+    if (!force) {
+      return;
+    }
+    waitForRecovery();
+  }
   std::lock_guard<std::shared_mutex> l(mutex_);
   if (!force && (bytesAfterCheckpoint_ < checkpointIntervalBytes_)) {
     return;
@@ -690,70 +1037,114 @@ void SsdFile::checkpoint(bool force) {
       return rc;
     };
 
-    std::ofstream state;
-    auto checkpointPath = fileName_ + kCheckpointExtension;
-    state.exceptions(std::ofstream::failbit);
-    state.open(checkpointPath, std::ios_base::out | std::ios_base::trunc);
-    // The checkpoint state file contains:
-    // int32_t The 4 bytes of kCheckpointMagic,
-    // int32_t maxRegions,
-    // int32_t numRegions,
-    // regionScores from the 'tracker_',
-    // {fileId, fileName} pairs,
-    // kMapMarker,
-    // {fileId, offset, SSdRun} triples,
-    // kEndMarker.
-    state.write(kCheckpointMagic, sizeof(int32_t));
-    state.write(asChar(&maxRegions_), sizeof(maxRegions_));
-    state.write(asChar(&numRegions_), sizeof(numRegions_));
+    // Counts the entries of each region and collects the file names.
+    std::vector<uint32_t> numRegionEntries(maxRegions_);
+    std::vector<std::pair<uint64_t, std::string>> fileNames;
+    folly::F14FastSet<uint64_t> fileNums;
+    uint64_t fileNamesSize = sizeof(int32_t);
+    for (const auto& [key, run] : entries_) {
+      ++numRegionEntries[regionIndex(run.offset())];
+      const auto fileNum = key.fileNum.id();
+      if (fileNums.insert(fileNum).second) {
+        fileNames.emplace_back(fileNum, fileIds().string(fileNum));
+        fileNamesSize += sizeof(uint64_t) + sizeof(int32_t) +
+            fileNames.back().second.size();
+      }
+    }
+    const uint64_t headerSize = bits::roundUp(
+        sizeof(CheckpointHeader) +
+            maxRegions_ * (sizeof(uint64_t) + sizeof(CheckpointRegion)) +
+            fileNamesSize,
+        sizeof(uint64_t));
+    const uint64_t checkpointSize =
+        headerSize + entries_.size() * sizeof(CheckpointEntry);
+
+    // The checkpoint is written through a shared mapping, so that the entries
+    // of each region are placed in one pass over 'entries_'.
+    const auto checkpointPath = fileName_ + kCheckpointExtension;
+    const auto checkpointFd = checkRc(
+        ::open(
+            checkpointPath.c_str(),
+            O_CREAT | O_RDWR | O_TRUNC,
+            S_IRUSR | S_IWUSR),
+        "Open of checkpoint file");
+    SCOPE_EXIT {
+      ::close(checkpointFd);
+    };
+    checkRc(
+        ::ftruncate(checkpointFd, checkpointSize),
+        "Truncate of checkpoint file");
+    auto* data = reinterpret_cast<char*>(::mmap(
+        nullptr,
+        checkpointSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        checkpointFd,
+        0));
+    if (data == MAP_FAILED) {
+      ++stats_.writeCheckpointErrors;
+      checkRc(-1, "Map of checkpoint file");
+    }
+    SCOPE_EXIT {
+      ::munmap(data, checkpointSize);
+    };
 
+    auto* header = reinterpret_cast<CheckpointHeader*>(data);
+    memcpy(header->magic, kCheckpointMagic, sizeof(header->magic));
+    header->maxRegions = maxRegions_;
+    header->numRegions = numRegions_;
+    header->checksum = 0;
+    header->size = headerSize;
+    auto* position = data + sizeof(CheckpointHeader);
     // Copy the region scores before writing out for tsan.
     const auto scoresCopy = tracker_.copyScores();
-    state.write(asChar(scoresCopy.data()), maxRegions_ * sizeof(uint64_t));
-    std::unordered_set<uint64_t> fileNums;
-    for (const auto& entry : entries_) {
-      const auto fileNum = entry.first.fileNum.id();
-      if (fileNums.insert(fileNum).second) {
-        state.write(asChar(&fileNum), sizeof(fileNum));
-        const auto name = fileIds().string(fileNum);
-        const int32_t length = name.size();
-        state.write(asChar(&length), sizeof(length));
-        state.write(name.data(), length);
-      }
+    memcpy(position, scoresCopy.data(), maxRegions_ * sizeof(uint64_t));
+    position += maxRegions_ * sizeof(uint64_t);
+    auto* regions = reinterpret_cast<CheckpointRegion*>(position);
+    position += maxRegions_ * sizeof(CheckpointRegion);
+    const int32_t numFileNames = fileNames.size();
+    memcpy(position, &numFileNames, sizeof(numFileNames));
+    position += sizeof(numFileNames);
+    for (const auto& [fileNum, name] : fileNames) {
+      const int32_t length = name.size();
+      memcpy(position, &fileNum, sizeof(fileNum));
+      position += sizeof(fileNum);
+      memcpy(position, &length, sizeof(length));
+      position += sizeof(length);
+      memcpy(position, name.data(), length);
+      position += length;
     }
 
-    const auto mapMarker = kCheckpointMapMarker;
-    state.write(asChar(&mapMarker), sizeof(mapMarker));
-    for (auto& pair : entries_) {
-      auto id = pair.first.fileNum.id();
-      state.write(asChar(&id), sizeof(id));
-      state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
-      auto offsetAndSize = pair.second.bits();
-      state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+    uint64_t entriesOffset = headerSize;
+    for (auto i = 0; i < maxRegions_; ++i) {
+      regions[i] = {entriesOffset, 0, regionSizes_[i], 0, 0};
+      entriesOffset += numRegionEntries[i] * sizeof(CheckpointEntry);
+    }
+    for (const auto& [key, run] : entries_) {
+      auto& region = regions[regionIndex(run.offset())];
+      auto* entry = reinterpret_cast<CheckpointEntry*>(
+                        data + region.entriesOffset) +
+          region.numEntries++;
+      *entry = {key.fileNum.id(), key.offset, run.bits()};
+    }
+    for (auto i = 0; i < maxRegions_; ++i) {
+      regions[i].checksum = checksum(
+          data + regions[i].entriesOffset,
+          regions[i].numEntries * sizeof(CheckpointEntry));
     }
 
     // NOTE: we need to ensure cache file data sync update completes before
-    // updating checkpoint file.
+    // the header checksum makes the checkpoint readable.
     const auto fileSyncRc = fileSync->move();
     checkRc(*fileSyncRc, "Sync of cache data file");
 
-    const auto endMarker = kCheckpointEndMarker;
-    state.write(asChar(&endMarker), sizeof(endMarker));
-
-    if (state.bad()) {
+    constexpr auto kChecksumBegin = offsetof(CheckpointHeader, size);
+    header->checksum =
+        checksum(data + kChecksumBegin, headerSize - kChecksumBegin);
+    if (::msync(data, checkpointSize, MS_SYNC) < 0) {
       ++stats_.writeCheckpointErrors;
-      checkRc(-1, "Write of checkpoint file");
+      checkRc(-1, "Sync of checkpoint file");
     }
-    state.close();
-
-    // Sync checkpoint data file. ofstream does not have a sync method, so open
-    // as fd and sync that.
-    const auto checkpointFd = checkRc(
-        ::open(checkpointPath.c_str(), O_WRONLY),
-        "Open of checkpoint file for sync");
-    VELOX_CHECK_GE(checkpointFd, 0);
-    checkRc(::fsync(checkpointFd), "Sync of checkpoint file");
-    ::close(checkpointFd);
 
     // NOTE: we shall truncate eviction log after checkpoint file sync
     // completes so that we never recover from an old checkpoint file without
@@ -773,14 +1164,20 @@ void SsdFile::initializeCheckpoint() {
   if (checkpointIntervalBytes_ == 0) {
     return;
   }
-  bool hasCheckpoint = true;
-  std::ifstream state(fileName_ + kCheckpointExtension);
-  if (!state.is_open()) {
-    hasCheckpoint = false;
+  const auto checkpointPath = fileName_ + kCheckpointExtension;
+  const auto checkpointFd = ::open(checkpointPath.c_str(), O_RDONLY);
+  const bool hasCheckpoint = checkpointFd >= 0;
+  if (!hasCheckpoint) {
     ++stats_.openCheckpointErrors;
     VELOX_SSD_CACHE_LOG(INFO)
         << "Starting shard " << shardId_ << " without checkpoint";
   }
+  // The mapping made by readCheckpoint() stays valid after the close.
+  SCOPE_EXIT {
+    if (hasCheckpoint) {
+      ::close(checkpointFd);
+    }
+  };
   const auto logPath = fileName_ + kLogExtension;
   evictLogFd_ = ::open(logPath.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
   if (evictLogFd_ < 0) {
@@ -795,14 +1192,14 @@ void SsdFile::initializeCheckpoint() {
 
   try {
     if (hasCheckpoint) {
-      state.exceptions(std::ifstream::failbit);
-      readCheckpoint(state);
+      readCheckpoint(checkpointFd);
     }
   } catch (const std::exception& e) {
     ++stats_.readCheckpointErrors;
     try {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
+      releaseCheckpointMap();
       entries_.clear();
       deleteCheckpoint(true);
     } catch (const std::exception&) {
@@ -827,38 +1224,65 @@ bool SsdFile::testingIsCowDisabled() const {
 #endif // linux
 }
 
-namespace {
-template <typename T>
-T readNumber(std::ifstream& stream) {
-  T data;
-  stream.read(asChar(&data), sizeof(T));
-  return data;
-}
-} // namespace
+void SsdFile::readCheckpoint(int32_t fd) {
+  struct stat fileStat;
+  VELOX_CHECK_EQ(
+      ::fstat(fd, &fileStat),
+      0,
+      "Failed to stat checkpoint: {}",
+      folly::errnoStr(errno));
+  const uint64_t size = fileStat.st_size;
+  VELOX_CHECK_GE(size, sizeof(CheckpointHeader), "Checkpoint is truncated");
+  auto* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  VELOX_CHECK(
+      data != MAP_FAILED,
+      "Failed to map checkpoint: {}",
+      folly::errnoStr(errno));
+  checkpointMap_ = reinterpret_cast<const char*>(data);
+  checkpointMapSize_ = size;
 
-void SsdFile::readCheckpoint(std::ifstream& state) {
-  char magic[4];
-  state.read(magic, sizeof(magic));
-  VELOX_CHECK_EQ(strncmp(magic, kCheckpointMagic, 4), 0);
-  const auto maxRegions = readNumber<int32_t>(state);
+  const auto* header = reinterpret_cast<const CheckpointHeader*>(data);
+  VELOX_CHECK_EQ(strncmp(header->magic, kCheckpointMagic, 4), 0);
   VELOX_CHECK_EQ(
-      maxRegions,
+      header->maxRegions,
       maxRegions_,
       "Trying to start from checkpoint with a different capacity");
-  numRegions_ = readNumber<int32_t>(state);
-  std::vector<int64_t> scores(maxRegions);
-  state.read(asChar(scores.data()), maxRegions_ * sizeof(uint64_t));
-  std::unordered_map<uint64_t, StringIdLease> idMap;
-  for (;;) {
-    auto id = readNumber<uint64_t>(state);
-    if (id == kCheckpointMapMarker) {
-      break;
-    }
-    std::string name;
-    name.resize(readNumber<int32_t>(state));
-    state.read(name.data(), name.size());
-    auto lease = StringIdLease(fileIds(), name);
-    idMap[id] = std::move(lease);
+  VELOX_CHECK_LE(header->numRegions, maxRegions_);
+  const uint64_t minHeaderSize = sizeof(CheckpointHeader) +
+      maxRegions_ * (sizeof(uint64_t) + sizeof(CheckpointRegion)) +
+      sizeof(int32_t);
+  VELOX_CHECK(
+      header->size >= minHeaderSize && header->size <= size,
+      "Checkpoint header is truncated");
+  constexpr auto kChecksumBegin = offsetof(CheckpointHeader, size);
+  VELOX_CHECK_EQ(
+      header->checksum,
+      checksum(checkpointMap_ + kChecksumBegin, header->size - kChecksumBegin),
+      "Checkpoint header checksum mismatch");
+
+  const auto* position = checkpointMap_ + sizeof(CheckpointHeader);
+  const auto* end = checkpointMap_ + header->size;
+  std::vector<int64_t> scores(maxRegions_);
+  memcpy(scores.data(), position, maxRegions_ * sizeof(uint64_t));
+  position += maxRegions_ * sizeof(uint64_t);
+  const auto* regions = reinterpret_cast<const CheckpointRegion*>(position);
+  position += maxRegions_ * sizeof(CheckpointRegion);
+  int32_t numFileNames;
+  memcpy(&numFileNames, position, sizeof(numFileNames));
+  position += sizeof(numFileNames);
+  for (auto i = 0; i < numFileNames; ++i) {
+    uint64_t fileNum;
+    int32_t length;
+    VELOX_CHECK(position + sizeof(fileNum) + sizeof(length) <= end);
+    memcpy(&fileNum, position, sizeof(fileNum));
+    position += sizeof(fileNum);
+    memcpy(&length, position, sizeof(length));
+    position += sizeof(length);
+    VELOX_CHECK(length >= 0 && position + length <= end);
+    // The file may have a different id on restore.
+    checkpointFileIds_[fileNum] =
+        StringIdLease(fileIds(), std::string_view(position, length));
+    position += length;
   }
 
   const auto logSize = ::lseek(evictLogFd_, 0, SEEK_END);
@@ -869,37 +1293,153 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
   for (auto region : evicted) {
     evictedMap.insert(region);
   }
-  for (;;) {
-    const uint64_t fileNum = readNumber<uint64_t>(state);
-    if (fileNum == kCheckpointEndMarker) {
-      break;
-    }
-    const uint64_t offset = readNumber<uint64_t>(state);
-    const auto run = SsdRun(readNumber<uint64_t>(state));
-    // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
-      // The file may have a different id on restore.
-      auto it = idMap.find(fileNum);
-      VELOX_CHECK(it != idMap.end());
-      FileCacheKey key{it->second, offset};
-      entries_[std::move(key)] = run;
-    }
-  }
-  // The state is successfully read. Install the access frequency scores and
-  // evicted regions.
+
+  // The header is valid. Install the access frequency scores and evicted
+  // regions. The entries of the other regions are recovered in the
+  // background, hottest region first, and are checked region by region.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
+  numRegions_ = header->numRegions;
   // Set the writable regions by deduplicated evicted regions.
   writableRegions_.clear();
   for (auto region : evictedMap) {
     writableRegions_.push_back(region);
   }
   tracker_.setRegionScores(scores);
+  std::vector<int32_t> toRecover;
+  for (auto region = 0; region < numRegions_; ++region) {
+    if (regions[region].numEntries > 0 &&
+        evictedMap.find(region) == evictedMap.end()) {
+      pendingRecovery_[region] = true;
+      toRecover.push_back(region);
+    }
+  }
+  std::sort(toRecover.begin(), toRecover.end(), [&](auto left, auto right) {
+    return scores[left] > scores[right];
+  });
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} regions with {} free.",
+      "Starting shard {} from checkpoint with {} regions to recover, {} regions with {} free.",
       shardId_,
-      entries_.size(),
+      toRecover.size(),
       numRegions_,
       writableRegions_.size());
+  if (toRecover.empty()) {
+    releaseCheckpointMap();
+    return;
+  }
+  recovering_ = true;
+  recoveryThread_ = std::thread([this, toRecover = std::move(toRecover)]() {
+    recoverRegions(toRecover);
+  });
+}
+
+const SsdFile::CheckpointRegion& SsdFile::checkpointRegion(
+    int32_t region) const {
+  return reinterpret_cast<const CheckpointRegion*>(
+      checkpointMap_ + sizeof(CheckpointHeader) +
+      maxRegions_ * sizeof(uint64_t))[region];
+}
+
+bool SsdFile::readCheckpointRegion(
+    int32_t region,
+    std::vector<std::pair<FileCacheKey, SsdRun>>& entries) const {
+  const auto& info = checkpointRegion(region);
+  const uint64_t size = info.numEntries * sizeof(CheckpointEntry);
+  if (info.entriesOffset + size > checkpointMapSize_ ||
+      checksum(checkpointMap_ + info.entriesOffset, size) != info.checksum) {
+    return false;
+  }
+  const auto* checkpointEntries =
+      reinterpret_cast<const CheckpointEntry*>(
+          checkpointMap_ + info.entriesOffset);
+  entries.reserve(info.numEntries);
+  for (auto i = 0; i < info.numEntries; ++i) {
+    const auto& entry = checkpointEntries[i];
+    const SsdRun run(entry.run);
+    const auto it = checkpointFileIds_.find(entry.fileNum);
+    if (it == checkpointFileIds_.end() || regionIndex(run.offset()) != region ||
+        run.offset() + run.size() > (region + 1) * kRegionSize) {
+      return false;
+    }
+    entries.emplace_back(FileCacheKey{it->second, entry.offset}, run);
+  }
+  return true;
+}
+
+void SsdFile::recoverRegions(const std::vector<int32_t>& regions) {
+  process::TraceContext trace("SsdFile::recoverRegions");
+  int32_t numRecovered = 0;
+  int32_t numDiscarded = 0;
+  uint64_t numEntries = 0;
+  try {
+    std::vector<std::pair<FileCacheKey, SsdRun>> entries;
+    for (const auto region : regions) {
+      if (stopRecovery_) {
+        break;
+      }
+      // The checksum is verified outside of 'mutex_'.
+      entries.clear();
+      const bool valid = readCheckpointRegion(region, entries);
+      std::lock_guard<std::shared_mutex> l(mutex_);
+      if (!pendingRecovery_[region]) {
+        // The region was evicted or cleared while recovering.
+        continue;
+      }
+      pendingRecovery_[region] = false;
+      if (valid) {
+        for (auto& entry : entries) {
+          entries_[std::move(entry.first)] = entry.second;
+        }
+        regionSizes_[region] = checkpointRegion(region).regionSize;
+        numEntries += entries.size();
+        ++numRecovered;
+      } else {
+        tracker_.regionCleared(region);
+        writableRegions_.push_back(region);
+        ++numDiscarded;
+      }
+    }
+  } catch (const std::exception& e) {
+    VELOX_SSD_CACHE_LOG(ERROR)
+        << "Error recovering shard " << shardId_
+        << " from checkpoint: " << e.what();
+  }
+
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  std::fill(pendingRecovery_.begin(), pendingRecovery_.end(), false);
+  stats_.checkpointRegionsRecovered += numRecovered;
+  stats_.checkpointRegionsDiscarded += numDiscarded;
+  if (numDiscarded > 0) {
+    ++stats_.readCheckpointErrors;
+  }
+  releaseCheckpointMap();
+  recovering_ = false;
+  VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
+      "Recovered {} entries in {} regions of shard {} from checkpoint, discarded {} corrupt regions.",
+      numEntries,
+      numRecovered,
+      shardId_,
+      numDiscarded);
+}
+
+void SsdFile::releaseCheckpointMap() {
+  if (checkpointMap_ != nullptr) {
+    ::munmap(const_cast<char*>(checkpointMap_), checkpointMapSize_);
+    checkpointMap_ = nullptr;
+    checkpointMapSize_ = 0;
+  }
+  checkpointFileIds_.clear();
+}
+
+void SsdFile::waitForRecovery() {
+  std::lock_guard<std::mutex> l(recoveryMutex_);
+  if (recoveryThread_.joinable()) {
+    recoveryThread_.join();
+  }
+}
+
+void SsdFile::stopRecovery() {
+  stopRecovery_ = true;
+  waitForRecovery();
 }
 
 } // namespace facebook::velox::cache
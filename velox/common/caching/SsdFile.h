@@ -18,12 +18,17 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/caching/SsdIoUring.h"
 #include "velox/common/file/File.h"
 
 #include <gflags/gflags.h>
+#include <array>
+#include <thread>
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_uint64(ssd_max_write_bytes_per_sec);
+DECLARE_int32(ssd_write_read_priority_ms);
 
 namespace facebook::velox::cache {
 
@@ -120,6 +125,10 @@ class SsdPin {
 
 // Metrics for SSD cache. Maintained by SsdFile and aggregated by SsdCache.
 struct SsdCacheStats {
+  // Number of power of 2 buckets in the io_uring histograms. The last bucket
+  // counts all values over its lower bound.
+  static constexpr int32_t kNumIoHistogramBuckets = 20;
+
   SsdCacheStats() {}
 
   SsdCacheStats(const SsdCacheStats& other) {
@@ -147,6 +156,28 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    checkpointRegionsRecovered =
+        tsanAtomicValue(other.checkpointRegionsRecovered);
+    checkpointRegionsDiscarded =
+        tsanAtomicValue(other.checkpointRegionsDiscarded);
+    writeThrottleUs = tsanAtomicValue(other.writeThrottleUs);
+    regionsCompacted = tsanAtomicValue(other.regionsCompacted);
+    bytesCompacted = tsanAtomicValue(other.bytesCompacted);
+
+    ioUringSubmissions = tsanAtomicValue(other.ioUringSubmissions);
+    ioUringRequests = tsanAtomicValue(other.ioUringRequests);
+    for (auto i = 0; i < kNumIoHistogramBuckets; ++i) {
+      ioUringQueueDepth[i] = tsanAtomicValue(other.ioUringQueueDepth[i]);
+      ioUringLatencyUs[i] = tsanAtomicValue(other.ioUringLatencyUs[i]);
+    }
+  }
+
+  // Returns the histogram bucket of 'value'. Bucket 0 is for 0 and bucket i
+  // for values in [2^(i - 1), 2^i).
+  static int32_t ioHistogramBucket(uint64_t value) {
+    return std::min<int32_t>(
+        kNumIoHistogramBuckets - 1,
+        value == 0 ? 0 : 64 - __builtin_clzll(value));
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -169,6 +200,27 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+  // Number of regions whose entries were recovered from a checkpoint and
+  // of regions discarded because their part of the checkpoint was corrupt.
+  tsan_atomic<uint32_t> checkpointRegionsRecovered{0};
+  tsan_atomic<uint32_t> checkpointRegionsDiscarded{0};
+  // Time writes waited for reads in progress or for write bandwidth, see
+  // FLAGS_ssd_write_read_priority_ms and FLAGS_ssd_max_write_bytes_per_sec.
+  tsan_atomic<uint64_t> writeThrottleUs{0};
+  // Number of regions whose live entries were moved to other regions to
+  // reclaim the space of erased entries, and the bytes moved.
+  tsan_atomic<uint64_t> regionsCompacted{0};
+  tsan_atomic<uint64_t> bytesCompacted{0};
+
+  // Number of io_uring submissions and of reads and writes in them.
+  tsan_atomic<uint64_t> ioUringSubmissions{0};
+  tsan_atomic<uint64_t> ioUringRequests{0};
+  // Histogram of the number of requests in a submission, capped at the queue
+  // depth of the ring.
+  std::array<tsan_atomic<uint64_t>, kNumIoHistogramBuckets> ioUringQueueDepth{};
+  // Histogram of the time from submission to the completion of all its
+  // requests in microseconds.
+  std::array<tsan_atomic<uint64_t>, kNumIoHistogramBuckets> ioUringLatencyUs{};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -191,7 +243,10 @@ class SsdFile {
       int32_t maxRegions,
       int64_t checkpointInternalBytes = 0,
       bool disableFileCow = false,
-      folly::Executor* executor = nullptr);
+      folly::Executor* executor = nullptr,
+      bool useIoUring = false);
+
+  ~SsdFile();
 
   // Adds entries of  'pins'  to this file. 'pins' must be in read mode and
   // those pins that are successfully added to SSD are marked as being on SSD.
@@ -265,18 +320,58 @@ class SsdFile {
   // written since last checkpoint and silently returns if not.
   void checkpoint(bool force = false);
 
+  /// Blocks until the regions of the checkpoint found at construction are
+  /// recovered. The recovery runs on a background thread and entries of a
+  /// region become visible to find() as soon as the region is validated.
+  void waitForRecovery();
+
   /// Returns true if copy on write is disabled for this file. Used in testing.
   bool testingIsCowDisabled() const;
 
+  /// Returns true if reads and writes go through io_uring. Used in testing.
+  bool testingUsesIoUring() const {
+    return ioUring_ != nullptr;
+  }
+
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
   // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
-  // Magic number separating file names from cache entry data in checkpoint
-  // file.
-  static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
-  // Magic number at end of completed checkpoint file.
-  static constexpr int64_t kCheckpointEndMarker = 0xcbedf11e;
+  static constexpr const char* kCheckpointMagic = "CPT2";
+
+  // Fixed part of the checkpoint file header. The header is followed by
+  // the region scores of 'tracker_', a CheckpointRegion for each of
+  // 'maxRegions_' regions, the count of file names and {fileNum, length,
+  // name} for each file name. The entries of each region follow the header
+  // as arrays of CheckpointEntry, so that a region can be validated and
+  // installed independently of the others.
+  struct CheckpointHeader {
+    char magic[4];
+    int32_t maxRegions;
+    int32_t numRegions;
+    // CRC32 of the header after this field. Written last, after the cache
+    // file is synced, so that a partially written checkpoint is not read.
+    uint32_t checksum;
+    // Size of the header, including file names, padded to 8 bytes.
+    uint64_t size;
+  };
+
+  struct CheckpointRegion {
+    // Offset of the entries of the region from the start of the file.
+    uint64_t entriesOffset;
+    uint32_t numEntries;
+    // 'regionSizes_' of the region.
+    uint32_t regionSize;
+    // CRC32 of the entries.
+    uint32_t checksum;
+    uint32_t padding;
+  };
+
+  struct CheckpointEntry {
+    uint64_t fileNum;
+    uint64_t offset;
+    // SsdRun::bits().
+    uint64_t run;
+  };
 
   static constexpr int kMaxErasedSizePct = 50;
 
@@ -286,14 +381,34 @@ class SsdFile {
     ++regionPins_[regionIndex(offset)];
   }
 
-  // Returns [offset, size] of contiguous space for storing data of a number of
-  // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
-  // if there is no space. The space does not necessarily cover all the pins, so
-  // multiple calls starting at the first unwritten pin may be needed.
+  // Returns [offset, size] of contiguous space for storing a number of
+  // contiguous entries with 'sizes' starting with the entry at index 'begin'.
+  // Returns nullopt if there is no space. The space does not necessarily cover
+  // all the entries, so multiple calls starting at the first unwritten entry
+  // may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<uint64_t>& sizes,
       int32_t begin);
 
+  // Waits before writing 'bytes' while reads are in progress, for up to
+  // FLAGS_ssd_write_read_priority_ms, and for as long as needed to stay under
+  // FLAGS_ssd_max_write_bytes_per_sec. Called by the writing thread.
+  void throttleWrite(uint64_t bytes);
+
+  // Records that 'size' bytes of 'region' are no longer referenced from
+  // 'entries_'. Queues the region for compaction when more than
+  // kMaxErasedSizePct of it is erased.
+  void regionBytesErasedLocked(int32_t region, uint64_t size);
+
+  // Compacts the regions in 'regionsToCompact_'. Called by the writing thread
+  // before writing new entries.
+  void compactRegions();
+
+  // Moves the live entries of 'region' to writable space and makes 'region'
+  // writable. Returns false if this should be retried later, e.g. because the
+  // entries of the region are not yet recovered from a checkpoint.
+  bool compactRegion(int32_t region);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -305,6 +420,25 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Appends to 'requests' a read of 'buffers' at 'offset'. Gaps, i.e. ranges
+  // with no data, are read into a scratch buffer.
+  static void addReadRequest(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      std::vector<SsdIoUring::Request>& requests);
+
+  // Submits 'requests' to 'ioUring_' in one batch and records the batch in
+  // 'stats_'.
+  void submitIo(std::vector<SsdIoUring::Request>& requests);
+
+  // Registers 'numWritten' entries of 'pins' starting at 'begin' as written at
+  // 'offset' and up.
+  void addWrittenEntries(
+      const std::vector<CachePin>& pins,
+      int32_t begin,
+      int32_t numWritten,
+      uint64_t offset);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -312,19 +446,40 @@ class SsdFile {
   // eviction log and leaves this open.
   void deleteCheckpoint(bool keepLog = false);
 
-  // Reads a checkpoint state file and sets 'this' accordingly if read
-  // is successful. Return true for successful read. A failed read
-  // deletes the checkpoint and leaves the log truncated open.
-  void readCheckpoint(std::ifstream& state);
+  // Maps the checkpoint file 'fd' and validates its header. Sets the region
+  // scores and writable regions of 'this' and starts recovering the entries
+  // of the other regions on 'recoveryThread_'. Throws if the header is
+  // corrupt, without modifying 'this'.
+  void readCheckpoint(int32_t fd);
+
+  // Recovers the entries of 'regions', hottest first. Runs on
+  // 'recoveryThread_'.
+  void recoverRegions(const std::vector<int32_t>& regions);
+
+  // Returns the description of 'region' in the mapped checkpoint.
+  const CheckpointRegion& checkpointRegion(int32_t region) const;
+
+  // Reads the entries of 'region' from the mapped checkpoint into 'entries'.
+  // Returns false if the entries of the region are corrupt.
+  bool readCheckpointRegion(
+      int32_t region,
+      std::vector<std::pair<FileCacheKey, SsdRun>>& entries) const;
+
+  // Unmaps the checkpoint being recovered and drops its file names.
+  void releaseCheckpointMap();
+
+  // Stops a recovery in progress and waits for its thread.
+  void stopRecovery();
 
   // Logs an error message, deletes the checkpoint and stop making new
   // checkpoints.
   void checkpointError(int32_t rc, const std::string& error);
 
   // Looks for a checkpointed state and sets the state of 'this' by
-  // the checkpointed state iif the state is complete and
-  // readable. Does not modify 'this' if the state is corrupt,
-  // e.g. there was a crash during writing the checkpoint. Initializes
+  // the checkpointed state iif its header is complete and
+  // readable. Does not modify 'this' if the header is corrupt,
+  // e.g. there was a crash during writing the checkpoint. Regions whose
+  // entries are corrupt are discarded while recovering. Initializes
   // the files for making new checkpoints.
   void initializeCheckpoint();
 
@@ -365,6 +520,18 @@ class SsdFile {
   // Indices of regions available for writing new entries.
   std::vector<int32_t> writableRegions_;
 
+  // Indices of full regions that have more than kMaxErasedSizePct erased
+  // bytes. Their live entries are rewritten elsewhere instead of being lost to
+  // eviction, since these are typically still hot.
+  std::vector<int32_t> regionsToCompact_;
+
+  // Number of load() calls in progress. Writes defer to these.
+  std::atomic<int32_t> numReadsInProgress_{0};
+
+  // Time in microseconds before which the next write may not start under
+  // FLAGS_ssd_max_write_bytes_per_sec. Accessed by the writing thread.
+  uint64_t nextWriteUs_{0};
+
   // Tracker for access frequencies and eviction.
   SsdFileTracker tracker_;
 
@@ -383,6 +550,10 @@ class SsdFile {
   // ReadFile made from 'fd_'.
   std::unique_ptr<ReadFile> readFile_;
 
+  // Set if reads and writes of 'fd_' go through io_uring instead of
+  // 'readFile_' and pwritev().
+  std::unique_ptr<SsdIoUring> ioUring_;
+
   // Counters.
   SsdCacheStats stats_;
 
@@ -402,6 +573,27 @@ class SsdFile {
 
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
+
+  // True for regions whose entries are in the checkpoint being recovered and
+  // not yet installed in 'entries_'. Cleared if the region is evicted or
+  // cleared before it is recovered.
+  std::vector<bool> pendingRecovery_;
+
+  // Read-only mapping of the checkpoint being recovered and the file names in
+  // it by their number in the checkpoint. Set before 'recoveryThread_'
+  // starts and released by it when done.
+  const char* checkpointMap_{nullptr};
+  uint64_t checkpointMapSize_{0};
+  folly::F14FastMap<uint64_t, StringIdLease> checkpointFileIds_;
+
+  // True while 'recoveryThread_' is installing entries. A checkpoint can
+  // not be written before this is false since the new checkpoint would
+  // overwrite the mapped file and lose the entries not yet recovered.
+  std::atomic<bool> recovering_{false};
+  std::atomic<bool> stopRecovery_{false};
+  // Serializes joining 'recoveryThread_'.
+  std::mutex recoveryMutex_;
+  std::thread recoveryThread_;
 };
 
 } // namespace facebook::velox::cache
@@ -38,7 +38,14 @@ void SsdFileTracker::regionFilled(int32_t region) {
 std::vector<int32_t> SsdFileTracker::findEvictionCandidates(
     int32_t numCandidates,
     int32_t numRegions,
-    const std::vector<int32_t>& regionPins) {
+    const std::vector<int32_t>& regionPins,
+    const std::vector<int32_t>& livePct) {
+  auto score = [&](int32_t region) -> uint64_t {
+    if (livePct.empty()) {
+      return regionScores_[region];
+    }
+    return regionScores_[region] * livePct[region] / 100;
+  };
   // Calculates average score of regions wiht no pins. Returns up to
   // 'numCandidates' unpinned regions with score <= average, lowest
   // scoring region first.
@@ -49,7 +56,7 @@ std::vector<int32_t> SsdFileTracker::findEvictionCandidates(
       continue;
     }
     ++numUnpinned;
-    scoreSum += regionScores_[i];
+    scoreSum += score(i);
   }
   if (numUnpinned == 0) {
     return {};
@@ -57,14 +64,14 @@ std::vector<int32_t> SsdFileTracker::findEvictionCandidates(
   const auto avg = scoreSum / numUnpinned;
   std::vector<int32_t> candidates;
   for (auto i = 0; i < regionScores_.size(); ++i) {
-    if ((regionPins[i] == 0) && (regionScores_[i] <= avg)) {
+    if ((regionPins[i] == 0) && (score(i) <= avg)) {
       candidates.push_back(i);
     }
   }
   // Sort by score to evict less read regions first.
   std::sort(
       candidates.begin(), candidates.end(), [&](int32_t left, int32_t right) {
-        return regionScores_[left] < regionScores_[right];
+        return score(left) < score(right);
       });
   candidates.resize(std::min<int32_t>(candidates.size(), numCandidates));
   return candidates;
@@ -55,11 +55,15 @@ class SsdFileTracker {
   // Returns up to 'numCandidates' least used regions. 'numRegions' is
   // the count of existing regions. This can be less than the size of
   // the tracker if the file cannot grow to full size. Regions with a
-  // non-zero count in 'regionPins' are not considered.
+  // non-zero count in 'regionPins' are not considered. If 'livePct' is not
+  // empty, it has the percentage of live bytes of each region and scales the
+  // region's score, so that regions whose entries are mostly erased are
+  // evicted first.
   std::vector<int32_t> findEvictionCandidates(
       int32_t numCandidates,
       int32_t numRegions,
-      const std::vector<int32_t>& regionPins);
+      const std::vector<int32_t>& regionPins,
+      const std::vector<int32_t>& livePct = {});
 
   // Expose the region access data. Used in checkpointing cache state.
   std::vector<tsan_atomic<uint64_t>>& regionScores() {
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdIoUring.h"
+
+#include <folly/String.h>
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace facebook::velox::cache {
+
+#ifdef VELOX_ENABLE_IO_URING
+
+struct SsdIoUring::Ring {
+  explicit Ring(int32_t queueDepth) {
+    const auto rc = io_uring_queue_init(queueDepth, &ring, 0);
+    VELOX_CHECK_EQ(
+        rc, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-rc));
+  }
+
+  ~Ring() {
+    io_uring_queue_exit(&ring);
+  }
+
+  struct io_uring ring;
+};
+
+// static
+bool SsdIoUring::isSupported() {
+  static const bool supported = [] {
+    struct io_uring ring;
+    if (io_uring_queue_init(1, &ring, 0) != 0) {
+      return false;
+    }
+    io_uring_queue_exit(&ring);
+    return true;
+  }();
+  return supported;
+}
+
+void SsdIoUring::submit(std::vector<Request>& requests) {
+  auto ring = acquireRing();
+  auto* uring = &ring->ring;
+  int32_t next = 0;
+  int32_t numInFlight = 0;
+  int32_t numCompleted = 0;
+  while (numCompleted < requests.size()) {
+    while (next < requests.size() && numInFlight < queueDepth_) {
+      auto* sqe = io_uring_get_sqe(uring);
+      if (sqe == nullptr) {
+        break;
+      }
+      auto& request = requests[next];
+      if (request.write) {
+        io_uring_prep_writev(
+            sqe,
+            fd_,
+            request.iovecs.data(),
+            request.iovecs.size(),
+            request.offset);
+      } else {
+        io_uring_prep_readv(
+            sqe,
+            fd_,
+            request.iovecs.data(),
+            request.iovecs.size(),
+            request.offset);
+      }
+      io_uring_sqe_set_data64(sqe, next);
+      ++next;
+      ++numInFlight;
+    }
+    const auto rc = io_uring_submit_and_wait(uring, 1);
+    if (rc < 0 && rc != -EINTR && rc != -EAGAIN) {
+      // The state of the requests in flight is unknown. The ring is not
+      // returned to the pool.
+      VELOX_FAIL("io_uring_submit_and_wait failed: {}", folly::errnoStr(-rc));
+    }
+    struct io_uring_cqe* cqe;
+    uint32_t head;
+    uint32_t numSeen = 0;
+    io_uring_for_each_cqe(uring, head, cqe) {
+      requests[io_uring_cqe_get_data64(cqe)].result = cqe->res;
+      ++numSeen;
+    }
+    io_uring_cq_advance(uring, numSeen);
+    numInFlight -= numSeen;
+    numCompleted += numSeen;
+  }
+  releaseRing(std::move(ring));
+}
+
+#else
+
+struct SsdIoUring::Ring {
+  explicit Ring(int32_t /*queueDepth*/) {}
+};
+
+// static
+bool SsdIoUring::isSupported() {
+  return false;
+}
+
+void SsdIoUring::submit(std::vector<Request>& /*requests*/) {
+  VELOX_UNSUPPORTED("Velox is built without VELOX_ENABLE_IO_URING");
+}
+
+#endif // VELOX_ENABLE_IO_URING
+
+uint64_t SsdIoUring::Request::bytes() const {
+  uint64_t bytes = 0;
+  for (const auto& iov : iovecs) {
+    bytes += iov.iov_len;
+  }
+  return bytes;
+}
+
+SsdIoUring::SsdIoUring(int32_t fd, int32_t queueDepth)
+    : fd_(fd), queueDepth_(queueDepth) {
+  VELOX_CHECK(isSupported(), "io_uring is not supported");
+  VELOX_CHECK_GT(queueDepth_, 0);
+}
+
+SsdIoUring::~SsdIoUring() = default;
+
+std::unique_ptr<SsdIoUring::Ring> SsdIoUring::acquireRing() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!freeRings_.empty()) {
+      auto ring = std::move(freeRings_.back());
+      freeRings_.pop_back();
+      return ring;
+    }
+  }
+  return std::make_unique<Ring>(queueDepth_);
+}
+
+void SsdIoUring::releaseRing(std::unique_ptr<Ring> ring) {
+  std::lock_guard<std::mutex> l(mutex_);
+  freeRings_.push_back(std::move(ring));
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/uio.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Issues batches of vectored reads and writes on a file with io_uring. An
+/// SsdFile is read from many threads at a time and a ring may only be used by
+/// one thread, so this keeps a pool of rings and each submit() takes one from
+/// the pool for its duration. Available only if Velox is built with
+/// VELOX_ENABLE_IO_URING and the kernel supports io_uring.
+class SsdIoUring {
+ public:
+  static constexpr int32_t kDefaultQueueDepth = 64;
+
+  /// One readv or writev of 'iovecs' at 'offset'. 'result' is set by submit()
+  /// to the bytes transferred or to -errno on error.
+  struct Request {
+    bool write{false};
+    uint64_t offset{0};
+    std::vector<iovec> iovecs;
+    int64_t result{0};
+
+    uint64_t bytes() const;
+  };
+
+  /// Returns true if io_uring is compiled in and a ring can be set up in this
+  /// process.
+  static bool isSupported();
+
+  /// Makes rings for 'fd' that have up to 'queueDepth' requests in flight.
+  /// 'fd' is not owned. Throws if io_uring is not supported.
+  explicit SsdIoUring(int32_t fd, int32_t queueDepth = kDefaultQueueDepth);
+
+  ~SsdIoUring();
+
+  /// Submits 'requests' and waits for all of them to complete. Requests over
+  /// the queue depth are submitted as earlier ones complete. Throws if the
+  /// ring fails. Errors of single requests are returned in their 'result'.
+  void submit(std::vector<Request>& requests);
+
+  int32_t queueDepth() const {
+    return queueDepth_;
+  }
+
+ private:
+  struct Ring;
+
+  // Returns a ring from 'freeRings_' or makes a new one.
+  std::unique_ptr<Ring> acquireRing();
+
+  void releaseRing(std::unique_ptr<Ring> ring);
+
+  const int32_t fd_;
+  const int32_t queueDepth_;
+
+  std::mutex mutex_;
+  // Rings not in use by a submit().
+  std::vector<std::unique_ptr<Ring>> freeRings_;
+};
+
+} // namespace facebook::velox::cache
@@ -17,6 +17,7 @@
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/Semaphore.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/CachePolicy.h"
 #include "velox/common/caching/CacheTTLController.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
@@ -89,7 +90,11 @@ class AsyncDataCacheTest : public testing::Test {
     }
   }
 
-  void initializeCache(uint64_t maxBytes, int64_t ssdBytes = 0) {
+  void initializeCache(
+      uint64_t maxBytes,
+      int64_t ssdBytes = 0,
+      CachePolicyFactory policyFactory = nullptr,
+      int32_t numaNodes = 1) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -119,7 +124,8 @@ class AsyncDataCacheTest : public testing::Test {
     options.trackDefaultUsage = true;
     manager_ = std::make_unique<memory::MemoryManager>(options);
     allocator_ = static_cast<memory::MmapAllocator*>(manager_->allocator());
-    cache_ = AsyncDataCache::create(allocator_, std::move(ssdCache));
+    cache_ = AsyncDataCache::create(
+        allocator_, std::move(ssdCache), std::move(policyFactory), numaNodes);
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -636,6 +642,132 @@ TEST_F(AsyncDataCacheTest, pin) {
   EXPECT_EQ(0, cache_->incrementPrefetchPages(0));
 }
 
+TEST_F(AsyncDataCacheTest, tinyLfuPolicy) {
+  constexpr int64_t kMaxBytes = 16 << 20;
+  constexpr int32_t kEntrySize = 128 << 10;
+  constexpr int32_t kNumHot = 4;
+  initializeCache(kMaxBytes, 0, []() {
+    return std::make_unique<TinyLfuCachePolicy>();
+  });
+  StringIdLease file(fileIds(), std::string_view("testingfile"));
+  auto load = [&](uint64_t offset) {
+    auto pin = cache_->findOrCreate({file.id(), offset}, kEntrySize);
+    ASSERT_FALSE(pin.empty());
+    if (pin.checkedEntry()->isExclusive()) {
+      initializeContents(file.id() + offset, pin.checkedEntry()->data());
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+  };
+
+  // The hot entries are not admitted at first load but are at the next hit.
+  for (auto pass = 0; pass < 3; ++pass) {
+    for (auto i = 0; i < kNumHot; ++i) {
+      load(i * kEntrySize);
+    }
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.policyName, "tinylfu");
+  ASSERT_EQ(stats.numNotAdmitted, kNumHot);
+  ASSERT_EQ(stats.numHit, 2 * kNumHot);
+
+  // A scan of 4x the capacity touching each entry once does not displace the
+  // hot entries.
+  constexpr int32_t kNumScan = 4 * kMaxBytes / kEntrySize;
+  for (auto i = 0; i < kNumScan; ++i) {
+    load((kNumHot + i) * kEntrySize);
+  }
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numNotAdmitted, kNumHot + kNumScan);
+  ASSERT_LT(0, stats.numEvict);
+  for (auto i = 0; i < kNumHot; ++i) {
+    EXPECT_TRUE(cache_->exists({file.id(), i * kEntrySize})) << i;
+  }
+  EXPECT_LT(stats.hitRatio(), 0.5);
+}
+
+TEST_F(AsyncDataCacheTest, compressedTier) {
+  constexpr int64_t kMaxBytes = 16 << 20;
+  constexpr int32_t kEntrySize = 1 << 20;
+  constexpr int32_t kNumEntries = 4 * kMaxBytes / kEntrySize;
+  initializeCache(kMaxBytes);
+  // Each shard can hold all the evicted entries compressed.
+  constexpr int64_t kCompressedBytes = 2 * kNumEntries * kEntrySize;
+  cache_->setCompressedTier(kCompressedBytes, 50);
+  ASSERT_FALSE(cache_->isCompressible(20));
+  ASSERT_TRUE(cache_->isCompressible(80));
+  StringIdLease file(fileIds(), std::string_view("compressedfile"));
+  auto load = [&](uint64_t offset, bool compressible) {
+    auto pin = cache_->findOrCreate({file.id(), offset}, kEntrySize);
+    ASSERT_FALSE(pin.empty());
+    auto* entry = pin.checkedEntry();
+    if (entry->isExclusive()) {
+      initializeContents(file.id() + offset, entry->data());
+      entry->setCompressible(compressible);
+      entry->setExclusiveToShared();
+    } else {
+      checkContents(*entry);
+    }
+  };
+
+  // A scan of 4x the capacity leaves the evicted entries compressed.
+  for (auto i = 0; i < kNumEntries; ++i) {
+    load(i * kEntrySize, true);
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_LT(0, stats.numEvict);
+  ASSERT_LT(0, stats.numCompressed);
+  ASSERT_LE(stats.compressedBytes, kCompressedBytes);
+  ASSERT_LT(stats.compressedBytes * 4, stats.compressedSourceBytes * 3);
+  ASSERT_EQ(stats.numCompressedHit, 0);
+
+  // A second scan decompresses the entries it did not find in memory.
+  for (auto i = 0; i < kNumEntries; ++i) {
+    load(i * kEntrySize, true);
+  }
+  stats = cache_->refreshStats();
+  ASSERT_LT(0, stats.numCompressedHit);
+  ASSERT_LE(stats.numCompressedHit, stats.numHit);
+  ASSERT_EQ(stats.numNew, kNumEntries);
+  ASSERT_NE(
+      cache_->toString(false).find("Compressed entries: "), std::string::npos);
+
+  // Clearing the cache drops the compressed tier and entries that are not
+  // compressible are not kept.
+  cache_->clear();
+  ASSERT_EQ(cache_->refreshStats().numCompressed, 0);
+  for (auto i = 0; i < kNumEntries; ++i) {
+    load((kNumEntries + i) * kEntrySize, false);
+  }
+  stats = cache_->refreshStats();
+  ASSERT_LT(0, stats.numEvict);
+  ASSERT_EQ(stats.numCompressed, 0);
+}
+
+TEST(CountMinSketchTest, estimate) {
+  CountMinSketch sketch(1000);
+  ASSERT_EQ(sketch.width(), 1024);
+  for (auto i = 0; i < 100; ++i) {
+    for (auto j = 0; j <= i % 4; ++j) {
+      sketch.increment(i);
+    }
+  }
+  for (auto i = 0; i < 100; ++i) {
+    // Estimates are never below the true count.
+    EXPECT_LE(i % 4 + 1, sketch.estimate(i));
+  }
+  EXPECT_EQ(0, sketch.estimate(12345));
+
+  // Counts saturate and are halved after 'sampleSize()' increments.
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(1000);
+  }
+  EXPECT_EQ(CountMinSketch::kMaxCount, sketch.estimate(1000));
+  for (auto i = 0; i < sketch.sampleSize(); ++i) {
+    sketch.increment(2000 + i % 64);
+  }
+  EXPECT_GE(CountMinSketch::kMaxCount / 2, sketch.estimate(1000));
+}
+
 TEST_F(AsyncDataCacheTest, replace) {
   constexpr int64_t kMaxBytes = 64 << 20;
   FLAGS_velox_exception_user_stacktrace_enabled = false;
@@ -856,12 +988,15 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
   stats.numAgedOut = 10;
   stats.allocClocks = 1320;
   stats.sumEvictScore = 123;
+  stats.numNotAdmitted = 17;
+  stats.policyName = "tinylfu";
   ASSERT_EQ(
       stats.toString(),
       "Cache size: 2.56KB tinySize: 257B large size: 2.31KB\n"
       "Cache entries: 100 read pins: 30 write pins: 20 pinned shared: 10.00MB pinned exclusive: 10.00MB\n"
       " num write wait: 244 empty entries: 20\n"
       "Cache access miss: 2041 hit: 46 hit bytes: 1.34KB eviction: 463 eviction checks: 348 aged out: 10\n"
+      "Cache policy: tinylfu hit ratio: 2.20% not admitted: 17\n"
       "Prefetch entries: 30 bytes: 100B\n"
       "Alloc Megaclocks 0");
 
@@ -874,6 +1009,7 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "Cache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n"
       " num write wait: 0 empty entries: 0\n"
       "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0 aged out: 0\n"
+      "Cache policy: clock hit ratio: 0.00% not admitted: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n"
@@ -898,12 +1034,42 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "Cache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n"
       " num write wait: 0 empty entries: 0\n"
       "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 eviction checks: 0 aged out: 0\n"
+      "Cache policy: clock hit ratio: 0.00% not admitted: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n";
   ASSERT_EQ(cache_->toString(false), expectedShortCacheOutput);
 }
 
+TEST_F(AsyncDataCacheTest, numaShards) {
+  initializeCache(64 << 20, 0, nullptr, 2);
+  ASSERT_EQ(cache_->numaNodes(), 2);
+  const RawFileCacheKey key{filenames_[0].id(), 0};
+  auto lookup = [&](int32_t node) {
+    memory::MmapAllocator::setThreadNumaNode(node);
+    auto pin = cache_->findOrCreate(key, 10'000);
+    EXPECT_FALSE(pin.empty());
+    if (pin.checkedEntry()->isExclusive()) {
+      pin.checkedEntry()->setExclusiveToShared();
+      return false;
+    }
+    return true;
+  };
+
+  ASSERT_FALSE(lookup(0));
+  ASSERT_TRUE(lookup(0));
+  // A thread on the other node finds the entry in the shards of node 0.
+  ASSERT_TRUE(lookup(1));
+  ASSERT_TRUE(cache_->exists(key));
+  memory::MmapAllocator::setThreadNumaNode(-1);
+
+  const auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numNew, 1);
+  ASSERT_EQ(stats.numLocalHit, 1);
+  ASSERT_EQ(stats.numRemoteHit, 1);
+  ASSERT_EQ(stats.numEntries, 1);
+}
+
 TEST_F(AsyncDataCacheTest, shrinkCache) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
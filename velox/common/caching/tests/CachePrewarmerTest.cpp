@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/CachePrewarmer.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+namespace facebook::velox::cache {
+
+class CachePrewarmerTest : public ::testing::Test {
+ protected:
+  static constexpr int32_t kEntrySize = 64 << 10;
+  static constexpr int32_t kNumEntries = 32;
+
+  void SetUp() override {
+    tempDirectory_ = exec::test::TempDirectoryPath::create();
+    dataPath_ = tempDirectory_->path + "/data";
+    LocalWriteFile file(dataPath_);
+    std::string data(kNumEntries * kEntrySize, 0);
+    for (auto i = 0; i < data.size(); ++i) {
+      data[i] = i % 251;
+    }
+    file.append(data);
+    file.close();
+    makeCache();
+  }
+
+  void TearDown() override {
+    cache_->shutdown();
+  }
+
+  void makeCache() {
+    if (cache_ != nullptr) {
+      cache_->shutdown();
+    }
+    cache_.reset();
+    allocator_ = std::make_shared<MmapAllocator>(
+        MmapAllocator::Options{.capacity = 64 << 20});
+    cache_ = AsyncDataCache::create(allocator_.get());
+  }
+
+  // Reads the entry at 'index' from the cache, loading it from 'dataPath_'
+  // if it is not cached.
+  void read(int32_t index) {
+    StringIdLease fileNum(fileIds(), dataPath_);
+    auto pin = cache_->findOrCreate(
+        {fileNum.id(), static_cast<uint64_t>(index) * kEntrySize}, kEntrySize);
+    ASSERT_FALSE(pin.empty());
+    auto* entry = pin.checkedEntry();
+    if (entry->isExclusive()) {
+      const auto data =
+          LocalReadFile(dataPath_).pread(entry->offset(), kEntrySize);
+      uint64_t offset = 0;
+      for (auto i = 0; i < entry->data().numRuns(); ++i) {
+        const auto run = entry->data().runAt(i);
+        const auto bytes =
+            std::min<uint64_t>(run.numBytes(), kEntrySize - offset);
+        ::memcpy(run.data<char>(), data.data() + offset, bytes);
+        offset += bytes;
+      }
+      entry->setExclusiveToShared();
+    }
+  }
+
+  void checkCached(int32_t index) {
+    StringIdLease fileNum(fileIds(), dataPath_);
+    const uint64_t offset = static_cast<uint64_t>(index) * kEntrySize;
+    ASSERT_TRUE(cache_->exists({fileNum.id(), offset})) << index;
+    auto pin = cache_->findOrCreate({fileNum.id(), offset}, kEntrySize);
+    auto* entry = pin.checkedEntry();
+    ASSERT_TRUE(entry->isShared());
+    uint64_t checked = 0;
+    for (auto i = 0; i < entry->data().numRuns(); ++i) {
+      const auto run = entry->data().runAt(i);
+      const auto* data = run.data<char>();
+      for (auto j = 0; j < run.numBytes() && checked < kEntrySize; ++j) {
+        ASSERT_EQ(data[j], static_cast<char>((offset + checked) % 251));
+        ++checked;
+      }
+    }
+    ASSERT_EQ(checked, kEntrySize);
+  }
+
+  std::shared_ptr<exec::test::TempDirectoryPath> tempDirectory_;
+  std::string dataPath_;
+  std::shared_ptr<MemoryAllocator> allocator_;
+  std::shared_ptr<AsyncDataCache> cache_;
+};
+
+TEST_F(CachePrewarmerTest, history) {
+  for (auto i = 0; i < kNumEntries; ++i) {
+    read(i);
+  }
+  // Every fourth entry is hit, the first of them the most.
+  for (auto i = 0; i < kNumEntries; i += 4) {
+    read(i);
+  }
+  read(0);
+  auto regions = cache_->hottestRegions(kNumEntries);
+  ASSERT_EQ(regions.size(), kNumEntries / 4);
+  ASSERT_EQ(regions[0].offset, 0);
+  ASSERT_EQ(regions[0].numUses, 2);
+  for (const auto& region : regions) {
+    ASSERT_EQ(region.path, dataPath_);
+    ASSERT_EQ(region.size, kEntrySize);
+    ASSERT_EQ(region.offset % (4 * kEntrySize), 0);
+  }
+  ASSERT_EQ(cache_->hottestRegions(2).size(), 2);
+  ASSERT_EQ(cache_->hottestRegions(kNumEntries, 0).size(), kNumEntries);
+
+  const auto historyPath = tempDirectory_->path + "/history";
+  CachePrewarmer::saveHistory(regions, historyPath);
+  // Saving again replaces the file.
+  CachePrewarmer::saveHistory(regions, historyPath);
+  auto loaded = CachePrewarmer::loadHistory(historyPath);
+  ASSERT_EQ(loaded.size(), regions.size());
+  for (auto i = 0; i < regions.size(); ++i) {
+    ASSERT_EQ(loaded[i].path, regions[i].path);
+    ASSERT_EQ(loaded[i].offset, regions[i].offset);
+    ASSERT_EQ(loaded[i].size, regions[i].size);
+    ASSERT_EQ(loaded[i].numUses, regions[i].numUses);
+  }
+
+  // A missing or corrupt history gives no regions.
+  ASSERT_TRUE(CachePrewarmer::loadHistory(historyPath + ".missing").empty());
+  {
+    LocalWriteFile file(historyPath + ".corrupt");
+    file.append("XXXX1234");
+    file.close();
+  }
+  ASSERT_TRUE(CachePrewarmer::loadHistory(historyPath + ".corrupt").empty());
+}
+
+TEST_F(CachePrewarmerTest, prewarm) {
+  std::vector<CachedRegion> regions;
+  for (auto i = 0; i < kNumEntries; i += 2) {
+    regions.push_back(CachedRegion{
+        dataPath_, static_cast<uint64_t>(i) * kEntrySize, kEntrySize, 1});
+  }
+  // A region of a missing file is an error.
+  regions.push_back(CachedRegion{dataPath_ + ".missing", 0, kEntrySize, 1});
+  auto openFile = [](const std::string& path) {
+    return std::make_shared<LocalReadFile>(path);
+  };
+
+  CachePrewarmer prewarmer(cache_.get(), openFile, {});
+  prewarmer.start(regions);
+  prewarmer.wait();
+  auto stats = prewarmer.stats();
+  ASSERT_EQ(stats.numLoaded, kNumEntries / 2);
+  ASSERT_EQ(stats.bytesLoaded, kNumEntries / 2 * kEntrySize);
+  ASSERT_EQ(stats.numErrors, 1);
+  ASSERT_EQ(stats.numSsdLoaded, 0);
+  ASSERT_EQ(cache_->refreshStats().numPrefetch, kNumEntries / 2);
+  for (auto i = 0; i < kNumEntries; i += 2) {
+    checkCached(i);
+  }
+
+  // Cached regions are not loaded again.
+  CachePrewarmer again(cache_.get(), openFile, {});
+  again.start(regions);
+  again.wait();
+  ASSERT_EQ(again.stats().numLoaded, 0);
+  ASSERT_EQ(again.stats().numCached, kNumEntries / 2);
+
+  // Loading stops at 'maxCachePct' of the cache capacity.
+  makeCache();
+  CachePrewarmer limited(cache_.get(), openFile, {.maxCachePct = 1});
+  limited.start(regions);
+  limited.wait();
+  ASSERT_LT(limited.stats().numLoaded, kNumEntries / 2);
+}
+
+TEST_F(CachePrewarmerTest, throttle) {
+  std::vector<CachedRegion> regions;
+  for (auto i = 0; i < kNumEntries; ++i) {
+    regions.push_back(CachedRegion{
+        dataPath_, static_cast<uint64_t>(i) * kEntrySize, kEntrySize, 1});
+  }
+  // 2MB at 1MB/s takes 2s, so stop() interrupts the load.
+  CachePrewarmer prewarmer(
+      cache_.get(),
+      [](const std::string& path) {
+        return std::make_shared<LocalReadFile>(path);
+      },
+      {.maxBytesPerSec = 1 << 20});
+  prewarmer.start(regions);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200)); // NOLINT
+  prewarmer.stop();
+  const auto stats = prewarmer.stats();
+  ASSERT_LT(0, stats.numLoaded);
+  ASSERT_LT(stats.numLoaded, kNumEntries);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+namespace {
+
+class TestMetadata : public FileMetadata {
+ public:
+  TestMetadata(int32_t id, uint64_t size) : id_(id), size_(size) {}
+
+  uint64_t memoryUsage() const override {
+    return size_;
+  }
+
+  int32_t id() const {
+    return id_;
+  }
+
+ private:
+  const int32_t id_;
+  const uint64_t size_;
+};
+
+int32_t idOf(const std::shared_ptr<const FileMetadata>& metadata) {
+  return dynamic_cast<const TestMetadata&>(*metadata).id();
+}
+
+} // namespace
+
+TEST(FileMetadataCacheTest, basic) {
+  FileMetadataCache cache(1'000);
+  ASSERT_EQ(cache.find("a@1"), nullptr);
+  cache.insert("a@1", std::make_shared<TestMetadata>(1, 100));
+  cache.insert("b@1", std::make_shared<TestMetadata>(2, 100));
+  ASSERT_EQ(idOf(cache.find("a@1")), 1);
+  ASSERT_EQ(idOf(cache.find("b@1")), 2);
+  // A new version of the file is a different key.
+  ASSERT_EQ(cache.find("a@2"), nullptr);
+
+  // Replacing an entry does not add to the size.
+  cache.insert("a@1", std::make_shared<TestMetadata>(3, 200));
+  ASSERT_EQ(idOf(cache.find("a@1")), 3);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numHits, 3);
+  ASSERT_EQ(stats.numMisses, 2);
+  ASSERT_EQ(stats.numEntries, 2);
+  ASSERT_EQ(stats.curBytes, 300 + 2 * 3);
+  ASSERT_EQ(stats.maxBytes, 1'000);
+  ASSERT_EQ(stats.numEvictions, 0);
+
+  cache.clear();
+  ASSERT_EQ(cache.find("a@1"), nullptr);
+  ASSERT_EQ(cache.stats().numEntries, 0);
+  ASSERT_EQ(cache.stats().curBytes, 0);
+}
+
+TEST(FileMetadataCacheTest, eviction) {
+  FileMetadataCache cache(1'000);
+  for (auto i = 0; i < 4; ++i) {
+    cache.insert(fmt::format("f{}", i), std::make_shared<TestMetadata>(i, 248));
+  }
+  ASSERT_EQ(cache.stats().numEntries, 4);
+
+  // 'f0' becomes the most recently used and 'f1' is evicted.
+  ASSERT_NE(cache.find("f0"), nullptr);
+  cache.insert("f4", std::make_shared<TestMetadata>(4, 248));
+  ASSERT_EQ(cache.find("f1"), nullptr);
+  ASSERT_NE(cache.find("f0"), nullptr);
+  ASSERT_NE(cache.find("f4"), nullptr);
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 4);
+  ASSERT_EQ(stats.numEvictions, 1);
+  ASSERT_LE(stats.curBytes, 1'000);
+
+  // An entry larger than the cache is not added.
+  auto large = std::make_shared<TestMetadata>(5, 2'000);
+  cache.insert("large", large);
+  ASSERT_EQ(cache.find("large"), nullptr);
+  ASSERT_EQ(cache.stats().numEntries, 4);
+}
@@ -19,6 +19,8 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <fcntl.h>
+#include <folly/ScopeGuard.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -58,20 +60,34 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      bool useIoUring = false,
+      int64_t checkpointIntervalBytes = 0) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
+    if (cache_ != nullptr) {
+      cache_->shutdown();
+    }
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
 
     fileName_ = StringIdLease(fileIds(), "fileInStorage");
 
-    tempDirectory_ = exec::test::TempDirectoryPath::create();
+    // A second initialization finds the checkpoint of the previous one.
+    if (tempDirectory_ == nullptr) {
+      tempDirectory_ = exec::test::TempDirectoryPath::create();
+    }
     ssdFile_ = std::make_unique<SsdFile>(
-        fmt::format("{}/ssdtest", tempDirectory_->path),
+        ssdPath(),
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
-        setNoCowFlag);
+        checkpointIntervalBytes,
+        setNoCowFlag,
+        nullptr, // executor
+        useIoUring);
+  }
+
+  std::string ssdPath() const {
+    return fmt::format("{}/ssdtest", tempDirectory_->path);
   }
 
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
@@ -304,6 +320,58 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, compactRegion) {
+  constexpr int32_t kEntrySize = 64 << 10;
+  initializeCache(128 * kMB, 4 * SsdFile::kRegionSize);
+  // Fills region 0 and starts region 1.
+  auto pins = makePins(fileName_.id(), 0, kEntrySize, kEntrySize, 64 * kMB);
+  ssdFile_->write(pins);
+  pins = makePins(fileName_.id(), 64 * kMB, kEntrySize, kEntrySize, kMB);
+  ssdFile_->write(pins);
+  pins.clear();
+
+  // Erases most of region 0. The rest is moved by the next write instead of
+  // being evicted with the region.
+  for (uint64_t offset = 0; offset < 40 * kMB; offset += kEntrySize) {
+    ASSERT_TRUE(ssdFile_->erase(RawFileCacheKey{fileName_.id(), offset}));
+  }
+  pins = makePins(fileName_.id(), 65 * kMB, kEntrySize, kEntrySize, kMB);
+  ssdFile_->write(pins);
+  pins.clear();
+
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.regionsCompacted, 1);
+  ASSERT_EQ(stats.bytesCompacted, 24 * kMB);
+  ASSERT_EQ(stats.bytesCached, 26 * kMB);
+  for (uint64_t offset = 40 * kMB; offset < 64 * kMB; offset += kEntrySize) {
+    auto ssdPin = ssdFile_->find(RawFileCacheKey{fileName_.id(), offset});
+    ASSERT_FALSE(ssdPin.empty());
+    ASSERT_NE(SsdFile::regionIndex(ssdPin.run().offset()), 0);
+  }
+  pins = makePins(fileName_.id(), 40 * kMB, kEntrySize, kEntrySize, 24 * kMB);
+  readAndCheckPins(pins);
+}
+
+TEST_F(SsdFileTest, writeThrottle) {
+  constexpr int32_t kEntrySize = 64 << 10;
+  initializeCache(128 * kMB, 4 * SsdFile::kRegionSize);
+  FLAGS_ssd_max_write_bytes_per_sec = 16 * kMB;
+  SCOPE_EXIT {
+    FLAGS_ssd_max_write_bytes_per_sec = 0;
+  };
+  // The first write starts right away and delays the second by its size over
+  // the rate.
+  for (auto i = 0; i < 2; ++i) {
+    auto pins =
+        makePins(fileName_.id(), i * 4 * kMB, kEntrySize, kEntrySize, 4 * kMB);
+    ssdFile_->write(pins);
+  }
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_GE(stats.writeThrottleUs, 200'000);
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   LOG(ERROR) << "here";
@@ -318,3 +386,111 @@ TEST_F(SsdFileTest, notDisabledCow) {
   EXPECT_FALSE(ssdFile_->testingIsCowDisabled());
 }
 #endif // VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
+
+TEST_F(SsdFileTest, ioUring) {
+  if (!SsdIoUring::isSupported()) {
+    GTEST_SKIP() << "io_uring is not supported";
+  }
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize, false, true);
+  ASSERT_TRUE(ssdFile_->testingUsesIoUring());
+  for (auto startOffset = 0; startOffset < kSsdSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+    }
+  }
+  for (auto startOffset = 0; startOffset < kSsdSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    readAndCheckPins(pins);
+  }
+
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(stats.writeSsdErrors, 0);
+  EXPECT_EQ(stats.readSsdErrors, 0);
+  // One submission for each write() and each load().
+  EXPECT_EQ(stats.ioUringSubmissions, 8);
+  EXPECT_GE(stats.ioUringRequests, 8);
+  uint64_t numDepths = 0;
+  uint64_t numLatencies = 0;
+  for (auto i = 0; i < SsdCacheStats::kNumIoHistogramBuckets; ++i) {
+    numDepths += stats.ioUringQueueDepth[i];
+    numLatencies += stats.ioUringLatencyUs[i];
+  }
+  EXPECT_EQ(numDepths, 8);
+  EXPECT_EQ(numLatencies, 8);
+}
+
+TEST_F(SsdFileTest, checkpointRecovery) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const auto restart = [&]() {
+    ssdFile_.reset();
+    initializeCache(128 * kMB, kSsdSize, false, false, kSsdSize);
+    ssdFile_->waitForRecovery();
+    SsdCacheStats stats;
+    ssdFile_->updateStats(stats);
+    return stats;
+  };
+  const auto isCached = [&](const TestEntry& entry) {
+    return !ssdFile_->find(RawFileCacheKey{fileName_.id(), entry.key.offset})
+                .empty();
+  };
+
+  initializeCache(128 * kMB, kSsdSize, false, false, kSsdSize);
+  std::vector<TestEntry> allEntries;
+  for (auto startOffset = 0; startOffset < kSsdSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+  }
+  ssdFile_->checkpoint(true);
+
+  auto stats = restart();
+  ASSERT_EQ(stats.checkpointRegionsRecovered, 4);
+  ASSERT_EQ(stats.checkpointRegionsDiscarded, 0);
+  ASSERT_EQ(stats.readCheckpointErrors, 0);
+  for (auto startOffset = 0; startOffset < kSsdSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    readAndCheckPins(pins);
+  }
+
+  // Cutting the tail off the checkpoint corrupts the entries of the last
+  // region. The other regions are recovered.
+  ssdFile_->checkpoint(true);
+  const auto checkpointPath = ssdPath() + ".cpt";
+  const auto fd = ::open(checkpointPath.c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(::ftruncate(fd, ::lseek(fd, 0, SEEK_END) - 1), 0);
+  ::close(fd);
+  stats = restart();
+  ASSERT_EQ(stats.checkpointRegionsRecovered, 3);
+  ASSERT_EQ(stats.checkpointRegionsDiscarded, 1);
+  ASSERT_EQ(stats.readCheckpointErrors, 1);
+  for (const auto& entry : allEntries) {
+    ASSERT_EQ(isCached(entry), SsdFile::regionIndex(entry.ssdOffset) < 3);
+  }
+
+  // A corrupt header discards the whole checkpoint.
+  ssdFile_->checkpoint(true);
+  const auto headerFd = ::open(checkpointPath.c_str(), O_WRONLY);
+  ASSERT_GE(headerFd, 0);
+  ASSERT_EQ(::ftruncate(headerFd, 16), 0);
+  ::close(headerFd);
+  stats = restart();
+  ASSERT_EQ(stats.checkpointRegionsRecovered, 0);
+  ASSERT_EQ(stats.readCheckpointErrors, 1);
+  ASSERT_FALSE(isCached(allEntries[0]));
+}
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/file/File.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Fs.h"
 
 #include <fmt/format.h>
@@ -23,10 +24,25 @@
 #include <stdexcept>
 
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <folly/portability/SysUio.h>
 
 namespace facebook::velox {
 
+namespace {
+// Alignment of the file offset, size and memory address of reads in
+// LocalReadFile::Mode::kDirect. Covers the logical block size of local disks.
+constexpr uint64_t kDirectIoAlignment = 4096;
+
+// Size of the aligned buffer that unaligned direct reads go through.
+constexpr uint64_t kDirectIoBufferSize = 1 << 20;
+
+void freeMappingView(void* /*buf*/, void* userData) {
+  delete static_cast<std::shared_ptr<const char>*>(userData);
+}
+} // namespace
+
 #define RETURN_IF_ERROR(func, result) \
   result = func;                      \
   if (result < 0) {                   \
@@ -101,8 +117,34 @@ uint64_t InMemoryWriteFile::size() const {
   return file_->size();
 }
 
-LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
-  fd_ = open(path_.c_str(), O_RDONLY);
+// static
+LocalReadFile::Mode LocalReadFile::toMode(std::string_view name) {
+  if (name == "buffered") {
+    return Mode::kBuffered;
+  }
+  if (name == "mmap") {
+    return Mode::kMmap;
+  }
+  if (name == "direct") {
+    return Mode::kDirect;
+  }
+  VELOX_USER_FAIL("Unknown local file read mode: {}", name);
+}
+
+LocalReadFile::LocalReadFile(std::string_view path, Mode mode)
+    : path_(path), mode_(mode) {
+  int32_t flags = O_RDONLY;
+#ifdef O_DIRECT
+  if (mode_ == Mode::kDirect) {
+    flags |= O_DIRECT;
+  }
+#endif
+  fd_ = open(path_.c_str(), flags);
+  if (fd_ < 0 && errno == EINVAL && mode_ == Mode::kDirect) {
+    // The file system does not support direct IO.
+    mode_ = Mode::kBuffered;
+    fd_ = open(path_.c_str(), O_RDONLY);
+  }
   if (fd_ < 0) {
     if (errno == ENOENT) {
       VELOX_FILE_NOT_FOUND_ERROR("No such file or directory: {}", path);
@@ -123,6 +165,30 @@ LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
       path,
       folly::errnoStr(errno));
   size_ = rc;
+
+  if (mode_ == Mode::kDirect) {
+#ifdef __APPLE__
+    if (fcntl(fd_, F_NOCACHE, 1) != 0) {
+      mode_ = Mode::kBuffered;
+    }
+#elif !defined(O_DIRECT)
+    mode_ = Mode::kBuffered;
+#endif
+  }
+  if (mode_ == Mode::kMmap && size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    VELOX_CHECK(
+        data != MAP_FAILED,
+        "mmap failure in LocalReadFile constructor, {} {}.",
+        path,
+        folly::errnoStr(errno));
+    const auto size = size_;
+    mapping_ = std::shared_ptr<const char>(
+        static_cast<const char*>(data),
+        [size](const char* address) {
+          munmap(const_cast<char*>(address), size);
+        });
+  }
 }
 
 LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {}
@@ -138,6 +204,23 @@ LocalReadFile::~LocalReadFile() {
 void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   bytesRead_ += length;
+  if (mode_ == Mode::kMmap) {
+    VELOX_CHECK_LE(
+        offset + length,
+        size_,
+        "Read past the end of {}, offset {}, length {}.",
+        getName(),
+        offset,
+        length);
+    if (length > 0) {
+      memcpy(pos, mapping_.get() + offset, length);
+    }
+    return;
+  }
+  if (mode_ == Mode::kDirect) {
+    preadDirect(offset, length, pos);
+    return;
+  }
   auto bytesRead = ::pread(fd_, pos, length, offset);
   VELOX_CHECK_EQ(
       bytesRead,
@@ -147,15 +230,87 @@ void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
       length);
 }
 
+void LocalReadFile::preadDirect(uint64_t offset, uint64_t length, char* pos)
+    const {
+  if (offset % kDirectIoAlignment == 0 && length % kDirectIoAlignment == 0 &&
+      reinterpret_cast<uintptr_t>(pos) % kDirectIoAlignment == 0) {
+    const auto bytesRead = ::pread(fd_, pos, length, offset);
+    VELOX_CHECK_EQ(
+        bytesRead,
+        length,
+        "fread failure in LocalReadFile::preadDirect, {} vs {}.",
+        bytesRead,
+        length);
+    return;
+  }
+  // Reads the aligned blocks that cover the range into an aligned buffer
+  // and copies the requested bytes out.
+  static thread_local std::unique_ptr<char, decltype(&std::free)> buffer(
+      static_cast<char*>(
+          std::aligned_alloc(kDirectIoAlignment, kDirectIoBufferSize)),
+      &std::free);
+  VELOX_CHECK_NOT_NULL(buffer);
+  while (length > 0) {
+    const auto skip = offset % kDirectIoAlignment;
+    const auto readSize = std::min<uint64_t>(
+        kDirectIoBufferSize, bits::roundUp(skip + length, kDirectIoAlignment));
+    const auto copySize = std::min<uint64_t>(readSize - skip, length);
+    const auto bytesRead = ::pread(fd_, buffer.get(), readSize, offset - skip);
+    // The last block of the file may be short.
+    VELOX_CHECK_GE(
+        bytesRead,
+        static_cast<int64_t>(skip + copySize),
+        "fread failure in LocalReadFile::preadDirect, {} vs {}.",
+        bytesRead,
+        skip + copySize);
+    memcpy(pos, buffer.get() + skip, copySize);
+    pos += copySize;
+    offset += copySize;
+    length -= copySize;
+  }
+}
+
 std::string_view
 LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
   preadInternal(offset, length, static_cast<char*>(buf));
   return {static_cast<char*>(buf), length};
 }
 
+void LocalReadFile::preadv(
+    folly::Range<const common::Region*> regions,
+    folly::Range<folly::IOBuf*> iobufs) const {
+  if (mapping_ == nullptr) {
+    ReadFile::preadv(regions, iobufs);
+    return;
+  }
+  VELOX_CHECK_EQ(regions.size(), iobufs.size());
+  for (size_t i = 0; i < regions.size(); ++i) {
+    const auto& region = regions[i];
+    VELOX_CHECK_LE(
+        region.offset + region.length,
+        size_,
+        "Read past the end of {}, offset {}, length {}.",
+        getName(),
+        region.offset,
+        region.length);
+    bytesRead_ += region.length;
+    iobufs[i] = folly::IOBuf(
+        folly::IOBuf::TAKE_OWNERSHIP,
+        const_cast<char*>(mapping_.get() + region.offset),
+        region.length,
+        freeMappingView,
+        new std::shared_ptr<const char>(mapping_));
+  }
+}
+
 uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (mode_ != Mode::kBuffered) {
+    // Goes through pread() for each range, which copies from the mapping or
+    // aligns the reads.
+    return ReadFile::preadv(offset, buffers);
+  }
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
@@ -221,6 +376,19 @@ uint64_t LocalReadFile::memoryUsage() const {
   return sizeof(FILE);
 }
 
+std::string LocalReadFile::getVersion() const {
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    return "";
+  }
+#ifdef __APPLE__
+  const auto& mtime = st.st_mtimespec;
+#else
+  const auto& mtime = st.st_mtim;
+#endif
+  return fmt::format("{}.{}-{}", mtime.tv_sec, mtime.tv_nsec, st.st_size);
+}
+
 LocalWriteFile::LocalWriteFile(
     std::string_view path,
     bool shouldCreateParentDirectories,
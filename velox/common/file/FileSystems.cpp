@@ -86,8 +86,13 @@ class LocalFileSystem : public FileSystem {
 
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
-      const FileOptions& /*unused*/) override {
-    return std::make_unique<LocalReadFile>(extractPath(path));
+      const FileOptions& options) override {
+    auto mode = LocalReadFile::Mode::kBuffered;
+    auto it = options.values.find(FileOptions::kLocalReadMode.str());
+    if (it != options.values.end()) {
+      mode = LocalReadFile::toMode(it->second);
+    }
+    return std::make_unique<LocalReadFile>(extractPath(path), mode);
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -41,6 +41,10 @@ struct FileOptions {
   /// etc.
   static constexpr folly::StringPiece kFileCreateConfig{"file-create-config"};
 
+  /// Selects how the local file system reads files: "buffered" (default),
+  /// "mmap" or "direct". See LocalReadFile::Mode.
+  static constexpr folly::StringPiece kLocalReadMode{"local-read-mode"};
+
   std::unordered_map<std::string, std::string> values;
   memory::MemoryPool* pool{nullptr};
 };
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/file/ParallelUploader.h"
+
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox {
+
+ParallelUploader::ParallelUploader(const Options& options, UploadFunc upload)
+    : blockSize_(options.blockSize),
+      maxBufferedBytes_(options.maxBufferedBytes),
+      executor_(options.executor),
+      pool_(options.pool),
+      upload_(std::move(upload)) {
+  VELOX_CHECK_GT(blockSize_, 0);
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+ParallelUploader::~ParallelUploader() {
+  if (current_ != nullptr) {
+    release(*current_);
+  }
+  for (auto& block : pending_) {
+    block->done.wait();
+    release(*block);
+  }
+}
+
+void ParallelUploader::append(std::string_view data) {
+  while (!data.empty()) {
+    if (current_ == nullptr) {
+      while (!pending_.empty() &&
+             (pending_.size() + 1) * blockSize_ > maxBufferedBytes_) {
+        waitForOldest();
+      }
+      // Frees the buffers of the uploads that are done without waiting.
+      while (!pending_.empty() && pending_.front()->done.isReady()) {
+        waitForOldest();
+      }
+      current_ = std::make_unique<Block>();
+      current_->data = static_cast<char*>(pool_->allocate(blockSize_));
+      current_->size = 0;
+    }
+    const auto numBytes = std::min(data.size(), blockSize_ - current_->size);
+    memcpy(current_->data + current_->size, data.data(), numBytes);
+    current_->size += numBytes;
+    size_ += numBytes;
+    data.remove_prefix(numBytes);
+    if (current_->size == blockSize_) {
+      submit();
+    }
+  }
+}
+
+void ParallelUploader::flush() {
+  if (current_ != nullptr) {
+    submit();
+  }
+  while (!pending_.empty()) {
+    waitForOldest();
+  }
+}
+
+void ParallelUploader::submit() {
+  auto block = std::move(current_);
+  const auto index = numBlocks_++;
+  const auto offset = size_ - block->size;
+  auto* rawBlock = block.get();
+  auto upload = [this, rawBlock, index, offset]() {
+    rawBlock->startMicros = getCurrentTimeMicro();
+    SCOPE_EXIT {
+      rawBlock->endMicros = getCurrentTimeMicro();
+    };
+    upload_(index, offset, {rawBlock->data, rawBlock->size});
+  };
+  block->submitMicros = getCurrentTimeMicro();
+  if (executor_ == nullptr) {
+    block->done = folly::makeFutureWith(std::move(upload));
+  } else {
+    block->done = folly::via(executor_, std::move(upload));
+  }
+  pending_.push_back(std::move(block));
+}
+
+void ParallelUploader::waitForOldest() {
+  auto block = std::move(pending_.front());
+  pending_.pop_front();
+  SCOPE_EXIT {
+    release(*block);
+  };
+  if (!block->done.isReady()) {
+    const auto startMicros = getCurrentTimeMicro();
+    block->done.wait();
+    stats_.waitMicros += getCurrentTimeMicro() - startMicros;
+  }
+  ++stats_.numUploads;
+  stats_.uploadedBytes += block->size;
+  if (block->startMicros > 0) {
+    stats_.queuedMicros += block->startMicros - block->submitMicros;
+    stats_.uploadMicros += block->endMicros - block->startMicros;
+  }
+  std::move(block->done).get();
+}
+
+void ParallelUploader::release(Block& block) {
+  pool_->free(block.data, blockSize_);
+  block.data = nullptr;
+}
+
+void ParallelUploader::addRuntimeStats(const std::string& prefix) const {
+  if (stats_.numUploads == 0) {
+    return;
+  }
+  addThreadLocalRuntimeStat(
+      prefix + "Uploads", RuntimeCounter(stats_.numUploads));
+  addThreadLocalRuntimeStat(
+      prefix + "UploadBytes",
+      RuntimeCounter(stats_.uploadedBytes, RuntimeCounter::Unit::kBytes));
+  addThreadLocalRuntimeStat(
+      prefix + "UploadWallNanos",
+      RuntimeCounter(
+          stats_.uploadMicros * 1'000, RuntimeCounter::Unit::kNanos));
+  addThreadLocalRuntimeStat(
+      prefix + "UploadQueuedWallNanos",
+      RuntimeCounter(
+          stats_.queuedMicros * 1'000, RuntimeCounter::Unit::kNanos));
+  addThreadLocalRuntimeStat(
+      prefix + "UploadWaitWallNanos",
+      RuntimeCounter(
+          stats_.waitMicros * 1'000, RuntimeCounter::Unit::kNanos));
+}
+
+} // namespace facebook::velox
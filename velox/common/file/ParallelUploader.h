@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
+
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox {
+
+/// Buffers the data appended to a WriteFile into blocks and uploads the full
+/// blocks on an executor while the writer keeps appending, e.g. as the blocks
+/// of an ABFS file or the components of a GCS composite object. The blocks
+/// are allocated from the writer's memory pool. append() waits for the oldest
+/// upload to finish when another block would take the buffered and uploading
+/// blocks over 'maxBufferedBytes'. The buffers are allocated and freed on the
+/// calling thread. Not thread-safe.
+class ParallelUploader {
+ public:
+  /// Uploads the block number 'index' that starts at 'offset' in the file.
+  /// Called on the executor, concurrently for different blocks.
+  using UploadFunc = std::function<
+      void(int32_t index, uint64_t offset, std::string_view data)>;
+
+  struct Options {
+    uint64_t blockSize{8 << 20};
+
+    /// Limit of the buffered and uploading blocks. At least one block is
+    /// uploading at a time.
+    uint64_t maxBufferedBytes{64 << 20};
+
+    /// Runs the uploads. nullptr uploads on the calling thread.
+    folly::Executor* executor{nullptr};
+
+    /// Pool of the writer. Not nullptr.
+    memory::MemoryPool* pool{nullptr};
+  };
+
+  struct Stats {
+    int32_t numUploads{0};
+    uint64_t uploadedBytes{0};
+
+    /// Sum of the time the uploads waited in the executor queue.
+    uint64_t queuedMicros{0};
+
+    /// Sum of the time of the upload calls.
+    uint64_t uploadMicros{0};
+
+    /// Time the writer waited for uploads to finish, either for buffer memory
+    /// in append() or in flush().
+    uint64_t waitMicros{0};
+  };
+
+  ParallelUploader(const Options& options, UploadFunc upload);
+
+  /// Waits for the uploads in flight. Does not upload the buffered data.
+  ~ParallelUploader();
+
+  void append(std::string_view data);
+
+  /// Uploads the buffered data as a block, even if smaller than the block
+  /// size, and waits for all uploads to finish. Throws the first error of an
+  /// upload.
+  void flush();
+
+  /// Bytes appended so far.
+  uint64_t size() const {
+    return size_;
+  }
+
+  /// Number of blocks uploaded or uploading.
+  int32_t numBlocks() const {
+    return numBlocks_;
+  }
+
+  /// Stats of the finished uploads.
+  const Stats& stats() const {
+    return stats_;
+  }
+
+  /// Adds 'stats()' to the runtime stats of the calling thread with names
+  /// starting with 'prefix', e.g. gcsUploadBytes for 'prefix' gcs.
+  void addRuntimeStats(const std::string& prefix) const;
+
+ private:
+  struct Block {
+    char* data;
+    uint64_t size;
+    uint64_t submitMicros{0};
+    uint64_t startMicros{0};
+    uint64_t endMicros{0};
+    folly::Future<folly::Unit> done = folly::makeFuture();
+  };
+
+  // Starts uploading 'current_'.
+  void submit();
+
+  // Waits for the oldest upload and frees its buffer. Throws the error of the
+  // upload.
+  void waitForOldest();
+
+  // Frees the buffer of 'block'.
+  void release(Block& block);
+
+  const uint64_t blockSize_;
+  const uint64_t maxBufferedBytes_;
+  folly::Executor* const executor_;
+  memory::MemoryPool* const pool_;
+  const UploadFunc upload_;
+
+  // The block being filled. nullptr if no data is buffered.
+  std::unique_ptr<Block> current_;
+  // Uploads in flight, oldest first.
+  std::deque<std::unique_ptr<Block>> pending_;
+
+  uint64_t size_{0};
+  int32_t numBlocks_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox
@@ -140,6 +140,50 @@ TEST(LocalFile, writeAndRead) {
   }
 }
 
+TEST(LocalFile, readModes) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  for (auto mode :
+       {LocalReadFile::Mode::kBuffered,
+        LocalReadFile::Mode::kMmap,
+        LocalReadFile::Mode::kDirect}) {
+    SCOPED_TRACE(static_cast<int>(mode));
+    auto readFile = std::make_unique<LocalReadFile>(filename, mode);
+    if (mode == LocalReadFile::Mode::kDirect) {
+      // Direct IO is not supported by all file systems, e.g. tmpfs.
+      EXPECT_NE(LocalReadFile::Mode::kMmap, readFile->mode());
+    } else {
+      EXPECT_EQ(mode, readFile->mode());
+    }
+    readData(readFile.get());
+
+    // aaaaa bbbbb c*1MB ddddd
+    const std::vector<Region> regions = {
+        {4, 2UL, {}}, {5 + 5 + kOneMB - 3, 5UL, {}}, {0, 15 + kOneMB, {}}};
+    std::vector<folly::IOBuf> iobufs(regions.size());
+    readFile->preadv(regions, {iobufs.data(), iobufs.size()});
+    if (mode == LocalReadFile::Mode::kMmap) {
+      // The views of the mapping stay valid after the file is closed.
+      readFile.reset();
+    }
+    std::vector<std::string> values;
+    for (auto& iobuf : iobufs) {
+      values.push_back(std::string{
+          reinterpret_cast<const char*>(iobuf.data()), iobuf.length()});
+    }
+    ASSERT_EQ("ab", values[0]);
+    ASSERT_EQ("cccdd", values[1]);
+    ASSERT_EQ("aaaaabbbbb" + std::string(kOneMB, 'c') + "ddddd", values[2]);
+  }
+  VELOX_ASSERT_THROW(
+      LocalReadFile::toMode("async"), "Unknown local file read mode: async");
+}
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
@@ -154,6 +198,14 @@ TEST(LocalFile, viaRegistry) {
   ASSERT_EQ(readFile->size(), 5);
   char buffer1[5];
   ASSERT_EQ(readFile->pread(0, 5, &buffer1), "snarf");
+
+  filesystems::FileOptions options;
+  options.values[filesystems::FileOptions::kLocalReadMode.str()] = "mmap";
+  readFile = lfs->openFileForRead(filename, options);
+  ASSERT_EQ(
+      LocalReadFile::Mode::kMmap,
+      dynamic_cast<LocalReadFile*>(readFile.get())->mode());
+  ASSERT_EQ(readFile->pread(0, 5, &buffer1), "snarf");
   lfs->remove(filename);
 }
 
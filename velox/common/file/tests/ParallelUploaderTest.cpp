@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/file/ParallelUploader.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include <mutex>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+class ParallelUploaderTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Returns an upload function that writes the blocks into 'uploaded_'.
+  ParallelUploader::UploadFunc uploadFunc() {
+    return [this](int32_t index, uint64_t offset, std::string_view data) {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (uploaded_.size() < offset + data.size()) {
+        uploaded_.resize(offset + data.size());
+      }
+      memcpy(uploaded_.data() + offset, data.data(), data.size());
+      if (blockSizes_.size() <= index) {
+        blockSizes_.resize(index + 1);
+      }
+      blockSizes_[index] = data.size();
+    };
+  }
+
+  static std::string makeData(int32_t size) {
+    std::string data(size, 0);
+    for (auto i = 0; i < size; ++i) {
+      data[i] = 'a' + i % 26;
+    }
+    return data;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  std::mutex mutex_;
+  std::string uploaded_;
+  std::vector<uint64_t> blockSizes_;
+};
+
+TEST_F(ParallelUploaderTest, basic) {
+  for (auto numThreads : {0, 4}) {
+    SCOPED_TRACE(fmt::format("numThreads: {}", numThreads));
+    uploaded_.clear();
+    blockSizes_.clear();
+    auto executor = numThreads == 0
+        ? nullptr
+        : std::make_unique<folly::CPUThreadPoolExecutor>(numThreads);
+    ParallelUploader uploader(
+        {.blockSize = 1'000,
+         .maxBufferedBytes = 3'000,
+         .executor = executor.get(),
+         .pool = pool_.get()},
+        uploadFunc());
+    const auto data = makeData(10'500);
+    uploader.append(std::string_view(data).substr(0, 700));
+    uploader.append(std::string_view(data).substr(700, 5'000));
+    EXPECT_EQ(uploader.numBlocks(), 5);
+    // At most 3 blocks are buffered or uploading.
+    EXPECT_LE(pool_->usedBytes(), 3'000);
+    uploader.flush();
+    EXPECT_EQ(uploader.numBlocks(), 6);
+    EXPECT_EQ(pool_->usedBytes(), 0);
+    // Appends after a flush start a new block.
+    uploader.append(std::string_view(data).substr(5'700));
+    uploader.flush();
+    EXPECT_EQ(uploader.size(), data.size());
+    EXPECT_EQ(uploaded_, data);
+    EXPECT_EQ(
+        blockSizes_,
+        std::vector<uint64_t>(
+            {1'000, 1'000, 1'000, 1'000, 1'000, 700, 1'000, 1'000, 1'000,
+             1'000, 800}));
+    EXPECT_EQ(uploader.stats().numUploads, 11);
+    EXPECT_EQ(uploader.stats().uploadedBytes, data.size());
+  }
+}
+
+TEST_F(ParallelUploaderTest, error) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  {
+    ParallelUploader uploader(
+        {.blockSize = 100,
+         .maxBufferedBytes = 1'000,
+         .executor = executor.get(),
+         .pool = pool_.get()},
+        [](int32_t index, uint64_t /*offset*/, std::string_view /*data*/) {
+          VELOX_CHECK_NE(index, 2, "Failed to upload");
+        });
+    uploader.append(makeData(550));
+    VELOX_ASSERT_THROW(uploader.flush(), "Failed to upload");
+  }
+  // The buffers of the uploads after the failed one are freed when the
+  // uploader is destroyed.
+  EXPECT_EQ(pool_->usedBytes(), 0);
+}
+
+} // namespace
@@ -117,6 +117,31 @@ double correctBias(double rawEstimate, int8_t indexBitLength) {
 
   return rawEstimate - bias;
 }
+
+/// Merges 'otherDeltas' into 'deltas' when neither side has overflows, so
+/// that no merged delta exceeds kMaxDelta. 'shift' and 'otherShift' are the
+/// differences of the new baseline and the baselines of the two sides, one
+/// of which is 0. Returns the number of zero deltas. The loop has no branches
+/// so that the compiler can vectorize it.
+int32_t mergeDeltasWithoutOverflows(
+    int8_t* deltas,
+    const int8_t* otherDeltas,
+    int32_t numSlots,
+    int8_t shift,
+    int8_t otherShift) {
+  int32_t baselineCount = 0;
+  for (auto i = 0; i < numSlots; ++i) {
+    const uint8_t slot = deltas[i];
+    const uint8_t otherSlot = otherDeltas[i];
+    const int32_t high =
+        std::max((slot >> 4) - shift, (otherSlot >> 4) - otherShift);
+    const int32_t low = std::max(
+        (slot & kBucketMask) - shift, (otherSlot & kBucketMask) - otherShift);
+    deltas[i] = static_cast<int8_t>((high << 4) | low);
+    baselineCount += (high == 0) + (low == 0);
+  }
+  return baselineCount;
+}
 } // namespace
 
 DenseHll::DenseHll(int8_t indexBitLength, HashStringAllocator* allocator)
@@ -568,6 +593,18 @@ void DenseHll::mergeWith(
     const uint16_t* otherOverflowBuckets,
     const int8_t* otherOverflowValues) {
   int8_t newBaseline = std::max(baseline_, otherBaseline);
+  if (overflows_ == 0 && otherOverflows == 0) {
+    baselineCount_ = mergeDeltasWithoutOverflows(
+        deltas_.data(),
+        otherDeltas,
+        deltas_.size(),
+        newBaseline - baseline_,
+        newBaseline - otherBaseline);
+    baseline_ = newBaseline;
+    adjustBaselineIfNeeded();
+    return;
+  }
+
   int32_t baselineCount = 0;
 
   int bucket = 0;
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/hyperloglog/SparseHll.h"
+
+#include <algorithm>
+
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -88,6 +91,31 @@ bool SparseHll::insertHash(uint64_t hash) {
   return overLimit();
 }
 
+bool SparseHll::insertHashes(const uint64_t* hashes, int32_t count) {
+  if (count == 0) {
+    return overLimit();
+  }
+  std::vector<uint32_t> newEntries(count);
+  for (auto i = 0; i < count; ++i) {
+    newEntries[i] = encode(
+        computeIndex(hashes[i], kIndexBitLength),
+        numberOfLeadingZeros(hashes[i], kIndexBitLength));
+  }
+  // The index is in the high bits, so the largest value of an index sorts
+  // last among the entries of the index.
+  std::sort(newEntries.begin(), newEntries.end());
+  int32_t numNewEntries = 0;
+  for (auto i = 0; i < count; ++i) {
+    if (i + 1 < count &&
+        decodeIndex(newEntries[i]) == decodeIndex(newEntries[i + 1])) {
+      continue;
+    }
+    newEntries[numNewEntries++] = newEntries[i];
+  }
+  mergeWith(numNewEntries, newEntries.data());
+  return overLimit();
+}
+
 int64_t SparseHll::cardinality() const {
   // Estimate the cardinality using linear counting over the theoretical
   // 2^kIndexBitLength buckets available due to the fact that we're
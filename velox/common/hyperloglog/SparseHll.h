@@ -40,6 +40,13 @@ class SparseHll {
   /// Returns true if soft memory limit has been reached. False, otherwise.
   bool insertHash(uint64_t hash);
 
+  /// Inserts 'count' hashes at once. Sorts the new entries by bucket and
+  /// merges them into the existing entries in one pass instead of inserting
+  /// into the sorted entries one at a time. The result is the same as
+  /// inserting the hashes one by one. Returns true if soft memory limit has
+  /// been reached. False, otherwise.
+  bool insertHashes(const uint64_t* hashes, int32_t count);
+
   int64_t cardinality() const;
 
   /// Returns cardinality estimate from the specified serialized digest.
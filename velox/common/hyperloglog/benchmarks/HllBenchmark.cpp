@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include <array>
+
+#include "velox/common/hyperloglog/DenseHll.h"
+#include "velox/common/hyperloglog/SparseHll.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::common::hll;
+
+namespace {
+
+constexpr int8_t kIndexBitLength = 11;
+
+class HllBenchmark {
+ public:
+  HllBenchmark() {
+    folly::Random::DefaultGenerator rng(1);
+    hashes_.resize(10'000);
+    for (auto& hash : hashes_) {
+      hash = folly::Random::rand64(rng);
+    }
+    for (auto i = 0; i < denseHlls_.size(); ++i) {
+      denseHlls_[i] = std::make_unique<DenseHll>(kIndexBitLength, &allocator_);
+      for (auto j = 0; j < 5'000; ++j) {
+        denseHlls_[i]->insertHash(folly::Random::rand64(rng));
+      }
+    }
+  }
+
+  // Inserts the first 'count' hashes into a sparse HLL, one by one or in
+  // one batch.
+  size_t sparseInsert(int32_t count, bool batch) {
+    SparseHll hll{&allocator_};
+    if (batch) {
+      hll.insertHashes(hashes_.data(), count);
+    } else {
+      for (auto i = 0; i < count; ++i) {
+        hll.insertHash(hashes_[i]);
+      }
+    }
+    return hll.cardinality();
+  }
+
+  size_t denseInsert() {
+    DenseHll hll{kIndexBitLength, &allocator_};
+    for (auto hash : hashes_) {
+      hll.insertHash(hash);
+    }
+    return hll.cardinality();
+  }
+
+  size_t denseMerge() {
+    DenseHll hll{kIndexBitLength, &allocator_};
+    for (const auto& other : denseHlls_) {
+      hll.mergeWith(*other);
+    }
+    return hll.cardinality();
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  HashStringAllocator allocator_{pool_.get()};
+  std::vector<uint64_t> hashes_;
+  std::array<std::unique_ptr<DenseHll>, 100> denseHlls_;
+};
+
+std::unique_ptr<HllBenchmark> benchmark;
+
+BENCHMARK(sparseInsertHash) {
+  folly::doNotOptimizeAway(benchmark->sparseInsert(500, false));
+}
+
+BENCHMARK_RELATIVE(sparseInsertHashes) {
+  folly::doNotOptimizeAway(benchmark->sparseInsert(500, true));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(denseInsertHash) {
+  folly::doNotOptimizeAway(benchmark->denseInsert());
+}
+
+BENCHMARK(denseMergeWith) {
+  folly::doNotOptimizeAway(benchmark->denseMerge());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<HllBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
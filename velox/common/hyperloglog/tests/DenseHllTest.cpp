@@ -223,6 +223,10 @@ TEST_P(DenseHllTest, mergeWith) {
 
   // large, same
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
+
+  // different baselines
+  testMergeWith(indexBitLength, sequence(0, 20'000), sequence(0, 10));
+  testMergeWith(indexBitLength, sequence(0, 10), sequence(0, 20'000));
 }
 
 INSTANTIATE_TEST_SUITE_P(
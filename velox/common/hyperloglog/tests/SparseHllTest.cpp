@@ -144,6 +144,34 @@ TEST_F(SparseHllTest, highCardinality) {
   ASSERT_EQ(1'000, SparseHll::cardinality(serialized.data()));
 }
 
+TEST_F(SparseHllTest, insertHashes) {
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 1'000; i++) {
+    hashes.push_back(hashOne(i % 300));
+  }
+
+  // Insert some hashes one by one and the rest in batches with duplicates.
+  SparseHll expected{&allocator_};
+  SparseHll sparseHll{&allocator_};
+  for (auto i = 0; i < 100; ++i) {
+    expected.insertHash(hashes[i]);
+    sparseHll.insertHash(hashes[i]);
+  }
+  for (auto i = 100; i < hashes.size(); ++i) {
+    expected.insertHash(hashes[i]);
+  }
+  sparseHll.insertHashes(hashes.data() + 100, 400);
+  sparseHll.insertHashes(hashes.data() + 500, 500);
+  sparseHll.insertHashes(hashes.data(), 0);
+
+  sparseHll.verify();
+  ASSERT_EQ(300, sparseHll.cardinality());
+  ASSERT_EQ(serialize(11, expected), serialize(11, sparseHll));
+
+  sparseHll.setSoftMemoryLimit(4 * 300);
+  ASSERT_TRUE(sparseHll.insertHashes(hashes.data(), 10));
+}
+
 namespace {
 template <typename T>
 std::vector<T> sequence(T start, T end) {
@@ -46,6 +46,14 @@ uint64_t IoStatistics::totalScanTime() const {
   return totalScanTime_.load(std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::localBytesRead() const {
+  return localBytesRead_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::remoteBytesRead() const {
+  return remoteBytesRead_.load(std::memory_order_relaxed);
+}
+
 uint64_t IoStatistics::incRawBytesRead(int64_t v) {
   return rawBytesRead_.fetch_add(v, std::memory_order_relaxed);
 }
@@ -70,6 +78,14 @@ uint64_t IoStatistics::incTotalScanTime(int64_t v) {
   return totalScanTime_.fetch_add(v, std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::incLocalBytesRead(int64_t v) {
+  return localBytesRead_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incRemoteBytesRead(int64_t v) {
+  return remoteBytesRead_.fetch_add(v, std::memory_order_relaxed);
+}
+
 void IoStatistics::incOperationCounters(
     const std::string& operation,
     const uint64_t resourceThrottleCount,
@@ -98,6 +114,8 @@ void IoStatistics::merge(const IoStatistics& other) {
   rawBytesRead_ += other.rawBytesRead_;
   rawBytesWritten_ += other.rawBytesWritten_;
   totalScanTime_ += other.totalScanTime_;
+  localBytesRead_ += other.localBytesRead_;
+  remoteBytesRead_ += other.remoteBytesRead_;
 
   rawOverreadBytes_ += other.rawOverreadBytes_;
   prefetch_.merge(other.prefetch_);
@@ -105,6 +123,8 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  adaptiveCoalesceDistance_.merge(other.adaptiveCoalesceDistance_);
+  adaptivePrefetchDepth_.merge(other.adaptivePrefetchDepth_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
@@ -94,6 +94,8 @@ class IoStatistics {
   uint64_t inputBatchSize() const;
   uint64_t outputBatchSize() const;
   uint64_t totalScanTime() const;
+  uint64_t localBytesRead() const;
+  uint64_t remoteBytesRead() const;
 
   uint64_t incRawBytesRead(int64_t);
   uint64_t incRawOverreadBytes(int64_t);
@@ -101,6 +103,8 @@ class IoStatistics {
   uint64_t incInputBatchSize(int64_t);
   uint64_t incOutputBatchSize(int64_t);
   uint64_t incTotalScanTime(int64_t);
+  uint64_t incLocalBytesRead(int64_t);
+  uint64_t incRemoteBytesRead(int64_t);
 
   IoCounter& prefetch() {
     return prefetch_;
@@ -122,6 +126,14 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& adaptiveCoalesceDistance() {
+    return adaptiveCoalesceDistance_;
+  }
+
+  IoCounter& adaptivePrefetchDepth() {
+    return adaptivePrefetchDepth_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -145,6 +157,11 @@ class IoStatistics {
   std::atomic<uint64_t> rawOverreadBytes_{0};
   std::atomic<uint64_t> totalScanTime_{0};
 
+  // Bytes read from storage on this host and on other hosts. Only counted for
+  // files that know where their data is, e.g. HDFS files.
+  std::atomic<uint64_t> localBytesRead_{0};
+  std::atomic<uint64_t> remoteBytesRead_{0};
+
   // Planned read from storage or SSD.
   IoCounter prefetch_;
 
@@ -162,6 +179,12 @@ class IoStatistics {
   // issued IO or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Coalesce distances and numbers of prefetches in flight chosen from the
+  // measured latency and bandwidth of the file system. One value per batch of
+  // coalesced loads.
+  IoCounter adaptiveCoalesceDistance_;
+  IoCounter adaptivePrefetchDepth_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/io/IoTuner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace facebook::velox::io {
+
+void IoTuner::Model::recordRead(uint64_t bytes, uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numReads_;
+  weight_ = weight_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumMicros_ = sumMicros_ * kDecay + y;
+  sumBytes2_ = sumBytes2_ * kDecay + x * x;
+  sumBytesMicros_ = sumBytesMicros_ * kDecay + x * y;
+}
+
+std::pair<double, double> IoTuner::Model::fitLocked() const {
+  if (numReads_ < kMinReads) {
+    return {0, 0};
+  }
+  const double meanBytes = sumBytes_ / weight_;
+  const double meanMicros = sumMicros_ / weight_;
+  const double variance = sumBytes2_ / weight_ - meanBytes * meanBytes;
+  // Reads of nearly the same size do not separate latency from bandwidth.
+  if (variance <= 0.01 * meanBytes * meanBytes) {
+    return {0, 0};
+  }
+  const double microsPerByte =
+      (sumBytesMicros_ / weight_ - meanBytes * meanMicros) / variance;
+  if (microsPerByte <= 0) {
+    return {0, 0};
+  }
+  const double latency =
+      std::max<double>(0, meanMicros - microsPerByte * meanBytes);
+  return {latency, microsPerByte};
+}
+
+bool IoTuner::Model::hasEstimate() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return fitLocked().second > 0;
+}
+
+double IoTuner::Model::latencyMicros() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return fitLocked().first;
+}
+
+double IoTuner::Model::bytesPerMicro() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto microsPerByte = fitLocked().second;
+  return microsPerByte > 0 ? 1 / microsPerByte : 0;
+}
+
+int32_t IoTuner::Model::coalesceDistance(int32_t defaultDistance) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto [latency, microsPerByte] = fitLocked();
+  if (microsPerByte <= 0) {
+    return defaultDistance;
+  }
+  return std::clamp<double>(
+      latency / microsPerByte, kMinCoalesceDistance, kMaxCoalesceDistance);
+}
+
+int32_t IoTuner::Model::prefetchDepth(int64_t loadBytes, int32_t defaultDepth)
+    const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto [latency, microsPerByte] = fitLocked();
+  if (microsPerByte <= 0 || loadBytes <= 0) {
+    return defaultDepth;
+  }
+  const double transferMicros = loadBytes * microsPerByte;
+  return std::clamp<double>(
+      1 + std::ceil(latency / transferMicros), 1, kMaxPrefetchDepth);
+}
+
+// static
+IoTuner& IoTuner::instance() {
+  static IoTuner* tuner = new IoTuner();
+  return *tuner;
+}
+
+// static
+std::string IoTuner::fileSystemClass(std::string_view fileName) {
+  const auto pos = fileName.find("://");
+  if (pos == std::string_view::npos) {
+    return "file";
+  }
+  return std::string(fileName.substr(0, pos));
+}
+
+std::shared_ptr<IoTuner::Model> IoTuner::model(std::string_view fileName) {
+  const auto fsClass = fileSystemClass(fileName);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& model = models_[fsClass];
+  if (model == nullptr) {
+    model = std::make_shared<Model>();
+  }
+  return model;
+}
+
+void IoTuner::testingClear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  models_.clear();
+}
+
+} // namespace facebook::velox::io
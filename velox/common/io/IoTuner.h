@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace facebook::velox::io {
+
+/// Learns the latency and bandwidth of reads from each class of file system,
+/// e.g. local files or S3, and derives how far apart reads may be to be
+/// coalesced and how many coalesced reads to keep in flight. Process-wide and
+/// thread-safe.
+class IoTuner {
+ public:
+  /// Model of a read of n bytes taking 'latency + n / bandwidth'. Fitted by
+  /// least squares over the recent reads.
+  class Model {
+   public:
+    /// Records a read of 'bytes' that took 'micros'.
+    void recordRead(uint64_t bytes, uint64_t micros);
+
+    /// Returns true if enough reads of different sizes have been recorded to
+    /// estimate the latency and bandwidth.
+    bool hasEstimate() const;
+
+    /// Returns the latency of a read in us. 0 if there is no estimate.
+    double latencyMicros() const;
+
+    /// Returns the bandwidth of a single read in bytes per us. 0 if there is
+    /// no estimate.
+    double bytesPerMicro() const;
+
+    /// Returns the largest gap between two reads for which reading the gap
+    /// is faster than issuing a separate read, i.e. the bytes transferred in
+    /// the latency of a read. Returns 'defaultDistance' if there is no
+    /// estimate.
+    int32_t coalesceDistance(int32_t defaultDistance) const;
+
+    /// Returns the number of reads of 'loadBytes' to keep in flight so that
+    /// the latency of the next read is hidden behind the transfer of the
+    /// previous ones. Returns 'defaultDepth' if there is no estimate.
+    int32_t prefetchDepth(int64_t loadBytes, int32_t defaultDepth) const;
+
+   private:
+    // Weight of the previous reads relative to a new one.
+    static constexpr double kDecay = 0.98;
+    static constexpr int32_t kMinReads = 16;
+
+    // Returns {latency, us per byte} or {0, 0} if there is no estimate.
+    std::pair<double, double> fitLocked() const;
+
+    mutable std::mutex mutex_;
+    int64_t numReads_{0};
+    // Decayed sums of weights, sizes, times, sizes squared and sizes times
+    // times.
+    double weight_{0};
+    double sumBytes_{0};
+    double sumMicros_{0};
+    double sumBytes2_{0};
+    double sumBytesMicros_{0};
+  };
+
+  static constexpr int32_t kMinCoalesceDistance = 4 << 10;
+  static constexpr int32_t kMaxCoalesceDistance = 16 << 20;
+  static constexpr int32_t kMaxPrefetchDepth = 32;
+
+  static IoTuner& instance();
+
+  /// Returns the class of the file system of 'fileName', i.e. the scheme of
+  /// the path or "file" for paths without a scheme.
+  static std::string fileSystemClass(std::string_view fileName);
+
+  /// Returns the model for the file system of 'fileName'.
+  std::shared_ptr<Model> model(std::string_view fileName);
+
+  void testingClear();
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Model>> models_;
+};
+
+} // namespace facebook::velox::io
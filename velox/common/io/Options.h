@@ -65,6 +65,7 @@ class ReaderOptions {
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  bool adaptiveCoalesce_{false};
 
  public:
   static constexpr int32_t kDefaultLoadQuantum = 8 << 20; // 8MB
@@ -85,6 +86,7 @@ class ReaderOptions {
     maxCoalesceBytes_ = other.maxCoalesceBytes_;
     prefetchRowGroups_ = other.prefetchRowGroups_;
     loadQuantum_ = other.loadQuantum_;
+    adaptiveCoalesce_ = other.adaptiveCoalesce_;
     return *this;
   }
 
@@ -146,6 +148,15 @@ class ReaderOptions {
     return *this;
   }
 
+  /**
+   * Derive the coalesce distance and the number of prefetches in flight from
+   * the latency and bandwidth measured for the file system.
+   */
+  ReaderOptions& setAdaptiveCoalesce(bool adaptive) {
+    adaptiveCoalesce_ = adaptive;
+    return *this;
+  }
+
   /**
    * Get the memory allocator.
    */
@@ -176,5 +187,9 @@ class ReaderOptions {
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
+
+  bool adaptiveCoalesce() const {
+    return adaptiveCoalesce_;
+  }
 };
 } // namespace facebook::velox::io
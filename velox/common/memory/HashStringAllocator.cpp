@@ -88,17 +88,21 @@ HashStringAllocator::~HashStringAllocator() {
 }
 
 void HashStringAllocator::clear() {
-  numFree_ = 0;
-  freeBytes_ = 0;
-  std::fill(std::begin(freeNonEmpty_), std::end(freeNonEmpty_), 0);
+  clearFreeLists();
   for (auto& pair : allocationsFromPool_) {
     pool()->free(pair.first, pair.second);
   }
   allocationsFromPool_.clear();
+  pool_.clear();
+}
+
+void HashStringAllocator::clearFreeLists() {
+  numFree_ = 0;
+  freeBytes_ = 0;
+  std::fill(std::begin(freeNonEmpty_), std::end(freeNonEmpty_), 0);
   for (auto i = 0; i < kNumFreeLists; ++i) {
     new (&free_[i]) CompactDoubleList();
   }
-  pool_.clear();
 }
 
 void* HashStringAllocator::allocateFromPool(size_t size) {
@@ -239,6 +243,17 @@ HashStringAllocator::finishWrite(
 }
 
 void HashStringAllocator::newSlab() {
+  int64_t available;
+  auto* run = allocateSlab(available);
+  cumulativeBytes_ += available;
+
+  // Add the new memory to the free list: Placement construct a header
+  // that covers the space from start to the end marker and add this
+  // to free list.
+  free(new (run) Header(available - sizeof(Header)));
+}
+
+char* HashStringAllocator::allocateSlab(int64_t& available) {
   constexpr int32_t kSimdPadding = simd::kPadding - sizeof(Header);
   const int64_t needed = pool_.allocatedBytes() >= pool_.hugePageThreshold()
       ? memory::AllocationTraits::kHugePageSize
@@ -250,18 +265,13 @@ void HashStringAllocator::newSlab() {
   // several huge pages for severl huge page sized arenas but
   // checkConsistency() can interpret that.
   VELOX_CHECK_EQ(0, pool_.freeBytes());
-  auto available = needed - sizeof(Header) - kSimdPadding;
+  available = needed - sizeof(Header) - kSimdPadding;
 
   VELOX_CHECK_NOT_NULL(run);
   VELOX_CHECK_GT(available, 0);
   // Write end  marker.
   *reinterpret_cast<uint32_t*>(run + available) = Header::kArenaEnd;
-  cumulativeBytes_ += available;
-
-  // Add the new memory to the free list: Placement construct a header
-  // that covers the space from start to the end marker and add this
-  // to free list.
-  free(new (run) Header(available - sizeof(Header)));
+  return run;
 }
 
 void HashStringAllocator::newRange(
@@ -655,6 +665,173 @@ std::string HashStringAllocator::toString() const {
   return out.str();
 }
 
+HashStringAllocator::Header* FOLLY_NULLABLE
+HashStringAllocator::BlockMap::newHeader(Header* FOLLY_NULLABLE header) const {
+  if (header == nullptr) {
+    return nullptr;
+  }
+  auto it = std::lower_bound(
+      moves_.begin(),
+      moves_.end(),
+      header,
+      [](const auto& move, const Header* header) {
+        return move.first < header;
+      });
+  if (it == moves_.end() || it->first != header) {
+    return header;
+  }
+  return it->second;
+}
+
+char* FOLLY_NULLABLE HashStringAllocator::BlockMap::newAddress(
+    const char* FOLLY_NULLABLE address) const {
+  if (address == nullptr) {
+    return nullptr;
+  }
+  auto* move = findMove(address);
+  if (move == nullptr) {
+    return const_cast<char*>(address);
+  }
+  return reinterpret_cast<char*>(move->second) +
+      (address - reinterpret_cast<const char*>(move->first));
+}
+
+HashStringAllocator::Position HashStringAllocator::BlockMap::newPosition(
+    Position position) const {
+  if (!position.isSet()) {
+    return position;
+  }
+  auto* header = newHeader(position.header);
+  return {header, header->begin() + position.offset()};
+}
+
+const std::pair<HashStringAllocator::Header*, HashStringAllocator::Header*>*
+HashStringAllocator::BlockMap::findMove(
+    const char* FOLLY_NONNULL address) const {
+  // The last block that starts at or below 'address'.
+  auto it = std::upper_bound(
+      moves_.begin(),
+      moves_.end(),
+      address,
+      [](const char* address, const auto& move) {
+        return address < reinterpret_cast<const char*>(move.first);
+      });
+  if (it == moves_.begin()) {
+    return nullptr;
+  }
+  --it;
+  if (address >= it->first->end()) {
+    return nullptr;
+  }
+  return &*it;
+}
+
+std::vector<HashStringAllocator::Header*>
+HashStringAllocator::allocatedBlocks() const {
+  static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
+
+  std::vector<Header*> blocks;
+  for (auto i = 0; i < pool_.numRanges(); ++i) {
+    auto topRange = pool_.rangeAt(i);
+    auto topRangeSize = topRange.size();
+    // Same layout of arenas in ranges as in checkConsistency().
+    for (int64_t subRangeStart = 0; subRangeStart < topRangeSize;
+         subRangeStart += kHugePageSize) {
+      auto range = folly::Range<char*>(
+          topRange.data() + subRangeStart,
+          std::min<int64_t>(topRangeSize, kHugePageSize));
+      auto end = reinterpret_cast<Header*>(
+          range.data() + range.size() - simd::kPadding);
+      for (auto header = reinterpret_cast<Header*>(range.data()); header != end;
+           header = reinterpret_cast<Header*>(header->end())) {
+        if (!header->isFree()) {
+          blocks.push_back(header);
+        }
+      }
+    }
+  }
+  return blocks;
+}
+
+int64_t HashStringAllocator::compact(const UpdatePointers& updatePointers) {
+  VELOX_CHECK_NULL(
+      currentHeader_, "Do not call compact() when a write is in progress");
+  const auto retainedBefore = retainedSize();
+  BlockMap blocks;
+  for (auto* header : allocatedBlocks()) {
+    blocks.moves_.emplace_back(header, nullptr);
+  }
+
+  // The old slabs stay readable until 'updatePointers' returns.
+  memory::AllocationPool oldSlabs(pool());
+  oldSlabs.swap(pool_);
+  pool_.setHugePageThreshold(oldSlabs.hugePageThreshold());
+  const auto cumulativeBytes = cumulativeBytes_;
+  clearFreeLists();
+
+  char* next = nullptr;
+  char* end = nullptr;
+  // Adds the space after the last block of a slab to the free list.
+  auto freeRestOfSlab = [&]() {
+    if (next != nullptr && next < end) {
+      free(new (next) Header(end - next - sizeof(Header)));
+    }
+  };
+  for (auto& [oldHeader, newHeader] : blocks.moves_) {
+    const int64_t size = oldHeader->size();
+    const int64_t needed = sizeof(Header) + size;
+    const int64_t remaining = end - next;
+    // The space after a block must either be empty or hold a free block.
+    if (next == nullptr ||
+        (remaining != needed &&
+         remaining < needed + sizeof(Header) + kMinAlloc)) {
+      if (size > kMaxAlloc) {
+        // A large block that does not fit the current slab is moved to a
+        // separate allocation like the ones made by allocate().
+        newHeader =
+            new (allocateFromPool(size + sizeof(Header))) Header(size);
+        if (oldHeader->isContinued()) {
+          newHeader->setContinued();
+        }
+        memcpy(newHeader->begin(), oldHeader->begin(), size);
+        continue;
+      }
+      freeRestOfSlab();
+      int64_t available;
+      next = allocateSlab(available);
+      end = next + available;
+    }
+    newHeader = new (next) Header(size);
+    if (oldHeader->isContinued()) {
+      newHeader->setContinued();
+    }
+    memcpy(newHeader->begin(), oldHeader->begin(), size);
+    next += needed;
+  }
+  freeRestOfSlab();
+  cumulativeBytes_ = cumulativeBytes;
+
+  std::sort(
+      blocks.moves_.begin(),
+      blocks.moves_.end(),
+      [](const auto& left, const auto& right) {
+        return left.first < right.first;
+      });
+  for (auto& [oldHeader, newHeader] : blocks.moves_) {
+    if (newHeader->isContinued()) {
+      auto** continued = reinterpret_cast<Header**>(
+          newHeader->end() - Header::kContinuedPtrSize);
+      *continued = blocks.newHeader(*continued);
+    }
+  }
+
+  if (updatePointers != nullptr) {
+    updatePointers(blocks);
+  }
+  oldSlabs.clear();
+  return retainedBefore - retainedSize();
+}
+
 int64_t HashStringAllocator::checkConsistency() const {
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
 
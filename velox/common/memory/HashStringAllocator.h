@@ -25,6 +25,8 @@
 
 #include <folly/container/F14Map.h>
 
+#include <functional>
+
 namespace facebook::velox {
 
 // Implements an arena backed by MappedMemory::Allocation. This is for backing
@@ -174,6 +176,44 @@ class HashStringAllocator : public StreamArena {
     }
   };
 
+  /// Maps the blocks moved by compact() from their old to their new
+  /// addresses. The old addresses are readable until compact() returns.
+  class BlockMap {
+   public:
+    /// Returns the new address of the block at 'header' or 'header' if the
+    /// block was not moved.
+    Header* FOLLY_NULLABLE newHeader(Header* FOLLY_NULLABLE header) const;
+
+    /// Returns the new address of 'address' if it points into the header or
+    /// payload of a moved block. Returns 'address' otherwise. Used for
+    /// StringViews and other pointers to payload.
+    char* FOLLY_NULLABLE newAddress(const char* FOLLY_NULLABLE address) const;
+
+    /// Returns 'position' in the new copy of its block. A position may point
+    /// to the end of its block, so the block is found from 'header'.
+    Position newPosition(Position position) const;
+
+    /// Number of moved blocks.
+    size_t size() const {
+      return moves_.size();
+    }
+
+   private:
+    friend class HashStringAllocator;
+
+    // Returns the move of the block that contains 'address' or nullptr.
+    const std::pair<Header*, Header*>* FOLLY_NULLABLE findMove(
+        const char* FOLLY_NONNULL address) const;
+
+    // Pairs of old and new block addresses, sorted on the old address.
+    std::vector<std::pair<Header*, Header*>> moves_;
+  };
+
+  /// Called by compact() after the blocks are copied and before the old
+  /// slabs are freed. Must replace all pointers to the moved blocks that are
+  /// held outside of 'this'.
+  using UpdatePointers = std::function<void(const BlockMap& blocks)>;
+
   explicit HashStringAllocator(memory::MemoryPool* FOLLY_NONNULL pool)
       : StreamArena(pool), pool_(pool) {}
 
@@ -328,6 +368,24 @@ class HashStringAllocator : public StreamArena {
   // Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear();
 
+  /// Returns the share of the bytes of the slabs of 'this' that is in free
+  /// blocks. A high ratio means that the free space is fragmented between
+  /// live blocks and compact() would return memory to the pool.
+  double freeRatio() const {
+    const auto slabBytes = pool_.allocatedBytes();
+    return slabBytes == 0 ? 0 : static_cast<double>(freeBytes_) / slabBytes;
+  }
+
+  /// Moves all allocated blocks in slabs to new slabs where they are
+  /// adjacent and frees the old slabs. Blocks allocated with
+  /// allocateFromPool() and blocks larger than kMaxAlloc that come directly
+  /// from 'pool()' are not moved. The continue pointers of multipart
+  /// allocations are updated here. 'updatePointers' must update all other
+  /// pointers to the moved blocks, e.g. StringViews in a RowContainer and
+  /// Positions in accumulators. Must not be called while a write is in
+  /// progress. Returns the number of bytes returned to the pool.
+  int64_t compact(const UpdatePointers& updatePointers);
+
   memory::MemoryPool* FOLLY_NONNULL pool() const {
     return pool_.pool();
   }
@@ -369,6 +427,18 @@ class HashStringAllocator : public StreamArena {
   // anything yet. Throws if fails to grow.
   void newSlab();
 
+  // Allocates a standard size slab from 'pool_' and writes the end marker.
+  // Sets 'available' to the number of bytes before the marker. Returns the
+  // start of the slab.
+  char* FOLLY_NONNULL allocateSlab(int64_t& available);
+
+  // Resets the free lists to empty.
+  void clearFreeLists();
+
+  // Returns the blocks in slabs that are not free, in the order of slabs and
+  // addresses.
+  std::vector<Header*> allocatedBlocks() const;
+
   void removeFromFreeList(Header* FOLLY_NONNULL header);
 
   /// Allocates a block of specified size. If exactSize is false, the block may
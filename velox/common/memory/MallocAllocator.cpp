@@ -19,7 +19,47 @@
 
 #include <sys/mman.h>
 
+#ifdef VELOX_ENABLE_JEMALLOC_ARENAS
+#include <jemalloc/jemalloc.h>
+#endif
+
 namespace facebook::velox::memory {
+namespace {
+// Allocates 'bytes' from the arena of ScopedMemoryArena if set.
+void* mallocBytes(uint64_t bytes, uint16_t alignment, bool zeroFilled) {
+#ifdef VELOX_ENABLE_JEMALLOC_ARENAS
+  const auto arena = ScopedMemoryArena::current();
+  if (arena != MemoryAllocator::kNoArena) {
+    // The arena allocations bypass the thread caches so that no cached memory
+    // is left behind when the arena is destroyed.
+    int flags = MALLOCX_ARENA(arena) | MALLOCX_TCACHE_NONE;
+    if (alignment > MemoryAllocator::kMinAlignment) {
+      flags |= MALLOCX_ALIGN(alignment);
+    }
+    if (zeroFilled) {
+      flags |= MALLOCX_ZERO;
+    }
+    return ::mallocx(std::max<uint64_t>(bytes, 1), flags);
+  }
+#endif
+  if (zeroFilled) {
+    return std::calloc(1, bytes);
+  }
+  return (alignment > MemoryAllocator::kMinAlignment)
+      ? ::aligned_alloc(alignment, bytes)
+      : ::malloc(bytes);
+}
+
+void freeMallocBytes(void* p) {
+#ifdef VELOX_ENABLE_JEMALLOC_ARENAS
+  if (ScopedMemoryArena::current() != MemoryAllocator::kNoArena) {
+    ::dallocx(p, MALLOCX_TCACHE_NONE);
+    return;
+  }
+#endif
+  ::free(p); // NOLINT
+}
+} // namespace
 MallocAllocator::MallocAllocator(size_t capacity, uint32_t reservationByteLimit)
     : kind_(MemoryAllocator::Kind::kMalloc),
       capacity_(capacity),
@@ -107,8 +147,10 @@ bool MallocAllocator::allocateNonContiguousWithoutRetry(
           AllocationTraits::pageBytes(sizeClassSizes_[mix.sizeIndices[i]]),
           mix.sizeCounts[i],
           [&]() {
-            ptr = ::malloc(
-                AllocationTraits::pageBytes(numSizeClassPages)); // NOLINT
+            ptr = mallocBytes(
+                AllocationTraits::pageBytes(numSizeClassPages),
+                kMinAlignment,
+                false);
           });
     }
     if (ptr == nullptr) {
@@ -130,7 +172,7 @@ bool MallocAllocator::allocateNonContiguousWithoutRetry(
     // Failed to allocate memory using malloc. Free any malloced pages and
     // return false.
     for (auto* buffer : buffers) {
-      ::free(buffer);
+      freeMallocBytes(buffer);
     }
     out.clear();
     if (reservationCB != nullptr) {
@@ -155,11 +197,12 @@ bool MallocAllocator::allocateContiguousWithoutRetry(
     Allocation* collateral,
     ContiguousAllocation& allocation,
     ReservationCallback reservationCB,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    HugePagePolicy hugePages) {
   bool result;
   stats_.recordAllocate(AllocationTraits::pageBytes(numPages), 1, [&]() {
     result = allocateContiguousImpl(
-        numPages, collateral, allocation, reservationCB, maxPages);
+        numPages, collateral, allocation, reservationCB, maxPages, hugePages);
   });
   return result;
 }
@@ -169,7 +212,8 @@ bool MallocAllocator::allocateContiguousImpl(
     Allocation* collateral,
     ContiguousAllocation& allocation,
     ReservationCallback reservationCB,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    HugePagePolicy hugePages) {
   if (maxPages == 0) {
     maxPages = numPages;
   } else {
@@ -237,19 +281,14 @@ bool MallocAllocator::allocateContiguousImpl(
   }
   numAllocated_.fetch_add(numPages);
   numMapped_.fetch_add(numPages);
-  void* data = ::mmap(
-      nullptr,
-      AllocationTraits::pageBytes(maxPages),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
-  // TODO: add handling of MAP_FAILED.
+  void* data =
+      mapContiguous(AllocationTraits::pageBytes(maxPages), hugePages);
+  // TODO: add handling of mmap failure.
   allocation.set(
       data,
       AllocationTraits::pageBytes(numPages),
       AllocationTraits::pageBytes(maxPages));
-  useHugePages(allocation, true);
+  useHugePages(allocation, true, hugePages);
   return true;
 }
 
@@ -264,7 +303,7 @@ int64_t MallocAllocator::freeNonContiguous(Allocation& allocation) {
     const int64_t numPages = run.numPages();
     freedPages += numPages;
     stats_.recordFree(AllocationTraits::pageBytes(numPages), [&]() {
-      ::free(ptr); // NOLINT
+      freeMallocBytes(ptr);
     });
   }
 
@@ -352,8 +391,7 @@ void* MallocAllocator::allocateBytesWithoutRetry(
         bytes,
         alignment);
   }
-  void* result = (alignment > kMinAlignment) ? ::aligned_alloc(alignment, bytes)
-                                             : ::malloc(bytes);
+  void* result = mallocBytes(bytes, alignment, false);
   if (FOLLY_UNLIKELY(result == nullptr)) {
     VELOX_MEM_LOG(ERROR) << "Failed to allocateBytes " << succinctBytes(bytes)
                          << " with " << alignment << " alignment";
@@ -372,7 +410,7 @@ void* MallocAllocator::allocateZeroFilledWithoutRetry(uint64_t bytes) {
     setAllocatorFailureMessage(errorMsg);
     return nullptr;
   }
-  void* result = std::calloc(1, bytes);
+  void* result = mallocBytes(bytes, kMinAlignment, true);
   if (FOLLY_UNLIKELY(result == nullptr)) {
     VELOX_MEM_LOG(ERROR) << "Failed to allocateZeroFilled "
                          << succinctBytes(bytes);
@@ -381,10 +419,36 @@ void* MallocAllocator::allocateZeroFilledWithoutRetry(uint64_t bytes) {
 }
 
 void MallocAllocator::freeBytes(void* p, uint64_t bytes) noexcept {
-  ::free(p); // NOLINT
+  freeMallocBytes(p);
   decrementUsage(bytes);
 }
 
+int32_t MallocAllocator::createArena() {
+#ifdef VELOX_ENABLE_JEMALLOC_ARENAS
+  unsigned arena;
+  size_t size = sizeof(arena);
+  if (::mallctl("arenas.create", &arena, &size, nullptr, 0) != 0) {
+    VELOX_MEM_LOG(WARNING) << "Failed to create jemalloc arena";
+    return kNoArena;
+  }
+  return arena;
+#else
+  return kNoArena;
+#endif
+}
+
+void MallocAllocator::destroyArena(int32_t arena) {
+  if (arena == kNoArena) {
+    return;
+  }
+#ifdef VELOX_ENABLE_JEMALLOC_ARENAS
+  const auto command = fmt::format("arena.{}.destroy", arena);
+  if (::mallctl(command.c_str(), nullptr, nullptr, nullptr, 0) != 0) {
+    VELOX_MEM_LOG(WARNING) << "Failed to destroy jemalloc arena " << arena;
+  }
+#endif
+}
+
 bool MallocAllocator::checkConsistency() const {
   const auto allocatedBytes = allocatedBytes_.load();
   return allocatedBytes >= 0 && allocatedBytes <= capacity_;
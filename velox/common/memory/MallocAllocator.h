@@ -80,6 +80,10 @@ class MallocAllocator : public MemoryAllocator {
 
   bool checkConsistency() const override;
 
+  int32_t createArena() override;
+
+  void destroyArena(int32_t arena) override;
+
   std::string toString() const override;
 
  private:
@@ -94,14 +98,16 @@ class MallocAllocator : public MemoryAllocator {
       Allocation* collateral,
       ContiguousAllocation& allocation,
       ReservationCallback reservationCB = nullptr,
-      MachinePageCount maxPages = 0) override;
+      MachinePageCount maxPages = 0,
+      HugePagePolicy hugePages = HugePagePolicy::kDefault) override;
 
   bool allocateContiguousImpl(
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
       ReservationCallback reservationCB,
-      MachinePageCount maxPages);
+      MachinePageCount maxPages,
+      HugePagePolicy hugePages);
 
   void freeContiguousImpl(ContiguousAllocation& allocation);
 
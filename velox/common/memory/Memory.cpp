@@ -42,6 +42,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.capacity = options.allocatorCapacity;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numaNodes = options.mmapNumaNodes;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -61,6 +62,11 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
        .memoryPoolTransferCapacity = options.memoryPoolTransferCapacity,
        .memoryReclaimWaitMs = options.memoryReclaimWaitMs,
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
+       .reclaimCostModel = options.arbitratorReclaimCostModel,
+       .fastExponentialGrowthCapacityLimit =
+           options.fastExponentialGrowthCapacityLimit,
+       .slowCapacityGrowPct = options.slowCapacityGrowPct,
+       .fastGrowFromFreeCapacity = options.fastGrowFromFreeCapacity,
        .checkUsageLeak = options.checkUsageLeak});
 }
 } // namespace
@@ -73,6 +79,8 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      reservationCacheEnabled_(options.reservationCacheEnabled),
+      mallocArenaPerRootPool_(options.mallocArenaPerRootPool),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -93,7 +101,8 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .trackUsage = options.trackDefaultUsage,
               .debugEnabled = options.debugEnabled,
               .coreOnAllocationFailureEnabled =
-                  options.coreOnAllocationFailureEnabled})},
+                  options.coreOnAllocationFailureEnabled,
+              .reservationCacheEnabled = options.reservationCacheEnabled})},
       spillPool_{addLeafPool("__sys_spilling__")} {
   VELOX_CHECK_NOT_NULL(allocator_);
   VELOX_CHECK_NOT_NULL(arbitrator_);
@@ -189,6 +198,8 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.reservationCacheEnabled = reservationCacheEnabled_;
+  options.mallocArenaEnabled = mallocArenaPerRootPool_;
 
   std::unique_lock guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
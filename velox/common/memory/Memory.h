@@ -81,6 +81,22 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// If true, the thread-safe leaf memory pools serve small allocations from
+  /// reservation caches shared by groups of threads instead of updating the
+  /// pool under its mutex for each allocation. See
+  /// MemoryPool::Options::reservationCacheEnabled.
+  bool reservationCacheEnabled{false};
+
+  /// If true, each root memory pool created by addRootPool() allocates from
+  /// a dedicated malloc arena which is destroyed with the pool. This returns
+  /// the memory of a finished query to the operating system instead of
+  /// leaving it to fragment the shared arenas, and avoids contention between
+  /// queries.
+  ///
+  /// NOTE: this only applies for MallocAllocator built with
+  /// VELOX_ENABLE_JEMALLOC_ARENAS.
+  bool mallocArenaPerRootPool{false};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -105,6 +121,12 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// Number of NUMA nodes with their own size classes. 0 means one per NUMA
+  /// node of the machine. See MmapAllocator::Options::numaNodes.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  int32_t mmapNumaNodes{1};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -170,6 +192,24 @@ struct MemoryManagerOptions {
   /// potential deadlock when reclaim memory from the task of the request memory
   /// pool.
   MemoryArbitrationStateCheckCB arbitrationStateCheckCb{nullptr};
+
+  /// Used by the memory arbitrator to choose the memory pools to reclaim used
+  /// memory from if not null. See MemoryArbitrator::Config::reclaimCostModel.
+  std::shared_ptr<MemoryReclaimCostModel> arbitratorReclaimCostModel{nullptr};
+
+  /// The memory pool capacity below which the arbitrator doubles the capacity
+  /// of a growing pool ahead of its demand. See
+  /// MemoryArbitrator::Config::fastExponentialGrowthCapacityLimit.
+  uint64_t fastExponentialGrowthCapacityLimit{0};
+
+  /// The fraction of its capacity the arbitrator grows a large memory pool by
+  /// ahead of its demand. See MemoryArbitrator::Config::slowCapacityGrowPct.
+  double slowCapacityGrowPct{0};
+
+  /// If true, grows memory pools from the free capacity of the arbitrator
+  /// without queuing for the memory arbitration when possible. See
+  /// MemoryArbitrator::Config::fastGrowFromFreeCapacity.
+  bool fastGrowFromFreeCapacity{false};
 };
 
 /// 'MemoryManager' is responsible for creating allocator, arbitrator and
@@ -293,6 +333,8 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const bool reservationCacheEnabled_;
+  const bool mallocArenaPerRootPool_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
@@ -190,10 +190,11 @@ bool MemoryAllocator::allocateContiguous(
     Allocation* collateral,
     ContiguousAllocation& allocation,
     ReservationCallback reservationCB,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    HugePagePolicy hugePages) {
   if (cache() == nullptr) {
     return allocateContiguousWithoutRetry(
-        numPages, collateral, allocation, reservationCB, maxPages);
+        numPages, collateral, allocation, reservationCB, maxPages, hugePages);
   }
   auto numCollateralPages =
       allocation.numPages() + (collateral ? collateral->numPages() : 0);
@@ -201,7 +202,12 @@ bool MemoryAllocator::allocateContiguous(
       pagesToAcquire(numPages, numCollateralPages), [&](Allocation& acquired) {
         freeNonContiguous(acquired);
         return allocateContiguousWithoutRetry(
-            numPages, collateral, allocation, reservationCB, maxPages);
+            numPages,
+            collateral,
+            allocation,
+            reservationCB,
+            maxPages,
+            hugePages);
       });
   if (!success) {
     // There can be a failure where allocation was never called because there
@@ -317,9 +323,11 @@ std::string Stats::toString() const {
 
 void MemoryAllocator::useHugePages(
     const ContiguousAllocation& data,
-    bool enable) {
+    bool enable,
+    HugePagePolicy hugePages) {
 #ifdef linux
-  if (!FLAGS_velox_memory_use_hugepages) {
+  if (!FLAGS_velox_memory_use_hugepages &&
+      hugePages != HugePagePolicy::kAlways) {
     return;
   }
   auto maybeRange = data.hugePageRange();
@@ -337,6 +345,44 @@ void MemoryAllocator::useHugePages(
 #endif
 }
 
+// static
+void* MemoryAllocator::mapContiguous(uint64_t bytes, HugePagePolicy hugePages) {
+  if (hugePages != HugePagePolicy::kAlways ||
+      bytes < AllocationTraits::kHugePageSize) {
+    void* data = ::mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    return data == MAP_FAILED ? nullptr : data;
+  }
+  // Maps an extra huge page and unmaps the unaligned head and tail.
+  const auto mappedBytes = bytes + AllocationTraits::kHugePageSize;
+  void* mapped = ::mmap(
+      nullptr,
+      mappedBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (mapped == MAP_FAILED) {
+    return nullptr;
+  }
+  auto* begin = reinterpret_cast<char*>(mapped);
+  auto* aligned = reinterpret_cast<char*>(bits::roundUp(
+      reinterpret_cast<uintptr_t>(begin), AllocationTraits::kHugePageSize));
+  if (aligned > begin) {
+    ::munmap(begin, aligned - begin);
+  }
+  const auto tailBytes = (begin + mappedBytes) - (aligned + bytes);
+  if (tailBytes > 0) {
+    ::munmap(aligned + bytes, tailBytes);
+  }
+  return aligned;
+}
+
 void MemoryAllocator::setAllocatorFailureMessage(std::string message) {
   allocatorFailureMessage() = std::move(message);
 }
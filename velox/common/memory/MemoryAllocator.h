@@ -141,6 +141,17 @@ struct Stats {
 
 class MemoryAllocator;
 
+/// Huge page policy of a contiguous allocation.
+enum class HugePagePolicy {
+  /// Advises huge pages for the huge pages contained in the allocation if
+  /// FLAGS_velox_memory_use_hugepages is set.
+  kDefault,
+  /// Aligns the allocation to a huge page and advises huge pages for all of it
+  /// regardless of FLAGS_velox_memory_use_hugepages. For large structures with
+  /// random access, like hash tables.
+  kAlways,
+};
+
 /// A general cache interface using 'MemroyAllocator' to allocate memory, that
 /// is also able to free up memory upon request by shrinking itself.
 class Cache {
@@ -276,13 +287,15 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   /// 'numPages'. This allows reserving a large range of addresses for use with
   /// huge pages without declaring the whole range as held by the query. The
   /// reservation will be increased as and if addresses in the range are used.
-  /// See growContiguous().
+  /// See growContiguous(). 'hugePages' specifies whether the new allocation is
+  /// backed by huge pages.
   bool allocateContiguous(
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
       ReservationCallback reservationCB = nullptr,
-      MachinePageCount maxPages = 0);
+      MachinePageCount maxPages = 0,
+      HugePagePolicy hugePages = HugePagePolicy::kDefault);
 
   /// Frees contiguous 'allocation'. 'allocation' is empty on return.
   virtual void freeContiguous(ContiguousAllocation& allocation) = 0;
@@ -322,6 +335,22 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   /// the number of actual unmapped physical pages.
   virtual MachinePageCount unmap(MachinePageCount targetPages) = 0;
 
+  /// Identifies the shared malloc arena used outside of a ScopedMemoryArena.
+  static constexpr int32_t kNoArena = -1;
+
+  /// Creates a dedicated malloc arena. The allocations and frees made while a
+  /// ScopedMemoryArena for the arena is active use that arena. Returns
+  /// kNoArena if dedicated arenas are not supported. This is only supported
+  /// by MallocAllocator when built with VELOX_ENABLE_JEMALLOC_ARENAS.
+  virtual int32_t createArena() {
+    return kNoArena;
+  }
+
+  /// Destroys 'arena' created by createArena() and returns its memory to the
+  /// operating system. All the memory allocated from 'arena' must have been
+  /// freed.
+  virtual void destroyArena(int32_t /*arena*/) {}
+
   /// Checks internal consistency of allocation data structures. Returns true if
   /// OK.
   virtual bool checkConsistency() const = 0;
@@ -411,7 +440,8 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
       Allocation* collateral,
       ContiguousAllocation& allocation,
       ReservationCallback reservationCB = nullptr,
-      MachinePageCount maxPages = 0) = 0;
+      MachinePageCount maxPages = 0,
+      HugePagePolicy hugePages = HugePagePolicy::kDefault) = 0;
 
   virtual bool allocateNonContiguousWithoutRetry(
       MachinePageCount numPages,
@@ -477,8 +507,16 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   }
 
   // If 'data' is sufficiently large, enables/disables adaptive  huge pages
-  // for the address range.
-  void useHugePages(const ContiguousAllocation& data, bool enable);
+  // for the address range. With HugePagePolicy::kAlways this is done
+  // regardless of FLAGS_velox_memory_use_hugepages.
+  void useHugePages(
+      const ContiguousAllocation& data,
+      bool enable,
+      HugePagePolicy hugePages = HugePagePolicy::kDefault);
+
+  // Makes an anonymous mmap of 'bytes'. The mapping starts at a huge page
+  // boundary if 'hugePages' is kAlways. Returns nullptr on failure.
+  static void* mapContiguous(uint64_t bytes, HugePagePolicy hugePages);
 
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
@@ -507,6 +545,29 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   Stats stats_;
 };
 
+/// Directs the malloc allocations and frees of the calling thread to 'arena'
+/// for the lifetime of 'this'. See MemoryAllocator::createArena().
+class ScopedMemoryArena {
+ public:
+  explicit ScopedMemoryArena(int32_t arena) : savedArena_(arena_) {
+    arena_ = arena;
+  }
+
+  ~ScopedMemoryArena() {
+    arena_ = savedArena_;
+  }
+
+  /// Returns the arena for the calling thread.
+  static int32_t current() {
+    return arena_;
+  }
+
+ private:
+  static inline thread_local int32_t arena_{MemoryAllocator::kNoArena};
+
+  const int32_t savedArena_;
+};
+
 std::ostream& operator<<(std::ostream& out, const MemoryAllocator::Kind& kind);
 } // namespace facebook::velox::memory
 template <>
@@ -16,6 +16,8 @@
 
 #include "velox/common/memory/MemoryArbitrator.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "velox/common/base/Counters.h"
@@ -198,6 +200,38 @@ bool MemoryReclaimer::reclaimableBytes(
   return reclaimable;
 }
 
+MemoryReclaimer::ReclaimCostInfo MemoryReclaimer::reclaimCostInfo(
+    const MemoryPool& pool) const {
+  ReclaimCostInfo info;
+  if (pool.kind() == MemoryPool::Kind::kLeaf) {
+    return info;
+  }
+  int32_t numChildren{0};
+  pool.visitChildren([&](MemoryPool* child) {
+    if (child->reclaimer() == nullptr) {
+      return true;
+    }
+    const auto childInfo = child->reclaimer()->reclaimCostInfo(*child);
+    info.runningTimeMs = std::max(info.runningTimeMs, childInfo.runningTimeMs);
+    info.progress += childInfo.progress;
+    info.priority = std::max(info.priority, childInfo.priority);
+    ++numChildren;
+    return true;
+  });
+  if (numChildren > 0) {
+    info.progress /= numChildren;
+  }
+  return info;
+}
+
+std::string MemoryReclaimer::ReclaimCostInfo::toString() const {
+  return fmt::format(
+      "runningTime {}ms progress {:.2f} priority {}",
+      runningTimeMs,
+      progress,
+      priority);
+}
+
 uint64_t MemoryReclaimer::reclaim(
     MemoryPool* pool,
     uint64_t targetBytes,
@@ -457,4 +491,50 @@ MemoryArbitrationContext* memoryArbitrationContext() {
 bool underMemoryArbitration() {
   return memoryArbitrationContext() != nullptr;
 }
+
+DefaultMemoryReclaimCostModel::DefaultMemoryReclaimCostModel(
+    const Options& options)
+    : options_(options) {
+  VELOX_CHECK_GT(options_.spillBytesPerSec, 0);
+}
+
+double DefaultMemoryReclaimCostModel::reclaimCost(
+    const MemoryPool& /*unused*/,
+    uint64_t reclaimableBytes,
+    uint64_t targetBytes,
+    const MemoryReclaimer::ReclaimCostInfo& info) const {
+  const uint64_t reclaimBytes = std::min(reclaimableBytes, targetBytes);
+  if (reclaimBytes == 0) {
+    return std::numeric_limits<double>::max();
+  }
+  const double spillSecs =
+      static_cast<double>(reclaimBytes) / options_.spillBytesPerSec;
+  const double disruptionSecs =
+      options_.runningTimeWeight * info.runningTimeMs / 1'000 +
+      options_.progressWeight * std::clamp(info.progress, 0.0, 1.0) +
+      options_.priorityWeight * std::max(info.priority, 0);
+  return (spillSecs + disruptionSecs) / reclaimBytes;
+}
+
+// static
+PrefetchThrottle& PrefetchThrottle::instance() {
+  static PrefetchThrottle throttle;
+  return throttle;
+}
+
+void PrefetchThrottle::update(uint64_t freeCapacity, uint64_t capacity) {
+  if (capacity == 0) {
+    return;
+  }
+  const double freePct = 100.0 * freeCapacity / capacity;
+  if (freePct >= kUnthrottledFreePct) {
+    prefetchPct_ = 100;
+  } else if (freePct <= kNoPrefetchFreePct) {
+    prefetchPct_ = 0;
+  } else {
+    prefetchPct_ = static_cast<int32_t>(
+        100 * (freePct - kNoPrefetchFreePct) /
+        (kUnthrottledFreePct - kNoPrefetchFreePct));
+  }
+}
 } // namespace facebook::velox::memory
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "velox/common/base/Exceptions.h"
@@ -26,6 +27,7 @@
 namespace facebook::velox::memory {
 
 class MemoryPool;
+class MemoryReclaimCostModel;
 
 using MemoryArbitrationStateCheckCB = std::function<void(MemoryPool&)>;
 
@@ -75,6 +77,32 @@ class MemoryArbitrator {
     /// memory pool.
     MemoryArbitrationStateCheckCB arbitrationStateCheckCb{nullptr};
 
+    /// Used by the arbitrator to choose the memory pools to reclaim used
+    /// memory from if not null. Otherwise, the arbitrator reclaims from the
+    /// memory pools with the most reclaimable memory first.
+    std::shared_ptr<MemoryReclaimCostModel> reclaimCostModel{nullptr};
+
+    /// The arbitrator grows a memory pool ahead of its demand from the free
+    /// capacity, assuming that a pool keeps growing at the rate it has grown
+    /// so far. A memory pool with capacity below this limit grows by its
+    /// current capacity, i.e. doubles. A memory pool at or above this limit
+    /// grows by 'slowCapacityGrowPct' of its current capacity. The grow ahead
+    /// never reclaims memory from other pools. Zero disables the doubling.
+    uint64_t fastExponentialGrowthCapacityLimit{0};
+
+    /// The fraction of its current capacity to grow a memory pool by ahead of
+    /// its demand once its capacity reaches
+    /// 'fastExponentialGrowthCapacityLimit'. Zero disables the grow ahead of
+    /// large pools.
+    double slowCapacityGrowPct{0};
+
+    /// If true, a memory pool grows from the free capacity of the arbitrator
+    /// without going through the serialized memory arbitration if no
+    /// arbitration is running and the free capacity covers the growth.
+    /// 'arbitrationStateCheckCb' is not invoked for such growth as it never
+    /// blocks.
+    bool fastGrowFromFreeCapacity{false};
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -234,12 +262,14 @@ class MemoryArbitrator {
         memoryPoolTransferCapacity_(config.memoryPoolTransferCapacity),
         memoryReclaimWaitMs_(config.memoryReclaimWaitMs),
         arbitrationStateCheckCb_(config.arbitrationStateCheckCb),
+        reclaimCostModel_(config.reclaimCostModel),
         checkUsageLeak_(config.checkUsageLeak) {}
 
   const uint64_t capacity_;
   const uint64_t memoryPoolTransferCapacity_;
   const uint64_t memoryReclaimWaitMs_;
   const MemoryArbitrationStateCheckCB arbitrationStateCheckCb_;
+  const std::shared_ptr<MemoryReclaimCostModel> reclaimCostModel_;
   const bool checkUsageLeak_;
 };
 
@@ -295,6 +325,22 @@ class MemoryReclaimer {
     bool operator!=(const Stats& other) const;
   };
 
+  /// Describes the owner of a memory pool, e.g. a query or a task, to the
+  /// memory arbitrator for weighing the cost of reclaiming memory from it.
+  struct ReclaimCostInfo {
+    /// The time since the owner started running in milliseconds.
+    uint64_t runningTimeMs{0};
+
+    /// The fraction of the work of the owner that is done, in [0, 1].
+    double progress{0};
+
+    /// The priority of the owner. The arbitrator prefers to reclaim from the
+    /// owners with lower priority.
+    int32_t priority{0};
+
+    std::string toString() const;
+  };
+
   virtual ~MemoryReclaimer() = default;
 
   static std::unique_ptr<MemoryReclaimer> create();
@@ -326,6 +372,11 @@ class MemoryReclaimer {
       const MemoryPool& pool,
       uint64_t& reclaimableBytes) const;
 
+  /// Invoked by the memory arbitrator to get the reclaim cost info of 'pool'.
+  /// The default implementation takes the max running time, the average
+  /// progress and the max priority of the child pools with reclaimers.
+  virtual ReclaimCostInfo reclaimCostInfo(const MemoryPool& pool) const;
+
   /// Invoked by the memory arbitrator to reclaim from memory 'pool' with
   /// specified 'targetBytes'. It is expected to reclaim at least that amount of
   /// memory bytes but there is no guarantees. If 'targetBytes' is zero, then it
@@ -355,6 +406,98 @@ class MemoryReclaimer {
   MemoryReclaimer() = default;
 };
 
+/// Estimates the cost of reclaiming used memory from a root memory pool. The
+/// SharedArbitrator reclaims from the memory pools with the least cost first.
+class MemoryReclaimCostModel {
+ public:
+  virtual ~MemoryReclaimCostModel() = default;
+
+  /// Returns the cost per reclaimed byte of reclaiming up to 'targetBytes' from
+  /// 'pool' which has 'reclaimableBytes' of reclaimable memory. 'info'
+  /// describes the owner of 'pool'.
+  virtual double reclaimCost(
+      const MemoryPool& pool,
+      uint64_t reclaimableBytes,
+      uint64_t targetBytes,
+      const MemoryReclaimer::ReclaimCostInfo& info) const = 0;
+};
+
+/// Weighs the time to spill the reclaimed bytes to disk against the disruption
+/// of the owner of the memory pool, which grows with its running time, progress
+/// and priority. The disruption is spread over the reclaimed bytes so that the
+/// model prefers pools which can give more of the target at once.
+class DefaultMemoryReclaimCostModel : public MemoryReclaimCostModel {
+ public:
+  struct Options {
+    /// The disk write throughput for spilling in bytes per second.
+    uint64_t spillBytesPerSec{200 << 20};
+
+    /// The cost in seconds of disrupting an owner per second of its running
+    /// time.
+    double runningTimeWeight{0.01};
+
+    /// The cost in seconds of disrupting an owner which is done.
+    double progressWeight{10};
+
+    /// The cost in seconds of disrupting an owner per priority level.
+    double priorityWeight{10};
+  };
+
+  DefaultMemoryReclaimCostModel() : DefaultMemoryReclaimCostModel(Options{}) {}
+
+  explicit DefaultMemoryReclaimCostModel(const Options& options);
+
+  double reclaimCost(
+      const MemoryPool& pool,
+      uint64_t reclaimableBytes,
+      uint64_t targetBytes,
+      const MemoryReclaimer::ReclaimCostInfo& info) const override;
+
+ private:
+  const Options options_;
+};
+
+/// Process-wide budget for read-ahead and split preloading. The memory
+/// arbitrator updates it whenever its free capacity changes. Prefetchers scale
+/// their depth by prefetchPct(), so that they do not take memory that running
+/// queries would otherwise get by evicting cache or spilling.
+class PrefetchThrottle {
+ public:
+  /// Free capacity, as a percentage of the arbitrator capacity, at or above
+  /// which prefetch is not throttled.
+  static constexpr int32_t kUnthrottledFreePct = 20;
+
+  /// Free capacity, as a percentage of the arbitrator capacity, at or below
+  /// which there is no prefetch.
+  static constexpr int32_t kNoPrefetchFreePct = 5;
+
+  static PrefetchThrottle& instance();
+
+  /// Returns the percentage of the configured prefetch depth to issue, from 0
+  /// to 100.
+  int32_t prefetchPct() const {
+    return prefetchPct_;
+  }
+
+  /// Returns 'depth' scaled by prefetchPct().
+  int64_t scale(int64_t depth) const {
+    return depth * prefetchPct_ / 100;
+  }
+
+  /// Sets the budget from the 'freeCapacity' of an arbitrator with
+  /// 'capacity'. The budget shrinks linearly from kUnthrottledFreePct down to
+  /// kNoPrefetchFreePct of free capacity.
+  void update(uint64_t freeCapacity, uint64_t capacity);
+
+  /// Lifts the throttling, e.g. when the arbitrator goes away.
+  void reset() {
+    prefetchPct_ = 100;
+  }
+
+ private:
+  std::atomic<int32_t> prefetchPct_{100};
+};
+
 /// The memory arbitration context which is set on per-thread local variable by
 /// memory arbitrator. It is used to indicate a running thread is under memory
 /// arbitration processing or not. This helps to enable sanity check such as all
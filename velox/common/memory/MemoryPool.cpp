@@ -219,7 +219,8 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      reservationCacheEnabled_(options.reservationCacheEnabled) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -388,6 +389,11 @@ MemoryPoolImpl::MemoryPoolImpl(
     : MemoryPool{name, kind, parent, options},
       manager_{memoryManager},
       allocator_{manager_->allocator()},
+      arena_(
+          parent_ != nullptr
+              ? toImpl(parent_)->arena_
+              : (options.mallocArenaEnabled ? allocator_->createArena()
+                                            : MemoryAllocator::kNoArena)),
       growCapacityCb_(std::move(growCapacityCb)),
       destructionCb_(std::move(destructionCb)),
       debugPoolNameRegex_(debugEnabled_ ? *(debugPoolNameRegex().rlock()) : ""),
@@ -408,10 +414,17 @@ MemoryPoolImpl::MemoryPoolImpl(
       isRoot() || (destructionCb_ == nullptr && growCapacityCb_ == nullptr),
       "Only root memory pool allows to set destruction and capacity grow callbacks: {}",
       name_);
+  if (reservationCacheEnabled_ && isLeaf() && trackUsage_ && threadSafe_) {
+    reservationCaches_ =
+        std::make_unique<ReservationCache[]>(kNumReservationCaches);
+  }
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
   DEBUG_LEAK_CHECK();
+  if (reservationCaches_ != nullptr) {
+    flushReservationCaches();
+  }
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
   }
@@ -435,6 +448,16 @@ MemoryPoolImpl::~MemoryPoolImpl() {
       "Bad memory usage track state: {}",
       toString());
 
+  if (arena_ != MemoryAllocator::kNoArena && isRoot()) {
+    // A leaked allocation keeps the arena alive.
+    if (reservationBytes_ == 0) {
+      allocator_->destroyArena(arena_);
+    } else {
+      LOG(ERROR) << "Memory arena " << arena_ << " is not destroyed on "
+                 << "memory leak: " << toString();
+    }
+  }
+
   if (destructionCb_ != nullptr) {
     destructionCb_(this);
   }
@@ -461,6 +484,7 @@ MemoryPool::Stats MemoryPoolImpl::statsLocked() const {
 
 void* MemoryPoolImpl::allocate(int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
+  ScopedMemoryArena arena(arena_);
   const auto alignedSize = sizeAlign(size);
   reserve(alignedSize);
   void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
@@ -479,6 +503,7 @@ void* MemoryPoolImpl::allocate(int64_t size) {
 
 void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
+  ScopedMemoryArena arena(arena_);
   const auto size = sizeEach * numEntries;
   const auto alignedSize = sizeAlign(size);
   reserve(alignedSize);
@@ -499,6 +524,7 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
 
 void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
+  ScopedMemoryArena arena(arena_);
   const auto alignedNewSize = sizeAlign(newSize);
   reserve(alignedNewSize);
 
@@ -523,6 +549,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
 
 void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
+  ScopedMemoryArena arena(arena_);
   const auto alignedSize = sizeAlign(size);
   DEBUG_RECORD_FREE(p, size);
   allocator_->freeBytes(p, alignedSize);
@@ -542,6 +569,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  ScopedMemoryArena arena(arena_);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -569,6 +597,7 @@ void MemoryPoolImpl::allocateNonContiguous(
 
 void MemoryPoolImpl::freeNonContiguous(Allocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
+  ScopedMemoryArena arena(arena_);
   DEBUG_RECORD_FREE(allocation);
   const int64_t freedBytes = allocator_->freeNonContiguous(allocation);
   VELOX_CHECK(allocation.empty());
@@ -586,7 +615,8 @@ const std::vector<MachinePageCount>& MemoryPoolImpl::sizeClasses() const {
 void MemoryPoolImpl::allocateContiguous(
     MachinePageCount numPages,
     ContiguousAllocation& out,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    HugePagePolicy hugePages) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   if (!out.empty()) {
     INC_MEM_OP_STATS(Frees);
@@ -604,7 +634,8 @@ void MemoryPoolImpl::allocateContiguous(
               release(allocBytes);
             }
           },
-          maxPages)) {
+          maxPages,
+          hugePages)) {
     VELOX_CHECK(out.empty());
     handleAllocationFailure(fmt::format(
         "{} failed with {} pages from {} {}",
@@ -678,7 +709,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .reservationCacheEnabled = reservationCacheEnabled_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -705,7 +737,10 @@ bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
 
 void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
   if (FOLLY_LIKELY(trackUsage_)) {
-    if (FOLLY_LIKELY(threadSafe_)) {
+    if (reservationCaches_ != nullptr && !reserveOnly &&
+        size <= kMaxCachedReservation) {
+      reserveCached(size);
+    } else if (FOLLY_LIKELY(threadSafe_)) {
       reserveThreadSafe(size, reserveOnly);
     } else {
       reserveNonThreadSafe(size, reserveOnly);
@@ -716,6 +751,58 @@ void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
   }
 }
 
+std::atomic<int64_t>& MemoryPoolImpl::reservationCache() {
+  static std::atomic<int32_t> nextIndex{0};
+  static thread_local const int32_t index =
+      nextIndex.fetch_add(1, std::memory_order_relaxed) %
+      kNumReservationCaches;
+  return reservationCaches_[index].bytes;
+}
+
+void MemoryPoolImpl::reserveCached(uint64_t size) {
+  auto& cache = reservationCache();
+  int64_t bytes = cache.load(std::memory_order_relaxed);
+  while (bytes >= static_cast<int64_t>(size)) {
+    if (cache.compare_exchange_weak(
+            bytes, bytes - size, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+  // The cache is refilled with a quantum more than 'size'. If the quantum
+  // does not fit, only 'size' is reserved.
+  try {
+    reserveThreadSafe(size + kReservationCacheQuantum);
+  } catch (const std::exception&) {
+    reserveThreadSafe(size);
+    return;
+  }
+  cache.fetch_add(kReservationCacheQuantum, std::memory_order_relaxed);
+}
+
+void MemoryPoolImpl::releaseCached(uint64_t size) {
+  auto& cache = reservationCache();
+  const auto bytes =
+      cache.fetch_add(size, std::memory_order_relaxed) + size;
+  if (bytes <= 2 * kReservationCacheQuantum) {
+    return;
+  }
+  const auto released = cache.exchange(0, std::memory_order_relaxed);
+  if (released > 0) {
+    releaseThreadSafe(released, false);
+  }
+}
+
+void MemoryPoolImpl::flushReservationCaches() {
+  int64_t released = 0;
+  for (auto i = 0; i < kNumReservationCaches; ++i) {
+    released +=
+        reservationCaches_[i].bytes.exchange(0, std::memory_order_relaxed);
+  }
+  if (released > 0) {
+    releaseThreadSafe(released, false);
+  }
+}
+
 void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
   VELOX_CHECK(isLeaf());
 
@@ -832,12 +919,18 @@ bool MemoryPoolImpl::maybeIncrementReservation(uint64_t size) {
 
 void MemoryPoolImpl::release() {
   CHECK_AND_INC_MEM_OP_STATS(Releases);
+  if (reservationCaches_ != nullptr) {
+    flushReservationCaches();
+  }
   release(0, true);
 }
 
 void MemoryPoolImpl::release(uint64_t size, bool releaseOnly) {
   if (FOLLY_LIKELY(trackUsage_)) {
-    if (FOLLY_LIKELY(threadSafe_)) {
+    if (reservationCaches_ != nullptr && !releaseOnly &&
+        size <= kMaxCachedReservation) {
+      releaseCached(size);
+    } else if (FOLLY_LIKELY(threadSafe_)) {
       releaseThreadSafe(size, releaseOnly);
     } else {
       releaseNonThreadSafe(size, releaseOnly);
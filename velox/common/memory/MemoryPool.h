@@ -23,6 +23,7 @@
 #include <queue>
 
 #include <fmt/format.h>
+#include <folly/lang/Align.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -156,6 +157,19 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If true, a thread-safe leaf memory pool serves small allocations and
+    /// frees from reservation caches that are private to groups of threads,
+    /// instead of taking the pool mutex for each one. Each cache holds up to
+    /// a small quantum of reservation. currentBytes() stays exact while the
+    /// peak and cumulative bytes count the cached bytes as used. Inherits from
+    /// the root memory pool.
+    bool reservationCacheEnabled{false};
+
+    /// If true, a root memory pool allocates the malloc memory of its tree
+    /// from a dedicated arena which is destroyed with the pool. See
+    /// MemoryAllocator::createArena(). Ignored by non-root pools.
+    bool mallocArenaEnabled{false};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -278,11 +292,13 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// range of addresses for huge pages. The range can be larger than
   /// is likely to be used because usage can be declared as needed but
   /// the number of huge pages  can be set according to an assumption of large
-  /// utilization.
+  /// utilization. 'hugePages' specifies whether the mmap is backed by huge
+  /// pages.
   virtual void allocateContiguous(
       MachinePageCount numPages,
       ContiguousAllocation& out,
-      MachinePageCount maxPages = 0) = 0;
+      MachinePageCount maxPages = 0,
+      HugePagePolicy hugePages = HugePagePolicy::kDefault) = 0;
 
   /// Frees contiguous 'allocation'. 'allocation' is empty on return.
   virtual void freeContiguous(ContiguousAllocation& allocation) = 0;
@@ -519,6 +535,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const bool reservationCacheEnabled_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -588,7 +605,8 @@ class MemoryPoolImpl : public MemoryPool {
   void allocateContiguous(
       MachinePageCount numPages,
       ContiguousAllocation& out,
-      MachinePageCount maxPages = 0) override;
+      MachinePageCount maxPages = 0,
+      HugePagePolicy hugePages = HugePagePolicy::kDefault) override;
 
   void freeContiguous(ContiguousAllocation& allocation) override;
 
@@ -730,15 +748,45 @@ class MemoryPoolImpl : public MemoryPool {
   }
 
   FOLLY_ALWAYS_INLINE int64_t currentBytesLocked() const {
-    return isLeaf() ? usedReservationBytes_ : reservationBytes_;
+    return isLeaf() ? usedReservationBytes_ - cachedReservationBytes()
+                    : reservationBytes_;
   }
 
   FOLLY_ALWAYS_INLINE int64_t availableReservationLocked() const {
-    return !isLeaf()
-        ? 0
-        : std::max<int64_t>(0, reservationBytes_ - usedReservationBytes_);
+    return !isLeaf() ? 0
+                     : std::max<int64_t>(
+                           0,
+                           reservationBytes_ - usedReservationBytes_ +
+                               cachedReservationBytes());
+  }
+
+  // Returns the sum of the reservation bytes held in 'reservationCaches_'.
+  // These bytes count as used in 'usedReservationBytes_'.
+  int64_t cachedReservationBytes() const {
+    if (FOLLY_LIKELY(reservationCaches_ == nullptr)) {
+      return 0;
+    }
+    int64_t bytes = 0;
+    for (auto i = 0; i < kNumReservationCaches; ++i) {
+      bytes += reservationCaches_[i].bytes.load(std::memory_order_relaxed);
+    }
+    return bytes;
   }
 
+  // Returns the reservation cache of the calling thread.
+  std::atomic<int64_t>& reservationCache();
+
+  // Reserves 'size' bytes from the reservation cache of the calling thread.
+  // Refills the cache from 'this' if it has less than 'size' bytes.
+  void reserveCached(uint64_t size);
+
+  // Returns 'size' bytes to the reservation cache of the calling thread.
+  // Releases the cached bytes to 'this' if more than 2 quanta are cached.
+  void releaseCached(uint64_t size);
+
+  // Moves the bytes of all reservation caches back to 'this'.
+  void flushReservationCaches();
+
   FOLLY_ALWAYS_INLINE int64_t sizeAlign(int64_t size) {
     const auto remainder = size % alignment_;
     return (remainder == 0) ? size : (size + alignment_ - remainder);
@@ -970,6 +1018,9 @@ class MemoryPoolImpl : public MemoryPool {
 
   MemoryManager* const manager_;
   MemoryAllocator* const allocator_;
+  // The malloc arena of the memory pool tree. Created by the root pool if
+  // Options::mallocArenaEnabled is set.
+  const int32_t arena_;
   const GrowCapacityCallback growCapacityCb_;
   const DestructionCallback destructionCb_;
 
@@ -1009,6 +1060,26 @@ class MemoryPoolImpl : public MemoryPool {
   tsan_atomic<int64_t> peakBytes_{0};
   tsan_atomic<int64_t> cumulativeBytes_{0};
 
+  // Number of reservation caches of a leaf pool with reservation caches.
+  static constexpr int32_t kNumReservationCaches = 16;
+
+  // Allocations up to this size are reserved from a reservation cache.
+  static constexpr int64_t kMaxCachedReservation = 32 << 10;
+
+  // Bytes added to a reservation cache when it runs out.
+  static constexpr int64_t kReservationCacheQuantum = 256 << 10;
+
+  // Reserved bytes taken from 'usedReservationBytes_' for allocations without
+  // taking 'mutex_'. Each thread uses the cache of its index. The caches are
+  // on separate cache lines so that threads do not contend.
+  struct alignas(folly::hardware_destructive_interference_size)
+      ReservationCache {
+    std::atomic<int64_t> bytes{0};
+  };
+
+  // Set for a thread-safe leaf pool with 'reservationCacheEnabled_'.
+  std::unique_ptr<ReservationCache[]> reservationCaches_;
+
   // Stats counters.
   // The number of memory allocations.
   std::atomic<uint64_t> numAllocs_{0};
@@ -16,12 +16,96 @@
 
 #include "velox/common/memory/MmapAllocator.h"
 
+#include <folly/Conv.h>
+#include <folly/String.h>
 #include <sys/mman.h>
+#include <fstream>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
+namespace {
+// Node set by MmapAllocator::setThreadNumaNode().
+thread_local int32_t threadNumaNode{-1};
+
+struct NumaTopology {
+  int32_t numNodes{1};
+  // The node of each cpu.
+  std::vector<int32_t> cpuNodes;
+};
+
+// Reads the cpus of each node from sysfs. All cpus are on node 0 if the
+// topology is not known.
+NumaTopology readNumaTopology() {
+  NumaTopology topology;
+#ifdef __linux__
+  for (auto node = 0;; ++node) {
+    std::ifstream in(
+        fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+    if (!in) {
+      topology.numNodes = std::max(1, node);
+      break;
+    }
+    std::string list;
+    std::getline(in, list);
+    std::vector<folly::StringPiece> ranges;
+    folly::split(',', folly::trimWhitespace(list), ranges);
+    for (const auto& range : ranges) {
+      if (range.empty()) {
+        continue;
+      }
+      folly::StringPiece first;
+      folly::StringPiece last;
+      if (!folly::split('-', range, first, last)) {
+        first = range;
+        last = range;
+      }
+      const auto lastCpu = folly::to<int32_t>(last);
+      if (lastCpu >= topology.cpuNodes.size()) {
+        topology.cpuNodes.resize(lastCpu + 1, 0);
+      }
+      for (auto cpu = folly::to<int32_t>(first); cpu <= lastCpu; ++cpu) {
+        topology.cpuNodes[cpu] = node;
+      }
+    }
+  }
+#endif
+  return topology;
+}
+
+const NumaTopology& numaTopology() {
+  static const NumaTopology kTopology = readNumaTopology();
+  return kTopology;
+}
+} // namespace
+
+// static
+void MmapAllocator::setThreadNumaNode(int32_t node) {
+  threadNumaNode = node;
+}
+
+// static
+int32_t MmapAllocator::currentNumaNode() {
+  if (threadNumaNode >= 0) {
+    return threadNumaNode;
+  }
+#ifdef __linux__
+  const auto cpu = sched_getcpu();
+  const auto& cpuNodes = numaTopology().cpuNodes;
+  if (cpu >= 0 && cpu < cpuNodes.size()) {
+    return cpuNodes[cpu];
+  }
+#endif
+  return 0;
+}
+
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
@@ -32,9 +116,21 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numaNodes_(
+          options.numaNodes == 0 ? numaTopology().numNodes
+                                 : options.numaNodes),
+      nodeAllocated_(numaNodes_) {
+  VELOX_CHECK_GT(numaNodes_, 0);
+  VELOX_CHECK_LE(numaNodes_, 64);
+  for (auto node = 0; node < numaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(
+          std::make_unique<SizeClass>(capacity_ / size, size, node));
+      if (numaNodes_ > 1 && node < numaTopology().numNodes) {
+        sizeClasses_.back()->bindToNode();
+      }
+    }
   }
 
   if (useMmapArena_) {
@@ -114,15 +210,20 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
     }
   }
   MachinePageCount newMapsNeeded = 0;
+  const auto node = allocationNode(mix.totalPages);
   for (int i = 0; i < mix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[mix.sizeIndices[i]]),
         mix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[mix.sizeIndices[i]]->allocate(
-              mix.sizeCounts[i], newMapsNeeded, out);
+          success = sizeClass(node, mix.sizeIndices[i])
+                        .allocate(mix.sizeCounts[i], newMapsNeeded, out);
         });
+    if (success) {
+      nodeAllocated_[node] +=
+          mix.sizeCounts[i] * sizeClassSizes_[mix.sizeIndices[i]];
+    }
     if (success && ((i > 0) || (mix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
       // Trigger memory allocation failure in the middle of the size class
@@ -169,6 +270,26 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   return false;
 }
 
+int32_t MmapAllocator::allocationNode(MachinePageCount numPages) {
+  if (numaNodes_ == 1) {
+    return 0;
+  }
+  const auto localNode = currentNumaNode() % numaNodes_;
+  if (nodeAllocated_[localNode] + numPages <= capacity_ / numaNodes_) {
+    return localNode;
+  }
+  auto node = localNode;
+  for (auto i = 0; i < numaNodes_; ++i) {
+    if (nodeAllocated_[i] < nodeAllocated_[node]) {
+      node = i;
+    }
+  }
+  if (node != localNode) {
+    ++numRemoteAllocations_;
+  }
+  return node;
+}
+
 bool MmapAllocator::ensureEnoughMappedPages(int32_t newMappedNeeded) {
   if (testingHasInjectedFailure(InjectedFailure::kMadvise)) {
     return false;
@@ -211,8 +332,7 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
     return numFreed;
   }
 
-  for (auto i = 0; i < sizeClasses_.size(); ++i) {
-    auto& sizeClass = sizeClasses_[i];
+  for (auto& sizeClass : sizeClasses_) {
     int32_t pages = 0;
     uint64_t clocks = 0;
     {
@@ -224,9 +344,12 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
       const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClass->unitSize()));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
+    if (pages > 0) {
+      nodeAllocated_[sizeClass->node()] -= pages;
+    }
     numFreed += pages;
   }
   allocation.clear();
@@ -238,11 +361,12 @@ bool MmapAllocator::allocateContiguousWithoutRetry(
     Allocation* collateral,
     ContiguousAllocation& allocation,
     ReservationCallback reservationCB,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    HugePagePolicy hugePages) {
   bool result;
   stats_.recordAllocate(AllocationTraits::pageBytes(numPages), 1, [&]() {
     result = allocateContiguousImpl(
-        numPages, collateral, allocation, reservationCB, maxPages);
+        numPages, collateral, allocation, reservationCB, maxPages, hugePages);
   });
   return result;
 }
@@ -252,7 +376,8 @@ bool MmapAllocator::allocateContiguousImpl(
     Allocation* collateral,
     ContiguousAllocation& allocation,
     ReservationCallback reservationCB,
-    MachinePageCount maxPages) {
+    MachinePageCount maxPages,
+    HugePagePolicy hugePages) {
   if (maxPages == 0) {
     maxPages = numPages;
   } else {
@@ -388,16 +513,9 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mapContiguous(AllocationTraits::pageBytes(maxPages), hugePages);
     }
   }
-  // TODO: add handling of MAP_FAILED.
   if (data == nullptr) {
     const std::string errorMsg = fmt::format(
         "Mmap failed with {} pages use MmapArena {}",
@@ -414,7 +532,7 @@ bool MmapAllocator::allocateContiguousImpl(
       data,
       AllocationTraits::pageBytes(numPages),
       AllocationTraits::pageBytes(maxPages));
-  useHugePages(allocation, true);
+  useHugePages(allocation, true, hugePages);
   return true;
 }
 
@@ -570,19 +688,23 @@ void MmapAllocator::markAllMapped(const Allocation& allocation) {
 
 MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   MachinePageCount numAway = 0;
-  for (int32_t i = sizeClasses_.size() - 1; i >= 0; --i) {
-    numAway += sizeClasses_[i]->adviseAway(target - numAway);
-    if (numAway >= target) {
-      break;
+  for (int32_t i = sizeClassSizes_.size() - 1; i >= 0 && numAway < target;
+       --i) {
+    for (auto node = 0; node < numaNodes_ && numAway < target; ++node) {
+      numAway += sizeClass(node, i).adviseAway(target - numAway);
     }
   }
   numAdvisedPages_ += numAway;
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t node)
     : capacity_(capacity),
       unitSize_(unitSize),
+      node_(node),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
@@ -614,6 +736,28 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
 MmapAllocator::SizeClass::~SizeClass() {
   munmap(address_, byteSize_);
 }
+
+void MmapAllocator::SizeClass::bindToNode() {
+#ifdef __linux__
+  // MPOL_PREFERRED from <numaif.h>, which comes with libnuma. The kernel
+  // backs the range from other nodes when 'node_' is out of memory.
+  constexpr int kMpolPreferred = 1;
+  VELOX_CHECK_LT(node_, 64);
+  unsigned long nodeMask = 1UL << node_;
+  if (::syscall(
+          SYS_mbind,
+          address_,
+          byteSize_,
+          kMpolPreferred,
+          &nodeMask,
+          sizeof(nodeMask) * 8,
+          0) != 0) {
+    VELOX_MEM_LOG(WARNING) << "mbind to NUMA node " << node_ << " failed with "
+                           << folly::errnoStr(errno) << " for size class "
+                           << unitSize_;
+  }
+#endif
+}
 ClassPageCount MmapAllocator::SizeClass::checkConsistency(
     ClassPageCount& numMapped,
     int32_t& numErrors) const {
@@ -1037,8 +1181,16 @@ std::string MmapAllocator::toString() const {
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
       << " external mapped pages " << numExternalMapped_ << std::endl;
-  for (auto& sizeClass : sizeClasses_) {
-    out << sizeClass->toString() << std::endl;
+  if (numaNodes_ > 1) {
+    out << "remote allocations " << numRemoteAllocations_ << std::endl;
+  }
+  for (auto i = 0; i < sizeClasses_.size(); ++i) {
+    if (numaNodes_ > 1 && i % sizeClassSizes_.size() == 0) {
+      const auto node = i / sizeClassSizes_.size();
+      out << "NUMA node " << node << " allocated pages "
+          << nodeAllocated_[node] << std::endl;
+    }
+    out << sizeClasses_[i]->toString() << std::endl;
   }
   out << "]";
   return out.str();
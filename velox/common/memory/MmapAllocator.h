@@ -76,6 +76,14 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// Number of NUMA nodes with their own size classes. Allocations come from
+    /// the size classes of the node of the calling thread and go to another
+    /// node only when the node of the caller has allocated its share of
+    /// 'capacity'. The size classes of node i are bound to node i if the
+    /// machine has node i. 1 means one set of size classes for all nodes and 0
+    /// means one set per NUMA node of the machine.
+    int32_t numaNodes = 1;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -156,6 +164,29 @@ class MmapAllocator : public MemoryAllocator {
     return stats;
   }
 
+  int32_t numaNodes() const {
+    return numaNodes_;
+  }
+
+  /// Returns the number of machine pages allocated from the size classes of
+  /// 'node'.
+  MachinePageCount numAllocatedOnNode(int32_t node) const {
+    return nodeAllocated_[node];
+  }
+
+  /// Returns the number of non-contiguous allocations that came from another
+  /// node than the node of the caller.
+  uint64_t numRemoteAllocations() const {
+    return numRemoteAllocations_;
+  }
+
+  /// Sets the NUMA node whose size classes serve the allocations of the
+  /// calling thread. -1 means the node the thread runs on.
+  static void setThreadNumaNode(int32_t node);
+
+  /// Returns the NUMA node for the allocations of the calling thread.
+  static int32_t currentNumaNode();
+
   std::string toString() const override;
 
  private:
@@ -165,7 +196,7 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(size_t capacity, MachinePageCount unitSize, int32_t node = 0);
 
     ~SizeClass();
 
@@ -173,6 +204,13 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    int32_t node() const {
+      return node_;
+    }
+
+    // Makes the kernel prefer 'node_' for backing the address range.
+    void bindToNode();
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -270,6 +308,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size of one size class page in machine pages.
     const MachinePageCount unitSize_;
 
+    // NUMA node of the MmapAllocator whose allocations come from 'this'.
+    const int32_t node_;
+
     // Size in bytes of the address range.
     const size_t byteSize_;
 
@@ -326,14 +367,16 @@ class MmapAllocator : public MemoryAllocator {
       Allocation* collateral,
       ContiguousAllocation& allocation,
       ReservationCallback reservationCB = nullptr,
-      MachinePageCount maxPages = 0) override;
+      MachinePageCount maxPages = 0,
+      HugePagePolicy hugePages = HugePagePolicy::kDefault) override;
 
   bool allocateContiguousImpl(
       MachinePageCount numPages,
       Allocation* collateral,
       ContiguousAllocation& allocation,
       ReservationCallback reservationCB,
-      MachinePageCount maxPages);
+      MachinePageCount maxPages,
+      HugePagePolicy hugePages);
 
   void freeContiguousImpl(ContiguousAllocation& allocation);
 
@@ -373,6 +416,16 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the size class for 'sizeIndex' in 'sizeClassSizes_' on 'node'.
+  SizeClass& sizeClass(int32_t node, int32_t sizeIndex) {
+    return *sizeClasses_[node * sizeClassSizes_.size() + sizeIndex];
+  }
+
+  // Returns the node to allocate 'numPages' from. This is the node of the
+  // caller unless it has allocated its share of 'capacity_', in which case
+  // this is the node with the least allocated pages.
+  int32_t allocationNode(MachinePageCount numPages);
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -409,8 +462,19 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // Number of NUMA nodes with their own size classes.
+  const int32_t numaNodes_;
+
+  // The size classes of each node in the order of 'sizeClassSizes_'. The
+  // size classes of each node span the whole capacity, so that any node can
+  // take all the allocations under pressure.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
+  // Machine pages allocated from the size classes of each node.
+  std::vector<std::atomic<MachinePageCount>> nodeAllocated_;
+
+  std::atomic<uint64_t> numRemoteAllocations_{0};
+
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
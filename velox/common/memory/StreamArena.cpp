@@ -76,4 +76,16 @@ void StreamArena::newTinyRange(
   range->buffer = reinterpret_cast<uint8_t*>(tinyRanges_.back().data());
   range->size = bytes;
 }
+
+void StreamArena::clear() {
+  allocations_.clear();
+  largeAllocations_.clear();
+  tinyRanges_.clear();
+  if (allocation_.numPages() > kMaxRetainedPages) {
+    pool_->freeNonContiguous(allocation_);
+  }
+  currentRun_ = 0;
+  currentOffset_ = 0;
+  size_ = allocation_.byteSize();
+}
 } // namespace facebook::velox
@@ -53,6 +53,11 @@ class StreamArena {
   virtual void
   newTinyRange(int32_t bytes, ByteRange* lastRange, ByteRange* range);
 
+  /// Frees the memory given out so far. Keeps the last non-contiguous
+  /// allocation for reuse if it is at most 'kMaxRetainedPages'. The streams
+  /// that were written to 'this' must not be used after this.
+  void clear();
+
   /// Returns the Total size in bytes held by all Allocations.
   virtual size_t size() const {
     return size_;
@@ -63,6 +68,9 @@ class StreamArena {
   }
 
  private:
+  // Largest allocation kept by clear().
+  static constexpr memory::MachinePageCount kMaxRetainedPages = 16;
+
   memory::MemoryPool* const pool_;
   const memory::MachinePageCount allocationQuantum_{2};
 
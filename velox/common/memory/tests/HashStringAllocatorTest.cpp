@@ -670,5 +670,95 @@ TEST_F(HashStringAllocatorTest, storeStringFast) {
   allocator_->checkConsistency();
 }
 
+TEST_F(HashStringAllocatorTest, compact) {
+  constexpr int32_t kNumSamples = 5'000;
+  std::vector<Multipart> data(kNumSamples);
+  for (auto i = 0; i < kNumSamples; ++i) {
+    auto chars = randomString();
+    ByteOutputStream stream(allocator_.get());
+    data[i].start = allocator_->newWrite(stream, 100);
+    stream.appendStringView(chars);
+    data[i].current = allocator_->finishWrite(stream, 0).second;
+    data[i].reference = chars;
+  }
+  // Frees 3 of 4 writes to leave free space between the live blocks.
+  for (auto i = 0; i < kNumSamples; ++i) {
+    if (i % 4 != 0) {
+      checkAndFree(data[i]);
+    }
+  }
+  allocator_->checkConsistency();
+  ASSERT_GT(allocator_->freeRatio(), 0.3);
+  const auto allocatedBytes = allocator_->checkConsistency();
+  const auto retainedSize = allocator_->retainedSize();
+
+  int32_t numMoved = 0;
+  const auto freed =
+      allocator_->compact([&](const HashStringAllocator::BlockMap& blocks) {
+        numMoved = blocks.size();
+        for (auto& d : data) {
+          if (d.start.isSet()) {
+            d.start = blocks.newPosition(d.start);
+            d.current = blocks.newPosition(d.current);
+          }
+        }
+      });
+  ASSERT_GT(numMoved, 0);
+  ASSERT_GT(freed, 0);
+  ASSERT_EQ(retainedSize - freed, allocator_->retainedSize());
+  ASSERT_EQ(allocatedBytes, allocator_->checkConsistency());
+
+  // The moved writes can be read, appended to and freed.
+  for (auto& d : data) {
+    if (!d.start.isSet()) {
+      continue;
+    }
+    checkMultipart(d);
+    auto chars = randomString();
+    ByteOutputStream stream(allocator_.get());
+    allocator_->extendWrite(d.current, stream);
+    stream.appendStringView(chars);
+    d.current = allocator_->finishWrite(stream, 0).second;
+    d.reference.insert(d.reference.end(), chars.begin(), chars.end());
+    checkMultipart(d);
+  }
+  allocator_->checkConsistency();
+  for (auto& d : data) {
+    if (d.start.isSet()) {
+      checkAndFree(d);
+    }
+  }
+  ASSERT_TRUE(allocator_->isEmpty());
+}
+
+TEST_F(HashStringAllocatorTest, compactStrings) {
+  std::vector<std::string> strings;
+  std::vector<StringView> views;
+  for (auto i = 0; i < 10'000; ++i) {
+    strings.push_back(randomString());
+    views.push_back(StringView(strings.back()));
+    allocator_->copyMultipart(reinterpret_cast<char*>(&views.back()), 0);
+  }
+  for (auto i = 0; i < views.size(); i += 2) {
+    allocator_->free(HashStringAllocator::headerOf(views[i].data()));
+    strings[i].clear();
+  }
+  allocator_->compact([&](const HashStringAllocator::BlockMap& blocks) {
+    for (auto i = 1; i < views.size(); i += 2) {
+      views[i] =
+          StringView(blocks.newAddress(views[i].data()), views[i].size());
+    }
+  });
+  allocator_->checkConsistency();
+  for (auto i = 1; i < views.size(); i += 2) {
+    std::string temp;
+    ASSERT_EQ(
+        StringView(strings[i]),
+        HashStringAllocator::contiguousString(views[i], temp));
+    allocator_->free(HashStringAllocator::headerOf(views[i].data()));
+  }
+  ASSERT_TRUE(allocator_->isEmpty());
+}
+
 } // namespace
 } // namespace facebook::velox
@@ -469,6 +469,52 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNumaNodes) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.numaNodes = 2;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(allocator->numaNodes(), 2);
+  const auto nodeCapacity =
+      AllocationTraits::numPages(allocator->capacity()) / 2;
+
+  MmapAllocator::setThreadNumaNode(1);
+  ASSERT_EQ(MmapAllocator::currentNumaNode(), 1);
+  Allocation onNode1;
+  ASSERT_TRUE(allocator->allocateNonContiguous(128, onNode1));
+  ASSERT_EQ(allocator->numAllocatedOnNode(0), 0);
+  ASSERT_EQ(allocator->numAllocatedOnNode(1), 128);
+
+  // Node 0 takes allocations up to its share.
+  MmapAllocator::setThreadNumaNode(0);
+  Allocation onNode0;
+  ASSERT_TRUE(allocator->allocateNonContiguous(nodeCapacity, onNode0));
+  ASSERT_EQ(allocator->numAllocatedOnNode(0), nodeCapacity);
+  ASSERT_EQ(allocator->numRemoteAllocations(), 0);
+
+  // Past its share, node 0 falls back to the node with the least allocated.
+  Allocation remote;
+  ASSERT_TRUE(allocator->allocateNonContiguous(16, remote));
+  ASSERT_EQ(allocator->numAllocatedOnNode(0), nodeCapacity);
+  ASSERT_EQ(allocator->numAllocatedOnNode(1), 144);
+  ASSERT_EQ(allocator->numRemoteAllocations(), 1);
+  ASSERT_TRUE(allocator->checkConsistency());
+  ASSERT_NE(
+      allocator->toString().find("NUMA node 1 allocated pages 144"),
+      std::string::npos);
+
+  allocator->freeNonContiguous(onNode0);
+  allocator->freeNonContiguous(onNode1);
+  allocator->freeNonContiguous(remote);
+  ASSERT_EQ(allocator->numAllocatedOnNode(0), 0);
+  ASSERT_EQ(allocator->numAllocatedOnNode(1), 0);
+  ASSERT_EQ(allocator->numAllocated(), 0);
+  MmapAllocator::setThreadNumaNode(-1);
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -1373,6 +1419,29 @@ TEST_P(MemoryAllocatorTest, nonContiguousAllocationBounds) {
   instance_->freeNonContiguous(*allocation);
 }
 
+TEST_P(MemoryAllocatorTest, contiguousHugePages) {
+  const auto numHugePagePages = AllocationTraits::numPagesInHugePage();
+  for (auto numPages :
+       {numHugePagePages, 3 * numHugePagePages, 5 * numHugePagePages + 1}) {
+    ContiguousAllocation allocation;
+    ASSERT_TRUE(instance_->allocateContiguous(
+        numPages, nullptr, allocation, nullptr, 0, HugePagePolicy::kAlways));
+    ASSERT_EQ(allocation.numPages(), numPages);
+    ASSERT_EQ(
+        reinterpret_cast<uintptr_t>(allocation.data()) %
+            AllocationTraits::kHugePageSize,
+        0);
+    // The whole range is writable.
+    memset(allocation.data(), 1, allocation.size());
+    ASSERT_EQ(
+        allocation.hugePageRange()->size(),
+        allocation.size() / AllocationTraits::kHugePageSize *
+            AllocationTraits::kHugePageSize);
+    instance_->freeContiguous(allocation);
+  }
+  ASSERT_EQ(instance_->numAllocated(), 0);
+}
+
 TEST_P(MemoryAllocatorTest, contiguousAllocation) {
   const MachinePageCount kNumPages = instance_->largestSizeClass() + 1;
   auto allocation = std::make_unique<ContiguousAllocation>();
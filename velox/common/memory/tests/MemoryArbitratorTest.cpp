@@ -670,6 +670,41 @@ TEST_F(MemoryReclaimerTest, orderedReclaim) {
   ASSERT_EQ(stats_, MemoryReclaimer::Stats{});
 }
 
+TEST_F(MemoryReclaimerTest, defaultReclaimCostModel) {
+  auto pool = memory::memoryManager()->addRootPool(
+      "defaultReclaimCostModel", kMaxMemory, memory::MemoryReclaimer::create());
+  ASSERT_EQ(pool->reclaimer()->reclaimCostInfo(*pool).runningTimeMs, 0);
+
+  DefaultMemoryReclaimCostModel model(
+      {.spillBytesPerSec = 100 << 20,
+       .runningTimeWeight = 1,
+       .progressWeight = 1,
+       .priorityWeight = 1});
+  const uint64_t target = 100 << 20;
+  MemoryReclaimer::ReclaimCostInfo info;
+  // Spilling the target takes 1s.
+  ASSERT_DOUBLE_EQ(
+      model.reclaimCost(*pool, target, target, info), 1.0 / target);
+  // The cost is spread over the reclaimed bytes.
+  ASSERT_DOUBLE_EQ(
+      model.reclaimCost(*pool, 2 * target, target, info), 1.0 / target);
+  ASSERT_DOUBLE_EQ(
+      model.reclaimCost(*pool, target / 2, target, info), 1.0 / target);
+  ASSERT_EQ(
+      model.reclaimCost(*pool, 0, target, info),
+      std::numeric_limits<double>::max());
+
+  info.runningTimeMs = 2'000;
+  info.progress = 0.5;
+  info.priority = 1;
+  ASSERT_DOUBLE_EQ(
+      model.reclaimCost(*pool, target, target, info), 4.5 / target);
+  // A partially reclaimable pool pays the disruption for fewer bytes.
+  ASSERT_GT(
+      model.reclaimCost(*pool, target / 2, target, info),
+      model.reclaimCost(*pool, target, target, info));
+}
+
 TEST_F(MemoryReclaimerTest, arbitrationContext) {
   auto root = memory::memoryManager()->addRootPool(
       "arbitrationContext", kMaxMemory, MemoryReclaimer::create());
@@ -814,4 +849,31 @@ TEST_F(MemoryArbitrationTest, reclaimerStats) {
   stats1.reset();
   ASSERT_EQ(stats1, stats2);
 }
+
+TEST_F(MemoryArbitrationTest, prefetchThrottle) {
+  PrefetchThrottle throttle;
+  ASSERT_EQ(throttle.prefetchPct(), 100);
+  throttle.update(50, 100);
+  ASSERT_EQ(throttle.prefetchPct(), 100);
+  ASSERT_EQ(throttle.scale(8), 8);
+
+  // Halfway between the thresholds of free capacity.
+  throttle.update(125, 1'000);
+  ASSERT_EQ(throttle.prefetchPct(), 50);
+  ASSERT_EQ(throttle.scale(8), 4);
+
+  throttle.update(PrefetchThrottle::kNoPrefetchFreePct, 100);
+  ASSERT_EQ(throttle.prefetchPct(), 0);
+  ASSERT_EQ(throttle.scale(8), 0);
+  // An arbitrator without capacity does not change the budget.
+  throttle.update(0, 0);
+  ASSERT_EQ(throttle.prefetchPct(), 0);
+
+  // The budget is restored when memory is free again.
+  throttle.update(PrefetchThrottle::kUnthrottledFreePct, 100);
+  ASSERT_EQ(throttle.prefetchPct(), 100);
+  throttle.update(0, 100);
+  throttle.reset();
+  ASSERT_EQ(throttle.prefetchPct(), 100);
+}
 } // namespace facebook::velox::memory
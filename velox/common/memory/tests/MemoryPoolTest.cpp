@@ -2267,6 +2267,96 @@ TEST_P(MemoryPoolTest, concurrentUpdatesToTheSamePool) {
   ASSERT_EQ(root->stats().currentBytes, 0);
 }
 
+TEST_P(MemoryPoolTest, reservationCache) {
+  if (!isLeafThreadSafe_) {
+    return;
+  }
+  setupMemory(
+      {.reservationCacheEnabled = true, .allocatorCapacity = kDefaultCapacity});
+  auto root = getMemoryManager()->addRootPool("reservationCache");
+  auto leaf = root->addLeafChild("leaf");
+
+  // A small allocation is counted exactly while the pool reserves more.
+  void* buffer = leaf->allocate(128);
+  ASSERT_EQ(leaf->currentBytes(), 128);
+  ASSERT_EQ(leaf->stats().currentBytes, 128);
+  ASSERT_GT(leaf->availableReservation(), 0);
+  ASSERT_GT(root->currentBytes(), 128);
+  leaf->free(buffer, 128);
+  ASSERT_EQ(leaf->currentBytes(), 0);
+
+  // Large allocations bypass the caches.
+  constexpr int64_t kLargeSize = 4 * MB;
+  buffer = leaf->allocate(kLargeSize);
+  ASSERT_EQ(leaf->currentBytes(), kLargeSize);
+  leaf->free(buffer, kLargeSize);
+
+  const int32_t kNumThreads = 8;
+  const int32_t kNumAllocsPerThread = 2'000;
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int32_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      folly::Random::DefaultGenerator rng(i);
+      std::vector<std::pair<void*, int64_t>> buffers;
+      for (int32_t j = 0; j < kNumAllocsPerThread; ++j) {
+        const int64_t size = 1 + folly::Random::rand32(2048, rng);
+        buffers.emplace_back(leaf->allocate(size), size);
+        if (j % 3 == 0) {
+          leaf->free(buffers.back().first, buffers.back().second);
+          buffers.pop_back();
+        }
+      }
+      for (auto& [data, size] : buffers) {
+        leaf->free(data, size);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(leaf->currentBytes(), 0);
+
+  // release() returns the cached reservation to the parent.
+  leaf->release();
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(leaf->availableReservation(), 0);
+  ASSERT_EQ(root->currentBytes(), 0);
+
+  buffer = leaf->allocate(1'024);
+  ASSERT_EQ(leaf->currentBytes(), 1'024);
+  leaf->free(buffer, 1'024);
+  leaf.reset();
+  ASSERT_EQ(root->currentBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, mallocArenaPerRootPool) {
+  setupMemory(
+      {.mallocArenaPerRootPool = true, .allocatorCapacity = kDefaultCapacity});
+  for (int32_t round = 0; round < 2; ++round) {
+    auto root = getMemoryManager()->addRootPool("mallocArenaPerRootPool");
+    auto leaf = root->addLeafChild("leaf");
+    ASSERT_EQ(ScopedMemoryArena::current(), MemoryAllocator::kNoArena);
+
+    auto* buffer = static_cast<char*>(leaf->allocate(1'024));
+    std::memset(buffer, 'a', 1'024);
+    buffer = static_cast<char*>(leaf->reallocate(buffer, 1'024, 4'096));
+    ASSERT_EQ(buffer[1'023], 'a');
+    auto* zeros = static_cast<char*>(leaf->allocateZeroFilled(16, 64));
+    ASSERT_EQ(zeros[1'023], 0);
+    Allocation allocation;
+    leaf->allocateNonContiguous(16, allocation);
+    ASSERT_EQ(leaf->currentBytes(), 4'096 + 1'024 + allocation.byteSize());
+
+    // The arena of the calling thread is restored after each call.
+    ASSERT_EQ(ScopedMemoryArena::current(), MemoryAllocator::kNoArena);
+    leaf->freeNonContiguous(allocation);
+    leaf->free(zeros, 1'024);
+    leaf->free(buffer, 4'096);
+    ASSERT_EQ(leaf->currentBytes(), 0);
+  }
+}
+
 TEST_P(MemoryPoolTest, concurrentUpdateToSharedPools) {
   // under some conditions bug.
   constexpr int64_t kMaxMemory = 10 * GB;
@@ -407,7 +407,11 @@ class MockSharedArbitrationTest : public testing::Test {
       int64_t memoryCapacity = 0,
       uint64_t memoryPoolInitCapacity = kMaxMemory,
       uint64_t memoryPoolTransferCapacity = 0,
-      std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr) {
+      std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr,
+      std::shared_ptr<MemoryReclaimCostModel> reclaimCostModel = nullptr,
+      uint64_t fastExponentialGrowthCapacityLimit = 0,
+      double slowCapacityGrowPct = 0,
+      bool fastGrowFromFreeCapacity = false) {
     if (memoryPoolInitCapacity == kMaxMemory) {
       memoryPoolInitCapacity = kMemoryPoolInitCapacity;
     }
@@ -422,6 +426,11 @@ class MockSharedArbitrationTest : public testing::Test {
     options.memoryPoolInitCapacity = memoryPoolInitCapacity;
     options.memoryPoolTransferCapacity = memoryPoolTransferCapacity;
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
+    options.arbitratorReclaimCostModel = std::move(reclaimCostModel);
+    options.fastExponentialGrowthCapacityLimit =
+        fastExponentialGrowthCapacityLimit;
+    options.slowCapacityGrowPct = slowCapacityGrowPct;
+    options.fastGrowFromFreeCapacity = fastGrowFromFreeCapacity;
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
     ASSERT_EQ(manager_->arbitrator()->kind(), arbitratorKind);
@@ -988,6 +997,111 @@ TEST_F(MockSharedArbitrationTest, arbitrateWithMemoryReclaim) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, reclaimCostModel) {
+  // Prefers to reclaim from 'cheapPool' regardless of the reclaimable bytes.
+  class TestCostModel : public MemoryReclaimCostModel {
+   public:
+    double reclaimCost(
+        const MemoryPool& pool,
+        uint64_t /*unused*/,
+        uint64_t /*unused*/,
+        const MemoryReclaimer::ReclaimCostInfo& /*unused*/) const override {
+      return &pool == cheapPool ? 0 : 1;
+    }
+
+    const MemoryPool* cheapPool{nullptr};
+  };
+
+  const uint64_t memoryCapacity = 256 * MB;
+  const uint64_t minPoolCapacity = 8 * MB;
+  const int allocateSize = 8 * MB;
+  for (const bool withCostModel : {false, true}) {
+    SCOPED_TRACE(fmt::format("withCostModel {}", withCostModel));
+    auto costModel = std::make_shared<TestCostModel>();
+    setupMemory(
+        memoryCapacity,
+        minPoolCapacity,
+        0,
+        nullptr,
+        withCostModel ? costModel : nullptr);
+    auto* largeOp = addMemoryOp();
+    while (largeOp->pool()->currentBytes() < 192 * MB) {
+      largeOp->allocate(allocateSize);
+    }
+    auto* smallOp = addMemoryOp();
+    while (smallOp->pool()->currentBytes() < 64 * MB) {
+      smallOp->allocate(allocateSize);
+    }
+    costModel->cheapPool = smallOp->pool()->root();
+
+    auto* arbitrateOp = addMemoryOp();
+    arbitrateOp->allocate(allocateSize);
+    if (withCostModel) {
+      ASSERT_EQ(largeOp->reclaimer()->stats().numReclaims, 0);
+      ASSERT_EQ(smallOp->reclaimer()->stats().numReclaims, 1);
+    } else {
+      ASSERT_EQ(largeOp->reclaimer()->stats().numReclaims, 1);
+      ASSERT_EQ(smallOp->reclaimer()->stats().numReclaims, 0);
+    }
+    clearTasks();
+  }
+}
+
+TEST_F(MockSharedArbitrationTest, growAhead) {
+  const uint64_t memoryCapacity = 96 * MB;
+  const int allocateSize = 8 * MB;
+  setupMemory(memoryCapacity, 0, 0, nullptr, nullptr, 64 * MB, 0.25);
+  auto* memOp = addMemoryOp();
+  // The pool doubles its capacity below 64MB.
+  const std::vector<uint64_t> expectedCapacities = {
+      8 * MB, 16 * MB, 32 * MB, 32 * MB, 64 * MB, 64 * MB, 64 * MB, 64 * MB};
+  for (const auto expectedCapacity : expectedCapacities) {
+    memOp->allocate(allocateSize);
+    ASSERT_EQ(memOp->pool()->capacity(), expectedCapacity);
+  }
+  ASSERT_EQ(arbitrator_->stats().numRequests, 4);
+
+  // The pool grows by a quarter of its capacity from 64MB.
+  memOp->allocate(allocateSize);
+  ASSERT_EQ(memOp->pool()->capacity(), 80 * MB);
+  ASSERT_EQ(arbitrator_->stats().numRequests, 5);
+
+  // The grow ahead is bounded by the free capacity.
+  memOp->allocate(allocateSize);
+  memOp->allocate(allocateSize);
+  ASSERT_EQ(memOp->pool()->capacity(), memoryCapacity);
+  ASSERT_EQ(arbitrator_->stats().numRequests, 6);
+  ASSERT_EQ(arbitrator_->stats().freeCapacityBytes, 0);
+}
+
+TEST_F(MockSharedArbitrationTest, fastGrowFromFreeCapacity) {
+  std::atomic<int> checkCount{0};
+  MemoryArbitrationStateCheckCB checkCountCb = [&](MemoryPool& /*unused*/) {
+    ++checkCount;
+  };
+  const uint64_t memoryCapacity = 64 * MB;
+  setupMemory(memoryCapacity, 0, 0, checkCountCb, nullptr, 0, 0, true);
+  auto* memOp = addMemoryOp();
+  memOp->allocate(kMemoryPoolTransferCapacity);
+  ASSERT_EQ(memOp->pool()->capacity(), kMemoryPoolTransferCapacity);
+  // The growth from the free capacity doesn't enter the memory arbitration.
+  ASSERT_EQ(checkCount, 0);
+  ASSERT_EQ(arbitrator_->stats().numRequests, 1);
+  ASSERT_EQ(arbitrator_->stats().numSucceeded, 1);
+
+  // The growth which needs to reclaim memory goes through the memory
+  // arbitration.
+  auto* otherOp = addMemoryOp();
+  while (otherOp->pool()->currentBytes() + memOp->pool()->capacity() <
+         memoryCapacity) {
+    otherOp->allocate(kMemoryPoolTransferCapacity);
+  }
+  ASSERT_EQ(checkCount, 0);
+  memOp->allocate(kMemoryPoolTransferCapacity);
+  ASSERT_EQ(checkCount, 1);
+  verifyReclaimerStats(otherOp->reclaimer()->stats(), 1, 0);
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrateBySelfMemoryReclaim) {
   const std::vector<bool> isLeafReclaimables = {true, false};
   for (const auto isLeafReclaimable : isLeafReclaimables) {
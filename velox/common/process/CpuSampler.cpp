@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/CpuSampler.h"
+
+#include <fmt/format.h>
+#include <folly/experimental/symbolizer/StackTrace.h>
+#include <glog/logging.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "velox/common/process/StackTrace.h"
+#include "velox/common/process/ThreadDebugInfo.h"
+
+namespace facebook::velox::process {
+namespace {
+thread_local const char* sampledOperatorType = nullptr;
+thread_local const char* sampledPlanNodeId = nullptr;
+
+constexpr int32_t kNumSlots = 4'096;
+constexpr int32_t kMaxFrames = 64;
+constexpr int32_t kMaxLabel = 128;
+// Frames of the signal handler and the signal trampoline.
+constexpr int32_t kNumHandlerFrames = 2;
+
+constexpr int32_t kEmpty = 0;
+constexpr int32_t kWriting = 1;
+constexpr int32_t kFull = 2;
+
+struct Slot {
+  std::atomic<int32_t> state{kEmpty};
+  int32_t numFrames{0};
+  uintptr_t frames[kMaxFrames];
+  char queryId[kMaxLabel];
+  char taskId[kMaxLabel];
+  char operatorLabel[kMaxLabel];
+};
+
+// Set on the first start() and never freed since a signal may be handled
+// after stop().
+std::atomic<Slot*> slots{nullptr};
+std::atomic<uint32_t> nextSlot{0};
+std::atomic<int64_t> numDropped{0};
+
+// Appends 'size' bytes of 'data' to the zero-terminated 'label' as far as
+// they fit. Async signal safe.
+void appendLabel(char* label, const char* data, size_t size) {
+  const auto length = strlen(label);
+  const auto numBytes = std::min<size_t>(size, kMaxLabel - 1 - length);
+  memcpy(label + length, data, numBytes);
+  label[length + numBytes] = 0;
+}
+
+void appendLabel(char* label, const char* data) {
+  appendLabel(label, data, strlen(data));
+}
+
+void handleSignal(int /*signal*/) {
+  auto* allSlots = slots.load(std::memory_order_acquire);
+  if (allSlots == nullptr) {
+    return;
+  }
+  const auto savedErrno = errno;
+  auto& slot = allSlots[nextSlot.fetch_add(1) % kNumSlots];
+  int32_t expected = kEmpty;
+  if (!slot.state.compare_exchange_strong(expected, kWriting)) {
+    numDropped.fetch_add(1);
+    errno = savedErrno;
+    return;
+  }
+  const auto numFrames =
+      folly::symbolizer::getStackTraceSafe(slot.frames, kMaxFrames);
+  slot.numFrames = numFrames < 0 ? 0 : numFrames;
+  slot.queryId[0] = 0;
+  slot.taskId[0] = 0;
+  slot.operatorLabel[0] = 0;
+  if (const auto* info = GetThreadDebugInfo()) {
+    appendLabel(slot.queryId, info->queryId_.data(), info->queryId_.size());
+    appendLabel(slot.taskId, info->taskId_.data(), info->taskId_.size());
+  }
+  if (sampledOperatorType != nullptr) {
+    appendLabel(slot.operatorLabel, sampledPlanNodeId);
+    appendLabel(slot.operatorLabel, " ");
+    appendLabel(slot.operatorLabel, sampledOperatorType);
+  }
+  slot.state.store(kFull, std::memory_order_release);
+  errno = savedErrno;
+}
+
+struct Stack {
+  std::string taskId;
+  std::string operatorLabel;
+  // From the outermost frame.
+  std::vector<uintptr_t> frames;
+
+  bool operator<(const Stack& other) const {
+    return std::tie(taskId, operatorLabel, frames) <
+        std::tie(other.taskId, other.operatorLabel, other.frames);
+  }
+};
+
+class Sampler {
+ public:
+  static Sampler& instance() {
+    static Sampler* sampler = new Sampler();
+    return *sampler;
+  }
+
+  void start(int32_t intervalMicros) {
+    std::lock_guard<std::mutex> l(startMutex_);
+    if (running_) {
+      return;
+    }
+    CHECK_GT(intervalMicros, 0);
+    if (slots.load() == nullptr) {
+      slots.store(new Slot[kNumSlots]);
+    }
+    struct sigaction action {};
+    action.sa_handler = handleSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    CHECK_EQ(sigaction(SIGPROF, &action, &previousAction_), 0);
+
+    {
+      std::lock_guard<std::mutex> stateLock(mutex_);
+      stopping_ = false;
+    }
+    thread_ = std::thread([this]() { run(); });
+
+    itimerval timer{};
+    timer.it_interval.tv_sec = intervalMicros / 1'000'000;
+    timer.it_interval.tv_usec = intervalMicros % 1'000'000;
+    timer.it_value = timer.it_interval;
+    CHECK_EQ(setitimer(ITIMER_PROF, &timer, nullptr), 0);
+    running_ = true;
+  }
+
+  void stop() {
+    std::lock_guard<std::mutex> l(startMutex_);
+    if (!running_) {
+      return;
+    }
+    itimerval timer{};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    sigaction(SIGPROF, &previousAction_, nullptr);
+    {
+      std::lock_guard<std::mutex> stateLock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    aggregate();
+    running_ = false;
+  }
+
+  bool isRunning() {
+    std::lock_guard<std::mutex> l(startMutex_);
+    return running_;
+  }
+
+  void aggregate() {
+    auto* allSlots = slots.load(std::memory_order_acquire);
+    if (allSlots == nullptr) {
+      return;
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto i = 0; i < kNumSlots; ++i) {
+      auto& slot = allSlots[i];
+      if (slot.state.load(std::memory_order_acquire) != kFull) {
+        continue;
+      }
+      Stack stack;
+      stack.taskId = slot.taskId;
+      stack.operatorLabel = slot.operatorLabel;
+      for (auto frame = slot.numFrames - 1; frame >= kNumHandlerFrames;
+           --frame) {
+        stack.frames.push_back(slot.frames[frame]);
+      }
+      ++queries_[slot.queryId][std::move(stack)];
+      slot.state.store(kEmpty, std::memory_order_release);
+    }
+  }
+
+  std::string foldedStacks(const std::string& queryId) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = queries_.find(queryId);
+    if (it == queries_.end()) {
+      return "";
+    }
+    std::string result;
+    for (const auto& [stack, count] : it->second) {
+      result += stack.taskId.empty() ? std::string("-") : stack.taskId;
+      result += ';';
+      result += stack.operatorLabel.empty() ? std::string("-")
+                                            : stack.operatorLabel;
+      for (auto frame : stack.frames) {
+        result += ';';
+        result += symbol(frame);
+      }
+      result += fmt::format(" {}\n", count);
+    }
+    return result;
+  }
+
+  std::unordered_map<std::string, int64_t> sampleCounts() {
+    std::lock_guard<std::mutex> l(mutex_);
+    std::unordered_map<std::string, int64_t> counts;
+    for (const auto& [queryId, stacks] : queries_) {
+      for (const auto& [stack, count] : stacks) {
+        counts[queryId] += count;
+      }
+    }
+    return counts;
+  }
+
+  void clear(const std::string& queryId) {
+    std::lock_guard<std::mutex> l(mutex_);
+    queries_.erase(queryId);
+  }
+
+ private:
+  static constexpr std::chrono::milliseconds kAggregateInterval{100};
+
+  void run() {
+    std::unique_lock<std::mutex> l(mutex_);
+    while (!stopping_) {
+      cv_.wait_for(l, kAggregateInterval, [&]() { return stopping_; });
+      l.unlock();
+      aggregate();
+      l.lock();
+    }
+  }
+
+  // Returns the symbolized name of the function at 'address'. Called under
+  // 'mutex_'.
+  const std::string& symbol(uintptr_t address) {
+    auto it = symbols_.find(address);
+    if (it == symbols_.end()) {
+      auto name =
+          StackTrace::translateFrame(reinterpret_cast<void*>(address), false);
+      if (name.empty()) {
+        name = fmt::format("{:#x}", address);
+      }
+      // ';' separates the frames of a folded stack.
+      std::replace(name.begin(), name.end(), ';', ':');
+      it = symbols_.emplace(address, std::move(name)).first;
+    }
+    return it->second;
+  }
+
+  // Serializes start() and stop().
+  std::mutex startMutex_;
+  bool running_{false};
+  struct sigaction previousAction_ {};
+  std::thread thread_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_{false};
+  // Number of samples per stack per query id.
+  std::unordered_map<std::string, std::map<Stack, int64_t>> queries_;
+  std::unordered_map<uintptr_t, std::string> symbols_;
+};
+} // namespace
+
+// static
+void CpuSampler::start(int32_t intervalMicros) {
+  Sampler::instance().start(intervalMicros);
+}
+
+// static
+void CpuSampler::stop() {
+  Sampler::instance().stop();
+}
+
+// static
+bool CpuSampler::isRunning() {
+  return Sampler::instance().isRunning();
+}
+
+// static
+std::string CpuSampler::foldedStacks(const std::string& queryId) {
+  return Sampler::instance().foldedStacks(queryId);
+}
+
+// static
+std::unordered_map<std::string, int64_t> CpuSampler::sampleCounts() {
+  return Sampler::instance().sampleCounts();
+}
+
+// static
+int64_t CpuSampler::numDroppedSamples() {
+  return numDropped.load();
+}
+
+// static
+void CpuSampler::clear(const std::string& queryId) {
+  Sampler::instance().clear(queryId);
+}
+
+ScopedSampledOperator::ScopedSampledOperator(
+    const std::string& operatorType,
+    const std::string& planNodeId)
+    : prevOperatorType_(sampledOperatorType),
+      prevPlanNodeId_(sampledPlanNodeId) {
+  sampledOperatorType = operatorType.c_str();
+  sampledPlanNodeId = planNodeId.c_str();
+}
+
+ScopedSampledOperator::~ScopedSampledOperator() {
+  sampledOperatorType = prevOperatorType_;
+  sampledPlanNodeId = prevPlanNodeId_;
+}
+
+} // namespace facebook::velox::process
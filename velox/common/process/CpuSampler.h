@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::velox::process {
+
+/// Samples the stacks of the threads that use CPU with SIGPROF at a low rate
+/// and attributes each sample to the query and task of the thread, from
+/// ThreadDebugInfo, and to the operator it runs, from ScopedSampledOperator.
+/// Meant to run continuously in a multi-tenant worker to see which queries
+/// use the CPU. The signal handler only copies the stack and the labels into
+/// a preallocated slot. A background thread aggregates the slots every
+/// 100ms. A slot that is not aggregated in time drops the samples that would
+/// go into it.
+class CpuSampler {
+ public:
+  /// Starts sampling every 'intervalMicros' of CPU time of the process.
+  /// No-op if already started.
+  static void start(int32_t intervalMicros = 10'000);
+
+  /// Stops sampling. Keeps the samples taken so far.
+  static void stop();
+
+  static bool isRunning();
+
+  /// Returns the samples of 'queryId' in folded stack format, for
+  /// flamegraph.pl or speedscope. Each line is a distinct stack with the
+  /// task, the operator and the frames from the outermost, separated by ';',
+  /// followed by a space and the number of samples.
+  static std::string foldedStacks(const std::string& queryId);
+
+  /// Returns the number of samples of each query. Samples of threads without
+  /// ThreadDebugInfo are under the empty query id.
+  static std::unordered_map<std::string, int64_t> sampleCounts();
+
+  /// Returns the number of samples dropped because the slots were full.
+  static int64_t numDroppedSamples();
+
+  /// Drops the samples of 'queryId', e.g. when the query finishes.
+  static void clear(const std::string& queryId);
+};
+
+/// Sets the operator that the calling thread runs for attributing CPU
+/// samples. The strings must outlive 'this'.
+class ScopedSampledOperator {
+ public:
+  ScopedSampledOperator(
+      const std::string& operatorType,
+      const std::string& planNodeId);
+
+  ~ScopedSampledOperator();
+
+ private:
+  const char* const prevOperatorType_;
+  const char* const prevPlanNodeId_;
+};
+
+} // namespace facebook::velox::process
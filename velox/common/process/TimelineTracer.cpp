@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/TimelineTracer.h"
+
+#include <folly/json.h>
+#include <folly/system/ThreadId.h>
+#include <chrono>
+#include <optional>
+
+namespace facebook::velox::process {
+namespace {
+// Chrome trace process ids of the thread events and the track events.
+constexpr int32_t kThreadsPid = 1;
+constexpr int32_t kTracksPid = 2;
+
+folly::dynamic metadataEvent(
+    const char* kind,
+    int32_t pid,
+    std::optional<int64_t> tid,
+    const std::string& name) {
+  auto event = folly::dynamic::object("name", kind)("ph", "M")("pid", pid)(
+      "args", folly::dynamic::object("name", name));
+  if (tid.has_value()) {
+    event["tid"] = tid.value();
+  }
+  return event;
+}
+} // namespace
+
+// static
+uint64_t TimelineTracer::nowMicros() {
+  // Same clock as the blocking times of BlockingState.
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::high_resolution_clock::now().time_since_epoch())
+      .count();
+}
+
+int32_t TimelineTracer::addTrack(std::string name) {
+  std::lock_guard<std::mutex> l(mutex_);
+  trackNames_.push_back(std::move(name));
+  return trackNames_.size() - 1;
+}
+
+void TimelineTracer::addThreadEvent(
+    std::string name,
+    const char* category,
+    uint64_t startMicros,
+    uint64_t endMicros,
+    std::string details) {
+  addEvent(
+      {std::move(name),
+       category,
+       startMicros,
+       endMicros - startMicros,
+       folly::getOSThreadID(),
+       false,
+       std::move(details)});
+}
+
+void TimelineTracer::addTrackEvent(
+    int32_t track,
+    std::string name,
+    const char* category,
+    uint64_t startMicros,
+    uint64_t endMicros) {
+  addEvent(
+      {std::move(name),
+       category,
+       startMicros,
+       endMicros - startMicros,
+       static_cast<uint64_t>(track),
+       true,
+       ""});
+}
+
+void TimelineTracer::addEvent(Event event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() >= kMaxEvents) {
+    ++numDropped_;
+    return;
+  }
+  events_.push_back(std::move(event));
+}
+
+std::string TimelineTracer::toJson() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto traceEvents = folly::dynamic::array(
+      metadataEvent("process_name", kThreadsPid, std::nullopt, "Threads"),
+      metadataEvent("process_name", kTracksPid, std::nullopt, "Drivers"));
+  for (auto i = 0; i < trackNames_.size(); ++i) {
+    traceEvents.push_back(
+        metadataEvent("thread_name", kTracksPid, i, trackNames_[i]));
+  }
+  for (const auto& event : events_) {
+    auto json = folly::dynamic::object("name", event.name)(
+        "cat", event.category)("ph", "X")(
+        "ts", static_cast<int64_t>(event.startMicros))(
+        "dur", static_cast<int64_t>(event.durationMicros))(
+        "pid", event.onTrack ? kTracksPid : kThreadsPid)(
+        "tid", static_cast<int64_t>(event.threadId));
+    if (!event.details.empty()) {
+      json["args"] = folly::dynamic::object("details", event.details);
+    }
+    traceEvents.push_back(std::move(json));
+  }
+  return folly::toJson(folly::dynamic::object("traceEvents", traceEvents)(
+      "droppedEvents", static_cast<int64_t>(numDropped_)));
+}
+
+} // namespace facebook::velox::process
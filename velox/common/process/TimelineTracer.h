@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Collects a timeline of intervals, e.g. operator calls and the time drivers
+/// are blocked, for one query. Exported as Chrome trace event JSON, which
+/// chrome://tracing and the Perfetto UI open. Events are either on the OS
+/// thread that recorded them or on a named track, e.g. of a driver. Meant for
+/// diagnosing stalls, not for always-on use: each event takes a mutex.
+class TimelineTracer {
+ public:
+  /// Events after this many are counted but not kept.
+  static constexpr size_t kMaxEvents = 1'000'000;
+
+  /// Returns the current time in the units of the event times.
+  static uint64_t nowMicros();
+
+  /// Adds a track for events that are not attributed to a thread and returns
+  /// its id.
+  int32_t addTrack(std::string name);
+
+  /// Records an interval on the calling thread. 'category' groups events in
+  /// the UI, e.g. 'operator' or 'spill'. 'details' is shown with the event.
+  void addThreadEvent(
+      std::string name,
+      const char* category,
+      uint64_t startMicros,
+      uint64_t endMicros,
+      std::string details = "");
+
+  /// Records an interval on 'track'.
+  void addTrackEvent(
+      int32_t track,
+      std::string name,
+      const char* category,
+      uint64_t startMicros,
+      uint64_t endMicros);
+
+  size_t numEvents() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return events_.size();
+  }
+
+  size_t numDroppedEvents() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numDropped_;
+  }
+
+  /// Returns the events in Chrome trace event format.
+  std::string toJson() const;
+
+ private:
+  struct Event {
+    std::string name;
+    const char* category;
+    uint64_t startMicros;
+    uint64_t durationMicros;
+    // OS thread id or the id of a track.
+    uint64_t threadId;
+    bool onTrack;
+    std::string details;
+  };
+
+  void addEvent(Event event);
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  std::vector<std::string> trackNames_;
+  size_t numDropped_{0};
+};
+
+/// Records the time between construction and destruction as an event on the
+/// calling thread. No-op if 'tracer' is nullptr.
+class TimelineScope {
+ public:
+  TimelineScope(
+      TimelineTracer* tracer,
+      std::string name,
+      const char* category,
+      std::string details = "")
+      : tracer_(tracer),
+        name_(tracer != nullptr ? std::move(name) : std::string()),
+        category_(category),
+        details_(tracer != nullptr ? std::move(details) : std::string()),
+        startMicros_(tracer != nullptr ? TimelineTracer::nowMicros() : 0) {}
+
+  ~TimelineScope() {
+    if (tracer_ != nullptr) {
+      tracer_->addThreadEvent(
+          std::move(name_),
+          category_,
+          startMicros_,
+          TimelineTracer::nowMicros(),
+          std::move(details_));
+    }
+  }
+
+ private:
+  TimelineTracer* const tracer_;
+  std::string name_;
+  const char* const category_;
+  std::string details_;
+  const uint64_t startMicros_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/CpuSampler.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+
+#include "velox/common/process/ThreadDebugInfo.h"
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(CpuSamplerTest, attribution) {
+  ThreadDebugInfo info{"query.1", "task.1", nullptr};
+  const std::string operatorType = "Burn";
+  const std::string planNodeId = "7";
+
+  CpuSampler::start(1'000);
+  ASSERT_TRUE(CpuSampler::isRunning());
+  {
+    ScopedThreadDebugInfo scopedInfo(info);
+    ScopedSampledOperator sampledOperator(operatorType, planNodeId);
+    // Uses about 300ms of CPU.
+    const auto end =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    volatile uint64_t n = 0;
+    while (std::chrono::steady_clock::now() < end) {
+      n = n + 1;
+    }
+  }
+  CpuSampler::stop();
+  ASSERT_FALSE(CpuSampler::isRunning());
+
+  const auto counts = CpuSampler::sampleCounts();
+  ASSERT_EQ(counts.count("query.1"), 1);
+  EXPECT_GT(counts.at("query.1"), 10);
+
+  const auto stacks = CpuSampler::foldedStacks("query.1");
+  EXPECT_EQ(stacks.rfind("task.1;7 Burn", 0), 0) << stacks;
+  EXPECT_EQ(CpuSampler::foldedStacks("query.2"), "");
+
+  CpuSampler::clear("query.1");
+  EXPECT_EQ(CpuSampler::sampleCounts().count("query.1"), 0);
+}
+
+} // namespace
+} // namespace facebook::velox::process
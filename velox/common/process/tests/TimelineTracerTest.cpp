@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/TimelineTracer.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(TimelineTracerTest, json) {
+  TimelineTracer tracer;
+  const auto track = tracer.addTrack("driver 0");
+  {
+    TimelineScope scope(&tracer, "call", "operator", "details");
+  }
+  std::thread([&]() {
+    TimelineScope scope(&tracer, "other thread", "operator");
+  }).join();
+  tracer.addTrackEvent(track, "blocked", "blocked", 100, 250);
+  TimelineScope noOp(nullptr, "not recorded", "operator");
+  ASSERT_EQ(tracer.numEvents(), 3);
+
+  const auto json = folly::parseJson(tracer.toJson());
+  const auto& events = json["traceEvents"];
+  // Names of the two processes and of the track, then the events.
+  ASSERT_EQ(events.size(), 6);
+  EXPECT_EQ(events[2]["ph"], "M");
+  EXPECT_EQ(events[2]["args"]["name"], "driver 0");
+
+  EXPECT_EQ(events[3]["name"], "call");
+  EXPECT_EQ(events[3]["cat"], "operator");
+  EXPECT_EQ(events[3]["ph"], "X");
+  EXPECT_EQ(events[3]["args"]["details"], "details");
+  EXPECT_NE(events[3]["tid"], events[4]["tid"]);
+  EXPECT_EQ(events[3]["pid"], events[4]["pid"]);
+
+  EXPECT_EQ(events[5]["name"], "blocked");
+  EXPECT_EQ(events[5]["ts"], 100);
+  EXPECT_EQ(events[5]["dur"], 150);
+  EXPECT_EQ(events[5]["tid"], track);
+  EXPECT_EQ(events[5]["pid"], events[2]["pid"]);
+  EXPECT_EQ(json["droppedEvents"], 0);
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/time/PerfCounters.h"
+
+#include <fmt/format.h>
+#include <memory>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox {
+
+std::string PerfCounterValues::toString() const {
+  return fmt::format(
+      "cycles: {}, instructions: {}, llcMisses: {}, dtlbMisses: {}",
+      cycles,
+      instructions,
+      llcMisses,
+      dtlbMisses);
+}
+
+#ifdef __linux__
+namespace {
+int32_t openEvent(uint32_t type, uint64_t config, int32_t groupFd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  // Counts the calling thread on any CPU.
+  return syscall(
+      __NR_perf_event_open, &attr, 0 /*pid*/, -1 /*cpu*/, groupFd, 0);
+}
+} // namespace
+
+PerfCounters::PerfCounters() {
+  const std::array<std::pair<uint32_t, uint64_t>, kNumEvents> events{{
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+      {PERF_TYPE_HW_CACHE,
+       PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+  }};
+  for (auto i = 0; i < kNumEvents; ++i) {
+    fds_[i] = openEvent(events[i].first, events[i].second, groupFd_);
+    if (fds_[i] >= 0) {
+      if (groupFd_ < 0) {
+        groupFd_ = fds_[i];
+      }
+      ++numOpened_;
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (auto fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+// static
+PerfCounters* PerfCounters::forThread() {
+  thread_local std::unique_ptr<PerfCounters> counters(new PerfCounters());
+  return counters->numOpened_ > 0 ? counters.get() : nullptr;
+}
+
+PerfCounterValues PerfCounters::read() const {
+  // PERF_FORMAT_GROUP returns the number of events followed by their values
+  // in the order the events were added to the group.
+  std::array<uint64_t, 1 + kNumEvents> buffer{};
+  if (::read(groupFd_, buffer.data(), sizeof(buffer)) <= 0) {
+    return {};
+  }
+  std::array<uint64_t, kNumEvents> values{};
+  int32_t position = 1;
+  for (auto i = 0; i < kNumEvents; ++i) {
+    if (fds_[i] >= 0) {
+      values[i] = buffer[position++];
+    }
+  }
+  return {values[0], values[1], values[2], values[3]};
+}
+#else
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+// static
+PerfCounters* PerfCounters::forThread() {
+  return nullptr;
+}
+
+PerfCounterValues PerfCounters::read() const {
+  return {};
+}
+#endif
+
+} // namespace facebook::velox
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace facebook::velox {
+
+// Hardware event counts of a thread.
+struct PerfCounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llcMisses = 0;
+  uint64_t dtlbMisses = 0;
+
+  PerfCounterValues operator-(const PerfCounterValues& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        llcMisses - other.llcMisses,
+        dtlbMisses - other.dtlbMisses};
+  }
+
+  std::string toString() const;
+};
+
+// Hardware counters of the calling thread, read with perf_event_open(2) on
+// Linux. The events are opened as one group so that they are scheduled on the
+// PMU together and read with a single read(2). Events that the kernel or the
+// hardware does not support read as 0.
+class PerfCounters {
+ public:
+  // Returns the counters of the calling thread, opened on first use. Returns
+  // nullptr if no event can be opened, e.g. off Linux or when
+  // perf_event_paranoid does not allow it.
+  static PerfCounters* forThread();
+
+  ~PerfCounters();
+
+  PerfCounterValues read() const;
+
+ private:
+  static constexpr int32_t kNumEvents = 4;
+
+  PerfCounters();
+
+  // File descriptor of each event. -1 if the event is not opened. The first
+  // opened event leads the group.
+  std::array<int32_t, kNumEvents> fds_;
+  int32_t groupFd_{-1};
+  int32_t numOpened_{0};
+};
+
+// Reads the counters of the calling thread at construction and at destruction
+// and passes the difference to 'func'.
+template <typename F>
+class DeltaPerfCounters {
+ public:
+  DeltaPerfCounters(PerfCounters& counters, F&& func)
+      : counters_(counters), start_(counters.read()), func_(std::move(func)) {}
+
+  ~DeltaPerfCounters() {
+    func_(counters_.read() - start_);
+  }
+
+ private:
+  const PerfCounters& counters_;
+  const PerfCounterValues start_;
+  F func_;
+};
+
+} // namespace facebook::velox
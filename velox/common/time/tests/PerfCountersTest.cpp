@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/time/PerfCounters.h"
+
+namespace facebook::velox::test {
+
+TEST(PerfCountersTest, delta) {
+  auto* counters = PerfCounters::forThread();
+  if (counters == nullptr) {
+    GTEST_SKIP() << "Perf events are not available";
+  }
+  ASSERT_EQ(counters, PerfCounters::forThread());
+
+  PerfCounterValues delta;
+  {
+    DeltaPerfCounters perfCounters(
+        *counters, [&](const PerfCounterValues& values) { delta = values; });
+    volatile uint64_t n = 0;
+    for (auto i = 0; i < 100'000; ++i) {
+      n = n + i;
+    }
+  }
+  // Some events may not be supported, but cycles and instructions are counted
+  // wherever perf events are available.
+  EXPECT_GT(delta.cycles, 0);
+  EXPECT_GT(delta.instructions, 100'000);
+}
+
+} // namespace facebook::velox::test
@@ -57,6 +57,15 @@ struct ConnectorSplit {
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  /// Returns a string that identifies the data read by this split, e.g. the
+  /// file, the byte range and the version of the file, or std::nullopt if the
+  /// data of the split may change between reads. Two splits with the same key
+  /// produce the same rows for the same table handle and columns. Used to cache
+  /// results computed over the split.
+  virtual std::optional<std::string> dataKey() const {
+    return std::nullopt;
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -143,6 +152,15 @@ class DataSink {
     uint64_t numWrittenBytes{0};
     uint32_t numWrittenFiles{0};
     common::SpillStats spillStats;
+    /// For a clustered table, the average fraction of the value range of a
+    /// clustering column in a file that a written batch covers. Lower is
+    /// better. 0 if the table is not clustered.
+    double clusteringSelectivity{0};
+    /// Number of times a file writer was flushed because the open writers
+    /// exceeded their memory limit.
+    uint64_t numMemoryFlushes{0};
+    /// Wall time spent closing the file writers in close().
+    uint64_t closeTimeUs{0};
 
     bool empty() const;
 
@@ -168,6 +186,24 @@ class DataSink {
   virtual void abort() = 0;
 };
 
+/// Describes an aggregation that directly consumes the output of a
+/// DataSource and whose result depends only on the number of rows, on the
+/// number of non-null values and the min and max of some columns and on the
+/// values of grouping keys. This is the case for count(*), count(x), min(x)
+/// and max(x). A DataSource may then return, for a split, rows that have the
+/// same such properties as the rows of the split instead of decoding them,
+/// e.g. rows made from the statistics of a file.
+struct StatisticsAggregation {
+  /// Output channels whose number of non-null values is used.
+  std::vector<column_index_t> countChannels;
+
+  /// Output channels whose number of non-null values, min and max are used.
+  std::vector<column_index_t> minMaxChannels;
+
+  /// Output channels that are grouping keys. Their values must be exact.
+  std::vector<column_index_t> groupingKeyChannels;
+};
+
 class DataSource {
  public:
   static constexpr int64_t kUnknownRowSize = -1;
@@ -196,6 +232,17 @@ class DataSource {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) = 0;
 
+  // Tells 'this' that at most 'numRows' rows of its output are used. Called
+  // before the first split is added. A DataSource may use this to read fewer
+  // rows.
+  virtual void setLimit(uint64_t /*numRows*/) {}
+
+  // Tells 'this' that its output is consumed by 'aggregation'. Called before
+  // the first split is added. A DataSource may ignore this and return the
+  // rows as they are.
+  virtual void setStatisticsAggregation(
+      const std::shared_ptr<const StatisticsAggregation>& /*aggregation*/) {}
+
   // Returns the number of input bytes processed so far.
   virtual uint64_t getCompletedBytes() = 0;
 
@@ -15,10 +15,89 @@
  */
 
 #include "velox/connectors/fuzzer/FuzzerConnector.h"
+#include "velox/functions/lib/ZetaDistribution.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 namespace facebook::velox::connector::fuzzer {
 
+namespace {
+// Draws keys from [0, numDistinctKeys) with a uniform or Zipf distribution.
+class KeyGenerator {
+ public:
+  KeyGenerator(const SyntheticLoadOptions& options, size_t seed)
+      : rng_(seed), uniform_(0, options.numDistinctKeys - 1) {
+    if (options.zipfExponent != 0) {
+      zipf_.emplace(options.zipfExponent, options.numDistinctKeys);
+    }
+  }
+
+  uint32_t next() {
+    if (zipf_.has_value()) {
+      return (*zipf_)(rng_) - 1;
+    }
+    return uniform_(rng_);
+  }
+
+  std::mt19937& rng() {
+    return rng_;
+  }
+
+ private:
+  std::mt19937 rng_;
+  std::uniform_int_distribution<uint32_t> uniform_;
+  std::optional<functions::ZetaDistribution> zipf_;
+};
+
+// Returns the string for 'key': its decimal digits padded to a length between
+// the string length bounds that depends on 'key'.
+std::string makeString(uint32_t key, const SyntheticLoadOptions& options) {
+  const uint64_t numLengths =
+      options.maxStringLength - options.minStringLength + 1;
+  const auto length = options.minStringLength +
+      ((key * 0x9E3779B97F4A7C15ULL) >> 32) % numLengths;
+  auto result = std::to_string(key);
+  if (result.size() < length) {
+    result.resize(length, static_cast<char>('a' + key % 26));
+  }
+  return result;
+}
+
+template <typename T>
+T valueForKey(uint32_t key, const SyntheticLoadOptions& /*options*/) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return key % 2 == 1;
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    return Timestamp(key, 0);
+  } else {
+    return static_cast<T>(key);
+  }
+}
+
+template <typename T>
+VectorPtr makeColumn(
+    const TypePtr& type,
+    const std::vector<uint32_t>& keys,
+    const std::vector<bool>& nulls,
+    const SyntheticLoadOptions& options,
+    memory::MemoryPool* pool) {
+  const auto size = keys.size();
+  auto column = BaseVector::create<FlatVector<T>>(type, size, pool);
+  for (auto row = 0; row < size; ++row) {
+    if (nulls[row]) {
+      column->setNull(row, true);
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = makeString(keys[row], options);
+      column->set(row, StringView(value));
+    } else {
+      column->set(row, valueForKey<T>(keys[row], options));
+    }
+  }
+  return column;
+}
+} // namespace
+
 FuzzerDataSource::FuzzerDataSource(
     const std::shared_ptr<const RowType>& outputType,
     const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
@@ -32,6 +111,101 @@ FuzzerDataSource::FuzzerDataSource(
 
   vectorFuzzer_ = std::make_unique<VectorFuzzer>(
       fuzzerTableHandle->fuzzerOptions, pool_, fuzzerTableHandle->fuzzerSeed);
+  if (fuzzerTableHandle->loadOptions.has_value()) {
+    makeSyntheticBatches(
+        fuzzerTableHandle->loadOptions.value(), fuzzerTableHandle->fuzzerSeed);
+  }
+}
+
+void FuzzerDataSource::makeSyntheticBatches(
+    const SyntheticLoadOptions& options,
+    size_t seed) {
+  VELOX_USER_CHECK_GT(options.numDistinctKeys, 0);
+  VELOX_USER_CHECK(
+      options.zipfExponent == 0 || options.zipfExponent > 1,
+      "Zipf exponent must be greater than 1: {}",
+      options.zipfExponent);
+  VELOX_USER_CHECK_LE(options.minStringLength, options.maxStringLength);
+  VELOX_USER_CHECK_GT(options.numBatches, 0);
+  VELOX_USER_CHECK_GT(options.batchSize, 0);
+
+  KeyGenerator keyGenerator(options, seed);
+  std::bernoulli_distribution isNull(options.nullRatio);
+  std::vector<uint32_t> keys(options.batchSize);
+  std::vector<bool> nulls(options.batchSize);
+  uint64_t totalBytes = 0;
+  syntheticBatches_.reserve(options.numBatches);
+  for (auto i = 0; i < options.numBatches; ++i) {
+    std::vector<VectorPtr> columns;
+    columns.reserve(outputType_->size());
+    for (const auto& type : outputType_->children()) {
+      for (auto row = 0; row < options.batchSize; ++row) {
+        keys[row] = keyGenerator.next();
+        nulls[row] = isNull(keyGenerator.rng());
+      }
+      switch (type->kind()) {
+        case TypeKind::BOOLEAN:
+          columns.push_back(
+              makeColumn<bool>(type, keys, nulls, options, pool_));
+          break;
+        case TypeKind::TINYINT:
+          columns.push_back(
+              makeColumn<int8_t>(type, keys, nulls, options, pool_));
+          break;
+        case TypeKind::SMALLINT:
+          columns.push_back(
+              makeColumn<int16_t>(type, keys, nulls, options, pool_));
+          break;
+        case TypeKind::INTEGER:
+          columns.push_back(
+              makeColumn<int32_t>(type, keys, nulls, options, pool_));
+          break;
+        case TypeKind::BIGINT:
+          columns.push_back(
+              makeColumn<int64_t>(type, keys, nulls, options, pool_));
+          break;
+        case TypeKind::REAL:
+          columns.push_back(
+              makeColumn<float>(type, keys, nulls, options, pool_));
+          break;
+        case TypeKind::DOUBLE:
+          columns.push_back(
+              makeColumn<double>(type, keys, nulls, options, pool_));
+          break;
+        case TypeKind::VARCHAR:
+        case TypeKind::VARBINARY:
+          columns.push_back(
+              makeColumn<StringView>(type, keys, nulls, options, pool_));
+          break;
+        case TypeKind::TIMESTAMP:
+          columns.push_back(
+              makeColumn<Timestamp>(type, keys, nulls, options, pool_));
+          break;
+        default:
+          columns.push_back(vectorFuzzer_->fuzz(type, options.batchSize));
+      }
+    }
+    auto batch = std::make_shared<RowVector>(
+        pool_, outputType_, nullptr, options.batchSize, std::move(columns));
+    totalBytes += batch->estimateFlatSize();
+    syntheticBatches_.push_back(std::move(batch));
+  }
+  const uint64_t numRows =
+      static_cast<uint64_t>(options.numBatches) * options.batchSize;
+  syntheticRowBytes_ = totalBytes / numRows;
+}
+
+RowVectorPtr FuzzerDataSource::nextSyntheticBatch(uint64_t size) {
+  const auto& batch = syntheticBatches_[batchIndex_];
+  const auto numRows = std::min<uint64_t>(size, batch->size() - batchOffset_);
+  auto result = std::static_pointer_cast<RowVector>(
+      batch->slice(batchOffset_, numRows));
+  batchOffset_ += numRows;
+  if (batchOffset_ == batch->size()) {
+    batchOffset_ = 0;
+    batchIndex_ = (batchIndex_ + 1) % syntheticBatches_.size();
+  }
+  return result;
 }
 
 void FuzzerDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
@@ -61,6 +235,17 @@ std::optional<RowVectorPtr> FuzzerDataSource::next(
   }
 
   const size_t outputRows = std::min(size, (splitEnd_ - splitOffset_));
+
+  if (!syntheticBatches_.empty()) {
+    // Slices share the buffers of the pre-generated batches, so their
+    // retained size would count the whole batches.
+    auto outputVector = nextSyntheticBatch(outputRows);
+    splitOffset_ += outputVector->size();
+    completedRows_ += outputVector->size();
+    completedBytes_ += outputVector->size() * syntheticRowBytes_;
+    return outputVector;
+  }
+
   splitOffset_ += outputRows;
 
   auto outputVector = vectorFuzzer_->fuzzRow(outputType_, outputRows);
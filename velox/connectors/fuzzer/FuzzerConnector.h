@@ -30,6 +30,38 @@ namespace facebook::velox::connector::fuzzer {
 ///
 /// FuzzerConnectorSplit lets clients specify how many rows are expected to be
 /// generated.
+///
+/// For performance tests, FuzzerTableHandle can instead specify
+/// SyntheticLoadOptions. The data source then generates a few batches when it
+/// is created and returns slices of them, so that generating data does not
+/// bottleneck the operators under test.
+
+/// Options for generating synthetic load. Each value is a function of a key
+/// drawn from [0, numDistinctKeys), which controls the cardinality and the
+/// skew seen by joins and aggregations. Columns of types other than boolean,
+/// integer, floating point, string and timestamp are generated by
+/// VectorFuzzer.
+struct SyntheticLoadOptions {
+  /// Number of distinct keys of each column.
+  uint32_t numDistinctKeys{1'000};
+
+  /// Exponent of the Zipf distribution of the keys, which must be greater
+  /// than 1. Keys are uniformly distributed if 0.
+  double zipfExponent{0};
+
+  /// Ratio of null values in each column.
+  double nullRatio{0};
+
+  /// Bounds of the length of strings. The length depends on the key. Strings
+  /// are no shorter than the decimal digits of their key.
+  uint32_t minStringLength{0};
+  uint32_t maxStringLength{16};
+
+  /// Number of pre-generated batches, which are returned in a cycle, and
+  /// number of rows in each.
+  uint32_t numBatches{16};
+  vector_size_t batchSize{10'000};
+};
 
 class FuzzerTableHandle : public ConnectorTableHandle {
  public:
@@ -41,6 +73,17 @@ class FuzzerTableHandle : public ConnectorTableHandle {
         fuzzerOptions(options),
         fuzzerSeed(fuzzerSeed) {}
 
+  FuzzerTableHandle(
+      std::string connectorId,
+      SyntheticLoadOptions loadOptions,
+      size_t fuzzerSeed = 0)
+      : ConnectorTableHandle(std::move(connectorId)),
+        fuzzerOptions{
+            .vectorSize = static_cast<size_t>(loadOptions.batchSize),
+            .nullRatio = loadOptions.nullRatio},
+        fuzzerSeed(fuzzerSeed),
+        loadOptions(loadOptions) {}
+
   ~FuzzerTableHandle() override {}
 
   std::string toString() const override {
@@ -49,6 +92,7 @@ class FuzzerTableHandle : public ConnectorTableHandle {
 
   const VectorFuzzer::Options fuzzerOptions;
   size_t fuzzerSeed;
+  const std::optional<SyntheticLoadOptions> loadOptions;
 };
 
 class FuzzerDataSource : public DataSource {
@@ -83,9 +127,25 @@ class FuzzerDataSource : public DataSource {
   }
 
  private:
+  // Generates the batches returned for SyntheticLoadOptions.
+  void makeSyntheticBatches(const SyntheticLoadOptions& options, size_t seed);
+
+  // Returns the next 'size' rows of the synthetic batches.
+  RowVectorPtr nextSyntheticBatch(uint64_t size);
+
   const RowTypePtr outputType_;
   std::unique_ptr<VectorFuzzer> vectorFuzzer_;
 
+  // Pre-generated batches for SyntheticLoadOptions. Empty when fuzzing.
+  std::vector<RowVectorPtr> syntheticBatches_;
+
+  // Estimated flat size of a row of the synthetic batches.
+  uint64_t syntheticRowBytes_{0};
+
+  // Position of the next row to return from 'syntheticBatches_'.
+  size_t batchIndex_{0};
+  vector_size_t batchOffset_{0};
+
   // The current split being processed.
   std::shared_ptr<FuzzerConnectorSplit> currentSplit_;
 
@@ -144,6 +144,94 @@ TEST_F(FuzzerConnectorTest, reproducible) {
   exec::test::assertEqualResults({results1}, {results2});
 }
 
+TEST_F(FuzzerConnectorTest, syntheticLoad) {
+  const size_t rowsPerSplit = 250;
+  const size_t numSplits = 4;
+  auto type = ROW({BIGINT(), VARCHAR(), DOUBLE(), ARRAY(INTEGER())});
+
+  SyntheticLoadOptions options;
+  options.numDistinctKeys = 10;
+  options.zipfExponent = 1.5;
+  options.nullRatio = 0.1;
+  options.minStringLength = 2;
+  options.maxStringLength = 8;
+  options.numBatches = 3;
+  options.batchSize = 100;
+
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(type)
+                  .tableHandle(makeSyntheticTableHandle(options))
+                  .endTableScan()
+                  .planNode();
+  auto result = exec::test::AssertQueryBuilder(plan)
+                    .splits(makeFuzzerSplits(rowsPerSplit, numSplits))
+                    .copyResults(pool());
+  ASSERT_EQ(result->size(), rowsPerSplit * numSplits);
+
+  auto* keys = result->childAt(0)->asFlatVector<int64_t>();
+  auto* strings = result->childAt(1)->asFlatVector<StringView>();
+  std::vector<int32_t> keyCounts(options.numDistinctKeys);
+  vector_size_t numNulls = 0;
+  for (auto row = 0; row < result->size(); ++row) {
+    if (keys->isNullAt(row)) {
+      ++numNulls;
+    } else {
+      const auto key = keys->valueAt(row);
+      ASSERT_GE(key, 0);
+      ASSERT_LT(key, options.numDistinctKeys);
+      ++keyCounts[key];
+    }
+    if (!strings->isNullAt(row)) {
+      const auto length = strings->valueAt(row).size();
+      ASSERT_GE(length, options.minStringLength);
+      ASSERT_LE(length, options.maxStringLength);
+    }
+  }
+  ASSERT_GT(numNulls, 0);
+  // Keys follow a Zipf distribution, so the smallest keys are the most
+  // frequent.
+  ASSERT_GT(keyCounts[0], keyCounts[options.numDistinctKeys - 1]);
+
+  // The batches are pre-generated and repeat after 'numBatches' batches.
+  const auto numBatchRows = options.numBatches * options.batchSize;
+  for (auto row = 0; row + numBatchRows < result->size(); ++row) {
+    ASSERT_TRUE(result->equalValueAt(result.get(), row, row + numBatchRows));
+  }
+}
+
+TEST_F(FuzzerConnectorTest, syntheticLoadUniform) {
+  auto type = ROW({INTEGER(), TIMESTAMP(), BOOLEAN()});
+
+  SyntheticLoadOptions options;
+  options.numDistinctKeys = 1'000;
+  options.batchSize = 64;
+  options.numBatches = 2;
+
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(type)
+                  .tableHandle(makeSyntheticTableHandle(options))
+                  .endTableScan()
+                  .planNode();
+  exec::test::AssertQueryBuilder(plan)
+      .split(makeFuzzerSplit(1'000))
+      .assertTypeAndNumRows(type, 1'000);
+
+  options.zipfExponent = 0.5;
+  plan = PlanBuilder()
+             .startTableScan()
+             .outputType(type)
+             .tableHandle(makeSyntheticTableHandle(options))
+             .endTableScan()
+             .planNode();
+  VELOX_ASSERT_THROW(
+      exec::test::AssertQueryBuilder(plan)
+          .split(makeFuzzerSplit(1'000))
+          .copyResults(pool()),
+      "Zipf exponent must be greater than 1: 0.5");
+}
+
 } // namespace facebook::velox::connector::fuzzer::test
 
 int main(int argc, char** argv) {
@@ -61,6 +61,13 @@ class FuzzerConnectorTestBase : public exec::test::OperatorTestBase {
         kFuzzerConnectorId, fuzzerOptions_, fuzzerSeed);
   }
 
+  std::shared_ptr<FuzzerTableHandle> makeSyntheticTableHandle(
+      const SyntheticLoadOptions& options,
+      size_t fuzzerSeed = 0) const {
+    return std::make_shared<FuzzerTableHandle>(
+        kFuzzerConnectorId, options, fuzzerSeed);
+  }
+
  private:
   VectorFuzzer::Options fuzzerOptions_;
 };
@@ -44,9 +44,16 @@ std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
     MicrosecondTimer timer(&elapsedTimeUs);
     fileHandle = std::make_shared<FileHandle>();
     fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename);
+                           ->openFileForRead(filename, fileOptions_);
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
+    if (metadataCache_ != nullptr) {
+      const auto version = fileHandle->file->getVersion();
+      if (!version.empty()) {
+        fileHandle->metadataCache = metadataCache_;
+        fileHandle->metadataKey = fmt::format("{}@{}", filename, version);
+      }
+    }
     VLOG(1) << "Generating file handle for: " << filename
             << " uuid: " << fileHandle->uuid.id();
   }
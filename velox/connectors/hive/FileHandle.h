@@ -27,7 +27,9 @@
 
 #include "velox/common/caching/CachedFactory.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/FileMetadataCache.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/FileSystems.h"
 
 namespace facebook::velox {
 
@@ -47,6 +49,15 @@ struct FileHandle {
   // example to decide placing on SSD.
   StringIdLease groupId;
 
+  // Cache of parsed footers shared by the readers of the file. nullptr if
+  // disabled.
+  cache::FileMetadataCache* metadataCache{nullptr};
+
+  // Key of the file in 'metadataCache', i.e. the path plus the version of
+  // the file. Empty if the version of the file is not known, in which case
+  // the metadata is not cached.
+  std::string metadataKey;
+
   // We'll want to have a hash map here to record the identifier->byte range
   // mappings. Different formats may have different identifiers, so we may need
   // a union of maps. For example in orc you need 3 integers (I think, to be
@@ -60,12 +71,20 @@ using FileHandleCache = SimpleLRUCache<std::string, FileHandle>;
 class FileHandleGenerator {
  public:
   FileHandleGenerator() {}
-  FileHandleGenerator(std::shared_ptr<const Config> properties)
-      : properties_(std::move(properties)) {}
+  FileHandleGenerator(
+      std::shared_ptr<const Config> properties,
+      cache::FileMetadataCache* metadataCache = nullptr,
+      filesystems::FileOptions fileOptions = {})
+      : properties_(std::move(properties)),
+        metadataCache_(metadataCache),
+        fileOptions_(std::move(fileOptions)) {}
   std::shared_ptr<FileHandle> operator()(const std::string& filename);
 
  private:
   const std::shared_ptr<const Config> properties_;
+  cache::FileMetadataCache* const metadataCache_{nullptr};
+  // Passed to FileSystem::openFileForRead().
+  const filesystems::FileOptions fileOptions_;
 };
 
 using FileHandleFactory = CachedFactory<
@@ -105,6 +105,27 @@ std::string HiveConfig::s3IAMRoleSessionName() const {
   return config_->get(kS3IamRoleSessionName, std::string("velox-session"));
 }
 
+uint32_t HiveConfig::s3MaxConnections() const {
+  return config_->get<uint32_t>(kS3MaxConnections, 25);
+}
+
+uint32_t HiveConfig::s3ReadThreads() const {
+  return config_->get<uint32_t>(kS3ReadThreads, 0);
+}
+
+uint64_t HiveConfig::s3ReadRangeSize() const {
+  return toCapacity(
+      config_->get<std::string>(kS3ReadRangeSize, "8MB"),
+      core::CapacityUnit::BYTE);
+}
+
+uint32_t HiveConfig::s3HedgePercentile() const {
+  const auto percentile = config_->get<uint32_t>(kS3HedgePercentile, 0);
+  VELOX_USER_CHECK_LT(
+      percentile, 100, "{} must be less than 100", kS3HedgePercentile);
+  return percentile;
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -117,6 +138,32 @@ std::string HiveConfig::gcsCredentials() const {
   return config_->get<std::string>(kGCSCredentials, std::string(""));
 }
 
+uint32_t HiveConfig::gcsUploadThreads() const {
+  return config_->get<uint32_t>(kGCSUploadThreads, 0);
+}
+
+uint64_t HiveConfig::gcsUploadBlockSize() const {
+  return toCapacity(
+      config_->get<std::string>(kGCSUploadBlockSize, "16MB"),
+      core::CapacityUnit::BYTE);
+}
+
+uint32_t HiveConfig::abfsUploadThreads() const {
+  return config_->get<uint32_t>(kAbfsUploadThreads, 0);
+}
+
+uint64_t HiveConfig::abfsUploadBlockSize() const {
+  return toCapacity(
+      config_->get<std::string>(kAbfsUploadBlockSize, "8MB"),
+      core::CapacityUnit::BYTE);
+}
+
+uint64_t HiveConfig::maxUploadBufferSize() const {
+  return toCapacity(
+      config_->get<std::string>(kMaxUploadBufferSize, "64MB"),
+      core::CapacityUnit::BYTE);
+}
+
 bool HiveConfig::isOrcUseColumnNames(const Config* session) const {
   return session->get<bool>(
       kOrcUseColumnNamesSession, config_->get<bool>(kOrcUseColumnNames, false));
@@ -136,6 +183,26 @@ bool HiveConfig::ignoreMissingFiles(const Config* session) const {
   return session->get<bool>(kIgnoreMissingFilesSession, false);
 }
 
+uint32_t HiveConfig::parallelColumnDecodingFactor(
+    const Config* session) const {
+  return session->get<uint32_t>(
+      kParallelColumnDecodingFactorSession,
+      config_->get<uint32_t>(kParallelColumnDecodingFactor, 0));
+}
+
+bool HiveConfig::fileStatisticsAggregationEnabled(
+    const Config* session) const {
+  return session->get<bool>(
+      kFileStatisticsAggregationEnabledSession,
+      config_->get<bool>(kFileStatisticsAggregationEnabled, false));
+}
+
+int32_t HiveConfig::minDictionaryRunLength(const Config* session) const {
+  return session->get<int32_t>(
+      kMinDictionaryRunLengthSession,
+      config_->get<int32_t>(kMinDictionaryRunLength, 0));
+}
+
 int64_t HiveConfig::maxCoalescedBytes() const {
   return config_->get<int64_t>(kMaxCoalescedBytes, 128 << 20);
 }
@@ -144,6 +211,10 @@ int32_t HiveConfig::maxCoalescedDistanceBytes() const {
   return config_->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+bool HiveConfig::adaptiveCoalesceEnabled() const {
+  return config_->get<bool>(kAdaptiveCoalesceEnabled, false);
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
@@ -160,6 +231,16 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+std::string HiveConfig::localFileReadMode() const {
+  return config_->get<std::string>(kLocalFileReadMode, "buffered");
+}
+
+uint64_t HiveConfig::fileMetadataCacheBytes() const {
+  return toCapacity(
+      config_->get<std::string>(kFileMetadataCacheBytes, "0B"),
+      core::CapacityUnit::BYTE);
+}
+
 uint64_t HiveConfig::orcWriterMaxStripeSize(const Config* session) const {
   return toCapacity(
       session->get<std::string>(
@@ -194,6 +275,29 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+uint64_t HiveConfig::maxTargetFileSize(const Config* session) const {
+  return toCapacity(
+      session->get<std::string>(
+          kMaxTargetFileSizeSession,
+          config_->get<std::string>(kMaxTargetFileSize, "0B")),
+      core::CapacityUnit::BYTE);
+}
+
+uint64_t HiveConfig::partitionedWritersMemoryLimit(
+    const Config* session) const {
+  return toCapacity(
+      session->get<std::string>(
+          kPartitionedWritersMemoryLimitSession,
+          config_->get<std::string>(kPartitionedWritersMemoryLimit, "0B")),
+      core::CapacityUnit::BYTE);
+}
+
+bool HiveConfig::parallelWriterClose(const Config* session) const {
+  return session->get<bool>(
+      kParallelWriterCloseSession,
+      config_->get<bool>(kParallelWriterClose, false));
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 1UL << 20);
 }
@@ -88,6 +88,22 @@ class HiveConfig {
   static constexpr const char* kS3IamRoleSessionName =
       "hive.s3.iam-role-session-name";
 
+  /// Maximum number of concurrent HTTP connections of an S3 file system.
+  static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
+
+  /// Number of threads of an S3 file system that issue the ranged GETs of
+  /// large reads. 0 reads on the calling thread.
+  static constexpr const char* kS3ReadThreads = "hive.s3.read-threads";
+
+  /// Reads larger than this are split into ranged GETs of this size that
+  /// run in parallel on the read threads.
+  static constexpr const char* kS3ReadRangeSize = "hive.s3.read-range-size";
+
+  /// Percentile of the recent latencies of ranged GETs after which a second
+  /// GET is issued for the same range. The first to finish is used. 0
+  /// disables hedging.
+  static constexpr const char* kS3HedgePercentile = "hive.s3.hedge-percentile";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -97,6 +113,29 @@ class HiveConfig {
   /// The GCS service account configuration as json string
   static constexpr const char* kGCSCredentials = "hive.gcs.credentials";
 
+  /// Number of threads of a GCS file system that upload the components of
+  /// the written objects in parallel. The components are composed into the
+  /// object on close. 0 streams each object from the writer thread.
+  static constexpr const char* kGCSUploadThreads = "hive.gcs.upload-threads";
+
+  /// Size of the components of the objects uploaded in parallel.
+  static constexpr const char* kGCSUploadBlockSize =
+      "hive.gcs.upload-block-size";
+
+  /// Number of threads of an ABFS file system that append the blocks of the
+  /// written files in parallel. 0 appends on the writer thread.
+  static constexpr const char* kAbfsUploadThreads = "hive.abfs.upload-threads";
+
+  /// Size of the blocks of the files appended in parallel.
+  static constexpr const char* kAbfsUploadBlockSize =
+      "hive.abfs.upload-block-size";
+
+  /// Maximum memory of a file written with parallel uploads for the blocks
+  /// being filled or uploaded. The memory is allocated from the writer's
+  /// pool. The writer waits for uploads to finish when the limit is reached.
+  static constexpr const char* kMaxUploadBufferSize =
+      "hive.max-upload-buffer-size";
+
   /// Maps table field names to file field names using names, not indices.
   // TODO: remove hive_orc_use_column_names since it doesn't exist in presto,
   // right now this is only used for testing.
@@ -116,6 +155,28 @@ class HiveConfig {
   static constexpr const char* kIgnoreMissingFilesSession =
       "ignore_missing_files";
 
+  /// Number of threads that decode the columns of a split in parallel on the
+  /// connector executor. 0 or 1 decodes them on the driver thread.
+  static constexpr const char* kParallelColumnDecodingFactor =
+      "parallel-column-decoding-factor";
+  static constexpr const char* kParallelColumnDecodingFactorSession =
+      "parallel_column_decoding_factor";
+
+  /// Whether count, min and max aggregations over a scan are answered from
+  /// the file statistics for the splits that need no filtering.
+  static constexpr const char* kFileStatisticsAggregationEnabled =
+      "file-statistics-aggregation-enabled";
+  static constexpr const char* kFileStatisticsAggregationEnabledSession =
+      "file_statistics_aggregation_enabled";
+
+  /// Minimum average length of the runs of equal consecutive values in a
+  /// batch of a scalar column for the reader to return the batch as a
+  /// dictionary over one value per run. 0 disables run detection.
+  static constexpr const char* kMinDictionaryRunLength =
+      "min-dictionary-run-length";
+  static constexpr const char* kMinDictionaryRunLengthSession =
+      "min_dictionary_run_length";
+
   /// The max coalesce bytes for a request.
   static constexpr const char* kMaxCoalescedBytes = "max-coalesced-bytes";
 
@@ -123,6 +184,12 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// Derive the coalesce distance and the number of prefetches in flight from
+  /// the latency and bandwidth measured for each file system instead of using
+  /// max-coalesced-distance-bytes.
+  static constexpr const char* kAdaptiveCoalesceEnabled =
+      "adaptive-coalesce-enabled";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
@@ -136,6 +203,15 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// How local files are read: "buffered", "mmap" or "direct". See
+  /// LocalReadFile::Mode.
+  static constexpr const char* kLocalFileReadMode = "local-file-read-mode";
+
+  /// Maximum size in bytes of the parsed file footers and Iceberg deletion
+  /// vectors cached across queries. 0 disables the cache.
+  static constexpr const char* kFileMetadataCacheBytes =
+      "file-metadata-cache-bytes";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -175,6 +251,28 @@ class HiveConfig {
   static constexpr const char* kSortWriterMaxOutputBytesSession =
       "sort_writer_max_output_bytes";
 
+  /// Size in bytes after which a file writer closes its file and continues
+  /// in a new file. Not applied to bucketed or sorted tables. 0 means no
+  /// limit.
+  static constexpr const char* kMaxTargetFileSize = "max-target-file-size";
+  static constexpr const char* kMaxTargetFileSizeSession =
+      "max_target_file_size";
+
+  /// Maximum memory used by the open file writers of a partitioned table
+  /// writer. When exceeded, the writers with the most buffered data are
+  /// flushed. 0 means no limit.
+  static constexpr const char* kPartitionedWritersMemoryLimit =
+      "partitioned-writers-memory-limit";
+  static constexpr const char* kPartitionedWritersMemoryLimitSession =
+      "partitioned_writers_memory_limit";
+
+  /// If true and the connector has an executor, a table writer closes its
+  /// file writers in parallel on the executor. Closing flushes the last
+  /// stripe, writes the footer and completes the upload of each file.
+  static constexpr const char* kParallelWriterClose = "parallel-writer-close";
+  static constexpr const char* kParallelWriterCloseSession =
+      "parallel_writer_close";
+
   static constexpr const char* kS3UseProxyFromEnv =
       "hive.s3.use-proxy-from-env";
 
@@ -203,12 +301,30 @@ class HiveConfig {
 
   std::string s3IAMRoleSessionName() const;
 
+  uint32_t s3MaxConnections() const;
+
+  uint32_t s3ReadThreads() const;
+
+  uint64_t s3ReadRangeSize() const;
+
+  uint32_t s3HedgePercentile() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
 
   std::string gcsCredentials() const;
 
+  uint32_t gcsUploadThreads() const;
+
+  uint64_t gcsUploadBlockSize() const;
+
+  uint32_t abfsUploadThreads() const;
+
+  uint64_t abfsUploadBlockSize() const;
+
+  uint64_t maxUploadBufferSize() const;
+
   bool isOrcUseColumnNames(const Config* session) const;
 
   bool isFileColumnNamesReadAsLowerCase(const Config* session) const;
@@ -217,10 +333,18 @@ class HiveConfig {
 
   bool ignoreMissingFiles(const Config* session) const;
 
+  uint32_t parallelColumnDecodingFactor(const Config* session) const;
+
+  bool fileStatisticsAggregationEnabled(const Config* session) const;
+
+  int32_t minDictionaryRunLength(const Config* session) const;
+
   int64_t maxCoalescedBytes() const;
 
   int32_t maxCoalescedDistanceBytes() const;
 
+  bool adaptiveCoalesceEnabled() const;
+
   int32_t prefetchRowGroups() const;
 
   int32_t loadQuantum() const;
@@ -229,6 +353,10 @@ class HiveConfig {
 
   bool isFileHandleCacheEnabled() const;
 
+  std::string localFileReadMode() const;
+
+  uint64_t fileMetadataCacheBytes() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   uint64_t orcWriterMaxStripeSize(const Config* session) const;
@@ -241,6 +369,12 @@ class HiveConfig {
 
   uint64_t sortWriterMaxOutputBytes(const Config* session) const;
 
+  uint64_t maxTargetFileSize(const Config* session) const;
+
+  uint64_t partitionedWritersMemoryLimit(const Config* session) const;
+
+  bool parallelWriterClose(const Config* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
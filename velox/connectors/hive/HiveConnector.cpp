@@ -57,13 +57,23 @@ HiveConnector::HiveConnector(
     folly::Executor* FOLLY_NULLABLE executor)
     : Connector(id),
       hiveConfig_(std::make_shared<HiveConfig>(config)),
+      fileMetadataCache_(
+          hiveConfig_->fileMetadataCacheBytes() > 0
+              ? std::make_unique<cache::FileMetadataCache>(
+                    hiveConfig_->fileMetadataCacheBytes())
+              : nullptr),
       fileHandleFactory_(
           hiveConfig_->isFileHandleCacheEnabled()
               ? std::make_unique<
                     SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(
                     hiveConfig_->numCacheFileHandles())
               : nullptr,
-          std::make_unique<FileHandleGenerator>(config)),
+          std::make_unique<FileHandleGenerator>(
+              config,
+              fileMetadataCache_.get(),
+              filesystems::FileOptions{
+                  {{filesystems::FileOptions::kLocalReadMode.str(),
+                    hiveConfig_->localFileReadMode()}}})),
       executor_(executor) {
   if (hiveConfig_->isFileHandleCacheEnabled()) {
     LOG(INFO) << "Hive connector " << connectorId()
@@ -106,7 +116,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
@@ -74,8 +74,17 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.clearCache();
   }
 
+  /// Returns the stats of the cache of parsed file footers. All 0 if the
+  /// cache is disabled.
+  cache::FileMetadataCacheStats fileMetadataCacheStats() const {
+    return fileMetadataCache_ ? fileMetadataCache_->stats()
+                              : cache::FileMetadataCacheStats{};
+  }
+
  protected:
   const std::shared_ptr<HiveConfig> hiveConfig_;
+  // Must be declared before 'fileHandleFactory_' whose generator refers to it.
+  const std::unique_ptr<cache::FileMetadataCache> fileMetadataCache_;
   FileHandleFactory fileHandleFactory_;
   folly::Executor* FOLLY_NULLABLE executor_;
 };
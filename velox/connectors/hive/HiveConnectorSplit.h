@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <map>
 #include <optional>
 #include <unordered_map>
 #include "velox/connectors/Connector.h"
@@ -39,6 +40,17 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   std::shared_ptr<std::string> extraFileInfo;
   std::unordered_map<std::string, std::string> serdeParameters;
 
+  /// Further small files read after this one by the same data source, in
+  /// order. Each has its own path, range and partition keys. Lets the
+  /// coordinator hand out one split for many small files, so that the per
+  /// split scheduling cost is paid once.
+  std::vector<std::shared_ptr<HiveConnectorSplit>> coalescedSplits;
+
+  /// Modification time of the file as reported by the coordinator. Splits
+  /// without it have no data key since a rewrite of the file in place would
+  /// not change the key.
+  std::optional<int64_t> fileModifiedTime;
+
   HiveConnectorSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -72,9 +84,49 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
           length,
           tableBucketNumber.value());
     }
+    if (!coalescedSplits.empty()) {
+      return fmt::format(
+          "Hive: {} {} - {} and {} more files",
+          filePath,
+          start,
+          length,
+          coalescedSplits.size());
+    }
     return fmt::format("Hive: {} {} - {}", filePath, start, length);
   }
 
+  std::optional<std::string> dataKey() const override {
+    if (!fileModifiedTime.has_value() || !coalescedSplits.empty()) {
+      return std::nullopt;
+    }
+    auto key = fmt::format(
+        "{} {} {} {} {}",
+        filePath,
+        start,
+        length,
+        fileModifiedTime.value(),
+        tableBucketNumber.has_value() ? tableBucketNumber.value() : -1);
+    // The maps are unordered, so their entries are sorted to make the key
+    // stable.
+    std::map<std::string, std::string> properties;
+    for (const auto& [name, value] : partitionKeys) {
+      properties["p:" + name] = value.has_value() ? "=" + value.value() : "";
+    }
+    for (const auto& [name, value] : customSplitInfo) {
+      properties["c:" + name] = value;
+    }
+    for (const auto& [name, value] : serdeParameters) {
+      properties["s:" + name] = value;
+    }
+    for (const auto& [name, value] : properties) {
+      key += fmt::format(" {}{}", name, value);
+    }
+    if (extraFileInfo != nullptr) {
+      key += " x:" + *extraFileInfo;
+    }
+    return key;
+  }
+
   std::string getFileName() const {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
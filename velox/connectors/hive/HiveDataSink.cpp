@@ -16,10 +16,12 @@
 
 #include "velox/connectors/hive/HiveDataSink.h"
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
 #include "velox/connectors/hive/TableHandle.h"
@@ -28,6 +30,7 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/SortBuffer.h"
 
+#include <folly/String.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -340,12 +343,28 @@ std::string HiveBucketProperty::toString() const {
   return out.str();
 }
 
+HiveClusteringProperty::HiveClusteringProperty(
+    Curve curve,
+    std::vector<std::string> clusteredBy)
+    : curve_(curve), clusteredBy_(std::move(clusteredBy)) {
+  VELOX_USER_CHECK(
+      !clusteredBy_.empty(), "Hive clustering columns must be set");
+}
+
+std::string HiveClusteringProperty::toString() const {
+  return fmt::format(
+      "HiveClusteringProperty[{} COLUMNS[{}]]",
+      dwio::common::ClusteringKeyEncoder::curveName(curve_),
+      folly::join(", ", clusteredBy_));
+}
+
 HiveDataSink::HiveDataSink(
     RowTypePtr inputType,
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* executor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -377,7 +396,16 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->spillConfig()) {
+      spillConfig_(connectorQueryCtx->spillConfig()),
+      writersMemoryLimit_(hiveConfig_->partitionedWritersMemoryLimit(
+          connectorQueryCtx->sessionProperties())),
+      maxTargetFileSize_(hiveConfig_->maxTargetFileSize(
+          connectorQueryCtx->sessionProperties())),
+      closeExecutor_(
+          hiveConfig_->parallelWriterClose(
+              connectorQueryCtx->sessionProperties())
+              ? executor
+              : nullptr) {
   VELOX_USER_CHECK(
       !isBucketed() || isPartitioned(), "A bucket table must be partitioned");
   if (isBucketed()) {
@@ -390,11 +418,26 @@ HiveDataSink::HiveDataSink(
       "Unsupported commit strategy: {}",
       commitStrategyToString(commitStrategy_));
 
+  if (const auto& clustering = insertTableHandle_->clusteringProperty()) {
+    const auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
+    for (const auto& column : clustering->clusteredBy()) {
+      const auto columnIndex = dataType->getChildIdxIfExists(column);
+      VELOX_USER_CHECK(
+          columnIndex.has_value(),
+          "Hive clustering column is not a data column: {}",
+          column);
+      clusteringColumnIndices_.push_back(columnIndex.value());
+    }
+  }
+
   if (!isBucketed()) {
     return;
   }
   const auto& sortedProperty = insertTableHandle_->bucketProperty()->sortedBy();
   if (!sortedProperty.empty()) {
+    VELOX_USER_CHECK(
+        clusteringColumnIndices_.empty(),
+        "A bucketed table can not be both sorted and clustered");
     sortColumnIndices_.reserve(sortedProperty.size());
     sortCompareFlags_.reserve(sortedProperty.size());
     for (int i = 0; i < sortedProperty.size(); ++i) {
@@ -459,6 +502,7 @@ void HiveDataSink::appendData(RowVectorPtr input) {
         : exec::wrap(partitionSize, partitionRows_[index], input);
     write(index, writerInput);
   }
+  maybeFlushLargestWriters();
 }
 
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
@@ -467,6 +511,66 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
 
   writers_[index]->write(dataInput);
   writerInfo_[index]->numWrittenRows += dataInput->size();
+  maybeRollWriter(index);
+}
+
+void HiveDataSink::maybeRollWriter(size_t index) {
+  // A bucket must be written to a single file. A sorted file is written at
+  // close.
+  if (maxTargetFileSize_ == 0 || isBucketed() || sortWrite()) {
+    return;
+  }
+  auto& info = *writerInfo_[index];
+  const auto fileSize =
+      ioStats_[index]->rawBytesWritten() - info.finishedFileBytes;
+  if (fileSize < maxTargetFileSize_) {
+    return;
+  }
+  {
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+    writers_[index]->close();
+    writers_[index].reset();
+  }
+  const auto closedFileSize =
+      ioStats_[index]->rawBytesWritten() - info.finishedFileBytes;
+  info.finishedFiles.push_back(
+      {info.writerParameters.writeFileName(),
+       info.writerParameters.targetFileName(),
+       closedFileSize});
+  info.finishedFileBytes += closedFileSize;
+  info.writerParameters =
+      getWriterParameters(info.writerParameters.partitionName(), std::nullopt);
+  writers_[index] = createWriter(index);
+}
+
+void HiveDataSink::maybeFlushLargestWriters() {
+  if (writersMemoryLimit_ == 0 || sortWrite()) {
+    return;
+  }
+  std::vector<std::pair<uint64_t, size_t>> writerBytes;
+  writerBytes.reserve(writers_.size());
+  uint64_t totalBytes = 0;
+  for (auto i = 0; i < writers_.size(); ++i) {
+    const auto bytes = writerInfo_[i]->writerPool->currentBytes();
+    totalBytes += bytes;
+    writerBytes.emplace_back(bytes, i);
+  }
+  if (totalBytes <= writersMemoryLimit_) {
+    return;
+  }
+  std::sort(writerBytes.begin(), writerBytes.end(), std::greater<>());
+  for (const auto& [bytes, index] : writerBytes) {
+    if (totalBytes <= writersMemoryLimit_ / 2) {
+      break;
+    }
+    {
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+      writers_[index]->flush();
+    }
+    ++writerInfo_[index]->numMemoryFlushes;
+    totalBytes -= bytes;
+    totalBytes += writerInfo_[index]->writerPool->currentBytes();
+  }
 }
 
 std::string HiveDataSink::stateString(State state) {
@@ -501,19 +605,29 @@ DataSink::Stats HiveDataSink::stats() const {
     numWrittenBytes += ioStats->rawBytesWritten();
   }
   stats.numWrittenBytes = numWrittenBytes;
+  for (const auto& info : writerInfo_) {
+    stats.numMemoryFlushes += info->numMemoryFlushes;
+  }
 
   if (state_ != State::kClosed) {
     return stats;
   }
 
   stats.numWrittenFiles = writers_.size();
+  for (const auto& info : writerInfo_) {
+    stats.numWrittenFiles += info->finishedFiles.size();
+  }
+  dwio::common::ClusteringStats clusteringStats;
   for (int i = 0; i < writerInfo_.size(); ++i) {
     const auto& info = writerInfo_.at(i);
     VELOX_CHECK_NOT_NULL(info);
     if (!info->spillStats->empty()) {
       stats.spillStats += *info->spillStats;
     }
+    clusteringStats += *info->clusteringStats;
   }
+  stats.clusteringSelectivity = clusteringStats.selectivity();
+  stats.closeTimeUs = closeTimeUs_;
   return stats;
 }
 
@@ -569,6 +683,17 @@ std::vector<std::string> HiveDataSink::close() {
   for (int i = 0; i < writerInfo_.size(); ++i) {
     const auto& info = writerInfo_.at(i);
     VELOX_CHECK_NOT_NULL(info);
+    auto fileWriteInfos = folly::dynamic::array();
+    for (const auto& file : info->finishedFiles) {
+      fileWriteInfos.push_back(folly::dynamic::object(
+          "writeFileName", file.writeFileName)(
+          "targetFileName", file.targetFileName)("fileSize", file.fileSize));
+    }
+    fileWriteInfos.push_back(folly::dynamic::object(
+        "writeFileName", info->writerParameters.writeFileName())(
+        "targetFileName", info->writerParameters.targetFileName())(
+        "fileSize",
+        ioStats_.at(i)->rawBytesWritten() - info->finishedFileBytes));
     // clang-format off
       auto partitionUpdateJson = folly::toJson(
        folly::dynamic::object
@@ -578,11 +703,7 @@ std::vector<std::string> HiveDataSink::close() {
               info->writerParameters.updateMode()))
           ("writePath", info->writerParameters.writeDirectory())
           ("targetPath", info->writerParameters.targetDirectory())
-          ("fileWriteInfos", folly::dynamic::array(
-            folly::dynamic::object
-              ("writeFileName", info->writerParameters.writeFileName())
-              ("targetFileName", info->writerParameters.targetFileName())
-              ("fileSize", ioStats_.at(i)->rawBytesWritten())))
+          ("fileWriteInfos", std::move(fileWriteInfos))
           ("rowCount", info->numWrittenRows)
          // TODO(gaoge): track and send the fields when inMemoryDataSizeInBytes
          // and containsNumberedFileNames are needed at coordinator when file_renaming_enabled are turned on.
@@ -601,6 +722,42 @@ void HiveDataSink::abort() {
   closeInternal();
 }
 
+void HiveDataSink::closeWriters() {
+  if (closeExecutor_ == nullptr || writers_.size() < 2) {
+    for (int i = 0; i < writers_.size(); ++i) {
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
+      writers_[i]->close();
+    }
+    return;
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> closes;
+  closes.reserve(writers_.size());
+  for (int i = 0; i < writers_.size(); ++i) {
+    closes.push_back(std::make_shared<AsyncSource<bool>>([this, i]() {
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
+      writers_[i]->close();
+      return std::make_unique<bool>(true);
+    }));
+    closeExecutor_->add([source = closes.back()]() { source->prepare(); });
+  }
+  // All the closes must finish before the writers can be freed or aborted,
+  // also if one fails.
+  std::exception_ptr error;
+  for (auto& close : closes) {
+    try {
+      close->move();
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 void HiveDataSink::closeInternal() {
   VELOX_CHECK_NE(state_, State::kRunning);
 
@@ -608,10 +765,8 @@ void HiveDataSink::closeInternal() {
       "facebook::velox::connector::hive::HiveDataSink::closeInternal", this);
 
   if (state_ == State::kClosed) {
-    for (int i = 0; i < writers_.size(); ++i) {
-      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
-      writers_[i]->close();
-    }
+    MicrosecondTimer timer(&closeTimeUs_);
+    closeWriters();
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
@@ -644,8 +799,6 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Without explicitly setting flush policy, the default memory based flush
   // policy is used.
   auto writerParameters = getWriterParameters(partitionName, id.bucketId);
-  const auto writePath = fs::path(writerParameters.writeDirectory()) /
-      writerParameters.writeFileName();
   auto writerPool = createWriterPool(id);
   auto sinkPool = createSinkPool(writerPool);
   std::shared_ptr<memory::MemoryPool> sortPool{nullptr};
@@ -658,19 +811,34 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       std::move(sinkPool),
       std::move(sortPool)));
   setMemoryReclaimers(writerInfo_.back().get());
+  ioStats_.emplace_back(std::make_shared<io::IoStatistics>());
 
+  writers_.emplace_back(createWriter(writers_.size()));
+  // Extends the buffer used for partition rows calculations.
+  partitionSizes_.emplace_back(0);
+  partitionRows_.emplace_back(nullptr);
+  rawPartitionRows_.emplace_back(nullptr);
+
+  writerIndexMap_.emplace(id, writers_.size() - 1);
+  return writerIndexMap_[id];
+}
+
+std::unique_ptr<dwio::common::Writer> HiveDataSink::createWriter(
+    size_t index) {
+  const auto& info = writerInfo_[index];
+  const auto writePath = fs::path(info->writerParameters.writeDirectory()) /
+      info->writerParameters.writeFileName();
   dwio::common::WriterOptions options;
   const auto* connectorSessionProperties =
       connectorQueryCtx_->sessionProperties();
   options.schema = getNonPartitionTypes(dataChannels_, inputType_);
 
-  options.memoryPool = writerInfo_.back()->writerPool.get();
+  options.memoryPool = info->writerPool.get();
   options.compressionKind = insertTableHandle_->compressionKind();
   if (canReclaim()) {
     options.spillConfig = spillConfig_;
   }
-  options.nonReclaimableSection =
-      writerInfo_.back()->nonReclaimableSectionHolder.get();
+  options.nonReclaimableSection = info->nonReclaimableSectionHolder.get();
   options.maxStripeSize = std::optional(
       hiveConfig_->orcWriterMaxStripeSize(connectorSessionProperties));
   options.maxDictionaryMemory = std::optional(
@@ -678,29 +846,20 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   options.serdeParameters = std::map<std::string, std::string>(
       insertTableHandle_->serdeParameters().begin(),
       insertTableHandle_->serdeParameters().end());
-  ioStats_.emplace_back(std::make_shared<io::IoStatistics>());
 
   // Prevents the memory allocation during the writer creation.
-  WRITER_NON_RECLAIMABLE_SECTION_GUARD(writerInfo_.size() - 1);
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto writer = writerFactory_->createWriter(
       dwio::common::FileSink::create(
           writePath,
           {.bufferWrite = false,
            .connectorProperties = hiveConfig_->config(),
            .fileCreateConfig = hiveConfig_->writeFileCreateConfig(),
-           .pool = writerInfo_.back()->sinkPool.get(),
+           .pool = info->sinkPool.get(),
            .metricLogger = dwio::common::MetricsLog::voidLog(),
-           .stats = ioStats_.back().get()}),
+           .stats = ioStats_[index].get()}),
       options);
-  writer = maybeCreateBucketSortWriter(std::move(writer));
-  writers_.emplace_back(std::move(writer));
-  // Extends the buffer used for partition rows calculations.
-  partitionSizes_.emplace_back(0);
-  partitionRows_.emplace_back(nullptr);
-  rawPartitionRows_.emplace_back(nullptr);
-
-  writerIndexMap_.emplace(id, writers_.size() - 1);
-  return writerIndexMap_[id];
+  return maybeCreateBucketSortWriter(std::move(writer));
 }
 
 std::unique_ptr<facebook::velox::dwio::common::Writer>
@@ -711,6 +870,9 @@ HiveDataSink::maybeCreateBucketSortWriter(
   }
   auto* sortPool = writerInfo_.back()->sortPool.get();
   VELOX_CHECK_NOT_NULL(sortPool);
+  if (!clusteringColumnIndices_.empty()) {
+    return createClusteringWriter(std::move(writer));
+  }
   auto sortBuffer = std::make_unique<exec::SortBuffer>(
       getNonPartitionTypes(dataChannels_, inputType_),
       sortColumnIndices_,
@@ -728,6 +890,36 @@ HiveDataSink::maybeCreateBucketSortWriter(
       writerInfo_.back()->spillStats.get());
 }
 
+std::unique_ptr<facebook::velox::dwio::common::Writer>
+HiveDataSink::createClusteringWriter(
+    std::unique_ptr<facebook::velox::dwio::common::Writer> writer) {
+  const auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
+  auto clusteringKeys = std::make_unique<dwio::common::ClusteringKeyEncoder>(
+      insertTableHandle_->clusteringProperty()->curve(),
+      dataType,
+      clusteringColumnIndices_);
+  // Sorts on the clustering keys appended to the data columns.
+  const column_index_t keyColumn = dataType->size();
+  auto sortBuffer = std::make_unique<exec::SortBuffer>(
+      dwio::common::SortingWriter::clusteringSortType(dataType),
+      std::vector<column_index_t>{keyColumn},
+      std::vector<CompareFlags>{
+          {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue}},
+      writerInfo_.back()->sortPool.get(),
+      writerInfo_.back()->nonReclaimableSectionHolder.get(),
+      spillConfig_);
+  return std::make_unique<dwio::common::SortingWriter>(
+      std::move(writer),
+      std::move(sortBuffer),
+      hiveConfig_->sortWriterMaxOutputRows(
+          connectorQueryCtx_->sessionProperties()),
+      hiveConfig_->sortWriterMaxOutputBytes(
+          connectorQueryCtx_->sessionProperties()),
+      writerInfo_.back()->spillStats.get(),
+      std::move(clusteringKeys),
+      writerInfo_.back()->clusteringStats.get());
+}
+
 void HiveDataSink::splitInputRowsAndEnsureWriters() {
   VELOX_CHECK(isPartitioned());
   if (isBucketed()) {
@@ -19,6 +19,7 @@
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/PartitionIdGenerator.h"
+#include "velox/dwio/common/ClusteringKeyEncoder.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
@@ -183,6 +184,32 @@ FOLLY_ALWAYS_INLINE std::ostream& operator<<(
   return os;
 }
 
+/// Clusters the rows of each written file on several columns by sorting them
+/// on a space-filling curve over the columns, so that the min/max statistics
+/// of the file prune multi-column filters. A bucketed table can not be both
+/// sorted and clustered.
+class HiveClusteringProperty {
+ public:
+  using Curve = dwio::common::ClusteringKeyEncoder::Curve;
+
+  HiveClusteringProperty(Curve curve, std::vector<std::string> clusteredBy);
+
+  Curve curve() const {
+    return curve_;
+  }
+
+  /// Returns the clustering column names.
+  const std::vector<std::string>& clusteredBy() const {
+    return clusteredBy_;
+  }
+
+  std::string toString() const;
+
+ private:
+  const Curve curve_;
+  const std::vector<std::string> clusteredBy_;
+};
+
 class HiveInsertTableHandle;
 using HiveInsertTableHandlePtr = std::shared_ptr<HiveInsertTableHandle>;
 
@@ -198,13 +225,16 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
           dwio::common::FileFormat::DWRF,
       std::shared_ptr<HiveBucketProperty> bucketProperty = nullptr,
       std::optional<common::CompressionKind> compressionKind = {},
-      const std::unordered_map<std::string, std::string>& serdeParameters = {})
+      const std::unordered_map<std::string, std::string>& serdeParameters = {},
+      std::shared_ptr<const HiveClusteringProperty> clusteringProperty =
+          nullptr)
       : inputColumns_(std::move(inputColumns)),
         locationHandle_(std::move(locationHandle)),
         tableStorageFormat_(tableStorageFormat),
         bucketProperty_(std::move(bucketProperty)),
         compressionKind_(compressionKind),
-        serdeParameters_(serdeParameters) {
+        serdeParameters_(serdeParameters),
+        clusteringProperty_(std::move(clusteringProperty)) {
     if (compressionKind.has_value()) {
       VELOX_CHECK(
           compressionKind.value() != common::CompressionKind_MAX,
@@ -245,6 +275,11 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
 
   const HiveBucketProperty* bucketProperty() const;
 
+  const std::shared_ptr<const HiveClusteringProperty>& clusteringProperty()
+      const {
+    return clusteringProperty_;
+  }
+
   bool isInsertTable() const;
 
   folly::dynamic serialize() const override;
@@ -262,6 +297,7 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
   const std::shared_ptr<HiveBucketProperty> bucketProperty_;
   const std::optional<common::CompressionKind> compressionKind_;
   const std::unordered_map<std::string, std::string> serdeParameters_;
+  const std::shared_ptr<const HiveClusteringProperty> clusteringProperty_;
 };
 
 /// Parameters for Hive writers.
@@ -356,19 +392,36 @@ struct HiveWriterInfo {
       : writerParameters(std::move(parameters)),
         nonReclaimableSectionHolder(new tsan_atomic<bool>(false)),
         spillStats(new common::SpillStats()),
+        clusteringStats(new dwio::common::ClusteringStats()),
         writerPool(std::move(_writerPool)),
         sinkPool(std::move(_sinkPool)),
         sortPool(std::move(_sortPool)) {}
 
-  const HiveWriterParameters writerParameters;
+  /// A file that the writer has finished before continuing in a new file.
+  struct FileInfo {
+    std::string writeFileName;
+    std::string targetFileName;
+    uint64_t fileSize;
+  };
+
+  /// Describes the file being written.
+  HiveWriterParameters writerParameters;
+  /// Files finished because they reached the target file size.
+  std::vector<FileInfo> finishedFiles;
+  /// Bytes written to 'finishedFiles'.
+  uint64_t finishedFileBytes = 0;
   const std::unique_ptr<tsan_atomic<bool>> nonReclaimableSectionHolder;
   /// Collects the spill stats from sort writer if the spilling has been
   /// triggered.
   const std::unique_ptr<common::SpillStats> spillStats;
+  /// Measures the clustering of the written file if the table is clustered.
+  const std::unique_ptr<dwio::common::ClusteringStats> clusteringStats;
   const std::shared_ptr<memory::MemoryPool> writerPool;
   const std::shared_ptr<memory::MemoryPool> sinkPool;
   const std::shared_ptr<memory::MemoryPool> sortPool;
   int64_t numWrittenRows = 0;
+  /// Number of flushes to bound the memory of the open writers.
+  uint64_t numMemoryFlushes = 0;
 };
 
 /// Identifies a hive writer.
@@ -416,7 +469,8 @@ class HiveDataSink : public DataSink {
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* executor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -474,7 +528,7 @@ class HiveDataSink : public DataSink {
   };
 
   FOLLY_ALWAYS_INLINE bool sortWrite() const {
-    return !sortColumnIndices_.empty();
+    return !sortColumnIndices_.empty() || !clusteringColumnIndices_.empty();
   }
 
   // Returns true if the table is partitioned.
@@ -513,10 +567,23 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Creates the file writer for the file described by the writer info at
+  // 'index'.
+  std::unique_ptr<dwio::common::Writer> createWriter(size_t index);
+
+  // Closes the file of the writer at 'index' and continues in a new file if
+  // the file reached 'maxTargetFileSize_'.
+  void maybeRollWriter(size_t index);
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
 
+  // Wraps 'writer' to sort the rows on the clustering keys.
+  std::unique_ptr<facebook::velox::dwio::common::Writer>
+  createClusteringWriter(
+      std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
+
   HiveWriterParameters getWriterParameters(
       const std::optional<std::string>& partition,
       std::optional<uint32_t> bucketId) const;
@@ -540,8 +607,17 @@ class HiveDataSink : public DataSink {
   // Invoked to write 'input' to the specified file writer.
   void write(size_t index, RowVectorPtr input);
 
+  // Flushes the writers with the most memory if the writers use more than
+  // 'writersMemoryLimit_'. Flushes until the usage is below half of the limit
+  // so that the next inputs do not flush again right away.
+  void maybeFlushLargestWriters();
+
   void closeInternal();
 
+  // Closes all 'writers_', in parallel on 'closeExecutor_' if set. Waits for
+  // all to finish and throws the first error.
+  void closeWriters();
+
   const RowTypePtr inputType_;
   const std::shared_ptr<const HiveInsertTableHandle> insertTableHandle_;
   const ConnectorQueryCtx* const connectorQueryCtx_;
@@ -556,12 +632,22 @@ class HiveDataSink : public DataSink {
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
+  const uint64_t writersMemoryLimit_;
+  const uint64_t maxTargetFileSize_;
+  // Executor for closing the writers in parallel. Null if they are closed one
+  // at a time on the calling thread.
+  folly::Executor* const closeExecutor_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
+  // Indices of the clustering columns in the data columns.
+  std::vector<column_index_t> clusteringColumnIndices_;
 
   State state_{State::kRunning};
 
+  // Wall time of closing the writers.
+  uint64_t closeTimeUs_{0};
+
   tsan_atomic<bool> nonReclaimableSection_{false};
 
   // The map from writer id to the writer index in 'writers_' and 'writerInfo_'.
@@ -39,6 +39,25 @@ core::CallTypedExprPtr replaceInputs(
       call->type(), std::move(inputs), call->name());
 }
 
+// Returns the number of values rejected by 'filter' if this is a Bloom filter.
+uint64_t bloomFilterRejectedRows(const common::Filter* filter) {
+  if (filter == nullptr ||
+      filter->kind() != common::FilterKind::kBloomFilterValues) {
+    return 0;
+  }
+  return static_cast<const common::BloomFilterValues*>(filter)->numRejected();
+}
+
+// Returns the number of values rejected by the Bloom filters on the top level
+// fields of 'scanSpec'.
+uint64_t bloomFilterRejectedRows(const common::ScanSpec& scanSpec) {
+  uint64_t numRejected = 0;
+  for (const auto& child : scanSpec.children()) {
+    numRejected += bloomFilterRejectedRows(child->filter());
+  }
+  return numRejected;
+}
+
 } // namespace
 
 core::TypedExprPtr HiveDataSource::extractFiltersFromRemainingFilter(
@@ -207,6 +226,13 @@ HiveDataSource::HiveDataSource(
       hiveTableHandle_->dataColumns(),
       partitionKeys_,
       pool_);
+  if (const auto minRunLength = hiveConfig_->minDictionaryRunLength(
+          connectorQueryCtx->sessionProperties());
+      minRunLength > 0) {
+    for (auto& child : scanSpec_->children()) {
+      child->setMinDictionaryRunLength(minRunLength);
+    }
+  }
   if (remainingFilter) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
@@ -226,7 +252,8 @@ std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
       executor_,
       connectorQueryCtx_,
       hiveConfig_,
-      ioStats_);
+      ioStats_,
+      &equalityDeleteCache_);
 }
 
 void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
@@ -238,11 +265,21 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   VLOG(1) << "Adding split " << split_->toString();
 
+  coalescedSplits_ = split_->coalescedSplits;
+  nextCoalescedSplit_ = 0;
+  prefetchNextFileHandle();
   if (splitReader_) {
     splitReader_.reset();
   }
+  openSplit();
+}
 
+void HiveDataSource::openSplit() {
   splitReader_ = createSplitReader();
+  splitReader_->setAdaptationCache(&adaptationCache_);
+  if (statisticsAggregation_) {
+    splitReader_->setStatisticsAggregation(statisticsAggregation_);
+  }
   // Split reader subclasses may need to use the reader options in prepareSplit
   // so we initialize it beforehand.
   splitReader_->configureReaderOptions();
@@ -255,6 +292,9 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
 
   if (splitReader_ && splitReader_->emptySplit()) {
+    if (nextCoalescedSplit()) {
+      return getEmptyOutput();
+    }
     resetSplit();
     return nullptr;
   }
@@ -267,6 +307,12 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   // any column, e.g. rand() < 0.1. Evaluate that conjunct first, then scan
   // only rows that passed.
 
+  if (remainingLimit_.has_value() && remainingFilterExprSet_ == nullptr &&
+      !scanSpec_->hasFilter()) {
+    // Each row read is returned. A batch of 0 rows would end the split.
+    size = std::max<uint64_t>(1, std::min(size, remainingLimit_.value()));
+  }
+
   auto rowsScanned = splitReader_->next(size, output_);
   completedRows_ += rowsScanned;
 
@@ -300,6 +346,11 @@ std::optional<RowVectorPtr> HiveDataSource::next(
       }
     }
 
+    if (remainingLimit_.has_value()) {
+      remainingLimit_ = remainingLimit_.value() -
+          std::min<uint64_t>(remainingLimit_.value(), rowsRemaining);
+    }
+
     if (outputType_->size() == 0) {
       return exec::wrap(rowsRemaining, remainingIndices, rowVector);
     }
@@ -322,14 +373,52 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   }
 
   splitReader_->updateRuntimeStats(runtimeStats_);
+  if (nextCoalescedSplit()) {
+    return getEmptyOutput();
+  }
   resetSplit();
   return nullptr;
 }
 
+bool HiveDataSource::nextCoalescedSplit() {
+  if (nextCoalescedSplit_ >= coalescedSplits_.size()) {
+    return false;
+  }
+  split_ = coalescedSplits_[nextCoalescedSplit_++];
+  VLOG(1) << "Reading coalesced split " << split_->toString();
+  prefetchNextFileHandle();
+  splitReader_.reset();
+  openSplit();
+  return true;
+}
+
+void HiveDataSource::prefetchNextFileHandle() {
+  // Without a cache the handle would be opened twice.
+  if (executor_ == nullptr || fileHandleFactory_->maxSize() == 0 ||
+      nextCoalescedSplit_ >= coalescedSplits_.size()) {
+    return;
+  }
+  executor_->add(
+      [factory = fileHandleFactory_,
+       path = coalescedSplits_[nextCoalescedSplit_]->filePath]() {
+        try {
+          factory->generate(path);
+        } catch (const std::exception& e) {
+          // The error is raised again when the file is opened for reading.
+          VLOG(1) << "Failed to open " << path << ": " << e.what();
+        }
+      });
+}
+
 void HiveDataSource::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
+  // The merged filter counts its rejected rows from 0.
+  bloomFilterRejectedRows_ += bloomFilterRejectedRows(fieldSpec.filter());
+  if (filter->kind() == common::FilterKind::kBloomFilterValues) {
+    hasBloomFilter_ = true;
+  }
   fieldSpec.addFilter(*filter);
   scanSpec_->resetCachedValues(true);
   if (splitReader_) {
@@ -337,6 +426,16 @@ void HiveDataSource::addDynamicFilter(
   }
 }
 
+void HiveDataSource::setStatisticsAggregation(
+    const std::shared_ptr<const StatisticsAggregation>& aggregation) {
+  // A remaining filter needs the values of the rows.
+  if (remainingFilterExprSet_ == nullptr &&
+      hiveConfig_->fileStatisticsAggregationEnabled(
+          connectorQueryCtx_->sessionProperties())) {
+    statisticsAggregation_ = aggregation;
+  }
+}
+
 std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
   auto res = runtimeStats_.toMap();
   res.insert(
@@ -374,6 +473,30 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
         RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+  if (ioStats_->localBytesRead() + ioStats_->remoteBytesRead() > 0) {
+    res.insert(
+        {{"localReadBytes",
+          RuntimeCounter(
+              ioStats_->localBytesRead(), RuntimeCounter::Unit::kBytes)},
+         {"remoteReadBytes",
+          RuntimeCounter(
+              ioStats_->remoteBytesRead(), RuntimeCounter::Unit::kBytes)}});
+  }
+  if (ioStats_->adaptiveCoalesceDistance().count() > 0) {
+    res.insert(
+        {{"adaptiveCoalesceDistance",
+          RuntimeCounter(
+              ioStats_->adaptiveCoalesceDistance().max(),
+              RuntimeCounter::Unit::kBytes)},
+         {"adaptivePrefetchDepth",
+          RuntimeCounter(ioStats_->adaptivePrefetchDepth().max())}});
+  }
+  if (hasBloomFilter_) {
+    res.insert(
+        {"bloomFilterRejectedRows",
+         RuntimeCounter(
+             bloomFilterRejectedRows_ + bloomFilterRejectedRows(*scanSpec_))});
+  }
   return res;
 }
 
@@ -383,14 +506,23 @@ void HiveDataSource::setFromDataSource(
   VELOX_CHECK(source, "Bad DataSource type");
 
   split_ = std::move(source->split_);
-  if (source->splitReader_ && source->splitReader_->emptySplit()) {
+  coalescedSplits_ = std::move(source->coalescedSplits_);
+  nextCoalescedSplit_ = source->nextCoalescedSplit_;
+  if (source->splitReader_ && source->splitReader_->emptySplit() &&
+      nextCoalescedSplit_ >= coalescedSplits_.size()) {
     runtimeStats_.skippedSplits += source->runtimeStats_.skippedSplits;
     runtimeStats_.skippedSplitBytes += source->runtimeStats_.skippedSplitBytes;
     return;
   }
   source->scanSpec_->moveAdaptationFrom(*scanSpec_);
+  hasBloomFilter_ |= source->hasBloomFilter_;
+  bloomFilterRejectedRows_ += source->bloomFilterRejectedRows_ +
+      bloomFilterRejectedRows(*scanSpec_);
   scanSpec_ = std::move(source->scanSpec_);
   splitReader_ = std::move(source->splitReader_);
+  if (splitReader_) {
+    splitReader_->setAdaptationCache(&adaptationCache_);
+  }
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
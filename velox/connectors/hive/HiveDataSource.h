@@ -21,6 +21,7 @@
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/SplitReader.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/dwio/common/Statistics.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
@@ -54,6 +55,13 @@ class HiveDataSource : public DataSource {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  void setLimit(uint64_t numRows) override {
+    remainingLimit_ = numRows;
+  }
+
+  void setStatisticsAggregation(
+      const std::shared_ptr<const StatisticsAggregation>& aggregation) override;
+
   uint64_t getCompletedBytes() override {
     return ioStats_->rawBytesRead();
   }
@@ -106,6 +114,12 @@ class HiveDataSource : public DataSource {
   const std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<io::IoStatistics> ioStats_;
 
+  // The Iceberg equality deletes read by the splits of 'this'.
+  iceberg::EqualityDeleteCache equalityDeleteCache_;
+
+  // The constants and column types the splits of 'this' are adapted with.
+  SplitAdaptationCache adaptationCache_;
+
  private:
   // Evaluates remainingFilter_ on the specified vector. Returns number of rows
   // passed. Populates filterEvalCtx_.selectedIndices and selectedBits if only
@@ -117,6 +131,17 @@ class HiveDataSource : public DataSource {
   // hold adaptation.
   void resetSplit();
 
+  // Creates and prepares 'splitReader_' for the file of 'split_'.
+  void openSplit();
+
+  // Moves to the next file of 'coalescedSplits_'. Returns false if there is
+  // none.
+  bool nextCoalescedSplit();
+
+  // Opens the handle of the next coalesced file on 'executor_' so that the
+  // open overlaps with reading the current file.
+  void prefetchNextFileHandle();
+
   const RowVectorPtr& getEmptyOutput() {
     if (!emptyOutput_) {
       emptyOutput_ = RowVector::createEmpty(outputType_, pool_);
@@ -128,11 +153,26 @@ class HiveDataSource : public DataSource {
   const RowTypePtr outputType_;
   std::shared_ptr<common::MetadataFilter> metadataFilter_;
   std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
+  // Rows still to be returned if a limit has been set. Without filters, no
+  // more rows than this are read.
+  std::optional<uint64_t> remainingLimit_;
+  // Set if the splits that need no filtering may be answered from the file
+  // statistics.
+  std::shared_ptr<const StatisticsAggregation> statisticsAggregation_;
   RowVectorPtr emptyOutput_;
   dwio::common::RuntimeStatistics runtimeStats_;
   std::atomic<uint64_t> totalRemainingFilterTime_{0};
+  // True if a Bloom filter has been pushed down by a hash join.
+  bool hasBloomFilter_{false};
+  // Rows rejected by the Bloom filters that have been replaced in
+  // 'scanSpec_', e.g. merged with another dynamic filter.
+  uint64_t bloomFilterRejectedRows_{0};
   core::ExpressionEvaluator* expressionEvaluator_;
   uint64_t completedRows_ = 0;
+  // The files read after the first file of the split added last.
+  std::vector<std::shared_ptr<HiveConnectorSplit>> coalescedSplits_;
+  // Index of the next file to read in 'coalescedSplits_'.
+  size_t nextCoalescedSplit_{0};
 
   // Reusable memory for remaining filter evaluation.
   VectorPtr filterResult_;
@@ -108,12 +108,90 @@ inline uint32_t hashOne<TypeKind::UNKNOWN>(const UnknownValue& /*value*/) {
   VELOX_FAIL("Unknown values cannot be non-NULL");
 }
 
+// Hashes the first 'numRows' of 'data' into 'hashes' in one pass with no
+// branches, so that the compiler can vectorize the hashes and the multiplies
+// that combine them with the hashes of the previous keys. Null rows hash to 0.
+template <TypeKind kind>
+void hashFlat(
+    const typename TypeTraits<kind>::NativeType* data,
+    const uint64_t* nulls,
+    vector_size_t numRows,
+    bool mix,
+    uint32_t* hashes) {
+  if (nulls == nullptr) {
+    if (mix) {
+      for (auto i = 0; i < numRows; ++i) {
+        hashes[i] = hashes[i] * 31 + hashOne<kind>(data[i]);
+      }
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        hashes[i] = hashOne<kind>(data[i]);
+      }
+    }
+    return;
+  }
+  if (mix) {
+    for (auto i = 0; i < numRows; ++i) {
+      const uint32_t hash =
+          bits::isBitNull(nulls, i) ? 0 : hashOne<kind>(data[i]);
+      hashes[i] = hashes[i] * 31 + hash;
+    }
+  } else {
+    for (auto i = 0; i < numRows; ++i) {
+      hashes[i] = bits::isBitNull(nulls, i) ? 0 : hashOne<kind>(data[i]);
+    }
+  }
+}
+
+// Hashes the 'values' of 'rows' into 'hashes'. Flat values are hashed with
+// hashFlat() if all rows are selected. If the values are a dictionary with
+// fewer values than there are rows, the dictionary is hashed once into
+// 'baseHashes' and each row looks up its hash. A constant is hashed once.
 template <TypeKind kind>
 void hashPrimitive(
     const DecodedVector& values,
     const SelectivityVector& rows,
     bool mix,
-    std::vector<uint32_t>& hashes) {
+    std::vector<uint32_t>& hashes,
+    std::vector<uint32_t>& baseHashes) {
+  using T = typename TypeTraits<kind>::NativeType;
+  // Booleans are bits and unknown values are always null, so they can not be
+  // read from DecodedVector::data().
+  if constexpr (kind != TypeKind::BOOLEAN && kind != TypeKind::UNKNOWN) {
+    if (values.isIdentityMapping()) {
+      if (rows.isAllSelected()) {
+        // The nulls of an identity mapping are the nulls of the base.
+        hashFlat<kind>(
+            values.data<T>(),
+            values.base()->rawNulls(),
+            rows.size(),
+            mix,
+            hashes.data());
+        return;
+      }
+    } else if (values.isConstantMapping()) {
+      const uint32_t hash =
+          values.isNullAt(0) ? 0 : hashOne<kind>(values.valueAt<T>(0));
+      rows.applyToSelected(
+          [&](auto row) { mergeHash(mix, hash, hashes[row]); });
+      return;
+    } else if (values.base()->size() < rows.countSelected()) {
+      const auto* base = values.base();
+      baseHashes.resize(base->size());
+      hashFlat<kind>(
+          values.data<T>(),
+          base->rawNulls(),
+          base->size(),
+          false,
+          baseHashes.data());
+      rows.applyToSelected([&](auto row) {
+        const uint32_t hash =
+            values.isNullAt(row) ? 0 : baseHashes[values.index(row)];
+        mergeHash(mix, hash, hashes[row]);
+      });
+      return;
+    }
+  }
   if (rows.isAllSelected()) {
     // The compiler seems to be a little fickle with optimizations.
     // Although rows.applyToSelected should do roughly the same thing, doing
@@ -156,8 +234,9 @@ void HivePartitionFunction::hashTyped<TypeKind::BOOLEAN>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::BOOLEAN>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::BOOLEAN>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -166,8 +245,9 @@ void HivePartitionFunction::hashTyped<TypeKind::TINYINT>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::TINYINT>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::TINYINT>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -176,8 +256,9 @@ void HivePartitionFunction::hashTyped<TypeKind::SMALLINT>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::SMALLINT>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::SMALLINT>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -186,8 +267,9 @@ void HivePartitionFunction::hashTyped<TypeKind::INTEGER>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::INTEGER>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::INTEGER>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -196,8 +278,9 @@ void HivePartitionFunction::hashTyped<TypeKind::REAL>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::REAL>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::REAL>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -206,8 +289,9 @@ void HivePartitionFunction::hashTyped<TypeKind::BIGINT>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::BIGINT>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::BIGINT>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -216,8 +300,9 @@ void HivePartitionFunction::hashTyped<TypeKind::DOUBLE>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::DOUBLE>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::DOUBLE>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -226,8 +311,9 @@ void HivePartitionFunction::hashTyped<TypeKind::VARCHAR>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::VARCHAR>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::VARCHAR>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -236,8 +322,9 @@ void HivePartitionFunction::hashTyped<TypeKind::VARBINARY>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::VARBINARY>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::VARBINARY>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -246,8 +333,9 @@ void HivePartitionFunction::hashTyped<TypeKind::TIMESTAMP>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::TIMESTAMP>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::TIMESTAMP>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -256,8 +344,9 @@ void HivePartitionFunction::hashTyped<TypeKind::UNKNOWN>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::UNKNOWN>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  hashPrimitive<TypeKind::UNKNOWN>(
+      values, rows, mix, hashes, getHashes(poolIndex));
 }
 
 template <>
@@ -42,9 +42,11 @@ PartitionIdGenerator::PartitionIdGenerator(
   std::vector<TypePtr> partitionKeyTypes;
   std::vector<std::string> partitionKeyNames;
   for (auto channel : partitionChannels_) {
+    const auto kind = inputType->childAt(channel)->kind();
+    // Hive partition values of type timestamp are not supported.
     VELOX_USER_CHECK(
-        exec::VectorHasher::typeKindSupportsValueIds(
-            inputType->childAt(channel)->kind()),
+        exec::VectorHasher::typeKindSupportsValueIds(kind) &&
+            kind != TypeKind::TIMESTAMP,
         "Unsupported partition type: {}.",
         inputType->childAt(channel)->toString());
     partitionKeyTypes.push_back(inputType->childAt(channel));
@@ -24,6 +24,7 @@
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/dwio/common/ReaderFactory.h"
+#include "velox/vector/ConstantVector.h"
 
 namespace facebook::velox::connector::hive {
 
@@ -39,7 +40,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
     folly::Executor* executor,
     const ConnectorQueryCtx* connectorQueryCtx,
     const std::shared_ptr<HiveConfig>& hiveConfig,
-    const std::shared_ptr<io::IoStatistics>& ioStats) {
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    iceberg::EqualityDeleteCache* equalityDeleteCache) {
   //  Create the SplitReader based on hiveSplit->customSplitInfo["table_format"]
   if (hiveSplit->customSplitInfo.count("table_format") > 0 &&
       hiveSplit->customSplitInfo["table_format"] == "hive-iceberg") {
@@ -53,7 +55,8 @@ std::unique_ptr<SplitReader> SplitReader::create(
         executor,
         connectorQueryCtx,
         hiveConfig,
-        ioStats);
+        ioStats,
+        equalityDeleteCache);
   } else {
     return std::make_unique<SplitReader>(
         hiveSplit,
@@ -130,6 +133,8 @@ void SplitReader::prepareSplit(
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandle->uuid.id());
   }
+  baseReaderOpts_.setFileMetadataCache(
+      fileHandle->metadataCache, fileHandle->metadataKey);
   auto baseFileInput = createBufferedInput(
       *fileHandle, baseReaderOpts_, connectorQueryCtx_, ioStats_, executor_);
 
@@ -159,6 +164,9 @@ void SplitReader::prepareSplit(
 
   auto& fileType = baseReader_->rowType();
   auto columnTypes = adaptColumns(fileType, baseReaderOpts_.getFileSchema());
+  if (prepareStatisticsOutput(fileHandle->file->size())) {
+    return;
+  }
 
   configureRowReaderOptions(
       baseRowReaderOpts_,
@@ -167,6 +175,15 @@ void SplitReader::prepareSplit(
       metadataFilter,
       ROW(std::vector<std::string>(fileType->names()), std::move(columnTypes)),
       hiveSplit_);
+  const auto decodingParallelism = hiveConfig_->parallelColumnDecodingFactor(
+      connectorQueryCtx_->sessionProperties());
+  if (executor_ != nullptr && decodingParallelism > 1) {
+    // The executor is owned by the connector and outlives the row reader.
+    baseRowReaderOpts_.setDecodingExecutor(
+        std::shared_ptr<folly::Executor>(
+            std::shared_ptr<folly::Executor>(), executor_));
+    baseRowReaderOpts_.setDecodingParallelismFactor(decodingParallelism);
+  }
   // NOTE: we firstly reset the finished 'baseRowReader_' of previous split
   // before setting up for the next one to avoid doubling the peak memory usage.
   baseRowReader_.reset();
@@ -176,8 +193,15 @@ void SplitReader::prepareSplit(
 std::vector<TypePtr> SplitReader::adaptColumns(
     const RowTypePtr& fileType,
     const std::shared_ptr<const velox::RowType>& tableSchema) {
+  // The column types only depend on the file type, which usually repeats
+  // from split to split.
+  const bool sameFileType = adaptationCache_ &&
+      adaptationCache_->fileType != nullptr &&
+      (adaptationCache_->fileType == fileType ||
+       *adaptationCache_->fileType == *fileType);
   // Keep track of schema types for columns in file, used by ColumnSelector.
-  std::vector<TypePtr> columnTypes = fileType->children();
+  std::vector<TypePtr> columnTypes =
+      sameFileType ? adaptationCache_->columnTypes : fileType->children();
 
   auto& childrenSpecs = scanSpec_->children();
   for (size_t i = 0; i < childrenSpecs.size(); ++i) {
@@ -202,10 +226,13 @@ std::vector<TypePtr> SplitReader::adaptColumns(
       if (!fileTypeIdx.has_value()) {
         // Column is missing. Most likely due to schema evolution.
         VELOX_CHECK(tableSchema);
-        setNullConstantValue(childSpec, tableSchema->findChild(fieldName));
+        setMissingColumnValue(childSpec, tableSchema->findChild(fieldName));
       } else {
         // Column no longer missing, reset constant value set on the spec.
         childSpec->setConstantValue(nullptr);
+        if (sameFileType) {
+          continue;
+        }
         auto outputTypeIdx = readerOutputType_->getChildIdxIfExists(fieldName);
         if (outputTypeIdx.has_value()) {
           // We know the fieldName exists in the file, make the type at that
@@ -219,10 +246,234 @@ std::vector<TypePtr> SplitReader::adaptColumns(
 
   scanSpec_->resetCachedValues(false);
 
+  if (adaptationCache_ && !sameFileType) {
+    adaptationCache_->fileType = fileType;
+    adaptationCache_->columnTypes = columnTypes;
+  }
   return columnTypes;
 }
 
+namespace {
+
+template <TypeKind Kind>
+VectorPtr makeNonNullConstant(const TypePtr& type, memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  return std::make_shared<ConstantVector<T>>(pool, 1, false, type, T());
+}
+
+template <TypeKind Kind>
+VectorPtr makeIntegerConstant(
+    const TypePtr& type,
+    int64_t value,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  if constexpr (std::is_integral_v<T>) {
+    return std::make_shared<ConstantVector<T>>(
+        pool, 1, false, type, static_cast<T>(value));
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
+// Sets 'min' and 'max' to constants of 'type' from 'statistics'. Returns
+// false if 'statistics' has no min and max that can be used for 'type'.
+bool makeMinMax(
+    const TypePtr& type,
+    const TypePtr& fileType,
+    const dwio::common::ColumnStatistics& statistics,
+    memory::MemoryPool* pool,
+    VectorPtr& min,
+    VectorPtr& max) {
+  if (type->kind() != fileType->kind() || type->isDecimal() ||
+      type->isDate() || type->isIntervalDayTime() ||
+      type->isIntervalYearMonth()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT: {
+      auto* integerStatistics =
+          dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+              &statistics);
+      if (integerStatistics == nullptr ||
+          !integerStatistics->getMinimum().has_value() ||
+          !integerStatistics->getMaximum().has_value()) {
+        return false;
+      }
+      min = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          makeIntegerConstant,
+          type->kind(),
+          type,
+          integerStatistics->getMinimum().value(),
+          pool);
+      max = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          makeIntegerConstant,
+          type->kind(),
+          type,
+          integerStatistics->getMaximum().value(),
+          pool);
+      return true;
+    }
+    case TypeKind::VARCHAR: {
+      auto* stringStatistics =
+          dynamic_cast<const dwio::common::StringColumnStatistics*>(
+              &statistics);
+      if (stringStatistics == nullptr ||
+          !stringStatistics->getMinimum().has_value() ||
+          !stringStatistics->getMaximum().has_value()) {
+        return false;
+      }
+      min = BaseVector::createConstant(
+          type,
+          velox::variant(stringStatistics->getMinimum().value()),
+          1,
+          pool);
+      max = BaseVector::createConstant(
+          type,
+          velox::variant(stringStatistics->getMaximum().value()),
+          1,
+          pool);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool contains(const std::vector<column_index_t>& channels, column_index_t i) {
+  return std::find(channels.begin(), channels.end(), i) != channels.end();
+}
+
+} // namespace
+
+bool SplitReader::prepareStatisticsOutput(uint64_t fileSize) {
+  statisticsColumns_.clear();
+  numStatisticsRows_ = 0;
+  nextStatisticsRow_ = 0;
+  if (statisticsAggregation_ == nullptr || hiveSplit_->start != 0 ||
+      hiveSplit_->length < fileSize ||
+      hiveTableHandle_->tableParameters().count(
+          dwio::common::TableParameter::kSkipHeaderLineCount) > 0) {
+    return false;
+  }
+  const auto numRows = baseReader_->numberOfRows();
+  if (!numRows.has_value()) {
+    return false;
+  }
+  // Filters on partition keys have been checked for the whole split in
+  // testFilters().
+  for (const auto& childSpec : scanSpec_->children()) {
+    if (childSpec->hasFilter() &&
+        hiveSplit_->partitionKeys.count(childSpec->fieldName()) == 0) {
+      return false;
+    }
+  }
+
+  const auto& fileType = baseReader_->rowType();
+  std::vector<StatisticsColumn> columns(readerOutputType_->size());
+  for (column_index_t i = 0; i < readerOutputType_->size(); ++i) {
+    const auto& name = readerOutputType_->nameOf(i);
+    const auto& type = readerOutputType_->childAt(i);
+    auto& column = columns[i];
+    auto* childSpec = scanSpec_->childByName(name);
+    if (childSpec != nullptr && childSpec->isConstant()) {
+      // Partition keys, missing columns and info columns have the same value
+      // on all rows.
+      column.min = childSpec->constantValue();
+      column.max = column.min;
+      column.numValues = column.min->isNullAt(0) ? 0 : numRows.value();
+      continue;
+    }
+    if (contains(statisticsAggregation_->groupingKeyChannels, i)) {
+      return false;
+    }
+    const bool needsMinMax =
+        contains(statisticsAggregation_->minMaxChannels, i);
+    if (!needsMinMax && !contains(statisticsAggregation_->countChannels, i)) {
+      // The column is not used by the aggregation.
+      column.min = BaseVector::createNullConstant(type, 1, pool_);
+      column.max = column.min;
+      column.numValues = 0;
+      continue;
+    }
+    const auto fileIndex = fileType->getChildIdxIfExists(name);
+    if (!fileIndex.has_value() || !type->isPrimitiveType()) {
+      return false;
+    }
+    const auto statistics = baseReader_->columnStatistics(
+        baseReader_->typeWithId()->childAt(fileIndex.value())->id());
+    if (statistics == nullptr ||
+        !statistics->getNumberOfValues().has_value() ||
+        statistics->getNumberOfValues().value() > numRows.value()) {
+      return false;
+    }
+    column.numValues = statistics->getNumberOfValues().value();
+    if (needsMinMax) {
+      if (column.numValues > 0 &&
+          !makeMinMax(
+              type,
+              fileType->childAt(fileIndex.value()),
+              *statistics,
+              pool_,
+              column.min,
+              column.max)) {
+        return false;
+      }
+    } else {
+      column.min = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          makeNonNullConstant, type->kind(), type, pool_);
+      column.max = column.min;
+    }
+    if (column.numValues == 0) {
+      column.min = BaseVector::createNullConstant(type, 1, pool_);
+      column.max = column.min;
+    }
+  }
+  statisticsColumns_ = std::move(columns);
+  numStatisticsRows_ = numRows.value();
+  return true;
+}
+
+uint64_t SplitReader::nextFromStatistics(int64_t size, VectorPtr& output) {
+  const auto begin = nextStatisticsRow_;
+  if (begin == numStatisticsRows_) {
+    return 0;
+  }
+  // All columns are constant in a batch. The first row is a batch of its own
+  // and a batch does not extend past the non-null values of a column.
+  const uint64_t maxRows = begin == 0 ? 1 : std::max<int64_t>(1, size);
+  auto end = std::min(numStatisticsRows_, begin + maxRows);
+  for (const auto& column : statisticsColumns_) {
+    if (column.numValues > begin) {
+      end = std::min(end, column.numValues);
+    }
+  }
+  const vector_size_t numRows = end - begin;
+  std::vector<VectorPtr> children;
+  children.reserve(statisticsColumns_.size());
+  for (auto i = 0; i < statisticsColumns_.size(); ++i) {
+    const auto& column = statisticsColumns_[i];
+    VectorPtr value;
+    if (begin >= column.numValues) {
+      value = BaseVector::createNullConstant(
+          readerOutputType_->childAt(i), 1, pool_);
+    } else {
+      value = begin == 0 ? column.min : column.max;
+    }
+    children.push_back(BaseVector::wrapInConstant(numRows, 0, value));
+  }
+  output = std::make_shared<RowVector>(
+      pool_, readerOutputType_, nullptr, numRows, std::move(children));
+  nextStatisticsRow_ = end;
+  return numRows;
+}
+
 uint64_t SplitReader::next(int64_t size, VectorPtr& output) {
+  if (numStatisticsRows_ > 0) {
+    return nextFromStatistics(size, output);
+  }
   return baseRowReader_->next(size, output);
 }
 
@@ -257,6 +508,9 @@ void SplitReader::updateRuntimeStats(
   if (baseRowReader_) {
     baseRowReader_->updateRuntimeStats(stats);
   }
+  if (numStatisticsRows_ > 0) {
+    ++stats.statisticsSplits;
+  }
 }
 
 bool SplitReader::allPrefetchIssued() const {
@@ -278,6 +532,21 @@ void SplitReader::setNullConstantValue(
       type, 1, connectorQueryCtx_->memoryPool()));
 }
 
+void SplitReader::setMissingColumnValue(
+    common::ScanSpec* spec,
+    const TypePtr& type) const {
+  if (!adaptationCache_) {
+    setNullConstantValue(spec, type);
+    return;
+  }
+  auto& constant = adaptationCache_->missingColumns[spec->fieldName()];
+  if (!constant) {
+    constant = BaseVector::createNullConstant(
+        type, 1, connectorQueryCtx_->memoryPool());
+  }
+  spec->setConstantValue(constant);
+}
+
 namespace {
 
 template <TypeKind ToKind>
@@ -315,12 +584,32 @@ void SplitReader::setPartitionValue(
       it != partitionKeys_->end(),
       "ColumnHandle is missing for partition key {}",
       partitionKey);
+  if (adaptationCache_) {
+    auto keyIt = adaptationCache_->partitionValues.find(partitionKey);
+    if (keyIt != adaptationCache_->partitionValues.end()) {
+      auto valueIt = keyIt->second.find(value);
+      if (valueIt != keyIt->second.end()) {
+        spec->setConstantValue(valueIt->second);
+        return;
+      }
+    }
+  }
   auto constValue = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
       convertFromString,
       it->second->dataType()->kind(),
       value,
       it->second->dataType());
   setConstantValue(spec, it->second->dataType(), constValue);
+  if (adaptationCache_) {
+    if (adaptationCache_->numPartitionValues >=
+        SplitAdaptationCache::kMaxPartitionValues) {
+      adaptationCache_->partitionValues.clear();
+      adaptationCache_->numPartitionValues = 0;
+    }
+    adaptationCache_->partitionValues[partitionKey][value] =
+        spec->constantValue();
+    ++adaptationCache_->numPartitionValues;
+  }
 }
 
 std::string SplitReader::toString() const {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/dwio/common/Options.h"
 
@@ -32,6 +33,7 @@ class ScanSpec;
 
 namespace facebook::velox::connector {
 class ConnectorQueryCtx;
+struct StatisticsAggregation;
 } // namespace facebook::velox::connector
 
 namespace facebook::velox::dwio::common {
@@ -44,6 +46,10 @@ namespace facebook::velox::memory {
 class MemoryPool;
 }
 
+namespace facebook::velox::connector::hive::iceberg {
+struct EqualityDeleteCache;
+}
+
 namespace facebook::velox::connector::hive {
 
 struct HiveConnectorSplit;
@@ -51,6 +57,28 @@ class HiveTableHandle;
 class HiveColumnHandle;
 class HiveConfig;
 
+/// The column adaptation of the splits of a data source. Kept by the data
+/// source so that a split with the same file schema or partition values as an
+/// earlier split does not make the constants and column types again.
+struct SplitAdaptationCache {
+  /// Bound on the number of cached partition values.
+  static constexpr int32_t kMaxPartitionValues = 10'000;
+
+  /// Constant vectors for partition values, keyed on partition key and value.
+  folly::F14FastMap<
+      std::string,
+      std::unordered_map<std::optional<std::string>, VectorPtr>>
+      partitionValues;
+  int32_t numPartitionValues{0};
+
+  /// Null constants for the table columns missing from a file.
+  folly::F14FastMap<std::string, VectorPtr> missingColumns;
+
+  /// The file type of the last split and the column types it was read with.
+  RowTypePtr fileType;
+  std::vector<TypePtr> columnTypes;
+};
+
 class SplitReader {
  public:
   static std::unique_ptr<SplitReader> create(
@@ -65,7 +93,8 @@ class SplitReader {
       folly::Executor* executor,
       const ConnectorQueryCtx* connectorQueryCtx,
       const std::shared_ptr<HiveConfig>& hiveConfig,
-      const std::shared_ptr<io::IoStatistics>& ioStats);
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      iceberg::EqualityDeleteCache* equalityDeleteCache = nullptr);
 
   SplitReader(
       const std::shared_ptr<velox::connector::hive::HiveConnectorSplit>&
@@ -85,6 +114,22 @@ class SplitReader {
 
   void configureReaderOptions();
 
+  /// Sets the aggregation that consumes the output. If set, prepareSplit()
+  /// answers a split that covers a whole file and needs no filtering from the
+  /// file statistics instead of creating a row reader. Must be called before
+  /// prepareSplit().
+  virtual void setStatisticsAggregation(
+      std::shared_ptr<const StatisticsAggregation> aggregation) {
+    statisticsAggregation_ = std::move(aggregation);
+  }
+
+  /// Sets the cache that adaptColumns() takes constants and column types from.
+  /// 'cache' is owned by the caller and outlives 'this'. Must be called before
+  /// prepareSplit().
+  void setAdaptationCache(SplitAdaptationCache* cache) {
+    adaptationCache_ = cache;
+  }
+
   /// This function is used by different table formats like Iceberg and Hudi to
   /// do additional preparations before reading the split, e.g. Open delete
   /// files or log files, and add column adapatations for metadata columns
@@ -124,11 +169,24 @@ class SplitReader {
       common::ScanSpec* FOLLY_NONNULL spec,
       const TypePtr& type) const;
 
+  // Sets a null constant for a table column that is missing from the file.
+  void setMissingColumnValue(
+      common::ScanSpec* FOLLY_NONNULL spec,
+      const TypePtr& type) const;
+
   void setPartitionValue(
       common::ScanSpec* FOLLY_NONNULL spec,
       const std::string& partitionKey,
       const std::optional<std::string>& value) const;
 
+  // Sets up 'statisticsColumns_' if the split can be answered from the file
+  // statistics for 'statisticsAggregation_'. Returns false if the split must
+  // be read.
+  bool prepareStatisticsOutput(uint64_t fileSize);
+
+  // Returns the next batch of rows made from 'statisticsColumns_'.
+  uint64_t nextFromStatistics(int64_t size, VectorPtr& output);
+
   std::shared_ptr<HiveConnectorSplit> hiveSplit_;
   std::shared_ptr<HiveTableHandle> hiveTableHandle_;
   std::shared_ptr<common::ScanSpec> scanSpec_;
@@ -146,8 +204,27 @@ class SplitReader {
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
 
+  std::shared_ptr<const StatisticsAggregation> statisticsAggregation_;
+  SplitAdaptationCache* adaptationCache_{nullptr};
+
  private:
+  // The values of an output column of a split answered from the file
+  // statistics. The first row has 'min', the next rows up to 'numValues' have
+  // 'max' and the remaining rows are null. These have the same count, min and
+  // max as the rows of the split.
+  struct StatisticsColumn {
+    uint64_t numValues;
+    VectorPtr min;
+    VectorPtr max;
+  };
+
   bool emptySplit_;
+
+  // Set if the split is answered from the file statistics. One per column of
+  // 'readerOutputType_'.
+  std::vector<StatisticsColumn> statisticsColumns_;
+  uint64_t numStatisticsRows_{0};
+  uint64_t nextStatisticsRow_{0};
 };
 
 } // namespace facebook::velox::connector::hive
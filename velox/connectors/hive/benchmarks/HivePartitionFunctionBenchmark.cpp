@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/Random.h>
 #include <folly/init/Init.h>
 #include "velox/connectors/hive/HivePartitionFunction.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
@@ -65,6 +66,20 @@ class HivePartitionFunctionBenchmark
     addRowVector(MAP(BIGINT(), BOOLEAN()));
     addRowVector(ROW({"a", "b"}, {INTEGER(), DOUBLE()}));
 
+    // Dictionaries over a base with a tenth of the rows.
+    for (auto typeKind : {TypeKind::BIGINT, TypeKind::VARCHAR}) {
+      opts.vectorSize = vectorSize / 10;
+      fuzzer.setOptions(opts);
+      auto base = fuzzer.fuzzFlat(createScalarType(typeKind));
+      auto indices = allocateIndices(vectorSize, pool());
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      for (auto i = 0; i < vectorSize; ++i) {
+        rawIndices[i] = folly::Random::rand32(base->size());
+      }
+      dictionaryRowVectors_[typeKind] = vm.rowVector(
+          {BaseVector::wrapInDictionary(nullptr, indices, vectorSize, base)});
+    }
+
     // Prepare HivePartitionFunction
     fewBucketsFunction_ = createHivePartitionFunction(20);
     manyBucketsFunction_ = createHivePartitionFunction(100);
@@ -82,6 +97,16 @@ class HivePartitionFunctionBenchmark
     run<KIND>(manyBucketsFunction_.get());
   }
 
+  template <TypeKind KIND>
+  void runFewDictionary() {
+    fewBucketsFunction_->partition(*dictionaryRowVectors_[KIND], partitions_);
+  }
+
+  template <TypeKind KIND>
+  void runManyDictionary() {
+    manyBucketsFunction_->partition(*dictionaryRowVectors_[KIND], partitions_);
+  }
+
  private:
   std::unique_ptr<HivePartitionFunction> createHivePartitionFunction(
       size_t bucketCount) {
@@ -103,6 +128,7 @@ class HivePartitionFunctionBenchmark
   }
 
   std::unordered_map<TypeKind, RowVectorPtr> rowVectors_;
+  std::unordered_map<TypeKind, RowVectorPtr> dictionaryRowVectors_;
   std::unique_ptr<HivePartitionFunction> fewBucketsFunction_;
   std::unique_ptr<HivePartitionFunction> manyBucketsFunction_;
   std::vector<uint32_t> partitions_;
@@ -325,6 +351,42 @@ BENCHMARK_RELATIVE(rowManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::ROW>();
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(bigintFewRowsDictionaryFewBuckets) {
+  benchmarkFew->runFewDictionary<TypeKind::BIGINT>();
+}
+
+BENCHMARK_RELATIVE(bigintFewRowsDictionaryManyBuckets) {
+  benchmarkFew->runManyDictionary<TypeKind::BIGINT>();
+}
+
+BENCHMARK(bigintManyRowsDictionaryFewBuckets) {
+  benchmarkMany->runFewDictionary<TypeKind::BIGINT>();
+}
+
+BENCHMARK_RELATIVE(bigintManyRowsDictionaryManyBuckets) {
+  benchmarkMany->runManyDictionary<TypeKind::BIGINT>();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(varcharFewRowsDictionaryFewBuckets) {
+  benchmarkFew->runFewDictionary<TypeKind::VARCHAR>();
+}
+
+BENCHMARK_RELATIVE(varcharFewRowsDictionaryManyBuckets) {
+  benchmarkFew->runManyDictionary<TypeKind::VARCHAR>();
+}
+
+BENCHMARK(varcharManyRowsDictionaryFewBuckets) {
+  benchmarkMany->runFewDictionary<TypeKind::VARCHAR>();
+}
+
+BENCHMARK_RELATIVE(varcharManyRowsDictionaryManyBuckets) {
+  benchmarkMany->runManyDictionary<TypeKind::VARCHAR>();
+}
+
 BENCHMARK_DRAW_LINE();
 } // namespace
 
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/connectors/hive/iceberg/DeletionVector.h"
+
+#include <folly/lang/Bits.h>
+#include <algorithm>
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Crc.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+
+constexpr char kMagic[] = {'\xD1', '\xD3', '\x39', '\x64'};
+constexpr uint32_t kSerialCookieNoRunContainer = 12346;
+constexpr uint32_t kSerialCookie = 12347;
+// Portable Roaring bitmaps with runs have no offsets below this many
+// containers.
+constexpr uint32_t kNoOffsetThreshold = 4;
+
+template <typename T>
+void append(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class Cursor {
+ public:
+  Cursor(const char* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    memcpy(&value, next(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* next(size_t size) {
+    VELOX_CHECK_LE(
+        position_ + size, size_, "Truncated Iceberg deletion vector");
+    auto* data = data_ + position_;
+    position_ += size;
+    return data;
+  }
+
+  size_t position() const {
+    return position_;
+  }
+
+ private:
+  const char* const data_;
+  const size_t size_;
+  size_t position_{0};
+};
+
+} // namespace
+
+// static
+void DeletionVector::addLow(Container& container, uint16_t low) {
+  if (container.bitmap.empty()) {
+    if (!container.values.empty() && low <= container.values.back()) {
+      VELOX_CHECK_EQ(
+          low,
+          container.values.back(),
+          "Deleted positions must be added in ascending order");
+      return;
+    }
+    if (container.values.size() < kMaxArraySize) {
+      container.values.push_back(low);
+      ++container.cardinality;
+      return;
+    }
+    container.bitmap.resize(kBitmapWords);
+    for (auto value : container.values) {
+      bits::setBit(container.bitmap.data(), value);
+    }
+    container.values = {};
+  }
+  if (!bits::isBitSet(container.bitmap.data(), low)) {
+    bits::setBit(container.bitmap.data(), low);
+    ++container.cardinality;
+  }
+}
+
+void DeletionVector::add(uint64_t position) {
+  const uint64_t key = position >> 16;
+  if (containers_.empty() || containers_.back().key != key) {
+    VELOX_CHECK(
+        containers_.empty() || containers_.back().key < key,
+        "Deleted positions must be added in ascending order");
+    containers_.push_back({key});
+  }
+  auto& container = containers_.back();
+  const auto previous = container.cardinality;
+  addLow(container, position & 0xFFFF);
+  cardinality_ += container.cardinality - previous;
+}
+
+void DeletionVector::setDeleted(
+    uint64_t begin,
+    uint64_t end,
+    uint64_t* bitmap) const {
+  if (begin >= end) {
+    return;
+  }
+  auto it = std::lower_bound(
+      containers_.begin(),
+      containers_.end(),
+      begin >> 16,
+      [](const Container& container, uint64_t key) {
+        return container.key < key;
+      });
+  for (; it != containers_.end(); ++it) {
+    const uint64_t base = it->key << 16;
+    if (base >= end) {
+      break;
+    }
+    const int32_t low = std::max(begin, base) - base;
+    const int32_t high = std::min<uint64_t>(end - base, 1 << 16);
+    const uint64_t offset = base - begin;
+    if (!it->bitmap.empty()) {
+      bits::forEachSetBit(it->bitmap.data(), low, high, [&](int32_t value) {
+        bits::setBit(bitmap, offset + value);
+      });
+      continue;
+    }
+    for (auto value = std::lower_bound(
+             it->values.begin(), it->values.end(), low);
+         value != it->values.end() && *value < high;
+         ++value) {
+      bits::setBit(bitmap, offset + *value);
+    }
+  }
+}
+
+uint64_t DeletionVector::memoryUsage() const {
+  uint64_t bytes = sizeof(*this) + containers_.capacity() * sizeof(Container);
+  for (const auto& container : containers_) {
+    bytes += container.values.capacity() * sizeof(uint16_t) +
+        container.bitmap.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+void DeletionVector::serializeBitmap32(
+    std::vector<const Container*>::const_iterator begin,
+    std::vector<const Container*>::const_iterator end,
+    std::string& out) const {
+  const uint32_t numContainers = end - begin;
+  append<uint32_t>(out, kSerialCookieNoRunContainer);
+  append<uint32_t>(out, numContainers);
+  for (auto it = begin; it != end; ++it) {
+    append<uint16_t>(out, (*it)->key & 0xFFFF);
+    append<uint16_t>(out, (*it)->cardinality - 1);
+  }
+  // Offsets of the containers from the cookie.
+  uint32_t offset = 8 + 8 * numContainers;
+  for (auto it = begin; it != end; ++it) {
+    append<uint32_t>(out, offset);
+    offset += (*it)->bitmap.empty() ? (*it)->cardinality * sizeof(uint16_t)
+                                    : kBitmapWords * sizeof(uint64_t);
+  }
+  for (auto it = begin; it != end; ++it) {
+    if ((*it)->bitmap.empty()) {
+      out.append(
+          reinterpret_cast<const char*>((*it)->values.data()),
+          (*it)->values.size() * sizeof(uint16_t));
+    } else {
+      out.append(
+          reinterpret_cast<const char*>((*it)->bitmap.data()),
+          kBitmapWords * sizeof(uint64_t));
+    }
+  }
+}
+
+std::string DeletionVector::serialize() const {
+  // Portable 64-bit Roaring bitmap: the number of 32-bit bitmaps, then each
+  // with the high 32 bits of its positions.
+  std::vector<const Container*> containers;
+  std::vector<size_t> bitmapStarts;
+  for (const auto& container : containers_) {
+    if (container.cardinality == 0) {
+      continue;
+    }
+    if (containers.empty() ||
+        (containers.back()->key >> 16) != (container.key >> 16)) {
+      bitmapStarts.push_back(containers.size());
+    }
+    containers.push_back(&container);
+  }
+  bitmapStarts.push_back(containers.size());
+
+  std::string out(4, '\0');
+  out.append(kMagic, sizeof(kMagic));
+  append<uint64_t>(out, bitmapStarts.size() - 1);
+  for (auto i = 0; i + 1 < bitmapStarts.size(); ++i) {
+    auto begin = containers.begin() + bitmapStarts[i];
+    append<uint32_t>(out, (*begin)->key >> 16);
+    serializeBitmap32(begin, containers.begin() + bitmapStarts[i + 1], out);
+  }
+
+  const uint32_t length = out.size() - 4;
+  const uint32_t bigLength = folly::Endian::big(length);
+  memcpy(out.data(), &bigLength, sizeof(bigLength));
+  bits::Crc32 crc;
+  crc.process_bytes(out.data() + 4, length);
+  append<uint32_t>(out, folly::Endian::big(crc.checksum()));
+  return out;
+}
+
+size_t DeletionVector::deserializeBitmap32(
+    uint32_t high,
+    const char* data,
+    size_t size) {
+  Cursor cursor(data, size);
+  const auto cookie = cursor.read<uint32_t>();
+  uint32_t numContainers;
+  const char* runFlags = nullptr;
+  if ((cookie & 0xFFFF) == kSerialCookie) {
+    numContainers = (cookie >> 16) + 1;
+    runFlags = cursor.next(bits::nbytes(numContainers));
+  } else {
+    VELOX_CHECK_EQ(
+        cookie,
+        kSerialCookieNoRunContainer,
+        "Invalid Roaring bitmap cookie in Iceberg deletion vector");
+    numContainers = cursor.read<uint32_t>();
+  }
+  std::vector<std::pair<uint16_t, uint32_t>> header(numContainers);
+  for (auto& [key, cardinality] : header) {
+    key = cursor.read<uint16_t>();
+    cardinality = cursor.read<uint16_t>() + 1;
+  }
+  if (runFlags == nullptr || numContainers >= kNoOffsetThreshold) {
+    cursor.next(numContainers * sizeof(uint32_t));
+  }
+
+  for (auto i = 0; i < numContainers; ++i) {
+    const uint64_t key = (static_cast<uint64_t>(high) << 16) | header[i].first;
+    VELOX_CHECK(
+        containers_.empty() || containers_.back().key < key,
+        "Iceberg deletion vector containers are not in ascending order");
+    auto& container = containers_.emplace_back();
+    container.key = key;
+    if (runFlags != nullptr &&
+        bits::isBitSet(reinterpret_cast<const uint8_t*>(runFlags), i)) {
+      const auto numRuns = cursor.read<uint16_t>();
+      for (auto run = 0; run < numRuns; ++run) {
+        const uint32_t start = cursor.read<uint16_t>();
+        const uint32_t length = cursor.read<uint16_t>();
+        for (auto value = start; value <= start + length; ++value) {
+          addLow(container, value);
+        }
+      }
+    } else if (header[i].second > kMaxArraySize) {
+      container.bitmap.resize(kBitmapWords);
+      memcpy(
+          container.bitmap.data(),
+          cursor.next(kBitmapWords * sizeof(uint64_t)),
+          kBitmapWords * sizeof(uint64_t));
+      container.cardinality =
+          bits::countBits(container.bitmap.data(), 0, 1 << 16);
+    } else {
+      container.values.resize(header[i].second);
+      memcpy(
+          container.values.data(),
+          cursor.next(header[i].second * sizeof(uint16_t)),
+          header[i].second * sizeof(uint16_t));
+      container.cardinality = header[i].second;
+    }
+    VELOX_CHECK_EQ(
+        container.cardinality,
+        header[i].second,
+        "Iceberg deletion vector container has an unexpected cardinality");
+    cardinality_ += container.cardinality;
+  }
+  return cursor.position();
+}
+
+// static
+std::shared_ptr<DeletionVector> DeletionVector::deserialize(
+    std::string_view blob) {
+  Cursor cursor(blob.data(), blob.size());
+  const auto length = folly::Endian::big(cursor.read<uint32_t>());
+  VELOX_CHECK_EQ(
+      length + 8,
+      blob.size(),
+      "Iceberg deletion vector has an unexpected length");
+  VELOX_CHECK_EQ(
+      memcmp(cursor.next(sizeof(kMagic)), kMagic, sizeof(kMagic)),
+      0,
+      "Invalid Iceberg deletion vector magic");
+  bits::Crc32 crc;
+  crc.process_bytes(blob.data() + 4, length);
+  uint32_t expectedCrc;
+  memcpy(&expectedCrc, blob.data() + 4 + length, sizeof(expectedCrc));
+  VELOX_CHECK_EQ(
+      crc.checksum(),
+      folly::Endian::big(expectedCrc),
+      "Iceberg deletion vector checksum mismatch");
+
+  auto deletionVector = std::make_shared<DeletionVector>();
+  const auto numBitmaps = cursor.read<uint64_t>();
+  const auto end = blob.size() - 4;
+  for (uint64_t i = 0; i < numBitmaps; ++i) {
+    const auto high = cursor.read<uint32_t>();
+    const auto offset = cursor.position();
+    cursor.next(deletionVector->deserializeBitmap32(
+        high, blob.data() + offset, end - offset));
+  }
+  return deletionVector;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "velox/common/caching/FileMetadataCache.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The deleted row positions of one data file. Stored like a Roaring bitmap:
+/// the positions are grouped into containers of 2^16 positions, each holding
+/// either the sorted low 16 bits of its positions or, if it has more than
+/// 4096 positions, a bitmap of 2^16 bits. Immutable once built, so it can be
+/// shared by the readers of all splits of the data file through a
+/// cache::FileMetadataCache.
+class DeletionVector : public cache::FileMetadata {
+ public:
+  /// Adds 'position'. Positions must be added in ascending order, as they are
+  /// in a positional delete file. Duplicates are ignored.
+  void add(uint64_t position);
+
+  /// Number of deleted positions.
+  uint64_t cardinality() const {
+    return cardinality_;
+  }
+
+  bool empty() const {
+    return cardinality_ == 0;
+  }
+
+  /// Sets bit 'i' of 'bitmap' if position 'begin + i' is deleted, for the
+  /// positions in [begin, end). Other bits are left as they are.
+  void setDeleted(uint64_t begin, uint64_t end, uint64_t* bitmap) const;
+
+  uint64_t memoryUsage() const override;
+
+  /// Returns a deletion vector blob of Iceberg v3, i.e. a
+  /// 'deletion-vector-v1' blob of a Puffin file: the big endian length of the
+  /// magic and the bitmap, the magic, a portable 64-bit Roaring bitmap and
+  /// the big endian CRC-32 of the magic and the bitmap.
+  std::string serialize() const;
+
+  /// Parses a blob written by serialize() or by another Iceberg writer. Run
+  /// containers are converted to array or bitmap containers.
+  static std::shared_ptr<DeletionVector> deserialize(std::string_view blob);
+
+ private:
+  static constexpr uint32_t kMaxArraySize = 4096;
+  static constexpr int32_t kBitmapWords = (1 << 16) / 64;
+
+  struct Container {
+    // The high 48 bits of the positions.
+    uint64_t key;
+    // The sorted low 16 bits of the positions if 'bitmap' is empty.
+    std::vector<uint16_t> values;
+    // kBitmapWords words with a bit set for each position if the container
+    // has more than kMaxArraySize positions.
+    std::vector<uint64_t> bitmap;
+    uint32_t cardinality{0};
+  };
+
+  // Adds 'low' to 'container'. 'low' must be greater than the positions in
+  // 'container' unless 'container' is a bitmap.
+  static void addLow(Container& container, uint16_t low);
+
+  // Parses a portable 32-bit Roaring bitmap at 'data' whose positions have
+  // 'high' as their high 32 bits. Returns the number of bytes read.
+  size_t deserializeBitmap32(uint32_t high, const char* data, size_t size);
+
+  void serializeBitmap32(
+      std::vector<const Container*>::const_iterator begin,
+      std::vector<const Container*>::const_iterator end,
+      std::string& out) const;
+
+  // Ordered by 'key'.
+  std::vector<Container> containers_;
+  uint64_t cardinality_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include <numeric>
+
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+constexpr uint64_t kReadBatchSize = 10'000;
+} // namespace
+
+EqualityDeleteSet::EqualityDeleteSet(
+    RowTypePtr keyType,
+    memory::MemoryPool* pool)
+    : keyType_(std::move(keyType)) {
+  std::vector<std::unique_ptr<exec::VectorHasher>> hashers;
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    hashers.push_back(
+        std::make_unique<exec::VectorHasher>(keyType_->childAt(i), i));
+  }
+  // Null keys are compared as values.
+  table_ = exec::HashTable<false>::createForJoin(
+      std::move(hashers),
+      {} /*dependentTypes*/,
+      true /*allowDuplicates*/,
+      false /*hasProbedFlag*/,
+      1'000 /*minTableSizeForParallelJoinBuild*/,
+      pool);
+  // The value id modes do not probe null keys.
+  table_->forceGenericHashMode();
+  lookup_ = std::make_unique<exec::HashLookup>(table_->hashers());
+}
+
+void EqualityDeleteSet::add(const RowVectorPtr& keys) {
+  SelectivityVector rows(keys->size());
+  decoded_.resize(keyType_->size());
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    decoded_[i].decode(*keys->childAt(i)->loadedVector(), rows);
+  }
+  auto* rowContainer = table_->rows();
+  const auto nextOffset = rowContainer->nextOffset();
+  for (auto row = 0; row < keys->size(); ++row) {
+    auto* newRow = rowContainer->newRow();
+    if (nextOffset > 0) {
+      *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
+    }
+    for (auto i = 0; i < keyType_->size(); ++i) {
+      rowContainer->store(decoded_[i], row, newRow, i);
+    }
+  }
+}
+
+void EqualityDeleteSet::prepare() {
+  table_->prepareJoinTable({});
+}
+
+void EqualityDeleteSet::setDeleted(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t size,
+    uint64_t* deleted) {
+  VELOX_CHECK_EQ(keys.size(), keyType_->size());
+  if (empty() || size == 0) {
+    return;
+  }
+  SelectivityVector rows(size);
+  lookup_->reset(size);
+  auto& hashers = table_->hashers();
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->decode(*keys[i]->loadedVector(), rows);
+    hashers[i]->hash(rows, i > 0, lookup_->hashes);
+  }
+  std::iota(lookup_->rows.begin(), lookup_->rows.end(), 0);
+  table_->joinProbe(*lookup_);
+  for (auto row = 0; row < size; ++row) {
+    if (lookup_->hits[row] != nullptr) {
+      bits::setBit(deleted, row);
+    }
+  }
+}
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<HiveConfig> hiveConfig,
+    std::shared_ptr<io::IoStatistics> ioStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile), pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+
+  deleteSplit_ = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  // The schema of the file gives the key columns.
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx->sessionProperties(),
+      nullptr,
+      deleteSplit_);
+
+  auto deleteFileHandle =
+      fileHandleFactory->generate(deleteFile_.filePath).second;
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandle,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      executor);
+
+  deleteReader_ =
+      dwio::common::getReaderFactory(deleteReaderOpts.getFileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+}
+
+void EqualityDeleteFileReader::readInto(EqualityDeleteSet& deleteSet) {
+  VELOX_CHECK(
+      deleteSet.keyType()->equivalent(*keyType()),
+      "Iceberg equality delete file {} has columns {}, expected {}",
+      deleteFile_.filePath,
+      keyType()->toString(),
+      deleteSet.keyType()->toString());
+  if (deleteFile_.recordCount == 0) {
+    return;
+  }
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*keyType());
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts, {}, scanSpec, nullptr, keyType(), deleteSplit_);
+  auto deleteRowReader = deleteReader_->createRowReader(deleteRowReaderOpts);
+
+  VectorPtr deleteRows = BaseVector::create(keyType(), 0, pool_);
+  while (deleteRowReader->next(kReadBatchSize, deleteRows) > 0) {
+    if (deleteRows->size() > 0) {
+      deleteSet.add(std::static_pointer_cast<RowVector>(deleteRows));
+    }
+  }
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
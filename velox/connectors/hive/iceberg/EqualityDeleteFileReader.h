@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+class IcebergDeleteFile;
+
+/// The rows of equality delete files with the same key columns, in a hash
+/// table for an anti join of the scanned rows. Null delete keys match null
+/// data keys, as in Iceberg. Built once and then probed by the splits of a
+/// scan. Not thread-safe.
+class EqualityDeleteSet {
+ public:
+  EqualityDeleteSet(RowTypePtr keyType, memory::MemoryPool* pool);
+
+  /// Names and types of the key columns.
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Adds the rows of 'keys', which is of keyType().
+  void add(const RowVectorPtr& keys);
+
+  /// Builds the hash table. Must be called after the last add() and before
+  /// setDeleted().
+  void prepare();
+
+  bool empty() const {
+    return table_->rows()->numRows() == 0;
+  }
+
+  /// Sets bit 'i' of 'deleted' if row 'i' of 'keys' matches a delete row, for
+  /// the first 'size' rows. 'keys' are the key columns in the order of
+  /// keyType(). Other bits are left as they are.
+  void setDeleted(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t size,
+      uint64_t* deleted);
+
+ private:
+  const RowTypePtr keyType_;
+  std::unique_ptr<exec::BaseHashTable> table_;
+  std::unique_ptr<exec::HashLookup> lookup_;
+  std::vector<DecodedVector> decoded_;
+};
+
+/// The equality delete sets built by a scan, one per set of key columns,
+/// keyed by the paths of the delete files of a split. The splits of the scan
+/// that have the same delete files share the sets.
+struct EqualityDeleteCache {
+  folly::F14FastMap<
+      std::string,
+      std::vector<std::shared_ptr<EqualityDeleteSet>>>
+      sets;
+};
+
+/// Reads the delete rows of an equality delete file. The key columns are the
+/// columns of the file, which are matched by name to the columns of the
+/// table.
+class EqualityDeleteFileReader {
+ public:
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<HiveConfig> hiveConfig,
+      std::shared_ptr<io::IoStatistics> ioStats,
+      const std::string& connectorId);
+
+  /// Names and types of the key columns.
+  const RowTypePtr& keyType() const {
+    return deleteReader_->rowType();
+  }
+
+  /// Adds the rows of the file to 'deleteSet', whose keyType() must be
+  /// keyType().
+  void readInto(EqualityDeleteSet& deleteSet);
+
+ private:
+  const IcebergDeleteFile& deleteFile_;
+  memory::MemoryPool* const pool_;
+  std::shared_ptr<HiveConnectorSplit> deleteSplit_;
+  std::unique_ptr<dwio::common::Reader> deleteReader_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
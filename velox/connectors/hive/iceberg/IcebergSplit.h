@@ -51,6 +51,15 @@ struct HiveIcebergSplit : public connector::hive::HiveConnectorSplit {
       const std::unordered_map<std::string, std::string>& _customSplitInfo = {},
       const std::shared_ptr<std::string>& _extraFileInfo = {},
       std::vector<IcebergDeleteFile> deletes = {});
+
+  /// The key does not cover 'deleteFiles', so splits with deletes are not
+  /// cached.
+  std::optional<std::string> dataKey() const override {
+    if (!deleteFiles.empty()) {
+      return std::nullopt;
+    }
+    return HiveConnectorSplit::dataKey();
+  }
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -16,11 +16,14 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include <map>
+
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ScanSpec.h"
 
 using namespace facebook::velox::dwio::common;
 
@@ -37,7 +40,8 @@ IcebergSplitReader::IcebergSplitReader(
     folly::Executor* executor,
     const ConnectorQueryCtx* connectorQueryCtx,
     const std::shared_ptr<HiveConfig> hiveConfig,
-    std::shared_ptr<io::IoStatistics> ioStats)
+    std::shared_ptr<io::IoStatistics> ioStats,
+    EqualityDeleteCache* equalityDeleteCache)
     : SplitReader(
           hiveSplit,
           hiveTableHandle,
@@ -48,64 +52,241 @@ IcebergSplitReader::IcebergSplitReader(
           executor,
           connectorQueryCtx,
           hiveConfig,
-          ioStats) {}
+          ioStats),
+      equalityDeleteCache_(equalityDeleteCache) {}
+
+IcebergSplitReader::~IcebergSplitReader() {
+  // The column readers refer to the children of 'scanSpec_'.
+  baseRowReader_.reset();
+  for (auto* spec : addedKeySpecs_) {
+    scanSpec_->removeChild(spec);
+  }
+  for (auto* spec : projectedKeySpecs_) {
+    spec->setProjectOut(false);
+  }
+  if (!addedKeySpecs_.empty() || !projectedKeySpecs_.empty()) {
+    scanSpec_->resetCachedValues(false);
+  }
+}
 
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
-  SplitReader::prepareSplit(metadataFilter, runtimeStats);
-  baseReadOffset_ = 0;
-  positionalDeleteFileReaders_.clear();
-  splitOffset_ = baseRowReader_->nextRowNumber();
-
   // TODO: Deserialize the std::vector<IcebergDeleteFile> deleteFiles. For now
   // we assume it's already deserialized.
   std::shared_ptr<HiveIcebergSplit> icebergSplit =
       std::dynamic_pointer_cast<HiveIcebergSplit>(hiveSplit_);
-
   const auto& deleteFiles = icebergSplit->deleteFiles;
+
+  // The key columns are added to the ScanSpec before the row reader is made.
+  prepareEqualityDeletes(deleteFiles);
+
+  SplitReader::prepareSplit(metadataFilter, runtimeStats);
+  baseReadOffset_ = 0;
+  deletionVectors_.clear();
+  splitOffset_ = baseRowReader_->nextRowNumber();
+
   for (const auto& deleteFile : deleteFiles) {
-    positionalDeleteFileReaders_.push_back(
-        std::make_unique<PositionalDeleteFileReader>(
-            deleteFile,
-            hiveSplit_->filePath,
-            fileHandleFactory_,
-            connectorQueryCtx_,
-            executor_,
-            hiveConfig_,
-            ioStats_,
-            runtimeStats,
-            splitOffset_,
-            hiveSplit_->connectorId));
+    if (deleteFile.content != FileContent::kPositionalDeletes) {
+      continue;
+    }
+    PositionalDeleteFileReader reader(
+        deleteFile,
+        hiveSplit_->filePath,
+        fileHandleFactory_,
+        connectorQueryCtx_,
+        executor_,
+        hiveConfig_,
+        ioStats_,
+        runtimeStats,
+        hiveSplit_->connectorId);
+    auto deletionVector = reader.read();
+    if (!deletionVector->empty()) {
+      deletionVectors_.push_back(std::move(deletionVector));
+    }
   }
 }
 
+void IcebergSplitReader::prepareEqualityDeletes(
+    const std::vector<IcebergDeleteFile>& files) {
+  equalityDeletes_.clear();
+  std::string cacheKey;
+  for (const auto& file : files) {
+    if (file.content == FileContent::kEqualityDeletes) {
+      cacheKey += file.filePath + "\n";
+    }
+  }
+  if (cacheKey.empty()) {
+    return;
+  }
+
+  std::vector<std::shared_ptr<EqualityDeleteSet>>* deleteSets;
+  std::vector<std::shared_ptr<EqualityDeleteSet>> splitDeleteSets;
+  if (equalityDeleteCache_ != nullptr) {
+    deleteSets = &equalityDeleteCache_->sets[cacheKey];
+  } else {
+    deleteSets = &splitDeleteSets;
+  }
+  if (deleteSets->empty()) {
+    // The delete files with the same key columns go into one set.
+    std::map<std::string, std::shared_ptr<EqualityDeleteSet>> setsByKeys;
+    for (const auto& file : files) {
+      if (file.content != FileContent::kEqualityDeletes) {
+        continue;
+      }
+      EqualityDeleteFileReader reader(
+          file,
+          fileHandleFactory_,
+          connectorQueryCtx_,
+          executor_,
+          hiveConfig_,
+          ioStats_,
+          hiveSplit_->connectorId);
+      auto& deleteSet = setsByKeys[reader.keyType()->toString()];
+      if (deleteSet == nullptr) {
+        deleteSet =
+            std::make_shared<EqualityDeleteSet>(reader.keyType(), pool_);
+      }
+      reader.readInto(*deleteSet);
+    }
+    for (auto& [_, deleteSet] : setsByKeys) {
+      deleteSet->prepare();
+      deleteSets->push_back(std::move(deleteSet));
+    }
+  }
+
+  keyOutputType_ = readerOutputType_;
+  for (const auto& deleteSet : *deleteSets) {
+    if (deleteSet->empty()) {
+      continue;
+    }
+    EqualityDeletes deletes;
+    const auto& keyType = deleteSet->keyType();
+    for (auto i = 0; i < keyType->size(); ++i) {
+      deletes.channels.push_back(
+          keyChannel(keyType->nameOf(i), keyType->childAt(i)));
+    }
+    deletes.deleteSet = deleteSet;
+    equalityDeletes_.push_back(std::move(deletes));
+  }
+  if (!addedKeySpecs_.empty() || !projectedKeySpecs_.empty()) {
+    scanSpec_->resetCachedValues(false);
+  }
+}
+
+column_index_t IcebergSplitReader::keyChannel(
+    const std::string& name,
+    const TypePtr& type) {
+  if (auto index = keyOutputType_->getChildIdxIfExists(name)) {
+    VELOX_USER_CHECK(
+        keyOutputType_->childAt(*index)->equivalent(*type),
+        "Iceberg equality delete column {} is {}, the table column is {}",
+        name,
+        type->toString(),
+        keyOutputType_->childAt(*index)->toString());
+    return *index;
+  }
+  const auto& dataColumns = hiveTableHandle_->dataColumns();
+  if (dataColumns != nullptr) {
+    if (auto index = dataColumns->getChildIdxIfExists(name)) {
+      VELOX_USER_CHECK(
+          dataColumns->childAt(*index)->equivalent(*type),
+          "Iceberg equality delete column {} is {}, the table column is {}",
+          name,
+          type->toString(),
+          dataColumns->childAt(*index)->toString());
+    }
+  }
+  const column_index_t channel = keyOutputType_->size();
+  auto names = keyOutputType_->names();
+  auto types = keyOutputType_->children();
+  names.push_back(name);
+  types.push_back(type);
+  keyOutputType_ = ROW(std::move(names), std::move(types));
+
+  // A column that is only filtered on has a spec that is not projected out.
+  if (auto* spec = scanSpec_->childByName(name)) {
+    VELOX_CHECK(!spec->projectOut());
+    spec->setProjectOut(true);
+    spec->setChannel(channel);
+    projectedKeySpecs_.push_back(spec);
+  } else {
+    addedKeySpecs_.push_back(scanSpec_->addField(name, channel));
+  }
+  return channel;
+}
+
+void IcebergSplitReader::removeEqualityDeletes(VectorPtr& output) {
+  auto* keyRows = keyOutput_->asUnchecked<RowVector>();
+  const auto numRows = keyRows->size();
+  equalityDeleted_.assign(bits::nwords(numRows), 0);
+  std::vector<VectorPtr> keys;
+  for (const auto& deletes : equalityDeletes_) {
+    keys.clear();
+    for (auto channel : deletes.channels) {
+      keys.push_back(keyRows->childAt(channel));
+    }
+    deletes.deleteSet->setDeleted(keys, numRows, equalityDeleted_.data());
+  }
+  const auto numDeleted =
+      bits::countBits(equalityDeleted_.data(), 0, numRows);
+
+  std::vector<VectorPtr> children(
+      keyRows->children().begin(),
+      keyRows->children().begin() + readerOutputType_->size());
+  const auto numPassed = numRows - numDeleted;
+  if (numDeleted > 0) {
+    auto indices = allocateIndices(numPassed, pool_);
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    vector_size_t numIndices = 0;
+    bits::forEachUnsetBit(
+        equalityDeleted_.data(), 0, numRows, [&](vector_size_t row) {
+          rawIndices[numIndices++] = row;
+        });
+    for (auto& child : children) {
+      child = BaseVector::wrapInDictionary(nullptr, indices, numPassed, child);
+    }
+  }
+  output = std::make_shared<RowVector>(
+      pool_, readerOutputType_, nullptr, numPassed, std::move(children));
+}
+
 uint64_t IcebergSplitReader::next(int64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.deletedRows = nullptr;
 
-  if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(size);
+  if (!deletionVectors_.empty()) {
+    auto numBytes = bits::nwords(size) * sizeof(uint64_t);
     dwio::common::ensureCapacity<int8_t>(
         deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool());
     std::memset((void*)deleteBitmap_->as<int8_t>(), 0L, numBytes);
 
-    for (auto iter = positionalDeleteFileReaders_.begin();
-         iter != positionalDeleteFileReaders_.end();
-         iter++) {
-      (*iter)->readDeletePositions(
-          baseReadOffset_, size, deleteBitmap_->asMutable<int8_t>());
-      if ((*iter)->endOfFile()) {
-        iter = positionalDeleteFileReaders_.erase(iter);
-      }
+    // The rows of the batch are at these positions in the base file.
+    const uint64_t begin = splitOffset_ + baseReadOffset_;
+    for (const auto& deletionVector : deletionVectors_) {
+      deletionVector->setDeleted(
+          begin, begin + size, deleteBitmap_->asMutable<uint64_t>());
     }
 
     deleteBitmap_->setSize(numBytes);
     mutation.deletedRows = deleteBitmap_->as<uint64_t>();
   }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+  if (equalityDeletes_.empty()) {
+    auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+    baseReadOffset_ += rowsScanned;
+    return rowsScanned;
+  }
+
+  // The key columns are read after the columns of 'readerOutputType_'.
+  if (keyOutput_ == nullptr) {
+    keyOutput_ = BaseVector::create(keyOutputType_, 0, pool_);
+  }
+  auto rowsScanned = baseRowReader_->next(size, keyOutput_, &mutation);
   baseReadOffset_ += rowsScanned;
+  if (rowsScanned > 0) {
+    removeEqualityDeletes(output);
+  }
 
   return rowsScanned;
 }
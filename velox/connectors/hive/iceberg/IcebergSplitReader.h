@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -37,9 +38,14 @@ class IcebergSplitReader : public SplitReader {
       folly::Executor* executor,
       const ConnectorQueryCtx* connectorQueryCtx,
       const std::shared_ptr<HiveConfig> hiveConfig,
-      std::shared_ptr<io::IoStatistics> ioStats);
+      std::shared_ptr<io::IoStatistics> ioStats,
+      EqualityDeleteCache* equalityDeleteCache = nullptr);
 
-  ~IcebergSplitReader() override = default;
+  ~IcebergSplitReader() override;
+
+  // The file statistics count the rows removed by the delete files.
+  void setStatisticsAggregation(
+      std::shared_ptr<const StatisticsAggregation> /*aggregation*/) override {}
 
   void prepareSplit(
       std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -48,6 +54,28 @@ class IcebergSplitReader : public SplitReader {
   uint64_t next(int64_t size, VectorPtr& output) override;
 
  private:
+  // The rows of the equality delete files with the same key columns and the
+  // channels of the key columns in 'keyOutput_'.
+  struct EqualityDeletes {
+    std::shared_ptr<EqualityDeleteSet> deleteSet;
+    std::vector<column_index_t> channels;
+  };
+
+  // Reads the equality delete files of the split or finds them in
+  // 'equalityDeleteCache_' and adds the key columns that are not read
+  // otherwise to the ScanSpec.
+  void prepareEqualityDeletes(const std::vector<IcebergDeleteFile>& files);
+
+  // Returns the channel of 'name' in 'keyOutput_', adding the column to the
+  // ScanSpec if it is not projected out.
+  column_index_t keyChannel(const std::string& name, const TypePtr& type);
+
+  // Removes the rows that match an equality delete from 'keyOutput_' and sets
+  // 'output' to the columns of 'readerOutputType_'.
+  void removeEqualityDeletes(VectorPtr& output);
+
+  EqualityDeleteCache* const equalityDeleteCache_;
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -55,8 +83,20 @@ class IcebergSplitReader : public SplitReader {
   // The file position for the first row in the split
   uint64_t splitOffset_;
 
-  std::list<std::unique_ptr<PositionalDeleteFileReader>>
-      positionalDeleteFileReaders_;
+  // The positions deleted from the base file, shared with the readers of the
+  // other splits of the base file.
+  std::vector<std::shared_ptr<const DeletionVector>> deletionVectors_;
   BufferPtr deleteBitmap_;
+
+  std::vector<EqualityDeletes> equalityDeletes_;
+  // 'readerOutputType_' followed by the equality delete key columns that are
+  // not in 'readerOutputType_'.
+  RowTypePtr keyOutputType_;
+  VectorPtr keyOutput_;
+  // Children of the shared ScanSpec added or projected out for the key
+  // columns. Restored when 'this' is destroyed.
+  std::vector<common::ScanSpec*> addedKeySpecs_;
+  std::vector<common::ScanSpec*> projectedKeySpecs_;
+  std::vector<uint64_t> equalityDeleted_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
@@ -24,6 +24,10 @@
 
 namespace facebook::velox::connector::hive::iceberg {
 
+namespace {
+constexpr uint64_t kReadBatchSize = 10'000;
+} // namespace
+
 PositionalDeleteFileReader::PositionalDeleteFileReader(
     const IcebergDeleteFile& deleteFile,
     const std::string& baseFilePath,
@@ -33,7 +37,6 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     const std::shared_ptr<HiveConfig> hiveConfig,
     std::shared_ptr<io::IoStatistics> ioStats,
     dwio::common::RuntimeStatistics& runtimeStats,
-    uint64_t splitOffset,
     const std::string& connectorId)
     : deleteFile_(deleteFile),
       baseFilePath_(baseFilePath),
@@ -42,23 +45,60 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
       ioStats_(ioStats),
+      runtimeStats_(runtimeStats),
       pool_(connectorQueryCtx->memoryPool()),
       filePathColumn_(IcebergMetadataColumn::icebergDeleteFilePathColumn()),
       posColumn_(IcebergMetadataColumn::icebergDeletePosColumn()),
-      splitOffset_(splitOffset),
-      deleteSplit_(nullptr),
-      deleteRowReader_(nullptr),
-      deletePositionsOutput_(nullptr),
-      deletePositionsOffset_(0),
-      endOfFile_(false) {
+      connectorId_(connectorId) {
   VELOX_CHECK(deleteFile_.content == FileContent::kPositionalDeletes);
+}
 
+std::shared_ptr<const DeletionVector> PositionalDeleteFileReader::read() {
   if (deleteFile_.recordCount == 0) {
-    return;
+    return std::make_shared<DeletionVector>();
+  }
+  auto deleteFileHandle =
+      fileHandleFactory_->generate(deleteFile_.filePath).second;
+  auto* cache = deleteFileHandle->metadataCache;
+  std::string cacheKey;
+  if (cache != nullptr) {
+    // A positional delete file has the deletes of many base files and a
+    // Puffin file has many deletion vectors.
+    cacheKey = fmt::format(
+        "{}#{}#{}",
+        deleteFileHandle->metadataKey,
+        deleteFile_.contentOffset.value_or(0),
+        baseFilePath_);
+    if (auto cached = std::dynamic_pointer_cast<const DeletionVector>(
+            cache->find(cacheKey))) {
+      return cached;
+    }
   }
+  auto deletionVector = deleteFile_.contentOffset.has_value()
+      ? readDeletionVector(*deleteFileHandle)
+      : readDeleteFile(*deleteFileHandle);
+  if (cache != nullptr) {
+    cache->insert(cacheKey, deletionVector);
+  }
+  return deletionVector;
+}
 
-  // TODO: check if the lowerbounds and upperbounds in deleteFile overlap with
-  //  this batch. If not, no need to proceed.
+std::shared_ptr<DeletionVector> PositionalDeleteFileReader::readDeletionVector(
+    const FileHandle& fileHandle) {
+  VELOX_CHECK(
+      deleteFile_.contentSizeInBytes.has_value(),
+      "Iceberg deletion vector without a size: {}",
+      deleteFile_.filePath);
+  const auto size = deleteFile_.contentSizeInBytes.value();
+  std::string blob(size, '\0');
+  fileHandle.file->pread(deleteFile_.contentOffset.value(), size, blob.data());
+  ioStats_->incRawBytesRead(size);
+  return DeletionVector::deserialize(blob);
+}
+
+std::shared_ptr<DeletionVector> PositionalDeleteFileReader::readDeleteFile(
+    FileHandle& fileHandle) {
+  auto deletionVector = std::make_shared<DeletionVector>();
 
   // Create the ScanSpec for this delete file
   auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
@@ -76,8 +116,8 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
   RowTypePtr deleteFileSchema =
       ROW(std::move(deleteColumnNames), std::move(deleteColumnTypes));
 
-  deleteSplit_ = std::make_shared<HiveConnectorSplit>(
-      connectorId,
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId_,
       deleteFile_.filePath,
       deleteFile_.fileFormat,
       0,
@@ -91,35 +131,26 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       hiveConfig_,
       connectorQueryCtx_->sessionProperties(),
       deleteFileSchema,
-      deleteSplit_);
+      deleteSplit);
 
-  auto deleteFileHandle =
-      fileHandleFactory_->generate(deleteFile_.filePath).second;
   auto deleteFileInput = createBufferedInput(
-      *deleteFileHandle,
-      deleteReaderOpts,
-      connectorQueryCtx_,
-      ioStats_,
-      executor_);
+      fileHandle, deleteReaderOpts, connectorQueryCtx_, ioStats_, executor_);
 
   auto deleteReader =
       dwio::common::getReaderFactory(deleteReaderOpts.getFileFormat())
           ->createReader(std::move(deleteFileInput), deleteReaderOpts);
 
-  // Check if the whole delete file split can be skipped. This could happen when
-  // 1) the delete file doesn't contain the base file that is being read; 2) The
-  // delete file does not contain the positions in the current batch for the
-  // base file.
+  // Check if the whole delete file can be skipped. This happens when the
+  // delete file doesn't contain the base file that is being read.
   if (!testFilters(
           scanSpec.get(),
           deleteReader.get(),
-          deleteSplit_->filePath,
-          deleteSplit_->partitionKeys,
+          deleteSplit->filePath,
+          deleteSplit->partitionKeys,
           {})) {
-    ++runtimeStats.skippedSplits;
-    runtimeStats.skippedSplitBytes += deleteSplit_->length;
-    deleteSplit_.reset();
-    return;
+    ++runtimeStats_.skippedSplits;
+    runtimeStats_.skippedSplitBytes += deleteSplit->length;
+    return deletionVector;
   }
 
   dwio::common::RowReaderOptions deleteRowReaderOpts;
@@ -129,115 +160,29 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       scanSpec,
       nullptr,
       deleteFileSchema,
-      deleteSplit_);
+      deleteSplit);
 
-  deleteRowReader_.reset();
-  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
-}
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
 
-void PositionalDeleteFileReader::readDeletePositions(
-    uint64_t baseReadOffset,
-    uint64_t size,
-    int8_t* deleteBitmap) {
-  // We are going to read to the row number up to the end of the batch. For the
-  // same base file, the deleted rows are in ascending order in the same delete
-  // file
-  int64_t rowNumberUpperBound = splitOffset_ + baseReadOffset + size;
-
-  // Finish unused delete positions from last batch
-  if (deletePositionsOutput_ &&
-      deletePositionsOffset_ < deletePositionsOutput_->size()) {
-    updateDeleteBitmap(
-        std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-            ->childAt(0),
-        baseReadOffset,
-        rowNumberUpperBound,
-        deleteBitmap);
-
-    if (readFinishedForBatch(rowNumberUpperBound)) {
-      return;
+  // For the same base file, the deleted rows are in ascending order in the
+  // delete file.
+  VectorPtr deletePositions = BaseVector::create(
+      ROW({posColumn_->name}, {posColumn_->type}), 0, pool_);
+  while (deleteRowReader->next(kReadBatchSize, deletePositions) > 0) {
+    if (deletePositions->size() == 0) {
+      continue;
     }
-  }
-
-  if (!deleteRowReader_ || !deleteSplit_) {
-    return;
-  }
-
-  // Read the new delete positions for this batch into deletePositionsOutput_
-  // and update the delete bitmap
-
-  auto outputType = posColumn_->type;
-
-  RowTypePtr outputRowType = ROW({posColumn_->name}, {posColumn_->type});
-  if (!deletePositionsOutput_) {
-    deletePositionsOutput_ = BaseVector::create(outputRowType, 0, pool_);
-  }
-
-  while (!readFinishedForBatch(rowNumberUpperBound)) {
-    auto rowsScanned = deleteRowReader_->next(size, deletePositionsOutput_);
-    if (rowsScanned > 0) {
-      VELOX_CHECK(
-          !deletePositionsOutput_->mayHaveNulls(),
-          "Iceberg delete file pos column cannot have nulls");
-
-      auto numDeletedRows = deletePositionsOutput_->size();
-      if (numDeletedRows > 0) {
-        deletePositionsOutput_->loadedVector();
-        deletePositionsOffset_ = 0;
-
-        updateDeleteBitmap(
-            std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-                ->childAt(0),
-            baseReadOffset,
-            rowNumberUpperBound,
-            deleteBitmap);
-      }
-    } else {
-      // Reaching the end of the file
-      endOfFile_ = true;
-      deleteSplit_.reset();
-      return;
+    VELOX_CHECK(
+        !deletePositions->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    auto positions = deletePositions->as<RowVector>()->childAt(0);
+    const auto* rawPositions =
+        positions->loadedVector()->asUnchecked<FlatVector<int64_t>>();
+    for (auto i = 0; i < positions->size(); ++i) {
+      deletionVector->add(rawPositions->valueAt(i));
     }
   }
-}
-
-bool PositionalDeleteFileReader::endOfFile() {
-  return endOfFile_;
-}
-
-void PositionalDeleteFileReader::updateDeleteBitmap(
-    VectorPtr deletePositionsVector,
-    uint64_t baseReadOffset,
-    int64_t rowNumberUpperBound,
-    int8_t* deleteBitmap) {
-  // Convert the positions in file into positions relative to the start of the
-  // split.
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-  int64_t offset = baseReadOffset + splitOffset_;
-  while (deletePositionsOffset_ < deletePositionsVector->size() &&
-         deletePositions[deletePositionsOffset_] < rowNumberUpperBound) {
-    bits::setBit(
-        deleteBitmap, deletePositions[deletePositionsOffset_] - offset);
-    deletePositionsOffset_++;
-  }
-}
-
-bool PositionalDeleteFileReader::readFinishedForBatch(
-    int64_t rowNumberUpperBound) {
-  VELOX_CHECK_NOT_NULL(deletePositionsOutput_);
-
-  auto deletePositionsVector =
-      std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)->childAt(0);
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-
-  if (deletePositionsOutput_->size() != 0 &&
-      deletePositionsOffset_ < deletePositionsVector->size() &&
-      deletePositions[deletePositionsOffset_] >= rowNumberUpperBound) {
-    return true;
-  }
-  return false;
+  return deletionVector;
 }
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/DeletionVector.h"
 #include "velox/dwio/common/Reader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -33,6 +34,10 @@ class IcebergMetadataColumn;
 using SubfieldFilters =
     std::unordered_map<common::Subfield, std::unique_ptr<common::Filter>>;
 
+/// Reads the positions deleted from one base file by a positional delete file
+/// or an Iceberg v3 deletion vector into a DeletionVector. The result is
+/// cached in the file metadata cache of the delete file so that the readers
+/// of all splits of the base file share it.
 class PositionalDeleteFileReader {
  public:
   PositionalDeleteFileReader(
@@ -44,24 +49,18 @@ class PositionalDeleteFileReader {
       const std::shared_ptr<HiveConfig> hiveConfig,
       std::shared_ptr<io::IoStatistics> ioStats,
       dwio::common::RuntimeStatistics& runtimeStats,
-      uint64_t splitOffset,
       const std::string& connectorId);
 
-  void readDeletePositions(
-      uint64_t baseReadOffset,
-      uint64_t size,
-      int8_t* deleteBitmap);
-
-  bool endOfFile();
+  /// Returns the deleted positions of the base file.
+  std::shared_ptr<const DeletionVector> read();
 
  private:
-  void updateDeleteBitmap(
-      VectorPtr deletePositionsVector,
-      uint64_t baseReadOffset,
-      int64_t rowNumberUpperBound,
-      int8_t* deleteBitmap);
+  // Reads the positions for the base file from a positional delete file.
+  std::shared_ptr<DeletionVector> readDeleteFile(FileHandle& fileHandle);
 
-  bool readFinishedForBatch(int64_t rowNumberUpperBound);
+  // Reads the blob of a deletion vector in a Puffin file.
+  std::shared_ptr<DeletionVector> readDeletionVector(
+      const FileHandle& fileHandle);
 
   const IcebergDeleteFile& deleteFile_;
   const std::string& baseFilePath_;
@@ -70,17 +69,12 @@ class PositionalDeleteFileReader {
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<io::IoStatistics> ioStats_;
+  dwio::common::RuntimeStatistics& runtimeStats_;
   memory::MemoryPool* const pool_;
 
   std::shared_ptr<IcebergMetadataColumn> filePathColumn_;
   std::shared_ptr<IcebergMetadataColumn> posColumn_;
-  uint64_t splitOffset_;
-
-  std::shared_ptr<HiveConnectorSplit> deleteSplit_;
-  std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
-  VectorPtr deletePositionsOutput_;
-  uint64_t deletePositionsOffset_;
-  bool endOfFile_;
+  const std::string connectorId_;
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/Crc.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/DeletionVector.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
@@ -24,6 +27,7 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
 #include <folly/Singleton.h>
+#include <folly/lang/Bits.h>
 
 using namespace facebook::velox::exec::test;
 using namespace facebook::velox::exec;
@@ -79,6 +83,87 @@ class HiveIcebergTest : public HiveConnectorTestBase {
     ASSERT_TRUE(it->second.peakMemoryBytes > 0);
   }
 
+  // Reads the data file with 'deleteRows' deleted by an Iceberg v3 deletion
+  // vector in a Puffin file.
+  void assertDeletionVector(const std::vector<int64_t>& deleteRows) {
+    std::shared_ptr<TempFilePath> dataFilePath = writeDataFile(rowCount);
+
+    DeletionVector deletionVector;
+    for (auto row : deleteRows) {
+      deletionVector.add(row);
+    }
+    const auto blob = deletionVector.serialize();
+    // The blob follows the magic of the Puffin file.
+    const std::string magic = "PFA1";
+    auto deleteFilePath = TempFilePath::create();
+    auto file = filesystems::getFileSystem(deleteFilePath->path, nullptr)
+                    ->openFileForWrite(deleteFilePath->path);
+    file->append(magic);
+    file->append(blob);
+    file->close();
+
+    IcebergDeleteFile deleteFile(
+        FileContent::kPositionalDeletes,
+        deleteFilePath->path,
+        fileFomat_,
+        deleteRows.size(),
+        magic.size() + blob.size(),
+        {},
+        {},
+        {},
+        magic.size(),
+        blob.size());
+    assertQuery(
+        tableScanNode(),
+        dataFilePath,
+        {deleteFile},
+        deleteRows.empty() ? "SELECT * FROM tmp"
+                           : "SELECT * FROM tmp WHERE c0 NOT IN (" +
+                makeNotInList(deleteRows) + ")");
+  }
+
+  // Reads 'numSplits' data files of c0 and c1 = c0 % 100 with the rows whose
+  // 'keyColumn' is in 'deleteKeys' deleted by an equality delete file. Only
+  // c0 is projected out.
+  void assertEqualityDeletes(
+      const std::string& keyColumn,
+      const std::vector<int64_t>& deleteKeys,
+      const std::string& duckDbSql,
+      int32_t numSplits = 1) {
+    auto data = makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(rowCount, [](auto row) { return row; }),
+         makeFlatVector<int64_t>(
+             rowCount, [](auto row) { return row % 100; })});
+    std::vector<std::shared_ptr<TempFilePath>> dataFilePaths;
+    std::vector<RowVectorPtr> expected;
+    for (auto i = 0; i < numSplits; ++i) {
+      dataFilePaths.push_back(TempFilePath::create());
+      writeToFile(dataFilePaths.back()->path, {data});
+      expected.push_back(data);
+    }
+    createDuckDbTable(expected);
+
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(
+        deleteFilePath->path,
+        {makeRowVector({keyColumn}, {makeFlatVector<int64_t>(deleteKeys)})});
+    IcebergDeleteFile deleteFile(
+        FileContent::kEqualityDeletes,
+        deleteFilePath->path,
+        fileFomat_,
+        deleteKeys.size(),
+        testing::internal::GetFileSize(
+            std::fopen(deleteFilePath->path.c_str(), "r")),
+        {keyColumn == "c0" ? 1 : 2});
+
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& dataFilePath : dataFilePaths) {
+      splits.push_back(makeIcebergSplit(dataFilePath->path, {deleteFile}));
+    }
+    OperatorTestBase::assertQuery(tableScanNode(), splits, duckDbSql);
+  }
+
   std::vector<int64_t> makeRandomDeleteRows(int32_t maxRowNumber) {
     std::mt19937 gen{0};
     std::vector<int64_t> deleteRows;
@@ -277,4 +362,116 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleBaseFiles) {
   assertPositionalDeletes({20000, 29999}, true);
 }
 
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  assertEqualityDeletes(
+      "c0",
+      {0, 1, 10000, 19999},
+      "SELECT c0 FROM tmp WHERE c0 NOT IN (0, 1, 10000, 19999)");
+  // The key column is not projected out. The splits share the delete set.
+  assertEqualityDeletes(
+      "c1", {3, 5}, "SELECT c0 FROM tmp WHERE c1 NOT IN (3, 5)", 3);
+  // Keys that match no row.
+  assertEqualityDeletes("c1", {200}, "SELECT c0 FROM tmp", 2);
+  // All rows.
+  std::vector<int64_t> allKeys(100);
+  std::iota(allKeys.begin(), allKeys.end(), 0);
+  assertEqualityDeletes("c1", allKeys, "SELECT c0 FROM tmp WHERE 1 = 0");
+}
+
+TEST_F(HiveIcebergTest, deletionVector) {
+  // Array and bitmap containers, with positions beyond 32 bits.
+  std::vector<uint64_t> positions = {1, 3, 70'000, 1ULL << 35};
+  for (uint64_t i = 0; i < 10'000; ++i) {
+    positions.push_back((1ULL << 20) + 2 * i);
+  }
+  std::sort(positions.begin(), positions.end());
+  DeletionVector deletionVector;
+  for (auto position : positions) {
+    deletionVector.add(position);
+  }
+  deletionVector.add(positions.back());
+  ASSERT_EQ(deletionVector.cardinality(), positions.size());
+  VELOX_ASSERT_THROW(deletionVector.add(2), "ascending order");
+
+  auto expectDeleted = [&](const DeletionVector& vector,
+                           uint64_t begin,
+                           uint64_t end) {
+    std::vector<uint64_t> bitmap(bits::nwords(end - begin));
+    vector.setDeleted(begin, end, bitmap.data());
+    for (auto position = begin; position < end; ++position) {
+      ASSERT_EQ(
+          bits::isBitSet(bitmap.data(), position - begin),
+          std::binary_search(positions.begin(), positions.end(), position))
+          << position;
+    }
+  };
+  expectDeleted(deletionVector, 0, 100);
+  expectDeleted(deletionVector, 2, 80'000);
+  expectDeleted(deletionVector, (1 << 20) + 101, (1 << 20) + 30'000);
+  expectDeleted(deletionVector, (1ULL << 35) - 10, (1ULL << 35) + 10);
+
+  auto blob = deletionVector.serialize();
+  auto copy = DeletionVector::deserialize(blob);
+  ASSERT_EQ(copy->cardinality(), positions.size());
+  expectDeleted(*copy, 0, 100);
+  expectDeleted(*copy, (1 << 20) + 101, (1 << 20) + 30'000);
+  expectDeleted(*copy, (1ULL << 35) - 10, (1ULL << 35) + 10);
+
+  blob[10] ^= 1;
+  VELOX_ASSERT_THROW(DeletionVector::deserialize(blob), "checksum mismatch");
+}
+
+TEST_F(HiveIcebergTest, deletionVectorRunContainer) {
+  // A Roaring bitmap with one run container of positions 10 to 109, as
+  // written by other Iceberg writers.
+  std::string bitmap;
+  auto append = [&](auto value) {
+    bitmap.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  append(uint64_t{1});
+  append(uint32_t{0});
+  append(uint32_t{12347});
+  append(uint8_t{1});
+  append(uint16_t{0});
+  append(uint16_t{99});
+  append(uint16_t{1});
+  append(uint16_t{10});
+  append(uint16_t{99});
+
+  const std::string magic = "\xD1\xD3\x39\x64";
+  bits::Crc32 crc;
+  crc.process_bytes(magic.data(), magic.size());
+  crc.process_bytes(bitmap.data(), bitmap.size());
+  std::string blob;
+  auto appendBig = [&](uint32_t value) {
+    value = folly::Endian::big(value);
+    blob.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  appendBig(magic.size() + bitmap.size());
+  blob += magic + bitmap;
+  appendBig(crc.checksum());
+
+  auto deletionVector = DeletionVector::deserialize(blob);
+  ASSERT_EQ(deletionVector->cardinality(), 100);
+  std::vector<uint64_t> deleted(2);
+  deletionVector->setDeleted(0, 128, deleted.data());
+  ASSERT_EQ(bits::countBits(deleted.data(), 0, 128), 100);
+  ASSERT_FALSE(bits::isBitSet(deleted.data(), 9));
+  ASSERT_TRUE(bits::isBitSet(deleted.data(), 10));
+  ASSERT_TRUE(bits::isBitSet(deleted.data(), 109));
+  ASSERT_FALSE(bits::isBitSet(deleted.data(), 110));
+}
+
+TEST_F(HiveIcebergTest, deletionVectorFile) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  assertDeletionVector({0, 1, 2, 3});
+  assertDeletionVector({0, 9999, 10000, 19999});
+  assertDeletionVector(makeRandomDeleteRows(rowCount));
+  assertDeletionVector({});
+  assertDeletionVector({20000, 29999});
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -213,8 +213,15 @@ uint64_t AbfsReadFile::getNaturalReadSize() const {
 
 class AbfsFileSystem::Impl {
  public:
-  explicit Impl(const Config* config) : abfsConfig_(config) {
+  explicit Impl(const Config* config)
+      : abfsConfig_(config),
+        hiveConfig_(std::make_shared<connector::hive::HiveConfig>(
+            std::make_shared<core::MemConfig>(config->values()))) {
     LOG(INFO) << "Init Azure Blob file system";
+    if (hiveConfig_->abfsUploadThreads() > 0) {
+      uploadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          hiveConfig_->abfsUploadThreads());
+    }
   }
 
   ~Impl() {
@@ -226,9 +233,24 @@ class AbfsFileSystem::Impl {
     return abfsConfig_.connectionString(path);
   }
 
+  // Returns the options of parallel uploads of a file written with buffers
+  // from 'pool'. nullopt if uploads are not parallel.
+  std::optional<ParallelUploader::Options> uploadOptions(
+      memory::MemoryPool* pool) const {
+    if (uploadExecutor_ == nullptr || pool == nullptr) {
+      return std::nullopt;
+    }
+    return ParallelUploader::Options{
+        .blockSize = hiveConfig_->abfsUploadBlockSize(),
+        .maxBufferedBytes = hiveConfig_->maxUploadBufferSize(),
+        .executor = uploadExecutor_.get(),
+        .pool = pool};
+  }
+
  private:
   const AbfsConfig abfsConfig_;
-  std::shared_ptr<folly::Executor> ioExecutor_;
+  const std::shared_ptr<connector::hive::HiveConfig> hiveConfig_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
 };
 
 AbfsFileSystem::AbfsFileSystem(const std::shared_ptr<const Config>& config)
@@ -251,9 +273,11 @@ std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
 
 std::unique_ptr<WriteFile> AbfsFileSystem::openFileForWrite(
     std::string_view path,
-    const FileOptions& /*unused*/) {
+    const FileOptions& options) {
   auto abfsfile = std::make_unique<AbfsWriteFile>(
-      std::string(path), impl_->connectionString(std::string(path)));
+      std::string(path),
+      impl_->connectionString(std::string(path)),
+      impl_->uploadOptions(options.pool));
   abfsfile->initialize();
   return abfsfile;
 }
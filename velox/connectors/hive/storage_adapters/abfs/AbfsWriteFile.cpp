@@ -51,13 +51,28 @@ class BlobStorageFileClient final : public IBlobStorageFileClient {
 
 class AbfsWriteFile::Impl {
  public:
-  explicit Impl(const std::string& path, const std::string& connectStr)
+  Impl(
+      const std::string& path,
+      const std::string& connectStr,
+      const std::optional<ParallelUploader::Options>& uploadOptions)
       : path_(path), connectStr_(connectStr) {
     // Make it a no-op if invoked twice.
     if (position_ != -1) {
       return;
     }
     position_ = 0;
+    if (uploadOptions.has_value()) {
+      // The blocks are appended at their offsets in any order. Flush commits
+      // the appended data up to the flushed position.
+      uploader_ = std::make_unique<ParallelUploader>(
+          uploadOptions.value(),
+          [this](int32_t /*index*/, uint64_t offset, std::string_view data) {
+            blobStorageFileClient_->append(
+                reinterpret_cast<const uint8_t*>(data.data()),
+                data.size(),
+                offset);
+          });
+    }
   }
 
   void initialize() {
@@ -85,11 +100,17 @@ class AbfsWriteFile::Impl {
       flush();
       blobStorageFileClient_->close();
       closed_ = true;
+      if (uploader_ != nullptr) {
+        uploader_->addRuntimeStats("abfs");
+      }
     }
   }
 
   void flush() {
     if (!closed_) {
+      if (uploader_ != nullptr) {
+        uploader_->flush();
+      }
       blobStorageFileClient_->flush(position_);
     }
   }
@@ -107,8 +128,12 @@ class AbfsWriteFile::Impl {
   }
 
   void append(const char* buffer, size_t size) {
-    blobStorageFileClient_->append(
-        reinterpret_cast<const uint8_t*>(buffer), size, position_);
+    if (uploader_ != nullptr) {
+      uploader_->append({buffer, size});
+    } else {
+      blobStorageFileClient_->append(
+          reinterpret_cast<const uint8_t*>(buffer), size, position_);
+    }
     position_ += size;
   }
 
@@ -134,12 +159,16 @@ class AbfsWriteFile::Impl {
 
   uint64_t position_ = -1;
   bool closed_ = false;
+  // Declared last so that the uploads in flight finish before the other
+  // members are destroyed.
+  std::unique_ptr<ParallelUploader> uploader_;
 };
 
 AbfsWriteFile::AbfsWriteFile(
     const std::string& path,
-    const std::string& connectStr) {
-  impl_ = std::make_shared<Impl>(path, connectStr);
+    const std::string& connectStr,
+    std::optional<ParallelUploader::Options> uploadOptions) {
+  impl_ = std::make_shared<Impl>(path, connectStr, uploadOptions);
 }
 
 void AbfsWriteFile::initialize() {
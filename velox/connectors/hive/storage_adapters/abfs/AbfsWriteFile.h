@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/file/File.h"
+#include "velox/common/file/ParallelUploader.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsUtil.h"
 
 namespace Azure::Storage::Files::DataLake::Models {
@@ -60,7 +61,13 @@ class AbfsWriteFile : public WriteFile {
   /// The constructor.
   /// @param path The file path to write.
   /// @param connectStr the connection string used to auth the storage account.
-  AbfsWriteFile(const std::string& path, const std::string& connectStr);
+  /// @param uploadOptions If set, the appended data is buffered into blocks
+  /// that are appended to the file in parallel on the upload executor.
+  /// Otherwise each append is sent from the calling thread.
+  AbfsWriteFile(
+      const std::string& path,
+      const std::string& connectStr,
+      std::optional<ParallelUploader::Options> uploadOptions = std::nullopt);
 
   /// check any issue reading file.
   void initialize();
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <atomic>
 #include <filesystem>
@@ -43,6 +44,10 @@ static const std::string fullFilePath =
 
 class AbfsFileSystemTest : public testing::Test {
  public:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
   static std::shared_ptr<const Config> hiveConfig(
       const std::unordered_map<std::string, std::string> configOverride = {}) {
     std::unordered_map<std::string, std::string> config({});
@@ -222,8 +227,7 @@ TEST_F(AbfsFileSystemTest, OpenFileForWriteTest) {
   const std::string abfsFile =
       filesystems::test::AzuriteABFSEndpoint + "writetest.txt";
   auto mockClient =
-      std::make_shared<filesystems::test::MockBlobStorageFileClient>(
-          filesystems::test::MockBlobStorageFileClient());
+      std::make_shared<filesystems::test::MockBlobStorageFileClient>();
   auto abfsWriteFile = openFileForWrite(abfsFile, mockClient);
   EXPECT_EQ(abfsWriteFile->size(), 0);
   std::string dataContent = "";
@@ -258,6 +262,44 @@ TEST_F(AbfsFileSystemTest, OpenFileForWriteTest) {
   ASSERT_EQ(fileContent, dataContent);
 }
 
+TEST_F(AbfsFileSystemTest, parallelUploads) {
+  const std::string abfsFile =
+      filesystems::test::AzuriteABFSEndpoint + "paralleltest.txt";
+  auto mockClient =
+      std::make_shared<filesystems::test::MockBlobStorageFileClient>();
+  auto pool = memory::memoryManager()->addLeafPool();
+  folly::IOThreadPoolExecutor executor(4);
+  auto abfsWriteFile = std::make_unique<AbfsWriteFile>(
+      abfsFile,
+      azuriteServer->connectionStr(),
+      ParallelUploader::Options{
+          .blockSize = kOneMB,
+          .maxBufferedBytes = 4 * kOneMB,
+          .executor = &executor,
+          .pool = pool.get()});
+  abfsWriteFile->testingSetFileClient(mockClient);
+  abfsWriteFile->initialize();
+
+  std::string dataContent;
+  for (auto size : {300'000, 5 * kOneMB, 10, 2 * kOneMB + 7}) {
+    auto randomData = AbfsFileSystemTest::generateRandomData(size);
+    abfsWriteFile->append(randomData);
+    dataContent += randomData;
+    // The buffered and uploading blocks stay within the limit.
+    EXPECT_LE(pool->usedBytes(), 4 * kOneMB);
+  }
+  abfsWriteFile->flush();
+  EXPECT_EQ(abfsWriteFile->size(), dataContent.size());
+  EXPECT_EQ(pool->usedBytes(), 0);
+
+  auto randomData = AbfsFileSystemTest::generateRandomData(kOneMB + 1);
+  abfsWriteFile->append(randomData);
+  dataContent += randomData;
+  abfsWriteFile->close();
+  EXPECT_EQ(pool->usedBytes(), 0);
+  ASSERT_EQ(mockClient->readContent(), dataContent);
+}
+
 TEST_F(AbfsFileSystemTest, renameNotImplemented) {
   auto hiveConfig = AbfsFileSystemTest::hiveConfig(
       {{"fs.azure.account.key.test.dfs.core.windows.net",
@@ -23,9 +23,8 @@
 using namespace Azure::Storage::Files::DataLake;
 namespace facebook::velox::filesystems::test {
 void MockBlobStorageFileClient::create() {
-  fileStream_ = std::ofstream(
-      filePath_,
-      std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+  fileStream_ =
+      std::ofstream(filePath_, std::ios_base::out | std::ios_base::binary);
 }
 
 PathProperties MockBlobStorageFileClient::getProperties() {
@@ -45,11 +44,13 @@ void MockBlobStorageFileClient::append(
     const uint8_t* buffer,
     size_t size,
     uint64_t offset) {
+  std::lock_guard<std::mutex> l(mutex_);
   fileStream_.seekp(offset);
   fileStream_.write(reinterpret_cast<const char*>(buffer), size);
 }
 
 void MockBlobStorageFileClient::flush(uint64_t position) {
+  std::lock_guard<std::mutex> l(mutex_);
   fileStream_.flush();
 }
 
@@ -18,6 +18,8 @@
 
 #include "velox/exec/tests/utils/TempFilePath.h"
 
+#include <mutex>
+
 using namespace facebook::velox;
 using namespace facebook::velox::filesystems::abfs;
 
@@ -51,6 +53,8 @@ class MockBlobStorageFileClient : public IBlobStorageFileClient {
 
  private:
   std::string filePath_;
+  // Serializes the appends, which may come from several upload threads.
+  std::mutex mutex_;
   std::ofstream fileStream_;
 };
 } // namespace facebook::velox::filesystems::test
@@ -17,11 +17,14 @@
 #include "velox/connectors/hive/storage_adapters/gcs/GCSFileSystem.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/ParallelUploader.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GCSUtil.h"
 #include "velox/core/Config.h"
 
 #include <fmt/format.h>
+#include <folly/Random.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -173,13 +176,34 @@ class GCSReadFile final : public ReadFile {
   std::atomic<int64_t> length_ = -1;
 };
 
+/// Streams the object from the writer thread or, with 'uploadOptions', uploads
+/// blocks of the object as separate component objects in parallel and
+/// composes them into the object on close. The components are deleted after
+/// composing.
 class GCSWriteFile final : public WriteFile {
  public:
-  explicit GCSWriteFile(
+  GCSWriteFile(
       const std::string& path,
-      std::shared_ptr<gcs::Client> client)
+      std::shared_ptr<gcs::Client> client,
+      const std::optional<ParallelUploader::Options>& uploadOptions)
       : client_(client) {
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
+    if (uploadOptions.has_value()) {
+      componentPrefix_ = fmt::format(
+          "{}.velox-upload-{:016x}/", key_, folly::Random::rand64());
+      uploader_ = std::make_unique<ParallelUploader>(
+          uploadOptions.value(),
+          [this](int32_t index, uint64_t /*offset*/, std::string_view data) {
+            const auto name = componentName(index);
+            auto object =
+                client_->InsertObject(bucket_, name, std::string(data));
+            checkGCSStatus(
+                object.status(),
+                "Failed to upload GCS object component",
+                bucket_,
+                name);
+          });
+    }
   }
 
   ~GCSWriteFile() {
@@ -196,6 +220,10 @@ class GCSWriteFile final : public WriteFile {
     auto object_metadata = client_->GetObjectMetadata(bucket_, key_);
     VELOX_CHECK(!object_metadata.ok(), "File already exists");
 
+    if (uploader_ != nullptr) {
+      size_ = 0;
+      return;
+    }
     auto stream = client_->WriteObject(bucket_, key_);
     checkGCSStatus(
         stream.last_status(),
@@ -208,22 +236,42 @@ class GCSWriteFile final : public WriteFile {
 
   void append(const std::string_view data) override {
     VELOX_CHECK(isFileOpen(), "File is not open");
-    stream_ << data;
+    if (uploader_ != nullptr) {
+      uploader_->append(data);
+    } else {
+      stream_ << data;
+    }
     size_ += data.size();
   }
 
+  /// No-op with parallel uploads. Full blocks are uploaded as they fill up
+  /// and the object is composed on close.
   void flush() override {
-    if (isFileOpen()) {
+    if (isFileOpen() && uploader_ == nullptr) {
       stream_.flush();
     }
   }
 
   void close() override {
-    if (isFileOpen()) {
-      stream_.flush();
-      stream_.Close();
+    if (!isFileOpen()) {
+      return;
+    }
+    if (uploader_ != nullptr) {
       closed_ = true;
+      try {
+        uploader_->flush();
+        compose();
+      } catch (const std::exception&) {
+        deleteComponents();
+        throw;
+      }
+      deleteComponents();
+      uploader_->addRuntimeStats("gcs");
+      return;
     }
+    stream_.flush();
+    stream_.Close();
+    closed_ = true;
   }
 
   uint64_t size() const override {
@@ -232,7 +280,47 @@ class GCSWriteFile final : public WriteFile {
 
  private:
   inline bool isFileOpen() {
-    return (!closed_ && stream_.IsOpen());
+    return !closed_ && (uploader_ != nullptr || stream_.IsOpen());
+  }
+
+  std::string componentName(int32_t index) const {
+    return fmt::format("{}{:08}", componentPrefix_, index);
+  }
+
+  // Composes the uploaded components into the object. ComposeMany composes
+  // in rounds of at most 32 components.
+  void compose() {
+    if (uploader_->numBlocks() == 0) {
+      auto object = client_->InsertObject(bucket_, key_, std::string());
+      checkGCSStatus(
+          object.status(), "Failed to create GCS object", bucket_, key_);
+      return;
+    }
+    std::vector<gcs::ComposeSourceObject> components;
+    components.reserve(uploader_->numBlocks());
+    for (auto i = 0; i < uploader_->numBlocks(); ++i) {
+      components.push_back({componentName(i), {}, {}});
+    }
+    auto object = gcs::ComposeMany(
+        *client_,
+        bucket_,
+        std::move(components),
+        componentPrefix_ + "compose-",
+        key_,
+        false);
+    checkGCSStatus(
+        object.status(), "Failed to compose GCS object", bucket_, key_);
+  }
+
+  void deleteComponents() {
+    for (auto i = 0; i < uploader_->numBlocks(); ++i) {
+      const auto status = client_->DeleteObject(bucket_, componentName(i));
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to delete GCS object component "
+                     << gcsURI(bucket_, componentName(i)) << ": "
+                     << status.message();
+      }
+    }
   }
 
   gcs::ObjectWriteStream stream_;
@@ -241,6 +329,10 @@ class GCSWriteFile final : public WriteFile {
   std::string key_;
   std::atomic<int64_t> size_{-1};
   std::atomic<bool> closed_{false};
+  std::string componentPrefix_;
+  // Declared last so that the uploads in flight finish before the other
+  // members are destroyed.
+  std::unique_ptr<ParallelUploader> uploader_;
 };
 } // namespace
 
@@ -253,7 +345,12 @@ class GCSFileSystem::Impl {
  public:
   Impl(const Config* config)
       : hiveConfig_(std::make_shared<HiveConfig>(
-            std::make_shared<core::MemConfig>(config->values()))) {}
+            std::make_shared<core::MemConfig>(config->values()))) {
+    if (hiveConfig_->gcsUploadThreads() > 0) {
+      uploadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          hiveConfig_->gcsUploadThreads());
+    }
+  }
 
   ~Impl() = default;
 
@@ -289,9 +386,24 @@ class GCSFileSystem::Impl {
     return client_;
   }
 
+  // Returns the options of parallel uploads of a file written with buffers
+  // from 'pool'. nullopt if uploads are not parallel.
+  std::optional<ParallelUploader::Options> uploadOptions(
+      memory::MemoryPool* pool) const {
+    if (uploadExecutor_ == nullptr || pool == nullptr) {
+      return std::nullopt;
+    }
+    return ParallelUploader::Options{
+        .blockSize = hiveConfig_->gcsUploadBlockSize(),
+        .maxBufferedBytes = hiveConfig_->maxUploadBufferSize(),
+        .executor = uploadExecutor_.get(),
+        .pool = pool};
+  }
+
  private:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<gcs::Client> client_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
 };
 
 GCSFileSystem::GCSFileSystem(std::shared_ptr<const Config> config)
@@ -314,9 +426,10 @@ std::unique_ptr<ReadFile> GCSFileSystem::openFileForRead(
 
 std::unique_ptr<WriteFile> GCSFileSystem::openFileForWrite(
     std::string_view path,
-    const FileOptions& /*unused*/) {
+    const FileOptions& options) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSWriteFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSWriteFile>(
+      gcspath, impl_->getClient(), impl_->uploadOptions(options.pool));
   gcsfile->initialize();
   return gcsfile;
 }
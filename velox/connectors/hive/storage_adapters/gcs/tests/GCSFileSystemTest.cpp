@@ -18,6 +18,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GCSUtil.h"
 #include "velox/core/Config.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -241,6 +242,56 @@ TEST_F(GCSFileSystemTest, writeAndReadFile) {
   EXPECT_EQ(readFile->pread(0, size), dataContent);
 }
 
+TEST_F(GCSFileSystemTest, parallelUploads) {
+  memory::MemoryManager::testingSetInstance({});
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto config = testGcsOptions()->values();
+  config[connector::hive::HiveConfig::kGCSUploadThreads] = "4";
+  config[connector::hive::HiveConfig::kGCSUploadBlockSize] = "64B";
+  config[connector::hive::HiveConfig::kMaxUploadBufferSize] = "256B";
+  filesystems::GCSFileSystem gcfs(
+      std::make_shared<const core::MemConfig>(std::move(config)));
+  gcfs.initializeClient();
+
+  // More components than one compose request takes.
+  std::string dataContent;
+  for (auto i = 0; i < 5; ++i) {
+    dataContent += kLoremIpsum;
+  }
+  const auto gcsFile = gcsURI(preexistingBucketName(), "parallelFile.txt");
+  auto writeFile = gcfs.openFileForWrite(gcsFile, {.pool = pool.get()});
+  for (auto i = 0; i < dataContent.size(); i += 100) {
+    writeFile->append(std::string_view(dataContent).substr(i, 100));
+    EXPECT_LE(pool->usedBytes(), 256);
+  }
+  writeFile->flush();
+  EXPECT_EQ(writeFile->size(), dataContent.size());
+  writeFile->close();
+  EXPECT_EQ(pool->usedBytes(), 0);
+  VELOX_ASSERT_THROW(writeFile->append("abc"), "File is not open");
+
+  auto readFile = gcfs.openFileForRead(gcsFile);
+  EXPECT_EQ(readFile->pread(0, readFile->size()), dataContent);
+
+  // Only the object is left in the bucket.
+  gcs::Client client(
+      google::cloud::Options{}
+          .set<gcs::RestEndpointOption>(
+              "http://localhost:" + testbench_->port())
+          .set<gc::UnifiedCredentialsOption>(gc::MakeInsecureCredentials()));
+  for (const auto& object : client.ListObjects(
+           preexistingBucketName(), gcs::Prefix("parallelFile.txt"))) {
+    ASSERT_TRUE(object.ok());
+    EXPECT_EQ(object->name(), "parallelFile.txt");
+  }
+
+  // An empty object.
+  const auto emptyFile = gcsURI(preexistingBucketName(), "emptyParallel.txt");
+  writeFile = gcfs.openFileForWrite(emptyFile, {.pool = pool.get()});
+  writeFile->close();
+  EXPECT_EQ(gcfs.openFileForRead(emptyFile)->size(), 0);
+}
+
 TEST_F(GCSFileSystemTest, openExistingFileForWrite) {
   const std::string newFile = "readWriteFile.txt";
   const std::string gcsFile = gcsURI(preexistingBucketName(), newFile);
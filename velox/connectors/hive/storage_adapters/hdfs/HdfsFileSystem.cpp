@@ -25,11 +25,13 @@ std::string_view HdfsFileSystem::kScheme("hdfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    if (config != nullptr) {
+      setShortCircuitRead(*config, builder);
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     hdfsFreeBuilder(builder);
     VELOX_CHECK_NOT_NULL(
@@ -53,6 +55,21 @@ class HdfsFileSystem::Impl {
   }
 
  private:
+  // Passes the short-circuit read settings to libhdfs3. With short-circuit
+  // reads, blocks with a replica on this host are read from the local disk
+  // through file descriptors passed over the DataNode's domain socket instead
+  // of over the DataNode's TCP protocol.
+  static void setShortCircuitRead(const Config& config, hdfsBuilder* builder) {
+    if (auto enabled = config.get<bool>(HdfsFileSystem::kShortCircuitRead)) {
+      hdfsBuilderConfSetStr(
+          builder, "dfs.client.read.shortcircuit", *enabled ? "true" : "false");
+    }
+    if (auto socketPath = config.get(HdfsFileSystem::kDomainSocketPath)) {
+      hdfsBuilderConfSetStr(
+          builder, "dfs.domain.socket.path", socketPath->c_str());
+    }
+  }
+
   hdfsFS hdfsClient_;
 };
 
@@ -42,6 +42,16 @@ struct HdfsServiceEndpoint {
  */
 class HdfsFileSystem : public FileSystem {
  public:
+  /// Whether blocks with a replica on this host are read through the
+  /// DataNode's domain socket, bypassing the DataNode's TCP protocol.
+  static constexpr const char* kShortCircuitRead =
+      "hive.hdfs.short-circuit-read";
+
+  /// Path of the domain socket of the local DataNode. Must match
+  /// dfs.domain.socket.path of the DataNode.
+  static constexpr const char* kDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
   explicit HdfsFileSystem(
       const std::shared_ptr<const Config>& config,
       const HdfsServiceEndpoint& endpoint);
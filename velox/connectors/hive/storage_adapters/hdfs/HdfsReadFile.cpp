@@ -15,10 +15,25 @@
  */
 
 #include "HdfsReadFile.h"
+#include <algorithm>
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include <unistd.h>
 
 namespace facebook::velox {
+namespace {
+// Returns true if 'host' of a block replica names this host.
+bool isLocalHost(const char* host) {
+  static const std::string hostName = [] {
+    char name[256] = {};
+    return gethostname(name, sizeof(name) - 1) == 0 ? std::string(name)
+                                                  : std::string();
+  }();
+  return std::strcmp(host, "localhost") == 0 ||
+      std::strcmp(host, "127.0.0.1") == 0 ||
+      (!hostName.empty() && hostName == host);
+}
+} // namespace
 
 HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
     : hdfsClient_(hdfs), filePath_(path) {
@@ -77,6 +92,62 @@ uint64_t HdfsReadFile::memoryUsage() const {
   return fileInfo_->mBlockSize;
 }
 
+const std::vector<HdfsReadFile::Block>& HdfsReadFile::blocks() const {
+  folly::call_once(blocksOnce_, [&]() {
+    int numBlocks = 0;
+    auto* locations = hdfsGetFileBlockLocations(
+        hdfsClient_, filePath_.data(), 0, size(), &numBlocks);
+    if (locations == nullptr) {
+      LOG(WARNING) << "Unable to get block locations of " << filePath_
+                   << ": " << hdfsGetLastError();
+      return;
+    }
+    blocks_.reserve(numBlocks);
+    for (auto i = 0; i < numBlocks; ++i) {
+      const auto& location = locations[i];
+      bool local = false;
+      for (auto j = 0; j < location.numOfNodes && !local; ++j) {
+        local = isLocalHost(location.hosts[j]);
+      }
+      blocks_.push_back(
+          {static_cast<uint64_t>(location.offset),
+           static_cast<uint64_t>(location.length),
+           local});
+    }
+    hdfsFreeFileBlockLocations(locations, numBlocks);
+  });
+  return blocks_;
+}
+
+std::optional<uint64_t> HdfsReadFile::localBytes(
+    uint64_t offset,
+    uint64_t length) const {
+  const auto& fileBlocks = blocks();
+  if (fileBlocks.empty()) {
+    return std::nullopt;
+  }
+  const auto end = offset + length;
+  auto it = std::upper_bound(
+      fileBlocks.begin(),
+      fileBlocks.end(),
+      offset,
+      [](uint64_t value, const Block& block) { return value < block.offset; });
+  if (it != fileBlocks.begin()) {
+    --it;
+  }
+  uint64_t local = 0;
+  for (; it != fileBlocks.end() && it->offset < end; ++it) {
+    if (it->local) {
+      const auto begin = std::max(offset, it->offset);
+      const auto blockEnd = std::min(end, it->offset + it->length);
+      if (blockEnd > begin) {
+        local += blockEnd - begin;
+      }
+    }
+  }
+  return local;
+}
+
 bool HdfsReadFile::shouldCoalesce() const {
   return false;
 }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
 #include "velox/common/file/File.h"
 
@@ -82,7 +83,24 @@ class HdfsReadFile final : public ReadFile {
     return 72 << 20;
   }
 
+  /// Returns the bytes in [offset, offset + length) that are in blocks with a
+  /// replica on this host. libhdfs3 reads these from the local DataNode,
+  /// through the domain socket if short-circuit reads are enabled. nullopt if
+  /// the block locations are not available.
+  std::optional<uint64_t> localBytes(uint64_t offset, uint64_t length)
+      const final;
+
  private:
+  struct Block {
+    uint64_t offset;
+    uint64_t length;
+    // True if a replica of the block is on this host.
+    bool local;
+  };
+
+  // Lists the blocks of the file on first use.
+  const std::vector<Block>& blocks() const;
+
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
@@ -90,6 +108,10 @@ class HdfsReadFile final : public ReadFile {
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
   folly::ThreadLocal<HdfsFile> file_;
+
+  mutable folly::once_flag blocksOnce_;
+  // Blocks in file order. Empty if the locations are not available.
+  mutable std::vector<Block> blocks_;
 };
 
 } // namespace facebook::velox
@@ -185,6 +185,27 @@ TEST_F(HdfsFileSystemTest, viaFileSystem) {
   readData(readFile.get());
 }
 
+TEST_F(HdfsFileSystemTest, shortCircuitRead) {
+  auto config = configurationValues;
+  config[filesystems::HdfsFileSystem::kShortCircuitRead] = "true";
+  config[filesystems::HdfsFileSystem::kDomainSocketPath] =
+      "/var/lib/hadoop-hdfs/dn_socket";
+  auto memConfig = std::make_shared<const core::MemConfig>(config);
+  filesystems::HdfsFileSystem hdfsFileSystem(
+      memConfig,
+      filesystems::HdfsFileSystem::getServiceEndpoint(
+          fullDestinationPath, memConfig.get()));
+  // The mini cluster has no domain socket, so reads fall back to the
+  // DataNode's TCP protocol.
+  auto readFile = hdfsFileSystem.openFileForRead(fullDestinationPath);
+  readData(readFile.get());
+
+  // The only DataNode of the mini cluster is on this host.
+  ASSERT_EQ(readFile->localBytes(0, readFile->size()), readFile->size());
+  ASSERT_EQ(readFile->localBytes(10, kOneMB), kOneMB);
+  ASSERT_EQ(readFile->localBytes(0, 0), 0);
+}
+
 TEST_F(HdfsFileSystemTest, initializeFsWithEndpointInfoInFilePath) {
   // Without host/port configured.
   auto memConfig = std::make_shared<const core::MemConfig>();
@@ -15,7 +15,10 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/File.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -23,8 +26,11 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <glog/logging.h>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 #include <aws/core/Aws.h>
@@ -32,6 +38,7 @@
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/identity-management/auth/STSAssumeRoleCredentialsProvider.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
@@ -69,11 +76,65 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// Latencies of the recent ranged GETs of an S3 file system.
+class S3LatencyTracker {
+ public:
+  void add(uint64_t micros) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (samples_.size() < kMaxSamples) {
+      samples_.push_back(micros);
+    } else {
+      samples_[next_] = micros;
+      next_ = (next_ + 1) % kMaxSamples;
+    }
+  }
+
+  // Returns the 'percentile' of the recent latencies or std::nullopt if there
+  // are too few samples.
+  std::optional<uint64_t> percentile(uint32_t percentile) const {
+    std::vector<uint64_t> samples;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (samples_.size() < kMinSamples) {
+        return std::nullopt;
+      }
+      samples = samples_;
+    }
+    auto nth = samples.begin() + (samples.size() - 1) * percentile / 100;
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+  }
+
+ private:
+  static constexpr size_t kMaxSamples = 256;
+  static constexpr size_t kMinSamples = 32;
+
+  mutable std::mutex mutex_;
+  std::vector<uint64_t> samples_;
+  // Index of the oldest sample once 'samples_' is full.
+  size_t next_{0};
+};
+
+// How an S3ReadFile splits large reads.
+struct S3ReadOptions {
+  // Runs the ranged GETs of reads larger than 'rangeSize'. If nullptr, reads
+  // are a single GET on the calling thread.
+  folly::Executor* executor{nullptr};
+  uint64_t rangeSize{0};
+  // Percentile of 'latencies' after which a ranged GET is hedged. 0 disables
+  // hedging.
+  uint32_t hedgePercentile{0};
+  S3LatencyTracker* latencies{nullptr};
+};
+
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      S3ReadOptions options = {})
+      : client_(client), options_(options) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -94,6 +155,8 @@ class S3ReadFile final : public ReadFile {
         outcome, "Failed to get metadata for S3 object", bucket_, key_);
     length_ = outcome.GetResult().GetContentLength();
     VELOX_CHECK_GE(length_, 0);
+    const auto& etag = outcome.GetResult().GetETag();
+    etag_ = std::string(etag.data(), etag.size());
   }
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
@@ -135,6 +198,63 @@ class S3ReadFile final : public ReadFile {
     return length;
   }
 
+  // Issues one GET like preadv() with the asynchronous API of the client. The
+  // GET runs on the executor of the client, so that the caller can have many
+  // reads in flight without waiting.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    uint64_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    auto result = std::make_shared<std::string>(length, 0);
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(awsString(bucket_));
+    request.SetKey(awsString(key_));
+    std::stringstream ss;
+    ss << "bytes=" << offset << "-" << offset + length - 1;
+    request.SetRange(awsString(ss.str()));
+    request.SetResponseStreamFactory(
+        AwsWriteableStreamFactory(result->data(), length));
+
+    auto [promise, future] = folly::makePromiseContract<uint64_t>();
+    client_->GetObjectAsync(
+        request,
+        [promise = std::make_shared<folly::Promise<uint64_t>>(
+             std::move(promise)),
+         result,
+         buffers,
+         bucket = bucket_,
+         key = key_](
+            const Aws::S3::S3Client* /*client*/,
+            const Aws::S3::Model::GetObjectRequest& /*request*/,
+            const auto& outcome,
+            const auto& /*context*/) {
+          try {
+            VELOX_CHECK_AWS_OUTCOME(
+                outcome, "Failed to get S3 object", bucket, key);
+          } catch (const std::exception& e) {
+            promise->setException(
+                folly::exception_wrapper(std::current_exception(), e));
+            return;
+          }
+          size_t resultOffset = 0;
+          for (auto range : buffers) {
+            if (range.data()) {
+              memcpy(range.data(), result->data() + resultOffset, range.size());
+            }
+            resultOffset += range.size();
+          }
+          promise->setValue(result->size());
+        });
+    return std::move(future);
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -153,14 +273,172 @@ class S3ReadFile final : public ReadFile {
     return fmt::format("s3://{}/{}", bucket_, key_);
   }
 
+  std::string getVersion() const final {
+    return etag_;
+  }
+
   uint64_t getNaturalReadSize() const final {
     return 72 << 20;
   }
 
  private:
+  // A range of a parallel read. Attempt 0 reads into 'buffer' and attempt 1,
+  // the hedged GET, into 'hedgeBuffer'.
+  struct RangeRead {
+    uint64_t offset;
+    uint64_t length;
+    char* buffer;
+    std::string hedgeBuffer;
+    int32_t numAttempts{0};
+    int32_t numDone{0};
+    // Index of the first attempt that succeeded, -1 if none yet.
+    int32_t winner{-1};
+    std::exception_ptr error;
+    // Time the first attempt started running and time the winner finished.
+    uint64_t startMicros{0};
+    uint64_t endMicros{0};
+    std::atomic_bool cancelled[2]{false, false};
+  };
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    if (options_.executor == nullptr || length <= options_.rangeSize) {
+      getObject(offset, length, position);
+      return;
+    }
+    parallelRead(offset, length, position);
+  }
+
+  // Reads [offset, offset + length) into 'position' with ranged GETs of
+  // 'options_.rangeSize' on 'options_.executor'. The calling thread only
+  // waits and issues the hedged GETs, so that the executor threads never
+  // wait for each other.
+  void parallelRead(uint64_t offset, uint64_t length, char* position) const {
+    const auto rangeSize = options_.rangeSize;
+    std::vector<RangeRead> ranges(bits::divRoundUp(length, rangeSize));
+    for (auto i = 0; i < ranges.size(); ++i) {
+      auto& range = ranges[i];
+      range.offset = offset + i * rangeSize;
+      range.length = std::min(rangeSize, length - i * rangeSize);
+      range.buffer = position + i * rangeSize;
+    }
+    std::optional<uint64_t> hedgeDelayMicros;
+    if (options_.hedgePercentile > 0) {
+      hedgeDelayMicros =
+          options_.latencies->percentile(options_.hedgePercentile);
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    auto startAttempt = [&](RangeRead& range, int32_t attempt) {
+      ++range.numAttempts;
+      options_.executor->add([&, attempt]() {
+        {
+          std::lock_guard<std::mutex> l(mutex);
+          if (range.startMicros == 0) {
+            range.startMicros = getCurrentTimeMicro();
+          }
+        }
+        char* buffer = attempt == 0 ? range.buffer : range.hedgeBuffer.data();
+        std::exception_ptr error;
+        try {
+          getObject(
+              range.offset, range.length, buffer, &range.cancelled[attempt]);
+        } catch (const std::exception&) {
+          error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> l(mutex);
+        if (error == nullptr && range.winner < 0) {
+          range.winner = attempt;
+          range.endMicros = getCurrentTimeMicro();
+          range.cancelled[1 - attempt] = true;
+        } else if (error != nullptr && range.error == nullptr) {
+          range.error = error;
+        }
+        ++range.numDone;
+        cv.notify_all();
+      });
+    };
+
+    std::unique_lock<std::mutex> l(mutex);
+    for (auto& range : ranges) {
+      startAttempt(range, 0);
+    }
+    int32_t numHedged = 0;
+    for (;;) {
+      bool allDone = true;
+      bool failed = false;
+      std::optional<uint64_t> nextHedgeMicros;
+      const auto now = getCurrentTimeMicro();
+      for (auto& range : ranges) {
+        if (range.numDone < range.numAttempts) {
+          allDone = false;
+        } else if (range.winner < 0) {
+          failed = true;
+        }
+        // Only full ranges are hedged since the latencies are of full ranges.
+        if (!hedgeDelayMicros.has_value() || range.numAttempts > 1 ||
+            range.numDone > 0 || range.startMicros == 0 ||
+            range.length < rangeSize) {
+          continue;
+        }
+        const auto hedgeMicros = range.startMicros + hedgeDelayMicros.value();
+        if (now >= hedgeMicros) {
+          range.hedgeBuffer.resize(range.length);
+          startAttempt(range, 1);
+          ++numHedged;
+        } else if (
+            !nextHedgeMicros.has_value() ||
+            hedgeMicros < nextHedgeMicros.value()) {
+          nextHedgeMicros = hedgeMicros;
+        }
+      }
+      if (allDone) {
+        break;
+      }
+      if (failed) {
+        // The read fails, so the other GETs are not needed.
+        hedgeDelayMicros.reset();
+        for (auto& range : ranges) {
+          range.cancelled[0] = true;
+          range.cancelled[1] = true;
+        }
+      }
+      if (nextHedgeMicros.has_value()) {
+        cv.wait_for(
+            l, std::chrono::microseconds(nextHedgeMicros.value() - now));
+      } else {
+        cv.wait(l);
+      }
+    }
+    l.unlock();
+
+    if (numHedged > 0) {
+      addThreadLocalRuntimeStat("s3HedgedReads", RuntimeCounter(numHedged));
+    }
+    for (auto& range : ranges) {
+      if (range.winner < 0) {
+        std::rethrow_exception(range.error);
+      }
+    }
+    for (auto& range : ranges) {
+      if (range.winner == 1) {
+        memcpy(range.buffer, range.hedgeBuffer.data(), range.length);
+      }
+      if (options_.latencies != nullptr && range.length == rangeSize) {
+        options_.latencies->add(range.endMicros - range.startMicros);
+      }
+    }
+  }
+
+  // Reads [offset, offset + length) into 'position' with one GET. If
+  // 'cancelled' becomes true, the GET is aborted and its result is ignored.
+  void getObject(
+      uint64_t offset,
+      uint64_t length,
+      char* position,
+      const std::atomic_bool* cancelled = nullptr) const {
     // Read the desired range of bytes.
     Aws::S3::Model::GetObjectRequest request;
     Aws::S3::Model::GetObjectResult result;
@@ -172,14 +450,25 @@ class S3ReadFile final : public ReadFile {
     request.SetRange(awsString(ss.str()));
     request.SetResponseStreamFactory(
         AwsWriteableStreamFactory(position, length));
+    if (cancelled != nullptr) {
+      request.SetContinueRequestHandler(
+          [cancelled](const Aws::Http::HttpRequest* /*request*/) {
+            return !cancelled->load();
+          });
+    }
     auto outcome = client_->GetObject(request);
+    if (cancelled != nullptr && cancelled->load()) {
+      return;
+    }
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
   }
 
   Aws::S3::S3Client* client_;
+  const S3ReadOptions options_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
+  std::string etag_;
 };
 
 Aws::Utils::Logging::LogLevel inferS3LogLevel(std::string level) {
@@ -535,6 +824,13 @@ class S3FileSystem::Impl {
       clientConfig.scheme = Aws::Http::Scheme::HTTP;
     }
 
+    clientConfig.maxConnections = hiveConfig_->s3MaxConnections();
+    // Runs the asynchronous GETs of ReadFile::preadvAsync(). Each GET in
+    // flight takes a connection, so more threads would only wait.
+    clientConfig.executor =
+        Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(
+            "S3FileSystem", hiveConfig_->s3MaxConnections());
+
     auto credentialsProvider = getCredentialsProvider();
 
     client_ = std::make_shared<Aws::S3::S3Client>(
@@ -542,10 +838,24 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         hiveConfig_->s3UseVirtualAddressing());
+    if (hiveConfig_->s3ReadThreads() > 0) {
+      readExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          hiveConfig_->s3ReadThreads());
+      readOptions_.executor = readExecutor_.get();
+      readOptions_.rangeSize = hiveConfig_->s3ReadRangeSize();
+      VELOX_USER_CHECK_GT(
+          readOptions_.rangeSize,
+          0,
+          "{} must be positive",
+          HiveConfig::kS3ReadRangeSize);
+      readOptions_.hedgePercentile = hiveConfig_->s3HedgePercentile();
+      readOptions_.latencies = &latencies_;
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    readExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -624,9 +934,17 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  const S3ReadOptions& readOptions() const {
+    return readOptions_;
+  }
+
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  // Runs the ranged GETs of large reads if hive.s3.read-threads is set.
+  std::unique_ptr<folly::IOThreadPoolExecutor> readExecutor_;
+  S3LatencyTracker latencies_;
+  S3ReadOptions readOptions_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -642,7 +960,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file, impl_->s3Client(), impl_->readOptions());
   s3file->initialize();
   return s3file;
 }
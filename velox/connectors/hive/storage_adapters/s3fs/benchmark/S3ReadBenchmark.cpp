@@ -17,9 +17,20 @@
 #include "velox/connectors/hive/storage_adapters/s3fs/benchmark/S3ReadBenchmark.h"
 #include "velox/core/Config.h"
 
+#include <folly/String.h>
+
 #include <fstream>
+#include <thread>
 
 DEFINE_string(s3_config, "", "Path of S3 config file");
+DEFINE_string(
+    s3_concurrency,
+    "1,4,16",
+    "Comma separated numbers of threads that read concurrently");
+DEFINE_int64(
+    s3_concurrent_read_size,
+    64 << 20,
+    "Size of a read in the concurrent read measurements");
 
 namespace facebook::velox {
 
@@ -47,4 +58,48 @@ std::shared_ptr<Config> readConfig(const std::string& filePath) {
   return std::make_shared<facebook::velox::core::MemConfig>(properties);
 }
 
+void S3ReadBenchmark::concurrentReads(uint64_t size, int32_t concurrency) {
+  if (fileSize_ <= size) {
+    LOG(ERROR) << "File size " << fileSize_ << " is <= then read size " << size;
+    return;
+  }
+  const auto repeats = std::max<int64_t>(
+      1, FLAGS_measurement_size / static_cast<int64_t>(size));
+  std::vector<uint64_t> offsets(concurrency * repeats);
+  for (auto& offset : offsets) {
+    offset = folly::Random::rand64(rng_) % (fileSize_ - size);
+  }
+  uint64_t usec = 0;
+  {
+    MicrosecondTimer timer(&usec);
+    std::vector<std::thread> threads;
+    threads.reserve(concurrency);
+    for (auto i = 0; i < concurrency; ++i) {
+      threads.emplace_back([&, i]() {
+        std::string buffer(size, 0);
+        for (auto repeat = 0; repeat < repeats; ++repeat) {
+          readFile_->pread(offsets[i * repeats + repeat], size, buffer.data());
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  std::cout << fmt::format(
+                   "{} MB/s {} threads reading {} bytes",
+                   static_cast<float>(size) * concurrency * repeats / usec,
+                   concurrency,
+                   size)
+            << std::endl;
+}
+
+void S3ReadBenchmark::runConcurrent() {
+  std::vector<std::string> levels;
+  folly::split(',', FLAGS_s3_concurrency, levels);
+  for (const auto& level : levels) {
+    concurrentReads(FLAGS_s3_concurrent_read_size, folly::to<int32_t>(level));
+  }
+}
+
 } // namespace facebook::velox
@@ -19,6 +19,8 @@
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 
 DECLARE_string(s3_config);
+DECLARE_string(s3_concurrency);
+DECLARE_int64(s3_concurrent_read_size);
 
 namespace facebook::velox {
 
@@ -53,6 +55,14 @@ class S3ReadBenchmark : public ReadBenchmark {
       rng_.seed(FLAGS_seed);
     }
   }
+
+  // Measures the throughput of 'concurrency' threads that each pread 'size'
+  // bytes at random offsets. With hive.s3.read-threads set, each pread is
+  // split into parallel ranged GETs.
+  void concurrentReads(uint64_t size, int32_t concurrency);
+
+  // Runs concurrentReads() for each of the --s3_concurrency levels.
+  void runConcurrent();
 };
 
 } // namespace facebook::velox
@@ -22,10 +22,13 @@ using namespace facebook::velox;
 // various ReadFile APIs. The output helps us understand the maximum possible
 // gains for queries. Example: If a single thread requires reading 1GB of data
 // and the IO throughput is 100 MBps, then it takes 10 seconds to just read the
-// data.
+// data. The concurrent measurements show the aggregate throughput of several
+// readers, e.g. to tune hive.s3.read-threads, hive.s3.read-range-size and
+// hive.s3.max-connections in --s3_config.
 int main(int argc, char** argv) {
   folly::Init init{&argc, &argv, false};
   S3ReadBenchmark bm;
   bm.initialize();
   bm.run();
+  bm.runConcurrent();
 }
@@ -60,6 +60,36 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const char* bucketName = "paralleldata";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Reads over 64KB are split into ranged GETs. The ranges of the first
+  // reads have latencies to hedge by.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-threads", "4"},
+       {"hive.s3.read-range-size", "64kB"},
+       {"hive.s3.hedge-percentile", "50"},
+       {"hive.s3.max-connections", "8"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  for (auto i = 0; i < 5; ++i) {
+    readData(readFile.get());
+  }
+
+  auto invalidConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-threads", "4"}, {"hive.s3.hedge-percentile", "100"}});
+  VELOX_ASSERT_THROW(
+      filesystems::S3FileSystem(invalidConfig),
+      "hive.s3.hedge-percentile must be less than 100");
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
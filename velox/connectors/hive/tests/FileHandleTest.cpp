@@ -48,3 +48,34 @@ TEST(FileHandleTest, localFile) {
   // Clean up
   remove(filename.c_str());
 }
+
+TEST(FileHandleTest, metadataKey) {
+  filesystems::registerLocalFileSystem();
+
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path;
+  remove(filename.c_str());
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foo");
+  }
+
+  cache::FileMetadataCache metadataCache(1 << 20);
+  FileHandleGenerator generator(nullptr, &metadataCache);
+  auto fileHandle = generator(filename);
+  ASSERT_EQ(fileHandle->metadataCache, &metadataCache);
+  ASSERT_EQ(fileHandle->metadataKey.find(filename + "@"), 0);
+  ASSERT_EQ(generator(filename)->metadataKey, fileHandle->metadataKey);
+
+  // A rewritten file has a different key.
+  remove(filename.c_str());
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foobar");
+  }
+  ASSERT_NE(generator(filename)->metadataKey, fileHandle->metadataKey);
+
+  // No cache means no key.
+  ASSERT_TRUE(FileHandleGenerator()(filename)->metadataKey.empty());
+  remove(filename.c_str());
+}
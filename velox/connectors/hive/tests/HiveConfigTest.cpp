@@ -40,17 +40,28 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(hiveConfig->s3SecretKey(), std::nullopt);
   ASSERT_EQ(hiveConfig->s3IAMRole(), std::nullopt);
   ASSERT_EQ(hiveConfig->s3IAMRoleSessionName(), "velox-session");
+  ASSERT_EQ(hiveConfig->s3MaxConnections(), 25);
+  ASSERT_EQ(hiveConfig->s3ReadThreads(), 0);
+  ASSERT_EQ(hiveConfig->s3ReadRangeSize(), 8UL << 20);
+  ASSERT_EQ(hiveConfig->s3HedgePercentile(), 0);
   ASSERT_EQ(hiveConfig->gcsEndpoint(), "");
   ASSERT_EQ(hiveConfig->gcsScheme(), "https");
   ASSERT_EQ(hiveConfig->gcsCredentials(), "");
+  ASSERT_EQ(hiveConfig->gcsUploadThreads(), 0);
+  ASSERT_EQ(hiveConfig->gcsUploadBlockSize(), 16 << 20);
+  ASSERT_EQ(hiveConfig->abfsUploadThreads(), 0);
+  ASSERT_EQ(hiveConfig->abfsUploadBlockSize(), 8 << 20);
+  ASSERT_EQ(hiveConfig->maxUploadBufferSize(), 64 << 20);
   ASSERT_EQ(hiveConfig->isOrcUseColumnNames(emptySession.get()), false);
   ASSERT_EQ(
       hiveConfig->isFileColumnNamesReadAsLowerCase(emptySession.get()), false);
 
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_FALSE(hiveConfig->adaptiveCoalesceEnabled());
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), true);
+  ASSERT_EQ(hiveConfig->fileMetadataCacheBytes(), 0);
   ASSERT_EQ(
       hiveConfig->orcWriterMaxStripeSize(emptySession.get()),
       64L * 1024L * 1024L);
@@ -77,15 +88,26 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kS3AwsSecretKey, "hello"},
       {HiveConfig::kS3IamRole, "hello"},
       {HiveConfig::kS3IamRoleSessionName, "velox"},
+      {HiveConfig::kS3MaxConnections, "100"},
+      {HiveConfig::kS3ReadThreads, "8"},
+      {HiveConfig::kS3ReadRangeSize, "16MB"},
+      {HiveConfig::kS3HedgePercentile, "95"},
       {HiveConfig::kGCSEndpoint, "hey"},
       {HiveConfig::kGCSScheme, "http"},
       {HiveConfig::kGCSCredentials, "hey"},
+      {HiveConfig::kGCSUploadThreads, "4"},
+      {HiveConfig::kGCSUploadBlockSize, "32MB"},
+      {HiveConfig::kAbfsUploadThreads, "8"},
+      {HiveConfig::kAbfsUploadBlockSize, "4MB"},
+      {HiveConfig::kMaxUploadBufferSize, "128MB"},
       {HiveConfig::kOrcUseColumnNames, "true"},
       {HiveConfig::kFileColumnNamesReadAsLowerCase, "true"},
       {HiveConfig::kMaxCoalescedBytes, "100"},
       {HiveConfig::kMaxCoalescedDistanceBytes, "100"},
+      {HiveConfig::kAdaptiveCoalesceEnabled, "true"},
       {HiveConfig::kNumCacheFileHandles, "100"},
       {HiveConfig::kEnableFileHandleCache, "false"},
+      {HiveConfig::kFileMetadataCacheBytes, "64MB"},
       {HiveConfig::kOrcWriterMaxStripeSize, "100MB"},
       {HiveConfig::kOrcWriterMaxDictionaryMemory, "100MB"},
       {HiveConfig::kSortWriterMaxOutputRows, "100"},
@@ -108,16 +130,27 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_EQ(hiveConfig->s3SecretKey(), std::optional("hello"));
   ASSERT_EQ(hiveConfig->s3IAMRole(), std::optional("hello"));
   ASSERT_EQ(hiveConfig->s3IAMRoleSessionName(), "velox");
+  ASSERT_EQ(hiveConfig->s3MaxConnections(), 100);
+  ASSERT_EQ(hiveConfig->s3ReadThreads(), 8);
+  ASSERT_EQ(hiveConfig->s3ReadRangeSize(), 16UL << 20);
+  ASSERT_EQ(hiveConfig->s3HedgePercentile(), 95);
   ASSERT_EQ(hiveConfig->gcsEndpoint(), "hey");
   ASSERT_EQ(hiveConfig->gcsScheme(), "http");
   ASSERT_EQ(hiveConfig->gcsCredentials(), "hey");
+  ASSERT_EQ(hiveConfig->gcsUploadThreads(), 4);
+  ASSERT_EQ(hiveConfig->gcsUploadBlockSize(), 32 << 20);
+  ASSERT_EQ(hiveConfig->abfsUploadThreads(), 8);
+  ASSERT_EQ(hiveConfig->abfsUploadBlockSize(), 4 << 20);
+  ASSERT_EQ(hiveConfig->maxUploadBufferSize(), 128 << 20);
   ASSERT_EQ(hiveConfig->isOrcUseColumnNames(emptySession.get()), true);
   ASSERT_EQ(
       hiveConfig->isFileColumnNamesReadAsLowerCase(emptySession.get()), true);
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 100);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 100);
+  ASSERT_TRUE(hiveConfig->adaptiveCoalesceEnabled());
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 100);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), false);
+  ASSERT_EQ(hiveConfig->fileMetadataCacheBytes(), 64UL << 20);
   ASSERT_EQ(
       hiveConfig->orcWriterMaxStripeSize(emptySession.get()),
       100L * 1024L * 1024L);
@@ -165,8 +198,10 @@ TEST(HiveConfigTest, overrideSession) {
 
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_FALSE(hiveConfig->adaptiveCoalesceEnabled());
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), true);
+  ASSERT_EQ(hiveConfig->fileMetadataCacheBytes(), 0);
   ASSERT_EQ(
       hiveConfig->orcWriterMaxStripeSize(session.get()), 22L * 1024L * 1024L);
   ASSERT_EQ(
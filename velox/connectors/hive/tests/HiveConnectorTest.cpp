@@ -430,6 +430,16 @@ TEST_F(HiveConnectorTest, extractFiltersFromRemainingFilter) {
   ASSERT_TRUE(remaining);
   ASSERT_EQ(
       remaining->toString(), "not(lt(ROW[\"c2\"],cast 0 as DECIMAL(20, 0)))");
+
+  // OR of ranges on the same column becomes one filter.
+  expr = parseExpr("c0 < 0 or c0 > 10 or c0 is null", rowType);
+  filters.clear();
+  remaining = HiveDataSource::extractFiltersFromRemainingFilter(
+      expr, &evaluator, false, filters);
+  ASSERT_FALSE(remaining);
+  ASSERT_EQ(filters.size(), 1);
+  ASSERT_TRUE(filters.at(Subfield("c0"))->testNull());
+  ASSERT_FALSE(filters.at(Subfield("c0"))->testInt64(5));
 }
 
 } // namespace
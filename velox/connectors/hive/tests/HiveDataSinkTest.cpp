@@ -18,6 +18,7 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -484,7 +485,7 @@ TEST_F(HiveDataSinkTest, basic) {
   ASSERT_TRUE(stats.empty()) << stats.toString();
   ASSERT_EQ(
       stats.toString(),
-      "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] maxSpillExceededLimitCount[0]");
+      "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] maxSpillExceededLimitCount[0] spillReads[0] spillReadBytes[0B] spillReadTime[0us] spillDeserializationTime[0us] spillMergeLevels[0] spillMergeRuns[0]");
 
   const int numBatches = 10;
   const auto vectors = createVectors(500, numBatches);
@@ -505,6 +506,185 @@ TEST_F(HiveDataSinkTest, basic) {
   verifyWrittenData(outputDirectory->path);
 }
 
+TEST_F(HiveDataSinkTest, maxTargetFileSize) {
+  const auto outputDirectory = TempDirectoryPath::create();
+  // Small stripes are flushed after each input so that the file reaches the
+  // target size.
+  auto dataSink = std::make_shared<HiveDataSink>(
+      rowType_,
+      createHiveInsertTableHandle(rowType_, outputDirectory->path),
+      connectorQueryCtx_.get(),
+      CommitStrategy::kNoCommit,
+      std::make_shared<HiveConfig>(std::make_shared<core::MemConfig>(
+          std::unordered_map<std::string, std::string>{
+              {HiveConfig::kMaxTargetFileSize, "1B"},
+              {HiveConfig::kOrcWriterMaxStripeSize, "1KB"}})));
+  const auto vectors = createVectors(500, 4);
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), 1);
+  const auto stats = dataSink->stats();
+  ASSERT_GT(stats.numWrittenFiles, 1);
+
+  const auto partitionUpdate = folly::parseJson(partitions[0]);
+  const auto& fileWriteInfos = partitionUpdate["fileWriteInfos"];
+  ASSERT_EQ(fileWriteInfos.size(), stats.numWrittenFiles);
+  int64_t fileSizes = 0;
+  for (const auto& fileWriteInfo : fileWriteInfos) {
+    fileSizes += fileWriteInfo["fileSize"].asInt();
+  }
+  ASSERT_EQ(fileSizes, stats.numWrittenBytes);
+  ASSERT_EQ(listFiles(outputDirectory->path).size(), stats.numWrittenFiles);
+
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (const auto& filePath : listFiles(outputDirectory->path)) {
+    splits.push_back(makeHiveConnectorSplit(filePath));
+  }
+  createDuckDbTable(vectors);
+  HiveConnectorTestBase::assertQuery(
+      PlanBuilder().tableScan(rowType_).planNode(),
+      splits,
+      "SELECT * FROM tmp");
+}
+
+TEST_F(HiveDataSinkTest, partitionedWritersMemoryLimit) {
+  const auto vectors = createVectors(500, 10);
+  for (bool limited : {false, true}) {
+    SCOPED_TRACE(fmt::format("limited: {}", limited));
+    const auto outputDirectory = TempDirectoryPath::create();
+    std::unordered_map<std::string, std::string> configs;
+    if (limited) {
+      configs[HiveConfig::kPartitionedWritersMemoryLimit] = "1KB";
+    }
+    auto dataSink = std::make_shared<HiveDataSink>(
+        rowType_,
+        createHiveInsertTableHandle(
+            rowType_,
+            outputDirectory->path,
+            dwio::common::FileFormat::DWRF,
+            {"c6"}),
+        connectorQueryCtx_.get(),
+        CommitStrategy::kNoCommit,
+        std::make_shared<HiveConfig>(
+            std::make_shared<core::MemConfig>(std::move(configs))));
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    if (limited) {
+      // The open writers are flushed after each input.
+      ASSERT_GE(dataSink->stats().numMemoryFlushes, vectors.size());
+    } else {
+      ASSERT_EQ(dataSink->stats().numMemoryFlushes, 0);
+    }
+    const auto partitions = dataSink->close();
+    ASSERT_EQ(partitions.size(), 2);
+  }
+}
+
+TEST_F(HiveDataSinkTest, parallelWriterClose) {
+  const auto vectors = createVectors(500, 10);
+  createDuckDbTable(vectors);
+  auto executor = std::make_unique<folly::IOThreadPoolExecutor>(4);
+  std::vector<size_t> numFiles;
+  for (bool parallel : {false, true}) {
+    SCOPED_TRACE(fmt::format("parallel: {}", parallel));
+    const auto outputDirectory = TempDirectoryPath::create();
+    std::unordered_map<std::string, std::string> configs;
+    configs[HiveConfig::kParallelWriterClose] = parallel ? "true" : "false";
+    auto dataSink = std::make_shared<HiveDataSink>(
+        rowType_,
+        createHiveInsertTableHandle(
+            rowType_,
+            outputDirectory->path,
+            dwio::common::FileFormat::DWRF,
+            {"c6"}),
+        connectorQueryCtx_.get(),
+        CommitStrategy::kNoCommit,
+        std::make_shared<HiveConfig>(
+            std::make_shared<core::MemConfig>(std::move(configs))),
+        executor.get());
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    const auto partitions = dataSink->close();
+    ASSERT_EQ(partitions.size(), 2);
+    numFiles.push_back(listFiles(outputDirectory->path).size());
+
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& file : listFiles(outputDirectory->path)) {
+      splits.push_back(makeHiveConnectorSplit(file));
+    }
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder().tableScan(ROW({"c0"}, {BIGINT()})).planNode(),
+        splits,
+        "SELECT c0 FROM tmp");
+  }
+  ASSERT_EQ(numFiles[0], numFiles[1]);
+}
+
+TEST_F(HiveDataSinkTest, clustering) {
+  const auto vectors = createVectors(500, 20);
+  createDuckDbTable(vectors);
+  for (auto curve :
+       {HiveClusteringProperty::Curve::kZOrder,
+        HiveClusteringProperty::Curve::kHilbert}) {
+    SCOPED_TRACE(dwio::common::ClusteringKeyEncoder::curveName(curve));
+    const auto outputDirectory = TempDirectoryPath::create();
+    const auto handle =
+        createHiveInsertTableHandle(rowType_, outputDirectory->path);
+    auto dataSink = std::make_shared<HiveDataSink>(
+        rowType_,
+        std::make_shared<HiveInsertTableHandle>(
+            handle->inputColumns(),
+            handle->locationHandle(),
+            dwio::common::FileFormat::DWRF,
+            nullptr,
+            CompressionKind::CompressionKind_ZSTD,
+            std::unordered_map<std::string, std::string>{},
+            std::make_shared<HiveClusteringProperty>(
+                curve, std::vector<std::string>{"c0", "c1"})),
+        connectorQueryCtx_.get(),
+        CommitStrategy::kNoCommit,
+        connectorConfig_);
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ASSERT_EQ(dataSink->stats().clusteringSelectivity, 0);
+    dataSink->close();
+
+    // The 10'000 rows are written in batches of 1024 rows. Each batch covers
+    // a part of the range of the clustering columns.
+    const auto stats = dataSink->stats();
+    ASSERT_GT(stats.clusteringSelectivity, 0);
+    ASSERT_LT(stats.clusteringSelectivity, 0.8);
+    verifyWrittenData(outputDirectory->path);
+  }
+
+  // A clustering column must be a data column.
+  const auto outputDirectory = TempDirectoryPath::create();
+  const auto handle =
+      createHiveInsertTableHandle(rowType_, outputDirectory->path);
+  VELOX_ASSERT_THROW(
+      std::make_shared<HiveDataSink>(
+          rowType_,
+          std::make_shared<HiveInsertTableHandle>(
+              handle->inputColumns(),
+              handle->locationHandle(),
+              dwio::common::FileFormat::DWRF,
+              nullptr,
+              CompressionKind::CompressionKind_ZSTD,
+              std::unordered_map<std::string, std::string>{},
+              std::make_shared<HiveClusteringProperty>(
+                  HiveClusteringProperty::Curve::kZOrder,
+                  std::vector<std::string>{"c0", "x"})),
+          connectorQueryCtx_.get(),
+          CommitStrategy::kNoCommit,
+          connectorConfig_),
+      "Hive clustering column is not a data column: x");
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -745,3 +745,38 @@ TEST_F(HivePartitionFunctionTest, unknown) {
   assertPartitionsWithConstChannel(values, 500);
   assertPartitionsWithConstChannel(values, 997);
 }
+
+TEST_F(HivePartitionFunctionTest, smallDictionary) {
+  // A dictionary with fewer values than rows is hashed once. The partitions
+  // must be the same as for the flat values.
+  constexpr vector_size_t kSize = 1'000;
+  auto bigints = makeNullableFlatVector<int64_t>(
+      {1, std::nullopt, -3, 1LL << 40, 7});
+  auto strings = makeNullableFlatVector<std::string>(
+      {"a", "bcd", std::nullopt, "", "efghijklmnopqrstuvwxyz"});
+  auto indices = makeIndices(kSize, [](auto row) { return (row * 7) % 5; });
+  auto nulls = makeNulls(kSize, [](auto row) { return row % 11 == 0; });
+
+  auto flatten = [&](const VectorPtr& base) {
+    auto dictionary = BaseVector::wrapInDictionary(nulls, indices, kSize, base);
+    auto flat = BaseVector::create(base->type(), kSize, pool());
+    flat->copy(dictionary.get(), 0, 0, kSize);
+    return std::make_pair(dictionary, flat);
+  };
+  auto [bigintDictionary, bigintFlat] = flatten(bigints);
+  auto [stringDictionary, stringFlat] = flatten(strings);
+
+  connector::hive::HivePartitionFunction function(
+      97, std::vector<column_index_t>{0, 1});
+  std::vector<uint32_t> expected;
+  function.partition(*makeRowVector({bigintFlat, stringFlat}), expected);
+  std::vector<uint32_t> partitions;
+  function.partition(
+      *makeRowVector({bigintDictionary, stringDictionary}), partitions);
+  ASSERT_EQ(expected, partitions);
+
+  // Mixed encodings.
+  function.partition(
+      *makeRowVector({bigintFlat, stringDictionary}), partitions);
+  ASSERT_EQ(expected, partitions);
+}
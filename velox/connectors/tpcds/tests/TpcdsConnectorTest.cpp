@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include "gtest/gtest.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace {
+
+using namespace facebook::velox;
+using namespace facebook::velox::connector::tpcds;
+
+using facebook::velox::exec::test::PlanBuilder;
+using facebook::velox::tpcds::Table;
+
+class TpcdsConnectorTest : public exec::test::OperatorTestBase {
+ public:
+  const std::string kTpcdsConnectorId = "test-tpcds";
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kTpcdsConnectorId);
+    OperatorTestBase::TearDown();
+  }
+
+  exec::Split makeTpcdsSplit(size_t totalParts = 1, size_t partNumber = 0)
+      const {
+    return exec::Split(std::make_shared<TpcdsConnectorSplit>(
+        kTpcdsConnectorId, totalParts, partNumber));
+  }
+
+  RowVectorPtr getResults(
+      const core::PlanNodePtr& planNode,
+      std::vector<exec::Split>&& splits) {
+    return exec::test::AssertQueryBuilder(planNode)
+        .splits(std::move(splits))
+        .copyResults(pool());
+  }
+};
+
+TEST_F(TpcdsConnectorTest, simple) {
+  auto plan = PlanBuilder()
+                  .tpcdsTableScan(
+                      Table::TBL_STORE,
+                      {"s_store_sk", "s_store_name", "s_state"},
+                      1)
+                  .limit(0, 3, false)
+                  .planNode();
+
+  auto output = getResults(plan, {makeTpcdsSplit()});
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<StringView>({"store#1", "store#2", "store#3"}),
+      makeFlatVector<StringView>({"TN", "TN", "SD"}),
+  });
+  test::assertEqualVectors(expected, output);
+}
+
+// Splits partition the rows of a table.
+TEST_F(TpcdsConnectorTest, multipleSplits) {
+  constexpr double kScaleFactor = 0.01;
+  const auto numRows = getRowCount(Table::TBL_STORE_SALES, kScaleFactor);
+  auto plan = PlanBuilder()
+                  .tpcdsTableScan(
+                      Table::TBL_STORE_SALES,
+                      {"ss_ticket_number", "ss_ext_sales_price"},
+                      kScaleFactor)
+                  .singleAggregation(
+                      {},
+                      {"count(1)",
+                       "sum(ss_ext_sales_price)",
+                       "max(ss_ticket_number)"})
+                  .planNode();
+
+  auto expected = getResults(plan, {makeTpcdsSplit()});
+  ASSERT_EQ(
+      numRows, expected->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
+
+  std::vector<exec::Split> splits;
+  constexpr size_t kNumSplits = 7;
+  for (size_t i = 0; i < kNumSplits; ++i) {
+    splits.push_back(makeTpcdsSplit(kNumSplits, i));
+  }
+  test::assertEqualVectors(expected, getResults(plan, std::move(splits)));
+}
+
+TEST_F(TpcdsConnectorTest, unknownColumn) {
+  EXPECT_THROW(
+      {
+        PlanBuilder()
+            .tpcdsTableScan(Table::TBL_ITEM, {"does_not_exist"})
+            .planNode();
+      },
+      VeloxUserError);
+}
+
+} // namespace
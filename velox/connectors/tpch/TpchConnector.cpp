@@ -71,7 +71,12 @@ TpchDataSource::TpchDataSource(
       tpchTableHandle, "TableHandle must be an instance of TpchTableHandle");
   tpchTable_ = tpchTableHandle->getTable();
   scaleFactor_ = tpchTableHandle->getScaleFactor();
-  tpchTableRowCount_ = getRowCount(tpchTable_, scaleFactor_);
+  // Lineitem is generated by orders, so its splits are ranges of orders.
+  // Partitioning by the lineitem row count would leave the last three
+  // quarters of the splits without rows.
+  tpchTableRowCount_ = getRowCount(
+      tpchTable_ == Table::TBL_LINEITEM ? Table::TBL_ORDERS : tpchTable_,
+      scaleFactor_);
 
   auto tpchTableSchema = getTableSchema(tpchTableHandle->getTable());
   VELOX_CHECK_NOT_NULL(tpchTableSchema, "TpchSchema can't be null.");
@@ -106,6 +106,8 @@ class TpchDataSource : public DataSource {
 
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
+  // Number of rows that the splits partition. The number of orders for
+  // lineitem.
   size_t tpchTableRowCount_{0};
   RowTypePtr outputType_;
 
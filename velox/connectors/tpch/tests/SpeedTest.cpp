@@ -19,17 +19,20 @@
 #include <chrono>
 
 #include "velox/common/memory/Memory.h"
+#include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/tpch/TpchConnector.h"
 #include "velox/connectors/tpch/TpchConnectorSplit.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TpchDataWriter.h"
 
 namespace {
 
 /// This a utility binary that helps measure and evaluate how fast we can
 /// generate TPC-H datasets using the TPC-H Connector. You can control the
 /// generated table, scale factor, number of splits, and number of threads
-/// (drivers) using the flags defined below.
+/// (drivers) using the flags defined below. With --data_path, the table is
+/// written to files there instead, e.g. to create datasets for benchmarks.
 
 DEFINE_string(table, "lineitem", "TPC-H table name to generate.");
 
@@ -48,6 +51,14 @@ DEFINE_int32(
     1,
     "Maximum number of drivers (threads) per pipeline.");
 
+DEFINE_string(
+    data_path,
+    "",
+    "If not empty, writes the table to files in this directory through a "
+    "TableWriter instead of discarding the rows.");
+
+DEFINE_string(data_format, "dwrf", "File format for --data_path.");
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
@@ -68,6 +79,40 @@ class TpchSpeedTest {
     connector::unregisterConnector(kTpchConnectorId_);
   }
 
+  // Writes 'table' to files of 'format' in 'path' with 'numSplits' splits.
+  void write(
+      tpch::Table table,
+      size_t scaleFactor,
+      size_t numSplits,
+      const std::string& path,
+      dwio::common::FileFormat format) {
+    LOG(INFO) << "Writing table '" << toTableName(table) << "' to " << path
+              << ".";
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId_, std::make_shared<core::MemConfig>());
+    connector::registerConnector(hiveConnector);
+
+    auto startTime = system_clock::now();
+    auto pool = memory::memoryManager()->addLeafPool();
+    const auto numRows = writeTpchTable(
+        table,
+        scaleFactor,
+        path,
+        format,
+        numSplits,
+        FLAGS_max_drivers,
+        pool.get());
+    std::chrono::duration<double> elapsed = system_clock::now() - startTime;
+    connector::unregisterConnector(kHiveConnectorId_);
+
+    LOG(INFO) << "Summary:";
+    LOG(INFO) << "\tTotal rows written: " << numRows;
+    LOG(INFO) << "\tTotal time spent: " << elapsed.count() << "s";
+  }
+
   void run(tpch::Table table, size_t scaleFactor, size_t numSplits) {
     LOG(INFO) << "Generating table '" << toTableName(table) << "'.";
 
@@ -167,6 +212,7 @@ class TpchSpeedTest {
   }
 
   const std::string kTpchConnectorId_{"test-tpch"};
+  const std::string kHiveConnectorId_{"test-hive"};
 
   size_t totalRows_{0};
   size_t totalBytes_{0};
@@ -181,9 +227,19 @@ class TpchSpeedTest {
 
 int main(int argc, char** argv) {
   folly::Init init{&argc, &argv, false};
+  memory::MemoryManager::initialize({});
 
   TpchSpeedTest speedTest;
-  speedTest.run(
-      tpch::fromTableName(FLAGS_table), FLAGS_scale_factor, FLAGS_num_splits);
+  if (FLAGS_data_path.empty()) {
+    speedTest.run(
+        tpch::fromTableName(FLAGS_table), FLAGS_scale_factor, FLAGS_num_splits);
+  } else {
+    speedTest.write(
+        tpch::fromTableName(FLAGS_table),
+        FLAGS_scale_factor,
+        FLAGS_num_splits,
+        FLAGS_data_path,
+        dwio::common::toFileFormat(FLAGS_data_format));
+  }
   return 0;
 }
@@ -16,11 +16,15 @@
 
 #include "velox/connectors/tpch/TpchConnector.h"
 #include <folly/init/Init.h>
+#include <filesystem>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/exec/tests/utils/TpchDataWriter.h"
 
 namespace {
 
@@ -194,6 +198,25 @@ TEST_F(TpchConnectorTest, lineitemTinyRowCount) {
   EXPECT_EQ(60'175, output->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
 }
 
+// Lineitem splits are ranges of orders, so all splits have rows.
+TEST_F(TpchConnectorTest, lineitemSplits) {
+  auto plan = PlanBuilder()
+                  .tpchTableScan(Table::TBL_LINEITEM, {"l_orderkey"}, 0.01)
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+
+  constexpr size_t kNumSplits = 8;
+  int64_t totalRows = 0;
+  for (size_t i = 0; i < kNumSplits; ++i) {
+    auto output = getResults(plan, {makeTpchSplit(kNumSplits, i)});
+    const auto numRows =
+        output->childAt(0)->asFlatVector<int64_t>()->valueAt(0);
+    ASSERT_GT(numRows, 0) << "split " << i;
+    totalRows += numRows;
+  }
+  EXPECT_EQ(60'175, totalRows);
+}
+
 TEST_F(TpchConnectorTest, unknownColumn) {
   EXPECT_THROW(
       {
@@ -286,6 +309,72 @@ TEST_F(TpchConnectorTest, orderDateCount) {
   EXPECT_EQ(9, orderDate->size());
 }
 
+class TpchTableWriteTest : public exec::test::HiveConnectorTestBase {
+ protected:
+  const std::string kTpchConnectorId = "test-tpch";
+
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
+    auto tpchConnector =
+        connector::getConnectorFactory(
+            connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+            ->newConnector(
+                kTpchConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpchConnector);
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kTpchConnectorId);
+    HiveConnectorTestBase::TearDown();
+  }
+};
+
+// Writes a table with several splits and drivers and checks that the files
+// have the rows of the generator.
+TEST_F(TpchTableWriteTest, orders) {
+  constexpr double kScaleFactor = 0.01;
+  auto outputDirectory = exec::test::TempDirectoryPath::create();
+  const auto numRows = exec::test::writeTpchTable(
+      Table::TBL_ORDERS,
+      kScaleFactor,
+      outputDirectory->path,
+      dwio::common::FileFormat::DWRF,
+      8,
+      4,
+      pool());
+  ASSERT_EQ(tpch::getRowCount(Table::TBL_ORDERS, kScaleFactor), numRows);
+
+  const std::vector<std::string> aggregates = {
+      "count(1)", "sum(o_orderkey)", "sum(o_custkey)", "max(o_comment)"};
+  auto expected =
+      exec::test::AssertQueryBuilder(
+          PlanBuilder()
+              .tpchTableScan(
+                  Table::TBL_ORDERS,
+                  {"o_orderkey", "o_custkey", "o_comment"},
+                  kScaleFactor)
+              .singleAggregation({}, aggregates)
+              .planNode())
+          .split(exec::Split(std::make_shared<TpchConnectorSplit>(
+              kTpchConnectorId, 1, 0)))
+          .copyResults(pool());
+
+  std::vector<exec::Split> splits;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(outputDirectory->path)) {
+    splits.emplace_back(makeHiveConnectorSplit(entry.path().string()));
+  }
+  ASSERT_FALSE(splits.empty());
+  auto actual = exec::test::AssertQueryBuilder(
+                    PlanBuilder()
+                        .tableScan(tpch::getTableSchema(Table::TBL_ORDERS))
+                        .singleAggregation({}, aggregates)
+                        .planNode())
+                    .splits(std::move(splits))
+                    .copyResults(pool());
+  test::assertEqualVectors(expected, actual);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
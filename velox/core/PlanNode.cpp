@@ -224,13 +224,6 @@ void addSortingKeys(
 } // namespace
 
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: Add spilling for aggregations over distinct inputs.
-  // https://github.com/facebookincubator/velox/issues/7454
-  for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
-      return false;
-    }
-  }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
   return (isFinal() || isSingle()) && preGroupedKeys().empty() &&
@@ -1543,10 +1536,12 @@ MarkDistinctNode::MarkDistinctNode(
     PlanNodeId id,
     std::string markerName,
     std::vector<FieldAccessTypedExprPtr> distinctKeys,
+    bool preGrouped,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
       markerName_(std::move(markerName)),
       distinctKeys_(std::move(distinctKeys)),
+      preGrouped_(preGrouped),
       sources_{std::move(source)},
       outputType_(
           getMarkDistinctOutputType(sources_[0]->outputType(), markerName_)) {
@@ -1558,6 +1553,7 @@ folly::dynamic MarkDistinctNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["distinctKeys"] = ISerializable::serialize(this->distinctKeys_);
   obj["markerName"] = this->markerName_;
+  obj["preGrouped"] = preGrouped_;
   return obj;
 }
 
@@ -1566,9 +1562,10 @@ PlanNodePtr MarkDistinctNode::create(const folly::dynamic& obj, void* context) {
   auto source = deserializeSingleSource(obj, context);
   auto distinctKeys = deserializeFields(obj["distinctKeys"], context);
   auto markerName = obj["markerName"].asString();
+  const bool preGrouped = obj["preGrouped"].asBool();
 
   return std::make_shared<MarkDistinctNode>(
-      deserializePlanNodeId(obj), markerName, distinctKeys, source);
+      deserializePlanNodeId(obj), markerName, distinctKeys, preGrouped, source);
 }
 
 namespace {
@@ -1891,12 +1888,20 @@ void LocalPartitionNode::addDetails(std::stringstream& stream) const {
   if (type_ != Type::kGather) {
     stream << " " << partitionFunctionSpec_->toString();
   }
+  if (scaleWriter_) {
+    stream << " scaleWriter";
+  }
+  if (outputKeyHashes_) {
+    stream << " keyHashes";
+  }
 }
 
 folly::dynamic LocalPartitionNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["type"] = typeName(type_);
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
+  obj["scaleWriter"] = scaleWriter_;
+  obj["outputKeyHashes"] = outputKeyHashes_;
   return obj;
 }
 
@@ -1909,7 +1914,9 @@ PlanNodePtr LocalPartitionNode::create(
       typeFromName(obj["type"].asString()),
       ISerializable::deserialize<PartitionFunctionSpec>(
           obj["partitionFunctionSpec"]),
-      deserializeSources(obj, context));
+      deserializeSources(obj, context),
+      obj.count("scaleWriter") && obj["scaleWriter"].asBool(),
+      obj.count("outputKeyHashes") && obj["outputKeyHashes"].asBool());
 }
 
 // static
@@ -2156,6 +2163,9 @@ PlanNodePtr OrderByNode::create(const folly::dynamic& obj, void* context) {
 }
 
 void MarkDistinctNode::addDetails(std::stringstream& stream) const {
+  if (preGrouped_) {
+    stream << "STREAMING ";
+  }
   addFields(stream, distinctKeys_);
 }
 
@@ -1123,21 +1123,45 @@ class LocalPartitionNode : public PlanNode {
 
   static Type typeFromName(const std::string& name);
 
+  /// Name of the BIGINT column with the hashes of the partitioning keys that
+  /// is added to the output if 'outputKeyHashes' is true.
+  static constexpr const char* kKeyHashColumn = "$key_hash";
+
+  /// If 'scaleWriter' is true, the node must be a round-robin repartition in
+  /// front of table writers. Each producer then starts by sending its input
+  /// to a single writer and adds writers while the writers do not keep up
+  /// with the input. Small writes then produce few files and large writes
+  /// use all writers.
+  ///
+  /// If 'outputKeyHashes' is true, the node must be a hash repartition and
+  /// appends the hashes of the partitioning keys to the output as column
+  /// 'kKeyHashColumn'. A downstream hash join build or hash aggregation on
+  /// the same keys then uses these instead of hashing the keys again.
   LocalPartitionNode(
       const PlanNodeId& id,
       Type type,
       PartitionFunctionSpecPtr partitionFunctionSpec,
-      std::vector<PlanNodePtr> sources)
+      std::vector<PlanNodePtr> sources,
+      bool scaleWriter = false,
+      bool outputKeyHashes = false)
       : PlanNode(id),
         type_{type},
         sources_{std::move(sources)},
-        partitionFunctionSpec_{std::move(partitionFunctionSpec)} {
+        partitionFunctionSpec_{std::move(partitionFunctionSpec)},
+        scaleWriter_{scaleWriter},
+        outputKeyHashes_{outputKeyHashes} {
     VELOX_USER_CHECK_GT(
         sources_.size(),
         0,
         "Local repartitioning node requires at least one source");
 
     VELOX_USER_CHECK_NOT_NULL(partitionFunctionSpec_);
+    VELOX_USER_CHECK(
+        !scaleWriter_ || type_ == Type::kRepartition,
+        "Scale writer local partitioning must be a repartition");
+    VELOX_USER_CHECK(
+        !outputKeyHashes_ || (type_ == Type::kRepartition && !scaleWriter_),
+        "Local partitioning with key hashes must be a hash repartition");
 
     for (auto i = 1; i < sources_.size(); ++i) {
       VELOX_USER_CHECK(
@@ -1146,6 +1170,19 @@ class LocalPartitionNode : public PlanNode {
           sources_[i]->outputType()->toString(),
           sources_[0]->outputType()->toString());
     }
+
+    outputType_ = sources_[0]->outputType();
+    if (outputKeyHashes_) {
+      VELOX_USER_CHECK(
+          !outputType_->containsChild(kKeyHashColumn),
+          "Input of local partitioning with key hashes must not have a column named {}",
+          kKeyHashColumn);
+      auto names = outputType_->names();
+      auto types = outputType_->children();
+      names.push_back(kKeyHashColumn);
+      types.push_back(BIGINT());
+      outputType_ = ROW(std::move(names), std::move(types));
+    }
   }
 
   static std::shared_ptr<LocalPartitionNode> gather(
@@ -1163,7 +1200,7 @@ class LocalPartitionNode : public PlanNode {
   }
 
   const RowTypePtr& outputType() const override {
-    return sources_[0]->outputType();
+    return outputType_;
   }
 
   const std::vector<PlanNodePtr>& sources() const override {
@@ -1174,6 +1211,15 @@ class LocalPartitionNode : public PlanNode {
     return *partitionFunctionSpec_;
   }
 
+  bool scaleWriter() const {
+    return scaleWriter_;
+  }
+
+  /// True if the last output column has the hashes of the partitioning keys.
+  bool outputKeyHashes() const {
+    return outputKeyHashes_;
+  }
+
   std::string_view name() const override {
     return "LocalPartition";
   }
@@ -1188,6 +1234,9 @@ class LocalPartitionNode : public PlanNode {
   const Type type_;
   const std::vector<PlanNodePtr> sources_;
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
+  const bool scaleWriter_;
+  const bool outputKeyHashes_;
+  RowTypePtr outputType_;
 };
 
 class PartitionedOutputNode : public PlanNode {
@@ -2258,10 +2307,14 @@ class RowNumberNode : public PlanNode {
 /// column.
 class MarkDistinctNode : public PlanNode {
  public:
+  /// @param preGrouped If true, the input is clustered on 'distinctKeys', i.e.
+  /// rows with the same keys are adjacent. The first row of each run of equal
+  /// keys is marked without building a hash table.
   MarkDistinctNode(
       PlanNodeId id,
       std::string markerName,
       std::vector<FieldAccessTypedExprPtr> distinctKeys,
+      bool preGrouped,
       PlanNodePtr source);
 
   const std::vector<PlanNodePtr>& sources() const override {
@@ -2285,6 +2338,10 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  bool isPreGrouped() const {
+    return preGrouped_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -2296,6 +2353,8 @@ class MarkDistinctNode : public PlanNode {
 
   const std::vector<FieldAccessTypedExprPtr> distinctKeys_;
 
+  const bool preGrouped_;
+
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
@@ -87,11 +87,36 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to evaluate trees of arithmetic and comparison functions over
+  /// fixed-width types in one pass over the rows without materializing the
+  /// intermediate results. False by default.
+  static constexpr const char* kExprFusionEnabled =
+      "expression.fusion_enabled";
+
+  /// Whether to resolve the function calls of expressions through the
+  /// process-wide ExprCompilationCache. True by default.
+  static constexpr const char* kExprCompilationCacheEnabled =
+      "expression.compilation_cache_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count CPU cycles, instructions, last level cache misses and
+  /// data TLB misses in Operator::getOutput() and Operator::addInput() using
+  /// Linux perf events. The counts are reported as the runtime stats
+  /// 'perfCycles', 'perfInstructions', 'perfLlcMisses' and 'perfDtlbMisses'
+  /// of each operator. False by default. Has no effect if perf events are not
+  /// available.
+  static constexpr const char* kOperatorTrackPerfCounters =
+      "track_operator_perf_counters";
+
+  /// Whether to record a timeline of operator calls, blocked drivers and
+  /// memory reclaims of the query in QueryCtx::timelineTracer(). The timeline
+  /// can be exported as Chrome trace JSON. False by default.
+  static constexpr const char* kTimelineTraceEnabled = "timeline_trace_enabled";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -106,6 +131,12 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// Minimum number of bytes that a scale writer local partition sends to
+  /// each of its writers before it adds a writer. A writer is added only if
+  /// the local exchange buffer is at least half full.
+  static constexpr const char* kScaleWriterMinProcessedBytes =
+      "scale_writer_min_processed_bytes";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
@@ -116,6 +147,12 @@ class QueryConfig {
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
+  /// If true, Exchange deserializes Presto pages without copying fixed width
+  /// values and strings that are contiguous in the received page. The
+  /// resulting vectors reference the page memory and keep it alive.
+  static constexpr const char* kExchangeZeroCopyDeserialize =
+      "exchange.zero_copy_deserialize";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -128,6 +165,25 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of input rows a partial aggregation passes through after
+  /// abandoning aggregation before it samples the input to decide whether to
+  /// aggregate again. 0 means never resume.
+  static constexpr const char* kPartialAggregationResumeCheckRows =
+      "partial_aggregation_resume_check_rows";
+
+  /// If true, a partial aggregation that directly consumes a table scan keeps
+  /// its output for each split in the AsyncDataCache and later queries with
+  /// the same plan fragment reuse it instead of reading the split again.
+  static constexpr const char* kSplitResultCacheEnabled =
+      "split_result_cache_enabled";
+
+  /// If true, a hash aggregation over raw input whose hash table is in array
+  /// mode combines the rows of each batch for sum, count, min, max and avg in
+  /// dense arrays indexed by group before updating the accumulators. Floating
+  /// point sums may then differ in the last bits.
+  static constexpr const char* kAggregationDenseAccumulation =
+      "aggregation_dense_accumulation_enabled";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -139,6 +195,20 @@ class QueryConfig {
 
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// The compression algorithm of the pages sent by PartitionedOutput and
+  /// received by Exchange. Supported types are the same as for
+  /// 'spill_compression_codec'. A page that does not compress well is sent
+  /// uncompressed, and compression is then skipped for a few pages.
+  static constexpr const char* kShuffleCompressionKind =
+      "shuffle_compression_codec";
+
+  /// The maximum size in bytes of the pages a broadcast output buffer retains
+  /// in memory for the destinations that have not been added yet. Above this,
+  /// the retained pages are written to the spill directory of the task and
+  /// read back by the destinations added later. 0 means no limit.
+  static constexpr const char* kMaxBroadcastRetainedBytes =
+      "max_broadcast_retained_bytes";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -158,6 +228,12 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, the Unnest operator splits the output of an input row whose
+  /// arrays or maps have more elements than fit in an output batch across
+  /// multiple batches. If false, all output rows of an input row are
+  /// returned in one batch.
+  static constexpr const char* kUnnestSplitOutput = "unnest_split_output";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
@@ -169,6 +245,12 @@ class QueryConfig {
   static constexpr const char* kHashAdaptivityEnabled =
       "hash_adaptivity_enabled";
 
+  /// Number of hash bits that split a final or single 'group by' into
+  /// 2^bits smaller hash tables, so that each table is more likely to be
+  /// cache resident. 0 means a single table.
+  static constexpr const char* kAggregationHashPartitionBits =
+      "aggregation_hash_partition_bits";
+
   /// If true, the conjunction expression can reorder inputs based on the time
   /// taken to calculate them.
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
@@ -263,6 +345,17 @@ class QueryConfig {
   static constexpr const char* kSpillWriteBufferSize =
       "spill_write_buffer_size";
 
+  /// Specifies the max bytes of the batches read ahead from spill files on the
+  /// spill executor when merging sorted spill runs. If it is set to zero, then
+  /// spill read ahead is disabled.
+  static constexpr const char* kSpillReadAheadBytes = "spill_read_ahead_bytes";
+
+  /// The max number of sorted spill runs merged at a time when restoring
+  /// spilled data. An aggregation with more spill runs first merges groups of
+  /// them into longer runs, in as many levels as needed. If it is set to zero,
+  /// then all the runs are merged at once.
+  static constexpr const char* kSpillMaxMergeFanIn = "spill_max_merge_fan_in";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
@@ -324,6 +417,25 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// If true, the parallel hash join table build inserts the rows of all the
+  /// build drivers into the shared table at the same time instead of in
+  /// partitions of the table.
+  static constexpr const char* kConcurrentHashJoinBuild =
+      "concurrent_hash_join_build";
+
+  /// The number of input batches after which a hash join build predicts from
+  /// the statistics of the join keys whether the table will be in kHash mode.
+  /// If so, the build stops collecting key statistics for the remaining
+  /// input. 0 disables the prediction.
+  static constexpr const char* kHashBuildModeSampleBatches =
+      "hash_build_mode_sample_batches";
+
+  /// The max size in bytes of a Bloom filter on a join key that a hash join
+  /// build pushes down into the probe side table scan when the key values
+  /// can't be pushed down as a range or IN-list. 0 disables the Bloom filters.
+  static constexpr const char* kHashJoinBloomFilterMaxBytes =
+      "hash_join_bloom_filter_max_bytes";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -351,12 +463,29 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// If not zero, the maximum number of Drivers started with the task for a
+  /// pipeline that reads splits of a table scan. The other Drivers of the
+  /// pipeline are started one by one while the pipeline has more queued splits
+  /// than started Drivers and memory arbitration is not in progress. All are
+  /// started once the splits are exhausted. Zero starts all Drivers at once.
+  static constexpr const char* kMaxInitialDriversPerPipeline =
+      "max_initial_drivers_per_pipeline";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
+  /// 0 to disable prefix-sort.
+  static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
+      "prefixsort_normalized_key_max_bytes";
+
+  /// Minimum number of rows to use prefix-sort. The default value has been
+  /// derived using micro-benchmarking.
+  static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
@@ -380,6 +509,18 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int64_t partialAggregationResumeCheckRows() const {
+    return get<int64_t>(kPartialAggregationResumeCheckRows, 0);
+  }
+
+  bool splitResultCacheEnabled() const {
+    return get<bool>(kSplitResultCacheEnabled, false);
+  }
+
+  bool aggregationDenseAccumulationEnabled() const {
+    return get<bool>(kAggregationDenseAccumulation, false);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -424,6 +565,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  std::string shuffleCompressionKind() const {
+    return get<std::string>(kShuffleCompressionKind, "none");
+  }
+
   /// Returns the maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -434,11 +579,20 @@ class QueryConfig {
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  uint64_t maxBroadcastRetainedBytes() const {
+    return get<uint64_t>(kMaxBroadcastRetainedBytes, 0);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  uint64_t scaleWriterMinProcessedBytes() const {
+    static constexpr uint64_t kDefault = 128UL << 20;
+    return get<uint64_t>(kScaleWriterMinProcessedBytes, kDefault);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
@@ -449,6 +603,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
   }
 
+  bool exchangeZeroCopyDeserialize() const {
+    return get<bool>(kExchangeZeroCopyDeserialize, false);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -462,6 +620,10 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool unnestSplitOutput() const {
+    return get<bool>(kUnnestSplitOutput, true);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
@@ -470,6 +632,11 @@ class QueryConfig {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
 
+  uint8_t aggregationHashPartitionBits() const {
+    constexpr uint8_t kMaxBits = 6;
+    return std::min(kMaxBits, get<uint8_t>(kAggregationHashPartitionBits, 0));
+  }
+
   uint32_t writeStrideSize() const {
     static constexpr uint32_t kDefault = 100'000;
     return kDefault;
@@ -617,6 +784,14 @@ class QueryConfig {
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
   }
 
+  uint64_t spillReadAheadBytes() const {
+    return get<uint64_t>(kSpillReadAheadBytes, 0);
+  }
+
+  uint32_t spillMaxMergeFanIn() const {
+    return get<uint32_t>(kSpillMaxMergeFanIn, 0);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
@@ -678,10 +853,26 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFusionEnabled() const {
+    return get<bool>(kExprFusionEnabled, false);
+  }
+
+  bool exprCompilationCacheEnabled() const {
+    return get<bool>(kExprCompilationCacheEnabled, true);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackPerfCounters() const {
+    return get<bool>(kOperatorTrackPerfCounters, false);
+  }
+
+  bool timelineTraceEnabled() const {
+    return get<bool>(kTimelineTraceEnabled, false);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -699,6 +890,18 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  bool concurrentHashJoinBuild() const {
+    return get<bool>(kConcurrentHashJoinBuild, false);
+  }
+
+  uint32_t hashBuildModeSampleBatches() const {
+    return get<uint32_t>(kHashBuildModeSampleBatches, 0);
+  }
+
+  uint64_t hashJoinBloomFilterMaxBytes() const {
+    return get<uint64_t>(kHashJoinBloomFilterMaxBytes, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -727,10 +930,22 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  uint32_t maxInitialDriversPerPipeline() const {
+    return get<uint32_t>(kMaxInitialDriversPerPipeline, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  uint32_t prefixSortNormalizedKeyMaxBytes() const {
+    return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
+  }
+
+  uint32_t prefixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortMinRows, 130);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -36,6 +36,7 @@ QueryCtx::QueryCtx(
       pool_(std::move(pool)),
       queryConfig_{std::move(queryConfig)} {
   initPool(queryId);
+  initTimelineTracer();
 }
 
 QueryCtx::QueryCtx(
@@ -55,6 +56,7 @@ QueryCtx::QueryCtx(
       pool_(std::move(pool)),
       queryConfig_{std::move(queryConfig)} {
   initPool(queryId);
+  initTimelineTracer();
 }
 
 QueryCtx::QueryCtx(
@@ -72,6 +74,7 @@ QueryCtx::QueryCtx(
       executorKeepalive_(std::move(executorKeepalive)),
       queryConfig_{std::move(queryConfigValues)} {
   initPool(queryId);
+  initTimelineTracer();
 }
 
 /*static*/ std::string QueryCtx::generatePoolName(const std::string& queryId) {
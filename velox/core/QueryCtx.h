@@ -20,6 +20,7 @@
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/TimelineTracer.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
@@ -93,6 +94,12 @@ class QueryCtx {
     return queryConfig_;
   }
 
+  /// Returns the timeline of the query if QueryConfig::timelineTraceEnabled()
+  /// was set at construction, nullptr otherwise.
+  process::TimelineTracer* timelineTracer() const {
+    return timelineTracer_.get();
+  }
+
   Config* connectorSessionProperties(const std::string& connectorId) const {
     auto it = connectorSessionProperties_.find(connectorId);
     if (it == connectorSessionProperties_.end()) {
@@ -133,6 +140,21 @@ class QueryCtx {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Adds to the wall time the drivers of this query ran on executor threads
+  /// and waited in the executor queue.
+  void addDriverSchedulingTime(uint64_t scheduledNanos, uint64_t queuedNanos) {
+    driverScheduledNanos_ += scheduledNanos;
+    driverQueuedNanos_ += queuedNanos;
+  }
+
+  uint64_t driverScheduledNanos() const {
+    return driverScheduledNanos_;
+  }
+
+  uint64_t driverQueuedNanos() const {
+    return driverQueuedNanos_;
+  }
+
  private:
   static Config* getEmptyConfig() {
     static const std::unique_ptr<Config> kEmptyConfig =
@@ -147,6 +169,12 @@ class QueryCtx {
     }
   }
 
+  void initTimelineTracer() {
+    if (queryConfig_.timelineTraceEnabled()) {
+      timelineTracer_ = std::make_unique<process::TimelineTracer>();
+    }
+  }
+
   const std::string queryId_;
   folly::Executor* const executor_{nullptr};
   folly::Executor* const spillExecutor_{nullptr};
@@ -158,6 +186,9 @@ class QueryCtx {
   folly::Executor::KeepAlive<> executorKeepalive_;
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
+  std::atomic<uint64_t> driverScheduledNanos_{0};
+  std::atomic<uint64_t> driverQueuedNanos_{0};
+  std::unique_ptr<process::TimelineTracer> timelineTracer_;
 };
 
 // Represents the state of one thread of query execution.
@@ -20,6 +20,7 @@
 #include <optional>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/core/Metaprogramming.h"
 #include "velox/core/QueryConfig.h"
@@ -492,6 +493,8 @@ class UDFHolder final
     : public core::
           SimpleFunctionMetadata<Fun, TReturn, ConstantChecker, TArgs...> {
   Fun instance_;
+  // Error returned by the last call() if call() returns Status.
+  Status status_;
 
  public:
   using udf_struct_t = Fun;
@@ -525,6 +528,7 @@ class UDFHolder final
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
 
   // Check which flavor of the call() method is provided by the UDF object. UDFs
   // are required to provide at least one of the following methods:
@@ -534,12 +538,14 @@ class UDFHolder final
   // - bool|void callNullFree(...)
   //
   // Each of these methods can return either bool or void. Returning void means
-  // that the UDF is assumed never to return null values.
+  // that the UDF is assumed never to return null values. call() can also
+  // return Status to report a user error for the row without throwing.
   //
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
   // - void initialize(...)
+  // - int32_t callBatch(...)
 
   // call():
   static constexpr bool udf_has_call_return_bool = util::has_method<
@@ -554,11 +560,18 @@ class UDFHolder final
       void,
       exec_return_type,
       const exec_arg_type<TArgs>&...>::value;
-  static constexpr bool udf_has_call =
-      udf_has_call_return_bool | udf_has_call_return_void;
+  static constexpr bool udf_has_call_return_status = util::has_method<
+      Fun,
+      call_method_resolver,
+      Status,
+      exec_return_type,
+      const exec_arg_type<TArgs>&...>::value;
+  static constexpr bool udf_has_call = udf_has_call_return_bool |
+      udf_has_call_return_void | udf_has_call_return_status;
   static_assert(
-      !(udf_has_call_return_bool && udf_has_call_return_void),
-      "Provided call() methods need to return either void OR bool.");
+      (udf_has_call_return_bool + udf_has_call_return_void +
+       udf_has_call_return_status) <= 1,
+      "Provided call() methods need to return either void OR bool OR Status.");
 
   // callNullable():
   static constexpr bool udf_has_callNullable_return_bool = util::has_method<
@@ -631,6 +644,23 @@ class UDFHolder final
       const core::QueryConfig&,
       const exec_arg_type<TArgs>*...>::value;
 
+  // callBatch(): computes call() for 'size' consecutive non-null rows given as
+  // arrays of values. A BOOLEAN result is written as a bit mask. Returns the
+  // number of leading rows computed. The caller computes the rest with
+  // call(), so that a function can stop at the first row that can fail and
+  // leave the error to call(). Must not throw.
+  using batch_return_type = std::conditional_t<
+      std::is_same_v<exec_return_type, bool>,
+      uint64_t,
+      exec_return_type>;
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      int32_t,
+      batch_return_type*,
+      const exec_arg_type<TArgs>*...,
+      int32_t>::value;
+
   static_assert(
       udf_has_call || udf_has_callNullable || udf_has_callNullFree,
       "UDF must implement at least one of `call`, `callNullable`, or `callNullFree` functions.\n"
@@ -654,8 +684,8 @@ class UDFHolder final
   // them return bool). This is only false if all the call methods provided for
   // a function return void.
   static constexpr bool can_produce_null_output = udf_has_call_return_bool |
-      udf_has_callNullable_return_bool | udf_has_callNullFree_return_bool |
-      udf_has_callAscii_return_bool;
+      udf_has_call_return_status | udf_has_callNullable_return_bool |
+      udf_has_callNullFree_return_bool | udf_has_callAscii_return_bool;
 
   // This is true when callNullFree is implemented, but not call or
   // callNullable. In this case if any input is NULL or any complex type in
@@ -686,6 +716,12 @@ class UDFHolder final
 
   explicit UDFHolder() : Metadata(), instance_{} {}
 
+  /// Returns the error of the last call() that returned false if the UDF
+  /// call() returns Status.
+  Status takeStatus() {
+    return std::move(status_);
+  }
+
   FOLLY_ALWAYS_INLINE void initialize(
       const core::QueryConfig& config,
       const typename exec_resolver<TArgs>::in_type*... constantArgs) {
@@ -749,6 +785,18 @@ class UDFHolder final
     }
   }
 
+  FOLLY_ALWAYS_INLINE int32_t callBatch(
+      batch_return_type* out,
+      const typename exec_resolver<TArgs>::in_type*... args,
+      int32_t size) {
+    if constexpr (udf_has_callBatch) {
+      return instance_.callBatch(out, args..., size);
+    } else {
+      VELOX_UNREACHABLE(
+          "callBatch should never be called if the UDF does not implement callBatch.");
+    }
+  }
+
   // Helper functions to handle void vs bool return type.
 
   FOLLY_ALWAYS_INLINE bool callImpl(
@@ -757,6 +805,9 @@ class UDFHolder final
     static_assert(udf_has_call);
     if constexpr (udf_has_call_return_bool) {
       return instance_.call(out, args...);
+    } else if constexpr (udf_has_call_return_status) {
+      status_ = instance_.call(out, args...);
+      return status_.ok();
     } else {
       instance_.call(out, args...);
       return true;
@@ -206,6 +206,10 @@ void CacheInputStream::loadSync(Region region) {
       // missed, fall back to remote fetching.
       entry->setGroupId(groupId_);
       entry->setTrackingId(trackingId_);
+      if (tracker_ != nullptr) {
+        entry->setCompressible(
+            cache_->isCompressible(tracker_->readPct(trackingId_)));
+      }
       if (loadFromSsd(region, *entry)) {
         return;
       }
@@ -15,8 +15,12 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Allocation.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -86,16 +90,19 @@ bool CachedBufferedInput::shouldPreload(int32_t numPages) {
                     memory::AllocationTraits::kPageSize) /
         memory::AllocationTraits::kPageSize;
   }
+  // The read-ahead budget shrinks when the memory arbitrator is short of free
+  // capacity.
+  const auto& throttle = memory::PrefetchThrottle::instance();
   auto cachePages = cache_->incrementCachedPages(0);
   auto allocator = cache_->allocator();
   auto maxPages = memory::AllocationTraits::numPages(allocator->capacity());
   auto allocatedPages = allocator->numAllocated();
-  if (numPages < maxPages - allocatedPages) {
+  if (numPages < throttle.scale(maxPages - allocatedPages)) {
     // There is free space for the read-ahead.
     return true;
   }
   auto prefetchPages = cache_->incrementPrefetchPages(0);
-  if (numPages + prefetchPages < cachePages / 2) {
+  if (numPages + prefetchPages < throttle.scale(cachePages / 2)) {
     // The planned prefetch plus other prefetches are under half the cache.
     return true;
   }
@@ -189,6 +196,8 @@ void CachedBufferedInput::load(const LogType) {
           if (cache_->exists(part->key)) {
             continue;
           }
+          part->compressible =
+              cache_->isCompressible(adjustedReadPct(trackingData));
           if (ssdFile) {
             part->ssdPin = ssdFile->find(part->key);
             if (!part->ssdPin.empty() &&
@@ -266,16 +275,23 @@ void CachedBufferedInput::makeLoads(
         ++numNewLoads;
         readRegion(ranges, prefetch);
       });
-  if (prefetch && executor_) {
+  // Without a prefetch budget the loads are made by the first reader.
+  if (prefetch && executor_ &&
+      memory::PrefetchThrottle::instance().prefetchPct() > 0) {
     std::vector<int32_t> doneIndices;
     for (auto i = 0; i < allCoalescedLoads_.size(); ++i) {
       auto& load = allCoalescedLoads_[i];
       if (load->state() == CoalescedLoad::State::kPlanned) {
         prefetchSize_ += load->size();
-        executor_->add([pendingLoad = load]() {
-          process::TraceContext trace("Read Ahead");
-          pendingLoad->loadOrFuture(nullptr);
-        });
+        if (load->hasLoadDataAsync()) {
+          // Issues the reads and returns without taking an executor thread.
+          CoalescedLoad::loadAsync(load);
+        } else {
+          executor_->add([pendingLoad = load]() {
+            process::TraceContext trace("Read Ahead");
+            pendingLoad->loadOrFuture(nullptr);
+          });
+        }
       } else {
         doneIndices.push_back(i);
       }
@@ -387,17 +403,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
         maxCoalesceDistance_(maxCoalesceDistance) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
-    std::vector<CachePin> pins;
-    pins.reserve(keys_.size());
-    cache_.makePins(
-        keys_,
-        [&](int32_t index) { return sizes_[index]; },
-        [&](int32_t /*index*/, CachePin pin) {
-          if (isPrefetch) {
-            pin.checkedEntry()->setPrefetch(true);
-          }
-          pins.push_back(std::move(pin));
-        });
+    auto pins = makePins(isPrefetch);
     if (pins.empty()) {
       return pins;
     }
@@ -411,12 +417,73 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t micros{0};
+          {
+            MicrosecondTimer timer(&micros);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          RECORD_HISTOGRAM_METRIC_VALUE(
+              kMetricStorageReadLatencyMs, micros / 1'000);
         });
     updateStats(stats, isPrefetch, false);
     return pins;
   }
 
+  // Like loadData() but issues the reads with readAsync() and returns when
+  // they are in flight.
+  folly::SemiFuture<std::vector<CachePin>> loadDataAsync(
+      bool isPrefetch) override {
+    auto pins = makePins(isPrefetch);
+    if (pins.empty()) {
+      return folly::makeSemiFuture(std::move(pins));
+    }
+    std::vector<folly::SemiFuture<uint64_t>> reads;
+    auto stats = cache::readPins(
+        pins,
+        maxCoalesceDistance_,
+        1000,
+        [&](int32_t i) { return pins[i].entry()->offset(); },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          reads.push_back(input_->readAsync(buffers, offset, LogType::FILE));
+        });
+    return folly::collectAll(std::move(reads))
+        .deferValue([this, pins = std::move(pins), stats, isPrefetch](
+                        std::vector<folly::Try<uint64_t>>&& results) mutable {
+          for (auto& result : results) {
+            // Rethrows the first error. The exclusive pins are then freed.
+            result.value();
+          }
+          updateStats(stats, isPrefetch, false);
+          return std::move(pins);
+        });
+  }
+
+  bool hasLoadDataAsync() const override {
+    return input_->hasReadAsync();
+  }
+
+ private:
+  // Makes exclusive pins for the entries that are not in the cache.
+  std::vector<CachePin> makePins(bool isPrefetch) {
+    std::vector<CachePin> pins;
+    pins.reserve(keys_.size());
+    cache_.makePins(
+        keys_,
+        [&](int32_t index) { return sizes_[index]; },
+        [&](int32_t index, CachePin pin) {
+          if (isPrefetch) {
+            pin.checkedEntry()->setPrefetch(true);
+          }
+          pin.checkedEntry()->setCompressible(requests_[index].compressible);
+          pins.push_back(std::move(pin));
+        });
+    return pins;
+  }
+
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
 };
@@ -51,6 +51,10 @@ struct CacheRequest {
   // for sparsely accessed large columns where hitting one piece
   // should not load the adjacent pieces.
   bool coalesces{true};
+
+  // True if the entry may be kept compressed in memory after eviction. See
+  // AsyncDataCache::setCompressedTier().
+  bool compressible{false};
   const SeekableInputStream* FOLLY_NONNULL stream;
 };
 
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/common/ClusteringKeyEncoder.h"
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+constexpr uint64_t kSignBit = 1ULL << 63;
+
+bool isSupported(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+uint64_t orderedInt(int64_t value) {
+  return static_cast<uint64_t>(value) ^ kSignBit;
+}
+
+uint64_t orderedDouble(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return (bits & kSignBit) ? ~bits : bits | kSignBit;
+}
+
+uint64_t orderedString(StringView value) {
+  uint64_t result = 0;
+  const auto size = std::min<int32_t>(value.size(), sizeof(uint64_t));
+  for (auto i = 0; i < size; ++i) {
+    result |= static_cast<uint64_t>(static_cast<uint8_t>(value.data()[i]))
+        << (56 - 8 * i);
+  }
+  return result;
+}
+
+uint64_t orderedValue(
+    const DecodedVector& decoded,
+    TypeKind kind,
+    vector_size_t row) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      return decoded.valueAt<bool>(row);
+    case TypeKind::TINYINT:
+      return orderedInt(decoded.valueAt<int8_t>(row));
+    case TypeKind::SMALLINT:
+      return orderedInt(decoded.valueAt<int16_t>(row));
+    case TypeKind::INTEGER:
+      return orderedInt(decoded.valueAt<int32_t>(row));
+    case TypeKind::BIGINT:
+      return orderedInt(decoded.valueAt<int64_t>(row));
+    case TypeKind::REAL:
+      return orderedDouble(decoded.valueAt<float>(row));
+    case TypeKind::DOUBLE:
+      return orderedDouble(decoded.valueAt<double>(row));
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return orderedString(decoded.valueAt<StringView>(row));
+    case TypeKind::TIMESTAMP:
+      return orderedInt(decoded.valueAt<Timestamp>(row).toMillis());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Places the low bits of 'value' at the set bits of 'mask'.
+inline uint64_t depositBits(uint64_t value, uint64_t mask) {
+#ifdef __BMI2__
+  return _pdep_u64(value, mask);
+#else
+  uint64_t result = 0;
+  for (uint64_t bit = 1; mask != 0; bit <<= 1) {
+    if (value & bit) {
+      result |= mask & -mask;
+    }
+    mask &= mask - 1;
+  }
+  return result;
+#endif
+}
+
+} // namespace
+
+ClusteringKeyEncoder::ClusteringKeyEncoder(
+    Curve curve,
+    RowTypePtr type,
+    std::vector<column_index_t> columns)
+    : curve_(curve),
+      type_(std::move(type)),
+      columns_(std::move(columns)),
+      bitsPerColumn_(
+          columns_.empty() ? 0
+                           : std::min<int32_t>(32, 63 / columns_.size())),
+      masks_(columns_.size()),
+      ranges_(columns_.size()),
+      codes_(columns_.size()) {
+  VELOX_USER_CHECK(!columns_.empty(), "Clustering columns must be set");
+  VELOX_USER_CHECK_LE(columns_.size(), 63, "Too many clustering columns");
+  for (auto column : columns_) {
+    VELOX_USER_CHECK_LT(column, type_->size());
+    const auto& columnType = type_->childAt(column);
+    VELOX_USER_CHECK(
+        isSupported(columnType->kind()),
+        "Unsupported clustering column type: {}",
+        columnType->toString());
+  }
+  // Code bit 'bit' of column i goes to key bit 'bit * n + n - 1 - i', so
+  // that the first column has the most significant bit of each group.
+  const int32_t n = columns_.size();
+  for (auto i = 0; i < n; ++i) {
+    for (auto bit = 0; bit < bitsPerColumn_; ++bit) {
+      masks_[i] |= 1ULL << (bit * n + n - 1 - i);
+    }
+  }
+}
+
+// static
+std::string ClusteringKeyEncoder::curveName(Curve curve) {
+  switch (curve) {
+    case Curve::kZOrder:
+      return "ZORDER";
+    case Curve::kHilbert:
+      return "HILBERT";
+    default:
+      return fmt::format("UNKNOWN {}", static_cast<int>(curve));
+  }
+}
+
+// static
+ClusteringKeyEncoder::Curve ClusteringKeyEncoder::curveFromName(
+    const std::string& name) {
+  if (name == "ZORDER") {
+    return Curve::kZOrder;
+  }
+  if (name == "HILBERT") {
+    return Curve::kHilbert;
+  }
+  VELOX_USER_FAIL("Unknown clustering curve: {}", name);
+}
+
+void ClusteringKeyEncoder::encodeColumn(
+    const RowVector& input,
+    int32_t i,
+    std::vector<uint32_t>& codes) {
+  const auto& vector = *input.childAt(columns_[i]);
+  const auto kind = vector.typeKind();
+  const auto size = input.size();
+  DecodedVector decoded(vector);
+  values_.resize(size);
+  auto min = std::numeric_limits<uint64_t>::max();
+  uint64_t max = 0;
+  bool hasValues = false;
+  for (auto row = 0; row < size; ++row) {
+    if (!decoded.isNullAt(row)) {
+      values_[row] = orderedValue(decoded, kind, row);
+      min = std::min(min, values_[row]);
+      max = std::max(max, values_[row]);
+      hasValues = true;
+    }
+  }
+  auto& range = ranges_[i];
+  if (!range.has_value() && hasValues) {
+    range = std::make_pair(min, max);
+  }
+
+  // Code 0 is for nulls.
+  const uint64_t maxCode = bits::lowMask(bitsPerColumn_);
+  codes.resize(size);
+  for (auto row = 0; row < size; ++row) {
+    if (decoded.isNullAt(row)) {
+      codes[row] = 0;
+      continue;
+    }
+    const auto [low, high] = range.value();
+    const auto value = std::clamp(values_[row], low, high);
+    const auto scaled = high == low
+        ? 0
+        : static_cast<uint64_t>(
+              static_cast<long double>(value - low) / (high - low) *
+              (maxCode - 1));
+    codes[row] = 1 + scaled;
+  }
+}
+
+void ClusteringKeyEncoder::encode(
+    const RowVector& input,
+    FlatVector<int64_t>& keys) {
+  const auto size = input.size();
+  const auto n = numColumns();
+  for (auto i = 0; i < n; ++i) {
+    encodeColumn(input, i, codes_[i]);
+  }
+  keys.resize(size);
+  keys.clearAllNulls();
+  auto* rawKeys = keys.mutableRawValues();
+  // A Hilbert curve over one dimension is the identity.
+  if (curve_ == Curve::kZOrder || n == 1) {
+    std::fill(rawKeys, rawKeys + size, 0);
+    for (auto i = 0; i < n; ++i) {
+      const auto* codes = codes_[i].data();
+      const auto mask = masks_[i];
+      for (auto row = 0; row < size; ++row) {
+        rawKeys[row] |= depositBits(codes[row], mask);
+      }
+    }
+    return;
+  }
+  std::vector<uint32_t> point(n);
+  for (auto row = 0; row < size; ++row) {
+    for (auto i = 0; i < n; ++i) {
+      point[i] = codes_[i][row];
+    }
+    hilbertTranspose(point.data(), n, bitsPerColumn_);
+    uint64_t key = 0;
+    for (auto i = 0; i < n; ++i) {
+      key |= depositBits(point[i], masks_[i]);
+    }
+    rawKeys[row] = key;
+  }
+}
+
+// static
+void ClusteringKeyEncoder::hilbertTranspose(
+    uint32_t* point,
+    int32_t size,
+    int32_t numBits) {
+  // J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004.
+  if (numBits == 0) {
+    return;
+  }
+  const uint32_t highBit = 1U << (numBits - 1);
+  // Inverse undo.
+  for (uint32_t q = highBit; q > 1; q >>= 1) {
+    const uint32_t p = q - 1;
+    for (auto i = 0; i < size; ++i) {
+      if (point[i] & q) {
+        point[0] ^= p;
+      } else {
+        const uint32_t t = (point[0] ^ point[i]) & p;
+        point[0] ^= t;
+        point[i] ^= t;
+      }
+    }
+  }
+  // Gray encode.
+  for (auto i = 1; i < size; ++i) {
+    point[i] ^= point[i - 1];
+  }
+  uint32_t t = 0;
+  for (uint32_t q = highBit; q > 1; q >>= 1) {
+    if (point[size - 1] & q) {
+      t ^= q - 1;
+    }
+  }
+  for (auto i = 0; i < size; ++i) {
+    point[i] ^= t;
+  }
+}
+
+} // namespace facebook::velox::dwio::common
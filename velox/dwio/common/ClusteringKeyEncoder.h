@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Computes keys that order rows along a space-filling curve over several
+/// columns. Sorting a file on the keys clusters it on all the columns at
+/// once, so that the min/max statistics of the stripes or row groups prune
+/// filters on any of the columns.
+///
+/// The value of each column is mapped to an order preserving code of
+/// bitsPerColumn() bits. The codes are scaled over the value range of the
+/// column in the first batch with non-null values. Later values outside of
+/// this range are clamped to it. Strings are ordered by their first 8 bytes.
+/// Nulls have the lowest code.
+class ClusteringKeyEncoder {
+ public:
+  enum class Curve {
+    /// Interleaves the bits of the codes, most significant bits first.
+    kZOrder,
+    /// Orders the codes along a Hilbert curve. Clusters somewhat better
+    /// than Z-order since consecutive keys are always adjacent.
+    kHilbert,
+  };
+
+  /// 'columns' are the indices of the clustering columns in 'type'.
+  ClusteringKeyEncoder(
+      Curve curve,
+      RowTypePtr type,
+      std::vector<column_index_t> columns);
+
+  static std::string curveName(Curve curve);
+
+  static Curve curveFromName(const std::string& name);
+
+  Curve curve() const {
+    return curve_;
+  }
+
+  const RowTypePtr& type() const {
+    return type_;
+  }
+
+  int32_t numColumns() const {
+    return columns_.size();
+  }
+
+  int32_t bitsPerColumn() const {
+    return bitsPerColumn_;
+  }
+
+  /// Sets 'keys' to the non-negative keys of the rows of 'input'.
+  void encode(const RowVector& input, FlatVector<int64_t>& keys);
+
+  /// Sets 'codes' to the codes of the i-th clustering column of the rows of
+  /// 'input'.
+  void encodeColumn(
+      const RowVector& input,
+      int32_t i,
+      std::vector<uint32_t>& codes);
+
+  /// Maps the codes of a point to its position on a Hilbert curve of
+  /// 'numBits' bits per dimension, in the transposed form where the bits of
+  /// the position are interleaved over the dimensions like in Z-order.
+  static void hilbertTranspose(uint32_t* point, int32_t size, int32_t numBits);
+
+ private:
+  // Order preserving unsigned value of each row of 'vector'.
+  void orderedValues(const BaseVector& vector, std::vector<uint64_t>& values);
+
+  const Curve curve_;
+  const RowTypePtr type_;
+  const std::vector<column_index_t> columns_;
+  const int32_t bitsPerColumn_;
+
+  // Bit positions of the code of each column in the Z-order key.
+  std::vector<uint64_t> masks_;
+
+  // Value range of each column. Set from the first batch with non-null
+  // values of the column.
+  std::vector<std::optional<std::pair<uint64_t, uint64_t>>> ranges_;
+
+  std::vector<uint64_t> values_;
+  std::vector<std::vector<uint32_t>> codes_;
+};
+
+/// Measures how well the batches written to a file are clustered.
+struct ClusteringStats {
+  /// Number of measured batches.
+  uint64_t numBatches{0};
+
+  /// Sum over the batches of the fraction of the value range of a
+  /// clustering column in the file that the batch covers, averaged over the
+  /// clustering columns. A filter on a single value of a clustering column
+  /// reads about numBatches * selectivity() batches.
+  double sumSelectivity{0};
+
+  double selectivity() const {
+    return numBatches == 0 ? 0 : sumSelectivity / numBatches;
+  }
+
+  ClusteringStats& operator+=(const ClusteringStats& other) {
+    numBatches += other.numBatches;
+    sumSelectivity += other.sumSelectivity;
+    return *this;
+  }
+};
+
+} // namespace facebook::velox::dwio::common
@@ -512,6 +512,28 @@ void ExtractToReader<TReader>::addNull(vector_size_t /*rowIndex*/) {
 
 enum FilterResult { kUnknown = 0x40, kSuccess = 0x80, kFailure = 0 };
 
+// Sets 'filterCache' to the result of 'filter' for each of the 'numValues'
+// dictionary entries in 'values'. Returns true if any entry passes. Used to
+// evaluate a deterministic filter once per dictionary before decoding the
+// indices.
+template <typename T>
+bool fillFilterCache(
+    velox::common::Filter& filter,
+    const T* values,
+    int32_t numValues,
+    raw_vector<uint8_t>& filterCache) {
+  // Make sure there is a cache even for an empty dictionary, see
+  // SelectiveIntegerDictionaryColumnReader.
+  filterCache.resize(std::max<int32_t>(1, numValues));
+  bool anyPassed = false;
+  for (auto i = 0; i < numValues; ++i) {
+    const bool passed = velox::common::applyFilter(filter, values[i]);
+    filterCache[i] = passed ? FilterResult::kSuccess : FilterResult::kFailure;
+    anyPassed |= passed;
+  }
+  return anyPassed;
+}
+
 namespace detail {
 
 template <typename T, typename A>
@@ -15,10 +15,15 @@
  */
 
 #include "velox/dwio/common/DirectBufferedInput.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/DirectInputStream.h"
 
+#include <folly/ScopeGuard.h>
+
 DECLARE_int32(cache_prefetch_min_pct);
 
 using ::facebook::velox::common::Region;
@@ -89,6 +94,52 @@ int32_t adjustedReadPct(const cache::TrackingData& trackingData) {
   }
   return (100 * trackingData.numReads) / (trackingData.numReferences - 1);
 }
+
+// Starts planned loads on an executor with a bounded number in flight. The
+// next load is started when one ends.
+class PrefetchQueue : public std::enable_shared_from_this<PrefetchQueue> {
+ public:
+  PrefetchQueue(
+      std::vector<std::shared_ptr<CoalescedLoad>> loads,
+      folly::Executor* executor)
+      : loads_(std::move(loads)), executor_(executor) {}
+
+  void startNext() {
+    std::shared_ptr<CoalescedLoad> load;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      // Loads that were started by their readers meanwhile are skipped.
+      while (next_ < loads_.size() && load == nullptr) {
+        load = std::move(loads_[next_++]);
+        if (load->state() != CoalescedLoad::State::kPlanned) {
+          load = nullptr;
+        }
+      }
+    }
+    if (load == nullptr) {
+      return;
+    }
+    auto self = shared_from_this();
+    if (load->hasLoadDataAsync()) {
+      // Issues the read and returns without taking an executor thread.
+      CoalescedLoad::loadAsync(std::move(load), [self]() { self->startNext(); });
+    } else {
+      executor_->add([self, pendingLoad = std::move(load)]() {
+        SCOPE_EXIT {
+          self->startNext();
+        };
+        process::TraceContext trace("Read Ahead");
+        pendingLoad->loadOrFuture(nullptr);
+      });
+    }
+  }
+
+ private:
+  std::vector<std::shared_ptr<CoalescedLoad>> loads_;
+  folly::Executor* const executor_;
+  std::mutex mutex_;
+  size_t next_{0};
+};
 } // namespace
 
 void DirectBufferedInput::load(const LogType /*unused*/) {
@@ -128,7 +179,12 @@ void DirectBufferedInput::makeLoads(
     // eligible to prefetch. This will be loaded by itself on first use.
     return;
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  // With adaptive coalescing, the distance and the prefetches in flight
+  // follow the latency and bandwidth measured for the file system.
+  const bool adaptive = options_.adaptiveCoalesce() && ioModel_->hasEstimate();
+  const int32_t maxDistance = adaptive
+      ? ioModel_->coalesceDistance(options_.maxCoalesceDistance())
+      : options_.maxCoalesceDistance();
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
@@ -143,6 +199,7 @@ void DirectBufferedInput::makeLoads(
       });
   // Combine adjacent short reads.
 
+  const auto firstNewLoad = coalescedLoads_.size();
   int32_t numNewLoads = 0;
   int64_t coalescedBytes = 0;
   coalesceIo<LoadRequest*, LoadRequest*>(
@@ -179,16 +236,31 @@ void DirectBufferedInput::makeLoads(
         ++numNewLoads;
         readRegion(ranges, shouldPrefetch);
       });
-  if (shouldPrefetch && executor_) {
-    for (auto i = 0; i < coalescedLoads_.size(); ++i) {
-      auto& load = coalescedLoads_[i];
-      if (load->state() == CoalescedLoad::State::kPlanned) {
-        executor_->add([pendingLoad = load]() {
-          process::TraceContext trace("Read Ahead");
-          pendingLoad->loadOrFuture(nullptr);
-        });
-      }
+  if (!shouldPrefetch || !executor_ ||
+      firstNewLoad == coalescedLoads_.size()) {
+    return;
+  }
+  std::vector<std::shared_ptr<CoalescedLoad>> loads(
+      coalescedLoads_.begin() + firstNewLoad, coalescedLoads_.end());
+  int32_t depth = loads.size();
+  if (adaptive) {
+    int64_t loadBytes = 0;
+    for (const auto& load : loads) {
+      loadBytes += load->size();
     }
+    depth = ioModel_->prefetchDepth(loadBytes / loads.size(), depth);
+    ioStats_->adaptiveCoalesceDistance().increment(maxDistance);
+    ioStats_->adaptivePrefetchDepth().increment(depth);
+  }
+  prefetch(std::move(loads), depth);
+}
+
+void DirectBufferedInput::prefetch(
+    std::vector<std::shared_ptr<CoalescedLoad>> loads,
+    int32_t depth) {
+  auto queue = std::make_shared<PrefetchQueue>(std::move(loads), executor_);
+  for (auto i = 0; i < depth; ++i) {
+    queue->startNext();
   }
 }
 
@@ -199,7 +271,13 @@ void DirectBufferedInput::readRegion(
     return;
   }
   auto load = std::make_shared<DirectCoalescedLoad>(
-      input_, ioStats_, groupId_, requests, pool_, options_.loadQuantum());
+      input_,
+      ioStats_,
+      groupId_,
+      requests,
+      pool_,
+      options_.loadQuantum(),
+      ioModel_);
   coalescedLoads_.push_back(load);
   streamToCoalescedLoad_.withWLock([&](auto& loads) {
     for (auto& request : requests) {
@@ -238,11 +316,13 @@ void appendRanges(
 }
 } // namespace
 
-std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool isPrefetch) {
+std::vector<folly::Range<char*>> DirectCoalescedLoad::makeBuffers(
+    int64_t& size,
+    int64_t& overread) {
   std::vector<folly::Range<char*>> buffers;
   int64_t lastEnd = requests_[0].region.offset;
-  int64_t size = 0;
-  int64_t overread = 0;
+  size = 0;
+  overread = 0;
   for (auto& request : requests_) {
     auto& region = request.region;
     if (region.offset > lastEnd) {
@@ -272,20 +352,62 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool isPrefetch) {
     lastEnd = region.offset + request.loadSize;
     size += std::min<int32_t>(loadQuantum_, region.length);
   }
-  input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+  return buffers;
+}
+
+void DirectCoalescedLoad::updateStats(
+    int64_t size,
+    int64_t overread,
+    bool isPrefetch,
+    uint64_t micros) {
+  if (ioModel_) {
+    ioModel_->recordRead(size + overread, micros);
+  }
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricStorageReadLatencyMs, micros / 1'000);
   ioStats_->read().increment(size);
   ioStats_->incRawOverreadBytes(overread);
   if (isPrefetch) {
     ioStats_->prefetch().increment(size);
   }
+}
+
+std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool isPrefetch) {
+  int64_t size;
+  int64_t overread;
+  const auto buffers = makeBuffers(size, overread);
+  uint64_t micros = 0;
+  {
+    MicrosecondTimer timer(&micros);
+    input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+  }
+  updateStats(size, overread, isPrefetch, micros);
   return {};
 }
 
+folly::SemiFuture<std::vector<cache::CachePin>>
+DirectCoalescedLoad::loadDataAsync(bool isPrefetch) {
+  int64_t size;
+  int64_t overread;
+  const auto buffers = makeBuffers(size, overread);
+  const auto startMicros = getCurrentTimeMicro();
+  return input_->readAsync(buffers, requests_[0].region.offset, LogType::FILE)
+      .deferValue([this, size, overread, isPrefetch, startMicros](
+                      uint64_t /*bytes*/) {
+        updateStats(
+            size, overread, isPrefetch, getCurrentTimeMicro() - startMicros);
+        return std::vector<cache::CachePin>{};
+      });
+}
+
 int32_t DirectCoalescedLoad::getData(
     int64_t offset,
 
     memory::Allocation& data,
     std::string& tinyData) {
+  // A cancelled load, e.g. a failed prefetch, has no data.
+  if (state() == State::kCancelled) {
+    return 0;
+  }
   for (auto& request : requests_) {
     if (request.region.offset == offset) {
       data = std::move(request.data);
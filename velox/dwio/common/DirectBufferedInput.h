@@ -22,6 +22,7 @@
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/io/IoStatistics.h"
+#include "velox/common/io/IoTuner.h"
 #include "velox/common/io/Options.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -56,12 +57,14 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
       uint64_t groupId,
       const std::vector<LoadRequest*>& requests,
       memory::MemoryPool& pool,
-      int32_t loadQuantum)
+      int32_t loadQuantum,
+      std::shared_ptr<io::IoTuner::Model> ioModel = nullptr)
       : CoalescedLoad({}, {}),
         ioStats_(ioStats),
         groupId_(groupId),
         input_(std::move(input)),
         loadQuantum_(loadQuantum),
+        ioModel_(std::move(ioModel)),
         pool_(pool) {
     requests_.reserve(requests.size());
     for (auto i = 0; i < requests.size(); ++i) {
@@ -73,6 +76,14 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   // data is retrieved with getData().
   std::vector<cache::CachePin> loadData(bool isPrefetch) override;
 
+  // Like loadData() but reads with ReadFileInputStream::readAsync().
+  folly::SemiFuture<std::vector<cache::CachePin>> loadDataAsync(
+      bool isPrefetch) override;
+
+  bool hasLoadDataAsync() const override {
+    return input_->hasReadAsync();
+  }
+
   // Returns the buffer for 'region' in either 'data' or 'tinyData'. 'region'
   // must match a region given to SelectiveBufferedInput::enqueue().
   int32_t
@@ -91,10 +102,27 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   }
 
  private:
+  // Allocates the buffers for 'requests_' and returns the ranges to read from
+  // the offset of the first request. Sets 'size' to the bytes to read and
+  // 'overread' to the bytes of the gaps.
+  std::vector<folly::Range<char*>> makeBuffers(
+      int64_t& size,
+      int64_t& overread);
+
+  // Updates 'ioStats_' and records the time of the read in 'ioModel_'.
+  void updateStats(
+      int64_t size,
+      int64_t overread,
+      bool isPrefetch,
+      uint64_t micros);
+
   const std::shared_ptr<IoStatistics> ioStats_;
   const uint64_t groupId_;
   const std::shared_ptr<ReadFileInputStream> input_;
   const int32_t loadQuantum_;
+  // Latency and bandwidth model of the file system. nullptr if reads are not
+  // timed.
+  const std::shared_ptr<io::IoTuner::Model> ioModel_;
   memory::MemoryPool& pool_;
   std::vector<LoadRequest> requests_;
 };
@@ -122,6 +150,7 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
+        ioModel_(io::IoTuner::instance().model(input_->getName())),
         options_(readerOptions) {}
 
   ~DirectBufferedInput() override {
@@ -172,6 +201,11 @@ class DirectBufferedInput : public BufferedInput {
     return executor_;
   }
 
+  /// Returns the latency and bandwidth model of the file system of the file.
+  io::IoTuner::Model* ioModel() const {
+    return ioModel_.get();
+  }
+
  private:
   /// Constructor used by clone().
   DirectBufferedInput(
@@ -189,6 +223,7 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
+        ioModel_(io::IoTuner::instance().model(input_->getName())),
         options_(readerOptions) {}
 
   // Sorts requests and makes CoalescedLoads for nearby requests. If
@@ -201,12 +236,19 @@ class DirectBufferedInput : public BufferedInput {
   // covers.
   void readRegion(std::vector<LoadRequest*> requests, bool prefetch);
 
+  // Starts the prefetch of the planned loads in 'loads' on 'executor_', with
+  // at most 'depth' in flight at a time.
+  void prefetch(
+      std::vector<std::shared_ptr<cache::CoalescedLoad>> loads,
+      int32_t depth);
+
   const uint64_t fileNum_;
   const std::shared_ptr<cache::ScanTracker> tracker_;
   const uint64_t groupId_;
   const std::shared_ptr<IoStatistics> ioStats_;
   folly::Executor* const executor_;
   const uint64_t fileSize_;
+  const std::shared_ptr<io::IoTuner::Model> ioModel_;
 
   // Regions that are candidates for loading.
   std::vector<LoadRequest> requests_;
@@ -74,6 +74,7 @@ void ReadFileInputStream::read(
   auto readStartMicros = getCurrentTimeMicro();
   std::string_view data_read = readFile_->pread(offset, length, buf);
   if (stats_) {
+    recordLocality(offset, length);
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
   }
@@ -101,6 +102,7 @@ void ReadFileInputStream::read(
   }
   logRead(offset, bufferSize, logType);
   auto size = readFile_->preadv(offset, buffers);
+  recordLocality(offset, bufferSize);
   DWIO_ENSURE_EQ(
       size,
       bufferSize,
@@ -123,6 +125,7 @@ folly::SemiFuture<uint64_t> ReadFileInputStream::readAsync(
     bufferSize += buffer.size();
   }
   logRead(offset, bufferSize, logType);
+  recordLocality(offset, bufferSize);
   return readFile_->preadvAsync(offset, buffers);
 }
 
@@ -144,11 +147,24 @@ void ReadFileInputStream::vread(
   auto readStartMicros = getCurrentTimeMicro();
   readFile_->preadv(regions, iobufs);
   if (stats_) {
+    for (const auto& region : regions) {
+      recordLocality(region.offset, region.length);
+    }
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
   }
 }
 
+void ReadFileInputStream::recordLocality(uint64_t offset, uint64_t length) {
+  if (!stats_ || length == 0) {
+    return;
+  }
+  if (auto local = readFile_->localBytes(offset, length)) {
+    stats_->incLocalBytesRead(*local);
+    stats_->incRemoteBytesRead(length - *local);
+  }
+}
+
 const std::string& InputStream::getName() const {
   return path_;
 }
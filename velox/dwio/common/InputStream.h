@@ -180,6 +180,10 @@ class ReadFileInputStream final : public InputStream {
   }
 
  private:
+  // Adds the local and remote bytes of reading [offset, offset + length) to
+  // 'stats_' if 'readFile_' knows where its data is.
+  void recordLocality(uint64_t offset, uint64_t length);
+
   std::shared_ptr<velox::ReadFile> readFile_;
 };
 
@@ -19,6 +19,7 @@
 #include <folly/Likely.h>
 #include <folly/Range.h>
 #include <folly/Varint.h>
+#include <folly/lang/Bits.h>
 #include "velox/common/base/Nulls.h"
 #include "velox/common/encode/Coding.h"
 #include "velox/dwio/common/IntCodecCommon.h"
@@ -426,6 +427,21 @@ inline int128_t IntDecoder<isSigned>::readVsHugeInt() {
 template <bool isSigned>
 inline uint128_t IntDecoder<isSigned>::readVuHugeInt() {
   VELOX_DCHECK_EQ(pendingSkip, 0);
+  if (LIKELY(bufferEnd - bufferStart >= 8)) {
+    // Most values fit in 8 bytes. The continuation bits of a word tell the
+    // length and the payload bits are gathered at once.
+    constexpr uint64_t kContinuationBits = 0x8080808080808080ULL;
+    const auto word = folly::loadUnaligned<uint64_t>(bufferStart);
+    const auto stops = ~word & kContinuationBits;
+    if (LIKELY(stops != 0)) {
+      const auto numBytes = (__builtin_ctzll(stops) >> 3) + 1;
+      const auto mask = numBytes == sizeof(uint64_t)
+          ? ~kContinuationBits
+          : ~kContinuationBits & ((1ULL << (8 * numBytes)) - 1);
+      bufferStart += numBytes;
+      return bits::extractBits<uint64_t>(word, mask);
+    }
+  }
   uint128_t value = 0;
   uint128_t work;
   uint32_t offset = 0;
@@ -21,6 +21,7 @@
 
 #include <folly/Executor.h>
 #include "velox/common/base/SpillConfig.h"
+#include "velox/common/caching/FileMetadataCache.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/common/io/Options.h"
 #include "velox/common/memory/Memory.h"
@@ -127,6 +128,11 @@ class RowReaderOptions {
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
   size_t decodingParallelismFactor_{0};
+  // Number of pages after the current one that a column reader decompresses
+  // ahead on 'decodingExecutor_' and the cap on the bytes of these pages per
+  // column. 0 pages means no read ahead.
+  int32_t pageReadAhead_{0};
+  uint64_t maxPageReadAheadBytes_{16 << 20};
   bool appendRowNumberColumn_ = false;
   // Function to populate metrics related to feature projection stats
   // in Koski. This gets fired in FlatMapColumnReader.
@@ -323,6 +329,16 @@ class RowReaderOptions {
     decodingParallelismFactor_ = factor;
   }
 
+  // Decompresses up to 'numPages' pages after the current one of each column
+  // on the decoding executor while the current page is decoded. The pages
+  // read ahead for a column take at most about 'maxBytes' of memory,
+  // compressed and decompressed. Used by the Parquet reader.
+  void setPageReadAhead(int32_t numPages, uint64_t maxBytes) {
+    VELOX_CHECK_GE(numPages, 0);
+    pageReadAhead_ = numPages;
+    maxPageReadAheadBytes_ = maxBytes;
+  }
+
   /*
    * Set to true, if you want to add a new column to the results containing the
    * row numbers.  These row numbers are relative to the beginning of file (0 as
@@ -391,6 +407,14 @@ class RowReaderOptions {
   size_t getDecodingParallelismFactor() const {
     return decodingParallelismFactor_;
   }
+
+  int32_t getPageReadAhead() const {
+    return pageReadAhead_;
+  }
+
+  uint64_t getMaxPageReadAheadBytes() const {
+    return maxPageReadAheadBytes_;
+  }
 };
 
 /**
@@ -408,6 +432,8 @@ class ReaderOptions : public io::ReaderOptions {
   bool fileColumnNamesReadAsLowerCase{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
+  cache::FileMetadataCache* fileMetadataCache_{nullptr};
+  std::string fileMetadataKey_;
 
  public:
   static constexpr uint64_t kDefaultFooterEstimatedSize = 1024 * 1024; // 1MB
@@ -435,6 +461,8 @@ class ReaderOptions : public io::ReaderOptions {
     filePreloadThreshold = other.filePreloadThreshold;
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    fileMetadataCache_ = other.fileMetadataCache_;
+    fileMetadataKey_ = other.fileMetadataKey_;
     return *this;
   }
 
@@ -448,8 +476,9 @@ class ReaderOptions : public io::ReaderOptions {
         footerEstimatedSize(other.footerEstimatedSize),
         filePreloadThreshold(other.filePreloadThreshold),
         fileColumnNamesReadAsLowerCase(other.fileColumnNamesReadAsLowerCase),
-        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_) {
-  }
+        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_),
+        fileMetadataCache_(other.fileMetadataCache_),
+        fileMetadataKey_(other.fileMetadataKey_) {}
 
   /**
    * Set the format of the file, such as "rc" or "dwrf".  The
@@ -518,6 +547,17 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the cache of parsed footers and the key of the file to read in it.
+  /// The reader looks up its footer under 'key' before reading it from the
+  /// file. 'key' must change when the file is rewritten.
+  ReaderOptions& setFileMetadataCache(
+      cache::FileMetadataCache* cache,
+      std::string key) {
+    fileMetadataCache_ = cache;
+    fileMetadataKey_ = std::move(key);
+    return *this;
+  }
+
   /**
    * Get the desired tail location.
    * @return if not set, return the maximum long.
@@ -565,6 +605,16 @@ class ReaderOptions : public io::ReaderOptions {
     return ioExecutor_;
   }
 
+  /// Returns the cache of parsed footers or nullptr if footers are not
+  /// cached.
+  cache::FileMetadataCache* getFileMetadataCache() const {
+    return fileMetadataKey_.empty() ? nullptr : fileMetadataCache_;
+  }
+
+  const std::string& getFileMetadataKey() const {
+    return fileMetadataKey_;
+  }
+
   bool isFileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase;
   }
@@ -583,6 +633,14 @@ struct WriterOptions {
   std::optional<uint64_t> maxStripeSize{std::nullopt};
   std::optional<uint64_t> maxDictionaryMemory{std::nullopt};
   std::map<std::string, std::string> serdeParameters;
+  // Optional executor to encode the columns in parallel and the number of
+  // threads, including the calling thread, that work on a batch.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
+  // Optional executor to write flushed stripes while the next stripe is
+  // encoded and the number of stripes that may be written at a time.
+  std::shared_ptr<folly::Executor> flushExecutor;
+  uint32_t maxPendingStripeFlushes{1};
 };
 
 } // namespace facebook::velox::dwio::common
@@ -415,7 +415,14 @@ std::shared_ptr<ScanSpec> ScanSpec::removeChild(const ScanSpec* child) {
 }
 
 void ScanSpec::addFilter(const Filter& filter) {
-  filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
+  if (!filter_) {
+    filter_ = filter.clone();
+  } else if (filter.kind() == FilterKind::kBloomFilterValues) {
+    // Only the Bloom filter knows how to merge with the other filter kinds.
+    filter_ = filter.mergeWith(filter_.get());
+  } else {
+    filter_ = filter_->mergeWith(&filter);
+  }
 }
 
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
@@ -256,6 +256,17 @@ class ScanSpec {
     makeFlat_ = makeFlat;
   }
 
+  // If non-zero, a flat scalar result whose equal consecutive values form
+  // runs of at least this average length is returned as a dictionary over
+  // one value per run, so that expressions work per run instead of per row.
+  int32_t minDictionaryRunLength() const {
+    return minDictionaryRunLength_;
+  }
+
+  void setMinDictionaryRunLength(int32_t minRunLength) {
+    minDictionaryRunLength_ = minRunLength;
+  }
+
   // True if this or a descendant has a filter that will affect the number of
   // output rows.  Note that filter on map keys and array indices is not
   // counted, as they do not change the number of container output rows.
@@ -354,6 +365,7 @@ class ScanSpec {
   // True if a string dictionary or flat map in this field should be
   // returned as flat.
   bool makeFlat_ = false;
+  int32_t minDictionaryRunLength_ = 0;
   std::shared_ptr<common::Filter> filter_;
 
   // Filters that will be only used for row group filtering based on metadata.
@@ -45,6 +45,72 @@ class Timer {
   const uint64_t startClocks_;
 };
 
+namespace detail {
+
+// Returns a dictionary over one value per run of bitwise equal consecutive
+// values of 'flat' if the runs are on average at least 'minRunLength' long.
+// Returns nullptr otherwise.
+template <typename T>
+VectorPtr encodeRuns(
+    const FlatVector<T>& flat,
+    int32_t minRunLength,
+    memory::MemoryPool* pool) {
+  const auto size = flat.size();
+  const vector_size_t maxRuns = size / minRunLength;
+  if (maxRuns == 0) {
+    return nullptr;
+  }
+  const auto* rawValues = flat.rawValues();
+  const auto* rawNulls = flat.rawNulls();
+  auto isNull = [&](vector_size_t row) {
+    return rawNulls && bits::isBitNull(rawNulls, row);
+  };
+  auto startsRun = [&](vector_size_t row) {
+    if (row == 0) {
+      return true;
+    }
+    const bool null = isNull(row);
+    if (null != isNull(row - 1)) {
+      return true;
+    }
+    return !null &&
+        std::memcmp(&rawValues[row], &rawValues[row - 1], sizeof(T)) != 0;
+  };
+
+  vector_size_t numRuns = 1;
+  for (vector_size_t row = 1; row < size; ++row) {
+    if (startsRun(row) && ++numRuns > maxRuns) {
+      return nullptr;
+    }
+  }
+
+  auto runValues =
+      BaseVector::create<FlatVector<T>>(flat.type(), numRuns, pool);
+  if constexpr (std::is_same_v<T, StringView>) {
+    runValues->setStringBuffers(flat.stringBuffers());
+  }
+  auto indices = allocateIndices(size, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t run = -1;
+  for (vector_size_t row = 0; row < size; ++row) {
+    if (startsRun(row)) {
+      ++run;
+      if (isNull(row)) {
+        runValues->setNull(run, true);
+      } else if constexpr (std::is_same_v<T, StringView>) {
+        runValues->setNoCopy(run, rawValues[row]);
+      } else {
+        runValues->set(run, rawValues[row]);
+      }
+    }
+    rawIndices[row] = run;
+  }
+  return BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), size, std::move(runValues));
+}
+
+} // namespace detail
+
 template <typename T>
 void SelectiveColumnReader::ensureValuesCapacity(vector_size_t numRows) {
   if (values_ && values_->unique() &&
@@ -134,13 +200,21 @@ void SelectiveColumnReader::getFlatValues(
     upcastScalarValues<T, TVector>(rows);
   }
   valueSize_ = sizeof(TVector);
-  *result = std::make_shared<FlatVector<TVector>>(
+  auto flat = std::make_shared<FlatVector<TVector>>(
       &memoryPool_,
       type,
       resultNulls(),
       numValues_,
       values_,
       std::move(stringBuffers_));
+  if (scanSpec_->minDictionaryRunLength() > 0 && !scanSpec_->makeFlat()) {
+    if (auto runs = detail::encodeRuns(
+            *flat, scanSpec_->minDictionaryRunLength(), &memoryPool_)) {
+      *result = std::move(runs);
+      return;
+    }
+  }
+  *result = std::move(flat);
 }
 
 template <>
@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -97,6 +98,7 @@ void SelectiveStructColumnReaderBase::read(
     RowSet rows,
     const uint64_t* incomingNulls) {
   numReads_ = scanSpec_->newRead();
+  childrenReadInParallel_ = false;
   prepareRead<char>(offset, rows, incomingNulls);
   RowSet activeRows = rows;
   if (hasMutation_) {
@@ -136,6 +138,9 @@ void SelectiveStructColumnReaderBase::read(
 
   auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
+  const bool readInParallel =
+      decodingExecutor_ != nullptr && decodingParallelism_ > 1;
+  std::vector<SelectiveColumnReader*> parallelReaders;
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
     VELOX_TRACE_HISTORY_PUSH("read %s", childSpec->fieldName().c_str());
@@ -144,6 +149,11 @@ void SelectiveStructColumnReaderBase::read(
     }
     auto fieldIndex = childSpec->subscript();
     auto reader = children_.at(fieldIndex);
+    if (readInParallel && !childSpec->hasFilter()) {
+      // Read after the filters on the rows that pass.
+      parallelReaders.push_back(reader);
+      continue;
+    }
     if (reader->isTopLevel() && childSpec->projectOut() &&
         !childSpec->hasFilter() && !childSpec->extractValues()) {
       // Will make a LazyVector.
@@ -171,6 +181,21 @@ void SelectiveStructColumnReaderBase::read(
     }
   }
 
+  if (!parallelReaders.empty() && !activeRows.empty()) {
+    for (auto* reader : parallelReaders) {
+      advanceFieldReader(reader, offset);
+    }
+    ParallelFor(
+        decodingExecutor_,
+        0,
+        parallelReaders.size(),
+        std::min(decodingParallelism_, parallelReaders.size()))
+        .execute([&](size_t i) {
+          parallelReaders[i]->read(offset, activeRows, structNulls);
+        });
+    childrenReadInParallel_ = true;
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -208,6 +233,9 @@ bool SelectiveStructColumnReaderBase::isChildConstant(
   // Returns true if the child has a constant set in the ScanSpec, or if the
   // file doesn't have this child (in which case it will be treated as null).
   return childSpec.isConstant() ||
+      // A key of a flat map read as a struct that is not in the stripe.
+      (fileType_->type()->kind() == TypeKind::MAP &&
+       childSpec.subscript() == kConstantChildSpecSubscript) ||
       // The below check is trying to determine if this is a missing field in a
       // struct that should be constant null.
       (!isRoot_ && // If we're in the root struct channel is meaningless in this
@@ -361,7 +389,7 @@ void SelectiveStructColumnReaderBase::getValues(
       continue;
     }
     if (childSpec->extractValues() || childSpec->hasFilter() ||
-        !children_[index]->isTopLevel()) {
+        !children_[index]->isTopLevel() || childrenReadInParallel_) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
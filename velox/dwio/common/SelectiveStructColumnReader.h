@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 
 namespace facebook::velox::dwio::common {
@@ -95,6 +97,14 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     return debugString_;
   }
 
+  /// Reads the children without filters in parallel on 'executor' once the
+  /// filters are evaluated, instead of one after the other or as LazyVectors.
+  /// 'parallelism' is the number of threads, including the calling thread.
+  void setDecodingExecutor(folly::Executor* executor, size_t parallelism) {
+    decodingExecutor_ = executor;
+    decodingParallelism_ = parallelism;
+  }
+
  protected:
   // The subscript of childSpecs will be set to this value if the column is
   // constant (either explicitly or because it's missing).
@@ -155,6 +165,15 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // Whether or not this is the root Struct that represents entire rows of the
   // table.
   const bool isRoot_;
+
+  // Executor for reading the children in parallel. nullptr if the children
+  // are read on the calling thread.
+  folly::Executor* decodingExecutor_{nullptr};
+  size_t decodingParallelism_{0};
+
+  // True if the last read() read the children without filters in parallel.
+  // These are then not returned as LazyVectors.
+  bool childrenReadInParallel_{false};
 };
 
 struct SelectiveStructColumnReader : SelectiveStructColumnReaderBase {
@@ -23,13 +23,21 @@ SortingWriter::SortingWriter(
     std::unique_ptr<exec::SortBuffer> sortBuffer,
     uint32_t maxOutputRowsConfig,
     uint64_t maxOutputBytesConfig,
-    velox::common::SpillStats* spillStats)
+    velox::common::SpillStats* spillStats,
+    std::unique_ptr<ClusteringKeyEncoder> clusteringKeys,
+    ClusteringStats* clusteringStats)
     : outputWriter_(std::move(writer)),
       maxOutputRowsConfig_(maxOutputRowsConfig),
       maxOutputBytesConfig_(maxOutputBytesConfig),
       sortPool_(sortBuffer->pool()),
       canReclaim_(sortBuffer->canSpill()),
       spillStats_(spillStats),
+      clusteringKeys_(std::move(clusteringKeys)),
+      clusteringStats_(clusteringStats),
+      clusteringSortType_(
+          clusteringKeys_ == nullptr
+              ? nullptr
+              : clusteringSortType(clusteringKeys_->type())),
       sortBuffer_(std::move(sortBuffer)) {
   VELOX_CHECK_GT(maxOutputRowsConfig_, 0);
   VELOX_CHECK_GT(maxOutputBytesConfig_, 0);
@@ -44,9 +52,34 @@ SortingWriter::~SortingWriter() {
   sortPool_->release();
 }
 
+// static
+RowTypePtr SortingWriter::clusteringSortType(const RowTypePtr& type) {
+  auto names = type->names();
+  auto types = type->children();
+  names.push_back("$clustering_key");
+  types.push_back(BIGINT());
+  return ROW(std::move(names), std::move(types));
+}
+
 void SortingWriter::write(const VectorPtr& data) {
   checkRunning();
-  sortBuffer_->addInput(data);
+  if (clusteringKeys_ == nullptr) {
+    sortBuffer_->addInput(data);
+    return;
+  }
+  const auto input = std::dynamic_pointer_cast<RowVector>(data);
+  VELOX_CHECK_NOT_NULL(input);
+  auto keys = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), input->size(), sortPool_);
+  clusteringKeys_->encode(*input, *keys);
+  auto children = input->children();
+  children.push_back(std::move(keys));
+  sortBuffer_->addInput(std::make_shared<RowVector>(
+      sortPool_,
+      clusteringSortType_,
+      nullptr,
+      input->size(),
+      std::move(children)));
 }
 
 void SortingWriter::flush() {
@@ -61,9 +94,15 @@ void SortingWriter::close() {
   const auto maxOutputBatchRows = outputBatchRows();
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputBatchRows);
   while (output != nullptr) {
+    if (clusteringKeys_ != nullptr) {
+      output = finishClusteredBatch(output);
+    }
     outputWriter_->write(output);
     output = sortBuffer_->getOutput(maxOutputBatchRows);
   }
+  if (clusteringKeys_ != nullptr) {
+    recordClusteringStats();
+  }
   auto spillStatsOr = sortBuffer_->spilledStats();
   if (spillStatsOr.has_value()) {
     VELOX_CHECK(canReclaim_);
@@ -125,6 +164,61 @@ uint32_t SortingWriter::outputBatchRows() {
   return std::min(estimatedMaxOutputRows, maxOutputRowsConfig_);
 }
 
+RowVectorPtr SortingWriter::finishClusteredBatch(const RowVectorPtr& output) {
+  auto children = output->children();
+  children.pop_back();
+  auto batch = std::make_shared<RowVector>(
+      output->pool(),
+      clusteringKeys_->type(),
+      nullptr,
+      output->size(),
+      std::move(children));
+
+  auto& ranges = batchCodeRanges_.emplace_back();
+  for (auto i = 0; i < clusteringKeys_->numColumns(); ++i) {
+    clusteringKeys_->encodeColumn(*batch, i, codes_);
+    auto min = std::numeric_limits<uint32_t>::max();
+    uint32_t max = 0;
+    for (auto code : codes_) {
+      // Nulls have code 0.
+      if (code != 0) {
+        min = std::min(min, code);
+        max = std::max(max, code);
+      }
+    }
+    ranges.emplace_back(min, max);
+  }
+  return batch;
+}
+
+void SortingWriter::recordClusteringStats() {
+  if (clusteringStats_ == nullptr || batchCodeRanges_.empty()) {
+    return;
+  }
+  const auto numColumns = clusteringKeys_->numColumns();
+  for (auto i = 0; i < numColumns; ++i) {
+    auto fileMin = std::numeric_limits<uint32_t>::max();
+    uint32_t fileMax = 0;
+    for (const auto& ranges : batchCodeRanges_) {
+      fileMin = std::min(fileMin, ranges[i].first);
+      fileMax = std::max(fileMax, ranges[i].second);
+    }
+    if (fileMin > fileMax) {
+      continue;
+    }
+    const double fileRange = fileMax - fileMin + 1.0;
+    for (const auto& ranges : batchCodeRanges_) {
+      const auto [min, max] = ranges[i];
+      if (min <= max) {
+        clusteringStats_->sumSelectivity +=
+            (max - min + 1.0) / fileRange / numColumns;
+      }
+    }
+  }
+  clusteringStats_->numBatches += batchCodeRanges_.size();
+  batchCodeRanges_.clear();
+}
+
 std::unique_ptr<memory::MemoryReclaimer> SortingWriter::MemoryReclaimer::create(
     SortingWriter* writer) {
   return std::unique_ptr<memory::MemoryReclaimer>(new MemoryReclaimer(writer));
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/dwio/common/ClusteringKeyEncoder.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/SortBuffer.h"
@@ -23,6 +24,11 @@
 namespace facebook::velox::dwio::common {
 
 /// Sorting Writer object is used to write sorted data into a single file.
+///
+/// If 'clusteringKeys' is set, the rows are clustered instead: 'sortBuffer'
+/// has the type from clusteringSortType() and sorts on its last column,
+/// which is filled with the keys from 'clusteringKeys'. The keys are not
+/// written. 'clusteringStats' is then set on close from the written batches.
 class SortingWriter : public Writer {
  public:
   SortingWriter(
@@ -30,7 +36,12 @@ class SortingWriter : public Writer {
       std::unique_ptr<exec::SortBuffer> sortBuffer,
       uint32_t maxOutputRowsConfig,
       uint64_t maxOutputBytesConfig,
-      velox::common::SpillStats* spillStats);
+      velox::common::SpillStats* spillStats,
+      std::unique_ptr<ClusteringKeyEncoder> clusteringKeys = nullptr,
+      ClusteringStats* clusteringStats = nullptr);
+
+  /// Returns 'type' with a BIGINT column for the clustering keys appended.
+  static RowTypePtr clusteringSortType(const RowTypePtr& type);
 
   ~SortingWriter() override;
 
@@ -76,14 +87,28 @@ class SortingWriter : public Writer {
 
   uint32_t outputBatchRows();
 
+  // Removes the clustering keys from 'output' and records the code range of
+  // the clustering columns in it.
+  RowVectorPtr finishClusteredBatch(const RowVectorPtr& output);
+
+  void recordClusteringStats();
+
   const std::unique_ptr<Writer> outputWriter_;
   const uint32_t maxOutputRowsConfig_;
   const uint64_t maxOutputBytesConfig_;
   memory::MemoryPool* const sortPool_;
   const bool canReclaim_;
   velox::common::SpillStats* const spillStats_;
+  const std::unique_ptr<ClusteringKeyEncoder> clusteringKeys_;
+  ClusteringStats* const clusteringStats_;
+  const RowTypePtr clusteringSortType_;
 
   std::unique_ptr<exec::SortBuffer> sortBuffer_;
+
+  // Min and max code of each clustering column in each written batch. The
+  // min is greater than the max if the column is all null in the batch.
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> batchCodeRanges_;
+  std::vector<uint32_t> codes_;
 };
 
 } // namespace facebook::velox::dwio::common
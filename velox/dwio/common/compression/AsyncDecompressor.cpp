@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/common/compression/AsyncDecompressor.h"
+
+#include <folly/Synchronized.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::dwio::common::compression {
+
+using facebook::velox::common::CompressionKind;
+
+namespace {
+folly::Synchronized<std::shared_ptr<AsyncDecompressor>>& backendHolder() {
+  static folly::Synchronized<std::shared_ptr<AsyncDecompressor>> backend;
+  return backend;
+}
+
+struct AtomicDecompressionStats {
+  std::atomic<uint64_t> numOffloaded{0};
+  std::atomic<uint64_t> offloadedBytes{0};
+  std::atomic<uint64_t> offloadedMicros{0};
+  std::atomic<uint64_t> numCpu{0};
+  std::atomic<uint64_t> cpuBytes{0};
+  std::atomic<uint64_t> cpuMicros{0};
+  std::atomic<uint64_t> numFallbacks{0};
+};
+
+AtomicDecompressionStats& globalStats() {
+  static AtomicDecompressionStats stats;
+  return stats;
+}
+
+class OffloadingDecompressor : public Decompressor {
+ public:
+  OffloadingDecompressor(
+      std::unique_ptr<Decompressor> cpu,
+      std::shared_ptr<AsyncDecompressor> backend,
+      CompressionKind kind,
+      const CompressionOptions& options,
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor(blockSize, streamDebugInfo),
+        cpu_(std::move(cpu)),
+        backend_(std::move(backend)),
+        kind_(kind),
+        options_(options) {}
+
+  std::pair<int64_t, bool> getDecompressedLength(
+      const char* src,
+      uint64_t srcLength) const override {
+    return cpu_->getDecompressedLength(src, srcLength);
+  }
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    auto& stats = globalStats();
+    if (backend_ != nullptr) {
+      uint64_t micros = 0;
+      std::optional<uint64_t> length;
+      {
+        MicrosecondTimer timer(&micros);
+        auto result =
+            backend_->submit(kind_, options_, src, srcLength, dest, destLength)
+                .getTry();
+        if (result.hasValue()) {
+          length = result.value();
+        } else {
+          VLOG(1) << "Decompression offload to " << backend_->name()
+                  << " failed, decompressing on CPU: "
+                  << result.exception().what() << " Info: "
+                  << streamDebugInfo_;
+        }
+      }
+      if (length.has_value()) {
+        stats.numOffloaded.fetch_add(1, std::memory_order_relaxed);
+        stats.offloadedBytes.fetch_add(
+            length.value(), std::memory_order_relaxed);
+        stats.offloadedMicros.fetch_add(micros, std::memory_order_relaxed);
+        RECORD_METRIC_VALUE(kMetricDecompressOffloadedBytes, length.value());
+        return length.value();
+      }
+      stats.numFallbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint64_t micros = 0;
+    uint64_t length;
+    {
+      MicrosecondTimer timer(&micros);
+      length = cpu_->decompress(src, srcLength, dest, destLength);
+    }
+    stats.numCpu.fetch_add(1, std::memory_order_relaxed);
+    stats.cpuBytes.fetch_add(length, std::memory_order_relaxed);
+    stats.cpuMicros.fetch_add(micros, std::memory_order_relaxed);
+    RECORD_METRIC_VALUE(kMetricDecompressCpuBytes, length);
+    return length;
+  }
+
+ private:
+  const std::unique_ptr<Decompressor> cpu_;
+  const std::shared_ptr<AsyncDecompressor> backend_;
+  const CompressionKind kind_;
+  const CompressionOptions options_;
+};
+} // namespace
+
+void registerAsyncDecompressor(std::shared_ptr<AsyncDecompressor> backend) {
+  *backendHolder().wlock() = std::move(backend);
+}
+
+std::shared_ptr<AsyncDecompressor> asyncDecompressor() {
+  return *backendHolder().rlock();
+}
+
+DecompressionStats decompressionStats() {
+  const auto& stats = globalStats();
+  DecompressionStats result;
+  result.numOffloaded = stats.numOffloaded;
+  result.offloadedBytes = stats.offloadedBytes;
+  result.offloadedMicros = stats.offloadedMicros;
+  result.numCpu = stats.numCpu;
+  result.cpuBytes = stats.cpuBytes;
+  result.cpuMicros = stats.cpuMicros;
+  result.numFallbacks = stats.numFallbacks;
+  return result;
+}
+
+std::unique_ptr<Decompressor> makeOffloadingDecompressor(
+    std::unique_ptr<Decompressor> cpu,
+    std::shared_ptr<AsyncDecompressor> backend,
+    CompressionKind kind,
+    const CompressionOptions& options,
+    uint64_t blockSize,
+    const std::string& streamDebugInfo) {
+  return std::make_unique<OffloadingDecompressor>(
+      std::move(cpu),
+      std::move(backend),
+      kind,
+      options,
+      blockSize,
+      streamDebugInfo);
+}
+
+} // namespace facebook::velox::dwio::common::compression
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <folly/futures/Future.h>
+
+#include "velox/dwio/common/compression/Compression.h"
+
+namespace facebook::velox::dwio::common::compression {
+
+/// Decompression backend that runs off the calling thread, e.g. on Intel
+/// IAA through QPL or on QAT. Decompressors made by createDecompressor()
+/// submit each block to the registered backend if it supports the codec and
+/// wait for the result. The backend sees the blocks of all concurrent
+/// readers and may batch them into hardware submissions. A block that the
+/// backend rejects or fails to decompress is decompressed on CPU.
+class AsyncDecompressor {
+ public:
+  virtual ~AsyncDecompressor() = default;
+
+  virtual std::string name() const = 0;
+
+  /// Returns true if data compressed with 'kind' and 'options' can be
+  /// submitted.
+  virtual bool supports(
+      facebook::velox::common::CompressionKind kind,
+      const CompressionOptions& options) const = 0;
+
+  /// Starts decompressing 'srcLength' bytes at 'src' into at most
+  /// 'destLength' bytes at 'dest'. The buffers stay valid until the future is
+  /// realized. The future gives the decompressed length or an error if the
+  /// job is not accepted or fails.
+  virtual folly::SemiFuture<uint64_t> submit(
+      facebook::velox::common::CompressionKind kind,
+      const CompressionOptions& options,
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) = 0;
+};
+
+/// Sets the process-wide backend. nullptr decompresses everything on CPU.
+/// Affects decompressors created after the call.
+void registerAsyncDecompressor(std::shared_ptr<AsyncDecompressor> backend);
+
+std::shared_ptr<AsyncDecompressor> asyncDecompressor();
+
+/// Process-wide counts of blocks decompressed by createDecompressor()
+/// streams, by the backend and on CPU. Zlib and gzip streams decompressed
+/// with zlib streaming are not counted.
+struct DecompressionStats {
+  uint64_t numOffloaded{0};
+  /// Decompressed bytes and wall time of 'numOffloaded'.
+  uint64_t offloadedBytes{0};
+  uint64_t offloadedMicros{0};
+
+  uint64_t numCpu{0};
+  uint64_t cpuBytes{0};
+  uint64_t cpuMicros{0};
+
+  /// Blocks that the backend did not accept or failed on. These are also
+  /// counted in 'numCpu'.
+  uint64_t numFallbacks{0};
+};
+
+DecompressionStats decompressionStats();
+
+/// Returns a Decompressor that decompresses with 'backend' if not nullptr
+/// and with 'cpu' otherwise or when 'backend' fails. Records
+/// DecompressionStats.
+std::unique_ptr<Decompressor> makeOffloadingDecompressor(
+    std::unique_ptr<Decompressor> cpu,
+    std::shared_ptr<AsyncDecompressor> backend,
+    facebook::velox::common::CompressionKind kind,
+    const CompressionOptions& options,
+    uint64_t blockSize,
+    const std::string& streamDebugInfo);
+
+} // namespace facebook::velox::dwio::common::compression
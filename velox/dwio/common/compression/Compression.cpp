@@ -17,6 +17,7 @@
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/common/compression/LzoDecompressor.h"
 #include "velox/dwio/common/IntCodecCommon.h"
+#include "velox/dwio/common/compression/AsyncDecompressor.h"
 #include "velox/dwio/common/compression/PagedInputStream.h"
 
 #include <folly/logging/xlog.h>
@@ -37,13 +38,25 @@ namespace {
 
 class ZstdCompressor : public Compressor {
  public:
-  explicit ZstdCompressor(int32_t level) : Compressor{level} {}
+  ZstdCompressor(
+      int32_t level,
+      std::shared_ptr<ZstdDictionaryTrainer> dictionaryTrainer)
+      : Compressor{level}, dictionaryTrainer_{std::move(dictionaryTrainer)} {}
 
   uint64_t compress(const void* src, void* dest, uint64_t length) override;
+
+ private:
+  const std::shared_ptr<ZstdDictionaryTrainer> dictionaryTrainer_;
 };
 
 uint64_t
 ZstdCompressor::compress(const void* src, void* dest, uint64_t length) {
+  if (dictionaryTrainer_ != nullptr) {
+    if (auto dictionary = dictionaryTrainer_->dictionary()) {
+      return dictionary->compress(level_, src, dest, length);
+    }
+    dictionaryTrainer_->addSample(src, length);
+  }
   auto ret = ZSTD_compress(dest, length, src, length, level_);
   if (ZSTD_isError(ret)) {
     // it's fine to hit dest size too small
@@ -396,10 +409,12 @@ uint64_t Lz4Decompressor::decompressInternal(
 // decompressors at same time and causing OOM.
 class ZstdDecompressor : public Decompressor {
  public:
-  explicit ZstdDecompressor(
+  ZstdDecompressor(
       uint64_t blockSize,
-      const std::string& streamDebugInfo)
-      : Decompressor{blockSize, streamDebugInfo} {}
+      const std::string& streamDebugInfo,
+      std::shared_ptr<const ZstdDictionaries> dictionaries)
+      : Decompressor{blockSize, streamDebugInfo},
+        dictionaries_{std::move(dictionaries)} {}
 
   uint64_t decompress(
       const char* src,
@@ -410,6 +425,9 @@ class ZstdDecompressor : public Decompressor {
   std::pair<int64_t, bool> getDecompressedLength(
       const char* src,
       uint64_t srcLength) const override;
+
+ private:
+  const std::shared_ptr<const ZstdDictionaries> dictionaries_;
 };
 
 uint64_t ZstdDecompressor::decompress(
@@ -417,6 +435,23 @@ uint64_t ZstdDecompressor::decompress(
     uint64_t srcLength,
     char* dest,
     uint64_t destLength) {
+  // The frames that were compressed with a dictionary have its id.
+  if (const auto id = ZSTD_getDictID_fromFrame(src, srcLength); id != 0) {
+    const ZstdDictionary* dictionary = nullptr;
+    if (dictionaries_ != nullptr) {
+      auto it = dictionaries_->find(id);
+      if (it != dictionaries_->end()) {
+        dictionary = it->second.get();
+      }
+    }
+    DWIO_ENSURE_NOT_NULL(
+        dictionary,
+        "Missing ZSTD dictionary ",
+        id,
+        " Info: ",
+        streamDebugInfo_);
+    return dictionary->decompress(src, srcLength, dest, destLength);
+  }
   auto ret = ZSTD_decompress(dest, destLength, src, srcLength);
   DWIO_ENSURE(
       !ZSTD_isError(ret),
@@ -629,7 +664,7 @@ std::unique_ptr<Compressor> createCompressor(
           "Initialized zstd compressor with compression level {}",
           options.format.zstd.compressionLevel);
       return std::make_unique<ZstdCompressor>(
-          options.format.zstd.compressionLevel);
+          options.format.zstd.compressionLevel, options.zstdDictionaryTrainer);
     }
     case CompressionKind::CompressionKind_SNAPPY:
     case CompressionKind::CompressionKind_LZO:
@@ -651,6 +686,15 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const Decrypter* decrypter,
     bool useRawDecompression,
     size_t compressedLength) {
+  auto backend = asyncDecompressor();
+  // The backends decompress standalone frames, so the streams of files with
+  // ZSTD dictionaries stay on CPU.
+  if (backend != nullptr &&
+      (!backend->supports(kind, options) ||
+       (options.zstdDictionaries != nullptr &&
+        !options.zstdDictionaries->empty()))) {
+    backend = nullptr;
+  }
   std::unique_ptr<Decompressor> decompressor;
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
@@ -660,7 +704,7 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       // decompressor remain as nullptr
       break;
     case CompressionKind::CompressionKind_ZLIB:
-      if (!decrypter) {
+      if (!decrypter && backend == nullptr) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
@@ -677,7 +721,7 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
           blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
       break;
     case CompressionKind::CompressionKind_GZIP:
-      if (!decrypter) {
+      if (!decrypter && backend == nullptr) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
@@ -710,12 +754,21 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
           streamDebugInfo);
       break;
     case CompressionKind::CompressionKind_ZSTD:
-      decompressor =
-          std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
+      decompressor = std::make_unique<ZstdDecompressor>(
+          blockSize, streamDebugInfo, options.zstdDictionaries);
       break;
     default:
       DWIO_RAISE("Unknown compression codec ", kind);
   }
+  if (decompressor != nullptr) {
+    decompressor = makeOffloadingDecompressor(
+        std::move(decompressor),
+        std::move(backend),
+        kind,
+        options,
+        blockSize,
+        streamDebugInfo);
+  }
   return std::make_unique<PagedInputStream>(
       std::move(input),
       pool,
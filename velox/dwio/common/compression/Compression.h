@@ -18,6 +18,7 @@
 
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/compression/ZstdDictionary.h"
 #include "velox/dwio/common/encryption/Encryption.h"
 
 namespace facebook::velox::dwio::common::compression {
@@ -87,6 +88,14 @@ struct CompressionOptions {
   } format;
 
   uint32_t compressionThreshold;
+
+  /// Trains the dictionary for a ZSTD compressor. The compressor uses the
+  /// dictionary once it is trained. nullptr for no dictionary.
+  std::shared_ptr<ZstdDictionaryTrainer> zstdDictionaryTrainer;
+
+  /// Dictionaries for decompressing the ZSTD frames that were compressed with
+  /// a dictionary.
+  std::shared_ptr<const ZstdDictionaries> zstdDictionaries;
 };
 
 /**
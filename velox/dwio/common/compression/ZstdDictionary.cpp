@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/compression/ZstdDictionary.h"
+#include "velox/dwio/common/exception/Exception.h"
+
+#include <zdict.h>
+#include <zstd.h>
+#include <zstd_errors.h>
+
+namespace facebook::velox::dwio::common::compression {
+
+namespace {
+// A dictionary starts with a 4 byte magic number followed by the 4 byte id.
+constexpr int32_t kDictionaryIdOffset = 4;
+} // namespace
+
+ZstdDictionary::ZstdDictionary(std::string data)
+    : data_(std::move(data)),
+      id_(ZSTD_getDictID_fromDict(data_.data(), data_.size())) {
+  DWIO_ENSURE_NE(id_, 0, "Not a ZSTD dictionary");
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(cdict_);
+  ZSTD_freeDDict(ddict_);
+}
+
+uint64_t ZstdDictionary::compress(
+    int32_t level,
+    const void* src,
+    void* dest,
+    uint64_t length) const {
+  const ZSTD_CDict* cdict = nullptr;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (cdict_ == nullptr) {
+      cdict_ = ZSTD_createCDict(data_.data(), data_.size(), level);
+      DWIO_ENSURE_NOT_NULL(cdict_, "Failed to create ZSTD dictionary");
+      cdictLevel_ = level;
+    }
+    if (cdictLevel_ == level) {
+      cdict = cdict_;
+    }
+  }
+  auto* cctx = ZSTD_createCCtx();
+  DWIO_ENSURE_NOT_NULL(cctx, "Failed to create ZSTD context");
+  // The dictionary is digested for the level of the first use. Other levels
+  // load it for each block.
+  auto ret = cdict != nullptr
+      ? ZSTD_compress_usingCDict(cctx, dest, length, src, length, cdict)
+      : ZSTD_compress_usingDict(
+            cctx, dest, length, src, length, data_.data(), data_.size(), level);
+  ZSTD_freeCCtx(cctx);
+  if (ZSTD_isError(ret)) {
+    if (ZSTD_getErrorCode(ret) == ZSTD_ErrorCode::ZSTD_error_dstSize_tooSmall) {
+      return length;
+    }
+    DWIO_RAISE("ZSTD returned an error: ", ZSTD_getErrorName(ret));
+  }
+  return ret;
+}
+
+uint64_t ZstdDictionary::decompress(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) const {
+  const ZSTD_DDict* ddict;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (ddict_ == nullptr) {
+      ddict_ = ZSTD_createDDict(data_.data(), data_.size());
+      DWIO_ENSURE_NOT_NULL(ddict_, "Failed to create ZSTD dictionary");
+    }
+    ddict = ddict_;
+  }
+  auto* dctx = ZSTD_createDCtx();
+  DWIO_ENSURE_NOT_NULL(dctx, "Failed to create ZSTD context");
+  auto ret =
+      ZSTD_decompress_usingDDict(dctx, dest, destLength, src, srcLength, ddict);
+  ZSTD_freeDCtx(dctx);
+  DWIO_ENSURE(
+      !ZSTD_isError(ret), "ZSTD returned an error: ", ZSTD_getErrorName(ret));
+  return ret;
+}
+
+// static
+std::shared_ptr<const ZstdDictionary> ZstdDictionary::train(
+    const std::string& samples,
+    const std::vector<size_t>& sampleSizes,
+    size_t maxSize,
+    uint32_t id) {
+  DWIO_ENSURE_GE(id, kMinId);
+  std::string data(maxSize, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      data.data(),
+      data.size(),
+      samples.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    return nullptr;
+  }
+  data.resize(size);
+  // The trained dictionary has a random id. The frames record the id, which
+  // must therefore be unique among the dictionaries of a file.
+  memcpy(data.data() + kDictionaryIdOffset, &id, sizeof(id));
+  return std::make_shared<ZstdDictionary>(std::move(data));
+}
+
+void ZstdDictionaryTrainer::addSample(const void* data, uint64_t length) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (trained_) {
+    return;
+  }
+  const auto size = std::min(length, kMaxSampleSize);
+  samples_.append(static_cast<const char*>(data), size);
+  sampleSizes_.push_back(size);
+  if (samples_.size() < sampleBytes_) {
+    return;
+  }
+  dictionary_ =
+      ZstdDictionary::train(samples_, sampleSizes_, maxDictionarySize_, id_);
+  trained_ = true;
+  samples_.clear();
+  samples_.shrink_to_fit();
+  sampleSizes_.clear();
+  sampleSizes_.shrink_to_fit();
+}
+
+} // namespace facebook::velox::dwio::common::compression
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace facebook::velox::dwio::common::compression {
+
+/// A trained ZSTD dictionary. Small blocks of similar data compress much
+/// better with a dictionary than as standalone frames. ZSTD records the id
+/// of the dictionary in the frames that are compressed with it, so that a
+/// reader can pick the dictionary from the frame.
+class ZstdDictionary {
+ public:
+  /// 'data' is a dictionary made by train().
+  explicit ZstdDictionary(std::string data);
+
+  ~ZstdDictionary();
+
+  const std::string& data() const {
+    return data_;
+  }
+
+  /// The id written to the frames compressed with 'this'. Not 0.
+  uint32_t id() const {
+    return id_;
+  }
+
+  /// Compresses 'length' bytes at 'src' into at most 'length' bytes at
+  /// 'dest'. Returns the compressed size or 'length' if the result does not
+  /// fit.
+  uint64_t
+  compress(int32_t level, const void* src, void* dest, uint64_t length) const;
+
+  /// Decompresses a frame compressed with 'this'. Returns the decompressed
+  /// size.
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) const;
+
+  /// Trains a dictionary of at most 'maxSize' bytes from the samples in
+  /// 'samples'. 'sampleSizes' are the sizes of consecutive samples. The
+  /// dictionary gets 'id', which should not be below kMinId. Returns nullptr
+  /// if ZSTD can not train a dictionary from the samples, e.g. when there
+  /// are too few.
+  static std::shared_ptr<const ZstdDictionary> train(
+      const std::string& samples,
+      const std::vector<size_t>& sampleSizes,
+      size_t maxSize,
+      uint32_t id);
+
+  /// ZSTD reserves the ids below this.
+  static constexpr uint32_t kMinId = 32'768;
+
+ private:
+  const std::string data_;
+  const uint32_t id_;
+
+  mutable std::mutex mutex_;
+  // Digested dictionaries, made on first use. The compression dictionary is
+  // for 'cdictLevel_'.
+  mutable ZSTD_CDict_s* cdict_{nullptr};
+  mutable int32_t cdictLevel_{0};
+  mutable ZSTD_DDict_s* ddict_{nullptr};
+};
+
+/// The dictionaries of a file by id.
+using ZstdDictionaries =
+    folly::F14FastMap<uint32_t, std::shared_ptr<const ZstdDictionary>>;
+
+/// Samples the blocks compressed by a group of similar streams, e.g. the
+/// data streams of the integer columns of a file, until it has
+/// 'sampleBytes' and then trains a dictionary with 'id' for the group. The
+/// streams compress without a dictionary until the dictionary is trained.
+/// Thread safe.
+class ZstdDictionaryTrainer {
+ public:
+  ZstdDictionaryTrainer(
+      uint32_t id,
+      size_t maxDictionarySize,
+      uint64_t sampleBytes)
+      : id_(id),
+        maxDictionarySize_(maxDictionarySize),
+        sampleBytes_(sampleBytes) {}
+
+  /// Returns the trained dictionary or nullptr if not trained yet.
+  std::shared_ptr<const ZstdDictionary> dictionary() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return dictionary_;
+  }
+
+  /// Adds a block to compress as a sample. Trains the dictionary when
+  /// there are enough samples.
+  void addSample(const void* data, uint64_t length);
+
+ private:
+  // Samples longer than this are truncated.
+  static constexpr uint64_t kMaxSampleSize = 128 << 10;
+
+  const uint32_t id_;
+  const size_t maxDictionarySize_;
+  const uint64_t sampleBytes_;
+
+  mutable std::mutex mutex_;
+  std::string samples_;
+  std::vector<size_t> sampleSizes_;
+  // True after training, also if training failed.
+  bool trained_{false};
+  std::shared_ptr<const ZstdDictionary> dictionary_;
+};
+
+} // namespace facebook::velox::dwio::common::compression
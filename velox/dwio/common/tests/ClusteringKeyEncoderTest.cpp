@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/common/ClusteringKeyEncoder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+class ClusteringKeyEncoderTest : public testing::Test,
+                                 public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::vector<int64_t> encode(
+      ClusteringKeyEncoder& encoder,
+      const RowVectorPtr& input) {
+    auto keys = BaseVector::create<FlatVector<int64_t>>(BIGINT(), 0, pool());
+    encoder.encode(*input, *keys);
+    EXPECT_EQ(keys->size(), input->size());
+    std::vector<int64_t> result;
+    for (auto i = 0; i < keys->size(); ++i) {
+      EXPECT_GE(keys->valueAt(i), 0);
+      result.push_back(keys->valueAt(i));
+    }
+    return result;
+  }
+
+  // Checks that the keys of a single column follow the order of its values
+  // with nulls first.
+  void testSingleColumn(const VectorPtr& values) {
+    auto input = makeRowVector({values});
+    ClusteringKeyEncoder encoder(
+        ClusteringKeyEncoder::Curve::kZOrder, asRowType(input->type()), {0});
+    ASSERT_EQ(encoder.bitsPerColumn(), 32);
+    const auto keys = encode(encoder, input);
+    for (auto i = 0; i < values->size(); ++i) {
+      for (auto j = 0; j < values->size(); ++j) {
+        if (values->isNullAt(i)) {
+          ASSERT_LE(keys[i], keys[j]);
+        } else if (
+            !values->isNullAt(j) && values->compare(values.get(), i, j) < 0) {
+          ASSERT_LT(keys[i], keys[j]) << values->toString(i) << " "
+                                      << values->toString(j);
+        }
+      }
+    }
+  }
+};
+
+TEST_F(ClusteringKeyEncoderTest, singleColumn) {
+  testSingleColumn(makeNullableFlatVector<int64_t>(
+      {-1'000'000, std::nullopt, -1, 0, 7, 1'000'000, -20}));
+  testSingleColumn(makeNullableFlatVector<int32_t>({-5, 3, std::nullopt, 0}));
+  testSingleColumn(makeNullableFlatVector<double>(
+      {-1.5, 0.0, std::nullopt, 2.25, -100.0, 1e10}));
+  testSingleColumn(makeNullableFlatVector<std::string>(
+      {"banana", std::nullopt, "apple", "cherry", "", "apricot"}));
+  testSingleColumn(makeNullableFlatVector<bool>({true, std::nullopt, false}));
+}
+
+TEST_F(ClusteringKeyEncoderTest, zOrder) {
+  constexpr int32_t kSide = 16;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(
+          kSide * kSide, [](auto row) { return row / kSide; }),
+      makeFlatVector<int64_t>(
+          kSide * kSide, [](auto row) { return row % kSide; }),
+  });
+  ClusteringKeyEncoder encoder(
+      ClusteringKeyEncoder::Curve::kZOrder, asRowType(input->type()), {0, 1});
+  ASSERT_EQ(encoder.bitsPerColumn(), 31);
+  const auto keys = encode(encoder, input);
+  // The keys are distinct and increase along each dimension.
+  ASSERT_EQ(std::set<int64_t>(keys.begin(), keys.end()).size(), keys.size());
+  for (auto x = 0; x < kSide; ++x) {
+    for (auto y = 0; y + 1 < kSide; ++y) {
+      ASSERT_LT(keys[x * kSide + y], keys[x * kSide + y + 1]);
+      ASSERT_LT(keys[y * kSide + x], keys[(y + 1) * kSide + x]);
+    }
+  }
+
+  // Values outside of the range of the first batch are clamped.
+  auto outside = makeRowVector({
+      makeFlatVector<int32_t>({-100, 100}),
+      makeFlatVector<int64_t>({-100, 100}),
+  });
+  const auto outsideKeys = encode(encoder, outside);
+  ASSERT_EQ(outsideKeys[0], keys.front());
+  ASSERT_EQ(outsideKeys[1], keys.back());
+}
+
+TEST_F(ClusteringKeyEncoderTest, hilbert) {
+  // Consecutive positions on the curve are adjacent points.
+  constexpr int32_t kBits = 3;
+  constexpr int32_t kSide = 1 << kBits;
+  std::vector<std::pair<int32_t, int32_t>> points(kSide * kSide, {-1, -1});
+  for (auto x = 0; x < kSide; ++x) {
+    for (auto y = 0; y < kSide; ++y) {
+      uint32_t point[2] = {static_cast<uint32_t>(x), static_cast<uint32_t>(y)};
+      ClusteringKeyEncoder::hilbertTranspose(point, 2, kBits);
+      int32_t index = 0;
+      for (auto bit = kBits - 1; bit >= 0; --bit) {
+        for (auto i = 0; i < 2; ++i) {
+          index = (index << 1) | ((point[i] >> bit) & 1);
+        }
+      }
+      ASSERT_EQ(points[index].first, -1);
+      points[index] = {x, y};
+    }
+  }
+  for (auto i = 1; i < points.size(); ++i) {
+    ASSERT_EQ(
+        std::abs(points[i].first - points[i - 1].first) +
+            std::abs(points[i].second - points[i - 1].second),
+        1)
+        << i;
+  }
+
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(100, [](auto row) { return row / 10; }),
+      makeFlatVector<int32_t>(100, [](auto row) { return row % 10; }),
+      makeFlatVector<int32_t>(100, [](auto row) { return row % 7; }),
+  });
+  ClusteringKeyEncoder encoder(
+      ClusteringKeyEncoder::Curve::kHilbert,
+      asRowType(input->type()),
+      {0, 1, 2});
+  ASSERT_EQ(encoder.bitsPerColumn(), 21);
+  encode(encoder, input);
+}
+
+TEST_F(ClusteringKeyEncoderTest, curveName) {
+  for (auto curve :
+       {ClusteringKeyEncoder::Curve::kZOrder,
+        ClusteringKeyEncoder::Curve::kHilbert}) {
+    ASSERT_EQ(
+        ClusteringKeyEncoder::curveFromName(
+            ClusteringKeyEncoder::curveName(curve)),
+        curve);
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
@@ -113,3 +113,42 @@ TEST(ReadFileInputStream, VReadIOBufs) {
   std::vector<std::string> expected = {"aaaaab", "bcccc"};
   EXPECT_EQ(result, expected);
 }
+
+TEST(ReadFileInputStream, localAndRemoteBytes) {
+  // A file whose first 8 bytes are stored on this host.
+  class PartlyLocalReadFile : public InMemoryReadFile {
+   public:
+    using InMemoryReadFile::InMemoryReadFile;
+
+    std::optional<uint64_t> localBytes(uint64_t offset, uint64_t length)
+        const override {
+      return offset >= 8 ? 0 : std::min<uint64_t>(length, 8 - offset);
+    }
+  };
+
+  auto readFile =
+      std::make_shared<PartlyLocalReadFile>(std::string("aaaaabbbbbccccc"));
+  IoStatistics stats;
+  ReadFileInputStream inputStream(readFile, MetricsLog::voidLog(), &stats);
+  auto buf = std::make_unique<char[]>(15);
+  inputStream.read(buf.get(), 10, 2, LogType::STREAM);
+  EXPECT_EQ(stats.localBytesRead(), 6);
+  EXPECT_EQ(stats.remoteBytesRead(), 4);
+
+  std::vector<Region> regions = {{0, 4}, {9, 5}};
+  std::vector<folly::IOBuf> iobufs(regions.size());
+  inputStream.vread(regions, {iobufs.data(), iobufs.size()}, LogType::STREAM);
+  EXPECT_EQ(stats.localBytesRead(), 10);
+  EXPECT_EQ(stats.remoteBytesRead(), 9);
+
+  // Files that do not know where their data is do not count.
+  IoStatistics otherStats;
+  ReadFileInputStream otherStream(
+      std::make_shared<InMemoryReadFile>(std::string("aaaaa")),
+      MetricsLog::voidLog(),
+      &otherStats);
+  otherStream.read(buf.get(), 5, 0, LogType::STREAM);
+  EXPECT_EQ(otherStats.rawBytesRead(), 5);
+  EXPECT_EQ(otherStats.localBytesRead(), 0);
+  EXPECT_EQ(otherStats.remoteBytesRead(), 0);
+}
@@ -58,18 +58,22 @@ inline CompressionOptions getDwrfOrcCompressionOptions(
  * @param bufferHolder Buffer holder that handles buffer allocation and
  * collection
  * @param config The compression options to use
+ * @param dictionaryTrainer Trains the dictionary for ZSTD compression
  */
 inline std::unique_ptr<dwio::common::BufferedOutputStream> createCompressor(
     common::CompressionKind kind,
     CompressionBufferPool& bufferPool,
     dwio::common::DataBufferHolder& bufferHolder,
     const Config& config,
-    const dwio::common::encryption::Encrypter* encrypter = nullptr) {
+    const dwio::common::encryption::Encrypter* encrypter = nullptr,
+    std::shared_ptr<ZstdDictionaryTrainer> dictionaryTrainer = nullptr) {
   CompressionOptions dwrfOrcCompressionOptions = getDwrfOrcCompressionOptions(
       kind,
       config.get(Config::COMPRESSION_THRESHOLD),
       config.get(Config::ZLIB_COMPRESSION_LEVEL),
       config.get(Config::ZSTD_COMPRESSION_LEVEL));
+  dwrfOrcCompressionOptions.zstdDictionaryTrainer =
+      std::move(dictionaryTrainer);
   auto compressor = createCompressor(kind, dwrfOrcCompressionOptions);
   if (!compressor) {
     if (!encrypter && kind == common::CompressionKind::CompressionKind_NONE) {
@@ -105,6 +109,7 @@ inline CompressionOptions getDwrfOrcDecompressionOptions(
  * @param input The input stream that is the underlying source
  * @param bufferSize The maximum size of the buffer
  * @param pool The memory pool
+ * @param zstdDictionaries The ZSTD dictionaries of the file
  */
 inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     facebook::velox::common::CompressionKind kind,
@@ -112,8 +117,10 @@ inline std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     uint64_t bufferSize,
     memory::MemoryPool& pool,
     const std::string& streamDebugInfo,
-    const dwio::common::encryption::Decrypter* decryptr = nullptr) {
-  const CompressionOptions& options = getDwrfOrcDecompressionOptions(kind);
+    const dwio::common::encryption::Decrypter* decryptr = nullptr,
+    std::shared_ptr<const ZstdDictionaries> zstdDictionaries = nullptr) {
+  CompressionOptions options = getDwrfOrcDecompressionOptions(kind);
+  options.zstdDictionaries = std::move(zstdDictionaries);
   return createDecompressor(
       kind,
       std::move(input),
@@ -37,6 +37,14 @@ Config::Entry<int32_t> Config::ZSTD_COMPRESSION_LEVEL(
     "hive.exec.orc.compress.zstd.level",
     7);
 
+Config::Entry<uint32_t> Config::ZSTD_DICTIONARY_SIZE(
+    "orc.compress.zstd.dictionary.size",
+    0);
+
+Config::Entry<uint64_t> Config::ZSTD_DICTIONARY_SAMPLE_SIZE(
+    "orc.compress.zstd.dictionary.sample.size",
+    4 << 20);
+
 Config::Entry<uint64_t> Config::COMPRESSION_BLOCK_SIZE{
     "hive.exec.orc.compress.size",
     256 * 1024};
@@ -105,6 +113,14 @@ Config::Entry<uint32_t> Config::ENTROPY_STRING_THRESHOLD{
     "hive.exec.orc.entropy.string.threshold",
     20};
 
+Config::Entry<uint32_t> Config::DICTIONARY_SAMPLE_ROWS{
+    "orc.dictionary.sample.rows",
+    0};
+
+Config::Entry<uint64_t> Config::DICTIONARY_MAX_COLUMN_MEMORY{
+    "orc.dictionary.max.column.memory",
+    0};
+
 Config::Entry<uint32_t> Config::STRING_STATS_LIMIT(
     "hive.orc.string.stats.limit",
     64);
@@ -33,6 +33,13 @@ class Config : public common::ConfigBase<Config> {
   static Entry<common::CompressionKind> COMPRESSION;
   static Entry<int32_t> ZLIB_COMPRESSION_LEVEL;
   static Entry<int32_t> ZSTD_COMPRESSION_LEVEL;
+  /// Maximum size of the trained ZSTD dictionary for each group of streams.
+  /// The streams of the columns of the same type and of the same kind, e.g.
+  /// the lengths of VARCHAR columns, are in a group. 0 means no dictionaries.
+  static Entry<uint32_t> ZSTD_DICTIONARY_SIZE;
+  /// Bytes of samples for training a ZSTD dictionary. About 100 times the
+  /// dictionary size works well.
+  static Entry<uint64_t> ZSTD_DICTIONARY_SAMPLE_SIZE;
   static Entry<uint64_t> COMPRESSION_BLOCK_SIZE;
   static Entry<uint64_t> COMPRESSION_BLOCK_SIZE_MIN;
   static Entry<float> COMPRESSION_BLOCK_SIZE_EXTEND_RATIO;
@@ -51,6 +58,14 @@ class Config : public common::ConfigBase<Config> {
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
   static Entry<uint32_t> ENTROPY_STRING_THRESHOLD;
+  /// Number of values of the first batch of an integer or string column that
+  /// are sampled to estimate the distinct fraction with HyperLogLog before
+  /// building the dictionary. A column with a larger distinct fraction than
+  /// the key size threshold starts with direct encoding. 0 disables sampling.
+  static Entry<uint32_t> DICTIONARY_SAMPLE_ROWS;
+  /// Bytes that the dictionary of a column may hold in the first stripe
+  /// before the column switches to direct encoding. 0 means no limit.
+  static Entry<uint64_t> DICTIONARY_MAX_COLUMN_MEMORY;
   static Entry<uint32_t> STRING_STATS_LIMIT;
   static Entry<bool> FLATTEN_MAP;
   static Entry<bool> MAP_FLAT_DISABLE_DICT_ENCODING;
@@ -452,6 +452,16 @@ class FooterWrapper : public ProtoWrapperBase {
     return dwrfPtr()->encryption();
   }
 
+  int zstdDictionariesSize() const {
+    return format_ == DwrfFormat::kDwrf ? dwrfPtr()->zstddictionaries_size()
+                                        : 0;
+  }
+
+  const std::string& zstdDictionaries(int index) const {
+    VELOX_CHECK_EQ(format_, DwrfFormat::kDwrf);
+    return dwrfPtr()->zstddictionaries(index);
+  }
+
   int stripesSize() const {
     return format_ == DwrfFormat::kDwrf ? dwrfPtr()->stripes_size()
                                         : orcPtr()->stripes_size();
@@ -22,6 +22,8 @@
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
+#include <folly/lang/Bits.h>
+
 #include <vector>
 
 namespace facebook::velox::dwrf {
@@ -64,6 +66,10 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     skipPending();
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
+    if constexpr (!hasNulls) {
+      readBatchesWithVisitor(current, visitor);
+      return;
+    }
 
     int32_t toSkip;
     bool atEnd = false;
@@ -100,6 +106,35 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  static constexpr int32_t kVisitorBatchSize = 128;
+
+  // Decodes the values from row 'current' to the last row of 'visitor' in
+  // batches of up to kVisitorBatchSize and passes the values of the visited
+  // rows to 'visitor'. The values between visited rows in a batch are
+  // decoded and dropped, which is what skip() would do for them.
+  template <typename Visitor>
+  void readBatchesWithVisitor(int32_t current, Visitor& visitor) {
+    const int32_t end = visitor.rowAt(visitor.numRows() - 1) + 1;
+    int64_t values[kVisitorBatchSize];
+    bool atEnd = false;
+    while (current < end) {
+      const int32_t batchStart = current;
+      const int32_t batchEnd = std::min(end, current + kVisitorBatchSize);
+      doNext(values, batchEnd - batchStart, nullptr);
+      while (current < batchEnd) {
+        const auto toSkip =
+            visitor.process(values[current - batchStart], atEnd);
+        if (atEnd) {
+          return;
+        }
+        current += toSkip + 1;
+      }
+      if (current > batchEnd) {
+        this->template skip<false>(current - batchEnd, 0, nullptr);
+      }
+    }
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap = static_cast<uint64_t>(unpackedPatch[patchIdx]) >> patchBitSize;
@@ -159,9 +194,11 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
+    if (!nulls) {
+      ret = readLongsInWords(data + offset, len, fb);
+    }
 
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
+    for (uint64_t i = offset + ret; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
         continue;
@@ -189,6 +226,53 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Decodes up to 'len' 'fb' bit values into 'data' with one unaligned
+  // 64-bit load per value. Stops before a load would go past the end of the
+  // buffer and returns the number of values decoded. The rest are decoded a
+  // byte at a time by readLongs().
+  uint64_t readLongsInWords(int64_t* data, uint64_t len, uint64_t fb) {
+    auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+    const auto* bufferEnd = dwio::common::IntDecoder<isSigned>::bufferEnd;
+    if (fb == 0 || (fb > 56 && (fb != 64 || bitsLeft > 0))) {
+      return 0;
+    }
+    // 'curByte' is the last byte read from the buffer.
+    const char* start = bufferStart;
+    uint64_t bit = 0;
+    if (bitsLeft > 0) {
+      --start;
+      bit = 8 - bitsLeft;
+    }
+    const uint64_t available = bufferEnd - start;
+    if (available < 8 || (available - 8) * 8 < bit) {
+      return 0;
+    }
+    const uint64_t numValues =
+        std::min(len, ((available - 8) * 8 - bit) / fb + 1);
+    if (fb == 64) {
+      for (uint64_t i = 0; i < numValues; ++i) {
+        data[i] = static_cast<int64_t>(
+            folly::Endian::big(folly::loadUnaligned<uint64_t>(start + i * 8)));
+      }
+    } else {
+      uint64_t position = bit;
+      for (uint64_t i = 0; i < numValues; ++i, position += fb) {
+        const auto word = folly::Endian::big(
+            folly::loadUnaligned<uint64_t>(start + (position >> 3)));
+        data[i] = static_cast<int64_t>((word << (position & 7)) >> (64 - fb));
+      }
+    }
+    const uint64_t endBit = bit + numValues * fb;
+    bufferStart = start + (endBit >> 3);
+    if (endBit & 7) {
+      curByte = static_cast<unsigned char>(*bufferStart++);
+      bitsLeft = 8 - (endBit & 7);
+    } else {
+      bitsLeft = 0;
+    }
+    return numValues;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
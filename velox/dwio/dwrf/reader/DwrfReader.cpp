@@ -18,6 +18,7 @@
 
 #include <chrono>
 
+#include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -43,8 +44,8 @@ DwrfRowReader::DwrfRowReader(
       columnSelector_{std::make_shared<ColumnSelector>(
           ColumnSelector::apply(opts.getSelector(), reader->getSchema()))} {
   if (executor_) {
-    LOG(INFO) << "Using parallel decoding with a parallelism factor of "
-              << options_.getDecodingParallelismFactor();
+    VLOG(1) << "Using parallel decoding with a parallelism factor of "
+            << options_.getDecodingParallelismFactor();
   }
   auto& fileFooter = getReader().getFooter();
   uint32_t numberOfStripes = fileFooter.stripesSize();
@@ -536,6 +537,14 @@ DwrfRowReader::FetchResult DwrfRowReader::fetch(uint32_t stripeIndex) {
         flatMapContext,
         true); // isRoot
     stripeState.selectiveColumnReader->setIsTopLevel();
+    if (executor_ && options_.getDecodingParallelismFactor() > 1) {
+      if (auto* root =
+              dynamic_cast<dwio::common::SelectiveStructColumnReaderBase*>(
+                  stripeState.selectiveColumnReader.get())) {
+        root->setDecodingExecutor(
+            executor_.get(), options_.getDecodingParallelismFactor());
+      }
+    }
   } else {
     stripeState.columnReader = ColumnReader::build( // enqueue streams
         requestedType,
@@ -786,7 +795,9 @@ DwrfReader::DwrfReader(
           options.getFilePreloadThreshold(),
           options.getFileFormat() == FileFormat::ORC ? FileFormat::ORC
                                                      : FileFormat::DWRF,
-          options.isFileColumnNamesReadAsLowerCase())),
+          options.isFileColumnNamesReadAsLowerCase(),
+          options.getFileMetadataCache(),
+          options.getFileMetadataKey())),
       options_(options) {
   // If we are not using column names to map table columns to file columns, then
   // we use indices. In that case we need to ensure the names completely match,
@@ -32,6 +32,45 @@ using dwio::common::encryption::DecrypterFactory;
 using encryption::DecryptionHandler;
 using memory::MemoryPool;
 
+namespace {
+// PostScript and Footer of a file. The Footer is allocated on 'arena'. Also
+// keeps the stripe metadata cache and the ZSTD dictionaries, so that the
+// readers of the file, e.g. for different splits, share them.
+struct FileTail : public cache::FileMetadata {
+  FileTail(
+      std::unique_ptr<google::protobuf::Arena> _arena,
+      std::shared_ptr<const PostScript> _postScript,
+      const FooterWrapper& _footer,
+      uint64_t _psLength)
+      : arena(std::move(_arena)),
+        postScript(std::move(_postScript)),
+        footer(_footer),
+        psLength(_psLength) {}
+
+  uint64_t memoryUsage() const override {
+    uint64_t bytes = sizeof(*this) + arena->SpaceUsed() + psLength;
+    if (stripeMetadataCache) {
+      bytes += stripeMetadataCache->memoryUsage();
+    }
+    if (zstdDictionaries) {
+      // A dictionary is digested into a copy of about its size.
+      for (const auto& [_, dictionary] : *zstdDictionaries) {
+        bytes += 2 * dictionary->data().size();
+      }
+    }
+    return bytes;
+  }
+
+  const std::unique_ptr<google::protobuf::Arena> arena;
+  const std::shared_ptr<const PostScript> postScript;
+  const FooterWrapper footer;
+  const uint64_t psLength;
+  // Set before 'this' is added to a FileMetadataCache.
+  std::shared_ptr<const StripeMetadataCache> stripeMetadataCache;
+  std::shared_ptr<const ZstdDictionaries> zstdDictionaries;
+};
+} // namespace
+
 FooterStatisticsImpl::FooterStatisticsImpl(
     const ReaderBase& reader,
     const StatsContext& statsContext) {
@@ -94,7 +133,9 @@ ReaderBase::ReaderBase(
     uint64_t footerEstimatedSize,
     uint64_t filePreloadThreshold,
     FileFormat fileFormat,
-    bool fileColumnNamesReadAsLowerCase)
+    bool fileColumnNamesReadAsLowerCase,
+    cache::FileMetadataCache* metadataCache,
+    const std::string& metadataKey)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
@@ -102,12 +143,119 @@ ReaderBase::ReaderBase(
       filePreloadThreshold_(filePreloadThreshold),
       input_(std::move(input)) {
   process::TraceContext trace("ReaderBase::ReaderBase");
-  // read last bytes into buffer to get PostScript
-  // If file is small, load the entire file.
-  // TODO: make a config
   fileLength_ = input_->getReadFile()->size();
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
 
+  std::string cacheKey;
+  std::shared_ptr<const FileTail> cachedTail;
+  if (metadataCache != nullptr) {
+    cacheKey = fmt::format(
+        "{}:{}", fileFormat == FileFormat::DWRF ? "dwrf" : "orc", metadataKey);
+    cachedTail =
+        std::dynamic_pointer_cast<const FileTail>(metadataCache->find(cacheKey));
+  }
+  const bool tailCached = cachedTail != nullptr;
+  if (tailCached) {
+    postScript_ = cachedTail->postScript;
+    footer_ = std::make_unique<FooterWrapper>(cachedTail->footer);
+    psLength_ = cachedTail->psLength;
+    cache_ = cachedTail->stripeMetadataCache;
+    zstdDictionaries_ = cachedTail->zstdDictionaries;
+    tail_ = std::move(cachedTail);
+  } else {
+    readTail(fileFormat);
+  }
+
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize =
+      1 + psLength_ + postScript_->footerLength() + cacheSize;
+  if (tailCached && !cache_ && cacheSize > 0 &&
+      !input_->shouldPrefetchStripes()) {
+    // The stripe metadata cache is not part of the cached tail and is read
+    // below.
+    input_->enqueue({fileLength_ - tailSize, cacheSize, "footer"});
+    input_->load(LogType::FOOTER);
+  }
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+
+  // load stripe index/footer cache
+  if (cacheSize > 0 && !cache_) {
+    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
+    if (metadataCache != nullptr) {
+      // Not allocated from 'pool' since the readers of other queries may use
+      // it through 'metadataCache'.
+      std::string data(cacheSize, '\0');
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(data.data(), cacheSize);
+      cache_ = std::make_shared<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(data));
+    } else if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_shared<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      auto cacheBuffer =
+          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_shared<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  if (!tailCached) {
+    loadZstdDictionaries();
+  }
+  if (metadataCache != nullptr && !tailCached) {
+    // 'tail_' is not shared until it is inserted.
+    auto* tail =
+        const_cast<FileTail*>(static_cast<const FileTail*>(tail_.get()));
+    tail->stripeMetadataCache = cache_;
+    tail->zstdDictionaries = zstdDictionaries_;
+    metadataCache->insert(cacheKey, tail_);
+  }
+}
+
+void ReaderBase::loadZstdDictionaries() {
+  if (footer_->zstdDictionariesSize() == 0) {
+    return;
+  }
+  auto dictionaries = std::make_shared<ZstdDictionaries>();
+  for (auto i = 0; i < footer_->zstdDictionariesSize(); ++i) {
+    auto dictionary =
+        std::make_shared<ZstdDictionary>(footer_->zstdDictionaries(i));
+    const auto id = dictionary->id();
+    DWIO_ENSURE(
+        dictionaries->emplace(id, std::move(dictionary)).second,
+        "Duplicate ZSTD dictionary id ",
+        id);
+  }
+  zstdDictionaries_ = std::move(dictionaries);
+}
+
+void ReaderBase::readTail(FileFormat fileFormat) {
+  // read last bytes into buffer to get PostScript
+  // If file is small, load the entire file.
   auto preloadFile = fileLength_ <= filePreloadThreshold_;
   uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, footerEstimatedSize_);
@@ -133,11 +281,11 @@ ReaderBase::ReaderBase(
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   }
 
   uint64_t footerSize = postScript_->footerLength();
@@ -166,61 +314,26 @@ ReaderBase::ReaderBase(
     input_->load(LogType::FOOTER);
   }
 
+  auto arena = std::make_unique<google::protobuf::Arena>();
   auto footerStream = input_->read(
       fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
     auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+        google::protobuf::Arena::CreateMessage<proto::Footer>(arena.get());
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
     footer_ = std::make_unique<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+        arena.get());
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
     footer_ = std::make_unique<FooterWrapper>(footer);
   }
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
-      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
-  }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  tail_ = std::make_shared<FileTail>(
+      std::move(arena), postScript_, *footer_, psLength_);
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
@@ -70,7 +70,9 @@ class ReaderBase {
       uint64_t filePreloadThreshold =
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
-      bool fileColumnNamesReadAsLowerCase = false);
+      bool fileColumnNamesReadAsLowerCase = false,
+      cache::FileMetadataCache* metadataCache = nullptr,
+      const std::string& metadataKey = "");
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -83,7 +85,7 @@ class ReaderBase {
       std::unique_ptr<dwio::common::BufferedInput> input,
       std::unique_ptr<PostScript> ps,
       const proto::Footer* footer,
-      std::unique_ptr<StripeMetadataCache> cache,
+      std::shared_ptr<const StripeMetadataCache> cache,
       std::unique_ptr<encryption::DecryptionHandler> handler = nullptr)
       : pool_{pool},
         postScript_{std::move(ps)},
@@ -100,6 +102,7 @@ class ReaderBase {
     if (!handler_) {
       handler_ = encryption::DecryptionHandler::create(*footer);
     }
+    loadZstdDictionaries();
   }
 
   // for testing
@@ -139,7 +142,7 @@ class ReaderBase {
     return *input_;
   }
 
-  const std::unique_ptr<StripeMetadataCache>& getMetadataCache() const {
+  const std::shared_ptr<const StripeMetadataCache>& getMetadataCache() const {
     return cache_;
   }
 
@@ -210,7 +213,8 @@ class ReaderBase {
         getCompressionBlockSize(),
         pool_,
         streamDebugInfo,
-        decrypter);
+        decrypter,
+        zstdDictionaries_);
   }
 
   template <typename T>
@@ -237,14 +241,27 @@ class ReaderBase {
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
+  // Reads and parses the PostScript and the Footer into 'tail_'.
+  void readTail(dwio::common::FileFormat fileFormat);
+
+  // Makes 'zstdDictionaries_' from the footer.
+  void loadZstdDictionaries();
+
   memory::MemoryPool& pool_;
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
+  // Owns the PostScript and Footer read from the file. May be shared with
+  // the readers of other queries through a FileMetadataCache.
+  std::shared_ptr<const cache::FileMetadata> tail_;
+  std::shared_ptr<const PostScript> postScript_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
-  std::unique_ptr<StripeMetadataCache> cache_;
+  // May be shared with the readers of other splits of the file through a
+  // FileMetadataCache.
+  std::shared_ptr<const StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
   std::unique_ptr<encryption::DecryptionHandler> handler_;
+  // The ZSTD dictionaries of the file. nullptr if there are none.
+  std::shared_ptr<const ZstdDictionaries> zstdDictionaries_;
   const uint64_t footerEstimatedSize_{
       dwio::common::ReaderOptions::kDefaultFooterEstimatedSize};
   const uint64_t filePreloadThreshold_{
@@ -106,33 +106,128 @@ void SelectiveDecimalColumnReader<DataT>::readHelper(RowSet rows) {
   readOffset_ += numRows;
 }
 
+template <typename DataT>
+void SelectiveDecimalColumnReader<DataT>::fillDecimals(const uint64_t* nulls) {
+  const auto* scales = scaleBuffer_->as<int64_t>();
+  auto* values = values_->asMutable<DataT>();
+  // Writers mostly write all values with the scale of the column. The check
+  // is branch free, unlike the rescaling.
+  bool sameScale = true;
+  for (vector_size_t i = 0; i < numValues_; ++i) {
+    sameScale &= scales[i] == scale_;
+  }
+  if (!sameScale) {
+    DecimalUtil::fillDecimals<DataT>(
+        values, nulls, values, scales, numValues_, scale_);
+  }
+  rescaled_ = true;
+}
+
+template <typename DataT>
+template <typename Test>
+void SelectiveDecimalColumnReader<DataT>::processFilter(
+    const common::Filter& filter,
+    RowSet rows,
+    const uint64_t* nulls,
+    Test test) {
+  auto* values = values_->asMutable<DataT>();
+  returnReaderNulls_ = false;
+  anyNulls_ = false;
+  allNull_ = true;
+  vector_size_t numPassed = 0;
+  for (vector_size_t i = 0; i < numValues_; ++i) {
+    if (nulls && bits::isBitNull(nulls, i)) {
+      if (filter.testNull()) {
+        bits::setNull(rawResultNulls_, numPassed);
+        addOutputRow(rows[i]);
+        anyNulls_ = true;
+        ++numPassed;
+      }
+    } else if (test(values[i])) {
+      if (nulls) {
+        bits::setNull(rawResultNulls_, numPassed, false);
+      }
+      values[numPassed++] = values[i];
+      addOutputRow(rows[i]);
+      allNull_ = false;
+    }
+  }
+}
+
+template <typename DataT>
+void SelectiveDecimalColumnReader<DataT>::processFilter(
+    const common::Filter& filter,
+    RowSet rows,
+    bool isDense) {
+  const auto* nulls = nullsInReadRange_
+      ? (isDense ? nullsInReadRange_->as<uint64_t>() : rawResultNulls_)
+      : nullptr;
+  fillDecimals(nulls);
+  // Range filters are applied inline, other filters through their virtual
+  // test functions.
+  if constexpr (std::is_same_v<DataT, int64_t>) {
+    if (filter.kind() == common::FilterKind::kBigintRange) {
+      const auto& range = static_cast<const common::BigintRange&>(filter);
+      const auto lower = range.lower();
+      const auto upper = range.upper();
+      processFilter(filter, rows, nulls, [&](int64_t value) {
+        return value >= lower && value <= upper;
+      });
+    } else {
+      processFilter(filter, rows, nulls, [&](int64_t value) {
+        return filter.testInt64(value);
+      });
+    }
+  } else {
+    if (filter.kind() == common::FilterKind::kHugeintRange) {
+      const auto& range = static_cast<const common::HugeintRange&>(filter);
+      const auto lower = range.lower();
+      const auto upper = range.upper();
+      processFilter(filter, rows, nulls, [&](int128_t value) {
+        return value >= lower && value <= upper;
+      });
+    } else {
+      processFilter(filter, rows, nulls, [&](int128_t value) {
+        return filter.testInt128(value);
+      });
+    }
+  }
+}
+
 template <typename DataT>
 void SelectiveDecimalColumnReader<DataT>::read(
     vector_size_t offset,
     RowSet rows,
     const uint64_t* incomingNulls) {
-  VELOX_CHECK(!scanSpec_->filter());
   prepareRead<int64_t>(offset, rows, incomingNulls);
+  auto* filter = scanSpec_->filter();
+  if (filter != nullptr &&
+      (!resultNulls_ || !resultNulls_->unique() ||
+       resultNulls_->capacity() * 8 < rows.size())) {
+    // The filtered nulls are compacted into a dedicated 'resultNulls_'.
+    resultNulls_ = AlignedBuffer::allocate<bool>(rows.size(), &memoryPool_);
+    rawResultNulls_ = resultNulls_->asMutable<uint64_t>();
+  }
+  rescaled_ = false;
   bool isDense = rows.back() == rows.size() - 1;
   if (isDense) {
     readHelper<true>(rows);
   } else {
     readHelper<false>(rows);
   }
+  if (filter != nullptr) {
+    processFilter(*filter, rows, isDense);
+  }
 }
 
 template <typename DataT>
 void SelectiveDecimalColumnReader<DataT>::getValues(
     RowSet rows,
     VectorPtr* result) {
-  auto nullsPtr =
-      resultNulls() ? resultNulls()->template as<uint64_t>() : nullptr;
-  auto scales = scaleBuffer_->as<int64_t>();
-  auto values = values_->asMutable<DataT>();
-
-  DecimalUtil::fillDecimals<DataT>(
-      values, nullsPtr, values, scales, numValues_, scale_);
-
+  if (!rescaled_) {
+    fillDecimals(
+        resultNulls() ? resultNulls()->template as<uint64_t>() : nullptr);
+  }
   rawValues_ = values_->asMutable<char>();
   getIntValues(rows, requestedType_, result);
 }
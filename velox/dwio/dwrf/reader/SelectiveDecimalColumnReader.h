@@ -44,12 +44,29 @@ class SelectiveDecimalColumnReader : public SelectiveColumnReader {
   template <bool kDense>
   void readHelper(RowSet rows);
 
+  // Rescales the decoded values to the scale of the column. 'nulls' are the
+  // nulls of the decoded values or nullptr if there are no nulls.
+  void fillDecimals(const uint64_t* nulls);
+
+  // Keeps the rows of 'rows' whose value passes 'filter' and compacts the
+  // values and nulls. 'test' tests a non-null value.
+  template <typename Test>
+  void processFilter(
+      const common::Filter& filter,
+      RowSet rows,
+      const uint64_t* nulls,
+      Test test);
+
+  void processFilter(const common::Filter& filter, RowSet rows, bool isDense);
+
   std::unique_ptr<IntDecoder<true>> valueDecoder_;
   std::unique_ptr<IntDecoder<true>> scaleDecoder_;
 
   BufferPtr scaleBuffer_;
   RleVersion version_;
   int32_t scale_ = 0;
+  // True if the values of the last read() are already rescaled.
+  bool rescaled_{false};
 };
 
 } // namespace facebook::velox::dwrf
@@ -16,6 +16,8 @@
 
 #include "velox/dwio/dwrf/reader/SelectiveFlatMapColumnReader.h"
 
+#include <folly/Conv.h>
+
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/dwrf/reader/SelectiveDwrfReader.h"
 #include "velox/dwio/dwrf/reader/SelectiveStructColumnReader.h"
@@ -109,11 +111,15 @@ std::vector<KeyNode<T>> getKeyNodes(
   std::unordered_map<KeyValue<T>, common::ScanSpec*, KeyValueHash<T>>
       childSpecs;
   if (asStruct) {
+    // The fields of the struct are named after the keys. The subscripts are
+    // reset so that the keys that are not in this stripe read as nulls.
     for (auto& c : scanSpec.children()) {
+      c->setSubscript(
+          SelectiveStructColumnReaderBase::kConstantChildSpecSubscript);
       if constexpr (std::is_same_v<T, StringView>) {
         childSpecs[KeyValue<T>(StringView(c->fieldName()))] = c.get();
-      } else {
-        childSpecs[KeyValue<T>(c->subscript())] = c.get();
+      } else if (auto key = folly::tryTo<T>(c->fieldName()); key.hasValue()) {
+        childSpecs[KeyValue<T>(key.value())] = c.get();
       }
     }
   }
@@ -182,6 +188,10 @@ std::vector<KeyNode<T>> getKeyNodes(
   return keyNodes;
 }
 
+// Reads the flat map as a struct with a field per projected key. Only the
+// streams of the projected keys are decoded and the filters on the fields
+// are applied by the value readers of the keys. Keys that are not in the
+// stripe are null.
 template <typename T>
 class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
  public:
@@ -199,17 +209,36 @@ class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
         keyNodes_(
             getKeyNodes<T>(requestedType, fileType, params, scanSpec, true)) {
     VELOX_CHECK(
-        !keyNodes_.empty(),
+        !scanSpec.children().empty(),
         "For struct encoding, keys to project must be configured");
     children_.resize(keyNodes_.size());
     for (int i = 0; i < keyNodes_.size(); ++i) {
       keyNodes_[i].reader->scanSpec()->setSubscript(i);
       children_[i] = keyNodes_[i].reader.get();
     }
+    for (auto& childSpec : scanSpec.children()) {
+      if (childSpec->subscript() == kConstantChildSpecSubscript &&
+          !childSpec->isConstant() && childSpec->hasFilter() &&
+          (!childSpec->filter() || !childSpec->filter()->testNull())) {
+        missingKeyFilterFails_ = true;
+      }
+    }
+  }
+
+  void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
+      override {
+    SelectiveStructColumnReaderBase::read(offset, rows, incomingNulls);
+    if (missingKeyFilterFails_) {
+      // A filter on a key that is not in the stripe does not pass nulls.
+      setOutputRows(RowSet());
+    }
   }
 
  private:
   std::vector<KeyNode<T>> keyNodes_;
+  // True if a projected key is not in the stripe and has a filter that fails
+  // on null.
+  bool missingKeyFilterFails_{false};
 };
 
 template <typename T>
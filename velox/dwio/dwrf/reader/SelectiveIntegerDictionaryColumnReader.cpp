@@ -105,6 +105,12 @@ void SelectiveIntegerDictionaryColumnReader::read(
 
   // lazy load dictionary only when it's needed
   ensureInitialized();
+  if (noDictionaryHits_) {
+    // Neither nulls nor any dictionary entry pass the filter.
+    dataReader_->skip(rawNulls ? bits::countNonNulls(rawNulls, 0, end) : end);
+    readOffset_ += end;
+    return;
+  }
   readCommon<SelectiveIntegerDictionaryColumnReader>(rows);
 
   readOffset_ += rows.back() + 1;
@@ -117,7 +123,14 @@ void SelectiveIntegerDictionaryColumnReader::ensureInitialized() {
 
   Timer timer;
   scanState_.dictionary.values = dictInit_();
-  if (scanSpec_->hasFilter()) {
+  auto* filter = scanSpec_->filter();
+  if (filter && !inDictionaryReader_ && !scanSpec_->valueHook() &&
+      filter->isDeterministic() && !filter->testNull()) {
+    // All values of the stripe come from the dictionary. If no entry passes,
+    // no row of the stripe passes and read() skips the indices.
+    noDictionaryHits_ = !VELOX_WIDTH_DISPATCH(
+        sizeOfIntKind(fileType_->type()->kind()), filterDictionary, *filter);
+  } else if (scanSpec_->hasFilter()) {
     // Make sure there is a cache even for an empty dictionary because of asan
     // failure when preparing a gather with all lanes masked out.
     scanState_.filterCache.resize(
@@ -132,4 +145,14 @@ void SelectiveIntegerDictionaryColumnReader::ensureInitialized() {
   scanState_.updateRawState();
 }
 
+template <typename T>
+bool SelectiveIntegerDictionaryColumnReader::filterDictionary(
+    common::Filter& filter) {
+  return fillFilterCache(
+      filter,
+      scanState_.dictionary.values->as<T>(),
+      scanState_.dictionary.numValues,
+      scanState_.filterCache);
+}
+
 } // namespace facebook::velox::dwrf
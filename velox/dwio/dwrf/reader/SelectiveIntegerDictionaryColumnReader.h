@@ -57,12 +57,20 @@ class SelectiveIntegerDictionaryColumnReader
  private:
   void ensureInitialized();
 
+  // Evaluates 'filter' on each entry of the dictionary of T and fills the
+  // filter cache. Returns true if any entry passes.
+  template <typename T>
+  bool filterDictionary(common::Filter& filter);
+
   std::unique_ptr<ByteRleDecoder> inDictionaryReader_;
   std::unique_ptr<dwio::common::IntDecoder</* isSigned = */ false>> dataReader_;
   std::unique_ptr<dwio::common::IntDecoder</* isSigned = */ true>> dictReader_;
   std::function<BufferPtr()> dictInit_;
   RleVersion rleVersion_;
   bool initialized_{false};
+  // True if no dictionary entry passes the filter and there are no literal
+  // values, so that no row of the stripe can pass.
+  bool noDictionaryHits_{false};
 };
 
 template <typename ColumnVisitor>
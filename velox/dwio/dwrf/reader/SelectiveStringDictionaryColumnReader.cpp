@@ -196,6 +196,10 @@ void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
         scanState_.dictionary.values,
         std::vector<BufferPtr>{scanState_.dictionary.strings});
   }
+  // The same values are used for all batches until the next stride or stripe
+  // dictionary, so expressions over them can cache results from the first
+  // batch.
+  dictionaryValues_->enableMemoOnFirstUse();
 }
 
 void SelectiveStringDictionaryColumnReader::read(
@@ -209,6 +213,15 @@ void SelectiveStringDictionaryColumnReader::read(
   // lazy loading dictionary data when first hit
   ensureInitialized();
 
+  if (noDictionaryHits_) {
+    // Neither nulls nor any dictionary entry pass the filter.
+    const auto end = rows.back() + 1;
+    dictIndex_->skip(nullsPtr ? bits::countNonNulls(nullsPtr, 0, end) : end);
+    readOffset_ += end;
+    numRowsScanned_ = readOffset_ - offset;
+    return;
+  }
+
   if (inDictionaryReader_) {
     auto end = rows.back() + 1;
     bool isBulk = useBulkPath();
@@ -333,7 +346,17 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
 
-  if (scanSpec_->hasFilter()) {
+  auto* filter = scanSpec_->filter();
+  if (filter && !inDictionaryReader_ && !scanSpec_->valueHook() &&
+      filter->isDeterministic() && !filter->testNull()) {
+    // All values of the stripe come from the stripe dictionary. If no entry
+    // passes, no row of the stripe passes and read() skips the indices.
+    noDictionaryHits_ = !fillFilterCache(
+        *filter,
+        scanState_.dictionary.values->as<StringView>(),
+        scanState_.dictionary.numValues,
+        scanState_.filterCache);
+  } else if (scanSpec_->hasFilter()) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
     simd::memset(
         scanState_.filterCache.data(),
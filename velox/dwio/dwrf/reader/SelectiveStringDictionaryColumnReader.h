@@ -104,6 +104,9 @@ class SelectiveStringDictionaryColumnReader
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> lengthDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
   bool initialized_{false};
+  // True if no entry of the stripe dictionary passes the filter and there is
+  // no stride dictionary, so that no row of the stripe can pass.
+  bool noDictionaryHits_{false};
   vector_size_t numRowsScanned_;
 };
 
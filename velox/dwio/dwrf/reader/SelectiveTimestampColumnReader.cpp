@@ -22,6 +22,22 @@ namespace facebook::velox::dwrf {
 
 using namespace dwio::common;
 
+namespace {
+// Multipliers of the nanos indexed by the low 3 bits of the encoded nanos.
+// These give the number of removed trailing zeros, 0 for none and n for
+// n + 1.
+constexpr uint64_t kNanosMultipliers[8] =
+    {1, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000};
+
+FOLLY_ALWAYS_INLINE Timestamp decodeTimestamp(int64_t seconds, uint64_t nanos) {
+  nanos = (nanos >> 3) * kNanosMultipliers[nanos & 7];
+  seconds += EPOCH_OFFSET;
+  // The seconds are rounded towards zero when written.
+  seconds -= seconds < 0 && nanos != 0;
+  return Timestamp(seconds, nanos);
+}
+} // namespace
+
 SelectiveTimestampColumnReader::SelectiveTimestampColumnReader(
     const std::shared_ptr<const TypeWithId>& fileType,
     DwrfParams& params,
@@ -134,21 +150,37 @@ void SelectiveTimestampColumnReader::readHelper(
   auto tsValues = AlignedBuffer::allocate<Timestamp>(numValues_, &memoryPool_);
   auto rawTs = tsValues->asMutable<Timestamp>();
 
-  for (vector_size_t i = 0; i < numValues_; i++) {
-    if (!rawNulls || !bits::isBitNull(rawNulls, i)) {
-      auto nanos = nanosData[i];
-      uint64_t zeros = nanos & 0x7;
-      nanos >>= 3;
-      if (zeros != 0) {
-        for (uint64_t j = 0; j <= zeros; ++j) {
-          nanos *= 10;
-        }
+  if (rawNulls == nullptr && filter != nullptr &&
+      filter->kind() == common::FilterKind::kTimestampRange) {
+    // Decodes and filters in one pass without a virtual call per row.
+    const auto* range = static_cast<const common::TimestampRange*>(filter);
+    const auto lower = range->lower();
+    const auto upper = range->upper();
+    returnReaderNulls_ = false;
+    anyNulls_ = false;
+    vector_size_t numPassed = 0;
+    for (vector_size_t i = 0; i < numValues_; i++) {
+      const auto timestamp = decodeTimestamp(secondsData[i], nanosData[i]);
+      if (timestamp >= lower && timestamp <= upper) {
+        rawTs[numPassed++] = timestamp;
+        addOutputRow(rows[i]);
       }
-      auto seconds = secondsData[i] + EPOCH_OFFSET;
-      if (seconds < 0 && nanos != 0) {
-        seconds -= 1;
+    }
+    allNull_ = numPassed == 0;
+    values_ = tsValues;
+    rawValues_ = values_->asMutable<char>();
+    return;
+  }
+
+  if (rawNulls == nullptr) {
+    for (vector_size_t i = 0; i < numValues_; i++) {
+      rawTs[i] = decodeTimestamp(secondsData[i], nanosData[i]);
+    }
+  } else {
+    for (vector_size_t i = 0; i < numValues_; i++) {
+      if (!bits::isBitNull(rawNulls, i)) {
+        rawTs[i] = decodeTimestamp(secondsData[i], nanosData[i]);
       }
-      rawTs[i] = Timestamp(seconds, nanos);
     }
   }
   values_ = tsValues;
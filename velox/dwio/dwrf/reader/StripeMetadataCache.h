@@ -37,6 +37,14 @@ class StripeMetadataCache {
       std::vector<uint32_t>&& offsets)
       : mode_{mode}, buffer_{std::move(buffer)}, offsets_{std::move(offsets)} {}
 
+  /// Owns 'data' instead of a buffer from a memory pool, so that 'this' can
+  /// be shared by readers of different queries.
+  StripeMetadataCache(
+      StripeCacheMode mode,
+      const FooterWrapper& footer,
+      std::string data)
+      : mode_{mode}, data_{std::move(data)}, offsets_{getOffsets(footer)} {}
+
   StripeMetadataCache(
       StripeCacheMode mode,
       const FooterWrapper& footer,
@@ -65,6 +73,9 @@ class StripeMetadataCache {
       if (buffer_) {
         return std::make_unique<dwio::common::SeekableArrayInputStream>(
             buffer_->data() + offset, offsets_[index + 1] - offset);
+      } else if (!input_) {
+        return std::make_unique<dwio::common::SeekableArrayInputStream>(
+            data_.data() + offset, offsets_[index + 1] - offset);
       } else {
         auto clone =
             reinterpret_cast<dwio::common::CacheInputStream*>(input_.get())
@@ -77,9 +88,16 @@ class StripeMetadataCache {
     return {};
   }
 
+  /// Returns the bytes owned by 'this'.
+  uint64_t memoryUsage() const {
+    return sizeof(*this) + data_.size() + offsets_.size() * sizeof(uint32_t) +
+        (buffer_ ? buffer_->capacity() : 0);
+  }
+
  private:
   StripeCacheMode mode_;
   std::shared_ptr<dwio::common::DataBuffer<char>> buffer_;
+  std::string data_;
   std::unique_ptr<dwio::common::SeekableInputStream> input_;
   std::vector<uint32_t> offsets_;
 
@@ -3166,6 +3166,85 @@ TEST_F(ColumnWriterTest, IntegerDictionaryDictionaryEncodableWriterCtor) {
   testIntegerDictionaryEncodableWriterConstructor<int64_t>();
 }
 
+// Writes 'batch' as one stripe of a column with 'config' and returns the
+// encoding of the column.
+proto::ColumnEncoding_Kind writeColumnEncoding(
+    const std::shared_ptr<Config>& config,
+    const VectorPtr& batch) {
+  WriterContext context{config, memory::memoryManager()->addRootPool()};
+  context.initBuffer();
+  auto typeWithId = TypeWithId::create(batch->type(), 1);
+  auto columnWriter = BaseColumnWriter::create(context, *typeWithId);
+  columnWriter->write(batch, common::Ranges::of(0, batch->size()));
+  columnWriter->createIndexEntry();
+  proto::StripeFooter stripeFooter;
+  columnWriter->flush(
+      [&stripeFooter](uint32_t /* unused */) -> proto::ColumnEncoding& {
+        return *stripeFooter.add_encoding();
+      });
+  for (const auto& encoding : stripeFooter.encoding()) {
+    if (encoding.node() == 1) {
+      return encoding.kind();
+    }
+  }
+  VELOX_FAIL("No encoding for the column");
+}
+
+TEST_F(ColumnWriterTest, dictionaryEncodingDecision) {
+  const vector_size_t kSize = 10'000;
+  auto distinctInts =
+      BaseVector::create<FlatVector<int64_t>>(BIGINT(), kSize, pool_.get());
+  auto repeatedInts =
+      BaseVector::create<FlatVector<int64_t>>(BIGINT(), kSize, pool_.get());
+  auto distinctStrings =
+      BaseVector::create<FlatVector<StringView>>(VARCHAR(), kSize, pool_.get());
+  auto repeatedStrings =
+      BaseVector::create<FlatVector<StringView>>(VARCHAR(), kSize, pool_.get());
+  for (auto i = 0; i < kSize; ++i) {
+    distinctInts->set(i, i * 7);
+    repeatedInts->set(i, i % 10);
+    distinctStrings->set(
+        i, StringView(fmt::format("distinct string value {}", i)));
+    repeatedStrings->set(
+        i, StringView(fmt::format("repeated string value {}", i % 10)));
+  }
+
+  // The sample of the first batch decides the encoding before the dictionary
+  // is built.
+  auto config = std::make_shared<Config>();
+  config->set(Config::DICTIONARY_SAMPLE_ROWS, 1'000u);
+  EXPECT_EQ(
+      writeColumnEncoding(config, distinctInts),
+      proto::ColumnEncoding_Kind_DIRECT);
+  EXPECT_EQ(
+      writeColumnEncoding(config, repeatedInts),
+      proto::ColumnEncoding_Kind_DICTIONARY);
+  EXPECT_EQ(
+      writeColumnEncoding(config, distinctStrings),
+      proto::ColumnEncoding_Kind_DIRECT);
+  EXPECT_EQ(
+      writeColumnEncoding(config, repeatedStrings),
+      proto::ColumnEncoding_Kind_DICTIONARY);
+
+  // A dictionary that would be kept at flush is abandoned when it grows over
+  // the memory limit of the column.
+  config = std::make_shared<Config>();
+  config->set(Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD, 1.0f);
+  EXPECT_EQ(
+      writeColumnEncoding(config, distinctInts),
+      proto::ColumnEncoding_Kind_DICTIONARY);
+  config->set(Config::DICTIONARY_MAX_COLUMN_MEMORY, uint64_t{64 << 10});
+  EXPECT_EQ(
+      writeColumnEncoding(config, distinctInts),
+      proto::ColumnEncoding_Kind_DIRECT);
+  EXPECT_EQ(
+      writeColumnEncoding(config, distinctStrings),
+      proto::ColumnEncoding_Kind_DIRECT);
+  EXPECT_EQ(
+      writeColumnEncoding(config, repeatedInts),
+      proto::ColumnEncoding_Kind_DICTIONARY);
+}
+
 std::string
 generateSomewhatRandomStringData(size_t /*unused*/, size_t i, size_t size) {
   return folly::to<std::string>(generateSomewhatRandomData(i, size, 0, 0));
@@ -17,12 +17,15 @@
 #include "velox/dwio/dwrf/common/Compression.h"
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/compression/AsyncDecompressor.h"
 #include "velox/dwio/common/encryption/TestProvider.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
+#include <zstd.h>
 #include "velox/common/compression/Compression.h"
 
 #include <algorithm>
@@ -81,7 +84,8 @@ void decompressAndVerify(
     const char* data,
     size_t size,
     MemoryPool& pool,
-    const Decrypter* decrypter) {
+    const Decrypter* decrypter,
+    std::shared_ptr<const ZstdDictionaries> dictionaries = nullptr) {
   std::unique_ptr<SeekableInputStream> inputStream(
       new SeekableArrayInputStream(memSink.data(), memSink.size()));
 
@@ -91,7 +95,8 @@ void decompressAndVerify(
       blockSize,
       pool,
       "Test Comrpession",
-      decrypter);
+      decrypter,
+      std::move(dictionaries));
 
   const char* decompressedBuffer;
   int32_t decompressedSize;
@@ -114,14 +119,21 @@ void compressAndVerify(
     MemoryPool& pool,
     const char* data,
     size_t dataSize,
-    const Encrypter* encrypter) {
+    const Encrypter* encrypter,
+    std::shared_ptr<ZstdDictionaryTrainer> dictionaryTrainer = nullptr) {
   TestBufferPool bufferPool(pool, block);
   DataBufferHolder holder{
       pool, block, 0, DEFAULT_PAGE_GROW_RATIO, std::addressof(sink)};
   Config config;
   config.set<uint32_t>(Config::COMPRESSION_THRESHOLD, 128);
   std::unique_ptr<BufferedOutputStream> compressStream =
-      createCompressor(kind, bufferPool, holder, config, encrypter);
+      createCompressor(
+          kind,
+          bufferPool,
+          holder,
+          config,
+          encrypter,
+          std::move(dictionaryTrainer));
 
   size_t pos = 0;
   char* compressBuffer;
@@ -475,3 +487,184 @@ TEST(CompressionOptionsTest, testCompressionOptions) {
   EXPECT_EQ(options.format.zstd.compressionLevel, 7);
   EXPECT_EQ(options.compressionThreshold, 256);
 }
+
+namespace {
+// Decompresses ZSTD on a thread pool. If 'rejectAlternate' is true, every
+// second block is rejected.
+class TestAsyncDecompressor : public compression::AsyncDecompressor {
+ public:
+  explicit TestAsyncDecompressor(bool rejectAlternate)
+      : rejectAlternate_(rejectAlternate) {}
+
+  std::string name() const override {
+    return "test";
+  }
+
+  bool supports(
+      CompressionKind kind,
+      const compression::CompressionOptions& /*options*/) const override {
+    return kind == CompressionKind_ZSTD;
+  }
+
+  folly::SemiFuture<uint64_t> submit(
+      CompressionKind /*kind*/,
+      const compression::CompressionOptions& /*options*/,
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    if (rejectAlternate_ && numSubmitted_++ % 2 == 1) {
+      return folly::makeSemiFuture<uint64_t>(
+          std::runtime_error("Queue full"));
+    }
+    return folly::via(
+               &executor_,
+               [=]() -> uint64_t {
+                 const auto length =
+                     ZSTD_decompress(dest, destLength, src, srcLength);
+                 VELOX_CHECK(!ZSTD_isError(length));
+                 return length;
+               })
+        .semi();
+  }
+
+ private:
+  const bool rejectAlternate_;
+  std::atomic<int32_t> numSubmitted_{0};
+  folly::CPUThreadPoolExecutor executor_{2};
+};
+} // namespace
+
+TEST(AsyncDecompressorTest, offload) {
+  MemoryManager::testingSetInstance({});
+  auto pool = memoryManager()->addLeafPool();
+  constexpr uint64_t kBlock = 1024;
+  constexpr size_t kDataSize = 64 * 1024;
+  std::vector<char> data(kDataSize);
+  generateRandomData(data.data(), kDataSize, true);
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+  compressAndVerify(
+      CompressionKind_ZSTD,
+      memSink,
+      kBlock,
+      *pool,
+      data.data(),
+      kDataSize,
+      nullptr);
+  auto decompress = [&]() {
+    decompressAndVerify(
+        memSink,
+        CompressionKind_ZSTD,
+        kBlock,
+        data.data(),
+        kDataSize,
+        *pool,
+        nullptr);
+  };
+
+  // Without a backend, all blocks are decompressed on CPU.
+  auto before = compression::decompressionStats();
+  decompress();
+  auto after = compression::decompressionStats();
+  ASSERT_EQ(after.numOffloaded, before.numOffloaded);
+  ASSERT_LT(before.numCpu, after.numCpu);
+  const auto numBlocks = after.numCpu - before.numCpu;
+
+  compression::registerAsyncDecompressor(
+      std::make_shared<TestAsyncDecompressor>(false));
+  before = after;
+  decompress();
+  after = compression::decompressionStats();
+  ASSERT_EQ(after.numOffloaded - before.numOffloaded, numBlocks);
+  ASSERT_EQ(after.numCpu, before.numCpu);
+  ASSERT_LT(before.offloadedBytes, after.offloadedBytes);
+
+  // Rejected blocks fall back to CPU.
+  compression::registerAsyncDecompressor(
+      std::make_shared<TestAsyncDecompressor>(true));
+  before = after;
+  decompress();
+  after = compression::decompressionStats();
+  ASSERT_EQ(after.numFallbacks - before.numFallbacks, numBlocks / 2);
+  ASSERT_EQ(after.numCpu - before.numCpu, numBlocks / 2);
+  ASSERT_EQ(after.numOffloaded - before.numOffloaded, (numBlocks + 1) / 2);
+
+  compression::registerAsyncDecompressor(nullptr);
+}
+
+TEST(ZstdDictionaryTest, trainedDictionary) {
+  MemoryManager::testingSetInstance({});
+  auto pool = memoryManager()->addLeafPool();
+  constexpr uint64_t kBlock = 1024;
+  // Records that share most of their bytes but not within a block.
+  std::string data;
+  for (auto i = 0; data.size() < 256 << 10; ++i) {
+    data += fmt::format(
+        "{{\"id\": {}, \"name\": \"customer_{}\", \"segment\": \"{}\"}}\n",
+        i * 7919 % 100'003,
+        i * 31 % 1'009,
+        i % 3 == 0 ? "AUTOMOBILE" : "HOUSEHOLD");
+  }
+  auto compress = [&](const std::shared_ptr<ZstdDictionaryTrainer>& trainer) {
+    auto sink = std::make_unique<MemorySink>(
+        DEFAULT_MEM_STREAM_SIZE, FileSink::Options{.pool = pool.get()});
+    compressAndVerify(
+        CompressionKind_ZSTD,
+        *sink,
+        kBlock,
+        *pool,
+        data.data(),
+        data.size(),
+        nullptr,
+        trainer);
+    return sink;
+  };
+  auto plain = compress(nullptr);
+
+  auto trainer = std::make_shared<ZstdDictionaryTrainer>(
+      ZstdDictionary::kMinId, 8 << 10, 128 << 10);
+  // The blocks compress without a dictionary until the trainer has enough
+  // samples.
+  auto sampled = compress(trainer);
+  auto dictionary = trainer->dictionary();
+  ASSERT_NE(dictionary, nullptr);
+  ASSERT_EQ(dictionary->id(), ZstdDictionary::kMinId);
+  auto withDictionary = compress(trainer);
+  EXPECT_LT(withDictionary->size(), plain->size());
+
+  auto dictionaries = std::make_shared<ZstdDictionaries>();
+  dictionaries->emplace(
+      dictionary->id(),
+      std::make_shared<ZstdDictionary>(dictionary->data()));
+  for (const auto* sink : {sampled.get(), withDictionary.get()}) {
+    decompressAndVerify(
+        *sink,
+        CompressionKind_ZSTD,
+        kBlock,
+        data.data(),
+        data.size(),
+        *pool,
+        nullptr,
+        dictionaries);
+  }
+  decompressAndVerify(
+      *plain,
+      CompressionKind_ZSTD,
+      kBlock,
+      data.data(),
+      data.size(),
+      *pool,
+      nullptr,
+      dictionaries);
+
+  VELOX_ASSERT_THROW(
+      decompressAndVerify(
+          *withDictionary,
+          CompressionKind_ZSTD,
+          kBlock,
+          data.data(),
+          data.size(),
+          *pool,
+          nullptr),
+      "Missing ZSTD dictionary 32768");
+}
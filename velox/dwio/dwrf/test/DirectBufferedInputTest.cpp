@@ -19,6 +19,7 @@
 #include <folly/container/F14Map.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include "velox/common/io/IoStatistics.h"
+#include "velox/common/io/IoTuner.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -186,3 +187,77 @@ TEST_F(DirectBufferedInputTest, basic) {
   // in one part.
   testLoads({{1000, 9000000}, {9010000, 1000000}}, 3);
 }
+
+TEST_F(DirectBufferedInputTest, asyncPrefetch) {
+  // The prefetches are issued with preadvAsync() and complete on
+  // 'asyncExecutor' without taking the threads of 'executor_'.
+  folly::IOThreadPoolExecutor asyncExecutor(2);
+  file_->setAsyncExecutor(&asyncExecutor);
+  makeDense(4);
+  testLoads({{100, 100}, {1000, 10000000}}, 2);
+  testLoads({{1000, 10000000}, {10001000, 1000}}, 3);
+  EXPECT_GT(file_->numAsyncIos(), 0);
+  asyncExecutor.join();
+}
+
+TEST_F(DirectBufferedInputTest, ioTunerModel) {
+  io::IoTuner::Model model;
+  ASSERT_FALSE(model.hasEstimate());
+  ASSERT_EQ(model.coalesceDistance(512 << 10), 512 << 10);
+  ASSERT_EQ(model.prefetchDepth(1 << 20, 4), 4);
+
+  // Reads of the same size do not tell latency from bandwidth.
+  for (auto i = 0; i < 100; ++i) {
+    model.recordRead(1 << 20, 20'000);
+  }
+  ASSERT_FALSE(model.hasEstimate());
+
+  // 10ms latency and 100 bytes per us.
+  for (auto i = 0; i < 100; ++i) {
+    const uint64_t bytes = (i % 10 + 1) * 100'000;
+    model.recordRead(bytes, 10'000 + bytes / 100);
+  }
+  ASSERT_TRUE(model.hasEstimate());
+  ASSERT_NEAR(model.latencyMicros(), 10'000, 100);
+  ASSERT_NEAR(model.bytesPerMicro(), 100, 1);
+  ASSERT_NEAR(model.coalesceDistance(512 << 10), 1'000'000, 10'000);
+  // A load of 20ms transfer needs one more in flight to hide the latency.
+  ASSERT_EQ(model.prefetchDepth(2'000'000, 1), 2);
+  ASSERT_EQ(model.prefetchDepth(100, 1), io::IoTuner::kMaxPrefetchDepth);
+
+  ASSERT_EQ(io::IoTuner::fileSystemClass("s3://bucket/key"), "s3");
+  ASSERT_EQ(io::IoTuner::fileSystemClass("/tmp/file"), "file");
+}
+
+TEST_F(DirectBufferedInputTest, adaptiveCoalesce) {
+  auto& tuner = io::IoTuner::instance();
+  tuner.testingClear();
+  makeDense(2);
+  // The gap is over the default distance of 512KB.
+  testLoads({{0, 100'000}, {900'000, 100'000}}, 2);
+  opts_->setAdaptiveCoalesce(true);
+  testLoads({{0, 100'000}, {900'000, 100'000}}, 2);
+  ASSERT_EQ(ioStats_->adaptiveCoalesceDistance().count(), 0);
+  tuner.testingClear();
+
+  // A file system with 10ms latency and 100 bytes per us coalesces reads up
+  // to 1MB apart.
+  auto model = tuner.model(file_->getName());
+  for (auto i = 0; i < 100; ++i) {
+    const uint64_t bytes = (i % 10 + 1) * 100'000;
+    model->recordRead(bytes, 10'000 + bytes / 100);
+  }
+  testLoads({{0, 100'000}, {900'000, 100'000}}, 1);
+  ASSERT_EQ(ioStats_->adaptiveCoalesceDistance().count(), 1);
+  ASSERT_NEAR(ioStats_->adaptiveCoalesceDistance().max(), 1'000'000, 10'000);
+  ASSERT_GT(ioStats_->adaptivePrefetchDepth().max(), 1);
+
+  // Many loads are prefetched a few at a time.
+  std::vector<TestRegion> regions;
+  for (auto i = 0; i < 20; ++i) {
+    regions.push_back({i * 5'000'000, 100'000});
+  }
+  makeDense(regions.size());
+  testLoads(regions, regions.size());
+  tuner.testingClear();
+}
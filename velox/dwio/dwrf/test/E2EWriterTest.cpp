@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -855,6 +856,106 @@ TEST_F(E2EWriterTest, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTest, zstdDictionaries) {
+  auto type = ROW({"id", "name"}, {BIGINT(), VARCHAR()});
+  std::vector<VectorPtr> batches;
+  for (auto batch = 0; batch < 4; ++batch) {
+    const size_t size = 10'000;
+    auto ids = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), size, leafPool_.get());
+    auto names = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), size, leafPool_.get());
+    for (auto i = 0; i < size; ++i) {
+      const auto row = batch * size + i;
+      ids->set(i, row * 7'919 % 1'000'003);
+      const auto name = fmt::format(
+          "customer_{}_{}", row % 3 == 0 ? "AUTOMOBILE" : "HOUSEHOLD", row);
+      names->set(i, StringView(name));
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        type,
+        nullptr,
+        size,
+        std::vector<VectorPtr>{ids, names}));
+  }
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(
+      dwrf::Config::COMPRESSION, facebook::velox::common::CompressionKind_ZSTD);
+  config->set<uint64_t>(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1024);
+  config->set<uint32_t>(dwrf::Config::ZSTD_DICTIONARY_SIZE, 8 << 10);
+  config->set<uint64_t>(dwrf::Config::ZSTD_DICTIONARY_SAMPLE_SIZE, 64 << 10);
+  dwrf::E2EWriterTestUtil::testWriter(*leafPool_, type, batches, 1, 1, config);
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  dwrf::E2EWriterTestUtil::writeData(std::move(sink), type, batches, config);
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(*sinkPtr, readerOpts);
+  ASSERT_GT(reader->getFooter().zstdDictionariesSize(), 0);
+}
+
+TEST_F(E2EWriterTest, parallelEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "bool_val:boolean,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "array_val:array<float>,"
+      "map_val:map<int,double>,"
+      "flat_map_val:map<bigint,string>,"
+      "struct_val:struct<a:float,b:string>"
+      ">");
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 1'000, *leafPool_, nullptr, i));
+  }
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {7});
+  config->set<uint64_t>(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1024);
+  config->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 256 << 10);
+
+  auto write = [&](std::shared_ptr<folly::Executor> executor) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    options.encodingParallelismFactor = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  // The file is the same as when the columns are encoded serially.
+  const auto expected = write(nullptr);
+  const auto actual = write(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  ASSERT_EQ(expected, actual);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  dwrf::DwrfReader reader(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(actual), *leafPool_));
+  ASSERT_GT(reader.getFooter().stripesSize(), 1);
+}
+
 TEST_F(E2EWriterTest, OversizeRows) {
   auto pool = facebook::velox::memory::memoryManager()->addLeafPool();
 
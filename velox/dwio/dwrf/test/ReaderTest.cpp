@@ -2768,6 +2768,64 @@ TEST_F(TestReader, failToReuseReaderNulls) {
   }
 }
 
+TEST_F(TestReader, dictionaryFilterNoHits) {
+  // Each batch is a stripe with its own dictionaries. No entry of the
+  // dictionaries of the first stripe passes the filters below.
+  std::vector<VectorPtr> batches;
+  for (auto stripe = 0; stripe < 2; ++stripe) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<std::string>(
+            1'000,
+            [&](auto row) {
+              return fmt::format("s{}", stripe * 10 + row % 5);
+            },
+            nullEvery(7)),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return stripe * 10 + row % 5; }),
+    }));
+  }
+  auto schema = asRowType(batches[0]->type());
+  auto [writer, reader] = createWriterReader(batches, pool());
+  ASSERT_EQ(reader->getNumberOfStripes(), 2);
+
+  auto test = [&](const std::string& column,
+                  std::unique_ptr<common::Filter> filter,
+                  vector_size_t expectedNumRows) {
+    SCOPED_TRACE(column);
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*schema);
+    spec->childByName(column)->setFilter(std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(schema, 0, pool());
+    vector_size_t numRows = 0;
+    while (rowReader->next(300, result) > 0) {
+      auto* rowVector = result->asUnchecked<RowVector>();
+      auto* c1 = rowVector->childAt(1)->asFlatVector<int64_t>();
+      for (auto i = 0; i < rowVector->size(); ++i) {
+        ASSERT_EQ(c1->valueAt(i), 11);
+      }
+      numRows += result->size();
+    }
+    ASSERT_EQ(numRows, expectedNumRows);
+  };
+  vector_size_t numNonNullHits = 0;
+  for (auto row = 0; row < 1'000; ++row) {
+    numNonNullHits += row % 5 == 1 && row % 7 != 0;
+  }
+  test(
+      "c0",
+      std::make_unique<common::BytesValues>(
+          std::vector<std::string>{"s11", "s42"}, false),
+      numNonNullHits);
+  test(
+      "c1",
+      std::make_unique<common::BigintValuesUsingHashTable>(
+          11, 42, std::vector<int64_t>{11, 42}, false),
+      200);
+}
+
 TEST_F(TestReader, readFlatMapsSomeEmpty) {
   // Test reading a flat map where the key filter means that some maps are
   // empty.
@@ -3025,6 +3083,50 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
 }
 
+TEST_F(TestReader, readRunsAsDictionary) {
+  // 'c0' has runs of 100 equal values, with a run of nulls every 5 runs.
+  // 'c1' has no runs.
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(
+          1'000,
+          [](auto row) { return row / 100; },
+          [](auto row) { return row / 100 % 5 == 4; }),
+      makeFlatVector<int64_t>(1'000, folly::identity),
+  });
+  auto [writer, reader] = createWriterReader({batch}, pool());
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  for (auto& child : spec->children()) {
+    child->setMinDictionaryRunLength(2);
+  }
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto actual = BaseVector::create(rowType, 0, pool());
+  ASSERT_EQ(rowReader->next(1'000, actual), 1'000);
+  auto* c0 = actual->as<RowVector>()->childAt(0)->loadedVector();
+  ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(c0->valueVector()->size(), 10);
+  auto* c1 = actual->as<RowVector>()->childAt(1)->loadedVector();
+  ASSERT_TRUE(c1->isFlatEncoding());
+  assertEqualVectors(batch, actual);
+
+  // The runs of the rows that pass a filter are encoded.
+  spec->childByName("c1")->setFilter(
+      common::createBigintValues({1, 2, 3, 650, 651}, false));
+  spec->resetCachedValues(true);
+  rowReader = reader->createRowReader(rowReaderOpts);
+  ASSERT_EQ(rowReader->next(1'000, actual), 1'000);
+  ASSERT_EQ(actual->size(), 5);
+  c0 = actual->as<RowVector>()->childAt(0)->loadedVector();
+  ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(c0->valueVector()->size(), 2);
+  assertEqualVectors(
+      makeFlatVector<int64_t>({0, 0, 0, 6, 6}),
+      actual->as<RowVector>()->childAt(0));
+}
+
 // A primitive subfield is missing in file, and result is not reused.
 TEST_F(TestReader, missingSubfieldsNoResultReusing) {
   constexpr int kSize = 10;
@@ -3104,3 +3206,40 @@ TEST_F(TestReader, selectiveStringDirect) {
   });
   assertEqualVectors(expected, actual);
 }
+
+TEST_F(TestReader, fileMetadataCache) {
+  cache::FileMetadataCache metadataCache(1 << 20);
+  dwio::common::ReaderOptions readerOpts{pool()};
+  readerOpts.setFileMetadataCache(&metadataCache, "fm_small.orc@1");
+  auto read = [&](VectorPtr& batch) {
+    auto reader = DwrfReader::create(
+        createFileBufferedInput(getFMSmallFile(), readerOpts.getMemoryPool()),
+        readerOpts);
+    auto rowReader = reader->createRowReader(RowReaderOptions{});
+    rowReader->next(1'000, batch);
+    return reader;
+  };
+
+  VectorPtr expected;
+  auto first = read(expected);
+  ASSERT_EQ(metadataCache.stats().numMisses, 1);
+  ASSERT_EQ(metadataCache.stats().numEntries, 1);
+  ASSERT_GT(metadataCache.stats().curBytes, 0);
+
+  // The second reader shares the footer of the first.
+  VectorPtr actual;
+  auto second = read(actual);
+  ASSERT_EQ(metadataCache.stats().numHits, 1);
+  ASSERT_EQ(
+      first->getFooter().rawProtoPtr(), second->getFooter().rawProtoPtr());
+  ASSERT_EQ(first->numberOfRows(), second->numberOfRows());
+  assertEqualVectors(expected, actual);
+
+  // The footer outlives its eviction from the cache.
+  first.reset();
+  metadataCache.clear();
+  ASSERT_EQ(second->getFooter().stripesSize(), 4);
+  read(actual);
+  assertEqualVectors(expected, actual);
+  ASSERT_EQ(metadataCache.stats().numMisses, 2);
+}
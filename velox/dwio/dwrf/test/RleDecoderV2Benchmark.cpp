@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+constexpr int32_t kNumValues = 1'000'000;
+constexpr int32_t kRunLength = 512;
+
+// Returns DIRECT runs of kNumValues values of 'width' bits, 'width' <= 24.
+std::vector<unsigned char> encodeDirect(int32_t width) {
+  std::vector<unsigned char> bytes;
+  const uint64_t mask = (1ULL << width) - 1;
+  for (auto run = 0; run < kNumValues / kRunLength; ++run) {
+    bytes.push_back((1 << 6) | ((width - 1) << 1) | ((kRunLength - 1) >> 8));
+    bytes.push_back((kRunLength - 1) & 0xff);
+    uint64_t bits = 0;
+    int32_t numBits = 0;
+    for (auto i = 0; i < kRunLength; ++i) {
+      bits = (bits << width) | ((i * 0x9E3779B97F4A7C15ULL) & mask);
+      numBits += width;
+      while (numBits >= 8) {
+        numBits -= 8;
+        bytes.push_back(bits >> numBits);
+      }
+    }
+    if (numBits > 0) {
+      bytes.push_back(bits << (8 - numBits));
+    }
+  }
+  return bytes;
+}
+
+std::unique_ptr<dwio::common::IntDecoder<false>> makeDecoder(
+    const std::vector<unsigned char>& bytes,
+    memory::MemoryPool& pool) {
+  return createRleDecoder<false>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          bytes.data(), bytes.size()),
+      RleVersion_2,
+      pool,
+      true,
+      dwio::common::INT_BYTE_SIZE);
+}
+
+// Decodes with next() in batches of 'batchSize' values.
+void decode(int32_t width, int32_t batchSize) {
+  std::vector<unsigned char> bytes;
+  std::shared_ptr<memory::MemoryPool> pool;
+  BENCHMARK_SUSPEND {
+    bytes = encodeDirect(width);
+    pool = memory::memoryManager()->addLeafPool();
+  }
+  auto decoder = makeDecoder(bytes, *pool);
+  std::vector<int64_t> values(batchSize);
+  for (auto i = 0; i < kNumValues; i += batchSize) {
+    decoder->next(values.data(), batchSize, nullptr);
+  }
+  folly::doNotOptimizeAway(values);
+}
+
+} // namespace
+
+BENCHMARK(width7Batch1) {
+  decode(7, 1);
+}
+
+BENCHMARK_RELATIVE(width7Batch1000) {
+  decode(7, 1'000);
+}
+
+BENCHMARK(width17Batch1) {
+  decode(17, 1);
+}
+
+BENCHMARK_RELATIVE(width17Batch1000) {
+  decode(17, 1'000);
+}
+
+BENCHMARK(width24Batch1) {
+  decode(24, 1);
+}
+
+BENCHMARK_RELATIVE(width24Batch1000) {
+  decode(24, 1'000);
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  folly::runBenchmarks();
+  return 0;
+}
@@ -3925,6 +3925,52 @@ TEST_P(TestColumnReader, testDecimal64) {
   }
 }
 
+TEST_P(TestColumnReader, testDecimal64WithFilter) {
+  if (!useSelectiveReader()) {
+    return;
+  }
+  proto::ColumnEncoding directEncoding;
+  directEncoding.set_kind(proto::ColumnEncoding_Kind_DIRECT);
+  EXPECT_CALL(streams_, getEncodingProxy(_))
+      .WillRepeatedly(Return(&directEncoding));
+  EXPECT_CALL(streams_, getStreamProxy(_, proto::Stream_Kind_ROW_INDEX, false))
+      .WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(streams_, getStreamProxy(_, proto::Stream_Kind_PRESENT, false))
+      .WillRepeatedly(Return(nullptr));
+  // Zigzag varints of -32 to 31.
+  char numBuffer[65];
+  for (int i = 0; i < 65; ++i) {
+    if (i < 32) {
+      numBuffer[i] = static_cast<char>(0x3f - 2 * i);
+    } else {
+      numBuffer[i] = static_cast<char>(2 * (i - 32));
+    }
+  }
+  EXPECT_CALL(streams_, getStreamProxy(1, proto::Stream_Kind_DATA, true))
+      .WillRepeatedly(Return(new SeekableArrayInputStream(
+          numBuffer, VELOX_ARRAY_SIZE(numBuffer), 3)));
+  const unsigned char buffer2[] = {0x3e, 0x00, 0x04}; // [0x02] * 65
+  EXPECT_CALL(streams_, getStreamProxy(1, proto::Stream_Kind_NANO_DATA, true))
+      .WillRepeatedly(Return(
+          new SeekableArrayInputStream(buffer2, VELOX_ARRAY_SIZE(buffer2))));
+
+  auto rowType = HiveTypeParser().parse("struct<col_0:decimal(12, 2)>");
+  auto scanSpec = std::make_unique<common::ScanSpec>("root");
+  scanSpec->addAllChildFields(*rowType);
+  scanSpec->childByName("col_0")->setFilter(
+      std::make_unique<common::BigintRange>(-5, 10, false));
+  buildReader(rowType, nullptr, {}, scanSpec.get());
+  VectorPtr batch = newBatch(rowType);
+  selectiveColumnReader_->next(64, batch, nullptr);
+
+  auto intBatch = getOnlyChild<FlatVector<int64_t>>(batch);
+  ASSERT_EQ(16, batch->size());
+  ASSERT_EQ(0, getNullCount(intBatch));
+  for (int64_t i = 0; i < 16; ++i) {
+    ASSERT_EQ(i - 5, intBatch->valueAt(i));
+  }
+}
+
 TEST_P(TestColumnReader, testDecimal64WithSkip) {
   // set getEncoding
   proto::ColumnEncoding directEncoding;
@@ -57,6 +57,27 @@ class TestReadFile : public velox::ReadFile {
     return res;
   }
 
+  // Makes preadvAsync() run preadv() on 'executor', so that the reads
+  // complete on another thread as with a native asynchronous implementation.
+  void setAsyncExecutor(folly::Executor* executor) {
+    asyncExecutor_ = executor;
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    VELOX_CHECK_NOT_NULL(asyncExecutor_);
+    ++numAsyncIos_;
+    return folly::via(
+               asyncExecutor_,
+               [this, offset, buffers]() { return preadv(offset, buffers); })
+        .semi();
+  }
+
+  bool hasPreadvAsync() const override {
+    return asyncExecutor_ != nullptr;
+  }
+
   // Asserts that 'bytes' is as would be read from 'offset'.
   void checkData(const void* bytes, uint64_t offset, int32_t size) {
     for (auto i = 0; i < size; ++i) {
@@ -78,6 +99,10 @@ class TestReadFile : public velox::ReadFile {
     return numIos_;
   }
 
+  int64_t numAsyncIos() const {
+    return numAsyncIos_;
+  }
+
   std::string getName() const override {
     return "<TestReadFile>";
   }
@@ -90,7 +115,9 @@ class TestReadFile : public velox::ReadFile {
   const uint64_t seed_;
   const uint64_t length_;
   std::shared_ptr<io::IoStatistics> ioStats_;
+  folly::Executor* asyncExecutor_{nullptr};
   mutable std::atomic<int64_t> numIos_{0};
+  mutable std::atomic<int64_t> numAsyncIos_{0};
 };
 
 } // namespace facebook::velox::dwio::common
@@ -673,6 +673,80 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+// Bit widths of DIRECT runs in the order of their encoding.
+const std::vector<int32_t> kDirectWidths = {
+    1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+    17, 18, 19, 20, 21, 22, 23, 24, 26, 28, 30, 32, 40, 48, 56, 64};
+
+// Appends a DIRECT run of 'values' bit-packed in 'width' bits.
+void appendDirectRun(
+    const std::vector<uint64_t>& values,
+    int32_t width,
+    std::vector<unsigned char>& bytes) {
+  const auto code =
+      std::find(kDirectWidths.begin(), kDirectWidths.end(), width) -
+      kDirectWidths.begin();
+  const auto length = values.size() - 1;
+  bytes.push_back((1 << 6) | (code << 1) | (length >> 8));
+  bytes.push_back(length & 0xff);
+  uint32_t byte = 0;
+  int32_t numBits = 0;
+  for (auto value : values) {
+    for (auto i = width - 1; i >= 0; --i) {
+      byte = (byte << 1) | ((value >> i) & 1);
+      if (++numBits == 8) {
+        bytes.push_back(byte);
+        byte = 0;
+        numBits = 0;
+      }
+    }
+  }
+  if (numBits > 0) {
+    bytes.push_back(byte << (8 - numBits));
+  }
+}
+
+TEST_F(RLEv2Test, directAllWidths) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  for (auto width : kDirectWidths) {
+    SCOPED_TRACE(width);
+    const uint64_t mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+    std::vector<unsigned char> bytes;
+    std::vector<int64_t> expected;
+    for (auto runLength : {512, 77, 1, 300}) {
+      std::vector<uint64_t> values(runLength);
+      for (auto i = 0; i < runLength; ++i) {
+        values[i] = (expected.size() * 0x9E3779B97F4A7C15ULL + i) & mask;
+        expected.push_back(static_cast<int64_t>(values[i]));
+      }
+      appendDirectRun(values, width, bytes);
+    }
+
+    // Reads in batches that end in the middle of bytes, from a stream whose
+    // buffers end in the middle of values.
+    for (auto blockSize : {0, 13}) {
+      for (auto batchSize : {1, 3, 7, static_cast<int32_t>(expected.size())}) {
+        auto decoder = createRleDecoder<false>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                bytes.data(), bytes.size(), blockSize),
+            RleVersion_2,
+            *pool,
+            true /* doesn't matter */,
+            dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+        std::vector<int64_t> actual(expected.size());
+        for (auto i = 0; i < expected.size(); i += batchSize) {
+          decoder->next(
+              actual.data() + i,
+              std::min<int32_t>(batchSize, expected.size() - i),
+              nullptr);
+        }
+        ASSERT_EQ(expected, actual)
+            << "blockSize=" << blockSize << ", batchSize=" << batchSize;
+      }
+    }
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -277,6 +277,28 @@ TEST_F(StripeStreamTest, zeroLength) {
   }
 }
 
+TEST_F(StripeStreamTest, metadataCacheOwnedData) {
+  google::protobuf::Arena arena;
+  auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(&arena);
+  footer->add_stripecacheoffsets(0);
+  footer->add_stripecacheoffsets(3);
+  footer->add_stripecacheoffsets(7);
+
+  // The data is not allocated from a pool, so that the cache can outlive the
+  // pools of the readers that share it.
+  StripeMetadataCache cache(
+      StripeCacheMode::INDEX, FooterWrapper(footer), std::string("abcdefg"));
+  ASSERT_TRUE(cache.has(StripeCacheMode::INDEX, 1));
+  ASSERT_FALSE(cache.has(StripeCacheMode::INDEX, 2));
+  ASSERT_FALSE(cache.has(StripeCacheMode::FOOTER, 0));
+  ASSERT_GE(cache.memoryUsage(), 7u);
+  auto stream = cache.get(StripeCacheMode::INDEX, 1);
+  const void* data;
+  int32_t size;
+  ASSERT_TRUE(stream->Next(&data, &size));
+  EXPECT_EQ(std::string(static_cast<const char*>(data), size), "defg");
+}
+
 TEST_F(StripeStreamTest, planReadsIndex) {
   google::protobuf::Arena arena;
 
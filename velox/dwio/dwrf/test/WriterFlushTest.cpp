@@ -137,7 +137,9 @@ class MockMemoryPool : public velox::memory::MemoryPool {
   void allocateContiguous(
       velox::memory::MachinePageCount /*unused*/,
       velox::memory::ContiguousAllocation& /*unused*/,
-      velox::memory::MachinePageCount /*unused*/ = 0) override {
+      velox::memory::MachinePageCount /*unused*/ = 0,
+      velox::memory::HugePagePolicy /*unused*/ =
+          velox::memory::HugePagePolicy::kDefault) override {
     VELOX_UNSUPPORTED("allocateContiguous unsupported");
   }
 
@@ -15,10 +15,12 @@
  */
 
 #include "velox/dwio/dwrf/writer/WriterSink.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "folly/Random.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
 
 using namespace ::testing;
 using namespace facebook::velox::dwio::common;
@@ -511,3 +513,41 @@ TEST_F(WriterSinkTest, SetModeOutOfOrder) {
   sink.addBuffer(*pool, data.data(), 10);
   ASSERT_EQ(sink.getChecksum()->getDigest(false), 977966233);
 }
+
+TEST_F(WriterSinkTest, asyncFlush) {
+  auto pool = memoryManager()->addLeafPool();
+  Config config;
+  config.set(Config::CHECKSUM_ALGORITHM, proto::ChecksumAlgorithm::NULL_);
+  config.set(Config::STRIPE_CACHE_MODE, StripeCacheMode::NA);
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  constexpr int32_t kNumFlushes = 20;
+  for (uint32_t maxPending : {0, 1, 3}) {
+    SCOPED_TRACE(fmt::format("maxPending: {}", maxPending));
+    std::string file;
+    WriteFileSink out{std::make_unique<InMemoryWriteFile>(&file), "test"};
+    {
+      WriterSink sink{out, *pool, config};
+      sink.setFlushExecutor(executor, maxPending);
+      sink.init(*pool);
+      for (auto i = 0; i < kNumFlushes; ++i) {
+        sink.addBuffer(*pool, data.data(), data.size());
+        sink.addBuffer(*pool, data.data(), i);
+        sink.flush();
+        ASSERT_EQ(
+            sink.size(),
+            ORC_MAGIC_LEN + (i + 1) * data.size() + i * (i + 1) / 2);
+      }
+      sink.finishFlushes();
+      ASSERT_EQ(sink.pendingFlushBytes(), 0);
+      ASSERT_EQ(out.size(), sink.size());
+      // Nothing is written after the last flush.
+      sink.finishFlushes();
+    }
+    std::string expected(ORC_MAGIC.data(), ORC_MAGIC_LEN);
+    for (auto i = 0; i < kNumFlushes; ++i) {
+      expected.append(data.data(), data.size());
+      expected.append(data.data(), i);
+    }
+    ASSERT_EQ(file, expected);
+  }
+}
@@ -17,8 +17,10 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
+#include "velox/dwio/dwrf/writer/DictionarySampler.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
 #include "velox/dwio/dwrf/writer/FlatMapColumnWriter.h"
 #include "velox/dwio/dwrf/writer/IntegerDictionaryEncoder.h"
@@ -27,6 +29,9 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/FlatVector.h"
 
+#include <deque>
+#include <numeric>
+
 using namespace facebook::velox::dwio::common;
 using namespace facebook::velox::memory;
 
@@ -35,7 +40,11 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // The shared vector is not used when the columns are written in parallel.
+  std::optional<SelectivityVector> localSelected;
+  auto& selected = context_.encodingExecutor() == nullptr
+      ? context_.getSharedSelectivityVector(slice->size())
+      : localSelected.emplace(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -210,7 +219,9 @@ class IntegerColumnWriter : public BaseColumnWriter {
             getConfig(Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
-        strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
+        strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)},
+        dictionarySampleRows_{getConfig(Config::DICTIONARY_SAMPLE_ROWS)},
+        maxDictionaryMemory_{getConfig(Config::DICTIONARY_MAX_COLUMN_MEMORY)} {
     DWIO_ENSURE_GE(dictionaryKeySizeThreshold_, 0.0);
     DWIO_ENSURE_LE(dictionaryKeySizeThreshold_, 1.0);
     DWIO_ENSURE(firstStripe_);
@@ -368,6 +379,34 @@ class IntegerColumnWriter : public BaseColumnWriter {
 
   uint64_t writeDirect(const VectorPtr& slice, const common::Ranges& ranges);
 
+  // Switches to direct encoding before building the dictionary if the values
+  // sampled from the first batch are mostly distinct.
+  void sampleDictionary(const VectorPtr& slice, const common::Ranges& ranges) {
+    const auto sampleRows = dictionarySampleRows_;
+    dictionarySampleRows_ = 0;
+    auto localDecoded = decode(slice, ranges);
+    const auto distinctFraction =
+        DictionarySampler::estimateDistinctFraction<T>(
+            localDecoded.get(),
+            ranges,
+            sampleRows,
+            getMemoryPool(MemoryUsageCategory::GENERAL));
+    if (distinctFraction.has_value() &&
+        distinctFraction.value() > dictionaryKeySizeThreshold_) {
+      tryAbandonDictionaries(true);
+    }
+  }
+
+  // Switches to direct encoding in the first stripe when the dictionary
+  // grows over the memory limit of the column. The rows written so far are
+  // converted to direct encoding from the buffered dictionary indices.
+  void abandonDictionaryAboveMemoryLimit() {
+    if (maxDictionaryMemory_ > 0 &&
+        dictEncoder_.memoryUsage() > maxDictionaryMemory_) {
+      tryAbandonDictionaries(true);
+    }
+  }
+
   void ensureValidStreamWriters(bool dictEncoding) {
     // Ensure we have valid streams for exactly one encoding.
     DWIO_ENSURE(
@@ -468,17 +507,26 @@ class IntegerColumnWriter : public BaseColumnWriter {
   bool useDictionaryEncoding_;
   bool firstStripe_{true};
   DataBuffer<size_t> strideOffsets_;
+  // Values of the first batch to sample for the encoding decision. Reset to
+  // 0 after the first batch.
+  uint32_t dictionarySampleRows_;
+  const uint64_t maxDictionaryMemory_;
 };
 
 template <typename T>
 uint64_t IntegerColumnWriter<T>::write(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
+  if (useDictionaryEncoding_ && dictionarySampleRows_ > 0) {
+    sampleDictionary(slice, ranges);
+  }
   if (useDictionaryEncoding_) {
     // Decode and then write
     auto localDecoded = decode(slice, ranges);
     auto& decodedVector = localDecoded.get();
-    return writeDict(decodedVector, ranges);
+    auto rawSize = writeDict(decodedVector, ranges);
+    abandonDictionaryAboveMemoryLimit();
+    return rawSize;
   } else {
     // If the input is not a flat vector we make a complete copy and convert
     // it to flat vector
@@ -805,7 +853,9 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
-        strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
+        strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)},
+        dictionarySampleRows_{getConfig(Config::DICTIONARY_SAMPLE_ROWS)},
+        maxDictionaryMemory_{getConfig(Config::DICTIONARY_MAX_COLUMN_MEMORY)} {
     DWIO_ENSURE(firstStripe_);
     if (!useDictionaryEncoding_) {
       initStreamWriters(useDictionaryEncoding_);
@@ -968,6 +1018,36 @@ class StringColumnWriter : public BaseColumnWriter {
       DecodedVector& decodedVector,
       const common::Ranges& ranges);
 
+  // Switches to direct encoding before building the dictionary if the values
+  // sampled from the first batch are mostly distinct.
+  void sampleDictionary(
+      const DecodedVector& decodedVector,
+      const common::Ranges& ranges) {
+    const auto sampleRows = dictionarySampleRows_;
+    dictionarySampleRows_ = 0;
+    const auto distinctFraction =
+        DictionarySampler::estimateDistinctFraction<StringView>(
+            decodedVector,
+            ranges,
+            sampleRows,
+            getMemoryPool(MemoryUsageCategory::GENERAL));
+    if (distinctFraction.has_value() &&
+        distinctFraction.value() >
+            getConfig(Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD)) {
+      tryAbandonDictionaries(true);
+    }
+  }
+
+  // Switches to direct encoding in the first stripe when the dictionary
+  // grows over the memory limit of the column. The rows written so far are
+  // converted to direct encoding from the buffered dictionary indices.
+  void abandonDictionaryAboveMemoryLimit() {
+    if (maxDictionaryMemory_ > 0 &&
+        dictEncoder_.memoryUsage() > maxDictionaryMemory_) {
+      tryAbandonDictionaries(true);
+    }
+  }
+
   void ensureValidStreamWriters(bool dictEncoding) {
     // Ensure we have exactly one valid data stream.
     DWIO_ENSURE(
@@ -1084,6 +1164,10 @@ class StringColumnWriter : public BaseColumnWriter {
   bool useDictionaryEncoding_;
   bool firstStripe_{true};
   DataBuffer<size_t> strideOffsets_;
+  // Values of the first batch to sample for the encoding decision. Reset to
+  // 0 after the first batch.
+  uint32_t dictionarySampleRows_;
+  const uint64_t maxDictionaryMemory_;
 };
 
 uint64_t StringColumnWriter::write(
@@ -1091,9 +1175,14 @@ uint64_t StringColumnWriter::write(
     const common::Ranges& ranges) {
   auto localDecoded = decode(slice, ranges);
   auto& decodedVector = localDecoded.get();
+  if (useDictionaryEncoding_ && dictionarySampleRows_ > 0) {
+    sampleDictionary(decodedVector, ranges);
+  }
 
   if (useDictionaryEncoding_) {
-    return writeDict(decodedVector, ranges);
+    auto rawSize = writeDict(decodedVector, ranges);
+    abandonDictionaryAboveMemoryLimit();
+    return rawSize;
   } else {
     return writeDirect(decodedVector, ranges);
   }
@@ -1607,26 +1696,94 @@ class StructColumnWriter : public BaseColumnWriter {
 
   void flush(
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
-      std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
-    BaseColumnWriter::flush(encodingFactory, encodingOverride);
-    for (auto& c : children_) {
-      c->flush(encodingFactory);
-    }
-  }
+      std::function<void(proto::ColumnEncoding&)> encodingOverride) override;
 
  private:
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  // True if the children of the root are written and flushed on the
+  // encoding executor of the context.
+  bool parallelChildren() const {
+    return isRoot() && context_.encodingExecutor() != nullptr &&
+        children_.size() > 1;
+  }
+
+  // Calls 'func' with the index of each child. The children run in parallel
+  // on the encoding executor, except for those that add streams on write or
+  // are encrypted, which run on the calling thread after the others.
+  void forEachChildInParallel(const std::function<void(size_t)>& func);
 };
 
+void StructColumnWriter::forEachChildInParallel(
+    const std::function<void(size_t)>& func) {
+  const auto& handler = context_.getEncryptionHandler();
+  std::vector<size_t> parallel;
+  std::vector<size_t> serial;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    const auto& child = *children_[i];
+    if (child.addsStreamsOnWrite() ||
+        handler.isEncrypted(child.getType().id())) {
+      serial.push_back(i);
+    } else {
+      parallel.push_back(i);
+    }
+  }
+  dwio::common::ParallelFor(
+      context_.encodingExecutor(),
+      0,
+      parallel.size(),
+      context_.encodingParallelismFactor())
+      .execute([&](size_t i) { func(parallel[i]); });
+  for (auto i : serial) {
+    func(i);
+  }
+}
+
+void StructColumnWriter::flush(
+    std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
+    std::function<void(proto::ColumnEncoding&)> encodingOverride) {
+  BaseColumnWriter::flush(encodingFactory, encodingOverride);
+  if (!parallelChildren()) {
+    for (auto& c : children_) {
+      c->flush(encodingFactory);
+    }
+    return;
+  }
+  // The encodings of each child are collected and then added in the order of
+  // the children, so that the footer is the same as with a serial flush.
+  std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+      encodings(children_.size());
+  forEachChildInParallel([&](size_t i) {
+    children_[i]->flush(
+        [&encodings, i](uint32_t nodeId) -> proto::ColumnEncoding& {
+          return encodings[i]
+              .emplace_back(nodeId, proto::ColumnEncoding{})
+              .second;
+        });
+  });
+  for (auto& childEncodings : encodings) {
+    for (auto& [nodeId, encoding] : childEncodings) {
+      encodingFactory(nodeId) = std::move(encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
-  if (ranges.size() > 0) {
+  if (ranges.size() > 0 && parallelChildren()) {
+    std::vector<uint64_t> childRawSizes(children_.size());
+    forEachChildInParallel([&](size_t i) {
+      childRawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+    });
+    rawSize = std::accumulate(
+        childRawSizes.begin(), childRawSizes.end(), uint64_t{0});
+  } else if (ranges.size() > 0) {
     for (size_t i = 0; i < children_.size(); ++i) {
       rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
     }
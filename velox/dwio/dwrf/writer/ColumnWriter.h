@@ -147,6 +147,12 @@ class BaseColumnWriter : public ColumnWriter {
     return type_;
   }
 
+  /// True if write() may add streams to the context. Such writers are not
+  /// run in parallel with other writers.
+  virtual bool addsStreamsOnWrite() const {
+    return false;
+  }
+
   static std::unique_ptr<BaseColumnWriter> create(
       WriterContext& context,
       const dwio::common::TypeWithId& type,
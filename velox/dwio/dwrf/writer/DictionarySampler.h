@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <xxhash.h>
+#include <optional>
+
+#include "velox/common/hyperloglog/DenseHll.h"
+#include "velox/dwio/common/Range.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::dwrf {
+
+// Estimates the fraction of distinct values of a column from a sample of a
+// batch before any value is added to the dictionary, so that a column of
+// mostly distinct values can start with direct encoding instead of building
+// a dictionary that is abandoned at flush.
+class DictionarySampler {
+ public:
+  // Returns the estimated number of distinct values divided by the number of
+  // sampled values. Samples at most 'maxSamples' non-null rows evenly spaced
+  // in 'ranges'. Returns std::nullopt if fewer than half of 'maxSamples'
+  // values could be sampled, which is too few for a decision.
+  template <typename T>
+  static std::optional<float> estimateDistinctFraction(
+      const DecodedVector& decoded,
+      const common::Ranges& ranges,
+      size_t maxSamples,
+      memory::MemoryPool& pool) {
+    if (maxSamples == 0 || ranges.size() < maxSamples / 2) {
+      return std::nullopt;
+    }
+    const auto step = std::max<size_t>(1, ranges.size() / maxSamples);
+    HashStringAllocator allocator{&pool};
+    common::hll::DenseHll hll{kIndexBitLength, &allocator};
+    size_t numSamples = 0;
+    size_t index = 0;
+    for (auto pos : ranges) {
+      if (index++ % step != 0 || decoded.isNullAt(pos)) {
+        continue;
+      }
+      hll.insertHash(hash(decoded.valueAt<T>(pos)));
+      if (++numSamples == maxSamples) {
+        break;
+      }
+    }
+    if (numSamples == 0 || numSamples < maxSamples / 2) {
+      return std::nullopt;
+    }
+    return std::min(1.0f, static_cast<float>(hll.cardinality()) / numSamples);
+  }
+
+ private:
+  // 2048 buckets, about 2.3% standard error.
+  static constexpr int8_t kIndexBitLength = 11;
+
+  template <typename T>
+  static uint64_t hash(T value) {
+    return XXH64(&value, sizeof(T), 0);
+  }
+
+  static uint64_t hash(StringView value) {
+    return XXH64(value.data(), value.size(), 0);
+  }
+};
+
+} // namespace facebook::velox::dwrf
@@ -270,6 +270,11 @@ class FlatMapColumnWriter : public BaseColumnWriter {
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
                               statsFactory) const override;
 
+  // Adds the streams of new keys.
+  bool addsStreamsOnWrite() const override {
+    return true;
+  }
+
  private:
   using KeyType = typename TypeTraits<K>::NativeType;
 
@@ -163,6 +163,12 @@ class IntegerDictionaryEncoder : public AbstractIntegerDictionaryEncoder {
     return totalCount_;
   }
 
+  // Bytes held by the keys, their counts and the lookup set.
+  uint64_t memoryUsage() const {
+    return keys_.capacityInBytes() + counts_.capacityInBytes() +
+        keyIndex_.getAllocatedMemorySize();
+  }
+
   // Get key with index/encoded value.
   // Can throw out_of_range exception.
   Integer getKey(uint32_t index) const {
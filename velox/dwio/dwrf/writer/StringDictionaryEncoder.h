@@ -153,6 +153,13 @@ class StringDictionaryEncoder {
     return firstSeenStrideIndex_[index];
   }
 
+  // Bytes held by the keys, their metadata and the lookup set.
+  uint64_t memoryUsage() const {
+    return keyBytes_.capacityInBytes() + keyOffsets_.capacityInBytes() +
+        counts_.capacityInBytes() + firstSeenStrideIndex_.capacityInBytes() +
+        hash_.capacityInBytes() + keyIndex_.getAllocatedMemorySize();
+  }
+
   folly::StringPiece getKey(uint32_t index) const {
     DCHECK(index < keyOffsets_.size() - 1);
     auto startOffset = keyOffsets_[index];
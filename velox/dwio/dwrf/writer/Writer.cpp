@@ -73,6 +73,10 @@ Writer::Writer(
   writerBase_->initContext(options.config, pool, std::move(handler));
 
   auto& context = writerBase_->getContext();
+  context.setEncodingExecutor(
+      options.encodingExecutor, options.encodingParallelismFactor);
+  writerBase_->getSink().setFlushExecutor(
+      options.flushExecutor, options.maxPendingStripeFlushes);
   VELOX_CHECK_EQ(
       context.getTotalMemoryUsage(),
       0,
@@ -81,6 +85,7 @@ Writer::Writer(
   writerBase_->initBuffers();
 
   context.buildPhysicalSizeAggregators(*schema_);
+  context.initZstdDictionaries(*schema_);
   if (options.flushPolicyFactory == nullptr) {
     flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
         context.stripeSizeFlushThreshold(),
@@ -756,6 +761,8 @@ uint64_t Writer::MemoryReclaimer::reclaim(
   auto reclaimBytes = memory::MemoryReclaimer::run(
       [&]() {
         writer_->flushInternal(false);
+        // The stripe buffers are freed only after they are written.
+        writer_->writerBase_->getSink().finishFlushes();
         return pool->shrink(targetBytes);
       },
       stats);
@@ -786,6 +793,10 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.memoryPool = options.memoryPool;
   dwrfOptions.spillConfig = options.spillConfig;
   dwrfOptions.nonReclaimableSection = options.nonReclaimableSection;
+  dwrfOptions.encodingExecutor = options.encodingExecutor;
+  dwrfOptions.encodingParallelismFactor = options.encodingParallelismFactor;
+  dwrfOptions.flushExecutor = options.flushExecutor;
+  dwrfOptions.maxPendingStripeFlushes = options.maxPendingStripeFlushes;
   return dwrfOptions;
 }
 
@@ -51,6 +51,17 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set, the top-level columns are encoded and their streams compressed
+  /// in parallel on this executor. The output is the same as without it.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  /// Number of threads, including the calling thread, that encode a batch or
+  /// flush a stripe when 'encodingExecutor' is set.
+  size_t encodingParallelismFactor{0};
+  /// If set, a flushed stripe is written to the file sink on this executor
+  /// while the next stripe is encoded. The writer waits when more than
+  /// 'maxPendingStripeFlushes' stripes are being written.
+  std::shared_ptr<folly::Executor> flushExecutor;
+  uint32_t maxPendingStripeFlushes{1};
 };
 
 class Writer : public dwio::common::Writer {
@@ -53,6 +53,9 @@ void WriterBase::writeFooter(const Type& type) {
   footer_.set_checksumalgorithm(
       (checksum != nullptr) ? checksum->getType()
                             : proto::ChecksumAlgorithm::NULL_);
+  for (const auto& dictionary : context_->zstdDictionaries()) {
+    footer_.add_zstddictionaries(dictionary->data());
+  }
   writeProto(footer_);
   const auto footerLength = writerSink_->size() - pos;
 
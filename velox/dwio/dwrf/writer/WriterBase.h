@@ -34,6 +34,7 @@ class WriterBase {
   virtual void close() {
     if (writerSink_) {
       writerSink_->flush();
+      writerSink_->finishFlushes();
     }
     sink_->close();
   }
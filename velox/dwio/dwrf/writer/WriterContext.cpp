@@ -142,6 +142,51 @@ void WriterContext::releaseMemoryReservation() {
   generalPool_->release();
 }
 
+void WriterContext::initZstdDictionaries(
+    const dwio::common::TypeWithId& schema) {
+  if (compression_ != common::CompressionKind_ZSTD ||
+      getConfig(Config::ZSTD_DICTIONARY_SIZE) == 0) {
+    return;
+  }
+  zstdNodeKinds_.resize(schema.maxId() + 1);
+  std::function<void(const dwio::common::TypeWithId&)> addKinds =
+      [&](const auto& type) {
+        zstdNodeKinds_[type.id()] = type.type()->kind();
+        for (auto i = 0; i < type.size(); ++i) {
+          addKinds(*type.childAt(i));
+        }
+      };
+  addKinds(schema);
+}
+
+std::shared_ptr<ZstdDictionaryTrainer> WriterContext::zstdDictionaryTrainer(
+    const DwrfStreamIdentifier& stream) {
+  const auto node = stream.encodingKey().node();
+  if (node >= zstdNodeKinds_.size()) {
+    return nullptr;
+  }
+  auto& trainer = zstdDictionaryTrainers_[std::make_pair(
+      zstdNodeKinds_[node], stream.kind())];
+  if (trainer == nullptr) {
+    trainer = std::make_shared<ZstdDictionaryTrainer>(
+        ZstdDictionary::kMinId + zstdDictionaryTrainers_.size() - 1,
+        getConfig(Config::ZSTD_DICTIONARY_SIZE),
+        getConfig(Config::ZSTD_DICTIONARY_SAMPLE_SIZE));
+  }
+  return trainer;
+}
+
+std::vector<std::shared_ptr<const ZstdDictionary>>
+WriterContext::zstdDictionaries() const {
+  std::vector<std::shared_ptr<const ZstdDictionary>> dictionaries;
+  for (const auto& [_, trainer] : zstdDictionaryTrainers_) {
+    if (auto dictionary = trainer->dictionary()) {
+      dictionaries.push_back(std::move(dictionary));
+    }
+  }
+  return dictionaries;
+}
+
 void WriterContext::abort() {
   compressionBuffer_.reset();
   physicalSizeAggregators_.clear();
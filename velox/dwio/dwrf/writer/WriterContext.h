@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -87,7 +89,13 @@ class WriterContext : public CompressionBufferPool {
         ? std::addressof(
               handler_->getEncryptionProvider(stream.encodingKey().node()))
         : nullptr;
-    return newStream(compression_, holder, encrypter);
+    // Encrypted streams are not sampled since the dictionaries are stored in
+    // the unencrypted footer.
+    return newStream(
+        compression_,
+        holder,
+        encrypter,
+        encrypter == nullptr ? zstdDictionaryTrainer(stream) : nullptr);
   }
 
   std::unique_ptr<DataBufferHolder> newDataBufferHolder(
@@ -103,9 +111,25 @@ class WriterContext : public CompressionBufferPool {
   std::unique_ptr<BufferedOutputStream> newStream(
       common::CompressionKind kind,
       DataBufferHolder& holder,
-      const dwio::common::encryption::Encrypter* encrypter = nullptr) {
-    return createCompressor(kind, *this, holder, *config_, encrypter);
-  }
+      const dwio::common::encryption::Encrypter* encrypter = nullptr,
+      std::shared_ptr<ZstdDictionaryTrainer> dictionaryTrainer = nullptr) {
+    return createCompressor(
+        kind,
+        *this,
+        holder,
+        *config_,
+        encrypter,
+        std::move(dictionaryTrainer));
+  }
+
+  /// Enables ZSTD dictionary training for the streams of 'schema' if the
+  /// compression is ZSTD and Config::ZSTD_DICTIONARY_SIZE is set. The streams
+  /// of each combination of column type and stream kind share a dictionary.
+  void initZstdDictionaries(const dwio::common::TypeWithId& schema);
+
+  /// Returns the dictionaries trained so far. These are written to the
+  /// footer.
+  std::vector<std::shared_ptr<const ZstdDictionary>> zstdDictionaries() const;
 
   template <typename T>
   IntegerDictionaryEncoder<T>& getIntDictionaryEncoder(
@@ -249,6 +273,14 @@ class WriterContext : public CompressionBufferPool {
 
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffer_ == nullptr && encodingExecutor_ != nullptr) {
+      // Another column is compressing in parallel.
+      auto buffer = std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+      VELOX_CHECK_GE(buffer->size(), size);
+      return buffer;
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -257,10 +289,36 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffer_ != nullptr) {
+      // The extra buffer of a parallel compression is freed.
+      VELOX_CHECK_NOT_NULL(encodingExecutor_);
+      return;
+    }
     compressionBuffer_ = std::move(buffer);
   }
 
+  /// Sets the executor on which the columns are encoded and compressed in
+  /// parallel. 'parallelismFactor' is the number of threads, including the
+  /// calling thread, that work on a batch or stripe. The context is then
+  /// shared by these threads.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  /// The executor for parallel encoding or nullptr if the columns are
+  /// encoded on the calling thread.
+  folly::Executor* encodingExecutor() const {
+    return encodingExecutor_.get();
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
+  }
+
   void incrementNodeSize(uint32_t node, uint64_t size) {
     nodeSize_[node] += size;
   }
@@ -577,7 +635,13 @@ class WriterContext : public CompressionBufferPool {
  private:
   void validateConfigs() const;
 
+  // Returns the trainer shared by the streams of the type and kind of
+  // 'stream'. nullptr if ZSTD dictionaries are not trained.
+  std::shared_ptr<ZstdDictionaryTrainer> zstdDictionaryTrainer(
+      const DwrfStreamIdentifier& stream);
+
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(decodedVectorMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -587,6 +651,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(decodedVectorMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -616,6 +681,12 @@ class WriterContext : public CompressionBufferPool {
       streams_;
   folly::F14NodeMap<uint32_t, std::unique_ptr<PhysicalSizeAggregator>>
       physicalSizeAggregators_;
+  // Type of each node. Empty if ZSTD dictionaries are not trained.
+  std::vector<TypeKind> zstdNodeKinds_;
+  folly::F14FastMap<
+      std::pair<TypeKind, StreamKind>,
+      std::shared_ptr<ZstdDictionaryTrainer>>
+      zstdDictionaryTrainers_;
   folly::F14FastMap<
       EncodingKey,
       std::unique_ptr<AbstractIntegerDictionaryEncoder>,
@@ -624,7 +695,11 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelismFactor_{0};
+  std::mutex compressionBufferMutex_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  std::mutex decodedVectorMutex_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -16,6 +16,8 @@
 
 #include "velox/dwio/dwrf/writer/WriterSink.h"
 
+#include <folly/ScopeGuard.h>
+
 namespace facebook::velox::dwrf {
 void WriterSink::addBuffer(dwio::common::DataBuffer<char> buffer) {
   const auto length = buffer.size();
@@ -59,6 +61,87 @@ void WriterSink::addBuffer(dwio::common::DataBuffer<char> buffer) {
   }
 }
 
+void WriterSink::setFlushExecutor(
+    std::shared_ptr<folly::Executor> executor,
+    uint32_t maxPendingFlushes) {
+  VELOX_CHECK(!initialized_);
+  if (executor == nullptr || !shouldBuffer_) {
+    return;
+  }
+  flushExecutor_ = std::move(executor);
+  maxPendingFlushes_ = maxPendingFlushes;
+  flushedSize_ = sink_->size();
+}
+
+void WriterSink::flush() {
+  if (flushExecutor_ == nullptr) {
+    sink_->write(buffers_);
+    buffers_.clear();
+    size_ = 0;
+    return;
+  }
+  if (buffers_.empty()) {
+    return;
+  }
+  const auto bytes = size_;
+  {
+    std::lock_guard<std::mutex> l(queueMutex_);
+    flushQueue_.push_back(std::move(buffers_));
+  }
+  buffers_.clear();
+  flushedSize_ += bytes;
+  pendingFlushBytes_ += bytes;
+  size_ = 0;
+
+  auto write = std::make_shared<AsyncSource<bool>>([this, bytes]() {
+    std::lock_guard<std::mutex> l(writeMutex_);
+    std::vector<dwio::common::DataBuffer<char>> buffers;
+    {
+      std::lock_guard<std::mutex> queueLock(queueMutex_);
+      VELOX_CHECK(!flushQueue_.empty());
+      buffers = std::move(flushQueue_.front());
+      flushQueue_.pop_front();
+    }
+    SCOPE_EXIT {
+      pendingFlushBytes_ -= bytes;
+    };
+    VELOX_CHECK(!writeFailed_, "Previous stripe write failed");
+    try {
+      sink_->write(buffers);
+    } catch (const std::exception&) {
+      writeFailed_ = true;
+      throw;
+    }
+    return std::make_unique<bool>(true);
+  });
+  flushExecutor_->add([write]() { write->prepare(); });
+  pendingFlushes_.push_back(std::move(write));
+  while (pendingFlushes_.size() > maxPendingFlushes_) {
+    // Runs the write inline if it has not started.
+    auto oldest = std::move(pendingFlushes_.front());
+    pendingFlushes_.pop_front();
+    oldest->move();
+  }
+}
+
+void WriterSink::finishFlushes() {
+  std::exception_ptr error;
+  while (!pendingFlushes_.empty()) {
+    auto oldest = std::move(pendingFlushes_.front());
+    pendingFlushes_.pop_front();
+    try {
+      oldest->move();
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 void WriterSink::init(memory::MemoryPool& pool) {
   VELOX_CHECK(!initialized_);
   VELOX_CHECK(offsets_.empty());
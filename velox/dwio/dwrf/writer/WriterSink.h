@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/Array.h>
 
+#include <deque>
+#include <mutex>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/dwio/common/DataBufferHolder.h"
 #include "velox/dwio/dwrf/common/Checksum.h"
 #include "velox/dwio/dwrf/common/Config.h"
@@ -53,6 +58,11 @@ class WriterSink {
         exceedsLimit_{false} {}
 
   ~WriterSink() {
+    try {
+      finishFlushes();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to write stripe in writer sink: " << e.what();
+    }
     if (!buffers_.empty() || size_ != 0) {
       LOG(WARNING) << "Unflushed data in writer sink: " << succinctBytes(size_)
                    << ", " << buffers_.size() << " buffers";
@@ -60,11 +70,31 @@ class WriterSink {
   }
 
   uint64_t size() const {
-    return sink_->size() + size_;
+    return (flushExecutor_ != nullptr ? flushedSize_ : sink_->size()) + size_;
   }
 
   void init(memory::MemoryPool& pool);
 
+  /// Makes flush() hand the buffered data to a write on 'executor' and return
+  /// while the data is written, so that the next stripe is encoded while the
+  /// previous one is written. flush() waits for the oldest write when more
+  /// than 'maxPendingFlushes' are in flight. The buffers remain allocated
+  /// from the output stream pool of the writer context until written. Has no
+  /// effect if the file sink buffers itself, since then nothing is buffered
+  /// here. Must be called before anything is added.
+  void setFlushExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      uint32_t maxPendingFlushes);
+
+  /// Number of bytes handed to asynchronous writes and not yet written.
+  uint64_t pendingFlushBytes() const {
+    return pendingFlushBytes_;
+  }
+
+  /// Waits for the asynchronous writes started by flush(). Throws the first
+  /// error of a write after all have finished.
+  void finishFlushes();
+
   void addBuffer(memory::MemoryPool& pool, const char* data, size_t size) {
     dwio::common::DataBuffer<char> buf{pool, size};
     std::memcpy(buf.data(), data, size);
@@ -81,11 +111,7 @@ class WriterSink {
     other.clear();
   }
 
-  void flush() {
-    sink_->write(buffers_);
-    buffers_.clear();
-    size_ = 0;
-  }
+  void flush();
 
   Checksum* getChecksum() {
     return checksum_.get();
@@ -182,6 +208,23 @@ class WriterSink {
   bool exceedsLimit_;
 
   std::vector<dwio::common::DataBuffer<char>> buffers_;
+
+  // Members used for asynchronous flushes. Unset if flushes are synchronous.
+  std::shared_ptr<folly::Executor> flushExecutor_;
+  uint32_t maxPendingFlushes_{0};
+  // Bytes handed to 'sink_' or to asynchronous writes.
+  uint64_t flushedSize_{0};
+  // The writes in flight, oldest first.
+  std::deque<std::shared_ptr<AsyncSource<bool>>> pendingFlushes_;
+  std::atomic<uint64_t> pendingFlushBytes_{0};
+  // Serializes the writes to 'sink_'. Each write takes the oldest batch of
+  // 'flushQueue_', so the batches are written in order even if the writes
+  // run out of order.
+  std::mutex writeMutex_;
+  std::mutex queueMutex_;
+  std::deque<std::vector<dwio::common::DataBuffer<char>>> flushQueue_;
+  // Set after a failed write. The following batches are then dropped.
+  bool writeFailed_{false};
 };
 
 } // namespace facebook::velox::dwrf
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+namespace detail {
+template <int32_t kWidth>
+void decodeByteStreamSplit(
+    const char* FOLLY_NONNULL data,
+    int32_t numValues,
+    char* FOLLY_NONNULL values) {
+  // Works on blocks of values so that each stream is read sequentially and
+  // the inner loops have a constant trip count the compiler can vectorize.
+  constexpr int32_t kBlockSize = 128;
+  char block[kBlockSize * kWidth];
+  for (int32_t begin = 0; begin < numValues; begin += kBlockSize) {
+    const int32_t size = std::min(kBlockSize, numValues - begin);
+    for (int32_t stream = 0; stream < kWidth; ++stream) {
+      const char* streamData = data + stream * numValues + begin;
+      for (int32_t i = 0; i < size; ++i) {
+        block[i * kWidth + stream] = streamData[i];
+      }
+    }
+    std::memcpy(values + begin * kWidth, block, size * kWidth);
+  }
+}
+} // namespace detail
+
+/// Decodes BYTE_STREAM_SPLIT data. The k-th byte of each of the 'numValues'
+/// values of 'width' bytes is stored in the k-th of 'width' consecutive
+/// streams of 'numValues' bytes. Writes the values in their plain layout to
+/// 'values', which can then be read like PLAIN data.
+inline void decodeByteStreamSplit(
+    const char* FOLLY_NONNULL data,
+    int32_t numValues,
+    int32_t width,
+    char* FOLLY_NONNULL values) {
+  switch (width) {
+    case 4:
+      detail::decodeByteStreamSplit<4>(data, numValues, values);
+      break;
+    case 8:
+      detail::decodeByteStreamSplit<8>(data, numValues, values);
+      break;
+    default:
+      VELOX_UNSUPPORTED("BYTE_STREAM_SPLIT of {} byte values", width);
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -33,6 +33,25 @@ class DeltaBpDecoder {
     skip<false>(numValues, 0, nullptr);
   }
 
+  /// Returns the number of values in the page.
+  uint64_t numValues() const {
+    return totalValueCount_;
+  }
+
+  /// Reads the next 'numValues' values into 'values'.
+  template <typename T>
+  void readValues(T* values, int32_t numValues) {
+    for (int32_t i = 0; i < numValues; ++i) {
+      values[i] = static_cast<T>(readLong());
+    }
+  }
+
+  /// Returns the position right after the encoded values. Valid once all
+  /// values have been read.
+  const char* bufferStart() const {
+    return bufferStart_;
+  }
+
   template <bool hasNulls>
   inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
     if (hasNulls) {
@@ -164,6 +183,7 @@ class DeltaBpDecoder {
     if (valuesRemainingCurrentMiniBlock_ == 0) {
       if (!firstBlockInitialized_) {
         value = lastValue_;
+        totalValuesRemaining_--;
         // When block is uninitialized we have two different possibilities:
         // 1. totalValueCount_ == 1, which means that the page may have only
         // one value (encoded in the header), and we should not initialize
@@ -201,8 +221,11 @@ class DeltaBpDecoder {
     valuesRemainingCurrentMiniBlock_--;
     totalValuesRemaining_--;
 
-    if (valuesRemainingCurrentMiniBlock_ == 0) {
+    // The last miniblock is padded to its full size, so that the data after
+    // the encoded values starts after it.
+    if (valuesRemainingCurrentMiniBlock_ == 0 || totalValuesRemaining_ == 0) {
       bufferStart_ += bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+      valuesRemainingCurrentMiniBlock_ = 0;
     }
     return value;
   }
@@ -55,6 +55,11 @@ class ColumnChunkMetaDataPtr {
   /// The compression.
   common::CompressionKind compression() const;
 
+  /// Returns true if the metadata shows that all data pages are dictionary
+  /// encoded, so that the dictionary page has all the values of the
+  /// ColumnChunk. False if the writer may have fallen back to plain encoding.
+  bool isDictionaryEncoded() const;
+
   /// Total byte size of all the compressed (and potentially encrypted)
   /// column data in this row group.
   /// This information is optional and may be 0 if omitted.
@@ -65,6 +70,33 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of the ColumnIndex of the ColumnChunk.
+  bool hasColumnIndex() const;
+
+  /// File offset of the ColumnIndex.
+  /// Must check for its presence using hasColumnIndex().
+  int64_t columnIndexOffset() const;
+
+  /// Size of the ColumnIndex in bytes.
+  int32_t columnIndexLength() const;
+
+  /// Check the presence of the OffsetIndex of the ColumnChunk.
+  bool hasOffsetIndex() const;
+
+  /// File offset of the OffsetIndex.
+  /// Must check for its presence using hasOffsetIndex().
+  int64_t offsetIndexOffset() const;
+
+  /// Size of the OffsetIndex in bytes.
+  int32_t offsetIndexLength() const;
+
+  /// Check the presence of the Bloom filter of the ColumnChunk.
+  bool hasBloomFilter() const;
+
+  /// File offset of the Bloom filter header.
+  /// Must check for its presence using hasBloomFilter().
+  int64_t bloomFilterOffset() const;
+
  private:
   const void* ptr_;
 };
@@ -16,6 +16,7 @@
 
 #include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/dwio/common/BufferUtil.h"
 
 namespace facebook::velox::parquet {
@@ -79,4 +80,72 @@ int64_t NestedStructureDecoder::readOffsetsAndNulls(
   return outputIndex;
 }
 
+int32_t NestedStructureDecoder::readNonNullListLengths(
+    const int16_t* definitionLevels,
+    const int16_t* repetitionLevels,
+    int32_t numValues,
+    int16_t minDefinition,
+    int32_t maxLists,
+    int32_t* lengths) {
+  using Batch = xsimd::batch<int16_t>;
+  constexpr int32_t kStep = Batch::size;
+  if (numValues == 0) {
+    return 0;
+  }
+  if (repetitionLevels[0] != 0) {
+    return -1;
+  }
+
+  // Checks the levels and counts the lists before writing any length.
+  const auto zeros = Batch::broadcast(0);
+  auto minDefinitions = Batch::broadcast(minDefinition);
+  auto maxRepetitions = zeros;
+  int32_t numBegins = 0;
+  int32_t i = 0;
+  for (; i + kStep <= numValues; i += kStep) {
+    auto repetitions = Batch::load_unaligned(repetitionLevels + i);
+    minDefinitions = xsimd::min(
+        minDefinitions, Batch::load_unaligned(definitionLevels + i));
+    maxRepetitions = xsimd::max(maxRepetitions, repetitions);
+    numBegins += __builtin_popcountll(
+        static_cast<uint64_t>(simd::toBitMask(repetitions == zeros)));
+  }
+  int16_t minLevel = xsimd::reduce_min(minDefinitions);
+  int16_t maxLevel = xsimd::reduce_max(maxRepetitions);
+  for (; i < numValues; ++i) {
+    minLevel = std::min(minLevel, definitionLevels[i]);
+    maxLevel = std::max(maxLevel, repetitionLevels[i]);
+    numBegins += repetitionLevels[i] == 0;
+  }
+  if (minLevel < minDefinition || maxLevel > 1 || numBegins > maxLists) {
+    return -1;
+  }
+
+  // Every level is an element. A repetition level of 0 begins a list.
+  int32_t numLists = 0;
+  int32_t listBegin = 0;
+  auto addList = [&](int32_t begin) {
+    if (numLists > 0) {
+      lengths[numLists - 1] = begin - listBegin;
+    }
+    listBegin = begin;
+    ++numLists;
+  };
+  for (i = 0; i + kStep <= numValues; i += kStep) {
+    auto begins = static_cast<uint64_t>(simd::toBitMask(
+        Batch::load_unaligned(repetitionLevels + i) == zeros));
+    while (begins) {
+      addList(i + __builtin_ctzll(begins));
+      begins &= begins - 1;
+    }
+  }
+  for (; i < numValues; ++i) {
+    if (repetitionLevels[i] == 0) {
+      addList(i);
+    }
+  }
+  lengths[numLists - 1] = numValues - listBegin;
+  return numLists;
+}
+
 } // namespace facebook::velox::parquet
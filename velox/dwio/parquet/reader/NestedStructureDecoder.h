@@ -60,6 +60,30 @@ class NestedStructureDecoder {
       BufferPtr& nullsBuffer,
       memory::MemoryPool& pool);
 
+  /// Fast path for lists at the first repetition level when no list in the
+  /// levels is null or empty and there are no nested lists. Sets 'lengths' to
+  /// the number of elements of each list and returns the number of lists.
+  /// Returns -1 without changing 'lengths' if a definition level is less than
+  /// 'minDefinition', i.e. a list or an ancestor is null or empty, if a
+  /// repetition level is greater than 1, if the levels do not start with a
+  /// new list or if there are more than 'maxLists' lists.
+  ///
+  /// @param definitionLevels The definition levels for the leaf level
+  /// @param repetitionLevels The repetition levels for the leaf level
+  /// @param numValues The number of elements in definitionLevels or
+  /// repetitionLevels
+  /// @param minDefinition The definition level of a present list element
+  /// @param maxLists The maximum number of lists to return
+  /// @param lengths The output lengths. Must have space for 'maxLists'
+  /// elements.
+  static int32_t readNonNullListLengths(
+      const int16_t* definitionLevels,
+      const int16_t* repetitionLevels,
+      int32_t numValues,
+      int16_t minDefinition,
+      int32_t maxLists,
+      int32_t* lengths);
+
  private:
   NestedStructureDecoder() {}
 };
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+template <typename T>
+T readThrift(dwio::common::SeekableInputStream& input, int32_t length) {
+  std::vector<char> buffer(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, &input, buffer.data(), bufferStart, bufferEnd);
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(buffer.data(), length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+} // namespace
+
+PageIndex::PageIndex(
+    std::unique_ptr<dwio::common::SeekableInputStream> offsetIndex,
+    int32_t offsetIndexLength,
+    std::unique_ptr<dwio::common::SeekableInputStream> columnIndex,
+    int32_t columnIndexLength,
+    int64_t chunkOffset,
+    int64_t numRows)
+    : chunkOffset_(chunkOffset), numRows_(numRows) {
+  VELOX_CHECK_NOT_NULL(offsetIndex);
+  offsetIndex_ =
+      readThrift<thrift::OffsetIndex>(*offsetIndex, offsetIndexLength);
+  VELOX_CHECK(!offsetIndex_.page_locations.empty());
+  if (columnIndex) {
+    columnIndex_ =
+        readThrift<thrift::ColumnIndex>(*columnIndex, columnIndexLength);
+    VELOX_CHECK_EQ(columnIndex_->null_pages.size(), numPages());
+    VELOX_CHECK_EQ(columnIndex_->min_values.size(), numPages());
+    VELOX_CHECK_EQ(columnIndex_->max_values.size(), numPages());
+  }
+}
+
+int64_t PageIndex::numRowsInPage(int32_t page) const {
+  const auto end =
+      page + 1 < numPages() ? firstRowOfPage(page + 1) : numRows_;
+  return end - firstRowOfPage(page);
+}
+
+int32_t PageIndex::pageOfRow(int64_t row) const {
+  const auto& locations = offsetIndex_.page_locations;
+  auto it = std::upper_bound(
+      locations.begin(),
+      locations.end(),
+      row,
+      [](int64_t row, const thrift::PageLocation& location) {
+        return row < location.first_row_index;
+      });
+  VELOX_CHECK(it != locations.begin());
+  return it - locations.begin() - 1;
+}
+
+std::unique_ptr<dwio::common::ColumnStatistics> PageIndex::pageStatistics(
+    int32_t page,
+    const Type& type) const {
+  VELOX_CHECK(hasColumnIndex());
+  const auto numRows = numRowsInPage(page);
+  thrift::Statistics stats;
+  if (columnIndex_->null_pages[page]) {
+    stats.__set_null_count(numRows);
+  } else {
+    stats.__set_min_value(columnIndex_->min_values[page]);
+    stats.__set_max_value(columnIndex_->max_values[page]);
+    if (columnIndex_->__isset.null_counts) {
+      stats.__set_null_count(columnIndex_->null_counts[page]);
+    }
+  }
+  return buildColumnStatisticsFromThrift(stats, type, numRows);
+}
+
+void PageIndex::filterPages(
+    common::Filter* filter,
+    const TypePtr& type,
+    std::vector<RowRange>& ranges) const {
+  VELOX_CHECK_NOT_NULL(filter);
+  if (!hasColumnIndex()) {
+    return;
+  }
+  std::optional<RowRange> range;
+  for (auto page = 0; page < numPages(); ++page) {
+    auto stats = pageStatistics(page, *type);
+    if (testFilter(filter, stats.get(), numRowsInPage(page), type)) {
+      if (range.has_value()) {
+        ranges.push_back(range.value());
+        range.reset();
+      }
+      continue;
+    }
+    const auto begin = firstRowOfPage(page);
+    const auto end = begin + numRowsInPage(page);
+    if (range.has_value()) {
+      range->end = end;
+    } else {
+      range = RowRange{begin, end};
+    }
+  }
+  if (range.has_value()) {
+    ranges.push_back(range.value());
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// A range of top level rows [begin, end) in a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+};
+
+/// The page index of a ColumnChunk. The OffsetIndex gives the location and the
+/// first row of each data page. The optional ColumnIndex gives the min/max
+/// values and the null counts of each data page.
+class PageIndex {
+ public:
+  /// Deserializes the OffsetIndex from 'offsetIndex' and the ColumnIndex from
+  /// 'columnIndex' if not null. 'chunkOffset' is the file offset of the first
+  /// page of the ColumnChunk, dictionary page included. 'numRows' is the
+  /// number of rows in the row group.
+  PageIndex(
+      std::unique_ptr<dwio::common::SeekableInputStream> offsetIndex,
+      int32_t offsetIndexLength,
+      std::unique_ptr<dwio::common::SeekableInputStream> columnIndex,
+      int32_t columnIndexLength,
+      int64_t chunkOffset,
+      int64_t numRows);
+
+  int32_t numPages() const {
+    return offsetIndex_.page_locations.size();
+  }
+
+  /// Row number of the first row of 'page' from the start of the row group.
+  int64_t firstRowOfPage(int32_t page) const {
+    return offsetIndex_.page_locations[page].first_row_index;
+  }
+
+  /// Number of top level rows in 'page'.
+  int64_t numRowsInPage(int32_t page) const;
+
+  /// Offset of the header of 'page' from the start of the ColumnChunk.
+  int64_t pageOffset(int32_t page) const {
+    return offsetIndex_.page_locations[page].offset - chunkOffset_;
+  }
+
+  /// Returns the page that contains 'row'.
+  int32_t pageOfRow(int64_t row) const;
+
+  bool hasColumnIndex() const {
+    return columnIndex_.has_value();
+  }
+
+  /// Returns the statistics of the values of 'type' in 'page' from the
+  /// ColumnIndex.
+  std::unique_ptr<dwio::common::ColumnStatistics> pageStatistics(
+      int32_t page,
+      const Type& type) const;
+
+  /// Appends to 'ranges' the rows of the pages for which 'filter' can't have
+  /// hits according to the ColumnIndex. Adjacent pages are appended as one
+  /// range.
+  void filterPages(
+      common::Filter* filter,
+      const TypePtr& type,
+      std::vector<RowRange>& ranges) const;
+
+ private:
+  const int64_t chunkOffset_;
+  const int64_t numRows_;
+  thrift::OffsetIndex offsetIndex_;
+  std::optional<thrift::ColumnIndex> columnIndex_;
+};
+
+/// Builds the ColumnStatistics of 'type' from 'columnChunkStats'. Defined in
+/// Metadata.cpp.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
+} // namespace facebook::velox::parquet
@@ -18,6 +18,8 @@
 
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+#include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
 
@@ -34,6 +36,9 @@ void PageReader::seekToPage(int64_t row) {
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
+    if (row != kRepDefOnly) {
+      skipToPageOfRow(row);
+    }
     auto dataStart = pageStart_;
     if (chunkSize_ <= pageStart_) {
       // This may happen if seeking to exactly end of row group.
@@ -41,7 +46,7 @@ void PageReader::seekToPage(int64_t row) {
       numRowsInPage_ = 0;
       break;
     }
-    PageHeader pageHeader = readPageHeader();
+    PageHeader pageHeader = nextPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
 
     switch (pageHeader.type) {
@@ -53,11 +58,7 @@ void PageReader::seekToPage(int64_t row) {
         break;
       case thrift::PageType::DICTIONARY_PAGE:
         if (row == kRepDefOnly) {
-          skipBytes(
-              pageHeader.compressed_page_size,
-              inputStream_.get(),
-              bufferStart_,
-              bufferEnd_);
+          skipPageBytes(pageHeader.compressed_page_size);
           continue;
         }
         prepareDictionary(pageHeader);
@@ -70,9 +71,66 @@ void PageReader::seekToPage(int64_t row) {
     }
     updateRowInfoAfterPageSkipped();
   }
+  if (row != kRepDefOnly) {
+    readAhead();
+  }
+}
+
+void PageReader::skipToPageOfRow(int64_t row) {
+  // Rows and leaf values are the same only if there are no repetitions. The
+  // dictionary page precedes the first data page and must be read first.
+  if (!pageIndex_ || maxRepeat_ > 0 ||
+      pageStart_ < static_cast<uint64_t>(pageIndex_->pageOffset(0))) {
+    return;
+  }
+  const auto page = pageIndex_->pageOfRow(row);
+  const uint64_t pageOffset = pageIndex_->pageOffset(page);
+  if (pageOffset <= pageStart_) {
+    return;
+  }
+  // The pages read ahead before 'pageOffset' are dropped.
+  const auto streamOffset = readAhead_.empty() ? pageStart_ : readAheadEnd_;
+  while (!readAhead_.empty() && readAhead_.front().pageStart < pageOffset) {
+    if (readAhead_.front().decompressed) {
+      readAhead_.front().decompressed->close();
+    }
+    readAheadBytes_ -= readAheadBytes(readAhead_.front().header);
+    readAhead_.pop_front();
+  }
+  if (readAhead_.empty()) {
+    dwio::common::skipBytes(
+        pageOffset - streamOffset,
+        inputStream_.get(),
+        bufferStart_,
+        bufferEnd_);
+  } else {
+    VELOX_CHECK_EQ(readAhead_.front().pageStart, pageOffset);
+  }
+  pageStart_ = pageOffset;
+  rowOfPage_ = pageIndex_->firstRowOfPage(page);
 }
 
 PageHeader PageReader::readPageHeader() {
+  PageHeader pageHeader;
+  pageDataStart_ = pageStart_ + parsePageHeader(pageHeader);
+  return pageHeader;
+}
+
+const dwio::common::DictionaryValues* PageReader::readDictionaryPage() {
+  VELOX_CHECK_EQ(pageStart_, 0);
+  if (chunkSize_ == 0) {
+    return nullptr;
+  }
+  PageHeader pageHeader = readPageHeader();
+  if (pageHeader.type != thrift::PageType::DICTIONARY_PAGE) {
+    return nullptr;
+  }
+  pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+  prepareDictionary(pageHeader);
+  return &dictionary_;
+}
+
+uint64_t PageReader::parsePageHeader(PageHeader& pageHeader) {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer;
     int32_t size;
@@ -86,12 +144,155 @@ PageHeader PageReader::readPageHeader() {
           inputStream_.get(), bufferStart_, bufferEnd_);
   apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
       transport);
-  PageHeader pageHeader;
-  uint64_t readBytes;
-  readBytes = pageHeader.read(&protocol);
+  return pageHeader.read(&protocol);
+}
 
-  pageDataStart_ = pageStart_ + readBytes;
-  return pageHeader;
+PageHeader PageReader::nextPageHeader() {
+  if (currentPage_.has_value() && currentPage_->decompressed) {
+    // The page was skipped.
+    currentPage_->decompressed->close();
+  }
+  currentPage_.reset();
+  if (readAhead_.empty()) {
+    return readPageHeader();
+  }
+  currentPage_ = std::move(readAhead_.front());
+  readAhead_.pop_front();
+  readAheadBytes_ -= readAheadBytes(currentPage_->header);
+  VELOX_CHECK_EQ(currentPage_->pageStart, pageStart_);
+  pageDataStart_ = currentPage_->pageDataStart;
+  return currentPage_->header;
+}
+
+const char* PageReader::readPageBytes(int32_t size) {
+  if (currentPage_.has_value()) {
+    VELOX_CHECK_EQ(currentPage_->data->size(), static_cast<uint64_t>(size));
+    return currentPage_->data->as<char>();
+  }
+  if (!readAheadEnabled()) {
+    return readBytes(size, pageBuffer_);
+  }
+  // Reading ahead moves 'inputStream_' past the current page, so the page is
+  // copied out of the buffers of 'inputStream_'.
+  dwio::common::ensureCapacity<char>(pageBuffer_, size, &pool_);
+  dwio::common::readBytes(
+      size,
+      inputStream_.get(),
+      pageBuffer_->asMutable<char>(),
+      bufferStart_,
+      bufferEnd_);
+  return pageBuffer_->as<char>();
+}
+
+void PageReader::skipPageBytes(int32_t size) {
+  if (!currentPage_.has_value()) {
+    dwio::common::skipBytes(size, inputStream_.get(), bufferStart_, bufferEnd_);
+  }
+}
+
+const char* PageReader::decompressPageData(
+    const char* pageData,
+    uint32_t compressedSize,
+    uint32_t uncompressedSize) {
+  if (currentPage_.has_value() && currentPage_->decompressed) {
+    auto data = currentPage_->decompressed->move();
+    VELOX_CHECK_NOT_NULL(data);
+    currentPage_->decompressed.reset();
+    decompressedData_ = std::move(*data);
+    return decompressedData_->as<char>();
+  }
+  return decompressData(pageData, compressedSize, uncompressedSize);
+}
+
+bool PageReader::readAheadEnabled() const {
+  // Columns below lists or structs read their repdefs ahead of the data and
+  // rewind 'inputStream_'.
+  return readAheadOptions_.executor != nullptr &&
+      readAheadOptions_.numPages > 0 &&
+      codec_ != common::CompressionKind::CompressionKind_NONE && isTopLevel_;
+}
+
+// static
+uint64_t PageReader::readAheadBytes(const PageHeader& header) {
+  return header.compressed_page_size + header.uncompressed_page_size;
+}
+
+void PageReader::readAhead() {
+  if (!readAheadEnabled()) {
+    return;
+  }
+  if (readAhead_.empty()) {
+    readAheadEnd_ = pageStart_;
+  }
+  const auto streamName =
+      fmt::format("Page Reader: Stream {}", inputStream_->getName());
+  while (readAhead_.size() < readAheadOptions_.numPages &&
+         readAheadBytes_ < readAheadOptions_.maxBytes &&
+         readAheadEnd_ < chunkSize_) {
+    ReadAheadPage page;
+    page.pageStart = readAheadEnd_;
+    page.pageDataStart = readAheadEnd_ + parsePageHeader(page.header);
+    const uint32_t size = page.header.compressed_page_size;
+    page.data = AlignedBuffer::allocate<char>(size, &pool_);
+    dwio::common::readBytes(
+        size,
+        inputStream_.get(),
+        page.data->asMutable<char>(),
+        bufferStart_,
+        bufferEnd_);
+    readAheadEnd_ = page.pageDataStart + size;
+
+    // Dictionary pages come before the data pages and are decompressed when
+    // read. For V2 pages only the data after the levels is compressed.
+    bool compressed = false;
+    uint32_t levelsSize = 0;
+    if (page.header.type == thrift::PageType::DATA_PAGE) {
+      compressed = true;
+    } else if (page.header.type == thrift::PageType::DATA_PAGE_V2) {
+      const auto& header = page.header.data_page_header_v2;
+      compressed = header.__isset.is_compressed || header.is_compressed;
+      levelsSize = maxDefine_ > 0 ? header.definition_levels_byte_length : 0;
+    }
+    if (compressed) {
+      page.decompressed = std::make_shared<AsyncSource<BufferPtr>>(
+          [data = page.data,
+           levelsSize,
+           size,
+           uncompressedSize = page.header.uncompressed_page_size,
+           codec = codec_,
+           streamName,
+           pool = &pool_]() {
+            auto result = std::make_unique<BufferPtr>();
+            decompressPage(
+                data->as<char>() + levelsSize,
+                size - levelsSize,
+                uncompressedSize - levelsSize,
+                codec,
+                streamName,
+                *pool,
+                *result);
+            return result;
+          });
+      readAheadOptions_.executor->add(
+          [source = page.decompressed]() { source->prepare(); });
+    }
+    readAheadBytes_ += readAheadBytes(page.header);
+    readAhead_.push_back(std::move(page));
+  }
+}
+
+void PageReader::clearReadAhead() {
+  if (currentPage_.has_value() && currentPage_->decompressed) {
+    currentPage_->decompressed->close();
+  }
+  currentPage_.reset();
+  for (auto& page : readAhead_) {
+    if (page.decompressed) {
+      page.decompressed->close();
+    }
+  }
+  readAhead_.clear();
+  readAheadBytes_ = 0;
 }
 
 const char* PageReader::readBytes(int32_t size, BufferPtr& copy) {
@@ -122,29 +323,44 @@ const char* FOLLY_NONNULL PageReader::decompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
+  return decompressPage(
+      pageData,
+      compressedSize,
+      uncompressedSize,
+      codec_,
+      fmt::format("Page Reader: Stream {}", inputStream_->getName()),
+      pool_,
+      decompressedData_);
+}
+
+// static
+const char* FOLLY_NONNULL PageReader::decompressPage(
+    const char* pageData,
+    uint32_t compressedSize,
+    uint32_t uncompressedSize,
+    common::CompressionKind codec,
+    const std::string& streamDebugInfo,
+    memory::MemoryPool& pool,
+    BufferPtr& result) {
   std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
       std::make_unique<dwio::common::SeekableArrayInputStream>(
           pageData, compressedSize, 0);
-  auto streamDebugInfo =
-      fmt::format("Page Reader: Stream {}", inputStream_->getName());
   std::unique_ptr<dwio::common::SeekableInputStream> decompressedStream =
       dwio::common::compression::createDecompressor(
-          codec_,
+          codec,
           std::move(inputStream),
           uncompressedSize,
-          pool_,
-          getParquetDecompressionOptions(codec_),
+          pool,
+          getParquetDecompressionOptions(codec),
           streamDebugInfo,
           nullptr,
           true,
           compressedSize);
 
-  dwio::common::ensureCapacity<char>(
-      decompressedData_, uncompressedSize, &pool_);
-  decompressedStream->readFully(
-      decompressedData_->asMutable<char>(), uncompressedSize);
+  dwio::common::ensureCapacity<char>(result, uncompressedSize, &pool);
+  decompressedStream->readFully(result->asMutable<char>(), uncompressedSize);
 
-  return decompressedData_->as<char>();
+  return result->as<char>();
 }
 
 void PageReader::setPageRowInfo(bool forRepDef) {
@@ -197,16 +413,11 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
       numRowsInPage_ + rowOfPage_ <= row) {
-    dwio::common::skipBytes(
-        pageHeader.compressed_page_size,
-        inputStream_.get(),
-        bufferStart_,
-        bufferEnd_);
-
+    skipPageBytes(pageHeader.compressed_page_size);
     return;
   }
-  pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
-  pageData_ = decompressData(
+  pageData_ = readPageBytes(pageHeader.compressed_page_size);
+  pageData_ = decompressPageData(
       pageData_,
       pageHeader.compressed_page_size,
       pageHeader.uncompressed_page_size);
@@ -253,11 +464,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
       numRowsInPage_ + rowOfPage_ <= row) {
-    skipBytes(
-        pageHeader.compressed_page_size,
-        inputStream_.get(),
-        bufferStart_,
-        bufferEnd_);
+    skipPageBytes(pageHeader.compressed_page_size);
     return;
   }
 
@@ -268,7 +475,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
       ? pageHeader.data_page_header_v2.repetition_levels_byte_length
       : 0;
   auto bytes = pageHeader.compressed_page_size;
-  pageData_ = readBytes(bytes, pageBuffer_);
+  pageData_ = readPageBytes(bytes);
 
   if (repeatLength) {
     repeatDecoder_ = std::make_unique<::arrow::util::RleDecoder>(
@@ -287,7 +494,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   pageData_ += levelsSize;
   if (pageHeader.data_page_header_v2.__isset.is_compressed ||
       pageHeader.data_page_header_v2.is_compressed) {
-    pageData_ = decompressData(
+    pageData_ = decompressPageData(
         pageData_,
         pageHeader.compressed_page_size - levelsSize,
         pageHeader.uncompressed_page_size - levelsSize);
@@ -317,8 +524,8 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       dictionaryEncoding_ == Encoding::PLAIN);
 
   if (codec_ != common::CompressionKind::CompressionKind_NONE) {
-    pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
-    pageData_ = decompressData(
+    pageData_ = readPageBytes(pageHeader.compressed_page_size);
+    pageData_ = decompressPageData(
         pageData_,
         pageHeader.compressed_page_size,
         pageHeader.uncompressed_page_size);
@@ -519,6 +726,7 @@ void PageReader::preloadRepDefs() {
   }
 
   // Reset the input to start of column chunk.
+  clearReadAhead();
   std::vector<uint64_t> rewind = {0};
   pageStart_ = 0;
   dwio::common::PositionProvider position(rewind);
@@ -574,6 +782,22 @@ int32_t PageReader::getLengthsAndNulls(
           definitionLevels_.data() + begin, end - begin, info, &bits);
       break;
     case LevelMode::kList: {
+      if (info.rep_level == 1) {
+        auto numLists = NestedStructureDecoder::readNonNullListLengths(
+            definitionLevels_.data() + begin,
+            repetitionLevels_.data() + begin,
+            end - begin,
+            info.def_level,
+            maxItems,
+            lengths);
+        if (numLists >= 0) {
+          if (nulls) {
+            bits::fillBits(
+                nulls, nullsStartIndex, nullsStartIndex + numLists, true);
+          }
+          return numLists;
+        }
+      }
       arrow::DefRepLevelsToList(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
@@ -602,6 +826,14 @@ int32_t PageReader::getLengthsAndNulls(
 
 void PageReader::makeDecoder() {
   auto parquetType = type_->parquetType_.value();
+  // Pages of a ColumnChunk may have different encodings. Clears the decoders
+  // of the previous page so that skip() finds the one of this page.
+  directDecoder_.reset();
+  stringDecoder_.reset();
+  booleanDecoder_.reset();
+  deltaBpDecoder_.reset();
+  deltaLengthByteArrayDecoder_.reset();
+  deltaByteArrayDecoder_.reset();
   switch (encoding_) {
     case Encoding::RLE_DICTIONARY:
     case Encoding::PLAIN_DICTIONARY:
@@ -646,6 +878,53 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      VELOX_CHECK_EQ(
+          parquetType,
+          thrift::Type::BYTE_ARRAY,
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      switch (parquetType) {
+        case thrift::Type::BYTE_ARRAY:
+          deltaByteArrayDecoder_ =
+              std::make_unique<DeltaByteArrayDecoder>(pageData_);
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      }
+      break;
+    case Encoding::BYTE_STREAM_SPLIT: {
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports FLOAT and DOUBLE");
+      }
+      // The streams are interleaved back into plain values once per page so
+      // that the values are read with the fast paths of DirectDecoder.
+      const auto width = parquetTypeBytes(parquetType);
+      VELOX_CHECK_EQ(
+          encodedDataSize_ % width,
+          0,
+          "BYTE_STREAM_SPLIT page size is not a multiple of the value size");
+      dwio::common::ensureCapacity<char>(
+          byteStreamSplitData_, encodedDataSize_, &pool_);
+      auto* values = byteStreamSplitData_->asMutable<char>();
+      decodeByteStreamSplit(
+          pageData_, encodedDataSize_ / width, width, values);
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              values, encodedDataSize_),
+          false,
+          width);
+      break;
+    }
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -680,6 +959,10 @@ void PageReader::skip(int64_t numRows) {
     booleanDecoder_->skip(toSkip);
   } else if (deltaBpDecoder_) {
     deltaBpDecoder_->skip(toSkip);
+  } else if (deltaLengthByteArrayDecoder_) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (deltaByteArrayDecoder_) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else {
     VELOX_FAIL("No decoder to skip");
   }
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/BitConcatenation.h"
 #include "velox/dwio/common/DirectDecoder.h"
@@ -23,6 +26,9 @@
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -31,6 +37,19 @@
 
 namespace facebook::velox::parquet {
 
+/// Decompression of the pages after the current one on an executor while the
+/// current page is decoded.
+struct PageReadAheadOptions {
+  folly::Executor* executor{nullptr};
+
+  /// Maximum number of pages read ahead.
+  int32_t numPages{0};
+
+  /// Cap on the compressed and decompressed bytes of the pages read ahead.
+  /// May be exceeded by one page.
+  uint64_t maxBytes{0};
+};
+
 /// Manages access to pages inside a ColumnChunk. Interprets page headers and
 /// encodings and presents the combination of pages and encoded values as a
 /// continuous stream accessible via readWithVisitor().
@@ -41,7 +60,9 @@ class PageReader {
       memory::MemoryPool& pool,
       ParquetTypeWithIdPtr fileType,
       common::CompressionKind codec,
-      int64_t chunkSize)
+      int64_t chunkSize,
+      std::unique_ptr<PageIndex> pageIndex = nullptr,
+      PageReadAheadOptions readAhead = {})
       : pool_(pool),
         inputStream_(std::move(stream)),
         type_(std::move(fileType)),
@@ -50,6 +71,8 @@ class PageReader {
         isTopLevel_(maxRepeat_ == 0 && maxDefine_ <= 1),
         codec_(codec),
         chunkSize_(chunkSize),
+        pageIndex_(std::move(pageIndex)),
+        readAheadOptions_(readAhead),
         nullConcatenation_(pool_) {
     type_->makeLevelInfo(leafInfo_);
   }
@@ -69,6 +92,10 @@ class PageReader {
         chunkSize_(chunkSize),
         nullConcatenation_(pool_) {}
 
+  ~PageReader() {
+    clearReadAhead();
+  }
+
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
@@ -137,6 +164,17 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Reads the dictionary page at the start of the ColumnChunk. Returns the
+  /// dictionary or nullptr if the first page is not a dictionary page. Used
+  /// to test a filter against the dictionary before reading the data pages.
+  const dwio::common::DictionaryValues* FOLLY_NULLABLE readDictionaryPage();
+
+  /// Returns the page index of the ColumnChunk or nullptr if the file has no
+  /// page index.
+  const PageIndex* FOLLY_NULLABLE pageIndex() const {
+    return pageIndex_.get();
+  }
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -158,6 +196,10 @@ class PageReader {
   // Initializes a filter result cache for the dictionary in 'state'.
   void makeFilterCache(dwio::common::ScanState& state);
 
+  // If the page index is known, positions 'inputStream_' at the header of the
+  // page containing 'row' if that is after the page at 'pageStart_'.
+  void skipToPageOfRow(int64_t row);
+
   // Makes a decoder based on 'encoding_' for bytes from ''pageData_' to
   // 'pageData_' + 'encodedDataSize_'.
   void makedecoder();
@@ -203,6 +245,57 @@ class PageReader {
   // straddles buffers. Allocates or resizes 'copy' as needed.
   const char* FOLLY_NONNULL readBytes(int32_t size, BufferPtr& copy);
 
+  // A page whose bytes have been read from 'inputStream_' ahead of the
+  // current page.
+  struct ReadAheadPage {
+    thrift::PageHeader header;
+    // Offsets of the header and of the first byte after the header from the
+    // start of the ColumnChunk.
+    uint64_t pageStart;
+    uint64_t pageDataStart;
+    // Compressed bytes of the page.
+    BufferPtr data;
+    // Makes the decompressed encoded data. nullptr if the page is not
+    // decompressed ahead.
+    std::shared_ptr<AsyncSource<BufferPtr>> decompressed;
+  };
+
+  // Parses the PageHeader at 'inputStream_' into 'header'. Returns the size of
+  // the header.
+  uint64_t parsePageHeader(thrift::PageHeader& header);
+
+  // Returns the header of the next page. Takes the page from 'readAhead_' if
+  // it is read ahead and otherwise reads the header from 'inputStream_'.
+  thrift::PageHeader nextPageHeader();
+
+  // Returns 'size' bytes of the current page. The page data is at the
+  // current position of 'inputStream_' unless the page is read ahead.
+  const char* FOLLY_NONNULL readPageBytes(int32_t size);
+
+  // Skips the 'size' bytes of the current page.
+  void skipPageBytes(int32_t size);
+
+  // Returns the decompressed data of the current page, decompressing it on
+  // the calling thread if it was not decompressed ahead. The arguments are as
+  // in decompressData().
+  const char* FOLLY_NONNULL decompressPageData(
+      const char* FOLLY_NONNULL pageData,
+      uint32_t compressedSize,
+      uint32_t uncompressedSize);
+
+  // True if pages are decompressed ahead of decoding.
+  bool readAheadEnabled() const;
+
+  // Reads the pages after the current one into 'readAhead_' and schedules
+  // their decompression on the executor of 'readAheadOptions_'.
+  void readAhead();
+
+  // Returns the memory a page with 'header' takes in 'readAhead_'.
+  static uint64_t readAheadBytes(const thrift::PageHeader& header);
+
+  // Drops the pages read ahead, waiting for decompressions in progress.
+  void clearReadAhead();
+
   // Decompresses data starting at 'pageData_', consuming 'compressedsize' and
   // producing up to 'uncompressedSize' bytes. The start of the decoding
   // result is returned. an intermediate copy may be made in 'decompresseddata_'
@@ -211,6 +304,18 @@ class PageReader {
       uint32_t compressedSize,
       uint32_t uncompressedSize);
 
+  // Decompresses 'compressedSize' bytes at 'pageData' into 'result', which
+  // is allocated from 'pool' as needed. Returns the start of 'result'. May be
+  // called on any thread.
+  static const char* FOLLY_NONNULL decompressPage(
+      const char* FOLLY_NONNULL pageData,
+      uint32_t compressedSize,
+      uint32_t uncompressedSize,
+      common::CompressionKind codec,
+      const std::string& streamDebugInfo,
+      memory::MemoryPool& pool,
+      BufferPtr& result);
+
   template <typename T>
   T readField(const char* FOLLY_NONNULL& ptr) {
     T data = *reinterpret_cast<const T*>(ptr);
@@ -301,6 +406,12 @@ class PageReader {
         nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor);
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -309,6 +420,10 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -356,6 +471,27 @@ class PageReader {
 
   const common::CompressionKind codec_;
   const int64_t chunkSize_;
+
+  // Locations of the data pages. Used for seeking to the page of a row without
+  // reading the headers of the pages in between.
+  const std::unique_ptr<PageIndex> pageIndex_;
+
+  const PageReadAheadOptions readAheadOptions_;
+
+  // Pages after the current one, in order, whose bytes have been read from
+  // 'inputStream_'.
+  std::deque<ReadAheadPage> readAhead_;
+
+  // Sum of readAheadBytes() of 'readAhead_'.
+  uint64_t readAheadBytes_{0};
+
+  // Offset of the position of 'inputStream_' from the start of the
+  // ColumnChunk if 'readAhead_' is not empty.
+  uint64_t readAheadEnd_{0};
+
+  // The current page if it was read ahead.
+  std::optional<ReadAheadPage> currentPage_;
+
   const char* FOLLY_NULLABLE bufferStart_{nullptr};
   const char* FOLLY_NULLABLE bufferEnd_{nullptr};
   BufferPtr tempNulls_;
@@ -420,6 +556,9 @@ class PageReader {
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
+  // Values of a BYTE_STREAM_SPLIT page in their plain layout.
+  BufferPtr byteStreamSplitData_;
+
   // First byte of decompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
@@ -485,6 +624,8 @@ class PageReader {
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
   // Add decoders for other encodings here.
 };
 
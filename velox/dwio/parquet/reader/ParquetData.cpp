@@ -22,8 +22,9 @@ namespace facebook::velox::parquet {
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_, pool());
+    const common::ScanSpec& scanSpec) {
+  return std::make_unique<ParquetData>(
+      type, metaData_, scanSpec, pool(), readAhead_);
 }
 
 void ParquetData::filterRowGroups(
@@ -85,42 +86,186 @@ void ParquetData::enqueueRowGroup(
     dwio::common::BufferedInput& input) {
   auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
   streams_.resize(fileMetaDataPtr_.numRowGroups());
+  offsetIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+  columnIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
   VELOX_CHECK(
       chunk.hasMetadata(),
       "ColumnMetaData does not exist for schema Id ",
       type_->column());
   ;
 
-  uint64_t chunkReadOffset = chunk.dataPageOffset();
-  if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = chunk.dictionaryPageOffset();
-  }
-  VELOX_CHECK_GE(chunkReadOffset, 0);
-
   uint64_t readSize =
       (chunk.compression() == common::CompressionKind::CompressionKind_NONE)
       ? chunk.totalUncompressedSize()
       : chunk.totalCompressedSize();
 
   auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] = input.enqueue({chunkReadOffset(chunk), readSize}, &id);
+
+  // The page index is only used to seek within columns without repetitions.
+  if (maxRepeat_ > 0 || !chunk.hasOffsetIndex()) {
+    return;
+  }
+  offsetIndexStreams_[index] = input.enqueue(
+      {static_cast<uint64_t>(chunk.offsetIndexOffset()),
+       static_cast<uint64_t>(chunk.offsetIndexLength())},
+      &id);
+  if (scanSpec_.filter() && chunk.hasColumnIndex()) {
+    columnIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.columnIndexOffset()),
+         static_cast<uint64_t>(chunk.columnIndexLength())},
+        &id);
+  }
+}
+
+// static
+uint64_t ParquetData::chunkReadOffset(const ColumnChunkMetaDataPtr& chunk) {
+  uint64_t chunkReadOffset = chunk.dataPageOffset();
+  if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    chunkReadOffset = chunk.dictionaryPageOffset();
+  }
+  VELOX_CHECK_GE(chunkReadOffset, 0);
+  return chunkReadOffset;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
   VELOX_CHECK(streams_[index], "Stream not enqueued for column");
-  auto metadata = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto metadata = rowGroup.columnChunk(type_->column());
+  std::unique_ptr<PageIndex> pageIndex;
+  if (offsetIndexStreams_[index]) {
+    const auto columnIndexLength =
+        columnIndexStreams_[index] ? metadata.columnIndexLength() : 0;
+    pageIndex = std::make_unique<PageIndex>(
+        std::move(offsetIndexStreams_[index]),
+        metadata.offsetIndexLength(),
+        std::move(columnIndexStreams_[index]),
+        columnIndexLength,
+        chunkReadOffset(metadata),
+        rowGroup.numRows());
+  }
   reader_ = std::make_unique<PageReader>(
       std::move(streams_[index]),
       pool_,
       type_,
       metadata.compression(),
-      metadata.totalCompressedSize());
+      metadata.totalCompressedSize(),
+      std::move(pageIndex),
+      readAhead_);
   return dwio::common::PositionProvider(empty);
 }
 
+void ParquetData::filterPages(
+    const common::ScanSpec& scanSpec,
+    std::vector<RowRange>& ranges) const {
+  auto* filter = scanSpec.filter();
+  if (!filter || !reader_ || maxRepeat_ > 0) {
+    return;
+  }
+  if (auto* pageIndex = reader_->pageIndex()) {
+    pageIndex->filterPages(filter, type_->type(), ranges);
+  }
+}
+
+bool ParquetData::hasBloomFilter(uint32_t rowGroupId) const {
+  auto* filter = scanSpec_.filter();
+  if (!filter || maxRepeat_ > 0 || !type_->parquetType_.has_value() ||
+      !SplitBlockBloomFilter::canTestFilter(
+          *filter, type_->parquetType_.value(), type_->type()->kind())) {
+    return false;
+  }
+  return fileMetaDataPtr_.rowGroup(rowGroupId)
+      .columnChunk(type_->column())
+      .hasBloomFilter();
+}
+
+bool ParquetData::testBloomFilter(
+    const SplitBlockBloomFilter& bloomFilter) const {
+  VELOX_CHECK_NOT_NULL(scanSpec_.filter());
+  return bloomFilter.testFilter(
+      *scanSpec_.filter(),
+      type_->parquetType_.value(),
+      type_->type()->kind());
+}
+
+bool ParquetData::hasDictionaryFilter(uint32_t rowGroupId) const {
+  auto* filter = scanSpec_.filter();
+  if (!filter || !filter->isDeterministic() || filter->testNull() ||
+      maxRepeat_ > 0 || !type_->parquetType_.has_value()) {
+    return false;
+  }
+  const auto& type = type_->type();
+  switch (type_->parquetType_.value()) {
+    case thrift::Type::INT32:
+    case thrift::Type::INT64:
+      switch (type->kind()) {
+        case TypeKind::TINYINT:
+        case TypeKind::SMALLINT:
+        case TypeKind::INTEGER:
+        case TypeKind::BIGINT:
+          if (type->isDecimal()) {
+            return false;
+          }
+          break;
+        default:
+          return false;
+      }
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      if (type->kind() != TypeKind::VARCHAR &&
+          type->kind() != TypeKind::VARBINARY) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  return fileMetaDataPtr_.rowGroup(rowGroupId)
+      .columnChunk(type_->column())
+      .isDictionaryEncoded();
+}
+
+bool ParquetData::testDictionary(uint32_t rowGroupId, std::string_view data)
+    const {
+  auto* filter = scanSpec_.filter();
+  VELOX_CHECK_NOT_NULL(filter);
+  auto chunk = fileMetaDataPtr_.rowGroup(rowGroupId).columnChunk(column());
+  PageReader reader(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          data.data(), data.size()),
+      pool_,
+      type_,
+      chunk.compression(),
+      data.size());
+  const auto* dictionary = reader.readDictionaryPage();
+  if (!dictionary) {
+    return true;
+  }
+  for (auto i = 0; i < dictionary->numValues; ++i) {
+    bool passed;
+    switch (type_->parquetType_.value()) {
+      case thrift::Type::INT32:
+        passed = filter->testInt64(dictionary->values->as<int32_t>()[i]);
+        break;
+      case thrift::Type::INT64:
+        passed = filter->testInt64(dictionary->values->as<int64_t>()[i]);
+        break;
+      default: {
+        const auto& value = dictionary->values->as<StringView>()[i];
+        passed = filter->testBytes(value.data(), value.size());
+        break;
+      }
+    }
+    if (passed) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::pair<int64_t, int64_t> ParquetData::getRowGroupRegion(
     uint32_t index) const {
   auto rowGroup = fileMetaDataPtr_.rowGroup(index);
@@ -19,6 +19,7 @@
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
 
 namespace facebook::velox::common {
 class ScanSpec;
@@ -35,14 +36,16 @@ class ParquetParams : public dwio::common::FormatParams {
   ParquetParams(
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const FileMetaDataPtr metaData)
-      : FormatParams(pool, stats), metaData_(metaData) {}
+      const FileMetaDataPtr metaData,
+      PageReadAheadOptions readAhead = {})
+      : FormatParams(pool, stats), metaData_(metaData), readAhead_(readAhead) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const FileMetaDataPtr metaData_;
+  const PageReadAheadOptions readAhead_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -51,10 +54,14 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
-      memory::MemoryPool& pool)
+      const common::ScanSpec& scanSpec,
+      memory::MemoryPool& pool,
+      PageReadAheadOptions readAhead = {})
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
+        scanSpec_(scanSpec),
+        readAhead_(readAhead),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -186,19 +193,61 @@ class ParquetData : public dwio::common::FormatData {
   // Returns the <offset, length> of the row group.
   std::pair<int64_t, int64_t> getRowGroupRegion(uint32_t index) const;
 
+  /// Appends to 'ranges' the rows of the current row group for which the
+  /// filter in 'scanSpec' can't have hits according to the page index.
+  void filterPages(
+      const common::ScanSpec& scanSpec,
+      std::vector<RowRange>& ranges) const;
+
+  /// Returns true if the filter of the column can be tested against the Bloom
+  /// filter of its ColumnChunk in 'rowGroupId'.
+  bool hasBloomFilter(uint32_t rowGroupId) const;
+
+  /// Returns false if no value passing the filter of the column can be in
+  /// 'bloomFilter'.
+  bool testBloomFilter(const SplitBlockBloomFilter& bloomFilter) const;
+
+  /// Returns true if the filter of the column can be tested against the
+  /// dictionary page of its ColumnChunk in 'rowGroupId', i.e. all the data
+  /// pages are dictionary encoded and nulls do not pass the filter.
+  bool hasDictionaryFilter(uint32_t rowGroupId) const;
+
+  /// Returns false if no entry of the dictionary page in 'data' passes the
+  /// filter of the column. 'data' starts at the dictionary page of the
+  /// ColumnChunk in 'rowGroupId'.
+  bool testDictionary(uint32_t rowGroupId, std::string_view data) const;
+
+  /// Index of the ColumnChunk of the column in a row group.
+  uint32_t column() const {
+    return type_->column();
+  }
+
  private:
   /// True if 'filter' may have hits for the column of 'this' according to the
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  // Returns the file offset of the first page of 'chunk'.
+  static uint64_t chunkReadOffset(const ColumnChunkMetaDataPtr& chunk);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
+  const common::ScanSpec& scanSpec_;
+  const PageReadAheadOptions readAhead_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Streams for the OffsetIndex and ColumnIndex of this column in each of
+  // 'rowGroups_'. Null if the file has no page index for the column or if the
+  // ColumnIndex is not needed for filtering.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
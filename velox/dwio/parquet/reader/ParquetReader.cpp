@@ -18,7 +18,10 @@
 
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/common/base/AsyncSource.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
@@ -26,6 +29,26 @@ namespace facebook::velox::parquet {
 
 using dwio::common::ColumnSelector;
 
+namespace {
+// Footer of a Parquet file and the Bloom filters read with it. May be shared
+// by the readers of the file through a FileMetadataCache.
+struct FileTail : public cache::FileMetadata {
+  uint64_t memoryUsage() const override {
+    // The parsed footer is estimated at a few times its serialized size.
+    return sizeof(*this) + 3 * footerLength + bloomFilterBuffer.size();
+  }
+
+  thrift::FileMetaData fileMetaData;
+  uint64_t footerLength{0};
+  // File offset of the footer.
+  uint64_t footerOffset{0};
+  // The Bloom filters in the tail of the file read with the footer and the
+  // file offset of the first of them.
+  std::vector<char> bloomFilterBuffer;
+  uint64_t bloomFilterBufferOffset{0};
+};
+} // namespace
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -33,7 +56,9 @@ class ReaderBase {
       std::unique_ptr<dwio::common::BufferedInput>,
       const dwio::common::ReaderOptions& options);
 
-  virtual ~ReaderBase() = default;
+  virtual ~ReaderBase() {
+    cancelRowGroupLoads();
+  }
 
   memory::MemoryPool& getMemoryPool() const {
     return pool_;
@@ -52,7 +77,7 @@ class ReaderBase {
   }
 
   FileMetaDataPtr fileMetaData() const {
-    return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_.get()));
+    return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_));
   }
 
   const std::shared_ptr<const RowType>& schema() const {
@@ -74,6 +99,11 @@ class ReaderBase {
       int32_t currentGroup,
       StructColumnReader& reader);
 
+  /// Stops the loads of row groups started by scheduleRowGroups() that have
+  /// not started and waits for the ones in progress. Called when the reading
+  /// ends before all the row groups are read.
+  void cancelRowGroupLoads();
+
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row group.
   int64_t rowGroupUncompressedSize(
@@ -84,10 +114,27 @@ class ReaderBase {
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
+  /// Reads the Bloom filters of the ColumnChunks given as pairs of row group
+  /// and column index. The filters read together with the footer are not read
+  /// again and the others are read in one coalesced load. An element of the
+  /// result is nullptr if the filter is not supported.
+  std::vector<std::unique_ptr<SplitBlockBloomFilter>> loadBloomFilters(
+      const std::vector<std::pair<uint32_t, uint32_t>>& columnChunks) const;
+
+  /// Reads the dictionary pages of the ColumnChunks given as pairs of row
+  /// group and column index in one coalesced load. An element of the result
+  /// is empty if the ColumnChunk has no dictionary page before its first data
+  /// page.
+  std::vector<std::string> loadDictionaryPages(
+      const std::vector<std::pair<uint32_t, uint32_t>>& columnChunks) const;
+
  private:
-  // Reads and parses file footer.
+  // Sets 'tail_' from the FileMetadataCache or from the file.
   void loadFileMetaData();
 
+  // Reads and parses the file footer.
+  std::shared_ptr<const FileTail> readFileTail() const;
+
   void initializeSchema();
 
   std::shared_ptr<const ParquetTypeWithId> getParquetColumnInfo(
@@ -112,15 +159,33 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const FileTail> tail_;
+  // The footer in 'tail_'.
+  const thrift::FileMetaData* fileMetaData_{nullptr};
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
   const bool binaryAsString = false;
 
+  // Returns true if a row group of 'bytes' can be loaded ahead of use
+  // without going over the capacity of the memory pool.
+  bool canLoadAhead(uint64_t bytes) const;
+
+  // Waits for the load of 'rowGroup' if it is loading on the IO executor.
+  void waitForRowGroup(uint32_t rowGroup);
+
+  // Load of a row group on the IO executor.
+  struct RowGroupLoad {
+    std::shared_ptr<AsyncSource<bool>> source;
+    uint64_t bytes;
+  };
+
   // Map from row group index to pre-created loading BufferedInput.
   std::unordered_map<uint32_t, std::shared_ptr<dwio::common::BufferedInput>>
       inputs_;
+
+  // Row groups in 'inputs_' that are loading on the IO executor.
+  std::unordered_map<uint32_t, RowGroupLoad> loads_;
 };
 
 ReaderBase::ReaderBase(
@@ -140,6 +205,23 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* metadataCache = options_.getFileMetadataCache();
+  std::string cacheKey;
+  if (metadataCache != nullptr) {
+    cacheKey = fmt::format("parquet:{}", options_.getFileMetadataKey());
+    tail_ = std::dynamic_pointer_cast<const FileTail>(
+        metadataCache->find(cacheKey));
+  }
+  if (tail_ == nullptr) {
+    tail_ = readFileTail();
+    if (metadataCache != nullptr) {
+      metadataCache->insert(cacheKey, tail_);
+    }
+  }
+  fileMetaData_ = &tail_->fileMetaData;
+}
+
+std::shared_ptr<const FileTail> ReaderBase::readFileTail() const {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -186,8 +268,34 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto tail = std::make_shared<FileTail>();
+  tail->fileMetaData.read(thriftProtocol.get());
+  tail->footerLength = footerLength;
+  tail->footerOffset = fileLength_ - footerLength - 8;
+
+  // Writers put the Bloom filters right before the page index and the footer.
+  // Keeps the ones that were read with the footer.
+  if (footerOffsetInBuffer > 0) {
+    const uint64_t bufferOffset = fileLength_ - readSize;
+    uint64_t bloomFilterOffset = tail->footerOffset;
+    for (const auto& rowGroup : tail->fileMetaData.row_groups) {
+      for (const auto& column : rowGroup.columns) {
+        if (column.__isset.meta_data &&
+            column.meta_data.__isset.bloom_filter_offset &&
+            column.meta_data.bloom_filter_offset >= bufferOffset) {
+          bloomFilterOffset = std::min<uint64_t>(
+              bloomFilterOffset, column.meta_data.bloom_filter_offset);
+        }
+      }
+    }
+    if (bloomFilterOffset < tail->footerOffset) {
+      tail->bloomFilterBuffer.assign(
+          copy.begin() + (bloomFilterOffset - bufferOffset),
+          copy.begin() + footerOffsetInBuffer);
+      tail->bloomFilterBufferOffset = bloomFilterOffset;
+    }
+  }
+  return tail;
 }
 
 void ReaderBase::initializeSchema() {
@@ -596,18 +704,69 @@ void ReaderBase::scheduleRowGroups(
   auto numRowGroupsToLoad = std::min(
       options_.prefetchRowGroups() + 1,
       static_cast<int64_t>(rowGroupIds.size() - currentGroup));
+  const auto& executor = options_.getIOExecutor();
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
-    if (!inputs_[thisGroup]) {
+    if (inputs_.count(thisGroup)) {
+      continue;
+    }
+    if (i == 0 || executor == nullptr) {
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
+      continue;
+    }
+    // The next row groups load on the IO executor while the current one is
+    // read, if memory allows. Otherwise they load when they become current.
+    const auto bytes = reader.rowGroupBytes(thisGroup);
+    if (!canLoadAhead(bytes)) {
+      break;
     }
+    auto input = reader.loadRowGroup(thisGroup, input_, false);
+    inputs_[thisGroup] = input;
+    if (input == input_) {
+      continue;
+    }
+    auto source = std::make_shared<AsyncSource<bool>>([input]() {
+      input->load(dwio::common::LogType::STRIPE);
+      return std::make_unique<bool>(true);
+    });
+    executor->add([source]() { source->prepare(); });
+    loads_[thisGroup] = {std::move(source), bytes};
   }
+  waitForRowGroup(rowGroupIds[currentGroup]);
 
   if (currentGroup >= 1) {
     inputs_.erase(rowGroupIds[currentGroup - 1]);
   }
 }
 
+bool ReaderBase::canLoadAhead(uint64_t bytes) const {
+  for (const auto& [_, load] : loads_) {
+    bytes += load.bytes;
+  }
+  const auto* root = pool_.root();
+  return root->reservedBytes() + static_cast<int64_t>(bytes) <=
+      root->maxCapacity();
+}
+
+void ReaderBase::waitForRowGroup(uint32_t rowGroup) {
+  auto it = loads_.find(rowGroup);
+  if (it == loads_.end()) {
+    return;
+  }
+  auto source = std::move(it->second.source);
+  loads_.erase(it);
+  // Loads on this thread if the executor has not started the load.
+  source->move();
+}
+
+void ReaderBase::cancelRowGroupLoads() {
+  for (auto& [rowGroup, load] : loads_) {
+    load.source->close();
+    inputs_.erase(rowGroup);
+  }
+  loads_.clear();
+}
+
 int64_t ReaderBase::rowGroupUncompressedSize(
     int32_t rowGroupIndex,
     const dwio::common::TypeWithId& type) const {
@@ -627,6 +786,132 @@ bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return inputs_.count(rowGroupIndex) != 0;
 }
 
+std::vector<std::unique_ptr<SplitBlockBloomFilter>>
+ReaderBase::loadBloomFilters(
+    const std::vector<std::pair<uint32_t, uint32_t>>& columnChunks) const {
+  // The metadata doesn't give the size of a Bloom filter. It ends at the next
+  // structure in the file, which is a column chunk, a page index, another
+  // Bloom filter or the footer.
+  std::vector<uint64_t> boundaries{tail_->footerOffset};
+  for (const auto& rowGroup : fileMetaData_->row_groups) {
+    for (const auto& column : rowGroup.columns) {
+      const auto& metadata = column.meta_data;
+      boundaries.push_back(metadata.data_page_offset);
+      if (metadata.__isset.dictionary_page_offset) {
+        boundaries.push_back(metadata.dictionary_page_offset);
+      }
+      if (metadata.__isset.bloom_filter_offset) {
+        boundaries.push_back(metadata.bloom_filter_offset);
+      }
+      if (column.__isset.column_index_offset) {
+        boundaries.push_back(column.column_index_offset);
+      }
+      if (column.__isset.offset_index_offset) {
+        boundaries.push_back(column.offset_index_offset);
+      }
+    }
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+
+  const auto numFilters = columnChunks.size();
+  std::vector<velox::common::Region> regions(numFilters);
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams(
+      numFilters);
+  std::unique_ptr<dwio::common::BufferedInput> input;
+  for (auto i = 0; i < numFilters; ++i) {
+    const auto& [rowGroup, column] = columnChunks[i];
+    const auto& metadata =
+        fileMetaData_->row_groups[rowGroup].columns[column].meta_data;
+    VELOX_CHECK(metadata.__isset.bloom_filter_offset);
+    const uint64_t offset = metadata.bloom_filter_offset;
+    auto end = std::upper_bound(boundaries.begin(), boundaries.end(), offset);
+    if (offset >= tail_->footerOffset || end == boundaries.end()) {
+      continue;
+    }
+    regions[i] = {offset, *end - offset};
+    if (!tail_->bloomFilterBuffer.empty() &&
+        offset >= tail_->bloomFilterBufferOffset) {
+      continue;
+    }
+    if (!input) {
+      input = input_->clone();
+    }
+    streams[i] = input->enqueue(regions[i]);
+  }
+  if (input) {
+    input->load(dwio::common::LogType::FOOTER);
+  }
+
+  std::vector<std::unique_ptr<SplitBlockBloomFilter>> bloomFilters(numFilters);
+  std::vector<char> buffer;
+  for (auto i = 0; i < numFilters; ++i) {
+    const auto& region = regions[i];
+    if (region.length == 0) {
+      continue;
+    }
+    const char* data;
+    if (streams[i]) {
+      buffer.resize(region.length);
+      const char* bufferStart = nullptr;
+      const char* bufferEnd = nullptr;
+      dwio::common::readBytes(
+          region.length,
+          streams[i].get(),
+          buffer.data(),
+          bufferStart,
+          bufferEnd);
+      data = buffer.data();
+    } else {
+      data = tail_->bloomFilterBuffer.data() +
+          (region.offset - tail_->bloomFilterBufferOffset);
+    }
+    bloomFilters[i] = SplitBlockBloomFilter::deserialize(data, region.length);
+  }
+  return bloomFilters;
+}
+
+std::vector<std::string> ReaderBase::loadDictionaryPages(
+    const std::vector<std::pair<uint32_t, uint32_t>>& columnChunks) const {
+  const auto numChunks = columnChunks.size();
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams(
+      numChunks);
+  std::vector<uint64_t> lengths(numChunks);
+  std::unique_ptr<dwio::common::BufferedInput> input;
+  for (auto i = 0; i < numChunks; ++i) {
+    const auto& [rowGroup, column] = columnChunks[i];
+    const auto& metadata =
+        fileMetaData_->row_groups[rowGroup].columns[column].meta_data;
+    VELOX_CHECK(metadata.__isset.dictionary_page_offset);
+    // The dictionary page is the first page of the ColumnChunk and is
+    // followed by the first data page.
+    const auto offset = metadata.dictionary_page_offset;
+    if (offset < 4 || offset >= metadata.data_page_offset) {
+      continue;
+    }
+    lengths[i] = metadata.data_page_offset - offset;
+    if (!input) {
+      input = input_->clone();
+    }
+    streams[i] = input->enqueue({static_cast<uint64_t>(offset), lengths[i]});
+  }
+  if (input) {
+    input->load(dwio::common::LogType::STREAM_BUNDLE);
+  }
+
+  std::vector<std::string> pages(numChunks);
+  for (auto i = 0; i < numChunks; ++i) {
+    if (!streams[i]) {
+      continue;
+    }
+    pages[i].resize(lengths[i]);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        lengths[i], streams[i].get(), pages[i].data(), bufferStart, bufferEnd);
+  }
+  return pages;
+}
+
 namespace {
 struct ParquetStatsContext : dwio::common::StatsContext {};
 } // namespace
@@ -661,7 +946,12 @@ class ParquetRowReader::Impl {
       return; // TODO
     }
     ParquetParams params(
-        pool_, columnReaderStats_, readerBase_->fileMetaData());
+        pool_,
+        columnReaderStats_,
+        readerBase_->fileMetaData(),
+        {.executor = options_.getDecodingExecutor().get(),
+         .numPages = options_.getPageReadAhead(),
+         .maxBytes = options_.getMaxPageReadAheadBytes()});
     auto columnSelector = std::make_shared<ColumnSelector>(
         ColumnSelector::apply(options_.getSelector(), readerBase_->schema()));
     columnReader_ = ParquetColumnReader::build(
@@ -669,6 +959,16 @@ class ParquetRowReader::Impl {
         readerBase_->schemaWithId(), // Id is schema id
         params,
         *options_.getScanSpec());
+    if (options_.getDecodingExecutor() &&
+        options_.getDecodingParallelismFactor() > 1) {
+      if (auto* root =
+              dynamic_cast<dwio::common::SelectiveStructColumnReaderBase*>(
+                  columnReader_.get())) {
+        root->setDecodingExecutor(
+            options_.getDecodingExecutor().get(),
+            options_.getDecodingParallelismFactor());
+      }
+    }
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
@@ -679,6 +979,11 @@ class ParquetRowReader::Impl {
     }
   }
 
+  ~Impl() {
+    // The row groups loading ahead are not needed if the reading stops early.
+    readerBase_->cancelRowGroupLoads();
+  }
+
   void filterRowGroups() {
     rowGroupIds_.reserve(rowGroups_.size());
     firstRowOfRowGroup_.reserve(rowGroups_.size());
@@ -714,12 +1019,98 @@ class ParquetRowReader::Impl {
       }
       rowNumber += rowGroups_[i].num_rows;
     }
+    filterRowGroupsWithBloomFilters();
+    filterRowGroupsWithDictionaries();
+  }
+
+  // Removes the row groups in which the Bloom filter of a filtered column has
+  // none of the values that pass the filter.
+  void filterRowGroupsWithBloomFilters() {
+    std::vector<const ParquetData*> columns;
+    static_cast<StructColumnReader&>(*columnReader_)
+        .filteredLeafColumns(columns);
+    // Pairs of row group and column index, and the index in 'rowGroupIds_'
+    // and the column for each pair.
+    std::vector<std::pair<uint32_t, uint32_t>> columnChunks;
+    std::vector<std::pair<size_t, const ParquetData*>> probes;
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      for (const auto* column : columns) {
+        if (column->hasBloomFilter(rowGroupIds_[i])) {
+          columnChunks.emplace_back(rowGroupIds_[i], column->column());
+          probes.emplace_back(i, column);
+        }
+      }
+    }
+    if (columnChunks.empty()) {
+      return;
+    }
+
+    const auto bloomFilters = readerBase_->loadBloomFilters(columnChunks);
+    std::vector<bool> excluded(rowGroupIds_.size());
+    for (auto i = 0; i < probes.size(); ++i) {
+      const auto& [index, column] = probes[i];
+      if (bloomFilters[i] && !column->testBloomFilter(*bloomFilters[i])) {
+        excluded[index] = true;
+      }
+    }
+    removeRowGroups(excluded);
+  }
+
+  // Removes the row groups in which no entry of the dictionary of a filtered
+  // and fully dictionary encoded column passes the filter.
+  void filterRowGroupsWithDictionaries() {
+    std::vector<const ParquetData*> columns;
+    static_cast<StructColumnReader&>(*columnReader_)
+        .filteredLeafColumns(columns);
+    std::vector<std::pair<uint32_t, uint32_t>> columnChunks;
+    std::vector<std::pair<size_t, const ParquetData*>> probes;
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      for (const auto* column : columns) {
+        if (column->hasDictionaryFilter(rowGroupIds_[i])) {
+          columnChunks.emplace_back(rowGroupIds_[i], column->column());
+          probes.emplace_back(i, column);
+        }
+      }
+    }
+    if (columnChunks.empty()) {
+      return;
+    }
+
+    const auto pages = readerBase_->loadDictionaryPages(columnChunks);
+    std::vector<bool> excluded(rowGroupIds_.size());
+    for (auto i = 0; i < probes.size(); ++i) {
+      const auto& [index, column] = probes[i];
+      if (!excluded[index] && !pages[i].empty() &&
+          !column->testDictionary(rowGroupIds_[index], pages[i])) {
+        excluded[index] = true;
+      }
+    }
+    removeRowGroups(excluded);
+  }
+
+  // Removes the row groups for which 'excluded' is set from 'rowGroupIds_'.
+  void removeRowGroups(const std::vector<bool>& excluded) {
+    int32_t numRowGroups = 0;
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      if (!excluded[i]) {
+        rowGroupIds_[numRowGroups] = rowGroupIds_[i];
+        firstRowOfRowGroup_[numRowGroups] = firstRowOfRowGroup_[i];
+        ++numRowGroups;
+      }
+    }
+    rowGroupIds_.resize(numRowGroups);
+    firstRowOfRowGroup_.resize(numRowGroups);
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      if (!skipFilteredPages()) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -729,7 +1120,11 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    uint64_t endOfRead = rowsInCurrentRowGroup_;
+    if (nextSkippedRange_ < skippedRanges_.size()) {
+      endOfRead = skippedRanges_[nextSkippedRange_].begin;
+    }
+    return std::min(size, endOfRead - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -783,6 +1178,53 @@ class ParquetRowReader::Impl {
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    filterPages();
+    return true;
+  }
+
+  // Sets 'skippedRanges_' to the rows of the current row group that can't
+  // pass the filters according to the page index.
+  void filterPages() {
+    skippedRanges_.clear();
+    nextSkippedRange_ = 0;
+    if (!static_cast<StructColumnReader&>(*columnReader_)
+             .filterPages(skippedRanges_)) {
+      skippedRanges_.clear();
+      return;
+    }
+    if (skippedRanges_.empty()) {
+      return;
+    }
+    // Merge the overlapping ranges from different columns.
+    std::sort(
+        skippedRanges_.begin(),
+        skippedRanges_.end(),
+        [](const RowRange& left, const RowRange& right) {
+          return left.begin < right.begin;
+        });
+    int32_t numMerged = 0;
+    for (auto i = 1; i < skippedRanges_.size(); ++i) {
+      auto& last = skippedRanges_[numMerged];
+      if (skippedRanges_[i].begin <= last.end) {
+        last.end = std::max(last.end, skippedRanges_[i].end);
+      } else {
+        skippedRanges_[++numMerged] = skippedRanges_[i];
+      }
+    }
+    skippedRanges_.resize(numMerged + 1);
+  }
+
+  // Advances past the next skipped range if it starts at the current row.
+  // The column readers seek to the new position on the next read. Returns true
+  // if rows were skipped.
+  bool skipFilteredPages() {
+    if (nextSkippedRange_ == skippedRanges_.size() ||
+        skippedRanges_[nextSkippedRange_].begin >
+            static_cast<int64_t>(currentRowInGroup_)) {
+      return false;
+    }
+    currentRowInGroup_ = skippedRanges_[nextSkippedRange_++].end;
+    columnReader_->setReadOffset(currentRowInGroup_);
     return true;
   }
 
@@ -800,6 +1242,12 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Ranges of rows in the current row group that can't pass the filters
+  // according to the page index, sorted and non-overlapping.
+  std::vector<RowRange> skippedRanges_;
+  // Index of the first range in 'skippedRanges_' that is not skipped yet.
+  size_t nextSkippedRange_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   RowTypePtr requestedType_;
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h> // @manual
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// The odd constants that give the bit of each word of a block, from the
+// Parquet format.
+alignas(32) constexpr uint32_t kSalt[SplitBlockBloomFilter::kWordsPerBlock] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// Bytes of a Bloom filter bitset allowed by the Parquet format.
+constexpr int32_t kMaxBloomFilterBytes = 128 << 20;
+
+FOLLY_ALWAYS_INLINE uint32_t maskBit(uint32_t key, int32_t word) {
+  return 1U << ((key * kSalt[word]) >> 27);
+}
+
+bool mayContainAny(
+    const SplitBlockBloomFilter& bloomFilter,
+    const std::vector<int64_t>& values,
+    thrift::Type::type physicalType) {
+  for (auto value : values) {
+    if (physicalType == thrift::Type::INT32) {
+      // A value outside of the range of the physical type is not in the
+      // column.
+      if (value < std::numeric_limits<int32_t>::min() ||
+          value > std::numeric_limits<int32_t>::max()) {
+        continue;
+      }
+      if (bloomFilter.mayContain(
+              SplitBlockBloomFilter::hash(static_cast<int32_t>(value)))) {
+        return true;
+      }
+    } else if (bloomFilter.mayContain(SplitBlockBloomFilter::hash(value))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(int32_t numBytes)
+    : words_(
+          bits::roundUp(std::max(numBytes, kBytesPerBlock), kBytesPerBlock) /
+          sizeof(uint32_t)) {}
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(const char* data, int32_t numBytes)
+    : words_(numBytes / sizeof(uint32_t)) {
+  VELOX_CHECK_GT(numBytes, 0);
+  VELOX_CHECK_EQ(
+      numBytes % kBytesPerBlock,
+      0,
+      "Bloom filter bitset is not a whole number of blocks");
+  std::memcpy(words_.data(), data, numBytes);
+}
+
+// static
+std::unique_ptr<SplitBlockBloomFilter> SplitBlockBloomFilter::deserialize(
+    const char* data,
+    uint64_t size) {
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const auto headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    return nullptr;
+  }
+  VELOX_CHECK_GT(header.numBytes, 0);
+  VELOX_CHECK_LE(header.numBytes, kMaxBloomFilterBytes);
+  VELOX_CHECK_LE(
+      headerSize + header.numBytes,
+      size,
+      "Bloom filter bitset extends past its region of the file");
+  return std::make_unique<SplitBlockBloomFilter>(
+      data + headerSize, header.numBytes);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+void SplitBlockBloomFilter::insert(uint64_t hash) {
+  auto* block = words_.data() + blockOffset(hash);
+  const auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    block[i] |= maskBit(key, i);
+  }
+}
+
+bool SplitBlockBloomFilter::mayContain(uint64_t hash) const {
+  const auto* block = words_.data() + blockOffset(hash);
+  const auto key = static_cast<uint32_t>(hash);
+#if XSIMD_WITH_AVX2
+  // Computes the bit of each of the 8 words at once and checks they are all
+  // set in the block.
+  const auto salt = _mm256_load_si256(reinterpret_cast<const __m256i*>(kSalt));
+  const auto shifts =
+      _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salt), 27);
+  const auto mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+  const auto bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  return _mm256_testc_si256(bits, mask);
+#else
+  uint32_t missing = 0;
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    missing |= ~block[i] & maskBit(key, i);
+  }
+  return missing == 0;
+#endif
+}
+
+// static
+bool SplitBlockBloomFilter::canTestFilter(
+    const common::Filter& filter,
+    thrift::Type::type physicalType,
+    TypeKind kind) {
+  // Nulls are not in the Bloom filter.
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      if (!static_cast<const common::BigintRange&>(filter).isSingleValue()) {
+        return false;
+      }
+      [[fallthrough]];
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      // Narrower types are excluded since their values are truncated on read
+      // and may not compare equal to the stored value.
+      return (physicalType == thrift::Type::INT32 &&
+              (kind == TypeKind::INTEGER || kind == TypeKind::BIGINT)) ||
+          (physicalType == thrift::Type::INT64 && kind == TypeKind::BIGINT);
+    case common::FilterKind::kBytesRange:
+      if (!static_cast<const common::BytesRange&>(filter).isSingleValue()) {
+        return false;
+      }
+      [[fallthrough]];
+    case common::FilterKind::kBytesValues:
+      return physicalType == thrift::Type::BYTE_ARRAY &&
+          (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY);
+    default:
+      return false;
+  }
+}
+
+bool SplitBlockBloomFilter::testFilter(
+    const common::Filter& filter,
+    thrift::Type::type physicalType,
+    TypeKind kind) const {
+  if (!canTestFilter(filter, physicalType, kind)) {
+    return true;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return mayContainAny(
+          *this,
+          {static_cast<const common::BigintRange&>(filter).lower()},
+          physicalType);
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      return mayContainAny(
+          *this,
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values(),
+          physicalType);
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return mayContainAny(
+          *this,
+          static_cast<const common::BigintValuesUsingBitmask&>(filter).values(),
+          physicalType);
+    case common::FilterKind::kBytesRange:
+      return mayContain(
+          hash(static_cast<const common::BytesRange&>(filter).lower()));
+    case common::FilterKind::kBytesValues:
+      for (const auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        if (mayContain(hash(value))) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace facebook::velox::parquet
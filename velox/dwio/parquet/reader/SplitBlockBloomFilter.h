@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter of a ColumnChunk as defined by the Parquet format.
+/// The bitset is made of blocks of 8 32 bit words. A value is hashed with
+/// XXH64 over its plain encoding. The high 32 bits of the hash select the
+/// block and the low 32 bits select one bit in each word of the block.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kWordsPerBlock = 8;
+  static constexpr int32_t kBytesPerBlock = kWordsPerBlock * sizeof(uint32_t);
+
+  /// Makes an empty filter of 'numBytes' rounded up to a whole block.
+  explicit SplitBlockBloomFilter(int32_t numBytes);
+
+  /// Makes a filter over a copy of the serialized bitset in 'data'.
+  SplitBlockBloomFilter(const char* data, int32_t numBytes);
+
+  /// Deserializes the BloomFilterHeader and the bitset that follows it from
+  /// the 'size' bytes at 'data'. Returns nullptr if the algorithm, hash or
+  /// compression of the filter is not supported.
+  static std::unique_ptr<SplitBlockBloomFilter> deserialize(
+      const char* data,
+      uint64_t size);
+
+  /// Hashes of the plain encoding of 'value'.
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(std::string_view value);
+
+  void insert(uint64_t hash);
+
+  bool mayContain(uint64_t hash) const;
+
+  /// Returns false if no non-null value passing 'filter' can be in the
+  /// ColumnChunk. 'physicalType' is the Parquet type and 'kind' the Velox
+  /// type of the column. Returns true if 'filter' is not a set of discrete
+  /// values that can be probed.
+  bool testFilter(
+      const common::Filter& filter,
+      thrift::Type::type physicalType,
+      TypeKind kind) const;
+
+  /// Returns true if the values passing 'filter' can be probed with
+  /// testFilter().
+  static bool canTestFilter(
+      const common::Filter& filter,
+      thrift::Type::type physicalType,
+      TypeKind kind);
+
+  int32_t numBytes() const {
+    return words_.size() * sizeof(uint32_t);
+  }
+
+  const uint32_t* words() const {
+    return words_.data();
+  }
+
+ private:
+  // Returns the index in 'words_' of the first word of the block of 'hash'.
+  uint64_t blockOffset(uint64_t hash) const {
+    const uint64_t numBlocks = words_.size() / kWordsPerBlock;
+    return ((hash >> 32) * numBlocks >> 32) * kWordsPerBlock;
+  }
+
+  std::vector<uint32_t> words_;
+};
+
+} // namespace facebook::velox::parquet
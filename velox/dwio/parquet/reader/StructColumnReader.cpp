@@ -105,17 +105,25 @@ void StructColumnReader::read(
 
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
-    const std::shared_ptr<dwio::common::BufferedInput>& input) {
+    const std::shared_ptr<dwio::common::BufferedInput>& input,
+    bool load) {
   if (isRowGroupBuffered(index, *input)) {
     enqueueRowGroup(index, *input);
     return input;
   }
   auto newInput = input->clone();
   enqueueRowGroup(index, *newInput);
-  newInput->load(dwio::common::LogType::STRIPE);
+  if (load) {
+    newInput->load(dwio::common::LogType::STRIPE);
+  }
   return newInput;
 }
 
+uint64_t StructColumnReader::rowGroupBytes(uint32_t index) {
+  return static_cast<uint64_t>(
+      formatData().as<ParquetData>().getRowGroupRegion(index).second);
+}
+
 bool StructColumnReader::isRowGroupBuffered(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -188,6 +196,48 @@ void StructColumnReader::setNullsFromRepDefs(PageReader& pageReader) {
   formatData_->as<ParquetData>().setNulls(nullsInReadRange(), numStructs);
 }
 
+bool StructColumnReader::filterPages(std::vector<RowRange>& ranges) const {
+  for (const auto* child : children_) {
+    if (!child) {
+      continue;
+    }
+    switch (child->fileType().type()->kind()) {
+      case TypeKind::ROW:
+      case TypeKind::ARRAY:
+      case TypeKind::MAP:
+        return false;
+      default:
+        child->formatData().as<ParquetData>().filterPages(
+            *child->scanSpec(), ranges);
+        break;
+    }
+  }
+  return true;
+}
+
+void StructColumnReader::filteredLeafColumns(
+    std::vector<const ParquetData*>& columns) const {
+  for (const auto* child : children_) {
+    if (!child) {
+      continue;
+    }
+    switch (child->fileType().type()->kind()) {
+      case TypeKind::ROW:
+        static_cast<const StructColumnReader*>(child)->filteredLeafColumns(
+            columns);
+        break;
+      case TypeKind::ARRAY:
+      case TypeKind::MAP:
+        break;
+      default:
+        if (child->scanSpec()->filter()) {
+          columns.push_back(&child->formatData().as<ParquetData>());
+        }
+        break;
+    }
+  }
+}
+
 void StructColumnReader::filterRowGroups(
     uint64_t rowGroupSize,
     const dwio::common::StatsContext& context,
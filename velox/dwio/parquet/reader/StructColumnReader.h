@@ -27,7 +27,9 @@ namespace facebook::velox::parquet {
 
 enum class LevelMode;
 class PageReader;
+class ParquetData;
 class ParquetParams;
+struct RowRange;
 
 class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  public:
@@ -44,10 +46,15 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
-  /// the streams in a new input and loads.
+  /// the streams in a new input and loads it if 'load' is true.
   std::shared_ptr<dwio::common::BufferedInput> loadRowGroup(
       uint32_t index,
-      const std::shared_ptr<dwio::common::BufferedInput>& input);
+      const std::shared_ptr<dwio::common::BufferedInput>& input,
+      bool load = true);
+
+  /// Returns the number of bytes of the file that loadRowGroup() reads for
+  /// row group 'index'.
+  uint64_t rowGroupBytes(uint32_t index);
 
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
@@ -75,6 +82,17 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       const dwio::common::StatsContext&,
       dwio::common::FormatData::FilterRowGroupsResult&) const override;
 
+  /// Appends to 'ranges' the rows of the current row group for which some
+  /// filter on a child can't have hits according to the page index. Returns
+  /// false if rows of the row group can't be skipped, e.g. if there are
+  /// complex type children that read repdefs ahead.
+  bool filterPages(std::vector<RowRange>& ranges) const;
+
+  /// Appends to 'columns' the leaf columns under 'this' and its struct
+  /// children that have a filter. Their row groups may be pruned with Bloom
+  /// filters.
+  void filteredLeafColumns(std::vector<const ParquetData*>& columns) const;
+
  private:
   dwio::common::SelectiveColumnReader* findBestLeaf();
 
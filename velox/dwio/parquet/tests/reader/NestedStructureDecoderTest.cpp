@@ -266,3 +266,82 @@ TEST_F(NestedStructureDecoderTest, emptyRowAtEnd) {
   assertStructure(
       defs, reps, 4, 3, 2, expectedOffsets, expectedLengths, expectedNulls);
 }
+
+TEST_F(NestedStructureDecoderTest, nonNullListLengths) {
+  // ARRAY<INTEGER> with list lengths 1, 2, 3, ... and a nullable element, so
+  // that a present element has definition level 2.
+  std::vector<int16_t> defs;
+  std::vector<int16_t> reps;
+  std::vector<int32_t> expectedLengths;
+  for (auto length = 1; length <= 40; ++length) {
+    for (auto i = 0; i < length; ++i) {
+      defs.push_back(i % 3 == 0 ? 3 : 2);
+      reps.push_back(i == 0 ? 0 : 1);
+    }
+    expectedLengths.push_back(length);
+  }
+  const int32_t numValues = defs.size();
+  std::vector<int32_t> lengths(expectedLengths.size());
+  ASSERT_EQ(
+      NestedStructureDecoder::readNonNullListLengths(
+          defs.data(),
+          reps.data(),
+          numValues,
+          2,
+          lengths.size(),
+          lengths.data()),
+      static_cast<int32_t>(expectedLengths.size()));
+  EXPECT_EQ(lengths, expectedLengths);
+
+  // Fewer levels than a batch.
+  ASSERT_EQ(
+      NestedStructureDecoder::readNonNullListLengths(
+          defs.data(), reps.data(), 6, 2, lengths.size(), lengths.data()),
+      3);
+  EXPECT_EQ(lengths[0], 1);
+  EXPECT_EQ(lengths[1], 2);
+  EXPECT_EQ(lengths[2], 3);
+
+  // More lists than 'maxLists'.
+  EXPECT_EQ(
+      NestedStructureDecoder::readNonNullListLengths(
+          defs.data(), reps.data(), numValues, 2, 39, lengths.data()),
+      -1);
+
+  // An empty list.
+  auto emptyDefs = defs;
+  emptyDefs[numValues - 20] = 1;
+  EXPECT_EQ(
+      NestedStructureDecoder::readNonNullListLengths(
+          emptyDefs.data(),
+          reps.data(),
+          numValues,
+          2,
+          lengths.size(),
+          lengths.data()),
+      -1);
+
+  // A nested list.
+  auto nestedReps = reps;
+  nestedReps[numValues - 1] = 2;
+  EXPECT_EQ(
+      NestedStructureDecoder::readNonNullListLengths(
+          defs.data(),
+          nestedReps.data(),
+          numValues,
+          2,
+          lengths.size(),
+          lengths.data()),
+      -1);
+
+  // Levels that continue a list.
+  EXPECT_EQ(
+      NestedStructureDecoder::readNonNullListLengths(
+          defs.data() + 2,
+          reps.data() + 2,
+          numValues - 2,
+          2,
+          lengths.size(),
+          lengths.data()),
+      -1);
+}
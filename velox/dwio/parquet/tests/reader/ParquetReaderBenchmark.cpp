@@ -41,7 +41,9 @@ class ParquetReaderBenchmark {
  public:
   explicit ParquetReaderBenchmark(
       bool disableDictionary,
-      const RowTypePtr& rowType)
+      const RowTypePtr& rowType,
+      std::optional<facebook::velox::parquet::arrow::Encoding::type>
+          encoding = std::nullopt)
       : disableDictionary_(disableDictionary) {
     rootPool_ = memory::memoryManager()->addRootPool("ParquetReaderBenchmark");
     leafPool_ = rootPool_->addLeafChild("ParquetReaderBenchmark");
@@ -55,6 +57,9 @@ class ParquetReaderBenchmark {
       // The parquet file is in plain encoding format.
       options.enableDictionary = false;
     }
+    if (encoding.has_value()) {
+      options.encoding = encoding.value();
+    }
     options.memoryPool = rootPool_.get();
     writer_ = std::make_unique<facebook::velox::parquet::Writer>(
         std::move(sink), options, rowType);
@@ -280,6 +285,20 @@ void run(
       columnName, type, 0, filterRateX100, nullsRateX100, nextSize);
 }
 
+// Reads a column without dictionary encoded with 'encoding'.
+void runWithEncoding(
+    uint32_t,
+    const std::string& columnName,
+    const TypePtr& type,
+    float filterRateX100,
+    uint8_t nullsRateX100,
+    facebook::velox::parquet::arrow::Encoding::type encoding) {
+  RowTypePtr rowType = ROW({columnName}, {type});
+  ParquetReaderBenchmark benchmark(true, rowType, encoding);
+  benchmark.readSingleColumn(
+      columnName, type, 0, filterRateX100, nullsRateX100, 10000);
+}
+
 #define PARQUET_BENCHMARKS_FILTER_NULLS(_type_, _name_, _filter_, _null_) \
   BENCHMARK_NAMED_PARAM(                                                  \
       run,                                                                \
@@ -401,6 +420,39 @@ PARQUET_BENCHMARKS(DOUBLE(), Double);
 PARQUET_BENCHMARKS_NO_FILTER(MAP(BIGINT(), BIGINT()), Map);
 PARQUET_BENCHMARKS_NO_FILTER(ARRAY(BIGINT()), List);
 
+// Compares the decoders of 'encoding' to PLAIN.
+#define PARQUET_ENCODING_BENCHMARKS_NULLS(                                  \
+    _type_, _name_, _encoding_, _filter_, _null_)                           \
+  BENCHMARK_NAMED_PARAM(                                                    \
+      runWithEncoding,                                                      \
+      _name_##_##_encoding_##_Filter_##_filter_##_Nulls_##_null_##_plain,   \
+      #_name_,                                                              \
+      _type_,                                                               \
+      _filter_,                                                             \
+      _null_,                                                               \
+      facebook::velox::parquet::arrow::Encoding::PLAIN);                    \
+  BENCHMARK_RELATIVE_NAMED_PARAM(                                           \
+      runWithEncoding,                                                      \
+      _name_##_##_encoding_##_Filter_##_filter_##_Nulls_##_null_##_encoded, \
+      #_name_,                                                              \
+      _type_,                                                               \
+      _filter_,                                                             \
+      _null_,                                                               \
+      facebook::velox::parquet::arrow::Encoding::_encoding_);               \
+  BENCHMARK_DRAW_LINE();
+
+#define PARQUET_ENCODING_BENCHMARKS(_type_, _name_, _encoding_)          \
+  PARQUET_ENCODING_BENCHMARKS_NULLS(_type_, _name_, _encoding_, 100, 0)  \
+  PARQUET_ENCODING_BENCHMARKS_NULLS(_type_, _name_, _encoding_, 100, 20) \
+  PARQUET_ENCODING_BENCHMARKS_NULLS(_type_, _name_, _encoding_, 20, 0)   \
+  PARQUET_ENCODING_BENCHMARKS_NULLS(_type_, _name_, _encoding_, 20, 20)  \
+  BENCHMARK_DRAW_LINE();
+
+PARQUET_ENCODING_BENCHMARKS(BIGINT(), BigInt, DELTA_BINARY_PACKED);
+PARQUET_ENCODING_BENCHMARKS(DOUBLE(), Double, BYTE_STREAM_SPLIT);
+PARQUET_ENCODING_BENCHMARKS(VARCHAR(), Varchar, DELTA_LENGTH_BYTE_ARRAY);
+PARQUET_ENCODING_BENCHMARKS(VARCHAR(), Varchar, DELTA_BYTE_ARRAY);
+
 // TODO: Add all data types
 
 int main(int argc, char** argv) {
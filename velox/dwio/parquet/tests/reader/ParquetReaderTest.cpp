@@ -14,7 +14,14 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+#include <fstream>
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
@@ -61,6 +68,78 @@ class ParquetReaderTest : public ParquetTestBase {
     assertReadWithReaderAndFilters(
         std::move(reader), fileName, fileSchema, std::move(filters), expected);
   }
+
+  // Rewrites the Parquet file at 'path' to add a Bloom filter of the values in
+  // 'data' to each ColumnChunk. The Bloom filters are placed between the last
+  // row group and the footer like writers do.
+  static void addBloomFilters(const std::string& path, const RowVectorPtr& data) {
+    std::string file;
+    {
+      std::ifstream in(path, std::ios::binary);
+      file.assign(
+          std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const auto footerLength =
+        *reinterpret_cast<const uint32_t*>(file.data() + file.size() - 8);
+    const auto footerOffset = file.size() - 8 - footerLength;
+    thrift::FileMetaData fileMetaData;
+    {
+      auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+          file.data() + footerOffset, footerLength);
+      apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+          protocol(transport);
+      fileMetaData.read(&protocol);
+    }
+    file.resize(footerOffset);
+
+    auto serialize = [&](const auto& thriftObject) {
+      auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+      apache::thrift::protocol::TCompactProtocolT<
+          apache::thrift::transport::TMemoryBuffer>
+          protocol(buffer);
+      thriftObject.write(&protocol);
+      file += buffer->getBufferAsString();
+    };
+
+    vector_size_t firstRow = 0;
+    for (auto& rowGroup : fileMetaData.row_groups) {
+      for (auto column = 0; column < rowGroup.columns.size(); ++column) {
+        SplitBlockBloomFilter bloomFilter(1'024);
+        auto* values = data->childAt(column).get();
+        for (auto row = firstRow; row < firstRow + rowGroup.num_rows; ++row) {
+          if (auto* bigints = values->asFlatVector<int64_t>()) {
+            bloomFilter.insert(
+                SplitBlockBloomFilter::hash(bigints->valueAt(row)));
+          } else {
+            bloomFilter.insert(SplitBlockBloomFilter::hash(std::string_view(
+                values->asFlatVector<StringView>()->valueAt(row))));
+          }
+        }
+        rowGroup.columns[column].meta_data.__set_bloom_filter_offset(
+            file.size());
+        thrift::BloomFilterHeader header;
+        header.__set_numBytes(bloomFilter.numBytes());
+        header.algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+        header.hash.__set_XXHASH(thrift::XxHash());
+        header.compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+        serialize(header);
+        file.append(
+            reinterpret_cast<const char*>(bloomFilter.words()),
+            bloomFilter.numBytes());
+      }
+      firstRow += rowGroup.num_rows;
+    }
+
+    const auto newFooterOffset = file.size();
+    serialize(fileMetaData);
+    const uint32_t newFooterLength = file.size() - newFooterOffset;
+    file.append(
+        reinterpret_cast<const char*>(&newFooterLength),
+        sizeof(newFooterLength));
+    file += "PAR1";
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(file.data(), file.size());
+  }
 };
 
 TEST_F(ParquetReaderTest, parseSample) {
@@ -893,6 +972,58 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+TEST_F(ParquetReaderTest, prefetchRowGroupsAsync) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+
+  auto readAll = [&](const std::shared_ptr<folly::Executor>& ioExecutor) {
+    facebook::velox::dwio::common::ReaderOptions readerOptions{
+        leafPool_.get()};
+    readerOptions.setFilePreloadThreshold(0);
+    readerOptions.setPrefetchRowGroups(2);
+    readerOptions.setIOExecutor(ioExecutor);
+    auto reader = createReader(sample, readerOptions);
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    std::vector<VectorPtr> batches;
+    VectorPtr result = BaseVector::create(rowType, 0, pool_.get());
+    while (rowReader->next(1'000, result)) {
+      batches.push_back(result);
+      result = BaseVector::create(rowType, 0, pool_.get());
+    }
+    return batches;
+  };
+
+  // The row groups loaded on the executor give the same result.
+  auto expected = readAll(nullptr);
+  auto actual = readAll(executor);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    facebook::velox::test::assertEqualVectors(expected[i], actual[i]);
+  }
+
+  // Stopping after the first batch drops the row groups loading ahead.
+  {
+    facebook::velox::dwio::common::ReaderOptions readerOptions{
+        leafPool_.get()};
+    readerOptions.setFilePreloadThreshold(0);
+    readerOptions.setPrefetchRowGroups(3);
+    readerOptions.setIOExecutor(executor);
+    auto reader = createReader(sample, readerOptions);
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto parquetRowReader = dynamic_cast<ParquetRowReader*>(rowReader.get());
+    VectorPtr result = BaseVector::create(rowType, 0, pool_.get());
+    ASSERT_GT(rowReader->next(1'000, result), 0);
+    EXPECT_TRUE(parquetRowReader->isRowGroupBuffered(1));
+    rowReader.reset();
+  }
+  executor->join();
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
@@ -918,3 +1049,414 @@ TEST_F(ParquetReaderTest, testEmptyRowGroups) {
 
   assertReadWithReaderAndExpected(fileSchema, *rowReader, expected, *leafPool_);
 }
+
+TEST_F(ParquetReaderTest, pageIndex) {
+  constexpr int64_t kRows = 20'000;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  // Both columns are sorted, so that their pages have disjoint ranges.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row * 2; }),
+  });
+
+  const auto filePath = tempPath_->path + "/pageIndex.parquet";
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.enablePageIndex = true;
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<facebook::velox::parquet::DefaultFlushPolicy>(
+        kRowsInRowGroup, kBytesInRowGroup);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  // Reads with 'filters', checks that the result is 'expected' and that fewer
+  // than 'maxScannedRows' rows are scanned.
+  auto testFilters = [&](FilterMap filters,
+                         const RowVectorPtr& expected,
+                         uint64_t maxScannedRows) {
+    ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFilePreloadThreshold(0);
+    readerOptions.setFooterEstimatedSize(1'024);
+    auto reader = createReader(filePath, readerOptions);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 2);
+    ASSERT_TRUE(
+        reader->fileMetaData().rowGroup(0).columnChunk(0).hasOffsetIndex());
+    ASSERT_TRUE(
+        reader->fileMetaData().rowGroup(0).columnChunk(0).hasColumnIndex());
+
+    auto scanSpec = makeScanSpec(rowType);
+    for (auto&& [column, filter] : filters) {
+      scanSpec->getOrCreateChild(Subfield(column))
+          ->setFilter(std::move(filter));
+    }
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    uint64_t numScanned = 0;
+    vector_size_t numRead = 0;
+    auto result = BaseVector::create(rowType, 0, leafPool_.get());
+    while (auto numRows = rowReader->next(1'000, result)) {
+      numScanned += numRows;
+      assertEqualVectorPart(expected, result, numRead);
+      numRead += result->size();
+    }
+    ASSERT_EQ(numRead, expected->size());
+    ASSERT_LT(numScanned, maxScannedRows);
+  };
+
+  {
+    SCOPED_TRACE("c0 BETWEEN 12345 AND 13000");
+    FilterMap filters;
+    filters.insert({"c0", exec::between(12'345, 13'000)});
+    auto expected = makeRowVector({
+        makeFlatVector<int64_t>(656, [](auto row) { return row + 12'345; }),
+        makeFlatVector<int64_t>(
+            656, [](auto row) { return (row + 12'345) * 2; }),
+    });
+    testFilters(std::move(filters), expected, kRowsInRowGroup / 2);
+  }
+
+  {
+    // Each filter alone passes a different part of the second row group.
+    SCOPED_TRACE("c0 >= 15000 AND c1 < 32000");
+    FilterMap filters;
+    filters.insert({"c0", exec::greaterThanOrEqual(15'000)});
+    filters.insert({"c1", exec::lessThan(32'000)});
+    auto expected = makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row + 15'000; }),
+        makeFlatVector<int64_t>(
+            1'000, [](auto row) { return (row + 15'000) * 2; }),
+    });
+    testFilters(std::move(filters), expected, kRowsInRowGroup / 2);
+  }
+}
+
+TEST_F(ParquetReaderTest, pageReadAhead) {
+  constexpr int64_t kRows = 20'000;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("value{}", row % 1'000); }),
+  });
+
+  const auto filePath = tempPath_->path + "/pageReadAhead.parquet";
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.enablePageIndex = true;
+  writerOptions.compression = CompressionKind_ZSTD;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  // Reads with 'numPages' of read ahead and 'filters' and checks that the
+  // result is 'expected'.
+  auto testReadAhead = [&](int32_t numPages,
+                           uint64_t maxBytes,
+                           FilterMap filters,
+                           const RowVectorPtr& expected) {
+    ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReader(filePath, readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    for (auto&& [column, filter] : filters) {
+      scanSpec->getOrCreateChild(Subfield(column))
+          ->setFilter(std::move(filter));
+    }
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    rowReaderOpts.setDecodingExecutor(executor);
+    rowReaderOpts.setPageReadAhead(numPages, maxBytes);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+  };
+
+  for (auto numPages : {0, 1, 8}) {
+    SCOPED_TRACE(fmt::format("numPages {}", numPages));
+    testReadAhead(numPages, 1 << 20, {}, data);
+    // The cap on the bytes read ahead stops reading ahead after one page.
+    testReadAhead(numPages, 1, {}, data);
+
+    // Pages before the filtered range are skipped using the page index, which
+    // drops the pages read ahead.
+    FilterMap filters;
+    filters.insert({"c0", exec::between(12'345, 13'000)});
+    auto expected = makeRowVector({
+        makeFlatVector<int64_t>(656, [](auto row) { return row + 12'345; }),
+        makeFlatVector<std::string>(
+            656,
+            [](auto row) {
+              return fmt::format("value{}", (row + 12'345) % 1'000);
+            }),
+    });
+    testReadAhead(numPages, 1 << 20, std::move(filters), expected);
+  }
+  executor->join();
+}
+
+TEST_F(ParquetReaderTest, splitBlockBloomFilter) {
+  SplitBlockBloomFilter bloomFilter(4'096);
+  ASSERT_EQ(bloomFilter.numBytes(), 4'096);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    bloomFilter.insert(SplitBlockBloomFilter::hash(i * 2));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    ASSERT_TRUE(bloomFilter.mayContain(SplitBlockBloomFilter::hash(i * 2)));
+    numFalsePositives +=
+        bloomFilter.mayContain(SplitBlockBloomFilter::hash(i * 2 + 1));
+  }
+  // 32 bits per value give a false positive rate well below 1%.
+  ASSERT_LT(numFalsePositives, 10);
+
+  const auto int64 = thrift::Type::INT64;
+  ASSERT_TRUE(
+      bloomFilter.testFilter(*exec::equal(10), int64, TypeKind::BIGINT));
+  ASSERT_FALSE(
+      bloomFilter.testFilter(*exec::equal(2'001), int64, TypeKind::BIGINT));
+  ASSERT_TRUE(bloomFilter.testFilter(
+      *exec::in(std::vector<int64_t>{2'001, 2'003, 16}), int64, TypeKind::BIGINT));
+  ASSERT_FALSE(bloomFilter.testFilter(
+      *exec::in(std::vector<int64_t>{2'001, 2'003, 2'005}), int64, TypeKind::BIGINT));
+  // Filters that pass nulls or ranges of values are not tested.
+  ASSERT_TRUE(bloomFilter.testFilter(
+      *exec::equal(2'001, true), int64, TypeKind::BIGINT));
+  ASSERT_TRUE(bloomFilter.testFilter(
+      *exec::between(2'001, 2'003), int64, TypeKind::BIGINT));
+  ASSERT_FALSE(SplitBlockBloomFilter::canTestFilter(
+      *exec::equal(2'001), thrift::Type::INT32, TypeKind::SMALLINT));
+
+  bloomFilter.insert(SplitBlockBloomFilter::hash(std::string_view("velox")));
+  const auto byteArray = thrift::Type::BYTE_ARRAY;
+  ASSERT_TRUE(bloomFilter.testFilter(
+      *exec::equal(std::string("velox")), byteArray, TypeKind::VARCHAR));
+  ASSERT_FALSE(bloomFilter.testFilter(
+      *exec::in(std::vector<std::string>{"presto", "spark"}),
+      byteArray,
+      TypeKind::VARCHAR));
+}
+
+TEST_F(ParquetReaderTest, bloomFilter) {
+  constexpr int64_t kRows = 20'000;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  // The first row group has the even and the second the odd numbers, so that
+  // the min/max of both row groups cover all values.
+  auto c0 = [](vector_size_t row) -> int64_t {
+    const int64_t half = kRowsInRowGroup;
+    return row < half ? row * 2 : (row - half) * 2 + 1;
+  };
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, c0),
+      makeFlatVector<std::string>(
+          kRows, [&](auto row) { return fmt::format("s{}", c0(row)); }),
+  });
+
+  const auto filePath = tempPath_->path + "/bloomFilter.parquet";
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<facebook::velox::parquet::DefaultFlushPolicy>(
+        kRowsInRowGroup, kBytesInRowGroup);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+  addBloomFilters(filePath, data);
+
+  // Reads with 'filters' and checks that the result is 'expected' and that
+  // 'numSkippedRowGroups' row groups are not read. A small footer estimated
+  // size makes the Bloom filters be read separately from the footer.
+  auto testFilters = [&](FilterMap filters,
+                         const RowVectorPtr& expected,
+                         uint64_t numSkippedRowGroups) {
+    for (auto footerEstimatedSize : {1'024, 1 << 20}) {
+      SCOPED_TRACE(fmt::format("footerEstimatedSize {}", footerEstimatedSize));
+      ReaderOptions readerOptions{leafPool_.get()};
+      readerOptions.setFilePreloadThreshold(0);
+      readerOptions.setFooterEstimatedSize(footerEstimatedSize);
+      auto reader = createReader(filePath, readerOptions);
+      ASSERT_EQ(reader->fileMetaData().numRowGroups(), 2);
+      ASSERT_TRUE(
+          reader->fileMetaData().rowGroup(1).columnChunk(1).hasBloomFilter());
+
+      auto scanSpec = makeScanSpec(rowType);
+      for (auto& [column, filter] : filters) {
+        scanSpec->getOrCreateChild(Subfield(column))
+            ->setFilter(filter->clone());
+      }
+      auto rowReaderOpts = getReaderOpts(rowType);
+      rowReaderOpts.setScanSpec(scanSpec);
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      vector_size_t numRead = 0;
+      auto result = BaseVector::create(rowType, 0, leafPool_.get());
+      while (rowReader->next(1'000, result)) {
+        assertEqualVectorPart(expected, result, numRead);
+        numRead += result->size();
+      }
+      ASSERT_EQ(numRead, expected->size());
+      RuntimeStatistics stats;
+      rowReader->updateRuntimeStats(stats);
+      ASSERT_EQ(stats.skippedStrides, numSkippedRowGroups);
+    }
+  };
+
+  auto expectedRows = [&](std::vector<int64_t> values) {
+    std::vector<std::string> strings;
+    for (auto value : values) {
+      strings.push_back(fmt::format("s{}", value));
+    }
+    return makeRowVector(
+        {makeFlatVector<int64_t>(values), makeFlatVector<std::string>(strings)});
+  };
+
+  {
+    FilterMap filters;
+    filters.insert({"c0", exec::equal(4)});
+    testFilters(std::move(filters), expectedRows({4}), 1);
+  }
+  {
+    FilterMap filters;
+    filters.insert({"c0", exec::in(std::vector<int64_t>{3, 5, 100'001})});
+    testFilters(std::move(filters), expectedRows({3, 5}), 1);
+  }
+  {
+    FilterMap filters;
+    filters.insert(
+        {"c1", exec::in(std::vector<std::string>{"s10", "s12", "s14"})});
+    testFilters(std::move(filters), expectedRows({10, 12, 14}), 1);
+  }
+  {
+    // Each filter prunes a different row group.
+    FilterMap filters;
+    filters.insert({"c0", exec::in(std::vector<int64_t>{4, 7})});
+    filters.insert({"c1", exec::equal(std::string("s9"))});
+    testFilters(std::move(filters), expectedRows({}), 2);
+  }
+  {
+    // Nulls are not in the Bloom filters.
+    FilterMap filters;
+    filters.insert({"c0", exec::equal(4, true)});
+    testFilters(std::move(filters), expectedRows({4}), 0);
+  }
+}
+
+TEST_F(ParquetReaderTest, dictionaryFilter) {
+  constexpr int64_t kRows = 20'000;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  // The first row group has the even and the second the odd numbers below 20,
+  // so that the min/max of both row groups cover all values.
+  auto c0 = [](vector_size_t row) -> int64_t {
+    return (row % 10) * 2 + (row < kRowsInRowGroup ? 0 : 1);
+  };
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, c0),
+      makeFlatVector<std::string>(
+          kRows, [&](auto row) { return fmt::format("s{}", c0(row)); }),
+  });
+
+  const auto filePath = tempPath_->path + "/dictionaryFilter.parquet";
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<facebook::velox::parquet::DefaultFlushPolicy>(
+        kRowsInRowGroup, kBytesInRowGroup);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  // Reads with 'filters' and checks that 'numRows' rows are read and that
+  // 'numSkippedRowGroups' row groups are not read.
+  auto testFilters = [&](FilterMap filters,
+                         vector_size_t numRows,
+                         uint64_t numSkippedRowGroups) {
+    ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReader(filePath, readerOptions);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 2);
+    ASSERT_TRUE(reader->fileMetaData()
+                    .rowGroup(1)
+                    .columnChunk(1)
+                    .isDictionaryEncoded());
+
+    auto scanSpec = makeScanSpec(rowType);
+    for (auto& [column, filter] : filters) {
+      scanSpec->getOrCreateChild(Subfield(column))->setFilter(filter->clone());
+    }
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    vector_size_t numRead = 0;
+    auto result = BaseVector::create(rowType, 0, leafPool_.get());
+    while (rowReader->next(1'000, result)) {
+      numRead += result->size();
+    }
+    ASSERT_EQ(numRead, numRows);
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    ASSERT_EQ(stats.skippedStrides, numSkippedRowGroups);
+  };
+
+  {
+    FilterMap filters;
+    filters.insert({"c0", exec::equal(4)});
+    testFilters(std::move(filters), kRowsInRowGroup / 10, 1);
+  }
+  {
+    FilterMap filters;
+    filters.insert({"c0", exec::in(std::vector<int64_t>{3, 5, 100})});
+    testFilters(std::move(filters), kRowsInRowGroup / 5, 1);
+  }
+  {
+    FilterMap filters;
+    filters.insert({"c1", exec::in(std::vector<std::string>{"s3", "s21"})});
+    testFilters(std::move(filters), kRowsInRowGroup / 10, 1);
+  }
+  {
+    // Each filter prunes a different row group.
+    FilterMap filters;
+    filters.insert({"c0", exec::equal(4)});
+    filters.insert({"c1", exec::equal(std::string("s9"))});
+    testFilters(std::move(filters), 0, 2);
+  }
+  {
+    // Nulls are not in the dictionary.
+    FilterMap filters;
+    filters.insert({"c0", exec::equal(4, true)});
+    testFilters(std::move(filters), kRowsInRowGroup / 10, 0);
+  }
+}
+
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  cache::FileMetadataCache metadataCache(1 << 20);
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setFileMetadataCache(&metadataCache, sample + "@1");
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+
+  for (auto i = 0; i < 2; ++i) {
+    auto reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), 20ULL);
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(
+        sampleSchema(), *rowReader, expected, *leafPool_);
+  }
+  const auto stats = metadataCache.stats();
+  ASSERT_EQ(stats.numMisses, 1);
+  ASSERT_EQ(stats.numHits, 1);
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_GT(stats.curBytes, 0);
+}
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 
@@ -43,6 +45,39 @@ class ParquetWriterTest : public ParquetTestBase {
             std::make_shared<InMemoryReadFile>(data), opts.getMemoryPool()),
         opts);
   };
+
+  // Writes 'data' in row groups of 'rowsInRowGroup' rows with the native
+  // column writer and checks that it reads back.
+  void testNativeColumnWriter(
+      const RowVectorPtr& data,
+      int32_t rowsInRowGroup,
+      std::shared_ptr<folly::Executor> executor = nullptr) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.enableNativeColumnWriter = true;
+    writerOptions.encodingExecutor = executor;
+    writerOptions.flushPolicyFactory = [rowsInRowGroup]() {
+      return std::make_unique<DefaultFlushPolicy>(rowsInRowGroup, 1L << 30);
+    };
+    const auto schema = asRowType(data->type());
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(data);
+    writer->close();
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), data->size());
+    ASSERT_EQ(
+        reader->fileMetaData().numRowGroups(),
+        bits::divRoundUp(data->size(), rowsInRowGroup));
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+  }
 };
 
 std::vector<CompressionKind> params = {
@@ -110,3 +145,41 @@ TEST_F(ParquetWriterTest, compression) {
   auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
+
+TEST_F(ParquetWriterTest, nativeColumnWriter) {
+  const vector_size_t kRows = 10'000;
+  auto names = makeFlatVector<std::string>(
+      100, [](auto row) { return fmt::format("name {}", row); });
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          kRows, [](auto row) { return row * 3; }, nullEvery(7)),
+      makeFlatVector<int8_t>(kRows, [](auto row) { return row % 100; }),
+      makeFlatVector<bool>(
+          kRows, [](auto row) { return row % 3 == 0; }, nullEvery(11)),
+      makeFlatVector<double>(kRows, [](auto row) { return row * 0.25; }),
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) { return fmt::format("string value {}", row); },
+          nullEvery(5)),
+      wrapInDictionary(
+          makeIndices(kRows, [](auto row) { return row % 100; }),
+          kRows,
+          names),
+  });
+  testNativeColumnWriter(data, 1'000);
+
+  // The column encoding runs in parallel when all columns are native.
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  testNativeColumnWriter(data, 1'000, executor);
+
+  // Columns of other types go through the Arrow conversion.
+  auto withArray = makeRowVector({
+      data->childAt(0),
+      makeArrayVector<int32_t>(
+          kRows, [](auto row) { return row % 5; }, [](auto i) { return i; }),
+      data->childAt(5),
+  });
+  testNativeColumnWriter(withArray, 3'000);
+  testNativeColumnWriter(withArray, 3'000, executor);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/parquet/writer/NativeColumnWriter.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/SelectivityVector.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Number of rows passed to the column writer at a time.
+constexpr int64_t kBatchSize = 4'096;
+
+// Writes the values of type T in 'vectors' as values of 'ParquetType'.
+// 'convert' makes a Parquet value from a Velox value.
+template <typename ParquetType, typename T, typename Convert>
+void writeValues(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t size,
+    arrow::ColumnWriter& columnWriter,
+    Convert convert) {
+  using Value = typename ParquetType::c_type;
+  // std::vector<bool> has no data().
+  using StoredValue =
+      std::conditional_t<std::is_same_v<Value, bool>, uint8_t, Value>;
+  static_assert(sizeof(StoredValue) == sizeof(Value));
+
+  auto& writer =
+      static_cast<arrow::TypedColumnWriter<ParquetType>&>(columnWriter);
+  const bool optional = writer.descr()->max_definition_level() > 0;
+  std::vector<int16_t> defLevels;
+  std::vector<StoredValue> values;
+  defLevels.reserve(kBatchSize);
+  values.reserve(kBatchSize);
+  DecodedVector decoded;
+  SelectivityVector rows;
+
+  const int64_t end = offset + size;
+  int64_t vectorStart = 0;
+  for (const auto& vector : vectors) {
+    if (vectorStart >= end) {
+      break;
+    }
+    const int64_t vectorEnd = vectorStart + vector->size();
+    const auto begin = std::max(offset, vectorStart) - vectorStart;
+    const auto last = std::min(end, vectorEnd) - vectorStart;
+    vectorStart = vectorEnd;
+    if (begin >= last) {
+      continue;
+    }
+    rows.resizeFill(vector->size(), false);
+    rows.setValidRange(begin, last, true);
+    rows.updateBounds();
+    decoded.decode(*vector, rows);
+    for (auto batch = begin; batch < last; batch += kBatchSize) {
+      const auto batchEnd = std::min(batch + kBatchSize, last);
+      defLevels.clear();
+      values.clear();
+      for (auto row = batch; row < batchEnd; ++row) {
+        if (decoded.isNullAt(row)) {
+          VELOX_CHECK(optional, "Null in a required Parquet column");
+          defLevels.push_back(0);
+        } else {
+          defLevels.push_back(1);
+          values.push_back(convert(decoded.valueAt<T>(row)));
+        }
+      }
+      writer.WriteBatch(
+          batchEnd - batch,
+          optional ? defLevels.data() : nullptr,
+          nullptr,
+          reinterpret_cast<const Value*>(values.data()));
+    }
+  }
+}
+
+template <typename ParquetType, typename T>
+void writeValues(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t size,
+    arrow::ColumnWriter& writer) {
+  writeValues<ParquetType, T>(
+      vectors, offset, size, writer, [](T value) { return value; });
+}
+
+} // namespace
+
+bool isNativeColumnType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    case TypeKind::INTEGER:
+      return type == *INTEGER() || type.isDate();
+    case TypeKind::BIGINT:
+      return type == *BIGINT();
+    case TypeKind::VARCHAR:
+      return type == *VARCHAR();
+    case TypeKind::VARBINARY:
+      return type == *VARBINARY();
+    default:
+      return false;
+  }
+}
+
+void writeNativeColumn(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t size,
+    arrow::ColumnWriter& writer) {
+  VELOX_CHECK(!vectors.empty());
+  const auto& type = vectors[0]->type();
+  VELOX_CHECK(isNativeColumnType(*type), "{}", type->toString());
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      VELOX_CHECK_EQ(writer.type(), arrow::Type::BOOLEAN);
+      return writeValues<arrow::BooleanType, bool>(
+          vectors, offset, size, writer);
+    case TypeKind::TINYINT:
+      VELOX_CHECK_EQ(writer.type(), arrow::Type::INT32);
+      return writeValues<arrow::Int32Type, int8_t>(
+          vectors, offset, size, writer);
+    case TypeKind::SMALLINT:
+      VELOX_CHECK_EQ(writer.type(), arrow::Type::INT32);
+      return writeValues<arrow::Int32Type, int16_t>(
+          vectors, offset, size, writer);
+    case TypeKind::INTEGER:
+      VELOX_CHECK_EQ(writer.type(), arrow::Type::INT32);
+      return writeValues<arrow::Int32Type, int32_t>(
+          vectors, offset, size, writer);
+    case TypeKind::BIGINT:
+      VELOX_CHECK_EQ(writer.type(), arrow::Type::INT64);
+      return writeValues<arrow::Int64Type, int64_t>(
+          vectors, offset, size, writer);
+    case TypeKind::REAL:
+      VELOX_CHECK_EQ(writer.type(), arrow::Type::FLOAT);
+      return writeValues<arrow::FloatType, float>(
+          vectors, offset, size, writer);
+    case TypeKind::DOUBLE:
+      VELOX_CHECK_EQ(writer.type(), arrow::Type::DOUBLE);
+      return writeValues<arrow::DoubleType, double>(
+          vectors, offset, size, writer);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      VELOX_CHECK_EQ(writer.type(), arrow::Type::BYTE_ARRAY);
+      return writeValues<arrow::ByteArrayType, StringView>(
+          vectors, offset, size, writer, [](const StringView& value) {
+            return arrow::ByteArray(
+                value.size(), reinterpret_cast<const uint8_t*>(value.data()));
+          });
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace facebook::velox::parquet
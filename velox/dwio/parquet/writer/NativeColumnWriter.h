@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::parquet {
+
+/// Returns true if top-level columns of 'type' can be written with
+/// writeNativeColumn(). These are the scalar types that map to a single
+/// Parquet leaf without a conversion of the values, e.g. integers, floating
+/// point numbers, dates and strings. Decimals, timestamps and nested types go
+/// through Arrow.
+bool isNativeColumnType(const Type& type);
+
+/// Writes rows [offset, offset + size) of the concatenation of 'vectors' to
+/// 'writer'. The values are read through DecodedVector, so that dictionary
+/// and constant encoded vectors are not flattened or copied into Arrow arrays.
+/// The type of 'vectors' must satisfy isNativeColumnType().
+void writeNativeColumn(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t size,
+    arrow::ColumnWriter& writer);
+
+} // namespace facebook::velox::parquet
@@ -18,6 +18,9 @@
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
+#include "velox/dwio/common/ParallelFor.h"
+#include "velox/dwio/parquet/writer/NativeColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/FileWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -102,6 +105,10 @@ struct ArrowContext {
   int64_t stagingBytes = 0;
   // columns, Arrays
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+  // With the native column writer, whether each column is written natively
+  // and the staged vectors of these columns.
+  std::vector<bool> nativeColumns;
+  std::vector<std::vector<VectorPtr>> stagingVectors;
 };
 
 Compression::type getArrowParquetCompression(
@@ -138,6 +145,9 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
         columnCompressionValues.first,
         getArrowParquetCompression(columnCompressionValues.second));
   }
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
   properties = properties->max_row_group_length(
@@ -219,7 +229,10 @@ Writer::Writer(
     const WriterOptions& options,
     std::shared_ptr<memory::MemoryPool> pool,
     RowTypePtr schema)
-    : pool_(std::move(pool)),
+    : enableNativeColumnWriter_(options.enableNativeColumnWriter),
+      encodingExecutor_(options.encodingExecutor),
+      encodingParallelismFactor_(options.encodingParallelismFactor),
+      pool_(std::move(pool)),
       generalPool_{pool_->addLeafChild(".general")},
       stream_(std::make_shared<ArrowDataBufferSink>(
           std::move(sink),
@@ -251,19 +264,27 @@ Writer::Writer(
               folly::to<std::string>(folly::Random::rand64()))),
           std::move(schema)} {}
 
+void Writer::ensureFileWriter() {
+  if (!arrowContext_->writer) {
+    auto arrowProperties = ArrowWriterProperties::Builder().build();
+    PARQUET_ASSIGN_OR_THROW(
+        arrowContext_->writer,
+        FileWriter::Open(
+            *arrowContext_->schema.get(),
+            ::arrow::default_memory_pool(),
+            stream_,
+            arrowContext_->properties,
+            arrowProperties));
+  }
+}
+
 void Writer::flush() {
   if (arrowContext_->stagingRows > 0) {
-    if (!arrowContext_->writer) {
-      auto arrowProperties = ArrowWriterProperties::Builder().build();
-      PARQUET_ASSIGN_OR_THROW(
-          arrowContext_->writer,
-          FileWriter::Open(
-              *arrowContext_->schema.get(),
-              ::arrow::default_memory_pool(),
-              stream_,
-              arrowContext_->properties,
-              arrowProperties));
+    if (enableNativeColumnWriter_) {
+      flushNative();
+      return;
     }
+    ensureFileWriter();
 
     auto fields = arrowContext_->schema->fields();
     std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks;
@@ -290,6 +311,83 @@ void Writer::flush() {
   }
 }
 
+void Writer::flushNative() {
+  ensureFileWriter();
+  auto& context = *arrowContext_;
+  const auto numColumns = context.nativeColumns.size();
+  std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks(numColumns);
+  bool allNative = true;
+  for (auto i = 0; i < numColumns; ++i) {
+    if (context.nativeColumns[i]) {
+      continue;
+    }
+    allNative = false;
+    chunks[i] = ::arrow::ChunkedArray::Make(
+                    std::move(context.stagingChunks[i]),
+                    context.schema->field(i)->type())
+                    .ValueOrDie();
+  }
+
+  // The columns of a buffered row group can be written in any order. The
+  // Arrow conversion only writes to unbuffered row groups.
+  const bool parallel = encodingExecutor_ != nullptr && allNative;
+  const int64_t numRows = context.stagingRows;
+  const int64_t rowGroupSize = std::min<int64_t>(
+      flushPolicy_->rowsInRowGroup(),
+      context.properties->max_row_group_length());
+  for (int64_t offset = 0; offset < numRows; offset += rowGroupSize) {
+    const auto size = std::min(rowGroupSize, numRows - offset);
+    if (parallel) {
+      PARQUET_THROW_NOT_OK(context.writer->NewBufferedRowGroup());
+      auto* rowGroup = context.writer->row_group_writer();
+      dwio::common::ParallelFor(
+          encodingExecutor_.get(), 0, numColumns, encodingParallelismFactor_)
+          .execute([&](size_t i) {
+            writeNativeColumn(
+                context.stagingVectors[i], offset, size, *rowGroup->column(i));
+          });
+      continue;
+    }
+    PARQUET_THROW_NOT_OK(context.writer->NewRowGroup(size));
+    auto* rowGroup = context.writer->row_group_writer();
+    for (auto i = 0; i < numColumns; ++i) {
+      if (context.nativeColumns[i]) {
+        writeNativeColumn(
+            context.stagingVectors[i], offset, size, *rowGroup->NextColumn());
+      } else {
+        PARQUET_THROW_NOT_OK(
+            context.writer->WriteColumnChunk(chunks[i], offset, size));
+      }
+    }
+  }
+  PARQUET_THROW_NOT_OK(stream_->Flush());
+  for (auto i = 0; i < numColumns; ++i) {
+    context.stagingChunks[i].clear();
+    context.stagingVectors[i].clear();
+  }
+  context.stagingRows = 0;
+  context.stagingBytes = 0;
+}
+
+void Writer::stageNative(
+    const RowVectorPtr& data,
+    const std::vector<std::shared_ptr<::arrow::Field>>& fields) {
+  ArrowOptions options{.flattenDictionary = true, .flattenConstant = true};
+  for (auto i = 0; i < fields.size(); ++i) {
+    const auto& child = data->childAt(i);
+    if (arrowContext_->nativeColumns[i]) {
+      arrowContext_->stagingVectors[i].push_back(
+          BaseVector::loadedVectorShared(child));
+      continue;
+    }
+    ArrowArray array;
+    exportToArrow(child, array, generalPool_.get(), options);
+    PARQUET_ASSIGN_OR_THROW(
+        auto arrowArray, ::arrow::ImportArray(&array, fields[i]->type()));
+    arrowContext_->stagingChunks[i].push_back(std::move(arrowArray));
+  }
+}
+
 dwio::common::StripeProgress getStripeProgress(
     uint64_t stagingRows,
     int64_t stagingBytes) {
@@ -311,9 +409,7 @@ void Writer::write(const VectorPtr& data) {
       "The file schema type should be equal with the input rowvector type.");
 
   ArrowOptions options{.flattenDictionary = true, .flattenConstant = true};
-  ArrowArray array;
   ArrowSchema schema;
-  exportToArrow(data, array, generalPool_.get(), options);
   exportToArrow(data, schema, options);
 
   // Convert the arrow schema to Schema and then update the column names based
@@ -326,6 +422,34 @@ void Writer::write(const VectorPtr& data) {
         arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
   }
 
+  auto bytes = data->estimateFlatSize();
+  auto numRows = data->size();
+  if (enableNativeColumnWriter_) {
+    if (!arrowContext_->schema) {
+      arrowContext_->schema = ::arrow::schema(newFields);
+      arrowContext_->stagingChunks.resize(childSize);
+      arrowContext_->stagingVectors.resize(childSize);
+      for (auto i = 0; i < childSize; ++i) {
+        arrowContext_->nativeColumns.push_back(
+            isNativeColumnType(*schema_->childAt(i)));
+      }
+    }
+    if (flushPolicy_->shouldFlush(getStripeProgress(
+            arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
+      flush();
+    }
+    auto rowVector = data;
+    if (rowVector->encoding() != VectorEncoding::Simple::ROW) {
+      BaseVector::flattenVector(rowVector);
+    }
+    stageNative(std::static_pointer_cast<RowVector>(rowVector), newFields);
+    arrowContext_->stagingRows += numRows;
+    arrowContext_->stagingBytes += bytes;
+    return;
+  }
+
+  ArrowArray array;
+  exportToArrow(data, array, generalPool_.get(), options);
   PARQUET_ASSIGN_OR_THROW(
       auto recordBatch,
       ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
@@ -338,8 +462,6 @@ void Writer::write(const VectorPtr& data) {
     }
   }
 
-  auto bytes = data->estimateFlatSize();
-  auto numRows = data->size();
   if (flushPolicy_->shouldFlush(getStripeProgress(
           arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
     flush();
@@ -372,6 +494,7 @@ void Writer::close() {
   PARQUET_THROW_NOT_OK(stream_->Close());
 
   arrowContext_->stagingChunks.clear();
+  arrowContext_->stagingVectors.clear();
 }
 
 void Writer::abort() {
@@ -386,6 +509,8 @@ parquet::WriterOptions getParquetOptions(
   if (options.compressionKind.has_value()) {
     parquetOptions.compression = options.compressionKind.value();
   }
+  parquetOptions.encodingExecutor = options.encodingExecutor;
+  parquetOptions.encodingParallelismFactor = options.encodingParallelismFactor;
   return parquetOptions;
 }
 
@@ -27,6 +27,10 @@
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
 #include "velox/vector/ComplexVector.h"
 
+namespace arrow {
+class Field;
+} // namespace arrow
+
 namespace facebook::velox::parquet {
 
 using facebook::velox::parquet::arrow::util::CodecOptions;
@@ -102,6 +106,18 @@ struct WriterOptions {
   std::shared_ptr<CodecOptions> codecOptions;
   std::unordered_map<std::string, common::CompressionKind>
       columnCompressionsMap;
+  // Writes the ColumnIndex and OffsetIndex of each column chunk.
+  bool enablePageIndex = false;
+  // Writes the top-level columns of scalar types straight from the vectors,
+  // see isNativeColumnType(). The other columns are converted to Arrow.
+  bool enableNativeColumnWriter = false;
+  // If set with 'enableNativeColumnWriter' and all columns are written
+  // natively, the columns of a row group are encoded in parallel on this
+  // executor. 'encodingParallelismFactor' is the number of threads including
+  // the calling thread. The row group is then buffered in memory until all
+  // its columns are encoded.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor = 0;
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -146,6 +162,22 @@ class Writer : public dwio::common::Writer {
   // Sets the memory reclaimers for all the memory pools used by this writer.
   void setMemoryReclaimers();
 
+  // Creates the Arrow file writer on the first flush.
+  void ensureFileWriter();
+
+  // Stages the columns of 'data' for flushNative(). The columns that are not
+  // written natively are converted to Arrow.
+  void stageNative(
+      const RowVectorPtr& data,
+      const std::vector<std::shared_ptr<::arrow::Field>>& fields);
+
+  // Writes the staged rows with the native column writer.
+  void flushNative();
+
+  const bool enableNativeColumnWriter_;
+  const std::shared_ptr<folly::Executor> encodingExecutor_;
+  const size_t encodingParallelismFactor_;
+
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
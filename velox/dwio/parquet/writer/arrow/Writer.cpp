@@ -393,6 +393,10 @@ class FileWriterImpl : public FileWriter {
     return schema_;
   }
 
+  RowGroupWriter* row_group_writer() const override {
+    return row_group_writer_;
+  }
+
   Status WriteTable(const Table& table, int64_t chunk_size) override {
     RETURN_NOT_OK(table.Validate());
 
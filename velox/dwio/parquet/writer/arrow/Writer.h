@@ -38,6 +38,7 @@ namespace facebook::velox::parquet::arrow {
 
 class FileMetaData;
 class ParquetFileWriter;
+class RowGroupWriter;
 
 namespace arrow {
 
@@ -133,6 +134,12 @@ class PARQUET_EXPORT FileWriter {
   /// Returns an error if not all columns have been written.
   virtual ::arrow::Status NewBufferedRowGroup() = 0;
 
+  /// \brief Return the writer of the current row group.
+  ///
+  /// Lets a caller write column chunks through the ColumnWriters of the row
+  /// group instead of Arrow arrays. nullptr before the first row group.
+  virtual RowGroupWriter* row_group_writer() const = 0;
+
   /// \brief Write a RecordBatch into the buffered row group.
   ///
   /// Multiple RecordBatches can be written into the same row group
@@ -85,6 +85,33 @@ class Aggregate {
     return false;
   }
 
+  /// How the raw input rows of a group combine into one intermediate result,
+  /// for the functions that are a plain sum, count, min, max or avg of at most
+  /// one argument. GroupingSet may then combine the rows of each group in
+  /// dense arrays and add the results with addIntermediateResults(), see
+  /// DenseAggregation.
+  enum class DenseKind {
+    kNone,
+    // The sum of the non-null inputs in the intermediate type. Null if there
+    // are none. Integer sums wrap around on overflow.
+    kSum,
+    // Like kSum, but integer sums throw on overflow.
+    kCheckedSum,
+    // The number of non-null inputs, or of rows if there is no argument.
+    kCount,
+    // The smallest or largest non-null input. Null if there are none.
+    kMin,
+    kMax,
+    // ROW(sum, count) of the non-null inputs. Null if there are none.
+    kAvg,
+  };
+
+  /// Returns the kind of the function, kNone if its input does not combine as
+  /// described for DenseKind.
+  virtual DenseKind denseKind() const {
+    return DenseKind::kNone;
+  }
+
   void setAllocator(HashStringAllocator* allocator) {
     setAllocatorInternal(allocator);
   }
@@ -15,6 +15,8 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+#include <folly/container/F14Set.h>
+#include <numeric>
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -25,6 +27,28 @@ namespace facebook::velox::exec {
 
 namespace {
 
+// Aggregates that are commutative and have small intermediate results. Sliding
+// frames of these are computed from a segment tree over the partition.
+bool supportsSegmentTree(const std::string& name) {
+  static const folly::F14FastSet<std::string> kNames = {
+      "min",
+      "max",
+      "sum",
+      "count",
+      "count_if",
+      "avg",
+      "bool_and",
+      "bool_or",
+      "every",
+      "bitwise_and_agg",
+      "bitwise_or_agg",
+  };
+  // Strips a prefix like 'presto.default.'.
+  const auto pos = name.rfind('.');
+  return kNames.contains(
+      pos == std::string::npos ? name : name.substr(pos + 1));
+}
+
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
@@ -99,6 +123,27 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
     computeDefaultAggregateValue(resultType);
+
+    if (supportsSegmentTree(name)) {
+      // The segment tree has its own Aggregate so that clear() on
+      // 'aggregate_' does not affect the null counts of the tree nodes.
+      treeAggregate_ = exec::Aggregate::create(
+          name,
+          core::AggregationNode::Step::kSingle,
+          argTypes_,
+          resultType,
+          config);
+      treeAggregate_->setAllocator(stringAllocator_);
+      treeAggregate_->setOffsets(
+          singleGroupRowSize_ - aggregate_->accumulatorFixedWidthSize(),
+          exec::RowContainer::nullByte(kNullOffset),
+          exec::RowContainer::nullMask(kNullOffset),
+          kRowSizeOffset);
+      treeRowSize_ = bits::roundUp(
+          singleGroupRowSize_, treeAggregate_->accumulatorAlignmentSize());
+      treeIntermediate_ = BaseVector::create(
+          exec::Aggregate::intermediateType(name, argTypes_), 0, pool_);
+    }
   }
 
   ~AggregateWindowFunction() {
@@ -108,12 +153,14 @@ class AggregateWindowFunction : public exec::WindowFunction {
       std::vector<char*> singleGroupRowVector = {rawSingleGroupRow_};
       aggregate_->destroy(folly::Range(singleGroupRowVector.data(), 1));
     }
+    destroySegmentTree();
   }
 
   void resetPartition(const exec::WindowPartition* partition) override {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    destroySegmentTree();
   }
 
   void apply(
@@ -161,6 +208,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -343,6 +393,160 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are to be computed from the
+  // segment tree. The tree costs a pass over the partition to build and
+  // O(log(frame size)) merges per row, so it is used only if the frames are
+  // on average larger than a few rows.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    static constexpr int64_t kMinAverageFrameSize = 16;
+    if (treeAggregate_ == nullptr) {
+      return false;
+    }
+    int64_t totalFrameSize = 0;
+    validRows.applyToSelected([&](auto i) {
+      totalFrameSize += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return totalFrameSize >= kMinAverageFrameSize * validRows.countSelected();
+  }
+
+  char* treeNode(vector_size_t index) const {
+    return treeNodes_->asMutable<char>() +
+        static_cast<int64_t>(index) * treeRowSize_;
+  }
+
+  // Builds a segment tree over the rows of the partition. Leaf n + i has the
+  // accumulator of row i, where n is the number of rows. Node i, 0 < i < n,
+  // merges nodes 2 * i and 2 * i + 1.
+  void buildSegmentTree() {
+    const auto numRows = partition_->numRows();
+    numTreeLeaves_ = numRows;
+    const auto numNodes = 2 * numRows;
+    treeNodes_ = AlignedBuffer::allocate<char>(
+        static_cast<int64_t>(numNodes) * treeRowSize_, pool_);
+    std::vector<char*> groups(numNodes);
+    for (auto i = 0; i < numNodes; ++i) {
+      groups[i] = treeNode(i);
+    }
+    std::vector<vector_size_t> indices(numNodes);
+    std::iota(indices.begin(), indices.end(), 0);
+    treeAggregate_->initializeNewGroups(groups.data(), indices);
+    treeBuilt_ = true;
+
+    std::vector<VectorPtr> args(argIndices_.size());
+    for (auto i = 0; i < argIndices_.size(); ++i) {
+      if (argIndices_[i] == kConstantChannel) {
+        args[i] = argVectors_[i];
+      } else {
+        args[i] = BaseVector::create(argTypes_[i], numRows, pool_);
+        partition_->extractColumn(argIndices_[i], 0, numRows, 0, args[i]);
+      }
+    }
+    treeAggregate_->addRawInput(
+        groups.data() + numRows, SelectivityVector(numRows), args, false);
+
+    // Merges the nodes in [first, last] after their children, which are all
+    // above 'last'.
+    std::vector<char*> parents;
+    for (vector_size_t last = numRows - 1; last > 0;) {
+      const vector_size_t first = std::max<vector_size_t>(1, last / 2 + 1);
+      const vector_size_t numChildren = 2 * (last - first + 1);
+      parents.resize(numChildren);
+      for (auto i = 0; i < numChildren; ++i) {
+        parents[i] = groups[first + i / 2];
+      }
+      treeAggregate_->extractAccumulators(
+          groups.data() + 2 * first, numChildren, &treeIntermediate_);
+      treeAggregate_->addIntermediateResults(
+          parents.data(),
+          SelectivityVector(numChildren),
+          {treeIntermediate_},
+          false);
+      last = first - 1;
+    }
+  }
+
+  void destroySegmentTree() {
+    if (!treeBuilt_) {
+      return;
+    }
+    std::vector<char*> groups(2 * numTreeLeaves_);
+    for (auto i = 0; i < groups.size(); ++i) {
+      groups[i] = treeNode(i);
+    }
+    treeAggregate_->destroy(folly::Range(groups.data(), groups.size()));
+    treeNodes_.reset();
+    treeBuilt_ = false;
+  }
+
+  // Computes each frame by merging the O(log(frame size)) tree nodes that
+  // cover it. The nodes of all the frames are merged in one batch.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    if (!treeBuilt_) {
+      buildSegmentTree();
+    }
+    const auto numFrames = validRows.countSelected();
+    auto resultRows = AlignedBuffer::allocate<char>(
+        std::max<vector_size_t>(numFrames, 1) * treeRowSize_, pool_);
+    std::vector<char*> resultGroups(numFrames);
+    for (auto i = 0; i < numFrames; ++i) {
+      resultGroups[i] = resultRows->asMutable<char>() + i * treeRowSize_;
+    }
+    std::vector<vector_size_t> indices(numFrames);
+    std::iota(indices.begin(), indices.end(), 0);
+    treeAggregate_->initializeNewGroups(resultGroups.data(), indices);
+
+    // Pairs of a covering node and the frame it goes to.
+    std::vector<char*> nodes;
+    std::vector<char*> targets;
+    std::vector<vector_size_t> frameRows;
+    frameRows.reserve(numFrames);
+    validRows.applyToSelected([&](auto i) {
+      auto* target = resultGroups[frameRows.size()];
+      frameRows.push_back(i);
+      auto add = [&](vector_size_t node) {
+        nodes.push_back(treeNode(node));
+        targets.push_back(target);
+      };
+      vector_size_t left = rawFrameStarts[i] + numTreeLeaves_;
+      vector_size_t right = rawFrameEnds[i] + numTreeLeaves_ + 1;
+      for (; left < right; left /= 2, right /= 2) {
+        if (left & 1) {
+          add(left++);
+        }
+        if (right & 1) {
+          add(--right);
+        }
+      }
+    });
+    treeAggregate_->extractAccumulators(
+        nodes.data(), nodes.size(), &treeIntermediate_);
+    treeAggregate_->addIntermediateResults(
+        targets.data(),
+        SelectivityVector(nodes.size()),
+        {treeIntermediate_},
+        false);
+
+    BaseVector::prepareForReuse(aggregateResultVector_, numFrames);
+    treeAggregate_->extractValues(
+        resultGroups.data(), numFrames, &aggregateResultVector_);
+    for (auto i = 0; i < numFrames; ++i) {
+      result->copy(
+          aggregateResultVector_.get(), resultOffset + frameRows[i], i, 1);
+    }
+    treeAggregate_->destroy(folly::Range(resultGroups.data(), numFrames));
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -391,6 +595,23 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // Aggregate for the segment tree of the current partition. nullptr if the
+  // aggregate is not supported by segment trees.
+  std::unique_ptr<exec::Aggregate> treeAggregate_;
+
+  // Size of a tree node row rounded up to the accumulator alignment.
+  vector_size_t treeRowSize_{0};
+
+  // Tree node rows. See buildSegmentTree().
+  BufferPtr treeNodes_;
+  vector_size_t numTreeLeaves_{0};
+
+  // True if 'treeNodes_' has the tree of the current partition.
+  bool treeBuilt_{false};
+
+  // Used for extracting the intermediate results of tree nodes.
+  VectorPtr treeIntermediate_;
 };
 
 } // namespace
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DenseAggregation.h"
+
+#include "velox/common/base/CheckedArithmetic.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+using DenseKind = Aggregate::DenseKind;
+
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool isFloatingPointKind(TypeKind kind) {
+  return kind == TypeKind::REAL || kind == TypeKind::DOUBLE;
+}
+
+// Returns true if the intermediate results of 'kind' over 'inputType' can be
+// made by makeIntermediate().
+bool isSupported(
+    DenseKind kind,
+    const TypePtr& inputType,
+    const TypePtr& intermediateType) {
+  switch (kind) {
+    case DenseKind::kSum:
+      if (isIntegerKind(inputType->kind())) {
+        return intermediateType->kind() == TypeKind::BIGINT;
+      }
+      return isFloatingPointKind(inputType->kind()) &&
+          intermediateType->kind() == TypeKind::DOUBLE;
+    case DenseKind::kCheckedSum:
+      return isIntegerKind(inputType->kind()) &&
+          intermediateType->kind() == TypeKind::BIGINT;
+    case DenseKind::kCount:
+      return intermediateType->kind() == TypeKind::BIGINT;
+    case DenseKind::kMin:
+    case DenseKind::kMax:
+      return isIntegerKind(inputType->kind()) &&
+          intermediateType->equivalent(*inputType);
+    case DenseKind::kAvg:
+      return (isIntegerKind(inputType->kind()) ||
+              isFloatingPointKind(inputType->kind())) &&
+          intermediateType->equivalent(*ROW({DOUBLE(), BIGINT()}));
+    default:
+      return false;
+  }
+}
+} // namespace
+
+// static
+std::unique_ptr<DenseAggregation> DenseAggregation::create(
+    const std::vector<AggregateInfo>& aggregates,
+    const RowTypePtr& inputType,
+    memory::MemoryPool* pool) {
+  if (aggregates.empty()) {
+    return nullptr;
+  }
+  std::vector<Accumulator> accumulators;
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.distinct || aggregate.mask.has_value() ||
+        !aggregate.sortingKeys.empty()) {
+      return nullptr;
+    }
+    const auto kind = aggregate.function->denseKind();
+    if (kind == DenseKind::kNone || aggregate.inputs.size() > 1) {
+      return nullptr;
+    }
+    Accumulator accumulator;
+    accumulator.function = aggregate.function.get();
+    accumulator.kind = kind;
+    accumulator.intermediateType = aggregate.intermediateType;
+    if (aggregate.inputs.empty() || aggregate.inputs[0] == kConstantChannel) {
+      // Count of constant non-null input, e.g. count(1), counts the rows.
+      if (kind != DenseKind::kCount ||
+          (!aggregate.inputs.empty() &&
+           aggregate.constantInputs[0]->isNullAt(0))) {
+        return nullptr;
+      }
+      accumulator.inputType = BIGINT();
+    } else {
+      accumulator.channel = aggregate.inputs[0];
+      accumulator.inputType = inputType->childAt(aggregate.inputs[0]);
+    }
+    if (!isSupported(
+            kind, accumulator.inputType, accumulator.intermediateType)) {
+      return nullptr;
+    }
+    accumulators.push_back(std::move(accumulator));
+  }
+  return std::unique_ptr<DenseAggregation>(
+      new DenseAggregation(std::move(accumulators), pool));
+}
+
+void DenseAggregation::addInput(
+    const HashLookup& lookup,
+    const RowVectorPtr& input,
+    const SelectivityVector& rows,
+    uint64_t numSlots) {
+  VELOX_DCHECK_LE(numSlots, kMaxSlots);
+  mapGroups(lookup, numSlots);
+  const auto numGroups = groups_.size();
+  denseRows_.resizeFill(numGroups, true);
+  for (auto& accumulator : accumulators_) {
+    accumulate(accumulator, lookup, input, rows);
+    const auto intermediate = makeIntermediate(accumulator);
+    accumulator.function->addIntermediateResults(
+        groups_.data(), denseRows_, {intermediate}, false);
+  }
+  for (auto slot : slots_) {
+    slotToDense_[slot] = -1;
+  }
+}
+
+void DenseAggregation::mapGroups(const HashLookup& lookup, uint64_t numSlots) {
+  if (slotToDense_.size() < numSlots) {
+    slotToDense_.resize(numSlots, -1);
+  }
+  groups_.clear();
+  slots_.clear();
+  const auto numRows = lookup.rows.size();
+  rowToDense_.resize(numRows);
+  auto* slotToDense = slotToDense_.data();
+  for (auto i = 0; i < numRows; ++i) {
+    const auto row = lookup.rows[i];
+    const auto slot = lookup.hashes[row];
+    VELOX_DCHECK_LT(slot, numSlots);
+    auto dense = slotToDense[slot];
+    if (dense < 0) {
+      dense = groups_.size();
+      slotToDense[slot] = dense;
+      groups_.push_back(lookup.hits[row]);
+      slots_.push_back(slot);
+    }
+    rowToDense_[i] = dense;
+  }
+}
+
+template <typename T, typename Func>
+void DenseAggregation::forEachValue(const HashLookup& lookup, Func func) {
+  const auto numRows = lookup.rows.size();
+  const auto* rows = lookup.rows.data();
+  const auto* dense = rowToDense_.data();
+  if (decoded_.isIdentityMapping() && !decoded_.mayHaveNulls()) {
+    const auto* values = decoded_.data<T>();
+    for (auto i = 0; i < numRows; ++i) {
+      func(dense[i], values[rows[i]]);
+    }
+    return;
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    const auto row = rows[i];
+    if (!decoded_.isNullAt(row)) {
+      func(dense[i], decoded_.valueAt<T>(row));
+    }
+  }
+}
+
+template <typename T>
+void DenseAggregation::accumulateTyped(
+    Accumulator& accumulator,
+    const HashLookup& lookup) {
+  auto* counts = accumulator.counts.data();
+  auto* longs = accumulator.longs.data();
+  auto* doubles = accumulator.doubles.data();
+  if constexpr (std::is_floating_point_v<T>) {
+    VELOX_DCHECK(
+        accumulator.kind == DenseKind::kSum ||
+        accumulator.kind == DenseKind::kAvg);
+    forEachValue<T>(lookup, [&](int32_t dense, T value) {
+      ++counts[dense];
+      doubles[dense] += value;
+    });
+  } else {
+    switch (accumulator.kind) {
+      case DenseKind::kSum:
+        // Wraps around like the accumulators of sums that allow overflow.
+        forEachValue<T>(lookup, [&](int32_t dense, T value) {
+          ++counts[dense];
+          longs[dense] = static_cast<int64_t>(
+              static_cast<uint64_t>(longs[dense]) +
+              static_cast<uint64_t>(static_cast<int64_t>(value)));
+        });
+        break;
+      case DenseKind::kCheckedSum:
+        forEachValue<T>(lookup, [&](int32_t dense, T value) {
+          ++counts[dense];
+          longs[dense] = checkedPlus<int64_t>(longs[dense], value);
+        });
+        break;
+      case DenseKind::kMin:
+        forEachValue<T>(lookup, [&](int32_t dense, T value) {
+          ++counts[dense];
+          longs[dense] = std::min<int64_t>(longs[dense], value);
+        });
+        break;
+      case DenseKind::kMax:
+        forEachValue<T>(lookup, [&](int32_t dense, T value) {
+          ++counts[dense];
+          longs[dense] = std::max<int64_t>(longs[dense], value);
+        });
+        break;
+      case DenseKind::kAvg:
+        forEachValue<T>(lookup, [&](int32_t dense, T value) {
+          ++counts[dense];
+          doubles[dense] += value;
+        });
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+void DenseAggregation::accumulate(
+    Accumulator& accumulator,
+    const HashLookup& lookup,
+    const RowVectorPtr& input,
+    const SelectivityVector& rows) {
+  const auto numGroups = groups_.size();
+  accumulator.counts.assign(numGroups, 0);
+  switch (accumulator.kind) {
+    case DenseKind::kSum:
+    case DenseKind::kCheckedSum:
+      if (accumulator.intermediateType->kind() == TypeKind::DOUBLE) {
+        accumulator.doubles.assign(numGroups, 0);
+      } else {
+        accumulator.longs.assign(numGroups, 0);
+      }
+      break;
+    case DenseKind::kMin:
+      accumulator.longs.assign(
+          numGroups, std::numeric_limits<int64_t>::max());
+      break;
+    case DenseKind::kMax:
+      accumulator.longs.assign(
+          numGroups, std::numeric_limits<int64_t>::min());
+      break;
+    case DenseKind::kAvg:
+      accumulator.doubles.assign(numGroups, 0);
+      break;
+    default:
+      break;
+  }
+
+  const auto numRows = lookup.rows.size();
+  auto* counts = accumulator.counts.data();
+  if (!accumulator.channel.has_value()) {
+    for (auto i = 0; i < numRows; ++i) {
+      ++counts[rowToDense_[i]];
+    }
+    return;
+  }
+
+  const auto& vector = input->childAt(accumulator.channel.value());
+  decoded_.decode(*vector, rows);
+  if (accumulator.kind == DenseKind::kCount) {
+    if (!decoded_.mayHaveNulls()) {
+      for (auto i = 0; i < numRows; ++i) {
+        ++counts[rowToDense_[i]];
+      }
+      return;
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      if (!decoded_.isNullAt(lookup.rows[i])) {
+        ++counts[rowToDense_[i]];
+      }
+    }
+    return;
+  }
+
+  switch (accumulator.inputType->kind()) {
+    case TypeKind::TINYINT:
+      accumulateTyped<int8_t>(accumulator, lookup);
+      break;
+    case TypeKind::SMALLINT:
+      accumulateTyped<int16_t>(accumulator, lookup);
+      break;
+    case TypeKind::INTEGER:
+      accumulateTyped<int32_t>(accumulator, lookup);
+      break;
+    case TypeKind::BIGINT:
+      accumulateTyped<int64_t>(accumulator, lookup);
+      break;
+    case TypeKind::REAL:
+      accumulateTyped<float>(accumulator, lookup);
+      break;
+    case TypeKind::DOUBLE:
+      accumulateTyped<double>(accumulator, lookup);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+VectorPtr DenseAggregation::makeFlat(
+    const TypePtr& type,
+    const std::vector<int64_t>& counts,
+    const T* values,
+    bool nullIfEmpty) {
+  const auto numGroups = groups_.size();
+  auto result = BaseVector::create<FlatVector<T>>(type, numGroups, pool_);
+  auto* rawValues = result->mutableRawValues();
+  for (auto i = 0; i < numGroups; ++i) {
+    if (nullIfEmpty && counts[i] == 0) {
+      result->setNull(i, true);
+    } else {
+      rawValues[i] = values[i];
+    }
+  }
+  return result;
+}
+
+VectorPtr DenseAggregation::makeIntermediate(const Accumulator& accumulator) {
+  const auto& type = accumulator.intermediateType;
+  const auto& counts = accumulator.counts;
+  switch (accumulator.kind) {
+    case DenseKind::kSum:
+    case DenseKind::kCheckedSum:
+      if (type->kind() == TypeKind::DOUBLE) {
+        return makeFlat<double>(
+            type, counts, accumulator.doubles.data(), true);
+      }
+      return makeFlat<int64_t>(type, counts, accumulator.longs.data(), true);
+    case DenseKind::kCount:
+      return makeFlat<int64_t>(type, counts, counts.data(), false);
+    case DenseKind::kMin:
+    case DenseKind::kMax: {
+      const auto numGroups = groups_.size();
+      const auto& longs = accumulator.longs;
+      switch (type->kind()) {
+        case TypeKind::TINYINT: {
+          std::vector<int8_t> values(longs.begin(), longs.begin() + numGroups);
+          return makeFlat<int8_t>(type, counts, values.data(), true);
+        }
+        case TypeKind::SMALLINT: {
+          std::vector<int16_t> values(
+              longs.begin(), longs.begin() + numGroups);
+          return makeFlat<int16_t>(type, counts, values.data(), true);
+        }
+        case TypeKind::INTEGER: {
+          std::vector<int32_t> values(
+              longs.begin(), longs.begin() + numGroups);
+          return makeFlat<int32_t>(type, counts, values.data(), true);
+        }
+        case TypeKind::BIGINT:
+          return makeFlat<int64_t>(type, counts, longs.data(), true);
+        default:
+          VELOX_UNREACHABLE();
+      }
+    }
+    case DenseKind::kAvg: {
+      const auto numGroups = groups_.size();
+      const auto& rowType = type->asRow();
+      auto sums = makeFlat<double>(
+          rowType.childAt(0), counts, accumulator.doubles.data(), false);
+      auto sumCounts =
+          makeFlat<int64_t>(rowType.childAt(1), counts, counts.data(), false);
+      auto result = std::make_shared<RowVector>(
+          pool_,
+          type,
+          nullptr,
+          numGroups,
+          std::vector<VectorPtr>{std::move(sums), std::move(sumCounts)});
+      for (auto i = 0; i < numGroups; ++i) {
+        if (counts[i] == 0) {
+          result->setNull(i, true);
+        }
+      }
+      return result;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace facebook::velox::exec
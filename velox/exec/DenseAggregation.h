@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/Aggregate.h"
+#include "velox/exec/AggregateInfo.h"
+#include "velox/exec/HashTable.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+
+/// Adds raw input to the groups of a hash table in array mode for aggregates
+/// whose input combines as described for Aggregate::DenseKind. The rows of a
+/// batch are first combined in dense arrays with one entry per group touched
+/// by the batch. The arrays then become one intermediate result per group for
+/// each aggregate. This replaces the per-row updates of the accumulators and
+/// of their null flags in the rows of the table with updates of contiguous
+/// arrays.
+class DenseAggregation {
+ public:
+  /// Largest table in array mode for which the dense index of each slot is
+  /// kept.
+  static constexpr uint64_t kMaxSlots = 64 << 10;
+
+  /// Returns nullptr unless all of 'aggregates' can be computed this way.
+  /// @param inputType Input row type for the aggregation operator.
+  static std::unique_ptr<DenseAggregation> create(
+      const std::vector<AggregateInfo>& aggregates,
+      const RowTypePtr& inputType,
+      memory::MemoryPool* pool);
+
+  /// Adds the rows of 'input' in 'lookup.rows' after a group probe into a
+  /// table in array mode with 'numSlots' slots. 'lookup.hashes' has the slot
+  /// and 'lookup.hits' the initialized group of each row. 'rows' are the rows
+  /// that were probed.
+  void addInput(
+      const HashLookup& lookup,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows,
+      uint64_t numSlots);
+
+ private:
+  struct Accumulator {
+    Aggregate* function;
+    Aggregate::DenseKind kind;
+    // Input channel. std::nullopt for count of rows.
+    std::optional<column_index_t> channel;
+    TypePtr inputType;
+    TypePtr intermediateType;
+    // Number of non-null inputs of each dense group, or of rows for count
+    // without arguments.
+    std::vector<int64_t> counts;
+    // Integer sums, minima or maxima of each dense group.
+    std::vector<int64_t> longs;
+    // Floating point sums of each dense group.
+    std::vector<double> doubles;
+  };
+
+  DenseAggregation(
+      std::vector<Accumulator> accumulators,
+      memory::MemoryPool* pool)
+      : pool_(pool), accumulators_(std::move(accumulators)) {}
+
+  // Sets 'rowToDense_' for the rows of 'lookup' and 'groups_' for the groups
+  // they touch.
+  void mapGroups(const HashLookup& lookup, uint64_t numSlots);
+
+  // Combines the rows of 'lookup' into the dense arrays of 'accumulator'.
+  void accumulate(
+      Accumulator& accumulator,
+      const HashLookup& lookup,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows);
+
+  template <typename T>
+  void accumulateTyped(Accumulator& accumulator, const HashLookup& lookup);
+
+  // Calls 'func' with the dense index and value of each row of 'lookup' whose
+  // input in 'decoded_' is not null.
+  template <typename T, typename Func>
+  void forEachValue(const HashLookup& lookup, Func func);
+
+  // Returns the intermediate results of 'accumulator' for the groups in
+  // 'groups_'.
+  VectorPtr makeIntermediate(const Accumulator& accumulator);
+
+  template <typename T>
+  VectorPtr makeFlat(
+      const TypePtr& type,
+      const std::vector<int64_t>& counts,
+      const T* values,
+      bool nullIfEmpty);
+
+  memory::MemoryPool* const pool_;
+  std::vector<Accumulator> accumulators_;
+
+  // Dense index of each slot of the table. -1 for the slots the current batch
+  // does not touch.
+  std::vector<int32_t> slotToDense_;
+  // Dense index of each row of 'lookup.rows', 1:1 with 'lookup.rows'.
+  std::vector<int32_t> rowToDense_;
+  // Group and slot of each dense index.
+  std::vector<char*> groups_;
+  std::vector<uint64_t> slots_;
+
+  DecodedVector decoded_;
+  SelectivityVector denseRows_;
+};
+
+} // namespace facebook::velox::exec
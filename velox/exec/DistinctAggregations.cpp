@@ -36,16 +36,17 @@ class TypedDistinctAggregations : public DistinctAggregations {
 
   using AccumulatorType = aggregate::prestosql::SetAccumulator<T>;
 
-  /// Returns metadata about the accumulator used to store unique inputs.
+  /// Returns metadata about the accumulator used to store unique inputs. The
+  /// unique inputs of a group are spilled as an array.
   Accumulator accumulator() const override {
     return {
         false, // isFixedSize
         sizeof(AccumulatorType),
         false, // usesExternalMemory
         1, // alignment
-        nullptr,
-        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
-          VELOX_UNREACHABLE();
+        ARRAY(inputType_),
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
         },
         [this](folly::Range<char**> groups) {
           for (auto* group : groups) {
@@ -103,6 +104,23 @@ class TypedDistinctAggregations : public DistinctAggregations {
     inputForAccumulator_.reset();
   }
 
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) override {
+    auto* arrayVector = input->as<ArrayVector>();
+    // The rows of a spilled batch share the elements, which are decoded once.
+    if (spillElements_ != arrayVector->elements()) {
+      spillElements_ = arrayVector->elements();
+      decodedSpillElements_.decode(*spillElements_);
+    }
+
+    auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+    RowSizeTracker<char, uint32_t> tracker(group[rowSizeOffset_], *allocator_);
+    accumulator->addValues(
+        *arrayVector, index, decodedSpillElements_, allocator_);
+  }
+
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
       override {
     SelectivityVector rows;
@@ -153,6 +171,38 @@ class TypedDistinctAggregations : public DistinctAggregations {
     return aggregates_[0]->inputs.size() == 1;
   }
 
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    auto* arrayVector = result->as<ArrayVector>();
+    arrayVector->resize(groups.size());
+
+    auto* rawOffsets =
+        arrayVector->mutableOffsets(groups.size())->asMutable<vector_size_t>();
+    auto* rawSizes =
+        arrayVector->mutableSizes(groups.size())->asMutable<vector_size_t>();
+
+    vector_size_t offset = 0;
+    for (auto i = 0; i < groups.size(); ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      rawOffsets[i] = offset;
+      rawSizes[i] = accumulator->size();
+      offset += accumulator->size();
+    }
+
+    auto elements = BaseVector::create(inputType_, offset, pool_);
+    offset = 0;
+    for (auto* group : groups) {
+      auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+      if constexpr (std::is_same_v<T, ComplexType>) {
+        offset += accumulator->extractValues(*elements, offset);
+      } else {
+        offset += accumulator->extractValues(
+            *(elements->template as<FlatVector<T>>()), offset);
+      }
+    }
+    arrayVector->setElements(std::move(elements));
+  }
+
   void decodeInput(const RowVectorPtr& input, const SelectivityVector& rows) {
     inputForAccumulator_ = makeInputForAccumulator(input);
     decodedInput_.decode(*inputForAccumulator_, rows);
@@ -202,6 +252,10 @@ class TypedDistinctAggregations : public DistinctAggregations {
 
   DecodedVector decodedInput_;
   VectorPtr inputForAccumulator_;
+
+  // Elements of the last spilled batch passed to addSingleGroupSpillInput().
+  VectorPtr spillElements_;
+  DecodedVector decodedSpillElements_;
 };
 
 } // namespace
@@ -70,6 +70,14 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the unique inputs of a group in row 'index' of 'input'. 'input' is
+  /// an array of unique inputs produced by the spill extract function of
+  /// accumulator().
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
@@ -21,9 +21,12 @@
 #include <gflags/gflags.h>
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/process/CpuSampler.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/DriverExecutor.h"
+#include "velox/exec/FairShareExecutor.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Task.h"
 
@@ -142,6 +145,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       fmt::format("{}_{}_{}", pipelineId, driverId, operatorId);
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb =
       [this](uint64_t bytes) {
+        task->addSpilledBytes(bytes);
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
   return common::SpillConfig(
@@ -161,7 +165,20 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.testingSpillPct(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      prefixSortConfig(),
+      queryConfig.spillReadAheadBytes(),
+      queryConfig.spillMaxMergeFanIn());
+}
+
+std::optional<common::PrefixSortConfig> DriverCtx::prefixSortConfig() const {
+  const auto& queryConfig = task->queryCtx()->queryConfig();
+  if (queryConfig.prefixSortNormalizedKeyMaxBytes() == 0) {
+    return std::nullopt;
+  }
+  return common::PrefixSortConfig{
+      queryConfig.prefixSortNormalizedKeyMaxBytes(),
+      queryConfig.prefixSortMinRows()};
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -198,6 +215,8 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          driver->traceBlocked(
+              state->operator_, state->reason_, state->sinceMicros_);
         }
         VELOX_CHECK(!driver->state().isSuspended);
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -257,8 +276,18 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  const auto& queryCtx = driver->task()->queryCtx();
+  auto* executor = queryCtx->executor();
+  if (auto* driverExecutor = dynamic_cast<DriverExecutor*>(executor)) {
+    driverExecutor->add(
+        [driver]() { Driver::run(driver); }, driver->lastWorker_);
+    return;
+  }
+  if (auto* fairShareExecutor = dynamic_cast<FairShareExecutor*>(executor)) {
+    fairShareExecutor->add([driver]() { Driver::run(driver); }, queryCtx);
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -271,6 +300,16 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorPerfCounters_ =
+      ctx_->queryConfig().operatorTrackPerfCounters();
+  timelineTracer_ = ctx_->task->queryCtx()->timelineTracer();
+  if (timelineTracer_ != nullptr) {
+    timelineTrack_ = timelineTracer_->addTrack(fmt::format(
+        "{} pipeline {} driver {}",
+        ctx_->task->taskId(),
+        ctx_->pipelineId,
+        ctx_->driverId));
+  }
 }
 
 void Driver::initializeOperators() {
@@ -362,6 +401,8 @@ void Driver::enqueueInternal() {
   try {                                                                    \
     Operator::NonReclaimableSectionGuard nonReclaimableGuard(operatorPtr); \
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
+    process::ScopedSampledOperator sampledOperator(                        \
+        operatorPtr->operatorType(), operatorPtr->planNodeId());           \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
     auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
@@ -401,6 +442,50 @@ size_t OpCallStatusRaw::callDuration() const {
       : fmt::format("null::{}", operatorMethod);
 }
 
+process::TimelineScope Driver::traceOperatorCall(
+    const Operator* op,
+    const char* method) const {
+  if (timelineTracer_ == nullptr) {
+    return process::TimelineScope(nullptr, "", "");
+  }
+  return process::TimelineScope(
+      timelineTracer_,
+      fmt::format("{}::{}", op->operatorType(), method),
+      "operator",
+      fmt::format(
+          "plan node: {}, pipeline: {}, driver: {}",
+          op->planNodeId(),
+          ctx_->pipelineId,
+          ctx_->driverId));
+}
+
+void Driver::traceBlocked(
+    const Operator* op,
+    BlockingReason reason,
+    uint64_t sinceMicros) {
+  if (timelineTracer_ == nullptr) {
+    return;
+  }
+  timelineTracer_->addTrackEvent(
+      timelineTrack_,
+      fmt::format(
+          "{} on {}", blockingReasonToString(reason), op->operatorType()),
+      "blocked",
+      sinceMicros,
+      process::TimelineTracer::nowMicros());
+}
+
+// static
+void Driver::addPerfCounters(Operator& op, const PerfCounterValues& delta) {
+  auto lockedStats = op.stats().wlock();
+  lockedStats->addRuntimeStat("perfCycles", RuntimeCounter(delta.cycles));
+  lockedStats->addRuntimeStat(
+      "perfInstructions", RuntimeCounter(delta.instructions));
+  lockedStats->addRuntimeStat("perfLlcMisses", RuntimeCounter(delta.llcMisses));
+  lockedStats->addRuntimeStat(
+      "perfDtlbMisses", RuntimeCounter(delta.dtlbMisses));
+}
+
 CpuWallTiming Driver::processLazyTiming(
     Operator& op,
     const CpuWallTiming& timing) {
@@ -576,6 +661,8 @@ StopReason Driver::runInternal(
                     processLazyTiming(*op, deltaTiming);
                     op->stats().wlock()->getOutputTiming.add(deltaTiming);
                   });
+              auto perfCounters = createDeltaPerfCounters(op);
+              auto timelineScope = traceOperatorCall(op, kOpMethodGetOutput);
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
               CALL_OPERATOR(
@@ -615,6 +702,9 @@ StopReason Driver::runInternal(
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
+              auto perfCounters = createDeltaPerfCounters(nextOp);
+              auto timelineScope =
+                  traceOperatorCall(nextOp, kOpMethodAddInput);
 
               CALL_OPERATOR(
                   nextOp->addInput(intermediateResult),
@@ -661,6 +751,8 @@ StopReason Driver::runInternal(
                       processLazyTiming(*op, timing);
                       op->stats().wlock()->finishTiming.add(timing);
                     });
+                auto timelineScope =
+                    traceOperatorCall(nextOp, kOpMethodNoMoreInput);
                 TestValue::adjust(
                     "facebook::velox::exec::Driver::runInternal::noMoreInput",
                     nextOp);
@@ -684,6 +776,8 @@ StopReason Driver::runInternal(
                   auto selfDelta = processLazyTiming(*op, timing);
                   op->stats().wlock()->getOutputTiming.add(selfDelta);
                 });
+            auto perfCounters = createDeltaPerfCounters(op);
+            auto timelineScope = traceOperatorCall(op, kOpMethodGetOutput);
             CALL_OPERATOR(
                 result = op->getOutput(),
                 op,
@@ -757,9 +851,33 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
+  auto* queryCtx = self->task()->queryCtx().get();
+  if (auto* driverExecutor =
+          dynamic_cast<DriverExecutor*>(queryCtx->executor())) {
+    self->lastWorker_ = driverExecutor->currentWorker();
+  }
+  const auto startMicros = getCurrentTimeMicro();
+  const auto queuedMicros = startMicros - self->queueTimeStartMicros_;
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
   auto reason = self->runInternal(self, blockingState, nullResult);
+  const auto endMicros = getCurrentTimeMicro();
+  queryCtx->addDriverSchedulingTime(
+      (endMicros - startMicros) * 1'000, queuedMicros * 1'000);
+  if (auto* tracer = self->timelineTracer_) {
+    tracer->addTrackEvent(
+        self->timelineTrack_,
+        "queued",
+        "driver",
+        self->queueTimeStartMicros_,
+        startMicros);
+    tracer->addTrackEvent(
+        self->timelineTrack_,
+        fmt::format("running, {}", stopReasonString(reason)),
+        "driver",
+        startMicros,
+        endMicros);
+  }
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -863,6 +981,55 @@ bool Driver::mayPushdownAggregation(Operator* aggregation) const {
       aggregation->toString());
 }
 
+bool Driver::pushdownLimit(const Operator* limit, uint64_t numRows) const {
+  if (operators_.size() < 2 || operators_[1].get() != limit) {
+    return false;
+  }
+  auto* source = operators_[0].get();
+  if (!source->canAddLimit()) {
+    return false;
+  }
+  source->addLimit(numRows);
+  return true;
+}
+
+bool Driver::pushdownStatisticsAggregation(
+    const Operator* aggregation,
+    const std::shared_ptr<const connector::StatisticsAggregation>&
+        statisticsAggregation) const {
+  if (operators_.size() < 2 || operators_[1].get() != aggregation) {
+    return false;
+  }
+  auto* source = operators_[0].get();
+  if (!source->canAddStatisticsAggregation()) {
+    return false;
+  }
+  source->addStatisticsAggregation(statisticsAggregation);
+  return true;
+}
+
+bool Driver::pushdownSplitResultListener(
+    const Operator* consumer,
+    SplitResultListener* listener) const {
+  for (auto i = 1; i < operators_.size(); ++i) {
+    auto* op = operators_[i].get();
+    if (op == consumer) {
+      auto* source = operators_[0].get();
+      if (!source->canAddSplitResultListener()) {
+        return false;
+      }
+      source->addSplitResultListener(listener);
+      return true;
+    }
+    // Filters and projections hold no rows across calls, so the rows of a
+    // split reach 'consumer' before the source produces the next split.
+    if (op->operatorType() != "FilterProject") {
+      return false;
+    }
+  }
+  return false;
+}
+
 std::unordered_set<column_index_t> Driver::canPushdownFilters(
     const Operator* filterSource,
     const std::vector<column_index_t>& channels) const {
@@ -21,7 +21,9 @@
 
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/process/ThreadDebugInfo.h"
+#include "velox/common/process/TimelineTracer.h"
 #include "velox/common/time/CpuWallTimer.h"
+#include "velox/common/time/PerfCounters.h"
 #include "velox/connectors/Connector.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/PlanNode.h"
@@ -34,6 +36,7 @@ class Driver;
 class ExchangeClient;
 class Operator;
 struct OperatorStats;
+class SplitResultListener;
 class Task;
 
 enum class StopReason {
@@ -106,6 +109,10 @@ struct ThreadState {
   /// decision. The thread is not supposed to access its memory, which a third
   /// party can revoke while the thread is in this state.
   bool isSuspended{false};
+  /// True if created by the Task but not started yet. The Task starts the
+  /// Driver when its pipeline has queued input, see
+  /// QueryConfig::maxInitialDriversPerPipeline().
+  bool isDeferred{false};
   /// The start execution time on thread in milliseconds. It is reset when the
   /// driver goes off thread. This is used to track the time that a driver has
   /// continuously run on a thread for per-driver cpu time slice enforcement.
@@ -149,6 +156,7 @@ struct ThreadState {
     obj["isEnqueued"] = isEnqueued.load();
     obj["hasBlockingFuture"] = hasBlockingFuture;
     obj["isSuspended"] = isSuspended;
+    obj["isDeferred"] = isDeferred;
     obj["startExecTime"] = startExecTimeMs;
     return obj;
   }
@@ -262,6 +270,10 @@ struct DriverCtx {
 
   /// Builds the spill config for the operator with specified 'operatorId'.
   std::optional<common::SpillConfig> makeSpillConfig(int32_t operatorId) const;
+
+  /// Builds the prefix-sort config from the query config. Returns null if
+  /// prefix-sort is disabled.
+  std::optional<common::PrefixSortConfig> prefixSortConfig() const;
 };
 
 constexpr const char* kOpMethodNone = "";
@@ -359,6 +371,13 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// time slice limit if set.
   bool shouldYield() const;
 
+  /// Records that the driver was blocked on 'op' for 'reason' from
+  /// 'sinceMicros' until now in the timeline of the query, if enabled.
+  void traceBlocked(
+      const Operator* op,
+      BlockingReason reason,
+      uint64_t sinceMicros);
+
   void initializeOperatorStats(std::vector<OperatorStats>& stats);
 
   /// Close operators and add operator stats to the task.
@@ -368,6 +387,25 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* aggregation) const;
 
+  /// Passes 'numRows' to the source operator if 'limit' directly consumes the
+  /// output of the source and the source accepts it. Returns true if passed.
+  bool pushdownLimit(const Operator* limit, uint64_t numRows) const;
+
+  /// Passes 'statisticsAggregation' to the source operator if 'aggregation'
+  /// directly consumes the output of the source and the source accepts it.
+  /// Returns true if passed.
+  bool pushdownStatisticsAggregation(
+      const Operator* aggregation,
+      const std::shared_ptr<const connector::StatisticsAggregation>&
+          statisticsAggregation) const;
+
+  /// Passes 'listener' to the source operator if only filters and projections
+  /// are between the source and 'consumer' and the source accepts it. Returns
+  /// true if passed.
+  bool pushdownSplitResultListener(
+      const Operator* consumer,
+      SplitResultListener* listener) const;
+
   /// Returns a subset of channels for which there are operators upstream from
   /// filterSource that accept dynamically generated filters.
   std::unordered_set<column_index_t> canPushdownFilters(
@@ -462,6 +500,29 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  // If 'trackOperatorPerfCounters_' is true and perf events are available,
+  // returns an object that adds the hardware counts between its construction
+  // and destruction to the runtime stats of 'op'. Returns null otherwise.
+  auto createDeltaPerfCounters(Operator* op) {
+    auto func = [op](const PerfCounterValues& delta) {
+      addPerfCounters(*op, delta);
+    };
+    using Counters = DeltaPerfCounters<decltype(func)>;
+    auto* counters =
+        trackOperatorPerfCounters_ ? PerfCounters::forThread() : nullptr;
+    return counters != nullptr
+        ? std::make_unique<Counters>(*counters, std::move(func))
+        : std::unique_ptr<Counters>();
+  }
+
+  static void addPerfCounters(Operator& op, const PerfCounterValues& delta);
+
+  // Returns a scope that records a call of 'method' of 'op' in the timeline
+  // of the query. The scope is a no-op if the timeline is not enabled.
+  process::TimelineScope traceOperatorCall(
+      const Operator* op,
+      const char* method) const;
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -486,6 +547,10 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   // Timer used to track down the time we are sitting in the driver queue.
   size_t queueTimeStartMicros_{0};
+
+  // The DriverExecutor worker 'this' last ran on, -1 if none. Passed as the
+  // preferred worker when enqueuing 'this' again.
+  int32_t lastWorker_{-1};
   // Id (index in the vector) of the current operator to run (or the 1st one if
   // we haven't started yet). Used to determine which operator's queueTime we
   // should update.
@@ -497,6 +562,13 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool trackOperatorPerfCounters_;
+
+  // Timeline of the query and the track of 'this' in it. nullptr if the
+  // timeline is not enabled.
+  process::TimelineTracer* timelineTracer_{nullptr};
+  int32_t timelineTrack_{-1};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverExecutor.h"
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <fstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// The executor and worker the calling thread runs for.
+thread_local const DriverExecutor* currentExecutor{nullptr};
+thread_local int32_t currentWorkerIndex{-1};
+
+// Returns the cpus in a list like "0-3,8,10-11".
+std::vector<int32_t> parseCpuList(const std::string& list) {
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(list), ranges);
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    folly::StringPiece first;
+    folly::StringPiece last;
+    if (!folly::split('-', range, first, last)) {
+      first = range;
+      last = range;
+    }
+    for (auto cpu = folly::to<int32_t>(first); cpu <= folly::to<int32_t>(last);
+         ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// Returns the NUMA node of each cpu the process may run on, ordered by node
+// and cpu. All cpus are on node 0 if the topology is not known.
+std::vector<std::pair<int32_t, int32_t>> cpusByNode() {
+  std::vector<std::pair<int32_t, int32_t>> result;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return result;
+  }
+  std::vector<int32_t> cpuNodes(CPU_SETSIZE, 0);
+  for (auto node = 0;; ++node) {
+    std::ifstream in(
+        fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+    if (!in) {
+      break;
+    }
+    std::string list;
+    std::getline(in, list);
+    for (auto cpu : parseCpuList(list)) {
+      if (cpu < CPU_SETSIZE) {
+        cpuNodes[cpu] = node;
+      }
+    }
+  }
+  for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      result.emplace_back(cpu, cpuNodes[cpu]);
+    }
+  }
+  std::stable_sort(result.begin(), result.end(), [](auto left, auto right) {
+    return left.second < right.second;
+  });
+#endif
+  return result;
+}
+
+void pinToCpu(int32_t cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  const auto rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (rc != 0) {
+    LOG(WARNING) << "Failed to pin driver thread to cpu " << cpu << ": "
+                 << folly::errnoStr(rc);
+  }
+#endif
+}
+} // namespace
+
+std::string DriverExecutor::Stats::toString() const {
+  return fmt::format(
+      "tasks: {} steals: {} cross node steals: {} cross node resumes: {}",
+      numTasks,
+      numSteals,
+      numCrossNodeSteals,
+      numCrossNodeResumes);
+}
+
+DriverExecutor::DriverExecutor(Options options) {
+  const auto cpus = cpusByNode();
+  auto numThreads = options.numThreads;
+  if (numThreads <= 0) {
+    numThreads = cpus.empty()
+        ? static_cast<int32_t>(std::thread::hardware_concurrency())
+        : static_cast<int32_t>(cpus.size());
+  }
+  VELOX_CHECK_GT(numThreads, 0);
+  workers_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    auto worker = std::make_unique<Worker>();
+    if (options.pinThreads && !cpus.empty()) {
+      worker->cpu = cpus[i % cpus.size()].first;
+      worker->node = cpus[i % cpus.size()].second;
+    }
+    workers_.push_back(std::move(worker));
+  }
+  for (auto i = 0; i < numThreads; ++i) {
+    auto& victims = workers_[i]->victims;
+    for (auto offset = 1; offset < numThreads; ++offset) {
+      victims.push_back((i + offset) % numThreads);
+    }
+    std::stable_partition(victims.begin(), victims.end(), [&](auto victim) {
+      return workers_[victim]->node == workers_[i]->node;
+    });
+  }
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_[i]->thread = std::thread([this, i]() { run(i); });
+  }
+}
+
+DriverExecutor::~DriverExecutor() {
+  join();
+}
+
+void DriverExecutor::add(folly::Func func) {
+  add(std::move(func), -1);
+}
+
+void DriverExecutor::add(folly::Func func, int32_t preferredWorker) {
+  VELOX_CHECK(!stopped_, "Adding a task to a stopped DriverExecutor");
+  int32_t worker = preferredWorker;
+  if (worker < 0) {
+    worker = currentWorker();
+  }
+  if (worker < 0) {
+    worker = nextWorker_++ % workers_.size();
+  }
+  VELOX_CHECK_LT(worker, workers_.size());
+  push(worker, Task{std::move(func), preferredWorker});
+}
+
+int32_t DriverExecutor::currentWorker() const {
+  return currentExecutor == this ? currentWorkerIndex : -1;
+}
+
+void DriverExecutor::push(int32_t worker, Task task) {
+  {
+    std::lock_guard<std::mutex> l(workers_[worker]->mutex);
+    workers_[worker]->queue.push_back(std::move(task));
+  }
+  ++numQueued_;
+  wakeUp(worker);
+}
+
+void DriverExecutor::wakeUp(int32_t worker) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* target = workers_[worker].get();
+  if (!target->idle) {
+    // The worker will get to the task when done with the current one. Wakes
+    // up another to steal it meanwhile.
+    target = nullptr;
+    for (auto victim : workers_[worker]->victims) {
+      if (workers_[victim]->idle) {
+        target = workers_[victim].get();
+        break;
+      }
+    }
+  }
+  if (target != nullptr) {
+    target->idle = false;
+    target->cv.notify_one();
+  }
+}
+
+bool DriverExecutor::next(int32_t worker, Task& task) {
+  auto& self = *workers_[worker];
+  {
+    std::lock_guard<std::mutex> l(self.mutex);
+    if (!self.queue.empty()) {
+      task = std::move(self.queue.front());
+      self.queue.pop_front();
+      --numQueued_;
+      return true;
+    }
+  }
+  for (auto victimIndex : self.victims) {
+    auto& victim = *workers_[victimIndex];
+    std::lock_guard<std::mutex> l(victim.mutex);
+    if (victim.queue.empty()) {
+      continue;
+    }
+    // Takes the most recently added task, which the victim would run last.
+    task = std::move(victim.queue.back());
+    victim.queue.pop_back();
+    --numQueued_;
+    ++numSteals_;
+    if (victim.node != self.node) {
+      ++numCrossNodeSteals_;
+    }
+    return true;
+  }
+  return false;
+}
+
+void DriverExecutor::run(int32_t worker) {
+  currentExecutor = this;
+  currentWorkerIndex = worker;
+  auto& self = *workers_[worker];
+  if (self.cpu >= 0) {
+    pinToCpu(self.cpu);
+  }
+  Task task;
+  for (;;) {
+    if (next(worker, task)) {
+      if (task.preferredWorker >= 0 &&
+          workers_[task.preferredWorker]->node != self.node) {
+        ++numCrossNodeResumes_;
+      }
+      ++numTasks_;
+      try {
+        task.func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "DriverExecutor task threw: " << e.what();
+      }
+      task.func = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> l(mutex_);
+    if (numQueued_ > 0) {
+      continue;
+    }
+    if (stopped_) {
+      return;
+    }
+    self.idle = true;
+    self.cv.wait(l, [&]() { return !self.idle || stopped_; });
+    self.idle = false;
+  }
+}
+
+void DriverExecutor::join() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+    for (auto& worker : workers_) {
+      worker->cv.notify_one();
+    }
+  }
+  for (auto& worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+DriverExecutor::Stats DriverExecutor::stats() const {
+  Stats stats;
+  stats.numTasks = numTasks_;
+  stats.numSteals = numSteals_;
+  stats.numCrossNodeSteals = numCrossNodeSteals_;
+  stats.numCrossNodeResumes = numCrossNodeResumes_;
+  return stats;
+}
+
+} // namespace facebook::velox::exec
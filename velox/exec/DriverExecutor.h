@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Executor for Drivers with one queue per worker thread. A worker runs the
+/// tasks of its own queue in order and steals from the back of the queues of
+/// other workers when its own is empty, first from workers on its own NUMA
+/// node. Workers may be pinned to a core each, so that a Driver resumed on
+/// the worker where it last ran finds its data in the caches and memory of
+/// that node. Driver::enqueue() passes the worker where the Driver last ran
+/// as the preferred worker if the QueryCtx executor is a DriverExecutor.
+class DriverExecutor : public folly::Executor {
+ public:
+  struct Options {
+    /// Number of worker threads. 0 means one per hardware thread.
+    int32_t numThreads{0};
+
+    /// If true, worker i is pinned to the i-th cpu of the process in the
+    /// order of NUMA nodes.
+    bool pinThreads{false};
+  };
+
+  struct Stats {
+    /// Number of tasks run.
+    uint64_t numTasks{0};
+
+    /// Tasks taken from the queue of another worker.
+    uint64_t numSteals{0};
+
+    /// Tasks taken from the queue of a worker on another NUMA node.
+    uint64_t numCrossNodeSteals{0};
+
+    /// Tasks with a preferred worker that ran on another NUMA node than the
+    /// preferred worker.
+    uint64_t numCrossNodeResumes{0};
+
+    std::string toString() const;
+  };
+
+  explicit DriverExecutor(Options options);
+
+  ~DriverExecutor() override;
+
+  /// Adds 'func' to the queue of the calling worker or, if not called on a
+  /// worker, to the queue of the next worker in round robin order.
+  void add(folly::Func func) override;
+
+  /// Adds 'func' to the queue of 'preferredWorker'. A negative
+  /// 'preferredWorker' is the same as add(func).
+  void add(folly::Func func, int32_t preferredWorker);
+
+  /// Returns the index of the worker of 'this' the caller runs on or -1 if
+  /// the caller is not a worker of 'this'.
+  int32_t currentWorker() const;
+
+  /// Stops accepting tasks, runs the queued tasks and joins the workers.
+  void join();
+
+  int32_t numThreads() const {
+    return workers_.size();
+  }
+
+  /// Returns the NUMA node of 'worker'.
+  int32_t nodeOf(int32_t worker) const {
+    return workers_[worker]->node;
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Task {
+    folly::Func func;
+    // Worker the task was added for, -1 if none.
+    int32_t preferredWorker;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> queue;
+    // Cpu the thread is pinned to, -1 if not pinned.
+    int32_t cpu{-1};
+    // NUMA node of 'cpu', 0 if not pinned.
+    int32_t node{0};
+    // The workers to steal from in order of preference. The ones on the same
+    // node come first.
+    std::vector<int32_t> victims;
+    // True if the worker waits on 'cv'. Guarded by DriverExecutor::mutex_.
+    bool idle{false};
+    std::condition_variable cv;
+    std::thread thread;
+  };
+
+  void push(int32_t worker, Task task);
+
+  // Wakes up 'worker' if idle, else an idle worker to steal the task added
+  // for 'worker', preferring one on the same node.
+  void wakeUp(int32_t worker);
+
+  // Sets 'task' to the next task of 'worker' from its own queue or stolen
+  // from another. Returns false if there is none.
+  bool next(int32_t worker, Task& task);
+
+  void run(int32_t worker);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Serializes sleeping and waking up of workers.
+  std::mutex mutex_;
+  // Number of tasks in the queues of all workers.
+  std::atomic<int64_t> numQueued_{0};
+  std::atomic<bool> stopped_{false};
+
+  std::atomic<uint32_t> nextWorker_{0};
+
+  std::atomic<uint64_t> numTasks_{0};
+  std::atomic<uint64_t> numSteals_{0};
+  std::atomic<uint64_t> numCrossNodeSteals_{0};
+  std::atomic<uint64_t> numCrossNodeResumes_{0};
+};
+
+} // namespace facebook::velox::exec
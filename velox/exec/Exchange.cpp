@@ -15,6 +15,7 @@
  */
 #include "velox/exec/Exchange.h"
 #include "velox/exec/Task.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -116,14 +117,20 @@ RowVectorPtr Exchange::getOutput() {
 
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
-  for (const auto& page : currentPages_) {
+  for (auto& page : currentPages_) {
     rawInputBytes += page->size();
 
     auto inputStream = page->prepareStreamForDeserialize();
+    const auto options = deserializeOptions(page);
 
     while (!inputStream.atEnd()) {
       getSerde()->deserialize(
-          &inputStream, pool(), outputType_, &result_, resultOffset);
+          &inputStream,
+          pool(),
+          outputType_,
+          &result_,
+          resultOffset,
+          options.get());
       resultOffset = result_->size();
     }
   }
@@ -140,6 +147,23 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+std::unique_ptr<VectorSerde::Options> Exchange::deserializeOptions(
+    std::unique_ptr<SerializedPage>& page) {
+  using PrestoVectorSerde = serializer::presto::PrestoVectorSerde;
+  if ((!zeroCopyDeserialize_ &&
+       compressionKind_ == common::CompressionKind_NONE) ||
+      dynamic_cast<PrestoVectorSerde*>(getSerde()) == nullptr) {
+    return nullptr;
+  }
+  auto options = std::make_unique<PrestoVectorSerde::PrestoOptions>();
+  options->compressionKind = compressionKind_;
+  if (zeroCopyDeserialize_) {
+    options->zeroCopy = true;
+    options->sourceOwner = std::shared_ptr<SerializedPage>(std::move(page));
+  }
+  return options;
+}
+
 void Exchange::close() {
   SourceOperator::close();
   currentPages_.clear();
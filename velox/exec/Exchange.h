@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <random>
+#include "velox/common/compression/Compression.h"
 #include "velox/exec/ExchangeClient.h"
 #include "velox/exec/Operator.h"
 
@@ -50,6 +51,10 @@ class Exchange : public SourceOperator {
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
+        zeroCopyDeserialize_{
+            driverCtx->queryConfig().exchangeZeroCopyDeserialize()},
+        compressionKind_{common::stringToCompressionKind(
+            driverCtx->queryConfig().shuffleCompressionKind())},
         exchangeClient_{std::move(exchangeClient)} {}
 
   ~Exchange() override {
@@ -87,11 +92,24 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  /// Returns the options for deserializing 'page' or nullptr for the serde
+  /// defaults. If deserializing without copy, 'page' is moved into the
+  /// options, which share it with the vectors that reference it.
+  std::unique_ptr<VectorSerde::Options> deserializeOptions(
+      std::unique_ptr<SerializedPage>& page);
+
   const uint64_t preferredOutputBatchBytes_;
 
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
+
+  /// True if pages in Presto format are deserialized without copying values
+  /// that are contiguous in the page.
+  const bool zeroCopyDeserialize_;
+
+  /// Codec of the compressed pages in Presto format.
+  const common::CompressionKind compressionKind_;
   bool noMoreSplits_ = false;
 
   /// A future received from Task::getSplitOrFuture(). It will be complete when
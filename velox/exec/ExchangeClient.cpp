@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeClient.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -47,10 +50,11 @@ void ExchangeClient::addRemoteTaskId(const std::string& taskId) {
       toClose = std::move(source);
     } else {
       sources_.push_back(source);
+      sourceStates_[source.get()];
       queue_->addSourceLocked();
       // Put new source into 'producingSources_' queue to prioritise fetching
       // from these to find out whether these are productive or not.
-      producingSources_.push(source);
+      addProducingSourceLocked(source, 0);
 
       requestSpec = pickSourcesToRequestLocked();
     }
@@ -110,6 +114,9 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  if (sourceWaitWallNanos_.count > 0) {
+    stats[kSourceWaitWallNanos] = sourceWaitWallNanos_;
+  }
 
   return stats;
 }
@@ -140,8 +147,10 @@ ExchangeClient::next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future) {
 
 void ExchangeClient::request(const RequestSpec& requestSpec) {
   auto self = shared_from_this();
-  for (auto& source : requestSpec.sources) {
-    auto future = source->request(requestSpec.maxBytes, kDefaultMaxWaitSeconds);
+  for (auto& [source, maxBytes] : requestSpec.requests) {
+    auto future = source->request(
+        std::min<int64_t>(maxBytes, std::numeric_limits<uint32_t>::max()),
+        kDefaultMaxWaitSeconds);
     VELOX_CHECK(future.valid());
     std::move(future)
         .via(executor_)
@@ -152,9 +161,20 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
             if (self->closed_) {
               return;
             }
+            auto& state = self->sourceStates_[requestSource.get()];
+            const auto waitMicros =
+                getCurrentTimeMicro() - state.requestStartMicros;
+            self->sourceWaitWallNanos_.addValue(waitMicros * 1'000);
+            RECORD_HISTOGRAM_METRIC_VALUE(
+                kMetricExchangeRequestLatencyMs, waitMicros / 1'000);
+            state.backlogBytes = 0;
+            for (auto bytes : response.remainingBytes) {
+              state.backlogBytes += bytes;
+            }
             if (!response.atEnd) {
-              if (response.bytes > 0) {
-                self->producingSources_.push(requestSource);
+              if (response.bytes > 0 || state.backlogBytes > 0) {
+                self->addProducingSourceLocked(
+                    requestSource, state.backlogBytes);
               } else {
                 self->emptySources_.push(requestSource);
               }
@@ -170,14 +190,23 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
   }
 }
 
-int32_t ExchangeClient::countPendingSourcesLocked() {
-  int32_t numPending = 0;
+void ExchangeClient::addProducingSourceLocked(
+    std::shared_ptr<ExchangeSource> source,
+    int64_t backlogBytes) {
+  producingSources_.push(
+      {std::move(source), backlogBytes, producingSequence_++});
+}
+
+int64_t ExchangeClient::pendingBytesLocked(int32_t& numPending) {
+  numPending = 0;
+  int64_t pendingBytes = 0;
   for (auto& source : sources_) {
     if (source->isRequestPendingLocked()) {
       ++numPending;
+      pendingBytes += sourceStates_[source.get()].requestedBytes;
     }
   }
-  return numPending;
+  return pendingBytes;
 }
 
 int64_t ExchangeClient::getAveragePageSize() {
@@ -190,31 +219,35 @@ int64_t ExchangeClient::getAveragePageSize() {
   return averagePageSize;
 }
 
-int32_t ExchangeClient::getNumSourcesToRequestLocked(int64_t averagePageSize) {
-  // Figure out how many more 'averagePageSize' fit into 'maxQueuedBytes_'.
-  // Make sure to leave room for 'numPending' pages.
-  const auto numPending = countPendingSourcesLocked();
-
-  auto numToRequest = std::max<int32_t>(
-      1, (maxQueuedBytes_ - queue_->totalBytes()) / averagePageSize);
-  if (numToRequest <= numPending) {
-    return 0;
-  }
-
-  return numToRequest - numPending;
-}
-
-void ExchangeClient::pickSourcesToRequestLocked(
-    RequestSpec& requestSpec,
-    int32_t numToRequest,
-    std::queue<std::shared_ptr<ExchangeSource>>& sources) {
-  while (requestSpec.sources.size() < numToRequest && !sources.empty()) {
-    auto& source = sources.front();
-    if (source->shouldRequestLocked()) {
-      requestSpec.sources.push_back(source);
+bool ExchangeClient::pickSourceLocked(
+    const std::shared_ptr<ExchangeSource>& source,
+    int64_t averagePageSize,
+    bool mustRequest,
+    int64_t& available,
+    RequestSpec& requestSpec) {
+  auto& state = sourceStates_[source.get()];
+  // Asks for all of the known backlog at once so that a source with many
+  // buffered pages does not need a round trip per page. Otherwise asks for
+  // one page of average size.
+  const auto wanted =
+      state.backlogBytes > 0 ? state.backlogBytes : averagePageSize;
+  auto bytes = std::min(wanted, available);
+  if (bytes < std::min(wanted, averagePageSize)) {
+    if (!mustRequest) {
+      return false;
     }
-    sources.pop();
+    // Nothing is in flight. Requests at least one page even if the queue is
+    // almost full.
+    bytes = std::min(wanted, averagePageSize);
   }
+  if (!source->shouldRequestLocked()) {
+    return true;
+  }
+  state.requestedBytes = bytes;
+  state.requestStartMicros = getCurrentTimeMicro();
+  available -= bytes;
+  requestSpec.requests.push_back({source, bytes});
+  return true;
 }
 
 ExchangeClient::RequestSpec ExchangeClient::pickSourcesToRequestLocked() {
@@ -223,19 +256,40 @@ ExchangeClient::RequestSpec ExchangeClient::pickSourcesToRequestLocked() {
   }
 
   const auto averagePageSize = getAveragePageSize();
-  const auto numToRequest = getNumSourcesToRequestLocked(averagePageSize);
-
-  if (numToRequest == 0) {
-    return {};
-  }
+  // Leave room for the data asked for by the pending requests.
+  int32_t numPending;
+  const auto pendingBytes = pendingBytesLocked(numPending);
+  auto available = maxQueuedBytes_ - queue_->totalBytes() - pendingBytes;
 
   RequestSpec requestSpec;
-  requestSpec.maxBytes = averagePageSize;
-
-  // Pick up to 'numToRequest' next sources to request data from. Prioritize
-  // sources that return data.
-  pickSourcesToRequestLocked(requestSpec, numToRequest, producingSources_);
-  pickSourcesToRequestLocked(requestSpec, numToRequest, emptySources_);
+  // Pick the next sources to request data from while there is room for their
+  // data. Prioritize sources that return data and the ones with the largest
+  // backlog among these.
+  while (!producingSources_.empty()) {
+    const auto& next = producingSources_.top();
+    const bool mustRequest = numPending == 0 && requestSpec.requests.empty();
+    if (!pickSourceLocked(
+            next.source,
+            averagePageSize,
+            mustRequest,
+            available,
+            requestSpec)) {
+      return requestSpec;
+    }
+    producingSources_.pop();
+  }
+  while (!emptySources_.empty()) {
+    const bool mustRequest = numPending == 0 && requestSpec.requests.empty();
+    if (!pickSourceLocked(
+            emptySources_.front(),
+            averagePageSize,
+            mustRequest,
+            available,
+            requestSpec)) {
+      return requestSpec;
+    }
+    emptySources_.pop();
+  }
 
   return requestSpec;
 }
@@ -27,6 +27,9 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   static constexpr int32_t kDefaultMaxQueuedBytes = 32 << 20; // 32 MB.
   static constexpr int32_t kDefaultMaxWaitSeconds = 2;
   static inline const std::string kBackgroundCpuTimeMs = "backgroundCpuTimeMs";
+  /// Runtime metric for the wall time between sending a request to a source
+  /// and receiving the response. One value per response.
+  static inline const std::string kSourceWaitWallNanos = "sourceWaitWallNanos";
 
   ExchangeClient(
       std::string taskId,
@@ -53,6 +56,7 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
     VELOX_CHECK_NULL(dynamic_cast<const folly::InlineLikeExecutor*>(executor_));
     VELOX_CHECK_GE(
         destination, 0, "Exchange client destination must not be negative");
+    sourceWaitWallNanos_.enableHistogram();
   }
 
   ~ExchangeClient();
@@ -100,22 +104,60 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // A list of sources to request data from and how much to request from each
   // (in bytes).
   struct RequestSpec {
-    std::vector<std::shared_ptr<ExchangeSource>> sources;
-    int64_t maxBytes;
+    struct Request {
+      std::shared_ptr<ExchangeSource> source;
+      int64_t maxBytes;
+    };
+    std::vector<Request> requests;
+  };
+
+  // Flow control state of a source.
+  struct SourceState {
+    // Bytes buffered at the source as of the latest response.
+    int64_t backlogBytes{0};
+    // Bytes asked for by the latest request.
+    int64_t requestedBytes{0};
+    // Time of the latest request.
+    uint64_t requestStartMicros{0};
+  };
+
+  // A source that returned data on its latest request. Sources with a
+  // larger backlog are requested first. Sources with the same backlog are
+  // requested in the order they responded.
+  struct ProducingSource {
+    std::shared_ptr<ExchangeSource> source;
+    int64_t backlogBytes;
+    uint64_t sequence;
+
+    bool operator<(const ProducingSource& other) const {
+      if (backlogBytes != other.backlogBytes) {
+        return backlogBytes < other.backlogBytes;
+      }
+      return sequence > other.sequence;
+    }
   };
 
   int64_t getAveragePageSize();
 
-  int32_t getNumSourcesToRequestLocked(int64_t averagePageSize);
+  // Returns the bytes requested from the sources with a pending request and
+  // sets 'numPending' to the number of these.
+  int64_t pendingBytesLocked(int32_t& numPending);
 
   RequestSpec pickSourcesToRequestLocked();
 
-  void pickSourcesToRequestLocked(
-      RequestSpec& requestSpec,
-      int32_t numToRequest,
-      std::queue<std::shared_ptr<ExchangeSource>>& sources);
+  // Adds 'source' to 'requestSpec' if 'source' can be requested and
+  // 'available' bytes are enough for its request. Returns false if no more
+  // sources should be requested.
+  bool pickSourceLocked(
+      const std::shared_ptr<ExchangeSource>& source,
+      int64_t averagePageSize,
+      bool mustRequest,
+      int64_t& available,
+      RequestSpec& requestSpec);
 
-  int32_t countPendingSourcesLocked();
+  void addProducingSourceLocked(
+      std::shared_ptr<ExchangeSource> source,
+      int64_t backlogBytes);
 
   void request(const RequestSpec& requestSpec);
 
@@ -131,11 +173,16 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::vector<std::shared_ptr<ExchangeSource>> sources_;
   bool closed_{false};
 
-  // A queue of sources that have returned non-empty response from the latest
-  // request.
-  std::queue<std::shared_ptr<ExchangeSource>> producingSources_;
+  folly::F14FastMap<const ExchangeSource*, SourceState> sourceStates_;
+
+  // Sources that have returned non-empty response from the latest request
+  // ordered by backlog.
+  std::priority_queue<ProducingSource> producingSources_;
+  uint64_t producingSequence_{0};
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  RuntimeMetric sourceWaitWallNanos_{RuntimeCounter::Unit::kNanos};
 };
 
 } // namespace facebook::velox::exec
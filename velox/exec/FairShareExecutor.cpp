@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FairShareExecutor.h"
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+namespace {
+std::vector<uint64_t> toNanos(const std::vector<int64_t>& millis) {
+  std::vector<uint64_t> nanos;
+  nanos.reserve(millis.size());
+  for (auto ms : millis) {
+    VELOX_CHECK_GE(ms, 0);
+    nanos.push_back(ms * 1'000'000);
+  }
+  return nanos;
+}
+} // namespace
+
+FairShareExecutor::FairShareExecutor(Options options)
+    : levelThresholdsNanos_(toNanos(options.levelThresholdsMs)) {
+  VELOX_CHECK(!levelThresholdsNanos_.empty());
+  VELOX_CHECK_EQ(levelThresholdsNanos_[0], 0);
+  VELOX_CHECK(
+      std::is_sorted(levelThresholdsNanos_.begin(), levelThresholdsNanos_.end()));
+  VELOX_CHECK_GT(options.levelTimeMultiplier, 0);
+  levelWeights_.resize(numLevels());
+  uint64_t weight = 1;
+  for (auto level = numLevels() - 1; level >= 0; --level) {
+    levelWeights_[level] = weight;
+    weight *= options.levelTimeMultiplier;
+  }
+  levelQueries_.resize(numLevels());
+  levelScheduledNanos_.resize(numLevels(), 0);
+
+  auto numThreads = options.numThreads;
+  if (numThreads <= 0) {
+    numThreads = std::thread::hardware_concurrency();
+  }
+  VELOX_CHECK_GT(numThreads, 0);
+  threads_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    threads_.emplace_back([this]() { run(); });
+  }
+}
+
+FairShareExecutor::~FairShareExecutor() {
+  join();
+}
+
+void FairShareExecutor::add(folly::Func func) {
+  add(std::move(func), nullptr);
+}
+
+void FairShareExecutor::add(
+    folly::Func func,
+    std::shared_ptr<core::QueryCtx> query) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!stopped_, "Adding a task to a stopped FairShareExecutor");
+  const auto* key = query.get();
+  auto& queryTasks = queries_[key];
+  const bool wasQueued = !queryTasks.tasks.empty();
+  queryTasks.tasks.push_back(Task{std::move(func), std::move(query)});
+  if (!wasQueued) {
+    enqueueLocked(key, levelOf(scheduledNanos(key)));
+  }
+  ++numQueued_;
+  cv_.notify_one();
+}
+
+int32_t FairShareExecutor::levelOf(uint64_t scheduledNanos) const {
+  return std::upper_bound(
+             levelThresholdsNanos_.begin(),
+             levelThresholdsNanos_.end(),
+             scheduledNanos) -
+      levelThresholdsNanos_.begin() - 1;
+}
+
+// static
+uint64_t FairShareExecutor::scheduledNanos(const core::QueryCtx* query) {
+  return query == nullptr ? 0 : query->driverScheduledNanos();
+}
+
+std::vector<uint64_t> FairShareExecutor::levelScheduledNanos() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return levelScheduledNanos_;
+}
+
+void FairShareExecutor::enqueueLocked(
+    const core::QueryCtx* query,
+    int32_t level) {
+  if (levelQueries_[level].empty()) {
+    // A level has no claim on the time it had nothing to run. Raises its
+    // time to the share of the level that is furthest behind, so that it
+    // does not take all threads until it catches up.
+    std::optional<double> minShare;
+    for (auto i = 0; i < numLevels(); ++i) {
+      if (!levelQueries_[i].empty()) {
+        const double share =
+            static_cast<double>(levelScheduledNanos_[i]) / levelWeights_[i];
+        minShare = minShare.has_value() ? std::min(*minShare, share) : share;
+      }
+    }
+    if (minShare.has_value()) {
+      levelScheduledNanos_[level] = std::max<uint64_t>(
+          levelScheduledNanos_[level], *minShare * levelWeights_[level]);
+    }
+  }
+  queries_[query].level = level;
+  levelQueries_[level].push_back(query);
+}
+
+FairShareExecutor::Task FairShareExecutor::nextLocked(int32_t& level) {
+  VELOX_CHECK_GT(numQueued_, 0);
+  level = -1;
+  double minShare = 0;
+  for (auto i = 0; i < numLevels(); ++i) {
+    if (levelQueries_[i].empty()) {
+      continue;
+    }
+    const double share =
+        static_cast<double>(levelScheduledNanos_[i]) / levelWeights_[i];
+    if (level < 0 || share < minShare) {
+      level = i;
+      minShare = share;
+    }
+  }
+  VELOX_CHECK_GE(level, 0);
+  auto& queries = levelQueries_[level];
+  auto it = std::min_element(
+      queries.begin(), queries.end(), [](auto* left, auto* right) {
+        return scheduledNanos(left) < scheduledNanos(right);
+      });
+  const auto* query = *it;
+  queries.erase(it);
+  auto queryTasksIt = queries_.find(query);
+  VELOX_CHECK(queryTasksIt != queries_.end());
+  auto& tasks = queryTasksIt->second.tasks;
+  auto task = std::move(tasks.front());
+  tasks.pop_front();
+  --numQueued_;
+  if (tasks.empty()) {
+    queries_.erase(queryTasksIt);
+  } else {
+    const auto newLevel = levelOf(scheduledNanos(query));
+    if (newLevel == level) {
+      queries.push_back(query);
+    } else {
+      enqueueLocked(query, newLevel);
+    }
+  }
+  return task;
+}
+
+void FairShareExecutor::run() {
+  for (;;) {
+    Task task;
+    int32_t level;
+    {
+      std::unique_lock<std::mutex> l(mutex_);
+      cv_.wait(l, [&]() { return numQueued_ > 0 || stopped_; });
+      if (numQueued_ == 0) {
+        return;
+      }
+      task = nextLocked(level);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      task.func();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "FairShareExecutor task threw: " << e.what();
+    }
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    // Releases the task outside of the mutex.
+    task = Task{};
+    std::lock_guard<std::mutex> l(mutex_);
+    levelScheduledNanos_[level] += nanos;
+  }
+}
+
+void FairShareExecutor::join() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  for (auto& thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
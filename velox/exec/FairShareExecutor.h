@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "velox/core/QueryCtx.h"
+
+namespace facebook::velox::exec {
+
+/// Executor that shares its threads between queries by a multi-level
+/// feedback queue, like the TaskExecutor of Presto. A query is on the level
+/// of the highest threshold that its drivers' scheduled time has passed, so
+/// that a query drops to lower priority levels as it runs longer. Each level
+/// gets 'levelTimeMultiplier' times the thread time of the next level. The
+/// next task is taken from the level that has used the least of its share
+/// and, within the level, from the query with the least scheduled time.
+/// Driver::enqueue() passes the QueryCtx of the Driver if the QueryCtx
+/// executor is a FairShareExecutor. Driver time slices are bounded by
+/// QueryConfig::driverCpuTimeSliceLimitMs().
+class FairShareExecutor : public folly::Executor {
+ public:
+  struct Options {
+    /// Number of threads. 0 means one per hardware thread.
+    int32_t numThreads{0};
+
+    /// Scheduled time in ms at which a query enters each level. The first
+    /// must be 0.
+    std::vector<int64_t> levelThresholdsMs{0, 1'000, 10'000, 60'000, 300'000};
+
+    /// Ratio of the thread time of a level to the thread time of the next.
+    int32_t levelTimeMultiplier{2};
+  };
+
+  explicit FairShareExecutor(Options options);
+
+  ~FairShareExecutor() override;
+
+  /// Adds 'func' on the top level, not attributed to a query.
+  void add(folly::Func func) override;
+
+  /// Adds 'func' for 'query'.
+  void add(folly::Func func, std::shared_ptr<core::QueryCtx> query);
+
+  /// Stops accepting tasks, runs the queued tasks and joins the threads.
+  void join();
+
+  int32_t numLevels() const {
+    return levelThresholdsNanos_.size();
+  }
+
+  /// Returns the level of a query with 'scheduledNanos' of scheduled time.
+  int32_t levelOf(uint64_t scheduledNanos) const;
+
+  /// Returns the thread time in ns used by the tasks of each level.
+  std::vector<uint64_t> levelScheduledNanos() const;
+
+ private:
+  struct Task {
+    folly::Func func;
+    std::shared_ptr<core::QueryCtx> query;
+  };
+
+  // The queued tasks of a query.
+  struct QueryTasks {
+    std::deque<Task> tasks;
+    // Level where 'this' is queued.
+    int32_t level{0};
+  };
+
+  // Returns the scheduled time that places 'query' into a level. 0 for
+  // tasks without a query.
+  static uint64_t scheduledNanos(const core::QueryCtx* query);
+
+  // Adds 'query' to the queries with tasks on 'level'.
+  void enqueueLocked(const core::QueryCtx* query, int32_t level);
+
+  // Removes and returns the next task. There must be a queued task.
+  Task nextLocked(int32_t& level);
+
+  void run();
+
+  const std::vector<uint64_t> levelThresholdsNanos_;
+  // Weight of each level. The top level has the largest weight.
+  std::vector<uint64_t> levelWeights_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_{false};
+  int64_t numQueued_{0};
+
+  // Queued tasks per query. nullptr is for tasks without a query.
+  folly::F14FastMap<const core::QueryCtx*, QueryTasks> queries_;
+  // Queries with queued tasks, per level.
+  std::vector<std::vector<const core::QueryCtx*>> levelQueries_;
+  // Thread time used by the tasks of each level.
+  std::vector<uint64_t> levelScheduledNanos_;
+
+  std::vector<std::thread> threads_;
+};
+
+} // namespace facebook::velox::exec
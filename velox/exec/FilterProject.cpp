@@ -81,6 +81,17 @@ void FilterProject::initialize() {
   }
   numExprs_ = allExprs.size();
   exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
+  if (numExprs_ > 0) {
+    const auto& compileStats = exprs_->compileStats();
+    addRuntimeStat(
+        "exprCompileNanos",
+        RuntimeCounter(
+            compileStats.timing.wallNanos, RuntimeCounter::Unit::kNanos));
+    addRuntimeStat(
+        "exprCompileCacheHits", RuntimeCounter(compileStats.numCacheHits));
+    addRuntimeStat(
+        "exprCompileCacheMisses", RuntimeCounter(compileStats.numCacheMisses));
+  }
 
   if (numExprs_ > 0 && !identityProjections_.empty()) {
     const auto inputType = project_ ? project_->sources()[0]->outputType()
@@ -126,6 +137,11 @@ RowVectorPtr FilterProject::getOutput() {
     return nullptr;
   }
 
+  // The results of the previous batch are recycled if the consumer of the
+  // previous output no longer references them.
+  operatorCtx_->execCtx()->releaseVectors(results_);
+  results_.clear();
+
   vector_size_t size = input_->size();
   LocalSelectivityVector localRows(*operatorCtx_->execCtx(), size);
   auto* rows = localRows.get();
@@ -142,9 +158,9 @@ RowVectorPtr FilterProject::getOutput() {
   if (!hasFilter_) {
     numProcessedInputRows_ = size;
     VELOX_CHECK(!isIdentityProjection_);
-    auto results = project(*rows, evalCtx);
+    project(*rows, evalCtx);
 
-    return fillOutput(size, nullptr, results);
+    return fillOutput(size, nullptr);
   }
 
   // evaluate filter
@@ -158,27 +174,20 @@ RowVectorPtr FilterProject::getOutput() {
   bool allRowsSelected = (numOut == size);
 
   // evaluate projections (if present)
-  std::vector<VectorPtr> results;
   if (!isIdentityProjection_) {
     if (!allRowsSelected) {
       rows->setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
     }
-    results = project(*rows, evalCtx);
+    project(*rows, evalCtx);
   }
 
   return fillOutput(
-      numOut,
-      allRowsSelected ? nullptr : filterEvalCtx_.selectedIndices,
-      results);
+      numOut, allRowsSelected ? nullptr : filterEvalCtx_.selectedIndices);
 }
 
-std::vector<VectorPtr> FilterProject::project(
-    const SelectivityVector& rows,
-    EvalCtx& evalCtx) {
-  std::vector<VectorPtr> results;
+void FilterProject::project(const SelectivityVector& rows, EvalCtx& evalCtx) {
   exprs_->eval(
-      hasFilter_ ? 1 : 0, numExprs_, !hasFilter_, rows, evalCtx, results);
-  return results;
+      hasFilter_ ? 1 : 0, numExprs_, !hasFilter_, rows, evalCtx, results_);
 }
 
 vector_size_t FilterProject::filter(
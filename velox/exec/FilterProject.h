@@ -86,11 +86,10 @@ class FilterProject : public Operator {
   // updated.
   vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
 
-  // Evaluate projections on the specified rows and return the results.
+  // Evaluate projections on the specified rows into 'results_'. The results
+  // are recycled on the next call to getOutput().
   // pre-condition: !isIdentityProjection_
-  std::vector<VectorPtr> project(
-      const SelectivityVector& rows,
-      EvalCtx& evalCtx);
+  void project(const SelectivityVector& rows, EvalCtx& evalCtx);
 
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
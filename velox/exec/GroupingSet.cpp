@@ -52,7 +52,8 @@ GroupingSet::GroupingSet(
     const std::optional<column_index_t>& groupIdChannel,
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection,
-    OperatorCtx* operatorCtx)
+    OperatorCtx* operatorCtx,
+    std::optional<column_index_t> keyHashChannel)
     : preGroupedKeyChannels_(std::move(preGroupedKeys)),
       hashers_(std::move(hashers)),
       isGlobal_(hashers_.empty()),
@@ -67,6 +68,7 @@ GroupingSet::GroupingSet(
                                 .aggregationSpillMemoryThreshold()),
       globalGroupingSets_(globalGroupingSets),
       groupIdChannel_(groupIdChannel),
+      keyHashChannel_(keyHashChannel),
       spillConfig_(spillConfig),
       nonReclaimableSection_(nonReclaimableSection),
       stringAllocator_(operatorCtx->pool()),
@@ -98,6 +100,7 @@ GroupingSet::GroupingSet(
         "Partial aggregations over sorted inputs are not supported");
   }
 
+  bool hasDistinctAggregations = false;
   for (auto& aggregate : aggregates_) {
     if (aggregate.distinct) {
       VELOX_USER_CHECK(
@@ -105,10 +108,28 @@ GroupingSet::GroupingSet(
           "Partial aggregations over distinct inputs are not supported");
       distinctAggregations_.emplace_back(
           DistinctAggregations::create({&aggregate}, inputType, &pool_));
+      hasDistinctAggregations = true;
     } else {
       distinctAggregations_.push_back(nullptr);
     }
   }
+
+  if (queryConfig_.aggregationDenseAccumulationEnabled() && isRawInput_ &&
+      !isGlobal_ && sortedAggregations_ == nullptr &&
+      !hasDistinctAggregations) {
+    denseAggregation_ =
+        DenseAggregation::create(aggregates_, inputType, &pool_);
+  }
+
+  // Bits above the ones the tables use for bucket numbers and tags.
+  constexpr uint8_t kHashPartitionStartBit = 46;
+  const auto partitionBits = queryConfig_.aggregationHashPartitionBits();
+  if (partitionBits > 0 && !isGlobal_ && !isPartial_ &&
+      spillConfig_ == nullptr && preGroupedKeyChannels_.empty() &&
+      sortedAggregations_ == nullptr && !hasDistinctAggregations) {
+    hashPartitionBits_ = HashBitRange(
+        kHashPartitionStartBit, kHashPartitionStartBit + partitionBits);
+  }
 }
 
 GroupingSet::~GroupingSet() {
@@ -229,19 +250,37 @@ void GroupingSet::addInputForActiveRows(
       input,
       activeRows_,
       ignoreNullKeys_,
-      BaseHashTable::kNoSpillInputStartPartitionBit);
+      BaseHashTable::kNoSpillInputStartPartitionBit,
+      keyHashChannel_);
   if (lookup_->rows.empty()) {
     // No rows to probe. Can happen when ignoreNullKeys_ is true and all rows
     // have null keys.
     return;
   }
 
-  table_->groupProbe(*lookup_);
+  if (otherPartitionTables_.empty()) {
+    table_->groupProbe(*lookup_);
+  } else {
+    partitionedGroupProbe();
+  }
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
 
+  if (denseAggregation_ != nullptr && otherPartitionTables_.empty() &&
+      table_->hashMode() == BaseHashTable::HashMode::kArray &&
+      table_->capacity() <= DenseAggregation::kMaxSlots) {
+    if (!newGroups.empty()) {
+      for (auto& aggregate : aggregates_) {
+        aggregate.function->initializeNewGroups(groups, newGroups);
+      }
+    }
+    denseAggregation_->addInput(
+        *lookup_, input, activeRows_, table_->capacity());
+    return;
+  }
+
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
       continue;
@@ -396,6 +435,116 @@ void GroupingSet::createHashTable() {
   if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
     table_->forceGenericHashMode();
   }
+
+  if (hashPartitionBits_.has_value()) {
+    // The hashes that select the partition must not depend on the value
+    // ranges of the keys, so all tables are in generic hash mode.
+    table_->forceGenericHashMode();
+    otherPartitionTables_.clear();
+    for (auto i = 1; i < hashPartitionBits_->numPartitions(); ++i) {
+      std::vector<std::unique_ptr<VectorHasher>> hashers;
+      for (const auto& hasher : table_->hashers()) {
+        hashers.push_back(
+            VectorHasher::create(hasher->type(), hasher->channel()));
+      }
+      std::unique_ptr<BaseHashTable> table;
+      if (ignoreNullKeys_) {
+        table = HashTable<true>::createForAggregation(
+            std::move(hashers),
+            accumulators(false),
+            &pool_,
+            table_->rows()->stringAllocatorShared());
+      } else {
+        table = HashTable<false>::createForAggregation(
+            std::move(hashers),
+            accumulators(false),
+            &pool_,
+            table_->rows()->stringAllocatorShared());
+      }
+      table->forceGenericHashMode();
+      otherPartitionTables_.push_back(std::move(table));
+    }
+    partitionRows_.resize(numPartitionTables());
+  }
+}
+
+void GroupingSet::partitionedGroupProbe() {
+  for (auto& rows : partitionRows_) {
+    rows.clear();
+  }
+  const auto* hashes = lookup_->hashes.data();
+  for (auto i = 0; i < lookup_->rows.size(); ++i) {
+    const auto row = lookup_->rows[i];
+    partitionRows_[hashPartitionBits_->partition(hashes[row])].push_back(row);
+  }
+  // Each table sets 'hits' and appends to 'newGroups' for its own rows.
+  allProbeRows_ = lookup_->rows;
+  for (auto partition = 0; partition < numPartitionTables(); ++partition) {
+    if (partitionRows_[partition].empty()) {
+      continue;
+    }
+    lookup_->rows = partitionRows_[partition];
+    partitionTable(partition).groupProbe(*lookup_);
+  }
+  lookup_->rows = allProbeRows_;
+}
+
+int32_t GroupingSet::listGroups(
+    RowContainerIterator& iterator,
+    int32_t maxRows,
+    int32_t maxBytes,
+    char** groups) {
+  if (table_ == nullptr) {
+    return 0;
+  }
+  for (; outputPartition_ < numPartitionTables(); ++outputPartition_) {
+    const auto numGroups =
+        partitionTable(outputPartition_)
+            .rows()
+            ->listRows(&iterator, maxRows, maxBytes, groups);
+    if (numGroups > 0) {
+      return numGroups;
+    }
+    iterator.reset();
+  }
+  return 0;
+}
+
+int64_t GroupingSet::numDistinct() const {
+  if (table_ == nullptr) {
+    return 0;
+  }
+  int64_t numDistinct = 0;
+  for (auto i = 0; i < numPartitionTables(); ++i) {
+    numDistinct += partitionTable(i).numDistinct();
+  }
+  return numDistinct;
+}
+
+int64_t GroupingSet::numRows() const {
+  if (table_ == nullptr) {
+    return 0;
+  }
+  int64_t numRows = 0;
+  for (auto i = 0; i < numPartitionTables(); ++i) {
+    numRows += partitionTable(i).rows()->numRows();
+  }
+  return numRows;
+}
+
+HashTableStats GroupingSet::hashTableStats() const {
+  if (table_ == nullptr) {
+    return HashTableStats{};
+  }
+  auto stats = table_->stats();
+  for (const auto& table : otherPartitionTables_) {
+    const auto partitionStats = table->stats();
+    stats.capacity += partitionStats.capacity;
+    stats.numRehashes += partitionStats.numRehashes;
+    stats.numDistinct += partitionStats.numDistinct;
+    stats.numTombstones += partitionStats.numTombstones;
+  }
+  return stats;
 }
 
 void GroupingSet::initializeGlobalAggregation() {
@@ -719,14 +868,10 @@ bool GroupingSet::getOutput(
 
   // @lint-ignore CLANGTIDY
   char* groups[maxOutputRows];
-  const int32_t numGroups = table_
-      ? table_->rows()->listRows(
-            &iterator, maxOutputRows, maxOutputBytes, groups)
-      : 0;
+  const int32_t numGroups =
+      listGroups(iterator, maxOutputRows, maxOutputBytes, groups);
   if (numGroups == 0) {
-    if (table_ != nullptr) {
-      table_->clear();
-    }
+    resetTable();
     return false;
   }
   extractGroups(folly::Range<char**>(groups, numGroups), result);
@@ -776,6 +921,10 @@ void GroupingSet::resetTable() {
   if (table_ != nullptr) {
     table_->clear();
   }
+  for (auto& table : otherPartitionTables_) {
+    table->clear();
+  }
+  outputPartition_ = 0;
 }
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
@@ -801,7 +950,13 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
 
 uint64_t GroupingSet::allocatedBytes() const {
   if (table_) {
-    return table_->allocatedBytes();
+    auto bytes = table_->allocatedBytes();
+    // The string allocator is shared with 'table_' and counted once.
+    for (const auto& table : otherPartitionTables_) {
+      bytes += table->allocatedBytes() -
+          table->rows()->stringAllocator().retainedSize();
+    }
+    return bytes;
   }
 
   return stringAllocator_.retainedSize() + rows_.allocatedBytes();
@@ -1017,8 +1172,10 @@ bool GroupingSet::getOutputWithSpill(
     VELOX_CHECK_EQ(table_->rows()->numRows(), 0);
 
     VELOX_CHECK_NULL(merge_);
-    auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(&pool_);
+    auto spillPartition = mergeSpillRuns(
+        std::make_unique<SpillPartition>(spiller_->finishSpill()));
+    merge_ = spillPartition->createOrderedReader(
+        &pool_, spillConfig_->executor, spillConfig_->readAheadBytes);
   }
   VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   if (merge_ == nullptr) {
@@ -1027,6 +1184,123 @@ bool GroupingSet::getOutputWithSpill(
   return mergeNext(maxOutputRows, maxOutputBytes, result);
 }
 
+std::unique_ptr<SpillPartition> GroupingSet::mergeSpillRuns(
+    std::unique_ptr<SpillPartition> partition) {
+  const int32_t maxFanIn = spillConfig_->maxMergeFanIn;
+  // NOTE: the merge of a distinct aggregation needs to know which keys come
+  // from the first run, so its runs are not combined.
+  if (maxFanIn == 0 || isDistinct()) {
+    return partition;
+  }
+  const auto spillType = makeSpillType();
+  auto updateAndCheckSpillLimitCb = spillConfig_->updateAndCheckSpillLimitCb;
+  int32_t level{0};
+  while (partition->numFiles() > maxFanIn) {
+    const auto numRuns = (partition->numFiles() + maxFanIn - 1) / maxFanIn;
+    const auto partitionId = partition->id();
+    SpillFiles runs;
+    for (auto& group : partition->split(numRuns)) {
+      SpillWriter writer(
+          spillType,
+          mergeRows_->keyTypes().size(),
+          std::vector<CompareFlags>(),
+          spillConfig_->compressionKind,
+          spillConfig_->getSpillDirPathCb,
+          fmt::format("{}-merge-{}", spillConfig_->fileNamePrefix, level),
+          std::numeric_limits<uint64_t>::max(),
+          spillConfig_->writeBufferSize,
+          spillConfig_->fileCreateConfig,
+          updateAndCheckSpillLimitCb,
+          memory::spillMemoryPool(),
+          &spillMergeStats_,
+          spillConfig_->executor);
+      mergeSpillRun(*group, writer);
+      for (auto& file : writer.finish()) {
+        runs.push_back(std::move(file));
+      }
+    }
+    partition = std::make_unique<SpillPartition>(partitionId, std::move(runs));
+    ++level;
+    auto lockedStats = spillMergeStats_.wlock();
+    ++lockedStats->spillMergeLevels;
+    lockedStats->spillMergeRuns += numRuns;
+  }
+  return partition;
+}
+
+void GroupingSet::mergeSpillRun(
+    SpillPartition& partition,
+    SpillWriter& writer) {
+  // The intermediate merges do not read ahead since each of them would
+  // reserve the read ahead memory again.
+  auto merge = partition.createOrderedReader(&pool_);
+  VELOX_CHECK_NOT_NULL(merge);
+  const auto maxRows = queryConfig_.preferredOutputBatchRows();
+  const auto maxBytes = queryConfig_.preferredOutputBatchBytes();
+  std::vector<char*> rows;
+  RowVectorPtr spillVector;
+  bool nextKeyIsEqual{false};
+  for (;;) {
+    auto next = merge->nextWithEquals();
+    if (next.first == nullptr) {
+      break;
+    }
+    if (!nextKeyIsEqual) {
+      if (rows.size() >= maxRows || mergeRows_->allocatedBytes() >= maxBytes) {
+        spillMergeRows(rows, spillVector, writer);
+      }
+      mergeState_ = mergeRows_->newRow();
+      initializeRow(*next.first, mergeState_);
+      rows.push_back(mergeState_);
+    }
+    updateRow(*next.first, mergeState_);
+    nextKeyIsEqual = next.second;
+    next.first->pop();
+  }
+  spillMergeRows(rows, spillVector, writer);
+}
+
+void GroupingSet::spillMergeRows(
+    std::vector<char*>& rows,
+    RowVectorPtr& spillVector,
+    SpillWriter& writer) {
+  if (rows.empty()) {
+    return;
+  }
+  const auto numRows = rows.size();
+  if (spillVector == nullptr) {
+    spillVector = BaseVector::create<RowVector>(
+        makeSpillType(), numRows, memory::spillMemoryPool());
+  } else {
+    spillVector->prepareForReuse();
+    spillVector->resize(numRows);
+  }
+  const auto numKeys = mergeRows_->keyTypes().size();
+  for (auto i = 0; i < numKeys; ++i) {
+    mergeRows_->extractColumn(rows.data(), numRows, i, spillVector->childAt(i));
+  }
+  const auto& accumulators = mergeRows_->accumulators();
+  for (auto i = 0; i < accumulators.size(); ++i) {
+    accumulators[i].extractForSpill(
+        folly::Range<char**>(rows.data(), numRows),
+        spillVector->childAt(i + numKeys));
+  }
+  IndexRange range{0, static_cast<vector_size_t>(numRows)};
+  writer.write(spillVector, folly::Range<IndexRange*>(&range, 1));
+  rows.clear();
+  mergeRows_->clear();
+}
+
+std::optional<common::SpillStats> GroupingSet::takeSpillMergeStats() {
+  auto lockedStats = spillMergeStats_.wlock();
+  if (lockedStats->spillMergeLevels == 0) {
+    return std::nullopt;
+  }
+  auto stats = *lockedStats;
+  lockedStats->reset();
+  return stats;
+}
+
 bool GroupingSet::mergeNext(
     int32_t maxOutputRows,
     int32_t maxOutputBytes,
@@ -1119,7 +1393,7 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
   }
   vector_size_t zero = 0;
   for (auto& aggregate : aggregates_) {
-    if (!aggregate.sortingKeys.empty()) {
+    if (!aggregate.sortingKeys.empty() || aggregate.distinct) {
       continue;
     }
     aggregate.function->initializeNewGroups(
@@ -1130,6 +1404,13 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
     sortedAggregations_->initializeNewGroups(
         &row, folly::Range<const vector_size_t*>(&zero, 1));
   }
+
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->initializeNewGroups(
+          &row, folly::Range<const vector_size_t*>(&zero, 1));
+    }
+  }
 }
 
 void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
@@ -1151,7 +1432,7 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
-    if (!aggregates_[i].sortingKeys.empty()) {
+    if (!aggregates_[i].sortingKeys.empty() || aggregates_[i].distinct) {
       continue;
     }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
@@ -1160,12 +1441,19 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   }
   mergeSelection_.setValid(input.currentIndex(), false);
 
+  auto column = aggregates_.size() + keyChannels_.size();
   if (sortedAggregations_ != nullptr) {
-    const auto& vector =
-        input.current().childAt(aggregates_.size() + keyChannels_.size());
+    const auto& vector = input.current().childAt(column++);
     sortedAggregations_->addSingleGroupSpillInput(
         row, vector, input.currentIndex());
   }
+
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      const auto& vector = input.current().childAt(column++);
+      aggregation->addSingleGroupSpillInput(row, vector, input.currentIndex());
+    }
+  }
 }
 
 void GroupingSet::abandonPartialAggregation() {
@@ -1190,9 +1478,24 @@ void GroupingSet::abandonPartialAggregation() {
       &pool_,
       table_->rows()->stringAllocatorShared());
   initializeAggregates(aggregates_, *intermediateRows_, true);
+  // Keeps new hashers for the table of resumePartialAggregation().
+  hashers_.clear();
+  for (const auto& hasher : table_->hashers()) {
+    hashers_.push_back(VectorHasher::create(hasher->type(), hasher->channel()));
+  }
   table_.reset();
 }
 
+void GroupingSet::resumePartialAggregation() {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK_NULL(table_);
+  abandonedPartialAggregation_ = false;
+  intermediateRows_.reset();
+  for (auto& aggregate : aggregates_) {
+    aggregate.function->clear();
+  }
+}
+
 namespace {
 // Recursive resize all children.
 
@@ -17,7 +17,9 @@
 
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
+#include "velox/exec/DenseAggregation.h"
 #include "velox/exec/DistinctAggregations.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/SortedAggregations.h"
 #include "velox/exec/Spiller.h"
@@ -40,7 +42,8 @@ class GroupingSet {
       const std::optional<column_index_t>& groupIdChannel,
       const common::SpillConfig* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection,
-      OperatorCtx* operatorCtx);
+      OperatorCtx* operatorCtx,
+      std::optional<column_index_t> keyHashChannel = std::nullopt);
 
   ~GroupingSet();
 
@@ -89,9 +92,7 @@ class GroupingSet {
   bool isPartialFull(int64_t maxBytes);
 
   /// Returns the count of the hash table, if any.
-  int64_t numDistinct() const {
-    return table_ ? table_->numDistinct() : 0;
-  }
+  int64_t numDistinct() const;
 
   /// Returns number of global grouping sets rows if there is default output.
   std::optional<vector_size_t> numDefaultGlobalGroupingSetRows() const {
@@ -118,23 +119,34 @@ class GroupingSet {
     return spiller_->stats();
   }
 
+  /// Returns the stats of merging sorted spill runs into longer runs before
+  /// the final merge since the last call, and resets them. Returns
+  /// std::nullopt if there were no such merges. These stats are not included
+  /// in spilledStats().
+  std::optional<common::SpillStats> takeSpillMergeStats();
+
   /// Returns true if spilling has triggered on this grouping set.
   bool hasSpilled() const;
 
   /// Returns the hashtable stats.
-  HashTableStats hashTableStats() const {
-    return table_ ? table_->stats() : HashTableStats{};
-  }
+  HashTableStats hashTableStats() const;
 
   /// Return the number of rows kept in memory.
-  int64_t numRows() const {
-    return table_ ? table_->rows()->numRows() : 0;
-  }
+  int64_t numRows() const;
 
   // Frees hash tables and other state when giving up partial aggregation as
   // non-productive. Must be called before toIntermediate() is used.
   void abandonPartialAggregation();
 
+  /// Undoes abandonPartialAggregation(). The next addInput() aggregates into a
+  /// new hash table.
+  void resumePartialAggregation();
+
+  /// Channels of the grouping keys in the input.
+  const std::vector<column_index_t>& keyChannels() const {
+    return keyChannels_;
+  }
+
   /// Translates the raw input in input to accumulators initialized from a
   /// single input row. Passes grouping keys through.
   void toIntermediate(const RowVectorPtr& input, RowVectorPtr& result);
@@ -181,6 +193,29 @@ class GroupingSet {
 
   void createHashTable();
 
+  // Returns the hash table of 'partition' when the groups are partitioned by
+  // 'hashPartitionBits_'. 'table_' is the table of partition 0.
+  BaseHashTable& partitionTable(int32_t partition) const {
+    return partition == 0 ? *table_ : *otherPartitionTables_[partition - 1];
+  }
+
+  int32_t numPartitionTables() const {
+    return 1 + otherPartitionTables_.size();
+  }
+
+  // Probes the rows of 'lookup_' into the table of their partition. The
+  // hashes and decoded keys of 'lookup_' are shared by all partitions.
+  void partitionedGroupProbe();
+
+  // Lists up to 'maxRows' groups from the position of 'iterator' into
+  // 'groups'. Continues with the next partition table when the current one
+  // is listed.
+  int32_t listGroups(
+      RowContainerIterator& iterator,
+      int32_t maxRows,
+      int32_t maxBytes,
+      char** groups);
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -212,6 +247,24 @@ class GroupingSet {
       int32_t maxOutputBytes,
       const RowVectorPtr& result);
 
+  // Merges the sorted runs of 'partition' in groups of at most
+  // 'spillConfig_->maxMergeFanIn' runs into one run per group, level by level,
+  // until at most that many runs are left. The rows of a group with equal keys
+  // are combined into one row, so the runs shrink as they are merged. Returns
+  // the partition with the merged runs.
+  std::unique_ptr<SpillPartition> mergeSpillRuns(
+      std::unique_ptr<SpillPartition> partition);
+
+  // Merges the runs of 'partition' into one sorted run written to 'writer'.
+  void mergeSpillRun(SpillPartition& partition, SpillWriter& writer);
+
+  // Writes 'rows' of 'mergeRows_' in the spill format to 'writer' using
+  // 'spillVector' as the buffer. Clears 'rows' and 'mergeRows_'.
+  void spillMergeRows(
+      std::vector<char*>& rows,
+      RowVectorPtr& spillVector,
+      SpillWriter& writer);
+
   // Reads from spilled rows until producing a batch of final results in
   // 'result'. Returns false and leaves 'result' empty when the spilled data is
   // fully read. 'maxOutputRows' and 'maxOutputBytes' specify the max number of
@@ -277,6 +330,10 @@ class GroupingSet {
   AggregationMasks masks_;
   std::unique_ptr<SortedAggregations> sortedAggregations_;
   std::vector<std::unique_ptr<DistinctAggregations>> distinctAggregations_;
+  // Adds raw input while the table is in array mode. Set only if
+  // QueryConfig::kAggregationDenseAccumulation is true and all aggregates
+  // support it.
+  std::unique_ptr<DenseAggregation> denseAggregation_;
 
   const bool ignoreNullKeys_;
 
@@ -290,6 +347,9 @@ class GroupingSet {
   const std::vector<vector_size_t> globalGroupingSets_;
   // Column for groupId for a GROUPING SET.
   std::optional<column_index_t> groupIdChannel_;
+  // Column with the hashes of the grouping keys computed by an upstream
+  // LocalPartition. Used instead of hashing the keys in kHash mode.
+  const std::optional<column_index_t> keyHashChannel_;
 
   const common::SpillConfig* const spillConfig_;
 
@@ -309,6 +369,19 @@ class GroupingSet {
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
 
+  // Hash bits that select the table of a group if a final or single
+  // aggregation splits its groups into multiple smaller tables. See
+  // QueryConfig::aggregationHashPartitionBits().
+  std::optional<HashBitRange> hashPartitionBits_;
+  // Tables of partitions 1 and above if 'hashPartitionBits_' is set. They
+  // are in generic hash mode and share the string allocator of 'table_'.
+  std::vector<std::unique_ptr<BaseHashTable>> otherPartitionTables_;
+  // Rows of the current input in each partition.
+  std::vector<raw_vector<vector_size_t>> partitionRows_;
+  raw_vector<vector_size_t> allProbeRows_;
+  // Partition of the table that getOutput() lists.
+  int32_t outputPartition_{0};
+
   // Used to allocate memory for a single row accumulating results of global
   // aggregation
   HashStringAllocator stringAllocator_;
@@ -332,6 +405,9 @@ class GroupingSet {
   std::unique_ptr<Spiller> spiller_;
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
+  // The stats of the merges made by mergeSpillRuns().
+  folly::Synchronized<common::SpillStats> spillMergeStats_;
+
   // Container for materializing batches of output from spilling.
   std::unique_ptr<RowContainer> mergeRows_;
 
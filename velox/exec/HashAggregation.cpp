@@ -15,6 +15,7 @@
  */
 #include "velox/exec/HashAggregation.h"
 #include <optional>
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
@@ -45,8 +46,12 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      partialAggregationResumeCheckRows_(
+          driverCtx->queryConfig().partialAggregationResumeCheckRows()),
+      initialMaxPartialAggregationMemoryUsage_(
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          initialMaxPartialAggregationMemoryUsage_) {}
 
 void HashAggregation::initialize() {
   Operator::initialize();
@@ -106,11 +111,131 @@ void HashAggregation::initialize() {
       groupIdChannel,
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
       &nonReclaimableSection_,
-      operatorCtx_.get());
+      operatorCtx_.get(),
+      keyHashChannel(
+          *aggregationNode_->sources()[0], aggregationNode_->groupingKeys()));
+
+  if (auto statisticsAggregation = makeStatisticsAggregation(inputType)) {
+    operatorCtx_->driver()->pushdownStatisticsAggregation(
+        this, statisticsAggregation);
+  }
+
+  if (operatorCtx_->driverCtx()->queryConfig().splitResultCacheEnabled() &&
+      aggregationNode_->step() == core::AggregationNode::Step::kPartial &&
+      !isGlobal_ && !isDistinct_ && !groupIdChannel.has_value()) {
+    splitResultFragmentKey_ = SplitResultCache::fragmentKey(*aggregationNode_);
+    if (splitResultFragmentKey_.has_value() &&
+        !operatorCtx_->driver()->pushdownSplitResultListener(this, this)) {
+      splitResultFragmentKey_.reset();
+    }
+  }
 
   aggregationNode_.reset();
 }
 
+bool HashAggregation::startSplit(const std::optional<std::string>& dataKey) {
+  VELOX_CHECK(isReadyForSplit());
+  VELOX_CHECK_NULL(splitResultWriter_);
+  // The result of the split may not include groups of earlier splits.
+  if (!splitResultFragmentKey_.has_value() || !dataKey.has_value() ||
+      groupingSet_->numRows() != 0) {
+    return false;
+  }
+  auto key = SplitResultCache::makeKey(
+      splitResultFragmentKey_.value(), dataKey.value());
+  if (SplitResultCache::instance().find(
+          key, outputType_, pool(), cachedSplitResult_)) {
+    std::reverse(cachedSplitResult_.begin(), cachedSplitResult_.end());
+    addRuntimeStat("splitResultCacheHits", RuntimeCounter(1));
+    return true;
+  }
+  addRuntimeStat("splitResultCacheMisses", RuntimeCounter(1));
+  splitResultWriter_ = std::make_unique<SplitResultCache::Writer>(
+      std::move(key), outputType_, pool());
+  return false;
+}
+
+void HashAggregation::finishSplit(bool cacheable) {
+  if (!cacheable) {
+    splitResultWriter_.reset();
+  }
+  // The groups are produced before the next split starts so that the next
+  // split starts with an empty table.
+  if (groupingSet_->numRows() == 0 && !partialFull_) {
+    finishSplitResult();
+    return;
+  }
+  splitFlushPending_ = true;
+}
+
+void HashAggregation::recordSplitResult(const RowVectorPtr& output) {
+  if (splitResultWriter_ != nullptr && !splitResultWriter_->append(output)) {
+    splitResultWriter_.reset();
+  }
+}
+
+void HashAggregation::finishSplitResult() {
+  splitFlushPending_ = false;
+  if (splitResultWriter_ != nullptr) {
+    SplitResultCache::instance().insert(*splitResultWriter_);
+    splitResultWriter_.reset();
+  }
+}
+
+std::shared_ptr<const connector::StatisticsAggregation>
+HashAggregation::makeStatisticsAggregation(const RowTypePtr& inputType) const {
+  const auto step = aggregationNode_->step();
+  if ((step != core::AggregationNode::Step::kPartial &&
+       step != core::AggregationNode::Step::kSingle) ||
+      aggregationNode_->groupId().has_value()) {
+    return nullptr;
+  }
+
+  auto statisticsAggregation =
+      std::make_shared<connector::StatisticsAggregation>();
+  for (const auto& key : aggregationNode_->groupingKeys()) {
+    statisticsAggregation->groupingKeyChannels.push_back(
+        exprToChannel(key.get(), inputType));
+  }
+  for (const auto& aggregate : aggregationNode_->aggregates()) {
+    if (aggregate.mask || aggregate.distinct ||
+        !aggregate.sortingKeys.empty()) {
+      return nullptr;
+    }
+    const auto& name = aggregate.call->name();
+    const auto& inputs = aggregate.call->inputs();
+    if (name == "count" && inputs.empty()) {
+      continue;
+    }
+    if (inputs.size() != 1) {
+      return nullptr;
+    }
+    if (const auto* constant =
+            dynamic_cast<const core::ConstantTypedExpr*>(inputs[0].get())) {
+      // count(1) counts the rows.
+      if (name == "count" && !constant->hasValueVector() &&
+          !constant->value().isNull()) {
+        continue;
+      }
+      return nullptr;
+    }
+    const auto* field =
+        dynamic_cast<const core::FieldAccessTypedExpr*>(inputs[0].get());
+    if (field == nullptr || !field->isInputColumn()) {
+      return nullptr;
+    }
+    const auto channel = inputType->getChildIdx(field->name());
+    if (name == "count") {
+      statisticsAggregation->countChannels.push_back(channel);
+    } else if (name == "min" || name == "max") {
+      statisticsAggregation->minMaxChannels.push_back(channel);
+    } else {
+      return nullptr;
+    }
+  }
+  return statisticsAggregation;
+}
+
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
   VELOX_CHECK(isPartialOutput_ && !isGlobal_);
   return numInputRows_ > abandonPartialAggregationMinRows_ &&
@@ -122,7 +247,7 @@ void HashAggregation::addInput(RowVectorPtr input) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
-  if (abandonedPartialAggregation_) {
+  if (abandonedPartialAggregation_ && !maybeResumePartialAggregation(*input)) {
     input_ = input;
     numInputRows_ += input->size();
     return;
@@ -159,6 +284,53 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+bool HashAggregation::maybeResumePartialAggregation(const RowVector& input) {
+  // Index bits of the HyperLogLog. The standard error is about 2%.
+  constexpr int8_t kSampleIndexBitLength = 11;
+  if (partialAggregationResumeCheckRows_ == 0) {
+    return false;
+  }
+  if (numPassThroughRows_ < partialAggregationResumeCheckRows_) {
+    numPassThroughRows_ += input.size();
+    return false;
+  }
+  if (sampleHll_ == nullptr) {
+    sampleAllocator_ = std::make_unique<HashStringAllocator>(pool());
+    sampleHll_ = std::make_unique<common::hll::DenseHll>(
+        kSampleIndexBitLength, sampleAllocator_.get());
+  }
+  const auto& keyChannels = groupingSet_->keyChannels();
+  for (auto row = 0; row < input.size(); ++row) {
+    uint64_t hash = 0;
+    for (auto i = 0; i < keyChannels.size(); ++i) {
+      const auto keyHash =
+          input.childAt(keyChannels[i])->loadedVector()->hashValueAt(row);
+      hash = i == 0 ? keyHash : bits::hashMix(hash, keyHash);
+    }
+    sampleHll_->insertHash(hash);
+  }
+  numSampledRows_ += input.size();
+  if (numSampledRows_ < abandonPartialAggregationMinRows_) {
+    return false;
+  }
+
+  const auto distinctPct = 100 * sampleHll_->cardinality() / numSampledRows_;
+  sampleHll_.reset();
+  sampleAllocator_.reset();
+  numSampledRows_ = 0;
+  numPassThroughRows_ = 0;
+  if (distinctPct >= abandonPartialAggregationMinPct_) {
+    return false;
+  }
+  groupingSet_->resumePartialAggregation();
+  abandonedPartialAggregation_ = false;
+  maxPartialAggregationMemoryUsage_ = initialMaxPartialAggregationMemoryUsage_;
+  numInputRows_ = 0;
+  numOutputRows_ = 0;
+  addRuntimeStat("resumedPartialAggregation", RuntimeCounter(1));
+  return true;
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -273,6 +445,11 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (!cachedSplitResult_.empty()) {
+    auto output = std::move(cachedSplitResult_.back());
+    cachedSplitResult_.pop_back();
+    return output;
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
@@ -284,6 +461,7 @@ RowVectorPtr HashAggregation::getOutput() {
     groupingSet_->toIntermediate(input_, output_);
     numOutputRows_ += input_->size();
     input_ = nullptr;
+    recordSplitResult(output_);
     return output_;
   }
 
@@ -291,9 +469,10 @@ RowVectorPtr HashAggregation::getOutput() {
   // - received no-more-input message;
   // - partial aggregation reached memory limit;
   // - distinct aggregation has new keys;
-  // - running in partial streaming mode and have some output ready.
+  // - running in partial streaming mode and have some output ready;
+  // - the split whose output is cached has finished.
   if (!noMoreInput_ && !partialFull_ && !newDistincts_ &&
-      !groupingSet_->hasOutput()) {
+      !splitFlushPending_ && !groupingSet_->hasOutput()) {
     input_ = nullptr;
     return nullptr;
   }
@@ -313,15 +492,25 @@ RowVectorPtr HashAggregation::getOutput() {
       queryConfig.preferredOutputBatchBytes(),
       resultIterator_,
       output_);
+  // The spill runs may be merged in more than one level on the first output
+  // call after spilling.
+  auto mergeStatsOr = groupingSet_->takeSpillMergeStats();
+  if (mergeStatsOr.has_value()) {
+    Operator::recordSpillStats(mergeStatsOr.value());
+  }
   if (!hasData) {
     resultIterator_.reset();
     if (noMoreInput_) {
       finished_ = true;
     }
     resetPartialOutputIfNeed();
+    if (splitFlushPending_) {
+      finishSplitResult();
+    }
     return nullptr;
   }
   numOutputRows_ += output_->size();
+  recordSplitResult(output_);
   return output_;
 }
 
@@ -448,6 +637,8 @@ void HashAggregation::close() {
 
   output_ = nullptr;
   groupingSet_.reset();
+  sampleHll_.reset();
+  sampleAllocator_.reset();
 }
 
 void HashAggregation::updateEstimatedOutputRowSize() {
@@ -15,12 +15,14 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SplitResultCache.h"
 
 namespace facebook::velox::exec {
 
-class HashAggregation : public Operator {
+class HashAggregation : public Operator, public SplitResultListener {
  public:
   HashAggregation(
       int32_t operatorId,
@@ -34,7 +36,7 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    return !noMoreInput_ && !partialFull_ && !splitFlushPending_;
   }
 
   void noMoreInput() override;
@@ -50,6 +52,14 @@ class HashAggregation : public Operator {
 
   void close() override;
 
+  bool isReadyForSplit() const override {
+    return !splitFlushPending_ && cachedSplitResult_.empty();
+  }
+
+  bool startSplit(const std::optional<std::string>& dataKey) override;
+
+  void finishSplit(bool cacheable) override;
+
  private:
   void updateRuntimeStats();
 
@@ -70,8 +80,31 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Invoked for each input after abandoning partial aggregation. Every
+  // 'partialAggregationResumeCheckRows_' rows, estimates the distinct keys of
+  // the next 'abandonPartialAggregationMinRows_' rows and resumes partial
+  // aggregation if they are fewer than 'abandonPartialAggregationMinPct_' %
+  // of the rows. Returns true if partial aggregation is resumed, starting
+  // with 'input'.
+  bool maybeResumePartialAggregation(const RowVector& input);
+
+  // Returns the description of this aggregation for the scan that produces
+  // the input if the result depends only on the number of rows, the counts
+  // of non-null values, the min and max of the input columns and the grouping
+  // keys, e.g. count(*), count(x), min(x) and max(x). Returns nullptr
+  // otherwise.
+  std::shared_ptr<const connector::StatisticsAggregation>
+  makeStatisticsAggregation(const RowTypePtr& inputType) const;
+
   RowVectorPtr getDistinctOutput();
 
+  // Appends 'output' to the result of the current split if it is to be cached.
+  void recordSplitResult(const RowVectorPtr& output);
+
+  // Invoked after the rows of the finished split have been produced. Stores
+  // them in the SplitResultCache if the split is cached.
+  void finishSplitResult();
+
   // Invoked to record the spilling stats in operator stats after processing all
   // the inputs.
   void recordSpillStats();
@@ -91,6 +124,13 @@ class HashAggregation : public Operator {
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
 
+  // Number of rows to pass through after abandoning partial aggregation
+  // before checking whether to resume it. 0 means never resume.
+  const int64_t partialAggregationResumeCheckRows_;
+  // Initial value of 'maxPartialAggregationMemoryUsage_'. Partial aggregation
+  // resumes with this limit.
+  const int64_t initialMaxPartialAggregationMemoryUsage_;
+
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
 
@@ -105,6 +145,15 @@ class HashAggregation : public Operator {
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
 
+  // Rows passed through since abandoning partial aggregation or since the
+  // last check whether to resume it.
+  int64_t numPassThroughRows_{0};
+  // Distinct keys of the rows sampled for deciding whether to resume partial
+  // aggregation.
+  std::unique_ptr<HashStringAllocator> sampleAllocator_;
+  std::unique_ptr<common::hll::DenseHll> sampleHll_;
+  int64_t numSampledRows_{0};
+
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
   bool mayPushdown_ = false;
@@ -118,6 +167,18 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // Digest of the plan fragment from the table scan to this aggregation. Set
+  // if the output for each split is kept in the SplitResultCache.
+  std::optional<std::string> splitResultFragmentKey_;
+  // Accumulates the output for the current split. nullptr if the split is not
+  // cached.
+  std::unique_ptr<SplitResultCache::Writer> splitResultWriter_;
+  // True if the split has finished and its groups are being produced before
+  // the next split starts.
+  bool splitFlushPending_{false};
+  // Output of the current split found in the cache, in reverse order.
+  std::vector<RowVectorPtr> cachedSplitResult_;
 };
 
 } // namespace facebook::velox::exec
@@ -18,6 +18,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -45,6 +46,32 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
 }
+
+// Adds the non-null values of the first 'numRows' rows of 'keys' to
+// 'bloomFilter' and the integral ones to the range ['min', 'max'].
+template <typename T>
+void addBloomFilterKeys(
+    const BaseVector& keys,
+    int32_t numRows,
+    BloomFilter<>& bloomFilter,
+    int64_t& min,
+    int64_t& max) {
+  const auto* flatKeys = keys.asUnchecked<FlatVector<T>>();
+  for (auto i = 0; i < numRows; ++i) {
+    if (flatKeys->isNullAt(i)) {
+      continue;
+    }
+    const auto value = flatKeys->valueAt(i);
+    if constexpr (std::is_same_v<T, StringView>) {
+      bloomFilter.insert(common::BloomFilterValues::hash(
+          std::string_view(value.data(), value.size())));
+    } else {
+      min = std::min<int64_t>(min, value);
+      max = std::max<int64_t>(max, value);
+      bloomFilter.insert(common::BloomFilterValues::hash(value));
+    }
+  }
+}
 } // namespace
 
 HashBuild::HashBuild(
@@ -68,6 +95,9 @@ HashBuild::HashBuild(
           planNodeId())),
       spillMemoryThreshold_(
           operatorCtx_->driverCtx()->queryConfig().joinSpillMemoryThreshold()),
+      hashModeSampleBatches_(operatorCtx_->driverCtx()
+                                 ->queryConfig()
+                                 .hashBuildModeSampleBatches()),
       keyChannelMap_(joinNode_->rightKeys().size()) {
   VELOX_CHECK(pool()->trackUsage());
   VELOX_CHECK_NOT_NULL(joinBridge_);
@@ -78,8 +108,11 @@ HashBuild::HashBuild(
       : nullptr;
 
   joinBridge_->addBuilder();
+  hotKeys_.setCapacity(kHotKeyCapacity);
 
   auto inputType = joinNode_->sources()[1]->outputType();
+  keyHashChannel_ =
+      keyHashChannel(*joinNode_->sources()[1], joinNode_->rightKeys());
 
   const auto numKeys = joinNode_->rightKeys().size();
   keyChannels_.reserve(numKeys);
@@ -109,7 +142,8 @@ HashBuild::HashBuild(
     decoders_.reserve(numDependents);
   }
   for (auto i = 0; i < inputType->size(); ++i) {
-    if (keyChannelMap_.find(i) == keyChannelMap_.end()) {
+    if (keyChannelMap_.find(i) == keyChannelMap_.end() &&
+        keyHashChannel_ != static_cast<column_index_t>(i)) {
       dependentChannels_.emplace_back(i);
       decoders_.emplace_back(std::make_unique<DecodedVector>());
       names.emplace_back(inputType->nameOf(i));
@@ -159,7 +193,8 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        pool(),
+        operatorCtx_->driverCtx()->queryConfig().concurrentHashJoinBuild());
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -179,7 +214,8 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          operatorCtx_->driverCtx()->queryConfig().concurrentHashJoinBuild());
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -190,10 +226,13 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          operatorCtx_->driverCtx()->queryConfig().concurrentHashJoinBuild());
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
+  numInputBatches_ = 0;
+  hashModePredicted_ = false;
 }
 
 void HashBuild::setupSpiller(SpillPartition* spillPartition) {
@@ -389,6 +428,9 @@ void HashBuild::addInput(RowVectorPtr input) {
   if (!activeRows_.hasSelections()) {
     return;
   }
+  if (!isInputFromSpill()) {
+    sampleHotKeys(input);
+  }
 
   if (analyzeKeys_ && hashes_.size() < activeRows_.end()) {
     hashes_.resize(activeRows_.end());
@@ -424,6 +466,65 @@ void HashBuild::addInput(RowVectorPtr input) {
       rows->store(*decoders_[i], rowIndex, newRow, i + hashers.size());
     }
   });
+
+  if (analyzeKeys_ && hashModeSampleBatches_ > 0 &&
+      ++numInputBatches_ == hashModeSampleBatches_) {
+    hashModePredicted_ = table_->predictHashMode(rows->numRows());
+    analyzeKeys_ = !hashModePredicted_;
+  }
+}
+
+void HashBuild::sampleHotKeys(const RowVectorPtr& input) {
+  hotKeySampleRows_.resize(activeRows_.end());
+  hotKeySampleRows_.clearAll();
+  int32_t counter{0};
+  activeRows_.applyToSelected([&](auto row) {
+    if (counter++ % kHotKeySampleInterval == 0) {
+      hotKeySampleRows_.setValid(row, true);
+    }
+  });
+  hotKeySampleRows_.updateBounds();
+
+  hotKeySampleHashes_.resize(hotKeySampleRows_.end());
+  computeKeyHashes(input, hotKeySampleRows_, hotKeySampleHashes_);
+  hotKeySampleRows_.applyToSelected(
+      [&](auto row) { hotKeys_.insert(hotKeySampleHashes_[row]); });
+  numHotKeySamples_ += hotKeySampleRows_.countSelected();
+}
+
+void HashBuild::mergeHotKeys(const HashBuild& other) {
+  if (other.numHotKeySamples_ == 0) {
+    return;
+  }
+  for (auto i = 0; i < other.hotKeys_.size(); ++i) {
+    hotKeys_.insert(other.hotKeys_.values()[i], other.hotKeys_.counts()[i]);
+  }
+  numHotKeySamples_ += other.numHotKeySamples_;
+}
+
+void HashBuild::addHotKeyStats() {
+  if (numHotKeySamples_ == 0) {
+    return;
+  }
+  int64_t numHotKeys{0};
+  int64_t numHotKeyRows{0};
+  for (const auto& entry : hotKeys_.topK(kHotKeyCapacity)) {
+    const auto count = entry.second;
+    if (count * 100.0 / numHotKeySamples_ <= kHotKeyPct) {
+      break;
+    }
+    ++numHotKeys;
+    numHotKeyRows += count;
+  }
+  if (numHotKeys == 0) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat("hotKeys", RuntimeCounter(numHotKeys));
+  // The percentage of the build rows that have a hot key.
+  lockedStats->addRuntimeStat(
+      "hotKeyRowsPct",
+      RuntimeCounter(numHotKeyRows * 100 / numHotKeySamples_));
 }
 
 bool HashBuild::ensureInputFits(RowVectorPtr& input) {
@@ -614,15 +715,7 @@ void HashBuild::computeSpillPartitions(const RowVectorPtr& input) {
   if (hashes_.size() < activeRows_.end()) {
     hashes_.resize(activeRows_.end());
   }
-  const auto& hashers = table_->hashers();
-  for (auto i = 0; i < hashers.size(); ++i) {
-    auto& hasher = hashers[i];
-    if (hasher->channel() != kConstantChannel) {
-      hashers[i]->hash(activeRows_, i > 0, hashes_);
-    } else {
-      hashers[i]->hashPrecomputed(activeRows_, i > 0, hashes_);
-    }
-  }
+  computeKeyHashes(input, activeRows_, hashes_);
 
   spillPartitions_.resize(input->size());
   for (auto i = 0; i < spillPartitions_.size(); ++i) {
@@ -630,6 +723,27 @@ void HashBuild::computeSpillPartitions(const RowVectorPtr& input) {
   }
 }
 
+void HashBuild::computeKeyHashes(
+    const RowVectorPtr& input,
+    const SelectivityVector& rows,
+    raw_vector<uint64_t>& hashes) {
+  if (keyHashChannel_.has_value() && !isInputFromSpill()) {
+    decodedKeyHashes_.decode(*input->childAt(keyHashChannel_.value()), rows);
+    rows.applyToSelected([&](auto row) {
+      hashes[row] = decodedKeyHashes_.valueAt<int64_t>(row);
+    });
+    return;
+  }
+  const auto& hashers = table_->hashers();
+  for (auto i = 0; i < hashers.size(); ++i) {
+    if (hashers[i]->channel() != kConstantChannel) {
+      hashers[i]->hash(rows, i > 0, hashes);
+    } else {
+      hashers[i]->hashPrecomputed(rows, i > 0, hashes);
+    }
+  }
+}
+
 void HashBuild::spillPartition(
     uint32_t partition,
     vector_size_t size,
@@ -693,16 +807,67 @@ void HashBuild::runSpill(const std::vector<Operator*>& spillOperators) {
   VELOX_CHECK_GT(targetRows, 0);
   VELOX_CHECK_GT(targetBytes, 0);
 
+  const auto partitions = partitionsToSpill(
+      spillOperators,
+      targetBytes + targetRows * table_->rows()->fixedRowSize());
+  const bool spillAll = partitions.size() +
+          spiller_->state().spilledPartitionSet().size() ==
+      spiller_->hashBits().numPartitions();
+
   // TODO: consider to offload the partition spill processing to an executor to
   // run in parallel.
   for (auto& spillOp : spillOperators) {
     HashBuild* build = dynamic_cast<HashBuild*>(spillOp);
-    build->spiller_->spill();
-    build->table_->clear();
+    if (spillAll) {
+      build->spiller_->spill();
+      build->table_->clear();
+    } else {
+      build->spiller_->spill(partitions);
+    }
     build->pool()->release();
   }
 }
 
+// static
+SpillPartitionNumSet HashBuild::partitionsToSpill(
+    const std::vector<Operator*>& spillOperators,
+    uint64_t targetBytes) {
+  // All the builds must spill the same partitions, so that the probe side
+  // finds a partition either all in the table or all on disk.
+  std::vector<uint64_t> partitionBytes;
+  const Spiller* spiller{nullptr};
+  for (auto& spillOp : spillOperators) {
+    HashBuild* build = static_cast<HashBuild*>(spillOp);
+    spiller = build->spiller_.get();
+    const auto bytes = spiller->partitionBytes();
+    partitionBytes.resize(bytes.size());
+    for (auto i = 0; i < bytes.size(); ++i) {
+      partitionBytes[i] += bytes[i];
+    }
+  }
+  std::vector<uint32_t> candidates;
+  for (auto partition = 0; partition < partitionBytes.size(); ++partition) {
+    if (!spiller->isSpilled(partition)) {
+      candidates.push_back(partition);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [&](auto left, auto right) {
+    return partitionBytes[left] > partitionBytes[right];
+  });
+
+  // Spills the largest partitions until they cover the target.
+  SpillPartitionNumSet partitions;
+  uint64_t spillBytes{0};
+  for (const auto partition : candidates) {
+    if (spillBytes >= targetBytes) {
+      break;
+    }
+    partitions.insert(partition);
+    spillBytes += partitionBytes[partition];
+  }
+  return partitions;
+}
+
 void HashBuild::addAndClearSpillTarget(uint64_t& numRows, uint64_t& numBytes) {
   numRows += numSpillRows_;
   numSpillRows_ = 0;
@@ -817,6 +982,7 @@ bool HashBuild::finishHashBuild() {
       buildSpiller->finishSpill(spillPartitions);
     }
     build->recordSpillStats(buildSpiller.get());
+    mergeHotKeys(*build);
   }
 
   if (spiller_ != nullptr) {
@@ -845,9 +1011,14 @@ bool HashBuild::finishHashBuild() {
                              : nullptr,
       isInputFromSpill() ? spillConfig()->startPartitionBit
                          : BaseHashTable::kNoSpillInputStartPartitionBit);
+  auto bloomFilters = makeBloomFilters(spillPartitions);
   addRuntimeStats();
+  addHotKeyStats();
   if (joinBridge_->setHashTable(
-          std::move(table_), std::move(spillPartitions), joinHasNullKeys_)) {
+          std::move(table_),
+          std::move(spillPartitions),
+          joinHasNullKeys_,
+          std::move(bloomFilters))) {
     intermediateStateCleared_ = true;
     spillGroup_->restart();
   }
@@ -962,6 +1133,122 @@ void HashBuild::processSpillInput() {
   noMoreInputInternal();
 }
 
+std::vector<std::shared_ptr<common::Filter>> HashBuild::makeBloomFilters(
+    const SpillPartitionSet& spillPartitions) {
+  const auto maxBytes =
+      operatorCtx_->driverCtx()->queryConfig().hashJoinBloomFilterMaxBytes();
+  // HashProbe only pushes down dynamic filters for these join types and if
+  // the table is built from all the build side input.
+  if (maxBytes == 0 || !spillPartitions.empty() || isInputFromSpill() ||
+      !(isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+        isRightSemiFilterJoin(joinType_) ||
+        isRightSemiProjectJoin(joinType_))) {
+    return {};
+  }
+  const auto numDistinct = table_->numDistinct();
+  if (numDistinct == 0 || numDistinct > std::numeric_limits<int32_t>::max()) {
+    return {};
+  }
+  // BloomFilter::reset() allocates 2 bytes per expected entry.
+  const uint64_t numBytes =
+      std::max<uint64_t>(4, bits::nextPowerOfTwo(numDistinct) / 4) *
+      sizeof(uint64_t);
+  if (numBytes > maxBytes) {
+    return {};
+  }
+
+  const auto& hashers = table_->hashers();
+  std::vector<column_index_t> keys;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    switch (hashers[i]->typeKind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        // HashProbe pushes down the distinct values of the key if these are
+        // known.
+        if (table_->hashMode() != BaseHashTable::HashMode::kHash &&
+            !hashers[i]->distinctOverflow()) {
+          break;
+        }
+        [[fallthrough]];
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        keys.push_back(i);
+        break;
+      default:
+        break;
+    }
+  }
+  if (keys.empty()) {
+    return {};
+  }
+
+  std::vector<std::unique_ptr<BloomFilter<>>> bloomFilters;
+  std::vector<int64_t> mins(keys.size(), std::numeric_limits<int64_t>::max());
+  std::vector<int64_t> maxs(keys.size(), std::numeric_limits<int64_t>::min());
+  std::vector<VectorPtr> keyVectors;
+  constexpr int32_t kBatch = 1024;
+  for (auto key : keys) {
+    bloomFilters.push_back(std::make_unique<BloomFilter<>>());
+    bloomFilters.back()->reset(numDistinct);
+    keyVectors.push_back(
+        BaseVector::create(hashers[key]->type(), kBatch, pool()));
+  }
+
+  std::vector<char*> rows(kBatch);
+  BaseHashTable::RowsIterator iter;
+  while (auto numRows = table_->listAllRows(
+             &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+    for (auto i = 0; i < keys.size(); ++i) {
+      RowContainer::extractColumn(
+          rows.data(),
+          numRows,
+          table_->rows()->columnAt(keys[i]),
+          keyVectors[i]);
+      switch (hashers[keys[i]]->typeKind()) {
+        case TypeKind::TINYINT:
+          addBloomFilterKeys<int8_t>(
+              *keyVectors[i], numRows, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::SMALLINT:
+          addBloomFilterKeys<int16_t>(
+              *keyVectors[i], numRows, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::INTEGER:
+          addBloomFilterKeys<int32_t>(
+              *keyVectors[i], numRows, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+        case TypeKind::BIGINT:
+          addBloomFilterKeys<int64_t>(
+              *keyVectors[i], numRows, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+        default:
+          addBloomFilterKeys<StringView>(
+              *keyVectors[i], numRows, *bloomFilters[i], mins[i], maxs[i]);
+          break;
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<common::Filter>> filters(hashers.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    if (mins[i] > maxs[i]) {
+      // String keys or integral keys that are all null.
+      mins[i] = std::numeric_limits<int64_t>::min();
+      maxs[i] = std::numeric_limits<int64_t>::max();
+    }
+    filters[keys[i]] = std::make_shared<common::BloomFilterValues>(
+        mins[i], maxs[i], std::move(bloomFilters[i]), false);
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat("numBloomFilters", RuntimeCounter(keys.size()));
+  lockedStats->addRuntimeStat(
+      "bloomFilterBytes",
+      RuntimeCounter(keys.size() * numBytes, RuntimeCounter::Unit::kBytes));
+  return filters;
+}
+
 void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
@@ -993,6 +1280,10 @@ void HashBuild::addRuntimeStats() {
     lockedStats->runtimeStats["hashtable.numTombstones"] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  if (hashModePredicted_) {
+    lockedStats->addRuntimeStat(
+        "hashtable.hashModePredicted", RuntimeCounter(1));
+  }
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
@@ -24,6 +24,7 @@
 #include "velox/exec/UnorderedStreamReader.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/Expr.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -87,6 +88,15 @@ class HashBuild final : public Operator {
 
   void close() override;
 
+  /// One in this many input rows is sampled for hot key detection.
+  static constexpr int32_t kHotKeySampleInterval = 16;
+
+  /// The number of most frequent keys tracked for hot key detection.
+  static constexpr int32_t kHotKeyCapacity = 32;
+
+  /// A key is hot if it has more than this percentage of the sampled rows.
+  static constexpr double kHotKeyPct = 1;
+
  private:
   void setState(State state);
   void checkStateTransition(State state);
@@ -185,6 +195,13 @@ class HashBuild final : public Operator {
   // enabled. The computed partition numbers are stored in 'spillPartitions_'.
   void computeSpillPartitions(const RowVectorPtr& input);
 
+  // Sets 'hashes' to the hashes of the keys of 'rows' in 'input'. Reads these
+  // from 'keyHashChannel_' if set and hashes the decoded keys otherwise.
+  void computeKeyHashes(
+      const RowVectorPtr& input,
+      const SelectivityVector& rows,
+      raw_vector<uint64_t>& hashes);
+
   // Invoked to set up 'spillChildVectors_' for spill if 'input' is from build
   // source.
   void maybeSetupSpillChildVectors(const RowVectorPtr& input);
@@ -208,10 +225,29 @@ class HashBuild final : public Operator {
   // spill inline.
   bool waitSpill(RowVectorPtr& input);
 
+  // Adds every 'kHotKeySampleInterval'th row of 'activeRows_' to 'hotKeys_'.
+  void sampleHotKeys(const RowVectorPtr& input);
+
+  // Adds the hot key samples of 'other' to 'this'.
+  void mergeHotKeys(const HashBuild& other);
+
+  // Reports the keys that make up more than 'kHotKeyPct' of the sampled rows
+  // in runtime stats.
+  void addHotKeyStats();
+
   // The callback registered to 'spillGroup_' to run group spill on
-  // 'spillOperators'.
+  // 'spillOperators'. Spills the largest partitions until the spill targets
+  // are met and keeps the other partitions in memory to join without
+  // spilling.
   void runSpill(const std::vector<Operator*>& spillOperators);
 
+  // Returns the partitions not spilled yet with the most rows in
+  // 'spillOperators', largest first, until their byte size adds up to
+  // 'targetBytes'.
+  static SpillPartitionNumSet partitionsToSpill(
+      const std::vector<Operator*>& spillOperators,
+      uint64_t targetBytes);
+
   // Invoked by 'runSpill' to sum up the spill targets from all the operators in
   // 'numRows' and 'numBytes'.
   void addAndClearSpillTarget(uint64_t& numRows, uint64_t& numBytes);
@@ -240,6 +276,13 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Returns the Bloom filters on the join keys of the built 'table_' to push
+  // down to the probe side, null for the keys whose values HashProbe can push
+  // down as a range or IN-list filter. Returns an empty vector if the Bloom
+  // filters are disabled or not applicable to the join.
+  std::vector<std::shared_ptr<common::Filter>> makeBloomFilters(
+      const SpillPartitionSet& spillPartitions);
+
   // Invoked to check if it needs to trigger spilling for test purpose only.
   bool testingTriggerSpill();
 
@@ -301,9 +344,37 @@ class HashBuild final : public Operator {
   // to false when the dataset is no longer suitable.
   bool analyzeKeys_;
 
+  // The number of input batches after which the hash mode is predicted from
+  // the key statistics. 0 if not predicted.
+  const uint32_t hashModeSampleBatches_;
+
+  // The number of input batches added to the current table.
+  uint32_t numInputBatches_{0};
+
+  // True if the hash mode of the current table was set to kHash from sampled
+  // key statistics.
+  bool hashModePredicted_{false};
+
   // Temporary space for hash numbers.
   raw_vector<uint64_t> hashes_;
 
+  // Input column with the hashes of the keys computed by an upstream
+  // LocalPartition. Not set for input read back from spill.
+  std::optional<column_index_t> keyHashChannel_;
+  DecodedVector decodedKeyHashes_;
+
+  // The most frequent key hashes in a sample of the input rows. Merged over
+  // the build operators when the table is built and reported in runtime
+  // stats.
+  functions::ApproxMostFrequentStreamSummary<uint64_t> hotKeys_;
+
+  // The number of input rows sampled into 'hotKeys_'.
+  uint64_t numHotKeySamples_{0};
+
+  // The sampled rows of the input in addInput() and their key hashes.
+  SelectivityVector hotKeySampleRows_;
+  raw_vector<uint64_t> hotKeySampleHashes_;
+
   // Set of active rows during addInput().
   SelectivityVector activeRows_;
 
@@ -32,7 +32,8 @@ void HashJoinBridge::addBuilder() {
 bool HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<common::Filter>> bloomFilters) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
@@ -62,7 +63,8 @@ bool HashJoinBridge::setHashTable(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(bloomFilters));
     restoringSpillPartitionId_.reset();
 
     hasSpillData = !spillPartitionSets_.empty();
@@ -126,11 +128,19 @@ bool HashJoinBridge::probeFinished() {
 
     if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
-      restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
-      restoringSpillShards_ =
-          spillPartitionSets_.begin()->second->split(numBuilders_);
+      // Restores the smallest partition first, so that the most partitions
+      // are joined before the largest, which is the most likely to spill
+      // again.
+      auto next = std::min_element(
+          spillPartitionSets_.begin(),
+          spillPartitionSets_.end(),
+          [](const auto& left, const auto& right) {
+            return left.second->size() < right.second->size();
+          });
+      restoringSpillPartitionId_ = next->first;
+      restoringSpillShards_ = next->second->split(numBuilders_);
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
-      spillPartitionSets_.erase(spillPartitionSets_.begin());
+      spillPartitionSets_.erase(next);
       promises = std::move(promises_);
     } else {
       VELOX_CHECK(promises_.empty());
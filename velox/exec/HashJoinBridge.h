@@ -38,11 +38,14 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table'. The function returns true if there is spill data to restore
   /// after HashProbe operators process 'table', otherwise false. This only
-  /// applies if the disk spilling is enabled.
+  /// applies if the disk spilling is enabled. 'bloomFilters' has the Bloom
+  /// filter on each join key of 'table' to push down to the probe side, null
+  /// if none, or is empty if there are no Bloom filters.
   bool setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<common::Filter>> bloomFilters = {});
 
   void setAntiJoinHasNullKeys();
 
@@ -57,11 +60,13 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<common::Filter>> _bloomFilters = {})
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          bloomFilters(std::move(_bloomFilters)) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -69,6 +74,8 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    // The Bloom filter on each join key or null. Empty if there are none.
+    std::vector<std::shared_ptr<common::Filter>> bloomFilters;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -150,4 +150,27 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
   return std::make_shared<HashPartitionFunctionSpec>(
       ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
 }
+
+std::optional<column_index_t> keyHashChannel(
+    const core::PlanNode& source,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys) {
+  const auto* localPartition =
+      dynamic_cast<const core::LocalPartitionNode*>(&source);
+  if (localPartition == nullptr || !localPartition->outputKeyHashes()) {
+    return std::nullopt;
+  }
+  const auto* spec = dynamic_cast<const HashPartitionFunctionSpec*>(
+      &localPartition->partitionFunctionSpec());
+  if (spec == nullptr || spec->keyChannels().size() != keys.size()) {
+    return std::nullopt;
+  }
+  for (auto i = 0; i < keys.size(); ++i) {
+    const auto channel = spec->keyChannels()[i];
+    if (channel == kConstantChannel ||
+        spec->inputType()->nameOf(channel) != keys[i]->name()) {
+      return std::nullopt;
+    }
+  }
+  return localPartition->outputType()->size() - 1;
+}
 } // namespace facebook::velox::exec
@@ -51,6 +51,14 @@ class HashPartitionFunction : public core::PartitionFunction {
     return numPartitions_;
   }
 
+  /// Returns the hashes of the keys of the rows of the last input to
+  /// partition(). These are the mix of VectorHasher::hash() over the keys, as
+  /// computed by a HashTable in kHash mode, and can be partitioned with a
+  /// HashBitRange as for spilling.
+  const raw_vector<uint64_t>& hashes() const {
+    return hashes_;
+  }
+
  private:
   void init(
       const RowTypePtr& inputType,
@@ -92,9 +100,25 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
       const folly::dynamic& obj,
       void* context);
 
+  const RowTypePtr& inputType() const {
+    return inputType_;
+  }
+
+  const std::vector<column_index_t>& keyChannels() const {
+    return keyChannels_;
+  }
+
  private:
   const RowTypePtr inputType_;
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
 };
+
+/// Returns the channel of the key hashes in the output of 'source' if
+/// 'source' is a LocalPartitionNode that outputs the hashes of exactly 'keys'
+/// in this order. An operator that hashes 'keys' with VectorHasher can then
+/// read the hashes from this channel instead.
+std::optional<column_index_t> keyHashChannel(
+    const core::PlanNode& source,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys);
 } // namespace facebook::velox::exec
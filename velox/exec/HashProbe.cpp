@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashProbe.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -27,11 +28,13 @@ namespace {
 constexpr int kBatchSize = 1024;
 
 // Returns the type for the hash table row. Build side keys first,
-// then dependent build side columns.
+// then dependent build side columns. The key hashes in 'keyHashChannel' are
+// not stored.
 RowTypePtr makeTableType(
     const RowType* type,
     const std::vector<std::shared_ptr<const core::FieldAccessTypedExpr>>&
-        keys) {
+        keys,
+    std::optional<column_index_t> keyHashChannel) {
   std::vector<std::string> names;
   std::vector<TypePtr> types;
   std::unordered_set<column_index_t> keyChannels(keys.size());
@@ -44,7 +47,8 @@ RowTypePtr makeTableType(
     keyChannels.insert(channel);
   }
   for (auto i = 0; i < type->size(); ++i) {
-    if (keyChannels.find(i) == keyChannels.end()) {
+    if (keyChannels.find(i) == keyChannels.end() &&
+        keyHashChannel != static_cast<column_index_t>(i)) {
       names.emplace_back(type->nameOf(i));
       types.emplace_back(type->childAt(i));
     }
@@ -67,8 +71,15 @@ void extractColumns(
     VELOX_CHECK_LT(resultChannel, resultVectors.size())
 
     auto& child = resultVectors[resultChannel];
-    // TODO: Consider reuse of complex types.
-    if (!child || !BaseVector::isVectorWritable(child) ||
+    if (child && BaseVector::isVectorWritable(child) &&
+        (child->encoding() == VectorEncoding::Simple::ARRAY ||
+         child->encoding() == VectorEncoding::Simple::MAP ||
+         child->encoding() == VectorEncoding::Simple::ROW)) {
+      // Complex values are appended to the children, so the children of a
+      // reused vector are cleared first.
+      BaseVector::prepareForReuse(child, rows.size());
+    } else if (
+        !child || !BaseVector::isVectorWritable(child) ||
         !child->isFlatEncoding()) {
       child = BaseVector::create(resultTypes[resultChannel], rows.size(), pool);
     }
@@ -146,7 +157,10 @@ void HashProbe::initialize() {
   VELOX_CHECK_NULL(lookup_);
   lookup_ = std::make_unique<HashLookup>(hashers_);
   auto buildType = joinNode_->sources()[1]->outputType();
-  auto tableType = makeTableType(buildType.get(), joinNode_->rightKeys());
+  auto tableType = makeTableType(
+      buildType.get(),
+      joinNode_->rightKeys(),
+      keyHashChannel(*joinNode_->sources()[1], joinNode_->rightKeys()));
   if (joinNode_->filter()) {
     initializeFilter(joinNode_->filter(), probeType_, tableType);
   }
@@ -292,6 +306,9 @@ void HashProbe::asyncWaitForHashTable() {
 
   table_ = std::move(hashBuildResult->table);
   VELOX_CHECK_NOT_NULL(table_);
+  buildRowSize_ = tableOutputProjections_.empty()
+      ? 0
+      : table_->rows()->estimateRowSize().value_or(0);
 
   maybeSetupSpillInput(
       hashBuildResult->restoredPartitionId, hashBuildResult->spillPartitionIds);
@@ -312,11 +329,13 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !hashBuildResult->bloomFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
-    // filters to push down.
+    // filters to push down. The Bloom filters made by HashBuild are pushed
+    // down for the keys without a range or IN-list filter.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
@@ -330,12 +349,22 @@ void HashProbe::asyncWaitForHashTable() {
     // nulls on the probe side. Hence, cannot filter these out.
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
+    const auto& bloomFilters = hashBuildResult->bloomFilters;
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
         if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+          continue;
         }
       }
+      if (i < bloomFilters.size() && bloomFilters[i] != nullptr) {
+        dynamicFilters_.emplace(
+            keyChannels_[i], bloomFilters[i]->clone(nullAllowed));
+        hasBloomFilter_ = true;
+      }
     }
   }
 }
@@ -496,9 +525,11 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the filter is not a Bloom filter, which has false positives.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      !hasBloomFilter_) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -554,6 +585,8 @@ void HashProbe::addInput(RowVectorPtr input) {
     }
   }
 
+  updateOutputBatchSize();
+
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
       VELOX_CHECK(needSpillInput());
@@ -624,6 +657,19 @@ void HashProbe::addInput(RowVectorPtr input) {
   results_.reset(*lookup_);
 }
 
+void HashProbe::updateOutputBatchSize() {
+  const auto numInput = input_->size();
+  if (numInput == 0) {
+    return;
+  }
+  uint64_t probeBytes = 0;
+  for (const auto& projection : identityProjections_) {
+    probeBytes += input_->childAt(projection.inputChannel)->estimateFlatSize();
+  }
+  outputBatchSize_ =
+      boundedOutputBatchRows(probeBytes / numInput + buildRowSize_);
+}
+
 void HashProbe::prepareOutput(vector_size_t size) {
   // Try to re-use memory for the output vectors that contain build-side data.
   // We expect output vectors containing probe-side data to be null (reset in
@@ -905,6 +951,15 @@ RowVectorPtr HashProbe::getOutput() {
       std::iota(mapping.begin(), mapping.end(), 0);
       std::fill(outputTableRows_.begin(), outputTableRows_.end(), nullptr);
       numOut = inputSize;
+    } else if (isLeftSemiFilterJoin(joinType_) && !filter_) {
+      // Only the existence of a match matters. Each probe row with a hit is
+      // returned once without listing its matches.
+      const auto* hits = lookup_->hits.data();
+      for (auto row : lookup_->rows) {
+        mapping[numOut] = row;
+        outputTableRows_[numOut] = hits[row];
+        numOut += hits[row] != nullptr;
+      }
     } else if (isAntiJoin(joinType_) && !filter_) {
       if (nullAware_) {
         // When build side is not empty, anti join without a filter returns
@@ -1181,11 +1236,39 @@ SelectivityVector HashProbe::evalFilterForNullAwareJoin(
   return filterPassedRows;
 }
 
+vector_size_t HashProbe::skipPassedProbeRow(vector_size_t numRows) {
+  auto* rawMapping = outputRowMapping_->asMutable<vector_size_t>();
+  const auto row = rawMapping[0];
+  const bool passed = isLeftSemiFilterJoin(joinType_)
+      ? leftSemiFilterJoinTracker_.hasPassed(row)
+      : noMatchDetector_.hasPassed(row);
+  if (!passed) {
+    return numRows;
+  }
+  vector_size_t numSkipped = 1;
+  while (numSkipped < numRows - 1 && rawMapping[numSkipped] == row) {
+    ++numSkipped;
+  }
+  std::copy(rawMapping + numSkipped, rawMapping + numRows, rawMapping);
+  std::copy(
+      outputTableRows_.begin() + numSkipped,
+      outputTableRows_.begin() + numRows,
+      outputTableRows_.begin());
+  return numRows - numSkipped;
+}
+
 int32_t HashProbe::evalFilter(int32_t numRows) {
   if (!filter_) {
     return numRows;
   }
 
+  // The candidates after the first passing one are not needed.
+  if (numRows > 1 &&
+      (isLeftSemiFilterJoin(joinType_) ||
+       (isAntiJoin(joinType_) && !nullAware_))) {
+    numRows = skipPassedProbeRow(numRows);
+  }
+
   const bool filterPropagateNulls = filter_->expr(0)->propagatesNulls();
   auto* rawOutputProbeRowMapping =
       outputRowMapping_->asMutable<vector_size_t>();
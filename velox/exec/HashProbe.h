@@ -99,6 +99,10 @@ class HashProbe : public Operator {
       const RowTypePtr& tableType);
 
   // Check if output_ can be re-used and if not make a new one.
+  // Sets 'outputBatchSize_' from the estimated size of the output rows for
+  // 'input_'.
+  void updateOutputBatchSize();
+
   void prepareOutput(vector_size_t size);
 
   // Populate output columns.
@@ -124,6 +128,13 @@ class HashProbe : public Operator {
   // Returns the number of passing rows.
   vector_size_t evalFilter(vector_size_t numRows);
 
+  // For left semi filter and anti joins, drops the candidate rows at the start
+  // of 'outputTableRows_' of the probe row that has already passed the filter
+  // in an earlier batch, so that the filter is not evaluated on them. Keeps at
+  // least one row so that the trackers see the end of the batch. Returns the
+  // number of rows left.
+  vector_size_t skipPassedProbeRow(vector_size_t numRows);
+
   inline bool filterPassed(vector_size_t row) {
     return filterInputRows_.isValid(row) &&
         !decodedFilterResult_.isNullAt(row) &&
@@ -240,8 +251,14 @@ class HashProbe : public Operator {
         spillInputPartitionIds_.empty();
   }
 
-  // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const uint32_t outputBatchSize_;
+  // Maximum number of output rows per batch. Updated for each input from the
+  // size of the probe side columns and 'buildRowSize_' so that output batches
+  // stay within preferredOutputBatchBytes.
+  uint32_t outputBatchSize_;
+
+  // Average size in bytes of the rows of 'table_' or 0 if no build side
+  // columns are projected out.
+  uint64_t buildRowSize_{0};
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
@@ -288,6 +305,9 @@ class HashProbe : public Operator {
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
+  // True if a Bloom filter from the build side is in 'dynamicFilters_'.
+  bool hasBloomFilter_{false};
+
   // True if the join became a no-op after pushing down the filter.
   bool replacedWithDynamicFilter_{false};
 
@@ -449,6 +469,12 @@ class HashProbe : public Operator {
       return lastMissedRow.has_value();
     }
 
+    // Returns true if 'row' is the row being processed and has passed the
+    // filter.
+    bool hasPassed(vector_size_t row) const {
+      return currentRow == row && currentRowPassed;
+    }
+
    private:
     // Row number being processed.
     vector_size_t currentRow{-1};
@@ -492,6 +518,11 @@ class HashProbe : public Operator {
       currentRow = -1;
     }
 
+    // Returns true if 'row' is the last row passed to advance().
+    bool hasPassed(vector_size_t row) const {
+      return currentRow == row;
+    }
+
    private:
     // The last row number passed to advance for the current input batch.
     vector_size_t currentRow{-1};
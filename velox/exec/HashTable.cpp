@@ -25,9 +25,24 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/vector/VectorTypeUtils.h"
 
+#include <folly/hash/Hash.h>
+#include <folly/portability/Asm.h>
+
+DECLARE_bool(velox_hash_table_use_hugepages);
+
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
+namespace {
+// Probes go to random places in the table. Huge pages avoid most of the TLB
+// misses.
+memory::HugePagePolicy tableHugePagePolicy() {
+  return FLAGS_velox_hash_table_use_hugepages
+      ? memory::HugePagePolicy::kAlways
+      : memory::HugePagePolicy::kDefault;
+}
+} // namespace
+
 // static
 std::string BaseHashTable::modeString(HashMode mode) {
   switch (mode) {
@@ -53,9 +68,11 @@ HashTable<ignoreNullKeys>::HashTable(
     bool hasProbedFlag,
     uint32_t minTableSizeForParallelJoinBuild,
     memory::MemoryPool* pool,
-    const std::shared_ptr<velox::HashStringAllocator>& stringArena)
+    const std::shared_ptr<velox::HashStringAllocator>& stringArena,
+    bool concurrentJoinBuild)
     : BaseHashTable(std::move(hashers)),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
+      concurrentJoinBuild_(concurrentJoinBuild),
       isJoinBuild_(isJoinBuild) {
   std::vector<TypePtr> keys;
   for (auto& hasher : hashers_) {
@@ -304,8 +321,10 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::storeKeys(
     HashLookup& lookup,
     vector_size_t row) {
-  for (int32_t i = 0; i < hashers_.size(); ++i) {
-    auto& hasher = hashers_[i];
+  // The keys are decoded by the hashers of 'lookup', which may belong to
+  // another table with the same keys.
+  for (int32_t i = 0; i < lookup.hashers.size(); ++i) {
+    auto& hasher = lookup.hashers[i];
     rows_->store(hasher->decodedVector(), row, lookup.hits[row], i); // NOLINT
   }
 }
@@ -596,36 +615,30 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
+  const int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    state2.firstProbe(*this, 0);
-    state3.firstProbe(*this, 0);
-    state4.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-    fullProbe<true>(lookup, state2, false);
-    fullProbe<true>(lookup, state3, false);
-    fullProbe<true>(lookup, state4, false);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
+  const uint64_t* hashes = lookup.hashes.data();
+  ProbeState states[kMaxJoinProbeGroupSize];
+  // Each stage runs over the whole group before the next one starts. The
+  // bucket loaded by a stage was prefetched by the previous stage
+  // 'groupSize' probes earlier.
+  for (int32_t probeIndex = 0; probeIndex < numProbes;
+       probeIndex += joinProbeGroupSize_) {
+    const int32_t groupSize =
+        std::min(joinProbeGroupSize_, numProbes - probeIndex);
+    // Prefetches the first bucket of each probe.
+    for (int32_t i = 0; i < groupSize; ++i) {
+      const int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    // Compares the tags and prefetches the first matching row.
+    for (int32_t i = 0; i < groupSize; ++i) {
+      states[i].firstProbe(*this, 0);
+    }
+    // Compares the keys and follows the probe sequence on mismatch.
+    for (int32_t i = 0; i < groupSize; ++i) {
+      fullProbe<true>(lookup, states[i], false);
+    }
   }
 }
 
@@ -720,7 +733,8 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   // cache line.
   const auto numPages =
       memory::AllocationTraits::numPages(size * tableSlotSize());
-  rows_->pool()->allocateContiguous(numPages, tableAllocation_);
+  rows_->pool()->allocateContiguous(
+      numPages, tableAllocation_, 0, tableHugePagePolicy());
   table_ = tableAllocation_.data<char*>();
   memset(table_, 0, capacity_ * sizeof(char*));
 }
@@ -1035,6 +1049,202 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::canApplyConcurrentJoinBuild() const {
+  if (!concurrentJoinBuild_ || !isJoinBuild_ || buildExecutor_ == nullptr) {
+    return false;
+  }
+  if (hashMode_ == HashMode::kArray || otherTables_.empty()) {
+    return false;
+  }
+  // Unlike the partitioned build, the threshold is on the whole table since
+  // the inserts are not limited to a partition of the table.
+  return capacity_ > minTableSizeForParallelJoinBuild_;
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::concurrentJoinBuild(bool initNormalizedKeys) {
+  process::TraceContext trace("HashTable::concurrentJoinBuild");
+  TestValue::adjust(
+      "facebook::velox::exec::HashTable::concurrentJoinBuild", rows_->pool());
+  const int32_t numTables = 1 + otherTables_.size();
+  // Rows with a key that is already in the table, per inserting thread and
+  // then per linking thread.
+  std::vector<std::vector<std::vector<std::pair<char*, char*>>>> duplicates(
+      numTables);
+  std::vector<std::shared_ptr<AsyncSource<bool>>> insertSteps;
+  std::vector<std::shared_ptr<AsyncSource<bool>>> linkSteps;
+  std::atomic<bool> hashModeChanged{false};
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw.
+    std::exception_ptr error;
+    syncWorkItems(insertSteps, error, offThreadBuildTiming_, true);
+    syncWorkItems(linkSteps, error, offThreadBuildTiming_, true);
+  });
+
+  const auto getTable = [this](size_t i) INLINE_LAMBDA {
+    return i == 0 ? this : otherTables_[i - 1].get();
+  };
+
+  for (auto i = 0; i < numTables; ++i) {
+    duplicates[i].resize(numTables);
+  }
+  for (auto i = 0; i < numTables; ++i) {
+    auto* table = getTable(i);
+    const bool initKeys = i == 0 ? initNormalizedKeys : true;
+    insertSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, table, initKeys, i, &duplicates, &hashModeChanged]() {
+          if (!concurrentInsertRows(*table, initKeys, duplicates[i])) {
+            hashModeChanged = true;
+          }
+          return std::make_unique<bool>(true);
+        }));
+    VELOX_CHECK(!insertSteps.empty());
+    buildExecutor_->add([step = insertSteps.back()]() { step->prepare(); });
+  }
+  std::exception_ptr error;
+  syncWorkItems(insertSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  if (hashModeChanged) {
+    // The caller starts over with another hash mode.
+    memset(table_, 0, capacity_ * sizeof(char*));
+    return false;
+  }
+  if (nextOffset_ == 0) {
+    // Semi and anti joins ignore repeats of a key.
+    return true;
+  }
+
+  // Links the repeats of a key to the row in the table. The repeats are
+  // partitioned on the row in the table so that the links of a row are set
+  // by a single thread.
+  for (auto i = 0; i < numTables; ++i) {
+    const bool hasDuplicates = std::any_of(
+        duplicates.begin(), duplicates.end(), [&](const auto& perThread) {
+          return !perThread[i].empty();
+        });
+    if (!hasDuplicates) {
+      continue;
+    }
+    linkSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, i, &duplicates]() {
+          for (const auto& perThread : duplicates) {
+            for (const auto& [group, row] : perThread[i]) {
+              pushNext(group, row);
+            }
+          }
+          return std::make_unique<bool>(true);
+        }));
+    VELOX_CHECK(!linkSteps.empty());
+    buildExecutor_->add([step = linkSteps.back()]() { step->prepare(); });
+  }
+  syncWorkItems(linkSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  return true;
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::concurrentInsertRows(
+    HashTable<ignoreNullKeys>& subtable,
+    bool initNormalizedKeys,
+    std::vector<std::vector<std::pair<char*, char*>>>& duplicates) {
+  constexpr int32_t kBatch = 1024;
+  raw_vector<char*> rows(kBatch);
+  raw_vector<uint64_t> hashes(kBatch);
+  RowContainerIterator iter;
+  while (auto numRows = subtable.rows_->listRows(
+             &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+    if (!hashRows(
+            folly::Range<char**>(rows.data(), numRows),
+            initNormalizedKeys,
+            hashes)) {
+      return false;
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      if (auto* group = concurrentInsertRow(hashes[i], rows[i])) {
+        if (nextOffset_ > 0) {
+          const auto partition =
+              folly::hash::twang_mix64(reinterpret_cast<uint64_t>(group)) %
+              duplicates.size();
+          duplicates[partition].emplace_back(group, rows[i]);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <bool ignoreNullKeys>
+char* HashTable<ignoreNullKeys>::concurrentInsertRow(
+    uint64_t hash,
+    char* row) {
+  // A slot that is claimed but not yet published. This is not a tag of a
+  // hash number since these have the high bit set.
+  constexpr uint8_t kClaimedTag = 0x01;
+  static_assert(kClaimedTag != ProbeState::kEmptyTag);
+  static_assert(kClaimedTag != ProbeState::kTombstoneTag);
+  const auto tag = hashTag(hash);
+  const auto wantedTags = BaseHashTable::TagVector::broadcast(tag);
+  const auto claimedTags = BaseHashTable::TagVector::broadcast(kClaimedTag);
+  const auto emptyTags =
+      BaseHashTable::TagVector::broadcast(ProbeState::kEmptyTag);
+  const auto isSameKey = [&](char* group) {
+    if (hashMode_ == HashMode::kNormalizedKey) {
+      return RowContainer::normalizedKey(group) ==
+          RowContainer::normalizedKey(row);
+    }
+    return compareKeys(group, row);
+  };
+
+  int64_t offset = bucketOffset(hash);
+  int64_t numProbedBuckets = 0;
+  while (numProbedBuckets < numBuckets()) {
+    auto* bucket = bucketAt(offset);
+    const auto tags =
+        BaseHashTable::loadTags(reinterpret_cast<uint8_t*>(table_), offset);
+    MaskType hits = (simd::toBitMask(tags == wantedTags) |
+                     simd::toBitMask(tags == claimedTags)) &
+        ProbeState::kFullMask;
+    while (hits) {
+      const auto slot = bits::getAndClearLastSetBit(hits);
+      uint8_t slotTag;
+      // A claimed slot is published right after, so waits for it rather than
+      // inserting a second row with the same key.
+      while ((slotTag = bucket->loadTag(slot)) == kClaimedTag) {
+        folly::asm_volatile_pause();
+      }
+      if (slotTag == tag) {
+        auto* group = bucket->loadPointer(slot);
+        if (isSameKey(group)) {
+          return group;
+        }
+      }
+    }
+    // Slots only go from empty to occupied and all threads take the first
+    // empty slot of the first bucket with empty slots. So two rows with the
+    // same key try to claim the same slot and the loser sees the winner on
+    // rereading the bucket.
+    const MaskType empty =
+        simd::toBitMask(tags == emptyTags) & ProbeState::kFullMask;
+    if (empty) {
+      const auto slot = __builtin_ctz(empty);
+      if (bucket->tryClaim(slot, ProbeState::kEmptyTag, kClaimedTag)) {
+        bucket->publish(slot, tag, row);
+        return nullptr;
+      }
+      continue;
+    }
+    offset = nextBucketOffset(offset);
+    ++numProbedBuckets;
+  }
+  VELOX_FAIL("Have looped through all the buckets in table: {}", toString());
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::insertBatch(
     char** groups,
@@ -1214,7 +1424,12 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
   ++numRehashes_;
   constexpr int32_t kHashBatchSize = 1024;
-  if (canApplyParallelJoinBuild()) {
+  if (canApplyConcurrentJoinBuild()) {
+    // Falls back to the sequential build below to change the hash mode.
+    if (concurrentJoinBuild(initNormalizedKeys)) {
+      return;
+    }
+  } else if (canApplyParallelJoinBuild()) {
     parallelJoinBuild();
     return;
   }
@@ -1248,7 +1463,8 @@ void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
   if (mode == HashMode::kArray) {
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
-    rows_->pool()->allocateContiguous(numPages, tableAllocation_);
+    rows_->pool()->allocateContiguous(
+        numPages, tableAllocation_, 0, tableHugePagePolicy());
     table_ = tableAllocation_.data<char*>();
     memset(table_, 0, bytes);
     hashMode_ = HashMode::kArray;
@@ -1479,6 +1695,46 @@ void HashTable<ignoreNullKeys>::decideHashMode(
   setHashMode(HashMode::kNormalizedKey, numNew);
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::predictHashMode(int64_t numSampledRows) {
+  VELOX_CHECK(isJoinBuild_);
+  // Below this many distinct values a key is not considered unbounded.
+  constexpr int32_t kMinSampledDistincts = 1'000;
+  // Fraction of the sampled rows that must have distinct values of a key for
+  // the key to be considered unbounded.
+  constexpr double kMinDistinctRatio = 0.5;
+  if (hashMode_ == HashMode::kHash) {
+    return true;
+  }
+  bool unbounded = false;
+  for (const auto& hasher : hashers_) {
+    if (!hasher->mayUseValueIds()) {
+      unbounded = true;
+      break;
+    }
+    uint64_t rangeSize;
+    uint64_t distinctSize;
+    hasher->cardinality(0, rangeSize, distinctSize);
+    const auto numDistincts = hasher->numUniqueValues();
+    if (rangeSize == VectorHasher::kRangeTooLarge &&
+        numDistincts >= kMinSampledDistincts &&
+        numDistincts >= numSampledRows * kMinDistinctRatio) {
+      unbounded = true;
+      break;
+    }
+  }
+  if (!unbounded) {
+    return false;
+  }
+  // Same as setHashMode(kHash) except that the table is not made.
+  hashMode_ = HashMode::kHash;
+  for (auto& hasher : hashers_) {
+    hasher->resetStats();
+  }
+  rows_->disableNormalizedKeys();
+  return true;
+}
+
 template <bool ignoreNullKeys>
 std::string HashTable<ignoreNullKeys>::toString() {
   std::stringstream out;
@@ -1984,7 +2240,8 @@ void BaseHashTable::prepareForGroupProbe(
     const RowVectorPtr& input,
     SelectivityVector& rows,
     bool ignoreNullKeys,
-    int8_t spillInputStartPartitionBit) {
+    int8_t spillInputStartPartitionBit,
+    std::optional<column_index_t> keyHashChannel) {
   checkHashBitsOverlap(spillInputStartPartitionBit);
   auto& hashers = lookup.hashers;
 
@@ -2002,14 +2259,21 @@ void BaseHashTable::prepareForGroupProbe(
 
   bool rehash = false;
   const auto mode = hashMode();
-  for (auto i = 0; i < hashers.size(); ++i) {
-    auto& hasher = hashers[i];
-    if (mode != BaseHashTable::HashMode::kHash) {
-      if (!hasher->computeValueIds(rows, lookup.hashes)) {
-        rehash = true;
+  if (mode == BaseHashTable::HashMode::kHash && keyHashChannel.has_value()) {
+    DecodedVector keyHashes(*input->childAt(keyHashChannel.value()), rows);
+    rows.applyToSelected([&](auto row) {
+      lookup.hashes[row] = keyHashes.valueAt<int64_t>(row);
+    });
+  } else {
+    for (auto i = 0; i < hashers.size(); ++i) {
+      auto& hasher = hashers[i];
+      if (mode != BaseHashTable::HashMode::kHash) {
+        if (!hasher->computeValueIds(rows, lookup.hashes)) {
+          rehash = true;
+        }
+      } else {
+        hasher->hash(rows, i > 0, lookup.hashes);
       }
-    } else {
-      hasher->hash(rows, i > 0, lookup.hashes);
     }
   }
 
@@ -2019,7 +2283,12 @@ void BaseHashTable::prepareForGroupProbe(
       // Do not forward 'ignoreNullKeys' to avoid redundant evaluation of
       // deselectRowsWithNulls.
       prepareForGroupProbe(
-          lookup, input, rows, false, spillInputStartPartitionBit);
+          lookup,
+          input,
+          rows,
+          false,
+          spillInputStartPartitionBit,
+          keyHashChannel);
       return;
     }
   }
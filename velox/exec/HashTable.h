@@ -178,13 +178,16 @@ class BaseHashTable {
   /// 'groupProbe' call. Rehashes the table if necessary. Uses lookup.hashes to
   /// decode grouping keys from 'input'. If 'ignoreNullKeys' is true, updates
   /// 'rows' to remove entries with null grouping keys. After this call, 'rows'
-  /// may have no entries selected.
+  /// may have no entries selected. If 'keyHashChannel' is set and the table is
+  /// in kHash mode, the hashes are read from this BIGINT column of 'input'
+  /// instead of being computed. See LocalPartitionNode::kKeyHashColumn.
   void prepareForGroupProbe(
       HashLookup& lookup,
       const RowVectorPtr& input,
       SelectivityVector& rows,
       bool ignoreNullKeys,
-      int8_t spillInputStartPartitionBit);
+      int8_t spillInputStartPartitionBit,
+      std::optional<column_index_t> keyHashChannel = std::nullopt);
 
   /// Finds or creates a group for each key in 'lookup'. The keys are
   /// returned in 'lookup.hits'.
@@ -312,6 +315,16 @@ class BaseHashTable {
       int32_t numNew,
       bool disableRangeArrayHash = false) = 0;
 
+  /// Predicts from the key statistics of the first 'numSampledRows' rows of a
+  /// join build whether the keys of the complete build side can map to an
+  /// array or normalized keys. If a key is not in a range and is mostly
+  /// distinct in the sample, it is expected to run out of distinct values
+  /// before the build completes. Then sets the hash mode to kHash without
+  /// making the table, so that the caller can stop collecting key statistics
+  /// and the table is made once for all rows in prepareJoinTable(). Returns
+  /// true if the mode was set to kHash.
+  virtual bool predictHashMode(int64_t numSampledRows) = 0;
+
   // Removes 'rows'  from the hash table and its RowContainer. 'rows' must exist
   // and be unique.
   virtual void erase(folly::Range<char**> rows) = 0;
@@ -427,7 +440,8 @@ class HashTable : public BaseHashTable {
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
       memory::MemoryPool* pool,
-      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr);
+      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr,
+      bool concurrentJoinBuild = false);
 
   static std::unique_ptr<HashTable> createForAggregation(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -453,7 +467,8 @@ class HashTable : public BaseHashTable {
       bool allowDuplicates,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool concurrentJoinBuild = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -462,13 +477,36 @@ class HashTable : public BaseHashTable {
         true, // isJoinBuild
         hasProbedFlag,
         minTableSizeForParallelJoinBuild,
-        pool);
+        pool,
+        nullptr,
+        concurrentJoinBuild);
   }
 
   void groupProbe(HashLookup& lookup) override;
 
   void joinProbe(HashLookup& lookup) override;
 
+  /// Default and maximum number of probes that joinProbe() runs together. In
+  /// kHash mode, each stage of the probe, i.e. prefetching the first bucket,
+  /// comparing the tags and prefetching the first hit, and comparing the
+  /// keys, runs over the whole group before the next stage starts, so that
+  /// the cache misses of the group overlap.
+  static constexpr int32_t kDefaultJoinProbeGroupSize = 16;
+  static constexpr int32_t kMaxJoinProbeGroupSize = 64;
+
+  /// Sets the number of probes that joinProbe() runs together in kHash mode.
+  /// Larger groups hide more memory latency for tables that do not fit in
+  /// cache, at the cost of more concurrent cache misses.
+  void setJoinProbeGroupSize(int32_t groupSize) {
+    VELOX_CHECK_GT(groupSize, 0);
+    VELOX_CHECK_LE(groupSize, kMaxJoinProbeGroupSize);
+    joinProbeGroupSize_ = groupSize;
+  }
+
+  int32_t joinProbeGroupSize() const {
+    return joinProbeGroupSize_;
+  }
+
   int32_t listJoinResults(
       JoinResultIterator& iter,
       bool includeMisses,
@@ -534,6 +572,8 @@ class HashTable : public BaseHashTable {
   void decideHashMode(int32_t numNew, bool disableRangeArrayHash = false)
       override;
 
+  bool predictHashMode(int64_t numSampledRows) override;
+
   void erase(folly::Range<char**> rows) override;
 
   // Moves the contents of 'tables' into 'this' and prepares 'this'
@@ -632,7 +672,46 @@ class HashTable : public BaseHashTable {
       *slot = (*slot & ~kPointerMask) | reinterpret_cast<uintptr_t>(pointer);
     }
 
+    // The functions below are used by the concurrent join build where
+    // several threads insert into the same buckets. A slot is claimed by
+    // replacing its empty tag with 'claimedTag' and is published by
+    // replacing 'claimedTag' with its tag once its pointer is written. The
+    // pointer of a slot is accessed without touching the bytes of its
+    // neighbors.
+
+    // Returns the tag at 'slotIndex' with acquire semantics so that the
+    // pointer of a published slot is visible.
+    uint8_t loadTag(int32_t slotIndex) {
+      return tagSlot(slotIndex).load(std::memory_order_acquire);
+    }
+
+    // Returns true if this thread replaced the empty tag at 'slotIndex' with
+    // 'claimedTag'.
+    bool tryClaim(int32_t slotIndex, uint8_t emptyTag, uint8_t claimedTag) {
+      return tagSlot(slotIndex).compare_exchange_strong(
+          emptyTag, claimedTag, std::memory_order_acq_rel);
+    }
+
+    // Writes 'pointer' to the claimed slot at 'slotIndex' and publishes
+    // 'tag'.
+    void publish(int32_t slotIndex, uint8_t tag, void* pointer) {
+      const auto value = reinterpret_cast<uintptr_t>(pointer);
+      std::memcpy(&pointers_[slotIndex * kPointerSize], &value, kPointerSize);
+      tagSlot(slotIndex).store(tag, std::memory_order_release);
+    }
+
+    char* loadPointer(int32_t slotIndex) {
+      uintptr_t value = 0;
+      std::memcpy(&value, &pointers_[slotIndex * kPointerSize], kPointerSize);
+      return reinterpret_cast<char*>(value);
+    }
+
    private:
+    std::atomic<uint8_t>& tagSlot(int32_t slotIndex) {
+      static_assert(sizeof(std::atomic<uint8_t>) == sizeof(uint8_t));
+      return reinterpret_cast<std::atomic<uint8_t>*>(&tags_)[slotIndex];
+    }
+
     static constexpr uint8_t kPointerSignificantBits = 48;
     static constexpr uint64_t kPointerMask =
         bits::lowMask(kPointerSignificantBits);
@@ -715,7 +794,8 @@ class HashTable : public BaseHashTable {
   void storeRowPointer(uint64_t index, uint64_t hash, char* row);
 
   // Allocates new tables for tags and payload pointers. The size must
-  // a power of 2.
+  // a power of 2. The tables are backed by huge pages if
+  // FLAGS_velox_hash_table_use_hugepages is set.
   void allocateTables(uint64_t size);
 
   // 'initNormalizedKeys' is passed to 'rehash' --> 'rehash' --> 'insertBatch'.
@@ -772,6 +852,37 @@ class HashTable : public BaseHashTable {
   // else.
   void parallelJoinBuild();
 
+  // Checks if the join table can be built with concurrent inserts. This is
+  // the case if the table is built for a join with 'concurrentJoinBuild_'
+  // set, there are other tables, the build executor has been set, the table
+  // is not in kArray mode and has more than
+  // 'minTableSizeForParallelJoinBuild_' entries.
+  bool canApplyConcurrentJoinBuild() const;
+
+  // Builds a join table with one thread per RowContainer of this and
+  // 'otherTables_' using 'executor_'. All threads insert into the shared
+  // table at the same time and claim slots with a compare and swap of their
+  // tag, so that no partitioning of the rows or sequential insert of
+  // overflows is needed. Rows with a key that is already in the table get
+  // linked to the row of the key after all inserts. Returns false without
+  // building the table if the hash mode must be reconsidered.
+  // 'initNormalizedKeys' applies to the rows of 'this'.
+  bool concurrentJoinBuild(bool initNormalizedKeys);
+
+  // Inserts the rows of 'subtable' into the table concurrently with other
+  // threads. Adds a pair of a row of 'subtable' and the row in the table with
+  // the same key to the element of 'duplicates' given by the row in the
+  // table. Returns false if the hash mode must be reconsidered.
+  bool concurrentInsertRows(
+      HashTable<ignoreNullKeys>& subtable,
+      bool initNormalizedKeys,
+      std::vector<std::vector<std::pair<char*, char*>>>& duplicates);
+
+  // Inserts 'row' with 'hash' concurrently with other threads. Returns the
+  // row in the table with the same key as 'row' or nullptr if 'row' was
+  // inserted.
+  char* concurrentInsertRow(uint64_t hash, char* row);
+
   // Inserts the rows in 'partition' from this and 'otherTables' into 'this'.
   // The rows that would have gone past the end of the partition are returned in
   // 'overflow'.
@@ -910,6 +1021,10 @@ class HashTable : public BaseHashTable {
   // The min table size in row to trigger parallel join table build.
   const uint32_t minTableSizeForParallelJoinBuild_;
 
+  // If true, the parallel join table build inserts the rows of all
+  // RowContainers concurrently instead of by partitions of the table.
+  const bool concurrentJoinBuild_;
+
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
@@ -974,6 +1089,9 @@ class HashTable : public BaseHashTable {
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
 
+  // Number of probes that joinProbe() runs together in kHash mode.
+  int32_t joinProbeGroupSize_{kDefaultJoinProbeGroupSize};
+
   friend class ProbeState;
   friend test::HashTableTestHelper<ignoreNullKeys>;
 };
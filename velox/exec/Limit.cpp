@@ -37,6 +37,16 @@ Limit::Limit(
   }
 }
 
+void Limit::initialize() {
+  Operator::initialize();
+  if (remainingLimit_ <=
+      std::numeric_limits<int64_t>::max() - remainingOffset_) {
+    // The source needs to produce the skipped rows and the returned rows.
+    operatorCtx_->driver()->pushdownLimit(
+        this, remainingOffset_ + remainingLimit_);
+  }
+}
+
 bool Limit::needsInput() const {
   return !finished_ && input_ == nullptr;
 }
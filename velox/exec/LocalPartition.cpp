@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/LocalPartition.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -29,34 +30,43 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasPromises_ = true;
+  if (bufferedBytes_ < maxBufferSize_) {
+    // Consumers have made room since the increase.
+    hasPromises_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasPromises_) {
+    return {};
+  }
+
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
     if (bufferedBytes_ < maxBufferSize_) {
       promises = std::move(promises_);
+      promises_.clear();
+      hasPromises_ = false;
     }
   }
   return promises;
 }
 
 void LocalExchangeQueue::addProducer() {
-  queue_.withWLock([&](auto& /*queue*/) {
+  queue_.withLock([&](auto& /*queue*/) {
     VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
     ++pendingProducers_;
   });
@@ -64,7 +74,7 @@ void LocalExchangeQueue::addProducer() {
 
 void LocalExchangeQueue::noMoreProducers() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  queue_.withLock([&](auto& queue) {
     VELOX_CHECK(!noMoreProducers_, "noMoreProducers can be called only once");
     noMoreProducers_ = true;
     if (pendingProducers_ == 0) {
@@ -80,19 +90,18 @@ BlockingReason LocalExchangeQueue::enqueue(
     ContinueFuture* future) {
   auto inputBytes = input->estimateFlatSize();
 
-  std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
-  bool isClosed = queue_.withWLock([&](auto& queue) {
+  std::optional<ContinuePromise> consumerPromise;
+  bool isClosed = queue_.withLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
-    consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
+    queue.push({std::move(input), inputBytes});
+    // One batch is enough for one consumer. The others stay blocked instead
+    // of waking up to find the queue empty.
+    if (!consumerPromises_.empty()) {
+      consumerPromise = std::move(consumerPromises_.back());
+      consumerPromises_.pop_back();
     }
-
     return false;
   });
 
@@ -100,9 +109,13 @@ BlockingReason LocalExchangeQueue::enqueue(
     return BlockingReason::kNotBlocked;
   }
 
-  notify(consumerPromises);
+  if (consumerPromise.has_value()) {
+    consumerPromise->setValue();
+  }
 
-  if (blockedOnConsumer) {
+  // Outside of the queue lock. A consumer may dequeue 'input' and decrease
+  // the memory usage before it is increased here.
+  if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
     return BlockingReason::kWaitForConsumer;
   }
 
@@ -111,7 +124,7 @@ BlockingReason LocalExchangeQueue::enqueue(
 
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  queue_.withLock([&](auto& queue) {
     VELOX_CHECK_GT(pendingProducers_, 0);
     --pendingProducers_;
     if (noMoreProducers_ && pendingProducers_ == 0) {
@@ -125,8 +138,8 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
-  auto blockingReason = queue_.withWLock([&](auto& queue) {
+  int64_t bytes = 0;
+  auto blockingReason = queue_.withLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
       if (isFinishedLocked(queue)) {
@@ -139,20 +152,20 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
+    *data = std::move(queue.front().data);
+    bytes = queue.front().bytes;
     queue.pop();
-
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
-
     return BlockingReason::kNotBlocked;
   });
-  notify(memoryPromises);
+  if (bytes > 0) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(bytes);
+    notify(memoryPromises);
+  }
   return blockingReason;
 }
 
 bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+    const std::queue<Entry>& queue) const {
   if (closed_) {
     return true;
   }
@@ -165,26 +178,24 @@ bool LocalExchangeQueue::isFinishedLocked(
 }
 
 bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+  return queue_.withLock([&](auto& queue) { return isFinishedLocked(queue); });
 }
 
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
-  queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
+  uint64_t freedBytes = 0;
+  queue_.withLock([&](auto& queue) {
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += queue.front().bytes;
       queue.pop();
     }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
-
     consumerPromises = std::move(consumerPromises_);
     closed_ = true;
   });
+  if (freedBytes) {
+    memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
+  }
   notify(consumerPromises);
   notify(memoryPromises);
 }
@@ -249,10 +260,23 @@ LocalPartition::LocalPartition(
           ctx->task->getLocalExchangeQueues(ctx->splitGroupId, planNode->id())},
       numPartitions_{queues_.size()},
       partitionFunction_(
-          numPartitions_ == 1
+          (numPartitions_ == 1 && !planNode->outputKeyHashes()) ||
+                  planNode->scaleWriter()
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
-  VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      scaleWriter_(planNode->scaleWriter()),
+      outputKeyHashes_(planNode->outputKeyHashes()),
+      scaleWriterMinProcessedBytes_(
+          ctx->queryConfig().scaleWriterMinProcessedBytes()) {
+  VELOX_CHECK(
+      numPartitions_ == 1 || scaleWriter_ || partitionFunction_ != nullptr);
+  if (outputKeyHashes_) {
+    const auto* spec = dynamic_cast<const HashPartitionFunctionSpec*>(
+        &planNode->partitionFunctionSpec());
+    VELOX_USER_CHECK(
+        spec != nullptr && !spec->keyChannels().empty(),
+        "Key hashes require hash partitioning on at least one key");
+  }
 
   for (auto& queue : queues_) {
     queue->addProducer();
@@ -295,10 +319,46 @@ wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
 }
 } // namespace
 
+void LocalPartition::enqueue(LocalExchangeQueue& queue, RowVectorPtr data) {
+  ContinueFuture future;
+  auto blockingReason = queue.enqueue(std::move(data), &future);
+  if (blockingReason != BlockingReason::kNotBlocked) {
+    blockingReasons_.push_back(blockingReason);
+    futures_.push_back(std::move(future));
+  }
+}
+
+RowVectorPtr LocalPartition::addKeyHashes(const RowVectorPtr& input) {
+  const auto& hashes =
+      static_cast<HashPartitionFunction*>(partitionFunction_.get())->hashes();
+  const auto numRows = input->size();
+  auto keyHashes =
+      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numRows, pool());
+  memcpy(
+      keyHashes->mutableRawValues(), hashes.data(), numRows * sizeof(int64_t));
+  auto children = input->children();
+  children.push_back(std::move(keyHashes));
+  return std::make_shared<RowVector>(
+      input->pool(), outputType_, nullptr, numRows, std::move(children));
+}
+
+void LocalPartition::maybeAddWriter() {
+  if (numWriters_ == numPartitions_ ||
+      processedBytes_ < numWriters_ * scaleWriterMinProcessedBytes_) {
+    return;
+  }
+  const auto& memoryManager = queues_[0]->memoryManager();
+  if (memoryManager->bufferedBytes() * 2 < memoryManager->maxBufferSize()) {
+    return;
+  }
+  ++numWriters_;
+}
+
 void LocalPartition::addInput(RowVectorPtr input) {
+  const auto inputBytes = input->estimateFlatSize();
   {
     auto lockedStats = stats_.wlock();
-    lockedStats->addOutputVector(input->estimateFlatSize(), input->size());
+    lockedStats->addOutputVector(inputBytes, input->size());
   }
 
   // Lazy vectors must be loaded or processed.
@@ -306,26 +366,29 @@ void LocalPartition::addInput(RowVectorPtr input) {
     child->loadedVector();
   }
 
+  std::optional<uint32_t> singlePartition;
+  if (outputKeyHashes_) {
+    singlePartition = partitionFunction_->partition(*input, partitions_);
+    input = addKeyHashes(input);
+  }
+
   if (numPartitions_ == 1) {
-    ContinueFuture future;
-    auto blockingReason = queues_[0]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(*queues_[0], input);
+    return;
+  }
+
+  if (scaleWriter_) {
+    maybeAddWriter();
+    enqueue(*queues_[nextWriter_++ % numWriters_], input);
+    processedBytes_ += inputBytes;
     return;
   }
 
-  const auto singlePartition =
-      partitionFunction_->partition(*input, partitions_);
+  if (!outputKeyHashes_) {
+    singlePartition = partitionFunction_->partition(*input, partitions_);
+  }
   if (singlePartition.has_value()) {
-    ContinueFuture future;
-    auto blockingReason =
-        queues_[singlePartition.value()]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(*queues_[singlePartition.value()], input);
     return;
   }
 
@@ -350,15 +413,9 @@ void LocalPartition::addInput(RowVectorPtr input) {
       // Do not enqueue empty partitions.
       continue;
     }
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
-
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(
+        *queues_[i],
+        wrapChildren(input, partitionSize, std::move(indexBuffers[i])));
   }
 }
 
@@ -376,6 +433,10 @@ BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
 
 void LocalPartition::noMoreInput() {
   Operator::noMoreInput();
+  if (scaleWriter_) {
+    stats_.wlock()->addRuntimeStat(
+        "scaledWriters", RuntimeCounter(numWriters_));
+  }
   for (const auto& queue : queues_) {
     queue->noMoreData();
   }
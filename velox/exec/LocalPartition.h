@@ -21,7 +21,9 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is updated without a lock while it is below
+/// the limit. The mutex is taken only to add or fulfill the promises of the
+/// blocked producers.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -36,10 +38,22 @@ class LocalExchangeMemoryManager {
   /// caller to fulfill.
   std::vector<ContinuePromise> decreaseMemoryUsage(int64_t removed);
 
+  int64_t bufferedBytes() const {
+    return bufferedBytes_;
+  }
+
+  int64_t maxBufferSize() const {
+    return maxBufferSize_;
+  }
+
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. Set before 'bufferedBytes_' is
+  // checked under 'mutex_' so that a concurrent decrease either sees the flag
+  // or is seen by the check.
+  std::atomic<bool> hasPromises_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -48,7 +62,8 @@ class LocalExchangeMemoryManager {
 /// producer must be registered with a call to 'addProducer'. 'noMoreProducers'
 /// must be called after all producers have been registered. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
-/// Consumers call 'next' repeatedly to fetch the data.
+/// Consumers call 'next' repeatedly to fetch the data. Each added batch wakes
+/// up one waiting consumer.
 class LocalExchangeQueue {
  public:
   LocalExchangeQueue(
@@ -60,6 +75,10 @@ class LocalExchangeQueue {
     return fmt::format("LocalExchangeQueue({})", partition_);
   }
 
+  const std::shared_ptr<LocalExchangeMemoryManager>& memoryManager() const {
+    return memoryManager_;
+  }
+
   void addProducer();
 
   void noMoreProducers();
@@ -89,14 +108,21 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // A batch of data and its estimated flat size, computed once by the
+  // producer.
+  struct Entry {
+    RowVectorPtr data;
+    int64_t bytes;
+  };
+
+  bool isFinishedLocked(const std::queue<Entry>& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<std::queue<Entry>, std::mutex> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
-  // and pendingProducers_ is zero.
+  // and pendingProducers_ is zero. Adding data satisfies only one.
   std::vector<ContinuePromise> consumerPromises_;
   int pendingProducers_{0};
   bool noMoreProducers_{false};
@@ -141,7 +167,10 @@ class LocalExchange : public SourceOperator {
 };
 
 /// Hash partitions the data using specified keys. The number of partitions is
-/// determined by the number of LocalExchangeQueues(s) found in the task.
+/// determined by the number of LocalExchangeQueues(s) found in the task. If
+/// the plan node is a scale writer partitioning, sends each input to one of
+/// the first 'numWriters_' partitions in turn and adds a partition when the
+/// consumers fall behind.
 class LocalPartition : public Operator {
  public:
   LocalPartition(
@@ -172,10 +201,28 @@ class LocalPartition : public Operator {
   bool isFinished() override;
 
  private:
+  void enqueue(LocalExchangeQueue& queue, RowVectorPtr data);
+
+  // Returns 'input' with the key hashes of the last partitioning appended.
+  RowVectorPtr addKeyHashes(const RowVectorPtr& input);
+
+  // Adds a writer if the writers have received at least
+  // 'scaleWriterMinProcessedBytes_' each and the local exchange buffer is at
+  // least half full.
+  void maybeAddWriter();
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
 
+  const bool scaleWriter_;
+  const bool outputKeyHashes_;
+  const uint64_t scaleWriterMinProcessedBytes_;
+  // Number of partitions that receive input if 'scaleWriter_' is true.
+  size_t numWriters_{1};
+  size_t nextWriter_{0};
+  uint64_t processedBytes_{0};
+
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
 
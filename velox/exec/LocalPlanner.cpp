@@ -306,6 +306,37 @@ void LocalPlanner::plan(
   }
 }
 
+// static
+std::shared_ptr<const PreparedPlanFragment> PreparedPlanFragment::create(
+    core::PlanFragment planFragment,
+    const core::QueryConfig& queryConfig,
+    uint32_t maxDrivers) {
+  std::shared_ptr<PreparedPlanFragment> prepared(
+      new PreparedPlanFragment(std::move(planFragment), maxDrivers));
+  LocalPlanner::plan(
+      prepared->planFragment_,
+      nullptr,
+      &prepared->driverFactories_,
+      queryConfig,
+      maxDrivers);
+  return prepared;
+}
+
+std::vector<std::unique_ptr<DriverFactory>>
+PreparedPlanFragment::makeDriverFactories(
+    ConsumerSupplier consumerSupplier) const {
+  std::vector<std::unique_ptr<DriverFactory>> driverFactories;
+  driverFactories.reserve(driverFactories_.size());
+  for (const auto& factory : driverFactories_) {
+    driverFactories.push_back(std::make_unique<DriverFactory>(*factory));
+  }
+  // The output pipeline is planned first.
+  VELOX_CHECK(driverFactories[0]->outputDriver);
+  driverFactories[0]->consumerSupplier =
+      detail::makeConsumerSupplier(std::move(consumerSupplier));
+  return driverFactories;
+}
+
 // static
 void LocalPlanner::determineGroupedExecutionPipelines(
     const core::PlanFragment& planFragment,
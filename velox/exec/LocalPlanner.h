@@ -15,12 +15,9 @@
  */
 #pragma once
 
+#include "velox/core/PlanFragment.h"
 #include "velox/exec/Operator.h"
 
-namespace facebook::velox::core {
-struct PlanFragment;
-} // namespace facebook::velox::core
-
 namespace facebook::velox::exec {
 
 class LocalPlanner {
@@ -44,4 +41,41 @@ class LocalPlanner {
   static void markMixedJoinBridges(
       std::vector<std::unique_ptr<DriverFactory>>& driverFactories);
 };
+
+/// A plan fragment that is planned into driver factories once and then
+/// instantiated into any number of Tasks. Avoids re-planning the fragment for
+/// each Task of a high QPS query shape, e.g. a point lookup that runs the same
+/// fragment with different splits. The Tasks must use a QueryConfig that is
+/// equivalent to the one passed to create() for planning. Thread safe.
+class PreparedPlanFragment {
+ public:
+  static std::shared_ptr<const PreparedPlanFragment> create(
+      core::PlanFragment planFragment,
+      const core::QueryConfig& queryConfig,
+      uint32_t maxDrivers);
+
+  const core::PlanFragment& planFragment() const {
+    return planFragment_;
+  }
+
+  /// Max number of drivers per pipeline the fragment is planned for.
+  uint32_t maxDrivers() const {
+    return maxDrivers_;
+  }
+
+  /// Returns copies of the planned driver factories whose output pipeline
+  /// passes its results to 'consumerSupplier'.
+  std::vector<std::unique_ptr<DriverFactory>> makeDriverFactories(
+      ConsumerSupplier consumerSupplier) const;
+
+ private:
+  PreparedPlanFragment(core::PlanFragment planFragment, uint32_t maxDrivers)
+      : planFragment_(std::move(planFragment)), maxDrivers_(maxDrivers) {}
+
+  const core::PlanFragment planFragment_;
+  const uint32_t maxDrivers_;
+  // Planned without a consumer. makeDriverFactories() sets the consumer of
+  // the output pipeline.
+  std::vector<std::unique_ptr<DriverFactory>> driverFactories_;
+};
 } // namespace facebook::velox::exec
@@ -43,21 +43,64 @@ MarkDistinct::MarkDistinct(
   // We will use result[0] for distinct mask output.
   resultProjections_.emplace_back(0, inputType->size());
 
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+  if (planNode->isPreGrouped()) {
+    for (const auto& key : planNode->distinctKeys()) {
+      preGroupedKeys_.push_back(exprToChannel(key.get(), inputType));
+    }
+  } else {
+    groupingSet_ = GroupingSet::createForMarkDistinct(
+        inputType,
+        createVectorHashers(inputType, planNode->distinctKeys()),
+        operatorCtx_.get(),
+        &nonReclaimableSection_);
+  }
 
   results_.resize(1);
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  if (groupingSet_ != nullptr) {
+    groupingSet_->addInput(input, false /*mayPushdown*/);
+  }
 
   input_ = std::move(input);
 }
 
+bool MarkDistinct::equalKeys(
+    vector_size_t row,
+    const RowVector& other,
+    vector_size_t otherRow) const {
+  for (auto key : preGroupedKeys_) {
+    if (!input_->childAt(key)->loadedVector()->equalValueAt(
+            other.childAt(key)->loadedVector(), row, otherRow)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MarkDistinct::markPreGrouped(uint64_t* resultBits) {
+  const auto numRows = input_->size();
+  if (numRows == 0) {
+    return;
+  }
+  bits::setBit(
+      resultBits, 0, lastRow_ == nullptr || !equalKeys(0, *lastRow_, 0));
+  for (auto row = 1; row < numRows; ++row) {
+    bits::setBit(resultBits, row, !equalKeys(row, *input_, row - 1));
+  }
+
+  // Copies the keys of the last row so that 'input_' can be released.
+  if (lastRow_ == nullptr) {
+    lastRow_ = BaseVector::create<RowVector>(
+        input_->type(), 1, operatorCtx_->pool());
+  }
+  for (auto key : preGroupedKeys_) {
+    lastRow_->childAt(key)->copy(
+        input_->childAt(key)->loadedVector(), 0, numRows - 1, 1);
+  }
+}
+
 RowVectorPtr MarkDistinct::getOutput() {
   if (isFinished() || !input_) {
     return nullptr;
@@ -79,8 +122,12 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
-    bits::setBit(resultBits, i, true);
+  if (groupingSet_ == nullptr) {
+    markPreGrouped(resultBits);
+  } else {
+    for (const auto i : groupingSet_->hashLookup().newGroups) {
+      bits::setBit(resultBits, i, true);
+    }
   }
   auto output = fillOutput(outputSize, nullptr);
 
@@ -21,6 +21,10 @@
 
 namespace facebook::velox::exec {
 
+/// Adds a boolean column that is true for the first row with each combination
+/// of the distinct keys. Keeps the distinct keys in a hash table, unless the
+/// input is clustered on the keys, in which case each row is compared with the
+/// previous row.
 class MarkDistinct : public Operator {
  public:
   MarkDistinct(
@@ -47,7 +51,24 @@ class MarkDistinct : public Operator {
   bool isFinished() override;
 
  private:
+  // Sets the bits of the rows of 'input_' that start a new run of equal keys.
+  void markPreGrouped(uint64_t* resultBits);
+
+  // True if the keys of 'input_' at 'row' equal the keys of 'other' at
+  // 'otherRow'.
+  bool equalKeys(
+      vector_size_t row,
+      const RowVector& other,
+      vector_size_t otherRow) const;
+
   // TODO: Document spilling configuration in spilling.rst.
   std::unique_ptr<GroupingSet> groupingSet_;
+
+  // Channels of the distinct keys if the input is clustered on them.
+  std::vector<column_index_t> preGroupedKeys_;
+
+  // Single row with the input columns of the last row of the previous input.
+  // Only the key columns are set.
+  RowVectorPtr lastRow_;
 };
 } // namespace facebook::velox::exec
@@ -228,9 +228,16 @@ void SourceStream::copyToOutput(RowVectorPtr& output) {
   outputRows_.applyToSelected(
       [&](auto row) { sourceRows_[row] = sourceRow++; });
 
+  // If all rows of 'data_' fill 'output' in order, the copy refers to the
+  // buffers of 'data_' without copying them.
+  const bool identity = firstSourceRow_ == 0 &&
+      outputRows_.isAllSelected() && outputRows_.end() == output->size() &&
+      data_->size() == output->size();
   for (auto i = 0; i < output->type()->size(); ++i) {
     output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
+        data_->childAt(i).get(),
+        outputRows_,
+        identity ? nullptr : sourceRows_.data());
   }
 
   outputRows_.clearAll();
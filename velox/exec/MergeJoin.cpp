@@ -191,6 +191,89 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+namespace {
+// Returns the first row in [start, end) of 'vector' with a value different
+// from row 'index' of 'other', or std::nullopt if the values can not be
+// compared directly. Checks blocks of rows without branching so that the
+// comparisons of a block can be vectorized.
+template <TypeKind Kind>
+std::optional<vector_size_t> findEndOfEqualValues(
+    const BaseVector& vector,
+    vector_size_t start,
+    vector_size_t end,
+    const BaseVector& other,
+    vector_size_t index) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  if constexpr (
+      (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+      std::is_same_v<T, StringView>) {
+    if (!vector.isFlatEncoding() || vector.mayHaveNulls() ||
+        !other.isFlatEncoding() || other.isNullAt(index)) {
+      return std::nullopt;
+    }
+    const auto* values = vector.asUnchecked<FlatVector<T>>()->rawValues();
+    const T value = other.asUnchecked<FlatVector<T>>()->valueAt(index);
+
+    constexpr vector_size_t kBlockSize = 32;
+    auto row = start;
+    for (; row + kBlockSize <= end; row += kBlockSize) {
+      bool allEqual = true;
+      for (auto i = 0; i < kBlockSize; ++i) {
+        allEqual &= values[row + i] == value;
+      }
+      if (!allEqual) {
+        break;
+      }
+    }
+    for (; row < end; ++row) {
+      if (values[row] != value) {
+        return row;
+      }
+    }
+    return end;
+  } else {
+    return std::nullopt;
+  }
+}
+} // namespace
+
+// static
+vector_size_t MergeJoin::findEndOfRun(
+    const std::vector<column_index_t>& keys,
+    const RowVectorPtr& batch,
+    vector_size_t start,
+    const RowVectorPtr& other,
+    vector_size_t index) {
+  // The run ends at the first row where any of the keys differs, so each key
+  // column only needs to be checked up to the end found for the previous
+  // keys.
+  auto end = batch->size();
+  for (auto i = 0; i < keys.size() && end > start; ++i) {
+    const auto& vector = *batch->childAt(keys[i]);
+    const auto& otherVector = *other->childAt(keys[i]);
+    std::optional<vector_size_t> keyEnd;
+    if (vector.type()->isPrimitiveType()) {
+      keyEnd = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          findEndOfEqualValues,
+          vector.typeKind(),
+          vector,
+          start,
+          end,
+          otherVector,
+          index);
+    }
+    if (!keyEnd.has_value()) {
+      auto row = start;
+      while (row < end && vector.compare(&otherVector, row, index) == 0) {
+        ++row;
+      }
+      keyEnd = row;
+    }
+    end = keyEnd.value();
+  }
+  return end;
+}
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -204,11 +287,7 @@ bool MergeJoin::findEndOfMatch(
 
   auto numInput = input->size();
 
-  vector_size_t endIndex = 0;
-  while (endIndex < numInput &&
-         compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
-    ++endIndex;
-  }
+  const auto endIndex = findEndOfRun(keys, input, 0, prevInput, prevIndex);
 
   if (endIndex == numInput) {
     // Inputs are kept past getting a new batch of inputs. LazyVectors
@@ -243,9 +322,105 @@ void copyRow(
 }
 } // namespace
 
+bool MergeJoin::addOutputReference(
+    const RowVectorPtr& left,
+    vector_size_t leftIndex,
+    const RowVectorPtr& right,
+    vector_size_t rightIndex) {
+  if (outputSize_ == 0) {
+    outputLeft_ = left;
+  }
+  if (left != outputLeft_ ||
+      (right != nullptr && outputRight_ != nullptr && right != outputRight_)) {
+    // The output continues with rows from another batch of input. Copy the
+    // rows so far and copy the rest of the output as well.
+    copyOutputReferences();
+    return false;
+  }
+
+  rawLeftOutputIndices_[outputSize_] = leftIndex;
+  if (right == nullptr) {
+    if (rightOutputNulls_ == nullptr) {
+      rightOutputNulls_ = allocateNulls(outputBatchSize_, pool());
+      rawRightOutputNulls_ = rightOutputNulls_->asMutable<uint64_t>();
+    }
+    bits::setNull(rawRightOutputNulls_, outputSize_);
+    rawRightOutputIndices_[outputSize_] = 0;
+  } else {
+    outputRight_ = right;
+    rawRightOutputIndices_[outputSize_] = rightIndex;
+  }
+  ++outputSize_;
+  return true;
+}
+
+std::vector<VectorPtr> MergeJoin::wrapOutputReferences() {
+  std::vector<VectorPtr> columns(outputType_->size());
+  if (outputSize_ == 0) {
+    for (auto i = 0; i < outputType_->size(); ++i) {
+      columns[i] = BaseVector::create(outputType_->childAt(i), 0, pool());
+    }
+    return columns;
+  }
+
+  for (const auto& projection : leftProjections_) {
+    columns[projection.outputChannel] = BaseVector::wrapInDictionary(
+        nullptr,
+        leftOutputIndices_,
+        outputSize_,
+        BaseVector::loadedVectorShared(
+            outputLeft_->childAt(projection.inputChannel)));
+  }
+  for (const auto& projection : rightProjections_) {
+    if (outputRight_ == nullptr) {
+      // All rows are left-side rows without a match.
+      columns[projection.outputChannel] = BaseVector::createNullConstant(
+          outputType_->childAt(projection.outputChannel), outputSize_, pool());
+      continue;
+    }
+    columns[projection.outputChannel] = BaseVector::wrapInDictionary(
+        rightOutputNulls_,
+        rightOutputIndices_,
+        outputSize_,
+        BaseVector::loadedVectorShared(
+            outputRight_->childAt(projection.inputChannel)));
+  }
+  return columns;
+}
+
+void MergeJoin::copyOutputReferences() {
+  auto references = wrapOutputReferences();
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto column =
+        BaseVector::create(outputType_->childAt(i), outputBatchSize_, pool());
+    column->copy(references[i].get(), 0, 0, outputSize_);
+    output_->childAt(i) = std::move(column);
+  }
+  outputByReference_ = false;
+  outputLeft_ = nullptr;
+  outputRight_ = nullptr;
+}
+
+RowVectorPtr MergeJoin::finishOutput() {
+  if (outputByReference_) {
+    output_ = std::make_shared<RowVector>(
+        pool(), outputType_, nullptr, outputSize_, wrapOutputReferences());
+    outputByReference_ = false;
+    outputLeft_ = nullptr;
+    outputRight_ = nullptr;
+  } else {
+    output_->resize(outputSize_);
+  }
+  return std::move(output_);
+}
+
 void MergeJoin::addOutputRowForLeftJoin(
     const RowVectorPtr& left,
     vector_size_t leftIndex) {
+  if (outputByReference_ && addOutputReference(left, leftIndex, nullptr, 0)) {
+    return;
+  }
+
   copyRow(left, leftIndex, output_, outputSize_, leftProjections_);
 
   for (const auto& projection : rightProjections_) {
@@ -266,6 +441,11 @@ void MergeJoin::addOutputRow(
     vector_size_t leftIndex,
     const RowVectorPtr& right,
     vector_size_t rightIndex) {
+  if (outputByReference_ &&
+      addOutputReference(left, leftIndex, right, rightIndex)) {
+    return;
+  }
+
   copyRow(left, leftIndex, output_, outputSize_, leftProjections_);
   copyRow(right, rightIndex, output_, outputSize_, rightProjections_);
 
@@ -285,9 +465,21 @@ void MergeJoin::addOutputRow(
 void MergeJoin::prepareOutput() {
   if (output_ == nullptr) {
     std::vector<VectorPtr> localColumns(outputType_->size());
-    for (auto i = 0; i < outputType_->size(); ++i) {
-      localColumns[i] = BaseVector::create(
-          outputType_->childAt(i), outputBatchSize_, operatorCtx_->pool());
+    // Without a filter, the output rows are recorded as indices into the
+    // input and the columns are allocated only if the rows must be copied.
+    outputByReference_ = filter_ == nullptr;
+    if (outputByReference_) {
+      leftOutputIndices_ = allocateIndices(outputBatchSize_, pool());
+      rawLeftOutputIndices_ = leftOutputIndices_->asMutable<vector_size_t>();
+      rightOutputIndices_ = allocateIndices(outputBatchSize_, pool());
+      rawRightOutputIndices_ = rightOutputIndices_->asMutable<vector_size_t>();
+      rightOutputNulls_ = nullptr;
+      rawRightOutputNulls_ = nullptr;
+    } else {
+      for (auto i = 0; i < outputType_->size(); ++i) {
+        localColumns[i] = BaseVector::create(
+            outputType_->childAt(i), outputBatchSize_, operatorCtx_->pool());
+      }
     }
 
     output_ = std::make_shared<RowVector>(
@@ -491,7 +683,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
     // Not all rows from the last match fit in the output. Continue producing
     // results from the current match.
     if (addToOutput()) {
-      return std::move(output_);
+      return finishOutput();
     }
   }
 
@@ -546,7 +738,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
     VELOX_CHECK(rightMatch_ && rightMatch_->complete);
 
     if (addToOutput()) {
-      return std::move(output_);
+      return finishOutput();
     }
   }
 
@@ -556,7 +748,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         prepareOutput();
         while (true) {
           if (outputSize_ == outputBatchSize_) {
-            return std::move(output_);
+            return finishOutput();
           }
 
           addOutputRowForLeftJoin(input_, index_);
@@ -571,14 +763,12 @@ RowVectorPtr MergeJoin::doGetOutput() {
       }
 
       if (noMoreInput_ && output_) {
-        output_->resize(outputSize_);
-        return std::move(output_);
+        return finishOutput();
       }
     } else {
       if (noMoreInput_ || noMoreRightInput_) {
         if (output_) {
-          output_->resize(outputSize_);
-          return std::move(output_);
+          return finishOutput();
         }
         input_ = nullptr;
       }
@@ -598,7 +788,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         prepareOutput();
 
         if (outputSize_ == outputBatchSize_) {
-          return std::move(output_);
+          return finishOutput();
         }
 
         addOutputRowForLeftJoin(input_, index_);
@@ -627,10 +817,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
     if (compareResult == 0) {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
-      vector_size_t endIndex = index_ + 1;
-      while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
-        ++endIndex;
-      }
+      const auto endIndex =
+          findEndOfRun(leftKeys_, input_, index_ + 1, input_, index_);
 
       if (endIndex == input_->size()) {
         // Matches continue in subsequent input. Load all lazies.
@@ -639,11 +827,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
       leftMatch_ = Match{
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
-      vector_size_t endRightIndex = rightIndex_ + 1;
-      while (endRightIndex < rightInput_->size() &&
-             compareRight(endRightIndex) == 0) {
-        ++endRightIndex;
-      }
+      const auto endRightIndex = findEndOfRun(
+          rightKeys_, rightInput_, rightIndex_ + 1, rightInput_, rightIndex_);
 
       rightMatch_ = Match{
           {rightInput_},
@@ -673,7 +858,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
       }
 
       if (addToOutput()) {
-        return std::move(output_);
+        return finishOutput();
       }
 
       if (!rightInput_) {
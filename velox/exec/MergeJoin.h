@@ -69,16 +69,17 @@ class MergeJoin : public Operator {
         leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
   }
 
-  // Compare two rows on the left: index_ and index.
-  int32_t compareLeft(vector_size_t index) const {
-    return compare(leftKeys_, input_, index_, leftKeys_, input_, index);
-  }
-
-  // Compare two rows on the right: rightIndex_ and index.
-  int32_t compareRight(vector_size_t index) const {
-    return compare(
-        rightKeys_, rightInput_, rightIndex_, rightKeys_, rightInput_, index);
-  }
+  // Returns the first row at or after 'start' in 'batch' with keys different
+  // from the keys of row 'index' of 'other'. 'other' may be 'batch'. Key
+  // columns that are flat without nulls and of integer or string type are
+  // compared a column at a time over blocks of rows. Other key columns are
+  // compared row by row.
+  static vector_size_t findEndOfRun(
+      const std::vector<column_index_t>& keys,
+      const RowVectorPtr& batch,
+      vector_size_t start,
+      const RowVectorPtr& other,
+      vector_size_t index);
 
   // Compare two rows from the left side.
   int32_t compareLeft(
@@ -165,18 +166,37 @@ class MergeJoin : public Operator {
   bool addToOutput();
 
   // Adds one row of output by copying values from left and right batches at the
-  // specified rows. Advances outputSize_. Assumes that output_ has room.
-  //
-  // TODO: Copying is inefficient especially for complex type values. Consider
-  // an optimization of using dictionary wrapping when full batch of output can
-  // be produced using single batch of input from the left side and single batch
-  // of input from the right side.
+  // specified rows or, if 'outputByReference_', by recording the rows in
+  // 'leftOutputIndices_' and 'rightOutputIndices_'. Advances outputSize_.
+  // Assumes that output_ has room.
   void addOutputRow(
       const RowVectorPtr& left,
       vector_size_t leftIndex,
       const RowVectorPtr& right,
       vector_size_t rightIndex);
 
+  // Records the output row made of 'leftIndex' row of 'left' and 'rightIndex'
+  // row of 'right', with nulls for the right side if 'right' is nullptr.
+  // Returns false if 'left' or 'right' is not the batch the previous rows of
+  // output refer to. In that case the previous rows are copied to output_ and
+  // the rest of output_ is filled by copying.
+  bool addOutputReference(
+      const RowVectorPtr& left,
+      vector_size_t leftIndex,
+      const RowVectorPtr& right,
+      vector_size_t rightIndex);
+
+  // Returns the output columns for the recorded output rows as dictionaries
+  // over the columns of 'outputLeft_' and 'outputRight_'.
+  std::vector<VectorPtr> wrapOutputReferences();
+
+  // Copies the recorded output rows to newly allocated columns of output_
+  // and stops recording rows for the current batch of output.
+  void copyOutputReferences();
+
+  // Returns output_ with outputSize_ rows and resets it.
+  RowVectorPtr finishOutput();
+
   /// Adds one row of output for a left-side row with no right-side match.
   /// Copies values from the 'leftIndex' row of 'left' and fills in nulls
   /// for columns that correspond to the right side.
@@ -403,6 +423,31 @@ class MergeJoin : public Operator {
   // Number of rows accumulated in the output_.
   vector_size_t outputSize_;
 
+  // True if the rows of output_ are recorded as indices into 'outputLeft_'
+  // and 'outputRight_' instead of being copied. The output is then produced
+  // by wrapping the input columns in dictionaries. Set when there is no
+  // filter and cleared for the rest of the batch as soon as an output row
+  // comes from another batch of input.
+  bool outputByReference_{false};
+
+  // The single batches of left and right input the recorded output rows
+  // refer to. 'outputRight_' is nullptr if all recorded rows are left-side
+  // rows without a match.
+  RowVectorPtr outputLeft_;
+  RowVectorPtr outputRight_;
+
+  // Row numbers in 'outputLeft_' and 'outputRight_' for each recorded output
+  // row.
+  BufferPtr leftOutputIndices_;
+  vector_size_t* rawLeftOutputIndices_{nullptr};
+  BufferPtr rightOutputIndices_;
+  vector_size_t* rawRightOutputIndices_{nullptr};
+
+  // Nulls for the right-side columns of recorded rows without a match.
+  // Allocated on first use.
+  BufferPtr rightOutputNulls_;
+  uint64_t* rawRightOutputNulls_{nullptr};
+
   // A future that will be completed when right side input becomes available.
   ContinueFuture futureRightSideInput_{ContinueFuture::makeEmpty()};
 
@@ -18,6 +18,138 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+bool isRangeComparable(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the range for 'probe OP build' if 'probe' is a column of
+// 'probeType' and 'build' a column of 'buildType'. 'op' is one of "lt",
+// "lte", "gt" and "gte".
+std::optional<NestedLoopJoinRange> makeRange(
+    const std::string& op,
+    const core::TypedExprPtr& probe,
+    const core::TypedExprPtr& build,
+    const RowType& probeType,
+    const RowType& buildType) {
+  auto* probeField =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(probe.get());
+  auto* buildField =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(build.get());
+  if (probeField == nullptr || buildField == nullptr ||
+      !probeField->isInputColumn() || !buildField->isInputColumn()) {
+    return std::nullopt;
+  }
+  const auto probeChannel = probeType.getChildIdxIfExists(probeField->name());
+  const auto buildChannel = buildType.getChildIdxIfExists(buildField->name());
+  if (!probeChannel.has_value() || !buildChannel.has_value()) {
+    return std::nullopt;
+  }
+  const auto& type = probeType.childAt(probeChannel.value());
+  if (!isRangeComparable(type) ||
+      !type->equivalent(*buildType.childAt(buildChannel.value()))) {
+    return std::nullopt;
+  }
+  return NestedLoopJoinRange{
+      probeChannel.value(),
+      buildChannel.value(),
+      op == "gt" || op == "gte",
+      op == "lte" || op == "gte"};
+}
+
+std::optional<NestedLoopJoinRange> findRange(
+    const core::TypedExprPtr& expr,
+    const RowType& probeType,
+    const RowType& buildType) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return std::nullopt;
+  }
+  const auto& name = call->name();
+  const auto& inputs = call->inputs();
+  if (name == "and") {
+    for (const auto& input : inputs) {
+      if (auto range = findRange(input, probeType, buildType)) {
+        return range;
+      }
+    }
+    return std::nullopt;
+  }
+  if (name == "between" && inputs.size() == 3) {
+    // p BETWEEN b AND c accepts build values of b up to p.
+    return makeRange("gte", inputs[0], inputs[1], probeType, buildType);
+  }
+  static const std::unordered_map<std::string, std::string> kReversed = {
+      {"lt", "gt"}, {"lte", "gte"}, {"gt", "lt"}, {"gte", "lte"}};
+  auto it = kReversed.find(name);
+  if (it == kReversed.end() || inputs.size() != 2) {
+    return std::nullopt;
+  }
+  if (auto range =
+          makeRange(name, inputs[0], inputs[1], probeType, buildType)) {
+    return range;
+  }
+  return makeRange(it->second, inputs[1], inputs[0], probeType, buildType);
+}
+
+// Returns the rows of 'vectors' in a single vector sorted on 'channel' with
+// nulls last.
+RowVectorPtr sortOnChannel(
+    const std::vector<RowVectorPtr>& vectors,
+    column_index_t channel,
+    memory::MemoryPool* pool) {
+  std::vector<std::pair<int32_t, vector_size_t>> rows;
+  for (auto i = 0; i < vectors.size(); ++i) {
+    for (auto row = 0; row < vectors[i]->size(); ++row) {
+      rows.emplace_back(i, row);
+    }
+  }
+  const CompareFlags flags{false, true};
+  std::stable_sort(rows.begin(), rows.end(), [&](auto left, auto right) {
+    return vectors[left.first]
+               ->childAt(channel)
+               ->compare(
+                   vectors[right.first]->childAt(channel).get(),
+                   left.second,
+                   right.second,
+                   flags)
+               .value() < 0;
+  });
+
+  auto sorted = BaseVector::create<RowVector>(
+      vectors[0]->type(), rows.size(), pool);
+  for (auto i = 0; i < rows.size(); ++i) {
+    sorted->copy(vectors[rows[i].first].get(), i, rows[i].second, 1);
+  }
+  return sorted;
+}
+} // namespace
+
+std::optional<NestedLoopJoinRange> findNestedLoopJoinRange(
+    const core::NestedLoopJoinNode& joinNode) {
+  const auto joinType = joinNode.joinType();
+  if (joinNode.joinCondition() == nullptr || isRightJoin(joinType) ||
+      isFullJoin(joinType)) {
+    return std::nullopt;
+  }
+  return findRange(
+      joinNode.joinCondition(),
+      *joinNode.sources()[0]->outputType(),
+      *joinNode.sources()[1]->outputType());
+}
+
 void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
   std::vector<ContinuePromise> promises;
   {
@@ -50,7 +182,8 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      range_(findNestedLoopJoinRange(*joinNode)) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -105,6 +238,10 @@ void NestedLoopJoinBuild::noMoreInput() {
     }
   }
 
+  if (range_.has_value() && !dataVectors_.empty()) {
+    dataVectors_ = {sortOnChannel(dataVectors_, range_->buildChannel, pool())};
+  }
+
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
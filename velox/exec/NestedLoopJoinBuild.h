@@ -20,6 +20,34 @@
 
 namespace facebook::velox::exec {
 
+/// A conjunct of a nested loop join condition that compares a probe-side
+/// column with a build-side column, e.g. 'p >= b' or 'p BETWEEN b AND c'.
+/// The build side is then sorted on the build-side column so that the build
+/// rows that can satisfy the condition for a probe row are a range found by
+/// binary search. The join condition is still evaluated on these rows.
+struct NestedLoopJoinRange {
+  /// Channel of the compared column in the probe-side input.
+  column_index_t probeChannel;
+
+  /// Channel of the compared column in the build-side input.
+  column_index_t buildChannel;
+
+  /// True if the conjunct accepts build values below the probe value, false
+  /// if it accepts build values above the probe value.
+  bool buildBelowProbe;
+
+  /// True if the conjunct also accepts a build value equal to the probe
+  /// value.
+  bool inclusive;
+};
+
+/// Returns the range conjunct used to narrow the build rows for each probe
+/// row of 'joinNode' or std::nullopt if the join condition has none. Only
+/// used for joins that do not return build-side mismatches. The compared
+/// columns must be of the same integer, date, timestamp or string type.
+std::optional<NestedLoopJoinRange> findNestedLoopJoinRange(
+    const core::NestedLoopJoinNode& joinNode);
+
 class NestedLoopJoinBridge : public JoinBridge {
  public:
   void setData(std::vector<RowVectorPtr> buildVectors);
@@ -59,6 +87,9 @@ class NestedLoopJoinBuild : public Operator {
   }
 
  private:
+  // Set if the build side is sorted for a range join.
+  const std::optional<NestedLoopJoinRange> range_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
@@ -56,7 +56,8 @@ NestedLoopJoinProbe::NestedLoopJoinProbe(
           "NestedLoopJoinProbe"),
       outputBatchSize_{outputBatchRows()},
       joinNode_(joinNode),
-      joinType_(joinNode_->joinType()) {
+      joinType_(joinNode_->joinType()),
+      range_(findNestedLoopJoinRange(*joinNode_)) {
   auto probeType = joinNode_->sources()[0]->outputType();
   auto buildType = joinNode_->sources()[1]->outputType();
   identityProjections_ = extractProjections(probeType, outputType_);
@@ -178,6 +179,18 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
+    if (range_.has_value()) {
+      output = doRangeMatch();
+      if (probeRow_ == input_->size()) {
+        probeRow_ = 0;
+        buildIndex_ = buildVectors_->size();
+        if (!needsProbeMismatch(joinType_)) {
+          finishProbeInput();
+        }
+      }
+      continue;
+    }
+
     const vector_size_t probeCnt = getNumProbeRows();
     output = doMatch(probeCnt);
     if (advanceProbeRows(probeCnt)) {
@@ -337,6 +350,15 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   buildVectors_ = std::move(buildData);
   if (buildVectors_->empty()) {
     buildSideEmpty_ = true;
+  } else if (range_.has_value()) {
+    VELOX_CHECK_EQ(buildVectors_->size(), 1);
+    const auto& sorted =
+        buildVectors_->front()->childAt(range_->buildChannel);
+    numNonNullBuildRows_ = sorted->size();
+    while (numNonNullBuildRows_ > 0 &&
+           sorted->isNullAt(numNonNullBuildRows_ - 1)) {
+      --numNonNullBuildRows_;
+    }
   }
   return true;
 }
@@ -437,6 +459,11 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       filterProbeProjections_,
       filterBuildProjections_);
 
+  return evalJoinCondition(filterInput);
+}
+
+RowVectorPtr NestedLoopJoinProbe::evalJoinCondition(
+    const RowVectorPtr& filterInput) {
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
   }
@@ -503,4 +530,84 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       std::move(projectedChildren));
 }
 
+std::pair<vector_size_t, vector_size_t> NestedLoopJoinProbe::findBuildRange(
+    vector_size_t probeRow) const {
+  const auto& probe = input_->childAt(range_->probeChannel);
+  if (probe->isNullAt(probeRow)) {
+    return {0, 0};
+  }
+  const auto& build = buildVectors_->front()->childAt(range_->buildChannel);
+  // Returns the first build row that is above the probe value, or at or above
+  // it if 'skipEqual' is false.
+  auto partitionPoint = [&](bool skipEqual) {
+    vector_size_t low = 0;
+    vector_size_t high = numNonNullBuildRows_;
+    while (low < high) {
+      const auto middle = low + (high - low) / 2;
+      const auto result = build->compare(probe.get(), middle, probeRow);
+      if (result < 0 || (skipEqual && result == 0)) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  };
+  if (range_->buildBelowProbe) {
+    return {0, partitionPoint(range_->inclusive)};
+  }
+  return {partitionPoint(!range_->inclusive), numNonNullBuildRows_};
+}
+
+RowVectorPtr NestedLoopJoinProbe::doRangeMatch() {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, outputBatchSize_, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, outputBatchSize_, pool());
+  vector_size_t numPairs{0};
+  while (probeRow_ < input_->size() && numPairs < outputBatchSize_) {
+    if (rangeRow_ < 0) {
+      std::tie(rangeRow_, rangeEnd_) = findBuildRange(probeRow_);
+    }
+    const auto count = std::min<vector_size_t>(
+        rangeEnd_ - rangeRow_, outputBatchSize_ - numPairs);
+    std::fill(
+        rawProbeIndices.begin() + numPairs,
+        rawProbeIndices.begin() + numPairs + count,
+        probeRow_);
+    std::iota(
+        rawBuildIndices.begin() + numPairs,
+        rawBuildIndices.begin() + numPairs + count,
+        rangeRow_);
+    numPairs += count;
+    rangeRow_ += count;
+    if (rangeRow_ == rangeEnd_) {
+      ++probeRow_;
+      rangeRow_ = -1;
+    }
+  }
+  if (numPairs == 0) {
+    return nullptr;
+  }
+
+  std::vector<VectorPtr> filterChildren(filterInputType_->size());
+  projectChildren(
+      filterChildren, input_, filterProbeProjections_, numPairs, probeIndices_);
+  projectChildren(
+      filterChildren,
+      buildVectors_->front(),
+      filterBuildProjections_,
+      numPairs,
+      buildIndices_);
+  return evalJoinCondition(std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numPairs,
+      std::move(filterChildren)));
+}
+
 } // namespace facebook::velox::exec
@@ -82,6 +82,23 @@ class NestedLoopJoinProbe : public Operator {
   // buildMatched_ accordingly.
   RowVectorPtr doMatch(vector_size_t probeCnt);
 
+  // Evaluates joinCondition against 'filterInput', which pairs the rows of
+  // input_ in 'probeIndices_' with the rows of the build side vector at
+  // 'buildIndex_' in 'buildIndices_'. Returns the pairs that passed and
+  // updates probeMatched_, buildMatched_ accordingly.
+  RowVectorPtr evalJoinCondition(const RowVectorPtr& filterInput);
+
+  // Used instead of doMatch() if 'range_' is set. Pairs the rows of input_
+  // starting at 'probeRow_' with the build rows in their ranges, up to
+  // 'outputBatchSize_' pairs, and evaluates joinCondition on the pairs.
+  // Advances 'probeRow_' past the probe rows whose pairs are all evaluated.
+  RowVectorPtr doRangeMatch();
+
+  // Returns the [begin, end) range of rows of the sorted build side that can
+  // satisfy the range conjunct for 'probeRow' of input_.
+  std::pair<vector_size_t, vector_size_t> findBuildRange(
+      vector_size_t probeRow) const;
+
   // Updates 'probeRow_' and 'buildIndex_' by advancing 'probeRow_' by probeCnt.
   // Returns true if 'buildIndex_' points to the end of 'buildData_'.
   bool advanceProbeRows(vector_size_t probeCnt);
@@ -147,6 +164,16 @@ class NestedLoopJoinProbe : public Operator {
   BufferPtr probeOutMapping_;
   BufferPtr probeIndices_;
 
+  // Set if the build side is a single vector sorted on the build-side column
+  // of a range conjunct of the join condition.
+  const std::optional<NestedLoopJoinRange> range_;
+  // Number of build rows before the rows with null in the sorted column.
+  vector_size_t numNonNullBuildRows_{0};
+  // Next build row and end of the build rows in the range of 'probeRow_'.
+  // 'rangeRow_' is -1 if the range is not found yet.
+  vector_size_t rangeRow_{-1};
+  vector_size_t rangeEnd_{0};
+
   // Build side state
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
   bool buildSideEmpty_{false};
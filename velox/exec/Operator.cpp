@@ -278,6 +278,18 @@ uint32_t Operator::outputBatchRows(
       queryConfig.preferredOutputBatchBytes() / rowSize, 1);
 }
 
+uint32_t Operator::boundedOutputBatchRows(
+    std::optional<uint64_t> averageRowSize) const {
+  const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
+  const uint32_t maxRows = queryConfig.preferredOutputBatchRows();
+  if (!averageRowSize.has_value() || averageRowSize.value() == 0) {
+    return maxRows;
+  }
+  const uint64_t numRows =
+      queryConfig.preferredOutputBatchBytes() / averageRowSize.value();
+  return std::max<uint32_t>(std::min<uint64_t>(numRows, maxRows), 1);
+}
+
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
   uint64_t now =
       std::chrono::duration_cast<std::chrono::microseconds>(
@@ -295,6 +307,24 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+void Operator::recordVectorPoolStats() {
+  auto* execCtx = operatorCtx_->execCtxIfCreated();
+  if (execCtx == nullptr || execCtx->vectorPool() == nullptr) {
+    return;
+  }
+  const auto& poolStats = execCtx->vectorPool()->stats();
+  if (poolStats.numHits == 0 && poolStats.numMisses == 0) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      "vectorPoolHits", RuntimeCounter(poolStats.numHits));
+  lockedStats->addRuntimeStat(
+      "vectorPoolMisses", RuntimeCounter(poolStats.numMisses));
+  lockedStats->addRuntimeStat(
+      "vectorPoolReleased", RuntimeCounter(poolStats.numReleased));
+}
+
 void Operator::recordSpillStats(const common::SpillStats& spillStats) {
   VELOX_CHECK(noMoreInput_);
   auto lockedStats = stats_.wlock();
@@ -368,6 +398,15 @@ void Operator::recordSpillStats(const common::SpillStats& spillStats) {
     common::updateGlobalMaxSpillLevelExceededCount(
         spillStats.spillMaxLevelExceededCount);
   }
+
+  if (spillStats.spillMergeLevels != 0) {
+    lockedStats->addRuntimeStat(
+        "spillMergeLevels",
+        RuntimeCounter{static_cast<int64_t>(spillStats.spillMergeLevels)});
+    lockedStats->addRuntimeStat(
+        "spillMergeRuns",
+        RuntimeCounter{static_cast<int64_t>(spillStats.spillMergeRuns)});
+  }
 }
 
 std::string Operator::toString() const {
@@ -618,6 +657,14 @@ uint64_t Operator::MemoryReclaimer::reclaim(
   }
 
   RuntimeStatWriterScopeGuard opStatsGuard(op_);
+  auto* tracer = driver->task()->queryCtx()->timelineTracer();
+  process::TimelineScope timelineScope(
+      tracer,
+      tracer != nullptr ? fmt::format("{}::reclaim", op_->operatorType()) : "",
+      "spill",
+      tracer != nullptr
+          ? fmt::format("target bytes: {}", succinctBytes(targetBytes))
+          : "");
 
   auto reclaimBytes = memory::MemoryReclaimer::run(
       [&]() {
@@ -25,6 +25,8 @@
 
 namespace facebook::velox::exec {
 
+class SplitResultListener;
+
 // Represents a column that is copied from input to output, possibly
 // with cardinality change, i.e. values removed or duplicated.
 struct IdentityProjection {
@@ -236,6 +238,11 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  /// Returns the ExecCtx if execCtx() has been called, nullptr otherwise.
+  core::ExecCtx* execCtxIfCreated() const {
+    return execCtx_.get();
+  }
+
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
@@ -409,6 +416,52 @@ class Operator : public BaseRuntimeStatWriter {
         toString());
   }
 
+  /// Returns true if this operator would accept the number of rows of its
+  /// output that are used by a downstream Limit.
+  virtual bool canAddLimit() const {
+    return false;
+  }
+
+  /// Tells this operator that at most 'numRows' rows of its output are used.
+  /// Called only if canAddLimit() returns true, before the first call to
+  /// getOutput().
+  virtual void addLimit(uint64_t /*numRows*/) {
+    VELOX_UNSUPPORTED(
+        "This operator doesn't support limit pushdown: {}", toString());
+  }
+
+  /// Returns true if this operator would accept the description of an
+  /// aggregation that directly consumes its output.
+  virtual bool canAddStatisticsAggregation() const {
+    return false;
+  }
+
+  /// Adds the description of an aggregation that directly consumes the output
+  /// of this operator. Called only if canAddStatisticsAggregation() returns
+  /// true, before the first call to getOutput().
+  virtual void addStatisticsAggregation(
+      const std::shared_ptr<const connector::StatisticsAggregation>&
+      /*aggregation*/) {
+    VELOX_UNSUPPORTED(
+        "This operator doesn't support statistics aggregation pushdown: {}",
+        toString());
+  }
+
+  /// Returns true if this operator would tell a consumer of its output where
+  /// its splits start and end.
+  virtual bool canAddSplitResultListener() const {
+    return false;
+  }
+
+  /// Adds a consumer of the output of this operator that keeps its results per
+  /// split. Called only if canAddSplitResultListener() returns true, before the
+  /// first call to getOutput().
+  virtual void addSplitResultListener(SplitResultListener* /*listener*/) {
+    VELOX_UNSUPPORTED(
+        "This operator doesn't support split result listeners: {}",
+        toString());
+  }
+
   /// Returns a list of identify projections, e.g. columns that are projected
   /// as-is possibly after applying a filter.
   const std::vector<IdentityProjection>& identityProjections() const {
@@ -420,6 +473,7 @@ class Operator : public BaseRuntimeStatWriter {
   virtual void close() {
     input_ = nullptr;
     results_.clear();
+    recordVectorPoolStats();
     // Release the unused memory reservation on close.
     operatorCtx_->pool()->release();
   }
@@ -685,9 +739,21 @@ class Operator : public BaseRuntimeStatWriter {
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
+  /// Returns the number of rows for the output batch of an operator whose
+  /// batches are sized by preferredOutputBatchRows. This caps
+  /// preferredOutputBatchRows so that rows of averageRowSize bytes do not
+  /// exceed preferredOutputBatchBytes and returns at least one row. Returns
+  /// preferredOutputBatchRows if the averageRowSize is not given or is 0.
+  uint32_t boundedOutputBatchRows(
+      std::optional<uint64_t> averageRowSize) const;
+
   /// Invoked to record spill stats in operator stats.
   void recordSpillStats(const common::SpillStats& spillStats);
 
+  /// Records the hits, misses and releases of the vector pool of the
+  /// operator's ExecCtx in operator stats. Invoked on close.
+  void recordVectorPoolStats();
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
@@ -373,7 +373,11 @@ void addOperatorRuntimeStats(
   } else {
     VELOX_CHECK_EQ(stats.at(name).unit, value.unit);
   }
-  stats.at(name).addValue(value.value);
+  auto& metric = stats.at(name);
+  if (value.histogram) {
+    metric.enableHistogram();
+  }
+  metric.addValue(value.value);
 }
 
 void aggregateOperatorRuntimeStats(
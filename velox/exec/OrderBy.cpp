@@ -66,7 +66,8 @@ OrderBy::OrderBy(
       pool(),
       &nonReclaimableSection_,
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      operatorCtx_->driverCtx()->queryConfig().orderBySpillMemoryThreshold());
+      operatorCtx_->driverCtx()->queryConfig().orderBySpillMemoryThreshold(),
+      driverCtx->prefixSortConfig());
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -92,6 +93,7 @@ void OrderBy::noMoreInput() {
   sortBuffer_->noMoreInput();
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
   recordSpillStats();
+  recordPrefixSortStats();
 }
 
 RowVectorPtr OrderBy::getOutput() {
@@ -116,4 +118,22 @@ void OrderBy::recordSpillStats() {
     Operator::recordSpillStats(spillStats.value());
   }
 }
+
+void OrderBy::recordPrefixSortStats() {
+  VELOX_CHECK_NOT_NULL(sortBuffer_);
+  const auto prefixSortStats = sortBuffer_->prefixSortStats();
+  if (prefixSortStats.empty()) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      kPrefixSortRows,
+      RuntimeCounter(static_cast<int64_t>(prefixSortStats.numRows)));
+  lockedStats->addRuntimeStat(
+      kPrefixSortHits,
+      RuntimeCounter(static_cast<int64_t>(prefixSortStats.numPrefixHits)));
+  lockedStats->addRuntimeStat(
+      kPrefixSortTies,
+      RuntimeCounter(static_cast<int64_t>(prefixSortStats.numPrefixTies)));
+}
 } // namespace facebook::velox::exec
@@ -62,11 +62,23 @@ class OrderBy : public Operator {
 
   void close() override;
 
+  /// Runtime stat names of the prefix-sort: the number of rows sorted with
+  /// prefix-sort, the number of comparisons decided by the normalized keys and
+  /// the number of comparisons that fell back to compare the rows on equal
+  /// normalized keys.
+  static inline const std::string kPrefixSortRows = "prefixSortRows";
+  static inline const std::string kPrefixSortHits = "prefixSortHits";
+  static inline const std::string kPrefixSortTies = "prefixSortTies";
+
  private:
   // Invoked to record the spilling stats in operator stats after processing all
   // the inputs.
   void recordSpillStats();
 
+  // Invoked to record the prefix-sort stats in operator stats after processing
+  // all the inputs.
+  void recordPrefixSortStats();
+
   std::unique_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
   uint32_t maxOutputRows_;
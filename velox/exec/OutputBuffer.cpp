@@ -15,6 +15,7 @@
  */
 #include "velox/exec/OutputBuffer.h"
 #include "velox/core/QueryConfig.h"
+#include "velox/exec/SpillFile.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -72,26 +73,79 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
+BroadcastSpill::~BroadcastSpill() {
+  files_.clear();
+  for (const auto& path : paths_) {
+    try {
+      filesystems::getFileSystem(path, nullptr)->remove(path);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove broadcast spill file " << path << ": "
+                 << e.what();
+    }
+  }
+}
+
+uint64_t BroadcastSpill::write(
+    const std::vector<std::shared_ptr<SerializedPage>>& pages,
+    const std::string& pathPrefix,
+    const std::string& fileCreateConfig) {
+  auto file =
+      SpillWriteFile::create(paths_.size(), pathPrefix, fileCreateConfig);
+  paths_.push_back(file->path());
+  const int32_t fileIndex = files_.size();
+  uint64_t offset = 0;
+  for (const auto& page : pages) {
+    // Writes the IOBufs of 'page' without copying them into a write buffer.
+    const auto size = file->write(page->getIOBuf());
+    pages_.push_back(
+        {fileIndex,
+         offset,
+         static_cast<int64_t>(size),
+         page->numRows().value()});
+    offset += size;
+  }
+  file->finish();
+  const auto& path = paths_.back();
+  files_.push_back(
+      filesystems::getFileSystem(path, nullptr)->openFileForRead(path));
+  return offset;
+}
+
+std::unique_ptr<folly::IOBuf> BroadcastSpill::read(const Page& page) const {
+  VELOX_CHECK_LT(page.file, files_.size());
+  auto iobuf = folly::IOBuf::create(page.size);
+  files_[page.file]->pread(page.offset, page.size, iobuf->writableData());
+  iobuf->append(page.size);
+  return iobuf;
+}
+
 void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
-  bytesBuffered += data.size();
-  rowsBuffered += numRows.value();
+  recordEnqueue(data.size(), numRows.value());
+}
+
+void DestinationBuffer::Stats::recordEnqueue(int64_t bytes, int64_t rows) {
+  bytesBuffered += bytes;
+  rowsBuffered += rows;
   ++pagesBuffered;
 }
 
 void DestinationBuffer::Stats::recordAcknowledge(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
-  const int64_t size = data.size();
-  bytesBuffered -= size;
+  recordAcknowledge(data.size(), numRows.value());
+}
+
+void DestinationBuffer::Stats::recordAcknowledge(int64_t bytes, int64_t rows) {
+  bytesBuffered -= bytes;
   VELOX_DCHECK_GE(bytesBuffered, 0, "bytesBuffered must be non-negative");
-  rowsBuffered -= numRows.value();
+  rowsBuffered -= rows;
   VELOX_DCHECK_GE(rowsBuffered, 0, "rowsBuffered must be non-negative");
   --pagesBuffered;
   VELOX_DCHECK_GE(pagesBuffered, 0, "pagesBuffered must be non-negative");
-  bytesSent += size;
-  rowsSent += numRows.value();
+  bytesSent += bytes;
+  rowsSent += rows;
   ++pagesSent;
 }
 
@@ -112,7 +166,9 @@ DestinationBuffer::Data DestinationBuffer::getData(
     loadData(arbitraryBuffer, maxBytes);
   }
 
-  if (sequence - sequence_ > data_.size()) {
+  const auto numSpilled = numSpilledLeft();
+  const auto numPages = numSpilled + data_.size();
+  if (sequence - sequence_ > numPages) {
     VLOG(1) << this << " Out of order get: " << sequence << " over "
             << sequence_ << " Setting second notify " << notifySequence_
             << " / " << sequence;
@@ -123,7 +179,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
     return {};
   }
 
-  if (sequence - sequence_ == data_.size()) {
+  if (sequence - sequence_ == numPages) {
     notify_ = std::move(notify);
     aliveCheck_ = std::move(activeCheck);
     notifySequence_ = sequence;
@@ -132,26 +188,39 @@ DestinationBuffer::Data DestinationBuffer::getData(
   }
 
   std::vector<std::unique_ptr<folly::IOBuf>> data;
+  std::vector<int64_t> remainingBytes;
   uint64_t resultBytes = 0;
   auto i = sequence - sequence_;
-  for (; i < data_.size(); ++i) {
-    // nullptr is used as end marker
-    if (data_[i] == nullptr) {
-      VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
-      data.push_back(nullptr);
-      ++i;
-      break;
-    }
-    data.push_back(data_[i]->getIOBuf());
-    resultBytes += data_[i]->size();
+  // The spilled pages come before the pages in 'data_'.
+  for (; i < numSpilled; ++i) {
+    const auto& page = spill_->pages()[nextSpilled_ + i];
     if (resultBytes >= maxBytes) {
-      ++i;
-      break;
+      remainingBytes.push_back(page.size);
+      continue;
+    }
+    data.push_back(spill_->read(page));
+    resultBytes += page.size;
+  }
+  i -= numSpilled;
+  if (resultBytes < maxBytes) {
+    for (; i < data_.size(); ++i) {
+      // nullptr is used as end marker
+      if (data_[i] == nullptr) {
+        VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
+        data.push_back(nullptr);
+        ++i;
+        break;
+      }
+      data.push_back(data_[i]->getIOBuf());
+      resultBytes += data_[i]->size();
+      if (resultBytes >= maxBytes) {
+        ++i;
+        break;
+      }
     }
   }
   bool atEnd = false;
-  std::vector<int64_t> remainingBytes;
-  remainingBytes.reserve(data_.size() - i);
+  remainingBytes.reserve(remainingBytes.size() + data_.size() - i);
   for (; i < data_.size(); ++i) {
     if (data_[i] == nullptr) {
       VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
@@ -178,6 +247,19 @@ void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
   data_.push_back(std::move(data));
 }
 
+void DestinationBuffer::enqueueSpilled(
+    std::shared_ptr<const BroadcastSpill> spill) {
+  VELOX_CHECK_NULL(spill_);
+  VELOX_CHECK(data_.empty());
+  VELOX_CHECK_EQ(sequence_, 0);
+  spill_ = std::move(spill);
+  numSpilled_ = spill_->pages().size();
+  nextSpilled_ = 0;
+  for (const auto& page : spill_->pages()) {
+    stats_.recordEnqueue(page.size, page.numRows);
+  }
+}
+
 DataAvailable DestinationBuffer::getAndClearNotify() {
   if (notify_ == nullptr) {
     VELOX_CHECK_NULL(aliveCheck_);
@@ -202,7 +284,8 @@ void DestinationBuffer::clearNotify() {
 
 void DestinationBuffer::finish() {
   VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
-  VELOX_CHECK(data_.empty(), "data must be fetched before finish");
+  VELOX_CHECK(
+      data_.empty() && spill_ == nullptr, "data must be fetched before finish");
   stats_.finished = true;
 }
 
@@ -249,9 +332,21 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
   }
 
   VELOX_CHECK_LE(
-      numDeleted, data_.size(), "Ack received for a not yet produced item");
+      numDeleted,
+      numSpilledLeft() + data_.size(),
+      "Ack received for a not yet produced item");
+  const auto numSpilledDeleted = std::min(numDeleted, numSpilledLeft());
+  for (auto i = 0; i < numSpilledDeleted; ++i) {
+    const auto& page = spill_->pages()[nextSpilled_ + i];
+    stats_.recordAcknowledge(page.size, page.numRows);
+  }
+  nextSpilled_ += numSpilledDeleted;
+  if (spill_ != nullptr && numSpilledLeft() == 0) {
+    spill_ = nullptr;
+  }
+  const auto numDataDeleted = numDeleted - numSpilledDeleted;
   std::vector<std::shared_ptr<SerializedPage>> freed;
-  for (auto i = 0; i < numDeleted; ++i) {
+  for (auto i = 0; i < numDataDeleted; ++i) {
     if (data_[i] == nullptr) {
       VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
       break;
@@ -259,13 +354,19 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
     stats_.recordAcknowledge(*data_[i]);
     freed.push_back(std::move(data_[i]));
   }
-  data_.erase(data_.begin(), data_.begin() + numDeleted);
+  data_.erase(data_.begin(), data_.begin() + numDataDeleted);
   sequence_ += numDeleted;
   return freed;
 }
 
 std::vector<std::shared_ptr<SerializedPage>>
 DestinationBuffer::deleteResults() {
+  for (auto i = nextSpilled_; i < numSpilled_; ++i) {
+    const auto& page = spill_->pages()[i];
+    stats_.recordAcknowledge(page.size, page.numRows);
+  }
+  spill_ = nullptr;
+  nextSpilled_ = numSpilled_;
   std::vector<std::shared_ptr<SerializedPage>> freed;
   for (auto i = 0; i < data_.size(); ++i) {
     if (data_[i] == nullptr) {
@@ -286,6 +387,7 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 std::string DestinationBuffer::toString() {
   std::stringstream out;
   out << "[available: " << data_.size() << ", "
+      << "spilled: " << numSpilledLeft() << ", "
       << "sequence: " << sequence_ << ", "
       << (notify_ ? "notify registered, " : "") << this << "]";
   return out.str();
@@ -316,6 +418,8 @@ OutputBuffer::OutputBuffer(
       kind_(kind),
       maxSize_(task_->queryCtx()->queryConfig().maxOutputBufferSize()),
       continueSize_((maxSize_ * kContinuePct) / 100),
+      maxBroadcastRetainedBytes_(
+          task_->queryCtx()->queryConfig().maxBroadcastRetainedBytes()),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
       numDrivers_(numDrivers) {
@@ -350,6 +454,9 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
     noMoreBuffers_ = true;
     isFinished = isFinishedLocked();
     updateAfterAcknowledgeLocked(dataToBroadcast_, promises);
+    broadcastRetainedBytes_ = 0;
+    // The destination buffers keep the spilled pages they have not fetched.
+    broadcastSpill_ = nullptr;
   }
 
   releaseAfterAcknowledge(dataToBroadcast_, promises);
@@ -380,6 +487,9 @@ void OutputBuffer::addOutputBuffersLocked(int numBuffers) {
   for (int32_t i = buffers_.size(); i < numBuffers; ++i) {
     auto buffer = std::make_unique<DestinationBuffer>();
     if (isBroadcast()) {
+      if (broadcastSpill_ != nullptr) {
+        buffer->enqueueSpilled(broadcastSpill_);
+      }
       for (const auto& data : dataToBroadcast_) {
         buffer->enqueue(data);
       }
@@ -434,6 +544,8 @@ bool OutputBuffer::enqueue(
   VELOX_CHECK(
       task_->isRunning(), "Task is terminated, cannot add data to output.");
   std::vector<DataAvailable> dataAvailableCallbacks;
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
   bool blocked = false;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -444,7 +556,8 @@ bool OutputBuffer::enqueue(
     switch (kind_) {
       case PartitionedOutputNode::Kind::kBroadcast:
         VELOX_CHECK_EQ(destination, 0, "Bad destination {}", destination);
-        enqueueBroadcastOutputLocked(std::move(data), dataAvailableCallbacks);
+        enqueueBroadcastOutputLocked(
+            std::move(data), dataAvailableCallbacks, freed, promises);
         break;
       case PartitionedOutputNode::Kind::kArbitrary:
         VELOX_CHECK_EQ(destination, 0, "Bad destination {}", destination);
@@ -469,13 +582,16 @@ bool OutputBuffer::enqueue(
   for (auto& callback : dataAvailableCallbacks) {
     callback.notify();
   }
+  releaseAfterAcknowledge(freed, promises);
 
   return blocked;
 }
 
 void OutputBuffer::enqueueBroadcastOutputLocked(
     std::unique_ptr<SerializedPage> data,
-    std::vector<DataAvailable>& dataAvailableCbs) {
+    std::vector<DataAvailable>& dataAvailableCbs,
+    std::vector<std::shared_ptr<SerializedPage>>& freed,
+    std::vector<ContinuePromise>& promises) {
   VELOX_DCHECK(isBroadcast());
   VELOX_CHECK_NULL(arbitraryBuffer_);
   VELOX_DCHECK(dataAvailableCbs.empty());
@@ -491,8 +607,35 @@ void OutputBuffer::enqueueBroadcastOutputLocked(
   // NOTE: we don't need to add new buffer to 'dataToBroadcast_' if there is no
   // more output buffers.
   if (!noMoreBuffers_) {
-    dataToBroadcast_.emplace_back(sharedData);
+    broadcastRetainedBytes_ += sharedData->size();
+    dataToBroadcast_.emplace_back(std::move(sharedData));
+    if (maxBroadcastRetainedBytes_ > 0 &&
+        broadcastRetainedBytes_ > maxBroadcastRetainedBytes_) {
+      spillBroadcastDataLocked(freed, promises);
+    }
+  }
+}
+
+void OutputBuffer::spillBroadcastDataLocked(
+    std::vector<std::shared_ptr<SerializedPage>>& freed,
+    std::vector<ContinuePromise>& promises) {
+  if (task_->spillDirectory().empty()) {
+    return;
   }
+  if (broadcastSpill_ == nullptr) {
+    broadcastSpill_ = std::make_shared<BroadcastSpill>();
+  }
+  const auto& queryConfig = task_->queryCtx()->queryConfig();
+  const auto spilledBytes = broadcastSpill_->write(
+      dataToBroadcast_,
+      fmt::format("{}/broadcast", task_->getOrCreateSpillDirectory()),
+      queryConfig.spillFileCreateConfig());
+  task_->addSpilledBytes(spilledBytes);
+  // The pages that all the destinations have fetched are freed.
+  freed = std::move(dataToBroadcast_);
+  dataToBroadcast_.clear();
+  broadcastRetainedBytes_ = 0;
+  updateAfterAcknowledgeLocked(freed, promises);
 }
 
 void OutputBuffer::enqueueArbitraryOutputLocked(
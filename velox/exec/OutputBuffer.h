@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/file/File.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
 
@@ -90,6 +91,44 @@ class ArbitraryBuffer {
   std::deque<std::shared_ptr<SerializedPage>> pages_;
 };
 
+/// The pages of a broadcast output buffer that are written to spill files
+/// instead of being retained in memory for the destinations that have not
+/// been added yet. The destinations added later read the pages back when
+/// fetched. Shared by the destination buffers that have not acknowledged all
+/// of its pages. Removes the files on destruction. Not thread-safe.
+class BroadcastSpill {
+ public:
+  struct Page {
+    // Index of the file in 'files_'.
+    int32_t file;
+    uint64_t offset;
+    int64_t size;
+    int64_t numRows;
+  };
+
+  ~BroadcastSpill();
+
+  /// Writes 'pages' to a new file with 'pathPrefix'. Returns the number of
+  /// bytes written.
+  uint64_t write(
+      const std::vector<std::shared_ptr<SerializedPage>>& pages,
+      const std::string& pathPrefix,
+      const std::string& fileCreateConfig);
+
+  /// The pages in the order they were written.
+  const std::vector<Page>& pages() const {
+    return pages_;
+  }
+
+  /// Reads 'page' from its file.
+  std::unique_ptr<folly::IOBuf> read(const Page& page) const;
+
+ private:
+  std::vector<std::string> paths_;
+  std::vector<std::unique_ptr<ReadFile>> files_;
+  std::vector<Page> pages_;
+};
+
 class DestinationBuffer {
  public:
   /// The data transferred by the destination buffer has two phases:
@@ -104,6 +143,10 @@ class DestinationBuffer {
 
     void recordDelete(const SerializedPage& data);
 
+    void recordEnqueue(int64_t bytes, int64_t rows);
+
+    void recordAcknowledge(int64_t bytes, int64_t rows);
+
     bool finished{false};
 
     /// Number of buffered bytes / rows / pages.
@@ -119,6 +162,10 @@ class DestinationBuffer {
 
   void enqueue(std::shared_ptr<SerializedPage> data);
 
+  /// Makes the pages of 'spill' the first pages of this buffer. The pages are
+  /// read from 'spill' when fetched. Must be called before any enqueue().
+  void enqueueSpilled(std::shared_ptr<const BroadcastSpill> spill);
+
   /// Invoked to load data with up to 'notifyMaxBytes_' bytes from arbitrary
   /// 'buffer' if there is pending fetch from this destination in which case
   /// 'notify_' is not null. Otherwise, it does nothing. This only used by
@@ -187,8 +234,22 @@ class DestinationBuffer {
  private:
   void clearNotify();
 
+  // Number of pages in 'spill_' that are not acknowledged.
+  int64_t numSpilledLeft() const {
+    return numSpilled_ - nextSpilled_;
+  }
+
+  // Spilled pages that precede the pages in 'data_'.
+  std::shared_ptr<const BroadcastSpill> spill_;
+  // Number of pages of 'spill_' that belong to 'this'. Pages spilled later
+  // are in 'data_'.
+  int64_t numSpilled_{0};
+  // Index in 'spill_' of the first page that is not acknowledged.
+  int64_t nextSpilled_{0};
+
   std::vector<std::shared_ptr<SerializedPage>> data_;
-  // The sequence number of the first in 'data_'.
+  // The sequence number of the first not acknowledged page in 'spill_' or, if
+  // there is none, of the first in 'data_'.
   int64_t sequence_ = 0;
   DataAvailableCallback notify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
@@ -353,7 +414,16 @@ class OutputBuffer {
 
   void enqueueBroadcastOutputLocked(
       std::unique_ptr<SerializedPage> data,
-      std::vector<DataAvailable>& dataAvailableCbs);
+      std::vector<DataAvailable>& dataAvailableCbs,
+      std::vector<std::shared_ptr<SerializedPage>>& freed,
+      std::vector<ContinuePromise>& promises);
+
+  // Writes 'dataToBroadcast_' to 'broadcastSpill_' if the task has a spill
+  // directory. Moves the pages to 'freed' and the producer promises that can
+  // continue to 'promises'.
+  void spillBroadcastDataLocked(
+      std::vector<std::shared_ptr<SerializedPage>>& freed,
+      std::vector<ContinuePromise>& promises);
 
   void enqueueArbitraryOutputLocked(
       std::unique_ptr<SerializedPage> data,
@@ -386,6 +456,9 @@ class OutputBuffer {
   // When 'totalSize_' goes below 'continueSize_', blocked producers are
   // resumed.
   const uint64_t continueSize_;
+  // If the pages in 'dataToBroadcast_' exceed this, they are written to
+  // 'broadcastSpill_'. 0 means no limit.
+  const uint64_t maxBroadcastRetainedBytes_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
 
   // Total number of drivers expected to produce results. This number will
@@ -401,6 +474,12 @@ class OutputBuffer {
   // broadcast to destinations that have not yet been initialized. Cleared
   // after receiving no-more-broadcast-buffers signal.
   std::vector<std::shared_ptr<SerializedPage>> dataToBroadcast_;
+  // Bytes of the pages in 'dataToBroadcast_'.
+  uint64_t broadcastRetainedBytes_{0};
+  // The broadcast pages produced before 'dataToBroadcast_'. Destinations
+  // added later read these from disk. Released after receiving
+  // no-more-broadcast-buffers signal.
+  std::shared_ptr<BroadcastSpill> broadcastSpill_;
 
   std::mutex mutex_;
   // Actual data size in 'buffers_'.
@@ -17,6 +17,7 @@
 #include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -55,7 +56,7 @@ BlockingReason Destination::advance(
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
-    current_->createStreamTree(rowType, rowsInCurrent_);
+    current_->createStreamTree(rowType, rowsInCurrent_, serdeOptions_);
   }
   current_->append(
       output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
@@ -73,7 +74,7 @@ BlockingReason Destination::flush(
     OutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
     ContinueFuture* future) {
-  if (!current_) {
+  if (rowsInCurrent_ == 0) {
     return BlockingReason::kNotBlocked;
   }
 
@@ -87,7 +88,7 @@ BlockingReason Destination::flush(
   const int64_t flushedRows = rowsInCurrent_;
 
   current_->flush(&stream);
-  current_.reset();
+  current_->clear();
 
   const int64_t flushedBytes = stream.tellp();
 
@@ -107,6 +108,20 @@ BlockingReason Destination::flush(
   return blocked ? BlockingReason::kWaitForConsumer
                  : BlockingReason::kNotBlocked;
 }
+
+VectorStreamGroup* Destination::prepareScatter(
+    const RowTypePtr& type,
+    vector_size_t numRows,
+    uint64_t bytes) {
+  VELOX_DCHECK_GE(rowIdx_, rows_.size());
+  if (!current_) {
+    current_ = std::make_unique<VectorStreamGroup>(pool_);
+    current_->createStreamTree(type, numRows, serdeOptions_);
+  }
+  bytesInCurrent_ += bytes;
+  rowsInCurrent_ += numRows;
+  return current_.get();
+}
 } // namespace detail
 
 PartitionedOutput::PartitionedOutput(
@@ -148,6 +163,20 @@ PartitionedOutput::PartitionedOutput(
     VELOX_USER_CHECK(keyChannels_.empty());
     VELOX_USER_CHECK_NULL(partitionFunction_);
   }
+  const auto compressionKind = common::stringToCompressionKind(
+      ctx->task->queryCtx()->queryConfig().shuffleCompressionKind());
+  if (compressionKind != common::CompressionKind_NONE &&
+      dynamic_cast<serializer::presto::PrestoVectorSerde*>(getVectorSerde()) !=
+          nullptr) {
+    // Pages that do not shrink to this fraction of their size are sent
+    // uncompressed.
+    constexpr float kMinCompressionRatio = 0.8;
+    auto options = std::make_unique<
+        serializer::presto::PrestoVectorSerde::PrestoOptions>();
+    options->compressionKind = compressionKind;
+    options->minCompressionRatio = kMinCompressionRatio;
+    serdeOptions_ = std::move(options);
+  }
 }
 
 void PartitionedOutput::initializeInput(RowVectorPtr input) {
@@ -182,10 +211,15 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          serdeOptions_.get()));
     }
   }
 }
@@ -263,7 +297,7 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
       if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
-      } else {
+      } else if (!tryScatter()) {
         for (vector_size_t i = 0; i < numInput; ++i) {
           destinations_[partitions_[i]]->addRow(i);
         }
@@ -272,6 +306,54 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
   }
 }
 
+uint64_t PartitionedOutput::maxPageSize() const {
+  // Limit serialized pages to 1MB.
+  static const uint64_t kMaxPageSize = 1 << 20;
+  return std::max<uint64_t>(
+      kMinDestinationSize,
+      std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
+}
+
+bool PartitionedOutput::tryScatter() {
+  const auto numInput = input_->size();
+  if (eagerFlush_ || output_->childrenSize() == 0 ||
+      numInput > numDestinations_ * kMaxScatterRowsPerDestination ||
+      !getVectorSerde()->supportsScatter()) {
+    return false;
+  }
+
+  destinationBytes_.assign(numDestinations_, 0);
+  destinationRows_.assign(numDestinations_, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    destinationBytes_[partitions_[i]] += rowSize_[i];
+    ++destinationRows_[partitions_[i]];
+  }
+  const auto pageSize = maxPageSize();
+  for (auto i = 0; i < numDestinations_; ++i) {
+    if (destinationRows_[i] > 0 &&
+        !destinations_[i]->canAddWithoutFlush(
+            pageSize, destinationBytes_[i], destinationRows_[i])) {
+      return false;
+    }
+  }
+
+  scatterGroups_.assign(numDestinations_, nullptr);
+  const auto rowType = asRowType(output_->type());
+  for (auto i = 0; i < numDestinations_; ++i) {
+    if (destinationRows_[i] > 0) {
+      scatterGroups_[i] = destinations_[i]->prepareScatter(
+          rowType, destinationRows_[i], destinationBytes_[i]);
+    }
+  }
+  VectorStreamGroup::scatter(
+      output_,
+      partitions_.data(),
+      folly::Range<VectorStreamGroup* const*>(
+          scatterGroups_.data(), scatterGroups_.size()),
+      scratch_);
+  return true;
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
@@ -309,11 +391,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
   VELOX_CHECK_NOT_NULL(
       bufferManager, "OutputBufferManager was already destructed");
 
-  // Limit serialized pages to 1MB.
-  static const uint64_t kMaxPageSize = 1 << 20;
-  const uint64_t maxPageSize = std::max<uint64_t>(
-      kMinDestinationSize,
-      std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
+  const auto pageSize = maxPageSize();
 
   bool workLeft;
   do {
@@ -321,7 +399,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
     for (auto& destination : destinations_) {
       bool atEnd = false;
       blockingReason_ = destination->advance(
-          maxPageSize,
+          pageSize,
           rowSize_,
           output_,
           *bufferManager,
@@ -381,4 +459,21 @@ bool PartitionedOutput::isFinished() {
   return finished_;
 }
 
+void PartitionedOutput::close() {
+  std::unordered_map<std::string, int64_t> serdeStats;
+  for (auto& destination : destinations_) {
+    for (const auto& [name, counter] : destination->runtimeStats()) {
+      serdeStats[name] += counter.value;
+    }
+  }
+  if (!serdeStats.empty()) {
+    auto lockedStats = stats_.wlock();
+    for (const auto& [name, value] : serdeStats) {
+      lockedStats->addRuntimeStat(
+          name, RuntimeCounter(value, RuntimeCounter::Unit::kBytes));
+    }
+  }
+  destinations_.clear();
+}
+
 } // namespace facebook::velox::exec
@@ -27,17 +27,21 @@ class Destination {
  public:
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param serdeOptions Options for serializing the pages. Owned by the
+  /// caller and must outlive 'this'. May be nullptr.
   Destination(
       const std::string& taskId,
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      const VectorSerde::Options* serdeOptions = nullptr)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
-        recordEnqueued_(std::move(recordEnqueued)) {
+        recordEnqueued_(std::move(recordEnqueued)),
+        serdeOptions_(serdeOptions) {
     setTargetSizePct();
   }
 
@@ -73,6 +77,23 @@ class Destination {
       const std::function<void()>& bufferReleaseFn,
       ContinueFuture* future);
 
+  /// Returns true if 'numRows' rows of 'bytes' serialized size can be added
+  /// without reaching the flush thresholds for 'maxBytes'.
+  bool canAddWithoutFlush(
+      uint64_t maxBytes,
+      uint64_t bytes,
+      vector_size_t numRows) const {
+    const uint64_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
+    return bytesInCurrent_ + bytes < adjustedMaxBytes &&
+        rowsInCurrent_ + numRows < targetNumRows_;
+  }
+
+  /// Returns the stream group to append 'numRows' rows of 'bytes' serialized
+  /// size of 'type' to with VectorStreamGroup::scatter(). The rows must fit
+  /// according to canAddWithoutFlush().
+  VectorStreamGroup*
+  prepareScatter(const RowTypePtr& type, vector_size_t numRows, uint64_t bytes);
+
   bool isFinished() const {
     return finished_;
   }
@@ -85,6 +106,15 @@ class Destination {
     return bytesInCurrent_;
   }
 
+  /// Returns the serializer statistics, e.g. compression sizes, of the pages
+  /// flushed so far.
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() {
+    if (current_ == nullptr) {
+      return {};
+    }
+    return current_->runtimeStats();
+  }
+
  private:
   // Sets the next target size for flushing. This is called at the
   // start of each batch of output for the destination. The effect is
@@ -104,6 +134,7 @@ class Destination {
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  const VectorSerde::Options* const serdeOptions_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -115,7 +146,7 @@ class Destination {
   vector_size_t rowIdx_{0};
 
   // The current stream where the input is serialized to. This is cleared on
-  // every flush() call.
+  // every flush() call and reused for the next rows.
   std::unique_ptr<VectorStreamGroup> current_;
   bool finished_{false};
 
@@ -148,6 +179,11 @@ class PartitionedOutput : public Operator {
   // network MTU of 64K.
   static constexpr uint64_t kMinDestinationSize = 60 * 1024;
 
+  // An input with at most this many rows per destination on average is
+  // serialized in one pass over the rows instead of one pass per
+  // destination.
+  static constexpr int32_t kMaxScatterRowsPerDestination = 16;
+
   PartitionedOutput(
       int32_t operatorId,
       DriverCtx* ctx,
@@ -178,9 +214,7 @@ class PartitionedOutput : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    destinations_.clear();
-  }
+  void close() override;
 
  private:
   void initializeInput(RowVectorPtr input);
@@ -194,6 +228,15 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Returns the target size of a serialized page for a destination.
+  uint64_t maxPageSize() const;
+
+  // Serializes all rows of 'output_' to their destinations in 'partitions_'
+  // in one pass if there are many destinations, few rows go to each and none
+  // of the destinations needs a flush. Returns false if the rows must be
+  // added to the destinations and serialized in getOutput().
+  bool tryScatter();
+
   const std::vector<column_index_t> keyChannels_;
   const int numDestinations_;
   const bool replicateNullsAndAny_;
@@ -204,6 +247,8 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  // Set if the pages are compressed. Shared by all destinations.
+  std::unique_ptr<VectorSerde::Options> serdeOptions_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -220,6 +265,10 @@ class PartitionedOutput : public Operator {
   std::vector<uint32_t> partitions_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
+  // Serialized bytes and number of rows of the input for each destination.
+  std::vector<uint64_t> destinationBytes_;
+  std::vector<vector_size_t> destinationRows_;
+  std::vector<VectorStreamGroup*> scatterGroups_;
 };
 
 } // namespace facebook::velox::exec
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// Number of leading bytes of a string sort key encoded in the normalized keys.
+constexpr uint32_t kStringPrefixBytes = 16;
+
+// Returns the number of bytes to encode a value of 'type' excluding the null
+// byte, or std::nullopt if values of 'type' can't be normalized.
+std::optional<uint32_t> encodeSize(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::INTEGER:
+      return sizeof(int32_t);
+    case TypeKind::BIGINT:
+      return sizeof(int64_t);
+    case TypeKind::REAL:
+      return sizeof(float);
+    case TypeKind::DOUBLE:
+      return sizeof(double);
+    case TypeKind::TIMESTAMP:
+      return prefixsort::PrefixSortEncoder::encodedSize<Timestamp>();
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return kStringPrefixBytes;
+    default:
+      return std::nullopt;
+  }
+}
+
+// Returns true if only a prefix of the values of 'type' is encoded.
+bool isPartiallyEncoded(const TypePtr& type) {
+  return type->kind() == TypeKind::VARCHAR ||
+      type->kind() == TypeKind::VARBINARY;
+}
+
+template <typename T>
+FOLLY_ALWAYS_INLINE void encodeRowColumn(
+    const prefixsort::PrefixSortEncoder& encoder,
+    RowColumn column,
+    const char* row,
+    char* dest) {
+  std::optional<T> value;
+  if (!RowContainer::isNullAt(row, column)) {
+    value = *reinterpret_cast<const T*>(row + column.offset());
+  }
+  encoder.encode(value, dest);
+}
+
+FOLLY_ALWAYS_INLINE void encodeStringRowColumn(
+    const prefixsort::PrefixSortEncoder& encoder,
+    RowColumn column,
+    const char* row,
+    uint32_t encodeSize,
+    char* dest) {
+  if (RowContainer::isNullAt(row, column)) {
+    encoder.encode(std::nullopt, dest, encodeSize);
+    return;
+  }
+  std::string storage;
+  encoder.encode(
+      HashStringAllocator::contiguousString(
+          *reinterpret_cast<const StringView*>(row + column.offset()),
+          storage),
+      dest,
+      encodeSize);
+}
+} // namespace
+
+// static
+PrefixSortLayout PrefixSortLayout::makeSortLayout(
+    const std::vector<TypePtr>& types,
+    const std::vector<CompareFlags>& compareFlags,
+    uint32_t maxNormalizedKeyBytes) {
+  VELOX_CHECK_EQ(types.size(), compareFlags.size());
+  const uint32_t numKeys = types.size();
+  uint32_t normalizedKeySize = 0;
+  uint32_t numNormalizedKeys = 0;
+  uint32_t firstNonNormalizedKey = numKeys;
+  std::vector<uint32_t> prefixOffsets;
+  std::vector<uint32_t> encodeSizes;
+  for (uint32_t i = 0; i < numKeys; ++i) {
+    const auto size = encodeSize(types[i]);
+    if (!size.has_value() ||
+        normalizedKeySize + 1 + size.value() > maxNormalizedKeyBytes) {
+      firstNonNormalizedKey = i;
+      break;
+    }
+    prefixOffsets.push_back(normalizedKeySize);
+    encodeSizes.push_back(size.value());
+    normalizedKeySize += 1 + size.value();
+    ++numNormalizedKeys;
+    if (isPartiallyEncoded(types[i])) {
+      // The order of the keys after a string key can't be decided by the
+      // normalized keys as the string may be longer than the encoded prefix.
+      firstNonNormalizedKey = i;
+      break;
+    }
+  }
+  // Pad the normalized keys to keep the row address aligned.
+  const uint32_t normalizedBufferSize =
+      bits::roundUp(normalizedKeySize, sizeof(char*));
+  return PrefixSortLayout{
+      normalizedBufferSize + sizeof(char*),
+      normalizedBufferSize,
+      numNormalizedKeys,
+      compareFlags,
+      firstNonNormalizedKey,
+      std::move(prefixOffsets),
+      std::move(encodeSizes)};
+}
+
+// static
+void PrefixSort::sort(
+    folly::Range<char**> rows,
+    memory::MemoryPool* pool,
+    RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    const common::PrefixSortConfig& config,
+    PrefixSortStats* stats) {
+  if (rows.size() < config.minNumRows) {
+    stdSort(rows, rowContainer, compareFlags);
+    return;
+  }
+
+  VELOX_CHECK_LE(compareFlags.size(), rowContainer->keyTypes().size());
+  const std::vector<TypePtr> keyTypes(
+      rowContainer->keyTypes().begin(),
+      rowContainer->keyTypes().begin() + compareFlags.size());
+  const auto sortLayout = PrefixSortLayout::makeSortLayout(
+      keyTypes, compareFlags, config.maxNormalizedKeyBytes);
+  if (sortLayout.numNormalizedKeys == 0) {
+    stdSort(rows, rowContainer, compareFlags);
+    return;
+  }
+
+  PrefixSort prefixSort(pool, rowContainer, sortLayout);
+  PrefixSortStats sortStats;
+  prefixSort.sortInternal(rows, sortStats);
+  if (stats != nullptr) {
+    *stats += sortStats;
+  }
+}
+
+// static
+void PrefixSort::stdSort(
+    folly::Range<char**> rows,
+    RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags) {
+  std::sort(
+      rows.begin(),
+      rows.end(),
+      [&](const char* leftRow, const char* rightRow) {
+        for (vector_size_t index = 0; index < compareFlags.size(); ++index) {
+          if (auto result = rowContainer->compare(
+                  leftRow, rightRow, index, compareFlags[index])) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+}
+
+void PrefixSort::extractRowAndEncodePrefixKeys(char* row, char* entry) {
+  for (uint32_t i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
+    const auto& flags = sortLayout_.compareFlags[i];
+    const prefixsort::PrefixSortEncoder encoder(
+        flags.ascending, flags.nullsFirst);
+    const auto column = rowContainer_->columnAt(i);
+    char* dest = entry + sortLayout_.prefixOffsets[i];
+    switch (rowContainer_->keyTypes()[i]->kind()) {
+      case TypeKind::INTEGER:
+        encodeRowColumn<int32_t>(encoder, column, row, dest);
+        break;
+      case TypeKind::BIGINT:
+        encodeRowColumn<int64_t>(encoder, column, row, dest);
+        break;
+      case TypeKind::REAL:
+        encodeRowColumn<float>(encoder, column, row, dest);
+        break;
+      case TypeKind::DOUBLE:
+        encodeRowColumn<double>(encoder, column, row, dest);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodeRowColumn<Timestamp>(encoder, column, row, dest);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        encodeStringRowColumn(
+            encoder, column, row, sortLayout_.encodeSizes[i], dest);
+        break;
+      default:
+        VELOX_UNREACHABLE(
+            "Unexpected prefix-sort key type: {}",
+            rowContainer_->keyTypes()[i]->toString());
+    }
+  }
+  // Zero the padding so that it doesn't affect memcmp.
+  const auto lastKey = sortLayout_.numNormalizedKeys - 1;
+  const auto normalizedKeySize = sortLayout_.prefixOffsets[lastKey] + 1 +
+      sortLayout_.encodeSizes[lastKey];
+  simd::memset(
+      entry + normalizedKeySize,
+      0,
+      sortLayout_.normalizedBufferSize - normalizedKeySize);
+  *reinterpret_cast<char**>(entry + sortLayout_.normalizedBufferSize) = row;
+}
+
+int PrefixSort::compareNonNormalizedKeys(char* leftRow, char* rightRow) const {
+  for (auto i = sortLayout_.firstNonNormalizedKey;
+       i < sortLayout_.compareFlags.size();
+       ++i) {
+    if (auto result = rowContainer_->compare(
+            leftRow, rightRow, i, sortLayout_.compareFlags[i])) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+void PrefixSort::sortInternal(
+    folly::Range<char**> rows,
+    PrefixSortStats& stats) {
+  const auto numRows = rows.size();
+  const auto entrySize = sortLayout_.entrySize;
+  // One extra entry is used as the swap buffer of the sort algorithm.
+  const auto buffer =
+      AlignedBuffer::allocate<char>(entrySize * (numRows + 1), pool_);
+  char* const start = buffer->asMutable<char>();
+  char* const end = start + entrySize * numRows;
+  for (size_t i = 0; i < numRows; ++i) {
+    extractRowAndEncodePrefixKeys(rows[i], start + i * entrySize);
+  }
+
+  const prefixsort::PrefixSortRunner runner(entrySize, end);
+  const auto normalizedBufferSize = sortLayout_.normalizedBufferSize;
+  uint64_t numPrefixHits{0};
+  uint64_t numPrefixTies{0};
+  if (sortLayout_.hasNonNormalizedKey()) {
+    runner.quickSort(start, end, [&](char* left, char* right) {
+      const auto result = std::memcmp(left, right, normalizedBufferSize);
+      if (result != 0) {
+        ++numPrefixHits;
+        return result;
+      }
+      ++numPrefixTies;
+      return compareNonNormalizedKeys(
+          getRowAddrFromPrefixBuffer(left), getRowAddrFromPrefixBuffer(right));
+    });
+  } else {
+    runner.quickSort(start, end, [&](char* left, char* right) {
+      ++numPrefixHits;
+      return std::memcmp(left, right, normalizedBufferSize);
+    });
+  }
+
+  for (size_t i = 0; i < numRows; ++i) {
+    rows[i] = getRowAddrFromPrefixBuffer(start + i * entrySize);
+  }
+  stats.numRows += numRows;
+  stats.numPrefixHits += numPrefixHits;
+  stats.numPrefixTies += numPrefixTies;
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/base/PrefixSortConfig.h"
+#include "velox/exec/RowContainer.h"
+#include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
+
+namespace facebook::velox::exec {
+
+/// The layout of a prefix-sort entry: the normalized keys of the leading sort
+/// keys followed by the address of the row in the RowContainer.
+///
+///  | normalized key 0 | ... | normalized key n | padding | row address |
+///
+/// The normalized keys are compared with memcmp. If the sort keys are not
+/// fully captured by the normalized keys, e.g. a non-normalizable key or a
+/// string key whose prefix is encoded, entries with equal normalized keys are
+/// compared with RowContainer::compare starting from the first key that is not
+/// fully captured.
+struct PrefixSortLayout {
+  /// Number of bytes of a single entry in the prefix-sort buffer.
+  const uint64_t entrySize;
+
+  /// Number of bytes of the normalized keys, including padding.
+  const uint32_t normalizedBufferSize;
+
+  /// Number of sort keys encoded in the normalized keys.
+  const uint32_t numNormalizedKeys;
+
+  /// The compare flags of all sort keys.
+  const std::vector<CompareFlags> compareFlags;
+
+  /// The index of the first sort key which is not fully captured by the
+  /// normalized keys. Equals compareFlags.size() if memcmp on the normalized
+  /// keys alone decides the order.
+  const uint32_t firstNonNormalizedKey;
+
+  /// Offsets of the normalized keys inside an entry.
+  const std::vector<uint32_t> prefixOffsets;
+
+  /// Number of bytes encoded for each normalized key, excluding the null byte.
+  const std::vector<uint32_t> encodeSizes;
+
+  bool hasNonNormalizedKey() const {
+    return firstNonNormalizedKey < compareFlags.size();
+  }
+
+  /// Builds the layout for sort keys of 'types'. The normalized keys take at
+  /// most 'maxNormalizedKeyBytes'.
+  static PrefixSortLayout makeSortLayout(
+      const std::vector<TypePtr>& types,
+      const std::vector<CompareFlags>& compareFlags,
+      uint32_t maxNormalizedKeyBytes);
+};
+
+/// Counters of a prefix-sort reported as runtime stats of the operator.
+struct PrefixSortStats {
+  /// Number of rows sorted with prefix-sort.
+  uint64_t numRows{0};
+
+  /// Number of comparisons decided by memcmp on the normalized keys.
+  uint64_t numPrefixHits{0};
+
+  /// Number of comparisons with equal normalized keys which fell back to
+  /// compare the rows in the RowContainer.
+  uint64_t numPrefixTies{0};
+
+  PrefixSortStats& operator+=(const PrefixSortStats& other) {
+    numRows += other.numRows;
+    numPrefixHits += other.numPrefixHits;
+    numPrefixTies += other.numPrefixTies;
+    return *this;
+  }
+
+  bool empty() const {
+    return numRows == 0;
+  }
+};
+
+/// Sorts the rows of a RowContainer on the sort keys, which are the first
+/// 'compareFlags.size()' columns of the RowContainer. The normalized keys are
+/// encoded into a contiguous buffer allocated from 'pool' and sorted with
+/// memcmp. Falls back to the comparator based sort if prefix-sort doesn't
+/// apply, e.g. no leading key can be normalized or there are too few rows.
+class PrefixSort {
+ public:
+  PrefixSort(
+      memory::MemoryPool* pool,
+      RowContainer* rowContainer,
+      const PrefixSortLayout& sortLayout)
+      : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {}
+
+  /// Sorts 'rows' in place. If 'stats' is not null, accumulates the prefix
+  /// sort counters into it.
+  static void sort(
+      folly::Range<char**> rows,
+      memory::MemoryPool* pool,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const common::PrefixSortConfig& config,
+      PrefixSortStats* stats = nullptr);
+
+  /// Sorts 'rows' in place with std::sort and RowContainer::compare.
+  static void stdSort(
+      folly::Range<char**> rows,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags);
+
+ private:
+  // Encodes the normalized keys of 'row' into 'entry' followed by the row
+  // address.
+  void extractRowAndEncodePrefixKeys(char* row, char* entry);
+
+  // Compares the non-normalized keys of 'leftRow' and 'rightRow'.
+  int compareNonNormalizedKeys(char* leftRow, char* rightRow) const;
+
+  void sortInternal(folly::Range<char**> rows, PrefixSortStats& stats);
+
+  FOLLY_ALWAYS_INLINE char* getRowAddrFromPrefixBuffer(char* entry) const {
+    return *reinterpret_cast<char**>(entry + sortLayout_.normalizedBufferSize);
+  }
+
+  memory::MemoryPool* const pool_;
+  const PrefixSortLayout sortLayout_;
+  RowContainer* const rowContainer_;
+};
+} // namespace facebook::velox::exec
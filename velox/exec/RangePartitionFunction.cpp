@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RangePartitionFunction.h"
+
+#include <numeric>
+
+#include "velox/common/encode/Base64.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+namespace {
+std::vector<CompareFlags> toCompareFlags(
+    const std::vector<core::SortOrder>& sortOrders) {
+  std::vector<CompareFlags> flags;
+  flags.reserve(sortOrders.size());
+  for (const auto& order : sortOrders) {
+    flags.push_back(
+        {order.isNullsFirst(), order.isAscending(), false /*equalsOnly*/});
+  }
+  return flags;
+}
+
+// Returns the key columns of 'input' at 'rows'.
+RowVectorPtr copyKeys(
+    const RowVector& input,
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<vector_size_t>& rows,
+    memory::MemoryPool* pool) {
+  std::vector<std::string> names;
+  std::vector<VectorPtr> keys;
+  for (auto channel : keyChannels) {
+    const auto& source = input.childAt(channel);
+    auto key = BaseVector::create(source->type(), rows.size(), pool);
+    for (auto i = 0; i < rows.size(); ++i) {
+      key->copy(source.get(), i, rows[i], 1);
+    }
+    names.push_back(asRowType(input.type())->nameOf(channel));
+    keys.push_back(std::move(key));
+  }
+  std::vector<TypePtr> types;
+  for (const auto& key : keys) {
+    types.push_back(key->type());
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      ROW(std::move(names), std::move(types)),
+      nullptr,
+      rows.size(),
+      std::move(keys));
+}
+} // namespace
+
+RangePartitionFunction::RangePartitionFunction(
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<core::SortOrder>& sortOrders,
+    RowVectorPtr splitPoints)
+    : keyChannels_(keyChannels),
+      splitPoints_(std::move(splitPoints)),
+      compareFlags_(toCompareFlags(sortOrders)) {
+  VELOX_CHECK(!keyChannels_.empty());
+  VELOX_CHECK_EQ(keyChannels_.size(), sortOrders.size());
+  VELOX_CHECK_EQ(keyChannels_.size(), splitPoints_->childrenSize());
+}
+
+bool RangePartitionFunction::lessThanSplitPoint(
+    const std::vector<BaseVector*>& keys,
+    vector_size_t row,
+    vector_size_t split) const {
+  for (auto i = 0; i < keys.size(); ++i) {
+    const auto result = keys[i]
+                            ->compare(
+                                splitPoints_->childAt(i).get(),
+                                row,
+                                split,
+                                compareFlags_[i])
+                            .value();
+    if (result != 0) {
+      return result < 0;
+    }
+  }
+  return false;
+}
+
+std::optional<uint32_t> RangePartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  const auto numSplitPoints = splitPoints_->size();
+  if (numSplitPoints == 0) {
+    return 0u;
+  }
+
+  std::vector<BaseVector*> keys;
+  keys.reserve(keyChannels_.size());
+  for (auto channel : keyChannels_) {
+    keys.push_back(input.childAt(channel)->loadedVector());
+  }
+
+  const auto size = input.size();
+  partitions.resize(size);
+  for (auto row = 0; row < size; ++row) {
+    // Binary search for the first split point greater than the row.
+    vector_size_t low = 0;
+    vector_size_t high = numSplitPoints;
+    while (low < high) {
+      const auto mid = low + (high - low) / 2;
+      if (lessThanSplitPoint(keys, row, mid)) {
+        high = mid;
+      } else {
+        low = mid + 1;
+      }
+    }
+    partitions[row] = low;
+  }
+  return std::nullopt;
+}
+
+RangePartitionFunctionSpec::RangePartitionFunctionSpec(
+    RowTypePtr inputType,
+    std::vector<column_index_t> keyChannels,
+    std::vector<core::SortOrder> sortOrders,
+    RowVectorPtr splitPoints)
+    : inputType_{std::move(inputType)},
+      keyChannels_{std::move(keyChannels)},
+      sortOrders_{std::move(sortOrders)},
+      splitPoints_{std::move(splitPoints)} {
+  VELOX_CHECK_EQ(keyChannels_.size(), sortOrders_.size());
+  VELOX_CHECK_EQ(keyChannels_.size(), splitPoints_->childrenSize());
+}
+
+std::unique_ptr<core::PartitionFunction> RangePartitionFunctionSpec::create(
+    int numPartitions) const {
+  VELOX_CHECK_GT(numPartitions, 0);
+  // 'splitPoints_' divide the input into 'numRanges' ranges. Partition i
+  // starts at range i * numRanges / numPartitions, which starts at split point
+  // range - 1. Some partitions are empty if there are fewer ranges than
+  // partitions.
+  const auto numRanges = splitPoints_->size() + 1;
+  std::vector<vector_size_t> rows;
+  for (auto i = 1; i < numPartitions; ++i) {
+    const auto range = static_cast<int64_t>(i) * numRanges / numPartitions;
+    rows.push_back(std::max<int64_t>(range - 1, 0));
+  }
+  if (rows.size() == splitPoints_->size()) {
+    return std::make_unique<RangePartitionFunction>(
+        keyChannels_, sortOrders_, splitPoints_);
+  }
+
+  std::vector<column_index_t> splitChannels(keyChannels_.size());
+  std::iota(splitChannels.begin(), splitChannels.end(), 0);
+  auto splitPoints =
+      copyKeys(*splitPoints_, splitChannels, rows, splitPoints_->pool());
+  return std::make_unique<RangePartitionFunction>(
+      keyChannels_, sortOrders_, std::move(splitPoints));
+}
+
+std::string RangePartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]) << " "
+         << sortOrders_[i].toString();
+  }
+  return fmt::format(
+      "RANGE({}; {} split points)", keys.str(), splitPoints_->size());
+}
+
+folly::dynamic RangePartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "RangePartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  folly::dynamic sortOrders = folly::dynamic::array;
+  for (const auto& order : sortOrders_) {
+    sortOrders.push_back(order.serialize());
+  }
+  obj["sortOrders"] = sortOrders;
+  std::ostringstream out;
+  saveVector(*splitPoints_, out);
+  const auto serialized = out.str();
+  obj["splitPoints"] =
+      encoding::Base64::encode(serialized.data(), serialized.size());
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr RangePartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  auto keys = ISerializable::deserialize<std::vector<column_index_t>>(
+      obj["keyChannels"], context);
+  std::vector<core::SortOrder> sortOrders;
+  for (const auto& order : obj["sortOrders"]) {
+    sortOrders.push_back(core::SortOrder::deserialize(order));
+  }
+  std::istringstream in(
+      encoding::Base64::decode(obj["splitPoints"].asString()));
+  auto* pool = static_cast<memory::MemoryPool*>(context);
+  return std::make_shared<RangePartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      std::move(keys),
+      std::move(sortOrders),
+      std::static_pointer_cast<RowVector>(restoreVector(in, pool)));
+}
+
+// static
+RowVectorPtr RangePartitionFunctionSpec::computeSplitPoints(
+    const RowVector& sample,
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<core::SortOrder>& sortOrders,
+    vector_size_t numSplitPoints,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_EQ(keyChannels.size(), sortOrders.size());
+  const auto flags = toCompareFlags(sortOrders);
+  std::vector<BaseVector*> keys;
+  for (auto channel : keyChannels) {
+    keys.push_back(sample.childAt(channel)->loadedVector());
+  }
+
+  std::vector<vector_size_t> sorted(sample.size());
+  std::iota(sorted.begin(), sorted.end(), 0);
+  std::sort(sorted.begin(), sorted.end(), [&](auto left, auto right) {
+    for (auto i = 0; i < keys.size(); ++i) {
+      const auto result =
+          keys[i]->compare(keys[i], left, right, flags[i]).value();
+      if (result != 0) {
+        return result < 0;
+      }
+    }
+    return false;
+  });
+
+  std::vector<vector_size_t> rows;
+  if (!sorted.empty()) {
+    for (auto i = 1; i <= numSplitPoints; ++i) {
+      rows.push_back(sorted[static_cast<int64_t>(i) * sorted.size() /
+                            (numSplitPoints + 1)]);
+    }
+  }
+  return copyKeys(sample, keyChannels, rows, pool);
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Assigns rows to partitions by ranges of the values of the sorting keys, so
+/// that the rows of partition i sort before the rows of partition i + 1. Used
+/// to sort in parallel: each driver sorts one range and the sorted ranges are
+/// output one after another.
+///
+/// 'splitPoints' has one column per key, in 'keyChannels' order, and rows
+/// sorted by 'sortOrders'. A row goes to the partition that is the number of
+/// split points that are less than or equal to the row. There must be
+/// 'numPartitions' - 1 split points.
+class RangePartitionFunction : public core::PartitionFunction {
+ public:
+  RangePartitionFunction(
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<core::SortOrder>& sortOrders,
+      RowVectorPtr splitPoints);
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+  int numPartitions() const {
+    return splitPoints_->size() + 1;
+  }
+
+ private:
+  // Returns true if row 'row' of 'keys' sorts before split point 'split'.
+  bool lessThanSplitPoint(
+      const std::vector<BaseVector*>& keys,
+      vector_size_t row,
+      vector_size_t split) const;
+
+  const std::vector<column_index_t> keyChannels_;
+  const RowVectorPtr splitPoints_;
+  std::vector<CompareFlags> compareFlags_;
+};
+
+/// Factory class to create RangePartitionFunction. 'splitPoints' are sorted
+/// values of the keys, usually from a sample of the input, that divide the
+/// input into 'splitPoints->size() + 1' ranges of about the same size. For
+/// 'numPartitions' partitions, the function uses 'numPartitions' - 1 evenly
+/// spaced split points. Some partitions are empty if there are fewer split
+/// points than partitions.
+class RangePartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  RangePartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      std::vector<core::SortOrder> sortOrders,
+      RowVectorPtr splitPoints);
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+  /// Returns 'numSplitPoints' split points that divide the rows of 'sample'
+  /// into ranges of about the same size. The split points are the values of
+  /// the keys at 'keyChannels' of evenly spaced rows of 'sample' sorted by
+  /// 'sortOrders'.
+  static RowVectorPtr computeSplitPoints(
+      const RowVector& sample,
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<core::SortOrder>& sortOrders,
+      vector_size_t numSplitPoints,
+      memory::MemoryPool* pool);
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<core::SortOrder> sortOrders_;
+  const RowVectorPtr splitPoints_;
+};
+} // namespace facebook::velox::exec
@@ -375,6 +375,43 @@ void RowContainer::freeVariableWidthFields(folly::Range<char**> rows) {
   }
 }
 
+int64_t RowContainer::compactStringAllocator(
+    const UpdateAccumulators& updateAccumulators) {
+  VELOX_CHECK_EQ(
+      nextOffset_, 0, "Cannot compact a row container with duplicate rows");
+  VELOX_CHECK(
+      accumulators_.empty() || updateAccumulators != nullptr,
+      "Compacting a row container with accumulators requires a callback");
+  return stringAllocator_->compact(
+      [&](const HashStringAllocator::BlockMap& blocks) {
+        constexpr int32_t kBatch = 1000;
+        std::vector<char*> rows(kBatch);
+        RowContainerIterator iter;
+        while (auto numRows = listRows(&iter, kBatch, rows.data())) {
+          folly::Range<char**> batch(rows.data(), numRows);
+          for (auto i = 0; i < types_.size(); ++i) {
+            switch (typeKinds_[i]) {
+              case TypeKind::VARCHAR:
+              case TypeKind::VARBINARY:
+                updateVariableWidthFieldsAtColumn<StringView>(
+                    i, batch, blocks);
+                break;
+              case TypeKind::ROW:
+              case TypeKind::ARRAY:
+              case TypeKind::MAP:
+                updateVariableWidthFieldsAtColumn<std::string_view>(
+                    i, batch, blocks);
+                break;
+              default:;
+            }
+          }
+          if (updateAccumulators != nullptr) {
+            updateAccumulators(batch, blocks);
+          }
+        }
+      });
+}
+
 void RowContainer::checkConsistency() {
   constexpr int32_t kBatch = 1000;
   std::vector<char*> rows(kBatch);
@@ -693,9 +730,14 @@ int32_t RowContainer::compareStringAsc(
     StringView left,
     const DecodedVector& decoded,
     vector_size_t index) {
+  const auto right = decoded.valueAt<StringView>(index);
+  // Most comparisons are decided without reading the out of line data of
+  // 'left', which may be in pieces in 'stringAllocator_'.
+  if (auto result = left.compareInlinePart(right)) {
+    return *result;
+  }
   std::string storage;
-  return HashStringAllocator::contiguousString(left, storage)
-      .compare(decoded.valueAt<StringView>(index));
+  return HashStringAllocator::contiguousString(left, storage).compare(right);
 }
 
 // static
@@ -712,6 +754,9 @@ int RowContainer::compareComplexType(
 }
 
 int32_t RowContainer::compareStringAsc(StringView left, StringView right) {
+  if (auto result = left.compareInlinePart(right)) {
+    return *result;
+  }
   std::string leftStorage;
   std::string rightStorage;
   return HashStringAllocator::contiguousString(left, leftStorage)
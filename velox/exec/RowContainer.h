@@ -631,6 +631,22 @@ class RowContainer {
   /// Returns the average size of rows in bytes stored in this container.
   std::optional<int64_t> estimateRowSize() const;
 
+  /// Called by compactStringAllocator() with batches of rows to update the
+  /// pointers that accumulators of the rows hold to the moved blocks.
+  using UpdateAccumulators = std::function<void(
+      folly::Range<char**> rows,
+      const HashStringAllocator::BlockMap& blocks)>;
+
+  /// Moves the variable length data of the rows to new slabs of the string
+  /// allocator so that the fragmented free space between the blocks is
+  /// returned to the memory pool. Updates the string and complex type
+  /// columns. 'updateAccumulators' is required if there are accumulators.
+  /// The string allocator must not be shared with another container. Not
+  /// supported for a join build with duplicate rows. Returns the number of
+  /// bytes returned to the pool.
+  int64_t compactStringAllocator(
+      const UpdateAccumulators& updateAccumulators = nullptr);
+
   /// Returns a cap on extra memory that may be needed when adding 'numRows'
   /// and variableLengthBytes of out-of-line variable length data.
   int64_t sizeIncrement(vector_size_t numRows, int64_t variableLengthBytes)
@@ -863,6 +879,33 @@ class RowContainer {
     }
   }
 
+  static bool allRowsNonNull(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      int32_t numRows) {
+    return std::find(rows, rows + numRows, nullptr) == rows + numRows;
+  }
+
+  // Copies the value at 'offset' in each of 'rows' to 'values' starting at
+  // 'resultOffset'. The rows are usually scattered over the row container, so
+  // the rows a few iterations ahead are prefetched.
+  template <typename T, typename Values>
+  static void gatherValues(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      int32_t numRows,
+      int32_t offset,
+      int32_t resultOffset,
+      Values& values) {
+    constexpr int32_t kPrefetchDistance = 16;
+    int32_t i = 0;
+    for (; i + kPrefetchDistance < numRows; ++i) {
+      __builtin_prefetch(rows[i + kPrefetchDistance] + offset);
+      values[resultOffset + i] = valueAt<T>(rows[i], offset);
+    }
+    for (; i < numRows; ++i) {
+      values[resultOffset + i] = valueAt<T>(rows[i], offset);
+    }
+  }
+
   template <bool useRowNumbers, typename T>
   static void extractValuesWithNulls(
       const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
@@ -880,6 +923,18 @@ class RowContainer {
     auto nulls = nullBuffer->asMutable<uint64_t>();
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     auto values = valuesBuffer->asMutableRange<T>();
+    if constexpr (!useRowNumbers && !std::is_same_v<T, StringView>) {
+      if (allRowsNonNull(rows, numRows)) {
+        // A null value is stored as T(), so the values are copied without
+        // looking at the null flags.
+        gatherValues<T>(rows, numRows, offset, resultOffset, values);
+        for (int32_t i = 0; i < numRows; ++i) {
+          bits::setNull(
+              nulls, resultOffset + i, isNullAt(rows[i], nullByte, nullMask));
+        }
+        return;
+      }
+    }
     for (int32_t i = 0; i < numRows; ++i) {
       const char* row;
       if constexpr (useRowNumbers) {
@@ -914,6 +969,15 @@ class RowContainer {
     VELOX_DCHECK_LE(maxRows, result->size());
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     auto values = valuesBuffer->asMutableRange<T>();
+    if constexpr (!useRowNumbers && !std::is_same_v<T, StringView>) {
+      if (allRowsNonNull(rows, numRows)) {
+        if (result->rawNulls() != nullptr) {
+          result->clearNulls(resultOffset, maxRows);
+        }
+        gatherValues<T>(rows, numRows, offset, resultOffset, values);
+        return;
+      }
+    }
     for (int32_t i = 0; i < numRows; ++i) {
       const char* row;
       if constexpr (useRowNumbers) {
@@ -976,8 +1040,12 @@ class RowContainer {
       return compareComplexType(row, offset, decoded, index) == 0;
     }
     if constexpr (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
-      return compareStringAsc(
-                 valueAt<StringView>(row, offset), decoded, index) == 0;
+      const auto value = valueAt<StringView>(row, offset);
+      // The size is inline, so a mismatch does not touch the string data.
+      if (value.size() != decoded.valueAt<StringView>(index).size()) {
+        return false;
+      }
+      return compareStringAsc(value, decoded, index) == 0;
     }
 
     using T = typename KindToFlatVector<Kind>::HashRowType;
@@ -1179,6 +1247,32 @@ class RowContainer {
   // complex-typed field in 'rows'.
   void freeVariableWidthFields(folly::Range<char**> rows);
 
+  // Points the variable-width fields at column 'columnIndex' of 'rows' to the
+  // new addresses of their blocks after compaction of 'stringAllocator_'.
+  template <typename FieldType>
+  void updateVariableWidthFieldsAtColumn(
+      size_t columnIndex,
+      folly::Range<char**> rows,
+      const HashStringAllocator::BlockMap& blocks) {
+    const auto column = columnAt(columnIndex);
+    for (auto row : rows) {
+      if (isNullAt(row, column.nullByte(), column.nullMask())) {
+        continue;
+      }
+      auto& view = valueAt<FieldType>(row, column.offset());
+      if constexpr (std::is_same_v<FieldType, StringView>) {
+        if (view.isInline()) {
+          continue;
+        }
+      } else {
+        if (view.empty()) {
+          continue;
+        }
+      }
+      view = FieldType(blocks.newAddress(view.data()), view.size());
+    }
+  }
+
   // Free any aggregates associated with the 'rows'.
   void freeAggregates(folly::Range<char**> rows);
 
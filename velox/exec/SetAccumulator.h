@@ -27,15 +27,27 @@ namespace facebook::velox::aggregate::prestosql {
 
 namespace detail {
 
-/// Maintains a set of unique values. Non-null values are stored in F14FastSet.
-/// A separate flag tracks presence of the null value.
+/// Maintains a set of unique values. The first kMaxSmallValues non-null
+/// values are kept in insertion order in a small array that is searched
+/// linearly. Adding one more moves the values to an F14FastMap. Both are
+/// allocated from the HashStringAllocator of the group. A separate flag
+/// tracks presence of the null value.
 template <
     typename T,
     typename Hash = std::hash<T>,
     typename EqualTo = std::equal_to<T>>
 struct SetAccumulator {
+  static constexpr int32_t kMaxSmallValues = 16;
+
   std::optional<vector_size_t> nullIndex;
 
+  /// Values in insertion order while 'uniqueValues' is empty.
+  T* smallValues{nullptr};
+  uint8_t numSmallValues{0};
+  uint8_t smallCapacity{0};
+
+  /// Maps a value to its position in the result. Empty until there are more
+  /// than kMaxSmallValues non-null values.
   folly::F14FastMap<
       T,
       int32_t,
@@ -60,15 +72,13 @@ struct SetAccumulator {
   void addValue(
       const DecodedVector& decoded,
       vector_size_t index,
-      HashStringAllocator* /*allocator*/) {
-    const auto cnt = uniqueValues.size();
+      HashStringAllocator* allocator) {
     if (decoded.isNullAt(index)) {
       if (!nullIndex.has_value()) {
-        nullIndex = cnt;
+        nullIndex = numValues();
       }
     } else {
-      uniqueValues.insert(
-          {decoded.valueAt<T>(index), nullIndex.has_value() ? cnt + 1 : cnt});
+      insert(decoded.valueAt<T>(index), allocator);
     }
   }
 
@@ -86,30 +96,120 @@ struct SetAccumulator {
     }
   }
 
+  /// Returns number of unique non-null values.
+  size_t numValues() const {
+    return uniqueValues.empty() ? numSmallValues : uniqueValues.size();
+  }
+
   /// Returns number of unique values including null.
   size_t size() const {
-    return uniqueValues.size() + (nullIndex.has_value() ? 1 : 0);
+    return numValues() + (nullIndex.has_value() ? 1 : 0);
+  }
+
+  bool contains(const T& value) const {
+    if (!uniqueValues.empty()) {
+      return uniqueValues.contains(value);
+    }
+    const auto& equalTo = uniqueValues.key_eq();
+    for (auto i = 0; i < numSmallValues; ++i) {
+      if (equalTo(smallValues[i], value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Adds a non-null value. Returns false if the value was added before.
+  bool insert(const T& value, HashStringAllocator* allocator) {
+    if (uniqueValues.empty()) {
+      if (contains(value)) {
+        return false;
+      }
+      if (numSmallValues < kMaxSmallValues) {
+        if (numSmallValues == smallCapacity) {
+          growSmallValues(allocator);
+        }
+        new (smallValues + numSmallValues) T(value);
+        ++numSmallValues;
+        return true;
+      }
+      moveSmallValues(*allocator);
+    }
+    const int32_t position = size();
+    return uniqueValues.insert({value, position}).second;
+  }
+
+  /// Calls 'func(value, position)' for each unique non-null value.
+  template <typename Func>
+  void forEach(Func func) const {
+    if (!uniqueValues.empty()) {
+      for (const auto& value : uniqueValues) {
+        func(value.first, value.second);
+      }
+      return;
+    }
+    for (auto i = 0; i < numSmallValues; ++i) {
+      func(smallValues[i], smallPosition(i));
+    }
   }
 
   /// Copies the unique values and null into the specified vector starting at
   /// the specified offset.
   vector_size_t extractValues(FlatVector<T>& values, vector_size_t offset) {
-    for (auto value : uniqueValues) {
-      values.set(offset + value.second, value.first);
-    }
+    forEach([&](const T& value, int32_t position) {
+      values.set(offset + position, value);
+    });
 
     if (nullIndex.has_value()) {
       values.setNull(offset + nullIndex.value(), true);
     }
 
-    return nullIndex.has_value() ? uniqueValues.size() + 1
-                                 : uniqueValues.size();
+    return size();
   }
 
   void free(HashStringAllocator& allocator) {
+    freeSmallValues(allocator);
     using UT = decltype(uniqueValues);
     uniqueValues.~UT();
   }
+
+ private:
+  // Returns the position in the result of the i-th small value.
+  int32_t smallPosition(int32_t i) const {
+    return nullIndex.has_value() && i >= nullIndex.value() ? i + 1 : i;
+  }
+
+  void growSmallValues(HashStringAllocator* allocator) {
+    const uint8_t newCapacity =
+        smallCapacity == 0 ? 4 : std::min(smallCapacity * 2, kMaxSmallValues);
+    auto* newValues =
+        AlignedStlAllocator<T, 16>(allocator).allocate(newCapacity);
+    for (auto i = 0; i < numSmallValues; ++i) {
+      new (newValues + i) T(smallValues[i]);
+    }
+    freeSmallValues(*allocator);
+    smallValues = newValues;
+    smallCapacity = newCapacity;
+  }
+
+  // Moves the small values to 'uniqueValues'.
+  void moveSmallValues(HashStringAllocator& allocator) {
+    uniqueValues.reserve(2 * kMaxSmallValues);
+    for (auto i = 0; i < numSmallValues; ++i) {
+      uniqueValues.insert({smallValues[i], smallPosition(i)});
+    }
+    freeSmallValues(allocator);
+    numSmallValues = 0;
+  }
+
+  void freeSmallValues(HashStringAllocator& allocator) {
+    if (smallValues != nullptr) {
+      AlignedStlAllocator<T, 16>(&allocator)
+          .deallocate(smallValues, smallCapacity);
+      smallValues = nullptr;
+      smallCapacity = 0;
+    }
+  }
 };
 
 /// Maintains a set of unique strings.
@@ -127,21 +227,19 @@ struct StringViewSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
     if (decoded.isNullAt(index)) {
       if (!base.nullIndex.has_value()) {
-        base.nullIndex = cnt;
+        base.nullIndex = base.numValues();
       }
     } else {
       auto value = decoded.valueAt<StringView>(index);
       if (!value.isInline()) {
-        if (base.uniqueValues.contains(value)) {
+        if (base.contains(value)) {
           return;
         }
         value = strings.append(value, *allocator);
       }
-      base.uniqueValues.insert(
-          {value, base.nullIndex.has_value() ? cnt + 1 : cnt});
+      base.insert(value, allocator);
     }
   }
 
@@ -170,8 +268,7 @@ struct StringViewSetAccumulator {
 
   void free(HashStringAllocator& allocator) {
     strings.free(allocator);
-    using Base = decltype(base);
-    base.~Base();
+    base.free(allocator);
   }
 };
 
@@ -197,17 +294,14 @@ struct ComplexTypeSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
     if (decoded.isNullAt(index)) {
       if (!base.nullIndex.has_value()) {
-        base.nullIndex = cnt;
+        base.nullIndex = base.numValues();
       }
     } else {
       auto entry = values.append(decoded, index, allocator);
 
-      if (!base.uniqueValues
-               .insert({entry, base.nullIndex.has_value() ? cnt + 1 : cnt})
-               .second) {
+      if (!base.insert(entry, allocator)) {
         values.removeLast(entry);
       }
     }
@@ -231,22 +325,20 @@ struct ComplexTypeSetAccumulator {
   }
 
   vector_size_t extractValues(BaseVector& values, vector_size_t offset) {
-    for (const auto& position : base.uniqueValues) {
-      AddressableNonNullValueList::read(
-          position.first, values, offset + position.second);
-    }
+    base.forEach([&](const auto& entry, int32_t position) {
+      AddressableNonNullValueList::read(entry, values, offset + position);
+    });
 
     if (base.nullIndex.has_value()) {
       values.setNull(offset + base.nullIndex.value(), true);
     }
 
-    return base.uniqueValues.size() + (base.nullIndex.has_value() ? 1 : 0);
+    return base.size();
   }
 
   void free(HashStringAllocator& allocator) {
     values.free(allocator);
-    using Base = decltype(base);
-    base.~Base();
+    base.free(allocator);
   }
 };
 
@@ -64,18 +64,25 @@ std::string memoryPoolAbortMessage(
 } // namespace
 
 SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
-    : MemoryArbitrator(config), freeCapacity_(capacity_) {
-  RECORD_METRIC_VALUE(kMetricArbitratorFreeCapacityBytes, freeCapacity_);
+    : MemoryArbitrator(config),
+      fastExponentialGrowthCapacityLimit_(
+          config.fastExponentialGrowthCapacityLimit),
+      slowCapacityGrowPct_(config.slowCapacityGrowPct),
+      fastGrowFromFreeCapacity_(config.fastGrowFromFreeCapacity),
+      freeCapacity_(capacity_) {
+  reportFreeCapacity(freeCapacity_);
   VELOX_CHECK_EQ(kind_, config.kind);
+  VELOX_CHECK_GE(slowCapacityGrowPct_, 0);
 }
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] RECLAIM_COST[{}]]",
       pool->root()->name(),
       reclaimable,
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      reclaimCost);
 }
 
 void SharedArbitrator::sortCandidatesByFreeCapacity(
@@ -112,6 +119,38 @@ void SharedArbitrator::sortCandidatesByReclaimableMemory(
       &candidates);
 }
 
+void SharedArbitrator::sortCandidatesByReclaimCost(
+    std::vector<Candidate>& candidates,
+    uint64_t targetBytes) const {
+  for (auto& candidate : candidates) {
+    if (!candidate.reclaimable) {
+      continue;
+    }
+    const auto* reclaimer = candidate.pool->reclaimer();
+    const auto info = reclaimer == nullptr
+        ? MemoryReclaimer::ReclaimCostInfo{}
+        : reclaimer->reclaimCostInfo(*candidate.pool);
+    candidate.reclaimCost = reclaimCostModel_->reclaimCost(
+        *candidate.pool, candidate.reclaimableBytes, targetBytes, info);
+  }
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const Candidate& lhs, const Candidate& rhs) {
+        if (!lhs.reclaimable || lhs.reclaimableBytes == 0) {
+          return false;
+        }
+        if (!rhs.reclaimable || rhs.reclaimableBytes == 0) {
+          return true;
+        }
+        return lhs.reclaimCost < rhs.reclaimCost;
+      });
+
+  TestValue::adjust(
+      "facebook::velox::memory::SharedArbitrator::sortCandidatesByReclaimCost",
+      &candidates);
+}
+
 const SharedArbitrator::Candidate&
 SharedArbitrator::findCandidateWithLargestCapacity(
     MemoryPool* requestor,
@@ -150,6 +189,7 @@ SharedArbitrator::findCandidateWithLargestCapacity(
 }
 
 SharedArbitrator::~SharedArbitrator() {
+  PrefetchThrottle::instance().reset();
   if (freeCapacity_ != capacity_) {
     const std::string errMsg = fmt::format(
         "\"There is unexpected free capacity not given back to arbitrator "
@@ -185,7 +225,7 @@ uint64_t SharedArbitrator::growCapacity(
     pool->grow(reserveBytes);
     freeCapacity = freeCapacity_;
   }
-  RECORD_METRIC_VALUE(kMetricArbitratorFreeCapacityBytes, freeCapacity);
+  reportFreeCapacity(freeCapacity);
   return reserveBytes;
 }
 
@@ -201,7 +241,7 @@ uint64_t SharedArbitrator::shrinkCapacity(
     incrementFreeCapacityLocked(freedBytes);
     freeCapacity = freeCapacity_;
   }
-  RECORD_METRIC_VALUE(kMetricArbitratorFreeCapacityBytes, freeCapacity);
+  reportFreeCapacity(freeCapacity);
   return freedBytes;
 }
 
@@ -225,6 +265,9 @@ bool SharedArbitrator::growCapacity(
     MemoryPool* pool,
     const std::vector<std::shared_ptr<MemoryPool>>& candidatePools,
     uint64_t targetBytes) {
+  if (tryFastGrow(pool->root(), targetBytes)) {
+    return true;
+  }
   ScopedArbitration scopedArbitration(pool, this);
   MemoryPool* requestor = pool->root();
   if (FOLLY_UNLIKELY(requestor->aborted())) {
@@ -345,7 +388,11 @@ bool SharedArbitrator::arbitrateMemory(
   const uint64_t growTarget = std::min(
       maxGrowBytes(*requestor),
       std::max(memoryPoolTransferCapacity_, targetBytes));
-  uint64_t freedBytes = decrementFreeCapacity(growTarget);
+  // Only grows ahead of the demand from the free capacity. The reclaim below
+  // is for 'growTarget'.
+  uint64_t freedBytes = decrementFreeCapacity(std::min(
+      maxGrowBytes(*requestor),
+      std::max(growTarget, growAheadBytes(*requestor))));
   if (freedBytes >= targetBytes) {
     requestor->grow(freedBytes);
     return true;
@@ -394,6 +441,55 @@ bool SharedArbitrator::arbitrateMemory(
   return true;
 }
 
+uint64_t SharedArbitrator::growAheadBytes(const MemoryPool& pool) const {
+  const uint64_t capacity = pool.capacity();
+  if (capacity < fastExponentialGrowthCapacityLimit_) {
+    return capacity;
+  }
+  return capacity * slowCapacityGrowPct_;
+}
+
+bool SharedArbitrator::tryFastGrow(
+    MemoryPool* requestor,
+    uint64_t targetBytes) {
+  if (!fastGrowFromFreeCapacity_ || requestor->aborted() ||
+      !checkCapacityGrowth(*requestor, targetBytes)) {
+    return false;
+  }
+  const uint64_t growTarget = std::min(
+      maxGrowBytes(*requestor),
+      std::max(
+          {memoryPoolTransferCapacity_,
+           targetBytes,
+           growAheadBytes(*requestor)}));
+  uint64_t freeCapacity;
+  {
+    std::unique_lock<std::mutex> l(mutex_, std::defer_lock);
+    lockWithTimer(l);
+    if (running_ || freeCapacity_ < targetBytes) {
+      return false;
+    }
+    RECORD_METRIC_VALUE(kMetricArbitratorRequestsCount);
+    ++numRequests_;
+    requestor->grow(decrementFreeCapacityLocked(growTarget));
+    ++numSucceeded_;
+    freeCapacity = freeCapacity_;
+  }
+  RECORD_METRIC_VALUE(kMetricArbitratorFastGrowCount);
+  reportFreeCapacity(freeCapacity);
+  return true;
+}
+
+void SharedArbitrator::lockWithTimer(
+    std::unique_lock<std::mutex>& lock) const {
+  uint64_t lockWaitUs{0};
+  {
+    MicrosecondTimer timer(&lockWaitUs);
+    lock.lock();
+  }
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricArbitratorLockWaitTimeUs, lockWaitUs);
+}
+
 uint64_t SharedArbitrator::reclaimFreeMemoryFromCandidates(
     std::vector<Candidate>& candidates,
     uint64_t targetBytes) {
@@ -424,8 +520,13 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
     MemoryPool* requestor,
     std::vector<Candidate>& candidates,
     uint64_t targetBytes) {
-  // Sort candidate memory pools based on their reclaimable memory.
-  sortCandidatesByReclaimableMemory(candidates);
+  // Sort candidate memory pools based on their reclaim cost if there is a
+  // cost model, otherwise based on their reclaimable memory.
+  if (reclaimCostModel_ != nullptr) {
+    sortCandidatesByReclaimCost(candidates, targetBytes);
+  } else {
+    sortCandidatesByReclaimableMemory(candidates);
+  }
 
   int64_t freedBytes{0};
   for (const auto& candidate : candidates) {
@@ -436,6 +537,9 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
     const int64_t bytesToReclaim = std::max<int64_t>(
         targetBytes - freedBytes, memoryPoolTransferCapacity_);
     VELOX_CHECK_GT(bytesToReclaim, 0);
+    VELOX_MEM_LOG(INFO) << "Reclaiming " << succinctBytes(bytesToReclaim)
+                        << " from " << candidate.toString() << " for "
+                        << requestor->name();
     freedBytes += reclaim(candidate.pool, bytesToReclaim);
     if ((freedBytes >= targetBytes) || requestor->aborted()) {
       break;
@@ -509,7 +613,7 @@ uint64_t SharedArbitrator::decrementFreeCapacity(uint64_t bytes) {
     reserveBytes = decrementFreeCapacityLocked(bytes);
     freeCapacity = freeCapacity_;
   }
-  RECORD_METRIC_VALUE(kMetricArbitratorFreeCapacityBytes, freeCapacity);
+  reportFreeCapacity(freeCapacity);
   return reserveBytes;
 }
 
@@ -527,7 +631,7 @@ void SharedArbitrator::incrementFreeCapacity(uint64_t bytes) {
     incrementFreeCapacityLocked(bytes);
     freeCapacity = freeCapacity_;
   }
-  RECORD_METRIC_VALUE(kMetricArbitratorFreeCapacityBytes, freeCapacity);
+  reportFreeCapacity(freeCapacity);
 }
 
 void SharedArbitrator::incrementFreeCapacityLocked(uint64_t bytes) {
@@ -541,6 +645,11 @@ void SharedArbitrator::incrementFreeCapacityLocked(uint64_t bytes) {
   }
 }
 
+void SharedArbitrator::reportFreeCapacity(uint64_t freeCapacity) const {
+  RECORD_METRIC_VALUE(kMetricArbitratorFreeCapacityBytes, freeCapacity);
+  PrefetchThrottle::instance().update(freeCapacity, capacity_);
+}
+
 MemoryArbitrator::Stats SharedArbitrator::stats() const {
   std::lock_guard<std::mutex> l(mutex_);
   return statsLocked();
@@ -604,7 +713,8 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
       kMetricArbitratorArbitrationTimeMs, arbitrationTimeUs / 1'000);
   addThreadLocalRuntimeStat(
       "memoryArbitrationWallNanos",
-      RuntimeCounter(arbitrationTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+      RuntimeCounter::withHistogram(
+          arbitrationTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
   arbitrator_->arbitrationTimeUs_ += arbitrationTimeUs;
   arbitrator_->finishArbitration();
 }
@@ -613,7 +723,8 @@ void SharedArbitrator::startArbitration(MemoryPool* requestor) {
   requestor->enterArbitration();
   ContinueFuture waitPromise{ContinueFuture::makeEmpty()};
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::unique_lock<std::mutex> l(mutex_, std::defer_lock);
+    lockWithTimer(l);
     RECORD_METRIC_VALUE(kMetricArbitratorRequestsCount);
     ++numRequests_;
     if (running_) {
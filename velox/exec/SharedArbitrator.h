@@ -70,6 +70,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     uint64_t reclaimableBytes{0};
     uint64_t freeBytes{0};
     MemoryPool* pool;
+    // The cost per reclaimed byte from the reclaim cost model, set when the
+    // arbitrator reclaims used memory with a cost model.
+    double reclaimCost{0};
 
     std::string toString() const;
   };
@@ -111,6 +114,13 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void sortCandidatesByReclaimableMemory(
       std::vector<Candidate>& candidates) const;
 
+  // Sets the reclaim cost of 'candidates' for reclaiming 'targetBytes' from
+  // each with 'reclaimCostModel_' and sorts them by ascending cost. The
+  // candidates without reclaimable memory go last.
+  void sortCandidatesByReclaimCost(
+      std::vector<Candidate>& candidates,
+      uint64_t targetBytes) const;
+
   void sortCandidatesByFreeCapacity(std::vector<Candidate>& candidates) const;
 
   // Finds the candidate with the largest capacity. For 'requestor', the
@@ -126,6 +136,20 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       std::vector<Candidate>& candidates,
       uint64_t targetBytes);
 
+  // Returns the capacity to grow 'pool' by ahead of its demand from the free
+  // capacity, based on 'fastExponentialGrowthCapacityLimit_' and
+  // 'slowCapacityGrowPct_'.
+  uint64_t growAheadBytes(const MemoryPool& pool) const;
+
+  // Invoked to grow 'requestor' by at least 'targetBytes' from the free
+  // capacity without the serialized memory arbitration if
+  // 'fastGrowFromFreeCapacity_' is set. Returns false if there is a running
+  // memory arbitration or not enough free capacity.
+  bool tryFastGrow(MemoryPool* requestor, uint64_t targetBytes);
+
+  // Acquires 'mutex_' with 'lock' and records the lock wait time.
+  void lockWithTimer(std::unique_lock<std::mutex>& lock) const;
+
   // Invoked to start next memory arbitration request, and it will wait for the
   // serialized execution if there is a running or other waiting arbitration
   // requests.
@@ -180,10 +204,18 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void incrementFreeCapacity(uint64_t bytes);
   void incrementFreeCapacityLocked(uint64_t bytes);
 
+  // Records the 'freeCapacity' after a change in the metrics and passes it to
+  // the PrefetchThrottle.
+  void reportFreeCapacity(uint64_t freeCapacity) const;
+
   std::string toStringLocked() const;
 
   Stats statsLocked() const;
 
+  const uint64_t fastExponentialGrowthCapacityLimit_;
+  const double slowCapacityGrowPct_;
+  const bool fastGrowFromFreeCapacity_;
+
   mutable std::mutex mutex_;
   uint64_t freeCapacity_{0};
   // Indicates if there is a running arbitration request or not.
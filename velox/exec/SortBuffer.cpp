@@ -26,13 +26,15 @@ SortBuffer::SortBuffer(
     velox::memory::MemoryPool* pool,
     tsan_atomic<bool>* nonReclaimableSection,
     const common::SpillConfig* spillConfig,
-    uint64_t spillMemoryThreshold)
+    uint64_t spillMemoryThreshold,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       spillConfig_(spillConfig),
-      spillMemoryThreshold_(spillMemoryThreshold) {
+      spillMemoryThreshold_(spillMemoryThreshold),
+      prefixSortConfig_(prefixSortConfig) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -112,19 +114,20 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
+    if (prefixSortConfig_.has_value()) {
+      PrefixSort::sort(
+          folly::Range<char**>(sortedRows_.data(), sortedRows_.size()),
+          pool_,
+          data_.get(),
+          sortCompareFlags_,
+          prefixSortConfig_.value(),
+          &prefixSortStats_);
+    } else {
+      PrefixSort::stdSort(
+          folly::Range<char**>(sortedRows_.data(), sortedRows_.size()),
+          data_.get(),
+          sortCompareFlags_);
+    }
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -176,6 +179,14 @@ std::optional<uint64_t> SortBuffer::estimateOutputRowSize() const {
   return estimatedOutputRowSize_;
 }
 
+PrefixSortStats SortBuffer::prefixSortStats() const {
+  auto stats = prefixSortStats_;
+  if (spiller_ != nullptr) {
+    stats += spiller_->prefixSortStats();
+  }
+  return stats;
+}
+
 void SortBuffer::ensureInputFits(const VectorPtr& input) {
   // Check if spilling is enabled or not.
   if (spillConfig_ == nullptr) {
@@ -389,7 +400,8 @@ void SortBuffer::getOutputWithSpill() {
 void SortBuffer::finishSpill() {
   VELOX_CHECK_NULL(spillMerger_);
   auto spillPartition = spiller_->finishSpill();
-  spillMerger_ = spillPartition.createOrderedReader(pool());
+  spillMerger_ = spillPartition.createOrderedReader(
+      pool(), spillConfig_->executor, spillConfig_->readAheadBytes);
 }
 
 } // namespace facebook::velox::exec
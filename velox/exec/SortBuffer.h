@@ -19,6 +19,7 @@
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/Spill.h"
 #include "velox/vector/BaseVector.h"
@@ -37,7 +38,9 @@ class SortBuffer {
       velox::memory::MemoryPool* pool,
       tsan_atomic<bool>* nonReclaimableSection,
       const common::SpillConfig* spillConfig = nullptr,
-      uint64_t spillMemoryThreshold = 0);
+      uint64_t spillMemoryThreshold = 0,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig =
+          std::nullopt);
 
   void addInput(const VectorPtr& input);
 
@@ -72,6 +75,10 @@ class SortBuffer {
 
   std::optional<uint64_t> estimateOutputRowSize() const;
 
+  /// Returns the prefix-sort stats of the in-memory sort and the sort of the
+  /// spill runs.
+  PrefixSortStats prefixSortStats() const;
+
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
@@ -101,6 +108,8 @@ class SortBuffer {
   //
   // NOTE: 'spillMemoryThreshold_' only applies if disk spilling is enabled.
   const uint64_t spillMemoryThreshold_;
+  // Sorts the rows with prefix-sort if set, otherwise with std::sort.
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -114,6 +123,8 @@ class SortBuffer {
   // Used to store the input data in row format.
   std::unique_ptr<RowContainer> data_;
   std::vector<char*> sortedRows_;
+  // The prefix-sort stats of the in-memory sort.
+  PrefixSortStats prefixSortStats_;
 
   // The data type of the rows stored in 'data_' and spilled on disk. The
   // sort key columns are stored first then the non-sorted data columns.
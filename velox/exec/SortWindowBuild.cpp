@@ -236,7 +236,8 @@ void SortWindowBuild::noMoreInput() {
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(pool_);
+    merge_ = spillPartition.createOrderedReader(
+        pool_, spillConfig_->executor, spillConfig_->readAheadBytes);
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -292,7 +293,7 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   if (merge_ != nullptr) {
     VELOX_CHECK(!sortedRows_.empty(), "No window partitions available")
     auto partition = folly::Range(sortedRows_.data(), sortedRows_.size());
-    return std::make_unique<WindowPartition>(
+    return std::make_shared<WindowPartition>(
         data_.get(), partition, inputColumns_, sortKeyInfo_);
   }
 
@@ -310,7 +311,7 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   auto partition = folly::Range(
       sortedRows_.data() + partitionStartRows_[currentPartition_],
       partitionSize);
-  return std::make_unique<WindowPartition>(
+  return std::make_shared<WindowPartition>(
       data_.get(), partition, inputColumns_, sortKeyInfo_);
 }
 
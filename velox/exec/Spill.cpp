@@ -76,7 +76,8 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* flushExecutor)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -89,6 +90,7 @@ SpillState::SpillState(
       fileCreateConfig_(fileCreateConfig),
       pool_(pool),
       stats_(stats),
+      flushExecutor_(flushExecutor),
       partitionWriters_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(uint32_t partition) {
@@ -126,13 +128,15 @@ uint64_t SpillState::appendToPartition(
         numSortKeys_,
         sortCompareFlags_,
         compressionKind_,
-        fmt::format("{}/{}-spill-{}", spillDir, fileNamePrefix_, partition),
+        getSpillDirPathCb_,
+        fmt::format("{}-spill-{}", fileNamePrefix_, partition),
         targetFileSize_,
         writeBufferSize_,
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        flushExecutor_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -242,12 +246,26 @@ SpillPartition::createUnorderedReader(memory::MemoryPool* pool) {
 }
 
 std::unique_ptr<TreeOfLosers<SpillMergeStream>>
-SpillPartition::createOrderedReader(memory::MemoryPool* pool) {
+SpillPartition::createOrderedReader(
+    memory::MemoryPool* pool,
+    folly::Executor* readAheadExecutor,
+    uint64_t readAheadBytes) {
+  std::shared_ptr<SpillReadAheadBudget> readAheadBudget;
+  // The read ahead allocates from 'pool' off the driver thread, so reserve
+  // its memory here where the reservation can be arbitrated.
+  if (readAheadExecutor != nullptr && readAheadBytes > 0 &&
+      pool->maybeReserve(readAheadBytes)) {
+    readAheadBudget = std::make_shared<SpillReadAheadBudget>(readAheadBytes);
+  } else {
+    readAheadExecutor = nullptr;
+  }
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(
-        FileSpillMergeStream::create(SpillReadFile::create(fileInfo, pool)));
+    streams.push_back(FileSpillMergeStream::create(
+        SpillReadFile::create(fileInfo, pool),
+        readAheadExecutor,
+        readAheadBudget));
   }
   files_.clear();
   // Check if the partition is empty or not.
@@ -257,17 +275,77 @@ SpillPartition::createOrderedReader(memory::MemoryPool* pool) {
   return std::make_unique<TreeOfLosers<SpillMergeStream>>(std::move(streams));
 }
 
+bool SpillReadAheadBudget::tryReserve(uint64_t bytes) {
+  auto used = usedBytes_.load();
+  do {
+    if (used + bytes > maxBytes_) {
+      return false;
+    }
+  } while (!usedBytes_.compare_exchange_weak(used, used + bytes));
+  return true;
+}
+
+FileSpillMergeStream::~FileSpillMergeStream() {
+  // The pending read ahead references 'spillFile_'. This is a cleanup and
+  // must not throw.
+  try {
+    finishReadAhead();
+  } catch (const std::exception&) {
+  }
+}
+
 uint32_t FileSpillMergeStream::id() const {
   return spillFile_->id();
 }
 
 void FileSpillMergeStream::nextBatch() {
   index_ = 0;
-  if (!spillFile_->nextBatch(rowVector_)) {
+  if (readAhead_ != nullptr) {
+    rowVector_ = std::move(finishReadAhead()->rows);
+  } else if (!spillFile_->nextBatch(rowVector_)) {
+    rowVector_ = nullptr;
+  }
+  if (rowVector_ == nullptr) {
     size_ = 0;
     return;
   }
   size_ = rowVector_->size();
+  maybeReadAhead();
+}
+
+void FileSpillMergeStream::maybeReadAhead() {
+  if (readAheadExecutor_ == nullptr) {
+    return;
+  }
+  VELOX_CHECK_NULL(readAhead_);
+  // The next batch is expected to be about as large as the current one.
+  const auto bytes = rowVector_->retainedSize();
+  if (!readAheadBudget_->tryReserve(bytes)) {
+    return;
+  }
+  readAheadBytes_ = bytes;
+  readAhead_ = std::make_shared<AsyncSource<ReadAheadBatch>>(
+      [spillFile = spillFile_.get()]() {
+        auto batch = std::make_unique<ReadAheadBatch>();
+        if (!spillFile->nextBatch(batch->rows)) {
+          batch->rows = nullptr;
+        }
+        return batch;
+      });
+  readAheadExecutor_->add([source = readAhead_]() { source->prepare(); });
+}
+
+std::unique_ptr<FileSpillMergeStream::ReadAheadBatch>
+FileSpillMergeStream::finishReadAhead() {
+  if (readAhead_ == nullptr) {
+    return nullptr;
+  }
+  auto readAhead = std::move(readAhead_);
+  SCOPE_EXIT {
+    readAheadBudget_->release(readAheadBytes_);
+    readAheadBytes_ = 0;
+  };
+  return readAhead->move();
 }
 
 SpillPartitionIdSet toSpillPartitionIdSet(
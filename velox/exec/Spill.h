@@ -126,22 +126,65 @@ class SpillMergeStream : public MergeStream {
   SelectivityVector rows_;
 };
 
+/// Bounds the bytes of the batches read ahead by the FileSpillMergeStreams of
+/// an ordered reader. Shared by the streams of the reader.
+class SpillReadAheadBudget {
+ public:
+  explicit SpillReadAheadBudget(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Adds 'bytes' to the used bytes if this does not exceed the budget.
+  /// Returns true if added.
+  bool tryReserve(uint64_t bytes);
+
+  void release(uint64_t bytes) {
+    VELOX_CHECK_GE(usedBytes_, bytes);
+    usedBytes_ -= bytes;
+  }
+
+  uint64_t usedBytes() const {
+    return usedBytes_;
+  }
+
+ private:
+  const uint64_t maxBytes_;
+  std::atomic<uint64_t> usedBytes_{0};
+};
+
 // A source of spilled RowVectors coming from a file.
 class FileSpillMergeStream : public SpillMergeStream {
  public:
+  /// If 'readAheadExecutor' is set, the stream reads its next batch on it
+  /// while the current batch is consumed, if the batch fits in
+  /// 'readAheadBudget'.
   static std::unique_ptr<SpillMergeStream> create(
-      std::unique_ptr<SpillReadFile> spillFile) {
-    auto* spillStream = new FileSpillMergeStream(std::move(spillFile));
+      std::unique_ptr<SpillReadFile> spillFile,
+      folly::Executor* readAheadExecutor = nullptr,
+      std::shared_ptr<SpillReadAheadBudget> readAheadBudget = nullptr) {
+    auto* spillStream = new FileSpillMergeStream(
+        std::move(spillFile), readAheadExecutor, std::move(readAheadBudget));
     spillStream->nextBatch();
     return std::unique_ptr<SpillMergeStream>(spillStream);
   }
 
+  ~FileSpillMergeStream() override;
+
   uint32_t id() const override;
 
  private:
-  explicit FileSpillMergeStream(std::unique_ptr<SpillReadFile> spillFile)
-      : spillFile_(std::move(spillFile)) {
+  // The result of a read ahead. 'rows' is nullptr at the end of the file.
+  struct ReadAheadBatch {
+    RowVectorPtr rows;
+  };
+
+  FileSpillMergeStream(
+      std::unique_ptr<SpillReadFile> spillFile,
+      folly::Executor* readAheadExecutor,
+      std::shared_ptr<SpillReadAheadBudget> readAheadBudget)
+      : spillFile_(std::move(spillFile)),
+        readAheadExecutor_(readAheadExecutor),
+        readAheadBudget_(std::move(readAheadBudget)) {
     VELOX_CHECK_NOT_NULL(spillFile_);
+    VELOX_CHECK_EQ(readAheadExecutor_ == nullptr, readAheadBudget_ == nullptr);
   }
 
   int32_t numSortKeys() const override {
@@ -154,7 +197,21 @@ class FileSpillMergeStream : public SpillMergeStream {
 
   void nextBatch() override;
 
+  // Starts reading the next batch on 'readAheadExecutor_' if the size of the
+  // current batch fits in the budget.
+  void maybeReadAhead();
+
+  // Waits for the pending read ahead and returns its budget.
+  std::unique_ptr<ReadAheadBatch> finishReadAhead();
+
   std::unique_ptr<SpillReadFile> spillFile_;
+  folly::Executor* const readAheadExecutor_;
+  const std::shared_ptr<SpillReadAheadBudget> readAheadBudget_;
+
+  // The pending read of the next batch, if any.
+  std::shared_ptr<AsyncSource<ReadAheadBatch>> readAhead_;
+  // The bytes of 'readAheadBudget_' taken by 'readAhead_'.
+  uint64_t readAheadBytes_{0};
 };
 
 /// A source of spilled RowVectors coming from a file. The spill data might not
@@ -292,9 +349,16 @@ class SpillPartition {
       memory::MemoryPool* pool);
 
   /// Invoked to create an ordered stream reader from this spill partition.
-  /// The created reader will take the ownership of the spill files.
+  /// The created reader will take the ownership of the spill files. If
+  /// 'readAheadExecutor' is set and 'readAheadBytes' is not zero, each file
+  /// stream reads its next batch on 'readAheadExecutor' while the merge
+  /// consumes the current one. 'readAheadBytes' bounds the bytes of the read
+  /// ahead batches of all streams and is reserved from 'pool' up front. There
+  /// is no read ahead if the reservation fails.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* readAheadExecutor = nullptr,
+      uint64_t readAheadBytes = 0);
 
   std::string toString() const;
 
@@ -318,7 +382,8 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'flushExecutor' is set, the partition writers serialize and
+  /// compress their write buffers on it.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -331,7 +396,8 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* flushExecutor = nullptr);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -422,6 +488,7 @@ class SpillState {
   const std::string fileCreateConfig_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const flushExecutor_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
@@ -32,8 +32,22 @@ void SpillInputStream::next(bool /*throwIfPastEnd*/) {
   const int32_t readBytes = std::min(size_ - offset_, buffer_->capacity());
   VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
   setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  file_->pread(offset_, readBytes, buffer_->asMutable<char>());
+  {
+    MicrosecondTimer timer(&readTimeUs_);
+    file_->pread(offset_, readBytes, buffer_->asMutable<char>());
+  }
   offset_ += readBytes;
+  ++numReads_;
+  readBytes_ += readBytes;
+}
+
+void SpillInputStream::takeReadStats(
+    uint64_t& reads,
+    uint64_t& readBytes,
+    uint64_t& readTimeUs) {
+  reads = std::exchange(numReads_, 0);
+  readBytes = std::exchange(readBytes_, 0);
+  readTimeUs = std::exchange(readTimeUs_, 0);
 }
 
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
@@ -83,30 +97,45 @@ SpillWriter::SpillWriter(
     const uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
-    const std::string& pathPrefix,
+    const common::GetSpillDirectoryPathCB& getSpillDirPathCb,
+    const std::string& fileNamePrefix,
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* flushExecutor)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
-      pathPrefix_(pathPrefix),
+      getSpillDirPathCb_(getSpillDirPathCb),
+      fileNamePrefix_(fileNamePrefix),
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      flushExecutor_(flushExecutor) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
+SpillWriter::~SpillWriter() {
+  // Waits for the pending flushes which reference 'this'. This is a cleanup
+  // and must not throw.
+  for (auto& pending : pendingFlushes_) {
+    try {
+      pending->move();
+    } catch (const std::exception&) {
+    }
+  }
+}
+
 SpillWriteFile* SpillWriter::ensureFile() {
   if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
     closeFile();
@@ -114,7 +143,11 @@ SpillWriteFile* SpillWriter::ensureFile() {
   if (currentFile_ == nullptr) {
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format(
+            "{}/{}-{}",
+            getSpillDirPathCb_(),
+            fileNamePrefix_,
+            finishedFiles_.size()),
         fileCreateConfig_);
   }
   return currentFile_.get();
@@ -142,30 +175,66 @@ uint64_t SpillWriter::flush() {
     return 0;
   }
 
-  auto* file = ensureFile();
-  VELOX_CHECK_NOT_NULL(file);
+  if (flushExecutor_ == nullptr) {
+    auto result = serialize(*batch_);
+    batch_.reset();
+    return writeFlushResult(*result);
+  }
+
+  std::shared_ptr<VectorStreamGroup> batch = std::move(batch_);
+  pendingFlushes_.push_back(std::make_shared<AsyncSource<FlushResult>>(
+      [this, batch]() { return serialize(*batch); }));
+  flushExecutor_->add(
+      [source = pendingFlushes_.back()]() { source->prepare(); });
+  uint64_t writtenBytes{0};
+  while (pendingFlushes_.size() > kMaxPendingFlushes) {
+    writtenBytes += writePendingFlush();
+  }
+  return writtenBytes;
+}
 
+std::unique_ptr<SpillWriter::FlushResult> SpillWriter::serialize(
+    VectorStreamGroup& batch) const {
   IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
-  uint64_t flushTimeUs{0};
+      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch.size()));
+  auto result = std::make_unique<FlushResult>();
   {
-    MicrosecondTimer timer(&flushTimeUs);
-    batch_->flush(&out);
+    MicrosecondTimer timer(&result->flushTimeUs);
+    batch.flush(&out);
   }
-  batch_.reset();
+  result->iobuf = out.getIOBuf();
+  return result;
+}
+
+uint64_t SpillWriter::writeFlushResult(FlushResult& result) {
+  auto* file = ensureFile();
+  VELOX_CHECK_NOT_NULL(file);
 
   uint64_t writeTimeUs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     MicrosecondTimer timer(&writeTimeUs);
-    writtenBytes = file->write(std::move(iobuf));
+    writtenBytes = file->write(std::move(result.iobuf));
   }
-  updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
+  updateWriteStats(writtenBytes, result.flushTimeUs, writeTimeUs);
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
 }
 
+uint64_t SpillWriter::writePendingFlush() {
+  VELOX_CHECK(!pendingFlushes_.empty());
+  auto pending = std::move(pendingFlushes_.front());
+  pendingFlushes_.pop_front();
+  auto result = pending->move();
+  return writeFlushResult(*result);
+}
+
+void SpillWriter::drainPendingFlushes() {
+  while (!pendingFlushes_.empty()) {
+    writePendingFlush();
+  }
+}
+
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
@@ -224,6 +293,7 @@ void SpillWriter::updateSpilledFileStats(uint64_t fileSize) {
 void SpillWriter::finishFile() {
   checkNotFinished();
   flush();
+  drainPendingFlushes();
   closeFile();
   VELOX_CHECK_NULL(currentFile_);
 }
@@ -311,8 +381,42 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
   if (input_->atEnd()) {
     return false;
   }
-  VectorStreamGroup::read(
-      input_.get(), pool_, type_, &rowVector, &readOptions_);
+  uint64_t batchTimeUs{0};
+  {
+    MicrosecondTimer timer(&batchTimeUs);
+    VectorStreamGroup::read(
+        input_.get(), pool_, type_, &rowVector, &readOptions_);
+  }
+  recordReadStats(batchTimeUs);
   return true;
 }
+
+void SpillReadFile::recordReadStats(uint64_t batchTimeUs) {
+  uint64_t reads;
+  uint64_t readBytes;
+  uint64_t readTimeUs;
+  input_->takeReadStats(reads, readBytes, readTimeUs);
+  // The first read happens when opening the file, outside of 'batchTimeUs'.
+  const uint64_t deserializationTimeUs =
+      batchTimeUs > readTimeUs ? batchTimeUs - readTimeUs : 0;
+  if (reads != 0) {
+    addThreadLocalRuntimeStat(
+        "spillReads", RuntimeCounter(static_cast<int64_t>(reads)));
+    addThreadLocalRuntimeStat(
+        "spillReadBytes",
+        RuntimeCounter(readBytes, RuntimeCounter::Unit::kBytes));
+    addThreadLocalRuntimeStat(
+        "spillReadTime",
+        RuntimeCounter(
+            readTimeUs * Timestamp::kNanosecondsInMicrosecond,
+            RuntimeCounter::Unit::kNanos));
+  }
+  addThreadLocalRuntimeStat(
+      "spillDeserializationTime",
+      RuntimeCounter(
+          deserializationTimeUs * Timestamp::kNanosecondsInMicrosecond,
+          RuntimeCounter::Unit::kNanos));
+  common::updateGlobalSpillReadStats(
+      reads, readBytes, readTimeUs, deserializationTimeUs);
+}
 } // namespace facebook::velox::exec
@@ -16,8 +16,12 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/F14Set.h>
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -99,13 +103,18 @@ using SpillFiles = std::vector<SpillFileInfo>;
 class SpillWriter {
  public:
   /// 'type' is a RowType describing the content. 'numSortKeys' is the number
-  /// of leading columns on which the data is sorted. 'path' is a file path
-  /// prefix. ' 'targetFileSize' is the target byte size of a single file.
+  /// of leading columns on which the data is sorted. 'getSpillDirPathCb'
+  /// returns the directory for each new file and 'fileNamePrefix' is the file
+  /// name prefix in it. 'targetFileSize' is the target byte size of a single
+  /// file.
   /// 'writeBufferSize' specifies the size limit of the buffered data before
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'flushExecutor' is set, the serialization and
+  /// compression of full write buffers runs on it, while the file writes stay
+  /// in buffer order on the calling thread. Up to 'kMaxPendingFlushes' buffers
+  /// may be in flight.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -114,13 +123,19 @@ class SpillWriter {
       const uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
-      const std::string& pathPrefix,
+      const common::GetSpillDirectoryPathCB& getSpillDirPathCb,
+      const std::string& fileNamePrefix,
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* flushExecutor = nullptr);
+
+  ~SpillWriter();
+
+  static constexpr int32_t kMaxPendingFlushes = 4;
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -145,6 +160,12 @@ class SpillWriter {
   std::vector<uint32_t> testingSpilledFileIds() const;
 
  private:
+  // A serialized write buffer to write to the file.
+  struct FlushResult {
+    std::unique_ptr<folly::IOBuf> iobuf;
+    uint64_t flushTimeUs{0};
+  };
+
   FOLLY_ALWAYS_INLINE void checkNotFinished() const {
     VELOX_CHECK(!finished_, "SpillWriter has finished");
   }
@@ -158,10 +179,24 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Writes data from 'batch_' to the current output file. If
+  // 'flushExecutor_' is set, 'batch_' is serialized in the background and only
+  // the oldest pending buffers beyond 'kMaxPendingFlushes' are written. Returns
+  // the actual written size.
   uint64_t flush();
 
+  // Serializes 'batch' into an IOBuf.
+  std::unique_ptr<FlushResult> serialize(VectorStreamGroup& batch) const;
+
+  // Writes 'result' to the current output file. Returns the written size.
+  uint64_t writeFlushResult(FlushResult& result);
+
+  // Writes the oldest pending flush. Returns the written size.
+  uint64_t writePendingFlush();
+
+  // Writes all pending flushes.
+  void drainPendingFlushes();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -178,7 +213,10 @@ class SpillWriter {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
-  const std::string pathPrefix_;
+  // Returns the directory for each new file. The files of 'this' may be in
+  // different directories, e.g. a local one first and then a remote one.
+  const common::GetSpillDirectoryPathCB getSpillDirPathCb_;
+  const std::string fileNamePrefix_;
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const std::string fileCreateConfig_;
@@ -188,10 +226,13 @@ class SpillWriter {
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const flushExecutor_;
 
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // Write buffers being serialized on 'flushExecutor_', in write order.
+  std::deque<std::shared_ptr<AsyncSource<FlushResult>>> pendingFlushes_;
   std::unique_ptr<SpillWriteFile> currentFile_;
   SpillFiles finishedFiles_;
 };
@@ -216,6 +257,11 @@ class SpillInputStream : public ByteInputStream {
     return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
   }
 
+  /// Returns the number of file reads, the read bytes and the read time since
+  /// the last call and resets them.
+  void
+  takeReadStats(uint64_t& reads, uint64_t& readBytes, uint64_t& readTimeUs);
+
  private:
   void next(bool throwIfPastEnd) override;
 
@@ -225,6 +271,11 @@ class SpillInputStream : public ByteInputStream {
 
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
+
+  // Read stats not yet taken by takeReadStats().
+  uint64_t numReads_{0};
+  uint64_t readBytes_{0};
+  uint64_t readTimeUs_{0};
 };
 
 /// Represents a spill file for read which turns the serialized spilled data on
@@ -252,6 +303,9 @@ class SpillReadFile {
     return sortCompareFlags_;
   }
 
+  /// Reads the next batch into 'rowVector'. Returns false at the end of file.
+  /// Records the read and deserialization stats in the global spill stats and
+  /// as runtime stats of the calling operator.
   bool nextBatch(RowVectorPtr& rowVector);
 
   /// Returns the file size in bytes.
@@ -274,6 +328,8 @@ class SpillReadFile {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool);
 
+  void recordReadStats(uint64_t batchTimeUs);
+
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
   const uint32_t id_;
@@ -54,7 +54,8 @@ Spiller::Spiller(
           spillConfig->compressionKind,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
       "Unexpected spiller type: {}",
@@ -166,13 +167,15 @@ Spiller::Spiller(
     common::CompressionKind compressionKind,
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig)
     : type_(type),
       container_(container),
       executor_(executor),
       bits_(bits),
       rowType_(std::move(rowType)),
       maxSpillRunRows_(maxSpillRunRows),
+      prefixSortConfig_(prefixSortConfig),
       state_(
           getSpillDirPathCb,
           updateAndCheckSpillLimitCb,
@@ -185,7 +188,8 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           &stats_,
-          fileCreateConfig) {
+          fileCreateConfig,
+          executor) {
   TestValue::adjust(
       "facebook::velox::exec::Spiller", const_cast<HashBitRange*>(&bits_));
 
@@ -336,13 +340,30 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeUs{0};
   {
     MicrosecondTimer timer(&sortTimeUs);
-    gfx::timsort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    if (prefixSortConfig_.has_value()) {
+      // An empty 'sortCompareFlags' means the default compare flags for all
+      // the keys.
+      const auto& compareFlags = state_.sortCompareFlags().empty()
+          ? std::vector<CompareFlags>(container_->keyTypes().size())
+          : state_.sortCompareFlags();
+      PrefixSortStats sortStats;
+      PrefixSort::sort(
+          folly::Range<char**>(run.rows.data(), run.rows.size()),
+          memory::spillMemoryPool(),
+          container_,
+          compareFlags,
+          prefixSortConfig_.value(),
+          &sortStats);
+      *prefixSortStats_.wlock() += sortStats;
+    } else {
+      gfx::timsort(
+          run.rows.begin(),
+          run.rows.end(),
+          [&](const char* left, const char* right) {
+            return container_->compareRows(
+                       left, right, state_.sortCompareFlags()) < 0;
+          });
+    }
     run.sorted = true;
   }
 
@@ -389,13 +410,13 @@ void Spiller::runSpill(bool lastRun) {
 
   std::vector<std::shared_ptr<AsyncSource<SpillStatus>>> writes;
   for (auto partition = 0; partition < spillRuns_.size(); ++partition) {
+    if (spillRuns_[partition].rows.empty()) {
+      continue;
+    }
     VELOX_CHECK(
         state_.isPartitionSpilled(partition),
         "Partition {} is not marked as spilled",
         partition);
-    if (spillRuns_[partition].rows.empty()) {
-      continue;
-    }
     writes.push_back(std::make_shared<AsyncSource<SpillStatus>>(
         [partition, this]() { return writeSpill(partition); }));
     if (executor_) {
@@ -502,6 +523,67 @@ void Spiller::spill(std::vector<char*>& rows) {
   checkEmptySpillRuns();
 }
 
+void Spiller::spill(const SpillPartitionNumSet& partitions) {
+  CHECK_NOT_FINALIZED();
+  VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
+  VELOX_CHECK(!partitions.empty());
+
+  for (const auto partition : partitions) {
+    if (!state_.isPartitionSpilled(partition)) {
+      state_.setPartitionSpilled(partition);
+    }
+  }
+
+  std::vector<char*> spilledRows;
+  RowContainerIterator rowIter;
+  bool lastRun{false};
+  do {
+    lastRun = fillSpillRuns(&rowIter);
+    for (auto partition = 0; partition < spillRuns_.size(); ++partition) {
+      auto& run = spillRuns_[partition];
+      if (!partitions.contains(partition)) {
+        run.clear();
+        continue;
+      }
+      spilledRows.insert(spilledRows.end(), run.rows.begin(), run.rows.end());
+    }
+    runSpill(lastRun);
+  } while (!lastRun);
+
+  checkEmptySpillRuns();
+  container_->eraseRows(
+      folly::Range<char**>(spilledRows.data(), spilledRows.size()));
+}
+
+std::vector<uint64_t> Spiller::partitionBytes() const {
+  std::vector<uint64_t> bytes(state_.maxPartitions());
+  constexpr int32_t kHashBatchSize = 4096;
+  std::vector<uint64_t> hashes(kHashBatchSize);
+  std::vector<char*> rows(kHashBatchSize);
+  const bool isSinglePartition = bits_.numPartitions() == 1;
+  RowContainerIterator rowIter;
+  for (;;) {
+    const auto numRows = container_->listRows(
+        &rowIter, rows.size(), RowContainer::kUnlimited, rows.data());
+    if (numRows == 0) {
+      break;
+    }
+    auto rowSet = folly::Range<char**>(rows.data(), numRows);
+    if (!isSinglePartition) {
+      for (auto i = 0; i < container_->keyTypes().size(); ++i) {
+        container_->hash(i, rowSet, i > 0, hashes.data());
+      }
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      const auto partition = isSinglePartition
+          ? 0
+          : bits_.partition(hashes[i], state_.maxPartitions());
+      bytes[partition] += container_->rowSize(rows[i]);
+    }
+  }
+  return bytes;
+}
+
 void Spiller::checkEmptySpillRuns() const {
   for (const auto& spillRun : spillRuns_) {
     VELOX_CHECK(spillRun.rows.empty());
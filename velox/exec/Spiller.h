@@ -18,6 +18,7 @@
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/exec/HashBitRange.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 
 namespace facebook::velox::exec {
@@ -104,6 +105,17 @@ class Spiller {
   /// container. The caller needs to erase them from the row container.
   void spill(std::vector<char*>& rows);
 
+  /// Spills the rows of 'partitions' and marks them as spilled. This is used
+  /// by 'kHashJoinBuild' spiller type to spill only a part of the build side,
+  /// so that the other partitions can be joined in memory. Unlike the other
+  /// spill methods, the spilled rows are erased from the row container since
+  /// its remaining rows stay in use.
+  void spill(const SpillPartitionNumSet& partitions);
+
+  /// Returns the byte size of the rows in the row container for each spill
+  /// partition.
+  std::vector<uint64_t> partitionBytes() const;
+
   /// Append 'spillVector' into the spill file of given 'partition'. It is now
   /// only used by the spilling operator which doesn't need data sort, such as
   /// hash join build and hash join probe.
@@ -176,6 +188,11 @@ class Spiller {
 
   common::SpillStats stats() const;
 
+  /// Returns the prefix-sort stats of sorting the spill runs.
+  PrefixSortStats prefixSortStats() const {
+    return *prefixSortStats_.rlock();
+  }
+
   std::string toString() const;
 
  private:
@@ -194,7 +211,9 @@ class Spiller {
       common::CompressionKind compressionKind,
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig =
+          std::nullopt);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
   // from row container starting at the offset pointed by 'startRowIter'.
@@ -304,6 +323,8 @@ class Spiller {
   const HashBitRange bits_;
   const RowTypePtr rowType_;
   const uint64_t maxSpillRunRows_;
+  // Sorts the spill runs with prefix-sort if set.
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
 
   // True if all rows of spilling partitions are in 'spillRuns_', so
   // that one can start reading these back. This means that the rows
@@ -312,6 +333,7 @@ class Spiller {
   bool finalized_{false};
 
   folly::Synchronized<common::SpillStats> stats_;
+  folly::Synchronized<PrefixSortStats> prefixSortStats_;
   SpillState state_;
 
   // Collects the rows to spill for each partition.
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/SplitResultCache.h"
+
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/io/Cursor.h>
+#include <folly/json.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/memory/ByteStream.h"
+#include "velox/common/serialization/Serializable.h"
+#include "velox/serializers/PrestoSerializer.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Number of results whose keys are remembered. A result is found only while
+// its key is remembered, even if its data is still in the AsyncDataCache.
+constexpr int32_t kMaxEntries = 100'000;
+
+const serializer::presto::PrestoVectorSerde::PrestoOptions& serdeOptions() {
+  static const serializer::presto::PrestoVectorSerde::PrestoOptions options{
+      true /*useLosslessTimestamp*/,
+      common::CompressionKind::CompressionKind_NONE,
+      true /*nullsFirst*/};
+  return options;
+}
+
+// Returns the ranges of the data of 'entry'.
+std::vector<ByteRange> entryRanges(cache::AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    return {ByteRange{
+        reinterpret_cast<uint8_t*>(entry.tinyData()),
+        static_cast<int32_t>(entry.size()),
+        0}};
+  }
+  std::vector<ByteRange> ranges;
+  const auto& allocation = entry.data();
+  uint64_t remaining = entry.size();
+  for (auto i = 0; i < allocation.numRuns() && remaining > 0; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto bytes = std::min<uint64_t>(run.numBytes(), remaining);
+    ranges.push_back(
+        ByteRange{run.data<uint8_t>(), static_cast<int32_t>(bytes), 0});
+    remaining -= bytes;
+  }
+  return ranges;
+}
+} // namespace
+
+SplitResultCache::Writer::Writer(
+    std::string key,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool)
+    : key_(std::move(key)), pool_(pool), batches_(pool) {
+  batches_.createStreamTree(type, 1'000, &serdeOptions());
+}
+
+bool SplitResultCache::Writer::append(const RowVectorPtr& batch) {
+  batches_.append(batch);
+  return batches_.size() <= kMaxResultBytes;
+}
+
+// static
+SplitResultCache& SplitResultCache::instance() {
+  static SplitResultCache cache(kMaxEntries);
+  return cache;
+}
+
+// static
+std::optional<std::string> SplitResultCache::fragmentKey(
+    const core::PlanNode& fragment) {
+  std::string text;
+  try {
+    text = folly::json::serialize(
+        fragment.serialize(), getSerializationOptions());
+  } catch (const std::exception&) {
+    // Some connectors do not serialize their table handles.
+    return std::nullopt;
+  }
+  uint64_t hash1 = 0;
+  uint64_t hash2 = 0;
+  folly::hash::SpookyHashV2::Hash128(text.data(), text.size(), &hash1, &hash2);
+  return fmt::format("{:016x}{:016x}", hash1, hash2);
+}
+
+bool SplitResultCache::find(
+    const std::string& key,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool,
+    std::vector<RowVectorPtr>& result) {
+  auto* cache = cache::AsyncDataCache::getInstance();
+  if (cache == nullptr) {
+    return false;
+  }
+  std::optional<Entry> entry;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    entry = entries_.get(key);
+  }
+  if (!entry.has_value()) {
+    return false;
+  }
+  const cache::RawFileCacheKey cacheKey{entry->fileId.id(), 0};
+  cache::CachePin pin;
+  try {
+    pin = cache->findOrCreate(cacheKey, entry->size);
+  } catch (const VeloxException&) {
+    return false;
+  }
+  if (pin.empty()) {
+    // Another thread is writing or loading the entry.
+    return false;
+  }
+  if (pin.checkedEntry()->isExclusive()) {
+    // The data was evicted from memory. The entry may still be on SSD.
+    auto* ssdCache = cache->ssdCache();
+    if (ssdCache == nullptr) {
+      return false;
+    }
+    auto& ssdFile = ssdCache->file(cacheKey.fileNum);
+    auto ssdPin = ssdFile.find(cacheKey);
+    if (ssdPin.empty() || ssdPin.run().size() < entry->size) {
+      return false;
+    }
+    std::vector<cache::SsdPin> ssdPins;
+    ssdPins.push_back(std::move(ssdPin));
+    std::vector<cache::CachePin> pins;
+    pins.push_back(std::move(pin));
+    try {
+      ssdFile.load(ssdPins, pins);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to load split result from SSD: " << e.what();
+      return false;
+    }
+    pin = std::move(pins[0]);
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+
+  ByteInputStream input(entryRanges(*pin.checkedEntry()));
+  result.clear();
+  while (!input.atEnd()) {
+    RowVectorPtr batch;
+    VectorStreamGroup::read(&input, pool, type, &batch, &serdeOptions());
+    if (batch->size() > 0) {
+      result.push_back(std::move(batch));
+    }
+  }
+  return true;
+}
+
+void SplitResultCache::insert(Writer& writer) {
+  auto* cache = cache::AsyncDataCache::getInstance();
+  if (cache == nullptr) {
+    return;
+  }
+  IOBufOutputStream out(
+      *writer.pool_,
+      nullptr,
+      std::max<int64_t>(64 * 1024, writer.batches_.size()));
+  writer.batches_.flush(&out);
+  const auto iobuf = out.getIOBuf();
+  const auto size = iobuf->computeChainDataLength();
+
+  StringIdLease fileId(fileIds(), writer.key_);
+  cache::CachePin pin;
+  try {
+    pin = cache->findOrCreate(cache::RawFileCacheKey{fileId.id(), 0}, size);
+  } catch (const VeloxException&) {
+    return;
+  }
+  if (pin.empty() || pin.checkedEntry()->isShared()) {
+    // The result is already cached or being cached by another thread.
+    return;
+  }
+  auto* entry = pin.checkedEntry();
+  folly::io::Cursor cursor(iobuf.get());
+  for (const auto& range : entryRanges(*entry)) {
+    cursor.pull(range.buffer, range.size);
+  }
+  entry->setExclusiveToShared();
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.add(writer.key_, Entry{std::move(fileId), size});
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/common/caching/StringIdMap.h"
+#include "velox/core/PlanNode.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::exec {
+
+/// Consumer of the output of a source operator that keeps its own result for
+/// each split of the source. The source tells the consumer where splits start
+/// and end so that the consumer can produce the result of a split before it
+/// sees the rows of the next one.
+class SplitResultListener {
+ public:
+  virtual ~SplitResultListener() = default;
+
+  /// Returns true if the consumer has produced the result of the previous
+  /// split and the source may start the next one.
+  virtual bool isReadyForSplit() const = 0;
+
+  /// Called before the source reads the split with 'dataKey', see
+  /// connector::ConnectorSplit::dataKey(). Returns true if the consumer has the
+  /// result of the split, in which case the source skips the split.
+  virtual bool startSplit(const std::optional<std::string>& dataKey) = 0;
+
+  /// Called after the source produced the last row of the split passed to the
+  /// previous startSplit(). 'cacheable' is false if the rows depend on more
+  /// than the split and the plan, e.g. on dynamic filters.
+  virtual void finishSplit(bool cacheable) = 0;
+};
+
+/// Keeps the results of plan fragments over single splits in the process-wide
+/// AsyncDataCache, e.g. the output of a partial aggregation over a table scan.
+/// The results are serialized like spill files and are stored under synthetic
+/// file ids, so that they are evicted and written to the SsdCache like file
+/// data. A result is keyed on the fragment and on the data key of the split.
+class SplitResultCache {
+ public:
+  /// Largest serialized result that is cached.
+  static constexpr uint64_t kMaxResultBytes = 16 << 20;
+
+  /// Accumulates the result of a fragment over one split.
+  class Writer {
+   public:
+    Writer(std::string key, const RowTypePtr& type, memory::MemoryPool* pool);
+
+    /// Appends 'batch' to the result. Returns false if the result became too
+    /// large to cache.
+    bool append(const RowVectorPtr& batch);
+
+   private:
+    friend class SplitResultCache;
+
+    const std::string key_;
+    memory::MemoryPool* const pool_;
+    VectorStreamGroup batches_;
+  };
+
+  explicit SplitResultCache(int32_t maxEntries) : entries_(maxEntries) {}
+
+  /// Returns the cache used by all queries of the process.
+  static SplitResultCache& instance();
+
+  /// Returns a digest of 'fragment' for use in makeKey(), or std::nullopt if
+  /// 'fragment' cannot be serialized.
+  static std::optional<std::string> fragmentKey(const core::PlanNode& fragment);
+
+  /// Returns the key of the result of the fragment with 'fragmentKey' over the
+  /// split with 'dataKey'.
+  static std::string makeKey(
+      const std::string& fragmentKey,
+      const std::string& dataKey) {
+    return fmt::format("split-result:{}:{}", fragmentKey, dataKey);
+  }
+
+  /// Returns true and sets 'result' to the batches stored for 'key'. Returns
+  /// false if there is no AsyncDataCache or the result is neither in memory
+  /// nor on SSD.
+  bool find(
+      const std::string& key,
+      const RowTypePtr& type,
+      memory::MemoryPool* pool,
+      std::vector<RowVectorPtr>& result);
+
+  /// Stores the result accumulated in 'writer'. Does nothing if there is no
+  /// AsyncDataCache or it has no space.
+  void insert(Writer& writer);
+
+ private:
+  struct Entry {
+    // Keeps the id of the synthetic file of the result stable.
+    StringIdLease fileId;
+    uint64_t size;
+  };
+
+  std::mutex mutex_;
+  SimpleLRUCache<std::string, Entry> entries_;
+};
+
+} // namespace facebook::velox::exec
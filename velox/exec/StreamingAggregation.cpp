@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/StreamingAggregation.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox::exec {
 
@@ -112,6 +113,69 @@ bool equalKeys(
 
   return true;
 }
+
+// Minimum average number of rows per group in a batch for updating the
+// accumulators once per group.
+constexpr vector_size_t kMinAverageRunLength = 16;
+
+// Sets the bits of 'boundaries' for the rows in (begin, end) whose value
+// differs from the value of the previous row.
+template <typename T>
+void setFlatBoundaries(
+    const T* values,
+    vector_size_t begin,
+    vector_size_t end,
+    uint64_t* boundaries) {
+  using Batch = xsimd::batch<T>;
+  auto row = begin + 1;
+  for (; row + static_cast<vector_size_t>(Batch::size) <= end;
+       row += Batch::size) {
+    uint64_t mask = simd::toBitMask(
+        Batch::load_unaligned(values + row) !=
+        Batch::load_unaligned(values + row - 1));
+    while (mask) {
+      bits::setBit(boundaries, row + __builtin_ctzll(mask));
+      mask &= mask - 1;
+    }
+  }
+  for (; row < end; ++row) {
+    if (values[row] != values[row - 1]) {
+      bits::setBit(boundaries, row);
+    }
+  }
+}
+
+// Calls setFlatBoundaries() if 'decoded' is a flat integer vector without
+// nulls. Returns true without setting bits if 'decoded' is constant. Returns
+// false otherwise.
+bool addFlatBoundaries(
+    const DecodedVector& decoded,
+    vector_size_t begin,
+    vector_size_t end,
+    uint64_t* boundaries) {
+  if (decoded.isConstantMapping()) {
+    return true;
+  }
+  if (!decoded.isIdentityMapping() || decoded.mayHaveNulls()) {
+    return false;
+  }
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      setFlatBoundaries(decoded.data<int8_t>(), begin, end, boundaries);
+      return true;
+    case TypeKind::SMALLINT:
+      setFlatBoundaries(decoded.data<int16_t>(), begin, end, boundaries);
+      return true;
+    case TypeKind::INTEGER:
+      setFlatBoundaries(decoded.data<int32_t>(), begin, end, boundaries);
+      return true;
+    case TypeKind::BIGINT:
+      setFlatBoundaries(decoded.data<int64_t>(), begin, end, boundaries);
+      return true;
+    default:
+      return false;
+  }
+}
 } // namespace
 
 char* StreamingAggregation::startNewGroup(vector_size_t index) {
@@ -197,26 +261,79 @@ void StreamingAggregation::assignGroups() {
     }
   }
 
+  runStarts_.clear();
+  if (index > 0) {
+    runStarts_.push_back(0);
+  }
+
   if (index < numInput) {
     for (auto i = 0; i < groupingKeys_.size(); ++i) {
       decodedKeys_[i].decode(*input_->childAt(groupingKeys_[i]), inputRows_);
     }
+    findGroupBoundaries(index, numInput);
+
+    auto* group = startNewGroup(index);
+    runStarts_.push_back(index);
+    bits::forEachSetBit(
+        groupBoundaries_.data(), index + 1, numInput, [&](auto row) {
+          std::fill(
+              inputGroups_.begin() + runStarts_.back(),
+              inputGroups_.begin() + row,
+              group);
+          group = startNewGroup(row);
+          runStarts_.push_back(row);
+        });
+    std::fill(
+        inputGroups_.begin() + runStarts_.back(), inputGroups_.end(), group);
+  }
+}
 
-    auto* newGroup = startNewGroup(index);
-    inputGroups_[index] = newGroup;
-
-    for (auto i = index + 1; i < numInput; ++i) {
-      if (equalKeys(groupingKeys_, input_, index, input_, i)) {
-        inputGroups_[i] = inputGroups_[index];
-      } else {
-        newGroup = startNewGroup(i);
-        inputGroups_[i] = newGroup;
-        index = i;
+void StreamingAggregation::findGroupBoundaries(
+    vector_size_t begin,
+    vector_size_t end) {
+  groupBoundaries_.resize(bits::nwords(end));
+  std::fill(groupBoundaries_.begin(), groupBoundaries_.end(), 0);
+  auto* boundaries = groupBoundaries_.data();
+  for (auto i = 0; i < groupingKeys_.size(); ++i) {
+    if (addFlatBoundaries(decodedKeys_[i], begin, end, boundaries)) {
+      continue;
+    }
+    const auto& key = input_->childAt(groupingKeys_[i]);
+    for (auto row = begin + 1; row < end; ++row) {
+      if (!bits::isBitSet(boundaries, row) &&
+          !key->equalValueAt(key.get(), row, row - 1)) {
+        bits::setBit(boundaries, row);
       }
     }
   }
 }
 
+bool StreamingAggregation::aggregateRuns() const {
+  return input_->size() >=
+      kMinAverageRunLength * static_cast<vector_size_t>(runStarts_.size());
+}
+
+void StreamingAggregation::addRunInput(
+    const AggregateInfo& aggregate,
+    const std::vector<VectorPtr>& args) {
+  const auto numInput = input_->size();
+  runRows_.resizeFill(numInput, false);
+  for (auto i = 0; i < runStarts_.size(); ++i) {
+    const auto begin = runStarts_[i];
+    const auto end = i + 1 < runStarts_.size() ? runStarts_[i + 1] : numInput;
+    runRows_.setValidRange(begin, end, true);
+    runRows_.updateBounds();
+    if (isRawInput(step_)) {
+      aggregate.function->addSingleGroupRawInput(
+          inputGroups_[begin], runRows_, args, false);
+    } else {
+      aggregate.function->addSingleGroupIntermediateResults(
+          inputGroups_[begin], runRows_, args, false);
+    }
+    runRows_.setValidRange(begin, end, false);
+  }
+}
+
 const SelectivityVector& StreamingAggregation::getSelectivityVector(
     size_t aggregateIndex) const {
   auto* rows = masks_->activeRows(aggregateIndex);
@@ -255,7 +372,9 @@ void StreamingAggregation::evaluateAggregates() {
       }
     }
 
-    if (isRawInput(step_)) {
+    if (rows.isAllSelected() && aggregateRuns()) {
+      addRunInput(aggregate, args);
+    } else if (isRawInput(step_)) {
       function->addRawInput(inputGroups_.data(), rows, args, false);
     } else {
       function->addIntermediateResults(inputGroups_.data(), rows, args, false);
@@ -70,6 +70,21 @@ class StreamingAggregation : public Operator {
   // assignments in inputGroups_.
   void assignGroups();
 
+  // Sets the bits of 'groupBoundaries_' for the rows in (begin, end) of
+  // 'input_' whose grouping keys differ from the previous row. Compares flat
+  // integer keys without nulls with SIMD.
+  void findGroupBoundaries(vector_size_t begin, vector_size_t end);
+
+  // Returns true if the runs of rows that belong to the same group in 'input_'
+  // are long enough to update each group once per run rather than per row.
+  bool aggregateRuns() const;
+
+  // Adds the input of the run of each group in 'input_' with a single group
+  // update.
+  void addRunInput(
+      const AggregateInfo& aggregate,
+      const std::vector<VectorPtr>& args);
+
   // Add input data to accumulators.
   void evaluateAggregates();
 
@@ -120,6 +135,15 @@ class StreamingAggregation : public Operator {
   // A subset of input rows to evaluate the aggregate function on. Rows
   // where aggregation mask is false are excluded.
   SelectivityVector inputRows_;
+
+  // Bits set for the rows of 'input_' that start a new group.
+  std::vector<uint64_t> groupBoundaries_;
+
+  // The first row of each run of rows of 'input_' that belong to one group.
+  std::vector<vector_size_t> runStarts_;
+
+  // The rows of one run. Used for single group updates.
+  SelectivityVector runRows_;
 };
 
 } // namespace facebook::velox::exec
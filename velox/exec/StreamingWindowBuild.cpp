@@ -22,8 +22,10 @@ StreamingWindowBuild::StreamingWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
-    tsan_atomic<bool>* nonReclaimableSection)
-    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection) {}
+    tsan_atomic<bool>* nonReclaimableSection,
+    bool streamRows)
+    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection),
+      streamRows_(streamRows) {}
 
 void StreamingWindowBuild::buildNextPartition() {
   partitionStartRows_.push_back(sortedRows_.size());
@@ -31,6 +33,13 @@ void StreamingWindowBuild::buildNextPartition() {
   inputRows_.clear();
 }
 
+void StreamingWindowBuild::addPartialPartitionRows() {
+  if (!inputRows_.empty()) {
+    inputPartition_->addRows(inputRows_);
+    inputRows_.clear();
+  }
+}
+
 void StreamingWindowBuild::addInput(RowVectorPtr input) {
   for (auto i = 0; i < inputChannels_.size(); ++i) {
     decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
@@ -45,15 +54,39 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
 
     if (previousRow_ != nullptr &&
         compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
-      buildNextPartition();
+      if (streamRows_) {
+        addPartialPartitionRows();
+        inputPartition_->setComplete();
+        inputPartition_ = nullptr;
+      } else {
+        buildNextPartition();
+      }
+    }
+
+    if (streamRows_ && inputPartition_ == nullptr) {
+      inputPartition_ = std::make_shared<WindowPartition>(
+          data_.get(), inputColumns_, sortKeyInfo_);
+      partialPartitions_.push_back(inputPartition_);
     }
 
     inputRows_.push_back(newRow);
     previousRow_ = newRow;
   }
+
+  if (streamRows_) {
+    addPartialPartitionRows();
+  }
 }
 
 void StreamingWindowBuild::noMoreInput() {
+  if (streamRows_) {
+    if (inputPartition_ != nullptr) {
+      inputPartition_->setComplete();
+      inputPartition_ = nullptr;
+    }
+    return;
+  }
+
   buildNextPartition();
 
   // Help for last partition related calculations.
@@ -89,11 +122,14 @@ std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
       sortedRows_.data() + partitionStartRows_[currentPartition_],
       partitionSize);
 
-  return std::make_unique<WindowPartition>(
+  return std::make_shared<WindowPartition>(
       data_.get(), partition, inputColumns_, sortKeyInfo_);
 }
 
 bool StreamingWindowBuild::hasNextPartition() {
+  if (streamRows_) {
+    return !partialPartitions_.empty();
+  }
   return partitionStartRows_.size() > 0 &&
       currentPartition_ < int(partitionStartRows_.size() - 2);
 }
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/WindowBuild.h"
 
 namespace facebook::velox::exec {
@@ -24,13 +26,18 @@ namespace facebook::velox::exec {
 /// {partition keys + order by keys}. The logic identifies partition changes
 /// when receiving input rows and splits out WindowPartitions for the Window
 /// operator to process.
+/// If 'streamRows' is true, the partitions are partial WindowPartitions that
+/// are returned as soon as their first rows are received and get their rows
+/// as the input arrives. This is used when all the window functions support
+/// streaming, so that a partition does not need to be held in memory in full.
 class StreamingWindowBuild : public WindowBuild {
  public:
   StreamingWindowBuild(
       const std::shared_ptr<const core::WindowNode>& windowNode,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
-      tsan_atomic<bool>* nonReclaimableSection);
+      tsan_atomic<bool>* nonReclaimableSection,
+      bool streamRows = false);
 
   void addInput(RowVectorPtr input) override;
 
@@ -46,9 +53,14 @@ class StreamingWindowBuild : public WindowBuild {
 
   bool hasNextPartition() override;
 
-  std::unique_ptr<WindowPartition> nextPartition() override;
+  std::shared_ptr<WindowPartition> nextPartition() override;
 
   bool needsInput() override {
+    if (streamRows_) {
+      // No complete partition is waiting to be output.
+      return partialPartitions_.empty() ||
+          !partialPartitions_.front()->complete();
+    }
     // No partitions are available or the currentPartition is the last available
     // one, so can consume input rows.
     return partitionStartRows_.size() == 0 ||
@@ -58,6 +70,11 @@ class StreamingWindowBuild : public WindowBuild {
  private:
   void buildNextPartition();
 
+  // Adds 'inputRows_' to the partial partition that receives the rows.
+  void addPartialPartitionRows();
+
+  const bool streamRows_;
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // Rows are erased from data_ when they are output from the
   // Window operator.
@@ -77,6 +94,18 @@ class StreamingWindowBuild : public WindowBuild {
   // Current partition being output. Used to construct WindowPartitions
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
+
+  // Partial partitions that are not yet returned by nextPartition(), used if
+  // 'streamRows_' is true. Only the last one can be incomplete.
+  std::deque<std::shared_ptr<WindowPartition>> partialPartitions_;
+
+  // Partial partition that receives the input rows. nullptr before the first
+  // row and after noMoreInput().
+  std::shared_ptr<WindowPartition> inputPartition_;
+
+  // Partial partition returned by the last nextPartition() call. Its rows are
+  // erased when the next partition is returned.
+  std::shared_ptr<WindowPartition> outputPartition_;
 };
 
 } // namespace facebook::velox::exec
@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/SplitResultCache.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
@@ -88,6 +90,12 @@ RowVectorPtr TableScan::getOutput() {
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
+      if (splitResultListener_ != nullptr &&
+          !splitResultListener_->isReadyForSplit()) {
+        // The consumer produces the result of the previous split first.
+        return nullptr;
+      }
+
       exec::Split split;
       curStatus_ = "getOutput: task->getSplitOrFuture";
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
@@ -139,6 +147,19 @@ RowVectorPtr TableScan::getOutput() {
           connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (splitResultListener_ != nullptr &&
+          splitResultListener_->startSplit(
+              pendingDynamicFilters_.empty() ? connectorSplit->dataKey()
+                                             : std::nullopt)) {
+        // The consumer has the result of the split, so the split is not read.
+        if (connectorSplit->dataSource != nullptr) {
+          connectorSplit->dataSource->close();
+        }
+        driverCtx_->task->splitFinished(true, currentSplitWeight_);
+        needNewSplit_ = true;
+        return nullptr;
+      }
+
       if (!dataSource_) {
         curStatus_ = "getOutput: creating dataSource_";
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
@@ -151,6 +172,12 @@ RowVectorPtr TableScan::getOutput() {
         for (const auto& entry : pendingDynamicFilters_) {
           dataSource_->addDynamicFilter(entry.first, entry.second);
         }
+        if (limit_.has_value()) {
+          dataSource_->setLimit(limit_.value());
+        }
+        if (statisticsAggregation_) {
+          dataSource_->setStatisticsAggregation(statisticsAggregation_);
+        }
       }
 
       debugString_ = fmt::format(
@@ -268,6 +295,9 @@ RowVectorPtr TableScan::getOutput() {
     curStatus_ = "getOutput: task->splitFinished";
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
     needNewSplit_ = true;
+    if (splitResultListener_ != nullptr) {
+      splitResultListener_->finishSplit(pendingDynamicFilters_.empty());
+    }
   }
 }
 
@@ -286,6 +316,7 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
            split->connectorId, planNodeId(), connectorPool_),
        task = operatorCtx_->task(),
        pendingDynamicFilters = pendingDynamicFilters_,
+       statisticsAggregation = statisticsAggregation_,
        split]() -> std::unique_ptr<connector::DataSource> {
         if (task->isCancelled()) {
           return nullptr;
@@ -305,6 +336,9 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
         for (const auto& entry : pendingDynamicFilters) {
           ptr->addDynamicFilter(entry.first, entry.second);
         }
+        if (statisticsAggregation) {
+          ptr->setStatisticsAggregation(statisticsAggregation);
+        }
         ptr->addSplit(split);
         return ptr;
       });
@@ -312,13 +346,18 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
 
 void TableScan::checkPreload() {
   auto executor = connector_->executor();
+  // With a limit the next splits are usually not needed, so they are not
+  // preloaded.
   if (maxSplitPreloadPerDriver_ == 0 || !executor ||
-      !connector_->supportsSplitPreload()) {
+      !connector_->supportsSplitPreload() || limit_.has_value()) {
     return;
   }
   if (dataSource_->allPrefetchIssued()) {
-    maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-        maxSplitPreloadPerDriver_;
+    // Fewer splits are preloaded when the memory arbitrator is short of free
+    // capacity.
+    maxPreloadedSplits_ = memory::PrefetchThrottle::instance().scale(
+        driverCtx_->task->numDrivers(driverCtx_->driver) *
+        maxSplitPreloadPerDriver_);
     if (!splitPreloader_) {
       splitPreloader_ =
           [executor,
@@ -348,4 +387,25 @@ void TableScan::addDynamicFilter(
   pendingDynamicFilters_.emplace(outputChannel, filter);
 }
 
+void TableScan::addLimit(uint64_t numRows) {
+  VELOX_CHECK_NULL(dataSource_, "Limit must be added before the first split");
+  limit_ = numRows;
+}
+
+void TableScan::addStatisticsAggregation(
+    const std::shared_ptr<const connector::StatisticsAggregation>&
+        aggregation) {
+  VELOX_CHECK_NULL(
+      dataSource_,
+      "Statistics aggregation must be added before the first split");
+  statisticsAggregation_ = aggregation;
+}
+
+void TableScan::addSplitResultListener(SplitResultListener* listener) {
+  VELOX_CHECK_NULL(
+      dataSource_,
+      "Split result listener must be added before the first split");
+  splitResultListener_ = listener;
+}
+
 } // namespace facebook::velox::exec
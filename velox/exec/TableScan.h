@@ -49,6 +49,26 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  bool canAddLimit() const override {
+    return true;
+  }
+
+  void addLimit(uint64_t numRows) override;
+
+  bool canAddStatisticsAggregation() const override {
+    return true;
+  }
+
+  void addStatisticsAggregation(
+      const std::shared_ptr<const connector::StatisticsAggregation>&
+          aggregation) override;
+
+  bool canAddSplitResultListener() const override {
+    return true;
+  }
+
+  void addSplitResultListener(SplitResultListener* listener) override;
+
   /// Returns process-wide cumulative IO wait time for all table
   /// scan. This is the blocked time. If running entirely from memory
   /// this would be 0.
@@ -89,6 +109,16 @@ class TableScan : public SourceOperator {
   // Dynamic filters to add to the data source when it gets created.
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       pendingDynamicFilters_;
+  // Number of rows used by the downstream Limit. Passed to the data source
+  // when it gets created.
+  std::optional<uint64_t> limit_;
+  // Aggregation that consumes the output. Passed to the data sources when
+  // they get created.
+  std::shared_ptr<const connector::StatisticsAggregation>
+      statisticsAggregation_;
+  // Consumer that keeps its results per split. Told where each split starts
+  // and ends.
+  SplitResultListener* splitResultListener_{nullptr};
 
   int32_t maxPreloadedSplits_{0};
 
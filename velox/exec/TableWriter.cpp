@@ -253,6 +253,22 @@ void TableWriter::updateStats(const connector::DataSink::Stats& stats) {
     }
     lockedStats->addRuntimeStat(
         "numWrittenFiles", RuntimeCounter(stats.numWrittenFiles));
+    if (stats.clusteringSelectivity > 0) {
+      lockedStats->addRuntimeStat(
+          "clusteringSelectivityPct",
+          RuntimeCounter(static_cast<int64_t>(
+              std::ceil(stats.clusteringSelectivity * 100))));
+    }
+    if (stats.numMemoryFlushes > 0) {
+      lockedStats->addRuntimeStat(
+          "numWriterMemoryFlushes", RuntimeCounter(stats.numMemoryFlushes));
+    }
+    if (stats.closeTimeUs > 0) {
+      lockedStats->addRuntimeStat(
+          "dataSinkCloseWallNanos",
+          RuntimeCounter(
+              stats.closeTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+    }
   }
   if (!stats.spillStats.empty()) {
     recordSpillStats(stats.spillStats);
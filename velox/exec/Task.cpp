@@ -21,6 +21,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Exchange.h"
@@ -245,6 +246,25 @@ std::shared_ptr<Task> Task::create(
   return task;
 }
 
+std::shared_ptr<Task> Task::create(
+    const std::string& taskId,
+    std::shared_ptr<const PreparedPlanFragment> preparedPlan,
+    int destination,
+    std::shared_ptr<core::QueryCtx> queryCtx,
+    ConsumerSupplier consumerSupplier,
+    std::function<void(std::exception_ptr)> onError) {
+  VELOX_CHECK_NOT_NULL(preparedPlan);
+  auto task = Task::create(
+      taskId,
+      preparedPlan->planFragment(),
+      destination,
+      std::move(queryCtx),
+      std::move(consumerSupplier),
+      std::move(onError));
+  task->preparedPlan_ = std::move(preparedPlan);
+  return task;
+}
+
 Task::Task(
     const std::string& taskId,
     core::PlanFragment planFragment,
@@ -333,37 +353,56 @@ bool Task::allNodesReceivedNoMoreSplitsMessageLocked() const {
 
 const std::string& Task::getOrCreateSpillDirectory() {
   VELOX_CHECK(!spillDirectory_.empty(), "Spill directory not set");
-  if (spillDirectoryCreated_) {
-    return spillDirectory_;
+  if (!overflowSpillDirectory_.empty() &&
+      spilledBytes_ >= spillDirectoryMaxBytes_) {
+    return getOrCreateSpillDirectory(
+        overflowSpillDirectory_, overflowSpillDirectoryCreated_);
+  }
+  return getOrCreateSpillDirectory(spillDirectory_, spillDirectoryCreated_);
+}
+
+const std::string& Task::getOrCreateSpillDirectory(
+    const std::string& directory,
+    std::atomic<bool>& created) {
+  if (created) {
+    return directory;
   }
 
   std::lock_guard<std::mutex> l(spillDirCreateMutex_);
-  if (spillDirectoryCreated_) {
-    return spillDirectory_;
+  if (created) {
+    return directory;
   }
   try {
-    auto fileSystem = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fileSystem->mkdir(spillDirectory_);
+    auto fileSystem = filesystems::getFileSystem(directory, nullptr);
+    fileSystem->mkdir(directory);
   } catch (const std::exception& e) {
     VELOX_FAIL(
         "Failed to create spill directory '{}' for Task {}: {}",
-        spillDirectory_,
+        directory,
         taskId(),
         e.what());
   }
-  spillDirectoryCreated_ = true;
-  return spillDirectory_;
+  created = true;
+  return directory;
 }
 
 void Task::removeSpillDirectoryIfExists() {
-  if (spillDirectory_.empty() || !spillDirectoryCreated_) {
+  removeSpillDirectoryIfExists(spillDirectory_, spillDirectoryCreated_);
+  removeSpillDirectoryIfExists(
+      overflowSpillDirectory_, overflowSpillDirectoryCreated_);
+}
+
+void Task::removeSpillDirectoryIfExists(
+    const std::string& directory,
+    const std::atomic<bool>& created) {
+  if (directory.empty() || !created) {
     return;
   }
   try {
-    auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fs->rmdir(spillDirectory_);
+    auto fs = filesystems::getFileSystem(directory, nullptr);
+    fs->rmdir(directory);
   } catch (const std::exception& e) {
-    LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
+    LOG(ERROR) << "Failed to remove spill directory '" << directory
                << "' for Task " << taskId() << ": " << e.what();
   }
 }
@@ -538,8 +577,16 @@ RowVectorPtr Task::next(ContinueFuture* future) {
         "callback");
 
     taskStats_.executionStartTimeMs = getCurrentTimeMs();
-    LocalPlanner::plan(
-        planFragment_, nullptr, &driverFactories_, queryCtx_->queryConfig(), 1);
+    if (preparedPlan_ != nullptr && preparedPlan_->maxDrivers() == 1) {
+      driverFactories_ = preparedPlan_->makeDriverFactories(nullptr);
+    } else {
+      LocalPlanner::plan(
+          planFragment_,
+          nullptr,
+          &driverFactories_,
+          queryCtx_->queryConfig(),
+          1);
+    }
     exchangeClients_.resize(driverFactories_.size());
 
     // In Task::next() we always assume ungrouped execution.
@@ -677,12 +724,16 @@ void Task::createDriverFactoriesLocked(uint32_t maxDrivers) {
   VELOX_CHECK(driverFactories_.empty());
 
   // Create driver factories.
-  LocalPlanner::plan(
-      planFragment_,
-      consumerSupplier(),
-      &driverFactories_,
-      queryCtx_->queryConfig(),
-      maxDrivers);
+  if (preparedPlan_ != nullptr && preparedPlan_->maxDrivers() == maxDrivers) {
+    driverFactories_ = preparedPlan_->makeDriverFactories(consumerSupplier());
+  } else {
+    LocalPlanner::plan(
+        planFragment_,
+        consumerSupplier(),
+        &driverFactories_,
+        queryCtx_->queryConfig(),
+        maxDrivers);
+  }
 
   // Calculates total number of drivers and create pipeline stats.
   for (auto& factory : driverFactories_) {
@@ -756,13 +807,8 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx()->executor()));
     // We might have first slots taken for grouped execution drivers, so need
     // only to enqueue the ungrouped execution drivers.
-    for (auto it = drivers_.end() - numDriversUngrouped_; it != drivers_.end();
-         ++it) {
-      if (*it) {
-        ++numRunningDrivers_;
-        Driver::enqueue(*it);
-      }
-    }
+    startDriversLocked(std::vector<std::shared_ptr<Driver>>(
+        drivers_.end() - numDriversUngrouped_, drivers_.end()));
   }
 
   // As some splits for grouped execution could have been added before the
@@ -772,6 +818,114 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   }
 }
 
+void Task::startDriversLocked(
+    const std::vector<std::shared_ptr<Driver>>& drivers) {
+  const auto maxInitialDrivers =
+      queryCtx_->queryConfig().maxInitialDriversPerPipeline();
+  for (const auto& driver : drivers) {
+    if (driver == nullptr) {
+      continue;
+    }
+    const auto* ctx = driver->driverCtx();
+    const auto& factory = *driverFactories_[ctx->pipelineId];
+    auto& pipelineStats = taskStats_.pipelineStats[ctx->pipelineId];
+    // A LocalMerge or a MergeJoin reads all its sources in lockstep and would
+    // wait for a deferred Driver that waits for queued input.
+    const bool deferrable = maxInitialDrivers > 0 &&
+        factory.numDrivers > maxInitialDrivers &&
+        std::dynamic_pointer_cast<const core::TableScanNode>(
+            factory.planNodes.front()) != nullptr &&
+        std::dynamic_pointer_cast<const core::LocalMergeNode>(
+            factory.consumerNode) == nullptr &&
+        std::dynamic_pointer_cast<const core::MergeJoinNode>(
+            factory.consumerNode) == nullptr;
+    if (deferrable && ctx->partitionId >= maxInitialDrivers) {
+      auto& deferred = deferredDrivers_[factory.leafNodeId()];
+      deferred.pipelineId = ctx->pipelineId;
+      driver->state().isDeferred = true;
+      deferred.drivers.push_back(driver);
+      continue;
+    }
+    if (deferrable) {
+      ++deferredDrivers_[factory.leafNodeId()].numStarted;
+    }
+    ++pipelineStats.numInitialDrivers;
+    ++numRunningDrivers_;
+    Driver::enqueue(driver);
+  }
+}
+
+void Task::maybeStartDeferredDriversLocked(
+    const core::PlanNodeId& planNodeId,
+    const SplitsStore& splitsStore) {
+  auto it = deferredDrivers_.find(planNodeId);
+  if (it == deferredDrivers_.end() || it->second.drivers.empty() ||
+      !isRunningLocked()) {
+    return;
+  }
+  auto& deferred = it->second;
+  auto& pipelineStats = taskStats_.pipelineStats[deferred.pipelineId];
+  auto start = [&]() {
+    auto driver = std::move(deferred.drivers.front());
+    deferred.drivers.pop_front();
+    driver->state().isDeferred = false;
+    ++deferred.numStarted;
+    ++numRunningDrivers_;
+    if (!pauseRequested_) {
+      // A paused task starts the Driver on resume.
+      Driver::enqueue(std::move(driver));
+    }
+  };
+
+  if (splitsStore.splits.empty()) {
+    if (!splitsStore.noMoreSplits) {
+      return;
+    }
+    // The deferred Drivers find no splits and finish right away. The task
+    // waits for them, e.g. in the barriers of a hash build.
+    while (!deferred.drivers.empty()) {
+      start();
+      ++pipelineStats.numDriversStartedAtEnd;
+    }
+    return;
+  }
+
+  if (splitsStore.splits.size() <= deferred.numStarted) {
+    // The started Drivers take the queued splits in their next round.
+    return;
+  }
+  if (localExchangeOutputBackedUpLocked(
+          *driverFactories_[deferred.pipelineId])) {
+    ++pipelineStats.numDriverAddsSkippedForOutput;
+    return;
+  }
+  // A paused task is typically being reclaimed from. A throttled prefetch
+  // means that the arbitrator is short of free capacity.
+  if (pauseRequested_ ||
+      memory::PrefetchThrottle::instance().prefetchPct() < 100) {
+    ++pipelineStats.numDriverAddsSkippedForArbitration;
+    return;
+  }
+  start();
+  ++pipelineStats.numAddedDrivers;
+}
+
+bool Task::localExchangeOutputBackedUpLocked(const DriverFactory& factory) {
+  const auto localPartition =
+      std::dynamic_pointer_cast<const core::LocalPartitionNode>(
+          factory.consumerNode);
+  if (localPartition == nullptr) {
+    return false;
+  }
+  auto& localExchanges = splitGroupStates_[kUngroupedGroupId].localExchanges;
+  auto it = localExchanges.find(localPartition->id());
+  if (it == localExchanges.end()) {
+    return false;
+  }
+  const auto& memoryManager = *it->second.memoryManager;
+  return memoryManager.bufferedBytes() >= memoryManager.maxBufferSize() / 2;
+}
+
 void Task::initializePartitionOutput() {
   VELOX_CHECK(
       isRunningLocked(),
@@ -856,6 +1010,10 @@ void Task::resume(std::shared_ptr<Task> self) {
             // enqueued twice.
             continue;
           }
+          if (driver->state().isDeferred) {
+            // The Driver is started when its pipeline has queued input.
+            continue;
+          }
           VELOX_CHECK(!driver->isOnThread() && !driver->isTerminated());
           if (!driver->state().hasBlockingFuture) {
             // Do not continue a Driver that is blocked on external
@@ -1367,13 +1525,19 @@ BlockingReason Task::getSplitOrFuture(
     const ConnectorSplitPreloadFunc& preload) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
-  return getSplitOrFutureLocked(
+  auto& splitsStore = splitsState.groupSplitsStores[splitGroupId];
+  const auto reason = getSplitOrFutureLocked(
       splitsState.sourceIsTableScan,
-      splitsState.groupSplitsStores[splitGroupId],
+      splitsStore,
       split,
       future,
       maxPreloadSplits,
       preload);
+  if (reason == BlockingReason::kNotBlocked &&
+      splitGroupId == kUngroupedGroupId && !deferredDrivers_.empty()) {
+    maybeStartDeferredDriversLocked(planNodeId, splitsStore);
+  }
+  return reason;
 }
 
 BlockingReason Task::getSplitOrFutureLocked(
@@ -1810,6 +1974,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
     // 'numRunningDrivers_' is cleared here so that this is 0 right
     // after terminate as tests expect.
     numRunningDrivers_ = 0;
+    deferredDrivers_.clear();
     for (auto& driver : drivers_) {
       if (driver) {
         if (enterForTerminateLocked(driver->state()) ==
@@ -2019,6 +2184,8 @@ TaskStats Task::taskStats() const {
   if (!taskStats.outputBufferStats.has_value()) {
     taskStats.outputBufferStats = bufferManager->stats(taskId_);
   }
+  taskStats.queryScheduledNanos = queryCtx_->driverScheduledNanos();
+  taskStats.queryQueuedNanos = queryCtx_->driverQueuedNanos();
   return taskStats;
 }
 
@@ -2718,4 +2885,20 @@ void Task::MemoryReclaimer::abort(
   memory::MemoryReclaimer::abort(pool, error);
 }
 
+memory::MemoryReclaimer::ReclaimCostInfo
+Task::MemoryReclaimer::reclaimCostInfo(const memory::MemoryPool& pool) const {
+  auto task = ensureTask();
+  if (FOLLY_UNLIKELY(task == nullptr)) {
+    return {};
+  }
+  ReclaimCostInfo info;
+  info.runningTimeMs = task->timeSinceStartMs();
+  const auto numTotalDrivers = task->numTotalDrivers();
+  if (numTotalDrivers > 0) {
+    info.progress =
+        static_cast<double>(task->numFinishedDrivers()) / numTotalDrivers;
+  }
+  return info;
+}
+
 } // namespace facebook::velox::exec
@@ -28,6 +28,7 @@
 namespace facebook::velox::exec {
 
 class OutputBufferManager;
+class PreparedPlanFragment;
 
 class HashJoinBridge;
 class NestedLoopJoinBridge;
@@ -69,6 +70,17 @@ class Task : public std::enable_shared_from_this<Task> {
       ConsumerSupplier consumerSupplier,
       std::function<void(std::exception_ptr)> onError = nullptr);
 
+  /// Creates a Task that runs 'preparedPlan'. The Task copies the driver
+  /// factories of 'preparedPlan' instead of planning the fragment if it is
+  /// started with the max number of drivers the fragment is planned for.
+  static std::shared_ptr<Task> create(
+      const std::string& taskId,
+      std::shared_ptr<const PreparedPlanFragment> preparedPlan,
+      int destination,
+      std::shared_ptr<core::QueryCtx> queryCtx,
+      ConsumerSupplier consumerSupplier = nullptr,
+      std::function<void(std::exception_ptr)> onError = nullptr);
+
   ~Task();
 
   /// Specify directory to which data will be spilled if spilling is enabled and
@@ -81,6 +93,17 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectoryCreated_ = alreadyCreated;
   }
 
+  /// Specifies the directory to which data is spilled once this task has
+  /// spilled 'spillDirectoryMaxBytes' to the spill directory. This is
+  /// typically on a remote FileSystem like S3, GCS or ABFS when the local disk
+  /// of the spill directory is small. The directory is created on first use.
+  void setOverflowSpillDirectory(
+      const std::string& overflowSpillDirectory,
+      uint64_t spillDirectoryMaxBytes) {
+    overflowSpillDirectory_ = overflowSpillDirectory;
+    spillDirectoryMaxBytes_ = spillDirectoryMaxBytes;
+  }
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -101,6 +124,11 @@ class Task : public std::enable_shared_from_this<Task> {
     return destination_;
   }
 
+  /// Returns the plan fragment specified in the constructor.
+  const core::PlanFragment& planFragment() const {
+    return planFragment_;
+  }
+
   // Convenience function for shortening a Presto taskId. To be used
   // in debugging messages and listings.
   static std::string shortId(const std::string& id);
@@ -605,12 +633,27 @@ class Task : public std::enable_shared_from_this<Task> {
     return spillDirectory_;
   }
 
+  const std::string& overflowSpillDirectory() const {
+    return overflowSpillDirectory_;
+  }
+
   /// Returns the spill directory path. Ensures that the spill directory is
   /// created before returning. Is thread safe. Returns an empty string if
   /// either the spill directory is not specified during task creation or the
-  /// folder could not be created.
+  /// folder could not be created. Returns the overflow spill directory
+  /// instead if set and this task has spilled more than the max bytes of the
+  /// spill directory.
   const std::string& getOrCreateSpillDirectory();
 
+  /// Adds 'bytes' to the bytes written to spill files by this task.
+  void addSpilledBytes(uint64_t bytes) {
+    spilledBytes_ += bytes;
+  }
+
+  uint64_t spilledBytes() const {
+    return spilledBytes_;
+  }
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -664,6 +707,15 @@ class Task : public std::enable_shared_from_this<Task> {
   // spilling.
   void removeSpillDirectoryIfExists();
 
+  void removeSpillDirectoryIfExists(
+      const std::string& directory,
+      const std::atomic<bool>& created);
+
+  // Creates 'directory' unless 'created' and sets 'created'.
+  const std::string& getOrCreateSpillDirectory(
+      const std::string& directory,
+      std::atomic<bool>& created);
+
   // Invoked to initialize the memory pool for this task on creation.
   void initTaskPool();
 
@@ -728,6 +780,11 @@ class Task : public std::enable_shared_from_this<Task> {
     void abort(memory::MemoryPool* pool, const std::exception_ptr& error)
         override;
 
+    /// Returns the running time and the fraction of finished drivers of the
+    /// task.
+    ReclaimCostInfo reclaimCostInfo(
+        const memory::MemoryPool& pool) const override;
+
    private:
     explicit MemoryReclaimer(const std::shared_ptr<Task>& task) : task_(task) {
       VELOX_CHECK_NOT_NULL(task);
@@ -816,6 +873,24 @@ class Task : public std::enable_shared_from_this<Task> {
 
   void driverClosedLocked();
 
+  // Defers the start of the Drivers of 'drivers' beyond
+  // QueryConfig::maxInitialDriversPerPipeline() in the pipelines that read a
+  // table scan and enqueues the others.
+  void startDriversLocked(const std::vector<std::shared_ptr<Driver>>& drivers);
+
+  // Called after a Driver got a split or found no more splits for
+  // 'planNodeId'. Starts a deferred Driver of the pipeline if 'splitsStore'
+  // has more queued splits than the pipeline has started Drivers, or all of
+  // them if the splits are exhausted.
+  void maybeStartDeferredDriversLocked(
+      const core::PlanNodeId& planNodeId,
+      const SplitsStore& splitsStore);
+
+  // Returns true if the local exchange consuming the output of 'factory' has
+  // buffered at least half of its capacity. Adding producers does not help
+  // then.
+  bool localExchangeOutputBackedUpLocked(const DriverFactory& factory);
+
   // Returns true if Task is in kRunning state, but all output drivers finished
   // processing and all output has been consumed. In other words, returns true
   // if task should transition to kFinished state.
@@ -934,6 +1009,8 @@ class Task : public std::enable_shared_from_this<Task> {
   // unique or universally unique.
   const std::string taskId_;
   core::PlanFragment planFragment_;
+  // Set if 'this' is created from a prepared plan.
+  std::shared_ptr<const PreparedPlanFragment> preparedPlan_;
   const int destination_;
   const std::shared_ptr<core::QueryCtx> queryCtx_;
 
@@ -1059,6 +1136,19 @@ class Task : public std::enable_shared_from_this<Task> {
   /// During ungrouped execution we use the [0] entry in this vector.
   std::unordered_map<uint32_t, SplitGroupState> splitGroupStates_;
 
+  // Drivers of an ungrouped pipeline that are created with the task but are
+  // started only when the pipeline has queued input.
+  struct DeferredDrivers {
+    uint32_t pipelineId;
+    // Number of Drivers of the pipeline that have been started.
+    uint32_t numStarted{0};
+    std::deque<std::shared_ptr<Driver>> drivers;
+  };
+
+  // Deferred Drivers keyed on the id of the table scan node of their pipeline.
+  // Cleared on termination.
+  std::unordered_map<core::PlanNodeId, DeferredDrivers> deferredDrivers_;
+
   std::weak_ptr<OutputBufferManager> bufferManager_;
 
   /// Boolean indicating that we have already received no-more-output-buffers
@@ -1093,6 +1183,15 @@ class Task : public std::enable_shared_from_this<Task> {
 
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
+
+  // Directory to spill to after 'spillDirectoryMaxBytes_' have been spilled.
+  // Empty if not set.
+  std::string overflowSpillDirectory_;
+  uint64_t spillDirectoryMaxBytes_{0};
+  std::atomic<bool> overflowSpillDirectoryCreated_{false};
+
+  // Bytes written to spill files by this task.
+  std::atomic<uint64_t> spilledBytes_{0};
 };
 
 /// Listener invoked on task completion.
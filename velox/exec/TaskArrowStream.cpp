@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/TaskArrowStream.h"
+
+#include <cerrno>
+#include <deque>
+
+namespace facebook::velox::exec {
+namespace {
+
+// Queue of result batches between the output drivers of a Task and the
+// consumer of the stream.
+class ResultQueue {
+ public:
+  explicit ResultQueue(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  void setNumProducers(int32_t numProducers) {
+    std::lock_guard<std::mutex> l(mutex_);
+    numProducers_ = numProducers;
+    if (consumerBlocked_) {
+      consumerBlocked_ = false;
+      consumerPromise_.setValue();
+    }
+  }
+
+  // Adds 'vector' or marks a producer at end if 'vector' is nullptr. Returns
+  // kWaitForConsumer and sets 'future' if the queue is full after the
+  // addition.
+  BlockingReason enqueue(RowVectorPtr vector, ContinueFuture* future) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (consumerBlocked_) {
+      consumerBlocked_ = false;
+      consumerPromise_.setValue();
+    }
+    if (vector == nullptr) {
+      ++numFinishedProducers_;
+      return BlockingReason::kNotBlocked;
+    }
+    if (closed_) {
+      return BlockingReason::kNotBlocked;
+    }
+    const auto bytes = vector->retainedSize();
+    queue_.push_back({std::move(vector), bytes});
+    queuedBytes_ += bytes;
+    if (queuedBytes_ <= maxBytes_) {
+      return BlockingReason::kNotBlocked;
+    }
+    auto [promise, unblockFuture] = makeVeloxContinuePromiseContract(
+        "TaskArrowStream::enqueue");
+    producerPromises_.push_back(std::move(promise));
+    *future = std::move(unblockFuture);
+    return BlockingReason::kWaitForConsumer;
+  }
+
+  // Returns the next batch. Waits if the queue is empty and not all producers
+  // are at end. Returns nullptr at end.
+  RowVectorPtr dequeue() {
+    for (;;) {
+      RowVectorPtr vector;
+      std::vector<ContinuePromise> producerPromises;
+      ContinueFuture wait;
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (!queue_.empty()) {
+          auto& entry = queue_.front();
+          vector = std::move(entry.vector);
+          queuedBytes_ -= entry.bytes;
+          queue_.pop_front();
+          if (queuedBytes_ <= maxBytes_ / 2) {
+            producerPromises = std::move(producerPromises_);
+          }
+        } else if (
+            numProducers_.has_value() &&
+            numFinishedProducers_ >= numProducers_.value()) {
+          return nullptr;
+        } else {
+          consumerBlocked_ = true;
+          consumerPromise_ = ContinuePromise("TaskArrowStream::dequeue");
+          wait = consumerPromise_.getSemiFuture();
+        }
+      }
+      for (auto& promise : producerPromises) {
+        promise.setValue();
+      }
+      if (vector != nullptr) {
+        return vector;
+      }
+      std::move(wait).wait();
+    }
+  }
+
+  // Drops the queued batches and unblocks the producers. Batches added later
+  // are dropped.
+  void close() {
+    std::vector<ContinuePromise> producerPromises;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      closed_ = true;
+      queue_.clear();
+      queuedBytes_ = 0;
+      producerPromises = std::move(producerPromises_);
+    }
+    for (auto& promise : producerPromises) {
+      promise.setValue();
+    }
+  }
+
+ private:
+  struct Entry {
+    RowVectorPtr vector;
+    uint64_t bytes;
+  };
+
+  const uint64_t maxBytes_;
+
+  std::mutex mutex_;
+  std::deque<Entry> queue_;
+  uint64_t queuedBytes_{0};
+  std::optional<int32_t> numProducers_;
+  int32_t numFinishedProducers_{0};
+  bool closed_{false};
+  std::vector<ContinuePromise> producerPromises_;
+  bool consumerBlocked_{false};
+  ContinuePromise consumerPromise_{ContinuePromise::makeEmpty()};
+};
+
+struct StreamState {
+  std::shared_ptr<ResultQueue> queue;
+  std::shared_ptr<Task> task;
+  // Pool for the buffers allocated by exportToArrow().
+  std::shared_ptr<memory::MemoryPool> pool;
+  RowTypePtr outputType;
+  ArrowOptions arrowOptions;
+  std::string lastError;
+  bool atEnd{false};
+};
+
+// Private data of an exported batch. Wraps the array made by exportToArrow()
+// to keep the Task that owns the memory of the batch alive.
+struct ExportedArray {
+  ArrowArray array;
+  std::shared_ptr<StreamState> state;
+};
+
+void releaseExportedArray(ArrowArray* array) {
+  auto* exported = static_cast<ExportedArray*>(array->private_data);
+  if (exported->array.release != nullptr) {
+    exported->array.release(&exported->array);
+  }
+  delete exported;
+  array->release = nullptr;
+  array->private_data = nullptr;
+}
+
+StreamState& streamState(ArrowArrayStream* stream) {
+  return **static_cast<std::shared_ptr<StreamState>*>(stream->private_data);
+}
+
+int getSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+  auto& state = streamState(stream);
+  try {
+    exportToArrow(
+        BaseVector::create(state.outputType, 0, state.pool.get()),
+        *out,
+        state.arrowOptions);
+    return 0;
+  } catch (const std::exception& e) {
+    state.lastError = e.what();
+    return EIO;
+  }
+}
+
+int getNext(ArrowArrayStream* stream, ArrowArray* out) {
+  const auto& statePtr =
+      *static_cast<std::shared_ptr<StreamState>*>(stream->private_data);
+  auto& state = *statePtr;
+  try {
+    RowVectorPtr vector;
+    if (!state.atEnd) {
+      vector = state.queue->dequeue();
+    }
+    if (auto error = state.task->error()) {
+      std::rethrow_exception(error);
+    }
+    if (vector == nullptr) {
+      state.atEnd = true;
+      out->release = nullptr;
+      return 0;
+    }
+    auto exported = std::make_unique<ExportedArray>();
+    exported->state = statePtr;
+    exportToArrow(
+        vector, exported->array, state.pool.get(), state.arrowOptions);
+    *out = exported->array;
+    out->private_data = exported.release();
+    out->release = releaseExportedArray;
+    return 0;
+  } catch (const std::exception& e) {
+    state.lastError = e.what();
+    return EIO;
+  }
+}
+
+const char* getLastError(ArrowArrayStream* stream) {
+  const auto& lastError = streamState(stream).lastError;
+  return lastError.empty() ? nullptr : lastError.c_str();
+}
+
+void releaseStream(ArrowArrayStream* stream) {
+  auto* statePtr = static_cast<std::shared_ptr<StreamState>*>(
+      stream->private_data);
+  auto& state = **statePtr;
+  state.queue->close();
+  if (!state.atEnd) {
+    state.task->requestCancel();
+  }
+  delete statePtr;
+  stream->release = nullptr;
+  stream->private_data = nullptr;
+}
+
+} // namespace
+
+std::shared_ptr<Task> exportTaskToArrowStream(
+    const std::string& taskId,
+    core::PlanFragment planFragment,
+    std::shared_ptr<core::QueryCtx> queryCtx,
+    const TaskArrowStreamOptions& options,
+    ArrowArrayStream& out) {
+  VELOX_CHECK(
+      queryCtx->isExecutorSupplied(),
+      "Exporting a Task to an Arrow stream requires an executor");
+  auto state = std::make_shared<StreamState>();
+  state->queue = std::make_shared<ResultQueue>(options.maxQueuedBytes);
+  state->pool = queryCtx->pool()->addLeafChild(
+      fmt::format("TaskArrowStream.{}", taskId));
+  state->outputType = planFragment.planNode->outputType();
+  state->arrowOptions = options.arrowOptions;
+
+  state->task = Task::create(
+      taskId,
+      std::move(planFragment),
+      0,
+      std::move(queryCtx),
+      [queue = state->queue](RowVectorPtr vector, ContinueFuture* future) {
+        return queue->enqueue(std::move(vector), future);
+      });
+  state->task->start(options.maxDrivers);
+  state->queue->setNumProducers(state->task->numOutputDrivers());
+
+  out.get_schema = getSchema;
+  out.get_next = getNext;
+  out.get_last_error = getLastError;
+  out.release = releaseStream;
+  out.private_data = new std::shared_ptr<StreamState>(state);
+  return state->task;
+}
+
+} // namespace facebook::velox::exec
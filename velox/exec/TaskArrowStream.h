@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/Task.h"
+#include "velox/vector/arrow/Abi.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::exec {
+
+struct TaskArrowStreamOptions {
+  /// Bytes of results queued for the consumer before the output drivers of
+  /// the Task block. The drivers continue when the consumer has taken half of
+  /// the queued bytes.
+  uint64_t maxQueuedBytes{32 << 20};
+
+  /// Maximum number of drivers per pipeline.
+  int32_t maxDrivers{1};
+
+  /// Options for exporting the result batches.
+  ArrowOptions arrowOptions;
+};
+
+/// Creates and starts a Task for 'planFragment' and sets 'out' to an Arrow C
+/// stream of its results, as defined in
+/// https://arrow.apache.org/docs/format/CStreamInterface.html. The Task runs
+/// on the executor of 'queryCtx' while the consumer pulls batches with
+/// get_next(), so that the first batches are available before the query
+/// finishes. Result batches are exported with exportToArrow() and reference
+/// the buffers of the result vectors instead of copying them. The exported
+/// arrays keep the Task and its memory alive until they are released.
+/// Releasing 'out' before the end of the stream cancels the Task. Returns the
+/// Task, to which the caller adds the splits.
+std::shared_ptr<Task> exportTaskToArrowStream(
+    const std::string& taskId,
+    core::PlanFragment planFragment,
+    std::shared_ptr<core::QueryCtx> queryCtx,
+    const TaskArrowStreamOptions& options,
+    ArrowArrayStream& out);
+
+} // namespace facebook::velox::exec
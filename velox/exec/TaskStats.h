@@ -40,6 +40,25 @@ struct PipelineStats {
   // True if contains the sync node for the task.
   bool outputPipeline;
 
+  // Number of Drivers started with the task. Less than the number of Drivers
+  // of the pipeline if the start of some Drivers was deferred, see
+  // QueryConfig::maxInitialDriversPerPipeline(). Set for ungrouped execution.
+  uint32_t numInitialDrivers{0};
+
+  // Number of deferred Drivers started because the pipeline had queued splits.
+  uint32_t numAddedDrivers{0};
+
+  // Number of deferred Drivers started because the splits were exhausted.
+  uint32_t numDriversStartedAtEnd{0};
+
+  // Number of times a Driver was not added despite queued splits because the
+  // local exchange output of the pipeline was backed up.
+  uint32_t numDriverAddsSkippedForOutput{0};
+
+  // Number of times a Driver was not added despite queued splits because
+  // memory arbitration was in progress.
+  uint32_t numDriverAddsSkippedForArbitration{0};
+
   PipelineStats(bool _inputPipeline, bool _outputPipeline)
       : inputPipeline{_inputPipeline}, outputPipeline{_outputPipeline} {}
 };
@@ -116,6 +135,13 @@ struct TaskStats {
   uint32_t memoryReclaimCount{0};
   /// The total memory reclamation time.
   uint64_t memoryReclaimMs{0};
+
+  /// Wall time the drivers of all the tasks of the query ran on executor
+  /// threads.
+  uint64_t queryScheduledNanos{0};
+  /// Wall time the drivers of all the tasks of the query waited in the
+  /// executor queue.
+  uint64_t queryQueuedNanos{0};
 };
 
 } // namespace facebook::velox::exec
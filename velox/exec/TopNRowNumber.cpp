@@ -167,7 +167,7 @@ TopNRowNumber::TopNRowNumber(
     lookup_ = std::make_unique<HashLookup>(table_->hashers());
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
-    singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    singlePartition_ = std::make_unique<TopRows>();
   }
 
   if (generateRowNumber_) {
@@ -241,19 +241,45 @@ bool TopNRowNumber::abandonPartialEarly() const {
 
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
-    new (lookup_->hits[index] + partitionOffset_)
-        TopRows(table_->stringAllocator(), comparator_);
+    new (lookup_->hits[index] + partitionOffset_) TopRows();
   }
 }
 
-void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
-  auto& topRows = partition.rows;
+void TopNRowNumber::pushRow(TopRows& partition, char* row) {
+  if (partition.size == partition.capacity) {
+    StlAllocator<char*> allocator(partitionAllocator());
+    const int32_t newCapacity =
+        std::min(limit_, std::max(2, partition.capacity * 2));
+    auto* newRows = allocator.allocate(newCapacity);
+    if (partition.rows != nullptr) {
+      std::copy(partition.rows, partition.rows + partition.size, newRows);
+      allocator.deallocate(partition.rows, partition.capacity);
+    }
+    partition.rows = newRows;
+    partition.capacity = newCapacity;
+  }
+  partition.rows[partition.size++] = row;
+  std::push_heap(
+      partition.rows,
+      partition.rows + partition.size,
+      [&](const char* lhs, const char* rhs) { return comparator_(lhs, rhs); });
+}
+
+char* TopNRowNumber::popRow(TopRows& partition) {
+  VELOX_DCHECK_GT(partition.size, 0);
+  std::pop_heap(
+      partition.rows,
+      partition.rows + partition.size,
+      [&](const char* lhs, const char* rhs) { return comparator_(lhs, rhs); });
+  return partition.rows[--partition.size];
+}
 
+void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   char* newRow = nullptr;
-  if (topRows.size() < limit_) {
+  if (partition.size < limit_) {
     newRow = data_->newRow();
   } else {
-    char* topRow = topRows.top();
+    char* topRow = partition.top();
 
     if (!comparator_(decodedVectors_, index, topRow)) {
       // Drop this input row.
@@ -261,7 +287,7 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     }
 
     // Replace existing row.
-    topRows.pop();
+    popRow(partition);
 
     // Reuse the topRow's memory.
     newRow = data_->initializeRow(topRow, true /* reuse */);
@@ -271,7 +297,7 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     data_->store(decodedVectors_[col], index, newRow, col);
   }
 
-  topRows.push(newRow);
+  pushRow(partition, newRow);
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -287,7 +313,8 @@ void TopNRowNumber::noMoreInput() {
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(pool());
+    merge_ = spillPartition.createOrderedReader(
+        pool(), spillConfig_->executor, spillConfig_->readAheadBytes);
     recordSpillStats(spiller_->stats());
   } else {
     outputRows_.resize(outputBatchSize_);
@@ -362,14 +389,13 @@ void TopNRowNumber::appendPartitionRows(
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
   // Append 'size' partition rows in reverse order starting from 'start' row.
-  auto rowNumber = partition.rows.size() - start;
+  auto rowNumber = partition.size - start;
   for (auto i = 0; i < size; ++i) {
     const auto index = outputOffset + size - i - 1;
     if (rowNumbers) {
       rowNumbers->set(index, rowNumber--);
     }
-    outputRows_[index] = partition.rows.top();
-    partition.rows.pop();
+    outputRows_[index] = popRow(partition);
   }
 }
 
@@ -429,7 +455,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   vector_size_t offset = 0;
   if (remainingRowsInPartition_ > 0) {
     auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
+    auto start = partition.size - remainingRowsInPartition_;
     auto numRows =
         std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
     appendPartitionRows(partition, start, numRows, offset, rowNumbers);
@@ -443,7 +469,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
       break;
     }
 
-    auto numRows = partition->rows.size();
+    vector_size_t numRows = partition->size;
     if (offset + numRows > outputBatchSize_) {
       remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
 
@@ -618,20 +644,7 @@ bool TopNRowNumber::isFinished() {
 void TopNRowNumber::close() {
   Operator::close();
 
-  if (table_) {
-    partitionIt_.reset();
-    partitions_.resize(1000);
-    while (auto numPartitions = table_->listAllRows(
-               &partitionIt_,
-               partitions_.size(),
-               RowContainer::kUnlimited,
-               partitions_.data())) {
-      for (auto i = 0; i < numPartitions; ++i) {
-        std::destroy_at(
-            reinterpret_cast<TopRows*>(partitions_[i] + partitionOffset_));
-      }
-    }
-  }
+  // The heap arrays of the partitions are freed with the allocator.
 }
 
 void TopNRowNumber::reclaim(
@@ -69,21 +69,19 @@ class TopNRowNumber : public Operator {
       override;
 
  private:
-  // A priority queue to keep track of top 'limit' rows for a given partition.
+  // A max-heap of the top 'limit' rows of a partition ordered by the sorting
+  // keys. The heap is an array of row pointers allocated from a
+  // HashStringAllocator. The array starts small and doubles up to 'limit'
+  // pointers, so that a partition with few rows takes little memory. This
+  // matters when there are millions of partitions.
   struct TopRows {
-    struct Compare {
-      RowComparator& comparator;
+    char** rows{nullptr};
+    int32_t size{0};
+    int32_t capacity{0};
 
-      bool operator()(const char* lhs, const char* rhs) {
-        return comparator(lhs, rhs);
-      }
-    };
-
-    std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
-        rows;
-
-    TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+    char* top() const {
+      return rows[0];
+    }
   };
 
   void initializeNewPartitions();
@@ -92,6 +90,18 @@ class TopNRowNumber : public Operator {
     return *reinterpret_cast<TopRows*>(group + partitionOffset_);
   }
 
+  // Returns the allocator for the heap arrays of the partitions.
+  HashStringAllocator* partitionAllocator() const {
+    return table_ ? table_->stringAllocator() : allocator_.get();
+  }
+
+  // Adds 'row' to the heap of 'partition'. The partition must have less than
+  // 'limit_' rows.
+  void pushRow(TopRows& partition, char* row);
+
+  // Removes and returns the top row of the heap of 'partition'.
+  char* popRow(TopRows& partition);
+
   // Adds input row to a partition or discards the row.
   void processInputRow(vector_size_t index, TopRows& partition);
 
@@ -30,7 +30,8 @@ Unnest::Unnest(
           operatorId,
           unnestNode->id(),
           "Unnest"),
-      withOrdinality_(unnestNode->withOrdinality()) {
+      withOrdinality_(unnestNode->withOrdinality()),
+      splitOutput_(driverCtx->queryConfig().unnestSplitOutput()) {
   const auto& inputType = unnestNode->sources()[0]->outputType();
   const auto& unnestVariables = unnestNode->unnestVariables();
   for (const auto& variable : unnestVariables) {
@@ -106,6 +107,33 @@ void Unnest::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  outputBatchSize_ = boundedOutputBatchRows(estimateOutputRowSize());
+}
+
+std::optional<uint64_t> Unnest::estimateOutputRowSize() const {
+  const auto size = input_->size();
+  uint64_t numOutputRows = 0;
+  for (auto row = 0; row < size; ++row) {
+    numOutputRows += rawMaxSizes_[row];
+  }
+  if (numOutputRows == 0) {
+    return std::nullopt;
+  }
+
+  // Each output row repeats one input row of the replicated columns and takes
+  // one element of each unnested column.
+  uint64_t replicatedBytes = 0;
+  for (const auto& projection : identityProjections_) {
+    replicatedBytes +=
+        input_->childAt(projection.inputChannel)->estimateFlatSize();
+  }
+  uint64_t unnestedBytes = 0;
+  for (auto channel : unnestChannels_) {
+    unnestedBytes += input_->childAt(channel)->estimateFlatSize();
+  }
+  return replicatedBytes / size + unnestedBytes / numOutputRows +
+      (withOrdinality_ ? sizeof(int64_t) : 0);
 }
 
 RowVectorPtr Unnest::getOutput() {
@@ -114,32 +142,46 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   const auto size = input_->size();
-  const auto maxOutputSize = outputBatchRows();
+  const auto maxOutputSize = outputBatchSize_;
 
   // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
-  vector_size_t numElements = 0;
+  // 'maxOutputSize' if possible. Unless 'splitOutput_', process each input
+  // row fully and do not break single row's output into multiple batches.
+  RowRange range{nextInputRow_, 0, nextElement_, 0, 0};
   for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
+    const auto begin = row == nextInputRow_ ? nextElement_ : 0;
+    auto end = rawMaxSizes_[row];
+    if (splitOutput_ && range.numElements + end - begin > maxOutputSize) {
+      end = begin + maxOutputSize - range.numElements;
+    }
+    range.numElements += end - begin;
+    range.lastElementEnd = end;
+    ++range.size;
 
-    if (numElements >= maxOutputSize) {
+    if (range.numElements >= maxOutputSize) {
       break;
     }
   }
 
-  if (numElements == 0) {
+  if (range.numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextElement_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(range);
 
-  nextInputRow_ += numInput;
+  const auto lastRow = range.start + range.size - 1;
+  if (range.lastElementEnd < rawMaxSizes_[lastRow]) {
+    // Continue with the rest of the elements of the last row.
+    nextInputRow_ = lastRow;
+    nextElement_ = range.lastElementEnd;
+  } else {
+    nextInputRow_ = lastRow + 1;
+    nextElement_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -150,37 +192,46 @@ RowVectorPtr Unnest::getOutput() {
 }
 
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements,
+    const RowRange& range,
     std::vector<VectorPtr>& outputs) {
+  if (range.size == 1) {
+    // All output rows repeat the same input row.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          range.numElements,
+          range.start,
+          input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
-  auto repeatedIndices = allocateIndices(numElements, pool());
+  auto repeatedIndices = allocateIndices(range.numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    for (auto i = begin; i < end; ++i) {
       rawRepeatedIndices[index++] = row;
     }
-  }
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
     outputs.at(projection.outputChannel) = wrapChild(
-        numElements, repeatedIndices, input_->childAt(projection.inputChannel));
+        range.numElements,
+        repeatedIndices,
+        input_->childAt(projection.inputChannel));
   }
 }
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  BufferPtr elementIndices = allocateIndices(numElements, pool());
+    const RowRange& range) {
+  BufferPtr elementIndices = allocateIndices(range.numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  auto nulls = allocateNulls(numElements, pool());
+  auto nulls = allocateNulls(range.numElements, pool());
   auto rawNulls = nulls->asMutable<uint64_t>();
 
   auto& currentDecoded = unnestDecoded_[channel];
@@ -190,108 +241,117 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
 
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
-  bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    auto maxSize = rawMaxSizes_[row];
+  bool contiguous = true;
+  vector_size_t firstOffset = 0;
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    if (begin == end) {
+      return;
+    }
 
     if (!currentDecoded.isNullAt(row)) {
       auto offset = currentOffsets[currentIndices[row]];
       auto unnestSize = currentSizes[currentIndices[row]];
 
-      if (index != offset || unnestSize < maxSize) {
-        identityMapping = false;
+      if (index == 0) {
+        firstOffset = offset + begin;
+      }
+      if (firstOffset + index != offset + begin || unnestSize < end) {
+        contiguous = false;
       }
 
-      for (auto i = 0; i < unnestSize; i++) {
+      for (auto i = begin; i < std::min(unnestSize, end); i++) {
         rawElementIndices[index++] = offset + i;
       }
 
-      for (auto i = unnestSize; i < maxSize; ++i) {
+      for (auto i = std::max(unnestSize, begin); i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
-    } else if (maxSize > 0) {
-      identityMapping = false;
+    } else {
+      contiguous = false;
 
-      for (auto i = 0; i < maxSize; ++i) {
+      for (auto i = begin; i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
     }
+  });
+  return {elementIndices, nulls, contiguous, firstOffset};
+}
+
+// static
+VectorPtr Unnest::wrapElements(
+    const UnnestChannelEncoding& encoding,
+    vector_size_t numElements,
+    const VectorPtr& elements) {
+  if (!encoding.contiguous) {
+    return wrapChild(numElements, encoding.indices, elements, encoding.nulls);
   }
-  return {elementIndices, nulls, identityMapping};
+  if (encoding.offset == 0 && numElements == elements->size()) {
+    return elements;
+  }
+  return elements->slice(encoding.offset, numElements);
 }
 
-VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  auto ordinalityVector =
-      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
+VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
+  auto* execCtx = operatorCtx_->execCtx();
+  if (ordinalityVector_ != nullptr) {
+    execCtx->releaseVector(ordinalityVector_);
+  }
+  ordinalityVector_ = execCtx->getVector(BIGINT(), range.numElements);
+  auto* ordinalityVector = ordinalityVector_->asFlatVector<int64_t>();
 
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto begin, auto end) {
+    std::iota(rawOrdinality, rawOrdinality + end - begin, begin + 1);
+    rawOrdinality += end - begin;
+  });
 
-  return ordinalityVector;
+  return ordinalityVector_;
 }
 
-RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
+RowVectorPtr Unnest::generateOutput(const RowRange& range) {
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     auto& currentDecoded = unnestDecoded_[channel];
-    auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+    auto unnestChannelEncoding = generateEncodingForChannel(channel, range);
 
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
-      // Construct unnest column using Array elements wrapped using above
-      // created dictionary.
+      // Construct unnest column using Array elements sliced or wrapped using
+      // above created dictionary.
       auto unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      outputs[outputsIndex++] = unnestChannelEncoding.identityMapping
-          ? unnestBaseArray->elements()
-          : wrapChild(
-                numElements,
-                unnestChannelEncoding.indices,
-                unnestBaseArray->elements(),
-                unnestChannelEncoding.nulls);
+      outputs[outputsIndex++] = wrapElements(
+          unnestChannelEncoding,
+          range.numElements,
+          unnestBaseArray->elements());
     } else {
-      // Construct two unnest columns for Map keys and values vectors wrapped
-      // using above created dictionary.
+      // Construct two unnest columns for Map keys and values vectors sliced or
+      // wrapped using above created dictionary.
       auto unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      outputs[outputsIndex++] = unnestChannelEncoding.identityMapping
-          ? unnestBaseMap->mapKeys()
-          : wrapChild(
-                numElements,
-                unnestChannelEncoding.indices,
-                unnestBaseMap->mapKeys(),
-                unnestChannelEncoding.nulls);
-      outputs[outputsIndex++] = unnestChannelEncoding.identityMapping
-          ? unnestBaseMap->mapValues()
-          : wrapChild(
-                numElements,
-                unnestChannelEncoding.indices,
-                unnestBaseMap->mapValues(),
-                unnestChannelEncoding.nulls);
+      outputs[outputsIndex++] = wrapElements(
+          unnestChannelEncoding, range.numElements, unnestBaseMap->mapKeys());
+      outputs[outputsIndex++] = wrapElements(
+          unnestChannelEncoding,
+          range.numElements,
+          unnestBaseMap->mapValues());
     }
   }
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range);
   }
 
   return std::make_shared<RowVector>(
-      pool(), outputType_, BufferPtr(nullptr), numElements, std::move(outputs));
+      pool(),
+      outputType_,
+      BufferPtr(nullptr),
+      range.numElements,
+      std::move(outputs));
 }
 
 bool Unnest::isFinished() {
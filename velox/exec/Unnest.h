@@ -38,44 +38,82 @@ class Unnest : public Operator {
 
   bool isFinished() override;
 
+  void close() override {
+    ordinalityVector_ = nullptr;
+    Operator::close();
+  }
+
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
-  //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
-  // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  // Input rows [start, start + size) to generate a batch of output for. Each
+  // row produces rawMaxSizes_[row] output rows, except that the output of
+  // the first row may start after its first element and the output of the
+  // last row may end before its last element if these rows are split across
+  // batches.
+  struct RowRange {
+    vector_size_t start;
+    vector_size_t size;
+
+    // Index of the first element of the first row to include in the output.
+    vector_size_t firstElement;
+
+    // Index past the last element of the last row to include in the output.
+    vector_size_t lastElementEnd;
+
+    // Number of output rows.
+    vector_size_t numElements;
+
+    // Calls 'func(row, begin, end)' for each row with the [begin, end) range
+    // of its elements to include in the output.
+    template <typename TFunc>
+    void forEachRow(const vector_size_t* maxSizes, TFunc func) const {
+      for (auto row = start; row < start + size; ++row) {
+        const auto begin = row == start ? firstElement : 0;
+        const auto end =
+            row == start + size - 1 ? lastElementEnd : maxSizes[row];
+        func(row, begin, end);
+      }
+    }
+  };
+
+  // Generate output for the rows in 'range'.
+  RowVectorPtr generateOutput(const RowRange& range);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements,
+      const RowRange& range,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
     BufferPtr indices;
     BufferPtr nulls;
-    bool identityMapping;
+    // True if the output is 'numElements' consecutive elements starting at
+    // 'offset' with no nulls. The elements are then sliced instead of wrapped
+    // in a dictionary.
+    bool contiguous;
+    vector_size_t offset;
   };
 
   // Invoked by generateOutput above to generate the encoding for the unnested
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+      const RowRange& range);
+
+  // Returns the elements, keys or values of an unnested column encoded as
+  // specified by 'encoding'.
+  static VectorPtr wrapElements(
+      const UnnestChannelEncoding& encoding,
+      vector_size_t numElements,
+      const VectorPtr& elements);
+
+  // Returns the average size in bytes of the output rows for 'input_' or
+  // std::nullopt if 'input_' produces no output.
+  std::optional<uint64_t> estimateOutputRowSize() const;
 
-  // Invoked by generateOutput for the ordinality column.
-  VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+  // Invoked by generateOutput for the ordinality column. Recycles the
+  // ordinality vector of the previous output if it is no longer referenced.
+  VectorPtr generateOrdinalityVector(const RowRange& range);
 
   const bool withOrdinality_;
   std::vector<column_index_t> unnestChannels_;
@@ -86,11 +124,26 @@ class Unnest : public Operator {
   BufferPtr maxSizes_;
   vector_size_t* rawMaxSizes_{nullptr};
 
+  // Number of output rows per batch for 'input_'. Estimated in addInput()
+  // from the flat size of the replicated and unnested columns.
+  vector_size_t outputBatchSize_{0};
+
   std::vector<const vector_size_t*> rawSizes_;
   std::vector<const vector_size_t*> rawOffsets_;
   std::vector<const vector_size_t*> rawIndices_;
 
+  // If true, the output of an input row with more elements than fit in an
+  // output batch is split across batches.
+  const bool splitOutput_;
+
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // First element of 'nextInputRow_' to process in getOutput(). Non-zero if
+  // the row is split across batches.
+  vector_size_t nextElement_{0};
+
+  // Ordinality column of the last output.
+  VectorPtr ordinalityVector_;
 };
 } // namespace facebook::velox::exec
@@ -240,6 +240,11 @@ class VectorHasher {
     return hasRange_ || !distinctOverflow_;
   }
 
+  // Returns true if there are too many distinct values to keep.
+  bool distinctOverflow() const {
+    return distinctOverflow_;
+  }
+
   // Returns an instance of the filter corresponding to a set of unique values.
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
@@ -291,6 +296,7 @@ class VectorHasher {
       case TypeKind::SMALLINT:
       case TypeKind::INTEGER:
       case TypeKind::BIGINT:
+      case TypeKind::TIMESTAMP:
       case TypeKind::VARCHAR:
       case TypeKind::VARBINARY:
         return true;
@@ -652,6 +658,46 @@ inline uint64_t VectorHasher::lookupValueId(StringView value) const {
   return kUnmappable;
 }
 
+// Timestamps are mapped through their nanoseconds since the epoch, which is
+// a 64-bit key that orders like the timestamp. Timestamps outside of the
+// range of int64_t nanoseconds are unmappable.
+template <>
+inline uint64_t VectorHasher::valueId(Timestamp value) {
+  int64_t nanos;
+  if (!value.tryToNanos(nanos)) {
+    return kUnmappable;
+  }
+  return valueId<int64_t>(nanos);
+}
+
+template <>
+inline uint64_t VectorHasher::lookupValueId(Timestamp value) const {
+  int64_t nanos;
+  if (!value.tryToNanos(nanos)) {
+    return kUnmappable;
+  }
+  return lookupValueId<int64_t>(nanos);
+}
+
+template <>
+inline void VectorHasher::analyzeValue(Timestamp value) {
+  int64_t nanos;
+  if (!value.tryToNanos(nanos)) {
+    setRangeOverflow();
+    setDistinctOverflow();
+    return;
+  }
+  analyzeValue<int64_t>(nanos);
+}
+
+template <>
+inline bool VectorHasher::tryMapToRange(
+    const Timestamp* /*values*/,
+    const SelectivityVector& /*rows*/,
+    uint64_t* /*result*/) {
+  return false;
+}
+
 template <>
 inline uint64_t VectorHasher::valueId(bool value) {
   return value ? 2 : 1;
@@ -21,6 +21,95 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+bool inputsSorted(const core::WindowNode& windowNode);
+
+// Returns true if 'windowNode' reads the output of another Window whose keys
+// start with the partition and sorting keys of 'windowNode'. A Window that
+// sorts its input outputs the partitions in the order of the partition keys
+// and the rows of each partition in the order of the sorting keys, so the
+// input of 'windowNode' needs no sort of its own.
+bool sortedBySourceWindow(const core::WindowNode& windowNode) {
+  const auto source = std::dynamic_pointer_cast<const core::WindowNode>(
+      windowNode.sources()[0]);
+  if (source == nullptr) {
+    return false;
+  }
+  const auto& partitionKeys = windowNode.partitionKeys();
+  const auto& sortingKeys = windowNode.sortingKeys();
+  if (partitionKeys.empty() && sortingKeys.empty()) {
+    return false;
+  }
+  // A Window on sorted input keeps the input order, which groups the rows by
+  // all the partition keys but not necessarily by a subset of them.
+  if (inputsSorted(*source) &&
+      partitionKeys.size() != source->partitionKeys().size()) {
+    return false;
+  }
+
+  // The keys of 'source' in the order its output is sorted by. Partition keys
+  // are sorted ascending with nulls first.
+  std::vector<std::pair<std::string, core::SortOrder>> sourceKeys;
+  for (const auto& key : source->partitionKeys()) {
+    sourceKeys.emplace_back(key->name(), core::SortOrder(true, true));
+  }
+  for (auto i = 0; i < source->sortingKeys().size(); ++i) {
+    sourceKeys.emplace_back(
+        source->sortingKeys()[i]->name(), source->sortingOrders()[i]);
+  }
+  if (partitionKeys.size() + sortingKeys.size() > sourceKeys.size()) {
+    return false;
+  }
+
+  // The partition keys may come in any order.
+  std::unordered_set<std::string> partitionNames;
+  std::unordered_set<std::string> leadingNames;
+  for (auto i = 0; i < partitionKeys.size(); ++i) {
+    partitionNames.insert(partitionKeys[i]->name());
+    leadingNames.insert(sourceKeys[i].first);
+  }
+  if (partitionNames != leadingNames) {
+    return false;
+  }
+  for (auto i = 0; i < sortingKeys.size(); ++i) {
+    const auto& [name, order] = sourceKeys[partitionKeys.size() + i];
+    if (sortingKeys[i]->name() != name ||
+        windowNode.sortingOrders()[i] != order) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the input is grouped by the partition keys and sorted by
+// the sorting keys within each partition, either as declared by the plan or
+// because it comes from a compatible Window.
+bool inputsSorted(const core::WindowNode& windowNode) {
+  return windowNode.inputsSorted() || sortedBySourceWindow(windowNode);
+}
+
+// Returns true if the rows of a partition can be output before all the rows
+// of the partition have been received. This needs sorted input and window
+// functions whose results depend only on the current and preceding rows.
+bool canStreamRows(const core::WindowNode& windowNode) {
+  if (!inputsSorted(windowNode)) {
+    return false;
+  }
+  for (const auto& function : windowNode.windowFunctions()) {
+    auto metadata = getWindowFunctionMetadata(function.functionCall->name());
+    if (!metadata.has_value() || !metadata->supportsStreaming) {
+      return false;
+    }
+    // k range frame bounds are searched in all the rows of the partition.
+    if (function.frame.type == core::WindowNode::WindowType::kRange &&
+        (function.frame.startValue || function.frame.endValue)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 Window::Window(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -31,7 +120,8 @@ Window::Window(
           operatorId,
           windowNode->id(),
           "Window",
-          windowNode->canSpill(driverCtx->queryConfig())
+          windowNode->canSpill(driverCtx->queryConfig()) &&
+                  !inputsSorted(*windowNode)
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       numInputColumns_(windowNode->inputType()->size()),
@@ -40,9 +130,13 @@ Window::Window(
       stringAllocator_(pool()) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
-  if (windowNode->inputsSorted()) {
+  if (inputsSorted(*windowNode)) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        canStreamRows(*windowNode));
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_);
@@ -522,6 +616,13 @@ void Window::callApplyForPartitionRows(
   vector_size_t numRows = endRow - startRow;
   numProcessedRows_ += numRows;
   partitionOffset_ += numRows;
+
+  if (currentPartition_->partial()) {
+    // Keeps the first row of the last peer group, which can continue in the
+    // rows that are not yet received.
+    currentPartition_->removeProcessedRows(
+        std::min(partitionOffset_, peerStartRow_));
+  }
 }
 
 vector_size_t Window::callApplyLoop(
@@ -547,6 +648,10 @@ vector_size_t Window::callApplyLoop(
           result);
       resultIndex += rowsForCurrentPartition;
       numOutputRowsLeft -= rowsForCurrentPartition;
+      if (!currentPartition_->complete()) {
+        // The rest of the rows of a partial partition are not yet received.
+        break;
+      }
       callResetPartition();
       if (!currentPartition_) {
         // The WindowBuild doesn't have any more partitions to process right
@@ -589,6 +694,12 @@ RowVectorPtr Window::getOutput() {
     }
   }
 
+  if (!currentPartition_->complete() &&
+      partitionOffset_ == currentPartition_->numRows()) {
+    // All the received rows of a partial partition are output.
+    return nullptr;
+  }
+
   auto numOutputRows = std::min(numRowsPerOutput_, numRowsLeft);
   auto result = BaseVector::create<RowVector>(
       outputType_, numOutputRows, operatorCtx_->pool());
@@ -33,6 +33,18 @@ struct WindowFunctionArg {
 
 class WindowFunction {
  public:
+  /// Properties of a window function that the Window operator uses to choose
+  /// how to process its input.
+  struct Metadata {
+    /// True if the result for a row depends only on the row and the rows
+    /// before it in the partition, e.g. row_number and rank. The Window
+    /// operator can output the rows of a partition over sorted input before
+    /// all the rows of the partition have been received if all the functions
+    /// support streaming. Such functions do not look at the frames nor at the
+    /// end of the peer group of a row.
+    bool supportsStreaming{false};
+  };
+
   explicit WindowFunction(
       TypePtr resultType,
       memory::MemoryPool* pool,
@@ -149,16 +161,23 @@ using WindowFunctionFactory = std::function<std::unique_ptr<WindowFunction>(
 bool registerWindowFunction(
     const std::string& name,
     std::vector<FunctionSignaturePtr> signatures,
-    WindowFunctionFactory factory);
+    WindowFunctionFactory factory,
+    WindowFunction::Metadata metadata = {});
 
 /// Returns signatures of the window function with the specified name.
 /// Returns empty std::optional if function with that name is not found.
 std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
     const std::string& name);
 
+/// Returns the metadata of the window function with the specified name.
+/// Returns empty std::optional if function with that name is not found.
+std::optional<WindowFunction::Metadata> getWindowFunctionMetadata(
+    const std::string& name);
+
 struct WindowFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   WindowFunctionFactory factory;
+  WindowFunction::Metadata metadata;
 };
 
 using WindowFunctionMap = std::unordered_map<std::string, WindowFunctionEntry>;
@@ -15,6 +15,8 @@
  */
 #include "velox/exec/WindowPartition.h"
 
+#include <algorithm>
+
 namespace facebook::velox::exec {
 
 WindowPartition::WindowPartition(
@@ -24,9 +26,41 @@ WindowPartition::WindowPartition(
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
     : data_(data),
       partition_(rows),
+      partial_(false),
+      complete_(true),
+      columns_(columns),
+      sortKeyInfo_(sortKeyInfo) {}
+
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    const std::vector<exec::RowColumn>& columns,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : data_(data),
+      partial_(true),
+      complete_(false),
       columns_(columns),
       sortKeyInfo_(sortKeyInfo) {}
 
+void WindowPartition::addRows(const std::vector<char*>& rows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK(!complete_);
+  rows_.insert(rows_.end(), rows.begin(), rows.end());
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+void WindowPartition::removeProcessedRows(vector_size_t numProcessedRows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK_LE(numProcessedRows, numRows());
+  if (numProcessedRows <= startRow_) {
+    return;
+  }
+  const auto numRemoved = numProcessedRows - startRow_;
+  data_->eraseRows(folly::Range<char**>(rows_.data(), numRemoved));
+  rows_.erase(rows_.begin(), rows_.begin() + numRemoved);
+  partition_ = folly::Range(rows_.data(), rows_.size());
+  startRow_ = numProcessedRows;
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
@@ -47,7 +81,7 @@ void WindowPartition::extractColumn(
     vector_size_t resultOffset,
     const VectorPtr& result) const {
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -60,7 +94,7 @@ void WindowPartition::extractNulls(
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -154,11 +188,16 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
 
     if (i == 0 || i >= peerEnd) {
       // Compute peerStart and peerEnd rows for the first row of the partition
-      // or when past the previous peerGroup.
-      peerStart = i;
+      // or when past the previous peerGroup. The previous peer group of a
+      // partial partition can continue in the rows added after the previous
+      // call.
+      if (!partial_ || i == 0 || i != peerEnd ||
+          peerCompare(rowAt(peerStart), rowAt(i))) {
+        peerStart = i;
+      }
       peerEnd = i;
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        if (peerCompare(rowAt(peerStart), rowAt(peerEnd))) {
           break;
         }
         peerEnd++;
@@ -260,6 +299,155 @@ vector_size_t WindowPartition::linearSearchFrameValue(
   return end == numRows() ? numRows() + 1 : -1;
 }
 
+namespace {
+
+// Returns the first position in [begin, end) for which 'crossed' is true, or
+// 'end' if there is none. 'crossed' must be false for a prefix of the range
+// and true for the rest. The search gallops from 'hint' in exponentially
+// growing steps and finishes with a binary search, so a bound near the bound
+// of the previous row is found in a few comparisons even in a large
+// partition.
+template <typename Crossed>
+vector_size_t gallopingSearch(
+    vector_size_t begin,
+    vector_size_t end,
+    vector_size_t hint,
+    Crossed crossed) {
+  hint = std::clamp(hint, begin, end);
+  int64_t low;
+  int64_t high;
+  if (hint < end && !crossed(hint)) {
+    low = hint + 1;
+    high = low;
+    for (int64_t step = 1; high < end && !crossed(high); step *= 2) {
+      low = high + 1;
+      high = std::min<int64_t>(end, low + step);
+    }
+  } else {
+    low = begin;
+    high = hint;
+    for (int64_t step = 1; high - step >= begin; step *= 2) {
+      if (!crossed(high - step)) {
+        low = high - step + 1;
+        break;
+      }
+      high -= step;
+    }
+  }
+  while (low < high) {
+    const auto mid = low + (high - low) / 2;
+    if (crossed(mid)) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
+}
+
+bool isColumnarSortKeyType(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+const BaseVector* WindowPartition::sortKeyValues() const {
+  if (sortKeyValuesInitialized_) {
+    return sortKeyValues_.get();
+  }
+  sortKeyValuesInitialized_ = true;
+  // The rows of a partial partition change while it is output.
+  if (partial_ || partition_.empty()) {
+    return nullptr;
+  }
+  const auto column = sortKeyInfo_[0].first;
+  const auto& type = data_->columnTypes()[column];
+  if (!isColumnarSortKeyType(type->kind())) {
+    return nullptr;
+  }
+  auto values = BaseVector::create(type, partition_.size(), data_->pool());
+  RowContainer::extractColumn(
+      partition_.data(), partition_.size(), data_->columnAt(column), values);
+  // Nulls sort before or after all values and do not compare like values.
+  if (BaseVector::countNulls(values->nulls(), 0, partition_.size()) > 0) {
+    return nullptr;
+  }
+  sortKeyValues_ = std::move(values);
+  return sortKeyValues_.get();
+}
+
+// Produces the same bounds as the row by row search below. A start bound is
+// the first row that is not before the frame value and an end bound is the
+// row before the first row that is after the frame value.
+template <bool isAscending, typename T>
+void WindowPartition::updateKRangeFrameBounds(
+    bool firstMatch,
+    bool isPreceding,
+    vector_size_t startRow,
+    vector_size_t numRows,
+    column_index_t frameColumn,
+    const T* sortKeyValues,
+    const vector_size_t* rawPeerBounds,
+    vector_size_t* rawFrameBounds) const {
+  const auto& frameType = data_->columnTypes()[frameColumn];
+  VELOX_CHECK(frameType->equivalent(*sortKeyValues_->type()));
+  auto frameValues = BaseVector::create(frameType, numRows, data_->pool());
+  RowContainer::extractColumn(
+      partition_.data() + startRow,
+      numRows,
+      data_->columnAt(frameColumn),
+      frameValues);
+  const auto* frameVector = frameValues->asUnchecked<FlatVector<T>>();
+  const auto* rawFrameValues = frameVector->rawValues();
+
+  // Bounds of consecutive rows are usually close, so the search for a row
+  // starts at the bound of the previous row.
+  vector_size_t hint = startRow;
+  for (auto i = 0; i < numRows; ++i) {
+    // For NULL values, CURRENT ROW semantics apply. So get frame bound from
+    // peer buffer.
+    if (frameVector->isNullAt(i)) {
+      rawFrameBounds[i] = rawPeerBounds[i];
+      continue;
+    }
+    const auto currentRow = startRow + i;
+    const vector_size_t start = isPreceding ? 0 : currentRow;
+    const vector_size_t end = isPreceding ? currentRow + 1 : partition_.size();
+    const auto frameValue = rawFrameValues[i];
+    const auto crossed = [&](vector_size_t row) {
+      const auto result = SimpleVector<T>::comparePrimitiveAsc(
+          sortKeyValues[row], frameValue);
+      if constexpr (isAscending) {
+        return firstMatch ? result >= 0 : result > 0;
+      } else {
+        return firstMatch ? result <= 0 : result < 0;
+      }
+    };
+    const auto bound = gallopingSearch(start, end, hint, crossed);
+    hint = bound;
+    if (bound == end) {
+      // Return a row beyond the partition boundary. The logic to determine
+      // valid frames handles the out of bound and empty frames from this
+      // value.
+      rawFrameBounds[i] = end == this->numRows() ? this->numRows() + 1 : -1;
+    } else {
+      rawFrameBounds[i] = firstMatch ? bound : bound - 1;
+    }
+  }
+}
+
 template <bool isAscending>
 void WindowPartition::updateKRangeFrameBounds(
     bool firstMatch,
@@ -269,6 +457,40 @@ void WindowPartition::updateKRangeFrameBounds(
     column_index_t frameColumn,
     const vector_size_t* rawPeerBounds,
     vector_size_t* rawFrameBounds) const {
+  if (const auto* keys = sortKeyValues()) {
+    const auto search = [&](const auto* values) {
+      updateKRangeFrameBounds<isAscending>(
+          firstMatch,
+          isPreceding,
+          startRow,
+          numRows,
+          frameColumn,
+          values,
+          rawPeerBounds,
+          rawFrameBounds);
+    };
+    switch (keys->typeKind()) {
+      case TypeKind::TINYINT:
+        return search(keys->asUnchecked<FlatVector<int8_t>>()->rawValues());
+      case TypeKind::SMALLINT:
+        return search(keys->asUnchecked<FlatVector<int16_t>>()->rawValues());
+      case TypeKind::INTEGER:
+        return search(keys->asUnchecked<FlatVector<int32_t>>()->rawValues());
+      case TypeKind::BIGINT:
+        return search(keys->asUnchecked<FlatVector<int64_t>>()->rawValues());
+      case TypeKind::HUGEINT:
+        return search(keys->asUnchecked<FlatVector<int128_t>>()->rawValues());
+      case TypeKind::REAL:
+        return search(keys->asUnchecked<FlatVector<float>>()->rawValues());
+      case TypeKind::DOUBLE:
+        return search(keys->asUnchecked<FlatVector<double>>()->rawValues());
+      case TypeKind::TIMESTAMP:
+        return search(keys->asUnchecked<FlatVector<Timestamp>>()->rawValues());
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
   column_index_t orderByColumn = sortKeyInfo_[0].first;
   RowColumn frameRowColumn = data_->columnAt(frameColumn);
 
@@ -40,11 +40,48 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Constructs a partial WindowPartition that is output while its rows are
+  /// still being received. Rows are added with addRows() and the rows that
+  /// are already output are erased from 'data' with removeProcessedRows().
+  /// Row numbers stay relative to the first row of the partition, so only
+  /// the rows from the current output position onwards can be accessed.
+  WindowPartition(
+      RowContainer* data,
+      const std::vector<exec::RowColumn>& columns,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  /// Returns the number of rows in the current WindowPartition. For a partial
+  /// partition, this is the number of rows received so far, including the
+  /// removed ones.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
+  }
+
+  /// Returns true if the partition is partial.
+  bool partial() const {
+    return partial_;
   }
 
+  /// Returns true if all the rows of the partition have been added. Always
+  /// true for a non-partial partition.
+  bool complete() const {
+    return complete_;
+  }
+
+  /// Indicates that all the rows of a partial partition have been added.
+  void setComplete() {
+    VELOX_CHECK(partial_);
+    complete_ = true;
+  }
+
+  /// Appends 'rows' to a partial partition.
+  void addRows(const std::vector<char*>& rows);
+
+  /// Erases the rows before 'numProcessedRows' of a partial partition from
+  /// the RowContainer. These rows can not be accessed afterwards.
+  void removeProcessedRows(vector_size_t numProcessedRows);
+
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
   /// array from the partition input data.
@@ -128,6 +165,11 @@ class WindowPartition {
  private:
   bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
 
+  // Returns the row at 'row' of the partition. 'row' must not be removed.
+  char* rowAt(vector_size_t row) const {
+    return partition_[row - startRow_];
+  }
+
   // Searches for 'currentRow[frameColumn]' in 'orderByColumn' of rows between
   // 'start' and 'end' in the partition. 'firstMatch' specifies if first or last
   // row is matched.
@@ -149,6 +191,24 @@ class WindowPartition {
       column_index_t orderByColumn,
       column_index_t frameColumn) const;
 
+  // Returns a flat copy of the first ORDER BY column for all the rows of the
+  // partition, or nullptr if the column is not of a fixed width numeric or
+  // date type or has nulls. Made on first use.
+  const BaseVector* sortKeyValues() const;
+
+  // Same as updateKRangeFrameBounds() but searches 'sortKeyValues' instead
+  // of the rows.
+  template <bool isAscending, typename T>
+  void updateKRangeFrameBounds(
+      bool firstMatch,
+      bool isPreceding,
+      vector_size_t startRow,
+      vector_size_t numRows,
+      column_index_t frameColumn,
+      const T* sortKeyValues,
+      const vector_size_t* rawPeerBounds,
+      vector_size_t* rawFrameBounds) const;
+
   // Iterates over 'numBlockRows' and searches frame value for each row.
   template <bool isAscending>
   void updateKRangeFrameBounds(
@@ -170,6 +230,19 @@ class WindowPartition {
   // of WindowPartition.
   folly::Range<char**> partition_;
 
+  // True for a partial partition. Its rows are in 'rows_' and 'partition_'
+  // covers them.
+  const bool partial_;
+
+  // False while rows can still be added to a partial partition.
+  bool complete_;
+
+  // Rows of a partial partition that have not been removed.
+  std::vector<char*> rows_;
+
+  // Number of rows removed from the start of a partial partition.
+  vector_size_t startRow_{0};
+
   // Copy of the input RowColumn objects that are used for
   // accessing the partition row columns. These RowColumn objects
   // index into RowContainer data_ above and can retrieve the column values.
@@ -181,5 +254,13 @@ class WindowPartition {
 
   // ORDER BY column info for this partition.
   const std::vector<std::pair<column_index_t, core::SortOrder>> sortKeyInfo_;
+
+  // True if 'sortKeyValues_' has been made. 'sortKeyValues_' may be nullptr
+  // afterwards if the column can not be copied.
+  mutable bool sortKeyValuesInitialized_{false};
+
+  // Flat copy of the first ORDER BY column for the search of k range frame
+  // bounds.
+  mutable VectorPtr sortKeyValues_;
 };
 } // namespace facebook::velox::exec
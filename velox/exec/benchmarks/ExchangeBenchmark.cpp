@@ -354,6 +354,7 @@ Counters deep10kCounters;
 Counters flat50Counters;
 Counters deep50Counters;
 Counters localFlat10kCounters;
+Counters localFlat50Counters;
 Counters struct1kCounters;
 
 BENCHMARK(exchangeFlat10k) {
@@ -381,6 +382,12 @@ BENCHMARK(localFlat10k) {
       flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
 }
 
+// Small batches make the local exchange queues and their wakeups dominate.
+BENCHMARK_RELATIVE(localFlat50) {
+  bm->runLocal(
+      flat50, FLAGS_width, FLAGS_num_local_tasks, localFlat50Counters);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -456,7 +463,9 @@ int main(int argc, char** argv) {
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
             << "deep50: " << deep50Counters.toString() << std::endl
-            << "struct1k: " << struct1kCounters.toString() << std::endl;
+            << "struct1k: " << struct1kCounters.toString() << std::endl
+            << "localFlat10k: " << localFlat10kCounters.toString() << std::endl
+            << "localFlat50: " << localFlat50Counters.toString() << std::endl;
   return 0;
   return 0;
 }
@@ -33,6 +33,14 @@ DEFINE_int32(custom_hit_rate, 0, "Percentage of hits in custom test");
 DEFINE_int32(custom_key_spacing, 1, "Spacing between key values");
 
 DEFINE_int32(custom_num_ways, 10, "Number of build threads");
+DEFINE_int32(
+    custom_join_probe_group_size,
+    0,
+    "Number of probes run together in kHash mode in custom test. 0 means the "
+    "default");
+DEFINE_bool(custom_hash_mode, false, "Probe in kHash mode in custom test");
+
+DECLARE_bool(velox_hash_table_use_hugepages);
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -58,9 +66,13 @@ struct HashTableBenchmarkParams {
   // Title for reporting
   std::string title;
 
-  // Expected mode.
+  // Expected mode. kHash disables the array and normalized key modes.
   BaseHashTable::HashMode mode{BaseHashTable::HashMode::kNormalizedKey};
 
+  // Number of probes that joinProbe() runs together in kHash mode. 0 means
+  // the default of HashTable.
+  int32_t joinProbeGroupSize{0};
+
   int64_t buildSize;
 
   // Number of distinct probe rows. Not all are necessarily in the table.
@@ -83,13 +95,18 @@ struct HashTableBenchmarkParams {
   // VectorHasher.
   int32_t keySpacing{1};
 
+  // Whether the table is backed by huge pages.
+  bool hugePages{true};
+
   std::string toString() const {
     return fmt::format(
-        "{}: Rows={} Hit%={} NumProbes={}",
+        "{}: Rows={} Hit%={} NumProbes={} HugePages={} GroupSize={}",
         title,
         buildSize,
         insertPct,
-        size * numWays);
+        size * numWays,
+        hugePages,
+        joinProbeGroupSize);
   }
 };
 
@@ -144,6 +161,7 @@ class HashTableBenchmark : public VectorTestBase {
     rowOfKey_.clear();
     isInTable_.clear();
     params_ = params;
+    FLAGS_velox_hash_table_use_hugepages = params_.hugePages;
     std::vector<TypePtr> dependentTypes;
     int32_t sequence = 0;
     isInTable_.resize(
@@ -177,6 +195,9 @@ class HashTableBenchmark : public VectorTestBase {
           false,
           1'000,
           pool_.get());
+      if (params_.mode == BaseHashTable::HashMode::kHash) {
+        table->forceGenericHashMode();
+      }
 
       makeRows(params_.size, 1, sequence, params_.buildType, batches);
       copyVectorsToTable(batches, startOffset, table.get());
@@ -190,6 +211,9 @@ class HashTableBenchmark : public VectorTestBase {
       startOffset += params_.size;
     }
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    if (params_.joinProbeGroupSize != 0) {
+      topTable_->setJoinProbeGroupSize(params_.joinProbeGroupSize);
+    }
     LOG(INFO) << "Made table " << topTable_->toString();
 
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
@@ -637,13 +661,45 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
       HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+
+  // Probe throughput of large tables with and without huge pages.
+  for (auto [title, size, hitRate] :
+       std::vector<std::tuple<std::string, int64_t, int32_t>>{
+           {"Hit32M", 32000000, 100}, {"Miss32M", 32000000, 5}}) {
+    HashTableBenchmarkParams noHugePages(title + "NoHugePages", size, hitRate);
+    noHugePages.hugePages = false;
+    params.push_back(noHugePages);
+  }
+  // kHash mode probes of tables from 1M to 128M entries with different
+  // numbers of probes run together. The size of 1 probes one row at a time.
+  // Tables up to 1B entries can be run with --custom_hash_mode.
+  for (auto [title, size, hitRate] :
+       std::vector<std::tuple<std::string, int64_t, int32_t>>{
+           {"HashHit1M", 1000000, 100},
+           {"HashMiss1M", 1000000, 5},
+           {"HashHit32M", 32000000, 100},
+           {"HashMiss32M", 32000000, 5},
+           {"HashHit128M", 128000000, 100}}) {
+    for (auto groupSize : {1, 4, 16, 64}) {
+      HashTableBenchmarkParams hash(
+          fmt::format("{}Group{}", title, groupSize), size, hitRate);
+      hash.mode = BaseHashTable::HashMode::kHash;
+      hash.joinProbeGroupSize = groupSize;
+      params.push_back(hash);
+    }
+  }
   if (FLAGS_custom_size != 0) {
-    params.push_back(HashTableBenchmarkParams(
+    HashTableBenchmarkParams custom(
         "Custom",
         FLAGS_custom_size,
         FLAGS_custom_hit_rate,
         FLAGS_custom_key_spacing,
-        FLAGS_custom_num_ways));
+        FLAGS_custom_num_ways);
+    if (FLAGS_custom_hash_mode) {
+      custom.mode = BaseHashTable::HashMode::kHash;
+    }
+    custom.joinProbeGroupSize = FLAGS_custom_join_probe_group_size;
+    params.push_back(custom);
   }
 
   for (auto& param : params) {
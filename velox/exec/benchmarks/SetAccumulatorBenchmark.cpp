@@ -27,7 +27,8 @@ using namespace facebook::velox::exec;
 namespace {
 
 // Adds 10M mostly unique values to a single SetAccumulator, then extracts
-// unique values from it.
+// unique values from it. The small sets case adds the values to 1M
+// accumulators with about 10 values each.
 class SetAccumulatorBenchmark : public facebook::velox::test::VectorTestBase {
  public:
   void setup() {
@@ -69,6 +70,38 @@ class SetAccumulatorBenchmark : public facebook::velox::test::VectorTestBase {
     folly::doNotOptimizeAway(result);
   }
 
+  void runSmallBigints() {
+    constexpr int32_t kNumSets = 1'000'000;
+    const auto& type = rowVectors_[0]->childAt("a")->type();
+
+    HashStringAllocator allocator(pool());
+    using Accumulator = aggregate::prestosql::SetAccumulator<int64_t>;
+    std::vector<Accumulator> accumulators;
+    accumulators.reserve(kNumSets);
+    for (auto i = 0; i < kNumSets; ++i) {
+      accumulators.emplace_back(type, &allocator);
+    }
+
+    for (const auto& rowVector : rowVectors_) {
+      DecodedVector decoded(*rowVector->childAt("a"));
+      for (auto i = 0; i < rowVector->size(); ++i) {
+        accumulators[i % kNumSets].addValue(decoded, i, &allocator);
+      }
+    }
+
+    vector_size_t size = 0;
+    for (const auto& accumulator : accumulators) {
+      size += accumulator.size();
+    }
+    auto result = BaseVector::create<FlatVector<int64_t>>(type, size, pool());
+    vector_size_t offset = 0;
+    for (auto& accumulator : accumulators) {
+      offset += accumulator.extractValues(*result, offset);
+      accumulator.free(allocator);
+    }
+    folly::doNotOptimizeAway(result);
+  }
+
  private:
   template <typename T>
   void runPrimitive(const std::string& name) {
@@ -107,6 +140,10 @@ BENCHMARK(twoBigints) {
   bm->runTwoBigints();
 }
 
+BENCHMARK(smallBigints) {
+  bm->runSmallBigints();
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -175,6 +175,98 @@ void benchmarkComputeValueIdsForStrings(bool flattenDictionaries) {
   }
 }
 
+// Hashes 'numColumns' columns of 'size' rows, mixing the hashes of the
+// columns. If 'wrapInDictionary' is true, the columns are wrapped in identity
+// dictionaries, which hashes them one decoded row at a time.
+template <typename T>
+void benchmarkHash(
+    int32_t numColumns,
+    bool withNulls,
+    bool wrapInDictionary,
+    std::function<T(vector_size_t)> valueAt) {
+  folly::BenchmarkSuspender suspender;
+  constexpr vector_size_t kSize = 10'000;
+  BenchmarkBase base;
+  std::vector<VectorPtr> columns;
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto i = 0; i < numColumns; ++i) {
+    VectorPtr column = base.vectorMaker().flatVector<T>(
+        kSize,
+        [&](auto row) { return valueAt(row + i); },
+        withNulls ? test::VectorMaker::nullEvery(7) : nullptr);
+    if (wrapInDictionary) {
+      column = BaseVector::wrapInDictionary(
+          nullptr,
+          base.makeIndices(kSize, [](auto row) { return row; }),
+          kSize,
+          column);
+    }
+    hashers.push_back(VectorHasher::create(column->type(), i));
+    columns.push_back(std::move(column));
+  }
+  SelectivityVector rows(kSize);
+  raw_vector<uint64_t> hashes(kSize);
+  suspender.dismiss();
+
+  for (auto i = 0; i < 1'000; ++i) {
+    for (auto j = 0; j < numColumns; ++j) {
+      hashers[j]->decode(*columns[j], rows);
+      hashers[j]->hash(rows, j > 0, hashes);
+    }
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+int64_t bigintAt(vector_size_t row) {
+  return row * 7;
+}
+
+StringView stringAt(vector_size_t row) {
+  // Half of the strings are inline and half are out of line.
+  static const std::vector<std::string> kStrings = [] {
+    std::vector<std::string> strings;
+    for (auto i = 0; i < 1'000; ++i) {
+      strings.push_back(
+          i % 2 ? fmt::format("{}", i)
+                : fmt::format("a string that is out of line {}", i));
+    }
+    return strings;
+  }();
+  return StringView(kStrings[row % kStrings.size()]);
+}
+
+BENCHMARK(hashBigintDictionary) {
+  benchmarkHash<int64_t>(1, false, true, bigintAt);
+}
+
+BENCHMARK_RELATIVE(hashBigintFlat) {
+  benchmarkHash<int64_t>(1, false, false, bigintAt);
+}
+
+BENCHMARK(hashBigintWithNullsDictionary) {
+  benchmarkHash<int64_t>(1, true, true, bigintAt);
+}
+
+BENCHMARK_RELATIVE(hashBigintWithNullsFlat) {
+  benchmarkHash<int64_t>(1, true, false, bigintAt);
+}
+
+BENCHMARK(hash4BigintsDictionary) {
+  benchmarkHash<int64_t>(4, false, true, bigintAt);
+}
+
+BENCHMARK_RELATIVE(hash4BigintsFlat) {
+  benchmarkHash<int64_t>(4, false, false, bigintAt);
+}
+
+BENCHMARK(hashStringsDictionary) {
+  benchmarkHash<StringView>(2, false, true, stringAt);
+}
+
+BENCHMARK_RELATIVE(hashStringsFlat) {
+  benchmarkHash<StringView>(2, false, false, stringAt);
+}
+
 BENCHMARK(computeValueIdsDictionaryStrings) {
   benchmarkComputeValueIdsForStrings(false);
 }
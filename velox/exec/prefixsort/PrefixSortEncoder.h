@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 
 namespace facebook::velox::exec::prefixsort {
@@ -33,13 +34,13 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, float, double, Timestamp).
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
   /// 2. The remaining bytes are the encoding result of value:
-  ///    -If value is null, we set the remaining sizeof(T) bytes to '0', they
-  ///     do not affect the comparison results at all.
+  ///    -If value is null, we set the remaining encodedSize<T>() bytes to '0',
+  ///     they do not affect the comparison results at all.
   ///    -If value is not null, the result is set by calling encodeNoNulls.
   template <typename T>
   FOLLY_ALWAYS_INLINE void encode(std::optional<T> value, char* dest) const {
@@ -48,7 +49,36 @@ class PrefixSortEncoder {
       encodeNoNulls(value.value(), dest + 1);
     } else {
       dest[0] = nullsFirst_ ? 0 : 1;
-      simd::memset(dest + 1, 0, sizeof(T));
+      simd::memset(dest + 1, 0, encodedSize<T>());
+    }
+  }
+
+  /// Returns the number of bytes encodeNoNulls() writes for a value of type T.
+  /// Timestamp takes 12 bytes: 8 for the seconds and 4 for the nanos, which
+  /// are less than 2^32.
+  template <typename T>
+  static constexpr uint32_t encodedSize() {
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      return sizeof(int64_t) + sizeof(uint32_t);
+    }
+    return sizeof(T);
+  }
+
+  /// Encode the first 'encodeSize' bytes of a string. The layout of the null
+  /// byte is the same as for the primitive types. Strings shorter than
+  /// 'encodeSize' are padded with zeros, so the encoded result of a string
+  /// is only a prefix of the value: two strings with equal encoded results
+  /// must be compared using their full values.
+  FOLLY_ALWAYS_INLINE void encode(
+      std::optional<StringView> value,
+      char* dest,
+      uint32_t encodeSize) const {
+    if (value.has_value()) {
+      dest[0] = nullsFirst_ ? 1 : 0;
+      encodeNoNulls(value.value(), dest + 1, encodeSize);
+    } else {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, encodeSize);
     }
   }
 
@@ -57,6 +87,22 @@ class PrefixSortEncoder {
   template <typename T>
   FOLLY_ALWAYS_INLINE void encodeNoNulls(T value, char* dest) const;
 
+  /// Strings are compared byte by byte as unsigned chars, which is the same as
+  /// memcmp on the copied bytes. A shorter string is smaller than any longer
+  /// string it is a prefix of, which the zero padding preserves. For
+  /// descending order all the bytes, including the padding, are inverted.
+  FOLLY_ALWAYS_INLINE void
+  encodeNoNulls(StringView value, char* dest, uint32_t encodeSize) const {
+    const auto copySize = std::min<uint32_t>(value.size(), encodeSize);
+    simd::memcpy(dest, value.data(), copySize);
+    simd::memset(dest + copySize, 0, encodeSize - copySize);
+    if (!ascending_) {
+      for (uint32_t i = 0; i < encodeSize; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   bool isAscending() const {
     return ascending_;
   }
@@ -193,13 +239,14 @@ FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
 }
 
 /// When comparing Timestamp, first compare seconds and then compare nanos, so
-/// when encoding, just encode seconds and nanos in sequence.
+/// when encoding, just encode seconds and nanos in sequence. Nanos fit in 4
+/// bytes, so the key is 12 bytes instead of the 16 of the in-memory value.
 template <>
 FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
     Timestamp value,
     char* dest) const {
   encodeNoNulls(value.getSeconds(), dest);
-  encodeNoNulls(value.getNanos(), dest + 8);
+  encodeNoNulls(static_cast<uint32_t>(value.getNanos()), dest + 8);
 }
 
 } // namespace facebook::velox::exec::prefixsort
@@ -74,26 +74,28 @@ class PrefixEncoderTest : public testing::Test,
  public:
   template <typename T>
   void testEncodeNoNull(T value, char* expectedAsc, char* expectedDesc) {
-    char encoded[sizeof(T)];
+    constexpr auto kSize = PrefixSortEncoder::encodedSize<T>();
+    char encoded[kSize];
     ascNullsFirstEncoder_.encodeNoNulls(value, (char*)encoded);
-    ASSERT_EQ(std::memcmp(encoded, expectedAsc, sizeof(T)), 0);
+    ASSERT_EQ(std::memcmp(encoded, expectedAsc, kSize), 0);
     descNullsFirstEncoder_.encodeNoNulls(value, (char*)encoded);
-    ASSERT_EQ(std::memcmp(encoded, expectedDesc, sizeof(T)), 0);
+    ASSERT_EQ(std::memcmp(encoded, expectedDesc, kSize), 0);
   }
 
   template <typename T>
   void testEncodeWithNull(T testValue, char* expectedAsc, char* expectedDesc) {
+    constexpr auto kSize = PrefixSortEncoder::encodedSize<T>();
     std::optional<T> nullValue = std::nullopt;
     std::optional<T> value = testValue;
-    char encoded[sizeof(T) + 1];
-    char nullFirst[sizeof(T) + 1];
-    char nullLast[sizeof(T) + 1];
-    memset(nullFirst, 0, sizeof(T) + 1);
+    char encoded[kSize + 1];
+    char nullFirst[kSize + 1];
+    char nullLast[kSize + 1];
+    memset(nullFirst, 0, kSize + 1);
     memset(nullLast, 1, 1);
-    memset(nullLast + 1, 0, sizeof(T));
+    memset(nullLast + 1, 0, kSize);
 
     auto compare = [](char* left, char* right) {
-      return std::memcmp(left, right, sizeof(T) + 1);
+      return std::memcmp(left, right, kSize + 1);
     };
 
     ascNullsFirstEncoder_.encode(nullValue, encoded);
@@ -103,16 +105,16 @@ class PrefixEncoderTest : public testing::Test,
 
     ascNullsFirstEncoder_.encode(value, encoded);
     ASSERT_EQ(encoded[0], 1);
-    ASSERT_EQ(std::memcmp(encoded + 1, expectedAsc, sizeof(T)), 0);
+    ASSERT_EQ(std::memcmp(encoded + 1, expectedAsc, kSize), 0);
     ascNullsLastEncoder_.encode(value, encoded);
     ASSERT_EQ(encoded[0], 0);
-    ASSERT_EQ(std::memcmp(encoded + 1, expectedAsc, sizeof(T)), 0);
+    ASSERT_EQ(std::memcmp(encoded + 1, expectedAsc, kSize), 0);
     descNullsFirstEncoder_.encode(value, encoded);
     ASSERT_EQ(encoded[0], 1);
-    ASSERT_EQ(std::memcmp(encoded + 1, expectedDesc, sizeof(T)), 0);
+    ASSERT_EQ(std::memcmp(encoded + 1, expectedDesc, kSize), 0);
     descNullsLastEncoder_.encode(value, encoded);
     ASSERT_EQ(encoded[0], 0);
-    ASSERT_EQ(std::memcmp(encoded + 1, expectedDesc, sizeof(T)), 0);
+    ASSERT_EQ(std::memcmp(encoded + 1, expectedDesc, kSize), 0);
   }
 
   template <typename T>
@@ -123,12 +125,13 @@ class PrefixEncoderTest : public testing::Test,
 
   template <typename T>
   void testNullCompare() {
+    constexpr auto kSize = PrefixSortEncoder::encodedSize<T>();
     std::optional<T> nullValue = std::nullopt;
     std::optional<T> max = std::numeric_limits<T>::max();
     std::optional<T> min = std::numeric_limits<T>::min();
-    char encodedNull[sizeof(T) + 1];
-    char encodedMax[sizeof(T) + 1];
-    char encodedMin[sizeof(T) + 1];
+    char encodedNull[kSize + 1];
+    char encodedMax[kSize + 1];
+    char encodedMin[kSize + 1];
 
     auto encode = [&](auto& encoder) {
       encoder.encode(nullValue, encodedNull);
@@ -137,7 +140,7 @@ class PrefixEncoderTest : public testing::Test,
     };
 
     auto compare = [](char* left, char* right) {
-      return std::memcmp(left, right, sizeof(T) + 1);
+      return std::memcmp(left, right, kSize + 1);
     };
 
     // Nulls first: NULL < non-NULL.
@@ -155,7 +158,7 @@ class PrefixEncoderTest : public testing::Test,
     // For float / double`s NaN.
     if (TypeLimits<T>::isFloat) {
       std::optional<T> nan = TypeLimits<T>::nan();
-      char encodedNaN[sizeof(T) + 1];
+      char encodedNaN[kSize + 1];
 
       ascNullsFirstEncoder_.encode(nan, encodedNaN);
       ascNullsFirstEncoder_.encode(max, encodedMax);
@@ -169,12 +172,13 @@ class PrefixEncoderTest : public testing::Test,
 
   template <typename T>
   void testValidValueCompare() {
+    constexpr auto kSize = PrefixSortEncoder::encodedSize<T>();
     std::optional<T> max = std::numeric_limits<T>::max();
     std::optional<T> min = TypeLimits<T>::min();
     std::optional<T> mid = TypeLimits<T>::mid();
-    char encodedMax[sizeof(T) + 1];
-    char encodedMin[sizeof(T) + 1];
-    char encodedMid[sizeof(T) + 1];
+    char encodedMax[kSize + 1];
+    char encodedMin[kSize + 1];
+    char encodedMid[kSize + 1];
     auto encode = [&](auto& encoder) {
       encoder.encode(mid, encodedMid);
       encoder.encode(min, encodedMin);
@@ -182,7 +186,7 @@ class PrefixEncoderTest : public testing::Test,
     };
 
     auto compare = [](char* left, char* right) {
-      return std::memcmp(left, right, sizeof(T) + 1);
+      return std::memcmp(left, right, kSize + 1);
     };
 
     encode(ascNullsFirstEncoder_);
@@ -215,10 +219,11 @@ class PrefixEncoderTest : public testing::Test,
   template <TypeKind Kind>
   void testFuzz() {
     using ValueDataType = typename TypeTraits<Kind>::NativeType;
+    constexpr auto kSize = PrefixSortEncoder::encodedSize<ValueDataType>();
     const int vectorSize = 1024;
 
     auto compare = [](char* left, char* right) {
-      const auto result = std::memcmp(left, right, sizeof(ValueDataType) + 1);
+      const auto result = std::memcmp(left, right, kSize + 1);
       // Keeping the result of memory compare consistent with the result of
       // Vector`s compare method can facilitate ASSERT_EQ.
       return result < 0 ? -1 : (result > 0 ? 1 : 0);
@@ -241,8 +246,8 @@ class PrefixEncoderTest : public testing::Test,
           std::dynamic_pointer_cast<FlatVector<ValueDataType>>(
               fuzzer.fuzzFlat(type, vectorSize));
 
-      char leftEncoded[sizeof(ValueDataType) + 1];
-      char rightEncoded[sizeof(ValueDataType) + 1];
+      char leftEncoded[kSize + 1];
+      char rightEncoded[kSize + 1];
 
       for (auto i = 0; i < vectorSize; ++i) {
         const auto leftValue = leftVector->isNullAt(i)
@@ -321,13 +326,54 @@ TEST_F(PrefixEncoderTest, encode) {
     uint64_t ascExpected[2];
     uint64_t descExpected[2];
     ascExpected[0] = 0x4433221100000080;
-    ascExpected[1] = 0x4433221100000000;
+    ascExpected[1] = 0x0000000044332211;
     descExpected[0] = 0xbbccddeeffffff7f;
-    descExpected[1] = 0xbbccddeeffffffff;
+    descExpected[1] = 0x00000000bbccddee;
     testEncode<Timestamp>(value, (char*)ascExpected, (char*)descExpected);
   }
 }
 
+TEST_F(PrefixEncoderTest, encodeString) {
+  const PrefixSortEncoder ascEncoder(true, true);
+  const PrefixSortEncoder descEncoder(false, true);
+  constexpr uint32_t kEncodeSize = 8;
+  char abc[kEncodeSize + 1];
+  char abcd[kEncodeSize + 1];
+  char longString[kEncodeSize + 1];
+  char longStringSuffix[kEncodeSize + 1];
+  char null[kEncodeSize + 1];
+  auto compare = [](char* left, char* right) {
+    return std::memcmp(left, right, kEncodeSize + 1);
+  };
+
+  auto encode = [&](const PrefixSortEncoder& encoder) {
+    encoder.encode(std::optional<StringView>("abc"), abc, kEncodeSize);
+    encoder.encode(std::optional<StringView>("abcd"), abcd, kEncodeSize);
+    encoder.encode(
+        std::optional<StringView>("abcdefghijk"), longString, kEncodeSize);
+    encoder.encode(
+        std::optional<StringView>("abcdefghxyz"),
+        longStringSuffix,
+        kEncodeSize);
+    encoder.encode(std::nullopt, null, kEncodeSize);
+  };
+
+  encode(ascEncoder);
+  ASSERT_EQ(abc[0], 1);
+  ASSERT_EQ(std::memcmp(abc + 1, "abc\0\0\0\0\0", kEncodeSize), 0);
+  ASSERT_LT(compare(abc, abcd), 0);
+  ASSERT_LT(compare(abcd, longString), 0);
+  ASSERT_LT(compare(null, abc), 0);
+  // Only the prefix of the strings is encoded.
+  ASSERT_EQ(compare(longString, longStringSuffix), 0);
+
+  encode(descEncoder);
+  ASSERT_GT(compare(abc, abcd), 0);
+  ASSERT_GT(compare(abcd, longString), 0);
+  ASSERT_LT(compare(null, abc), 0);
+  ASSERT_EQ(compare(longString, longStringSuffix), 0);
+}
+
 TEST_F(PrefixEncoderTest, compare) {
   testCompare<uint64_t>();
   testCompare<uint32_t>();
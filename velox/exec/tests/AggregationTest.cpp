@@ -1037,6 +1037,181 @@ TEST_F(AggregationTest, partialAggregationMemoryLimitIncrease) {
   }
 }
 
+TEST_F(AggregationTest, partialAggregationResume) {
+  std::vector<RowVectorPtr> vectors;
+  // Unique keys make the partial aggregation abandon on the 2nd batch.
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(100, [&](auto row) { return i * 100 + row; }),
+        makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+    }));
+  }
+  // Few keys make the partial aggregation resume.
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(100, [](auto row) { return row % 5; }),
+        makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto resumeCheckRows : {0, 100}) {
+    SCOPED_TRACE(fmt::format("resumeCheckRows: {}", resumeCheckRows));
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, 100)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 50)
+            .config(
+                QueryConfig::kPartialAggregationResumeCheckRows,
+                resumeCheckRows)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"sum(c1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+    const auto planStats = toPlanStats(task->taskStats()).at(aggNodeId);
+    ASSERT_EQ(
+        planStats.customStats.at("abandonedPartialAggregation").sum, 1);
+    if (resumeCheckRows == 0) {
+      ASSERT_EQ(planStats.customStats.count("resumedPartialAggregation"), 0);
+      // All rows after the 2nd batch are passed through.
+      ASSERT_GT(planStats.outputRows, 1'000);
+    } else {
+      // The 4th batch is sampled and passed through. The 6th is sampled and
+      // aggregated, so 5 batches are passed through in total.
+      ASSERT_EQ(planStats.customStats.at("resumedPartialAggregation").sum, 1);
+      ASSERT_LT(planStats.outputRows, 600);
+    }
+  }
+}
+
+TEST_F(AggregationTest, hashPartitionedGroupBy) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) % 3'001; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [](auto row) { return fmt::format("key-{}", row % 7); },
+            nullEvery(11)),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto partitionBits : {0, 1, 3}) {
+    SCOPED_TRACE(fmt::format("partitionBits: {}", partitionBits));
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationHashPartitionBits, partitionBits)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0", "c1"}, {"sum(c2)", "max(c1)", "count(1)"})
+                  .planNode())
+        .assertResults(
+            "SELECT c0, c1, sum(c2), max(c1), count(1) FROM tmp GROUP BY 1, 2");
+
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationHashPartitionBits, partitionBits)
+        .config(QueryConfig::kPreferredOutputBatchRows, 100)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c1"}, {"sum(c2)"})
+                  .finalAggregation()
+                  .planNode())
+        .assertResults("SELECT c1, sum(c2) FROM tmp GROUP BY 1");
+
+    // Distinct.
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationHashPartitionBits, partitionBits)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, {})
+                  .planNode())
+        .assertResults("SELECT DISTINCT c0 FROM tmp");
+  }
+}
+
+TEST_F(AggregationTest, denseAccumulation) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) % 97; }),
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return i * 1'000 + row - 3'000; },
+            nullEvery(7)),
+        makeFlatVector<int8_t>(1'000, [](auto row) { return row % 101; }),
+        makeFlatVector<double>(
+            1'000, [](auto row) { return row * 0.25; }, nullEvery(5)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> aggregates = {
+      "sum(c1)",
+      "sum(c2)",
+      "sum(c3)",
+      "count(c1)",
+      "count(1)",
+      "min(c1)",
+      "max(c2)",
+      "avg(c1)",
+      "avg(c3)"};
+  const std::string sql =
+      "SELECT c0, sum(c1), sum(c2), sum(c3), count(c1), count(1), min(c1), "
+      "max(c2), avg(c1), avg(c3) FROM tmp GROUP BY 1";
+  for (const auto dense : {false, true}) {
+    SCOPED_TRACE(fmt::format("dense: {}", dense));
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationDenseAccumulation, dense)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, aggregates)
+                  .planNode())
+        .assertResults(sql);
+
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationDenseAccumulation, dense)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, aggregates)
+                  .finalAggregation()
+                  .planNode())
+        .assertResults(sql);
+
+    // The max of a double is not supported and all aggregates use the
+    // accumulators.
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationDenseAccumulation, dense)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, {"sum(c1)", "max(c3)"})
+                  .planNode())
+        .assertResults("SELECT c0, sum(c1), max(c3) FROM tmp GROUP BY 1");
+  }
+
+  // Checked integer sums still fail on overflow.
+  auto overflow = makeRowVector({
+      makeFlatVector<int32_t>({1, 1, 2}),
+      makeFlatVector<int64_t>({std::numeric_limits<int64_t>::max(), 1, 1}),
+  });
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(PlanBuilder()
+                             .values({overflow})
+                             .singleAggregation({"c0"}, {"sum(c1)"})
+                             .planNode())
+          .config(QueryConfig::kAggregationDenseAccumulation, true)
+          .copyResults(pool_.get()),
+      "integer overflow");
+}
+
 TEST_F(AggregationTest, partialAggregationMaybeReservationReleaseCheck) {
   auto vectors = {
       makeRowVector({makeFlatVector<int32_t>(
@@ -1328,6 +1503,66 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsOverPartialAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 17; }, nullEvery(13)),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  // The GroupId replicates the partial aggregation results instead of the
+  // input rows.
+  auto test = [&](const std::vector<std::vector<std::string>>& groupingSets,
+                  const std::string& duckDbGroupBy) {
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .groupingSetsAggregation(
+                        {"k1", "k2"},
+                        groupingSets,
+                        {"count(1) as count_1",
+                         "sum(a) as sum_a",
+                         "max(b) as max_b",
+                         "avg(a) as avg_a"})
+                    .project({"k1", "k2", "count_1", "sum_a", "max_b", "avg_a"})
+                    .planNode();
+    const auto& groupIdNode = plan->sources()[0]->sources()[0];
+    ASSERT_EQ(groupIdNode->name(), "GroupId");
+
+    auto task = assertQuery(
+        plan,
+        "SELECT k1, k2, count(1), sum(a), max(b), avg(a) FROM tmp "
+        "GROUP BY " +
+            duckDbGroupBy);
+    auto stats = toPlanStats(task->taskStats());
+    ASSERT_LT(stats.at(groupIdNode->id()).inputRows, size);
+  };
+
+  test({{"k1", "k2"}, {"k1"}, {}}, "ROLLUP (k1, k2)");
+  test({{"k1", "k2"}, {"k1"}, {"k2"}, {}}, "CUBE (k1, k2)");
+  test({{"k1"}, {"k2"}}, "GROUPING SETS ((k1), (k2))");
+
+  // A global grouping set over empty input returns one row.
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .filter("a < 0")
+                  .groupingSetsAggregation(
+                      {"k1", "k2"}, {{"k1"}, {}}, {"count(1) as count_1"})
+                  .project({"k1", "k2", "count_1"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1) FROM tmp WHERE a < 0 "
+      "GROUP BY GROUPING SETS ((k1), ())");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1803,26 +2038,50 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
   auto spillDirectory = exec::test::TempDirectoryPath::create();
+
   core::PlanNodeId aggrNodeId;
-  auto task =
-      AssertQueryBuilder(duckDbQueryRunner_)
-          .spillDirectory(spillDirectory->path)
-          .config(QueryConfig::kSpillEnabled, true)
-          .config(QueryConfig::kAggregationSpillEnabled, true)
-          .config(QueryConfig::kTestingSpillPct, "100")
-          .plan(PlanBuilder()
-                    .values(vectors)
-                    .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
-                    .capturePlanNodeId(aggrNodeId)
-                    .planNode())
-          .assertResults("SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
-  // Verify that spilling is not triggered.
-  const auto& queryConfig = task->queryCtx()->queryConfig();
-  ASSERT_TRUE(queryConfig.spillEnabled());
-  ASSERT_TRUE(queryConfig.aggregationSpillEnabled());
-  ASSERT_EQ(100, queryConfig.testingSpillPct());
-  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
-  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+
+  auto testPlan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    SCOPED_TRACE(sql);
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->path)
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .config(QueryConfig::kTestingSpillPct, "100")
+                    .plan(plan)
+                    .assertResults(sql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    checkSpillStats(stats, true);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  testPlan(plan, "SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
+
+  // Distinct aggregations over strings mixed with regular and sorted
+  // aggregations.
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c0 % 7", "c1", "c2", "c6"})
+             .singleAggregation(
+                 {"p0"},
+                 {"count(DISTINCT c6)",
+                  "sum(c2)",
+                  "array_agg(c1 ORDER BY c1)",
+                  "sum(DISTINCT c1)"},
+                 {})
+             .capturePlanNodeId(aggrNodeId)
+             .planNode();
+  testPlan(
+      plan,
+      "SELECT c0 % 7, count(DISTINCT c6), sum(c2), array_agg(c1 ORDER BY c1), "
+      "sum(DISTINCT c1) FROM tmp GROUP BY 1");
 }
 
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
@@ -1865,6 +2124,53 @@ TEST_F(AggregationTest, spillingForAggrsWithSorting) {
       plan, "SELECT c0 % 7, array_agg(c1 ORDER BY c1) FROM tmp GROUP BY 1");
 }
 
+TEST_F(AggregationTest, spillMergeFanIn) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+  core::PlanNodeId aggrNodeId;
+  // Few keys, each of which is in every spill run.
+  auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .project({"c0 % 7", "c1"})
+          .singleAggregation(
+              {"p0"}, {"sum(c1)", "count(1)", "array_agg(c1 ORDER BY c1)"})
+          .capturePlanNodeId(aggrNodeId)
+          .planNode();
+  const std::string sql =
+      "SELECT c0 % 7, sum(c1), count(1), array_agg(c1 ORDER BY c1) "
+      "FROM tmp GROUP BY 1";
+
+  for (const auto maxFanIn : {0, 2, 3, 100}) {
+    SCOPED_TRACE(fmt::format("maxFanIn: {}", maxFanIn));
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->path)
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .config(QueryConfig::kTestingSpillPct, "100")
+                    .config(
+                        QueryConfig::kSpillMaxMergeFanIn,
+                        std::to_string(maxFanIn))
+                    .plan(plan)
+                    .assertResults(sql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    checkSpillStats(stats, true);
+    const auto numRuns = stats.customStats["spillRuns"].sum;
+    ASSERT_GT(numRuns, 3);
+    if (maxFanIn == 0 || maxFanIn >= numRuns) {
+      ASSERT_EQ(stats.customStats.count("spillMergeLevels"), 0);
+    } else {
+      ASSERT_GT(stats.customStats["spillMergeLevels"].sum, 0);
+      ASSERT_GT(stats.customStats["spillMergeRuns"].sum, 0);
+    }
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 TEST_F(AggregationTest, distinctSpillWithMemoryLimit) {
   rowType_ = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
   VectorFuzzer fuzzer({}, pool());
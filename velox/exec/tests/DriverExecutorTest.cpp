@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverExecutor.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+class DriverExecutorTest : public OperatorTestBase {};
+
+TEST_F(DriverExecutorTest, runAll) {
+  DriverExecutor executor({.numThreads = 4});
+  ASSERT_EQ(executor.numThreads(), 4);
+  ASSERT_EQ(executor.currentWorker(), -1);
+
+  constexpr int32_t kNumTasks = 10'000;
+  std::atomic<int32_t> numRun{0};
+  std::atomic<int32_t> numOnWorker{0};
+  for (auto i = 0; i < kNumTasks; ++i) {
+    executor.add([&]() {
+      ++numRun;
+      if (executor.currentWorker() >= 0) {
+        ++numOnWorker;
+      }
+    });
+  }
+  executor.join();
+  ASSERT_EQ(numRun, kNumTasks);
+  ASSERT_EQ(numOnWorker, kNumTasks);
+  ASSERT_EQ(executor.stats().numTasks, kNumTasks);
+  VELOX_ASSERT_THROW(executor.add([]() {}), "stopped DriverExecutor");
+}
+
+TEST_F(DriverExecutorTest, steal) {
+  DriverExecutor executor({.numThreads = 2});
+  folly::Baton<> started;
+  folly::Baton<> release;
+  int32_t blockedWorker = -1;
+  executor.add(
+      [&]() {
+        blockedWorker = executor.currentWorker();
+        started.post();
+        release.wait();
+      },
+      0);
+  started.wait();
+
+  // One worker is blocked, so the other runs the next task for worker 0.
+  // Either this or the first task is stolen.
+  folly::Baton<> done;
+  int32_t worker = -1;
+  executor.add(
+      [&]() {
+        worker = executor.currentWorker();
+        done.post();
+      },
+      0);
+  done.wait();
+  ASSERT_EQ(worker, 1 - blockedWorker);
+  release.post();
+  executor.join();
+
+  const auto stats = executor.stats();
+  ASSERT_EQ(stats.numTasks, 2);
+  ASSERT_EQ(stats.numSteals, 1);
+  // The workers are not pinned, so they are all on node 0.
+  ASSERT_EQ(stats.numCrossNodeSteals, 0);
+  ASSERT_EQ(stats.numCrossNodeResumes, 0);
+}
+
+TEST_F(DriverExecutorTest, query) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data});
+
+  auto executor =
+      std::make_shared<DriverExecutor>(DriverExecutor::Options{.numThreads = 4});
+  auto queryCtx = std::make_shared<core::QueryCtx>(executor.get());
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .queryCtx(queryCtx)
+      .maxDrivers(4)
+      .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY c0");
+  queryCtx.reset();
+  executor->join();
+  ASSERT_GT(executor->stats().numTasks, 0);
+}
+
+} // namespace facebook::velox::exec::test
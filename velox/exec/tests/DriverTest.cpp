@@ -15,6 +15,7 @@
  */
 #include <folly/Unit.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <velox/exec/Driver.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -1419,6 +1420,83 @@ DEBUG_ONLY_TEST_F(DriverTest, driverCpuTimeSlicingCheck) {
   }
 }
 
+TEST_F(DriverTest, perfCounters) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}));
+  }
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .project({"c0 * 3 + 1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  for (const auto enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    std::shared_ptr<Task> task;
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kOperatorTrackPerfCounters,
+            enabled ? "true" : "false")
+        .copyResults(pool(), task);
+    const auto& customStats =
+        toPlanStats(task->taskStats()).at(projectId).customStats;
+    // Perf events may not be available, e.g. in a container.
+    const bool expectCounters =
+        enabled && PerfCounters::forThread() != nullptr;
+    ASSERT_EQ(customStats.count("perfCycles"), expectCounters ? 1 : 0);
+    ASSERT_EQ(customStats.count("perfInstructions"), expectCounters ? 1 : 0);
+    if (expectCounters) {
+      ASSERT_GT(customStats.at("perfInstructions").sum, 0);
+    }
+  }
+}
+
+TEST_F(DriverTest, timelineTrace) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 5; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+  }
+  auto plan =
+      PlanBuilder().values(batches).filter("c0 % 2 = 0").planFragment();
+
+  std::unordered_map<std::string, std::string> queryConfig{
+      {core::QueryConfig::kTimelineTraceEnabled, "true"}};
+  auto queryCtx = std::make_shared<core::QueryCtx>(
+      driverExecutor_.get(), std::move(queryConfig));
+  ASSERT_NE(queryCtx->timelineTracer(), nullptr);
+  auto task = Task::create(
+      "t0",
+      std::move(plan),
+      0,
+      queryCtx,
+      [](RowVectorPtr /*unused*/, ContinueFuture* /*unused*/) {
+        return exec::BlockingReason::kNotBlocked;
+      });
+  task->start(1, 1);
+  ASSERT_TRUE(waitForTaskCompletion(task.get(), 600'000'000));
+
+  const auto json = folly::parseJson(queryCtx->timelineTracer()->toJson());
+  std::unordered_map<std::string, int32_t> numEvents;
+  for (const auto& event : json["traceEvents"]) {
+    if (event["ph"] == "X") {
+      ++numEvents[event["cat"].asString() + " " + event["name"].asString()];
+    }
+  }
+  EXPECT_EQ(numEvents["operator FilterProject::addInput"], 5);
+  EXPECT_GT(numEvents["operator Values::getOutput"], 5);
+  EXPECT_GE(numEvents["driver queued"], 1);
+
+  // Disabled by default.
+  ASSERT_EQ(
+      std::make_shared<core::QueryCtx>(driverExecutor_.get())->timelineTracer(),
+      nullptr);
+}
+
 class OpCallStatusTest : public OperatorTestBase {};
 
 // Test that the opCallStatus is returned properly and formats the call as
@@ -27,6 +27,67 @@ namespace facebook::velox::exec {
 
 namespace {
 
+// Returns one page of 'pageBytes' per request and reports the next of
+// 'backlogs' as the bytes remaining at the source. At end after all of
+// 'backlogs' have been reported. Records the bytes asked for by each request.
+class BacklogExchangeSource : public ExchangeSource {
+ public:
+  BacklogExchangeSource(
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool,
+      int64_t pageBytes,
+      std::vector<std::vector<int64_t>> backlogs)
+      : ExchangeSource("backlog", 0, std::move(queue), pool),
+        pageBytes_(pageBytes),
+        backlogs_(std::move(backlogs)) {}
+
+  bool shouldRequestLocked() override {
+    if (atEnd_) {
+      return false;
+    }
+    return !requestPending_.exchange(true);
+  }
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      uint32_t /*maxWaitSeconds*/) override {
+    requestedBytes_.push_back(maxBytes);
+    std::vector<ContinuePromise> promises;
+    std::vector<int64_t> remainingBytes;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+      if (numResponses_ < backlogs_.size()) {
+        remainingBytes = backlogs_[numResponses_++];
+        auto ioBuf = folly::IOBuf::create(pageBytes_);
+        ioBuf->append(pageBytes_);
+        queue_->enqueueLocked(
+            std::make_unique<SerializedPage>(std::move(ioBuf)), promises);
+      } else {
+        atEnd_ = true;
+        queue_->enqueueLocked(nullptr, promises);
+      }
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+    return folly::makeSemiFuture(Response{
+        atEnd_ ? 0 : pageBytes_, atEnd_, std::move(remainingBytes)});
+  }
+
+  void close() override {}
+
+  const std::vector<uint32_t>& requestedBytes() const {
+    return requestedBytes_;
+  }
+
+ private:
+  const int64_t pageBytes_;
+  const std::vector<std::vector<int64_t>> backlogs_;
+  int32_t numResponses_{0};
+  std::vector<uint32_t> requestedBytes_;
+};
+
 class ExchangeClientTest : public testing::Test,
                            public velox::test::VectorTestBase {
  protected:
@@ -385,5 +446,54 @@ TEST_F(ExchangeClientTest, sourceTimeout) {
   test::testingShutdownLocalExchangeSource();
 }
 
+TEST_F(ExchangeClientTest, backlogSizedRequests) {
+  std::shared_ptr<BacklogExchangeSource> source;
+  ExchangeSource::registerFactory(
+      [&](const auto& /*taskId*/, auto /*destination*/, auto queue, auto pool)
+          -> std::shared_ptr<ExchangeSource> {
+        source = std::make_shared<BacklogExchangeSource>(
+            queue,
+            pool,
+            1'000,
+            std::vector<std::vector<int64_t>>{{4'000, 4'000}, {}});
+        return source;
+      });
+
+  auto client =
+      std::make_shared<ExchangeClient>("test", 0, 10 << 20, pool(), executor());
+  client->addRemoteTaskId("backlog");
+  client->noMoreRemoteTasks();
+
+  int32_t numPages = 0;
+  for (;;) {
+    bool atEnd;
+    ContinueFuture future;
+    auto pages = client->next(1, &atEnd, &future);
+    numPages += pages.size();
+    if (atEnd) {
+      break;
+    }
+    if (pages.empty()) {
+      auto& exec = folly::QueuedImmediateExecutor::instance();
+      std::move(future).via(&exec).wait();
+    }
+  }
+  ASSERT_EQ(numPages, 2);
+
+  // The first request asks for the default 1MB. The second asks for the
+  // whole backlog reported by the first response. The third asks for the
+  // average page size since the second response reported no backlog.
+  ASSERT_EQ(
+      source->requestedBytes(), (std::vector<uint32_t>{1 << 20, 8'000, 1'000}));
+
+  // The callback of the last response may not have run yet.
+  const auto stats = client->stats();
+  const auto& sourceWait = stats.at(ExchangeClient::kSourceWaitWallNanos);
+  ASSERT_GE(sourceWait.count, 2);
+  ASSERT_EQ(sourceWait.histogram->count(), sourceWait.count);
+
+  client->close();
+}
+
 } // namespace
 } // namespace facebook::velox::exec
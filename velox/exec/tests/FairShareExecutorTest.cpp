@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FairShareExecutor.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+class FairShareExecutorTest : public OperatorTestBase {};
+
+TEST_F(FairShareExecutorTest, levelOf) {
+  FairShareExecutor executor(
+      {.numThreads = 1, .levelThresholdsMs = {0, 10, 100}});
+  ASSERT_EQ(executor.numLevels(), 3);
+  ASSERT_EQ(executor.levelOf(0), 0);
+  ASSERT_EQ(executor.levelOf(9'999'999), 0);
+  ASSERT_EQ(executor.levelOf(10'000'000), 1);
+  ASSERT_EQ(executor.levelOf(99'999'999), 1);
+  ASSERT_EQ(executor.levelOf(100'000'000), 2);
+  ASSERT_EQ(executor.levelOf(1'000'000'000'000), 2);
+
+  VELOX_ASSERT_THROW(
+      FairShareExecutor({.numThreads = 1, .levelThresholdsMs = {10, 100}}),
+      "");
+  executor.join();
+  VELOX_ASSERT_THROW(executor.add([]() {}), "stopped FairShareExecutor");
+}
+
+TEST_F(FairShareExecutorTest, shortQueryFirst) {
+  FairShareExecutor executor({.numThreads = 1});
+  folly::Baton<> started;
+  folly::Baton<> release;
+  executor.add([&]() {
+    started.post();
+    release.wait();
+  });
+  started.wait();
+
+  // A query that has run for 10s is on level 2.
+  auto longQuery = std::make_shared<core::QueryCtx>();
+  longQuery->addDriverSchedulingTime(10'000'000'000, 0);
+  ASSERT_EQ(executor.levelOf(longQuery->driverScheduledNanos()), 2);
+  auto shortQuery = std::make_shared<core::QueryCtx>();
+
+  std::mutex mutex;
+  std::vector<std::string> order;
+  for (auto i = 0; i < 100; ++i) {
+    executor.add(
+        [&]() {
+          std::lock_guard<std::mutex> l(mutex);
+          order.push_back("long");
+        },
+        longQuery);
+  }
+  executor.add(
+      [&]() {
+        std::lock_guard<std::mutex> l(mutex);
+        order.push_back("short");
+      },
+      shortQuery);
+  release.post();
+  executor.join();
+
+  ASSERT_EQ(order.size(), 101);
+  ASSERT_EQ(order[0], "short");
+}
+
+TEST_F(FairShareExecutorTest, query) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data});
+
+  auto executor = std::make_shared<FairShareExecutor>(
+      FairShareExecutor::Options{.numThreads = 4});
+  auto queryCtx = std::make_shared<core::QueryCtx>(executor.get());
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .queryCtx(queryCtx)
+                  .maxDrivers(4)
+                  .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY c0");
+  const auto stats = task->taskStats();
+  ASSERT_GT(stats.queryScheduledNanos, 0);
+  task.reset();
+  queryCtx.reset();
+  executor->join();
+}
+
+} // namespace facebook::velox::exec::test
@@ -363,3 +363,29 @@ TEST_F(FilterProjectTest, numSilentThrow) {
   auto planStats = toPlanStats(task->taskStats());
   ASSERT_EQ(100, planStats.at(filterId).customStats.at("numSilentThrow").sum);
 }
+
+TEST_F(FilterProjectTest, recycleResults) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // The aggregation drops its input before the next batch is projected, so
+  // the projection results are recycled.
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 + c1 AS x"})
+                  .capturePlanNodeId(projectId)
+                  .singleAggregation({}, {"sum(x)"})
+                  .planNode();
+  auto task = assertQuery(plan, "SELECT sum(c0 + c1) FROM tmp");
+  auto planStats = toPlanStats(task->taskStats());
+  const auto& customStats = planStats.at(projectId).customStats;
+  ASSERT_LT(0, customStats.at("vectorPoolHits").sum);
+  ASSERT_LT(0, customStats.at("vectorPoolReleased").sum);
+}
@@ -1123,6 +1123,54 @@ DEBUG_ONLY_TEST_P(MultiThreadedHashJoinTest, parallelJoinBuildCheck) {
   ASSERT_EQ(numDrivers_ == 1, !isParallelBuild);
 }
 
+DEBUG_ONLY_TEST_P(MultiThreadedHashJoinTest, concurrentJoinBuildCheck) {
+  std::atomic<bool> isConcurrentBuild{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashTable::concurrentJoinBuild",
+      std::function<void(void*)>([&](void*) { isConcurrentBuild = true; }));
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .keyTypes({BIGINT(), VARCHAR()})
+      .probeVectors(1600, 5)
+      .buildVectors(1500, 5)
+      .config(core::QueryConfig::kConcurrentHashJoinBuild, "true")
+      .referenceQuery(
+          "SELECT t_k0, t_k1, t_data, u_k0, u_k1, u_data FROM t, u WHERE t_k0 = u_k0 AND t_k1 = u_k1")
+      .injectSpill(false)
+      .run();
+  ASSERT_EQ(numDrivers_ == 1, !isConcurrentBuild);
+}
+
+TEST_P(MultiThreadedHashJoinTest, concurrentJoinBuildWithDuplicates) {
+  // Few distinct build keys so that most build rows are repeats of a key
+  // inserted by another build driver. The keys are doubles so that the table
+  // is in kHash mode and not an array.
+  std::vector<RowVectorPtr> buildVectors;
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u_k0", "u_data"},
+        {makeFlatVector<double>(1'000, [](auto row) { return row % 97; }),
+         makeFlatVector<int64_t>(1'000, [i](auto row) { return i + row; })}));
+    probeVectors.push_back(makeRowVector(
+        {"t_k0", "t_data"},
+        {makeFlatVector<double>(100, [](auto row) { return row; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+  }
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"t_k0"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"u_k0"})
+      .buildVectors(std::move(buildVectors))
+      .config(core::QueryConfig::kConcurrentHashJoinBuild, "true")
+      .config(core::QueryConfig::kMinTableRowsForParallelJoinBuild, "0")
+      .injectSpill(false)
+      .referenceQuery(
+          "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t_k0 = u_k0")
+      .run();
+}
+
 DEBUG_ONLY_TEST_P(
     MultiThreadedHashJoinTest,
     raceBetweenTaskTerminateAndTableBuild) {
@@ -1312,6 +1360,42 @@ TEST_P(MultiThreadedHashJoinTest, arrayBasedLookup) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, hotKeys) {
+  std::vector<RowVectorPtr> probeVectors = {makeRowVector(
+      {makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row; })})};
+  // Nine in ten build rows have key 7. The other keys are all distinct.
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 3; ++i) {
+    buildVectors.push_back(
+        makeRowVector({makeFlatVector<int32_t>(1'000, [&](auto row) {
+          return row % 10 == 0 ? i * 1'000 + row : 7;
+        })}));
+  }
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"c0"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"c0"})
+      .buildVectors(std::move(buildVectors))
+      .joinOutputLayout({"c1"})
+      .referenceQuery("SELECT t.c1 FROM t, u WHERE t.c0 = u.c0")
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (hasSpill) {
+          return;
+        }
+        auto joinStats = task->taskStats()
+                             .pipelineStats.back()
+                             .operatorStats.back()
+                             .runtimeStats;
+        ASSERT_EQ(1, joinStats["hotKeys"].sum);
+        ASSERT_GE(joinStats["hotKeyRowsPct"].sum, 80);
+        ASSERT_LE(joinStats["hotKeyRowsPct"].sum, 100);
+      })
+      .run();
+}
+
 TEST_P(MultiThreadedHashJoinTest, joinSidesDifferentSchema) {
   // In this join, the tables have different schema. LHS table t has schema
   // {INTEGER, VARCHAR, INTEGER}. RHS table u has schema {INTEGER, REAL,
@@ -1536,6 +1620,45 @@ TEST_P(MultiThreadedHashJoinTest, leftSemiJoinFilterWithExtraFilter) {
   }
 }
 
+TEST_P(MultiThreadedHashJoinTest, semiAndAntiJoinFilterManyMatches) {
+  // Each probe row has 200 candidate build rows, which span many output
+  // batches.
+  std::vector<RowVectorPtr> probeVectors = {makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int32_t>(100, [](auto row) { return row % 5; }),
+       makeFlatVector<int32_t>(100, [](auto row) { return row * 10; })})};
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 5; }),
+       makeFlatVector<int32_t>(1'000, [](auto row) { return row; })})};
+
+  for (const auto& filter : {"t1 < u1", "t1 + 500 < u1", "t1 = u1"}) {
+    SCOPED_TRACE(filter);
+    for (const auto joinType :
+         {core::JoinType::kLeftSemiFilter, core::JoinType::kAnti}) {
+      auto testProbeVectors = probeVectors;
+      auto testBuildVectors = buildVectors;
+      HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+          .numDrivers(numDrivers_)
+          .probeKeys({"t0"})
+          .probeVectors(std::move(testProbeVectors))
+          .buildKeys({"u0"})
+          .buildVectors(std::move(testBuildVectors))
+          .joinType(joinType)
+          .joinFilter(filter)
+          .joinOutputLayout({"t0", "t1"})
+          .config(
+              core::QueryConfig::kPreferredOutputBatchRows, std::to_string(10))
+          .referenceQuery(fmt::format(
+              "SELECT t.* FROM t WHERE {} EXISTS "
+              "(SELECT * FROM u WHERE t0 = u0 AND {})",
+              joinType == core::JoinType::kAnti ? "NOT" : "",
+              filter))
+          .run();
+    }
+  }
+}
+
 TEST_P(MultiThreadedHashJoinTest, rightSemiJoinFilter) {
   HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
       .numDrivers(numDrivers_)
@@ -4595,6 +4718,102 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 1'000;
+  const int32_t numRowsBuild = 1'000;
+
+  // Distinct string keys, which can't be pushed down as an IN-list.
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<StringView>(
+            numRowsProbe,
+            [&](auto row) {
+              return StringView::makeInline(
+                  std::to_string(row + i * numRowsProbe));
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+  }
+  std::vector<exec::Split> probeSplits;
+  for (auto& file : tempFiles) {
+    probeSplits.push_back(exec::Split(makeHiveConnectorSplit(file->path)));
+  }
+
+  // Every 10th key of the probe side.
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u_c0", "u_c1"},
+      {makeFlatVector<StringView>(
+           numRowsBuild,
+           [](auto row) {
+             return StringView::makeInline(std::to_string(row * 10));
+           }),
+       makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; })})};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  core::PlanNodeId joinNodeId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(ROW({"c0", "c1"}, {VARCHAR(), BIGINT()}))
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .values(buildVectors)
+                        .planNode(),
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .capturePlanNodeId(joinNodeId)
+                .planNode();
+
+  for (const auto maxBytes : {0, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("maxBytes: {}", maxBytes));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .config(
+            core::QueryConfig::kHashJoinBloomFilterMaxBytes,
+            std::to_string(maxBytes))
+        .injectSpill(false)
+        .inputSplits({{probeScanId, probeSplits}})
+        .referenceQuery(
+            "SELECT t.c0, t.c1, u.u_c1 FROM t, u WHERE t.c0 = u.u_c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          if (maxBytes == 0) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(0, getFiltersAccepted(task, 0).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+            return;
+          }
+          auto planStats = toPlanStats(task->taskStats());
+          ASSERT_EQ(
+              1, planStats.at(joinNodeId).customStats.at("numBloomFilters").sum);
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          // The Bloom filter has false positives, so the join is not replaced
+          // with the filter.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          const auto numRejected =
+              getOperatorRuntimeStats(task, 0, "bloomFilterRejectedRows").sum;
+          ASSERT_GT(numRejected, 8'000);
+          ASSERT_LE(numRejected, 9'000);
+          ASSERT_EQ(
+              getInputPositions(task, 1),
+              numRowsProbe * numSplits - numRejected);
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersWithSkippedSplits) {
   const int32_t numSplits = 20;
   const int32_t numNonSkippedSplits = 10;
@@ -6217,6 +6436,44 @@ TEST_F(HashJoinTest, leftJoinWithMissAtEndOfBatch) {
   test("t_k2 > 9");
 }
 
+TEST_F(HashJoinTest, outputBatchBytes) {
+  // Each probe row matches one build row with a 1KB string.
+  std::vector<RowVectorPtr> probeVectors = {makeRowVector(
+      {"t0"}, {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })})};
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<std::string>(1'000, [](auto row) {
+         return std::string(1'000, 'a' + row % 26);
+       })})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"t0", "u1"})
+                  .capturePlanNodeId(joinId)
+                  .planNode();
+
+  // Rows of about 1KB limit the batches to 100 rows.
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchBytes, "100000")
+          .assertResults("SELECT t0, u1 FROM t, u WHERE t0 = u0");
+  auto stats = toPlanStats(task->taskStats()).at(joinId);
+  ASSERT_EQ(stats.outputRows, 1'000);
+  ASSERT_GE(stats.outputVectors, 10);
+}
+
 TEST_F(HashJoinTest, leftJoinWithMissAtEndOfBatchMultipleBuildMatches) {
   // Tests some cases where the row at the end of an output batch fails the
   // filter and there are multiple matches with the build side..
@@ -135,7 +135,13 @@ class HashTableTest : public testing::TestWithParam<bool>,
             buildType->childAt(channel), channel));
       }
       auto table = HashTable<true>::createForJoin(
-          std::move(keyHashers), dependentTypes, true, false, 1'000, pool());
+          std::move(keyHashers),
+          dependentTypes,
+          true,
+          false,
+          1'000,
+          pool(),
+          concurrentJoinBuild_);
 
       makeRows(size, 1, sequence, buildType, batches);
       copyVectorsToTable(batches, startOffset, table.get());
@@ -558,6 +564,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Builds the join tables with concurrent inserts if true.
+  bool concurrentJoinBuild_{false};
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -610,6 +618,44 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, string2NormalizedConcurrentBuild) {
+  auto type = ROW({"k1", "k2"}, {VARCHAR(), VARCHAR()});
+  concurrentJoinBuild_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 5000, 19, type, 2);
+}
+
+TEST_P(HashTableTest, mixed6SparseConcurrentBuild) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  concurrentJoinBuild_ = true;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
+TEST_P(HashTableTest, joinProbeGroupSize) {
+  // A struct key is always probed in kHash mode.
+  auto type = ROW({"key"}, {ROW({"k1", "k2"}, {BIGINT(), VARCHAR()})});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  testCycle(BaseHashTable::HashMode::kHash, 10000, 2, type, 1);
+  ASSERT_EQ(
+      topTable_->joinProbeGroupSize(),
+      HashTable<true>::kDefaultJoinProbeGroupSize);
+
+  // Groups that do not divide the number of probes leave a partial group.
+  for (auto groupSize : {1, 3, 7, HashTable<true>::kMaxJoinProbeGroupSize}) {
+    SCOPED_TRACE(fmt::format("groupSize: {}", groupSize));
+    topTable_->setJoinProbeGroupSize(groupSize);
+    testProbe();
+  }
+  VELOX_ASSERT_THROW(topTable_->setJoinProbeGroupSize(0), "");
+  VELOX_ASSERT_THROW(
+      topTable_->setJoinProbeGroupSize(
+          HashTable<true>::kMaxJoinProbeGroupSize + 1),
+      "");
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -1039,6 +1085,54 @@ DEBUG_ONLY_TEST_P(HashTableTest, failureInCreateRowPartitions) {
   executor_->join();
 }
 
+TEST_P(HashTableTest, predictHashMode) {
+  const auto makeTable = [&](const RowVectorPtr& data) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    auto table = HashTable<false>::createForJoin(
+        std::move(hashers),
+        {}, /*dependentTypes*/
+        true /*allowDuplicates*/,
+        false /*hasProbedFlag*/,
+        1 /*minTableSizeForParallelJoinBuild*/,
+        pool());
+    SelectivityVector rows(data->size());
+    raw_vector<uint64_t> hashes(data->size());
+    auto& hasher = table->hashers()[0];
+    hasher->decode(*data->childAt(0), rows);
+    EXPECT_TRUE(hasher->computeValueIds(rows, hashes));
+    store(*table->rows(), data);
+    return table;
+  };
+
+  // Distinct keys spread over too large a range for range mode are expected
+  // to overflow the distinct values.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          10'000, [](auto row) { return row * 100'000'000'000'000L; }),
+  });
+  auto table = makeTable(data);
+  ASSERT_TRUE(table->predictHashMode(data->size()));
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+  table->prepareJoinTable({});
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+  ASSERT_EQ(table->numDistinct(), data->size());
+  ASSERT_EQ(table->stats().numRehashes, 1);
+
+  // Keys in a small range or with few distinct values keep the mode open.
+  for (const auto& keys : std::vector<VectorPtr>{
+           makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+           makeFlatVector<int64_t>(
+               10'000, [](auto row) { return (row % 10) * 1'000'000'007L; }),
+       }) {
+    data = makeRowVector({keys});
+    table = makeTable(data);
+    ASSERT_FALSE(table->predictHashMode(data->size()));
+    table->prepareJoinTable({});
+    ASSERT_NE(table->hashMode(), BaseHashTable::HashMode::kHash);
+  }
+}
+
 TEST_P(HashTableTest, toStringSingleKey) {
   std::vector<std::unique_ptr<VectorHasher>> hashers;
   hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -108,6 +110,57 @@ TEST_F(LimitTest, limitOverLocalExchange) {
   ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
 }
 
+TEST_F(LimitTest, pushdownToTableScan) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize, [&](auto row) { return batchSize * i + row; }),
+        makeFlatVector<int32_t>(batchSize, [](auto row) { return row % 7; }),
+    }));
+  }
+  auto file = TempFilePath::create();
+  writeToFile(file->path, vectors);
+  createDuckDbTable(vectors);
+
+  const auto rowType = asRowType(vectors[0]->type());
+  core::PlanNodeId scanNodeId;
+  auto makePlan = [&](const std::vector<std::string>& filters,
+                      int64_t offset,
+                      int64_t limit) {
+    return PlanBuilder()
+        .tableScan(rowType, filters)
+        .capturePlanNodeId(scanNodeId)
+        .limit(offset, limit, true)
+        .planNode();
+  };
+  // Returns the number of rows read by the scan.
+  auto assertLimit = [&](int64_t offset,
+                         int64_t limit,
+                         const std::string& duckDbSql) {
+    auto task =
+        AssertQueryBuilder(makePlan({}, offset, limit), duckDbQueryRunner_)
+            .split(makeHiveConnectorSplit(file->path))
+            .assertResults(duckDbSql);
+    return toPlanStats(task->taskStats()).at(scanNodeId).rawInputRows;
+  };
+
+  // Without filters, the scan reads only the rows that the limit uses.
+  ASSERT_EQ(assertLimit(0, 10, "SELECT * FROM tmp LIMIT 10"), 10);
+  ASSERT_EQ(
+      assertLimit(17, 983, "SELECT * FROM tmp OFFSET 17 LIMIT 983"), 1'000);
+  ASSERT_EQ(assertLimit(0, 5'000, "SELECT * FROM tmp"), 3'000);
+
+  // With a filter, the scan reads full batches.
+  std::shared_ptr<exec::Task> task;
+  auto result = AssertQueryBuilder(makePlan({"c1 = 3"}, 0, 10))
+                    .split(makeHiveConnectorSplit(file->path))
+                    .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 10);
+  ASSERT_GT(toPlanStats(task->taskStats()).at(scanNodeId).rawInputRows, 10);
+}
+
 TEST_F(LimitTest, partialLimitEagerFlush) {
   std::vector<RowVectorPtr> batches(
       10, makeRowVector({makeFlatVector(std::vector<int64_t>(1, 0))}));
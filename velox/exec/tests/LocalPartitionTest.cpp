@@ -13,10 +13,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/Fs.h"
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/RangePartitionFunction.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -192,6 +196,52 @@ TEST_F(LocalPartitionTest, partition) {
   verifyExchangeSourceOperatorStats(task, 300, 6);
 }
 
+TEST_F(LocalPartitionTest, rangePartitionOrderBy) {
+  // Sorts the ranges of the keys in parallel and merges the sorted ranges.
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row * 7'919) % 3'001; }, nullEvery(97)),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data});
+
+  for (const auto& sortOrder : {core::kAscNullsLast, core::kDescNullsFirst}) {
+    const auto orderBy = fmt::format("c0 {}", sortOrder.toString());
+    SCOPED_TRACE(orderBy);
+    auto spec = std::make_shared<RangePartitionFunctionSpec>(
+        asRowType(data->type()),
+        std::vector<column_index_t>{0},
+        std::vector<core::SortOrder>{sortOrder},
+        RangePartitionFunctionSpec::computeSplitPoints(
+            *data, {0}, {sortOrder}, 16, pool()));
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .localMerge(
+                {orderBy},
+                {PlanBuilder(planNodeIdGenerator)
+                     .values(split(data, 20))
+                     .addNode([&](auto nodeId, auto source) {
+                       return std::make_shared<core::LocalPartitionNode>(
+                           nodeId,
+                           core::LocalPartitionNode::Type::kRepartition,
+                           spec,
+                           std::vector<core::PlanNodePtr>{source});
+                     })
+                     .orderBy({orderBy}, true)
+                     .planNode()})
+            .planNode();
+
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(4)
+        .assertResults(
+            fmt::format("SELECT * FROM tmp ORDER BY {}", orderBy),
+            std::vector<uint32_t>{0});
+  }
+}
+
 TEST_F(LocalPartitionTest, maxBufferSizeGather) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
@@ -624,3 +674,165 @@ TEST_F(LocalPartitionTest, unionAllLocalExchange) {
       "   SELECT * FROM (VALUES ('y')) as t2(c0)"
       ")");
 }
+
+TEST_F(LocalPartitionTest, keyHashes) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        {"c0", "c1", "c2"},
+        {makeFlatVector<int64_t>(
+             1'000, [&](auto row) { return (i * 1'000 + row) * 7'919; }),
+         makeFlatVector<std::string>(
+             1'000, [](auto row) { return fmt::format("s{}", row % 17); }),
+         makeFlatSequence<int32_t>(i, 1'000)}));
+  }
+  createDuckDbTable(vectors);
+
+  // The key hashes are the same as those of a hash table in kHash mode.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .localPartitionWithKeyHashes({"c1", "c0"})
+                  .planNode();
+  ASSERT_EQ(
+      plan->outputType()->names().back(),
+      core::LocalPartitionNode::kKeyHashColumn);
+  auto result = AssertQueryBuilder(plan).maxDrivers(2).copyResults(pool());
+  ASSERT_EQ(result->size(), 3'000);
+  SelectivityVector rows(result->size());
+  raw_vector<uint64_t> hashes(result->size());
+  auto c1Hasher = VectorHasher::create(VARCHAR(), 1);
+  c1Hasher->decode(*result->childAt(1), rows);
+  c1Hasher->hash(rows, false, hashes);
+  auto c0Hasher = VectorHasher::create(BIGINT(), 0);
+  c0Hasher->decode(*result->childAt(0), rows);
+  c0Hasher->hash(rows, true, hashes);
+  auto* keyHashes = result->childAt(3)->asFlatVector<int64_t>();
+  for (auto i = 0; i < result->size(); ++i) {
+    ASSERT_EQ(static_cast<uint64_t>(keyHashes->valueAt(i)), hashes[i]);
+  }
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .localPartitionWithKeyHashes({"c1", "c0"})
+             .singleAggregation({"c1", "c0"}, {"sum(c2)"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(2)
+      .assertResults("SELECT c1, c0, sum(c2) FROM tmp GROUP BY 1, 2");
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values(vectors)
+             .project({"c0 AS t0", "c2 AS t2"})
+             .hashJoin(
+                 {"t0"},
+                 {"c0"},
+                 PlanBuilder(planNodeIdGenerator)
+                     .values(vectors)
+                     .localPartitionWithKeyHashes({"c0"})
+                     .planNode(),
+                 "",
+                 {"t0", "t2", "c1", "c2"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(2)
+      .assertResults(
+          "SELECT a.c0, a.c2, b.c1, b.c2 FROM tmp a, tmp b WHERE a.c0 = b.c0");
+}
+
+TEST_F(LocalPartitionTest, scaleWriter) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({makeFlatSequence<int64_t>(i * 100, 100)}));
+  }
+  createDuckDbTable(vectors);
+  const auto rowType = asRowType(vectors[0]->type());
+
+  // Returns the splits of the written files.
+  std::vector<std::shared_ptr<TempDirectoryPath>> outputDirectories;
+  auto write = [&](bool scale) {
+    const auto outputDirectory = TempDirectoryPath::create();
+    outputDirectories.push_back(outputDirectory);
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .scaleWriterLocalPartitionRoundRobin()
+                    .tableWrite(outputDirectory->path)
+                    .planNode();
+    AssertQueryBuilder builder(plan);
+    builder.maxDrivers(4);
+    if (scale) {
+      // Adds writers as soon as the local exchange buffer is half full.
+      builder.config(core::QueryConfig::kScaleWriterMinProcessedBytes, "0")
+          .config(core::QueryConfig::kMaxLocalExchangeBufferSize, "1");
+    }
+    std::shared_ptr<Task> task;
+    builder.copyResults(pool(), task);
+    const auto scaledWriters = toPlanStats(task->taskStats())
+                                   .at(plan->sources()[0]->id())
+                                   .customStats.at("scaledWriters");
+    EXPECT_GE(scaledWriters.min, 1);
+    EXPECT_LE(scaledWriters.max, 4);
+    if (!scale) {
+      EXPECT_EQ(scaledWriters.max, 1);
+    }
+
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& entry :
+         fs::recursive_directory_iterator(outputDirectory->path)) {
+      if (entry.is_regular_file()) {
+        splits.push_back(makeHiveConnectorSplit(entry.path().string()));
+      }
+    }
+    return splits;
+  };
+
+  // The input is small, so a single writer writes it.
+  auto splits = write(false);
+  ASSERT_EQ(splits.size(), 1);
+  assertQuery(
+      PlanBuilder().tableScan(rowType).planNode(), splits, "SELECT * FROM tmp");
+
+  splits = write(true);
+  ASSERT_GE(splits.size(), 1);
+  ASSERT_LE(splits.size(), 4);
+  assertQuery(
+      PlanBuilder().tableScan(rowType).planNode(), splits, "SELECT * FROM tmp");
+}
+
+TEST_F(LocalPartitionTest, queueWakeups) {
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(1);
+  LocalExchangeQueue queue(memoryManager, 0);
+  queue.addProducer();
+  queue.noMoreProducers();
+
+  RowVectorPtr data;
+  ContinueFuture firstConsumer;
+  ContinueFuture secondConsumer;
+  ASSERT_EQ(
+      queue.next(&firstConsumer, pool(), &data),
+      BlockingReason::kWaitForProducer);
+  ASSERT_EQ(
+      queue.next(&secondConsumer, pool(), &data),
+      BlockingReason::kWaitForProducer);
+
+  // One batch wakes up one consumer. The producer is blocked since the batch
+  // exceeds the buffer size.
+  auto input = makeRowVector({makeFlatSequence<int64_t>(0, 100)});
+  ContinueFuture producer;
+  ASSERT_EQ(queue.enqueue(input, &producer), BlockingReason::kWaitForConsumer);
+  ASSERT_NE(firstConsumer.isReady(), secondConsumer.isReady());
+  ASSERT_FALSE(producer.isReady());
+
+  ContinueFuture future;
+  ASSERT_EQ(queue.next(&future, pool(), &data), BlockingReason::kNotBlocked);
+  ASSERT_EQ(data, input);
+  ASSERT_TRUE(producer.isReady());
+
+  // The end of data wakes up all consumers.
+  queue.noMoreData();
+  ASSERT_TRUE(firstConsumer.isReady());
+  ASSERT_TRUE(secondConsumer.isReady());
+  ASSERT_EQ(queue.next(&future, pool(), &data), BlockingReason::kNotBlocked);
+  ASSERT_EQ(data, nullptr);
+  ASSERT_TRUE(queue.isFinished());
+}
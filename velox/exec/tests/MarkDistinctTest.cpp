@@ -141,3 +141,46 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, preGrouped) {
+  // Input clustered on (c0, c1). Runs of equal keys, including null keys,
+  // span batches.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) / 300; }),
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) {
+              return StringView::makeInline(
+                  std::to_string((i * 1'000 + row) / 70));
+            },
+            [&](auto row) { return (i * 1'000 + row) / 300 % 3 == 0; }),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .markDistinct("c0_c1_distinct", {"c0", "c1"})
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .markDistinct("c0_c1_distinct", {"c0", "c1"}, true /*preGrouped*/)
+             .planNode();
+  auto results = AssertQueryBuilder(plan).copyResults(pool());
+  assertEqualVectors(expected, results);
+
+  // count(DISTINCT) over the marked rows.
+  createDuckDbTable(vectors);
+  plan = PlanBuilder()
+             .values(vectors)
+             .markDistinct("c1_distinct", {"c0", "c1"}, true /*preGrouped*/)
+             .singleAggregation({"c0"}, {"count(c1)"}, {"c1_distinct"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT c0, count(distinct c1) FROM tmp GROUP BY 1");
+}
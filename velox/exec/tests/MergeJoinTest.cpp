@@ -540,6 +540,71 @@ TEST_F(MergeJoinTest, nullKeys) {
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
 }
 
+TEST_F(MergeJoinTest, multipleKeysDictionaryOutput) {
+  // Runs of equal keys on two keys of different types. Key values are shared
+  // by multiple rows on both sides and some keys have no match.
+  auto left = makeRowVector(
+      {"t0", "t1", "t2"},
+      {
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row / 100; }),
+          makeFlatVector<StringView>(
+              1'000,
+              [](auto row) {
+                return StringView::makeInline(
+                    fmt::format("key-{:02}", row % 100 / 7));
+              }),
+          makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+      });
+  auto right = makeRowVector(
+      {"u0", "u1", "u2"},
+      {
+          makeFlatVector<int64_t>(500, [](auto row) { return row / 50; }),
+          makeFlatVector<StringView>(
+              500,
+              [](auto row) {
+                return StringView::makeInline(
+                    fmt::format("key-{:02}", row % 50 / 3));
+              }),
+          makeFlatVector<int32_t>(500, [](auto row) { return row * 10; }),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values({left})
+            .mergeJoin(
+                {"t0", "t1"},
+                {"u0", "u1"},
+                PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                "",
+                {"t0", "t1", "t2", "u2"},
+                joinType)
+            .planNode();
+    const std::string sql = joinType == core::JoinType::kInner
+        ? "SELECT t0, t1, t2, u2 FROM t, u WHERE t0 = u0 AND t1 = u1"
+        : "SELECT t0, t1, t2, u2 FROM t LEFT JOIN u ON t0 = u0 AND t1 = u1";
+
+    for (auto batchSize : {16, 1024}) {
+      assertQuery(makeCursorParameters(plan, batchSize), sql);
+    }
+
+    // With a single batch of input on each side, the output refers to the
+    // input instead of copying it.
+    auto [cursor, results] =
+        readCursor(makeCursorParameters(plan, 1024), [](Task*) {});
+    ASSERT_FALSE(results.empty());
+    for (const auto& result : results) {
+      for (const auto& child : result->children()) {
+        ASSERT_NE(child->encoding(), VectorEncoding::Simple::FLAT);
+      }
+    }
+  }
+}
+
 TEST_F(MergeJoinTest, complexTypedFilter) {
   constexpr vector_size_t size{1000};
 
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
@@ -421,3 +422,102 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, rangeJoin) {
+  // Intervals on the build side, with some null bounds.
+  auto probeVectors = {
+      makeRowVector(
+          {"t0", "t1"},
+          {makeNullableFlatVector<int64_t>({5, 17, std::nullopt, 40, 3, 22}),
+           sequence<int32_t>(6)}),
+      makeRowVector(
+          {"t0", "t1"},
+          {makeFlatVector<int64_t>(500, [](auto row) { return row % 97; }),
+           sequence<int32_t>(500, 6)}),
+  };
+  auto buildVectors = {
+      makeRowVector(
+          {"u0", "u1"},
+          {makeNullableFlatVector<int64_t>({10, std::nullopt, 0, 20, 35}),
+           makeNullableFlatVector<int64_t>({20, 30, 4, std::nullopt, 50})}),
+      makeRowVector(
+          {"u0", "u1"},
+          {makeFlatVector<int64_t>(300, [](auto row) { return row % 60; }),
+           makeFlatVector<int64_t>(
+               300, [](auto row) { return row % 60 + row % 13; })}),
+  };
+
+  setComparisons({""});
+  setJoinTypes(
+      {core::JoinType::kInner,
+       core::JoinType::kLeft,
+       core::JoinType::kRight,
+       core::JoinType::kFull});
+  setOutputLayout({"t0", "t1", "u0", "u1"});
+  setJoinConditionStr("t0 BETWEEN u0 AND u1{}");
+  setQueryStr(
+      "SELECT t0, t1, u0, u1 FROM t {0} JOIN u ON t0 BETWEEN u0 AND u1{1}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  // Bounds on either side of the comparison, combined with other conjuncts.
+  setComparisons({"", " AND t1 % 3 = 0", " AND t0 + u0 < 100"});
+  setJoinTypes({core::JoinType::kInner, core::JoinType::kLeft});
+  setJoinConditionStr("u0 < t0 AND t0 <= u1{}");
+  setQueryStr(
+      "SELECT t0, t1, u0, u1 FROM t {0} JOIN u ON u0 < t0 AND t0 <= u1{1}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  setJoinConditionStr("t0 > u1{}");
+  setQueryStr("SELECT t0, t1, u0, u1 FROM t {0} JOIN u ON t0 > u1{1}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
+TEST_F(NestedLoopJoinTest, findRange) {
+  auto probe = makeRowVector(
+      {"t0", "t1", "t2"},
+      {makeFlatVector<int64_t>({1}),
+       makeFlatVector<double>({1.0}),
+       makeFlatVector<int32_t>({1})});
+  auto build = makeRowVector(
+      {"u0", "u1", "u2"},
+      {makeFlatVector<int64_t>({1}),
+       makeFlatVector<double>({1.0}),
+       makeFlatVector<int64_t>({1})});
+
+  auto findRange = [&](const std::string& condition, core::JoinType joinType) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probe})
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values({build})
+                            .planNode(),
+                        condition,
+                        {"t0", "u0"},
+                        joinType)
+                    .planNode();
+    return findNestedLoopJoinRange(
+        *std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(plan));
+  };
+
+  auto range = findRange("t0 BETWEEN u0 AND u2", core::JoinType::kInner);
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range->probeChannel, 0);
+  ASSERT_EQ(range->buildChannel, 0);
+  ASSERT_TRUE(range->buildBelowProbe);
+  ASSERT_TRUE(range->inclusive);
+
+  range = findRange("t1 = u1 AND u2 > t0", core::JoinType::kLeft);
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range->buildChannel, 2);
+  ASSERT_FALSE(range->buildBelowProbe);
+  ASSERT_FALSE(range->inclusive);
+
+  // Floating point, different types, disjunctions and joins that return
+  // build-side mismatches are not range joins.
+  ASSERT_FALSE(findRange("t1 < u1", core::JoinType::kInner).has_value());
+  ASSERT_FALSE(findRange("t2 < u0", core::JoinType::kInner).has_value());
+  ASSERT_FALSE(
+      findRange("t0 < u0 OR t0 > u2", core::JoinType::kInner).has_value());
+  ASSERT_FALSE(findRange("t0 < u0", core::JoinType::kRight).has_value());
+}
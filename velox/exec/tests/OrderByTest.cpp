@@ -524,6 +524,79 @@ TEST_F(OrderByTest, spill) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(OrderByTest, prefixSort) {
+  const auto rowType = ROW(
+      {"c0", "c1", "c2", "c3"}, {BIGINT(), VARCHAR(), TIMESTAMP(), INTEGER()});
+  VectorFuzzer::Options options;
+  options.vectorSize = 1'000;
+  options.nullRatio = 0.1;
+  options.stringLength = 20;
+  options.timestampPrecision =
+      VectorFuzzer::Options::TimestampPrecision::kMicroSeconds;
+  VectorFuzzer fuzzer(options, pool());
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(fuzzer.fuzzInputRow(rowType));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId orderById;
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .orderBy(
+                            {"c1 DESC NULLS FIRST",
+                             "c0 NULLS LAST",
+                             "c2 NULLS LAST",
+                             "c3 NULLS LAST"},
+                            false)
+                        .capturePlanNodeId(orderById)
+                        .planNode();
+  const std::string duckDbSql =
+      "SELECT * FROM tmp ORDER BY c1 DESC NULLS FIRST, c0 NULLS LAST, "
+      "c2 NULLS LAST, c3 NULLS LAST";
+
+  // Prefix-sort is enabled by default.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .assertResults(duckDbSql, {{1, 0, 2, 3}});
+  auto planStats = toPlanStats(task->taskStats()).at(orderById);
+  ASSERT_EQ(planStats.customStats[OrderBy::kPrefixSortRows].sum, 5'000);
+  ASSERT_GT(planStats.customStats[OrderBy::kPrefixSortHits].sum, 0);
+  ASSERT_GT(planStats.customStats[OrderBy::kPrefixSortTies].sum, 0);
+
+  // The leading string key doesn't fit in the normalized keys.
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kPrefixSortNormalizedKeyMaxBytes, 9)
+             .assertResults(duckDbSql, {{1, 0, 2, 3}});
+  planStats = toPlanStats(task->taskStats()).at(orderById);
+  ASSERT_EQ(planStats.customStats.count(OrderBy::kPrefixSortRows), 0);
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kPrefixSortNormalizedKeyMaxBytes, 0)
+             .assertResults(duckDbSql, {{1, 0, 2, 3}});
+  planStats = toPlanStats(task->taskStats()).at(orderById);
+  ASSERT_EQ(planStats.customStats.count(OrderBy::kPrefixSortRows), 0);
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kPrefixSortMinRows, 10'000)
+             .assertResults(duckDbSql, {{1, 0, 2, 3}});
+  planStats = toPlanStats(task->taskStats()).at(orderById);
+  ASSERT_EQ(planStats.customStats.count(OrderBy::kPrefixSortRows), 0);
+
+  // Sorts the spill runs with prefix-sort.
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .spillDirectory(spillDirectory->path)
+             .config(core::QueryConfig::kSpillEnabled, true)
+             .config(core::QueryConfig::kOrderBySpillEnabled, true)
+             .config(core::QueryConfig::kTestingSpillPct, 100)
+             .config(QueryConfig::kPrefixSortMinRows, 0)
+             .assertResults(duckDbSql, {{1, 0, 2, 3}});
+  planStats = toPlanStats(task->taskStats()).at(orderById);
+  ASSERT_GT(planStats.spilledRows, 0);
+  ASSERT_GT(planStats.customStats[OrderBy::kPrefixSortRows].sum, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(OrderByTest, spillWithMemoryLimit) {
   constexpr int32_t kNumRows = 2000;
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
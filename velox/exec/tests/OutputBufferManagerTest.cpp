@@ -20,6 +20,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -38,6 +39,7 @@ class OutputBufferManagerTest : public testing::Test {
 
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
+    filesystems::registerLocalFileSystem();
   }
 
   void SetUp() override {
@@ -59,14 +61,14 @@ class OutputBufferManagerTest : public testing::Test {
       PartitionedOutputNode::Kind kind,
       int numDestinations,
       int numDrivers,
-      int maxOutputBufferSize = 0) {
+      int maxOutputBufferSize = 0,
+      std::unordered_map<std::string, std::string> configSettings = {}) {
     bufferManager_->removeTask(taskId);
 
     auto planFragment = exec::test::PlanBuilder()
                             .values({std::dynamic_pointer_cast<RowVector>(
                                 BatchMaker::createBatch(rowType, 100, *pool_))})
                             .planFragment();
-    std::unordered_map<std::string, std::string> configSettings;
     if (maxOutputBufferSize != 0) {
       configSettings[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           std::to_string(maxOutputBufferSize);
@@ -1110,6 +1112,88 @@ TEST_F(OutputBufferManagerTest, broadcastWithDynamicAddedDestination) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, broadcastSpill) {
+  const std::string taskId = "t0";
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  // Every page is spilled as soon as it is enqueued.
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kBroadcast,
+      2,
+      1,
+      0,
+      {{core::QueryConfig::kMaxBroadcastRetainedBytes, "1"}});
+  task->setSpillDirectory(spillDirectory->path);
+  auto fs = filesystems::getFileSystem(spillDirectory->path, nullptr);
+
+  const int numPages = 5;
+  std::vector<std::string> expectedPages;
+  for (int i = 0; i < numPages; ++i) {
+    auto page = makeSerializedPage(rowType_, 100);
+    expectedPages.push_back(page->getIOBuf()->moveToFbString().toStdString());
+    ContinueFuture future;
+    ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+  }
+  ASSERT_FALSE(fs->list(spillDirectory->path).empty());
+  ASSERT_GT(task->spilledBytes(), 0);
+  ASSERT_EQ(getStats(taskId).bufferedPages, numPages);
+
+  // The pages are freed once the existing destinations have fetched them.
+  for (int i = 0; i < numPages; ++i) {
+    for (int destination = 0; destination < 2; ++destination) {
+      fetchOneAndAck(taskId, destination, i);
+    }
+  }
+  ASSERT_EQ(getStats(taskId).bufferedBytes, 0);
+  ASSERT_EQ(getStats(taskId).bufferedPages, 0);
+
+  // A destination added later reads the pages from the spill files, first
+  // one at a time and then all the rest at once.
+  const int destination = 2;
+  auto fetchPages = [&](int64_t sequence, uint64_t maxBytes) {
+    std::vector<std::string> pages;
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        destination,
+        maxBytes,
+        sequence,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> iobufs,
+            int64_t inSequence,
+            std::vector<int64_t> remainingBytes) {
+          ASSERT_EQ(inSequence, sequence);
+          for (auto& iobuf : iobufs) {
+            ASSERT_TRUE(iobuf != nullptr);
+            pages.push_back(iobuf->moveToFbString().toStdString());
+          }
+          ASSERT_EQ(
+              pages.size() + remainingBytes.size(), numPages - sequence);
+        }));
+    for (auto i = 0; i < pages.size(); ++i) {
+      ASSERT_EQ(pages[i], expectedPages[sequence + i]);
+    }
+    acknowledge(taskId, destination, sequence + pages.size());
+  };
+  fetchPages(0, 1);
+  fetchPages(1, 1);
+  fetchPages(2, std::numeric_limits<uint64_t>::max());
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.buffersStats[destination].pagesSent, numPages);
+  ASSERT_EQ(stats.buffersStats[destination].pagesBuffered, 0);
+
+  bufferManager_->updateOutputBuffers(taskId, 3, true);
+  noMoreData(taskId);
+  for (int i = 0; i < 3; ++i) {
+    fetchEndMarker(taskId, i, numPages);
+  }
+  ASSERT_TRUE(bufferManager_->isFinished(taskId));
+  // The spill files are removed once no destination needs them.
+  ASSERT_TRUE(fs->list(spillDirectory->path).empty());
+
+  bufferManager_->removeTask(taskId);
+  EXPECT_TRUE(task->isFinished());
+}
+
 TEST_F(OutputBufferManagerTest, arbitraryWithDynamicAddedDestination) {
   const vector_size_t size = 100;
   int numDestinations = 5;
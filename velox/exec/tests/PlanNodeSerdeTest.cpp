@@ -124,6 +124,12 @@ TEST_F(PlanNodeSerdeTest, markDistinct) {
                   .markDistinct("marker", {"c0", "c1", "c2"})
                   .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .markDistinct("marker", {"c0", "c1"}, true /*preGrouped*/)
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, nestedLoopJoin) {
@@ -219,6 +225,12 @@ TEST_F(PlanNodeSerdeTest, localPartition) {
 
   plan = PlanBuilder().values({data_}).localPartition({"c0", "c1"}).planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .scaleWriterLocalPartitionRoundRobin()
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, limit) {
@@ -901,4 +901,12 @@ TEST_F(PlanNodeToStringTest, markDistinct) {
   ASSERT_EQ(
       "-- MarkDistinct[a, b] -> a:VARCHAR, b:BIGINT, c:BIGINT, marker:BOOLEAN\n",
       op->toString(true, false));
+
+  op = PlanBuilder()
+           .tableScan(ROW({"a", "b", "c"}, {VARCHAR(), BIGINT(), BIGINT()}))
+           .markDistinct("marker", {"a", "b"}, true /*preGrouped*/)
+           .planNode();
+  ASSERT_EQ(
+      "-- MarkDistinct[STREAMING a, b] -> a:VARCHAR, b:BIGINT, c:BIGINT, marker:BOOLEAN\n",
+      op->toString(true, false));
 }
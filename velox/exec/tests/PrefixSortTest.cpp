@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class PrefixSortTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Stores 'data' into a RowContainer with all columns as keys, sorts the rows
+  // with prefix-sort and std::sort and verifies both orders are the same.
+  void testSort(
+      const RowVectorPtr& data,
+      const std::vector<CompareFlags>& compareFlags,
+      uint32_t maxNormalizedKeyBytes = 128) {
+    const auto numRows = data->size();
+    RowContainer rowContainer(data->type()->asRow().children(), pool());
+    std::vector<char*> rows(numRows);
+    for (auto row = 0; row < numRows; ++row) {
+      rows[row] = rowContainer.newRow();
+    }
+    SelectivityVector allRows(numRows);
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      DecodedVector decoded(*data->childAt(column), allRows);
+      for (auto row = 0; row < numRows; ++row) {
+        rowContainer.store(decoded, row, rows[row], column);
+      }
+    }
+
+    auto expected = rows;
+    PrefixSort::stdSort(
+        folly::Range<char**>(expected.data(), expected.size()),
+        &rowContainer,
+        compareFlags);
+
+    PrefixSortStats stats;
+    PrefixSort::sort(
+        folly::Range<char**>(rows.data(), rows.size()),
+        pool(),
+        &rowContainer,
+        compareFlags,
+        common::PrefixSortConfig{maxNormalizedKeyBytes, 0},
+        &stats);
+    ASSERT_EQ(stats.numRows, numRows);
+    ASSERT_GT(stats.numPrefixHits, 0);
+
+    for (auto i = 0; i < numRows; ++i) {
+      for (auto key = 0; key < compareFlags.size(); ++key) {
+        ASSERT_EQ(
+            rowContainer.compare(rows[i], expected[i], key, compareFlags[key]),
+            0)
+            << "Mismatch at row " << i << ", key " << key;
+      }
+    }
+  }
+
+  RowVectorPtr fuzzData(const RowTypePtr& type, size_t numRows = 1'000) {
+    VectorFuzzer::Options options;
+    options.vectorSize = numRows;
+    options.nullRatio = 0.1;
+    options.stringLength = 24;
+    options.stringVariableLength = true;
+    VectorFuzzer fuzzer(options, pool());
+    return fuzzer.fuzzInputRow(type);
+  }
+
+  const std::vector<CompareFlags> allCompareFlags_{
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue},
+      {true, false, false, CompareFlags::NullHandlingMode::kNullAsValue},
+      {false, true, false, CompareFlags::NullHandlingMode::kNullAsValue},
+      {false, false, false, CompareFlags::NullHandlingMode::kNullAsValue}};
+};
+
+TEST_F(PrefixSortTest, layout) {
+  const std::vector<CompareFlags> compareFlags(4);
+  {
+    const auto layout = PrefixSortLayout::makeSortLayout(
+        {BIGINT(), INTEGER(), TIMESTAMP(), DOUBLE()}, compareFlags, 128);
+    ASSERT_EQ(layout.numNormalizedKeys, 4);
+    ASSERT_FALSE(layout.hasNonNormalizedKey());
+    // 9 + 5 + 17 + 9 = 40 bytes of normalized keys plus the row address.
+    ASSERT_EQ(layout.normalizedBufferSize, 40);
+    ASSERT_EQ(layout.entrySize, 48);
+    ASSERT_EQ(layout.prefixOffsets, (std::vector<uint32_t>{0, 9, 14, 31}));
+  }
+
+  {
+    // The key after a string key is not normalized.
+    const auto layout = PrefixSortLayout::makeSortLayout(
+        {BIGINT(), VARCHAR(), INTEGER(), DOUBLE()}, compareFlags, 128);
+    ASSERT_EQ(layout.numNormalizedKeys, 2);
+    ASSERT_TRUE(layout.hasNonNormalizedKey());
+    ASSERT_EQ(layout.firstNonNormalizedKey, 1);
+  }
+
+  {
+    // Stops at the first key that can't be normalized.
+    const auto layout = PrefixSortLayout::makeSortLayout(
+        {INTEGER(), SMALLINT(), BIGINT(), DOUBLE()}, compareFlags, 128);
+    ASSERT_EQ(layout.numNormalizedKeys, 1);
+    ASSERT_EQ(layout.firstNonNormalizedKey, 1);
+    ASSERT_EQ(layout.normalizedBufferSize, 8);
+  }
+
+  {
+    // Stops at the first key that exceeds the max normalized key bytes.
+    const auto layout = PrefixSortLayout::makeSortLayout(
+        {BIGINT(), BIGINT(), BIGINT(), BIGINT()}, compareFlags, 20);
+    ASSERT_EQ(layout.numNormalizedKeys, 2);
+    ASSERT_EQ(layout.firstNonNormalizedKey, 2);
+  }
+
+  {
+    const auto layout = PrefixSortLayout::makeSortLayout(
+        {ARRAY(BIGINT()), BIGINT()}, std::vector<CompareFlags>(2), 128);
+    ASSERT_EQ(layout.numNormalizedKeys, 0);
+  }
+}
+
+TEST_F(PrefixSortTest, singleKey) {
+  const std::vector<TypePtr> types{
+      BIGINT(), INTEGER(), REAL(), DOUBLE(), TIMESTAMP(), VARCHAR()};
+  for (const auto& type : types) {
+    SCOPED_TRACE(type->toString());
+    const auto data = fuzzData(ROW({"c0"}, {type}));
+    for (const auto& flags : allCompareFlags_) {
+      SCOPED_TRACE(flags.toString());
+      testSort(data, {flags});
+    }
+  }
+}
+
+TEST_F(PrefixSortTest, multipleKeys) {
+  const auto data = fuzzData(ROW(
+      {"c0", "c1", "c2", "c3", "c4"},
+      {INTEGER(), TIMESTAMP(), VARCHAR(), BIGINT(), SMALLINT()}));
+  for (const auto& flags : allCompareFlags_) {
+    SCOPED_TRACE(flags.toString());
+    testSort(data, {flags, flags, flags, allCompareFlags_[0], flags});
+  }
+  // Only a part of the keys fit in the normalized keys.
+  testSort(data, std::vector<CompareFlags>(5), 24);
+}
+
+TEST_F(PrefixSortTest, lowCardinality) {
+  // Many ties on the normalized keys of the leading bigint key.
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+      makeFlatVector<std::string>(
+          1'000,
+          [](auto row) {
+            return fmt::format("a long common prefix {}", row % 13);
+          }),
+      makeFlatVector<int16_t>(1'000, [](auto row) { return row % 17; }),
+  });
+  for (const auto& flags : allCompareFlags_) {
+    SCOPED_TRACE(flags.toString());
+    testSort(data, {flags, flags, flags});
+  }
+}
+} // namespace
+} // namespace facebook::velox::exec::test
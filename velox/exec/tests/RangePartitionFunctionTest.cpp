@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RangePartitionFunction.h"
+#include <gtest/gtest.h>
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class RangePartitionFunctionTest : public test::VectorTestBase,
+                                   public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+};
+
+TEST_F(RangePartitionFunctionTest, basic) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({5, 1, 10, 20, 11, 3, 10}),
+      makeNullableFlatVector<int32_t>(
+          {1, 2, std::nullopt, 4, 5, std::nullopt, 3}),
+  });
+
+  // Ascending on c0, then descending nulls first on c1. (10, null) sorts
+  // before (10, 3), which sorts before (10, 0).
+  RangePartitionFunction function(
+      {0, 1},
+      {core::kAscNullsLast, core::kDescNullsFirst},
+      makeRowVector({
+          makeFlatVector<int64_t>({5, 10, 10}),
+          makeFlatVector<int32_t>({0, 3, 0}),
+      }));
+  ASSERT_EQ(function.numPartitions(), 4);
+
+  std::vector<uint32_t> partitions;
+  ASSERT_FALSE(function.partition(*data, partitions).has_value());
+  std::vector<uint32_t> expected{0, 0, 1, 3, 3, 0, 2};
+  ASSERT_EQ(partitions, expected);
+
+  // Ascending nulls last on c1.
+  RangePartitionFunction ascending(
+      {0, 1},
+      {core::kAscNullsLast, core::kAscNullsLast},
+      makeRowVector({
+          makeFlatVector<int64_t>({5, 10, 10}),
+          makeFlatVector<int32_t>({0, 0, 3}),
+      }));
+  ASSERT_FALSE(ascending.partition(*data, partitions).has_value());
+  expected = {1, 0, 3, 3, 3, 0, 3};
+  ASSERT_EQ(partitions, expected);
+
+  // No split points.
+  RangePartitionFunction single(
+      {0, 1},
+      {core::kAscNullsLast, core::kAscNullsLast},
+      makeRowVector(
+          {makeFlatVector<int64_t>({}), makeFlatVector<int32_t>({})}));
+  ASSERT_EQ(single.partition(*data, partitions), 0);
+}
+
+TEST_F(RangePartitionFunctionTest, spec) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return (row * 7) % size; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+
+  auto splitPoints = RangePartitionFunctionSpec::computeSplitPoints(
+      *data, {0}, {core::kAscNullsLast}, 99, pool());
+  ASSERT_EQ(splitPoints->size(), 99);
+  ASSERT_EQ(splitPoints->childrenSize(), 1);
+
+  RangePartitionFunctionSpec spec(
+      asRowType(data->type()), {0}, {core::kAscNullsLast}, splitPoints);
+  ASSERT_EQ(spec.toString(), "RANGE(c0 ASC NULLS LAST; 99 split points)");
+
+  auto copy = RangePartitionFunctionSpec::deserialize(spec.serialize(), pool());
+  ASSERT_EQ(spec.toString(), copy->toString());
+
+  // The partitions are ordered and have about the same number of rows.
+  for (auto numPartitions : {1, 4, 7, 100, 300}) {
+    SCOPED_TRACE(fmt::format("numPartitions: {}", numPartitions));
+    for (const auto* partitionSpec : {&spec, copy.get()}) {
+      auto function = partitionSpec->create(numPartitions);
+      std::vector<uint32_t> partitions;
+      if (auto partition = function->partition(*data, partitions)) {
+        partitions.assign(size, partition.value());
+      }
+
+      std::vector<int32_t> minValues(numPartitions, size);
+      std::vector<int32_t> maxValues(numPartitions, -1);
+      std::vector<vector_size_t> counts(numPartitions, 0);
+      auto* values = data->childAt(0)->asFlatVector<int32_t>();
+      for (auto row = 0; row < size; ++row) {
+        const auto partition = partitions[row];
+        ASSERT_LT(partition, numPartitions);
+        minValues[partition] =
+            std::min(minValues[partition], values->valueAt(row));
+        maxValues[partition] =
+            std::max(maxValues[partition], values->valueAt(row));
+        ++counts[partition];
+      }
+      int32_t previousMax = -1;
+      for (auto i = 0; i < numPartitions; ++i) {
+        if (counts[i] == 0) {
+          continue;
+        }
+        ASSERT_GT(minValues[i], previousMax);
+        previousMax = maxValues[i];
+        if (numPartitions <= 100) {
+          ASSERT_NEAR(counts[i], size / numPartitions, size / 100);
+        }
+      }
+    }
+  }
+}
@@ -912,6 +912,53 @@ TEST_F(RowContainerTest, extractNulls) {
   }
 }
 
+TEST_F(RowContainerTest, extractFixedWidthColumns) {
+  constexpr int32_t kNumRows = 1'000;
+  auto batch = makeRowVector({
+      makeFlatVector<bool>(
+          kNumRows, [](auto row) { return row % 3 == 0; }, nullEvery(7)),
+      makeFlatVector<int32_t>(
+          kNumRows, [](auto row) { return row; }, nullEvery(5)),
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 11; }),
+      makeFlatVector<double>(
+          kNumRows, [](auto row) { return row / 2.0; }, nullEvery(11)),
+  });
+  auto data = makeRowContainer({}, {BOOLEAN(), INTEGER(), BIGINT(), DOUBLE()});
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+  }
+  SelectivityVector allRows(kNumRows);
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    DecodedVector decoded(*batch->childAt(column), allRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      data->store(decoded, i, rows[i], column);
+    }
+  }
+
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    const auto& expected = batch->childAt(column);
+    auto result = BaseVector::create(expected->type(), kNumRows, pool());
+    data->extractColumn(rows.data(), kNumRows, column, result);
+    assertEqualVectors(expected, result);
+
+    // Rows that are nullptr, as for probe rows without a match, extract as
+    // nulls.
+    auto withMissing = rows;
+    for (auto i = 0; i < kNumRows; i += 13) {
+      withMissing[i] = nullptr;
+    }
+    data->extractColumn(withMissing.data(), kNumRows, column, result);
+    for (auto i = 0; i < kNumRows; ++i) {
+      if (withMissing[i] == nullptr) {
+        EXPECT_TRUE(result->isNullAt(i)) << i;
+      } else {
+        EXPECT_TRUE(expected->equalValueAt(result.get(), i, i)) << i;
+      }
+    }
+  }
+}
+
 TEST_F(RowContainerTest, erase) {
   constexpr int32_t kNumRows = 100;
   auto data = makeRowContainer({SMALLINT()}, {SMALLINT()});
@@ -1411,6 +1458,53 @@ TEST_F(RowContainerTest, mixedFree) {
   data2->checkConsistency();
 }
 
+TEST_F(RowContainerTest, compactStringAllocator) {
+  constexpr int32_t kNumRows = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return std::string(20 + row % 100, 'a' + row % 26); }),
+      makeArrayVector<int64_t>(
+          kNumRows,
+          [](auto row) { return row % 50; },
+          [](auto row, auto index) { return row + index; },
+          nullEvery(7)),
+  });
+  auto rowContainer =
+      makeRowContainer({VARCHAR()}, {data->childAt(1)->type()}, false);
+  auto rows = store(*rowContainer, data);
+
+  // Erases 3 of 4 rows to fragment the string allocator.
+  std::vector<char*> erased;
+  std::vector<char*> kept;
+  std::vector<vector_size_t> keptIndices;
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (i % 4 == 0) {
+      kept.push_back(rows[i]);
+      keptIndices.push_back(i);
+    } else {
+      erased.push_back(rows[i]);
+    }
+  }
+  rowContainer->eraseRows(folly::Range<char**>(erased.data(), erased.size()));
+  const auto allocatedBytes = rowContainer->allocatedBytes();
+
+  ASSERT_GT(rowContainer->compactStringAllocator(), 0);
+  ASSERT_LT(rowContainer->allocatedBytes(), allocatedBytes);
+  rowContainer->stringAllocator().checkConsistency();
+
+  auto indices = makeIndices(keptIndices);
+  for (auto column = 0; column < 2; ++column) {
+    auto expected = BaseVector::wrapInDictionary(
+        nullptr, indices, kept.size(), data->childAt(column));
+    auto result =
+        BaseVector::create(data->childAt(column)->type(), kept.size(), pool());
+    rowContainer->extractColumn(kept.data(), kept.size(), column, result);
+    assertEqualVectors(expected, result);
+  }
+  rowContainer->clear();
+}
+
 TEST_F(RowContainerTest, unknown) {
   std::vector<TypePtr> types = {UNKNOWN()};
   auto rowContainer = std::make_unique<RowContainer>(types, pool_.get());
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -384,7 +385,7 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
     ASSERT_EQ(
         finalStats.toString(),
         fmt::format(
-            "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[0]",
+            "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[0] spillReads[{}] spillReadBytes[{}] spillReadTime[{}] spillDeserializationTime[{}] spillMergeLevels[0] spillMergeRuns[0]",
             finalStats.spillRuns,
             succinctBytes(finalStats.spilledInputBytes),
             succinctBytes(finalStats.spilledBytes),
@@ -396,7 +397,11 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
             succinctMicros(finalStats.spillSerializationTimeUs),
             finalStats.spillWrites,
             succinctMicros(finalStats.spillFlushTimeUs),
-            succinctMicros(finalStats.spillWriteTimeUs)));
+            succinctMicros(finalStats.spillWriteTimeUs),
+            finalStats.spillReads,
+            succinctBytes(finalStats.spillReadBytes),
+            succinctMicros(finalStats.spillReadTimeUs),
+            succinctMicros(finalStats.spillDeserializationTimeUs)));
 
     // Verify the spilled files are still there after spill state destruction.
     for (const auto& spilledFile : spilledFileSet) {
@@ -492,6 +497,98 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, parallelFlush) {
+  // Verify that the write buffers serialized on an executor are written in
+  // order and that the reads are counted.
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  folly::CPUThreadPoolExecutor executor(4);
+  const std::vector<CompareFlags> emptyCompareFlags;
+  constexpr int32_t kNumBatches = 20;
+  constexpr int32_t kBatchSize = 100;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->path; },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      0,
+      emptyCompareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &stats_,
+      {},
+      &executor);
+  state.setPartitionSpilled(0);
+  for (auto i = 0; i < kNumBatches; ++i) {
+    state.appendToPartition(
+        0, makeRowVector({makeFlatVector<int64_t>(kBatchSize, [&](auto row) {
+          return i * kBatchSize + row;
+        })}));
+  }
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  ASSERT_EQ(stats_.rlock()->spillWrites, kNumBatches);
+
+  const auto prevStats = common::globalSpillStats();
+  auto reader = spillPartition.createUnorderedReader(pool());
+  RowVectorPtr output;
+  int64_t expected = 0;
+  while (reader->nextBatch(output)) {
+    auto* values = output->childAt(0)->asFlatVector<int64_t>();
+    for (auto row = 0; row < output->size(); ++row) {
+      ASSERT_EQ(values->valueAt(row), expected++);
+    }
+  }
+  ASSERT_EQ(expected, kNumBatches * kBatchSize);
+  const auto readStats = common::globalSpillStats() - prevStats;
+  ASSERT_GT(readStats.spillReads, 0);
+  ASSERT_GT(readStats.spillReadBytes, 0);
+}
+
+TEST_P(SpillTest, orderedReaderReadAhead) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  folly::CPUThreadPoolExecutor executor(4);
+  const std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  constexpr int32_t kNumFiles = 8;
+  constexpr int32_t kNumBatches = 10;
+  constexpr int32_t kBatchSize = 100;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->path; },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      compareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &stats_);
+  state.setPartitionSpilled(0);
+  // File i has the values congruent to i modulo 'kNumFiles'.
+  for (auto file = 0; file < kNumFiles; ++file) {
+    for (auto i = 0; i < kNumBatches; ++i) {
+      state.appendToPartition(
+          0, makeRowVector({makeFlatVector<int64_t>(kBatchSize, [&](auto row) {
+            return ((i * kBatchSize + row) * kNumFiles) + file;
+          })}));
+    }
+    state.finishFile(0);
+  }
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  auto merge = spillPartition.createOrderedReader(pool(), &executor, 1 << 20);
+  ASSERT_TRUE(merge != nullptr);
+  int64_t expected = 0;
+  for (auto* stream = merge->next(); stream != nullptr;
+       stream = merge->next()) {
+    ASSERT_EQ(
+        stream->decoded(0).valueAt<int64_t>(stream->currentIndex()),
+        expected++);
+    stream->pop();
+  }
+  ASSERT_EQ(expected, kNumFiles * kNumBatches * kBatchSize);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
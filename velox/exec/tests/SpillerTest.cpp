@@ -16,6 +16,7 @@
 
 #include "velox/exec/Spiller.h"
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <numeric>
 #include <unordered_set>
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -1171,6 +1172,42 @@ TEST_P(HashJoinBuildOnly, spillPartition) {
   VELOX_ASSERT_THROW(spiller_->spill(RowContainerIterator{}), "");
 }
 
+TEST_P(HashJoinBuildOnly, spillSomePartitions) {
+  if (numPartitions_ < 2) {
+    return;
+  }
+  setupSpillData(rowType_, numKeys_, 1'000, 1, nullptr, {});
+  std::vector<std::vector<RowVectorPtr>> vectorsByPartition(numPartitions_);
+  HashPartitionFunction spillHashFunction(hashBits_, rowType_, keyChannels_);
+  splitByPartition(rowVector_, spillHashFunction, vectorsByPartition);
+  setupSpiller(100'000, 0, false);
+
+  const auto bytes = spiller_->partitionBytes();
+  ASSERT_EQ(bytes.size(), static_cast<size_t>(numPartitions_));
+  uint64_t expectedBytes{0};
+  for (const auto* row : rows_) {
+    expectedBytes += rowContainer_->rowSize(row);
+  }
+  ASSERT_EQ(
+      std::accumulate(bytes.begin(), bytes.end(), uint64_t{0}), expectedBytes);
+
+  vector_size_t numSpillRows{0};
+  for (const auto& vector : vectorsByPartition[0]) {
+    numSpillRows += vector->size();
+  }
+  const SpillPartitionNumSet spillPartitions{0};
+  spiller_->spill(spillPartitions);
+  ASSERT_TRUE(spiller_->isSpilled(0));
+  ASSERT_FALSE(spiller_->isAllSpilled());
+  // The spilled rows are erased and the other partitions stay in memory.
+  ASSERT_EQ(rowContainer_->numRows(), 1'000 - numSpillRows);
+  ASSERT_EQ(spiller_->partitionBytes()[0], 0);
+  for (auto partition = 1; partition < numPartitions_; ++partition) {
+    ASSERT_EQ(spiller_->partitionBytes()[partition], bytes[partition]);
+  }
+  verifyNonSortedSpillData(spillPartitions, vectorsByPartition);
+}
+
 TEST_P(HashJoinBuildOnly, writeBufferSize) {
   std::vector<uint64_t> writeBufferSizes = {0, 4'000'000'000};
   for (const auto writeBufferSize : writeBufferSizes) {
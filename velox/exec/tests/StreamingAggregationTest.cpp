@@ -421,6 +421,46 @@ TEST_F(StreamingAggregationTest, uniqueKeys) {
   testAggregation(keys, 100);
 }
 
+TEST_F(StreamingAggregationTest, longRuns) {
+  // Runs of 100 rows that span batches update each group once per run.
+  auto size = 1'024;
+  testAggregation(
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row / 100; }),
+          makeFlatVector<int64_t>(
+              size, [size](auto row) { return (size + row) / 100; }),
+          makeFlatVector<int64_t>(
+              78, [size](auto row) { return (2 * size + row) / 100; }),
+      },
+      1024);
+
+  // Keys with nulls, constant keys and dictionary encoded keys are compared
+  // without SIMD.
+  testAggregation(
+      {
+          makeFlatVector<int16_t>(
+              size,
+              [](auto row) { return row / 100; },
+              [](auto row) { return row < 3; }),
+          makeConstant<int16_t>(10, size),
+          wrapInDictionary(
+              makeIndices(size, [](auto row) { return row; }),
+              makeFlatVector<int16_t>(
+                  size, [](auto row) { return 10 + row / 100; })),
+      },
+      3);
+
+  testAggregation(
+      {
+          makeFlatVector<StringView>(
+              size,
+              [](auto row) {
+                return StringView::makeInline(fmt::format("{:06}", row / 50));
+              }),
+      },
+      1024);
+}
+
 TEST_F(StreamingAggregationTest, partialStreaming) {
   auto size = 1'024;
 
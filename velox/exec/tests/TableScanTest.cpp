@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include <folly/String.h>
 #include <atomic>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -251,6 +252,263 @@ TEST_F(TableScanTest, allColumns) {
   EXPECT_LT(0, exec::TableScan::ioWaitNanos());
 }
 
+TEST_F(TableScanTest, parallelColumnDecoding) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  auto assertParallel = [&](const core::PlanNodePtr& plan,
+                            const std::string& duckDbSql) {
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .connectorSessionProperty(
+            kHiveConnectorId,
+            connector::hive::HiveConfig::kParallelColumnDecodingFactorSession,
+            "4")
+        .split(makeHiveConnectorSplit(filePath->path))
+        .assertResults(duckDbSql);
+  };
+  assertParallel(tableScanNode(), "SELECT * FROM tmp");
+  // The columns without filters are read on the rows that pass the filters.
+  assertParallel(
+      PlanBuilder(pool_.get())
+          .tableScan(rowType_, {"c1 > 0", "c6 < 50"}, "c0 % 3 = 0")
+          .planNode(),
+      "SELECT * FROM tmp WHERE c1 > 0 AND c6 < 50 AND c0 % 3 = 0");
+  assertParallel(
+      PlanBuilder(pool_.get()).tableScan(rowType_, {"c2 = -1000"}).planNode(),
+      "SELECT * FROM tmp WHERE c2 = -1000");
+}
+
+TEST_F(TableScanTest, statisticsAggregation) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  // Returns the number of splits answered from the file statistics.
+  auto assertStatistics =
+      [&](const core::PlanNodePtr& plan,
+          const std::vector<std::shared_ptr<connector::ConnectorSplit>>& splits,
+          const std::string& duckDbSql,
+          bool enabled = true) {
+        auto task =
+            AssertQueryBuilder(plan, duckDbQueryRunner_)
+                .connectorSessionProperty(
+                    kHiveConnectorId,
+                    connector::hive::HiveConfig::
+                        kFileStatisticsAggregationEnabledSession,
+                    enabled ? "true" : "false")
+                .splits(splits)
+                .assertResults(duckDbSql);
+        return getTableScanRuntimeStats(task)["statisticsSplits"].sum;
+      };
+
+  // Makes a split of the file for each partition key value or one split
+  // without partition keys.
+  auto makeSplits = [&](const std::vector<std::string>& partitionValues = {}) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& value : partitionValues) {
+      splits.push_back(HiveConnectorSplitBuilder(filePath->path)
+                           .partitionKey("pkey", value)
+                           .build());
+    }
+    if (splits.empty()) {
+      splits.push_back(makeHiveConnectorSplit(filePath->path));
+    }
+    return splits;
+  };
+
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(rowType_)
+                  .singleAggregation(
+                      {},
+                      {"count(1)",
+                       "count(c0)",
+                       "min(c1)",
+                       "max(c2)",
+                       "min(c5)",
+                       "max(c5)",
+                       "count(c4)"})
+                  .planNode();
+  const std::string duckDbSql =
+      "SELECT count(*), count(c0), min(c1), max(c2), min(c5), max(c5), "
+      "count(c4) FROM tmp";
+  ASSERT_EQ(assertStatistics(plan, makeSplits(), duckDbSql), 1);
+  ASSERT_EQ(assertStatistics(plan, makeSplits(), duckDbSql, false), 0);
+
+  plan = PlanBuilder(pool_.get())
+             .tableScan(rowType_)
+             .partialAggregation({}, {"min(c0)", "max(c6)"})
+             .finalAggregation()
+             .planNode();
+  ASSERT_EQ(
+      assertStatistics(
+          plan, makeSplits(), "SELECT min(c0), max(c6) FROM tmp"),
+      1);
+
+  // A filter on a regular column or an aggregate other than count, min and
+  // max needs the rows.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(rowType_, {"c1 > 0"})
+             .singleAggregation({}, {"count(1)"})
+             .planNode();
+  ASSERT_EQ(
+      assertStatistics(
+          plan, makeSplits(), "SELECT count(*) FROM tmp WHERE c1 > 0"),
+      0);
+  plan = PlanBuilder(pool_.get())
+             .tableScan(rowType_)
+             .singleAggregation({}, {"sum(c0)"})
+             .planNode();
+  ASSERT_EQ(assertStatistics(plan, makeSplits(), "SELECT sum(c0) FROM tmp"), 0);
+
+  // Grouping by a partition key and filtering on it.
+  ColumnHandleMap assignments = {
+      {"pkey", partitionKey("pkey", VARCHAR())},
+      {"c0", regularColumn("c0", BIGINT())},
+      {"c1", regularColumn("c1", INTEGER())}};
+  auto outputType = ROW({"pkey", "c0", "c1"}, {VARCHAR(), BIGINT(), INTEGER()});
+  plan = PlanBuilder(pool_.get())
+             .startTableScan()
+             .outputType(outputType)
+             .assignments(assignments)
+             .endTableScan()
+             .singleAggregation(
+                 {"pkey"}, {"count(1)", "max(c0)", "min(c1)", "count(pkey)"})
+             .planNode();
+  ASSERT_EQ(
+      assertStatistics(
+          plan,
+          makeSplits({"a", "b"}),
+          "SELECT pkey, count(*), max(c0), min(c1), count(*) FROM "
+          "(SELECT 'a' AS pkey, * FROM tmp UNION ALL SELECT 'b', * FROM tmp) "
+          "GROUP BY pkey"),
+      2);
+  plan = PlanBuilder(pool_.get())
+             .startTableScan()
+             .outputType(outputType)
+             .assignments(assignments)
+             .subfieldFilter("pkey = 'b'")
+             .endTableScan()
+             .singleAggregation({}, {"count(c0)", "max(c1)"})
+             .planNode();
+  ASSERT_EQ(
+      assertStatistics(
+          plan, makeSplits({"a", "b"}), "SELECT count(c0), max(c1) FROM tmp"),
+      1);
+
+  // A grouping key that is not a partition key needs the rows.
+  plan = PlanBuilder(pool_.get())
+             .startTableScan()
+             .outputType(outputType)
+             .assignments(assignments)
+             .endTableScan()
+             .singleAggregation({"c1"}, {"count(c0)"})
+             .planNode();
+  ASSERT_EQ(
+      assertStatistics(
+          plan,
+          makeSplits({"a"}),
+          "SELECT c1, count(c0) FROM tmp GROUP BY c1"),
+      0);
+}
+
+TEST_F(TableScanTest, splitResultCache) {
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < 3; ++i) {
+    auto vectors = makeVectors(2, 1'000);
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->path, vectors);
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  auto makeSplits = [&](bool withModifiedTime) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      HiveConnectorSplitBuilder builder(filePath->path);
+      if (withModifiedTime) {
+        builder.fileModifiedTime(1'000);
+      }
+      splits.push_back(builder.build());
+    }
+    return splits;
+  };
+
+  core::PlanNodeId aggregationId;
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(rowType_, {"c1 > 0"})
+                  .project({"c0 % 7 AS k", "c1"})
+                  .partialAggregation({"k"}, {"sum(c1)", "count(1)"})
+                  .capturePlanNodeId(aggregationId)
+                  .finalAggregation()
+                  .planNode();
+  const std::string duckDbSql =
+      "SELECT c0 % 7, sum(c1), count(*) FROM tmp WHERE c1 > 0 GROUP BY 1";
+
+  // Returns the number of cache hits and misses of the partial aggregation.
+  auto runQuery = [&](bool withModifiedTime, bool enabled = true) {
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        core::QueryConfig::kSplitResultCacheEnabled,
+                        enabled ? "true" : "false")
+                    .splits(makeSplits(withModifiedTime))
+                    .assertResults(duckDbSql);
+    auto stats = exec::toPlanStats(task->taskStats()).at(aggregationId);
+    return std::make_pair(
+        stats.customStats["splitResultCacheHits"].sum,
+        stats.customStats["splitResultCacheMisses"].sum);
+  };
+
+  ASSERT_EQ(runQuery(true), std::make_pair(0L, 3L));
+  // The second run reads no split.
+  ASSERT_EQ(runQuery(true), std::make_pair(3L, 0L));
+  ASSERT_EQ(runQuery(true, false), std::make_pair(0L, 0L));
+  // Splits without a modification time are not cached.
+  ASSERT_EQ(runQuery(false), std::make_pair(0L, 0L));
+}
+
+TEST_F(TableScanTest, deferredDriverStarts) {
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < 8; ++i) {
+    auto vectors = makeVectors(2, 1'000);
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->path, vectors);
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  auto plan =
+      PlanBuilder(pool_.get()).tableScan(rowType_, {"c1 > 0"}).planNode();
+  auto runQuery = [&](const std::string& maxInitialDrivers) {
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .maxDrivers(4)
+                    .config(
+                        core::QueryConfig::kMaxInitialDriversPerPipeline,
+                        maxInitialDrivers)
+                    .splits(makeHiveConnectorSplits(filePaths))
+                    .assertResults("SELECT * FROM tmp WHERE c1 > 0");
+    return task->taskStats().pipelineStats[0];
+  };
+
+  auto stats = runQuery("1");
+  ASSERT_EQ(stats.numInitialDrivers, 1);
+  // The deferred Drivers start while splits are queued or at the end.
+  ASSERT_EQ(
+      stats.numInitialDrivers + stats.numAddedDrivers +
+          stats.numDriversStartedAtEnd,
+      4);
+  ASSERT_EQ(stats.numDriverAddsSkippedForOutput, 0);
+
+  stats = runQuery("0");
+  ASSERT_EQ(stats.numInitialDrivers, 4);
+  ASSERT_EQ(stats.numAddedDrivers, 0);
+  ASSERT_EQ(stats.numDriversStartedAtEnd, 0);
+}
+
 TEST_F(TableScanTest, connectorStats) {
   auto hiveConnector =
       std::dynamic_pointer_cast<connector::hive::HiveConnector>(
@@ -1352,6 +1610,37 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, coalescedSplits) {
+  auto filePaths = makeFilePaths(10);
+  auto vectors = makeVectors(10, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // The first two files are read as separate splits, the rest as one split.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (auto i = 0; i < 3; ++i) {
+    splits.push_back(makeHiveConnectorSplit(filePaths[i]->path));
+  }
+  auto* coalesced = dynamic_cast<HiveConnectorSplit*>(splits.back().get());
+  for (auto i = 3; i < filePaths.size(); ++i) {
+    coalesced->coalescedSplits.push_back(
+        std::dynamic_pointer_cast<HiveConnectorSplit>(
+            makeHiveConnectorSplit(filePaths[i]->path)));
+  }
+  auto task = OperatorTestBase::assertQuery(
+      tableScanNode(), splits, "SELECT * FROM tmp");
+  auto stats = getTableScanStats(task);
+  ASSERT_EQ(stats.numSplits, 3);
+  ASSERT_EQ(stats.rawInputRows, 1'000);
+
+  OperatorTestBase::assertQuery(
+      PlanBuilder().tableScan(rowType_, {}, "c0 % 3 = 0").planNode(),
+      splits,
+      "SELECT * FROM tmp WHERE c0 % 3 = 0");
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
@@ -1669,6 +1958,43 @@ TEST_F(TableScanTest, partitionedTableDateKey) {
   testPartitionedTable(filePath->path, DATE(), "2023-10-27");
 }
 
+TEST_F(TableScanTest, partitionValuesAcrossSplits) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  auto vectors = makeVectors(1, 100, rowType);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  // The splits repeat partition values and read a column missing from the
+  // file. Each split must see its own partition value.
+  std::vector<std::optional<std::string>> values = {
+      "1", "2", "1", std::nullopt, "2", std::nullopt};
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  std::vector<std::string> sql;
+  for (const auto& value : values) {
+    splits.push_back(HiveConnectorSplitBuilder(filePath->path)
+                         .partitionKey("pkey", value)
+                         .build());
+    sql.push_back(fmt::format(
+        "SELECT {}, c0, null::double FROM tmp", value.value_or("null")));
+  }
+  auto outputType = ROW({"pkey", "c0", "c2"}, {BIGINT(), BIGINT(), DOUBLE()});
+  ColumnHandleMap assignments = {
+      {"pkey", partitionKey("pkey", BIGINT())},
+      {"c0", regularColumn("c0", BIGINT())},
+      {"c2", regularColumn("c2", DOUBLE())}};
+  auto dataColumns =
+      ROW({"c0", "c1", "c2"}, {BIGINT(), DOUBLE(), DOUBLE()});
+  auto op = PlanBuilder()
+                .startTableScan()
+                .outputType(outputType)
+                .dataColumns(dataColumns)
+                .assignments(assignments)
+                .endTableScan()
+                .planNode();
+  OperatorTestBase::assertQuery(op, splits, folly::join(" UNION ALL ", sql));
+}
+
 std::vector<StringView> toStringViews(const std::vector<std::string>& values) {
   std::vector<StringView> views;
   views.reserve(values.size());
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/TaskArrowStream.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class TaskArrowStreamTest : public OperatorTestBase {
+ protected:
+  std::vector<RowVectorPtr> makeData(int32_t numBatches) {
+    std::vector<RowVectorPtr> data;
+    for (auto i = 0; i < numBatches; ++i) {
+      data.push_back(makeRowVector({
+          makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+          makeFlatVector<std::string>(
+              1'000,
+              [](auto row) {
+                return fmt::format("a string that is not inlined {}", row);
+              }),
+      }));
+    }
+    return data;
+  }
+
+  std::shared_ptr<Task> exportTask(
+      const core::PlanNodePtr& plan,
+      ArrowArrayStream& stream,
+      const TaskArrowStreamOptions& options = {}) {
+    static std::atomic<int32_t> taskId{0};
+    return exportTaskToArrowStream(
+        fmt::format("TaskArrowStreamTest.{}", ++taskId),
+        core::PlanFragment{plan},
+        std::make_shared<core::QueryCtx>(executor_.get()),
+        options,
+        stream);
+  }
+
+  // Returns the next batch of 'stream' imported to Velox or nullptr at end.
+  RowVectorPtr next(ArrowArrayStream& stream) {
+    ArrowArray array;
+    VELOX_CHECK_EQ(
+        stream.get_next(&stream, &array),
+        0,
+        "{}",
+        stream.get_last_error(&stream));
+    if (array.release == nullptr) {
+      return nullptr;
+    }
+    ArrowSchema schema;
+    VELOX_CHECK_EQ(stream.get_schema(&stream, &schema), 0);
+    auto vector = importFromArrowAsOwner(schema, array, pool());
+    return std::dynamic_pointer_cast<RowVector>(vector);
+  }
+
+  std::vector<RowVectorPtr> readAll(ArrowArrayStream& stream) {
+    std::vector<RowVectorPtr> batches;
+    while (auto batch = next(stream)) {
+      batches.push_back(std::move(batch));
+    }
+    return batches;
+  }
+};
+
+TEST_F(TaskArrowStreamTest, basic) {
+  auto plan = PlanBuilder()
+                  .values(makeData(10))
+                  .project({"c0 * 2 AS a", "c1"})
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  ArrowArrayStream stream;
+  auto task = exportTask(plan, stream);
+
+  ArrowSchema schema;
+  ASSERT_EQ(stream.get_schema(&stream, &schema), 0);
+  EXPECT_STREQ("+s", schema.format);
+  ASSERT_EQ(2, schema.n_children);
+  EXPECT_STREQ("a", schema.children[0]->name);
+  schema.release(&schema);
+
+  auto batches = readAll(stream);
+  EXPECT_EQ(10, batches.size());
+  assertEqualResults({expected}, batches);
+
+  // Reading past the end returns no more batches.
+  EXPECT_EQ(nullptr, next(stream));
+  stream.release(&stream);
+  EXPECT_EQ(nullptr, stream.release);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+}
+
+TEST_F(TaskArrowStreamTest, backpressure) {
+  auto data = makeData(10);
+  auto plan = PlanBuilder().values(data).planNode();
+
+  // The Task blocks after each batch until the consumer takes it.
+  TaskArrowStreamOptions options;
+  options.maxQueuedBytes = 1;
+  ArrowArrayStream stream;
+  auto task = exportTask(plan, stream, options);
+
+  std::vector<RowVectorPtr> batches;
+  batches.push_back(next(stream));
+  ASSERT_FALSE(waitForTaskCompletion(task.get(), 100'000));
+
+  auto rest = readAll(stream);
+  batches.insert(batches.end(), rest.begin(), rest.end());
+  assertEqualResults(data, batches);
+  stream.release(&stream);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+}
+
+TEST_F(TaskArrowStreamTest, releaseBeforeEnd) {
+  auto data = makeData(10);
+  auto plan = PlanBuilder().values(data).planNode();
+  TaskArrowStreamOptions options;
+  options.maxQueuedBytes = 1;
+  ArrowArrayStream stream;
+  auto task = exportTask(plan, stream, options);
+
+  // The batches that were exported stay valid after the stream is released.
+  auto batch = next(stream);
+  stream.release(&stream);
+  ASSERT_TRUE(waitForTaskCancelled(task.get()));
+  assertEqualVectors(data[0], batch);
+}
+
+TEST_F(TaskArrowStreamTest, error) {
+  auto plan = PlanBuilder()
+                  .values(makeData(10))
+                  .project({"c0 / 0 AS a"})
+                  .planNode();
+  ArrowArrayStream stream;
+  auto task = exportTask(plan, stream);
+
+  ArrowArray array;
+  ASSERT_NE(stream.get_next(&stream, &array), 0);
+  const std::string error = stream.get_last_error(&stream);
+  EXPECT_NE(error.find("division by zero"), std::string::npos) << error;
+  stream.release(&stream);
+}
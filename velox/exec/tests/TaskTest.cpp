@@ -21,6 +21,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/exec/LocalPlanner.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Values.h"
@@ -465,7 +466,15 @@ class TaskTest : public HiveConnectorTestBase {
           filePaths = {}) {
     auto task = Task::create(
         "single.execution.task.0", plan, 0, std::make_shared<core::QueryCtx>());
+    return executeSingleThreaded(task, filePaths);
+  }
 
+  static std::pair<std::shared_ptr<exec::Task>, std::vector<RowVectorPtr>>
+  executeSingleThreaded(
+      std::shared_ptr<exec::Task> task,
+      const std::unordered_map<std::string, std::vector<std::string>>&
+          filePaths = {}) {
+    const auto& plan = task->planFragment();
     for (const auto& [nodeId, paths] : filePaths) {
       for (const auto& path : paths) {
         task->addSplit(nodeId, exec::Split(makeHiveConnectorSplit(path)));
@@ -944,6 +953,66 @@ TEST_F(TaskTest, supportsSingleThreadedExecution) {
   ASSERT_FALSE(task->supportsSingleThreadedExecution());
 }
 
+TEST_F(TaskTest, preparedPlan) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  std::vector<std::shared_ptr<TempFilePath>> files;
+  for (auto i = 0; i < 3; ++i) {
+    files.push_back(TempFilePath::create());
+    writeToFile(files.back()->path, {data});
+  }
+
+  core::PlanNodeId scanId;
+  auto prepared = PreparedPlanFragment::create(
+      PlanBuilder()
+          .tableScan(asRowType(data->type()))
+          .capturePlanNodeId(scanId)
+          .filter("c0 < 10")
+          .project({"c0 * 2"})
+          .planFragment(),
+      core::QueryConfig({}),
+      1);
+  ASSERT_EQ(prepared->maxDrivers(), 1);
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(10, [](auto row) { return row * 2; }),
+  });
+
+  // Each Task of the prepared plan reads its own splits.
+  for (auto numFiles = 1; numFiles <= files.size(); ++numFiles) {
+    std::vector<std::string> paths;
+    for (auto i = 0; i < numFiles; ++i) {
+      paths.push_back(files[i]->path);
+    }
+    auto task = Task::create(
+        fmt::format("prepared.task.{}", numFiles),
+        prepared,
+        0,
+        std::make_shared<core::QueryCtx>());
+    auto [_, results] = executeSingleThreaded(task, {{scanId, paths}});
+    assertEqualResults(std::vector<RowVectorPtr>(numFiles, expected), results);
+  }
+
+  // A Task started with a different number of drivers plans the fragment
+  // again.
+  auto task = Task::create(
+      "prepared.task.multi",
+      prepared,
+      0,
+      std::make_shared<core::QueryCtx>(driverExecutor_.get()),
+      [](RowVectorPtr /*vector*/, ContinueFuture* /*future*/) {
+        return BlockingReason::kNotBlocked;
+      });
+  task->start(2);
+  for (const auto& file : files) {
+    task->addSplit(scanId, exec::Split(makeHiveConnectorSplit(file->path)));
+  }
+  task->noMoreSplits(scanId);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(task->taskStats().numTotalDrivers, 2);
+}
+
 TEST_F(TaskTest, updateBroadCastOutputBuffers) {
   auto plan = PlanBuilder()
                   .tableScan(ROW({"c0"}, {BIGINT()}))
@@ -1406,6 +1475,50 @@ TEST_F(TaskTest, spillDirectoryLifecycleManagement) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(TaskTest, overflowSpillDirectory) {
+  // Verifies that spill files go to the overflow spill directory once the task
+  // has spilled the max bytes of the spill directory, and that the Task
+  // deletes both directories.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 300; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+
+  const auto plan = PlanBuilder()
+                        .values({data, data, data})
+                        .singleAggregation({"c0"}, {"sum(c1)"}, {})
+                        .planNode();
+  CursorParameters params;
+  params.planNode = plan;
+  params.queryCtx = std::make_shared<core::QueryCtx>(driverExecutor_.get());
+  params.queryCtx->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kSpillEnabled, "true"},
+       {core::QueryConfig::kAggregationSpillEnabled, "true"},
+       {core::QueryConfig::kTestingSpillPct, "100"}});
+  params.maxDrivers = 1;
+
+  auto cursor = TaskCursor::create(params);
+  std::shared_ptr<Task> task = cursor->task();
+  auto rootTempDir = exec::test::TempDirectoryPath::create();
+  const auto spillDirectory = rootTempDir->path + "/spill";
+  const auto overflowSpillDirectory = rootTempDir->path + "/overflow";
+  task->setSpillDirectory(spillDirectory, false);
+  task->setOverflowSpillDirectory(overflowSpillDirectory, 1);
+
+  while (cursor->moveNext()) {
+  }
+  ASSERT_TRUE(waitForTaskCompletion(task.get(), 5'000'000));
+  EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  ASSERT_GT(task->spilledBytes(), 0);
+  auto fs = filesystems::getFileSystem(overflowSpillDirectory, nullptr);
+  ASSERT_TRUE(fs->exists(spillDirectory));
+  ASSERT_TRUE(fs->exists(overflowSpillDirectory));
+  ASSERT_FALSE(fs->list(overflowSpillDirectory).empty());
+  cursor.reset(); // ensure 'task' has no other shared pointer.
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  ASSERT_FALSE(fs->exists(overflowSpillDirectory));
+}
+
 TEST_F(TaskTest, spillDirNotCreated) {
   // Verify that no spill directory is created if spilling is not engaged.
   const std::vector<RowVectorPtr> probeVectors = {makeRowVector(
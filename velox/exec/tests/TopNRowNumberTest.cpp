@@ -239,6 +239,40 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(1, 1);
 }
 
+TEST_F(TopNRowNumberTest, skewedPartitions) {
+  // Half of the rows are in partitions of 1 row and the rest in 5 partitions
+  // of 1'000 rows, so that the heaps of the partitions grow to different
+  // sizes.
+  const vector_size_t size = 10'000;
+  auto data = split(
+      makeRowVector(
+          {"p", "s"},
+          {
+              makeFlatVector<int64_t>(
+                  size,
+                  [](auto row) { return row < 5'000 ? row : row % 5; }),
+              makeFlatVector<int64_t>(
+                  size, [](auto row) { return size - row; }),
+          }),
+      10);
+
+  createDuckDbTable(data);
+
+  for (auto limit : {1, 3, 64, 1'000}) {
+    SCOPED_TRACE(fmt::format("Limit: {}", limit));
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRowNumber({"p"}, {"s"}, limit, true)
+                    .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, row_number() over (partition by p order by s) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            limit));
+  }
+}
+
 TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   auto data = makeRowVector(
       {"p", "s"},
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+constexpr double kScaleFactor = 0.01;
+
+class TpcdsQueryTest : public OperatorTestBase {
+ protected:
+  static constexpr const char* kTpcdsConnectorId = "test-tpcds";
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+
+    for (auto table : tpcds::tables) {
+      std::vector<RowVectorPtr> data;
+      const auto numRows = tpcds::getRowCount(table, kScaleFactor);
+      for (size_t offset = 0; offset < numRows; offset += kBatchSize) {
+        data.push_back(tpcds::genTpcdsData(
+            table, pool(), kBatchSize, offset, kScaleFactor));
+      }
+      createDuckDbTable(std::string(tpcds::toTableName(table)), data);
+    }
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kTpcdsConnectorId);
+    OperatorTestBase::TearDown();
+  }
+
+  // Runs query 'queryId' with 'numSplits' splits per table and compares the
+  // result with DuckDB. 'sortingKeys' are the ordinals of the columns of the
+  // result that the query orders by.
+  void assertQuery(
+      int queryId,
+      const std::vector<uint32_t>& sortingKeys,
+      size_t numSplits = 1) {
+    auto tpcdsPlan = TpcdsQueryBuilder(kScaleFactor).getQueryPlan(queryId);
+    AssertQueryBuilder builder(tpcdsPlan.plan, duckDbQueryRunner_);
+    for (const auto& scanNodeId : tpcdsPlan.scanNodeIds) {
+      std::vector<Split> splits;
+      for (size_t i = 0; i < numSplits; ++i) {
+        splits.emplace_back(
+            std::make_shared<connector::tpcds::TpcdsConnectorSplit>(
+                kTpcdsConnectorId, numSplits, i));
+      }
+      builder.splits(scanNodeId, std::move(splits));
+    }
+    builder.maxDrivers(numSplits).assertResults(
+        TpcdsQueryBuilder::getQuerySql(queryId), sortingKeys);
+  }
+
+  static constexpr size_t kBatchSize = 10'000;
+};
+
+TEST_F(TpcdsQueryTest, q3) {
+  assertQuery(3, {0, 3, 1});
+}
+
+TEST_F(TpcdsQueryTest, q7) {
+  assertQuery(7, {0}, 4);
+}
+
+TEST_F(TpcdsQueryTest, q27) {
+  assertQuery(27, {0, 1});
+}
+
+TEST_F(TpcdsQueryTest, q42) {
+  assertQuery(42, {3, 0, 1, 2}, 4);
+}
+
+TEST_F(TpcdsQueryTest, q52) {
+  assertQuery(52, {0, 3, 1});
+}
+
+TEST_F(TpcdsQueryTest, q55) {
+  assertQuery(55, {2, 0}, 4);
+}
+
+TEST_F(TpcdsQueryTest, q98) {
+  assertQuery(98, {2, 3, 0, 1, 6});
+}
+
+TEST_F(TpcdsQueryTest, unsupported) {
+  VELOX_ASSERT_THROW(
+      TpcdsQueryBuilder(kScaleFactor).getQueryPlan(1),
+      "TPC-DS query 1 is not supported yet");
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
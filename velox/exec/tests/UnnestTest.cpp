@@ -424,10 +424,12 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // Without splitting rows across batches, 17 rows per output allows to
+  // unnest 6 input rows at a time.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
+                    .config(core::QueryConfig::kUnnestSplitOutput, "false")
                     .assertResults({expected});
     auto stats = exec::toPlanStats(task->taskStats());
 
@@ -435,10 +437,12 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // Without splitting rows across batches, 2 rows per output allows to
+  // unnest 1 input row at a time.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
+                    .config(core::QueryConfig::kUnnestSplitOutput, "false")
                     .assertResults({expected});
     auto stats = exec::toPlanStats(task->taskStats());
 
@@ -446,6 +450,20 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
   }
 
+  // Rows split across batches fill each batch.
+  for (auto [batchSize, numBatches] :
+       std::vector<std::pair<std::string, int64_t>>{
+           {"17", (30'000 + 16) / 17}, {"2", 15'000}}) {
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, batchSize)
+            .assertResults({expected});
+    auto stats = exec::toPlanStats(task->taskStats());
+
+    ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
+    ASSERT_EQ(numBatches, stats.at(unnestId).outputVectors);
+  }
+
   // 100K rows per output allows to unnest all at once.
   {
     auto task =
@@ -458,3 +476,107 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
 }
+
+TEST_F(UnnestTest, batchBytes) {
+  // Unnest 100 rows with a 1KB replicated string into 1K rows.
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          100, [](auto row) { return std::string(1'000, 'a' + row % 26); }),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto /*row*/) { return 10; },
+          [](auto row, auto index) { return row * 10 + index; }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1"})
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  // Rows of about 1KB limit the batches to 100 rows.
+  auto task =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kPreferredOutputBatchBytes, "100000")
+          .assertResults({expected});
+  auto stats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(1'000, stats.at(unnestId).outputRows);
+  ASSERT_LE(10, stats.at(unnestId).outputVectors);
+}
+
+TEST_F(UnnestTest, splitLargeArrays) {
+  // A few rows with many elements between rows with few. The second array is
+  // shorter in some rows and null in others.
+  std::vector<vector_size_t> sizes = {3, 10'000, 0, 2'500, 1, 7'777};
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(sizes.size(), [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          sizes.size(),
+          [&](auto row) { return sizes[row]; },
+          [](auto row, auto index) { return row * 100'000 + index; }),
+      makeArrayVector<int64_t>(
+          sizes.size(),
+          [&](auto row) { return sizes[row] / 3; },
+          [](auto /*row*/, auto index) { return index; },
+          nullEvery(4)),
+      vectorMaker_.mapVector<int32_t, int64_t>(
+          sizes.size(),
+          [&](auto row) { return sizes[row] / 2; },
+          [](auto /*row*/, auto index) { return index; },
+          [](auto row, auto index) { return row + index * 2; }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1", "c2", "c3"}, "ordinal")
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+
+  // Each input row in one batch gives the expected result.
+  auto expected = AssertQueryBuilder(plan)
+                      .config(core::QueryConfig::kUnnestSplitOutput, "false")
+                      .copyResults(pool());
+  const vector_size_t numRows = 3 + 10'000 + 2'500 + 1 + 7'777;
+  ASSERT_EQ(expected->size(), numRows);
+
+  for (auto batchSize : {1'000, 333, 20'000}) {
+    SCOPED_TRACE(fmt::format("batchSize: {}", batchSize));
+    auto task = AssertQueryBuilder(plan)
+                    .config(
+                        core::QueryConfig::kPreferredOutputBatchRows,
+                        std::to_string(batchSize))
+                    .assertResults({expected});
+    auto stats = exec::toPlanStats(task->taskStats());
+    ASSERT_EQ(numRows, stats.at(unnestId).outputRows);
+    ASSERT_EQ(
+        (numRows + batchSize - 1) / batchSize,
+        stats.at(unnestId).outputVectors);
+  }
+
+  // The batches of a split row refer to the input without copying. The
+  // replicated column is constant and the elements are a slice of the input.
+  auto singleRow = makeRowVector({
+      makeFlatVector<int64_t>({7}),
+      makeArrayVector<int32_t>(
+          1,
+          [](auto /*row*/) { return 5'000; },
+          [](auto /*row*/, auto index) { return index; }),
+  });
+  CursorParameters params;
+  params.planNode =
+      PlanBuilder().values({singleRow}).unnest({"c0"}, {"c1"}).planNode();
+  params.queryConfigs = {
+      {core::QueryConfig::kPreferredOutputBatchRows, "1000"}};
+  auto [cursor, results] = readCursor(params, [](Task*) {});
+  ASSERT_EQ(results.size(), 5);
+  for (auto i = 0; i < results.size(); ++i) {
+    ASSERT_EQ(results[i]->size(), 1'000);
+    ASSERT_TRUE(results[i]->childAt(0)->isConstantEncoding());
+    ASSERT_TRUE(results[i]->childAt(1)->isFlatEncoding());
+    ASSERT_EQ(
+        results[i]->childAt(1)->asFlatVector<int32_t>()->valueAt(0), i * 1'000);
+  }
+}
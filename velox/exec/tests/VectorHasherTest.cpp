@@ -224,6 +224,44 @@ TEST_F(VectorHasherTest, flat) {
   }
 }
 
+TEST_F(VectorHasherTest, flatMultiColumn) {
+  // Flat columns are hashed without decoding each row. The hashes must be
+  // the same as for the same values behind a dictionary.
+  constexpr vector_size_t kSize = 1'000;
+  std::vector<VectorPtr> columns = {
+      makeFlatVector<int32_t>(
+          kSize, [](auto row) { return row * 3; }, nullEvery(7)),
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.1; }),
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) {
+            return row % 2 ? fmt::format("{}", row)
+                           : fmt::format("a longer string {}", row);
+          },
+          nullEvery(11)),
+      makeFlatVector<Timestamp>(
+          kSize, [](auto row) { return Timestamp(row, row * 1'000); }),
+      makeFlatVector<int128_t>(kSize, [](auto row) { return row; }),
+  };
+  auto identity = makeIndices(kSize, [](auto row) { return row; });
+  SelectivityVector rows(kSize);
+  raw_vector<uint64_t> flatHashes(kSize);
+  raw_vector<uint64_t> dictionaryHashes(kSize);
+  for (auto i = 0; i < columns.size(); ++i) {
+    SCOPED_TRACE(columns[i]->type()->toString());
+    auto hasher = exec::VectorHasher::create(columns[i]->type(), i);
+    hasher->decode(*columns[i], rows);
+    hasher->hash(rows, i > 0, flatHashes);
+    hasher->decode(
+        *BaseVector::wrapInDictionary(nullptr, identity, kSize, columns[i]),
+        rows);
+    hasher->hash(rows, i > 0, dictionaryHashes);
+    for (auto row = 0; row < kSize; ++row) {
+      ASSERT_EQ(flatHashes[row], dictionaryHashes[row]) << "at " << row;
+    }
+  }
+}
+
 TEST_F(VectorHasherTest, nonNullConstant) {
   auto hasher = exec::VectorHasher::create(INTEGER(), 1);
   auto vector = BaseVector::createConstant(INTEGER(), 123, 100, pool());
@@ -573,6 +611,41 @@ TEST_F(VectorHasherTest, dateIds) {
   EXPECT_EQ(numDistinct, VectorHasher::kRangeTooLarge);
 }
 
+TEST_F(VectorHasherTest, timestampIds) {
+  auto vector = BaseVector::create(TIMESTAMP(), 100, pool());
+  auto* timestamps = vector->as<FlatVector<Timestamp>>();
+  timestamps->setNull(0, true);
+  for (auto i = 0; i < 99; ++i) {
+    timestamps->set(i + 1, Timestamp(0, i * 1'000));
+  }
+  auto hasher = exec::VectorHasher::create(TIMESTAMP(), 1);
+  raw_vector<uint64_t> hashes(timestamps->size());
+  SelectivityVector rows(timestamps->size());
+  hasher->decode(*vector, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, hashes));
+  hasher->enableValueRange(1, 0);
+  hasher->decode(*vector, rows);
+  EXPECT_TRUE(hasher->computeValueIds(rows, hashes));
+  // Timestamps are mapped by their nanoseconds since the epoch.
+  EXPECT_EQ(hashes[0], 0);
+  EXPECT_EQ(hashes[1], 1);
+  EXPECT_EQ(hashes[11], 10'001);
+
+  uint64_t numRange;
+  uint64_t numDistinct;
+  hasher->cardinality(0, numRange, numDistinct);
+  EXPECT_EQ(numDistinct, 100);
+  EXPECT_EQ(numRange, 98'002);
+
+  // A timestamp whose nanoseconds do not fit in 64 bits is not mappable.
+  timestamps->set(10, Timestamp(1LL << 40, 0));
+  hasher->decode(*vector, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, hashes));
+  hasher->cardinality(0, numRange, numDistinct);
+  EXPECT_EQ(numRange, VectorHasher::kRangeTooLarge);
+  EXPECT_EQ(numDistinct, VectorHasher::kRangeTooLarge);
+}
+
 TEST_F(VectorHasherTest, boolNoNulls) {
   auto vector = BaseVector::create(BOOLEAN(), 100, pool());
   auto bools = vector->as<FlatVector<bool>>();
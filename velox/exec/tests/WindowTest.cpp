@@ -79,6 +79,134 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, rowStreaming) {
+  const vector_size_t size = 1'000;
+  // Sorted by the partition and the sorting keys. The peer groups and the
+  // partitions span several input batches.
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(size, [](auto row) { return row / 300; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 17; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s)",
+      "rank() over (partition by p order by s)",
+      "dense_rank() over (partition by p order by s)",
+  };
+  auto plan = PlanBuilder()
+                  .values(split(data, 50))
+                  .streamingWindow(functions)
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+      .assertResults(fmt::format(
+          "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+
+  // percent_rank needs all the rows of the partition.
+  plan = PlanBuilder()
+             .values(split(data, 50))
+             .streamingWindow(
+                 {"rank() over (partition by p order by s)",
+                  "percent_rank() over (partition by p order by s)"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+      .assertResults(
+          "SELECT *, rank() over (partition by p order by s), "
+          "percent_rank() over (partition by p order by s) FROM tmp");
+}
+
+TEST_F(WindowTest, kRangeFrameLargePeerGroups) {
+  const vector_size_t size = 2'000;
+  // Large peer groups with sparse ORDER BY values and a frame that spans
+  // several peer groups.
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 3; }),
+          makeFlatVector<double>(
+              size, [](auto row) { return (row / 60) * 100.0; }),
+      });
+  createDuckDbTable({data});
+
+  for (const auto ascending : {true, false}) {
+    SCOPED_TRACE(fmt::format("ascending: {}", ascending));
+    // The frame bound columns are computed by the application.
+    auto plan =
+        PlanBuilder()
+            .values({data})
+            .project(
+                {"d",
+                 "p",
+                 "s",
+                 ascending ? "s - 250.0 as start" : "s + 250.0 as start",
+                 ascending ? "s + 100.0 as finish" : "s - 100.0 as finish"})
+            .window({fmt::format(
+                "sum(d) over (partition by p order by s {} range between "
+                "start preceding and finish following)",
+                ascending ? "asc" : "desc")})
+            .project({"d", "p", "s", "w0"})
+            .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT *, sum(d) over (partition by p order by s {} range "
+            "between 250 preceding and 100 following) FROM tmp",
+            ascending ? "asc" : "desc"));
+  }
+}
+
+TEST_F(WindowTest, sortedBySourceWindow) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "q", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 7; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row % 17; }),
+      });
+  createDuckDbTable({data});
+
+  // The second Window is partitioned by a prefix of the keys of the first
+  // and sorted by the following ones, so it reads sorted input and does not
+  // sort, nor spill, by itself.
+  core::PlanNodeId firstId;
+  core::PlanNodeId secondId;
+  auto plan =
+      PlanBuilder()
+          .values(split(data, 10))
+          .window({"row_number() over (partition by p, q order by s desc)"})
+          .capturePlanNodeId(firstId)
+          .window(
+              {"rank() over (partition by p order by q nulls first, s desc)"})
+          .capturePlanNodeId(secondId)
+          .planNode();
+
+  auto spillDirectory = TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kTestingSpillPct, "100")
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kWindowSpillEnabled, "true")
+          .spillDirectory(spillDirectory->path)
+          .assertResults(
+              "SELECT *, "
+              "row_number() over (partition by p, q order by s desc), "
+              "rank() over (partition by p order by q nulls first, s desc) "
+              "FROM tmp");
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  ASSERT_GT(taskStats.at(firstId).spilledBytes, 0);
+  ASSERT_EQ(taskStats.at(secondId).spilledBytes, 0);
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
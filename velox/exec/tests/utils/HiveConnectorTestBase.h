@@ -225,11 +225,16 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& fileModifiedTime(int64_t fileModifiedTime) {
+    fileModifiedTime_ = fileModifiedTime;
+    return *this;
+  }
+
   std::shared_ptr<connector::hive::HiveConnectorSplit> build() const {
     static const std::unordered_map<std::string, std::string> customSplitInfo;
     static const std::shared_ptr<std::string> extraFileInfo;
     static const std::unordered_map<std::string, std::string> serdeParameters;
-    return std::make_shared<connector::hive::HiveConnectorSplit>(
+    auto split = std::make_shared<connector::hive::HiveConnectorSplit>(
         connectorId_,
         filePath_.find("/") == 0 ? "file:" + filePath_ : filePath_,
         fileFormat_,
@@ -241,6 +246,8 @@ class HiveConnectorSplitBuilder {
         extraFileInfo,
         serdeParameters,
         splitWeight_);
+    split->fileModifiedTime = fileModifiedTime_;
+    return split;
   }
 
  private:
@@ -252,6 +259,7 @@ class HiveConnectorSplitBuilder {
   std::optional<int32_t> tableBucketNumber_;
   std::string connectorId_ = kHiveConnectorId;
   int64_t splitWeight_{0};
+  std::optional<int64_t> fileModifiedTime_;
 };
 
 } // namespace facebook::velox::exec::test
@@ -17,6 +17,7 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
 #include "velox/connectors/tpch/TpchConnector.h"
 #include "velox/duckdb/conversion/DuckParser.h"
 #include "velox/exec/Aggregate.h"
@@ -43,6 +44,7 @@ namespace {
 // TODO Avoid duplication.
 static const std::string kHiveConnectorId = "test-hive";
 static const std::string kTpchConnectorId = "test-tpch";
+static const std::string kTpcdsConnectorId = "test-tpcds";
 
 core::TypedExprPtr parseExpr(
     const std::string& text,
@@ -134,6 +136,32 @@ PlanBuilder& PlanBuilder::tpchTableScan(
       .endTableScan();
 }
 
+PlanBuilder& PlanBuilder::tpcdsTableScan(
+    tpcds::Table table,
+    std::vector<std::string>&& columnNames,
+    double scaleFactor) {
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignmentsMap;
+  std::vector<TypePtr> outputTypes;
+
+  assignmentsMap.reserve(columnNames.size());
+  outputTypes.reserve(columnNames.size());
+
+  for (const auto& columnName : columnNames) {
+    assignmentsMap.emplace(
+        columnName,
+        std::make_shared<connector::tpcds::TpcdsColumnHandle>(columnName));
+    outputTypes.emplace_back(resolveTpcdsColumn(table, columnName));
+  }
+  auto rowType = ROW(std::move(columnNames), std::move(outputTypes));
+  return TableScanBuilder(*this)
+      .outputType(rowType)
+      .tableHandle(std::make_shared<connector::tpcds::TpcdsTableHandle>(
+          kTpcdsConnectorId, table, scaleFactor))
+      .assignments(assignmentsMap)
+      .endTableScan();
+}
+
 core::PlanNodePtr PlanBuilder::TableScanBuilder::build(core::PlanNodeId id) {
   std::unordered_map<std::string, core::TypedExprPtr> typedMapping;
   bool hasAssignments = !(assignments_.empty());
@@ -897,6 +925,41 @@ PlanBuilder& PlanBuilder::groupId(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    std::string groupIdName) {
+  partialAggregation(groupingKeys, aggregates);
+  const auto partialAggNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+  const auto& names = partialAggNode->aggregateNames();
+
+  std::vector<std::string> finalAggregates;
+  std::vector<std::vector<TypePtr>> rawInputTypes;
+  for (auto i = 0; i < names.size(); ++i) {
+    const auto& call = partialAggNode->aggregates()[i].call;
+    std::vector<TypePtr> types;
+    for (const auto& input : call->inputs()) {
+      VELOX_USER_CHECK_NE(
+          input->type()->kind(),
+          TypeKind::FUNCTION,
+          "Grouping sets aggregation does not support lambdas: {}",
+          call->toString());
+      types.push_back(input->type());
+    }
+    finalAggregates.push_back(
+        fmt::format("{}({}) AS {}", call->name(), names[i], names[i]));
+    rawInputTypes.push_back(std::move(types));
+  }
+
+  groupId(groupingKeys, groupingSets, names, groupIdName);
+
+  auto finalKeys = groupingKeys;
+  finalKeys.push_back(std::move(groupIdName));
+  return finalAggregation(finalKeys, finalAggregates, rawInputTypes);
+}
+
 namespace {
 core::PlanNodePtr createLocalMergeNode(
     const core::PlanNodeId& id,
@@ -1103,7 +1166,8 @@ core::PlanNodePtr createLocalPartitionNode(
     const core::PlanNodeId& planNodeId,
     const std::vector<core::TypedExprPtr>& keys,
     const std::vector<core::PlanNodePtr>& sources,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    bool outputKeyHashes = false) {
   auto partitionFunctionFactory =
       createPartitionFunctionSpec(sources[0]->outputType(), keys, pool);
   return std::make_shared<core::LocalPartitionNode>(
@@ -1111,7 +1175,9 @@ core::PlanNodePtr createLocalPartitionNode(
       keys.empty() ? core::LocalPartitionNode::Type::kGather
                    : core::LocalPartitionNode::Type::kRepartition,
       partitionFunctionFactory,
-      sources);
+      sources,
+      /*scaleWriter=*/false,
+      outputKeyHashes);
 }
 } // namespace
 
@@ -1204,6 +1270,18 @@ PlanBuilder& PlanBuilder::localPartition(const std::vector<std::string>& keys) {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::localPartitionWithKeyHashes(
+    const std::vector<std::string>& keys) {
+  VELOX_CHECK(!keys.empty(), "Key hashes require partitioning keys");
+  planNode_ = createLocalPartitionNode(
+      nextPlanNodeId(),
+      exprs(keys, planNode_->outputType()),
+      {planNode_},
+      pool_,
+      true);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::localPartitionByBucket(
     const std::shared_ptr<connector::hive::HiveBucketProperty>&
         bucketProperty) {
@@ -1308,6 +1386,16 @@ PlanBuilder& PlanBuilder::localPartitionRoundRobinRow() {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::scaleWriterLocalPartitionRoundRobin() {
+  planNode_ = std::make_shared<core::LocalPartitionNode>(
+      nextPlanNodeId(),
+      core::LocalPartitionNode::Type::kRepartition,
+      std::make_shared<RoundRobinPartitionFunctionSpec>(),
+      std::vector<core::PlanNodePtr>{planNode_},
+      true);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::hashJoin(
     const std::vector<std::string>& leftKeys,
     const std::vector<std::string>& rightKeys,
@@ -1797,13 +1885,14 @@ PlanBuilder& PlanBuilder::topNRowNumber(
 
 PlanBuilder& PlanBuilder::markDistinct(
     std::string markerKey,
-    const std::vector<std::string>& distinctKeys) {
+    const std::vector<std::string>& distinctKeys,
+    bool preGrouped) {
   VELOX_CHECK_NOT_NULL(planNode_, "MarkDistinct cannot be the source node");
   planNode_ = std::make_shared<core::MarkDistinctNode>(
       nextPlanNodeId(),
       std::move(markerKey),
       fields(planNode_->outputType(), distinctKeys),
-
+      preGrouped,
       planNode_);
   return *this;
 }
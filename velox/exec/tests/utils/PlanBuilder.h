@@ -31,6 +31,10 @@ namespace facebook::velox::tpch {
 enum class Table : uint8_t;
 }
 
+namespace facebook::velox::tpcds {
+enum class Table : uint8_t;
+}
+
 namespace facebook::velox::exec::test {
 
 /// A builder class with fluent API for building query plans. Plans are built
@@ -157,6 +161,16 @@ class PlanBuilder {
       std::vector<std::string>&& columnNames,
       double scaleFactor = 1);
 
+  /// Add a TableScanNode to scan a TPC-DS table.
+  ///
+  /// @param table The TPC-DS table to scan.
+  /// @param columnNames The columns to be returned from that table.
+  /// @param scaleFactor The TPC-DS scale factor.
+  PlanBuilder& tpcdsTableScan(
+      tpcds::Table table,
+      std::vector<std::string>&& columnNames,
+      double scaleFactor = 1);
+
   /// Helper class to build a custom TableScanNode.
   /// Uses a planBuilder instance to get the next plan id, memory pool, and
   /// parse options.
@@ -630,6 +644,20 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Add an aggregation over the grouping sets of 'groupingKeys', e.g. the
+  /// sets of a ROLLUP or CUBE, without replicating the input rows once per
+  /// set. A partial aggregation groups the input by all 'groupingKeys', a
+  /// GroupIdNode replicates the partial results once per grouping set and a
+  /// final aggregation merges the partial results of each set. The output
+  /// has the grouping keys, the 'groupIdName' column and the aggregates. The
+  /// grouping keys must be column names without aliases and the aggregates
+  /// must not take lambdas.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      std::string groupIdName = "group_id");
+
   /// Add an ExpandNode using specified projections. See comments for
   /// ExpandNode class for description of this plan node.
   ///
@@ -775,6 +803,14 @@ class PlanBuilder {
   /// current plan node).
   PlanBuilder& localPartition(const std::vector<std::string>& keys);
 
+  /// Adds a LocalPartitionNode with a single source (the current plan node) to
+  /// hash-partition the input on the specified non-empty keys and to add the
+  /// key hashes to the output as column
+  /// core::LocalPartitionNode::kKeyHashColumn. A hash join build or hash
+  /// aggregation on the same keys reads the hashes from this column.
+  PlanBuilder& localPartitionWithKeyHashes(
+      const std::vector<std::string>& keys);
+
   /// A convenience method to add a LocalPartitionNode with a single source (the
   /// current plan node) and hive bucket property.
   PlanBuilder& localPartitionByBucket(
@@ -798,6 +834,11 @@ class PlanBuilder {
   /// parallelism of the downstream pipeline.
   PlanBuilder& localPartitionRoundRobinRow();
 
+  /// Add a LocalPartitionNode that sends the input to a growing number of
+  /// round-robin partitions, e.g. table writers. See
+  /// core::LocalPartitionNode.
+  PlanBuilder& scaleWriterLocalPartitionRoundRobin();
+
   /// Add a HashJoinNode to join two inputs using one or more join keys and an
   /// optional filter.
   ///
@@ -936,9 +977,11 @@ class PlanBuilder {
   /// Add a MarkDistinctNode to compute aggregate mask channel
   /// @param markerKey Name of output mask channel
   /// @param distinctKeys List of columns to be marked distinct.
+  /// @param preGrouped True if the input is clustered on 'distinctKeys'.
   PlanBuilder& markDistinct(
       std::string markerKey,
-      const std::vector<std::string>& distinctKeys);
+      const std::vector<std::string>& distinctKeys,
+      bool preGrouped = false);
 
   /// Stores the latest plan node ID into the specified variable. Useful for
   /// capturing IDs of the leaf plan nodes (table scans, exchanges, etc.) to use
@@ -0,0 +1,547 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+namespace facebook::velox::exec::test {
+
+namespace {
+
+using tpcds::Table;
+
+// Queries 3, 42, 52 and 55 return at most this many rows.
+constexpr int32_t kLimit = 100;
+
+// The columns of store_sales that queries 7 and 27 average.
+const std::vector<std::string> kMeasures = {
+    "ss_quantity",
+    "ss_list_price",
+    "ss_coupon_amt",
+    "ss_sales_price"};
+
+const std::vector<std::string> kMeasureAverages = {
+    "avg(ss_quantity) AS agg1",
+    "avg(ss_list_price) AS agg2",
+    "avg(ss_coupon_amt) AS agg3",
+    "avg(ss_sales_price) AS agg4"};
+
+std::vector<std::string> concat(
+    std::vector<std::string> left,
+    const std::vector<std::string>& right) {
+  left.insert(left.end(), right.begin(), right.end());
+  return left;
+}
+
+} // namespace
+
+const std::vector<int>& TpcdsQueryBuilder::supportedQueries() {
+  static const std::vector<int> kQueries = {3, 7, 27, 42, 52, 55, 98};
+  return kQueries;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 7:
+      return getQ7Plan();
+    case 27:
+      return getQ27Plan();
+    case 42:
+      return getQ42Plan();
+    case 52:
+      return getQ52Plan();
+    case 55:
+      return getQ55Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+std::string TpcdsQueryBuilder::getQuerySql(int queryId) {
+  switch (queryId) {
+    case 3:
+      return "SELECT d_year, i_brand_id AS brand_id, i_brand AS brand, "
+             "  sum(ss_ext_sales_price) AS sum_agg "
+             "FROM date_dim, store_sales, item "
+             "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+             "  AND i_manufact_id = 128 AND d_moy = 11 "
+             "GROUP BY d_year, i_brand, i_brand_id "
+             "ORDER BY d_year, sum_agg DESC, brand_id "
+             "LIMIT 100";
+    case 7:
+      return "SELECT i_item_id, avg(ss_quantity) AS agg1, "
+             "  avg(ss_list_price) AS agg2, avg(ss_coupon_amt) AS agg3, "
+             "  avg(ss_sales_price) AS agg4 "
+             "FROM store_sales, customer_demographics, date_dim, item, "
+             "  promotion "
+             "WHERE ss_sold_date_sk = d_date_sk AND ss_item_sk = i_item_sk "
+             "  AND ss_cdemo_sk = cd_demo_sk AND ss_promo_sk = p_promo_sk "
+             "  AND cd_gender = 'M' AND cd_marital_status = 'S' "
+             "  AND cd_education_status = 'College' "
+             "  AND (p_channel_email = 'N' OR p_channel_event = 'N') "
+             "  AND d_year = 2000 "
+             "GROUP BY i_item_id "
+             "ORDER BY i_item_id "
+             "LIMIT 100";
+    case 27:
+      return "SELECT i_item_id, s_state, "
+             "  cast(grouping(s_state) AS integer) AS g_state, "
+             "  avg(ss_quantity) AS agg1, avg(ss_list_price) AS agg2, "
+             "  avg(ss_coupon_amt) AS agg3, avg(ss_sales_price) AS agg4 "
+             "FROM store_sales, customer_demographics, date_dim, store, item "
+             "WHERE ss_sold_date_sk = d_date_sk AND ss_item_sk = i_item_sk "
+             "  AND ss_store_sk = s_store_sk AND ss_cdemo_sk = cd_demo_sk "
+             "  AND cd_gender = 'M' AND cd_marital_status = 'S' "
+             "  AND cd_education_status = 'College' AND d_year = 2002 "
+             "  AND s_state IN ('TN') "
+             "GROUP BY ROLLUP (i_item_id, s_state) "
+             "ORDER BY i_item_id ASC NULLS LAST, s_state ASC NULLS LAST "
+             "LIMIT 100";
+    case 42:
+      return "SELECT d_year, i_category_id, i_category, "
+             "  sum(ss_ext_sales_price) AS sum_agg "
+             "FROM date_dim, store_sales, item "
+             "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+             "  AND i_manager_id = 1 AND d_moy = 11 AND d_year = 2000 "
+             "GROUP BY d_year, i_category_id, i_category "
+             "ORDER BY sum_agg DESC, d_year, i_category_id, i_category "
+             "LIMIT 100";
+    case 52:
+      return "SELECT d_year, i_brand_id AS brand_id, i_brand AS brand, "
+             "  sum(ss_ext_sales_price) AS ext_price "
+             "FROM date_dim, store_sales, item "
+             "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+             "  AND i_manager_id = 1 AND d_moy = 11 AND d_year = 2000 "
+             "GROUP BY d_year, i_brand, i_brand_id "
+             "ORDER BY d_year, ext_price DESC, brand_id "
+             "LIMIT 100";
+    case 55:
+      return "SELECT i_brand_id AS brand_id, i_brand AS brand, "
+             "  sum(ss_ext_sales_price) AS ext_price "
+             "FROM date_dim, store_sales, item "
+             "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+             "  AND i_manager_id = 28 AND d_moy = 11 AND d_year = 1999 "
+             "GROUP BY i_brand, i_brand_id "
+             "ORDER BY ext_price DESC, brand_id "
+             "LIMIT 100";
+    case 98:
+      return "SELECT i_item_id, i_item_desc, i_category, i_class, "
+             "  i_current_price, sum(ss_ext_sales_price) AS itemrevenue, "
+             "  sum(ss_ext_sales_price) * 100.0 / "
+             "    sum(sum(ss_ext_sales_price)) OVER (PARTITION BY i_class) "
+             "    AS revenueratio "
+             "FROM store_sales, item, date_dim "
+             "WHERE ss_item_sk = i_item_sk "
+             "  AND i_category IN ('Sports', 'Books', 'Home') "
+             "  AND ss_sold_date_sk = d_date_sk "
+             "  AND d_date BETWEEN cast('1999-02-22' AS date) "
+             "    AND cast('1999-03-24' AS date) "
+             "GROUP BY i_item_id, i_item_desc, i_category, i_class, "
+             "  i_current_price "
+             "ORDER BY i_category, i_class, i_item_id, i_item_desc, "
+             "  revenueratio";
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+TpcdsPlan TpcdsQueryBuilder::getSalesByItemPlan(
+    const std::vector<std::string>& itemColumns,
+    const std::string& itemFilter,
+    const std::string& dateFilter,
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::string>& projections,
+    const std::vector<std::string>& orderBy) const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  core::PlanNodeId scanNodeId;
+
+  auto dates = PlanBuilder(planNodeIdGenerator)
+                   .tpcdsTableScan(
+                       Table::TBL_DATE_DIM,
+                       {"d_date_sk", "d_year", "d_moy"},
+                       scaleFactor_)
+                   .capturePlanNodeId(scanNodeId)
+                   .filter(dateFilter)
+                   .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  auto items = PlanBuilder(planNodeIdGenerator)
+                   .tpcdsTableScan(
+                       Table::TBL_ITEM,
+                       concat(
+                           {"i_item_sk", "i_manufact_id", "i_manager_id"},
+                           itemColumns),
+                       scaleFactor_)
+                   .capturePlanNodeId(scanNodeId)
+                   .filter(itemFilter)
+                   .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  context.plan =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_STORE_SALES,
+              {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+              scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              concat({"ss_sold_date_sk", "ss_ext_sales_price"}, itemColumns))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              concat({"d_year", "ss_ext_sales_price"}, itemColumns))
+          .partialAggregation(
+              groupingKeys, {"sum(ss_ext_sales_price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(projections)
+          .topN(orderBy, kLimit, false)
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ3Plan() const {
+  return getSalesByItemPlan(
+      {"i_brand_id", "i_brand"},
+      "i_manufact_id = 128",
+      "d_moy = 11",
+      {"d_year", "i_brand", "i_brand_id"},
+      {"d_year", "i_brand_id AS brand_id", "i_brand AS brand", "sum_agg"},
+      {"d_year", "sum_agg DESC", "brand_id"});
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ42Plan() const {
+  return getSalesByItemPlan(
+      {"i_category_id", "i_category"},
+      "i_manager_id = 1",
+      "d_moy = 11 AND d_year = 2000",
+      {"d_year", "i_category_id", "i_category"},
+      {"d_year", "i_category_id", "i_category", "sum_agg"},
+      {"sum_agg DESC", "d_year", "i_category_id", "i_category"});
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ52Plan() const {
+  return getSalesByItemPlan(
+      {"i_brand_id", "i_brand"},
+      "i_manager_id = 1",
+      "d_moy = 11 AND d_year = 2000",
+      {"d_year", "i_brand", "i_brand_id"},
+      {"d_year",
+       "i_brand_id AS brand_id",
+       "i_brand AS brand",
+       "sum_agg AS ext_price"},
+      {"d_year", "ext_price DESC", "brand_id"});
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ55Plan() const {
+  return getSalesByItemPlan(
+      {"i_brand_id", "i_brand"},
+      "i_manager_id = 28",
+      "d_moy = 11 AND d_year = 1999",
+      {"i_brand", "i_brand_id"},
+      {"i_brand_id AS brand_id", "i_brand AS brand", "sum_agg AS ext_price"},
+      {"ext_price DESC", "brand_id"});
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ7Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  core::PlanNodeId scanNodeId;
+
+  auto demographics =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_CUSTOMER_DEMOGRAPHICS,
+              {"cd_demo_sk",
+               "cd_gender",
+               "cd_marital_status",
+               "cd_education_status"},
+              scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .filter(
+              "cd_gender = 'M' AND cd_marital_status = 'S' AND "
+              "cd_education_status = 'College'")
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  auto dates =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_DATE_DIM, {"d_date_sk", "d_year"}, scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .filter("d_year = 2000")
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  auto promotions =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_PROMOTION,
+              {"p_promo_sk", "p_channel_email", "p_channel_event"},
+              scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .filter("p_channel_email = 'N' OR p_channel_event = 'N'")
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  auto items =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_ITEM, {"i_item_sk", "i_item_id"}, scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  context.plan =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_STORE_SALES,
+              concat(
+                  {"ss_sold_date_sk",
+                   "ss_item_sk",
+                   "ss_cdemo_sk",
+                   "ss_promo_sk"},
+                  kMeasures),
+              scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              concat(
+                  {"ss_sold_date_sk", "ss_item_sk", "ss_promo_sk"}, kMeasures))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              concat({"ss_item_sk", "ss_promo_sk"}, kMeasures))
+          .hashJoin(
+              {"ss_promo_sk"},
+              {"p_promo_sk"},
+              promotions,
+              "",
+              concat({"ss_item_sk"}, kMeasures))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              concat({"i_item_id"}, kMeasures))
+          .partialAggregation({"i_item_id"}, kMeasureAverages)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"i_item_id"}, kLimit, false)
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ27Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  core::PlanNodeId scanNodeId;
+
+  auto demographics =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_CUSTOMER_DEMOGRAPHICS,
+              {"cd_demo_sk",
+               "cd_gender",
+               "cd_marital_status",
+               "cd_education_status"},
+              scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .filter(
+              "cd_gender = 'M' AND cd_marital_status = 'S' AND "
+              "cd_education_status = 'College'")
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  auto dates =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_DATE_DIM, {"d_date_sk", "d_year"}, scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .filter("d_year = 2002")
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  auto stores =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_STORE, {"s_store_sk", "s_state"}, scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .filter("s_state = 'TN'")
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  auto items =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_ITEM, {"i_item_sk", "i_item_id"}, scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  // The rollup is a GroupId over the grouping sets (i_item_id, s_state),
+  // (i_item_id) and (). g_state is 1 for the sets that do not group by
+  // s_state.
+  context.plan =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_STORE_SALES,
+              concat(
+                  {"ss_sold_date_sk",
+                   "ss_item_sk",
+                   "ss_cdemo_sk",
+                   "ss_store_sk"},
+                  kMeasures),
+              scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              concat(
+                  {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}, kMeasures))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              concat({"ss_item_sk", "ss_store_sk"}, kMeasures))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              concat({"ss_item_sk", "s_state"}, kMeasures))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              concat({"i_item_id", "s_state"}, kMeasures))
+          .groupId(
+              {"i_item_id", "s_state"},
+              {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+              kMeasures)
+          .partialAggregation(
+              {"i_item_id", "s_state", "group_id"}, kMeasureAverages)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"i_item_id",
+               "s_state",
+               "cast(if(group_id = 0, 0, 1) AS integer) AS g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .topN(
+              {"i_item_id ASC NULLS LAST", "s_state ASC NULLS LAST"},
+              kLimit,
+              false)
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ98Plan() const {
+  const std::vector<std::string> itemColumns = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  core::PlanNodeId scanNodeId;
+
+  auto items = PlanBuilder(planNodeIdGenerator)
+                   .tpcdsTableScan(
+                       Table::TBL_ITEM,
+                       concat({"i_item_sk"}, itemColumns),
+                       scaleFactor_)
+                   .capturePlanNodeId(scanNodeId)
+                   .filter("i_category IN ('Sports', 'Books', 'Home')")
+                   .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  auto dates =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_DATE_DIM, {"d_date_sk", "d_date"}, scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .filter(
+              "d_date BETWEEN cast('1999-02-22' AS date) AND "
+              "cast('1999-03-24' AS date)")
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+
+  context.plan =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(
+              Table::TBL_STORE_SALES,
+              {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+              scaleFactor_)
+          .capturePlanNodeId(scanNodeId)
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              concat({"ss_sold_date_sk", "ss_ext_sales_price"}, itemColumns))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              concat({"ss_ext_sales_price"}, itemColumns))
+          .partialAggregation(
+              itemColumns, {"sum(ss_ext_sales_price) AS itemrevenue"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .window({"sum(itemrevenue) OVER (PARTITION BY i_class) AS total"})
+          .project(concat(
+              itemColumns,
+              {"itemrevenue", "itemrevenue * 100.0 / total AS revenueratio"}))
+          .orderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"},
+              false)
+          .planNode();
+  context.scanNodeIds.push_back(scanNodeId);
+  return context;
+}
+
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Contains the query plan and the IDs of its table scan nodes. Each table
+/// scan reads from the TPC-DS connector and takes TpcdsConnectorSplits.
+struct TpcdsPlan {
+  core::PlanNodePtr plan;
+  std::vector<core::PlanNodeId> scanNodeIds;
+};
+
+/// Builds plans of a subset of the TPC-DS queries over the tables of the
+/// TPC-DS connector. The queries are the single-fact-table store_sales
+/// queries whose tables the generator supports. The plans expect the
+/// connector with ID 'test-tpcds' to be registered.
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(double scaleFactor) : scaleFactor_(scaleFactor) {}
+
+  /// Get the query plan for a given TPC-DS query number.
+  /// @param queryId TPC-DS query number. Must be in supportedQueries().
+  TpcdsPlan getQueryPlan(int queryId) const;
+
+  /// Returns the text of query 'queryId' in the SQL of DuckDB. The result
+  /// is the same as the result of getQueryPlan(queryId).
+  static std::string getQuerySql(int queryId);
+
+  /// Returns the numbers of the queries that have plans.
+  static const std::vector<int>& supportedQueries();
+
+ private:
+  TpcdsPlan getQ3Plan() const;
+  TpcdsPlan getQ7Plan() const;
+  TpcdsPlan getQ27Plan() const;
+  TpcdsPlan getQ42Plan() const;
+  TpcdsPlan getQ52Plan() const;
+  TpcdsPlan getQ55Plan() const;
+  TpcdsPlan getQ98Plan() const;
+
+  // Returns a plan for queries 3, 42, 52 and 55. These join store_sales with
+  // item and date_dim, sum ss_ext_sales_price and differ only in filters,
+  // grouping keys and ordering. 'itemColumns' are the columns of item that
+  // the grouping keys use.
+  TpcdsPlan getSalesByItemPlan(
+      const std::vector<std::string>& itemColumns,
+      const std::string& itemFilter,
+      const std::string& dateFilter,
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::string>& projections,
+      const std::vector<std::string>& orderBy) const;
+
+  const double scaleFactor_;
+};
+
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/tests/utils/TpchDataWriter.h"
+#include "velox/connectors/tpch/TpchConnectorSplit.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+int64_t writeTpchTable(
+    tpch::Table table,
+    double scaleFactor,
+    const std::string& outputDirectory,
+    dwio::common::FileFormat format,
+    int32_t numSplits,
+    int32_t numDrivers,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_GT(numSplits, 0);
+  VELOX_CHECK_GT(numDrivers, 0);
+  auto columnNames = tpch::getTableSchema(table)->names();
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tpchTableScan(table, std::move(columnNames), scaleFactor)
+                  .capturePlanNodeId(scanNodeId)
+                  .tableWrite(outputDirectory, format)
+                  .planNode();
+
+  std::vector<Split> splits;
+  splits.reserve(numSplits);
+  for (int32_t i = 0; i < numSplits; ++i) {
+    splits.emplace_back(std::make_shared<connector::tpch::TpchConnectorSplit>(
+        "test-tpch", numSplits, i));
+  }
+  auto result = AssertQueryBuilder(plan)
+                    .splits(scanNodeId, std::move(splits))
+                    .maxDrivers(numDrivers)
+                    .copyResults(pool);
+
+  // The first column of the TableWriter output is the number of rows
+  // written by each driver.
+  auto* rows = result->childAt(0)->as<SimpleVector<int64_t>>();
+  int64_t numRows = 0;
+  for (vector_size_t i = 0; i < rows->size(); ++i) {
+    if (!rows->isNullAt(i)) {
+      numRows += rows->valueAt(i);
+    }
+  }
+  return numRows;
+}
+
+} // namespace facebook::velox::exec::test
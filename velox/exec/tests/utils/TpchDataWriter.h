@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/dwio/common/Options.h"
+#include "velox/tpch/gen/TpchGen.h"
+
+namespace facebook::velox::exec::test {
+
+/// Generates TPC-H 'table' at 'scaleFactor' with the TPC-H connector and
+/// writes it to files of 'format' in 'outputDirectory' through a
+/// TableWriter. The table is generated in 'numSplits' splits by up to
+/// 'numDrivers' threads, each writing its own files. The generator is seeded
+/// at the first row of each split, so the rows do not depend on 'numSplits'
+/// or 'numDrivers'. Expects the connectors 'test-tpch' and 'test-hive' to be
+/// registered. Returns the number of rows written.
+int64_t writeTpchTable(
+    tpch::Table table,
+    double scaleFactor,
+    const std::string& outputDirectory,
+    dwio::common::FileFormat format,
+    int32_t numSplits,
+    int32_t numDrivers,
+    memory::MemoryPool* pool);
+
+} // namespace facebook::velox::exec::test
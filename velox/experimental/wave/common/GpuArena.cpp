@@ -15,6 +15,7 @@
  */
 
 #include "velox/experimental/wave/common/GpuArena.h"
+#include <cstring>
 #include <sstream>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
@@ -275,6 +276,62 @@ GpuArena::Buffers::Buffers() {
   memset(&buffers[0], 0, sizeof(buffers));
 }
 
+HostStaging::HostStaging(
+    GpuAllocator* hostAllocator,
+    uint64_t bufferBytes,
+    int32_t numBuffers)
+    : bufferBytes_(bufferBytes), buffers_(numBuffers) {
+  VELOX_CHECK_GT(bufferBytes_, 0);
+  for (auto& buffer : buffers_) {
+    buffer.data = hostAllocator->allocate<char>(bufferBytes_);
+    buffer.start = std::make_unique<Event>(true);
+    buffer.end = std::make_unique<Event>(true);
+  }
+}
+
+void HostStaging::copyToDevice(
+    void* to,
+    const void* from,
+    uint64_t bytes,
+    Stream& stream) {
+  for (uint64_t offset = 0; offset < bytes; offset += bufferBytes_) {
+    auto& buffer = buffers_[next_];
+    next_ = (next_ + 1) % buffers_.size();
+    if (buffer.pending) {
+      finish(buffer, true);
+    }
+    const auto size = std::min(bufferBytes_, bytes - offset);
+    ::memcpy(
+        buffer.data.get(), reinterpret_cast<const char*>(from) + offset, size);
+    buffer.start->record(stream);
+    stream.hostToDeviceAsync(
+        reinterpret_cast<char*>(to) + offset, buffer.data.get(), size);
+    buffer.end->record(stream);
+    buffer.pending = true;
+    bytesCopied_ += size;
+  }
+}
+
+uint64_t HostStaging::transferNanos() {
+  for (auto& buffer : buffers_) {
+    if (buffer.pending) {
+      finish(buffer, false);
+    }
+  }
+  return transferNanos_;
+}
+
+void HostStaging::finish(StagingBuffer& buffer, bool wait) {
+  if (wait) {
+    buffer.end->wait();
+  } else if (!buffer.end->query()) {
+    return;
+  }
+  transferNanos_ +=
+      static_cast<uint64_t>(buffer.end->elapsedTime(*buffer.start) * 1e6);
+  buffer.pending = false;
+}
+
 GpuArena::GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator)
     : singleArenaCapacity_(singleArenaCapacity), allocator_(allocator) {
   auto arena = std::make_shared<GpuSlab>(
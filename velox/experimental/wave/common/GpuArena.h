@@ -23,6 +23,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "velox/experimental/wave/common/Buffer.h"
 #include "velox/experimental/wave/common/Cuda.h"
@@ -114,6 +115,52 @@ class GpuSlab {
   GpuAllocator* const allocator_;
 };
 
+/// Pinned host buffers for copying pageable host memory to the device. The
+/// buffers are used in turn, so that one is filled on the host while the
+/// copies from the others are in flight. The copies are timed with events.
+/// The caller is responsible for serializing access across threads.
+class HostStaging {
+ public:
+  HostStaging(
+      GpuAllocator* hostAllocator,
+      uint64_t bufferBytes,
+      int32_t numBuffers = 2);
+
+  /// Enqueues a copy of 'bytes' from 'from' to 'to' on 'stream'. 'from' can be
+  /// reused after return. Blocks if the copy from the next buffer in turn is
+  /// not complete.
+  void copyToDevice(void* to, const void* from, uint64_t bytes, Stream& stream);
+
+  /// Bytes copied so far.
+  uint64_t bytesCopied() const {
+    return bytesCopied_;
+  }
+
+  /// Device time of the copies completed so far.
+  uint64_t transferNanos();
+
+ private:
+  struct StagingBuffer {
+    GpuAllocator::UniquePtr<char[]> data;
+    std::unique_ptr<Event> start;
+    std::unique_ptr<Event> end;
+    // True if a copy from 'data' is enqueued and not yet timed.
+    bool pending{false};
+  };
+
+  // Adds the time of the copy from 'buffer' to 'transferNanos_'. If 'wait' is
+  // true, waits for the copy, otherwise only adds the time if the copy is
+  // complete.
+  void finish(StagingBuffer& buffer, bool wait);
+
+  const uint64_t bufferBytes_;
+  std::vector<StagingBuffer> buffers_;
+  // Index of the next buffer to fill.
+  int32_t next_{0};
+  uint64_t bytesCopied_{0};
+  uint64_t transferNanos_{0};
+};
+
 /// A class that manages a set of GpuSlabs. It is able to adapt itself by
 /// growing the number of its managed GpuSlab's when extreme memory
 /// fragmentation happens.
@@ -141,6 +188,18 @@ class GpuArena {
     return arenas_;
   }
 
+  /// Sets the staging buffers for copies from pageable host memory to memory
+  /// of 'this'.
+  void setHostStaging(std::unique_ptr<HostStaging> staging) {
+    hostStaging_ = std::move(staging);
+  }
+
+  /// Returns the staging buffers or nullptr if copies go through unified
+  /// memory.
+  HostStaging* hostStaging() const {
+    return hostStaging_.get();
+  }
+
  private:
   // A preallocated array of Buffer handles for memory of 'this'.
   struct Buffers {
@@ -173,6 +232,8 @@ class GpuArena {
   // All allocations should come from this GpuSlab. When it is no longer able
   // to handle allocations it will be updated to a newly created GpuSlab.
   std::shared_ptr<GpuSlab> currentArena_;
+
+  std::unique_ptr<HostStaging> hostStaging_;
 };
 
 } // namespace facebook::velox::wave
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/GpuArena.h"
+#include "velox/experimental/wave/common/Type.h"
+
+/// Device side decoding of encoded columns. The encoded data is transferred
+/// to the device as is and decoded directly into the buffers of
+/// WaveVectors. Included for both host and device side files.
+namespace facebook::velox::wave {
+
+enum class DecodeStep {
+  // Values of the result type, stored as is.
+  kTrivial,
+  // Bit packed integers. Each is added to a baseline or, if there is a
+  // dictionary, is an index into the dictionary.
+  kBitpack,
+  // Runs of equal values.
+  kRle,
+};
+
+/// Filter on the decoded values. Only the values that pass are written to
+/// the result, so that the filtered out rows never take device memory.
+/// Made from the common::Filter of the ScanSpec of the column, see
+/// setDecodeResult().
+struct DecodeFilter {
+  enum Kind {
+    kAlwaysTrue,
+    // Integers in [lower, upper].
+    kBigintRange,
+  };
+
+  Kind kind{kAlwaysTrue};
+  int64_t lower{0};
+  int64_t upper{0};
+};
+
+/// Decoding of a range of rows of one column.
+struct GpuDecode {
+  struct Trivial {
+    const void* input;
+  };
+
+  struct Bitpack {
+    // Padded with one word so that the last value can be read as a word.
+    const uint64_t* input;
+    int32_t bitWidth;
+    int64_t baseline;
+    // Values of the result type or nullptr.
+    const void* dictionary;
+  };
+
+  struct Rle {
+    // Value of each run, of the result type.
+    const void* values;
+    const int32_t* lengths;
+    int32_t numRuns;
+  };
+
+  DecodeStep step;
+
+  // Kind of the values in 'result'. Integers and floating point.
+  PhysicalType::Kind resultType;
+
+  int32_t numRows;
+
+  // Row number of the first row. Added to the row numbers in 'resultRows'.
+  int32_t firstRow{0};
+
+  // The decoded values. If 'filter' is set, only the values that pass, in
+  // row order.
+  void* result;
+
+  DecodeFilter filter;
+
+  // With a filter, the row numbers of the values that pass.
+  int32_t* resultRows{nullptr};
+
+  // With a filter, set to the number of values that pass.
+  int32_t* numResultRows{nullptr};
+
+  union {
+    Trivial trivial;
+    Bitpack bitpack;
+    Rle rle;
+  } data;
+};
+
+/// Sequences of GpuDecodes. Each sequence is run by one thread block, so
+/// long columns are split into multiple GpuDecodes to spread them over
+/// thread blocks.
+struct DecodePrograms {
+  std::vector<std::vector<std::unique_ptr<GpuDecode>>> programs;
+};
+
+/// Launches a kernel running 'programs' on 'stream'. The GpuDecodes are
+/// copied into 'extra', allocated from 'arena', which must stay live until
+/// the kernel is done.
+void launchDecode(
+    const DecodePrograms& programs,
+    GpuArena* arena,
+    WaveBufferPtr& extra,
+    Stream* stream);
+
+} // namespace facebook::velox::wave
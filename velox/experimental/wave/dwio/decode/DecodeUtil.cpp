@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/dwio/decode/DecodeUtil.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+bool isInteger(PhysicalType::Kind kind) {
+  switch (kind) {
+    case PhysicalType::kInt8:
+    case PhysicalType::kInt16:
+    case PhysicalType::kInt32:
+    case PhysicalType::kInt64:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns false if 'filter' can not be evaluated on the device.
+bool toDecodeFilter(
+    const common::Filter* filter,
+    PhysicalType::Kind kind,
+    DecodeFilter& result) {
+  result = DecodeFilter();
+  if (!filter) {
+    return true;
+  }
+  switch (filter->kind()) {
+    case common::FilterKind::kAlwaysTrue:
+    case common::FilterKind::kIsNotNull:
+      // The decoded values have no nulls.
+      return true;
+    case common::FilterKind::kBigintRange: {
+      if (!isInteger(kind)) {
+        return false;
+      }
+      auto* range = static_cast<const common::BigintRange*>(filter);
+      result.kind = DecodeFilter::kBigintRange;
+      result.lower = range->lower();
+      result.upper = range->upper();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+bool setDecodeResult(
+    const common::ScanSpec& spec,
+    int32_t numRows,
+    WaveVector& result,
+    GpuArena& arena,
+    GpuDecode& decode,
+    WaveBufferPtr& resultRows,
+    WaveBufferPtr& numResultRows) {
+  result.resize(numRows, false);
+  decode.resultType = fromCpuType(*result.type()).kind;
+  decode.numRows = numRows;
+  decode.result = result.values<char>();
+  auto supported =
+      toDecodeFilter(spec.filter(), decode.resultType, decode.filter);
+  if (decode.filter.kind == DecodeFilter::kAlwaysTrue) {
+    decode.resultRows = nullptr;
+    decode.numResultRows = nullptr;
+  } else {
+    decode.resultRows = arena.allocate<int32_t>(numRows, resultRows);
+    decode.numResultRows = arena.allocate<int32_t>(1, numResultRows);
+  }
+  return supported;
+}
+
+} // namespace facebook::velox::wave
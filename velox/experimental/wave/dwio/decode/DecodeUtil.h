@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+#include "velox/experimental/wave/vector/WaveVector.h"
+
+namespace facebook::velox::wave {
+
+/// Sets 'decode' to decode 'numRows' values into 'result', which is
+/// resized to 'numRows', and to apply the filter of 'spec'. With a filter,
+/// 'resultRows' gets the row numbers of the passing values and
+/// 'numResultRows' their count. Returns false if the filter of 'spec' can
+/// not be evaluated on the device. Then all rows are decoded and the caller
+/// must apply the filter to 'result'. The step and its data are set by the
+/// caller.
+bool setDecodeResult(
+    const common::ScanSpec& spec,
+    int32_t numRows,
+    WaveVector& result,
+    GpuArena& arena,
+    GpuDecode& decode,
+    WaveBufferPtr& resultRows,
+    WaveBufferPtr& numResultRows);
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+
+#include <cub/block/block_scan.cuh>
+#include <type_traits>
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/vector/Operand.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+using Scan = cub::BlockScan<int32_t, kBlockSize>;
+
+template <typename T>
+__device__ inline bool testFilter(const DecodeFilter& filter, T value) {
+  if constexpr (std::is_integral_v<T>) {
+    if (filter.kind == DecodeFilter::kBigintRange) {
+      return value >= filter.lower && value <= filter.upper;
+    }
+  }
+  return true;
+}
+
+// Returns the 'bitWidth' bits starting at 'bit'.
+__device__ inline uint64_t
+loadBits(const uint64_t* words, int64_t bit, int32_t bitWidth) {
+  if (bitWidth == 0) {
+    return 0;
+  }
+  auto word = bit >> 6;
+  auto shift = bit & 63;
+  uint64_t bits = words[word] >> shift;
+  if (shift + bitWidth > 64) {
+    bits |= words[word + 1] << (64 - shift);
+  }
+  return bitWidth == 64 ? bits : bits & ((1ULL << bitWidth) - 1);
+}
+
+// Writes the values given by 'getter' for the rows of 'op'. With a filter,
+// writes the passing values and their row numbers one after the other.
+template <typename T, typename Getter>
+__device__ void decodeRows(GpuDecode* op, Getter getter, char* shared) {
+  auto* result = reinterpret_cast<T*>(op->result);
+  if (op->filter.kind == DecodeFilter::kAlwaysTrue) {
+    for (auto row = threadIdx.x; row < op->numRows; row += blockDim.x) {
+      result[row] = getter(row);
+    }
+    return;
+  }
+  auto* temp = reinterpret_cast<Scan::TempStorage*>(shared);
+  int32_t numPassed = 0;
+  for (int32_t start = 0; start < op->numRows; start += blockDim.x) {
+    int32_t row = start + threadIdx.x;
+    T value;
+    bool passed = false;
+    if (row < op->numRows) {
+      value = getter(row);
+      passed = testFilter(op->filter, value);
+    }
+    int32_t offset;
+    int32_t numChunkPassed;
+    Scan(*temp).ExclusiveSum(passed ? 1 : 0, offset, numChunkPassed);
+    __syncthreads();
+    if (passed) {
+      result[numPassed + offset] = value;
+      op->resultRows[numPassed + offset] = op->firstRow + row;
+    }
+    numPassed += numChunkPassed;
+  }
+  if (threadIdx.x == 0) {
+    *op->numResultRows = numPassed;
+  }
+}
+
+template <typename T>
+__device__ void decodeTrivial(GpuDecode* op, char* shared) {
+  auto* input = reinterpret_cast<const T*>(op->data.trivial.input);
+  decodeRows<T>(op, [&](int32_t row) { return input[row]; }, shared);
+}
+
+template <typename T>
+__device__ void decodeBitpack(GpuDecode* op, char* shared) {
+  auto& bitpack = op->data.bitpack;
+  auto* dictionary = reinterpret_cast<const T*>(bitpack.dictionary);
+  decodeRows<T>(
+      op,
+      [&](int32_t row) {
+        auto bits = loadBits(
+            bitpack.input,
+            static_cast<int64_t>(row) * bitpack.bitWidth,
+            bitpack.bitWidth);
+        if (dictionary) {
+          return dictionary[bits];
+        }
+        return static_cast<T>(bitpack.baseline + bits);
+      },
+      shared);
+}
+
+// Each thread expands one run at a time. The offsets of the runs come from a
+// prefix sum of their lengths.
+template <typename T>
+__device__ void decodeRle(GpuDecode* op, char* shared) {
+  auto& rle = op->data.rle;
+  auto* values = reinterpret_cast<const T*>(rle.values);
+  auto* result = reinterpret_cast<T*>(op->result);
+  auto* temp = reinterpret_cast<Scan::TempStorage*>(shared);
+  const bool hasFilter = op->filter.kind != DecodeFilter::kAlwaysTrue;
+  int32_t numRows = 0;
+  int32_t numPassed = 0;
+  for (int32_t start = 0; start < rle.numRuns; start += blockDim.x) {
+    int32_t run = start + threadIdx.x;
+    int32_t length = 0;
+    bool passed = false;
+    T value;
+    if (run < rle.numRuns) {
+      length = rle.lengths[run];
+      value = values[run];
+      passed = testFilter(op->filter, value);
+    }
+    int32_t rowOffset;
+    int32_t numChunkRows;
+    Scan(*temp).ExclusiveSum(length, rowOffset, numChunkRows);
+    __syncthreads();
+    int32_t passedOffset;
+    int32_t numChunkPassed;
+    Scan(*temp).ExclusiveSum(passed ? length : 0, passedOffset, numChunkPassed);
+    __syncthreads();
+    if (!hasFilter) {
+      for (auto i = 0; i < length; ++i) {
+        result[numRows + rowOffset + i] = value;
+      }
+    } else if (passed) {
+      for (auto i = 0; i < length; ++i) {
+        result[numPassed + passedOffset + i] = value;
+        op->resultRows[numPassed + passedOffset + i] =
+            op->firstRow + numRows + rowOffset + i;
+      }
+    }
+    numRows += numChunkRows;
+    numPassed += numChunkPassed;
+  }
+  assert(numRows == op->numRows);
+  if (hasFilter && threadIdx.x == 0) {
+    *op->numResultRows = numPassed;
+  }
+}
+
+template <typename T>
+__device__ void decodeStep(GpuDecode* op, char* shared) {
+  switch (op->step) {
+    case DecodeStep::kTrivial:
+      decodeTrivial<T>(op, shared);
+      break;
+    case DecodeStep::kBitpack:
+      decodeBitpack<T>(op, shared);
+      break;
+    case DecodeStep::kRle:
+      decodeRle<T>(op, shared);
+      break;
+  }
+}
+
+__device__ void decodeStep(GpuDecode* op, char* shared) {
+  switch (op->resultType) {
+    case PhysicalType::kInt8:
+      decodeStep<int8_t>(op, shared);
+      break;
+    case PhysicalType::kInt16:
+      decodeStep<int16_t>(op, shared);
+      break;
+    case PhysicalType::kInt32:
+      decodeStep<int32_t>(op, shared);
+      break;
+    case PhysicalType::kInt64:
+      decodeStep<int64_t>(op, shared);
+      break;
+    case PhysicalType::kFloat32:
+      decodeStep<float>(op, shared);
+      break;
+    case PhysicalType::kFloat64:
+      decodeStep<double>(op, shared);
+      break;
+    default:
+#ifndef NDEBUG
+      printf(
+          "%s:%d: Unsupported type %d\n", __FILE__, __LINE__, op->resultType);
+#endif
+      assert(false);
+  }
+}
+
+__global__ void decodeGlobal(GpuDecode* steps, int32_t* programStarts) {
+  extern __shared__ __align__(alignof(Scan::TempStorage)) char shared[];
+  auto end = programStarts[blockIdx.x + 1];
+  for (auto i = programStarts[blockIdx.x]; i < end; ++i) {
+    decodeStep(&steps[i], shared);
+    __syncthreads();
+  }
+}
+
+} // namespace
+
+void launchDecode(
+    const DecodePrograms& programs,
+    GpuArena* arena,
+    WaveBufferPtr& extra,
+    Stream* stream) {
+  int32_t numSteps = 0;
+  for (auto& program : programs.programs) {
+    numSteps += program.size();
+  }
+  const int32_t numPrograms = programs.programs.size();
+  extra = arena->allocateBytes(
+      numSteps * sizeof(GpuDecode) + (numPrograms + 1) * sizeof(int32_t));
+  auto* steps = extra->as<GpuDecode>();
+  auto* programStarts = reinterpret_cast<int32_t*>(steps + numSteps);
+  int32_t fill = 0;
+  for (auto i = 0; i < numPrograms; ++i) {
+    programStarts[i] = fill;
+    for (auto& step : programs.programs[i]) {
+      steps[fill++] = *step;
+    }
+  }
+  programStarts[numPrograms] = fill;
+  if (numPrograms == 0) {
+    return;
+  }
+  decodeGlobal<<<
+      numPrograms,
+      kBlockSize,
+      sizeof(Scan::TempStorage),
+      stream->stream()->stream>>>(steps, programStarts);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <deque>
+
+#include "velox/experimental/wave/common/GpuArena.h"
+#include "velox/experimental/wave/dwio/decode/DecodeUtil.h"
+#include "velox/type/Filter.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::wave;
+
+class GpuDecoderTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = getDevice();
+    setDevice(device_);
+    allocator_ = getAllocator(device_);
+    arena_ = std::make_unique<GpuArena>(1 << 28, allocator_);
+  }
+
+  // Returns a GpuDecode writing 'numRows' values of 'type' into 'result'
+  // and applying the filter of 'spec'.
+  std::unique_ptr<GpuDecode> makeDecode(
+      DecodeStep step,
+      const TypePtr& type,
+      int32_t numRows,
+      const common::ScanSpec& spec,
+      std::unique_ptr<WaveVector>& result) {
+    auto decode = std::make_unique<GpuDecode>();
+    decode->step = step;
+    result = std::make_unique<WaveVector>(type, *arena_);
+    EXPECT_TRUE(setDecodeResult(
+        spec,
+        numRows,
+        *result,
+        *arena_,
+        *decode,
+        resultRows_.emplace_back(),
+        numResultRows_.emplace_back()));
+    return decode;
+  }
+
+  void run(DecodePrograms& programs) {
+    Stream stream;
+    WaveBufferPtr extra;
+    launchDecode(programs, arena_.get(), extra, &stream);
+    stream.wait();
+  }
+
+  // Bit packs 'values' with 'bitWidth' bits each.
+  const uint64_t* bitpack(const std::vector<uint64_t>& values, int bitWidth) {
+    const auto numWords = (values.size() * bitWidth + 63) / 64 + 1;
+    auto* words = arena_->allocate<uint64_t>(numWords, buffers_.emplace_back());
+    std::fill(words, words + numWords, 0);
+    for (auto i = 0; i < values.size(); ++i) {
+      const uint64_t bit = i * bitWidth;
+      words[bit / 64] |= values[i] << (bit % 64);
+      if (bit % 64 + bitWidth > 64) {
+        words[bit / 64 + 1] |= values[i] >> (64 - bit % 64);
+      }
+    }
+    return words;
+  }
+
+  template <typename T>
+  T* copyToDevice(const std::vector<T>& values) {
+    auto* data = arena_->allocate<T>(values.size(), buffers_.emplace_back());
+    std::copy(values.begin(), values.end(), data);
+    return data;
+  }
+
+  // Checks that 'result' has the values of 'expected' that pass 'filter'
+  // and that the row numbers of the filtered values are right.
+  template <typename T>
+  void checkResult(
+      const std::vector<T>& expected,
+      WaveVector& result,
+      const GpuDecode& decode,
+      const common::Filter* filter = nullptr) {
+    auto* values = result.values<T>();
+    if (!filter) {
+      for (auto i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], values[i]) << i;
+      }
+      return;
+    }
+    int32_t numPassed = 0;
+    for (auto i = 0; i < expected.size(); ++i) {
+      if (!filter->testInt64(expected[i])) {
+        continue;
+      }
+      ASSERT_EQ(expected[i], values[numPassed]) << i;
+      ASSERT_EQ(decode.firstRow + i, decode.resultRows[numPassed]) << i;
+      ++numPassed;
+    }
+    ASSERT_EQ(numPassed, *decode.numResultRows);
+  }
+
+  Device* device_;
+  GpuAllocator* allocator_;
+  std::unique_ptr<GpuArena> arena_;
+  std::vector<WaveBufferPtr> buffers_;
+  std::deque<WaveBufferPtr> resultRows_;
+  std::deque<WaveBufferPtr> numResultRows_;
+};
+
+TEST_F(GpuDecoderTest, trivial) {
+  constexpr int32_t kNumRows = 10'000;
+  std::vector<int64_t> data(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    data[i] = i * 11;
+  }
+  common::ScanSpec spec("c0");
+  std::unique_ptr<WaveVector> result;
+  DecodePrograms programs;
+  auto decode =
+      makeDecode(DecodeStep::kTrivial, BIGINT(), kNumRows, spec, result);
+  decode->data.trivial.input = copyToDevice(data);
+  auto* step = decode.get();
+  programs.programs.emplace_back().push_back(std::move(decode));
+  run(programs);
+  checkResult(data, *result, *step);
+}
+
+TEST_F(GpuDecoderTest, bitpack) {
+  constexpr int32_t kNumRows = 3'000;
+  for (auto bitWidth : {1, 3, 8, 13, 32, 47, 64}) {
+    SCOPED_TRACE(fmt::format("bitWidth {}", bitWidth));
+    const uint64_t mask = bitWidth == 64 ? ~0ULL : (1ULL << bitWidth) - 1;
+    std::vector<uint64_t> packed(kNumRows);
+    std::vector<int64_t> expected(kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      packed[i] = (i * 0x9E3779B97F4A7C15ULL) & mask;
+      expected[i] = packed[i] + 100;
+    }
+    common::ScanSpec spec("c0");
+    std::unique_ptr<WaveVector> result;
+    DecodePrograms programs;
+    auto decode =
+        makeDecode(DecodeStep::kBitpack, BIGINT(), kNumRows, spec, result);
+    decode->data.bitpack.input = bitpack(packed, bitWidth);
+    decode->data.bitpack.bitWidth = bitWidth;
+    decode->data.bitpack.baseline = 100;
+    decode->data.bitpack.dictionary = nullptr;
+    auto* step = decode.get();
+    programs.programs.emplace_back().push_back(std::move(decode));
+    run(programs);
+    checkResult(expected, *result, *step);
+  }
+}
+
+TEST_F(GpuDecoderTest, dictionary) {
+  constexpr int32_t kNumRows = 5'000;
+  constexpr int32_t kDictionarySize = 100;
+  std::vector<double> dictionary(kDictionarySize);
+  for (auto i = 0; i < kDictionarySize; ++i) {
+    dictionary[i] = i * 1.5;
+  }
+  std::vector<uint64_t> indices(kNumRows);
+  std::vector<double> expected(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    indices[i] = (i * 7) % kDictionarySize;
+    expected[i] = dictionary[indices[i]];
+  }
+  common::ScanSpec spec("c0");
+  std::unique_ptr<WaveVector> result;
+  DecodePrograms programs;
+  auto decode =
+      makeDecode(DecodeStep::kBitpack, DOUBLE(), kNumRows, spec, result);
+  decode->data.bitpack.input = bitpack(indices, 7);
+  decode->data.bitpack.bitWidth = 7;
+  decode->data.bitpack.baseline = 0;
+  decode->data.bitpack.dictionary = copyToDevice(dictionary);
+  auto* step = decode.get();
+  programs.programs.emplace_back().push_back(std::move(decode));
+  run(programs);
+  checkResult(expected, *result, *step);
+}
+
+TEST_F(GpuDecoderTest, rle) {
+  std::vector<int32_t> values;
+  std::vector<int32_t> lengths;
+  std::vector<int32_t> expected;
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(i * 3);
+    lengths.push_back(1 + (i * 13) % 29);
+    expected.insert(expected.end(), lengths.back(), values.back());
+  }
+  common::ScanSpec spec("c0");
+  std::unique_ptr<WaveVector> result;
+  DecodePrograms programs;
+  auto decode = makeDecode(
+      DecodeStep::kRle, INTEGER(), expected.size(), spec, result);
+  decode->data.rle.values = copyToDevice(values);
+  decode->data.rle.lengths = copyToDevice(lengths);
+  decode->data.rle.numRuns = values.size();
+  auto* step = decode.get();
+  programs.programs.emplace_back().push_back(std::move(decode));
+  run(programs);
+  checkResult(expected, *result, *step);
+}
+
+TEST_F(GpuDecoderTest, filter) {
+  constexpr int32_t kNumRows = 4'096;
+  constexpr int32_t kNumPrograms = 4;
+  std::vector<uint64_t> packed(kNumRows);
+  std::vector<int64_t> expected(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    packed[i] = (i * 121) % 1'000;
+    expected[i] = packed[i];
+  }
+  common::ScanSpec spec("c0");
+  spec.setFilter(std::make_unique<common::BigintRange>(100, 199, false));
+  // Each program decodes a quarter of the rows into its own vector.
+  constexpr int32_t kRowsPerProgram = kNumRows / kNumPrograms;
+  std::vector<std::unique_ptr<WaveVector>> results(kNumPrograms);
+  std::vector<GpuDecode*> steps;
+  DecodePrograms programs;
+  auto* input = bitpack(packed, 10);
+  for (auto i = 0; i < kNumPrograms; ++i) {
+    auto decode = makeDecode(
+        DecodeStep::kBitpack, BIGINT(), kRowsPerProgram, spec, results[i]);
+    decode->firstRow = i * kRowsPerProgram;
+    // 10 bits per value, so that each quarter starts at a whole word.
+    decode->data.bitpack.input = input + i * kRowsPerProgram * 10 / 64;
+    decode->data.bitpack.bitWidth = 10;
+    decode->data.bitpack.baseline = 0;
+    decode->data.bitpack.dictionary = nullptr;
+    steps.push_back(decode.get());
+    programs.programs.emplace_back().push_back(std::move(decode));
+  }
+  run(programs);
+  for (auto i = 0; i < kNumPrograms; ++i) {
+    std::vector<int64_t> quarter(
+        expected.begin() + i * kRowsPerProgram,
+        expected.begin() + (i + 1) * kRowsPerProgram);
+    checkResult(quarter, *results[i], *steps[i], spec.filter());
+  }
+}
+
+TEST_F(GpuDecoderTest, unsupportedFilter) {
+  common::ScanSpec spec("c0");
+  spec.setFilter(std::make_unique<common::DoubleRange>(
+      1.0, false, false, 2.0, false, false, false));
+  auto result = std::make_unique<WaveVector>(DOUBLE(), *arena_);
+  GpuDecode decode;
+  WaveBufferPtr resultRows;
+  WaveBufferPtr numResultRows;
+  EXPECT_FALSE(setDecodeResult(
+      spec, 100, *result, *arena_, decode, resultRows, numResultRows));
+  EXPECT_EQ(DecodeFilter::kAlwaysTrue, decode.filter.kind);
+}
@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/exec/HashJoin.h"
+
+#include <folly/ScopeGuard.h>
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+DEFINE_int64(
+    velox_wave_hash_join_device_bytes,
+    4LL << 30,
+    "Maximum size of the rows of a Wave hash join table in GPU memory. "
+    "Larger tables are placed in pinned host memory");
+
+namespace facebook::velox::wave {
+
+namespace {
+
+constexpr int32_t kMinBuckets = 1024;
+constexpr uint64_t kMinArenaBytes = 64 << 20;
+
+bool isWaveSource(const core::PlanNode& node) {
+  if (dynamic_cast<const core::ValuesNode*>(&node)) {
+    return true;
+  }
+  if (dynamic_cast<const core::ProjectNode*>(&node)) {
+    return isWaveSource(*node.sources()[0]);
+  }
+  return false;
+}
+
+bool isFixedWidth(const RowType& type) {
+  for (auto& child : type.children()) {
+    switch (child->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// Returns the size of a slab of an arena whose largest allocation is
+// 'largestBytes'.
+uint64_t arenaCapacity(uint64_t largestBytes) {
+  return std::max(kMinArenaBytes, bits::nextPowerOfTwo(largestBytes));
+}
+
+} // namespace
+
+bool isWaveHashJoin(const core::HashJoinNode& node) {
+  if (!node.isInnerJoin() || node.filter() || node.isNullAware() ||
+      node.leftKeys().size() != 1 || node.outputType()->size() == 0) {
+    return false;
+  }
+  auto kind = node.leftKeys()[0]->type()->kind();
+  if ((kind != TypeKind::INTEGER && kind != TypeKind::BIGINT) ||
+      node.rightKeys()[0]->type()->kind() != kind) {
+    return false;
+  }
+  for (auto& source : node.sources()) {
+    if (!isFixedWidth(*source->outputType()) || !isWaveSource(*source)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+std::shared_ptr<WaveHashJoinBridge> WaveHashJoinBridge::getInstance(
+    const exec::DriverCtx& driverCtx,
+    const core::PlanNodeId& joinNodeId) {
+  using Key = std::tuple<const exec::Task*, uint32_t, core::PlanNodeId>;
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<WaveHashJoinBridge>> bridges;
+  std::lock_guard<std::mutex> l(mutex);
+  for (auto it = bridges.begin(); it != bridges.end();) {
+    if (it->second.expired()) {
+      it = bridges.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto& entry =
+      bridges[Key(driverCtx.task.get(), driverCtx.splitGroupId, joinNodeId)];
+  auto bridge = entry.lock();
+  if (!bridge) {
+    bridge = std::make_shared<WaveHashJoinBridge>();
+    entry = bridge;
+  }
+  return bridge;
+}
+
+void WaveHashJoinBridge::addInput(std::vector<WaveVectorPtr> input) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_NULL(table_);
+  for (auto& batch : input) {
+    if (batch->size() > 0) {
+      input_.push_back(std::move(batch));
+    }
+  }
+}
+
+void WaveHashJoinBridge::build(const RowType& buildType, int32_t keyChannel) {
+  std::vector<WaveVectorPtr> input;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_NULL(table_);
+    input = std::move(input_);
+  }
+  int64_t numRows = 0;
+  int32_t numBlocks = 0;
+  for (auto& batch : input) {
+    numRows += batch->size();
+    numBlocks =
+        std::max(numBlocks, (batch->size() + kBlockSize - 1) / kBlockSize);
+  }
+  VELOX_CHECK_LE(numRows, std::numeric_limits<int32_t>::max());
+  const int32_t numColumns = buildType.size();
+  int64_t largestColumnBytes = 0;
+  int64_t rowBytes = 0;
+  for (auto& type : buildType.children()) {
+    // A value and a null flag.
+    rowBytes += type->cppSizeInBytes() + 1;
+    largestColumnBytes = std::max<int64_t>(
+        largestColumnBytes, numRows * type->cppSizeInBytes());
+  }
+  rowsInHostMemory_ =
+      numRows * rowBytes > FLAGS_velox_wave_hash_join_device_bytes;
+  if (rowsInHostMemory_) {
+    LOG(INFO) << "Wave hash join table of " << numRows << " rows and "
+              << numRows * rowBytes << " bytes is placed in host memory";
+  }
+  const int64_t numBuckets =
+      bits::nextPowerOfTwo(std::max<int64_t>(kMinBuckets, numRows * 2));
+  auto* device = getDevice();
+  arena_ = std::make_unique<GpuArena>(
+      arenaCapacity(numBuckets * sizeof(int32_t)), getAllocator(device));
+  rowArena_ = std::make_unique<GpuArena>(
+      arenaCapacity(largestColumnBytes),
+      rowsInHostMemory_ ? getHostAllocator(device) : getAllocator(device));
+
+  auto* table =
+      arena_->allocate<hashjoin::HashTable>(1, buffers_.emplace_back());
+  table->sizeMask = numBuckets - 1;
+  table->heads = arena_->allocate<int32_t>(numBuckets, buffers_.emplace_back());
+  std::fill_n(table->heads, numBuckets, hashjoin::kNoRow);
+  table->next = arena_->allocate<int32_t>(
+      std::max<int64_t>(1, numRows), buffers_.emplace_back());
+  table->numRows = numRows;
+  table->numColumns = numColumns;
+  table->keyColumn = keyChannel;
+  table->columnTypes =
+      arena_->allocate<PhysicalType>(numColumns, buffers_.emplace_back());
+  table->columns = arena_->allocate<void*>(numColumns, buffers_.emplace_back());
+  table->nulls =
+      arena_->allocate<uint8_t*>(numColumns, buffers_.emplace_back());
+  for (auto i = 0; i < numColumns; ++i) {
+    auto& type = buildType.childAt(i);
+    table->columnTypes[i] = fromCpuType(*type);
+    buffers_.push_back(rowArena_->allocateBytes(
+        std::max<int64_t>(1, numRows) * type->cppSizeInBytes()));
+    table->columns[i] = buffers_.back()->as<char>();
+    table->nulls[i] = rowArena_->allocate<uint8_t>(
+        std::max<int64_t>(1, numRows), buffers_.emplace_back());
+  }
+
+  if (!input.empty()) {
+    // Each block copies and inserts its range of rows of all batches.
+    std::vector<WaveBufferPtr> holders;
+    auto* instructions = arena_->allocate<hashjoin::Instruction>(
+        input.size(), holders.emplace_back());
+    auto* operands = arena_->allocate<Operand>(
+        input.size() * numColumns, holders.emplace_back());
+    int32_t firstRow = 0;
+    for (auto i = 0; i < input.size(); ++i) {
+      instructions[i].opCode = hashjoin::OpCode::kBuildRows;
+      auto& buildRows = instructions[i]._.buildRows;
+      buildRows.table = table;
+      buildRows.inputs = operands + i * numColumns;
+      buildRows.firstRow = firstRow;
+      for (auto j = 0; j < numColumns; ++j) {
+        input[i]->childAt(j).toOperand(&buildRows.inputs[j]);
+      }
+      firstRow += input[i]->size();
+    }
+    auto* programs = arena_->allocate<hashjoin::ThreadBlockProgram>(
+        numBlocks, holders.emplace_back());
+    for (auto i = 0; i < numBlocks; ++i) {
+      programs[i].numInstructions = input.size();
+      programs[i].instructions = instructions;
+    }
+    auto* status =
+        arena_->allocate<BlockStatus>(numBlocks, holders.emplace_back());
+    bzero(status, numBlocks * sizeof(BlockStatus));
+    auto stream = WaveStream::streamFromReserve();
+    hashjoin::call(*stream, numBlocks, programs, nullptr, status, 0);
+    stream->wait();
+    WaveStream::releaseStream(std::move(stream));
+  }
+  // The batches belong to the build Drivers, which may finish now.
+  input.clear();
+
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    table_ = table;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+hashjoin::HashTable* WaveHashJoinBridge::table(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (table_) {
+    return table_;
+  }
+  if (future) {
+    promises_.emplace_back("WaveHashJoinBridge::table");
+    *future = promises_.back().getSemiFuture();
+  }
+  return nullptr;
+}
+
+HashBuild::HashBuild(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, ROW({}, {})),
+      joinNodeId_(node.id()),
+      driverCtx_(state.driverCtx()),
+      buildType_(node.sources()[1]->outputType()),
+      keyChannel_(
+          exec::exprToChannel(node.rightKeys()[0].get(), buildType_)),
+      bridge_(WaveHashJoinBridge::getInstance(*driverCtx_, node.id())) {
+  VELOX_CHECK_NE(keyChannel_, kConstantChannel);
+}
+
+void HashBuild::flush(bool noMoreInput) {
+  if (!noMoreInput || noMoreInput_) {
+    return;
+  }
+  noMoreInput_ = true;
+  bridge_->addInput(std::move(buffered_));
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<exec::Driver>> peers;
+  if (!driverCtx_->task->allPeersFinished(
+          joinNodeId_, driverCtx_->driver, &future_, promises, peers)) {
+    return;
+  }
+  // The other build Drivers wait for their batches to be copied into the
+  // table.
+  SCOPE_EXIT {
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+  bridge_->build(*buildType_, keyChannel_);
+}
+
+exec::BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  *future = std::move(future_);
+  return exec::BlockingReason::kWaitForJoinBuild;
+}
+
+HashProbe::HashProbe(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, node.outputType()),
+      arena_(&state.arena()),
+      bridge_(WaveHashJoinBridge::getInstance(*state.driverCtx(), node.id())) {
+  auto& probeType = node.sources()[0]->outputType();
+  auto& buildType = node.sources()[1]->outputType();
+  keyChannel_ = exec::exprToChannel(node.leftKeys()[0].get(), probeType);
+  VELOX_CHECK_NE(keyChannel_, kConstantChannel);
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto& name = outputType_->nameOf(i);
+    if (auto channel = probeType->getChildIdxIfExists(name)) {
+      probeProjections_.emplace_back(*channel, i);
+      probeTypes_.push_back(fromCpuType(*probeType->childAt(*channel)));
+    } else {
+      buildProjections_.emplace_back(buildType->getChildIdx(name), i);
+    }
+  }
+}
+
+HashProbe::~HashProbe() {
+  if (countStream_) {
+    WaveStream::releaseStream(std::move(countStream_));
+  }
+}
+
+exec::BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
+  if (table_ || buffered_.empty() || (table_ = bridge_->table(future))) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  return exec::BlockingReason::kWaitForJoinBuild;
+}
+
+int32_t HashProbe::countMatches() {
+  if (!countStream_) {
+    countStream_ = WaveStream::streamFromReserve();
+  }
+  auto& holder = countHolder_;
+  int32_t numBlocks = bits::roundUp(input_->size(), kBlockSize) / kBlockSize;
+  auto* programs = arena_->allocate<hashjoin::ThreadBlockProgram>(
+      numBlocks, holder.programs);
+  auto* instruction =
+      arena_->allocate<hashjoin::Instruction>(1, holder.instructions);
+  auto* status = arena_->allocate<BlockStatus>(numBlocks, holder.status);
+  bzero(status, numBlocks * sizeof(BlockStatus));
+  auto* numMatches = arena_->allocate<int32_t>(1, holder.numMatches);
+  *numMatches = 0;
+  instruction->opCode = hashjoin::OpCode::kCountMatches;
+  auto& countMatches = instruction->_.countMatches;
+  countMatches.table = table_;
+  countMatches.probeKey = arena_->allocate<Operand>(1, holder.key);
+  input_->childAt(keyChannel_).toOperand(countMatches.probeKey);
+  countMatches.numMatches = numMatches;
+  for (auto i = 0; i < numBlocks; ++i) {
+    programs[i].numInstructions = 1;
+    programs[i].instructions = instruction;
+  }
+  hashjoin::call(
+      *countStream_,
+      numBlocks,
+      programs,
+      nullptr,
+      status,
+      hashjoin::CountMatches::sharedSize());
+  countStream_->wait();
+  return *numMatches;
+}
+
+int32_t HashProbe::canAdvance() {
+  if (input_ || buffered_.empty()) {
+    return 0;
+  }
+  if (!table_ && !(table_ = bridge_->table(nullptr))) {
+    return 0;
+  }
+  while (!buffered_.empty()) {
+    input_ = std::move(buffered_.front());
+    buffered_.pop_front();
+    if (input_->size() > 0) {
+      if (auto numMatches = countMatches()) {
+        return numMatches;
+      }
+    }
+    input_.reset();
+  }
+  return 0;
+}
+
+void HashProbe::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK_NOT_NULL(input_);
+  const int32_t numColumns = outputType_->size();
+  const int32_t numProbeColumns = probeProjections_.size();
+  const int32_t numBuildColumns = buildProjections_.size();
+  const int32_t numBlocks =
+      bits::roundUp(input_->size(), kBlockSize) / kBlockSize;
+  auto exec = std::make_unique<Executable>();
+  auto* programs = arena_->allocate<hashjoin::ThreadBlockProgram>(
+      numBlocks, exec->deviceData.emplace_back());
+  auto* instruction = arena_->allocate<hashjoin::Instruction>(
+      1, exec->deviceData.emplace_back());
+  auto* status = arena_->allocate<BlockStatus>(
+      numBlocks, exec->deviceData.emplace_back());
+  bzero(status, numBlocks * sizeof(BlockStatus));
+  // The key, the probe side inputs, the probe and build side results and the
+  // results in output order.
+  auto* operands = arena_->allocate<Operand>(
+      1 + 2 * numProbeColumns + numBuildColumns + numColumns,
+      exec->deviceData.emplace_back());
+  auto* probeTypes = arena_->allocate<PhysicalType>(
+      std::max(1, numProbeColumns), exec->deviceData.emplace_back());
+  auto* buildColumns = arena_->allocate<int32_t>(
+      std::max(1, numBuildColumns), exec->deviceData.emplace_back());
+  auto* numResults =
+      arena_->allocate<int32_t>(1, exec->deviceData.emplace_back());
+  *numResults = 0;
+
+  instruction->opCode = hashjoin::OpCode::kJoinRows;
+  auto& joinRows = instruction->_.joinRows;
+  joinRows.table = table_;
+  joinRows.probeKey = operands;
+  joinRows.numProbeColumns = numProbeColumns;
+  joinRows.probeTypes = probeTypes;
+  joinRows.probeInputs = operands + 1;
+  joinRows.probeResults = joinRows.probeInputs + numProbeColumns;
+  joinRows.numBuildColumns = numBuildColumns;
+  joinRows.buildColumns = buildColumns;
+  joinRows.buildResults = joinRows.probeResults + numProbeColumns;
+  joinRows.numResults = numResults;
+  input_->childAt(keyChannel_).toOperand(joinRows.probeKey);
+
+  exec->operands = joinRows.buildResults + numBuildColumns;
+  exec->outputOperands = outputIds_;
+  for (auto i = 0; i < numColumns; ++i) {
+    auto column = WaveVector::create(outputType_->childAt(i), *arena_);
+    column->resize(maxRows, true);
+    column->toOperand(&exec->operands[i]);
+    exec->output.push_back(std::move(column));
+  }
+  for (auto i = 0; i < numProbeColumns; ++i) {
+    auto [inputChannel, outputChannel] = probeProjections_[i];
+    probeTypes[i] = probeTypes_[i];
+    input_->childAt(inputChannel).toOperand(&joinRows.probeInputs[i]);
+    exec->output[outputChannel]->toOperand(&joinRows.probeResults[i]);
+  }
+  for (auto i = 0; i < numBuildColumns; ++i) {
+    auto [column, outputChannel] = buildProjections_[i];
+    buildColumns[i] = column;
+    exec->output[outputChannel]->toOperand(&joinRows.buildResults[i]);
+  }
+  for (auto i = 0; i < numBlocks; ++i) {
+    programs[i].numInstructions = 1;
+    programs[i].instructions = instruction;
+  }
+  // The probe batch is freed with the results.
+  exec->intermediates.push_back(std::move(input_));
+
+  // Gives the Wave operators after 'this' a row count to start from.
+  folly::Range<Executable**> empty(nullptr, nullptr);
+  waveStream.prepareProgramLaunch(
+      id_,
+      maxRows,
+      empty,
+      bits::roundUp(maxRows, kBlockSize) / kBlockSize,
+      true,
+      nullptr);
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        hashjoin::call(
+            *stream,
+            numBlocks,
+            programs,
+            nullptr,
+            status,
+            hashjoin::JoinRows::sharedSize());
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+}
+
+vector_size_t HashProbe::outputSize(WaveStream& stream) const {
+  vector_size_t size = 0;
+  outputIds_.forEach([&](int32_t id) {
+    auto* exe = stream.operandExecutable(id);
+    VELOX_CHECK_NOT_NULL(exe);
+    size = exe->output[exe->outputOperands.ordinal(id)]->size();
+  });
+  return size;
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <deque>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/Driver.h"
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Returns true if the HashBuild and HashProbe of 'node' can run on Wave.
+/// Both sides must decide the same way, so this depends on the plan only.
+bool isWaveHashJoin(const core::HashJoinNode& node);
+
+/// The hash table of a hash join, shared by the build and probe Drivers of
+/// a split group. The table is in an arena of its own so that it outlives
+/// the build Drivers. If the rows do not fit in
+/// FLAGS_velox_wave_hash_join_device_bytes they are placed in pinned host
+/// memory, which the probe kernels read over the interconnect.
+class WaveHashJoinBridge {
+ public:
+  /// Returns the bridge for the join 'joinNodeId' in the task and split
+  /// group of 'driverCtx'. The first caller creates it.
+  static std::shared_ptr<WaveHashJoinBridge> getInstance(
+      const exec::DriverCtx& driverCtx,
+      const core::PlanNodeId& joinNodeId);
+
+  /// Adds the build side batches of one build Driver. These must stay valid
+  /// until build() returns.
+  void addInput(std::vector<WaveVectorPtr> input);
+
+  /// Builds the table from the batches of all build Drivers. Called by the
+  /// last build Driver to finish.
+  void build(const RowType& buildType, int32_t keyChannel);
+
+  /// Returns the table if it is built. Otherwise returns nullptr and, if
+  /// 'future' is not nullptr, sets it to be realized when the table is
+  /// built.
+  hashjoin::HashTable* table(ContinueFuture* future);
+
+  /// True if the table rows are in host memory.
+  bool rowsInHostMemory() const {
+    return rowsInHostMemory_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<WaveVectorPtr> input_;
+  std::vector<ContinuePromise> promises_;
+  hashjoin::HashTable* table_{nullptr};
+  bool rowsInHostMemory_{false};
+
+  // Arena for the table and its buckets.
+  std::unique_ptr<GpuArena> arena_;
+  // Arena for the rows. In host memory if the rows are too large for the
+  // device.
+  std::unique_ptr<GpuArena> rowArena_;
+  std::vector<WaveBufferPtr> buffers_;
+};
+
+/// Wave replacement for exec::HashBuild of an inner join. Buffers the build
+/// side batches of the Driver. The last Driver to finish builds the table of
+/// all Drivers into WaveHashJoinBridge. The other Drivers wait for the table
+/// to be built so that their batches stay valid.
+class HashBuild : public WaveOperator {
+ public:
+  HashBuild(CompileState& state, const core::HashJoinNode& node);
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  void schedule(WaveStream&, int32_t) override {
+    VELOX_UNREACHABLE("HashBuild produces no output");
+  }
+
+  bool isFinished() const override {
+    return noMoreInput_ && !future_.valid();
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return 0;
+  }
+
+  std::string toString() const override {
+    return "HashBuild";
+  }
+
+ private:
+  const core::PlanNodeId joinNodeId_;
+  exec::DriverCtx* const driverCtx_;
+  const RowTypePtr buildType_;
+  int32_t keyChannel_;
+  std::shared_ptr<WaveHashJoinBridge> bridge_;
+  std::vector<WaveVectorPtr> buffered_;
+  bool noMoreInput_{false};
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+};
+
+/// Wave replacement for exec::HashProbe of an inner join. Waits for the
+/// table, then joins the buffered probe side batches one at a time: a first
+/// kernel counts the matches to size the result and a second one writes the
+/// result rows.
+class HashProbe : public WaveOperator {
+ public:
+  HashProbe(CompileState& state, const core::HashJoinNode& node);
+
+  ~HashProbe() override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override {
+    noMoreInput_ |= noMoreInput;
+  }
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  int32_t canAdvance() override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && buffered_.empty() && !input_;
+  }
+
+  vector_size_t outputSize(WaveStream& stream) const override;
+
+  std::string toString() const override {
+    return "HashProbe";
+  }
+
+ private:
+  // Returns the number of result rows for 'input_'.
+  int32_t countMatches();
+
+  GpuArena* arena_;
+  std::shared_ptr<WaveHashJoinBridge> bridge_;
+  hashjoin::HashTable* table_{nullptr};
+  int32_t keyChannel_;
+
+  // Probe side input channel and output channel of the probe side columns in
+  // the result.
+  std::vector<std::pair<int32_t, int32_t>> probeProjections_;
+  std::vector<PhysicalType> probeTypes_;
+  // Build side column and output channel of the build side columns in the
+  // result.
+  std::vector<std::pair<int32_t, int32_t>> buildProjections_;
+
+  std::deque<WaveVectorPtr> buffered_;
+  // The batch being joined.
+  WaveVectorPtr input_;
+  bool noMoreInput_{false};
+
+  std::unique_ptr<Stream> countStream_;
+  struct {
+    WaveBufferPtr programs;
+    WaveBufferPtr instructions;
+    WaveBufferPtr status;
+    WaveBufferPtr key;
+    WaveBufferPtr numMatches;
+  } countHolder_;
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+
+#include <cub/cub.cuh> // @manual
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/Hash.h"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+#define VELOX_WAVE_RETURN_NOT_OK(_expr)            \
+  if (auto _ec = (_expr); _ec != ErrorCode::kOk) { \
+    return _ec;                                    \
+  }
+
+#ifdef NDEBUG
+#define LOG_TYPE_DISPATCH_ERROR(_kind)
+#else
+#define LOG_TYPE_DISPATCH_ERROR(_kind) \
+  printf("%s:%d: Unsupported type %d\n", __FILE__, __LINE__, _kind)
+#endif
+
+#define KEY_TYPE_DISPATCH(_func, _kindExpr, ...) \
+  [&]() {                                        \
+    auto _kind = (_kindExpr);                    \
+    switch (_kind) {                             \
+      case PhysicalType::kInt32:                 \
+        return _func<int32_t>(__VA_ARGS__);      \
+      case PhysicalType::kInt64:                 \
+        return _func<int64_t>(__VA_ARGS__);      \
+      default:                                   \
+        LOG_TYPE_DISPATCH_ERROR(_kind);          \
+        return ErrorCode::kError;                \
+    };                                           \
+  }()
+
+#define FIXED_WIDTH_TYPE_DISPATCH(_func, _kindExpr, ...) \
+  [&]() {                                                \
+    auto _kind = (_kindExpr);                            \
+    switch (_kind) {                                     \
+      case PhysicalType::kInt8:                          \
+        return _func<int8_t>(__VA_ARGS__);               \
+      case PhysicalType::kInt16:                         \
+        return _func<int16_t>(__VA_ARGS__);              \
+      case PhysicalType::kInt32:                         \
+        return _func<int32_t>(__VA_ARGS__);              \
+      case PhysicalType::kInt64:                         \
+        return _func<int64_t>(__VA_ARGS__);              \
+      case PhysicalType::kFloat32:                       \
+        return _func<float>(__VA_ARGS__);                \
+      case PhysicalType::kFloat64:                       \
+        return _func<double>(__VA_ARGS__);               \
+      default:                                           \
+        LOG_TYPE_DISPATCH_ERROR(_kind);                  \
+        return ErrorCode::kError;                        \
+    };                                                   \
+  }()
+
+namespace facebook::velox::wave::hashjoin {
+
+namespace {
+
+struct BlockInfo {
+  int base;
+  char* shared;
+};
+
+__device__ inline int32_t rowIndex(Operand* op, int32_t row) {
+  if (auto indicesInOp = op->indices) {
+    if (auto indices = indicesInOp[0]) {
+      return indices[row];
+    }
+  }
+  return row;
+}
+
+__device__ inline bool isNullAt(Operand* op, int32_t row) {
+  return op->nulls && op->nulls[rowIndex(op, row)] == kNull;
+}
+
+template <typename T>
+__device__ ErrorCode
+copyValue(const void* from, int32_t fromRow, void* to, int32_t toRow) {
+  reinterpret_cast<T*>(to)[toRow] = reinterpret_cast<const T*>(from)[fromRow];
+  return ErrorCode::kOk;
+}
+
+template <typename T>
+__device__ ErrorCode insertRow(HashTable* table, int32_t row) {
+  auto key = reinterpret_cast<const T*>(table->columns[table->keyColumn])[row];
+  auto bucket = Hasher<T, uint32_t>()(key) & table->sizeMask;
+  table->next[row] = atomicExch(&table->heads[bucket], row);
+  return ErrorCode::kOk;
+}
+
+__device__ ErrorCode run(BlockInfo* block, BuildRows* buildRows) {
+  auto* table = buildRows->table;
+  int32_t row = block->base + threadIdx.x;
+  if (row >= buildRows->inputs[0].size) {
+    return ErrorCode::kOk;
+  }
+  int32_t tableRow = buildRows->firstRow + row;
+  for (int i = 0; i < table->numColumns; ++i) {
+    auto* input = &buildRows->inputs[i];
+    if (isNullAt(input, row)) {
+      table->nulls[i][tableRow] = kNull;
+      continue;
+    }
+    table->nulls[i][tableRow] = kNotNull;
+    VELOX_WAVE_RETURN_NOT_OK(FIXED_WIDTH_TYPE_DISPATCH(
+        copyValue,
+        table->columnTypes[i].kind,
+        input->base,
+        rowIndex(input, row),
+        table->columns[i],
+        tableRow));
+  }
+  if (table->nulls[table->keyColumn][tableRow] == kNull) {
+    // A null key never matches.
+    table->next[tableRow] = kNoRow;
+    return ErrorCode::kOk;
+  }
+  return KEY_TYPE_DISPATCH(
+      insertRow, table->columnTypes[table->keyColumn].kind, table, tableRow);
+}
+
+template <typename T>
+__device__ ErrorCode
+countRowMatches(HashTable* table, Operand* probeKey, int32_t row, int& count) {
+  auto key = value<T>(probeKey, row);
+  auto* keys = reinterpret_cast<const T*>(table->columns[table->keyColumn]);
+  auto bucket = Hasher<T, uint32_t>()(key) & table->sizeMask;
+  for (auto i = table->heads[bucket]; i != kNoRow; i = table->next[i]) {
+    count += keys[i] == key;
+  }
+  return ErrorCode::kOk;
+}
+
+// Sets 'count' to the number of matches of the row of the calling thread.
+__device__ ErrorCode countRowMatches(
+    BlockInfo* block,
+    HashTable* table,
+    Operand* probeKey,
+    int& count) {
+  count = 0;
+  int32_t row = block->base + threadIdx.x;
+  if (row >= probeKey->size || isNullAt(probeKey, row)) {
+    return ErrorCode::kOk;
+  }
+  return KEY_TYPE_DISPATCH(
+      countRowMatches,
+      table->columnTypes[table->keyColumn].kind,
+      table,
+      probeKey,
+      row,
+      count);
+}
+
+__device__ ErrorCode run(BlockInfo* block, CountMatches* countMatches) {
+  using Reduce = cub::BlockReduce<int, kBlockSize>;
+  auto* tmp = reinterpret_cast<Reduce::TempStorage*>(block->shared);
+  int count;
+  auto ec = countRowMatches(
+      block, countMatches->table, countMatches->probeKey, count);
+  // All threads must take part in the reduction.
+  auto total = Reduce(*tmp).Sum(count);
+  if (threadIdx.x == 0 && total > 0) {
+    atomicAdd(countMatches->numMatches, total);
+  }
+  __syncthreads();
+  return ec;
+}
+
+__device__ ErrorCode copyResult(
+    PhysicalType type,
+    Operand* result,
+    int32_t resultRow,
+    const void* from,
+    int32_t fromRow,
+    bool isNull) {
+  if (result->nulls) {
+    result->nulls[resultRow] = isNull ? kNull : kNotNull;
+  }
+  if (isNull) {
+    return ErrorCode::kOk;
+  }
+  return FIXED_WIDTH_TYPE_DISPATCH(
+      copyValue, type.kind, from, fromRow, result->base, resultRow);
+}
+
+template <typename T>
+__device__ ErrorCode joinRow(JoinRows* joinRows, int32_t row, int offset) {
+  auto* table = joinRows->table;
+  auto key = value<T>(joinRows->probeKey, row);
+  auto* keys = reinterpret_cast<const T*>(table->columns[table->keyColumn]);
+  auto bucket = Hasher<T, uint32_t>()(key) & table->sizeMask;
+  for (auto i = table->heads[bucket]; i != kNoRow; i = table->next[i]) {
+    if (keys[i] != key) {
+      continue;
+    }
+    for (int j = 0; j < joinRows->numProbeColumns; ++j) {
+      auto* input = &joinRows->probeInputs[j];
+      VELOX_WAVE_RETURN_NOT_OK(copyResult(
+          joinRows->probeTypes[j],
+          &joinRows->probeResults[j],
+          offset,
+          input->base,
+          rowIndex(input, row),
+          isNullAt(input, row)));
+    }
+    for (int j = 0; j < joinRows->numBuildColumns; ++j) {
+      auto column = joinRows->buildColumns[j];
+      VELOX_WAVE_RETURN_NOT_OK(copyResult(
+          table->columnTypes[column],
+          &joinRows->buildResults[j],
+          offset,
+          table->columns[column],
+          i,
+          table->nulls[column][i] == kNull));
+    }
+    ++offset;
+  }
+  return ErrorCode::kOk;
+}
+
+__device__ ErrorCode run(BlockInfo* block, JoinRows* joinRows) {
+  using Scan = cub::BlockScan<int, kBlockSize>;
+  auto* tmp = reinterpret_cast<Scan::TempStorage*>(block->shared);
+  int count;
+  auto ec =
+      countRowMatches(block, joinRows->table, joinRows->probeKey, count);
+  // The matches of the block are written after the ones of the blocks that
+  // got their space before.
+  int offset;
+  int total;
+  Scan(*tmp).ExclusiveSum(count, offset, total);
+  __syncthreads();
+  auto* blockOffset = reinterpret_cast<int*>(block->shared);
+  if (threadIdx.x == 0) {
+    *blockOffset = atomicAdd(joinRows->numResults, total);
+  }
+  __syncthreads();
+  offset += *blockOffset;
+  __syncthreads();
+  if (ec != ErrorCode::kOk || count == 0) {
+    return ec;
+  }
+  return KEY_TYPE_DISPATCH(
+      joinRow,
+      joinRows->table->columnTypes[joinRows->table->keyColumn].kind,
+      joinRows,
+      block->base + threadIdx.x,
+      offset);
+}
+
+__global__ void runPrograms(
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* blockStatusArray) {
+  extern __shared__ __align__(64) char shared[];
+  int baseIndex = baseIndices ? baseIndices[blockIdx.x] : 0;
+  BlockInfo block = {
+      .base = (int)(blockDim.x * (blockIdx.x - baseIndex)),
+      .shared = shared,
+  };
+  auto& status = blockStatusArray[blockIdx.x];
+  auto& program = programs[blockIdx.x];
+  assert(status.errors[threadIdx.x] == ErrorCode::kOk);
+  for (auto i = 0; i < program.numInstructions; ++i) {
+    auto& instruction = program.instructions[i];
+    // The probe instructions synchronize the threads of the block, so all
+    // threads run these even after an error.
+    ErrorCode ec;
+    switch (instruction.opCode) {
+      case OpCode::kBuildRows:
+        ec = run(&block, &instruction._.buildRows);
+        break;
+      case OpCode::kCountMatches:
+        ec = run(&block, &instruction._.countMatches);
+        break;
+      case OpCode::kJoinRows:
+        ec = run(&block, &instruction._.joinRows);
+        break;
+      default:
+#ifndef NDEBUG
+        printf(
+            "%s:%d: Unsupported OpCode %d\n",
+            __FILE__,
+            __LINE__,
+            instruction.opCode);
+#endif
+        ec = ErrorCode::kError;
+    }
+    if (status.errors[threadIdx.x] == ErrorCode::kOk) {
+      status.errors[threadIdx.x] = ec;
+    }
+  }
+  assert(status.errors[threadIdx.x] == ErrorCode::kOk);
+}
+
+} // namespace
+
+int CountMatches::sharedSize() {
+  return sizeof(cub::BlockReduce<int, kBlockSize>::TempStorage);
+}
+
+int JoinRows::sharedSize() {
+  return std::max<int>(
+      sizeof(cub::BlockScan<int, kBlockSize>::TempStorage), sizeof(int));
+}
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* status,
+    int sharedSize) {
+  runPrograms<<<numBlocks, kBlockSize, sharedSize, stream.stream()->stream>>>(
+      programs, baseIndices, status);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::hashjoin
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/exec/ErrorCode.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+namespace facebook::velox::wave::hashjoin {
+
+/// Marks the end of a chain of rows in HashTable.
+constexpr int32_t kNoRow = -1;
+
+/// Build side of a hash join. The rows are stored column by column. 'heads'
+/// has the first row of each bucket and 'next' has the next row in the same
+/// bucket for each row. Rows with a null key are stored but not in any
+/// bucket. The columns may be in host memory if the table does not fit on
+/// the device.
+struct HashTable {
+  int32_t sizeMask;
+  int32_t* heads;
+  int32_t* next;
+  int32_t numRows;
+  int32_t numColumns;
+  int32_t keyColumn;
+  PhysicalType* columnTypes;
+  void** columns;
+  // kNull or kNotNull for each row of each column.
+  uint8_t** nulls;
+};
+
+/// Copies a batch of build side rows into 'table' and links them into their
+/// buckets.
+struct BuildRows {
+  HashTable* table;
+  // One per column of 'table'.
+  Operand* inputs;
+  // Row number in 'table' of the first row of the batch.
+  int32_t firstRow;
+};
+
+/// Adds the number of rows of 'table' that match 'probeKey' to 'numMatches'.
+struct CountMatches {
+  HashTable* table;
+  Operand* probeKey;
+  int32_t* numMatches;
+  static int sharedSize();
+};
+
+/// Writes a result row for each match of 'probeKey' in 'table'. The probe
+/// side columns are copied from 'probeInputs' to 'probeResults' and the
+/// build side columns from the columns of 'table' given by 'buildColumns'
+/// to 'buildResults'. 'numResults' is the number of rows written so far.
+struct JoinRows {
+  HashTable* table;
+  Operand* probeKey;
+  int32_t numProbeColumns;
+  PhysicalType* probeTypes;
+  Operand* probeInputs;
+  Operand* probeResults;
+  int32_t numBuildColumns;
+  int32_t* buildColumns;
+  Operand* buildResults;
+  int32_t* numResults;
+  static int sharedSize();
+};
+
+enum class OpCode {
+  kBuildRows,
+  kCountMatches,
+  kJoinRows,
+};
+
+struct Instruction {
+  OpCode opCode;
+  union {
+    BuildRows buildRows;
+    CountMatches countMatches;
+    JoinRows joinRows;
+  } _;
+};
+
+struct ThreadBlockProgram {
+  int32_t numInstructions;
+  Instruction* instructions;
+};
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* status,
+    int sharedSize);
+
+} // namespace facebook::velox::wave::hashjoin
@@ -17,6 +17,7 @@
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashJoin.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/Values.h"
 #include "velox/experimental/wave/exec/WaveDriver.h"
@@ -24,6 +25,11 @@
 #include "velox/expression/FieldReference.h"
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
+DEFINE_int64(
+    velox_wave_staging_bytes,
+    8 << 20,
+    "Size of each pinned host buffer for staging copies to the device. 0 "
+    "copies through unified memory");
 
 namespace facebook::velox::wave {
 
@@ -279,6 +285,10 @@ bool CompileState::reserveMemory() {
   auto* allocator = getAllocator(getDevice());
   arena_ =
       std::make_unique<GpuArena>(FLAGS_velox_wave_arena_unit_size, allocator);
+  if (FLAGS_velox_wave_staging_bytes > 0) {
+    arena_->setHostStaging(std::make_unique<HostStaging>(
+        getHostAllocator(getDevice()), FLAGS_velox_wave_staging_bytes));
+  }
   return true;
 }
 
@@ -326,6 +336,23 @@ bool CompileState::addOperator(
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
+  } else if (name == "HashBuild" || name == "HashProbe") {
+    // HashBuild is the consumer of the build pipeline, not in 'planNodes'.
+    auto& planNode = nodeIndex < driverFactory_.planNodes.size()
+        ? driverFactory_.planNodes[nodeIndex]
+        : driverFactory_.consumerNode;
+    auto* node = dynamic_cast<const core::HashJoinNode*>(planNode.get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!isWaveHashJoin(*node) || !reserveMemory()) {
+      return false;
+    }
+    if (name == "HashBuild") {
+      operators_.push_back(std::make_unique<HashBuild>(*this, *node));
+      outputType = operators_.back()->outputType();
+    } else {
+      operators_.push_back(std::make_unique<HashProbe>(*this, *node));
+      outputType = node->outputType();
+    }
   } else {
     return false;
   }
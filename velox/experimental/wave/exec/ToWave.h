@@ -74,6 +74,10 @@ class CompileState {
     return *arena_;
   }
 
+  exec::DriverCtx* driverCtx() const {
+    return driver_.driverCtx();
+  }
+
  private:
   bool
   addOperator(exec::Operator* op, int32_t& nodeIndex, RowTypePtr& outputType);
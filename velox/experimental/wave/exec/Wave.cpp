@@ -128,13 +128,23 @@ void Executable::startTransfer(
   exe->deviceData.push_back(operands);
   exe->operands = operands->as<Operand>();
   exe->outputOperands = outputOperands;
-  copyData(exe->transfers);
+  // With staging, the copies are enqueued on the stream of the transfer, so
+  // that they overlap with kernels of other WaveStreams.
+  auto* staging = waveStream.arena().hostStaging();
+  if (!staging) {
+    copyData(exe->transfers);
+  }
   auto* device = waveStream.device();
   waveStream.installExecutables(
       folly::Range(&exe, 1),
       [&](Stream* stream, folly::Range<Executable**> executables) {
         for (auto& transfer : executables[0]->transfers) {
-          stream->prefetch(device, transfer.to, transfer.size);
+          if (staging) {
+            staging->copyToDevice(
+                transfer.to, transfer.from, transfer.size, *stream);
+          } else {
+            stream->prefetch(device, transfer.to, transfer.size);
+          }
         }
         waveStream.markLaunch(*stream, *executables[0]);
       });
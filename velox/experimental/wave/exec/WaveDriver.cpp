@@ -15,9 +15,16 @@
  */
 
 #include "velox/experimental/wave/exec/WaveDriver.h"
+#include "velox/common/time/Timer.h"
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    velox_wave_max_streams,
+    2,
+    "Maximum number of batches in flight in a Wave pipeline. With more than "
+    "one, the transfers of a batch overlap with the kernels of another");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -80,7 +87,7 @@ RowVectorPtr WaveDriver::getOutput() {
           VLOG(1) << "Final output size: " << result->size();
         }
         if (streamAtEnd(*stream)) {
-          it = streams.erase(it);
+          it = eraseStream(streams, it);
         } else {
           ++it;
         }
@@ -96,6 +103,16 @@ RowVectorPtr WaveDriver::getOutput() {
       running = true;
     }
     if (!running) {
+      for (auto& pipeline : pipelines_) {
+        for (auto& op : pipeline.operators) {
+          auto reason = op->isBlocked(&blockingFuture_);
+          if (reason != exec::BlockingReason::kNotBlocked) {
+            VLOG(1) << "Blocked on " << op->toString();
+            blockingReason_ = reason;
+            return nullptr;
+          }
+        }
+      }
       VLOG(1) << "No more output";
       finished_ = true;
       return nullptr;
@@ -148,6 +165,9 @@ RowVectorPtr WaveDriver::makeResult(
 void WaveDriver::startMore() {
   for (int i = 0; i < pipelines_.size(); ++i) {
     auto& ops = pipelines_[i].operators;
+    if (pipelines_[i].streams.size() >= FLAGS_velox_wave_max_streams) {
+      continue;
+    }
     if (auto rows = ops[0]->canAdvance()) {
       VLOG(1) << "Advance " << rows << " rows in pipeline " << i;
       auto stream = std::make_unique<WaveStream>(*arena_);
@@ -158,11 +178,61 @@ void WaveDriver::startMore() {
         prefetchReturn(*stream);
       }
       pipelines_[i].streams.push_back(std::move(stream));
+      if (numStreams_++ == 0) {
+        busyStartMicros_ = getCurrentTimeMicro();
+        if (firstStartMicros_ == 0) {
+          firstStartMicros_ = busyStartMicros_;
+        }
+      }
+      maxStreams_ = std::max(maxStreams_, numStreams_);
       break;
     }
   }
 }
 
+std::list<std::unique_ptr<WaveStream>>::iterator WaveDriver::eraseStream(
+    std::list<std::unique_ptr<WaveStream>>& streams,
+    std::list<std::unique_ptr<WaveStream>>::iterator it) {
+  if (--numStreams_ == 0) {
+    deviceBusyMicros_ += getCurrentTimeMicro() - busyStartMicros_;
+  }
+  return streams.erase(it);
+}
+
+void WaveDriver::close() {
+  updateStats();
+  exec::SourceOperator::close();
+}
+
+void WaveDriver::updateStats() {
+  if (firstStartMicros_ == 0) {
+    return;
+  }
+  auto now = getCurrentTimeMicro();
+  auto busyMicros = deviceBusyMicros_;
+  if (numStreams_ > 0) {
+    busyMicros += now - busyStartMicros_;
+  }
+  addRuntimeStat(
+      "waveDeviceBusyNanos",
+      RuntimeCounter(busyMicros * 1'000, RuntimeCounter::Unit::kNanos));
+  // Percentage of the time from the first batch to close during which some
+  // batch was pending on the device.
+  const auto wallMicros = std::max<uint64_t>(1, now - firstStartMicros_);
+  addRuntimeStat(
+      "waveDeviceBusyPct", RuntimeCounter(busyMicros * 100 / wallMicros));
+  addRuntimeStat("waveMaxStreams", RuntimeCounter(maxStreams_));
+  if (auto* staging = arena_->hostStaging()) {
+    addRuntimeStat(
+        "waveTransferNanos",
+        RuntimeCounter(
+            staging->transferNanos(), RuntimeCounter::Unit::kNanos));
+    addRuntimeStat(
+        "waveTransferBytes",
+        RuntimeCounter(staging->bytesCopied(), RuntimeCounter::Unit::kBytes));
+  }
+}
+
 void WaveDriver::prefetchReturn(WaveStream& stream) {
   // Schedule return buffers from last op to be on host side.
 }
@@ -179,7 +249,9 @@ LaunchControl* WaveDriver::inputControl(
     for (auto i = operatorId - 1; i >= 0; --i) {
       if (i == 0 || pipeline.operators[i]->isFilter() ||
           pipeline.operators[i]->isExpanding()) {
-        return stream.launchControls(i).back().get();
+        return stream.launchControls(pipeline.operators[i]->operatorId())
+            .back()
+            .get();
       }
     }
   }
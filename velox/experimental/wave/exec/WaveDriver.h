@@ -51,6 +51,8 @@ class WaveDriver : public exec::SourceOperator {
     return finished_;
   }
 
+  void close() override;
+
   void setReplaced(std::vector<std::unique_ptr<exec::Operator>> original) {
     cpuOperators_ = std::move(original);
   }
@@ -90,6 +92,14 @@ class WaveDriver : public exec::SourceOperator {
   // Enqueus a prefetch from device to host for the buffers of output vectors.
   void prefetchReturn(WaveStream& stream);
 
+  // Removes a finished WaveStream from 'streams'.
+  std::list<std::unique_ptr<WaveStream>>::iterator eraseStream(
+      std::list<std::unique_ptr<WaveStream>>& streams,
+      std::list<std::unique_ptr<WaveStream>>::iterator it);
+
+  // Adds the device busy time and transfer timings to the runtime stats.
+  void updateStats();
+
   std::unique_ptr<GpuArena> arena_;
 
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
@@ -111,6 +121,17 @@ class WaveDriver : public exec::SourceOperator {
 
   std::vector<Pipeline> pipelines_;
 
+  // Number of WaveStreams in all of 'pipelines_'.
+  int32_t numStreams_{0};
+  int32_t maxStreams_{0};
+
+  // Time when 'numStreams_' went from 0 to 1.
+  uint64_t busyStartMicros_{0};
+  // Time when the first WaveStream was started.
+  uint64_t firstStartMicros_{0};
+  // Time during which at least one WaveStream was pending on the device.
+  uint64_t deviceBusyMicros_{0};
+
   // The replaced Operators from the Driver. Can be used for a CPU fallback.
   std::vector<std::unique_ptr<exec::Operator>> cpuOperators_;
 
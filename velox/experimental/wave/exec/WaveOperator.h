@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/Driver.h"
 #include "velox/experimental/wave/exec/Wave.h"
 #include "velox/experimental/wave/vector/WaveVector.h"
 
@@ -84,6 +85,13 @@ class WaveOperator {
     VELOX_FAIL("Override for source or blocking operator");
   }
 
+  /// Called by WaveDriver when no operator has work. Returns the reason
+  /// 'this' can not make progress, e.g. waiting for a hash join table, and
+  /// sets 'future' to be realized when it can.
+  virtual exec::BlockingReason isBlocked(ContinueFuture* /*future*/) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+
   virtual std::string toString() const = 0;
 
   void definesSubfields(
@@ -21,6 +21,9 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/experimental/wave/exec/ToWave.h"
 
+DECLARE_int64(velox_wave_staging_bytes);
+DECLARE_int32(velox_wave_max_streams);
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
@@ -96,3 +99,53 @@ TEST_F(FilterProjectTest, project) {
 
   assertProject(vectors);
 }
+
+TEST_F(FilterProjectTest, pipelinedTransfers) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 20; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 1000, *pool_));
+    makeNotNull(vector, 1000000000);
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  auto waveStats = [](const std::shared_ptr<Task>& task) {
+    for (auto& pipeline : task->taskStats().pipelineStats) {
+      for (auto& op : pipeline.operatorStats) {
+        if (op.operatorType == "Wave") {
+          return op.runtimeStats;
+        }
+      }
+    }
+    VELOX_FAIL("No Wave operator");
+  };
+
+  SCOPE_EXIT {
+    FLAGS_velox_wave_staging_bytes = 8 << 20;
+    FLAGS_velox_wave_max_streams = 2;
+  };
+  // Staging buffers smaller than a column make a transfer wait for the
+  // previous copy from the same buffer.
+  for (auto stagingBytes : {0, 1000, 8 << 20}) {
+    for (auto maxStreams : {1, 3}) {
+      SCOPED_TRACE(fmt::format("{} {}", stagingBytes, maxStreams));
+      FLAGS_velox_wave_staging_bytes = stagingBytes;
+      FLAGS_velox_wave_max_streams = maxStreams;
+      auto plan = PlanBuilder()
+                      .values(vectors)
+                      .project({"c0", "c1", "c0 + c1"})
+                      .planNode();
+      auto task = assertQuery(plan, "SELECT c0, c1, c0 + c1 FROM tmp");
+      auto stats = waveStats(task);
+      ASSERT_LE(stats.at("waveMaxStreams").max, maxStreams);
+      ASSERT_EQ(1, stats.count("waveDeviceBusyNanos"));
+      if (stagingBytes == 0) {
+        ASSERT_EQ(0, stats.count("waveTransferBytes"));
+      } else {
+        ASSERT_LT(0, stats.at("waveTransferBytes").sum);
+        ASSERT_EQ(1, stats.count("waveTransferNanos"));
+      }
+    }
+  }
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cuda_runtime.h> // @manual
+#include <gflags/gflags.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+DECLARE_int64(velox_wave_hash_join_device_bytes);
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    OperatorTestBase::SetUp();
+  }
+
+  // Makes 'numBatches' probe side batches with columns c0 and c1 and build
+  // side batches with u0 and u1. Build side keys repeat so that a probe row
+  // matches several build rows. Every 97th probe and 31st build key is null.
+  template <typename T>
+  void makeData(int32_t numBatches) {
+    for (auto i = 0; i < numBatches; ++i) {
+      probe_.push_back(makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<T>(
+               1'000, [&](auto row) { return (i * 1'000 + row) % 500; },
+               nullEvery(97)),
+           makeFlatVector<int64_t>(
+               1'000, [&](auto row) { return i * 1'000 + row; })}));
+      build_.push_back(makeRowVector(
+          {"u0", "u1"},
+          {makeFlatVector<T>(
+               300, [&](auto row) { return (i * 300 + row) % 400; },
+               nullEvery(31)),
+           makeFlatVector<double>(
+               300, [&](auto row) { return (i * 300 + row) * 0.5; })}));
+    }
+    createDuckDbTable("t", probe_);
+    createDuckDbTable("u", build_);
+  }
+
+  core::PlanNodePtr makePlan(bool parallelBuild = false) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probe_)
+        .hashJoin(
+            {"c0"},
+            {"u0"},
+            PlanBuilder(planNodeIdGenerator)
+                .values(build_, parallelBuild)
+                .planNode(),
+            "",
+            {"c0", "c1", "u1"})
+        .planNode();
+  }
+
+  std::vector<RowVectorPtr> probe_;
+  std::vector<RowVectorPtr> build_;
+};
+
+TEST_F(HashJoinTest, bigintKey) {
+  makeData<int64_t>(10);
+  assertQuery(makePlan(), "SELECT c0, c1, u1 FROM t, u WHERE c0 = u0");
+}
+
+TEST_F(HashJoinTest, integerKey) {
+  makeData<int32_t>(10);
+  assertQuery(makePlan(), "SELECT c0, c1, u1 FROM t, u WHERE c0 = u0");
+}
+
+TEST_F(HashJoinTest, noMatch) {
+  probe_.push_back(makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>({1, 2, 3}),
+       makeFlatVector<int64_t>({1, 2, 3})}));
+  build_.push_back(makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>({4, 5}), makeFlatVector<double>({4, 5})}));
+  createDuckDbTable("t", probe_);
+  createDuckDbTable("u", build_);
+  assertQuery(makePlan(), "SELECT c0, c1, u1 FROM t, u WHERE c0 = u0");
+}
+
+TEST_F(HashJoinTest, multipleBuildDrivers) {
+  // Each build Driver produces all of 'build_'.
+  makeData<int64_t>(5);
+  AssertQueryBuilder(makePlan(true), duckDbQueryRunner_)
+      .maxDrivers(4)
+      .assertResults(
+          "SELECT c0, c1, u1 FROM t, "
+          "(SELECT * FROM u UNION ALL SELECT * FROM u "
+          "UNION ALL SELECT * FROM u UNION ALL SELECT * FROM u) v "
+          "WHERE c0 = v.u0");
+}
+
+TEST_F(HashJoinTest, rowsInHostMemory) {
+  gflags::FlagSaver saver;
+  FLAGS_velox_wave_hash_join_device_bytes = 0;
+  makeData<int64_t>(10);
+  assertQuery(makePlan(), "SELECT c0, c1, u1 FROM t, u WHERE c0 = u0");
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -332,9 +332,11 @@ void CastExpr::applyCastKernel(
   auto setError = [&](const std::string& details) {
     if (setNullInResultAtError()) {
       result->setNull(row, true);
-    } else {
+    } else if (context.captureErrorDetails()) {
       context.setVeloxExceptionError(
           row, makeBadCastException(result->type(), *input, row, details));
+    } else {
+      context.setStatus(row, Status::UserError("{}", details));
     }
   };
 
@@ -374,6 +376,25 @@ void CastExpr::applyCastKernel(
       }
     }
 
+    // Parsing strings to numbers and booleans reports errors without
+    // throwing since invalid strings are common under TRY and TRY_CAST.
+    if constexpr (
+        (FromKind == TypeKind::VARCHAR || FromKind == TypeKind::VARBINARY) &&
+        (ToKind == TypeKind::BOOLEAN || ToKind == TypeKind::TINYINT ||
+         ToKind == TypeKind::SMALLINT || ToKind == TypeKind::INTEGER ||
+         ToKind == TypeKind::BIGINT || ToKind == TypeKind::REAL ||
+         ToKind == TypeKind::DOUBLE)) {
+      typename TypeTraits<ToKind>::NativeType output;
+      const auto status = util::Converter<ToKind, void, TPolicy>::tryCast(
+          folly::StringPiece(inputRowValue), output);
+      if (!status.ok()) {
+        setError(status.message());
+        return;
+      }
+      result->set(row, output);
+      return;
+    }
+
     auto output = util::Converter<ToKind, void, TPolicy>::cast(inputRowValue);
 
     if constexpr (
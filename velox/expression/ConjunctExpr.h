@@ -64,6 +64,12 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  /// Returns the indices into inputs() in the order of evaluation. The order
+  /// is adapted after each batch if adaptive filter reordering is enabled.
+  const std::vector<int32_t>& inputOrder() const {
+    return inputOrder_;
+  }
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -206,6 +206,29 @@ void EvalCtx::setErrors(
       [&](auto row) { addError(row, veloxException, errors_); });
 }
 
+void EvalCtx::setStatus(vector_size_t index, const Status& status) {
+  VELOX_CHECK(!status.ok(), "Status must be an error");
+  if (!status.isUserError()) {
+    VELOX_FAIL("{}", status.message());
+  }
+  if (throwOnError_) {
+    VELOX_USER_FAIL("{}", status.message());
+  }
+  if (captureErrorDetails_) {
+    addError(
+        index,
+        std::make_exception_ptr(
+            VeloxUserError(std::current_exception(), status.message(), false)),
+        errors_);
+    return;
+  }
+  // The rows are only nulled out, so all share one exception.
+  static const std::exception_ptr kPlaceholder =
+      std::make_exception_ptr(VeloxUserError(
+          std::exception_ptr(), "Error details not captured", false));
+  addError(index, kPlaceholder, errors_);
+}
+
 void EvalCtx::addElementErrorsToTopLevel(
     const SelectivityVector& elementRows,
     const BufferPtr& elementToTopLevelRows,
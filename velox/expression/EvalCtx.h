@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <functional>
 
 #include "velox/common/base/Portability.h"
+#include "velox/common/base/Status.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
@@ -95,6 +97,13 @@ class EvalCtx {
       const SelectivityVector& rows,
       const std::exception_ptr& exceptionPtr);
 
+  /// Records a user error in 'status' for the row at 'index' without the
+  /// caller throwing. Throws if throwOnError() is true. Makes an exception
+  /// only if captureErrorDetails() is true, otherwise records a shared
+  /// placeholder that only marks the row as failed. 'status' must not be OK.
+  /// Errors other than user errors are thrown.
+  void setStatus(vector_size_t index, const Status& status);
+
   /// Invokes a function on each selected row. Records per-row exceptions by
   /// calling 'setError'. The function must take a single "row" argument of type
   /// vector_size_t and return void.
@@ -200,10 +209,32 @@ class EvalCtx {
     return &throwOnError_;
   }
 
+  /// True if the errors set by setStatus() must keep their messages. False
+  /// while evaluating under TRY without listeners, where a failed row only
+  /// becomes null.
+  bool captureErrorDetails() const {
+    return captureErrorDetails_ || throwOnError_;
+  }
+
+  bool* FOLLY_NONNULL mutableCaptureErrorDetails() {
+    return &captureErrorDetails_;
+  }
+
   bool nullsPruned() const {
     return nullsPruned_;
   }
 
+  /// Returns the entry for 'key' in a cache that lives as long as 'this',
+  /// i.e. for one batch of input. Lets functions share work that depends on
+  /// an input vector, e.g. an index over the keys of a map that is subscripted
+  /// by several expressions. 'tag' identifies the user so that different
+  /// users can key on the same vector. The entry is nullptr until set. The
+  /// entry must keep 'key' alive, e.g. by holding a VectorPtr, so that the
+  /// address is not reused for another vector.
+  std::shared_ptr<void>& batchCacheEntry(const void* tag, const void* key) {
+    return batchCache_[std::make_pair(tag, key)];
+  }
+
   bool* FOLLY_NONNULL mutableNullsPruned() {
     return &nullsPruned_;
   }
@@ -354,6 +385,7 @@ class EvalCtx {
   // behavior.
   bool nullsPruned_{false};
   bool throwOnError_{true};
+  bool captureErrorDetails_{true};
 
   // True if the current set of rows will not grow, e.g. not under and IF or OR.
   bool isFinalSelection_{true};
@@ -366,6 +398,12 @@ class EvalCtx {
   // in a opaque flat vector, which will translate to a
   // std::shared_ptr<std::exception_ptr>.
   ErrorVectorPtr errors_;
+
+  // See batchCacheEntry().
+  folly::F14FastMap<
+      std::pair<const void*, const void*>,
+      std::shared_ptr<void>>
+      batchCache_;
 };
 
 /// Utility wrapper struct that is used to temporarily reset the value of the
@@ -918,6 +918,7 @@ void Expr::evaluateSharedSubexpr(
     return;
   }
 
+  ++stats_.numSharedSubexprHits;
   if (rows.isSubset(*sharedSubexprRows)) {
     // We have results for all requested rows. No need to compute anything.
     context.moveOrCopyResult(sharedSubexprValues, rows, result);
@@ -1194,12 +1195,17 @@ void Expr::evalWithMemo(
     baseOfDictionaryRawPtr_ = base.get();
     context.releaseVector(baseOfDictionary_);
     context.releaseVector(dictionaryCache_);
-    evalWithNulls(rows, context, result);
-    return;
+    // A base that is known to be reused, e.g. a stripe dictionary, is cached
+    // on first use. Otherwise caching starts when the base repeats.
+    if (!base->memoOnFirstUse()) {
+      evalWithNulls(rows, context, result);
+      return;
+    }
+  } else {
+    ++baseOfDictionaryRepeats_;
   }
-  ++baseOfDictionaryRepeats_;
 
-  if (baseOfDictionaryRepeats_ == 1) {
+  if (baseOfDictionaryRepeats_ <= 1) {
     evalWithNulls(rows, context, result);
     baseOfDictionary_ = base;
     dictionaryCache_ = result;
@@ -1742,7 +1748,10 @@ ExprSet::ExprSet(
     core::ExecCtx* execCtx,
     bool enableConstantFolding)
     : execCtx_(execCtx) {
-  exprs_ = compileExpressions(sources, execCtx, this, enableConstantFolding);
+  {
+    CpuWallTimer timer(compileStats_.timing);
+    exprs_ = compileExpressions(sources, execCtx, this, enableConstantFolding);
+  }
   std::vector<FieldReference*> allDistinctFields;
   for (auto& expr : exprs_) {
     Expr::mergeFields(
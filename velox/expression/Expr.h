@@ -59,21 +59,46 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of evaluations of a common sub-expression which reused the cached
+  /// results of an earlier evaluation on the same input for all or some of
+  /// the rows, e.g. a projection reusing the results computed by a filter.
+  uint64_t numSharedSubexprHits{0};
+
+  /// Number of times an AND or OR changed the evaluation order of its inputs
+  /// based on their observed time per dropped row.
+  uint64_t numInputReorders{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numSharedSubexprHits += other.numSharedSubexprHits;
+    numInputReorders += other.numInputReorders;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numSharedSubexprHits: {}, numInputReorders: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numSharedSubexprHits,
+        numInputReorders);
   }
 };
 
+/// Statistics of compiling an ExprSet.
+struct ExprCompileStats {
+  CpuWallTiming timing;
+
+  /// Number of function calls resolved from ExprCompilationCache.
+  uint64_t numCacheHits{0};
+
+  /// Number of function calls resolved from the function registries.
+  uint64_t numCacheMisses{0};
+};
+
 /// Maintains a set of rows for evaluation and removes rows with
 /// nulls or errors as needed. Helps to avoid copying SelectivityVector in cases
 /// when evaluation doesn't encounter nulls or errors.
@@ -731,6 +756,14 @@ class ExprSet {
   /// evaluated.
   std::unordered_map<std::string, exec::ExprStats> stats() const;
 
+  const ExprCompileStats& compileStats() const {
+    return compileStats_;
+  }
+
+  ExprCompileStats& mutableCompileStats() {
+    return compileStats_;
+  }
+
  protected:
   void clearSharedSubexprs();
 
@@ -749,6 +782,8 @@ class ExprSet {
   // Exprs which retain memoized state, e.g. from running over dictionaries.
   std::unordered_set<Expr*> memoizingExprs_;
   core::ExecCtx* FOLLY_NONNULL const execCtx_;
+
+  ExprCompileStats compileStats_;
 };
 
 class ExprSetSimplified : public ExprSet {
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprCompilationCache.h"
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::exec {
+
+std::shared_ptr<VectorFunction> ResolvedFunction::createVectorFunction(
+    const std::vector<TypePtr>& inputTypes,
+    const std::vector<VectorPtr>& constantInputs,
+    const core::QueryConfig& config) const {
+  if (simpleFunction.has_value()) {
+    return simpleFunction->createFunction()->createVectorFunction(
+        constantInputs, config);
+  }
+  std::vector<VectorFunctionArg> inputArgs;
+  inputArgs.reserve(inputTypes.size());
+  for (auto i = 0; i < inputTypes.size(); ++i) {
+    inputArgs.push_back({
+        inputTypes[i],
+        constantInputs.size() > i ? constantInputs[i] : nullptr,
+    });
+  }
+  return vectorFunctionFactory(name, inputArgs, config);
+}
+
+bool ExprCompilationCache::Key::operator==(const Key& other) const {
+  if (name != other.name || inputTypes.size() != other.inputTypes.size()) {
+    return false;
+  }
+  for (auto i = 0; i < inputTypes.size(); ++i) {
+    if (*inputTypes[i] != *other.inputTypes[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t ExprCompilationCache::KeyHasher::operator()(const Key& key) const {
+  auto hash = std::hash<std::string>()(key.name);
+  for (const auto& type : key.inputTypes) {
+    hash = bits::hashMix(hash, type->hashKind());
+  }
+  return hash;
+}
+
+// static
+ExprCompilationCache& ExprCompilationCache::instance() {
+  static ExprCompilationCache cache;
+  return cache;
+}
+
+std::shared_ptr<const ResolvedFunction> ExprCompilationCache::resolve(
+    const std::string& name,
+    const std::vector<TypePtr>& inputTypes,
+    bool& hit) {
+  Key key{name, inputTypes};
+  {
+    auto entries = entries_.rlock();
+    auto it = entries->find(key);
+    if (it != entries->end()) {
+      hit = true;
+      return it->second;
+    }
+  }
+  hit = false;
+  auto resolved = resolveUncached(name, inputTypes);
+  if (resolved) {
+    auto entries = entries_.wlock();
+    if (entries->size() >= kMaxEntries) {
+      entries->clear();
+    }
+    entries->emplace(std::move(key), resolved);
+  }
+  return resolved;
+}
+
+void ExprCompilationCache::clear() {
+  entries_.wlock()->clear();
+}
+
+// static
+std::shared_ptr<const ResolvedFunction> ExprCompilationCache::resolveUncached(
+    const std::string& name,
+    const std::vector<TypePtr>& inputTypes) {
+  auto resolved = std::make_shared<ResolvedFunction>();
+  resolved->name = sanitizeName(name);
+  if (resolveVectorFunction(resolved->name, inputTypes)) {
+    vectorFunctionFactories().withRLock([&](auto& functionMap) {
+      auto it = functionMap.find(resolved->name);
+      if (it != functionMap.end()) {
+        resolved->vectorFunctionFactory = it->second.factory;
+      }
+    });
+    if (resolved->vectorFunctionFactory) {
+      return resolved;
+    }
+  }
+  if (auto simpleFunction =
+          simpleFunctions().resolveFunction(name, inputTypes)) {
+    resolved->simpleFunction.emplace(simpleFunction->functionEntry());
+    resolved->simpleFunctionType = simpleFunction->type();
+    return resolved;
+  }
+  return nullptr;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/SimpleFunctionRegistry.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::exec {
+
+/// A function call resolved to a vector function factory or a simple
+/// function. Instantiated for each Expr with the constant inputs and config
+/// of the Expr.
+struct ResolvedFunction {
+  /// Sanitized name of the function.
+  std::string name;
+
+  /// Set if the call resolves to a vector function.
+  VectorFunctionFactory vectorFunctionFactory;
+
+  /// Set if the call resolves to a simple function.
+  std::optional<FunctionEntry> simpleFunction;
+
+  /// Return type of the simple function.
+  TypePtr simpleFunctionType;
+
+  std::shared_ptr<VectorFunction> createVectorFunction(
+      const std::vector<TypePtr>& inputTypes,
+      const std::vector<VectorPtr>& constantInputs,
+      const core::QueryConfig& config) const;
+};
+
+/// Process-wide cache of function resolutions for compiling expressions. A
+/// call of a function with given argument types resolves to the same
+/// function for all tasks and queries, so that the signature binding against
+/// all the signatures of the function is done once per process. The cache is
+/// cleared when a function is registered. Enabled by
+/// QueryConfig::exprCompilationCacheEnabled().
+class ExprCompilationCache {
+ public:
+  static constexpr int32_t kMaxEntries = 100'000;
+
+  static ExprCompilationCache& instance();
+
+  /// Returns the resolution of a call of 'name' with 'inputTypes' or nullptr
+  /// if there is no such function. Sets 'hit' to true if the resolution was
+  /// cached.
+  std::shared_ptr<const ResolvedFunction> resolve(
+      const std::string& name,
+      const std::vector<TypePtr>& inputTypes,
+      bool& hit);
+
+  void clear();
+
+  int32_t size() const {
+    return entries_.rlock()->size();
+  }
+
+ private:
+  struct Key {
+    std::string name;
+    std::vector<TypePtr> inputTypes;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  // Resolves a call without the cache.
+  static std::shared_ptr<const ResolvedFunction> resolveUncached(
+      const std::string& name,
+      const std::vector<TypePtr>& inputTypes);
+
+  using EntryMap = folly::
+      F14FastMap<Key, std::shared_ptr<const ResolvedFunction>, KeyHasher>;
+
+  folly::Synchronized<EntryMap> entries_;
+};
+
+} // namespace facebook::velox::exec
@@ -20,7 +20,9 @@
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ExprCompilationCache.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -331,6 +333,123 @@ ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
   return expr;
 }
 
+// Returns the value of 'expr' if it is a constant boolean. std::nullopt if
+// 'expr' is not constant. 'isNull' is set if the constant is null.
+std::optional<bool> constantBoolean(const ExprPtr& expr, bool& isNull) {
+  auto* constant = expr->as<ConstantExpr>();
+  if (constant == nullptr || constant->type()->kind() != TypeKind::BOOLEAN) {
+    return std::nullopt;
+  }
+  const auto& value = constant->value();
+  isNull = value->isNullAt(0);
+  return isNull ? false : value->as<SimpleVector<bool>>()->valueAt(0);
+}
+
+// Partially evaluates 'and' and 'or' over constant inputs: a false input of
+// 'and' (true of 'or') decides the result and a true input of 'and' (false of
+// 'or') has no effect. Null constants are kept. Returns nullptr if 'expr'
+// does not change.
+ExprPtr trySimplifyConjunct(
+    const ExprPtr& expr,
+    const core::QueryConfig& config,
+    memory::MemoryPool* pool) {
+  const bool isAnd = expr->name() == kAnd;
+  std::vector<ExprPtr> inputs;
+  for (const auto& input : expr->inputs()) {
+    bool isNull = false;
+    const auto value = constantBoolean(input, isNull);
+    if (!value.has_value() || isNull) {
+      inputs.push_back(input);
+    } else if (value.value() != isAnd) {
+      return std::make_shared<ConstantExpr>(
+          BaseVector::createConstant(BOOLEAN(), !isAnd, 1, pool));
+    }
+  }
+  if (inputs.size() == expr->inputs().size()) {
+    return nullptr;
+  }
+  if (inputs.empty()) {
+    return std::make_shared<ConstantExpr>(
+        BaseVector::createConstant(BOOLEAN(), isAnd, 1, pool));
+  }
+  if (inputs.size() == 1) {
+    return inputs[0];
+  }
+  return getSpecialForm(
+      config,
+      expr->name(),
+      expr->type(),
+      std::move(inputs),
+      config.exprTrackCpuUsage());
+}
+
+// Drops the cases of a 'switch' whose condition is a false or null constant.
+// A case with a true constant condition becomes the else clause. Returns
+// nullptr if 'expr' does not change.
+ExprPtr trySimplifySwitch(
+    const ExprPtr& expr,
+    const core::QueryConfig& config,
+    memory::MemoryPool* pool) {
+  const auto& oldInputs = expr->inputs();
+  const auto numCases = oldInputs.size() / 2;
+  std::vector<ExprPtr> inputs;
+  ExprPtr elseClause = oldInputs.size() % 2 ? oldInputs.back() : nullptr;
+  for (auto i = 0; i < numCases; ++i) {
+    bool isNull = false;
+    const auto value = constantBoolean(oldInputs[2 * i], isNull);
+    if (!value.has_value()) {
+      inputs.push_back(oldInputs[2 * i]);
+      inputs.push_back(oldInputs[2 * i + 1]);
+    } else if (value.value()) {
+      elseClause = oldInputs[2 * i + 1];
+      break;
+    }
+  }
+  if (elseClause != nullptr && *elseClause->type() != *expr->type()) {
+    return nullptr;
+  }
+  if (inputs.empty()) {
+    return elseClause != nullptr
+        ? elseClause
+        : std::make_shared<ConstantExpr>(
+              BaseVector::createNullConstant(expr->type(), 1, pool));
+  }
+  if (elseClause != nullptr) {
+    inputs.push_back(elseClause);
+  }
+  if (inputs.size() == oldInputs.size()) {
+    return nullptr;
+  }
+  return getSpecialForm(
+      config,
+      expr->name(),
+      expr->type(),
+      std::move(inputs),
+      config.exprTrackCpuUsage());
+}
+
+// Partially evaluates a special form with some constant inputs. Returns
+// 'expr' if it can not be simplified.
+ExprPtr trySimplifySpecialForm(
+    const ExprPtr& expr,
+    const core::QueryConfig& config,
+    memory::MemoryPool* pool) {
+  if (!expr->isSpecialForm()) {
+    return expr;
+  }
+  ExprPtr simplified;
+  if (expr->name() == kAnd || expr->name() == kOr) {
+    simplified = trySimplifyConjunct(expr, config, pool);
+  } else if (expr->name() == "switch") {
+    simplified = trySimplifySwitch(expr, config, pool);
+  }
+  if (simplified == nullptr) {
+    return expr;
+  }
+  simplified->computeMetadata();
+  return simplified;
+}
+
 /// Returns a vector aligned with exprs vector where elements that correspond to
 /// constant expressions are set to constant values of these expressions.
 /// Elements that correspond to non-constant expressions are set to null.
@@ -347,6 +466,63 @@ std::vector<VectorPtr> getConstantInputs(const std::vector<ExprPtr>& exprs) {
   return constants;
 }
 
+void checkSimpleFunctionType(
+    const std::string& name,
+    const std::vector<TypePtr>& inputTypes,
+    const TypePtr& resultType,
+    const TypePtr& functionType) {
+  VELOX_USER_CHECK(
+      resultType->equivalent(*functionType),
+      "Found incompatible return types for '{}' ({} vs. {}) "
+      "for input types ({}).",
+      name,
+      functionType,
+      resultType,
+      folly::join(", ", inputTypes));
+}
+
+// Returns the vector function or simple function for a call of 'name' with
+// 'inputTypes', nullptr if there is no such function.
+std::shared_ptr<VectorFunction> getFunction(
+    const std::string& name,
+    const std::vector<TypePtr>& inputTypes,
+    const TypePtr& resultType,
+    const std::vector<VectorPtr>& constantInputs,
+    const core::QueryConfig& config,
+    ExprSet& exprSet) {
+  if (!config.exprCompilationCacheEnabled()) {
+    if (auto func =
+            getVectorFunction(name, inputTypes, constantInputs, config)) {
+      return func;
+    }
+    if (auto simpleFunctionEntry =
+            simpleFunctions().resolveFunction(name, inputTypes)) {
+      checkSimpleFunctionType(
+          name, inputTypes, resultType, simpleFunctionEntry->type());
+      return simpleFunctionEntry->createFunction()->createVectorFunction(
+          constantInputs, config);
+    }
+    return nullptr;
+  }
+  bool hit;
+  auto resolved =
+      ExprCompilationCache::instance().resolve(name, inputTypes, hit);
+  auto& stats = exprSet.mutableCompileStats();
+  if (hit) {
+    ++stats.numCacheHits;
+  } else {
+    ++stats.numCacheMisses;
+  }
+  if (!resolved) {
+    return nullptr;
+  }
+  if (resolved->simpleFunction.has_value()) {
+    checkSimpleFunctionType(
+        name, inputTypes, resultType, resolved->simpleFunctionType);
+  }
+  return resolved->createVectorFunction(inputTypes, constantInputs, config);
+}
+
 core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   for (auto& rewrite : expressionRewrites()) {
     if (auto rewritten = rewrite(expr)) {
@@ -412,34 +588,17 @@ ExprPtr compileRewrittenExpression(
             trackCpuUsage)) {
       result = specialForm;
     } else if (
-        auto func = getVectorFunction(
+        auto func = getFunction(
             call->name(),
             inputTypes,
+            resultType,
             getConstantInputs(compiledInputs),
-            config)) {
-      result = std::make_shared<Expr>(
-          resultType,
-          std::move(compiledInputs),
-          func,
-          call->name(),
-          trackCpuUsage);
-    } else if (
-        auto simpleFunctionEntry =
-            simpleFunctions().resolveFunction(call->name(), inputTypes)) {
-      VELOX_USER_CHECK(
-          resultType->equivalent(*simpleFunctionEntry->type().get()),
-          "Found incompatible return types for '{}' ({} vs. {}) "
-          "for input types ({}).",
-          call->name(),
-          simpleFunctionEntry->type(),
-          resultType,
-          folly::join(", ", inputTypes));
-      auto func_2 = simpleFunctionEntry->createFunction()->createVectorFunction(
-          getConstantInputs(compiledInputs), config);
+            config,
+            *scope->exprSet)) {
       result = std::make_shared<Expr>(
           resultType,
           std::move(compiledInputs),
-          std::move(func_2),
+          std::move(func),
           call->name(),
           trackCpuUsage);
     } else {
@@ -512,9 +671,16 @@ ExprPtr compileRewrittenExpression(
   result->computeMetadata();
 
   // If the expression is constant folding it is redundant.
-  auto folded = enableConstantFolding && !isConstantExpr
-      ? tryFoldIfConstant(result, scope)
-      : result;
+  auto folded = result;
+  if (enableConstantFolding && !isConstantExpr) {
+    folded = tryFoldIfConstant(
+        trySimplifySpecialForm(result, config, pool), scope);
+  }
+  if (config.exprFusionEnabled() && !folded->isSpecialForm()) {
+    if (auto fused = FusedExpr::tryFuse(folded)) {
+      folded = fused;
+    }
+  }
   scope->visited[expr.get()] = folded;
   return folded;
 }
@@ -586,11 +752,17 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  auto rewritten = sources;
+  for (auto& rewrite : exprSetRewrites()) {
+    rewritten = rewrite(rewritten);
+    VELOX_CHECK_EQ(rewritten.size(), sources.size());
+  }
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(rewritten);
 
-  for (auto& source : sources) {
+  for (auto& source : rewritten) {
     exprs.push_back(compileExpression(
         source,
         &scope,
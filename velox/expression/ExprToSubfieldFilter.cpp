@@ -16,6 +16,8 @@
 
 #include "velox/expression/ExprToSubfieldFilter.h"
 
+#include <folly/container/F14Set.h>
+
 #include "velox/expression/Expr.h"
 
 using namespace facebook::velox;
@@ -453,6 +455,257 @@ std::unique_ptr<common::Filter> makeBetweenFilter(
   }
 }
 
+// Returns the name of the comparison that gives the same result as 'name'
+// with its arguments swapped. nullptr if 'name' is not a comparison.
+const char* mirroredComparison(const std::string& name) {
+  if (name == "eq" || name == "neq" || name == "distinct_from") {
+    return name.c_str();
+  }
+  if (name == "lt") {
+    return "gt";
+  }
+  if (name == "lte") {
+    return "gte";
+  }
+  if (name == "gt") {
+    return "lt";
+  }
+  if (name == "gte") {
+    return "lte";
+  }
+  return nullptr;
+}
+
+std::unique_ptr<common::Filter> makeDistinctFromFilter(
+    const core::TypedExprPtr& valueExpr,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  auto value = toConstant(valueExpr, evaluator);
+  if (!value) {
+    return nullptr;
+  }
+  if (value->isNullAt(0)) {
+    if (negated) {
+      return isNull();
+    }
+    return isNotNull();
+  }
+  if (negated) {
+    return makeEqualFilter(valueExpr, evaluator);
+  }
+  // Nulls are distinct from any value.
+  auto filter = makeNotEqualFilter(valueExpr, evaluator);
+  return filter ? filter->clone(true) : nullptr;
+}
+
+// Returns a filter that passes the strings that start with 'prefix'.
+std::unique_ptr<common::Filter> makePrefixFilter(const std::string& prefix) {
+  if (prefix.empty()) {
+    return isNotNull();
+  }
+  // The smallest string greater than all strings that start with 'prefix'.
+  auto upper = prefix;
+  while (!upper.empty() && static_cast<uint8_t>(upper.back()) == 0xff) {
+    upper.pop_back();
+  }
+  if (upper.empty()) {
+    return greaterThanOrEqual(prefix);
+  }
+  upper.back() = static_cast<char>(static_cast<uint8_t>(upper.back()) + 1);
+  return std::make_unique<common::BytesRange>(
+      prefix, false, false, upper, false, true, false);
+}
+
+// Converts 'like' with a pattern that has no wildcards or only trailing %'s.
+std::unique_ptr<common::Filter> makeLikeFilter(
+    const core::TypedExprPtr& patternExpr,
+    core::ExpressionEvaluator* evaluator) {
+  auto value = toConstant(patternExpr, evaluator);
+  if (!value || value->typeKind() != TypeKind::VARCHAR || value->isNullAt(0)) {
+    return nullptr;
+  }
+  const auto pattern = singleValue<StringView>(value).str();
+  const auto wildcard = pattern.find_first_of("%_");
+  if (wildcard == std::string::npos) {
+    return equal(pattern);
+  }
+  if (pattern.find_first_not_of('%', wildcard) != std::string::npos) {
+    return nullptr;
+  }
+  return makePrefixFilter(pattern.substr(0, wildcard));
+}
+
+// Adds the ranges of 'filter' to 'ranges'. Returns false if 'filter' is not a
+// BigintRange or BigintMultiRange.
+bool addBigintRanges(
+    const common::Filter& filter,
+    std::vector<std::unique_ptr<common::BigintRange>>& ranges) {
+  if (auto* range = dynamic_cast<const common::BigintRange*>(&filter)) {
+    ranges.push_back(asUniquePtr<common::BigintRange>(range->clone()));
+    return true;
+  }
+  if (auto* multiRange =
+          dynamic_cast<const common::BigintMultiRange*>(&filter)) {
+    for (const auto& range : multiRange->ranges()) {
+      ranges.push_back(asUniquePtr<common::BigintRange>(range->clone()));
+    }
+    return true;
+  }
+  return false;
+}
+
+// Returns the union of 'ranges'. Overlapping and adjacent ranges are merged.
+std::unique_ptr<common::Filter> bigintUnion(
+    std::vector<std::unique_ptr<common::BigintRange>> ranges,
+    bool nullAllowed) {
+  std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+    return a->lower() < b->lower();
+  });
+  std::vector<std::unique_ptr<common::BigintRange>> merged;
+  for (const auto& range : ranges) {
+    if (!merged.empty() &&
+        (merged.back()->upper() == std::numeric_limits<int64_t>::max() ||
+         range->lower() <= merged.back()->upper() + 1)) {
+      if (range->upper() > merged.back()->upper()) {
+        merged.back() = std::make_unique<common::BigintRange>(
+            merged.back()->lower(), range->upper(), false);
+      }
+      continue;
+    }
+    merged.push_back(std::make_unique<common::BigintRange>(
+        range->lower(), range->upper(), false));
+  }
+  if (merged.size() == 1) {
+    return merged[0]->clone(nullAllowed);
+  }
+  return std::make_unique<common::BigintMultiRange>(
+      std::move(merged), nullAllowed);
+}
+
+// True if 'filter' can be a part of a MultiRange.
+bool isMultiRangeCompatible(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kDoubleRange:
+    case common::FilterKind::kFloatRange:
+    case common::FilterKind::kBytesRange:
+    case common::FilterKind::kBytesValues:
+    case common::FilterKind::kTimestampRange:
+    case common::FilterKind::kMultiRange:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// True if 'filter' passes NaN. A MultiRange decides on NaN without testing
+// its filters.
+bool allowsNaN(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kDoubleRange:
+    case common::FilterKind::kMultiRange:
+      return filter.testDouble(std::numeric_limits<double>::quiet_NaN());
+    case common::FilterKind::kFloatRange:
+      return filter.testFloat(std::numeric_limits<float>::quiet_NaN());
+    default:
+      return false;
+  }
+}
+
+// Returns the filter that passes the values that pass 'a' or 'b', or nullptr
+// if the union can not be represented.
+std::unique_ptr<common::Filter> makeUnionFilter(
+    std::unique_ptr<common::Filter> a,
+    std::unique_ptr<common::Filter> b) {
+  if (a->kind() == common::FilterKind::kIsNull) {
+    return b->clone(true);
+  }
+  if (b->kind() == common::FilterKind::kIsNull) {
+    return a->clone(true);
+  }
+  const bool nullAllowed = a->testNull() || b->testNull();
+  std::vector<std::unique_ptr<common::BigintRange>> ranges;
+  if (addBigintRanges(*a, ranges) && addBigintRanges(*b, ranges)) {
+    return bigintUnion(std::move(ranges), nullAllowed);
+  }
+  if (!isMultiRangeCompatible(*a) || !isMultiRangeCompatible(*b)) {
+    return nullptr;
+  }
+  const bool nanAllowed = allowsNaN(*a) || allowsNaN(*b);
+  return orFilter(std::move(a), std::move(b), nullAllowed, nanAllowed);
+}
+
+// Converts an 'or' (an 'and' if 'negated') whose inputs are filters on the
+// same subfield.
+std::unique_ptr<common::Filter> makeDisjunctionFilter(
+    const core::CallTypedExpr& call,
+    common::Subfield& subfield,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  std::unique_ptr<common::Filter> result;
+  for (const auto& input : call.inputs()) {
+    auto* inputCall = asCall(input.get());
+    if (!inputCall) {
+      return nullptr;
+    }
+    common::Subfield inputSubfield;
+    auto filter =
+        leafCallToSubfieldFilter(*inputCall, inputSubfield, evaluator, negated);
+    if (!filter) {
+      return nullptr;
+    }
+    if (!result) {
+      result = std::move(filter);
+      subfield = std::move(inputSubfield);
+      continue;
+    }
+    if (!(inputSubfield == subfield)) {
+      return nullptr;
+    }
+    result = makeUnionFilter(std::move(result), std::move(filter));
+    if (!result) {
+      return nullptr;
+    }
+  }
+  return result;
+}
+
+// Converts a comparison of coalesce(field, constant) with a constant to the
+// filter of the comparison of the field. The filter passes nulls if the
+// comparison is true for the constant.
+std::unique_ptr<common::Filter> makeCoalesceFilter(
+    const core::CallTypedExpr& call,
+    const core::CallTypedExpr& coalesce,
+    common::Subfield& subfield,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  static const folly::F14FastSet<std::string> kSupported = {
+      "eq", "neq", "lt", "lte", "gt", "gte", "between", "in"};
+  if (coalesce.inputs().size() != 2 || kSupported.count(call.name()) == 0 ||
+      !toSubfield(coalesce.inputs()[0].get(), subfield)) {
+    return nullptr;
+  }
+  auto inputs = call.inputs();
+  inputs[0] = coalesce.inputs()[0];
+  auto filter = leafCallToSubfieldFilter(
+      core::CallTypedExpr(call.type(), inputs, call.name()),
+      subfield,
+      evaluator,
+      negated);
+  if (!filter) {
+    return nullptr;
+  }
+  inputs[0] = coalesce.inputs()[1];
+  auto nullResult = toConstant(
+      std::make_shared<core::CallTypedExpr>(call.type(), inputs, call.name()),
+      evaluator);
+  if (!nullResult) {
+    return nullptr;
+  }
+  const bool passesNull =
+      !nullResult->isNullAt(0) && singleValue<bool>(nullResult) != negated;
+  return filter->clone(passesNull);
+}
+
 } // namespace
 
 std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
@@ -464,8 +717,37 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     return nullptr;
   }
 
+  if (call.name() == "not") {
+    if (auto* inner = asCall(call.inputs()[0].get())) {
+      return leafCallToSubfieldFilter(*inner, subfield, evaluator, !negated);
+    }
+    return nullptr;
+  }
+  if ((call.name() == "or" && !negated) || (call.name() == "and" && negated)) {
+    return makeDisjunctionFilter(call, subfield, evaluator, negated);
+  }
+
   const auto* leftSide = call.inputs()[0].get();
 
+  // A comparison of a constant with a field, e.g. 'date_add(...) < ds', is
+  // converted as the mirrored comparison of the field with the constant.
+  if (call.inputs().size() == 2 && !toSubfield(leftSide, subfield) &&
+      toSubfield(call.inputs()[1].get(), subfield)) {
+    if (auto* mirrored = mirroredComparison(call.name())) {
+      core::CallTypedExpr mirroredCall(
+          call.type(), {call.inputs()[1], call.inputs()[0]}, mirrored);
+      return leafCallToSubfieldFilter(
+          mirroredCall, subfield, evaluator, negated);
+    }
+    return nullptr;
+  }
+
+  if (auto* coalesce = asCall(leftSide)) {
+    if (coalesce->name() == "coalesce") {
+      return makeCoalesceFilter(call, *coalesce, subfield, evaluator, negated);
+    }
+  }
+
   if (call.name() == "eq") {
     if (toSubfield(leftSide, subfield)) {
       return negated ? makeNotEqualFilter(call.inputs()[1], evaluator)
@@ -506,6 +788,15 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     if (toSubfield(leftSide, subfield)) {
       return makeInFilter(call.inputs()[1], evaluator, negated);
     }
+  } else if (call.name() == "distinct_from") {
+    if (toSubfield(leftSide, subfield)) {
+      return makeDistinctFromFilter(call.inputs()[1], evaluator, negated);
+    }
+  } else if (call.name() == "like") {
+    if (call.inputs().size() == 2 && !negated &&
+        toSubfield(leftSide, subfield)) {
+      return makeLikeFilter(call.inputs()[1], evaluator);
+    }
   } else if (call.name() == "is_null") {
     if (toSubfield(leftSide, subfield)) {
       if (negated) {
@@ -376,10 +376,13 @@ std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
     core::ExpressionEvaluator*);
 
 /// Convert a leaf call expression (no conjunction like AND/OR) to subfield and
-/// filter.  Return nullptr if not supported for pushdown.  This is needed
-/// because this conversion is frequently applied when extracting filters from
-/// remaining filter in readers.  Frequent throw clutters logs and slows down
-/// execution.
+/// filter. An OR (AND if 'negated') of calls on the same subfield is converted
+/// to the union of their filters. Besides comparisons, IN, BETWEEN and IS NULL,
+/// supports IS DISTINCT FROM, LIKE with a constant prefix and comparisons of
+/// coalesce(subfield, constant).  Return nullptr if not supported for
+/// pushdown.  This is needed because this conversion is frequently applied
+/// when extracting filters from remaining filter in readers.  Frequent throw
+/// clutters logs and slows down execution.
 std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     const core::CallTypedExpr&,
     common::Subfield&,
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedExpr.h"
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+template <TypeKind Kind>
+uint8_t* mutableRawBytes(BaseVector& vector) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  return vector.asUnchecked<FlatVector<T>>()
+      ->template mutableRawValues<uint8_t>();
+}
+} // namespace
+
+FusedExpr::FusedExpr(ExprPtr original)
+    : SpecialForm(
+          original->type(),
+          {original},
+          "fused",
+          original->supportsFlatNoNullsFastPath(),
+          false /* trackCpuUsage */) {}
+
+// static
+ExprPtr FusedExpr::tryFuse(const ExprPtr& expr) {
+  std::shared_ptr<FusedExpr> fused(new FusedExpr(expr));
+  Column column;
+  if (!fused->addSteps(expr, column) || fused->steps_.size() < 2) {
+    return nullptr;
+  }
+  fused->leafValues_.resize(fused->leaves_.size());
+  fused->scratch_.resize(fused->leaves_.size() + fused->steps_.size());
+  fused->computeMetadata();
+  return fused;
+}
+
+bool FusedExpr::addSteps(const ExprPtr& expr, Column& column) {
+  if (auto* nested = dynamic_cast<const FusedExpr*>(expr.get())) {
+    fused_.push_back(nested);
+    return addSteps(nested->inputs_[0], column);
+  }
+  if (dynamic_cast<const ConstantExpr*>(expr.get()) ||
+      (dynamic_cast<const FieldReference*>(expr.get()) &&
+       expr->inputs().empty())) {
+    for (auto i = 0; i < leaves_.size(); ++i) {
+      if (leaves_[i].get() == expr.get()) {
+        column = ~i;
+        return true;
+      }
+    }
+    leaves_.push_back(expr);
+    column = ~static_cast<Column>(leaves_.size() - 1);
+    return true;
+  }
+  if (expr->isSpecialForm() || expr->vectorFunction() == nullptr) {
+    return false;
+  }
+  Step step;
+  step.function = expr->vectorFunction().get();
+  for (const auto& input : expr->inputs()) {
+    step.argTypes.push_back(input->type());
+  }
+  if (!step.function->supportsFlatKernel(step.argTypes)) {
+    return false;
+  }
+  step.width = expr->type()->cppSizeInBytes();
+  for (const auto& input : expr->inputs()) {
+    Column arg;
+    if (!addSteps(input, arg)) {
+      return false;
+    }
+    step.args.push_back(arg);
+  }
+  fused_.push_back(expr.get());
+  column = steps_.size();
+  steps_.push_back(std::move(step));
+  return true;
+}
+
+bool FusedExpr::shouldFuse(const SelectivityVector& rows) const {
+  for (const auto* expr : fused_) {
+    if (expr->isMultiplyReferenced()) {
+      return false;
+    }
+  }
+  // The steps compute all rows in [begin, end).
+  return rows.countSelected() * 2 >= rows.end() - rows.begin();
+}
+
+bool FusedExpr::evalLeaves(const SelectivityVector& rows, EvalCtx& context) {
+  for (auto i = 0; i < leaves_.size(); ++i) {
+    auto& value = leafValues_[i];
+    if (auto* constant = dynamic_cast<const ConstantExpr*>(leaves_[i].get())) {
+      value = constant->value();
+      if (value->isNullAt(0)) {
+        return false;
+      }
+      continue;
+    }
+    leaves_[i]->eval(rows, context, value);
+    if (!value->isFlatEncoding() || value->size() < rows.end()) {
+      return false;
+    }
+    if (value->mayHaveNulls() &&
+        !rows.testSelected([&](auto row) { return !value->isNullAt(row); })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (shouldFuse(rows) && evalLeaves(rows, context)) {
+    try {
+      evalFused(rows, context, result);
+      std::fill(leafValues_.begin(), leafValues_.end(), nullptr);
+      return;
+    } catch (const VeloxException&) {
+      // Evaluates the original tree to report the errors per row.
+    }
+  }
+  std::fill(leafValues_.begin(), leafValues_.end(), nullptr);
+  inputs_[0]->eval(rows, context, result);
+}
+
+void FusedExpr::evalFused(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  const auto numLeaves = leaves_.size();
+  // Constant leaves are repeated to fill a block.
+  std::vector<const void*> constantBlocks(numLeaves);
+  for (auto i = 0; i < numLeaves; ++i) {
+    const auto& value = leafValues_[i];
+    if (!value->isConstantEncoding()) {
+      continue;
+    }
+    const auto width = value->type()->cppSizeInBytes();
+    auto& block = scratch_[i];
+    block.resize(kBlockSize * width / sizeof(int64_t));
+    auto* bytes = reinterpret_cast<char*>(block.data());
+    for (auto row = 0; row < kBlockSize; ++row) {
+      memcpy(bytes + row * width, value->valuesAsVoid(), width);
+    }
+    constantBlocks[i] = block.data();
+  }
+  for (auto i = 0; i < steps_.size(); ++i) {
+    scratch_[numLeaves + i].resize(
+        kBlockSize * steps_[i].width / sizeof(int64_t));
+  }
+
+  context.ensureWritable(rows, type(), result);
+  result->clearNulls(rows);
+  const auto resultWidth = steps_.back().width;
+  const bool isBoolean = type()->kind() == TypeKind::BOOLEAN;
+  auto* rawResult = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      mutableRawBytes, type()->kind(), *result);
+  const auto* selected = rows.asRange().bits();
+
+  std::vector<const void*> args;
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kBlockSize) {
+    const auto size = std::min(kBlockSize, rows.end() - begin);
+    const bool allSelected =
+        bits::isAllSet(selected, begin, begin + size, true);
+    for (auto i = 0; i < steps_.size(); ++i) {
+      const auto& step = steps_[i];
+      args.clear();
+      for (auto arg : step.args) {
+        if (arg >= 0) {
+          args.push_back(scratch_[numLeaves + arg].data());
+        } else if (constantBlocks[~arg] != nullptr) {
+          args.push_back(constantBlocks[~arg]);
+        } else {
+          const auto& value = leafValues_[~arg];
+          args.push_back(
+              static_cast<const char*>(value->valuesAsVoid()) +
+              begin * value->type()->cppSizeInBytes());
+        }
+      }
+      // The last step writes to 'result' unless some rows in the block must
+      // be left as they are.
+      void* stepResult = i == steps_.size() - 1 && allSelected && !isBoolean
+          ? static_cast<void*>(rawResult + begin * resultWidth)
+          : static_cast<void*>(scratch_[numLeaves + i].data());
+      step.function->applyFlatKernel(
+          step.argTypes, args.data(), size, stepResult);
+    }
+    if (allSelected && !isBoolean) {
+      continue;
+    }
+    const auto* values = reinterpret_cast<const char*>(
+        scratch_[numLeaves + steps_.size() - 1].data());
+    for (auto row = begin; row < begin + size; ++row) {
+      if (!bits::isBitSet(selected, row)) {
+        continue;
+      }
+      if (isBoolean) {
+        bits::setBit(
+            reinterpret_cast<uint64_t*>(rawResult),
+            row,
+            reinterpret_cast<const bool*>(values)[row - begin]);
+      } else {
+        memcpy(
+            rawResult + row * resultWidth,
+            values + (row - begin) * resultWidth,
+            resultWidth);
+      }
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Evaluates a tree of functions that support
+/// VectorFunction::applyFlatKernel(), e.g. arithmetic and comparisons over
+/// fixed-width types, in one pass over blocks of rows. The intermediate
+/// results stay in small scratch buffers instead of being materialized as
+/// vectors. The leaves of the tree must be top-level columns or constants.
+/// Falls back to evaluating the original tree when the leaves have nulls in
+/// the selected rows or are not flat, when few rows are selected, when a
+/// subexpression is shared with other expressions or when a function throws.
+/// Enabled by QueryConfig::exprFusionEnabled().
+class FusedExpr : public SpecialForm {
+ public:
+  /// Returns a FusedExpr that evaluates 'expr' or nullptr if 'expr' is not a
+  /// tree of at least two functions that support flat kernels. 'expr' must
+  /// have its metadata computed.
+  static ExprPtr tryFuse(const ExprPtr& expr);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  /// Number of functions evaluated in one pass.
+  int32_t numSteps() const {
+    return steps_.size();
+  }
+
+ private:
+  // Argument of a step. The index of the step that computes the argument or
+  // the bitwise complement of the index of a leaf.
+  using Column = int32_t;
+
+  struct Step {
+    const VectorFunction* function;
+    std::vector<TypePtr> argTypes;
+    std::vector<Column> args;
+    // Width of a result value in bytes.
+    int32_t width;
+  };
+
+  explicit FusedExpr(ExprPtr original);
+
+  // Appends the steps and leaves that compute 'expr' and sets 'column' to
+  // where the result is. Returns false if 'expr' can not be fused.
+  bool addSteps(const ExprPtr& expr, Column& column);
+
+  // Returns true if 'rows' should be evaluated in one pass, false to
+  // evaluate the original tree.
+  bool shouldFuse(const SelectivityVector& rows) const;
+
+  // Returns false if a leaf is not flat or constant or has nulls in 'rows'.
+  bool evalLeaves(const SelectivityVector& rows, EvalCtx& context);
+
+  void evalFused(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  void computePropagatesNulls() override {
+    propagatesNulls_ = inputs_[0]->propagatesNulls();
+  }
+
+  static constexpr vector_size_t kBlockSize = 1024;
+
+  // Columns and constants the steps read.
+  std::vector<ExprPtr> leaves_;
+
+  // Expressions that are evaluated by the steps. If any is shared with
+  // another expression, the original tree is evaluated so that the shared
+  // result is computed once.
+  std::vector<const Expr*> fused_;
+
+  std::vector<Step> steps_;
+
+  // Values of 'leaves_' for the current batch.
+  std::vector<VectorPtr> leafValues_;
+
+  // Block of values for each constant leaf and each step.
+  std::vector<std::vector<int64_t>> scratch_;
+};
+
+} // namespace facebook::velox::exec
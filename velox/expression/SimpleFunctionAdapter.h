@@ -148,6 +148,60 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  template <size_t... Is>
+  constexpr bool static allArgsFlatKernelEligibleImpl(
+      std::index_sequence<Is...>) {
+    return ([&]() {
+      if constexpr (isVariadicType<arg_at<Is>>::value) {
+        return false;
+      } else {
+        return isArgFlatConstantFastPathEligible<Is> &&
+            sizeof(exec_arg_at<Is>) <= sizeof(int64_t);
+      }
+    }() && ...);
+  }
+
+  /// True if the function can compute contiguous arrays of native values,
+  /// see VectorFunction::applyFlatKernel().
+  constexpr bool static flatKernelEligible() {
+    if constexpr (
+        FUNC::num_args == 0 || !FUNC::is_default_null_behavior ||
+        FUNC::can_produce_null_output || FUNC::udf_has_callNullFree ||
+        FUNC::udf_has_initialize || FUNC::has_ascii || !fastPathIteration) {
+      return false;
+    } else {
+      return sizeof(T) <= sizeof(int64_t) &&
+          allArgsFlatKernelEligibleImpl(
+                 std::make_index_sequence<FUNC::num_args>());
+    }
+  }
+
+  template <size_t... Is>
+  FOLLY_ALWAYS_INLINE void applyFlatKernelImpl(
+      const void* const* args,
+      vector_size_t size,
+      T* result,
+      std::index_sequence<Is...>) const {
+    for (vector_size_t row = 0; row < size; ++row) {
+      (*fn_).call(
+          result[row], static_cast<const exec_arg_at<Is>*>(args[Is])[row]...);
+    }
+  }
+
+  /// True if the function provides callBatch() over primitive arguments. It
+  /// is used when all arguments are flat without nulls and all rows are
+  /// selected.
+  constexpr bool static batchEligible() {
+    if constexpr (
+        FUNC::num_args == 0 || !FUNC::udf_has_callBatch ||
+        !FUNC::is_default_null_behavior || FUNC::udf_has_callNullFree ||
+        !fastPathIteration) {
+      return false;
+    } else {
+      return allArgsFlatConstantFastPathEligible();
+    }
+  }
+
   /// When true, a fast path for each possible combination of encodings will be
   /// used for reading arguments when all arguments are flat or constant
   /// primitivies.
@@ -203,6 +257,32 @@ class SimpleFunctionAdapter : public VectorFunction {
     bool mayHaveNullsRecursive{false};
   };
 
+  // Computes the leading rows with callBatch() if all rows are selected and
+  // all arguments are flat without nulls. Returns the number of rows
+  // computed.
+  template <size_t... Is>
+  vector_size_t applyBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    const auto& rows = *applyContext.rows;
+    if (!rows.isAllSelected() ||
+        !((args[Is]->isFlatEncoding() && !args[Is]->mayHaveNulls()) && ...)) {
+      return 0;
+    }
+    typename FUNC::batch_return_type* rawResult;
+    if constexpr (return_type_traits::typeKind == TypeKind::BOOLEAN) {
+      rawResult = applyContext.result->template mutableRawValues<uint64_t>();
+    } else {
+      rawResult = applyContext.result->mutableRawValues();
+    }
+    return (*fn_).callBatch(
+        rawResult,
+        args[Is]->template asUnchecked<FlatVector<exec_arg_at<Is>>>()
+            ->rawValues()...,
+        rows.end());
+  }
+
   template <int32_t POSITION, typename... Values>
   void unpackInitialize(
       const core::QueryConfig& config,
@@ -349,8 +429,25 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    // Computes the leading rows with callBatch() if possible and the rest
+    // row by row.
+    vector_size_t numBatchRows = 0;
+    std::optional<LocalSelectivityVector> remainingRows;
+    if constexpr (batchEligible()) {
+      numBatchRows = applyBatch(
+          applyContext, args, std::make_index_sequence<FUNC::num_args>());
+      if (numBatchRows > 0 && numBatchRows < rows.end()) {
+        remainingRows.emplace(context, rows);
+        remainingRows->get()->setValidRange(0, numBatchRows, false);
+        remainingRows->get()->updateBounds();
+        applyContext.rows = remainingRows->get();
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
-    if (allPrimitiveArgsFlatConstant(args)) {
+    if (numBatchRows == rows.end()) {
+      // All rows are computed.
+    } else if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
           allArgsFlatConstantFastPathEligible() && specializeForAllEncodings) {
         unpackSpecializeForAllEncodings<0>(applyContext, args);
@@ -439,6 +536,30 @@ class SimpleFunctionAdapter : public VectorFunction {
     return fn_->has_ascii;
   }
 
+  bool supportsFlatKernel(
+      const std::vector<TypePtr>& /*argTypes*/) const override {
+    if constexpr (flatKernelEligible()) {
+      return fn_->isDeterministic();
+    }
+    return false;
+  }
+
+  void applyFlatKernel(
+      const std::vector<TypePtr>& argTypes,
+      const void* const* args,
+      vector_size_t size,
+      void* result) const override {
+    if constexpr (flatKernelEligible()) {
+      applyFlatKernelImpl(
+          args,
+          size,
+          static_cast<T*>(result),
+          std::make_index_sequence<FUNC::num_args>());
+    } else {
+      VectorFunction::applyFlatKernel(argTypes, args, size, result);
+    }
+  }
+
   bool propagateStringEncodingFromAllInputs() const override {
     return fn_->is_default_ascii_behavior;
   }
@@ -585,7 +706,7 @@ class SimpleFunctionAdapter : public VectorFunction {
       };
 
       auto* data = getRawData();
-      auto writeResult = [&applyContext, &nullBuffer, &data](
+      auto writeResult = [this, &applyContext, &nullBuffer, &data](
                              auto row, bool notNull, auto out) INLINE_LAMBDA {
         // For fast path iteration, all active rows were already set as
         // non-null beforehand, so we only need to update the null buffer if
@@ -601,6 +722,7 @@ class SimpleFunctionAdapter : public VectorFunction {
             nullBuffer = applyContext.result->mutableRawNulls();
           }
           bits::setNull(nullBuffer, row);
+          setStatusIfError(applyContext, row);
         }
       };
       if (callNullFree) {
@@ -710,17 +832,36 @@ class SimpleFunctionAdapter : public VectorFunction {
         auto notNull = func(localWriter, row);
         currentWriter = localWriter;
         applyContext.resultWriter.commit(notNull);
+        if (!notNull) {
+          setStatusIfError(applyContext, row);
+        }
       });
       applyContext.resultWriter.finish();
     } else {
       applyContext.applyToSelectedNoThrow([&](auto row) INLINE_LAMBDA {
         applyContext.resultWriter.setOffset(row);
-        applyContext.resultWriter.commit(
-            func(applyContext.resultWriter.current(), row));
+        const bool notNull = func(applyContext.resultWriter.current(), row);
+        applyContext.resultWriter.commit(notNull);
+        if (!notNull) {
+          setStatusIfError(applyContext, row);
+        }
       });
     }
   }
 
+  // Records the error of a call() that returns Status for 'row'. No-op if the
+  // function returned null without an error, e.g. for a null input.
+  FOLLY_ALWAYS_INLINE void setStatusIfError(
+      ApplyContext& applyContext,
+      vector_size_t row) const {
+    if constexpr (FUNC::udf_has_call_return_status) {
+      auto status = fn_->takeStatus();
+      if (!status.ok()) {
+        applyContext.context.setStatus(row, status);
+      }
+    }
+  }
+
   // == NULLABLE VARIANTS ==
 
   // For default null behavior, assume everything is not null.
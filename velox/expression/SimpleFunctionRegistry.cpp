@@ -15,6 +15,7 @@
  */
 
 #include "velox/expression/SimpleFunctionRegistry.h"
+#include "velox/expression/ExprCompilationCache.h"
 
 namespace facebook::velox::exec {
 namespace {
@@ -43,6 +44,12 @@ void SimpleFunctionRegistry::registerFunctionInternal(
     signatureMap[*metadata->signature()] =
         std::make_unique<const FunctionEntry>(metadata, factory);
   });
+  ExprCompilationCache::instance().clear();
+}
+
+void SimpleFunctionRegistry::clearRegistry() {
+  registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+  ExprCompilationCache::instance().clear();
 }
 
 namespace {
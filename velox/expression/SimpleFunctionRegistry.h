@@ -84,9 +84,7 @@ class SimpleFunctionRegistry {
     return result;
   }
 
-  void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
-  }
+  void clearRegistry();
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
       const std::string& name) const;
@@ -110,6 +108,10 @@ class SimpleFunctionRegistry {
       return functionEntry_.getMetadata();
     }
 
+    const FunctionEntry& functionEntry() const {
+      return functionEntry_;
+    }
+
    private:
     const FunctionEntry& functionEntry_;
     TypePtr type_;
@@ -25,6 +25,54 @@ namespace {
 bool hasElseClause(const std::vector<ExprPtr>& inputs) {
   return inputs.size() % 2 == 1;
 }
+
+// Minimum number of conditions for looking up the case of a row instead of
+// evaluating the conditions.
+constexpr size_t kMinLookupCases = 2;
+
+// Maximum range of the constants for looking up cases in an array instead of
+// a hash table.
+constexpr uint64_t kMaxLookupArraySize = 4'096;
+
+// Number of batches evaluated in each of blend and sparse mode before picking
+// the cheaper one.
+constexpr int32_t kNumSampleBatches = 10;
+
+bool isLookupKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t constantAsInt64(const BaseVector& constant) {
+  switch (constant.typeKind()) {
+    case TypeKind::TINYINT:
+      return constant.as<SimpleVector<int8_t>>()->valueAt(0);
+    case TypeKind::SMALLINT:
+      return constant.as<SimpleVector<int16_t>>()->valueAt(0);
+    case TypeKind::INTEGER:
+      return constant.as<SimpleVector<int32_t>>()->valueAt(0);
+    case TypeKind::BIGINT:
+      return constant.as<SimpleVector<int64_t>>()->valueAt(0);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Returns true if 'expr' is a constant or a top-level column.
+bool isCheapInput(const Expr& expr) {
+  if (dynamic_cast<const ConstantExpr*>(&expr) != nullptr) {
+    return true;
+  }
+  return dynamic_cast<const FieldReference*>(&expr) != nullptr &&
+      expr.inputs().empty();
+}
 } // namespace
 
 SwitchExpr::SwitchExpr(
@@ -54,6 +102,87 @@ SwitchExpr::SwitchExpr(
       "Switch expression type different than then clause. Expected {} but got Actual {}.",
       typeExpected->toString(),
       this->type()->toString());
+
+  initializeLookup();
+  blendable_ = canBlend();
+}
+
+void SwitchExpr::initializeLookup() {
+  if (numCases_ < kMinLookupCases) {
+    return;
+  }
+  FieldReference* field = nullptr;
+  std::vector<int64_t> values;
+  values.reserve(numCases_);
+  for (auto i = 0; i < numCases_; ++i) {
+    const auto& condition = inputs_[2 * i];
+    if (condition->name() != "eq" || condition->inputs().size() != 2) {
+      return;
+    }
+    auto* column = dynamic_cast<FieldReference*>(condition->inputs()[0].get());
+    auto* constant = dynamic_cast<ConstantExpr*>(condition->inputs()[1].get());
+    if (column == nullptr) {
+      column = dynamic_cast<FieldReference*>(condition->inputs()[1].get());
+      constant = dynamic_cast<ConstantExpr*>(condition->inputs()[0].get());
+    }
+    if (column == nullptr || constant == nullptr ||
+        !column->inputs().empty() || !isLookupKind(column->type()->kind()) ||
+        column->type()->kind() != constant->type()->kind() ||
+        constant->value()->isNullAt(0)) {
+      return;
+    }
+    if (field != nullptr && field->field() != column->field()) {
+      return;
+    }
+    field = column;
+    values.push_back(constantAsInt64(*constant->value()));
+  }
+
+  const auto [min, max] = std::minmax_element(values.begin(), values.end());
+  if (static_cast<uint64_t>(*max) - static_cast<uint64_t>(*min) <
+      kMaxLookupArraySize) {
+    lookupMin_ = *min;
+    lookupArray_.resize(*max - *min + 1, numCases_);
+    // The first case with a value wins.
+    for (auto i = numCases_; i-- > 0;) {
+      lookupArray_[values[i] - lookupMin_] = i;
+    }
+  } else {
+    for (auto i = 0; i < numCases_; ++i) {
+      lookupMap_.emplace(values[i], i);
+    }
+  }
+  lookupField_ = field;
+}
+
+bool SwitchExpr::canBlend() const {
+  switch (type()->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      break;
+    default:
+      return false;
+  }
+  for (auto i = 0; i < numCases_; ++i) {
+    if (!isCheapInput(*inputs_[2 * i + 1])) {
+      return false;
+    }
+  }
+  return !hasElseClause_ || isCheapInput(*inputs_.back());
+}
+
+bool SwitchExpr::useBlend() {
+  if (numSampledBatches_ < 2 * kNumSampleBatches) {
+    return numSampledBatches_++ % 2 == 1;
+  }
+  // No row is dropped, so timeToDropValue() is the time per row.
+  return blendStats_.timeToDropValue() < sparseStats_.timeToDropValue();
 }
 
 void SwitchExpr::evalSpecialForm(
@@ -63,8 +192,6 @@ void SwitchExpr::evalSpecialForm(
   VectorPtr localResult;
   LocalSelectivityVector remainingRows(context, rows);
 
-  LocalSelectivityVector thenRows(context);
-
   // SWITCH: fix finalSelection at "rows" unless already fixed
   ScopedFinalSelectionSetter scopedFinalSelectionSetter(context, &rows);
   if (propagatesNulls_) {
@@ -84,59 +211,21 @@ void SwitchExpr::evalSpecialForm(
     }
   }
 
-  VectorPtr condition;
-  const uint64_t* values;
-
-  for (auto i = 0; i < numCases_; i++) {
-    context.releaseVector(condition);
-
-    if (!remainingRows.get()->hasSelections()) {
-      break;
-    }
-
-    // evaluate the case condition
-    inputs_[2 * i]->eval(*remainingRows.get(), context, condition);
-
-    if (context.errors()) {
-      context.deselectErrors(*remainingRows);
-      if (!remainingRows->hasSelections()) {
-        break;
-      }
-    }
-
-    const auto booleanMix = getFlatBool(
-        condition.get(),
-        *remainingRows.get(),
-        context,
-        &tempValues_,
-        nullptr,
-        true,
-        &values,
-        nullptr);
-    switch (booleanMix) {
-      case BooleanMix::kAllTrue:
-        inputs_[2 * i + 1]->eval(*remainingRows.get(), context, localResult);
-        remainingRows->clearAll();
-        continue;
-      case BooleanMix::kAllNull:
-      case BooleanMix::kAllFalse:
-        continue;
-      default: {
-        thenRows.get(remainingRows->end(), false);
-        bits::andBits(
-            thenRows.get()->asMutableRange().bits(),
-            remainingRows.get()->asRange().bits(),
-            values,
-            0,
-            remainingRows->end());
-        thenRows.get()->updateBounds();
-
-        if (thenRows.get()->hasSelections()) {
-          inputs_[2 * i + 1]->eval(*thenRows.get(), context, localResult);
-          remainingRows.get()->deselect(*thenRows.get());
-        }
-      }
-    }
+  // Times the evaluation of the cases and the else clause in the mode picked
+  // for this batch.
+  std::optional<SelectivityTimer> timer;
+  bool blend = false;
+  if (blendable_) {
+    blend = useBlend();
+    timer.emplace(
+        blend ? blendStats_ : sparseStats_, remainingRows->countSelected());
+  }
+  if (blend) {
+    evalBlend(*remainingRows, context, localResult);
+  } else if (lookupField_ != nullptr) {
+    evalLookup(*remainingRows, context, localResult);
+  } else {
+    evalCases(*remainingRows, context, localResult);
   }
 
   // Evaluate the "else" clause.
@@ -151,6 +240,7 @@ void SwitchExpr::evalSpecialForm(
           [&](auto row) { localResult->setNull(row, true); });
     }
   }
+  timer.reset();
 
   // Some rows may have not been evaluated by any then or else clause because
   // a condition threw an error on these rows. We set those to nulls to make
@@ -171,6 +261,229 @@ void SwitchExpr::evalSpecialForm(
   context.moveOrCopyResult(localResult, rows, finalResult);
 }
 
+void SwitchExpr::evalCondition(
+    int32_t i,
+    SelectivityVector& remaining,
+    EvalCtx& context,
+    SelectivityVector& thenRows) {
+  VectorPtr condition;
+  inputs_[2 * i]->eval(remaining, context, condition);
+
+  if (context.errors()) {
+    context.deselectErrors(remaining);
+    if (!remaining.hasSelections()) {
+      thenRows.clearAll();
+      context.releaseVector(condition);
+      return;
+    }
+  }
+
+  const uint64_t* values;
+  const auto booleanMix = getFlatBool(
+      condition.get(),
+      remaining,
+      context,
+      &tempValues_,
+      nullptr,
+      true,
+      &values,
+      nullptr);
+  switch (booleanMix) {
+    case BooleanMix::kAllTrue:
+      thenRows = remaining;
+      break;
+    case BooleanMix::kAllNull:
+    case BooleanMix::kAllFalse:
+      thenRows.clearAll();
+      break;
+    default:
+      thenRows.resizeFill(remaining.end(), false);
+      bits::andBits(
+          thenRows.asMutableRange().bits(),
+          remaining.asRange().bits(),
+          values,
+          0,
+          remaining.end());
+      thenRows.updateBounds();
+  }
+  context.releaseVector(condition);
+}
+
+void SwitchExpr::evalCases(
+    SelectivityVector& remaining,
+    EvalCtx& context,
+    VectorPtr& result) {
+  LocalSelectivityVector thenRows(context, remaining.end());
+  for (auto i = 0; i < numCases_; i++) {
+    if (!remaining.hasSelections()) {
+      break;
+    }
+    evalCondition(i, remaining, context, *thenRows);
+    if (thenRows->hasSelections()) {
+      inputs_[2 * i + 1]->eval(*thenRows, context, result);
+      remaining.deselect(*thenRows);
+    }
+  }
+}
+
+template <typename T>
+void SwitchExpr::lookupBranches(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows) {
+  rows.applyToSelected([&](auto row) {
+    branches_[row] = decoded.isNullAt(row)
+        ? static_cast<int32_t>(numCases_)
+        : lookupBranch(decoded.valueAt<T>(row));
+  });
+}
+
+void SwitchExpr::computeBranches(SelectivityVector& rows, EvalCtx& context) {
+  branches_.resize(rows.end());
+  if (lookupField_ != nullptr) {
+    const auto index = lookupField_->index(context);
+    context.ensureFieldLoaded(index, rows);
+    LocalDecodedVector decoded(context, *context.getField(index), rows);
+    switch (lookupField_->type()->kind()) {
+      case TypeKind::TINYINT:
+        lookupBranches<int8_t>(*decoded, rows);
+        break;
+      case TypeKind::SMALLINT:
+        lookupBranches<int16_t>(*decoded, rows);
+        break;
+      case TypeKind::INTEGER:
+        lookupBranches<int32_t>(*decoded, rows);
+        break;
+      case TypeKind::BIGINT:
+        lookupBranches<int64_t>(*decoded, rows);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    return;
+  }
+
+  rows.applyToSelected([&](auto row) { branches_[row] = numCases_; });
+  LocalSelectivityVector remaining(context, rows);
+  LocalSelectivityVector thenRows(context, rows.end());
+  for (auto i = 0; i < numCases_; ++i) {
+    if (!remaining->hasSelections()) {
+      break;
+    }
+    evalCondition(i, *remaining, context, *thenRows);
+    thenRows->applyToSelected([&](auto row) { branches_[row] = i; });
+    remaining->deselect(*thenRows);
+  }
+  if (context.errors()) {
+    context.deselectErrors(rows);
+  }
+}
+
+void SwitchExpr::evalLookup(
+    SelectivityVector& remaining,
+    EvalCtx& context,
+    VectorPtr& result) {
+  computeBranches(remaining, context);
+  branchRows_.resize(numCases_ + 1);
+  for (auto& branchRows : branchRows_) {
+    branchRows.resizeFill(remaining.end(), false);
+  }
+  remaining.applyToSelected(
+      [&](auto row) { branchRows_[branches_[row]].setValid(row, true); });
+  for (auto i = 0; i < numCases_; ++i) {
+    auto& thenRows = branchRows_[i];
+    thenRows.updateBounds();
+    if (thenRows.hasSelections()) {
+      inputs_[2 * i + 1]->eval(thenRows, context, result);
+    }
+  }
+  remaining = branchRows_[numCases_];
+  remaining.updateBounds();
+}
+
+void SwitchExpr::evalBlend(
+    SelectivityVector& remaining,
+    EvalCtx& context,
+    VectorPtr& result) {
+  computeBranches(remaining, context);
+  if (!remaining.hasSelections()) {
+    return;
+  }
+  // The results are cheap and cannot fail, so they are evaluated on all rows.
+  // The else clause or null is last.
+  std::vector<VectorPtr> values(numCases_ + 1);
+  for (auto i = 0; i < numCases_; ++i) {
+    inputs_[2 * i + 1]->eval(remaining, context, values[i]);
+  }
+  if (hasElseClause_) {
+    inputs_.back()->eval(remaining, context, values[numCases_]);
+  }
+  switch (type()->kind()) {
+    case TypeKind::TINYINT:
+      blend<int8_t>(remaining, context, values, result);
+      break;
+    case TypeKind::SMALLINT:
+      blend<int16_t>(remaining, context, values, result);
+      break;
+    case TypeKind::INTEGER:
+      blend<int32_t>(remaining, context, values, result);
+      break;
+    case TypeKind::BIGINT:
+      blend<int64_t>(remaining, context, values, result);
+      break;
+    case TypeKind::HUGEINT:
+      blend<int128_t>(remaining, context, values, result);
+      break;
+    case TypeKind::REAL:
+      blend<float>(remaining, context, values, result);
+      break;
+    case TypeKind::DOUBLE:
+      blend<double>(remaining, context, values, result);
+      break;
+    case TypeKind::TIMESTAMP:
+      blend<Timestamp>(remaining, context, values, result);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  remaining.clearAll();
+}
+
+template <typename T>
+void SwitchExpr::blend(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    const std::vector<VectorPtr>& values,
+    VectorPtr& result) {
+  std::vector<DecodedVector> decoded(values.size());
+  bool mayHaveNulls = !hasElseClause_;
+  for (auto i = 0; i < values.size(); ++i) {
+    if (values[i] != nullptr) {
+      decoded[i].decode(*values[i], rows);
+      mayHaveNulls |= decoded[i].mayHaveNulls();
+    }
+  }
+  context.ensureWritable(rows, type(), result);
+  auto* flatResult = result->asFlatVector<T>();
+  if (!mayHaveNulls) {
+    auto* rawResult = flatResult->mutableRawValues();
+    rows.applyToSelected([&](auto row) {
+      rawResult[row] = decoded[branches_[row]].template valueAt<T>(row);
+    });
+    if (flatResult->mayHaveNulls()) {
+      flatResult->clearNulls(rows);
+    }
+    return;
+  }
+  rows.applyToSelected([&](auto row) {
+    const auto& branch = decoded[branches_[row]];
+    if (values[branches_[row]] == nullptr || branch.isNullAt(row)) {
+      flatResult->setNull(row, true);
+    } else {
+      flatResult->set(row, branch.template valueAt<T>(row));
+    }
+  });
+}
+
 // This is safe to call only after all metadata is computed for input
 // expressions.
 void SwitchExpr::computePropagatesNulls() {
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/SelectivityInfo.h"
 #include "velox/expression/FunctionCallToSpecialForm.h"
 #include "velox/expression/SpecialForm.h"
 
@@ -34,6 +37,16 @@ namespace facebook::velox::exec {
 ///
 /// IF expression can be represented as a CASE expression with a single
 /// condition.
+///
+/// Besides evaluating the conditions one by one, there are two faster modes:
+/// - If all conditions compare the same integer column to constants, e.g. CASE
+///   c0 WHEN 1 THEN ... WHEN 2 THEN ..., the case of each row is looked up by
+///   the value of the column and the conditions are not evaluated.
+/// - If all results are constants or columns, which are cheap and cannot fail,
+///   they may be evaluated on all rows and blended in one pass by the case of
+///   each row. This replaces evaluating each result on its own rows. Whether
+///   this is faster depends on the number of rows taking each case, so the
+///   first batches alternate between the modes and the cheaper one is kept.
 class SwitchExpr : public SpecialForm {
  public:
   /// Inputs are concatenated conditions and results with an optional "else" at
@@ -57,10 +70,102 @@ class SwitchExpr : public SpecialForm {
 
   void computePropagatesNulls() override;
 
+  // Sets 'lookupField_' and the mapping from values to cases if all conditions
+  // compare the same integer column to constants.
+  void initializeLookup();
+
+  // Returns true if all results are constants or columns of a fixed width
+  // type.
+  bool canBlend() const;
+
+  // Returns true if the next batch should be evaluated in blend mode.
+  bool useBlend();
+
+  // Evaluates the conditions one by one and each result on the rows where its
+  // condition is true. Leaves in 'remaining' the rows where no condition is
+  // true.
+  void evalCases(
+      SelectivityVector& remaining,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  // Evaluates the results of the cases found by lookup on the rows of each
+  // case. Leaves in 'remaining' the rows that match no case.
+  void evalLookup(
+      SelectivityVector& remaining,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  // Evaluates all results on all of 'remaining' and copies the result of the
+  // case of each row into 'result'. Clears 'remaining'.
+  void evalBlend(
+      SelectivityVector& remaining,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  // Evaluates condition 'i' on 'remaining' and sets 'thenRows' to the rows
+  // where it is true. Deselects the rows with errors from 'remaining'.
+  void evalCondition(
+      int32_t i,
+      SelectivityVector& remaining,
+      EvalCtx& context,
+      SelectivityVector& thenRows);
+
+  // Sets 'branches_' to the case of each row in 'rows' by evaluating the
+  // conditions or by lookup. Rows that match no case get 'numCases_'.
+  // Deselects the rows with errors from 'rows'.
+  void computeBranches(SelectivityVector& rows, EvalCtx& context);
+
+  template <typename T>
+  void lookupBranches(
+      const DecodedVector& decoded,
+      const SelectivityVector& rows);
+
+  template <typename T>
+  void blend(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      const std::vector<VectorPtr>& values,
+      VectorPtr& result);
+
+  int32_t lookupBranch(int64_t value) const {
+    if (!lookupArray_.empty()) {
+      const auto index =
+          static_cast<uint64_t>(value) - static_cast<uint64_t>(lookupMin_);
+      return index < lookupArray_.size() ? lookupArray_[index]
+                                         : static_cast<int32_t>(numCases_);
+    }
+    auto it = lookupMap_.find(value);
+    return it == lookupMap_.end() ? static_cast<int32_t>(numCases_)
+                                  : it->second;
+  }
+
   const size_t numCases_;
   const bool hasElseClause_;
   BufferPtr tempValues_;
 
+  // The column compared to constants by all conditions, if any. Then the case
+  // of a row is found in 'lookupArray_' if the range of the constants is
+  // small, otherwise in 'lookupMap_'.
+  FieldReference* lookupField_{nullptr};
+  int64_t lookupMin_{0};
+  std::vector<int32_t> lookupArray_;
+  folly::F14FastMap<int64_t, int32_t> lookupMap_;
+
+  // True if evalBlend() can be used.
+  bool blendable_{false};
+
+  // Time spent in each mode for picking the cheaper one.
+  SelectivityInfo blendStats_;
+  SelectivityInfo sparseStats_;
+  int32_t numSampledBatches_{0};
+
+  // Case of each row. 'numCases_' stands for the else clause or null.
+  raw_vector<int32_t> branches_;
+
+  // Rows of each case in evalLookup().
+  std::vector<SelectivityVector> branchRows_;
+
   friend class SwitchCallToSpecialForm;
 };
 
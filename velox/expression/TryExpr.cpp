@@ -18,6 +18,17 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+
+// Listeners receive the errors under TRY, so the errors must keep their
+// messages if there are any.
+bool hasErrorListeners() {
+  return exprSetListeners().withRLock(
+      [](auto& listeners) { return !listeners.empty(); });
+}
+
+} // namespace
+
 void TryExpr::evalSpecialForm(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -32,6 +43,8 @@ void TryExpr::evalSpecialForm(
   // parent TRY expression, so the parent won't incorrectly null out rows that
   // threw exceptions which this expression already handled.
   ScopedVarSetter<ErrorVectorPtr> errorsSetter(context.errorsPtr(), nullptr);
+  ScopedVarSetter captureErrorDetails(
+      context.mutableCaptureErrorDetails(), hasErrorListeners());
   inputs_[0]->eval(rows, context, result);
 
   nullOutErrors(rows, context, result);
@@ -51,6 +64,8 @@ void TryExpr::evalSpecialFormSimplified(
   // parent TRY expression, so the parent won't incorrectly null out rows that
   // threw exceptions which this expression already handled.
   ScopedVarSetter<ErrorVectorPtr> errorsSetter(context.errorsPtr(), nullptr);
+  ScopedVarSetter captureErrorDetails(
+      context.mutableCaptureErrorDetails(), hasErrorListeners());
   inputs_[0]->evalSimplified(rows, context, result);
 
   nullOutErrors(rows, context, result);
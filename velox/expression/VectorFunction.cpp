@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include "folly/Singleton.h"
 #include "folly/Synchronized.h"
+#include "velox/expression/ExprCompilationCache.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
@@ -99,6 +100,7 @@ bool registerStatefulVectorFunction(
     VectorFunctionMetadata metadata,
     bool overwrite) {
   auto sanitizedName = sanitizeName(name);
+  ExprCompilationCache::instance().clear();
 
   if (overwrite) {
     vectorFunctionFactories().withWLock([&](auto& functionMap) {
@@ -142,4 +144,13 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::vector<ExprSetRewrite>& exprSetRewrites() {
+  static std::vector<ExprSetRewrite> rewrites;
+  return rewrites;
+}
+
+void registerExprSetRewrite(ExprSetRewrite rewrite) {
+  exprSetRewrites().emplace_back(std::move(rewrite));
+}
+
 } // namespace facebook::velox::exec
@@ -101,6 +101,31 @@ class VectorFunction {
     return false;
   }
 
+  /// Returns true if applyFlatKernel() is supported for arguments of
+  /// 'argTypes'. Requires that the function is deterministic, has default null
+  /// behavior, never produces nulls on non-null input and that the arguments
+  /// are fixed-width, at most 8 bytes wide and not BOOLEAN. The result is
+  /// fixed-width and at most 8 bytes wide.
+  virtual bool supportsFlatKernel(
+      const std::vector<TypePtr>& /*argTypes*/) const {
+    return false;
+  }
+
+  /// Computes the function for rows [0, size) of non-null arguments of
+  /// 'argTypes'. 'args' holds a pointer to the contiguous native values of
+  /// each argument and 'result' points to space for 'size' native result
+  /// values. A BOOLEAN result is written as one bool per row. Used by
+  /// FusedExpr to evaluate a tree of such functions without materializing the
+  /// intermediate results as vectors. May throw, in which case FusedExpr
+  /// evaluates the tree the regular way to get the per-row errors.
+  virtual void applyFlatKernel(
+      const std::vector<TypePtr>& /*argTypes*/,
+      const void* const* /*args*/,
+      vector_size_t /*size*/,
+      void* /*result*/) const {
+    VELOX_UNSUPPORTED("applyFlatKernel is not supported");
+  }
+
   // The evaluation engine will scan and set the string encoding of the
   // specified input arguments when presented if their type is VARCHAR before
   // applying the function
@@ -295,6 +320,21 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all the expressions of an ExprSet and returns
+/// equivalent expressions, 1:1 to the input. Used for re-writes that share work
+/// between the expressions, e.g. parsing a JSON column once for several
+/// functions.
+using ExprSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered ExprSet re-writes.
+std::vector<ExprSetRewrite>& exprSetRewrites();
+
+/// Appends a 'rewrite' to 'exprSetRewrites'. Re-writes are applied in the order
+/// they were registered, each to the result of the previous one, before
+/// the expressions of an ExprSet are compiled.
+void registerExprSetRewrite(ExprSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ExprCompilationCache.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/types/JsonType.h"
@@ -123,6 +124,37 @@ TEST_F(ExprCompilerTest, constantFolding) {
       "plus(plus(a, 1:BIGINT), 5:BIGINT)", compile(expression)->toString());
 }
 
+TEST_F(ExprCompilerTest, partialEvaluation) {
+  auto rowType = ROW({"a", "b", "c"}, {BOOLEAN(), BOOLEAN(), BIGINT()});
+  auto compileText = [&](const std::string& text) {
+    return compile(makeTypedExpr(text, rowType))->toString();
+  };
+
+  ASSERT_EQ("and(a, b)", compileText("a AND (1 < 2) AND b"));
+  ASSERT_EQ("a", compileText("a AND true"));
+  ASSERT_EQ("false:BOOLEAN", compileText("a AND (1 > 2) AND b"));
+  ASSERT_EQ("or(a, b)", compileText("a OR (1 > 2) OR b"));
+  ASSERT_EQ("true:BOOLEAN", compileText("a OR (1 < 2)"));
+
+  // A null constant does not decide the result.
+  auto exprSet = compile(
+      makeTypedExpr("a AND cast(null as boolean) AND true", rowType));
+  ASSERT_EQ(exprSet->exprs()[0]->name(), "and");
+  ASSERT_EQ(exprSet->exprs()[0]->inputs().size(), 2);
+
+  ASSERT_EQ("c", compileText("if(1 < 2, c, c + 1)"));
+  ASSERT_EQ("plus(c, 1:BIGINT)", compileText("if(1 > 2, c, c + 1)"));
+  ASSERT_EQ(
+      "switch(a, c, 5:BIGINT)",
+      compileText("case when a then c when 1 > 2 then c + 1 else 5 end"));
+  ASSERT_EQ(
+      "switch(a, c, plus(c, 1:BIGINT))",
+      compileText("case when a then c when 1 < 2 then c + 1 else 5 end"));
+
+  // Branches that are never taken do not fail.
+  ASSERT_EQ("c", compileText("if(1 > 2, 1 / 0, c)"));
+}
+
 TEST_F(ExprCompilerTest, andFlattening) {
   auto rowType =
       ROW({"a", "b", "c", "d"}, {BOOLEAN(), BOOLEAN(), BOOLEAN(), BOOLEAN()});
@@ -273,6 +305,41 @@ TEST_F(ExprCompilerTest, functionSignatureNotRegistered) {
       "((varchar,varchar...) -> varchar)");
 }
 
+TEST_F(ExprCompilerTest, compilationCache) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  ExprCompilationCache::instance().clear();
+
+  // A simple function and a vector function.
+  auto expression = makeTypedExpr("c0 + length(upper(c1))", rowType);
+  auto exprSet = compile(expression);
+  ASSERT_EQ(0, exprSet->compileStats().numCacheHits);
+  ASSERT_EQ(3, exprSet->compileStats().numCacheMisses);
+  ASSERT_EQ(3, ExprCompilationCache::instance().size());
+
+  // Compiling the same calls again, e.g. in another task, resolves them from
+  // the cache. Calls with other constants resolve the same way.
+  auto cachedExprSet = compile(expression);
+  ASSERT_EQ(3, cachedExprSet->compileStats().numCacheHits);
+  ASSERT_EQ(0, cachedExprSet->compileStats().numCacheMisses);
+  ASSERT_EQ(exprSet->toString(), cachedExprSet->toString());
+
+  exprSet = compile(makeTypedExpr("c0 + 11", rowType));
+  ASSERT_EQ(1, exprSet->compileStats().numCacheHits);
+  ASSERT_EQ("plus(c0, 11:BIGINT)", exprSet->toString());
+
+  // Registering functions invalidates the cache.
+  functions::prestosql::registerAllScalarFunctions();
+  ASSERT_EQ(0, ExprCompilationCache::instance().size());
+
+  // The cache can be disabled per query.
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprCompilationCacheEnabled, "false"}});
+  exprSet = compile(expression);
+  ASSERT_EQ(0, exprSet->compileStats().numCacheHits);
+  ASSERT_EQ(0, exprSet->compileStats().numCacheMisses);
+  ASSERT_EQ(0, ExprCompilationCache::instance().size());
+}
+
 TEST_F(ExprCompilerTest, constantFromFlatVector) {
   auto expression = std::make_shared<core::ConstantTypedExpr>(
       makeFlatVector<int64_t>({137, 23, -10}));
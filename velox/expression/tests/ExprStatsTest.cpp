@@ -303,6 +303,30 @@ TEST_F(ExprStatsTest, listener) {
   ASSERT_EQ(3, events.size());
 }
 
+TEST_F(ExprStatsTest, sharedSubexprHits) {
+  vector_size_t size = 1'024;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 7; }),
+  });
+  auto rowType = asRowType(data->type());
+
+  // The second expression reuses the results of 'cast(c0 + c1 as BIGINT)'
+  // computed by the first.
+  auto exprSet =
+      compileExpressions({"(c0 + c1) % 5 = 0", "(c0 + c1) % 3"}, rowType);
+  evaluate(*exprSet, data);
+  auto stats = exprSet->stats();
+  ASSERT_EQ(1, stats.at("cast").numSharedSubexprHits);
+  ASSERT_EQ(1024, stats.at("cast").numProcessedRows);
+  ASSERT_EQ(0, stats.at("plus").numSharedSubexprHits);
+
+  evaluate(*exprSet, data);
+  stats = exprSet->stats();
+  ASSERT_EQ(2, stats.at("cast").numSharedSubexprHits);
+  ASSERT_EQ(2048, stats.at("cast").numProcessedRows);
+}
+
 TEST_F(ExprStatsTest, specialForms) {
   vector_size_t size = 1'024;
 
@@ -448,6 +448,9 @@ TEST_P(ParameterizedExprTest, reorder) {
         condition->selectivityAt(i - 1).timeToDropValue(),
         condition->selectivityAt(i).timeToDropValue());
   }
+  // 'c0 % 103 < 30' drops more rows for about the same cost per row.
+  ASSERT_EQ(condition->inputOrder(), (std::vector<int32_t>{1, 0}));
+  ASSERT_EQ(condition->stats().numInputReorders, 1);
 }
 
 TEST_P(ParameterizedExprTest, constant) {
@@ -1684,6 +1687,83 @@ TEST_P(ParameterizedExprTest, switchExpr) {
   assertEqualVectors(expected, result);
 }
 
+TEST_F(ExprTest, switchLookupAndBlend) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row % 7; }, nullEvery(11)),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 3; }, nullEvery(13)),
+  });
+
+  // Evaluates enough batches for the switch to sample the blend and sparse
+  // modes and to keep one of them.
+  auto testSwitch = [&](const std::string& sql, const VectorPtr& expected) {
+    SCOPED_TRACE(sql);
+    auto exprSet = compileExpression(sql, asRowType(data->type()));
+    for (auto i = 0; i < 25; ++i) {
+      assertEqualVectors(expected, evaluate(exprSet.get(), data));
+    }
+  };
+
+  // Constants in a small range are looked up in an array. The first case with
+  // a value wins and null keys take the else clause.
+  testSwitch(
+      "case c0 when 1 then 10 when 3 then c1 when 1 then 30 else 0 end",
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) {
+            if (row % 11 == 0) {
+              return 0;
+            }
+            return row % 7 == 1 ? 10 : (row % 7 == 3 ? row * 3 : 0);
+          },
+          [](auto row) {
+            return row % 11 != 0 && row % 7 == 3 && row % 13 == 0;
+          }));
+
+  // Constants in a large range are looked up in a hash table.
+  testSwitch(
+      "case c0 when 1 then 10 when 5000 then 20 when 3 then 30 end",
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return row % 7 == 1 ? 10 : 30; },
+          [](auto row) {
+            return row % 11 == 0 || (row % 7 != 1 && row % 7 != 3);
+          }));
+
+  // Conditions that are not lookups with results that can be blended.
+  testSwitch(
+      "case when c0 > 4 then c1 when c0 < 2 then 1 else 2 end",
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) {
+            if (row % 11 == 0) {
+              return 2;
+            }
+            return row % 7 > 4 ? row * 3 : (row % 7 < 2 ? 1 : 2);
+          },
+          [](auto row) {
+            return row % 11 != 0 && row % 7 > 4 && row % 13 == 0;
+          }));
+
+  // Lookups with results that cannot be blended.
+  testSwitch(
+      "case c0 when 2 then c1 + 1 when 4 then c1 * 2 else c1 end",
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) {
+            if (row % 11 != 0 && row % 7 == 2) {
+              return row * 3 + 1;
+            }
+            if (row % 11 != 0 && row % 7 == 4) {
+              return row * 6;
+            }
+            return row * 3;
+          },
+          nullEvery(13)));
+}
+
 TEST_P(ParameterizedExprTest, swithExprSanityChecks) {
   auto vector = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
 
@@ -2138,6 +2218,41 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK(base.unique());
 }
 
+TEST_F(ExprTest, memoOnFirstUse) {
+  // Results for dictionary values that are marked as reused are cached the
+  // first time the values are seen.
+  auto base = makeFlatVector<std::string>(
+      1'000, [](auto row) { return fmt::format("value {}", row % 7); });
+  base->enableMemoOnFirstUse();
+
+  auto evenIndices = makeIndices(100, [](auto row) { return row * 2; });
+  auto rowType = ROW({"c0"}, {base->type()});
+  auto exprSet = compileExpression("upper(c0)", rowType);
+
+  auto [result, stats] = evaluateWithStats(
+      exprSet.get(), makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  auto expectedResult = makeFlatVector<std::string>(
+      100, [](auto row) { return fmt::format("VALUE {}", row * 2 % 7); });
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["upper"].numProcessedRows, 100);
+  ASSERT_FALSE(base.unique());
+
+  // All rows are cached.
+  std::tie(result, stats) = evaluateWithStats(
+      exprSet.get(), makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["upper"].numProcessedRows, 100);
+
+  // Only the rows that are not cached are evaluated.
+  auto firstRows = makeIndices(100, [](auto row) { return row; });
+  std::tie(result, stats) = evaluateWithStats(
+      exprSet.get(), makeRowVector({wrapInDictionary(firstRows, 100, base)}));
+  expectedResult = makeFlatVector<std::string>(
+      100, [](auto row) { return fmt::format("VALUE {}", row % 7); });
+  assertEqualVectors(expectedResult, result);
+  ASSERT_EQ(stats["upper"].numProcessedRows, 150);
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -213,7 +213,132 @@ TEST_F(ExprToSubfieldFilterTest, like) {
   auto call = parseCallExpr("a like 'foo%'", ROW({{"a", VARCHAR()}}));
   Subfield subfield;
   auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
-  ASSERT_FALSE(filter);
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_TRUE(filter->testBytes("foo", 3));
+  ASSERT_TRUE(filter->testBytes("foobar", 6));
+  ASSERT_FALSE(filter->testBytes("fo", 2));
+  ASSERT_FALSE(filter->testBytes("fop", 3));
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("a like 'foo'", ROW({{"a", VARCHAR()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testBytes("foo", 3));
+  ASSERT_FALSE(filter->testBytes("foobar", 6));
+
+  // Wildcards other than trailing %'s are not converted.
+  for (const auto* pattern :
+       {"a like '%foo'", "a like 'f_o%'", "a like 'f%o'"}) {
+    call = parseCallExpr(pattern, ROW({{"a", VARCHAR()}}));
+    ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+  }
+  call = parseCallExpr("a like 'foo%'", ROW({{"a", VARCHAR()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator(), true));
+}
+
+TEST_F(ExprToSubfieldFilterTest, orSameColumn) {
+  auto call =
+      parseCallExpr("a < 10 or a > 100 or a = 50", ROW({{"a", BIGINT()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintMultiRange);
+  ASSERT_TRUE(filter->testInt64(9));
+  ASSERT_FALSE(filter->testInt64(10));
+  ASSERT_TRUE(filter->testInt64(50));
+  ASSERT_FALSE(filter->testInt64(100));
+  ASSERT_TRUE(filter->testInt64(101));
+  ASSERT_FALSE(filter->testNull());
+
+  // Overlapping ranges are merged.
+  call = parseCallExpr("a < 10 or a < 20", ROW({{"a", BIGINT()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintRange);
+  ASSERT_TRUE(filter->testInt64(19));
+  ASSERT_FALSE(filter->testInt64(20));
+
+  call = parseCallExpr("a is null or a like 'x%'", ROW({{"a", VARCHAR()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testNull());
+  ASSERT_TRUE(filter->testBytes("xy", 2));
+  ASSERT_FALSE(filter->testBytes("y", 1));
+
+  call = parseCallExpr("a < 1.0 or a > 2.0", ROW({{"a", DOUBLE()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testDouble(0.5));
+  ASSERT_FALSE(filter->testDouble(1.5));
+  ASSERT_TRUE(filter->testDouble(2.5));
+
+  // not (a >= 10 and a <= 100) is a < 10 or a > 100.
+  call = parseCallExpr("a >= 10 and a <= 100", ROW({{"a", BIGINT()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator(), true);
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(9));
+  ASSERT_FALSE(filter->testInt64(50));
+  ASSERT_TRUE(filter->testInt64(101));
+
+  // Different columns are not converted.
+  call = parseCallExpr(
+      "a < 10 or b > 100", ROW({{"a", BIGINT()}, {"b", BIGINT()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+}
+
+TEST_F(ExprToSubfieldFilterTest, coalesce) {
+  auto rowType = ROW({{"a", ROW({{"b", BIGINT()}})}});
+  auto call = parseCallExpr("coalesce(a.b, 0) = 5", rowType);
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a", "b"});
+  ASSERT_TRUE(filter->testInt64(5));
+  ASSERT_FALSE(filter->testInt64(0));
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("coalesce(a.b, 0) < 5", rowType);
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(4));
+  ASSERT_FALSE(filter->testInt64(5));
+  ASSERT_TRUE(filter->testNull());
+
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator(), true);
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(5));
+  ASSERT_FALSE(filter->testNull());
+
+  // The default must be constant.
+  call = parseCallExpr(
+      "coalesce(a.b, c) = 5",
+      ROW({{"a", ROW({{"b", BIGINT()}})}, {"c", BIGINT()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+}
+
+TEST_F(ExprToSubfieldFilterTest, distinctFrom) {
+  auto call = parseCallExpr("a is distinct from 5", ROW({{"a", BIGINT()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_FALSE(filter->testInt64(5));
+  ASSERT_TRUE(filter->testInt64(6));
+  ASSERT_TRUE(filter->testNull());
+
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator(), true);
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(5));
+  ASSERT_FALSE(filter->testInt64(6));
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr(
+      "a is distinct from cast(null as bigint)", ROW({{"a", BIGINT()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kIsNotNull);
 }
 
 TEST_F(ExprToSubfieldFilterTest, nonConstant) {
@@ -224,6 +349,33 @@ TEST_F(ExprToSubfieldFilterTest, nonConstant) {
   ASSERT_FALSE(filter);
 }
 
+TEST_F(ExprToSubfieldFilterTest, constantOnLeft) {
+  auto call = parseCallExpr("21 * 2 > a", ROW({{"a", BIGINT()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_TRUE(filter->testInt64(41));
+  ASSERT_FALSE(filter->testInt64(42));
+
+  // The constant side is folded before the filter is made.
+  call = parseCallExpr(
+      "date_add('day', -7, cast('2024-01-08' as date)) < ds",
+      ROW({{"ds", DATE()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"ds"});
+  // 2024-01-01 is day 19723.
+  ASSERT_FALSE(filter->testInt64(19723));
+  ASSERT_TRUE(filter->testInt64(19724));
+
+  call = parseCallExpr("1 = a", ROW({{"a", BIGINT()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator(), true);
+  ASSERT_TRUE(filter);
+  ASSERT_FALSE(filter->testInt64(1));
+  ASSERT_TRUE(filter->testInt64(2));
+}
+
 TEST_F(ExprToSubfieldFilterTest, userError) {
   auto call = parseCallExpr("a = 1 / 0", ROW({{"a", BIGINT()}}));
   Subfield subfield;
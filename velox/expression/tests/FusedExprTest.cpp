@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/FusedExpr.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class FusedExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFusionEnabled(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kExprFusionEnabled, enabled ? "true" : "false"}});
+  }
+
+  // Returns the number of fused steps of the root of 'expr'. 0 if the root
+  // is not fused.
+  int32_t numFusedSteps(const std::string& expr, const RowVectorPtr& data) {
+    setFusionEnabled(true);
+    auto exprSet = compileExpression(expr, asRowType(data->type()));
+    auto* fused = dynamic_cast<const FusedExpr*>(exprSet->exprs()[0].get());
+    return fused == nullptr ? 0 : fused->numSteps();
+  }
+
+  // Checks that 'expr' gives the same result with and without fusion.
+  void testFusion(
+      const std::string& expr,
+      const RowVectorPtr& data,
+      const std::optional<SelectivityVector>& rows = std::nullopt) {
+    setFusionEnabled(false);
+    const auto rowType = asRowType(data->type());
+    auto expected = evaluate(*compileExpression(expr, rowType), data, rows);
+    setFusionEnabled(true);
+    auto actual = evaluate(*compileExpression(expr, rowType), data, rows);
+    if (rows.has_value()) {
+      assertEqualVectors(expected, actual, rows.value());
+    } else {
+      assertEqualVectors(expected, actual);
+    }
+  }
+};
+
+TEST_F(FusedExprTest, arithmetic) {
+  auto data = makeRowVector({
+      makeFlatVector<double>(5'000, [](auto row) { return row * 0.5; }),
+      makeFlatVector<double>(5'000, [](auto row) { return row % 7; }),
+      makeFlatVector<int64_t>(5'000, [](auto row) { return row; }),
+  });
+
+  ASSERT_EQ(numFusedSteps("c0 * c1 + c0 * 2.0 - c1", data), 4);
+  testFusion("c0 * c1 + c0 * 2.0 - c1", data);
+  testFusion("c2 * 3 + c2 % 5", data);
+
+  // A single function is not fused.
+  ASSERT_EQ(numFusedSteps("c0 * c1", data), 0);
+}
+
+TEST_F(FusedExprTest, comparison) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(3'000, [](auto row) { return row % 101; }),
+      makeFlatVector<int64_t>(3'000, [](auto row) { return row % 37; }),
+  });
+
+  ASSERT_EQ(numFusedSteps("c0 * 2 + c1 > c1 * 3", data), 4);
+  testFusion("c0 * 2 + c1 > c1 * 3", data);
+  testFusion("c0 - c1 < 10", data);
+
+  // Partially selected rows leave the other rows of the result as they are.
+  SelectivityVector rows(data->size());
+  for (auto i = 0; i < data->size(); i += 3) {
+    rows.setValid(i, false);
+  }
+  rows.updateBounds();
+  testFusion("c0 * 2 + c1 > c1 * 3", data, rows);
+  testFusion("c0 * 2 + c1 - c1 * 3", data, rows);
+}
+
+TEST_F(FusedExprTest, fallback) {
+  // Nulls are removed before evaluating the fused steps.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          2'000, [](auto row) { return row; }, nullEvery(7)),
+      makeFlatVector<int64_t>(
+          2'000, [](auto row) { return row % 11; }, nullEvery(5)),
+  });
+  testFusion("c0 * c1 + c1", data);
+
+  // A dictionary-encoded input that can not be peeled is evaluated without
+  // fusion.
+  auto indices = makeIndicesInReverse(2'000);
+  auto base = makeFlatVector<int64_t>(2'000, [](auto row) { return row; });
+  data = makeRowVector({
+      wrapInDictionary(indices, base),
+      makeFlatVector<int64_t>(2'000, [](auto row) { return row % 11; }),
+  });
+  testFusion("c0 * c1 + c1", data);
+
+  // Overflow is reported the same way as without fusion.
+  data = makeRowVector({
+      makeFlatVector<int64_t>({1, std::numeric_limits<int64_t>::max(), 3}),
+      makeFlatVector<int64_t>({1, 2, 3}),
+  });
+  setFusionEnabled(true);
+  VELOX_ASSERT_THROW(evaluate("c0 * c1 + c1", data), "integer overflow");
+  testFusion("try(c0 * c1 + c1)", data);
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -1288,4 +1288,67 @@ TEST_F(SimpleFunctionTest, constantArgument) {
   EXPECT_TRUE(signatures[0]->constantArguments().at(4));
   EXPECT_TRUE(signatures[0]->constantArguments().at(5));
 }
+
+// Number of rows computed by BatchFunction::callBatch().
+int32_t numBatchRows{0};
+
+// Doubles non-negative values. callBatch() stops at the first negative value
+// and leaves it to call() to fail.
+template <typename T>
+struct BatchFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, const int64_t& input) {
+    VELOX_USER_CHECK_GE(input, 0);
+    out = input * 2;
+  }
+
+  int32_t callBatch(int64_t* out, const int64_t* input, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      if (input[i] < 0) {
+        numBatchRows += i;
+        return i;
+      }
+      out[i] = input[i] * 2;
+    }
+    numBatchRows += size;
+    return size;
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchFunction, int64_t, int64_t>({"batch_function"});
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  numBatchRows = 0;
+  auto result = evaluate("batch_function(c0)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 2; }), result);
+  ASSERT_EQ(numBatchRows, 100);
+
+  // The rows after the first negative value are computed with call().
+  data = makeRowVector({makeFlatVector<int64_t>(
+      100, [](auto row) { return row == 10 ? -1 : row; })});
+  numBatchRows = 0;
+  result = evaluate("try(batch_function(c0))", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row * 2; }, [](auto row) {
+            return row == 10;
+          }),
+      result);
+  ASSERT_EQ(numBatchRows, 10);
+
+  // Arguments with nulls are not computed with callBatch().
+  data = makeRowVector({makeFlatVector<int64_t>(
+      100, [](auto row) { return row; }, nullEvery(3))});
+  numBatchRows = 0;
+  result = evaluate("batch_function(c0)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row * 2; }, nullEvery(3)),
+      result);
+  ASSERT_EQ(numBatchRows, 0);
+}
 } // namespace
@@ -472,6 +472,50 @@ TEST_F(TryExprTest, decimalDivideByZero) {
   assertEqualVectors(expectedLong, result);
 }
 
+// Returns the square root of a non-negative number. Reports negative numbers
+// as errors without throwing.
+template <typename T>
+struct StatusSqrtFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  Status call(double& out, const double& input) {
+    if (input < 0) {
+      return Status::UserError("Negative input: {}", input);
+    }
+    out = std::sqrt(input);
+    return Status::OK();
+  }
+};
+
+TEST_F(TryExprTest, statusErrors) {
+  registerFunction<StatusSqrtFunction, double, double>({"status_sqrt"});
+  auto data = makeRowVector({makeNullableFlatVector<double>(
+      {4.0, -1.0, std::nullopt, 9.0, -2.0})});
+
+  auto result = evaluate("try(status_sqrt(c0))", data);
+  assertEqualVectors(
+      makeNullableFlatVector<double>(
+          {2.0, std::nullopt, std::nullopt, 3.0, std::nullopt}),
+      result);
+
+  VELOX_ASSERT_THROW(evaluate("status_sqrt(c0)", data), "Negative input: -1");
+
+  // Cast reports invalid strings without throwing under TRY.
+  auto strings = makeRowVector({makeFlatVector<StringView>(
+      {"1", "x", "2.5", "", "-7", "true"})});
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>(
+          {1, std::nullopt, std::nullopt, std::nullopt, -7, std::nullopt}),
+      evaluate("try(cast(c0 as bigint))", strings));
+  assertEqualVectors(
+      makeNullableFlatVector<double>(
+          {1.0, std::nullopt, 2.5, std::nullopt, -7.0, std::nullopt}),
+      evaluate("try_cast(c0 as double)", strings));
+  VELOX_ASSERT_THROW(
+      evaluate("cast(c0 as bigint)", strings),
+      "Invalid leading character");
+}
+
 // This test must be DEBUG_ONLY because it uses SCOPED_TESTVALUE_SET.
 DEBUG_ONLY_TEST_F(TryExprTest, errorRestoringContext) {
   registerFunction<TestingAlwaysThrowsFunction, bool, bool>({"always_throws"});
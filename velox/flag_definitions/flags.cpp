@@ -105,3 +105,9 @@ DEFINE_bool(
     "exception. This is only used by test to control the test error output size");
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
+
+DEFINE_bool(
+    velox_hash_table_use_hugepages,
+    true,
+    "If true, hash tables are aligned to huge pages and backed by huge pages "
+    "regardless of velox_memory_use_hugepages");
@@ -19,6 +19,7 @@
 #include <limits>
 #include "CheckedArithmeticImpl.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/Macros.h"
 
 namespace facebook::velox::functions {
@@ -30,6 +31,35 @@ struct CheckedPlusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = checkedPlus(a, b);
   }
+
+  // Stops at the first batch that overflows and leaves it to call() to
+  // report the error.
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE int32_t
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    int32_t i = 0;
+    if constexpr (xsimd::has_simd_register<TInput>::value) {
+      using Batch = xsimd::batch<TInput>;
+      for (; i + Batch::size <= size; i += Batch::size) {
+        const auto x = Batch::load_unaligned(a + i);
+        const auto y = Batch::load_unaligned(b + i);
+        const auto sum = x + y;
+        // The sum overflows if it has a different sign than both operands.
+        if (xsimd::any(((x ^ sum) & (y ^ sum)) < Batch(TInput(0)))) {
+          return i;
+        }
+        sum.store_unaligned(result + i);
+      }
+    }
+    for (; i < size; ++i) {
+      TInput sum;
+      if (__builtin_add_overflow(a[i], b[i], &sum)) {
+        return i;
+      }
+      result[i] = sum;
+    }
+    return size;
+  }
 };
 
 template <typename T>
@@ -39,6 +69,36 @@ struct CheckedMinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = checkedMinus(a, b);
   }
+
+  // Stops at the first batch that overflows and leaves it to call() to
+  // report the error.
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE int32_t
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    int32_t i = 0;
+    if constexpr (xsimd::has_simd_register<TInput>::value) {
+      using Batch = xsimd::batch<TInput>;
+      for (; i + Batch::size <= size; i += Batch::size) {
+        const auto x = Batch::load_unaligned(a + i);
+        const auto y = Batch::load_unaligned(b + i);
+        const auto difference = x - y;
+        // The difference overflows if the operands have different signs and
+        // the difference has a different sign than the first operand.
+        if (xsimd::any(((x ^ y) & (x ^ difference)) < Batch(TInput(0)))) {
+          return i;
+        }
+        difference.store_unaligned(result + i);
+      }
+    }
+    for (; i < size; ++i) {
+      TInput difference;
+      if (__builtin_sub_overflow(a[i], b[i], &difference)) {
+        return i;
+      }
+      result[i] = difference;
+    }
+    return size;
+  }
 };
 
 template <typename T>
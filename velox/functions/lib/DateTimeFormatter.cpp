@@ -937,8 +937,258 @@ int32_t parseFromPattern(
   return 0;
 }
 
+constexpr int64_t kMillisPerSecond = 1'000;
+constexpr int64_t kMillisPerMinute = 60 * kMillisPerSecond;
+constexpr int64_t kMillisPerHour = 60 * kMillisPerMinute;
+constexpr int64_t kMillisPerDay = 24 * kMillisPerHour;
+
+// Converts days since epoch to a proleptic Gregorian calendar date. See
+// http://howardhinnant.github.io/date_algorithms.html#civil_from_days.
+void civilFromDays(
+    int64_t days,
+    int64_t& year,
+    uint32_t& month,
+    uint32_t& day) {
+  days += 719'468;
+  const int64_t era = (days >= 0 ? days : days - 146'096) / 146'097;
+  const auto dayOfEra = static_cast<uint32_t>(days - era * 146'097);
+  const uint32_t yearOfEra = (dayOfEra - dayOfEra / 1'460 +
+                              dayOfEra / 36'524 - dayOfEra / 146'096) /
+      365;
+  const uint32_t dayOfYear =
+      dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  // Month counted from March.
+  const uint32_t marchMonth = (5 * dayOfYear + 2) / 153;
+  day = dayOfYear - (153 * marchMonth + 2) / 5 + 1;
+  month = marchMonth < 10 ? marchMonth + 3 : marchMonth - 9;
+  year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2);
+}
+
+// Writes the 'width' low digits of 'value' to 'result'.
+inline void writeDigits(uint32_t value, int32_t width, char* result) {
+  for (auto i = width - 1; i >= 0; --i) {
+    result[i] = '0' + value % 10;
+    value /= 10;
+  }
+}
+
+// Parses 'width' digits at 'input'. Returns -1 if some character is not a
+// digit.
+inline int32_t readDigits(const char* input, int32_t width) {
+  int32_t number = 0;
+  for (auto i = 0; i < width; ++i) {
+    if (!characterIsDigit(input[i])) {
+      return -1;
+    }
+    number = number * 10 + (input[i] - '0');
+  }
+  return number;
+}
+
+// Parses 'input' according to 'layout' into 'date' the same way
+// parseFromPattern() parses each field. Returns false if 'input' does not
+// match the layout or some field is out of range. 'date' is undefined in
+// that case.
+bool parseFixedWidth(
+    const FixedWidthLayout& layout,
+    const std::string_view& input,
+    Date& date) {
+  if (input.size() != layout.text.size()) {
+    return false;
+  }
+  int32_t literalStart = 0;
+  for (const auto& field : layout.fields) {
+    if (std::memcmp(
+            input.data() + literalStart,
+            layout.text.data() + literalStart,
+            field.offset - literalStart) != 0) {
+      return false;
+    }
+    literalStart = field.offset + field.width;
+
+    const auto number = readDigits(input.data() + field.offset, field.width);
+    if (number < 0) {
+      return false;
+    }
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        date.centuryFormat = false;
+        date.isYearOfEra = false;
+        date.hasYear = true;
+        date.year = number;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        if (field.specifier == DateTimeFormatSpecifier::MONTH_OF_YEAR) {
+          if (number < 1 || number > 12) {
+            return false;
+          }
+          date.month = number;
+        } else {
+          date.dayOfMonthValues.push_back(number);
+          date.day = number;
+        }
+        date.weekDateFormat = false;
+        date.dayOfYearFormat = false;
+        if (!date.hasYear) {
+          date.hasYear = true;
+          date.year = 2000;
+        }
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        if (number > 23) {
+          return false;
+        }
+        date.isClockHour = false;
+        date.isHourOfHalfDay = false;
+        date.hour = number;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        if (number > 59) {
+          return false;
+        }
+        date.minute = number;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        if (number > 59) {
+          return false;
+        }
+        date.second = number;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND: {
+        auto millis = number;
+        for (auto i = field.width; i < 3; ++i) {
+          millis *= 10;
+        }
+        date.microsecond = millis * util::kMicrosPerMsec;
+      } break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  return std::memcmp(
+             input.data() + literalStart,
+             layout.text.data() + literalStart,
+             input.size() - literalStart) == 0;
+}
+
 } // namespace
 
+// static
+std::optional<FixedWidthLayout> DateTimeFormatter::makeFixedWidthLayout(
+    const std::vector<DateTimeToken>& tokens) {
+  FixedWidthLayout layout;
+  layout.parsable = true;
+  for (const auto& token : tokens) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      // A digit after a field would be read as part of the field by
+      // parseFromPattern().
+      for (auto c : token.literal) {
+        if (characterIsDigit(c)) {
+          layout.parsable = false;
+        }
+      }
+      layout.text.append(token.literal.data(), token.literal.size());
+      continue;
+    }
+    const int32_t width = token.pattern.minRepresentDigits;
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        if (width != 2 && width != 4) {
+          return std::nullopt;
+        }
+        // Two digit years are mapped to a century when parsing.
+        if (width == 2) {
+          layout.parsable = false;
+        }
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        if (width != 2) {
+          return std::nullopt;
+        }
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        // parseFromPattern() scales more than 3 digits differently.
+        if (width > 3) {
+          layout.parsable = false;
+        }
+        break;
+      default:
+        return std::nullopt;
+    }
+    layout.fields.push_back(
+        {token.pattern.specifier,
+         static_cast<int32_t>(layout.text.size()),
+         width});
+    layout.text.append(width, '0');
+  }
+  if (layout.fields.empty()) {
+    return std::nullopt;
+  }
+  return layout;
+}
+
+int32_t DateTimeFormatter::formatFixedWidth(int64_t millis, char* result)
+    const {
+  const auto& layout = fixedWidth_.value();
+  int64_t days = millis / kMillisPerDay;
+  int64_t millisInDay = millis % kMillisPerDay;
+  if (millisInDay < 0) {
+    millisInDay += kMillisPerDay;
+    --days;
+  }
+  int64_t year;
+  uint32_t month;
+  uint32_t day;
+  civilFromDays(days, year, month, day);
+
+  std::memcpy(result, layout.text.data(), layout.text.size());
+  for (const auto& field : layout.fields) {
+    char* out = result + field.offset;
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        if (field.width == 2) {
+          writeDigits(std::abs(year) % 100, 2, out);
+        } else {
+          if (year < 0 || year > 9999) {
+            return -1;
+          }
+          writeDigits(year, 4, out);
+        }
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        writeDigits(month, 2, out);
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        writeDigits(day, 2, out);
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        writeDigits(millisInDay / kMillisPerHour, 2, out);
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        writeDigits(millisInDay / kMillisPerMinute % 60, 2, out);
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        writeDigits(millisInDay / kMillisPerSecond % 60, 2, out);
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND: {
+        // The digits of milliseconds followed by zeros, truncated to
+        // 'width'.
+        char digits[3];
+        writeDigits(millisInDay % kMillisPerSecond, 3, digits);
+        std::memcpy(out, digits, std::min(field.width, 3));
+      } break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  return layout.text.size();
+}
+
 uint32_t DateTimeFormatter::maxResultSize(
     const date::time_zone* timezone) const {
   uint32_t size = 0;
@@ -1021,6 +1271,14 @@ int32_t DateTimeFormatter::format(
     t.toTimezone(*timezone);
   }
   const auto timePoint = t.toTimePoint(allowOverflow);
+  if (fixedWidth_.has_value()) {
+    const auto size =
+        formatFixedWidth(timePoint.time_since_epoch().count(), result);
+    if (size >= 0) {
+      VELOX_CHECK_LE(size, maxResultSize, "Bad allocation size for result.");
+      return size;
+    }
+  }
   const auto daysTimePoint = date::floor<date::days>(timePoint);
 
   const auto durationInTheDay = date::make_time(timePoint - daysTimePoint);
@@ -1255,43 +1513,47 @@ std::optional<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input,
     const bool failOnError) const {
   Date date;
-  const char* cur = input.data();
-  const char* end = cur + input.size();
-
-  for (int i = 0; i < tokens_.size(); i++) {
-    auto& tok = tokens_[i];
-    switch (tok.type) {
-      case DateTimeToken::Type::kLiteral:
-        if (tok.literal.size() > end - cur ||
-            std::memcmp(cur, tok.literal.data(), tok.literal.size()) != 0) {
-          parseFail(input, cur, end, failOnError);
-          return std::nullopt;
-        }
-        cur += tok.literal.size();
-        break;
-      case DateTimeToken::Type::kPattern:
-        if (i + 1 < tokens_.size() &&
-            tokens_[i + 1].type == DateTimeToken::Type::kPattern) {
-          if (parseFromPattern(
-                  tok.pattern, input, cur, end, date, true, type_) == -1) {
+  if (!fixedWidth_.has_value() || !fixedWidth_->parsable ||
+      !parseFixedWidth(*fixedWidth_, input, date)) {
+    date = Date();
+    const char* cur = input.data();
+    const char* end = cur + input.size();
+
+    for (int i = 0; i < tokens_.size(); i++) {
+      auto& tok = tokens_[i];
+      switch (tok.type) {
+        case DateTimeToken::Type::kLiteral:
+          if (tok.literal.size() > end - cur ||
+              std::memcmp(cur, tok.literal.data(), tok.literal.size()) != 0) {
             parseFail(input, cur, end, failOnError);
             return std::nullopt;
           }
-        } else {
-          if (parseFromPattern(
-                  tok.pattern, input, cur, end, date, false, type_) == -1) {
-            parseFail(input, cur, end, failOnError);
-            return std::nullopt;
+          cur += tok.literal.size();
+          break;
+        case DateTimeToken::Type::kPattern:
+          if (i + 1 < tokens_.size() &&
+              tokens_[i + 1].type == DateTimeToken::Type::kPattern) {
+            if (parseFromPattern(
+                    tok.pattern, input, cur, end, date, true, type_) == -1) {
+              parseFail(input, cur, end, failOnError);
+              return std::nullopt;
+            }
+          } else {
+            if (parseFromPattern(
+                    tok.pattern, input, cur, end, date, false, type_) == -1) {
+              parseFail(input, cur, end, failOnError);
+              return std::nullopt;
+            }
           }
-        }
-        break;
+          break;
+      }
     }
-  }
 
-  // Ensure all input was consumed.
-  if (cur < end) {
-    parseFail(input, cur, end, failOnError);
-    return std::nullopt;
+    // Ensure all input was consumed.
+    if (cur < end) {
+      parseFail(input, cur, end, failOnError);
+      return std::nullopt;
+    }
   }
 
   // Era is BC and year of era is provided
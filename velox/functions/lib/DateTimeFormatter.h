@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -139,6 +140,28 @@ struct DateTimeToken {
   }
 };
 
+/// Layout of a pattern that consists of numeric fields of fixed width and
+/// literals, e.g. 'yyyy-MM-dd HH:mm:ss.SSS'. Such a pattern is formatted by
+/// writing the digits of each field at a fixed offset of a prebuilt string
+/// and parsed by reading the digits at the same offsets, without going over
+/// the tokens for each value.
+struct FixedWidthLayout {
+  struct Field {
+    DateTimeFormatSpecifier specifier;
+    int32_t offset;
+    int32_t width;
+  };
+
+  std::vector<Field> fields;
+
+  // The formatted result with all digits set to '0'.
+  std::string text;
+
+  // True if parsing the layout gives the same result as parsing the tokens
+  // for the inputs that match the layout.
+  bool parsable{false};
+};
+
 struct DateTimeResult {
   Timestamp timestamp;
   int64_t timezoneId{-1};
@@ -159,7 +182,8 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type),
+        fixedWidth_(makeFixedWidthLayout(tokens_)) {}
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -173,6 +197,12 @@ class DateTimeFormatter {
     return tokens_;
   }
 
+  /// Returns the fixed width layout of the pattern or std::nullopt if some
+  /// field of the pattern has no fixed width.
+  const std::optional<FixedWidthLayout>& fixedWidthLayout() const {
+    return fixedWidth_;
+  }
+
   // If failOnError is false, returns std::nullopt for parsing error.
   // Otherwise, fail with error thrown.
   std::optional<DateTimeResult> parse(
@@ -197,10 +227,19 @@ class DateTimeFormatter {
       bool allowOverflow = false) const;
 
  private:
+  static std::optional<FixedWidthLayout> makeFixedWidthLayout(
+      const std::vector<DateTimeToken>& tokens);
+
+  // Formats 'millis' since epoch in local time according to 'fixedWidth_'.
+  // Returns the size of the result or -1 if the year does not fit the
+  // layout.
+  int32_t formatFixedWidth(int64_t millis, char* result) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+  std::optional<FixedWidthLayout> fixedWidth_;
 };
 
 std::shared_ptr<DateTimeFormatter> buildMysqlDateTimeFormatter(
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/InSet.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace facebook::velox::functions {
+
+// static
+std::unique_ptr<StringPerfectHashSet> StringPerfectHashSet::create(
+    const std::vector<std::string_view>& values) {
+  VELOX_CHECK(!values.empty(), "values must not be empty");
+  // Upper bound for the seed of a bucket. Buckets have 4 strings on average
+  // and the table is at most half full, so that a seed is typically found
+  // within a few tries.
+  constexpr uint64_t kMaxSeed = 1 << 16;
+
+  std::unique_ptr<StringPerfectHashSet> set(new StringPerfectHashSet());
+  set->numValues_ = values.size();
+  const auto numSlots = bits::nextPowerOfTwo(values.size() * 2);
+  const auto numBuckets =
+      bits::nextPowerOfTwo(std::max<size_t>(1, values.size() / 4));
+  set->slotMask_ = numSlots - 1;
+  set->bucketMask_ = numBuckets - 1;
+  set->seeds_.resize(numBuckets, 0);
+  set->slots_.resize(numSlots);
+
+  std::vector<uint64_t> hashes(values.size());
+  std::vector<std::vector<int32_t>> buckets(numBuckets);
+  for (auto i = 0; i < values.size(); ++i) {
+    hashes[i] = folly::hasher<std::string_view>()(values[i]);
+    buckets[(hashes[i] >> 32) & set->bucketMask_].push_back(i);
+  }
+
+  // Places the largest buckets first while most slots are free.
+  std::vector<int32_t> order(numBuckets);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](int32_t left, int32_t right) {
+    return buckets[left].size() > buckets[right].size();
+  });
+
+  // Index of the value in each slot, -1 if empty.
+  std::vector<int32_t> slotValues(numSlots, -1);
+  std::vector<uint64_t> bucketSlots;
+  for (auto bucket : order) {
+    if (buckets[bucket].empty()) {
+      break;
+    }
+    uint64_t seed = 0;
+    for (;; ++seed) {
+      if (seed == kMaxSeed) {
+        return nullptr;
+      }
+      bucketSlots.clear();
+      bool placed = true;
+      for (auto i : buckets[bucket]) {
+        const auto slot = bits::hashMix(hashes[i], seed) & set->slotMask_;
+        if (slotValues[slot] >= 0 ||
+            std::find(bucketSlots.begin(), bucketSlots.end(), slot) !=
+                bucketSlots.end()) {
+          placed = false;
+          break;
+        }
+        bucketSlots.push_back(slot);
+      }
+      if (placed) {
+        break;
+      }
+    }
+    set->seeds_[bucket] = seed;
+    for (auto i = 0; i < bucketSlots.size(); ++i) {
+      slotValues[bucketSlots[i]] = buckets[bucket][i];
+    }
+  }
+
+  size_t dataSize = 0;
+  for (const auto& value : values) {
+    dataSize += value.size();
+  }
+  set->data_.reserve(dataSize);
+  std::vector<size_t> offsets(values.size());
+  for (auto i = 0; i < values.size(); ++i) {
+    offsets[i] = set->data_.size();
+    set->data_.append(values[i]);
+  }
+  for (auto slot = 0; slot < numSlots; ++slot) {
+    if (slotValues[slot] >= 0) {
+      const auto i = slotValues[slot];
+      set->slots_[slot] = {
+          set->data_.data() + offsets[i],
+          static_cast<int64_t>(values[i].size())};
+    }
+  }
+  return set;
+}
+
+} // namespace facebook::velox::functions
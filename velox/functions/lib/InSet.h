@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/hash/Hash.h>
+#include <xsimd/xsimd.hpp>
+
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::functions {
+
+/// Sets bit i of 'result' to the result of testing values[i] for i in [0,
+/// numValues). Tests a batch of values at a time with 'batchTest', which
+/// takes an xsimd::batch<T> and returns an xsimd::batch_bool<T>, and the
+/// values after the last full word of bits one at a time with 'test'.
+template <typename T, typename BatchTest, typename Test>
+void testValuesInBatches(
+    const T* values,
+    int32_t numValues,
+    BatchTest batchTest,
+    Test test,
+    uint64_t* result) {
+  constexpr int32_t kLanes = xsimd::batch<T>::size;
+  static_assert(64 % kLanes == 0);
+  constexpr uint64_t kLaneMask =
+      kLanes == 64 ? ~0ULL : (1ULL << kLanes % 64) - 1;
+  int32_t row = 0;
+  for (; row + 64 <= numValues; row += 64) {
+    uint64_t word = 0;
+    for (auto i = 0; i < 64; i += kLanes) {
+      const auto mask = simd::toBitMask(
+          batchTest(xsimd::batch<T>::load_unaligned(values + row + i)));
+      word |= (static_cast<uint64_t>(mask) & kLaneMask) << i;
+    }
+    result[row / 64] = word;
+  }
+  for (; row < numValues; ++row) {
+    bits::setBit(result, row, test(values[row]));
+  }
+}
+
+/// IN list of at most kMaxValues integers. Compares a value with all the
+/// list values using SIMD instructions. For few values this is faster than
+/// probing a hash table or a bitmap and needs no virtual call per value.
+template <typename T>
+class SmallInSet {
+ public:
+  static constexpr int32_t kMaxValues = 16;
+
+  /// @param values Unique values. Must contain 1 to kMaxValues entries.
+  explicit SmallInSet(const std::vector<T>& values)
+      : numValues_(values.size()) {
+    VELOX_CHECK(!values.empty(), "values must not be empty");
+    VELOX_CHECK_LE(values.size(), kMaxValues);
+    // Pads with the first value so that full batches can be compared.
+    for (auto i = 0; i < kPaddedSize; ++i) {
+      values_[i] = values[i < numValues_ ? i : 0];
+    }
+  }
+
+  bool contains(T value) const {
+    const auto x = xsimd::broadcast<T>(value);
+    for (auto i = 0; i < numValues_; i += kLanes) {
+      if (xsimd::any(x == xsimd::batch<T>::load_aligned(values_ + i))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Returns the lanes of 'x' that are in the list.
+  xsimd::batch_bool<T> testValues(xsimd::batch<T> x) const {
+    auto result = x == xsimd::broadcast<T>(values_[0]);
+    for (auto i = 1; i < numValues_; ++i) {
+      result = result | (x == xsimd::broadcast<T>(values_[i]));
+    }
+    return result;
+  }
+
+  /// Sets bit i of 'result' to whether values[i] is in the list for i in [0,
+  /// numValues).
+  void testValues(const T* values, int32_t numValues, uint64_t* result)
+      const {
+    testValuesInBatches(
+        values,
+        numValues,
+        [&](xsimd::batch<T> x) { return testValues(x); },
+        [&](T value) { return contains(value); },
+        result);
+  }
+
+ private:
+  static constexpr int32_t kLanes = xsimd::batch<T>::size;
+  static constexpr int32_t kPaddedSize =
+      (kMaxValues + kLanes - 1) / kLanes * kLanes;
+
+  const int32_t numValues_;
+  alignas(xsimd::default_arch::alignment()) T values_[kPaddedSize];
+};
+
+/// Set of strings with a perfect hash function found by the hash and
+/// displace method: the strings are divided into buckets by their hash and
+/// each bucket gets a seed that maps its strings to free slots of a table
+/// with twice as many slots as strings. A lookup hashes the value once and
+/// compares it with the string in a single slot, without probing.
+class StringPerfectHashSet {
+ public:
+  /// Returns nullptr if no seed is found for some bucket within a bounded
+  /// number of tries, e.g. if two strings have the same hash.
+  /// @param values Unique values. Must not be empty.
+  static std::unique_ptr<StringPerfectHashSet> create(
+      const std::vector<std::string_view>& values);
+
+  bool contains(std::string_view value) const {
+    const uint64_t hash = folly::hasher<std::string_view>()(value);
+    const auto& slot =
+        slots_[bits::hashMix(hash, seeds_[(hash >> 32) & bucketMask_]) &
+               slotMask_];
+    return slot.size == static_cast<int64_t>(value.size()) &&
+        std::memcmp(slot.data, value.data(), value.size()) == 0;
+  }
+
+  size_t size() const {
+    return numValues_;
+  }
+
+ private:
+  struct Slot {
+    const char* data{nullptr};
+    // -1 for an empty slot so that no value matches it.
+    int64_t size{-1};
+  };
+
+  StringPerfectHashSet() = default;
+
+  // Copy of the strings 'slots_' point to.
+  std::string data_;
+  std::vector<uint64_t> seeds_;
+  std::vector<Slot> slots_;
+  uint64_t bucketMask_{0};
+  uint64_t slotMask_{0};
+  size_t numValues_{0};
+};
+
+} // namespace facebook::velox::functions
@@ -644,16 +644,25 @@ void KllSketch<T, A, C>::mergeViews(const folly::Range<const View*>& others) {
               &other.items[other.levels[lvl]] + sz);
         }
       }
-      int outIndex = worklevels[lvl];
-      while (!pq.empty()) {
+      // A level of one or two sketches is copied or merged without the heap.
+      auto* out = workbuf.data() + worklevels[lvl];
+      if (pq.size() == 1) {
+        out = std::copy(pq.top().first, pq.top().second, out);
+      } else if (pq.size() == 2) {
         auto [s, t] = pq.top();
         pq.pop();
-        workbuf[outIndex++] = *s++;
-        if (s < t) {
-          pq.emplace(s, t);
+        out = std::merge(s, t, pq.top().first, pq.top().second, out, C());
+      } else {
+        while (!pq.empty()) {
+          auto [s, t] = pq.top();
+          pq.pop();
+          *out++ = *s++;
+          if (s < t) {
+            pq.emplace(s, t);
+          }
         }
       }
-      worklevels[lvl + 1] = outIndex;
+      worklevels[lvl + 1] = out - workbuf.data();
     }
     auto result = detail::generalCompress<T, C>(
         k_,
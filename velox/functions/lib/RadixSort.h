@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "velox/common/base/Scratch.h"
+
+namespace facebook::velox::functions {
+
+/// Arrays of fixed-width values with at least this many elements are sorted
+/// with radixSort() instead of std::sort.
+constexpr int32_t kMinRadixSortSize = 256;
+
+/// True if radixSort() supports T. BOOLEAN is sorted by counting bits.
+template <typename T>
+constexpr bool kRadixSortable =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8) ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+namespace detail {
+
+template <int32_t kSize>
+struct RadixKey;
+
+template <>
+struct RadixKey<1> {
+  using type = uint8_t;
+};
+
+template <>
+struct RadixKey<2> {
+  using type = uint16_t;
+};
+
+template <>
+struct RadixKey<4> {
+  using type = uint32_t;
+};
+
+template <>
+struct RadixKey<8> {
+  using type = uint64_t;
+};
+
+// Maps 'value' to an unsigned integer that orders the same way.
+template <typename T, typename Key>
+inline Key toRadixKey(T value) {
+  constexpr Key kSignBit = Key(1) << (sizeof(Key) * 8 - 1);
+  Key key;
+  std::memcpy(&key, &value, sizeof(Key));
+  if constexpr (std::is_floating_point_v<T>) {
+    return (key & kSignBit) ? ~key : key | kSignBit;
+  } else if constexpr (std::is_signed_v<T>) {
+    return key ^ kSignBit;
+  } else {
+    return key;
+  }
+}
+
+template <typename T, typename Key>
+inline T fromRadixKey(Key key) {
+  constexpr Key kSignBit = Key(1) << (sizeof(Key) * 8 - 1);
+  if constexpr (std::is_floating_point_v<T>) {
+    key = (key & kSignBit) ? key ^ kSignBit : ~key;
+  } else if constexpr (std::is_signed_v<T>) {
+    key ^= kSignBit;
+  }
+  T value;
+  std::memcpy(&value, &key, sizeof(Key));
+  return value;
+}
+
+} // namespace detail
+
+/// Sorts 'size' 'values' in place with a least significant digit first radix
+/// sort on bytes. Bytes that are the same in all values take no pass, so that
+/// values of a small range sort in few passes. NaNs are larger than all other
+/// values and are moved to the end, or to the start if not 'ascending', before
+/// sorting the rest. -0.0 is before 0.0 in ascending order. Temporary space
+/// is leased from 'scratch'.
+template <typename T>
+void radixSort(T* values, int32_t size, bool ascending, Scratch& scratch) {
+  static_assert(kRadixSortable<T>);
+  using Key = typename detail::RadixKey<sizeof(T)>::type;
+  if constexpr (std::is_floating_point_v<T>) {
+    auto* notNan = ascending
+        ? std::partition(
+              values, values + size, [](T value) { return !std::isnan(value); })
+        : std::partition(
+              values, values + size, [](T value) { return std::isnan(value); });
+    if (ascending) {
+      size = notNan - values;
+    } else {
+      size -= notNan - values;
+      values = notNan;
+    }
+  }
+  if (size < 2) {
+    return;
+  }
+
+  ScratchPtr<Key> keysHolder(scratch);
+  ScratchPtr<Key> otherKeysHolder(scratch);
+  Key* keys = keysHolder.get(size);
+  Key* otherKeys = otherKeysHolder.get(size);
+  // Flipping all bits of the keys sorts in descending order.
+  const Key flip = ascending ? Key(0) : ~Key(0);
+  std::array<std::array<int32_t, 256>, sizeof(Key)> counts{};
+  for (auto i = 0; i < size; ++i) {
+    const Key key = detail::toRadixKey<T, Key>(values[i]) ^ flip;
+    keys[i] = key;
+    for (auto byte = 0; byte < sizeof(Key); ++byte) {
+      ++counts[byte][(key >> (byte * 8)) & 0xff];
+    }
+  }
+  for (auto byte = 0; byte < sizeof(Key); ++byte) {
+    auto& byteCounts = counts[byte];
+    const auto shift = byte * 8;
+    if (byteCounts[(keys[0] >> shift) & 0xff] == size) {
+      continue;
+    }
+    int32_t offset = 0;
+    for (auto& count : byteCounts) {
+      const auto numKeys = count;
+      count = offset;
+      offset += numKeys;
+    }
+    for (auto i = 0; i < size; ++i) {
+      otherKeys[byteCounts[(keys[i] >> shift) & 0xff]++] = keys[i];
+    }
+    std::swap(keys, otherKeys);
+  }
+  for (auto i = 0; i < size; ++i) {
+    values[i] = detail::fromRadixKey<T, Key>(keys[i] ^ flip);
+  }
+}
+
+} // namespace facebook::velox::functions
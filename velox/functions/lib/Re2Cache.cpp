@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/Re2Cache.h"
+
+#include <folly/hash/Hash.h>
+
+namespace facebook::velox::functions {
+
+// static
+Re2Cache* Re2Cache::getInstance() {
+  static Re2Cache instance;
+  return &instance;
+}
+
+size_t Re2Cache::KeyHasher::operator()(const Key& key) const {
+  return folly::hash::hash_combine(
+      std::hash<std::string>()(key.pattern),
+      key.parseFlags,
+      key.longestMatch,
+      key.maxMem);
+}
+
+// static
+int64_t Re2Cache::estimateMemory(const RE2& re) {
+  // Approximate size of a compiled instruction.
+  constexpr int64_t kBytesPerInstruction = 16;
+  return sizeof(RE2) + re.pattern().size() +
+      re.ProgramSize() * kBytesPerInstruction;
+}
+
+std::shared_ptr<const RE2> Re2Cache::findOrCompile(
+    std::string_view pattern,
+    const RE2::Options& options) {
+  Key key{
+      std::string(pattern),
+      options.ParseFlags(),
+      options.longest_match(),
+      options.max_mem()};
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      ++stats_.numHits;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->re;
+    }
+    ++stats_.numMisses;
+  }
+
+  // Compiles outside of the lock. Another thread may compile the same pattern
+  // at the same time, in which case the first one to finish is cached.
+  auto re = std::make_shared<const RE2>(
+      re2::StringPiece(pattern.data(), pattern.size()), options);
+  if (!re->ok()) {
+    return re;
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->re;
+  }
+  const auto memoryBytes = estimateMemory(*re);
+  lru_.push_front(Entry{key, re, memoryBytes});
+  entries_.emplace(std::move(key), lru_.begin());
+  ++stats_.numEntries;
+  stats_.memoryBytes += memoryBytes;
+  evictLocked();
+  return re;
+}
+
+void Re2Cache::setMaxMemoryBytes(int64_t maxMemoryBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  maxMemoryBytes_ = maxMemoryBytes;
+  evictLocked();
+}
+
+void Re2Cache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  stats_.numEntries = 0;
+  stats_.memoryBytes = 0;
+}
+
+Re2Cache::Stats Re2Cache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+void Re2Cache::evictLocked() {
+  while (stats_.memoryBytes > maxMemoryBytes_ && !lru_.empty()) {
+    auto& entry = lru_.back();
+    stats_.memoryBytes -= entry.memoryBytes;
+    --stats_.numEntries;
+    ++stats_.numEvictions;
+    entries_.erase(entry.key);
+    lru_.pop_back();
+  }
+}
+
+} // namespace facebook::velox::functions
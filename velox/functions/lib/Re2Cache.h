@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <re2/re2.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace facebook::velox::functions {
+
+/// Process-wide cache of compiled regular expressions. Function instances of
+/// all drivers and queries that use the same pattern share one compiled RE2,
+/// which is thread-safe for matching, instead of compiling their own copy.
+/// The least recently used expressions are evicted when the estimated memory
+/// of the cached expressions exceeds a limit. An evicted expression stays
+/// alive while a function instance uses it.
+class Re2Cache {
+ public:
+  struct Stats {
+    int64_t numHits{0};
+    int64_t numMisses{0};
+    int64_t numEvictions{0};
+    int64_t numEntries{0};
+    int64_t memoryBytes{0};
+  };
+
+  static constexpr int64_t kDefaultMaxMemoryBytes = 64 << 20;
+
+  explicit Re2Cache(int64_t maxMemoryBytes = kDefaultMaxMemoryBytes)
+      : maxMemoryBytes_(maxMemoryBytes) {}
+
+  static Re2Cache* getInstance();
+
+  /// Returns 'pattern' compiled with 'options'. The result may not be ok().
+  /// Expressions that fail to compile are not cached.
+  std::shared_ptr<const RE2> findOrCompile(
+      std::string_view pattern,
+      const RE2::Options& options);
+
+  /// Sets the memory limit and evicts entries to fit.
+  void setMaxMemoryBytes(int64_t maxMemoryBytes);
+
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct Key {
+    std::string pattern;
+    int32_t parseFlags;
+    bool longestMatch;
+    int64_t maxMem;
+
+    bool operator==(const Key& other) const {
+      return parseFlags == other.parseFlags &&
+          longestMatch == other.longestMatch && maxMem == other.maxMem &&
+          pattern == other.pattern;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const RE2> re;
+    int64_t memoryBytes;
+  };
+
+  // Returns the estimated memory of 're'. The program size is known after
+  // compilation. The DFA memory that matching adds later is bounded by the
+  // max_mem option of 're'.
+  static int64_t estimateMemory(const RE2& re);
+
+  // Evicts the least recently used entries until the cached memory is within
+  // 'maxMemoryBytes_'.
+  void evictLocked();
+
+  mutable std::mutex mutex_;
+  int64_t maxMemoryBytes_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<Key, std::list<Entry>::iterator, KeyHasher> entries_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::functions
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/functions/lib/Re2Cache.h"
 #include "velox/functions/lib/string/StringImpl.h"
 
 #include <re2/re2.h>
@@ -34,14 +35,24 @@ re2::StringPiece toStringPiece(const T& s) {
   return re2::StringPiece(s.data(), s.size());
 }
 
-// A cache of compiled regular expressions (RE2 instances). Allows up to
-// 'kMaxCompiledRegexes' different expressions.
+// Returns 'pattern' compiled with 'options' from the process-wide cache.
+std::shared_ptr<const RE2> compileShared(
+    const StringView& pattern,
+    const RE2::Options& options = RE2::Options(RE2::Quiet)) {
+  return Re2Cache::getInstance()->findOrCompile(
+      std::string_view(pattern.data(), pattern.size()), options);
+}
+
+// The regular expressions (RE2 instances) used by a function instance. Allows
+// up to 'kMaxCompiledRegexes' different expressions.
 //
 // Compiling regular expressions is expensive. It can take up to 200 times
-// more CPU time to compile a regex vs. evaluate it.
+// more CPU time to compile a regex vs. evaluate it. The compiled expressions
+// come from Re2Cache, so that instances of the same function in different
+// drivers compile a pattern once.
 class ReCache {
  public:
-  RE2* findOrCompile(const StringView& pattern) {
+  const RE2* findOrCompile(const StringView& pattern) {
     const std::string key = pattern;
 
     auto reIt = cache_.find(key);
@@ -52,7 +63,7 @@ class ReCache {
     VELOX_USER_CHECK_LT(
         cache_.size(), kMaxCompiledRegexes, "Max number of regex reached");
 
-    auto re = std::make_unique<RE2>(toStringPiece(pattern), RE2::Quiet);
+    auto re = compileShared(pattern);
     checkForBadPattern(*re);
 
     auto [it, inserted] = cache_.emplace(key, std::move(re));
@@ -62,7 +73,7 @@ class ReCache {
   }
 
  private:
-  folly::F14FastMap<std::string, std::unique_ptr<RE2>> cache_;
+  folly::F14FastMap<std::string, std::shared_ptr<const RE2>> cache_;
 };
 
 std::string printTypesCsv(
@@ -204,7 +215,7 @@ template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
   explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(compileShared(pattern)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -216,19 +227,19 @@ class Re2MatchConstantPattern final : public exec::VectorFunction {
     FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception& e) {
       context.setErrors(rows, std::current_exception());
       return;
     }
 
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-      result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
+      result.set(i, Fn(toSearch->valueAt<StringView>(i), *re_));
     });
   }
 
  private:
-  RE2 re_;
+  const std::shared_ptr<const RE2> re_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
@@ -272,7 +283,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
   explicit Re2SearchAndExtractConstantPattern(
       StringView pattern,
       bool emptyNoMatch)
-      : re_(toStringPiece(pattern), RE2::Quiet), emptyNoMatch_(emptyNoMatch) {}
+      : re_(compileShared(pattern)), emptyNoMatch_(emptyNoMatch) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -287,7 +298,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
 
     // apply() will not be invoked if the selection is empty.
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception& e) {
       context.setErrors(rows, std::current_exception());
       return;
@@ -301,7 +312,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |=
-            re2Extract(result, i, re_, toSearch, groups, 0, emptyNoMatch_);
+            re2Extract(result, i, *re_, toSearch, groups, 0, emptyNoMatch_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -311,7 +322,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
 
     if (const auto groupId = getIfConstant<T>(*args[2])) {
       try {
-        checkForBadGroupId(*groupId, re_);
+        checkForBadGroupId(*groupId, *re_);
       } catch (const std::exception& e) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -320,7 +331,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
       groups.resize(*groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |= re2Extract(
-            result, i, re_, toSearch, groups, *groupId, emptyNoMatch_);
+            result, i, *re_, toSearch, groups, *groupId, emptyNoMatch_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -332,12 +343,12 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
     // number of capturing groups + 1.
     exec::LocalDecodedVector groupIds(context, *args[2], rows);
 
-    groups.resize(re_.NumberOfCapturingGroups() + 1);
+    groups.resize(re_->NumberOfCapturingGroups() + 1);
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
       T group = groupIds->valueAt<T>(i);
-      checkForBadGroupId(group, re_);
+      checkForBadGroupId(group, *re_);
       mustRefSourceStrings |=
-          re2Extract(result, i, re_, toSearch, groups, group, emptyNoMatch_);
+          re2Extract(result, i, *re_, toSearch, groups, group, emptyNoMatch_);
     });
     if (mustRefSourceStrings) {
       result.acquireSharedStringBuffers(toSearch->base());
@@ -345,7 +356,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
   }
 
  private:
-  RE2 re_;
+  const std::shared_ptr<const RE2> re_;
   const bool emptyNoMatch_;
 };
 
@@ -811,9 +822,8 @@ class LikeWithRe2 final : public exec::VectorFunction {
   LikeWithRe2(StringView pattern, std::optional<char> escapeChar) {
     RE2::Options opt{RE2::Quiet};
     opt.set_dot_nl(true);
-    re_.emplace(
-        toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
-        opt);
+    re_ = compileShared(
+        StringView(likePatternToRe2(pattern, escapeChar, validPattern_)), opt);
   }
 
   void apply(
@@ -865,7 +875,7 @@ class LikeWithRe2 final : public exec::VectorFunction {
   }
 
  private:
-  std::optional<RE2> re_;
+  std::shared_ptr<const RE2> re_;
   bool validPattern_;
 };
 
@@ -979,7 +989,7 @@ class LikeGeneric final : public exec::VectorFunction {
   }
 
  private:
-  RE2* findOrCompileRegex(
+  const RE2* findOrCompileRegex(
       const StringView& pattern,
       std::optional<char> escapeChar) const {
     const auto key =
@@ -1003,7 +1013,7 @@ class LikeGeneric final : public exec::VectorFunction {
 
     RE2::Options opt{RE2::Quiet};
     opt.set_dot_nl(true);
-    auto re = std::make_unique<RE2>(toStringPiece(regex), opt);
+    auto re = compileShared(StringView(regex), opt);
     checkForBadPattern(*re);
 
     auto [it, inserted] =
@@ -1015,7 +1025,7 @@ class LikeGeneric final : public exec::VectorFunction {
 
   mutable folly::F14FastMap<
       std::pair<std::string, std::optional<char>>,
-      std::unique_ptr<RE2>>
+      std::shared_ptr<const RE2>>
       compiledRegularExpressions_;
 };
 
@@ -1056,7 +1066,7 @@ template <typename T>
 class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
  public:
   explicit Re2ExtractAllConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(compileShared(pattern)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -1066,7 +1076,7 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
       VectorPtr& resultRef) const final {
     VELOX_CHECK(args.size() == 2 || args.size() == 3);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception& e) {
       context.setErrors(rows, std::current_exception());
       return;
@@ -1085,13 +1095,13 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
       //
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, 0);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, 0);
       });
     } else if (const auto _groupId = getIfConstant<T>(*args[2])) {
       // Case 2: Constant groupId
       //
       try {
-        checkForBadGroupId(*_groupId, re_);
+        checkForBadGroupId(*_groupId, *re_);
       } catch (const std::exception& e) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -1099,18 +1109,18 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
 
       groups.resize(*_groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, *_groupId);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, *_groupId);
       });
     } else {
       // Case 3: Variable groupId, so resize the groups vector to accommodate
       // number of capturing groups + 1.
       exec::LocalDecodedVector groupIds(context, *args[2], rows);
 
-      groups.resize(re_.NumberOfCapturingGroups() + 1);
+      groups.resize(re_->NumberOfCapturingGroups() + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
         const T groupId = groupIds->valueAt<T>(row);
-        checkForBadGroupId(groupId, re_);
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, groupId);
+        checkForBadGroupId(groupId, *re_);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, groupId);
       });
     }
 
@@ -1123,7 +1133,7 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
   }
 
  private:
-  RE2 re_;
+  const std::shared_ptr<const RE2> re_;
 };
 
 template <typename T>
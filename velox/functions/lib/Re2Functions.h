@@ -22,6 +22,7 @@
 
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/Udf.h"
+#include "velox/functions/lib/Re2Cache.h"
 #include "velox/vector/BaseVector.h"
 
 namespace facebook::velox::functions {
@@ -257,7 +258,7 @@ struct Re2RegexpReplace {
 
   std::string processedReplacement_;
   std::string result_;
-  std::optional<RE2> re_;
+  std::shared_ptr<const RE2> re_;
 
   FOLLY_ALWAYS_INLINE void initialize(
       const core::QueryConfig& config,
@@ -272,7 +273,8 @@ struct Re2RegexpReplace {
 
     auto processedPattern = prepareRegexpPattern(*pattern);
 
-    re_.emplace(processedPattern, RE2::Quiet);
+    re_ = Re2Cache::getInstance()->findOrCompile(
+        processedPattern, RE2::Options(RE2::Quiet));
     if (UNLIKELY(!re_->ok())) {
       VELOX_USER_FAIL(
           "Invalid regular expression {}: {}.", processedPattern, re_->error());
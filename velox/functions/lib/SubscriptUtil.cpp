@@ -43,6 +43,40 @@ struct SimpleType<TypeKind::VARCHAR> {
   using type = Varchar;
 };
 
+// Index over the keys of the maps of a MapVector for one batch. Shared by the
+// subscripts of the same base map, e.g. m['a'] and m['b'], through
+// EvalCtx::batchCacheEntry().
+struct BatchMapIndex {
+  // Keeps the base map alive while the index refers to it.
+  VectorPtr map;
+  std::shared_ptr<LookupTableBase> lookupTable;
+};
+
+// Returns the index of the keys of 'baseMap' for the current batch or
+// nullptr if the index is not worth making. The index is made on the second
+// subscript of the same base map in the batch, or on the first if
+// 'manyLookups' is true, i.e. if each map may be looked up several times.
+template <TypeKind kind>
+LookupTable<kind>* batchLookupTable(
+    const VectorPtr& mapArg,
+    const BaseVector* baseMap,
+    bool manyLookups,
+    exec::EvalCtx& context) {
+  static const char kTag = 0;
+  auto& entry = context.batchCacheEntry(&kTag, baseMap);
+  if (entry == nullptr) {
+    entry = std::make_shared<BatchMapIndex>(BatchMapIndex{mapArg, nullptr});
+    if (!manyLookups) {
+      return nullptr;
+    }
+  }
+  auto& index = *std::static_pointer_cast<BatchMapIndex>(entry);
+  if (!index.lookupTable) {
+    index.lookupTable = std::make_shared<LookupTable<kind>>(*context.pool());
+  }
+  return &index.lookupTable->typedTable<kind>();
+}
+
 /// Decode arguments and transform result into a dictionaryVector where the
 /// dictionary maintains a mapping from a given row to the index of the input
 /// map value vector. This allows us to ensure that element_at is zero-copy.
@@ -57,15 +91,6 @@ VectorPtr applyMapTyped(
   static constexpr vector_size_t kMinCachedMapSize = 100;
   using TKey = typename TypeTraits<kind>::NativeType;
 
-  if (triggeCaching) {
-    if (!cachedLookupTablePtr) {
-      cachedLookupTablePtr =
-          std::make_shared<LookupTable<kind>>(*context.pool());
-    }
-  }
-
-  auto& typedLookupTable = cachedLookupTablePtr->typedTable<kind>();
-
   auto* pool = context.pool();
   BufferPtr indices = allocateIndices(rows.end(), pool);
   auto rawIndices = indices->asMutable<vector_size_t>();
@@ -90,67 +115,100 @@ VectorPtr applyMapTyped(
   // Get index vector (second argument).
   exec::LocalDecodedVector indexHolder(context, *indexArg, rows);
   auto decodedIndices = indexHolder.get();
+  const bool constantKey = decodedIndices->isConstantMapping();
+
+  // The keys are looked up in a hash table if the same base map is seen in
+  // several batches, or in one batch by several subscripts or by several rows
+  // with different keys.
+  LookupTable<kind>* lookupTable = nullptr;
+  if (triggeCaching) {
+    if (!cachedLookupTablePtr) {
+      cachedLookupTablePtr =
+          std::make_shared<LookupTable<kind>>(*context.pool());
+    }
+    lookupTable = &cachedLookupTablePtr->typedTable<kind>();
+  } else {
+    lookupTable = batchLookupTable<kind>(
+        mapArg,
+        baseMap,
+        !constantKey && !decodedMap->isIdentityMapping(),
+        context);
+  }
 
   auto rawSizes = baseMap->rawSizes();
   auto rawOffsets = baseMap->rawOffsets();
 
-  // Lambda that does the search for a key, for each row.
-  auto processRow = [&](vector_size_t row, TKey searchKey) {
-    size_t mapIndex = mapIndices[row];
-    auto size = rawSizes[mapIndex];
-    size_t offsetStart = rawOffsets[mapIndex];
-    size_t offsetEnd = offsetStart + size;
-    bool found = false;
+  // Returns the offset of 'searchKey' in the map at 'mapIndex' or -1.
+  auto findKey = [&](vector_size_t mapIndex, TKey searchKey) -> vector_size_t {
+    const auto size = rawSizes[mapIndex];
+    const vector_size_t offsetStart = rawOffsets[mapIndex];
+    const vector_size_t offsetEnd = offsetStart + size;
 
-    if (triggeCaching && size >= kMinCachedMapSize) {
+    if (lookupTable != nullptr && size >= kMinCachedMapSize) {
       // Create map for mapIndex if not created.
-      if (!typedLookupTable.containsMapAtIndex(mapIndex)) {
-        typedLookupTable.ensureMapAtIndex(mapIndex);
+      if (!lookupTable->containsMapAtIndex(mapIndex)) {
+        lookupTable->ensureMapAtIndex(mapIndex);
         // Materialize the map at index row.
-        auto& map = typedLookupTable.getMapAtIndex(mapIndex);
-        for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
+        auto& map = lookupTable->getMapAtIndex(mapIndex);
+        for (auto offset = offsetStart; offset < offsetEnd; ++offset) {
           map.emplace(decodedMapKeys->valueAt<TKey>(offset), offset);
         }
       }
 
-      auto& map = typedLookupTable.getMapAtIndex(mapIndex);
+      auto& map = lookupTable->getMapAtIndex(mapIndex);
 
       // Fast lookup.
       auto value = map.find(searchKey);
-      if (value != map.end()) {
-        rawIndices[row] = value->second;
-        found = true;
-      }
+      return value != map.end() ? value->second : -1;
+    }
 
-    } else {
-      // Search map without caching.
-      for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
-        if (decodedMapKeys->valueAt<TKey>(offset) == searchKey) {
-          rawIndices[row] = offset;
-          found = true;
-          break;
-        }
+    // Search map without caching.
+    for (auto offset = offsetStart; offset < offsetEnd; ++offset) {
+      if (decodedMapKeys->valueAt<TKey>(offset) == searchKey) {
+        return offset;
       }
     }
+    return -1;
+  };
 
-    // Handle NULLs.
-    if (!found) {
+  // Sets the result for 'row' to the value at 'offset'.
+  auto setResult = [&](vector_size_t row, vector_size_t offset) {
+    if (offset >= 0) {
+      rawIndices[row] = offset;
+    } else {
+      // Handle NULLs.
       nullsBuilder.setNull(row);
     }
   };
 
   // When second argument ("at") is a constant.
-  if (decodedIndices->isConstantMapping()) {
+  if (constantKey) {
     auto searchKey = decodedIndices->valueAt<TKey>(0);
-    rows.applyToSelected(
-        [&](vector_size_t row) { processRow(row, searchKey); });
+    if (decodedMap->isIdentityMapping()) {
+      rows.applyToSelected([&](vector_size_t row) {
+        setResult(row, findKey(row, searchKey));
+      });
+    } else {
+      // Rows of a dictionary may refer to the same map. Each map is searched
+      // once.
+      static constexpr vector_size_t kNotSearched = -2;
+      std::vector<vector_size_t> foundOffsets(baseMap->size(), kNotSearched);
+      rows.applyToSelected([&](vector_size_t row) {
+        const auto mapIndex = mapIndices[row];
+        auto& offset = foundOffsets[mapIndex];
+        if (offset == kNotSearched) {
+          offset = findKey(mapIndex, searchKey);
+        }
+        setResult(row, offset);
+      });
+    }
   }
 
   // When the second argument ("at") is also a variable vector.
   else {
     rows.applyToSelected([&](vector_size_t row) {
       auto searchKey = decodedIndices->valueAt<TKey>(row);
-      processRow(row, searchKey);
+      setResult(row, findKey(mapIndices[row], searchKey));
     });
   }
 
@@ -83,6 +83,14 @@ class AverageAggregateBase : public exec::Aggregate {
     return sizeof(SumCount<TAccumulator>);
   }
 
+  DenseKind denseKind() const override {
+    if constexpr (std::is_same_v<TAccumulator, double>) {
+      return DenseKind::kAvg;
+    } else {
+      return DenseKind::kNone;
+    }
+  }
+
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
@@ -147,10 +147,7 @@ class DecimalAggregate : public exec::Aggregate {
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      sumValues(data, rows, accumulator);
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
@@ -315,6 +312,40 @@ class DecimalAggregate : public exec::Aggregate {
     accumulator->mergeWith(serialized);
   }
 
+  // Adds the values of 'rows' to 'accumulator' with a branch-free loop.
+  // Short decimals are summed into an int128_t, which can not overflow for
+  // any number of rows. Long decimals are summed into an int128_t that
+  // wraps around, with each wrap around counted as 2 overflows of 2^127.
+  // The result is then normalized so that adjustSumForOverflow() and
+  // computeAverage() see the same sum and overflow as if every value had
+  // been added with DecimalUtil::addWithOverflow().
+  static void sumValues(
+      const TInputType* data,
+      const SelectivityVector& rows,
+      LongDecimalWithOverflowState& accumulator) {
+    int128_t sum = 0;
+    int64_t overflow = 0;
+    if constexpr (std::is_same_v<TInputType, int64_t>) {
+      rows.applyToSelected([&](vector_size_t i) { sum += data[i]; });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        const int128_t value = data[i];
+        const bool wrapped = __builtin_add_overflow(sum, value, &sum);
+        overflow += wrapped * (value < 0 ? -2 : 2);
+      });
+      constexpr int128_t kMax = std::numeric_limits<int128_t>::max();
+      if (overflow > 0 && sum < 0) {
+        --overflow;
+        sum = sum + kMax + 1;
+      } else if (overflow < 0 && sum > 0) {
+        ++overflow;
+        sum = sum - kMax - 1;
+      }
+    }
+    accumulator.overflow += overflow +
+        DecimalUtil::addWithOverflow(accumulator.sum, accumulator.sum, sum);
+  }
+
   template <bool tableHasNulls = true>
   void updateNonNullValue(char* group, TResultType value) {
     if constexpr (tableHasNulls) {
@@ -43,6 +43,18 @@ class SumAggregateBase
     return 1;
   }
 
+  exec::Aggregate::DenseKind denseKind() const override {
+    if constexpr (std::is_same_v<TAccumulator, int64_t> && !Overflow) {
+      return exec::Aggregate::DenseKind::kCheckedSum;
+    } else if constexpr (
+        std::is_same_v<TAccumulator, int64_t> ||
+        std::is_floating_point_v<TAccumulator>) {
+      return exec::Aggregate::DenseKind::kSum;
+    } else {
+      return exec::Aggregate::DenseKind::kNone;
+    }
+  }
+
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
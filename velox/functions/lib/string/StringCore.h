@@ -15,11 +15,14 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <string_view>
+#include <xsimd/xsimd.hpp>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 #if (ENABLE_VECTORIZATION > 0) && !defined(_DEBUG) && !defined(DEBUG)
@@ -44,11 +47,127 @@
 namespace facebook::velox::functions {
 namespace stringCore {
 
+/// Number of bytes that the UTF-8 functions check for ASCII at a time. Blocks
+/// of ASCII are processed without decoding code points.
+constexpr size_t kAsciiBlockSize = 64;
+
+/// Returns true if the kAsciiBlockSize bytes at 'str' are ASCII.
+FOLLY_ALWAYS_INLINE bool isAsciiBlock(const char* str) {
+  using Batch = xsimd::batch<int8_t>;
+  static_assert(kAsciiBlockSize % Batch::size == 0);
+  auto* data = reinterpret_cast<const int8_t*>(str);
+  auto bits = Batch::load_unaligned(data);
+  for (auto i = Batch::size; i < kAsciiBlockSize; i += Batch::size) {
+    bits |= Batch::load_unaligned(data + i);
+  }
+  // Non-ASCII bytes have the sign bit set.
+  return xsimd::none(bits < Batch(0));
+}
+
+/// Returns the number of leading bytes of 'str' that are in whole blocks of
+/// kAsciiBlockSize ASCII bytes.
+FOLLY_ALWAYS_INLINE size_t asciiBlocksPrefix(const char* str, size_t length) {
+  size_t i = 0;
+  while (i + kAsciiBlockSize <= length && isAsciiBlock(str + i)) {
+    i += kAsciiBlockSize;
+  }
+  return i;
+}
+
+/// Returns the position of the first 'byte' in the 'size' bytes at 'data' or
+/// 'size' if there is none. Compares a SIMD batch of bytes at a time.
+FOLLY_ALWAYS_INLINE size_t
+findByte(const char* data, size_t size, char byte) {
+  using Batch = xsimd::batch<int8_t>;
+  const Batch target(static_cast<int8_t>(byte));
+  auto* bytes = reinterpret_cast<const int8_t*>(data);
+  size_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    const uint64_t mask =
+        simd::toBitMask(Batch::load_unaligned(bytes + i) == target);
+    if (mask != 0) {
+      return i + __builtin_ctzll(mask);
+    }
+  }
+  for (; i < size; ++i) {
+    if (data[i] == byte) {
+      return i;
+    }
+  }
+  return size;
+}
+
+/// Returns the position of the first byte in the 'size' bytes at 'data' that
+/// is one of 'kBytes' or 'size' if there is none.
+template <char... kBytes>
+FOLLY_ALWAYS_INLINE size_t findFirstOf(const char* data, size_t size) {
+  using Batch = xsimd::batch<int8_t>;
+  auto* bytes = reinterpret_cast<const int8_t*>(data);
+  size_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    const auto batch = Batch::load_unaligned(bytes + i);
+    const uint64_t mask = simd::toBitMask(
+        ((batch == Batch(static_cast<int8_t>(kBytes))) | ...));
+    if (mask != 0) {
+      return i + __builtin_ctzll(mask);
+    }
+  }
+  for (; i < size; ++i) {
+    if (((data[i] == kBytes) || ...)) {
+      return i;
+    }
+  }
+  return size;
+}
+
+/// Returns the number of 'byte' in the 'size' bytes at 'data'.
+FOLLY_ALWAYS_INLINE size_t
+countByte(const char* data, size_t size, char byte) {
+  using Batch = xsimd::batch<int8_t>;
+  const Batch target(static_cast<int8_t>(byte));
+  auto* bytes = reinterpret_cast<const int8_t*>(data);
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    const uint64_t mask =
+        simd::toBitMask(Batch::load_unaligned(bytes + i) == target);
+    count += __builtin_popcountll(mask);
+  }
+  for (; i < size; ++i) {
+    count += data[i] == byte;
+  }
+  return count;
+}
+
+/// Returns the position of the first 'delimiter' in 'input' at or after 'pos'
+/// or std::string_view::npos if there is none. Single-byte delimiters are
+/// found with findByte().
+FOLLY_ALWAYS_INLINE size_t findDelimiter(
+    std::string_view input,
+    std::string_view delimiter,
+    size_t pos = 0) {
+  if (delimiter.size() != 1) {
+    return input.find(delimiter, pos);
+  }
+  if (pos >= input.size()) {
+    return std::string_view::npos;
+  }
+  const auto found =
+      pos + findByte(input.data() + pos, input.size() - pos, delimiter[0]);
+  return found == input.size() ? std::string_view::npos : found;
+}
+
 /// Check if a given string is ascii
 static bool isAscii(const char* str, size_t length);
 
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
+  size_t i = 0;
+  for (; i + kAsciiBlockSize <= length; i += kAsciiBlockSize) {
+    if (!isAsciiBlock(str + i)) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
     if (str[i] & 0x80) {
       return false;
     }
@@ -126,6 +245,13 @@ FOLLY_ALWAYS_INLINE size_t upperUnicode(
   auto outputIdx = 0;
 
   while (inputIdx < inputLength) {
+    if (inputLength - inputIdx >= kAsciiBlockSize &&
+        isAsciiBlock(input + inputIdx)) {
+      upperAscii(output + outputIdx, input + inputIdx, kAsciiBlockSize);
+      inputIdx += kAsciiBlockSize;
+      outputIdx += kAsciiBlockSize;
+      continue;
+    }
     utf8proc_int32_t nextCodePoint;
     int size;
     nextCodePoint =
@@ -166,6 +292,13 @@ FOLLY_ALWAYS_INLINE size_t lowerUnicode(
   auto outputIdx = 0;
 
   while (inputIdx < inputLength) {
+    if (inputLength - inputIdx >= kAsciiBlockSize &&
+        isAsciiBlock(input + inputIdx)) {
+      lowerAscii(output + outputIdx, input + inputIdx, kAsciiBlockSize);
+      inputIdx += kAsciiBlockSize;
+      outputIdx += kAsciiBlockSize;
+      continue;
+    }
     utf8proc_int32_t nextCodePoint;
     int size;
     nextCodePoint =
@@ -222,10 +355,18 @@ lengthUnicode(const char* inputBuffer, size_t bufferLength) {
   auto currentChar = inputBuffer;
   int64_t size = 0;
   while (currentChar < buffEndAddress) {
-    auto chrOffset = utf8proc_char_length(currentChar);
-    // Skip bad byte if we get utf length < 0.
-    currentChar += UNLIKELY(chrOffset < 0) ? 1 : chrOffset;
-    size++;
+    const auto numAscii =
+        asciiBlocksPrefix(currentChar, buffEndAddress - currentChar);
+    currentChar += numAscii;
+    size += numAscii;
+    // Decodes the block that is not ASCII.
+    auto blockEnd = currentChar + kAsciiBlockSize;
+    while (currentChar < buffEndAddress && currentChar < blockEnd) {
+      auto chrOffset = utf8proc_char_length(currentChar);
+      // Skip bad byte if we get utf length < 0.
+      currentChar += UNLIKELY(chrOffset < 0) ? 1 : chrOffset;
+      size++;
+    }
   }
   return size;
 }
@@ -255,10 +396,18 @@ cappedLengthUnicode(const char* input, size_t size, size_t maxChars) {
   // Use maxChars to early stop to avoid calculating the whole
   // length of long string.
   while (currentChar < end && numChars < maxChars) {
-    auto charSize = utf8proc_char_length(currentChar);
-    // Skip bad byte if we get utf length < 0.
-    currentChar += UNLIKELY(charSize < 0) ? 1 : charSize;
-    numChars++;
+    const auto numAscii = std::min<size_t>(
+        asciiBlocksPrefix(currentChar, end - currentChar), maxChars - numChars);
+    currentChar += numAscii;
+    numChars += numAscii;
+    auto blockEnd = currentChar + kAsciiBlockSize;
+    while (currentChar < end && currentChar < blockEnd &&
+           numChars < maxChars) {
+      auto charSize = utf8proc_char_length(currentChar);
+      // Skip bad byte if we get utf length < 0.
+      currentChar += UNLIKELY(charSize < 0) ? 1 : charSize;
+      numChars++;
+    }
   }
 
   return numChars;
@@ -284,9 +433,18 @@ cappedByteLengthUnicode(const char* input, size_t size, int64_t maxChars) {
   size_t utf8Position = 0;
   size_t numCharacters = 0;
   while (utf8Position < size && numCharacters < maxChars) {
-    auto charSize = utf8proc_char_length(input + utf8Position);
-    utf8Position += UNLIKELY(charSize < 0) ? 1 : charSize;
-    numCharacters++;
+    const auto numAscii = std::min<size_t>(
+        asciiBlocksPrefix(input + utf8Position, size - utf8Position),
+        maxChars - numCharacters);
+    utf8Position += numAscii;
+    numCharacters += numAscii;
+    auto blockEnd = utf8Position + kAsciiBlockSize;
+    while (utf8Position < size && utf8Position < blockEnd &&
+           numCharacters < maxChars) {
+      auto charSize = utf8proc_char_length(input + utf8Position);
+      utf8Position += UNLIKELY(charSize < 0) ? 1 : charSize;
+      numCharacters++;
+    }
   }
   return utf8Position;
 }
@@ -446,7 +446,7 @@ FOLLY_ALWAYS_INLINE bool splitPart(
   }
   while (curPos <= inputSv.size()) {
     size_t start = curPos;
-    curPos = inputSv.find(delim, curPos);
+    curPos = stringCore::findDelimiter(inputSv, delim, curPos);
     if (iteration == index) {
       size_t end = curPos;
       if (end == std::string_view::npos) {
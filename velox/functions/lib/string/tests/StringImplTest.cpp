@@ -196,6 +196,55 @@ TEST_F(StringImplTest, cappedLength) {
   ASSERT_EQ(cappedLength</*isAscii*/ false>(input, 7), 5);
 }
 
+TEST_F(StringImplTest, mixedAsciiBlocks) {
+  // Long runs of ASCII are processed in blocks. Checks the results against
+  // processing each character.
+  std::string ascii(kAsciiBlockSize * 2 + 5, 'a');
+  for (auto i = 0; i < ascii.size(); i += 7) {
+    ascii[i] = 'B';
+  }
+  for (const auto& input : std::vector<std::string>{
+           ascii,
+           ascii + "é" + ascii,
+           "ü" + ascii + "你好" + ascii.substr(3) + "Ω",
+           ascii.substr(0, kAsciiBlockSize - 1) + "é" + ascii}) {
+    ASSERT_EQ(isAscii(input.data(), input.size()), input == ascii);
+
+    int64_t numChars = 0;
+    std::string expectedUpper;
+    std::string expectedLower;
+    auto append = [](std::string& output, utf8proc_int32_t codePoint) {
+      unsigned char buffer[4];
+      auto size = utf8proc_encode_char(codePoint, buffer);
+      output.append(reinterpret_cast<const char*>(buffer), size);
+    };
+    for (auto i = 0; i < input.size(); ++numChars) {
+      int size;
+      auto codePoint =
+          utf8proc_codepoint(&input[i], input.data() + input.size(), size);
+      append(expectedUpper, utf8proc_toupper(codePoint));
+      append(expectedLower, utf8proc_tolower(codePoint));
+      i += size;
+    }
+    ASSERT_EQ(length</*isAscii*/ false>(input), numChars);
+    for (auto maxChars : {1, 63, 64, 65, 130, 1'000}) {
+      ASSERT_EQ(
+          cappedLength</*isAscii*/ false>(input, maxChars),
+          std::min<int64_t>(maxChars, numChars));
+      auto numBytes = cappedByteLength</*isAscii*/ false>(input, maxChars);
+      ASSERT_EQ(
+          length</*isAscii*/ false>(std::string_view(input.data(), numBytes)),
+          std::min<int64_t>(maxChars, numChars));
+    }
+
+    std::string output;
+    upper</*ascii*/ false>(output, input);
+    ASSERT_EQ(output, expectedUpper);
+    lower</*ascii*/ false>(output, input);
+    ASSERT_EQ(output, expectedLower);
+  }
+}
+
 TEST_F(StringImplTest, cappedUnicodeBytes) {
   // Test functions use case for indexing
   // UTF strings.
@@ -499,6 +548,31 @@ TEST_F(StringImplTest, stringPosition) {
       VeloxUserError);
 }
 
+TEST_F(StringImplTest, findByte) {
+  std::string input;
+  for (auto i = 0; i < 100; ++i) {
+    input += i % 7 == 3 ? ',' : static_cast<char>('a' + i % 26);
+  }
+  for (auto begin = 0; begin < input.size(); ++begin) {
+    const auto size = input.size() - begin;
+    const auto expected = input.find(',', begin);
+    ASSERT_EQ(
+        findByte(input.data() + begin, size, ','),
+        expected == std::string::npos ? size : expected - begin);
+    ASSERT_EQ(
+        countByte(input.data() + begin, size, ','),
+        static_cast<size_t>(
+            std::count(input.begin() + begin, input.end(), ',')));
+  }
+  ASSERT_EQ(findByte(input.data(), input.size(), '|'), input.size());
+
+  std::string_view view(input);
+  ASSERT_EQ(findDelimiter(view, ",", 4), size_t(10));
+  ASSERT_EQ(findDelimiter(view, ",a", 4), view.find(",a", 4));
+  ASSERT_EQ(findDelimiter(view, ",", input.size()), std::string_view::npos);
+  ASSERT_EQ(findDelimiter(view, "|"), std::string_view::npos);
+}
+
 TEST_F(StringImplTest, replace) {
   auto runTest = [](const std::string& string,
                     const std::string& replaced,
@@ -373,6 +373,82 @@ TEST_F(JodaDateTimeFormatterTest, validJodaBuild) {
           ->tokens());
 }
 
+TEST_F(JodaDateTimeFormatterTest, fixedWidthLayout) {
+  auto layout = buildJodaDateTimeFormatter("yyyy-MM-dd HH:mm:ss.SSS")
+                    ->fixedWidthLayout();
+  ASSERT_TRUE(layout.has_value());
+  EXPECT_EQ(layout->text, "0000-00-00 00:00:00.000");
+  EXPECT_EQ(layout->fields.size(), 7);
+  EXPECT_TRUE(layout->parsable);
+
+  EXPECT_FALSE(buildJodaDateTimeFormatter("yy-MM-dd")
+                   ->fixedWidthLayout()
+                   ->parsable);
+  EXPECT_FALSE(buildJodaDateTimeFormatter("yyyy'1'MM")
+                   ->fixedWidthLayout()
+                   ->parsable);
+  EXPECT_FALSE(
+      buildJodaDateTimeFormatter("yyyy-M-d")->fixedWidthLayout().has_value());
+  EXPECT_FALSE(buildJodaDateTimeFormatter("yyyy-MM-dd EEE")
+                   ->fixedWidthLayout()
+                   .has_value());
+  EXPECT_FALSE(buildJodaDateTimeFormatter("'abc'")
+                   ->fixedWidthLayout()
+                   .has_value());
+
+  // Formats the same as a pattern without a fixed width layout.
+  auto format = [](const std::string& pattern,
+                   const Timestamp& timestamp,
+                   const date::time_zone* timezone) {
+    auto formatter = buildJodaDateTimeFormatter(pattern);
+    const auto maxSize = formatter->maxResultSize(timezone);
+    std::string result(maxSize, '\0');
+    result.resize(
+        formatter->format(timestamp, timezone, maxSize, result.data()));
+    return result;
+  };
+  const auto* timezone = date::locate_zone("America/Los_Angeles");
+  for (const auto& pattern :
+       {"yyyy-MM-dd HH:mm:ss.SSS", "yy/MM/dd HH:mm", "yyyyMMddHHmmssSSSSSS"}) {
+    for (const auto& timestamp :
+         {Timestamp(0, 0),
+          Timestamp(-1, 999'000'000),
+          Timestamp(951'782'400, 123'456'789),
+          Timestamp(-62'135'596'800, 0),
+          Timestamp(-62'135'596'801, 0),
+          Timestamp(-62'167'219'201, 0),
+          Timestamp(253'402'300'799, 999'000'000),
+          Timestamp(-2'208'988'801, 1'000'000),
+          Timestamp(1'700'000'000, 0)}) {
+      for (const auto* tz : {(const date::time_zone*)nullptr, timezone}) {
+        auto expected = format(std::string(pattern) + " EEE", timestamp, tz);
+        expected.resize(expected.size() - 4);
+        EXPECT_EQ(expected, format(pattern, timestamp, tz))
+            << pattern << " " << timestamp.toString();
+      }
+    }
+  }
+
+  // Years that do not fit 4 digits are formatted by the tokens.
+  EXPECT_EQ(
+      "10000-01-01",
+      format("yyyy-MM-dd", Timestamp(253'402'300'800, 0), nullptr));
+
+  EXPECT_EQ(
+      util::fromTimestampString("2023-02-28 23:59:58.120"),
+      parseJoda("2023-02-28 23:59:58.12", "yyyy-MM-dd HH:mm:ss.SS").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("2000-12-31 00:00:00"),
+      parseJoda("12-31", "MM-dd").timestamp);
+  // Inputs that do not match the layout are parsed by the tokens.
+  EXPECT_EQ(
+      util::fromTimestampString("2023-02-08 03:09:08"),
+      parseJoda("2023-2-8 3:09:08", "yyyy-MM-dd HH:mm:ss").timestamp);
+  EXPECT_THROW(parseJoda("2023-02-30", "yyyy-MM-dd"), VeloxUserError);
+  EXPECT_THROW(parseJoda("2023-13-01", "yyyy-MM-dd"), VeloxUserError);
+  EXPECT_THROW(parseJoda("2023-01-0a", "yyyy-MM-dd"), VeloxUserError);
+}
+
 TEST_F(JodaDateTimeFormatterTest, invalidJodaBuild) {
   // Invalid specifiers
   EXPECT_THROW(buildJodaDateTimeFormatter("q"), VeloxUserError);
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/InSet.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace facebook::velox::functions {
+namespace {
+
+template <typename T>
+void testSmallInSet() {
+  for (auto numValues = 1; numValues <= SmallInSet<T>::kMaxValues;
+       ++numValues) {
+    std::vector<T> values;
+    for (auto i = 0; i < numValues; ++i) {
+      values.push_back(i * 7 - 20);
+    }
+    SmallInSet<T> set(values);
+    auto expected = [&](T value) {
+      return std::find(values.begin(), values.end(), value) != values.end();
+    };
+
+    std::vector<T> input;
+    for (auto i = -50; i < 100; ++i) {
+      input.push_back(i);
+    }
+    for (auto value : input) {
+      ASSERT_EQ(expected(value), set.contains(value)) << value;
+    }
+
+    std::vector<uint64_t> bits(bits::nwords(input.size()));
+    set.testValues(input.data(), input.size(), bits.data());
+    for (auto i = 0; i < input.size(); ++i) {
+      ASSERT_EQ(expected(input[i]), bits::isBitSet(bits.data(), i))
+          << numValues << " " << i;
+    }
+  }
+}
+
+TEST(InSetTest, smallInSet) {
+  testSmallInSet<int8_t>();
+  testSmallInSet<int16_t>();
+  testSmallInSet<int32_t>();
+  testSmallInSet<int64_t>();
+}
+
+TEST(InSetTest, stringPerfectHashSet) {
+  for (auto numValues : {1, 2, 3, 10, 100, 1'000, 10'000}) {
+    std::vector<std::string> strings;
+    for (auto i = 0; i < numValues; ++i) {
+      strings.push_back(fmt::format("string {}", i * 2));
+    }
+    strings[0] = "";
+    std::vector<std::string_view> values(strings.begin(), strings.end());
+    auto set = StringPerfectHashSet::create(values);
+    ASSERT_NE(set, nullptr) << numValues;
+    ASSERT_EQ(numValues, set->size());
+    for (auto i = 1; i < 2 * numValues; ++i) {
+      const auto value = fmt::format("string {}", i);
+      ASSERT_EQ(i % 2 == 0, set->contains(value)) << value;
+    }
+    ASSERT_TRUE(set->contains(""));
+    ASSERT_FALSE(set->contains("string"));
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions
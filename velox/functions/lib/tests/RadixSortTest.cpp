@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+
+#include "velox/functions/lib/RadixSort.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+template <typename T>
+void testRadixSort(std::vector<T> values) {
+  Scratch scratch;
+  for (auto ascending : {true, false}) {
+    auto expected = values;
+    std::sort(expected.begin(), expected.end(), [&](T left, T right) {
+      return ascending ? left < right : right < left;
+    });
+    auto actual = values;
+    radixSort(actual.data(), actual.size(), ascending, scratch);
+    ASSERT_EQ(expected, actual) << (ascending ? "ascending" : "descending");
+  }
+}
+
+TEST(RadixSortTest, integers) {
+  std::mt19937 rng(1);
+  std::vector<int64_t> int64s;
+  std::vector<int32_t> int32s;
+  std::vector<int16_t> int16s;
+  std::vector<int8_t> int8s;
+  for (auto i = 0; i < 5'000; ++i) {
+    int64s.push_back(static_cast<int64_t>(rng()) << 32 | rng());
+    int32s.push_back(static_cast<int32_t>(rng()));
+    int16s.push_back(static_cast<int16_t>(rng()));
+    int8s.push_back(static_cast<int8_t>(rng()));
+  }
+  int64s.push_back(std::numeric_limits<int64_t>::min());
+  int64s.push_back(std::numeric_limits<int64_t>::max());
+  testRadixSort(int64s);
+  testRadixSort(int32s);
+  testRadixSort(int16s);
+  testRadixSort(int8s);
+
+  // A small range of values only takes a pass over the low byte.
+  std::vector<int64_t> smallRange;
+  for (auto i = 0; i < 1'000; ++i) {
+    smallRange.push_back(1'000'000 + rng() % 200);
+  }
+  testRadixSort(smallRange);
+  testRadixSort(std::vector<int64_t>(300, 7));
+  testRadixSort(std::vector<int32_t>{});
+}
+
+TEST(RadixSortTest, floatingPoint) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+  std::vector<double> doubles;
+  std::vector<float> floats;
+  for (auto i = 0; i < 5'000; ++i) {
+    doubles.push_back(distribution(rng));
+    floats.push_back(distribution(rng));
+  }
+  doubles.push_back(std::numeric_limits<double>::infinity());
+  doubles.push_back(-std::numeric_limits<double>::infinity());
+  doubles.push_back(std::numeric_limits<double>::denorm_min());
+  doubles.push_back(std::numeric_limits<double>::lowest());
+  testRadixSort(doubles);
+  testRadixSort(floats);
+
+  // NaNs are last in ascending order and first in descending order.
+  constexpr auto kNan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> withNans = {3.0, kNan, -1.0, kNan, 2.5, -kNan, 0.0};
+  Scratch scratch;
+  auto values = withNans;
+  radixSort(values.data(), values.size(), true, scratch);
+  EXPECT_EQ(
+      (std::vector<double>(values.begin(), values.begin() + 4)),
+      (std::vector<double>{-1.0, 0.0, 2.5, 3.0}));
+  for (auto i = 4; i < values.size(); ++i) {
+    EXPECT_TRUE(std::isnan(values[i]));
+  }
+  values = withNans;
+  radixSort(values.data(), values.size(), false, scratch);
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_TRUE(std::isnan(values[i]));
+  }
+  EXPECT_EQ(
+      (std::vector<double>(values.begin() + 3, values.end())),
+      (std::vector<double>{3.0, 2.5, 0.0, -1.0}));
+}
+
+} // namespace
+} // namespace facebook::velox::functions
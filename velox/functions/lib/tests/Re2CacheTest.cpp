@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/Re2Cache.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace facebook::velox::functions {
+namespace {
+
+TEST(Re2CacheTest, share) {
+  Re2Cache cache;
+  const RE2::Options options(RE2::Quiet);
+  auto re = cache.findOrCompile("a.*b", options);
+  ASSERT_TRUE(re->ok());
+  ASSERT_EQ(cache.findOrCompile("a.*b", options), re);
+  ASSERT_TRUE(RE2::FullMatch("axxb", *re));
+
+  // Different options give a different expression.
+  RE2::Options dotNl(RE2::Quiet);
+  dotNl.set_dot_nl(true);
+  auto other = cache.findOrCompile("a.*b", dotNl);
+  ASSERT_NE(other, re);
+  ASSERT_TRUE(RE2::FullMatch("a\nb", *other));
+  ASSERT_FALSE(RE2::FullMatch("a\nb", *re));
+
+  // Invalid patterns are not cached.
+  ASSERT_FALSE(cache.findOrCompile("a(b", options)->ok());
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(stats.numHits, 1);
+  ASSERT_EQ(stats.numMisses, 3);
+  ASSERT_EQ(stats.numEntries, 2);
+  ASSERT_GT(stats.memoryBytes, 0);
+
+  cache.clear();
+  ASSERT_EQ(cache.stats().numEntries, 0);
+  ASSERT_EQ(cache.stats().memoryBytes, 0);
+}
+
+TEST(Re2CacheTest, evict) {
+  Re2Cache cache;
+  const RE2::Options options(RE2::Quiet);
+  auto first = cache.findOrCompile("first.*", options);
+  const auto entryBytes = cache.stats().memoryBytes;
+  cache.setMaxMemoryBytes(entryBytes * 3);
+  cache.findOrCompile("second.*", options);
+  cache.findOrCompile("third.*", options);
+
+  // Makes 'first' the most recently used.
+  ASSERT_EQ(cache.findOrCompile("first.*", options), first);
+  cache.findOrCompile("fourth.*", options);
+  auto stats = cache.stats();
+  ASSERT_GE(stats.numEvictions, 1);
+  ASSERT_LE(stats.memoryBytes, entryBytes * 3);
+  ASSERT_EQ(cache.findOrCompile("first.*", options), first);
+
+  // An evicted expression stays valid while used.
+  cache.setMaxMemoryBytes(0);
+  ASSERT_EQ(cache.stats().numEntries, 0);
+  ASSERT_TRUE(RE2::FullMatch("first one", *first));
+}
+
+TEST(Re2CacheTest, concurrent) {
+  Re2Cache cache;
+  std::vector<std::thread> threads;
+  std::vector<std::shared_ptr<const RE2>> results(8);
+  for (auto i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = 0; j < 100; ++j) {
+        results[i] = cache.findOrCompile(
+            fmt::format("pattern{}.*", j % 10), RE2::Options(RE2::Quiet));
+        ASSERT_TRUE(results[i]->ok());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(cache.stats().numEntries, 10);
+  for (const auto& result : results) {
+    ASSERT_EQ(result, results[0]);
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions
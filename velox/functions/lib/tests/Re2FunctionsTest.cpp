@@ -1471,5 +1471,25 @@ TEST_F(Re2FunctionsTest, limit) {
   ASSERT_NO_THROW(evaluate("regexp_like(c0, c2)", data));
 }
 
+TEST_F(Re2FunctionsTest, sharedCompiledRegex) {
+  // Function instances of different expressions use the same compiled
+  // expressions.
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          100, [](auto row) { return fmt::format("abc{}x", row % 10); }),
+      makeFlatVector<std::string>(
+          100, [](auto row) { return fmt::format("abc{}.*", row % 10); }),
+  });
+  Re2Cache::getInstance()->clear();
+  evaluate("regexp_like(c0, c1)", data);
+  const auto numMisses = Re2Cache::getInstance()->stats().numMisses;
+  const auto numHits = Re2Cache::getInstance()->stats().numHits;
+  auto result = evaluate("regexp_like(c0, c1)", data);
+  assertEqualVectors(
+      makeFlatVector<bool>(100, [](auto /*row*/) { return true; }), result);
+  ASSERT_EQ(Re2Cache::getInstance()->stats().numMisses, numMisses);
+  ASSERT_EQ(Re2Cache::getInstance()->stats().numHits, numHits + 10);
+}
+
 } // namespace
 } // namespace facebook::velox::functions
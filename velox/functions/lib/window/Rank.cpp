@@ -109,7 +109,9 @@ void registerRankInternal(
           const core::QueryConfig& /*queryConfig*/)
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<RankFunction<TRank, TResult>>(resultType);
-      });
+      },
+      // percent_rank needs the number of rows in the partition.
+      {.supportsStreaming = TRank != RankType::kPercentRank});
 }
 
 void registerRankBigint(const std::string& name) {
@@ -29,6 +29,7 @@
 #include "folly/CPortability.h"
 #include "velox/common/base/Doubles.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/prestosql/ArithmeticImpl.h"
 
@@ -53,6 +54,14 @@ struct PlusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = plus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE int32_t
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    simd::transform(
+        [](auto x, auto y) { return x + y; }, size, result, a, b);
+    return size;
+  }
 };
 
 template <typename T>
@@ -62,6 +71,14 @@ struct MinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = minus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE int32_t
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    simd::transform(
+        [](auto x, auto y) { return x - y; }, size, result, a, b);
+    return size;
+  }
 };
 
 template <typename T>
@@ -71,6 +88,14 @@ struct MultiplyFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = multiply(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE int32_t
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    simd::transform(
+        [](auto x, auto y) { return x * y; }, size, result, a, b);
+    return size;
+  }
 };
 
 // Multiply function for IntervalDayTime * Double and Double * IntervalDayTime.
@@ -121,6 +146,14 @@ struct DivideFunction {
   {
     result = a / b;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE int32_t
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    simd::transform(
+        [](auto x, auto y) { return x / y; }, size, result, a, b);
+    return size;
+  }
 };
 
 template <typename T>
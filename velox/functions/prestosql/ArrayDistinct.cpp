@@ -16,10 +16,12 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/Scratch.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/prestosql/ArraySetUtil.h"
 
 namespace facebook::velox::functions {
 namespace {
@@ -98,29 +100,37 @@ class ArrayDistinctFunction : public exec::VectorFunction {
 
     // Process the rows: store unique values in the hash table.
     folly::F14FastSet<T> uniqueSet;
+    // Reused by all rows that are deduplicated by sorting.
+    Scratch scratch;
 
     rows.applyToSelected([&](vector_size_t row) {
       auto size = arrayVector->sizeAt(row);
       auto offset = arrayVector->offsetAt(row);
 
       rawOffsets[row] = indicesCursor;
-      bool hasNulls = false;
-      for (vector_size_t i = offset; i < offset + size; ++i) {
-        if (elements->isNullAt(i)) {
-          if (!hasNulls) {
-            hasNulls = true;
-            rawNewIndices[indicesCursor++] = i;
-          }
-        } else {
-          auto value = elements->valueAt<T>(i);
+      if (size <= kLinearSetMaxSize) {
+        applyLinear(*elements, offset, size, rawNewIndices, indicesCursor);
+      } else if (kSortableSetType<T> && size >= kSortedSetMinSize) {
+        applySorted(
+            *elements, offset, size, scratch, rawNewIndices, indicesCursor);
+      } else {
+        bool hasNulls = false;
+        for (vector_size_t i = offset; i < offset + size; ++i) {
+          if (elements->isNullAt(i)) {
+            if (!hasNulls) {
+              hasNulls = true;
+              rawNewIndices[indicesCursor++] = i;
+            }
+          } else {
+            auto value = elements->valueAt<T>(i);
 
-          if (uniqueSet.insert(value).second) {
-            rawNewIndices[indicesCursor++] = i;
+            if (uniqueSet.insert(value).second) {
+              rawNewIndices[indicesCursor++] = i;
+            }
           }
         }
+        uniqueSet.clear();
       }
-
-      uniqueSet.clear();
       rawSizes[row] = indicesCursor - rawOffsets[row];
     });
 
@@ -138,6 +148,70 @@ class ArrayDistinctFunction : public exec::VectorFunction {
         std::move(newElements),
         0);
   }
+
+  // Compares each element of a small array with the distinct elements found
+  // before it.
+  static void applyLinear(
+      const DecodedVector& elements,
+      vector_size_t offset,
+      vector_size_t size,
+      vector_size_t* rawNewIndices,
+      vector_size_t& indicesCursor) {
+    T distinct[kLinearSetMaxSize];
+    vector_size_t numDistinct = 0;
+    bool hasNulls = false;
+    for (vector_size_t i = offset; i < offset + size; ++i) {
+      if (elements.isNullAt(i)) {
+        if (!hasNulls) {
+          hasNulls = true;
+          rawNewIndices[indicesCursor++] = i;
+        }
+        continue;
+      }
+      const auto value = elements.valueAt<T>(i);
+      if (std::find(distinct, distinct + numDistinct, value) ==
+          distinct + numDistinct) {
+        distinct[numDistinct++] = value;
+        rawNewIndices[indicesCursor++] = i;
+      }
+    }
+  }
+
+  // Sorts the elements of a large array with their positions and keeps the
+  // first of each run of equal values. Sorted arrays are not sorted again.
+  static void applySorted(
+      const DecodedVector& elements,
+      vector_size_t offset,
+      vector_size_t size,
+      Scratch& scratch,
+      vector_size_t* rawNewIndices,
+      vector_size_t& indicesCursor) {
+    ScratchPtr<PositionedValue<T>> valuesHolder(scratch);
+    ScratchPtr<uint64_t> keepHolder(scratch);
+    auto* values = valuesHolder.get(size);
+    auto* keep = keepHolder.get(bits::nwords(size));
+    std::fill(keep, keep + bits::nwords(size), 0);
+
+    vector_size_t numValues = 0;
+    bool hasNulls = false;
+    for (vector_size_t i = 0; i < size; ++i) {
+      if (elements.isNullAt(offset + i)) {
+        if (!hasNulls) {
+          hasNulls = true;
+          bits::setBit(keep, i);
+        }
+      } else {
+        values[numValues++] = {elements.valueAt<T>(offset + i), i};
+      }
+    }
+    sortPositionedValues(values, numValues);
+    forEachRun(values, numValues, [&](auto begin, auto /*end*/) {
+      bits::setBit(keep, values[begin].second);
+    });
+    bits::forEachSetBit(keep, 0, size, [&](auto i) {
+      rawNewIndices[indicesCursor++] = offset + i;
+    });
+  }
 };
 
 // Validate number of parameters and types.
@@ -13,9 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/Scratch.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/prestosql/ArraySetUtil.h"
 
 namespace facebook::velox::functions {
 namespace {
@@ -209,6 +211,133 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
       rawNewLengths[row] = indicesCursor - rawNewOffsets[row];
     };
 
+    // Gathers the non-null elements of a right-hand side array into 'values'
+    // and returns their count. Sets 'hasNull' if the array has a null.
+    auto gatherRight = [](const ArrayVector* rightArray,
+                          const DecodedVector* rightElements,
+                          vector_size_t idx,
+                          T* values,
+                          bool& hasNull) {
+      const auto offset = rightArray->offsetAt(idx);
+      const auto size = rightArray->sizeAt(idx);
+      vector_size_t numValues = 0;
+      hasNull = false;
+      for (auto i = offset; i < offset + size; ++i) {
+        if (rightElements->isNullAt(i)) {
+          hasNull = true;
+        } else {
+          values[numValues++] = rightElements->valueAt<T>(i);
+        }
+      }
+      return numValues;
+    };
+
+    // Processes a row where both arrays are small by comparing each element
+    // with the elements of the right-hand side and of the output.
+    auto processRowLinear = [&](vector_size_t row,
+                                const ArrayVector* rightArray,
+                                const DecodedVector* rightElements,
+                                vector_size_t rightIdx) {
+      auto idx = decodedLeftArray->index(row);
+      auto size = baseLeftArray->sizeAt(idx);
+      auto offset = baseLeftArray->offsetAt(idx);
+
+      T rightValues[kLinearSetMaxSize];
+      bool rightHasNull;
+      const auto numRight = gatherRight(
+          rightArray, rightElements, rightIdx, rightValues, rightHasNull);
+      T outputValues[kLinearSetMaxSize];
+      vector_size_t numOutput = 0;
+      bool outputHasNull = false;
+
+      rawNewOffsets[row] = indicesCursor;
+      for (auto i = offset; i < offset + size; ++i) {
+        if (decodedLeftElements->isNullAt(i)) {
+          if (!outputHasNull && rightHasNull == isIntersect) {
+            bits::setNull(rawNewElementNulls, indicesCursor++, true);
+            outputHasNull = true;
+          }
+          continue;
+        }
+        const auto val = decodedLeftElements->valueAt<T>(i);
+        const bool found =
+            std::find(rightValues, rightValues + numRight, val) !=
+            rightValues + numRight;
+        if (found == isIntersect &&
+            std::find(outputValues, outputValues + numOutput, val) ==
+                outputValues + numOutput) {
+          outputValues[numOutput++] = val;
+          rawNewIndices[indicesCursor++] = i;
+        }
+      }
+      rawNewLengths[row] = indicesCursor - rawNewOffsets[row];
+    };
+
+    // Processes a row where both arrays are large by sorting both and merging
+    // them. The elements of the left-hand side are sorted with their
+    // positions so that the output keeps the order of the first occurrences.
+    Scratch scratch;
+    auto processRowSorted = [&](vector_size_t row,
+                                const ArrayVector* rightArray,
+                                const DecodedVector* rightElements,
+                                vector_size_t rightIdx) {
+      auto idx = decodedLeftArray->index(row);
+      auto size = baseLeftArray->sizeAt(idx);
+      auto offset = baseLeftArray->offsetAt(idx);
+
+      ScratchPtr<PositionedValue<T>> leftValuesHolder(scratch);
+      ScratchPtr<T> rightValuesHolder(scratch);
+      ScratchPtr<uint64_t> keepHolder(scratch);
+      auto* leftValues = leftValuesHolder.get(size);
+      auto* rightValues = rightValuesHolder.get(rightArray->sizeAt(rightIdx));
+      auto* keep = keepHolder.get(bits::nwords(size));
+      std::fill(keep, keep + bits::nwords(size), 0);
+
+      bool rightHasNull;
+      const auto numRight = gatherRight(
+          rightArray, rightElements, rightIdx, rightValues, rightHasNull);
+      if (!std::is_sorted(rightValues, rightValues + numRight)) {
+        std::sort(rightValues, rightValues + numRight);
+      }
+
+      vector_size_t numLeft = 0;
+      vector_size_t firstNull = -1;
+      for (vector_size_t i = 0; i < size; ++i) {
+        if (!decodedLeftElements->isNullAt(offset + i)) {
+          leftValues[numLeft++] = {
+              decodedLeftElements->valueAt<T>(offset + i), i};
+        } else if (firstNull < 0) {
+          firstNull = i;
+        }
+      }
+      if (firstNull >= 0 && rightHasNull == isIntersect) {
+        bits::setBit(keep, firstNull);
+      }
+      sortPositionedValues(leftValues, numLeft);
+      vector_size_t rightCursor = 0;
+      forEachRun(leftValues, numLeft, [&](auto begin, auto /*end*/) {
+        const auto& val = leftValues[begin].first;
+        while (rightCursor < numRight && rightValues[rightCursor] < val) {
+          ++rightCursor;
+        }
+        const bool found =
+            rightCursor < numRight && rightValues[rightCursor] == val;
+        if (found == isIntersect) {
+          bits::setBit(keep, leftValues[begin].second);
+        }
+      });
+
+      rawNewOffsets[row] = indicesCursor;
+      bits::forEachSetBit(keep, 0, size, [&](auto i) {
+        if (i == firstNull) {
+          bits::setNull(rawNewElementNulls, indicesCursor++, true);
+        } else {
+          rawNewIndices[indicesCursor++] = offset + i;
+        }
+      });
+      rawNewLengths[row] = indicesCursor - rawNewOffsets[row];
+    };
+
     SetWithNull<T> outputSet;
 
     // Optimized case when the right-hand side array is constant.
@@ -229,6 +358,21 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
       auto rightArrayVector = rightHolder.get()->base()->as<ArrayVector>();
       rows.applyToSelected([&](vector_size_t row) {
         auto idx = rightHolder.get()->index(row);
+        const auto leftSize =
+            baseLeftArray->sizeAt(decodedLeftArray->index(row));
+        const auto rightSize = rightArrayVector->sizeAt(idx);
+        if (leftSize <= kLinearSetMaxSize && rightSize <= kLinearSetMaxSize) {
+          processRowLinear(row, rightArrayVector, decodedRightElements, idx);
+          return;
+        }
+        if constexpr (kSortableSetType<T>) {
+          if (leftSize >= kSortedSetMinSize &&
+              rightSize >= kSortedSetMinSize) {
+            processRowSorted(
+                row, rightArrayVector, decodedRightElements, idx);
+            return;
+          }
+        }
         generateSet<T>(rightArrayVector, decodedRightElements, idx, rightSet);
         processRow(row, rightSet, outputSet);
       });
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/vector/TypeAliases.h"
+
+namespace facebook::velox::functions {
+
+/// Arrays of at most this many elements are deduplicated by comparing each
+/// element with the distinct elements before it. This is faster than hashing
+/// for small arrays.
+constexpr vector_size_t kLinearSetMaxSize = 16;
+
+/// Arrays of at least this many elements are deduplicated by sorting their
+/// elements together with their positions when the elements have a total
+/// order. This avoids the cache misses of a large hash table and takes a
+/// single pass without sorting when the array is sorted already.
+constexpr vector_size_t kSortedSetMinSize = 1'000;
+
+/// True if arrays of T may be deduplicated by sorting. Floating point values
+/// are hashed since NaN has no order.
+template <typename T>
+constexpr bool kSortableSetType = !std::is_floating_point_v<T>;
+
+/// A non-null element of an array and its position in the array.
+template <typename T>
+using PositionedValue = std::pair<T, vector_size_t>;
+
+/// Sorts 'values' by value and position unless they are sorted by value
+/// already. 'values' must be in position order.
+template <typename T>
+void sortPositionedValues(PositionedValue<T>* values, vector_size_t size) {
+  if (!std::is_sorted(
+          values, values + size, [](const auto& left, const auto& right) {
+            return left.first < right.first;
+          })) {
+    std::sort(values, values + size);
+  }
+}
+
+/// Calls 'func(begin, end)' for each run of equal values in 'values' sorted by
+/// sortPositionedValues(). The first element of a run is the first occurrence
+/// of the value in the array.
+template <typename T, typename Func>
+void forEachRun(
+    const PositionedValue<T>* values,
+    vector_size_t size,
+    Func func) {
+  vector_size_t begin = 0;
+  while (begin < size) {
+    auto end = begin + 1;
+    while (end < size && values[end].first == values[begin].first) {
+      ++end;
+    }
+    func(begin, end);
+    begin = end;
+  }
+}
+
+} // namespace facebook::velox::functions
@@ -20,6 +20,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
+#include "velox/functions/lib/RadixSort.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
 #include "velox/functions/prestosql/SimpleComparisonMatcher.h"
 
@@ -141,6 +142,8 @@ void applyScalarType(
       inputElements.get(), inputElementRows, /*toSourceRow=*/nullptr);
 
   auto flatResults = resultElements->asFlatVector<T>();
+  // Reused by all rows that are radix sorted.
+  Scratch scratch;
 
   auto processRow = [&](vector_size_t row) {
     const auto size = inputArray->sizeAt(row);
@@ -174,6 +177,16 @@ void applyScalarType(
       }
     } else {
       T* resultRawValues = flatResults->mutableRawValues();
+      if constexpr (kRadixSortable<T>) {
+        if (endRow - startRow >= kMinRadixSortSize) {
+          radixSort(
+              resultRawValues + startRow,
+              endRow - startRow,
+              ascending,
+              scratch);
+          return;
+        }
+      }
       if (ascending) {
         std::sort(resultRawValues + startRow, resultRawValues + endRow);
       } else {
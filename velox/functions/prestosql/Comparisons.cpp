@@ -231,6 +231,52 @@ class ComparisonSimdFunction : public exec::VectorFunction {
   bool supportsFlatNoNullsFastPath() const override {
     return true;
   }
+
+  bool supportsFlatKernel(
+      const std::vector<TypePtr>& argTypes) const override {
+    switch (argTypes[0]->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  void applyFlatKernel(
+      const std::vector<TypePtr>& argTypes,
+      const void* const* args,
+      vector_size_t size,
+      void* result) const override {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        applyKernel,
+        argTypes[0]->kind(),
+        args,
+        size,
+        static_cast<bool*>(result));
+  }
+
+ private:
+  template <TypeKind kind>
+  static void
+  applyKernel(const void* const* args, vector_size_t size, bool* result) {
+    using T = typename TypeTraits<kind>::NativeType;
+    if constexpr (
+        std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+        sizeof(T) <= sizeof(int64_t)) {
+      const auto* lhs = static_cast<const T*>(args[0]);
+      const auto* rhs = static_cast<const T*>(args[1]);
+      for (auto i = 0; i < size; ++i) {
+        result[i] = ComparisonOp()(lhs[i], rhs[i]);
+      }
+    } else {
+      VELOX_UNREACHABLE();
+    }
+  }
 };
 
 } // namespace
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/base/CompareFlags.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 
@@ -48,6 +49,21 @@ struct TimestampWithTimezoneComparisonSupport {
     FOLLY_ALWAYS_INLINE void                                       \
     call(TResult& result, const TInput& lhs, const TInput& rhs) {  \
       result = (Expr);                                             \
+    }                                                              \
+                                                                   \
+    template <typename TInput>                                     \
+    FOLLY_ALWAYS_INLINE int32_t callBatch(                         \
+        uint64_t* result,                                          \
+        const TInput* lhsValues,                                   \
+        const TInput* rhsValues,                                   \
+        int32_t size) {                                            \
+      simd::transformToBits<TInput>(                               \
+          [](auto lhs, auto rhs) { return (Expr); },               \
+          size,                                                    \
+          result,                                                  \
+          lhsValues,                                               \
+          rhsValues);                                              \
+      return size;                                                 \
     }                                                              \
   };
 
@@ -121,6 +137,17 @@ struct EqFunction {
     out = (lhs == rhs);
   }
 
+  template <typename TInput>
+  int32_t callBatch(
+      uint64_t* out,
+      const TInput* lhs,
+      const TInput* rhs,
+      int32_t size) {
+    simd::transformToBits<TInput>(
+        [](auto x, auto y) { return x == y; }, size, out, lhs, rhs);
+    return size;
+  }
+
   // For arbitrary nested complex types. Can return null.
   bool call(
       bool& out,
@@ -161,6 +188,17 @@ struct NeqFunction {
     out = (lhs != rhs);
   }
 
+  template <typename TInput>
+  int32_t callBatch(
+      uint64_t* out,
+      const TInput* lhs,
+      const TInput* rhs,
+      int32_t size) {
+    simd::transformToBits<TInput>(
+        [](auto x, auto y) { return x != y; }, size, out, lhs, rhs);
+    return size;
+  }
+
   // For arbitrary nested complex types. Can return null.
   bool call(
       bool& out,
@@ -198,6 +236,25 @@ struct BetweenFunction {
       const TInput& high) {
     result = value >= low && value <= high;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE int32_t callBatch(
+      uint64_t* result,
+      const TInput* values,
+      const TInput* lows,
+      const TInput* highs,
+      int32_t size) {
+    simd::transformToBits<TInput>(
+        [](auto value, auto low, auto high) {
+          return (value >= low) & (value <= high);
+        },
+        size,
+        result,
+        values,
+        lows,
+        highs);
+    return size;
+  }
 };
 
 } // namespace facebook::velox::functions
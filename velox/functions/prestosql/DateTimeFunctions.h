@@ -23,6 +23,7 @@
 #include "velox/type/TimestampConversion.h"
 #include "velox/type/Type.h"
 #include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneOffsets.h"
 
 namespace facebook::velox::functions {
 
@@ -1274,7 +1275,7 @@ struct FormatDateTimeFunction {
 
     const auto timestamp = unpackTimestampUtc(timestampWithTimezone);
     const auto timeZoneId = unpackZoneKeyId(timestampWithTimezone);
-    auto* timezonePtr = date::locate_zone(util::getTimeZoneName(timeZoneId));
+    auto* timezonePtr = &util::TimeZoneOffsets::get(timeZoneId).zone();
 
     auto maxResultSize = jodaDateTime_->maxResultSize(timezonePtr);
     result.reserve(maxResultSize);
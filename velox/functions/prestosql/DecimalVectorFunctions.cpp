@@ -37,8 +37,13 @@ template <
     typename Operation /* Arithmetic operation */>
 class DecimalBaseFunction : public exec::VectorFunction {
  public:
-  DecimalBaseFunction(uint8_t aRescale, uint8_t bRescale)
-      : aRescale_(aRescale), bRescale_(bRescale) {}
+  /// @param overflowFree True if no result can overflow the result precision
+  /// given the precisions of the arguments.
+  DecimalBaseFunction(
+      uint8_t aRescale,
+      uint8_t bRescale,
+      bool overflowFree = false)
+      : aRescale_(aRescale), bRescale_(bRescale), overflowFree_(overflowFree) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -47,6 +52,11 @@ class DecimalBaseFunction : public exec::VectorFunction {
       exec::EvalCtx& context,
       VectorPtr& result) const override {
     auto rawResults = prepareResults(rows, resultType, context, result);
+    if constexpr (Operation::kHasOverflowFreePath) {
+      if (overflowFree_ && applyOverflowFree(rows, args, rawResults)) {
+        return;
+      }
+    }
     if (args[0]->isConstantEncoding() && args[1]->isFlatEncoding()) {
       // Fast path for (const, flat).
       auto constant = args[0]->asUnchecked<SimpleVector<A>>()->valueAt(0);
@@ -102,8 +112,60 @@ class DecimalBaseFunction : public exec::VectorFunction {
     return result->asUnchecked<FlatVector<R>>()->mutableRawValues();
   }
 
+  // Computes the results with Operation::applyOverflowFree(), which has no
+  // overflow checks, and the rescale multipliers computed once per batch.
+  // When all rows are selected, the loop has no branches and no error
+  // handling so that the compiler can vectorize it. Returns false if an
+  // argument is not flat or constant.
+  bool applyOverflowFree(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      R* rawResults) const {
+    const auto& a = args[0];
+    const auto& b = args[1];
+    if (!(a->isFlatEncoding() || a->isConstantEncoding()) ||
+        !(b->isFlatEncoding() || b->isConstantEncoding()) ||
+        (a->isConstantEncoding() && b->isConstantEncoding())) {
+      return false;
+    }
+    const R aMultiplier = R(DecimalUtil::kPowersOfTen[aRescale_]);
+    const R bMultiplier = R(DecimalUtil::kPowersOfTen[bRescale_]);
+    auto compute = [&](auto aValueAt, auto bValueAt) {
+      if (rows.isAllSelected()) {
+        for (auto row = 0; row < rows.end(); ++row) {
+          rawResults[row] = Operation::template applyOverflowFree<R>(
+              R(aValueAt(row)), R(bValueAt(row)), aMultiplier, bMultiplier);
+        }
+      } else {
+        rows.applyToSelected([&](auto row) {
+          rawResults[row] = Operation::template applyOverflowFree<R>(
+              R(aValueAt(row)), R(bValueAt(row)), aMultiplier, bMultiplier);
+        });
+      }
+    };
+    if (a->isConstantEncoding()) {
+      const auto constant = a->asUnchecked<SimpleVector<A>>()->valueAt(0);
+      const auto* rawB = b->asUnchecked<FlatVector<B>>()->rawValues();
+      compute(
+          [&](auto) { return constant; }, [&](auto row) { return rawB[row]; });
+    } else if (b->isConstantEncoding()) {
+      const auto* rawA = a->asUnchecked<FlatVector<A>>()->rawValues();
+      const auto constant = b->asUnchecked<SimpleVector<B>>()->valueAt(0);
+      compute(
+          [&](auto row) { return rawA[row]; }, [&](auto) { return constant; });
+    } else {
+      const auto* rawA = a->asUnchecked<FlatVector<A>>()->rawValues();
+      const auto* rawB = b->asUnchecked<FlatVector<B>>()->rawValues();
+      compute(
+          [&](auto row) { return rawA[row]; },
+          [&](auto row) { return rawB[row]; });
+    }
+    return true;
+  }
+
   const uint8_t aRescale_;
   const uint8_t bRescale_;
+  const bool overflowFree_;
 };
 
 template <
@@ -292,6 +354,26 @@ class Addition {
     DecimalUtil::valueInRange(r);
   }
 
+  static constexpr bool kHasOverflowFreePath = true;
+
+  // Returns true if the sum of any two values fits the result precision
+  // before it is capped at 38 digits.
+  inline static bool isOverflowFree(
+      uint8_t aPrecision,
+      uint8_t aScale,
+      uint8_t bPrecision,
+      uint8_t bScale) {
+    return std::max(aPrecision - aScale, bPrecision - bScale) +
+        std::max(aScale, bScale) + 1 <=
+        LongDecimalType::kMaxPrecision;
+  }
+
+  template <typename R>
+  inline static R
+  applyOverflowFree(R a, R b, R aMultiplier, R bMultiplier) {
+    return a * aMultiplier + b * bMultiplier;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -334,6 +416,22 @@ class Subtraction {
     DecimalUtil::valueInRange(r);
   }
 
+  static constexpr bool kHasOverflowFreePath = true;
+
+  inline static bool isOverflowFree(
+      uint8_t aPrecision,
+      uint8_t aScale,
+      uint8_t bPrecision,
+      uint8_t bScale) {
+    return Addition::isOverflowFree(aPrecision, aScale, bPrecision, bScale);
+  }
+
+  template <typename R>
+  inline static R
+  applyOverflowFree(R a, R b, R aMultiplier, R bMultiplier) {
+    return a * aMultiplier - b * bMultiplier;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -360,6 +458,25 @@ class Multiply {
     DecimalUtil::valueInRange(r);
   }
 
+  static constexpr bool kHasOverflowFreePath = true;
+
+  // Returns true if the product of any two values fits the result precision
+  // before it is capped at 38 digits.
+  inline static bool isOverflowFree(
+      uint8_t aPrecision,
+      uint8_t /*aScale*/,
+      uint8_t bPrecision,
+      uint8_t /*bScale*/) {
+    return aPrecision + bPrecision <= LongDecimalType::kMaxPrecision;
+  }
+
+  // The arguments are not rescaled.
+  template <typename R>
+  inline static R
+  applyOverflowFree(R a, R b, R /*aMultiplier*/, R /*bMultiplier*/) {
+    return a * b;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return 0;
@@ -383,6 +500,18 @@ class Divide {
     DecimalUtil::valueInRange(r);
   }
 
+  // Division by zero must be reported and the rescaled dividend may
+  // overflow.
+  static constexpr bool kHasOverflowFreePath = false;
+
+  inline static bool isOverflowFree(
+      uint8_t /*aPrecision*/,
+      uint8_t /*aScale*/,
+      uint8_t /*bPrecision*/,
+      uint8_t /*bScale*/) {
+    return false;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale) {
     return rScale - fromScale + toScale;
@@ -650,6 +779,8 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
       aPrecision, aScale, bPrecision, bScale);
   uint8_t aRescale = Operation::computeRescaleFactor(aScale, bScale, rScale);
   uint8_t bRescale = Operation::computeRescaleFactor(bScale, aScale, rScale);
+  const bool overflowFree =
+      Operation::isOverflowFree(aPrecision, aScale, bPrecision, bScale);
   if (aType->isShortDecimal()) {
     if (bType->isShortDecimal()) {
       if (rPrecision > ShortDecimalType::kMaxPrecision) {
@@ -658,14 +789,14 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
             int128_t /*result*/,
             int64_t,
             int64_t,
-            Operation>>(aRescale, bRescale);
+            Operation>>(aRescale, bRescale, overflowFree);
       } else {
         // Arguments are short decimals and result is a short decimal.
         return std::make_shared<DecimalBaseFunction<
             int64_t /*result*/,
             int64_t,
             int64_t,
-            Operation>>(aRescale, bRescale);
+            Operation>>(aRescale, bRescale, overflowFree);
       }
     } else {
       if (rPrecision > ShortDecimalType::kMaxPrecision) {
@@ -675,7 +806,7 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
             int128_t /*result*/,
             int64_t,
             int128_t,
-            Operation>>(aRescale, bRescale);
+            Operation>>(aRescale, bRescale, overflowFree);
       } else {
         // In some cases such as division, the result type can still be a short
         // decimal even though RHS is a long decimal.
@@ -683,7 +814,7 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
             int64_t /*result*/,
             int64_t,
             int128_t,
-            Operation>>(aRescale, bRescale);
+            Operation>>(aRescale, bRescale, overflowFree);
       }
     }
   } else {
@@ -693,14 +824,14 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
           int128_t /*result*/,
           int128_t,
           int64_t,
-          Operation>>(aRescale, bRescale);
+          Operation>>(aRescale, bRescale, overflowFree);
     } else {
       // Arguments and result are all long decimals.
       return std::make_shared<DecimalBaseFunction<
           int128_t /*result*/,
           int128_t,
           int128_t,
-          Operation>>(aRescale, bRescale);
+          Operation>>(aRescale, bRescale, overflowFree);
     }
   }
   VELOX_UNSUPPORTED();
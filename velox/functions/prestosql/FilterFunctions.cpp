@@ -172,6 +172,120 @@ class ArrayFilterFunction : public FilterFunctionBase {
   }
 };
 
+// Evaluates transform(filter(array, x -> p(x)), x -> f(x)) in one pass
+// without making the filtered array. f is evaluated on the elements of
+// 'array' that pass p, in place, so that captures and errors map to the top
+// level rows by the layout of 'array' and f gets flat elements instead of a
+// dictionary. Calls are made by rewriteLambdaChain().
+class ArrayFilterTransformFunction : public FilterFunctionBase {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(args.size(), 3);
+    exec::LocalDecodedVector arrayDecoder(context, *args[0], rows);
+    auto& decodedArray = *arrayDecoder.get();
+
+    auto flatArray = flattenArray(rows, args[0], decodedArray);
+
+    VectorPtr elements = flatArray->elements();
+    const auto numElements = elements->size();
+    BufferPtr resultSizes;
+    BufferPtr resultOffsets;
+    BufferPtr selectedIndices;
+    const auto numSelected = doApply(
+        rows,
+        flatArray,
+        args[1],
+        {elements},
+        context,
+        resultOffsets,
+        resultSizes,
+        selectedIndices);
+
+    // Rows that failed the filter are not transformed.
+    exec::LocalSelectivityVector remainingRows(context, rows);
+    context.deselectErrors(*remainingRows);
+
+    const auto* rawSizes = resultSizes->as<vector_size_t>();
+    const auto* rawOffsets = resultOffsets->as<vector_size_t>();
+    const auto* rawSelected = selectedIndices->as<vector_size_t>();
+    // Sets the positions in 'elements' of the passing elements of 'arrayRows'.
+    auto toSelectedElementRows = [&](const SelectivityVector& arrayRows) {
+      SelectivityVector elementRows(numElements, false);
+      arrayRows.applyToSelected([&](auto row) {
+        if (flatArray->isNullAt(row)) {
+          return;
+        }
+        for (auto i = 0; i < rawSizes[row]; ++i) {
+          elementRows.setValid(rawSelected[rawOffsets[row] + i], true);
+        }
+      });
+      elementRows.updateBounds();
+      return elementRows;
+    };
+
+    VectorPtr newElements;
+    if (numSelected > 0) {
+      const auto validRowsInReusedResult =
+          toSelectedElementRows(*remainingRows);
+      auto elementToTopLevelRows = getElementToTopLevelRows(
+          numElements, *remainingRows, flatArray.get(), context.pool());
+      std::vector<VectorPtr> lambdaArgs = {elements};
+      auto it = args[2]->asUnchecked<FunctionVector>()->iterator(
+          remainingRows.get());
+      while (auto entry = it.next()) {
+        const auto elementRows = toSelectedElementRows(*entry.rows);
+        auto wrapCapture = toWrapCapture<ArrayVector>(
+            numElements, entry.callable, *entry.rows, flatArray);
+        entry.callable->apply(
+            elementRows,
+            &validRowsInReusedResult,
+            wrapCapture,
+            &context,
+            lambdaArgs,
+            elementToTopLevelRows,
+            &newElements);
+      }
+    }
+
+    auto wrappedElements = newElements
+        ? BaseVector::wrapInDictionary(
+              BufferPtr(nullptr),
+              std::move(selectedIndices),
+              numSelected,
+              std::move(newElements))
+        : BaseVector::create(
+              outputType->childAt(0), 0, context.pool());
+    // Set nulls for rows not present in 'rows'.
+    BufferPtr newNulls = addNullsForUnselectedRows(flatArray, rows);
+    auto localResult = std::make_shared<ArrayVector>(
+        flatArray->pool(),
+        outputType,
+        std::move(newNulls),
+        rows.end(),
+        std::move(resultOffsets),
+        std::move(resultSizes),
+        wrappedElements);
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // array(T), function(T,boolean), function(T,U) -> array(U)
+    return {exec::FunctionSignatureBuilder()
+                .typeVariable("T")
+                .typeVariable("U")
+                .returnType("array(U)")
+                .argumentType("array(T)")
+                .argumentType("function(T,boolean)")
+                .argumentType("function(T,U)")
+                .build()};
+  }
+};
+
 // See documentation at
 //    - https://prestodb.io/docs/current/functions/map.html
 //    - https://prestodb.io/docs/current/functions/lambda.html
@@ -247,6 +361,11 @@ VELOX_DECLARE_VECTOR_FUNCTION(
     ArrayFilterFunction::signatures(),
     std::make_unique<ArrayFilterFunction>());
 
+VELOX_DECLARE_VECTOR_FUNCTION(
+    udf_array_filter_transform,
+    ArrayFilterTransformFunction::signatures(),
+    std::make_unique<ArrayFilterTransformFunction>());
+
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_map_filter,
     MapFilterFunction::signatures(),
@@ -184,23 +184,33 @@ class FromUtf8Function : public exec::VectorFunction {
       const SelectivityVector& rows) {
     std::optional<vector_size_t> firstInvalidRow;
     rows.testSelected([&](auto row) {
-      auto value = decodedInput.valueAt<StringView>(row);
+      if (!isValidUtf8(decodedInput.valueAt<StringView>(row))) {
+        firstInvalidRow = row;
+        return false;
+      }
+      return true;
+    });
+    return firstInvalidRow;
+  }
 
-      int32_t pos = 0;
-      while (pos < value.size()) {
-        auto charLength =
-            tryGetCharLength(value.data() + pos, value.size() - pos);
+  // Returns true if 'value' is valid UTF-8. Blocks of ASCII are checked
+  // without decoding the characters.
+  static bool isValidUtf8(StringView value) {
+    const auto* data = value.data();
+    const int32_t size = value.size();
+    int32_t pos = 0;
+    while (pos < size) {
+      pos += stringCore::asciiBlocksPrefix(data + pos, size - pos);
+      const int32_t blockEnd = pos + stringCore::kAsciiBlockSize;
+      while (pos < size && pos < blockEnd) {
+        auto charLength = tryGetCharLength(data + pos, size - pos);
         if (charLength < 0) {
-          firstInvalidRow = row;
           return false;
         }
-
         pos += charLength;
       }
-
-      return true;
-    });
-    return firstInvalidRow;
+    }
+    return true;
   }
 
   void toVarcharNoCopy(
@@ -266,7 +276,19 @@ class FromUtf8Function : public exec::VectorFunction {
     }
 
     int32_t pos = 0;
+    int32_t blockEnd = 0;
     while (pos < input.size()) {
+      if (pos >= blockEnd) {
+        // Appends the blocks of ASCII as is.
+        const auto numAscii = stringCore::asciiBlocksPrefix(
+            input.data() + pos, input.size() - pos);
+        if (numAscii > 0) {
+          fixedWriter.append(std::string_view(input.data() + pos, numAscii));
+          pos += numAscii;
+        }
+        blockEnd = pos + stringCore::kAsciiBlockSize;
+        continue;
+      }
       auto charLength =
           tryGetCharLength(input.data() + pos, input.size() - pos);
       if (charLength > 0) {
@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <variant>
+
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/lib/InSet.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::functions {
@@ -325,10 +328,54 @@ std::pair<std::unique_ptr<common::Filter>, bool> createBytesValuesFilter(
   return {std::make_unique<common::BytesValues>(values, nullAllowed), false};
 }
 
+using SmallSet = std::variant<
+    std::monostate,
+    SmallInSet<int8_t>,
+    SmallInSet<int16_t>,
+    SmallInSet<int32_t>,
+    SmallInSet<int64_t>>;
+
+// Returns a SmallInSet for an integer IN list of at most
+// SmallInSet::kMaxValues non-null values, std::monostate otherwise.
+template <typename T>
+SmallSet createSmallInSet(
+    const VectorPtr& valuesVector,
+    vector_size_t offset,
+    vector_size_t size) {
+  if (size > SmallInSet<T>::kMaxValues) {
+    return std::monostate();
+  }
+  auto values = toValues<T, T>(valuesVector, offset, size).first;
+  if (values.empty()) {
+    return std::monostate();
+  }
+  return SmallInSet<T>(values);
+}
+
+// Returns a StringPerfectHashSet for the values of a BytesValues filter or
+// nullptr if 'filter' is of another kind or no perfect hash is found.
+std::unique_ptr<StringPerfectHashSet> createStringPerfectHashSet(
+    const common::Filter* filter) {
+  if (filter == nullptr ||
+      filter->kind() != common::FilterKind::kBytesValues) {
+    return nullptr;
+  }
+  const auto& values =
+      static_cast<const common::BytesValues*>(filter)->values();
+  return StringPerfectHashSet::create(
+      std::vector<std::string_view>(values.begin(), values.end()));
+}
+
 class InPredicate : public exec::VectorFunction {
  public:
-  explicit InPredicate(std::unique_ptr<common::Filter> filter, bool alwaysNull)
-      : filter_{std::move(filter)}, alwaysNull_(alwaysNull) {}
+  explicit InPredicate(
+      std::unique_ptr<common::Filter> filter,
+      bool alwaysNull,
+      SmallSet smallSet = std::monostate())
+      : filter_{std::move(filter)},
+        alwaysNull_(alwaysNull),
+        smallSet_(std::move(smallSet)),
+        stringSet_(createStringPerfectHashSet(filter_.get())) {}
 
   static std::shared_ptr<exec::VectorFunction> create(
       const std::string& /*name*/,
@@ -373,6 +420,7 @@ class InPredicate : public exec::VectorFunction {
     const auto& elements = arrayVector->elements();
 
     std::pair<std::unique_ptr<common::Filter>, bool> filter;
+    SmallSet smallSet;
 
     switch (inListType->childAt(0)->kind()) {
       case TypeKind::HUGEINT:
@@ -380,15 +428,19 @@ class InPredicate : public exec::VectorFunction {
         break;
       case TypeKind::BIGINT:
         filter = createBigintValuesFilter<int64_t>(elements, offset, size);
+        smallSet = createSmallInSet<int64_t>(elements, offset, size);
         break;
       case TypeKind::INTEGER:
         filter = createBigintValuesFilter<int32_t>(elements, offset, size);
+        smallSet = createSmallInSet<int32_t>(elements, offset, size);
         break;
       case TypeKind::SMALLINT:
         filter = createBigintValuesFilter<int16_t>(elements, offset, size);
+        smallSet = createSmallInSet<int16_t>(elements, offset, size);
         break;
       case TypeKind::TINYINT:
         filter = createBigintValuesFilter<int8_t>(elements, offset, size);
+        smallSet = createSmallInSet<int8_t>(elements, offset, size);
         break;
       case TypeKind::REAL:
         filter = createFloatingPointValuesFilter<float>(elements, offset, size);
@@ -423,7 +475,7 @@ class InPredicate : public exec::VectorFunction {
             inListType->toString());
     }
     return std::make_shared<InPredicate>(
-        std::move(filter.first), filter.second);
+        std::move(filter.first), filter.second, std::move(smallSet));
   }
 
   // x IN (2, null) returns null when x != 2 and true when x == 2.
@@ -452,24 +504,16 @@ class InPredicate : public exec::VectorFunction {
         });
         break;
       case TypeKind::BIGINT:
-        applyTyped<int64_t>(rows, input, context, result, [&](int64_t value) {
-          return filter_->testInt64(value);
-        });
+        applyInteger<int64_t>(rows, input, context, result);
         break;
       case TypeKind::INTEGER:
-        applyTyped<int32_t>(rows, input, context, result, [&](int32_t value) {
-          return filter_->testInt64(value);
-        });
+        applyInteger<int32_t>(rows, input, context, result);
         break;
       case TypeKind::SMALLINT:
-        applyTyped<int16_t>(rows, input, context, result, [&](int16_t value) {
-          return filter_->testInt64(value);
-        });
+        applyInteger<int16_t>(rows, input, context, result);
         break;
       case TypeKind::TINYINT:
-        applyTyped<int8_t>(rows, input, context, result, [&](int8_t value) {
-          return filter_->testInt64(value);
-        });
+        applyInteger<int8_t>(rows, input, context, result);
         break;
       case TypeKind::REAL:
         applyTyped<float>(rows, input, context, result, [&](float value) {
@@ -510,10 +554,18 @@ class InPredicate : public exec::VectorFunction {
         break;
       case TypeKind::VARCHAR:
       case TypeKind::VARBINARY:
-        applyTyped<StringView>(
-            rows, input, context, result, [&](StringView value) {
-              return filter_->testBytes(value.data(), value.size());
-            });
+        if (stringSet_ != nullptr) {
+          applyTyped<StringView>(
+              rows, input, context, result, [&](StringView value) {
+                return stringSet_->contains(
+                    std::string_view(value.data(), value.size()));
+              });
+        } else {
+          applyTyped<StringView>(
+              rows, input, context, result, [&](StringView value) {
+                return filter_->testBytes(value.data(), value.size());
+              });
+        }
         break;
       default:
         VELOX_UNSUPPORTED(
@@ -562,13 +614,59 @@ class InPredicate : public exec::VectorFunction {
         context.pool(), size, false /*isNull*/, BOOLEAN(), std::move(value));
   }
 
-  template <typename T, typename F>
+  // Tests integers with 'smallSet_' if set and with 'filter_' otherwise. Flat
+  // values without nulls are tested a batch at a time.
+  template <typename T>
+  void applyInteger(
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      exec::EvalCtx& context,
+      VectorPtr& result) const {
+    if (const auto* smallSet = std::get_if<SmallInSet<T>>(&smallSet_)) {
+      applyTyped<T>(
+          rows,
+          arg,
+          context,
+          result,
+          [&](T value) { return smallSet->contains(value); },
+          [&](const T* values, int32_t numValues, uint64_t* bits) {
+            smallSet->testValues(values, numValues, bits);
+          });
+      return;
+    }
+    auto test = [&](T value) { return filter_->testInt64(value); };
+    if constexpr (std::is_same_v<T, int8_t>) {
+      // Filter has no testValues() for batches of 8 bit values.
+      applyTyped<T>(rows, arg, context, result, test);
+    } else {
+      applyTyped<T>(
+          rows,
+          arg,
+          context,
+          result,
+          test,
+          [&](const T* values, int32_t numValues, uint64_t* bits) {
+            testValuesInBatches(
+                values,
+                numValues,
+                [&](xsimd::batch<T> x) { return filter_->testValues(x); },
+                test,
+                bits);
+          });
+    }
+  }
+
+  // Sets the result to 'testFunction' of each non-null value. If
+  // 'batchTestFunction' is given, it is called with the values and the
+  // result bits of all rows when all rows are selected and have a value.
+  template <typename T, typename F, typename B = std::nullptr_t>
   void applyTyped(
       const SelectivityVector& rows,
       const VectorPtr& arg,
       exec::EvalCtx& context,
       VectorPtr& result,
-      F&& testFunction) const {
+      F&& testFunction,
+      B&& batchTestFunction = nullptr) const {
     VELOX_CHECK(filter_, "IN predicate supports only constant IN list");
 
     // Indicates whether result can be true or null only, e.g. no false results.
@@ -615,6 +713,12 @@ class InPredicate : public exec::VectorFunction {
         }
       });
     } else {
+      if constexpr (!std::is_same_v<std::decay_t<B>, std::nullptr_t>) {
+        if (rows.isAllSelected()) {
+          batchTestFunction(flatArg->rawValues(), rows.end(), rawResults);
+          return;
+        }
+      }
       rows.applyToSelected([&](auto row) {
         bool pass = testFunction(flatArg->valueAtFast(row));
         bits::setBit(rawResults, row, pass);
@@ -624,6 +728,13 @@ class InPredicate : public exec::VectorFunction {
 
   const std::unique_ptr<common::Filter> filter_;
   const bool alwaysNull_;
+
+  // Set for integer IN lists of at most SmallInSet::kMaxValues values.
+  const SmallSet smallSet_;
+
+  // Set for VARCHAR and VARBINARY IN lists of more than one value. nullptr
+  // if no perfect hash function is found.
+  const std::unique_ptr<StringPerfectHashSet> stringSet_;
 };
 } // namespace
 
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/JsonExtractScalarMulti.h"
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FunctionCallToSpecialForm.h"
+#include "velox/expression/SpecialForm.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/SIMDJsonFunctions.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+using ExtractorPtr = std::shared_ptr<detail::SIMDJsonExtractor>;
+
+class JsonExtractScalarMulti : public exec::SpecialForm {
+ public:
+  JsonExtractScalarMulti(
+      TypePtr type,
+      exec::ExprPtr json,
+      std::vector<ExtractorPtr> extractors,
+      bool trackCpuUsage)
+      : SpecialForm(
+            std::move(type),
+            {std::move(json)},
+            kJsonExtractScalarMulti,
+            false /* supportsFlatNoNullsFastPath */,
+            trackCpuUsage),
+        extractors_(std::move(extractors)) {}
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      exec::EvalCtx& context,
+      VectorPtr& result) override {
+    VectorPtr json;
+    inputs_[0]->eval(rows, context, json);
+    exec::LocalDecodedVector decoded(context, *json, rows);
+
+    const auto numPaths = extractors_.size();
+    std::vector<VectorPtr> children(numPaths);
+    std::vector<FlatVector<StringView>*> flatChildren(numPaths);
+    for (auto i = 0; i < numPaths; ++i) {
+      children[i] = BaseVector::create(VARCHAR(), rows.end(), context.pool());
+      flatChildren[i] = children[i]->asFlatVector<StringView>();
+    }
+    auto setNulls = [&](vector_size_t row) {
+      for (auto* child : flatChildren) {
+        child->setNull(row, true);
+      }
+    };
+
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      if (decoded->isNullAt(row)) {
+        setNulls(row);
+        return;
+      }
+      // The document is indexed once and rewound for each path.
+      const auto value = decoded->valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(value.data(), value.size());
+      simdjson::ondemand::document jsonDoc;
+      if (parser_.iterate(paddedJson).get(jsonDoc) != simdjson::SUCCESS) {
+        setNulls(row);
+        return;
+      }
+      for (auto i = 0; i < numPaths; ++i) {
+        if (i > 0) {
+          jsonDoc.rewind();
+        }
+        JsonExtractScalarConsumer consumer;
+        if (simdJsonExtract(jsonDoc, *extractors_[i], consumer) ==
+                simdjson::SUCCESS &&
+            consumer.result.has_value()) {
+          flatChildren[i]->set(row, StringView(*consumer.result));
+        } else {
+          flatChildren[i]->setNull(row, true);
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), type(), nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  void computePropagatesNulls() override {
+    // A null JSON gives a row of nulls, not a null row.
+    propagatesNulls_ = false;
+  }
+
+  // Compiled paths, 1:1 to the fields of the result.
+  const std::vector<ExtractorPtr> extractors_;
+
+  simdjson::ondemand::parser parser_;
+};
+
+RowTypePtr multiType(size_t numPaths) {
+  std::vector<std::string> names;
+  for (auto i = 0; i < numPaths; ++i) {
+    names.push_back(fmt::format("p{}", i));
+  }
+  return ROW(std::move(names), std::vector<TypePtr>(numPaths, VARCHAR()));
+}
+
+class JsonExtractScalarMultiCallToSpecialForm
+    : public exec::FunctionCallToSpecialForm {
+ public:
+  TypePtr resolveType(const std::vector<TypePtr>& argTypes) override {
+    VELOX_USER_CHECK_GE(
+        argTypes.size(), 2, "{} takes a JSON and paths", kJsonExtractScalarMulti);
+    return multiType(argTypes.size() - 1);
+  }
+
+  exec::ExprPtr constructSpecialForm(
+      const TypePtr& type,
+      std::vector<exec::ExprPtr>&& compiledChildren,
+      bool trackCpuUsage,
+      const core::QueryConfig& /*config*/) override {
+    VELOX_CHECK_GE(compiledChildren.size(), 2);
+    std::vector<ExtractorPtr> extractors;
+    for (auto i = 1; i < compiledChildren.size(); ++i) {
+      auto* constant =
+          dynamic_cast<const exec::ConstantExpr*>(compiledChildren[i].get());
+      VELOX_USER_CHECK(
+          constant != nullptr && !constant->value()->isNullAt(0),
+          "Paths of {} must be constant and not null",
+          kJsonExtractScalarMulti);
+      const auto path =
+          constant->value()->as<SimpleVector<StringView>>()->valueAt(0);
+      auto extractor = detail::SIMDJsonExtractor::tryCompile(path);
+      VELOX_USER_CHECK_NOT_NULL(extractor, "Invalid JSON path: {}", path);
+      extractors.push_back(std::move(extractor));
+    }
+    return std::make_shared<JsonExtractScalarMulti>(
+        type, compiledChildren[0], std::move(extractors), trackCpuUsage);
+  }
+};
+
+// Returns the path of a json_extract_scalar call with a valid constant path.
+std::optional<std::string> constantPath(
+    const std::string& name,
+    const core::ITypedExpr& expr) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(&expr);
+  if (call == nullptr || call->name() != name || call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (constant == nullptr || constant->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  std::string path;
+  if (constant->hasValueVector()) {
+    const auto& value = constant->valueVector();
+    if (value->isNullAt(0)) {
+      return std::nullopt;
+    }
+    path = value->as<SimpleVector<StringView>>()->valueAt(0);
+  } else {
+    if (constant->value().isNull()) {
+      return std::nullopt;
+    }
+    path = constant->value().value<TypeKind::VARCHAR>();
+  }
+  // Invalid paths are left to json_extract_scalar to report per row.
+  if (detail::SIMDJsonExtractor::tryCompile(path) == nullptr) {
+    return std::nullopt;
+  }
+  return path;
+}
+
+// Returns true for the expressions whose inputs are re-written. Lambdas are
+// not entered because their bodies are in a different scope.
+bool canRewriteInputs(const core::ITypedExpr& expr) {
+  return dynamic_cast<const core::CallTypedExpr*>(&expr) ||
+      dynamic_cast<const core::CastTypedExpr*>(&expr) ||
+      dynamic_cast<const core::DereferenceTypedExpr*>(&expr) ||
+      (dynamic_cast<const core::FieldAccessTypedExpr*>(&expr) &&
+       !expr.inputs().empty());
+}
+
+struct TypedExprHasher {
+  size_t operator()(const core::ITypedExpr* expr) const {
+    return expr->hash();
+  }
+};
+
+struct TypedExprComparer {
+  bool operator()(const core::ITypedExpr* lhs, const core::ITypedExpr* rhs)
+      const {
+    return *lhs == *rhs;
+  }
+};
+
+struct JsonPaths {
+  core::TypedExprPtr json;
+  // Distinct paths extracted from 'json'.
+  std::vector<std::string> paths;
+};
+
+using PathsMap = folly::F14FastMap<
+    const core::ITypedExpr*,
+    JsonPaths,
+    TypedExprHasher,
+    TypedExprComparer>;
+
+// The shared call for each JSON.
+using MultiMap = folly::F14FastMap<
+    const core::ITypedExpr*,
+    core::TypedExprPtr,
+    TypedExprHasher,
+    TypedExprComparer>;
+
+void collectPaths(
+    const std::string& name,
+    const core::TypedExprPtr& expr,
+    PathsMap& paths) {
+  if (auto path = constantPath(name, *expr)) {
+    auto& entry = paths[expr->inputs()[0].get()];
+    if (entry.json == nullptr) {
+      entry.json = expr->inputs()[0];
+    }
+    auto& jsonPaths = entry.paths;
+    if (std::find(jsonPaths.begin(), jsonPaths.end(), *path) ==
+        jsonPaths.end()) {
+      jsonPaths.push_back(std::move(*path));
+    }
+  }
+  if (!canRewriteInputs(*expr)) {
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectPaths(name, input, paths);
+  }
+}
+
+core::TypedExprPtr rewrite(
+    const std::string& name,
+    const core::TypedExprPtr& expr,
+    const PathsMap& paths,
+    const MultiMap& multis) {
+  if (auto path = constantPath(name, *expr)) {
+    auto it = multis.find(expr->inputs()[0].get());
+    if (it != multis.end()) {
+      const auto& jsonPaths = paths.at(expr->inputs()[0].get()).paths;
+      const auto index =
+          std::find(jsonPaths.begin(), jsonPaths.end(), *path) -
+          jsonPaths.begin();
+      return std::make_shared<core::DereferenceTypedExpr>(
+          VARCHAR(), it->second, index);
+    }
+  }
+  if (!canRewriteInputs(*expr)) {
+    return expr;
+  }
+  std::vector<core::TypedExprPtr> inputs;
+  bool changed = false;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(rewrite(name, input, paths, multis));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CallTypedExpr>(
+        call->type(), std::move(inputs), call->name());
+  }
+  if (auto cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CastTypedExpr>(
+        cast->type(), inputs, cast->nullOnFailure());
+  }
+  if (auto dereference =
+          dynamic_cast<const core::DereferenceTypedExpr*>(expr.get())) {
+    return std::make_shared<core::DereferenceTypedExpr>(
+        dereference->type(), inputs[0], dereference->index());
+  }
+  auto access = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  VELOX_CHECK_NOT_NULL(access);
+  return std::make_shared<core::FieldAccessTypedExpr>(
+      access->type(), inputs[0], access->name());
+}
+
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  const auto name = prefix + "json_extract_scalar";
+  PathsMap paths;
+  for (const auto& expr : exprs) {
+    collectPaths(name, expr, paths);
+  }
+
+  MultiMap multis;
+  for (const auto& [json, entry] : paths) {
+    const auto& jsonPaths = entry.paths;
+    if (jsonPaths.size() < 2) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{entry.json};
+    for (const auto& path : jsonPaths) {
+      inputs.push_back(
+          std::make_shared<core::ConstantTypedExpr>(VARCHAR(), variant(path)));
+    }
+    multis[json] = std::make_shared<core::CallTypedExpr>(
+        multiType(jsonPaths.size()), std::move(inputs), kJsonExtractScalarMulti);
+  }
+  if (multis.empty()) {
+    return exprs;
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(rewrite(name, expr, paths, multis));
+  }
+  return rewritten;
+}
+
+void registerJsonExtractScalarMulti(const std::string& prefix) {
+  exec::registerFunctionCallToSpecialForm(
+      kJsonExtractScalarMulti,
+      std::make_unique<JsonExtractScalarMultiCallToSpecialForm>());
+  exec::registerExprSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalarCalls(prefix, exprs);
+  });
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Name of the special form that evaluates json_extract_scalar for several
+/// constant paths over the same JSON. Takes the JSON and the paths and returns
+/// a ROW with one VARCHAR field per path.
+inline constexpr const char* kJsonExtractScalarMulti =
+    "$internal$json_extract_scalar_multi";
+
+/// Rewrites the json_extract_scalar calls with constant paths in 'exprs' so
+/// that the calls over the same JSON share one kJsonExtractScalarMulti call.
+/// The shared call is a common subexpression of the ExprSet, so each document
+/// is parsed once for all the paths and the paths are compiled once. The
+/// calls for each path become dereferences of the shared call. Returns
+/// 'exprs' as is if there are no two distinct paths over the same JSON.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+/// Registers kJsonExtractScalarMulti and the re-write of json_extract_scalar
+/// calls with function name prefix 'prefix'.
+void registerJsonExtractScalarMulti(const std::string& prefix);
+
+} // namespace facebook::velox::functions
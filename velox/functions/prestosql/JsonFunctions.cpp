@@ -88,6 +88,11 @@ class JsonParseFunction : public exec::VectorFunction {
         context.setErrors(rows, errors_[error]);
         return;
       }
+      if (const auto minifiedSize = minify(value.size());
+          minifiedSize < value.size()) {
+        // The constant vector copies the string.
+        value = StringView(minified_.data(), minifiedSize);
+      }
       localResult = std::make_shared<ConstantVector<StringView>>(
           context.pool(), rows.end(), false, JSON(), std::move(value));
     } else {
@@ -102,20 +107,42 @@ class JsonParseFunction : public exec::VectorFunction {
         maxSize = std::max(maxSize, value.size());
       });
       paddedInput_.resize(maxSize + simdjson::SIMDJSON_PADDING);
+      // Rows that have whitespace outside of strings. Other rows refer to the
+      // input strings.
+      struct MinifiedRow {
+        vector_size_t row;
+        size_t offset;
+        size_t size;
+      };
+      std::vector<MinifiedRow> minifiedRows;
+      std::string minifiedText;
       rows.applyToSelected([&](auto row) {
         auto value = flatInput->valueAt(row);
         memcpy(paddedInput_.data(), value.data(), value.size());
         if (auto error = parse(value.size())) {
           context.setVeloxExceptionError(row, errors_[error]);
+        } else if (const auto minifiedSize = minify(value.size());
+                   minifiedSize < value.size()) {
+          minifiedRows.push_back({row, minifiedText.size(), minifiedSize});
+          minifiedText.append(minified_.data(), minifiedSize);
         }
       });
-      localResult = std::make_shared<FlatVector<StringView>>(
+      auto flatResult = std::make_shared<FlatVector<StringView>>(
           context.pool(),
           JSON(),
           nullptr,
           rows.end(),
-          flatInput->values(),
+          minifiedRows.empty()
+              ? flatInput->values()
+              : AlignedBuffer::copy(context.pool(), flatInput->values()),
           std::move(stringBuffers));
+      for (const auto& minified : minifiedRows) {
+        flatResult->set(
+            minified.row,
+            StringView(
+                minifiedText.data() + minified.offset, minified.size));
+      }
+      localResult = std::move(flatResult);
     }
 
     context.moveOrCopyResult(localResult, rows, result);
@@ -141,6 +168,21 @@ class JsonParseFunction : public exec::VectorFunction {
     return simdjson::SUCCESS;
   }
 
+  // Writes the JSON in 'paddedInput_' without the whitespace outside of
+  // strings to 'minified_'. The JSON must be valid. Returns the size of the
+  // result, which is less than 'size' only if there was whitespace to remove.
+  size_t minify(size_t size) const {
+    if (minified_.size() < size) {
+      minified_.resize(size);
+    }
+    size_t minifiedSize;
+    if (simdjson::minify(
+            paddedInput_.data(), size, minified_.data(), minifiedSize)) {
+      return size;
+    }
+    return minifiedSize;
+  }
+
   template <typename T>
   static simdjson::error_code validate(T value) {
     SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
@@ -179,6 +221,7 @@ class JsonParseFunction : public exec::VectorFunction {
   mutable std::exception_ptr errors_[simdjson::NUM_ERROR_CODES];
   // Padding is needed in case string view is inlined.
   mutable std::string paddedInput_;
+  mutable std::string minified_;
 };
 
 } // namespace
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/LambdaFusion.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+// Returns 'expr' if it is a call to 'name' with an array and a lambda.
+const core::CallTypedExpr* asLambdaCall(
+    const core::TypedExprPtr& expr,
+    const std::string& name) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != name || call->inputs().size() != 2 ||
+      !dynamic_cast<const core::LambdaTypedExpr*>(call->inputs()[1].get())) {
+    return nullptr;
+  }
+  return call;
+}
+
+std::shared_ptr<const core::LambdaTypedExpr> lambdaOf(
+    const core::CallTypedExpr& call) {
+  return std::static_pointer_cast<const core::LambdaTypedExpr>(
+      call.inputs()[1]);
+}
+
+// Adds the names of the columns referenced in 'expr' to 'names', once per
+// reference, and the parameters of the lambdas in 'expr' to 'params'.
+void collectNames(
+    const core::TypedExprPtr& expr,
+    std::unordered_multiset<std::string>& names,
+    std::unordered_set<std::string>& params) {
+  if (const auto* field =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    if (field->isInputColumn()) {
+      names.insert(field->name());
+      return;
+    }
+  }
+  if (const auto* lambda =
+          dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    for (const auto& name : lambda->signature()->names()) {
+      params.insert(name);
+    }
+    collectNames(lambda->body(), names, params);
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectNames(input, names, params);
+  }
+}
+
+// Returns x -> g(f(x)) for f = x -> f(x) and g = y -> g(y) or nullptr if
+// 'y' is not referenced exactly once in 'g' or if substituting f(x) for 'y'
+// would bind a name to a different variable.
+std::shared_ptr<const core::LambdaTypedExpr> compose(
+    const core::LambdaTypedExpr& f,
+    const core::LambdaTypedExpr& g) {
+  if (f.signature()->size() != 1 || g.signature()->size() != 1) {
+    return nullptr;
+  }
+  const auto& fParam = f.signature()->nameOf(0);
+  const auto& gParam = g.signature()->nameOf(0);
+
+  std::unordered_multiset<std::string> gNames;
+  std::unordered_set<std::string> gParams;
+  collectNames(g.body(), gNames, gParams);
+  if (gNames.count(gParam) != 1 || gParams.count(gParam) > 0) {
+    return nullptr;
+  }
+  // The columns that 'g' captures must not become references to 'fParam'.
+  if (fParam != gParam && gNames.count(fParam) > 0) {
+    return nullptr;
+  }
+  // The names in f(x) must not be shadowed by the lambdas in 'g'.
+  std::unordered_multiset<std::string> fNames;
+  std::unordered_set<std::string> fParams;
+  collectNames(f.body(), fNames, fParams);
+  for (const auto& name : fNames) {
+    if (gParams.count(name) > 0) {
+      return nullptr;
+    }
+  }
+
+  return std::make_shared<core::LambdaTypedExpr>(
+      f.signature(), g.body()->rewriteInputNames({{gParam, f.body()}}));
+}
+
+} // namespace
+
+core::TypedExprPtr rewriteLambdaChain(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  const auto transformName = prefix + "transform";
+  const auto* outer = asLambdaCall(expr, transformName);
+  if (outer == nullptr) {
+    return nullptr;
+  }
+
+  auto array = outer->inputs()[0];
+  auto lambda = lambdaOf(*outer);
+  bool rewritten = false;
+  while (const auto* inner = asLambdaCall(array, transformName)) {
+    auto composed = compose(*lambdaOf(*inner), *lambda);
+    if (composed == nullptr) {
+      break;
+    }
+    lambda = std::move(composed);
+    array = inner->inputs()[0];
+    rewritten = true;
+  }
+
+  if (const auto* filter = asLambdaCall(array, prefix + "filter")) {
+    return std::make_shared<core::CallTypedExpr>(
+        expr->type(),
+        std::vector<core::TypedExprPtr>{
+            filter->inputs()[0], filter->inputs()[1], lambda},
+        kArrayFilterTransform);
+  }
+  if (!rewritten) {
+    return nullptr;
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      expr->type(),
+      std::vector<core::TypedExprPtr>{array, lambda},
+      transformName);
+}
+
+} // namespace facebook::velox::functions
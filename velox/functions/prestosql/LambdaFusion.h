@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Name of the function that evaluates transform(filter(array, p), f) in one
+/// pass. Takes the array and the two lambdas.
+inline constexpr const char* kArrayFilterTransform =
+    "$internal$filter_transform";
+
+/// Fuses chains of 'transform' and 'filter' calls over arrays so that the
+/// intermediate arrays are not made. Rewrites
+///     transform(transform(a, x -> f(x)), y -> g(y))
+/// into
+///     transform(a, x -> g(f(x)))
+/// if 'y' is referenced once in 'g' and the names of the lambdas do not
+/// clash, and rewrites
+///     transform(filter(a, x -> p(x)), y -> g(y))
+/// into a call of kArrayFilterTransform. Returns new expression or nullptr if
+/// 'expr' is not such a chain.
+core::TypedExprPtr rewriteLambdaChain(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
+} // namespace facebook::velox::functions
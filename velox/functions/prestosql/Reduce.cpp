@@ -50,7 +50,9 @@ void checkArraySizes(
 /// Populates indices of the n-th elements of the arrays.
 /// Selects 'row' in 'arrayRows' if corresponding array has an n-th element.
 /// Sets elementIndices[row] to the index of the n-th element in the 'elements'
-/// vector.
+/// vector. The indices of the other rows are left as they are, so they stay
+/// valid positions in 'elements'. 'rows' can be the 'arrayRows' of the (n-1)th
+/// element since only these arrays can have an n-th element.
 /// Returns true if at least one array has n-th element.
 bool toNthElementRows(
     const ArrayVectorPtr& arrayVector,
@@ -65,7 +67,6 @@ bool toNthElementRows(
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
   arrayRows.clearAll();
-  memset(rawElementIndices, 0, elementIndices->size());
 
   rows.applyToSelected([&](auto row) {
     if (!rawNulls || !bits::isBitNull(rawNulls, row)) {
@@ -166,6 +167,8 @@ class ReduceFunction : public exec::VectorFunction {
     BufferPtr elementIndices =
         allocateIndices(flatArray->size(), context.pool());
     SelectivityVector arrayRows(flatArray->size(), false);
+    // The arrays that have the (n-1)th element.
+    SelectivityVector previousArrayRows(flatArray->size(), false);
 
     // Iteratively apply input function to array elements.
     // First, apply input function to first elements of all arrays.
@@ -189,9 +192,14 @@ class ReduceFunction : public exec::VectorFunction {
         // Set elementIndices[row] to the index of the n-th element in the
         // array's elements vector.
         if (!toNthElementRows(
-                flatArray, *entry.rows, n, arrayRows, elementIndices)) {
+                flatArray,
+                n == 0 ? *entry.rows : previousArrayRows,
+                n,
+                arrayRows,
+                elementIndices)) {
           break; // Ran out of elements in all arrays.
         }
+        previousArrayRows = arrayRows;
 
         // Create dictionary row -> element in array's elements vector.
         auto dictNthElements = BaseVector::wrapInDictionary(
@@ -19,6 +19,7 @@
 #include "velox/expression/StringWriter.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 
@@ -102,6 +103,23 @@ class SplitFunction : public exec::VectorFunction {
     DecodedVector* delims = decodedArgs.at(1);
     DecodedVector* limits = noLimit ? nullptr : decodedArgs.at(2);
 
+    if (strings->isIdentityMapping() && delims->isConstantMapping() &&
+        delims->valueAt<StringView>(0).size() == 1 &&
+        (noLimit || limits->isConstantMapping())) {
+      const I limit =
+          noLimit ? std::numeric_limits<I>::max() : limits->valueAt<I>(0);
+      if (limit > 0) {
+        applySingleByte<I>(
+            rows,
+            strings,
+            delims->valueAt<StringView>(0).data()[0],
+            limit,
+            context,
+            result);
+        return;
+      }
+    }
+
     BaseVector::ensureWritable(rows, ARRAY(VARCHAR()), context.pool(), result);
     exec::VectorWriter<Array<Varchar>> resultWriter;
     resultWriter.init(*result->as<ArrayVector>());
@@ -148,6 +166,68 @@ class SplitFunction : public exec::VectorFunction {
         ->acquireSharedStringBuffers(strings->base());
   }
 
+  /// Splits flat strings on a constant single-byte delimiter in two passes.
+  /// The first pass counts the delimiters of all rows so that the result is
+  /// allocated once. The second fills in the elements as views into the input
+  /// strings.
+  template <typename I>
+  void applySingleByte(
+      const SelectivityVector& rows,
+      DecodedVector* strings,
+      char delim,
+      I limit,
+      exec::EvalCtx& context,
+      VectorPtr& result) const {
+    const auto* rawStrings = strings->data<StringView>();
+    vector_size_t numElements = 0;
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto& input = rawStrings[row];
+      const int64_t numParts =
+          stringCore::countByte(input.data(), input.size(), delim) + 1;
+      numElements += std::min<int64_t>(numParts, limit);
+    });
+
+    auto* pool = context.pool();
+    auto elements = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), numElements, pool);
+    auto* rawElements = elements->mutableRawValues();
+    BufferPtr offsets = allocateOffsets(rows.end(), pool);
+    BufferPtr sizes = allocateSizes(rows.end(), pool);
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
+
+    vector_size_t cursor = 0;
+    rows.applyToSelected([&](vector_size_t row) {
+      const char* data = rawStrings[row].data();
+      const size_t size = rawStrings[row].size();
+      rawOffsets[row] = cursor;
+      size_t begin = 0;
+      for (I numParts = 1; numParts < limit; ++numParts) {
+        const auto end =
+            begin + stringCore::findByte(data + begin, size - begin, delim);
+        if (end == size) {
+          break;
+        }
+        rawElements[cursor++] = StringView(data + begin, end - begin);
+        begin = end + 1;
+      }
+      // The rest of the string is the last element, even if empty.
+      rawElements[cursor++] = StringView(data + begin, size - begin);
+      rawSizes[row] = cursor - rawOffsets[row];
+    });
+
+    elements->acquireSharedStringBuffers(strings->base());
+    auto localResult = std::make_shared<ArrayVector>(
+        pool,
+        ARRAY(VARCHAR()),
+        nullptr,
+        rows.end(),
+        std::move(offsets),
+        std::move(sizes),
+        std::move(elements));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
   template <typename I>
   void applyDecoded(
       const SelectivityVector& rows,
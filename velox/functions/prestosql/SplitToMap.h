@@ -17,6 +17,7 @@
 
 #include "folly/container/F14Set.h"
 #include "velox/functions/Udf.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 
@@ -64,7 +65,7 @@ struct SplitToMapFunction {
 
     folly::F14FastSet<std::string_view> keys;
 
-    auto nextEntryPos = input.find(entryDelimiter, pos);
+    auto nextEntryPos = stringCore::findDelimiter(input, entryDelimiter, pos);
     while (nextEntryPos != std::string::npos) {
       processEntry(
           out,
@@ -73,7 +74,7 @@ struct SplitToMapFunction {
           keys);
 
       pos = nextEntryPos + 1;
-      nextEntryPos = input.find(entryDelimiter, pos);
+      nextEntryPos = stringCore::findDelimiter(input, entryDelimiter, pos);
     }
 
     processEntry(
@@ -88,7 +89,8 @@ struct SplitToMapFunction {
       std::string_view entry,
       std::string_view keyValueDelimiter,
       folly::F14FastSet<std::string_view>& keys) const {
-    const auto delimiterPos = entry.find(keyValueDelimiter, 0);
+    const auto delimiterPos =
+        stringCore::findDelimiter(entry, keyValueDelimiter);
 
     VELOX_USER_CHECK_NE(
         delimiterPos,
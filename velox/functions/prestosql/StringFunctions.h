@@ -121,12 +121,16 @@ struct SubstrFunction {
       length = numCharacters - start + 1;
     }
 
-    auto byteRange =
-        stringCore::getByteRange<isAscii>(input.data(), start, length);
+    // Finds the first byte and the size in bytes of the substring.
+    // cappedByteLength() skips blocks of ASCII without decoding them.
+    const auto startByte =
+        stringImpl::cappedByteLength<isAscii>(input, start - 1);
+    const auto numBytes = stringImpl::cappedByteLength<isAscii>(
+        StringView(input.data() + startByte, input.size() - startByte),
+        length);
 
     // Generating output string
-    result.setNoCopy(StringView(
-        input.data() + byteRange.first, byteRange.second - byteRange.first));
+    result.setNoCopy(StringView(input.data() + startByte, numBytes));
   }
 };
 
@@ -20,38 +20,52 @@
 
 namespace facebook::velox::functions {
 
-std::optional<StringView> matchAuthorityAndPath(
-    StringView authorityAndPath,
-    boost::cmatch& authorityMatch,
-    int subGroup) {
-  boost::cmatch authAndPathMatch;
-  static const boost::regex kAuthorityAndPathRegex("//([^/]*)(/.*)?");
-  if (!boost::regex_match(
-          authorityAndPath.begin(),
-          authorityAndPath.end(),
-          authAndPathMatch,
-          kAuthorityAndPathRegex)) {
-    // Does not start with //, doesn't have authority.
-    return std::nullopt;
-  }
-
-  static const boost::regex kAuthorityRegex(
-      "(?:([^@:]*)(?::([^@]*))?@)?" // username, password.
-      "(\\[[^\\]]*\\]|[^\\[:]*)" // host (IP-literal (e.g. '['+IPv6+']',
-      // dotted-IPv4, or named host).
-      "(?::(\\d*))?"); // port.
+namespace {
 
-  const auto authority = authAndPathMatch[1];
-  if (!boost::regex_match(
-          authority.first, authority.second, authorityMatch, kAuthorityRegex)) {
-    return std::nullopt; // Invalid URI Authority.
+// Matches the host and port of an authority without user info.
+bool parseHostAndPort(std::string_view input, UrlAuthority& result) {
+  size_t hostEnd;
+  if (!input.empty() && input[0] == '[') {
+    // IP-literal, e.g. '[' + IPv6 + ']'.
+    hostEnd = input.find(']');
+    if (hostEnd == std::string_view::npos) {
+      return false;
+    }
+    ++hostEnd;
+  } else {
+    // Dotted IPv4 or named host.
+    hostEnd = std::min(input.find_first_of("[:"), input.size());
   }
-
-  if (authorityMatch[subGroup].matched) {
-    return submatch(authorityMatch, subGroup);
+  result.host = StringView(input.data(), hostEnd);
+  result.port.reset();
+  if (hostEnd == input.size()) {
+    return true;
+  }
+  if (input[hostEnd] != ':') {
+    return false;
   }
+  for (auto i = hostEnd + 1; i < input.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(input[i]))) {
+      return false;
+    }
+  }
+  result.port =
+      StringView(input.data() + hostEnd + 1, input.size() - hostEnd - 1);
+  return true;
+}
 
-  return std::nullopt;
+} // namespace
+
+bool parseUrlAuthority(StringView authority, UrlAuthority& result) {
+  const std::string_view input(authority.data(), authority.size());
+  // User info is everything before the first '@'. If the rest is not a host
+  // and port, the '@' belongs to the host.
+  const auto at = input.find('@');
+  if (at != std::string_view::npos &&
+      parseHostAndPort(input.substr(at + 1), result)) {
+    return true;
+  }
+  return parseHostAndPort(input, result);
 }
 
 } // namespace facebook::velox::functions
@@ -15,77 +15,79 @@
  */
 #pragma once
 
-#include <boost/regex.hpp>
 #include <cctype>
 #include <optional>
 #include "velox/functions/Macros.h"
+#include "velox/functions/lib/string/StringCore.h"
 #include "velox/functions/lib/string/StringImpl.h"
 
 namespace facebook::velox::functions {
 
-namespace {
-
-const auto kScheme = 2;
-const auto kAuthority = 3;
-const auto kPath = 5;
-const auto kQuery = 7;
-const auto kFragment = 9;
-const auto kHost = 3; // From the authority and path regex.
-const auto kPort = 4; // From the authority and path regex.
-
-FOLLY_ALWAYS_INLINE StringView submatch(const boost::cmatch& match, int idx) {
-  const auto& sub = match[idx];
-  return StringView(sub.first, sub.length());
-}
+/// Components of a URL as split by the regex of RFC 3986 appendix B:
+///
+///   ^(([^:/?#]+):)?(//([^/?#]*))?([^?#]*)(\?([^#]*))?(#(.*))?
+///
+/// For example, http://www.ics.uci.edu/pub/ietf/uri/?q#Related has the scheme
+/// 'http', the authority 'www.ics.uci.edu', the path '/pub/ietf/uri/', the
+/// query 'q' and the fragment 'Related'. The components refer to the URL.
+struct UrlComponents {
+  std::optional<StringView> scheme;
+  std::optional<StringView> authority;
+  StringView path;
+  std::optional<StringView> query;
+  std::optional<StringView> fragment;
+};
 
-bool parse(const char* rawUrlData, size_t rawUrlsize, boost::cmatch& match) {
-  /// This regex is taken from RFC - 3986.
-  /// See: https://www.rfc-editor.org/rfc/rfc3986#appendix-B
-  /// The basic groups are:
-  ///      scheme    = $2
-  ///      authority = $4
-  ///      path      = $5
-  ///      query     = $7
-  ///      fragment  = $9
-  /// For example a URI like below :
-  ///  http://www.ics.uci.edu/pub/ietf/uri/#Related
-  ///
-  ///   results in the following subexpression matches:
-  ///
-  ///      $1 = http:
-  ///      $2 = http
-  ///      $3 = //www.ics.uci.edu
-  ///      $4 = www.ics.uci.edu
-  ///      $5 = /pub/ietf/uri/
-  ///      $6 = <undefined>
-  ///      $7 = <undefined>
-  ///      $8 = #Related
-  ///      $9 = Related
-  static const boost::regex kUriRegex(
-      "^(([^:\\/?#]+):)?" // scheme:
-      "(\\/\\/([^\\/?#]*))?([^?#]*)" // authority and path
-      "(\\?([^#]*))?" // ?query
-      "(#(.*))?"); // #fragment
-
-  return boost::regex_match(
-      rawUrlData, rawUrlData + rawUrlsize, match, kUriRegex);
-}
+/// Host and port of the authority of a URL, as matched by
+///
+///   (?:([^@:]*)(?::([^@]*))?@)?(\[[^\]]*\]|[^\[:]*)(?::(\d*))?
+///
+/// 'port' is set if a ':' follows the host, even if no digits follow it.
+struct UrlAuthority {
+  StringView host;
+  std::optional<StringView> port;
+};
 
-/// Parses the url and returns the matching subgroup if the particular sub group
-/// is matched by the call to parse call above.
-std::optional<StringView> parse(StringView rawUrl, int subGroup) {
-  boost::cmatch match;
-  if (!parse(rawUrl.data(), rawUrl.size(), match)) {
-    return std::nullopt;
-  }
+/// Splits 'authority' into host and port. Returns false if 'authority' is not
+/// a valid URL authority.
+bool parseUrlAuthority(StringView authority, UrlAuthority& result);
 
-  VELOX_CHECK_LT(subGroup, match.size());
+namespace {
 
-  if (match[subGroup].matched) {
-    return submatch(match, subGroup);
+/// Splits 'url' into its components. The delimiters of the components are
+/// found a SIMD batch at a time.
+FOLLY_ALWAYS_INLINE UrlComponents parseUrl(StringView url) {
+  const char* data = url.data();
+  const size_t size = url.size();
+  UrlComponents components;
+  size_t pos = 0;
+  const auto schemeEnd =
+      stringCore::findFirstOf<':', '/', '?', '#'>(data, size);
+  if (schemeEnd > 0 && schemeEnd < size && data[schemeEnd] == ':') {
+    components.scheme = StringView(data, schemeEnd);
+    pos = schemeEnd + 1;
   }
-
-  return std::nullopt;
+  if (pos + 1 < size && data[pos] == '/' && data[pos + 1] == '/') {
+    pos += 2;
+    const auto end =
+        pos + stringCore::findFirstOf<'/', '?', '#'>(data + pos, size - pos);
+    components.authority = StringView(data + pos, end - pos);
+    pos = end;
+  }
+  auto end = pos + stringCore::findFirstOf<'?', '#'>(data + pos, size - pos);
+  components.path = StringView(data + pos, end - pos);
+  pos = end;
+  if (pos < size && data[pos] == '?') {
+    ++pos;
+    end = pos + stringCore::findByte(data + pos, size - pos, '#');
+    components.query = StringView(data + pos, end - pos);
+    pos = end;
+  }
+  if (pos < size) {
+    // Skips the '#'.
+    components.fragment = StringView(data + pos + 1, size - pos - 1);
+  }
+  return components;
 }
 
 FOLLY_ALWAYS_INLINE unsigned char toHex(unsigned char c) {
@@ -204,14 +206,6 @@ FOLLY_ALWAYS_INLINE void urlUnescape(
 
 } // namespace
 
-/// Matches the authority (i.e host[:port], ipaddress), and path from a string
-/// representing the authority and path. Returns true if the regex matches, and
-/// sets the appropriate groups matching authority in authorityMatch.
-std::optional<StringView> matchAuthorityAndPath(
-    StringView authorityAndPath,
-    boost::cmatch& authorityMatch,
-    int subGroup);
-
 template <typename T>
 struct UrlExtractProtocolFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -229,7 +223,7 @@ struct UrlExtractProtocolFunction {
       return false;
     }
 
-    if (auto protocol = parse(url, kScheme)) {
+    if (auto protocol = parseUrl(url).scheme) {
       result.setNoCopy(protocol.value());
     } else {
       result.setEmpty();
@@ -255,7 +249,7 @@ struct UrlExtractFragmentFunction {
       return false;
     }
 
-    if (auto fragment = parse(url, kFragment)) {
+    if (auto fragment = parseUrl(url).fragment) {
       result.setNoCopy(fragment.value());
     } else {
       result.setEmpty();
@@ -281,16 +275,10 @@ struct UrlExtractHostFunction {
       return false;
     }
 
-    auto authAndPath = parse(url, kAuthority);
-    if (!authAndPath) {
-      result.setEmpty();
-      return true;
-    }
-    boost::cmatch authorityMatch;
-
-    if (auto host =
-            matchAuthorityAndPath(authAndPath.value(), authorityMatch, kHost)) {
-      result.setNoCopy(host.value());
+    const auto authority = parseUrl(url).authority;
+    UrlAuthority parsed;
+    if (authority && parseUrlAuthority(authority.value(), parsed)) {
+      result.setNoCopy(parsed.host);
     } else {
       result.setEmpty();
     }
@@ -307,20 +295,17 @@ struct UrlExtractPortFunction {
       return false;
     }
 
-    auto authAndPath = parse(url, kAuthority);
-    if (!authAndPath) {
+    const auto authority = parseUrl(url).authority;
+    UrlAuthority parsed;
+    if (!authority || !parseUrlAuthority(authority.value(), parsed)) {
       return false;
     }
 
-    boost::cmatch authorityMatch;
-    if (auto port =
-            matchAuthorityAndPath(authAndPath.value(), authorityMatch, kPort)) {
-      if (!port.value().empty()) {
-        try {
-          result = to<int64_t>(port.value());
-          return true;
-        } catch (folly::ConversionError const&) {
-        }
+    if (parsed.port && !parsed.port.value().empty()) {
+      try {
+        result = to<int64_t>(parsed.port.value());
+        return true;
+      } catch (folly::ConversionError const&) {
       }
     }
     return false;
@@ -340,10 +325,7 @@ struct UrlExtractPathFunction {
       return false;
     }
 
-    auto path = parse(url, kPath);
-    VELOX_USER_CHECK(
-        path.has_value(), "Unable to determine path for URL: {}", url);
-    urlUnescape(result, path.value());
+    urlUnescape(result, parseUrl(url).path);
 
     return true;
   }
@@ -366,7 +348,7 @@ struct UrlExtractQueryFunction {
       return false;
     }
 
-    if (auto query = parse(url, kQuery)) {
+    if (auto query = parseUrl(url).query) {
       result.setNoCopy(query.value());
     } else {
       result.setEmpty();
@@ -394,37 +376,33 @@ struct UrlExtractParameterFunction {
       return false;
     }
 
-    auto query = parse(url, kQuery);
+    const auto query = parseUrl(url).query;
     if (!query) {
       return false;
     }
 
-    if (!query.value().empty()) {
-      // Parse query string.
-      static const boost::regex kQueryParamRegex(
-          "(^|&)" // start of query or start of parameter "&"
-          "([^=&]*)=?" // parameter name and "=" if value is expected
-          "([^=&]*)" // parameter value
-          "(?=(&|$))" // forward reference, next should be end of query or
-                      // start of next parameter
-      );
-
-      const boost::cregex_iterator begin(
-          query.value().data(),
-          query.value().data() + query.value().size(),
-          kQueryParamRegex);
-      boost::cregex_iterator end;
-
-      for (auto it = begin; it != end; ++it) {
-        if (it->length(2) != 0 && (*it)[2].matched) { // key shouldnt be empty.
-          auto key = submatch((*it), 2);
-          if (param.compare(key) == 0) {
-            auto value = submatch((*it), 3);
-            result.setNoCopy(value);
-            return true;
-          }
-        }
+    // Parameters are 'name=value' or 'name' separated by '&'. Parameters with
+    // an empty name or with more than one '=' are skipped.
+    const std::string_view params(query->data(), query->size());
+    size_t begin = 0;
+    while (begin < params.size()) {
+      auto end = params.find('&', begin);
+      if (end == std::string_view::npos) {
+        end = params.size();
+      }
+      const auto pair = params.substr(begin, end - begin);
+      const auto equals = pair.find('=');
+      const auto name = pair.substr(0, equals);
+      const bool valid = equals == std::string_view::npos ||
+          pair.find('=', equals + 1) == std::string_view::npos;
+      if (valid && !name.empty() && param.compare(StringView(name)) == 0) {
+        result.setNoCopy(
+            equals == std::string_view::npos
+                ? StringView()
+                : StringView(pair.substr(equals + 1)));
+        return true;
       }
+      begin = end + 1;
     }
 
     return false;
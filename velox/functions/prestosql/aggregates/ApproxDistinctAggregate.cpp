@@ -54,6 +54,18 @@ struct HllAccumulator {
     }
   }
 
+  void append(const std::vector<uint64_t>& hashes) {
+    if (isSparse_) {
+      if (sparseHll_.insertHashes(hashes.data(), hashes.size())) {
+        toDense();
+      }
+    } else {
+      for (auto hash : hashes) {
+        denseHll_.insertHash(hash);
+      }
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -270,18 +282,20 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
+      // The hashes are inserted in one batch.
+      hashes_.clear();
       rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+        if (!decodedValue_.isNullAt(row)) {
+          hashes_.push_back(hashOne(decodedValue_.valueAt<T>(row)));
         }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
       });
+      if (hashes_.empty()) {
+        return;
+      }
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(hashes_);
     }
   }
 
@@ -410,6 +424,8 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // Hashes of the values of a batch for addSingleGroupRawInput().
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
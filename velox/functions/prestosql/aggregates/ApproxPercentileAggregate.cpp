@@ -702,8 +702,12 @@ class ApproxPercentileAggregate : public exec::Aggregate {
 
     KllSketchAccumulator<T>* accumulator = nullptr;
     std::vector<typename KllSketch<T>::View> views;
+    // The sketches of each group, merged after all rows are read.
+    std::vector<std::pair<char*, typename KllSketch<T>::View>> groupViews;
     if constexpr (kSingleGroup) {
       views.reserve(rows.end());
+    } else {
+      groupViews.reserve(rows.countSelected());
     }
     rows.applyToSelected([&](auto row) {
       if (decoded.isNullAt(row)) {
@@ -764,8 +768,7 @@ class ApproxPercentileAggregate : public exec::Aggregate {
       if constexpr (kSingleGroup) {
         views.push_back(v);
       } else {
-        auto tracker = trackRowSize(group[row]);
-        accumulator->append(v);
+        groupViews.emplace_back(group[row], v);
       }
     });
     if constexpr (kSingleGroup) {
@@ -773,6 +776,28 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         auto tracker = trackRowSize(group);
         accumulator->append(views);
       }
+    } else {
+      // A final aggregation typically sees each group once per partial
+      // aggregation. Merging all the sketches of a group at once compacts
+      // the group once instead of once per sketch.
+      std::stable_sort(
+          groupViews.begin(),
+          groupViews.end(),
+          [](const auto& left, const auto& right) {
+            return std::less<char*>()(left.first, right.first);
+          });
+      for (auto begin = 0; begin < groupViews.size();) {
+        auto* groupRow = groupViews[begin].first;
+        views.clear();
+        auto end = begin;
+        for (; end < groupViews.size() && groupViews[end].first == groupRow;
+             ++end) {
+          views.push_back(groupViews[end].second);
+        }
+        auto tracker = trackRowSize(groupRow);
+        value<KllSketchAccumulator<T>>(groupRow)->append(views);
+        begin = end;
+      }
     }
   }
 };
@@ -22,17 +22,40 @@
 namespace facebook::velox::aggregate::prestosql {
 namespace {
 
+template <typename List>
 struct ArrayAccumulator {
-  ValueList elements;
+  List elements;
 };
 
+void readElements(
+    ValueList& values,
+    BaseVector& elements,
+    vector_size_t offset) {
+  ValueListReader reader(values);
+  for (auto index = 0; index < values.size(); ++index) {
+    reader.next(elements, offset + index);
+  }
+}
+
+template <typename T>
+void readElements(
+    FixedWidthValueList<T>& values,
+    BaseVector& elements,
+    vector_size_t offset) {
+  values.read(*elements.asFlatVector<T>(), offset);
+}
+
+// 'List' is ValueList or, for fixed-width elements, FixedWidthValueList.
+template <typename List>
 class ArrayAggAggregate : public exec::Aggregate {
+  using Accumulator = ArrayAccumulator<List>;
+
  public:
   explicit ArrayAggAggregate(TypePtr resultType, bool ignoreNulls)
       : Aggregate(resultType), ignoreNulls_(ignoreNulls) {}
 
   int32_t accumulatorFixedWidthSize() const override {
-    return sizeof(ArrayAccumulator);
+    return sizeof(Accumulator);
   }
 
   bool isFixedSize() const override {
@@ -96,7 +119,7 @@ class ArrayAggAggregate : public exec::Aggregate {
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
     for (auto index : indices) {
-      new (groups[index] + offset_) ArrayAccumulator();
+      new (groups[index] + offset_) Accumulator();
     }
   }
 
@@ -112,15 +135,11 @@ class ArrayAggAggregate : public exec::Aggregate {
     uint64_t* rawNulls = getRawNulls(vector);
     vector_size_t offset = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      auto& values = value<ArrayAccumulator>(groups[i])->elements;
+      auto& values = value<Accumulator>(groups[i])->elements;
       auto arraySize = values.size();
       if (arraySize) {
         clearNull(rawNulls, i);
-
-        ValueListReader reader(values);
-        for (auto index = 0; index < arraySize; ++index) {
-          reader.next(*elements, offset + index);
-        }
+        readElements(values, *elements, offset);
         vector->setOffsetAndSize(i, offset, arraySize);
         offset += arraySize;
       } else {
@@ -146,7 +165,7 @@ class ArrayAggAggregate : public exec::Aggregate {
       }
       auto group = groups[row];
       auto tracker = trackRowSize(group);
-      value<ArrayAccumulator>(group)->elements.appendValue(
+      value<Accumulator>(group)->elements.appendValue(
           decodedElements_, row, allocator_);
     });
   }
@@ -165,7 +184,7 @@ class ArrayAggAggregate : public exec::Aggregate {
       auto decodedRow = decodedIntermediate_.index(row);
       auto tracker = trackRowSize(group);
       if (!decodedIntermediate_.isNullAt(row)) {
-        value<ArrayAccumulator>(group)->elements.appendRange(
+        value<Accumulator>(group)->elements.appendRange(
             elements,
             arrayVector->offsetAt(decodedRow),
             arrayVector->sizeAt(decodedRow),
@@ -179,7 +198,7 @@ class ArrayAggAggregate : public exec::Aggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /* mayPushdown */) override {
-    auto& values = value<ArrayAccumulator>(group)->elements;
+    auto& values = value<Accumulator>(group)->elements;
 
     decodedElements_.decode(*args[0], rows);
     auto tracker = trackRowSize(group);
@@ -199,7 +218,7 @@ class ArrayAggAggregate : public exec::Aggregate {
     decodedIntermediate_.decode(*args[0], rows);
     auto arrayVector = decodedIntermediate_.base()->as<ArrayVector>();
 
-    auto& values = value<ArrayAccumulator>(group)->elements;
+    auto& values = value<Accumulator>(group)->elements;
     auto elements = arrayVector->elements();
     rows.applyToSelected([&](vector_size_t row) {
       if (!decodedIntermediate_.isNullAt(row)) {
@@ -215,7 +234,7 @@ class ArrayAggAggregate : public exec::Aggregate {
 
   void destroy(folly::Range<char**> groups) override {
     for (auto group : groups) {
-      value<ArrayAccumulator>(group)->elements.free(allocator_);
+      value<Accumulator>(group)->elements.free(allocator_);
     }
   }
 
@@ -223,7 +242,7 @@ class ArrayAggAggregate : public exec::Aggregate {
   vector_size_t countElements(char** groups, int32_t numGroups) const {
     vector_size_t size = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      size += value<ArrayAccumulator>(groups[i])->elements.size();
+      size += value<Accumulator>(groups[i])->elements.size();
     }
     return size;
   }
@@ -235,6 +254,14 @@ class ArrayAggAggregate : public exec::Aggregate {
   DecodedVector decodedIntermediate_;
 };
 
+template <typename T>
+std::unique_ptr<exec::Aggregate> makeFixedWidth(
+    const TypePtr& resultType,
+    bool ignoreNulls) {
+  return std::make_unique<ArrayAggAggregate<FixedWidthValueList<T>>>(
+      resultType, ignoreNulls);
+}
+
 } // namespace
 
 void registerArrayAggAggregate(
@@ -259,8 +286,29 @@ void registerArrayAggAggregate(
           const core::QueryConfig& config) -> std::unique_ptr<exec::Aggregate> {
         VELOX_CHECK_EQ(
             argTypes.size(), 1, "{} takes at most one argument", name);
-        return std::make_unique<ArrayAggAggregate>(
-            resultType, config.prestoArrayAggIgnoreNulls());
+        const bool ignoreNulls = config.prestoArrayAggIgnoreNulls();
+        // Fixed-width elements are stored contiguously.
+        switch (argTypes[0]->kind()) {
+          case TypeKind::TINYINT:
+            return makeFixedWidth<int8_t>(resultType, ignoreNulls);
+          case TypeKind::SMALLINT:
+            return makeFixedWidth<int16_t>(resultType, ignoreNulls);
+          case TypeKind::INTEGER:
+            return makeFixedWidth<int32_t>(resultType, ignoreNulls);
+          case TypeKind::BIGINT:
+            return makeFixedWidth<int64_t>(resultType, ignoreNulls);
+          case TypeKind::HUGEINT:
+            return makeFixedWidth<int128_t>(resultType, ignoreNulls);
+          case TypeKind::REAL:
+            return makeFixedWidth<float>(resultType, ignoreNulls);
+          case TypeKind::DOUBLE:
+            return makeFixedWidth<double>(resultType, ignoreNulls);
+          case TypeKind::TIMESTAMP:
+            return makeFixedWidth<Timestamp>(resultType, ignoreNulls);
+          default:
+            return std::make_unique<ArrayAggAggregate<ValueList>>(
+                resultType, ignoreNulls);
+        }
       },
       withCompanionFunctions);
 }
@@ -120,6 +120,16 @@ class MaxAggregate : public MinMaxAggregate<T> {
  public:
   explicit MaxAggregate(TypePtr resultType) : MinMaxAggregate<T>(resultType) {}
 
+  exec::Aggregate::DenseKind denseKind() const override {
+    if constexpr (
+        std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+        !std::is_same_v<T, int128_t>) {
+      return exec::Aggregate::DenseKind::kMax;
+    } else {
+      return exec::Aggregate::DenseKind::kNone;
+    }
+  }
+
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
@@ -205,6 +215,16 @@ class MinAggregate : public MinMaxAggregate<T> {
  public:
   explicit MinAggregate(TypePtr resultType) : MinMaxAggregate<T>(resultType) {}
 
+  exec::Aggregate::DenseKind denseKind() const override {
+    if constexpr (
+        std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+        !std::is_same_v<T, int128_t>) {
+      return exec::Aggregate::DenseKind::kMin;
+    } else {
+      return exec::Aggregate::DenseKind::kNone;
+    }
+  }
+
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/CheckedArithmetic.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/expression/ComplexViewTypes.h"
@@ -132,4 +133,137 @@ class ValueListReader {
   vector_size_t pos_{0};
 };
 
+// Represents a list of values of a fixed-width type T, including nulls, for
+// array_agg. Unlike ValueList, the values are stored contiguously in a single
+// allocation that doubles in size as values are added, followed by one
+// not-null bit per value. The values are read back with memcpy. The first
+// allocation has space for kInitialCapacity values, so that a small list makes
+// a single allocation.
+template <typename T>
+class FixedWidthValueList {
+ public:
+  static constexpr uint32_t kInitialCapacity = 8;
+
+  void appendValue(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      HashStringAllocator* allocator) {
+    reserve(size_ + 1, allocator);
+    if (decoded.isNullAt(index)) {
+      setNull(size_);
+    } else {
+      const T value = decoded.valueAt<T>(index);
+      memcpy(data_ + size_ * sizeof(T), &value, sizeof(T));
+      bits::setBit(notNulls(), size_, true);
+    }
+    ++size_;
+  }
+
+  void appendRange(
+      const VectorPtr& vector,
+      vector_size_t offset,
+      vector_size_t size,
+      HashStringAllocator* allocator) {
+    reserve(size_ + size, allocator);
+    if (auto* flat = vector->asFlatVector<T>()) {
+      memcpy(
+          data_ + size_ * sizeof(T),
+          flat->rawValues() + offset,
+          size * sizeof(T));
+      for (auto i = 0; i < size; ++i) {
+        if (flat->isNullAt(offset + i)) {
+          setNull(size_ + i);
+        } else {
+          bits::setBit(notNulls(), size_ + i, true);
+        }
+      }
+    } else {
+      auto* simple = vector->as<SimpleVector<T>>();
+      for (auto i = 0; i < size; ++i) {
+        if (simple->isNullAt(offset + i)) {
+          setNull(size_ + i);
+        } else {
+          const T value = simple->valueAt(offset + i);
+          memcpy(data_ + (size_ + i) * sizeof(T), &value, sizeof(T));
+          bits::setBit(notNulls(), size_ + i, true);
+        }
+      }
+    }
+    size_ += size;
+  }
+
+  int32_t size() const {
+    return size_;
+  }
+
+  bool hasNulls() const {
+    return hasNulls_;
+  }
+
+  // Copies the values and null flags to 'values' starting at 'offset'.
+  void read(FlatVector<T>& values, vector_size_t offset) const {
+    if (size_ == 0) {
+      return;
+    }
+    memcpy(values.mutableRawValues() + offset, data_, size_ * sizeof(T));
+    if (hasNulls_) {
+      const auto* notNullBits = notNulls();
+      for (auto i = 0; i < size_; ++i) {
+        values.setNull(offset + i, !bits::isBitSet(notNullBits, i));
+      }
+    } else if (values.rawNulls() != nullptr) {
+      values.clearNulls(offset, offset + size_);
+    }
+  }
+
+  void free(HashStringAllocator* allocator) {
+    if (data_ != nullptr) {
+      allocator->free(HashStringAllocator::headerOf(data_));
+      data_ = nullptr;
+    }
+  }
+
+ private:
+  uint8_t* notNulls() const {
+    return reinterpret_cast<uint8_t*>(data_ + capacity_ * sizeof(T));
+  }
+
+  void setNull(uint32_t index) {
+    bits::setBit(notNulls(), index, false);
+    hasNulls_ = true;
+  }
+
+  // Makes space for 'size' values, moving the values to a larger allocation
+  // if needed.
+  void reserve(uint32_t size, HashStringAllocator* allocator) {
+    if (size <= capacity_) {
+      return;
+    }
+    auto newCapacity = std::max(capacity_ * 2, kInitialCapacity);
+    while (newCapacity < size) {
+      newCapacity *= 2;
+    }
+    auto* newData = allocator
+                        ->allocate(checkedPlus<int32_t>(
+                            checkedMultiply<int32_t>(newCapacity, sizeof(T)),
+                            bits::nbytes(newCapacity)))
+                        ->begin();
+    if (data_ != nullptr) {
+      memcpy(newData, data_, size_ * sizeof(T));
+      memcpy(
+          newData + newCapacity * sizeof(T), notNulls(), bits::nbytes(size_));
+      allocator->free(HashStringAllocator::headerOf(data_));
+    }
+    data_ = newData;
+    capacity_ = newCapacity;
+  }
+
+  // 'capacity_' values followed by 'capacity_' not-null bits. The values are
+  // accessed with memcpy since the allocation is not aligned for T.
+  char* data_{nullptr};
+  uint32_t size_{0};
+  uint32_t capacity_{0};
+  bool hasNulls_{false};
+};
+
 } // namespace facebook::velox::aggregate
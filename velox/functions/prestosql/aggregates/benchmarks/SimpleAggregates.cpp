@@ -24,6 +24,11 @@
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 DEFINE_int64(fuzzer_seed, 99887766, "Seed for random input dataset generator");
+DEFINE_bool(
+    dense_accumulation,
+    false,
+    "Sets aggregation_dense_accumulation_enabled, which affects the "
+    "aggregations over k_array");
 
 using namespace facebook::velox;
 using namespace facebook::velox::connector::hive;
@@ -164,7 +169,11 @@ class SimpleAggregatesBenchmark : public HiveConnectorTestBase {
         "t",
         std::move(plan),
         0,
-        std::make_shared<core::QueryCtx>(executor_.get()));
+        std::make_shared<core::QueryCtx>(
+            executor_.get(),
+            core::QueryConfig(
+                {{core::QueryConfig::kAggregationDenseAccumulation,
+                  FLAGS_dense_accumulation ? "true" : "false"}})));
   }
 
  private:
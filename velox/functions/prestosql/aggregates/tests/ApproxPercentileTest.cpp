@@ -400,6 +400,38 @@ TEST_F(ApproxPercentileTest, finalAggregateAccuracy) {
   assertQuery(op, "SELECT 5");
 }
 
+TEST_F(ApproxPercentileTest, finalAggregateGroupBy) {
+  // Each group gets 10 sketches in one batch of intermediate results. The
+  // sketches are exact, so the result matches a single aggregation.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 7; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 10; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+  });
+  auto singlePlan = PlanBuilder()
+                        .values({data})
+                        .singleAggregation(
+                            {"c0"},
+                            {"approx_percentile(c2, 0.5)",
+                             "approx_percentile(c2, 0.9)"})
+                        .planNode();
+  auto expected = AssertQueryBuilder(singlePlan).copyResults(pool());
+
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .partialAggregation(
+                      {"c0", "c1"},
+                      {"approx_percentile(c2, 0.5)",
+                       "approx_percentile(c2, 0.9)"})
+                  .project({"c0", "a0", "a1"})
+                  .finalAggregation(
+                      {"c0"},
+                      {"approx_percentile(a0)", "approx_percentile(a1)"},
+                      {{INTEGER(), DOUBLE()}, {INTEGER(), DOUBLE()}})
+                  .planNode();
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
 TEST_F(ApproxPercentileTest, invalidEncoding) {
   auto indices = AlignedBuffer::allocate<vector_size_t>(3, pool());
   auto rawIndices = indices->asMutable<vector_size_t>();
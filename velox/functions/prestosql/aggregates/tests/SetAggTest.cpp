@@ -696,5 +696,56 @@ TEST_F(SetAggTest, inputOrder) {
   assertQuery(plan, expected);
 }
 
+TEST_F(SetAggTest, smallAndLargeSets) {
+  // Group i has i + 1 distinct values. Sets of up to 16 values are kept in a
+  // small array and larger ones in a hash table. Even groups have a null.
+  constexpr int32_t kNumGroups = 40;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(4'000, [](auto row) { return row % kNumGroups; }),
+      makeFlatVector<int64_t>(
+          4'000,
+          [](auto row) { return (row / kNumGroups) % (row % kNumGroups + 1); },
+          [](auto row) { return row % 2 == 0 && row / kNumGroups == 5; }),
+  });
+
+  std::vector<std::vector<std::optional<int64_t>>> sets(kNumGroups);
+  for (auto i = 0; i < kNumGroups; ++i) {
+    for (auto j = 0; j <= i; ++j) {
+      sets[i].push_back(j);
+    }
+    if (i % 2 == 0) {
+      sets[i].push_back(std::nullopt);
+    }
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(kNumGroups, [](auto row) { return row; }),
+      makeNullableArrayVector<int64_t>(sets),
+  });
+
+  testAggregations(
+      {data}, {"c0"}, {"set_agg(c1)"}, {"c0", "array_sort(a0)"}, {expected});
+
+  // The order of input is preserved when a small set becomes a hash table.
+  std::vector<std::optional<int64_t>> values;
+  std::vector<std::optional<int64_t>> uniqueValues;
+  for (auto i = 0; i < 30; ++i) {
+    if (i == 10) {
+      values.push_back(std::nullopt);
+      uniqueValues.push_back(std::nullopt);
+    }
+    values.push_back(100 - i);
+    values.push_back(100 - i / 2);
+    uniqueValues.push_back(100 - i);
+  }
+  data = makeRowVector({makeNullableFlatVector<int64_t>(values)});
+  expected = makeRowVector({makeNullableArrayVector<int64_t>({uniqueValues})});
+
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation({}, {"set_agg(c0)"})
+                  .planNode();
+  assertQuery(plan, expected);
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::test
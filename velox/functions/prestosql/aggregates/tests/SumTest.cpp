@@ -250,6 +250,19 @@ TEST_F(SumTest, sumDecimalOverflow) {
   longDecimalOutput.push_back(DecimalUtil::kLongDecimalMin);
   decimalSumOverflow(longDecimalInput, longDecimalOutput);
 
+  // The partial sums overflow many times in both directions.
+  longDecimalInput.clear();
+  longDecimalOutput.clear();
+  for (auto i = 0; i < 100; ++i) {
+    longDecimalInput.push_back(DecimalUtil::kLongDecimalMax);
+  }
+  for (auto i = 0; i < 99; ++i) {
+    longDecimalInput.push_back(DecimalUtil::kLongDecimalMin);
+  }
+  longDecimalInput.push_back(-1);
+  longDecimalOutput.push_back(DecimalUtil::kLongDecimalMax - 1);
+  decimalSumOverflow(longDecimalInput, longDecimalOutput);
+
   // Check value in range.
   longDecimalInput.clear();
   longDecimalInput.push_back(DecimalUtil::kLongDecimalMax);
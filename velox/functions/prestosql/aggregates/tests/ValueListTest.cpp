@@ -111,6 +111,46 @@ TEST_F(ValueListTest, integers) {
   }
 }
 
+TEST_F(ValueListTest, fixedWidth) {
+  auto testRoundTrip = [&](const VectorPtr& data) {
+    const auto size = data->size();
+    DecodedVector decoded(*data);
+
+    aggregate::FixedWidthValueList<int64_t> values;
+    for (auto i = 0; i < size; ++i) {
+      values.appendValue(decoded, i, allocator());
+    }
+    // Appends the same values again from a range.
+    values.appendRange(data, 0, size, allocator());
+    ASSERT_EQ(2 * size, values.size());
+    ASSERT_EQ(data->mayHaveNulls(), values.hasNulls());
+
+    // Starts with all nulls to check that read() sets the null flags.
+    auto result = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), 2 * size + 1, pool());
+    for (auto i = 0; i < result->size(); ++i) {
+      result->setNull(i, true);
+    }
+    values.read(*result, 1);
+    ASSERT_TRUE(result->isNullAt(0));
+    for (auto i = 0; i < 2 * size; ++i) {
+      ASSERT_TRUE(data->equalValueAt(result.get(), i % size, i + 1)) << i;
+    }
+    values.free(allocator());
+  };
+
+  for (auto size : {1, 7, 8, 9, 1'000}) {
+    testRoundTrip(makeFlatVector<int64_t>(size, [](auto row) { return row; }));
+    testRoundTrip(makeFlatVector<int64_t>(
+        size, [](auto row) { return row; }, nullEvery(3)));
+    // A range of a non-flat vector is copied value by value.
+    testRoundTrip(wrapInDictionary(
+        makeIndicesInReverse(size),
+        makeFlatVector<int64_t>(
+            size, [](auto row) { return row * 3; }, nullEvery(5))));
+  }
+}
+
 TEST_F(ValueListTest, arrays) {
   // No nulls.
   int32_t kSizeCaps[] = {730, 4000, 7500, 50000};
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+// Returns arrays of 'arraySize' elements with about half as many distinct
+// values. Sorted arrays are sorted in ascending order.
+VectorPtr makeArrays(
+    test::VectorMaker& maker,
+    vector_size_t numRows,
+    vector_size_t arraySize,
+    bool sorted) {
+  return maker.arrayVector<int64_t>(
+      numRows,
+      [&](auto /*row*/) { return arraySize; },
+      [&](auto row, auto index) {
+        return sorted ? index / 2 : (index * 7'919 + row) % (arraySize / 2);
+      });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  functions::prestosql::registerArrayFunctions();
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  auto& maker = benchmarkBuilder.vectorMaker();
+
+  struct Input {
+    std::string name;
+    vector_size_t numRows;
+    vector_size_t arraySize;
+    bool sorted;
+  };
+  // Small arrays are searched linearly, large arrays are sorted or found
+  // sorted and mid-size arrays are hashed.
+  const std::vector<Input> inputs = {
+      {"small", 10'000, 10, false},
+      {"medium", 1'000, 200, false},
+      {"large", 20, 10'000, false},
+      {"large_sorted", 20, 10'000, true},
+  };
+  for (const auto& input : inputs) {
+    auto data = maker.rowVector({
+        makeArrays(maker, input.numRows, input.arraySize, input.sorted),
+        makeArrays(maker, input.numRows, input.arraySize / 2, input.sorted),
+    });
+    benchmarkBuilder
+        .addBenchmarkSet(fmt::format("array_set_{}", input.name), data)
+        .addExpression("distinct", "array_distinct(c0)")
+        .addExpression("intersect", "array_intersect(c0, c1)")
+        .addExpression("except", "array_except(c0, c1)")
+        .withIterations(100)
+        .disableTesting();
+  }
+
+  benchmarkBuilder.registerBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -42,6 +42,15 @@ namespace facebook::velox::functions::detail {
   return *it.first->second;
 }
 
+/* static */ std::shared_ptr<SIMDJsonExtractor> SIMDJsonExtractor::tryCompile(
+    folly::StringPiece path) {
+  std::shared_ptr<SIMDJsonExtractor> extractor(new SIMDJsonExtractor());
+  if (!extractor->tokenize(folly::trimWhitespace(path).str())) {
+    return nullptr;
+  }
+  return extractor;
+}
+
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
   thread_local static JsonPathTokenizer tokenizer;
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "folly/Range.h"
@@ -33,6 +34,16 @@ simdjson::error_code simdJsonExtract(
     const velox::StringView& path,
     TConsumer&& consumer);
 
+namespace detail {
+class SIMDJsonExtractor;
+}
+
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    detail::SIMDJsonExtractor& extractor,
+    TConsumer&& consumer);
+
 namespace detail {
 
 using JsonVector = std::vector<simdjson::ondemand::value>;
@@ -55,6 +66,10 @@ class SIMDJsonExtractor {
   // simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  // Returns an extractor for 'path' that is not cached, or nullptr if 'path'
+  // is not valid. Used to compile the paths once per expression.
+  static std::shared_ptr<SIMDJsonExtractor> tryCompile(folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -63,6 +78,8 @@ class SIMDJsonExtractor {
     }
   }
 
+  SIMDJsonExtractor() = default;
+
   bool tokenize(const std::string& path);
 
   // Max number of extractors cached in extractorCache.
@@ -156,7 +173,18 @@ simdjson::error_code simdJsonExtract(
   auto& extractor = detail::SIMDJsonExtractor::getInstance(path);
   simdjson::padded_string paddedJson(json.data(), json.size());
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  return simdJsonExtract(
+      jsonDoc, extractor, std::forward<TConsumer>(consumer));
+}
 
+/// Like simdJsonExtract() above but for a parsed document and a compiled path.
+/// Used to extract several paths from a document that is parsed once. The
+/// document must be rewound between calls.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    detail::SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
     // document.  Note, we cannot convert this to a value as this is not
@@ -164,7 +192,7 @@ simdjson::error_code simdJsonExtract(
     return consumer(jsonDoc);
   }
   SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
-  return extractor.extract(value, std::forward<TConsumer>(consumer));
+  return extractor.extract(value, consumer);
 }
 
 template <typename TConsumer>
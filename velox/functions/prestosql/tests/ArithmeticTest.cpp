@@ -116,6 +116,34 @@ TEST_F(ArithmeticTest, minus) {
   assertExpression("c0 - c1", op1, op2, expected);
 }
 
+TEST_F(ArithmeticTest, checkedPlusMinusBatch) {
+  // Flat inputs without nulls are computed in batches up to the first
+  // overflow and the remaining rows one by one.
+  auto a = makeFlatVector<int64_t>(
+      100, [](auto row) { return row == 37 ? kLongMax : row; });
+  auto b = makeFlatVector<int64_t>(100, [](auto row) { return row; });
+  auto data = makeRowVector({a, b});
+
+  VELOX_ASSERT_THROW(evaluate("c0 + c1", data), "integer overflow");
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row * 2; }, [](auto row) {
+            return row == 37;
+          }),
+      evaluate("try(c0 + c1)", data));
+
+  a = makeFlatVector<int64_t>(
+      100, [](auto row) { return row == 61 ? kLongMin : row * 3; });
+  data = makeRowVector({a, b});
+  VELOX_ASSERT_THROW(evaluate("c0 - c1", data), "integer overflow");
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row * 2; }, [](auto row) {
+            return row == 61;
+          }),
+      evaluate("try(c0 - c1)", data));
+}
+
 TEST_F(ArithmeticTest, divide)
 #if defined(__has_feature)
 #if __has_feature(__address_sanitizer__)
@@ -329,3 +329,60 @@ TEST_F(ArrayDistinctTest, constant) {
   expected = makeConstantArray<int64_t>(size, {6});
   assertEqualVectors(expected, result);
 }
+
+TEST_F(ArrayDistinctTest, sizes) {
+  // Small arrays are deduplicated by linear search, mid-size arrays by
+  // hashing and large arrays by sorting, with a shortcut for sorted arrays.
+  auto makeArray = [](vector_size_t size, bool sorted, int32_t seed) {
+    std::vector<std::optional<int64_t>> array;
+    for (auto i = 0; i < size; ++i) {
+      if (!sorted && i % 97 == 13) {
+        array.push_back(std::nullopt);
+      } else {
+        array.push_back(sorted ? i / 3 : (i * seed) % (size / 2 + 1));
+      }
+    }
+    return array;
+  };
+  auto distinct = [](const std::vector<std::optional<int64_t>>& array) {
+    std::vector<std::optional<int64_t>> result;
+    for (const auto& value : array) {
+      if (std::find(result.begin(), result.end(), value) == result.end()) {
+        result.push_back(value);
+      }
+    }
+    return result;
+  };
+
+  std::vector<std::vector<std::optional<int64_t>>> arrays = {
+      makeArray(10, false, 7),
+      makeArray(16, true, 0),
+      makeArray(100, false, 13),
+      makeArray(3'000, false, 31),
+      makeArray(3'000, true, 0),
+      makeArray(5'000, false, 11),
+  };
+  std::vector<std::vector<std::optional<int64_t>>> expected;
+  for (const auto& array : arrays) {
+    expected.push_back(distinct(array));
+  }
+  auto result = evaluate(
+      "array_distinct(c0)", makeRowVector({makeNullableArrayVector(arrays)}));
+  assertEqualVectors(makeNullableArrayVector(expected), result);
+
+  // Large arrays of strings.
+  std::vector<std::vector<std::string>> strings(2);
+  std::vector<std::vector<std::string>> expectedStrings(2);
+  for (auto i = 0; i < 2'000; ++i) {
+    strings[0].push_back(fmt::format("string value {}", i % 300));
+    strings[1].push_back(fmt::format("string value {}", 2'000 - i));
+    if (i < 300) {
+      expectedStrings[0].push_back(strings[0].back());
+    }
+    expectedStrings[1].push_back(strings[1].back());
+  }
+  result = evaluate(
+      "array_distinct(c0)",
+      makeRowVector({makeArrayVector<std::string>(strings)}));
+  assertEqualVectors(makeArrayVector<std::string>(expectedStrings), result);
+}
@@ -320,3 +320,57 @@ TEST_F(ArrayIntersectTest, dictionaryEncodedElementsInConstant) {
       "array_intersect(c0, testing_dictionary_array_elements(ARRAY [2, 2, 3, 1, 2, 2]))",
       {array});
 }
+
+TEST_F(ArrayIntersectTest, sizes) {
+  // Small arrays are compared by linear search, large arrays by sorting and
+  // merging and others by hashing.
+  auto makeArray = [](vector_size_t size, int32_t seed, bool withNulls) {
+    std::vector<std::optional<int64_t>> array;
+    for (auto i = 0; i < size; ++i) {
+      if (withNulls && i % 101 == 7) {
+        array.push_back(std::nullopt);
+      } else {
+        array.push_back((i * seed) % (size / 2 + 1));
+      }
+    }
+    return array;
+  };
+  auto intersect = [](const std::vector<std::optional<int64_t>>& left,
+                      const std::vector<std::optional<int64_t>>& right) {
+    std::vector<std::optional<int64_t>> result;
+    for (const auto& value : left) {
+      const bool found =
+          std::find(right.begin(), right.end(), value) != right.end();
+      if (found == true &&
+          std::find(result.begin(), result.end(), value) == result.end()) {
+        result.push_back(value);
+      }
+    }
+    return result;
+  };
+
+  std::vector<std::vector<std::optional<int64_t>>> left = {
+      makeArray(10, 3, true),
+      makeArray(16, 5, false),
+      makeArray(200, 7, true),
+      makeArray(3'000, 31, true),
+      makeArray(3'000, 1, false),
+      makeArray(2'000, 13, false),
+  };
+  std::vector<std::vector<std::optional<int64_t>>> right = {
+      makeArray(12, 5, false),
+      makeArray(8, 3, true),
+      makeArray(300, 11, false),
+      makeArray(4'000, 17, true),
+      makeArray(2'000, 1, false),
+      makeArray(10, 7, false),
+  };
+  std::vector<std::vector<std::optional<int64_t>>> expected;
+  for (auto i = 0; i < left.size(); ++i) {
+    expected.push_back(intersect(left[i], right[i]));
+  }
+  testExpr(
+      makeNullableArrayVector(expected),
+      "array_intersect(c0, c1)",
+      {makeNullableArrayVector(left), makeNullableArrayVector(right)});
+}
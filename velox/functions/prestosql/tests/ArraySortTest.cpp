@@ -350,6 +350,42 @@ TEST_P(ArraySortTest, basic) {
   runTest(GetParam());
 }
 
+TEST_F(ArraySortTest, largeArrays) {
+  // Arrays of at least kMinRadixSortSize fixed-width values are radix sorted.
+  auto data = makeArrayVector<int64_t>(
+      3,
+      [](auto row) { return 1'000 * (row + 1); },
+      [](auto index) { return (index * 7'919) % 1'009 - 500; },
+      nullptr,
+      nullEvery(17));
+  auto sorted = [&](bool ascending) {
+    std::vector<std::vector<std::optional<int64_t>>> arrays;
+    auto* elements = data->elements()->asFlatVector<int64_t>();
+    for (auto row = 0; row < data->size(); ++row) {
+      std::vector<std::optional<int64_t>> array;
+      vector_size_t numNulls = 0;
+      for (auto i = 0; i < data->sizeAt(row); ++i) {
+        const auto index = data->offsetAt(row) + i;
+        if (elements->isNullAt(index)) {
+          ++numNulls;
+        } else {
+          array.push_back(elements->valueAt(index));
+        }
+      }
+      std::sort(array.begin(), array.end(), [&](auto left, auto right) {
+        return ascending ? left < right : right < left;
+      });
+      array.insert(array.end(), numNulls, std::nullopt);
+      arrays.push_back(std::move(array));
+    }
+    return makeNullableArrayVector(arrays);
+  };
+  assertEqualVectors(
+      sorted(true), evaluate("array_sort(c0)", makeRowVector({data})));
+  assertEqualVectors(
+      sorted(false), evaluate("array_sort_desc(c0)", makeRowVector({data})));
+}
+
 TEST_F(ArraySortTest, constant) {
   vector_size_t size = 1'000;
   auto data =
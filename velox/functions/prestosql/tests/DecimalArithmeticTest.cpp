@@ -293,6 +293,90 @@ TEST_F(DecimalArithmeticTest, multiply) {
       "Decimal overflow. Value '119630519620642428561342635425231011830' is not in the range of Decimal Type");
 }
 
+TEST_F(DecimalArithmeticTest, overflowFree) {
+  // The result precisions are not capped at 38, so the results are computed
+  // without overflow checks.
+  constexpr vector_size_t kSize = 1'000;
+  auto a = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 7 - 3'000; }, nullptr, DECIMAL(10, 2));
+  auto b = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 13 + 5; }, nullptr, DECIMAL(12, 4));
+  auto longB = makeFlatVector<int128_t>(
+      kSize,
+      [](auto row) { return HugeInt::build(row, row * 11); },
+      nullptr,
+      DECIMAL(26, 4));
+
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row * 7 - 3'000) * 100 + row * 13 + 5; },
+          nullptr,
+          DECIMAL(13, 4)),
+      "c0 + c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row * 7 - 3'000) * 100 - (row * 13 + 5); },
+          nullptr,
+          DECIMAL(13, 4)),
+      "c0 - c1",
+      {a, b});
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          kSize,
+          [](auto row) {
+            return int128_t(row * 7 - 3'000) * 100 -
+                HugeInt::build(row, row * 11);
+          },
+          nullptr,
+          DECIMAL(27, 4)),
+      "c0 - c1",
+      {a, longB});
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          kSize,
+          [](auto row) {
+            return int128_t(row * 7 - 3'000) * HugeInt::build(row, row * 11);
+          },
+          nullptr,
+          DECIMAL(36, 6)),
+      "c0 * c1",
+      {a, longB});
+
+  // Constant arguments.
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return 125 + row * 7 - 3'000; },
+          nullptr,
+          DECIMAL(11, 2)),
+      "1.25 + c0",
+      {a});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row * 13 + 5) * 30; },
+          nullptr,
+          DECIMAL(14, 5)),
+      "c0 * 3.0",
+      {b});
+
+  // Rows that are not selected are not written.
+  SelectivityVector rows(kSize);
+  for (auto i = 0; i < kSize; i += 3) {
+    rows.setValid(i, false);
+  }
+  rows.updateBounds();
+  auto result = evaluate("c0 + c1", makeRowVector({a, b}), rows);
+  auto* flatResult = result->asFlatVector<int64_t>();
+  rows.applyToSelected([&](auto row) {
+    ASSERT_EQ(
+        flatResult->valueAt(row), (row * 7 - 3'000) * 100 + row * 13 + 5);
+  });
+}
+
 TEST_F(DecimalArithmeticTest, decimalDivTest) {
   auto shortFlat = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(17, 3));
   // Divide short and short, returning long.
@@ -1086,3 +1086,55 @@ TEST_F(ElementAtTest, testCachingOptimzation) {
     test::assertEqualVectors(result, result1);
   }
 }
+
+TEST_F(ElementAtTest, batchKeyIndex) {
+  // 100 maps of 500 keys each. Map i has key j * 2 -> i * 1000 + j.
+  constexpr vector_size_t kNumMaps = 100;
+  constexpr vector_size_t kMapSize = 500;
+  auto inputMap = makeMapVector<int64_t, int64_t>(
+      kNumMaps,
+      [](auto /*row*/) { return kMapSize; },
+      [](auto idx) { return (idx % kMapSize) * 2; },
+      [](auto idx) { return (idx / kMapSize) * 1000 + idx % kMapSize; });
+
+  exec::ExprSet exprSet({}, &execCtx_);
+  auto inputs = makeRowVector({});
+  exec::EvalCtx evalCtx(&execCtx_, &exprSet, inputs.get());
+  SelectivityVector rows(kNumMaps);
+  functions::MapSubscript mapSubscript(false);
+
+  // Several subscripts of the same map in one batch share an index.
+  for (auto key : {10, 11, 998}) {
+    std::vector<VectorPtr> args = {
+        inputMap, makeConstant<int64_t>(key, kNumMaps)};
+    auto result = mapSubscript.applyMap(rows, args, evalCtx);
+    auto expected = makeFlatVector<int64_t>(
+        kNumMaps,
+        [&](auto row) { return row * 1000 + key / 2; },
+        [&](auto /*row*/) { return key % 2 == 1; });
+    test::assertEqualVectors(expected, result);
+  }
+
+  // A dictionary over the maps with a constant key searches each map once.
+  auto indices = makeIndices(1'000, [](auto row) { return row % kNumMaps; });
+  auto dictionaryMap =
+      BaseVector::wrapInDictionary(nullptr, indices, 1'000, inputMap);
+  rows.resize(1'000);
+  std::vector<VectorPtr> args = {
+      dictionaryMap, makeConstant<int64_t>(20, 1'000)};
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return (row % kNumMaps) * 1000 + 10; }),
+      mapSubscript.applyMap(rows, args, evalCtx));
+
+  // Different keys per row over a dictionary use the index too.
+  args = {
+      dictionaryMap,
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; })};
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(
+          1'000,
+          [](auto row) { return (row % kNumMaps) * 1000 + row % 7 / 2; },
+          [](auto row) { return row % 7 % 2 == 1; }),
+      mapSubscript.applyMap(rows, args, evalCtx));
+}
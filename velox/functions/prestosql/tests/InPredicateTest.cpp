@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/String.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 
@@ -412,6 +414,42 @@ TEST_F(InPredicateTest, varchar) {
   assertEqualVectors(expected, result);
 }
 
+TEST_F(InPredicateTest, longInList) {
+  const vector_size_t size = 1'000;
+  // Lists with more values than fit a SmallInSet.
+  std::vector<std::string> numbers;
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 300; ++i) {
+    numbers.push_back(std::to_string(i * 3));
+    strings.push_back(fmt::format("'value {}'", i * 3));
+  }
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int16_t>(size, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          size, [](auto row) { return fmt::format("value {}", row); }),
+  });
+  auto expected = makeFlatVector<bool>(
+      size, [](auto row) { return row % 3 == 0 && row < 900; });
+  const auto numberList = folly::join(", ", numbers);
+  for (const auto& column : {"c0", "c1", "c2"}) {
+    assertEqualVectors(
+        expected,
+        evaluate(fmt::format("{} IN ({})", column, numberList), data));
+  }
+  assertEqualVectors(
+      expected,
+      evaluate(fmt::format("c3 IN ({})", folly::join(", ", strings)), data));
+
+  // Partially selected rows are tested one at a time.
+  SelectivityVector rows(size);
+  rows.setValidRange(0, 100, false);
+  rows.updateBounds();
+  auto result = evaluate(fmt::format("c0 IN ({})", numberList), data, rows);
+  assertEqualVectors(expected, result, rows);
+}
+
 TEST_F(InPredicateTest, varcharConstant) {
   const vector_size_t size = 1'000;
   auto rowVector = makeRowVector(
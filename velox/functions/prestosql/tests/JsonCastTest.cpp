@@ -255,6 +255,18 @@ TEST_F(JsonCastTest, fromVarchar) {
       VARCHAR(),
       {std::nullopt, std::nullopt, std::nullopt, std::nullopt},
       {std::nullopt, std::nullopt, std::nullopt, std::nullopt});
+
+  // Strings that are written as-is mixed with strings that need escaping.
+  testCastToJson<StringView>(
+      VARCHAR(),
+      {"a string longer than the inline size"_sv,
+       "a \"quoted\" string longer than the inline size"_sv,
+       "tab\tseparated"_sv,
+       "another plain string longer than the inline size"_sv},
+      {R"("a string longer than the inline size")"_sv,
+       R"("a \"quoted\" string longer than the inline size")"_sv,
+       R"("tab\tseparated")"_sv,
+       R"("another plain string longer than the inline size")"_sv});
 }
 
 TEST_F(JsonCastTest, fromBoolean) {
@@ -193,9 +193,13 @@ TEST_F(JsonFunctionsTest, jsonParse) {
   EXPECT_EQ(jsonParse(R"(null)"), "null");
   EXPECT_EQ(jsonParse(R"(42)"), "42");
   EXPECT_EQ(jsonParse(R"("abc")"), R"("abc")");
-  EXPECT_EQ(jsonParse(R"([1, 2, 3])"), "[1, 2, 3]");
+  EXPECT_EQ(jsonParse(R"([1, 2, 3])"), "[1,2,3]");
   EXPECT_EQ(jsonParse(R"({"k1":"v1"})"), R"({"k1":"v1"})");
-  EXPECT_EQ(jsonParse(R"(["k1", "v1"])"), R"(["k1", "v1"])");
+  EXPECT_EQ(jsonParse(R"(["k1", "v1"])"), R"(["k1","v1"])");
+  // Whitespace in strings is kept.
+  EXPECT_EQ(
+      jsonParse(" { \"k 1\" :\t[ \"v 1\" ,\n null ] } "),
+      R"({"k 1":["v 1",null]})");
 
   VELOX_ASSERT_THROW(
       jsonParse(R"({"k1":})"), "The JSON document has an improper structure");
@@ -239,6 +243,19 @@ TEST_F(JsonFunctionsTest, jsonParse) {
       JSON());
   velox::test::assertEqualVectors(expected, result);
 
+  // Only rows with whitespace outside of strings are rewritten.
+  data = makeRowVector({makeFlatVector<StringView>(
+      {R"({"key": "a long string value", "other": [1, 2]})",
+       R"({"key":"a long string value"})",
+       R"( [ "x" ] )"})});
+  result = evaluate("json_parse(c0)", data);
+  expected = makeFlatVector<StringView>(
+      {R"({"key":"a long string value","other":[1,2]})",
+       R"({"key":"a long string value"})",
+       R"(["x"])"},
+      JSON());
+  velox::test::assertEqualVectors(expected, result);
+
   data = makeRowVector({makeConstant(R"("apple")", 2)});
   result = evaluate("json_parse(c0)", data);
   expected = makeFlatVector<StringView>({{R"("apple")", R"("apple")"}}, JSON());
@@ -571,6 +588,47 @@ TEST_F(JsonFunctionsTest, invalidPath) {
   VELOX_ASSERT_THROW(jsonSize(R"({"k1":"v1)", "$.k1]"), "Invalid JSON path");
 }
 
+TEST_F(JsonFunctionsTest, jsonExtractScalarMultiplePaths) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>({
+      R"({"a": 1, "b": {"c": "x"}, "d": [1, 2]})",
+      R"({"a": true, "b": {"c": null}})",
+      std::nullopt,
+      R"({"a": 1, "b": )",
+      R"([1, 2])",
+      R"({"a": "long string value of a", "b": {"c": 2.5}, "d": [3]})",
+  })});
+  const std::vector<std::string> exprs = {
+      "json_extract_scalar(c0, '$.a')",
+      "concat(json_extract_scalar(c0, '$.b.c'), '!')",
+      "json_extract_scalar(c0, '$.d[0]')",
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.d')",
+  };
+
+  // The calls share one parse of each document.
+  auto exprSet = compileExpressions(exprs, asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_scalar_multi"),
+      std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(exprs.size());
+  exprSet->eval(rows, context, results);
+  for (auto i = 0; i < exprs.size(); ++i) {
+    SCOPED_TRACE(exprs[i]);
+    assertEqualVectors(evaluate(exprs[i], data), results[i]);
+  }
+
+  // An invalid path is not shared, so that errors are reported per row.
+  exprSet = compileExpressions(
+      {"json_extract_scalar(c0, '$.a')", "try(json_extract_scalar(c0, '$k'))"},
+      asRowType(data->type()));
+  ASSERT_EQ(
+      exprSet->toString().find("$internal$json_extract_scalar_multi"),
+      std::string::npos);
+}
+
 TEST_F(JsonFunctionsTest, jsonExtract) {
   auto jsonExtract = [&](std::optional<std::string> json,
                          const std::string& path) {
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <numeric>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/functions/Udf.h"
@@ -289,6 +290,44 @@ TEST_F(SplitTest, split) {
   }
 }
 
+TEST_F(SplitTest, longStrings) {
+  // Delimiters are found a SIMD batch at a time.
+  std::vector<std::string> inputs;
+  std::vector<std::vector<std::string>> expected;
+  std::vector<std::vector<std::string>> expectedLimit;
+  for (auto i = 0; i < 20; ++i) {
+    std::vector<std::string> parts;
+    std::string input;
+    for (auto j = 0; j < i; ++j) {
+      parts.push_back(std::string(i * j % 37, 'a' + j));
+      input += parts.back() + "|";
+    }
+    parts.push_back(std::string(i, 'z'));
+    input += parts.back();
+    inputs.push_back(input);
+    expected.push_back(parts);
+    std::vector<std::string> limited(
+        parts.begin(), parts.begin() + std::min<size_t>(parts.size(), 4));
+    if (parts.size() > 4) {
+      limited.back() = input.substr(
+          std::accumulate(
+              parts.begin(),
+              parts.begin() + 3,
+              size_t(0),
+              [](auto size, const auto& part) {
+                return size + part.size() + 1;
+              }));
+    }
+    expectedLimit.push_back(limited);
+  }
+  auto data = makeRowVector({makeFlatVector<std::string>(inputs)});
+  assertEqualVectors(
+      makeArrayVector<std::string>(expected), evaluate("split(c0, '|')", data));
+  assertEqualVectors(
+      makeArrayVector<std::string>(expectedLimit),
+      evaluate("split(c0, '|', 4)", data));
+}
+
 /// Test split vector function with errors.
 TEST_F(SplitTest, splitError) {
   const std::string delim = ",";
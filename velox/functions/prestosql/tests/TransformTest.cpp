@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 
 using namespace facebook::velox;
@@ -184,3 +185,82 @@ TEST_F(TransformTest, try) {
   });
   assertEqualVectors(expectedResult, result);
 }
+
+TEST_F(TransformTest, fusedChains) {
+  auto input = makeRowVector({
+      makeNullableArrayVector<int64_t>({
+          {{1, 2, 3, 4}},
+          {{-1, 0, 2}},
+          std::nullopt,
+          {{}},
+          {{5, std::nullopt, 7}},
+      }),
+      makeFlatVector<int64_t>({10, 20, 30, 40, 50}),
+  });
+
+  auto exprName = [&](const std::string& expr) {
+    auto exprSet = compileExpression(expr, asRowType(input->type()));
+    return exprSet->exprs()[0]->name();
+  };
+
+  // transform over filter is evaluated in one pass. The filter removes the
+  // elements that would fail in the transform.
+  const std::string filterTransform =
+      "transform(filter(c0, x -> x <> 2), y -> y * 10 + c1 / (y - 2))";
+  ASSERT_EQ(exprName(filterTransform), "$internal$filter_transform");
+  auto expected = makeNullableArrayVector<int64_t>({
+      {{0, 40, 45}},
+      {{-16, -10}},
+      std::nullopt,
+      {{}},
+      {{66, 80}},
+  });
+  assertEqualVectors(expected, evaluate(filterTransform, input));
+
+  // Nested transforms are composed into one lambda.
+  const std::string transforms =
+      "transform(transform(c0, x -> x + 1), y -> y * c1)";
+  auto exprSet = compileExpression(
+      "transform(" + transforms + ", z -> z - 1)", asRowType(input->type()));
+  ASSERT_EQ(
+      exprSet->exprs()[0]->toString().find("transform(transform"),
+      std::string::npos);
+  expected = makeNullableArrayVector<int64_t>({
+      {{20, 30, 40, 50}},
+      {{0, 20, 60}},
+      std::nullopt,
+      {{}},
+      {{300, std::nullopt, 400}},
+  });
+  assertEqualVectors(expected, evaluate(transforms, input));
+
+  // 'x' in the outer lambda is a column, so the lambdas are not composed but
+  // the result is the same.
+  auto withX = makeRowVector(
+      {"c0", "x"},
+      {input->childAt(0), makeFlatVector<int64_t>({1, 1, 1, 1, 1})});
+  assertEqualVectors(
+      makeNullableArrayVector<int64_t>({
+          {{3, 4, 5, 6}},
+          {{1, 2, 4}},
+          std::nullopt,
+          {{}},
+          {{7, std::nullopt, 9}},
+      }),
+      evaluate("transform(transform(c0, x -> x + 1), y -> y + x)", withX));
+
+  // Errors in the filter are reported for the failing rows.
+  VELOX_ASSERT_THROW(
+      evaluate("transform(filter(c0, x -> 6 / x > 0), y -> y + 1)", input),
+      "division by zero");
+  assertEqualVectors(
+      makeNullableArrayVector<int64_t>({
+          {{2, 3, 4, 5}},
+          std::nullopt,
+          std::nullopt,
+          {{}},
+          {{6}},
+      }),
+      evaluate(
+          "try(transform(filter(c0, x -> 6 / x > 0), y -> y + 1))", input));
+}
@@ -77,17 +77,62 @@ void generateJsonTyped(
   }
 }
 
+// Writes 'value' in quotes directly into 'flatResult' if it has no characters
+// that need escaping. Returns false otherwise.
+bool tryWriteJsonString(
+    StringView value,
+    vector_size_t row,
+    FlatVector<StringView>& flatResult) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  for (auto i = 0; i < value.size(); ++i) {
+    if (data[i] < 0x20 || data[i] >= 0x7f || data[i] == '"' ||
+        data[i] == '\\') {
+      return false;
+    }
+  }
+  exec::StringWriter<> writer(&flatResult, row);
+  writer.resize(value.size() + 2);
+  writer.data()[0] = '"';
+  std::memcpy(writer.data() + 1, value.data(), value.size());
+  writer.data()[value.size() + 1] = '"';
+  writer.finalize();
+  return true;
+}
+
+// Reserves space in 'flatResult' for the quoted strings of 'rows'.
+template <typename T>
+void reserveJsonStrings(
+    const SimpleVector<T>& inputVector,
+    const SelectivityVector& rows,
+    FlatVector<StringView>& flatResult) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    size_t totalSize = 0;
+    rows.applyToSelected([&](auto row) {
+      if (!inputVector.isNullAt(row)) {
+        totalSize += inputVector.valueAt(row).size() + 2;
+      }
+    });
+    flatResult.getBufferWithSpace(totalSize);
+  }
+}
+
 template <typename T, bool legacyCast>
 void generateJsonNonKeyTyped(
     const SimpleVector<T>& inputVector,
     exec::EvalCtx& context,
     const SelectivityVector& rows,
     FlatVector<StringView>& flatResult) {
+  reserveJsonStrings(inputVector, rows, flatResult);
   std::string result;
   context.applyToSelectedNoThrow(rows, [&](auto row) {
     if (inputVector.isNullAt(row)) {
       flatResult.set(row, "null");
     } else {
+      if constexpr (std::is_same_v<T, StringView>) {
+        if (tryWriteJsonString(inputVector.valueAt(row), row, flatResult)) {
+          return;
+        }
+      }
       result.clear();
       generateJsonTyped<T, legacyCast>(
           inputVector, row, result, inputVector.type());
@@ -103,11 +148,17 @@ void generateJsonKeyTyped(
     exec::EvalCtx& context,
     const SelectivityVector& rows,
     FlatVector<StringView>& flatResult) {
+  reserveJsonStrings(inputVector, rows, flatResult);
   std::string result;
   context.applyToSelectedNoThrow(rows, [&](auto row) {
     if (inputVector.isNullAt(row)) {
       VELOX_USER_FAIL("Map keys cannot be null.");
     } else {
+      if constexpr (std::is_same_v<T, StringView>) {
+        if (tryWriteJsonString(inputVector.valueAt(row), row, flatResult)) {
+          return;
+        }
+      }
       result.clear();
 
       if constexpr (!std::is_same_v<T, StringView>) {
@@ -129,6 +129,42 @@ TEST_F(AggregateWindowTest, variableWidthAggregate) {
       input, "max(c2)", kOverClauses, {""}, false);
 }
 
+// Tests sliding frames that are large enough to be computed from a segment
+// tree over the partition.
+TEST_F(AggregateWindowTest, largeSlidingFrames) {
+  const vector_size_t size = 3'000;
+  auto input = {makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row * 7919) % 1'000; }, nullEvery(5)),
+      makeFlatVector<bool>(size, [](auto row) { return row % 7 != 0; }),
+  })};
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 30 preceding and 30 following",
+      "rows between current row and 200 following",
+      "rows between 80 preceding and 10 following",
+  };
+  bool createTable = true;
+  for (const auto& function :
+       {"sum(c2)",
+        "min(c2)",
+        "max(c2)",
+        "count(c2)",
+        "avg(c2)",
+        "bool_and(c3)",
+        "bool_or(c3)"}) {
+    WindowTestBase::testWindowFunction(
+        input,
+        function,
+        {"partition by c0 order by c1", "order by c1"},
+        frameClauses,
+        createTable);
+    createTable = false;
+  }
+}
+
 // Tests function with k RANGE PRECEDING (FOLLOWING) frames.
 TEST_F(AggregateWindowTest, rangeFrames) {
   for (const auto& function : kAggregateFunctions) {
@@ -17,6 +17,7 @@
 #include "velox/functions/remote/client/Remote.h"
 
 #include <folly/io/async/EventBase.h>
+#include <deque>
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/remote/client/ThriftClient.h"
@@ -43,7 +44,9 @@ class RemoteFunction : public exec::VectorFunction {
         location_(metadata.location),
         thriftClient_(getThriftClient(location_, &eventBase_)),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        maxRequestBytes_(metadata.maxRequestBytes),
+        maxRequestsInFlight_(std::max(1, metadata.maxRequestsInFlight)) {
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -81,6 +84,13 @@ class RemoteFunction : public exec::VectorFunction {
   }
 
  private:
+  // A request for rows [offset, offset + size) of the input.
+  struct PendingRequest {
+    vector_size_t offset;
+    vector_size_t size;
+    folly::SemiFuture<remote::RemoteFunctionResponse> response;
+  };
+
   void applyRemote(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -95,8 +105,8 @@ class RemoteFunction : public exec::VectorFunction {
         rows.end(),
         std::move(args));
 
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    // The handle and flags are set once for all requests. Only the payload
+    // differs between requests.
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -106,21 +116,75 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
     requestInputs->pageFormat_ref() = serdeFormat_;
 
-    // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
+    const auto numRows = remoteRowVector->size();
+    const auto batchSize = rowsPerRequest(*remoteRowVector);
+    std::deque<PendingRequest> pending;
+    auto receive = [&]() {
+      auto& next = pending.front();
+      auto output =
+          receiveResult(std::move(next.response), outputType, context);
+      if (next.size == numRows) {
+        result = std::move(output);
+      } else {
+        if (next.offset == 0) {
+          result = BaseVector::create(outputType, numRows, context.pool());
+        }
+        result->copy(output.get(), next.offset, 0, next.size);
+      }
+      pending.pop_front();
+    };
+
+    vector_size_t offset = 0;
+    do {
+      if (pending.size() >= static_cast<size_t>(maxRequestsInFlight_)) {
+        receive();
+      }
+      const auto size = std::min(batchSize, numRows - offset);
+      auto input = size == numRows
+          ? remoteRowVector
+          : std::static_pointer_cast<RowVector>(
+                remoteRowVector->slice(offset, size));
+      requestInputs->rowCount_ref() = size;
+      // TODO: serialize only active rows.
+      requestInputs->payload_ref() =
+          rowVectorToIOBuf(input, size, *context.pool(), serde_.get());
+      try {
+        pending.push_back(
+            {offset, size, thriftClient_->semifuture_invokeFunction(request)});
+      } catch (const std::exception& e) {
+        failRemote(e);
+      }
+      offset += size;
+    } while (offset < numRows);
+
+    while (!pending.empty()) {
+      receive();
+    }
+  }
 
+  // Returns the number of rows of 'input' to send in one request.
+  vector_size_t rowsPerRequest(const RowVector& input) const {
+    const auto numRows = input.size();
+    if (maxRequestBytes_ <= 0 || numRows == 0) {
+      return numRows;
+    }
+    const auto rowBytes =
+        std::max<uint64_t>(1, input.estimateFlatSize() / numRows);
+    return std::clamp<int64_t>(maxRequestBytes_ / rowBytes, 1, numRows);
+  }
+
+  // Waits for 'response' and returns the result vector in it.
+  VectorPtr receiveResult(
+      folly::SemiFuture<remote::RemoteFunctionResponse>&& response,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
+    remote::RemoteFunctionResponse remoteResponse;
     try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
+      remoteResponse = std::move(response).via(&eventBase_).getVia(&eventBase_);
     } catch (const std::exception& e) {
-      VELOX_FAIL(
-          "Error while executing remote function '{}' at '{}': {}",
-          functionName_,
-          location_.describe(),
-          e.what());
+      failRemote(e);
     }
 
     auto outputRowVector = IOBufToRowVector(
@@ -128,16 +192,27 @@ class RemoteFunction : public exec::VectorFunction {
         ROW({outputType}),
         *context.pool(),
         serde_.get());
-    result = outputRowVector->childAt(0);
+    return outputRowVector->childAt(0);
+  }
+
+  [[noreturn]] void failRemote(const std::exception& e) const {
+    VELOX_FAIL(
+        "Error while executing remote function '{}' at '{}': {}",
+        functionName_,
+        location_.describe(),
+        e.what());
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  // Drives the client while waiting for responses.
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const int64_t maxRequestBytes_;
+  const int32_t maxRequestsInFlight_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
@@ -30,6 +30,14 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Inputs are sent in requests of about this many bytes, estimated from the
+  /// flat size of the input. 0 sends each input in one request.
+  int64_t maxRequestBytes{4 << 20};
+
+  /// Maximum number of requests in flight for one input. The next request is
+  /// serialized and sent while the previous ones are processed remotely.
+  int32_t maxRequestsInFlight{4};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
@@ -66,6 +66,13 @@ class RemoteFunctionTest
     wrongMetadata.location = folly::SocketAddress(); // empty address.
     registerRemoteFunction("remote_wrong_port", plusSignatures, wrongMetadata);
 
+    // Splits inputs into requests of a few rows with several in flight.
+    RemoteVectorFunctionMetadata batchedMetadata = metadata;
+    batchedMetadata.maxRequestBytes = 100;
+    batchedMetadata.maxRequestsInFlight = 3;
+    registerRemoteFunction(
+        "remote_plus_batched", plusSignatures, batchedMetadata);
+
     auto divSignatures = {exec::FunctionSignatureBuilder()
                               .returnType("double")
                               .argumentType("double")
@@ -83,7 +90,8 @@ class RemoteFunctionTest
     // Registers the actual function under a different prefix. This is only
     // needed for tests since the thrift service runs in the same process.
     registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
-        {remotePrefix_ + ".remote_plus"});
+        {remotePrefix_ + ".remote_plus",
+         remotePrefix_ + ".remote_plus_batched"});
     registerFunction<CheckedDivideFunction, double, double, double>(
         {remotePrefix_ + ".remote_divide"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
@@ -151,6 +159,25 @@ TEST_P(RemoteFunctionTest, string) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, batched) {
+  auto inputVector = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; }, nullEvery(7));
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_batched(c0, c0)", makeRowVector({inputVector}));
+
+  auto expected = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row * 2; }, nullEvery(7));
+  assertEqualVectors(expected, results);
+
+  // A partial selection sends all rows up to the last selected one.
+  SelectivityVector rows(500);
+  rows.setValidRange(0, 100, false);
+  rows.updateBounds();
+  auto partial = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_batched(c0, c0)", makeRowVector({inputVector}), rows);
+  assertEqualVectors(expected, partial, rows);
+}
+
 TEST_P(RemoteFunctionTest, connectionError) {
   auto inputVector = makeFlatVector<int64_t>({1, 2, 3, 4, 5});
   auto func = [&]() {
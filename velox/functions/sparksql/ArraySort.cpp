@@ -20,6 +20,7 @@
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/lib/RadixSort.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
 #include "velox/functions/sparksql/Comparisons.h"
 #include "velox/type/Type.h"
@@ -103,6 +104,8 @@ void applyTyped(
 
   auto flatResults = (*resultElements)->asFlatVector<T>();
   T* resultRawValues = flatResults->mutableRawValues();
+  // Reused by all rows that are radix sorted.
+  Scratch scratch;
 
   auto processRow = [&](vector_size_t row) {
     auto size = inputArray->sizeAt(row);
@@ -143,6 +146,16 @@ void applyTyped(
       bits::fillBits(rawBits, rowBegin, mid, smallerValue);
       bits::fillBits(rawBits, mid, rowEnd, !smallerValue);
     } else {
+      if constexpr (kRadixSortable<T>) {
+        if (rowEnd - rowBegin >= kMinRadixSortSize) {
+          radixSort(
+              resultRawValues + rowBegin,
+              rowEnd - rowBegin,
+              ascending,
+              scratch);
+          return;
+        }
+      }
       if (ascending) {
         std::sort(
             resultRawValues + rowBegin, resultRawValues + rowEnd, Less<T>());
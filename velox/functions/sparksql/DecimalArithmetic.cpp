@@ -225,7 +225,10 @@ class DecimalBaseFunction : public exec::VectorFunction {
         bPrecision_(bPrecision),
         bScale_(bScale),
         rPrecision_(rPrecision),
-        rScale_(rScale) {}
+        rScale_(rScale),
+        overflowFree_(
+            Operation::kHasOverflowFreePath &&
+            rPrecision < LongDecimalType::kMaxPrecision) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -234,6 +237,11 @@ class DecimalBaseFunction : public exec::VectorFunction {
       exec::EvalCtx& context,
       VectorPtr& result) const override {
     auto rawResults = prepareResults(rows, resultType, context, result);
+    if constexpr (Operation::kHasOverflowFreePath) {
+      if (overflowFree_ && applyOverflowFree(rows, args, rawResults)) {
+        return;
+      }
+    }
     if (args[0]->isConstantEncoding() && args[1]->isFlatEncoding()) {
       // Fast path for (const, flat).
       auto constant = args[0]->asUnchecked<SimpleVector<A>>()->valueAt(0);
@@ -354,6 +362,57 @@ class DecimalBaseFunction : public exec::VectorFunction {
     return result->asUnchecked<FlatVector<R>>()->mutableRawValues();
   }
 
+  // Computes the results with Operation::applyOverflowFree() when the result
+  // precision is not adjusted, so that no result can overflow and no result
+  // is null. The rescale multipliers are computed once per batch and the
+  // loop over all rows has no branches. Returns false if an argument is not
+  // flat or constant.
+  bool applyOverflowFree(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      R* rawResults) const {
+    const auto& a = args[0];
+    const auto& b = args[1];
+    if (!(a->isFlatEncoding() || a->isConstantEncoding()) ||
+        !(b->isFlatEncoding() || b->isConstantEncoding()) ||
+        (a->isConstantEncoding() && b->isConstantEncoding())) {
+      return false;
+    }
+    const R aMultiplier = R(velox::DecimalUtil::kPowersOfTen[aRescale_]);
+    const R bMultiplier = R(velox::DecimalUtil::kPowersOfTen[bRescale_]);
+    auto compute = [&](auto aValueAt, auto bValueAt) {
+      if (rows.isAllSelected()) {
+        for (auto row = 0; row < rows.end(); ++row) {
+          rawResults[row] = Operation::template applyOverflowFree<R>(
+              R(aValueAt(row)), R(bValueAt(row)), aMultiplier, bMultiplier);
+        }
+      } else {
+        rows.applyToSelected([&](auto row) {
+          rawResults[row] = Operation::template applyOverflowFree<R>(
+              R(aValueAt(row)), R(bValueAt(row)), aMultiplier, bMultiplier);
+        });
+      }
+    };
+    if (a->isConstantEncoding()) {
+      const auto constant = a->asUnchecked<SimpleVector<A>>()->valueAt(0);
+      const auto* rawB = b->asUnchecked<FlatVector<B>>()->rawValues();
+      compute(
+          [&](auto) { return constant; }, [&](auto row) { return rawB[row]; });
+    } else if (b->isConstantEncoding()) {
+      const auto* rawA = a->asUnchecked<FlatVector<A>>()->rawValues();
+      const auto constant = b->asUnchecked<SimpleVector<B>>()->valueAt(0);
+      compute(
+          [&](auto row) { return rawA[row]; }, [&](auto) { return constant; });
+    } else {
+      const auto* rawA = a->asUnchecked<FlatVector<A>>()->rawValues();
+      const auto* rawB = b->asUnchecked<FlatVector<B>>()->rawValues();
+      compute(
+          [&](auto row) { return rawA[row]; },
+          [&](auto row) { return rawB[row]; });
+    }
+    return true;
+  }
+
   const uint8_t aRescale_;
   const uint8_t bRescale_;
   const uint8_t aPrecision_;
@@ -362,6 +421,8 @@ class DecimalBaseFunction : public exec::VectorFunction {
   const uint8_t bScale_;
   const uint8_t rPrecision_;
   const uint8_t rScale_;
+  // True if the result precision is not adjusted down to 38 digits.
+  const bool overflowFree_;
 };
 
 class Addition {
@@ -407,6 +468,14 @@ class Addition {
     }
   }
 
+  static constexpr bool kHasOverflowFreePath = true;
+
+  template <typename R>
+  inline static R
+  applyOverflowFree(R a, R b, R aMultiplier, R bMultiplier) {
+    return a * aMultiplier + b * bMultiplier;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -455,6 +524,14 @@ class Subtraction {
         overflow);
   }
 
+  static constexpr bool kHasOverflowFreePath = true;
+
+  template <typename R>
+  inline static R
+  applyOverflowFree(R a, R b, R aMultiplier, R bMultiplier) {
+    return a * aMultiplier - b * bMultiplier;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -557,6 +634,15 @@ class Multiply {
     }
   }
 
+  static constexpr bool kHasOverflowFreePath = true;
+
+  // The arguments are not rescaled.
+  template <typename R>
+  inline static R
+  applyOverflowFree(R a, R b, R /*aMultiplier*/, R /*bMultiplier*/) {
+    return a * b;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return 0;
@@ -607,6 +693,9 @@ class Divide {
     DecimalUtil::divideWithRoundUp<R, A, B>(r, a, b, aRescale, overflow);
   }
 
+  // Division by zero gives null.
+  static constexpr bool kHasOverflowFreePath = false;
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale) {
     return rScale - fromScale + toScale;
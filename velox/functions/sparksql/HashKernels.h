@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <folly/CPortability.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/type/DecimalUtil.h"
+#include "velox/type/Timestamp.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::functions::sparksql {
+
+// Derived from src/main/java/org/apache/spark/unsafe/hash/Murmur3_x86_32.java.
+//
+// Spark's Murmur3 seems slightly different from the original from Austin
+// Appleby: in particular the fmix function's first line is different. The
+// original can be found here:
+// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+//
+// Signed integer types have been remapped to unsigned types (as in the
+// original) to avoid undefined signed integer overflow and sign extension.
+
+class Murmur3Hash final {
+ public:
+  using HashType = uint32_t;
+
+  static uint32_t hashInt32(int32_t input, uint32_t seed) {
+    uint32_t k1 = mixK1(input);
+    uint32_t h1 = mixH1(seed, k1);
+    return fmix(h1, 4);
+  }
+
+  static uint32_t hashInt64(uint64_t input, uint32_t seed) {
+    uint32_t low = input;
+    uint32_t high = input >> 32;
+
+    uint32_t k1 = mixK1(low);
+    uint32_t h1 = mixH1(seed, k1);
+
+    k1 = mixK1(high);
+    h1 = mixH1(h1, k1);
+
+    return fmix(h1, 8);
+  }
+
+  // Floating point numbers are hashed as if they are integers, with
+  // -0f defined to have the same output as +0f.
+  static uint32_t hashFloat(float input, uint32_t seed) {
+    return hashInt32(
+        input == -0.f ? 0 : *reinterpret_cast<uint32_t*>(&input), seed);
+  }
+
+  static uint32_t hashDouble(double input, uint32_t seed) {
+    return hashInt64(
+        input == -0. ? 0 : *reinterpret_cast<uint64_t*>(&input), seed);
+  }
+
+  // Spark also has an hashUnsafeBytes2 function, but it was not used at the
+  // time of implementation.
+  static uint32_t hashBytes(const StringView& input, uint32_t seed) {
+    const char* i = input.data();
+    const char* const end = input.data() + input.size();
+    uint32_t h1 = seed;
+    for (; i <= end - 4; i += 4) {
+      h1 = mixH1(h1, mixK1(*reinterpret_cast<const uint32_t*>(i)));
+    }
+    for (; i != end; ++i) {
+      h1 = mixH1(h1, mixK1(*i));
+    }
+    return fmix(h1, input.size());
+  }
+
+  static uint32_t hashLongDecimal(int128_t input, uint32_t seed) {
+    char out[sizeof(int128_t)];
+    int32_t length = DecimalUtil::toByteArray(input, out);
+    return hashBytes(StringView(out, length), seed);
+  }
+
+  static uint32_t hashTimestamp(Timestamp input, uint32_t seed) {
+    return hashInt64(input.toMicros(), seed);
+  }
+
+ private:
+  static uint32_t mixK1(uint32_t k1) {
+    k1 *= 0xcc9e2d51;
+    k1 = bits::rotateLeft(k1, 15);
+    k1 *= 0x1b873593;
+    return k1;
+  }
+
+  static uint32_t mixH1(uint32_t h1, uint32_t k1) {
+    h1 ^= k1;
+    h1 = bits::rotateLeft(h1, 13);
+    h1 = h1 * 5 + 0xe6546b64;
+    return h1;
+  }
+
+  // Finalization mix - force all bits of a hash block to avalanche
+  static uint32_t fmix(uint32_t h1, uint32_t length) {
+    h1 ^= length;
+    h1 ^= h1 >> 16;
+    h1 *= 0x85ebca6b;
+    h1 ^= h1 >> 13;
+    h1 *= 0xc2b2ae35;
+    h1 ^= h1 >> 16;
+    return h1;
+  }
+};
+
+class XxHash64 final {
+  static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87L;
+  static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FL;
+  static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9L;
+  static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63L;
+  static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5L;
+
+ public:
+  using HashType = uint64_t;
+
+  static int64_t hashInt32(const int32_t input, uint64_t seed) {
+    int64_t hash = seed + PRIME64_5 + 4L;
+    hash ^= static_cast<int64_t>((input & 0xFFFFFFFFL) * PRIME64_1);
+    hash = bits::rotateLeft64(hash, 23) * PRIME64_2 + PRIME64_3;
+    return fmix(hash);
+  }
+
+  static int64_t hashInt64(int64_t input, uint64_t seed) {
+    int64_t hash = seed + PRIME64_5 + 8L;
+    hash ^= bits::rotateLeft64(input * PRIME64_2, 31) * PRIME64_1;
+    hash = bits::rotateLeft64(hash, 27) * PRIME64_1 + PRIME64_4;
+    return fmix(hash);
+  }
+
+  // Floating point numbers are hashed as if they are integers, with
+  // -0f defined to have the same output as +0f.
+  static int64_t hashFloat(float input, uint64_t seed) {
+    return hashInt32(
+        input == -0.f ? 0 : *reinterpret_cast<uint32_t*>(&input), seed);
+  }
+
+  static int64_t hashDouble(double input, uint64_t seed) {
+    return hashInt64(
+        input == -0. ? 0 : *reinterpret_cast<uint64_t*>(&input), seed);
+  }
+
+  static uint64_t hashBytes(const StringView& input, uint64_t seed) {
+    const char* i = input.data();
+    const char* const end = input.data() + input.size();
+
+    uint64_t hash = hashBytesByWords(input, seed);
+    uint32_t length = input.size();
+    auto offset = i + (length & -8);
+    if (offset + 4L <= end) {
+      hash ^= (*reinterpret_cast<const uint64_t*>(offset) & 0xFFFFFFFFL) *
+          PRIME64_1;
+      hash = bits::rotateLeft64(hash, 23) * PRIME64_2 + PRIME64_3;
+      offset += 4L;
+    }
+
+    while (offset < end) {
+      hash ^= (*reinterpret_cast<const uint64_t*>(offset) & 0xFFL) * PRIME64_5;
+      hash = bits::rotateLeft64(hash, 11) * PRIME64_1;
+      offset++;
+    }
+    return fmix(hash);
+  }
+
+  static int64_t hashLongDecimal(int128_t input, uint32_t seed) {
+    char out[sizeof(int128_t)];
+    int32_t length = DecimalUtil::toByteArray(input, out);
+    return hashBytes(StringView(out, length), seed);
+  }
+
+  static int64_t hashTimestamp(Timestamp input, uint32_t seed) {
+    return hashInt64(input.toMicros(), seed);
+  }
+
+ private:
+  static uint64_t fmix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+  static uint64_t hashBytesByWords(const StringView& input, uint64_t seed) {
+    const char* i = input.data();
+    const char* const end = input.data() + input.size();
+    uint32_t length = input.size();
+    uint64_t hash;
+    if (length >= 32) {
+      uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+      uint64_t v2 = seed + PRIME64_2;
+      uint64_t v3 = seed;
+      uint64_t v4 = seed - PRIME64_1;
+      for (; i <= end - 32; i += 32) {
+        v1 = bits::rotateLeft64(
+                 v1 + (*reinterpret_cast<const uint64_t*>(i) * PRIME64_2), 31) *
+            PRIME64_1;
+        v2 = bits::rotateLeft64(
+                 v2 + (*reinterpret_cast<const uint64_t*>(i + 8) * PRIME64_2),
+                 31) *
+            PRIME64_1;
+        v3 = bits::rotateLeft64(
+                 v3 + (*reinterpret_cast<const uint64_t*>(i + 16) * PRIME64_2),
+                 31) *
+            PRIME64_1;
+        v4 = bits::rotateLeft64(
+                 v4 + (*reinterpret_cast<const uint64_t*>(i + 24) * PRIME64_2),
+                 31) *
+            PRIME64_1;
+      }
+      hash = bits::rotateLeft64(v1, 1) + bits::rotateLeft64(v2, 7) +
+          bits::rotateLeft64(v3, 12) + bits::rotateLeft64(v4, 18);
+      v1 *= PRIME64_2;
+      v1 = bits::rotateLeft64(v1, 31);
+      v1 *= PRIME64_1;
+      hash ^= v1;
+      hash = hash * PRIME64_1 + PRIME64_4;
+
+      v2 *= PRIME64_2;
+      v2 = bits::rotateLeft64(v2, 31);
+      v2 *= PRIME64_1;
+      hash ^= v2;
+      hash = hash * PRIME64_1 + PRIME64_4;
+
+      v3 *= PRIME64_2;
+      v3 = bits::rotateLeft64(v3, 31);
+      v3 *= PRIME64_1;
+      hash ^= v3;
+      hash = hash * PRIME64_1 + PRIME64_4;
+
+      v4 *= PRIME64_2;
+      v4 = bits::rotateLeft64(v4, 31);
+      v4 *= PRIME64_1;
+      hash ^= v4;
+      hash = hash * PRIME64_1 + PRIME64_4;
+    } else {
+      hash = seed + PRIME64_5;
+    }
+
+    hash += length;
+
+    for (; i <= end - 8; i += 8) {
+      hash ^= bits::rotateLeft64(
+                  *reinterpret_cast<const uint64_t*>(i) * PRIME64_2, 31) *
+          PRIME64_1;
+      hash = bits::rotateLeft64(hash, 27) * PRIME64_1 + PRIME64_4;
+    }
+    return hash;
+  }
+};
+
+/// Hashes 'value' with 'seed' by the hash of 'Hash' for the type of 'value'.
+template <typename Hash, typename T>
+FOLLY_ALWAYS_INLINE typename Hash::HashType hashValue(
+    T value,
+    typename Hash::HashType seed) {
+  using HashType = typename Hash::HashType;
+  if constexpr (std::is_same_v<T, int64_t>) {
+    return static_cast<HashType>(Hash::hashInt64(value, seed));
+  } else if constexpr (std::is_same_v<T, float>) {
+    return static_cast<HashType>(Hash::hashFloat(value, seed));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return static_cast<HashType>(Hash::hashDouble(value, seed));
+  } else if constexpr (std::is_same_v<T, int128_t>) {
+    return static_cast<HashType>(Hash::hashLongDecimal(value, seed));
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    return static_cast<HashType>(Hash::hashTimestamp(value, seed));
+  } else if constexpr (std::is_same_v<T, StringView>) {
+    return static_cast<HashType>(Hash::hashBytes(value, seed));
+  } else {
+    // Booleans and integers of up to 32 bits are hashed as 32 bit integers.
+    return static_cast<HashType>(Hash::hashInt32(value, seed));
+  }
+}
+
+/// Hashes 'values' of rows [begin, end) into 'hashes'. The hash of each row is
+/// the seed of the value of the row, so that hashing the columns of a row one
+/// after another gives the hash of the row. Rows that are null in 'nulls'
+/// keep their hash. 'nulls' may be nullptr. The loops have no branches, so
+/// that the compiler can vectorize them for fixed-width values.
+template <typename Hash, typename T>
+void hashValues(
+    const T* values,
+    const uint64_t* nulls,
+    vector_size_t begin,
+    vector_size_t end,
+    typename Hash::HashType* hashes) {
+  if (nulls == nullptr) {
+    for (auto row = begin; row < end; ++row) {
+      hashes[row] = hashValue<Hash>(values[row], hashes[row]);
+    }
+  } else {
+    for (auto row = begin; row < end; ++row) {
+      const auto hash = hashValue<Hash>(values[row], hashes[row]);
+      hashes[row] = bits::isBitNull(nulls, row) ? hashes[row] : hash;
+    }
+  }
+}
+
+/// Hashes the values of 'rows' of 'decoded' into 'hashes' like hashValues().
+/// Flat fixed-width values are hashed a column at a time with hashValues()
+/// when all rows are selected. Throws if 'decoded' has an unsupported type.
+template <typename Hash>
+void hashColumn(
+    const DecodedVector& decoded,
+    TypeKind kind,
+    const SelectivityVector& rows,
+    typename Hash::HashType* hashes) {
+  auto hashRows = [&](auto* dummy) {
+    using T = std::remove_pointer_t<decltype(dummy)>;
+    constexpr bool kFixedWidth =
+        !std::is_same_v<T, bool> && !std::is_same_v<T, StringView>;
+    if constexpr (kFixedWidth) {
+      if (decoded.isIdentityMapping() && rows.isAllSelected()) {
+        // The nulls of an identity mapping are the nulls of the base.
+        hashValues<Hash>(
+            decoded.data<T>(),
+            decoded.base()->rawNulls(),
+            rows.begin(),
+            rows.end(),
+            hashes);
+        return;
+      }
+    }
+    if (decoded.isConstantMapping()) {
+      if (decoded.isNullAt(0)) {
+        return;
+      }
+      const auto value = decoded.valueAt<T>(0);
+      rows.applyToSelected([&](auto row) {
+        hashes[row] = hashValue<Hash>(value, hashes[row]);
+      });
+      return;
+    }
+    rows.applyToSelected([&](auto row) {
+      if (!decoded.isNullAt(row)) {
+        hashes[row] = hashValue<Hash>(decoded.valueAt<T>(row), hashes[row]);
+      }
+    });
+  };
+
+  switch (kind) {
+// Derived from InterpretedHashFunction.hash:
+// https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
+#define CASE(typeEnum, inputType)               \
+  case TypeKind::typeEnum:                      \
+    hashRows(static_cast<inputType*>(nullptr)); \
+    break;
+    CASE(BOOLEAN, bool);
+    CASE(TINYINT, int8_t);
+    CASE(SMALLINT, int16_t);
+    CASE(INTEGER, int32_t);
+    CASE(BIGINT, int64_t);
+    CASE(VARCHAR, StringView);
+    CASE(VARBINARY, StringView);
+    CASE(REAL, float);
+    CASE(DOUBLE, double);
+    CASE(HUGEINT, int128_t);
+    CASE(TIMESTAMP, Timestamp);
+#undef CASE
+    default:
+      VELOX_NYI("Unsupported type for HASH(): {}", mapTypeKindToName(kind));
+  }
+}
+
+} // namespace facebook::velox::functions::sparksql
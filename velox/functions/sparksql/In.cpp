@@ -18,6 +18,7 @@
 
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/Macros.h"
+#include "velox/functions/lib/InSet.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/sparksql/Arena.h"
 #include "velox/functions/sparksql/Comparisons.h"
@@ -27,7 +28,57 @@ namespace facebook::velox::functions::sparksql {
 namespace {
 
 template <typename T>
-class Set : public folly::F14FastSet<T, folly::hasher<T>, Equal<T>> {};
+class Set : public folly::F14FastSet<T, folly::hasher<T>, Equal<T>> {
+ public:
+  // Called after all values are added.
+  void finalize() {}
+};
+
+// Tests integers with a SmallInSet if there are at most
+// SmallInSet::kMaxValues of them.
+template <typename T>
+class IntegerSet {
+ public:
+  void emplace(T value) {
+    set_.emplace(value);
+  }
+
+  bool contains(T value) const {
+    return smallSet_.has_value() ? smallSet_->contains(value)
+                                 : set_.contains(value);
+  }
+
+  void reserve(size_t size) {
+    set_.reserve(size);
+  }
+
+  size_t size() const {
+    return set_.size();
+  }
+
+  auto begin() const {
+    return set_.begin();
+  }
+
+  void finalize() {
+    if (!set_.empty() && set_.size() <= SmallInSet<T>::kMaxValues) {
+      smallSet_.emplace(std::vector<T>(set_.begin(), set_.end()));
+    }
+  }
+
+ private:
+  folly::F14FastSet<T> set_;
+  std::optional<SmallInSet<T>> smallSet_;
+};
+
+template <>
+class Set<int8_t> : public IntegerSet<int8_t> {};
+template <>
+class Set<int16_t> : public IntegerSet<int16_t> {};
+template <>
+class Set<int32_t> : public IntegerSet<int32_t> {};
+template <>
+class Set<int64_t> : public IntegerSet<int64_t> {};
 
 template <>
 class Set<StringView> {
@@ -42,7 +93,9 @@ class Set<StringView> {
   }
 
   bool contains(const StringView& s) const {
-    return set_.contains(std::string_view(s.data(), s.size()));
+    std::string_view sv(s.data(), s.size());
+    return perfectHashSet_ != nullptr ? perfectHashSet_->contains(sv)
+                                      : set_.contains(sv);
   }
 
   void reserve(size_t size) {
@@ -57,9 +110,18 @@ class Set<StringView> {
     return set_.begin();
   }
 
+  void finalize() {
+    if (set_.size() > 1) {
+      perfectHashSet_ = StringPerfectHashSet::create(
+          std::vector<std::string_view>(set_.begin(), set_.end()));
+    }
+  }
+
  private:
   Arena arena_;
   folly::F14FastSet<std::string_view> set_;
+  // Used for lookups instead of 'set_' if not nullptr.
+  std::unique_ptr<StringPerfectHashSet> perfectHashSet_;
 };
 
 template <typename TInput>
@@ -85,6 +147,7 @@ struct InFunctionOuter {
         }
         elements_.emplace(entry.value());
       }
+      elements_.finalize();
     }
 
     FOLLY_ALWAYS_INLINE bool callNullable(
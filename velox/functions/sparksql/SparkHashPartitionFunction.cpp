@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/functions/sparksql/SparkHashPartitionFunction.h"
+
+#include <algorithm>
+
+#include "velox/functions/sparksql/HashKernels.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+// Seed of the 'hash' function and of Spark's HashPartitioning.
+constexpr uint32_t kSeed = 42;
+} // namespace
+
+SparkHashPartitionFunction::SparkHashPartitionFunction(
+    int numBuckets,
+    std::vector<int> bucketToPartition,
+    std::vector<column_index_t> keyChannels,
+    std::vector<VectorPtr> constValues)
+    : numBuckets_(numBuckets),
+      bucketToPartition_(std::move(bucketToPartition)),
+      keyChannels_(std::move(keyChannels)),
+      constValues_(std::move(constValues)) {
+  VELOX_CHECK_GT(numBuckets_, 0);
+  VELOX_CHECK(
+      bucketToPartition_.empty() ||
+      bucketToPartition_.size() == static_cast<size_t>(numBuckets_));
+  const size_t numConstants = std::count(
+      keyChannels_.begin(), keyChannels_.end(), kConstantChannel);
+  VELOX_CHECK_EQ(numConstants, constValues_.size());
+}
+
+std::optional<uint32_t> SparkHashPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  const auto numRows = input.size();
+  rows_.resizeFill(numRows, true);
+  hashes_.assign(numRows, kSeed);
+
+  size_t constIndex = 0;
+  for (const auto channel : keyChannels_) {
+    const auto& key = channel == kConstantChannel
+        ? constValues_[constIndex++]
+        : input.childAt(channel);
+    decoded_.decode(*key, rows_);
+    hashColumn<Murmur3Hash>(decoded_, key->typeKind(), rows_, hashes_.data());
+  }
+
+  partitions.resize(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    // pmod() of the signed hash like Spark.
+    const int32_t hash = hashes_[i];
+    const int32_t bucket = (hash % numBuckets_ + numBuckets_) % numBuckets_;
+    partitions[i] =
+        bucketToPartition_.empty() ? bucket : bucketToPartition_[bucket];
+  }
+  return std::nullopt;
+}
+
+std::unique_ptr<core::PartitionFunction> SparkHashPartitionFunctionSpec::create(
+    int numPartitions) const {
+  std::vector<int> bucketToPartition = bucketToPartition_;
+  if (bucketToPartition.empty()) {
+    bucketToPartition.resize(numBuckets_);
+    for (int bucket = 0; bucket < numBuckets_; ++bucket) {
+      bucketToPartition[bucket] = bucket % numPartitions;
+    }
+  }
+  return std::make_unique<SparkHashPartitionFunction>(
+      numBuckets_, std::move(bucketToPartition), channels_, constValues_);
+}
+
+std::string SparkHashPartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  size_t constIndex = 0;
+  for (auto i = 0; i < channels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    auto channel = channels_[i];
+    if (channel == kConstantChannel) {
+      keys << "\"" << constValues_[constIndex++]->toString(0) << "\"";
+    } else {
+      keys << channel;
+    }
+  }
+
+  return fmt::format("SPARK_HASH(({}) buckets: {})", keys.str(), numBuckets_);
+}
+
+folly::dynamic SparkHashPartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "SparkHashPartitionFunctionSpec";
+  obj["numBuckets"] = ISerializable::serialize(numBuckets_);
+  obj["bucketToPartition"] = ISerializable::serialize(bucketToPartition_);
+  obj["keys"] = ISerializable::serialize(channels_);
+  std::vector<velox::core::ConstantTypedExpr> constValueExprs;
+  constValueExprs.reserve(constValues_.size());
+  for (const auto& value : constValues_) {
+    constValueExprs.emplace_back(value);
+  }
+  obj["constants"] = ISerializable::serialize(constValueExprs);
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr SparkHashPartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  auto channels = ISerializable::deserialize<std::vector<column_index_t>>(
+      obj["keys"], context);
+  const auto constTypedValues =
+      ISerializable::deserialize<std::vector<velox::core::ConstantTypedExpr>>(
+          obj["constants"], context);
+  std::vector<VectorPtr> constValues;
+  constValues.reserve(constTypedValues.size());
+  auto* pool = static_cast<memory::MemoryPool*>(context);
+  for (const auto& value : constTypedValues) {
+    constValues.emplace_back(value->toConstantVector(pool));
+  }
+  return std::make_shared<SparkHashPartitionFunctionSpec>(
+      ISerializable::deserialize<int>(obj["numBuckets"], context),
+      ISerializable::deserialize<std::vector<int>>(
+          obj["bucketToPartition"], context),
+      std::move(channels),
+      std::move(constValues));
+}
+
+void registerSparkHashPartitionFunctionSerDe() {
+  auto& registry = DeserializationWithContextRegistryForSharedPtr();
+  registry.Register(
+      "SparkHashPartitionFunctionSpec",
+      SparkHashPartitionFunctionSpec::deserialize);
+}
+
+} // namespace facebook::velox::functions::sparksql
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::functions::sparksql {
+
+/// Assigns rows to buckets like the hash partitioning and bucketing of Spark:
+/// the bucket of a row is pmod(hash(keys), numBuckets), where hash() is the
+/// Murmur3 hash of Spark with seed 42, i.e. the 'hash' function. The keys are
+/// hashed a column at a time. If 'bucketToPartition' is not empty, the
+/// partition of a row is the partition of its bucket, otherwise the bucket.
+/// 'keyChannels' are the indices of the keys in the input. A key that is a
+/// constant has index kConstantChannel and its value in 'constValues', in the
+/// order of the constant keys.
+class SparkHashPartitionFunction : public core::PartitionFunction {
+ public:
+  SparkHashPartitionFunction(
+      int numBuckets,
+      std::vector<int> bucketToPartition,
+      std::vector<column_index_t> keyChannels,
+      std::vector<VectorPtr> constValues = {});
+
+  SparkHashPartitionFunction(
+      int numBuckets,
+      std::vector<column_index_t> keyChannels,
+      std::vector<VectorPtr> constValues = {})
+      : SparkHashPartitionFunction(
+            numBuckets,
+            {},
+            std::move(keyChannels),
+            std::move(constValues)) {}
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+ private:
+  const int numBuckets_;
+  const std::vector<int> bucketToPartition_;
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<VectorPtr> constValues_;
+
+  // Reusable memory.
+  SelectivityVector rows_;
+  DecodedVector decoded_;
+  std::vector<uint32_t> hashes_;
+};
+
+/// Factory of SparkHashPartitionFunction. If 'bucketToPartition' is empty,
+/// the buckets are assigned to the partitions round-robin like
+/// HivePartitionFunctionSpec does.
+class SparkHashPartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  SparkHashPartitionFunctionSpec(
+      int numBuckets,
+      std::vector<int> bucketToPartition,
+      std::vector<column_index_t> channels,
+      std::vector<VectorPtr> constValues)
+      : numBuckets_(numBuckets),
+        bucketToPartition_(std::move(bucketToPartition)),
+        channels_(std::move(channels)),
+        constValues_(std::move(constValues)) {}
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+ private:
+  const int numBuckets_;
+  const std::vector<int> bucketToPartition_;
+  const std::vector<column_index_t> channels_;
+  const std::vector<VectorPtr> constValues_;
+};
+
+void registerSparkHashPartitionFunctionSerDe();
+
+} // namespace facebook::velox::functions::sparksql
@@ -17,7 +17,7 @@
 #include <utility>
 
 #include "velox/expression/VectorFunction.h"
-#include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions::sparksql {
 namespace {
@@ -41,34 +41,49 @@ class SplitCharacter final : public exec::VectorFunction {
       VectorPtr& result) const override {
     exec::LocalDecodedVector input(context, *args[0], rows);
 
-    BaseVector::ensureWritable(rows, ARRAY(VARCHAR()), context.pool(), result);
-    exec::VectorWriter<Array<Varchar>> resultWriter;
-    resultWriter.init(*result->as<ArrayVector>());
-
+    // Counts the parts of all rows so that the result is allocated once.
+    vector_size_t numElements = 0;
     rows.applyToSelected([&](vector_size_t row) {
-      resultWriter.setOffset(row);
-      auto& arrayWriter = resultWriter.current();
+      const auto current = input->valueAt<StringView>(row);
+      numElements +=
+          stringCore::countByte(current.data(), current.size(), pattern_) + 1;
+    });
+
+    auto* pool = context.pool();
+    auto elements = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), numElements, pool);
+    auto* rawElements = elements->mutableRawValues();
+    BufferPtr offsets = allocateOffsets(rows.end(), pool);
+    BufferPtr sizes = allocateSizes(rows.end(), pool);
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
 
-      const StringView& current = input->valueAt<StringView>(row);
-      const char* pos = current.begin();
+    vector_size_t cursor = 0;
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto current = input->valueAt<StringView>(row);
+      const char* pos = current.data();
       const char* end = pos + current.size();
+      rawOffsets[row] = cursor;
       const char* delim;
       do {
-        delim = std::find(pos, end, pattern_);
-        arrayWriter.add_item().setNoCopy(StringView(pos, delim - pos));
+        delim = pos + stringCore::findByte(pos, end - pos, pattern_);
+        rawElements[cursor++] = StringView(pos, delim - pos);
         pos = delim + 1; // Skip past delim.
       } while (delim != end);
-
-      resultWriter.commit();
+      rawSizes[row] = cursor - rawOffsets[row];
     });
 
-    resultWriter.finish();
-
     // Reference the input StringBuffers since we did not deep copy above.
-    result->as<ArrayVector>()
-        ->elements()
-        ->as<FlatVector<StringView>>()
-        ->acquireSharedStringBuffers(args[0].get());
+    elements->acquireSharedStringBuffers(args[0].get());
+    auto localResult = std::make_shared<ArrayVector>(
+        pool,
+        ARRAY(VARCHAR()),
+        nullptr,
+        rows.end(),
+        std::move(offsets),
+        std::move(sizes),
+        std::move(elements));
+    context.moveOrCopyResult(localResult, rows, result);
   }
 
  private:
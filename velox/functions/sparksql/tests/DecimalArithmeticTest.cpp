@@ -416,6 +416,42 @@ TEST_F(DecimalArithmeticTest, multiply) {
           DECIMAL(38, 0))});
 }
 
+TEST_F(DecimalArithmeticTest, overflowFree) {
+  // The result precisions are not adjusted, so the results are computed
+  // without overflow checks.
+  constexpr vector_size_t kSize = 1'000;
+  auto a = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 7 - 3'000; }, nullptr, DECIMAL(10, 2));
+  auto b = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 13 + 5; }, nullptr, DECIMAL(12, 4));
+  testArithmeticFunction(
+      "add",
+      {a, b},
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row * 7 - 3'000) * 100 + row * 13 + 5; },
+          nullptr,
+          DECIMAL(13, 4)));
+  testArithmeticFunction(
+      "subtract",
+      {a, b},
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row * 7 - 3'000) * 100 - (row * 13 + 5); },
+          nullptr,
+          DECIMAL(13, 4)));
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          kSize,
+          [](auto row) {
+            return int128_t(row * 7 - 3'000) * int128_t(row * 13 + 5);
+          },
+          nullptr,
+          DECIMAL(23, 6)),
+      "multiply(c0, c1)",
+      {a, b});
+}
+
 TEST_F(DecimalArithmeticTest, decimalDivTest) {
   auto shortFlat = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(17, 3));
   // Divide short and short, returning long.
@@ -128,5 +128,45 @@ TEST_F(HashTest, Float) {
   EXPECT_EQ(hash<float>(-limits::infinity()), 427440766);
 }
 
+TEST_F(HashTest, columns) {
+  // Flat columns are hashed a column at a time. The hashes must be the same
+  // as hashing each row on its own.
+  constexpr vector_size_t kSize = 100;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row * 1'000'003; }, nullEvery(7)),
+      makeFlatVector<int32_t>(
+          kSize, [](auto row) { return row - 50; }, nullEvery(5)),
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.25; }),
+      makeFlatVector<StringView>(
+          kSize,
+          [](auto row) { return StringView::makeInline(std::to_string(row)); },
+          nullEvery(3)),
+  });
+  auto result = evaluate<SimpleVector<int32_t>>("hash(c0, c1, c2, c3)", data);
+  auto dictionaryResult = evaluate<SimpleVector<int32_t>>(
+      "hash(c0, c1, c2, c3)",
+      makeRowVector({
+          wrapInDictionary(makeIndicesInReverse(kSize), data->childAt(0)),
+          wrapInDictionary(makeIndicesInReverse(kSize), data->childAt(1)),
+          wrapInDictionary(makeIndicesInReverse(kSize), data->childAt(2)),
+          wrapInDictionary(makeIndicesInReverse(kSize), data->childAt(3)),
+      }));
+  for (auto row = 0; row < kSize; ++row) {
+    auto valueOrNull = [&](auto value, int32_t n) {
+      return row % n == 0 ? std::nullopt : std::make_optional(value);
+    };
+    const auto expected = evaluateOnce<int32_t>(
+        "hash(c0, c1, c2, c3)",
+        valueOrNull(int64_t(row * 1'000'003), 7),
+        valueOrNull(int32_t(row - 50), 5),
+        std::make_optional(row * 0.25),
+        valueOrNull(std::to_string(row), 3));
+    ASSERT_EQ(result->valueAt(row), expected.value()) << row;
+    ASSERT_EQ(dictionaryResult->valueAt(kSize - 1 - row), expected.value())
+        << row;
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/functions/sparksql/SparkHashPartitionFunction.h"
+#include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
+
+namespace facebook::velox::functions::sparksql::test {
+namespace {
+
+class SparkHashPartitionFunctionTest : public SparkFunctionBaseTest {
+ protected:
+  // Returns pmod(hash(<keys>), numBuckets) for each row of 'input'.
+  std::vector<uint32_t> expectedBuckets(
+      const std::string& keys,
+      const RowVectorPtr& input,
+      int numBuckets) {
+    auto hashes =
+        evaluate<SimpleVector<int32_t>>(fmt::format("hash({})", keys), input);
+    std::vector<uint32_t> buckets(input->size());
+    for (auto i = 0; i < input->size(); ++i) {
+      buckets[i] = (hashes->valueAt(i) % numBuckets + numBuckets) % numBuckets;
+    }
+    return buckets;
+  }
+};
+
+TEST_F(SparkHashPartitionFunctionTest, basic) {
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 3, 4, 5}),
+      makeNullableFlatVector<int64_t>({10, std::nullopt, 30, 40, 50}),
+      makeFlatVector<std::string>({"a", "bb", "", "dddd", "eeeee"}),
+  });
+
+  // hash(1) is -559580957.
+  std::vector<uint32_t> partitions;
+  SparkHashPartitionFunction function(8, {0});
+  function.partition(*input, partitions);
+  ASSERT_EQ(partitions[0], 3);
+  ASSERT_EQ(partitions, expectedBuckets("c0", input, 8));
+
+  SparkHashPartitionFunction multiKey(10, {2, 1, 0});
+  multiKey.partition(*input, partitions);
+  ASSERT_EQ(partitions, expectedBuckets("c2, c1, c0", input, 10));
+
+  // Buckets are mapped to partitions.
+  std::vector<int> bucketToPartition = {0, 0, 1, 1, 2, 2, 3, 3};
+  SparkHashPartitionFunction mapped(8, bucketToPartition, {0});
+  mapped.partition(*input, partitions);
+  auto buckets = expectedBuckets("c0", input, 8);
+  for (auto i = 0; i < input->size(); ++i) {
+    ASSERT_EQ(partitions[i], bucketToPartition[buckets[i]]);
+  }
+}
+
+TEST_F(SparkHashPartitionFunctionTest, constantKey) {
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(100, [](auto row) { return row; }),
+      makeConstant<int64_t>(7, 100),
+  });
+  SparkHashPartitionFunction function(
+      16, {0, kConstantChannel}, {makeConstant<int64_t>(7, 1)});
+  std::vector<uint32_t> partitions;
+  function.partition(*input, partitions);
+  ASSERT_EQ(partitions, expectedBuckets("c0, c1", input, 16));
+}
+
+TEST_F(SparkHashPartitionFunctionTest, spec) {
+  registerSparkHashPartitionFunctionSerDe();
+  auto spec = std::make_shared<SparkHashPartitionFunctionSpec>(
+      4,
+      std::vector<int>{},
+      std::vector<column_index_t>{1, kConstantChannel},
+      std::vector<VectorPtr>{makeConstant<int32_t>(3, 1)});
+  ASSERT_EQ(spec->toString(), "SPARK_HASH((1, \"3\") buckets: 4)");
+
+  auto copy = SparkHashPartitionFunctionSpec::deserialize(
+      spec->serialize(), pool());
+  ASSERT_EQ(copy->toString(), spec->toString());
+
+  // 4 buckets into 2 partitions.
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 3}),
+      makeFlatVector<int32_t>({4, 5, 6}),
+  });
+  std::vector<uint32_t> partitions;
+  copy->create(2)->partition(*input, partitions);
+  auto buckets = expectedBuckets("c1, cast(3 as integer)", input, 4);
+  for (auto i = 0; i < input->size(); ++i) {
+    ASSERT_EQ(partitions[i], buckets[i] % 2);
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions::sparksql::test
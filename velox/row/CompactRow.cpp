@@ -184,6 +184,157 @@ int32_t CompactRow::serializeRow(vector_size_t index, char* buffer) {
   return valuesOffset;
 }
 
+namespace {
+// Copies the values of rows in [offset, offset + size) from flat 'values' to
+// 'fieldOffset' bytes from the start of each row. Skips the rows that are null
+// in 'nulls' if 'nulls' is not nullptr. 'kValueBytes' is 0 if the width is
+// known only at runtime.
+template <int32_t kValueBytes>
+void copyFixedWidthValues(
+    const char* values,
+    int32_t valueBytes,
+    const uint64_t* nulls,
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* rowOffsets,
+    size_t fieldOffset,
+    char* buffer) {
+  const auto width = kValueBytes > 0 ? kValueBytes : valueBytes;
+  auto copy = [&](vector_size_t row) {
+    memcpy(
+        buffer + rowOffsets[row - offset] + fieldOffset,
+        values + row * width,
+        width);
+  };
+  if (nulls == nullptr) {
+    for (auto row = offset; row < offset + size; ++row) {
+      copy(row);
+    }
+  } else {
+    bits::forEachSetBit(nulls, offset, offset + size, copy);
+  }
+}
+
+// Calls copyFixedWidthValues() with the common widths as constants.
+void copyFixedWidth(
+    const char* values,
+    int32_t valueBytes,
+    const uint64_t* nulls,
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* rowOffsets,
+    size_t fieldOffset,
+    char* buffer) {
+  switch (valueBytes) {
+    case 1:
+      return copyFixedWidthValues<1>(
+          values, 1, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    case 2:
+      return copyFixedWidthValues<2>(
+          values, 2, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    case 4:
+      return copyFixedWidthValues<4>(
+          values, 4, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    case 8:
+      return copyFixedWidthValues<8>(
+          values, 8, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    case 16:
+      return copyFixedWidthValues<16>(
+          values, 16, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    default:
+      return copyFixedWidthValues<0>(
+          values,
+          valueBytes,
+          nulls,
+          offset,
+          size,
+          rowOffsets,
+          fieldOffset,
+          buffer);
+  }
+}
+} // namespace
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* rowOffsets,
+    char* buffer) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  // Offset of the next field from the start of the row while it is the same
+  // for all rows, i.e. before the first variable-width field.
+  size_t fieldOffset = rowNullBytes_;
+  // Offset of the next field from the start of each row, starting at the
+  // first variable-width field.
+  std::vector<size_t> valuesOffsets;
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+
+    if (childIsFixedWidth_[i] && valuesOffsets.empty()) {
+      if (child.supportsBulkCopy_ && decoded_.isIdentityMapping()) {
+        const uint64_t* nulls =
+            child.decoded_.mayHaveNulls() ? child.decoded_.nulls() : nullptr;
+        if (nulls != nullptr) {
+          bits::forEachUnsetBit(nulls, offset, offset + size, [&](auto row) {
+            bits::setBit(buffer + rowOffsets[row - offset], i, true);
+          });
+        }
+        // decoded_.data<char>() can be null if all values are null.
+        const auto* values = child.decoded_.data<char>();
+        if (values != nullptr && child.valueBytes_ > 0) {
+          copyFixedWidth(
+              values,
+              child.valueBytes_,
+              nulls,
+              offset,
+              size,
+              rowOffsets,
+              fieldOffset,
+              buffer);
+        }
+      } else {
+        for (auto row = offset; row < offset + size; ++row) {
+          const auto childIndex = decoded_.index(row);
+          auto* rowBuffer = buffer + rowOffsets[row - offset];
+          if (child.isNullAt(childIndex)) {
+            bits::setBit(rowBuffer, i, true);
+          } else if (child.valueBytes_ > 0) {
+            child.serializeFixedWidth(childIndex, rowBuffer + fieldOffset);
+          }
+        }
+      }
+      fieldOffset += child.valueBytes_;
+      continue;
+    }
+
+    if (valuesOffsets.empty()) {
+      valuesOffsets.resize(size, fieldOffset);
+    }
+    for (auto row = offset; row < offset + size; ++row) {
+      const auto childIndex = decoded_.index(row);
+      auto* rowBuffer = buffer + rowOffsets[row - offset];
+      auto& valuesOffset = valuesOffsets[row - offset];
+      if (child.isNullAt(childIndex)) {
+        bits::setBit(rowBuffer, i, true);
+        if (childIsFixedWidth_[i]) {
+          valuesOffset += child.valueBytes_;
+        }
+        continue;
+      }
+      if (childIsFixedWidth_[i]) {
+        if (child.valueBytes_ > 0) {
+          child.serializeFixedWidth(childIndex, rowBuffer + valuesOffset);
+        }
+        valuesOffset += child.valueBytes_;
+      } else {
+        valuesOffset +=
+            child.serializeVariableWidth(childIndex, rowBuffer + valuesOffset);
+      }
+    }
+  }
+}
+
 bool CompactRow::isNullAt(vector_size_t index) {
   return decoded_.isNullAt(index);
 }
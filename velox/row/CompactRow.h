@@ -36,6 +36,18 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Serializes rows in [offset, offset + size) one column at a time. Row
+  /// 'offset + i' is written at 'buffer + rowOffsets[i]'. Writes the same
+  /// bytes as serialize(index, buffer) for each row. Flat fixed-width columns
+  /// that precede the first variable-width column are copied in one pass and
+  /// their nulls are read a word at a time. 'buffer' must have sufficient
+  /// capacity and set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* rowOffsets,
+      char* buffer);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
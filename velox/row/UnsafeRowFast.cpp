@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/row/UnsafeRowFast.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::row {
 
@@ -408,4 +409,292 @@ int32_t UnsafeRowFast::serializeRow(vector_size_t index, char* buffer) {
 
   return variableWidthOffset;
 }
+
+namespace {
+// Copies the values of rows in [offset, offset + size) from flat 'values' to
+// 'fieldOffset' bytes from the start of each row. Skips the rows that are null
+// in 'nulls' if 'nulls' is not nullptr. 'kValueBytes' is 0 if the width is
+// known only at runtime.
+template <int32_t kValueBytes>
+void copyFixedWidthValues(
+    const char* values,
+    int32_t valueBytes,
+    const uint64_t* nulls,
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* rowOffsets,
+    size_t fieldOffset,
+    char* buffer) {
+  const auto width = kValueBytes > 0 ? kValueBytes : valueBytes;
+  auto copy = [&](vector_size_t row) {
+    memcpy(
+        buffer + rowOffsets[row - offset] + fieldOffset,
+        values + row * width,
+        width);
+  };
+  if (nulls == nullptr) {
+    for (auto row = offset; row < offset + size; ++row) {
+      copy(row);
+    }
+  } else {
+    bits::forEachSetBit(nulls, offset, offset + size, copy);
+  }
+}
+
+// Calls copyFixedWidthValues() with the common widths as constants.
+void copyFixedWidth(
+    const char* values,
+    int32_t valueBytes,
+    const uint64_t* nulls,
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* rowOffsets,
+    size_t fieldOffset,
+    char* buffer) {
+  switch (valueBytes) {
+    case 1:
+      return copyFixedWidthValues<1>(
+          values, 1, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    case 2:
+      return copyFixedWidthValues<2>(
+          values, 2, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    case 4:
+      return copyFixedWidthValues<4>(
+          values, 4, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    case 8:
+      return copyFixedWidthValues<8>(
+          values, 8, nulls, offset, size, rowOffsets, fieldOffset, buffer);
+    default:
+      return copyFixedWidthValues<0>(
+          values,
+          valueBytes,
+          nulls,
+          offset,
+          size,
+          rowOffsets,
+          fieldOffset,
+          buffer);
+  }
+}
+} // namespace
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* rowOffsets,
+    char* buffer) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  const auto numFields = children_.size();
+  const int64_t fixedWidthBytes = rowNullBytes_ + kFieldWidth * numFields;
+  // Offset of the variable-width data of each row from the start of the row.
+  std::vector<int64_t> variableWidthOffsets;
+
+  for (auto i = 0; i < numFields; ++i) {
+    auto& child = children_[i];
+    const size_t fieldOffset = rowNullBytes_ + i * kFieldWidth;
+
+    if (child.supportsBulkCopy_ && decoded_.isIdentityMapping()) {
+      const uint64_t* nulls =
+          child.decoded_.mayHaveNulls() ? child.decoded_.nulls() : nullptr;
+      if (nulls != nullptr) {
+        bits::forEachUnsetBit(nulls, offset, offset + size, [&](auto row) {
+          bits::setBit(buffer + rowOffsets[row - offset], i, true);
+        });
+      }
+      // decoded_.data<char>() can be null if all values are null.
+      const auto* values = child.decoded_.data<char>();
+      if (values == nullptr) {
+        continue;
+      }
+      copyFixedWidth(
+          values,
+          child.valueBytes_,
+          nulls,
+          offset,
+          size,
+          rowOffsets,
+          fieldOffset,
+          buffer);
+      continue;
+    }
+
+    if (!childIsFixedWidth_[i] && variableWidthOffsets.empty()) {
+      variableWidthOffsets.resize(size, fixedWidthBytes);
+    }
+    for (auto row = offset; row < offset + size; ++row) {
+      const auto childIndex = decoded_.index(row);
+      auto* rowBuffer = buffer + rowOffsets[row - offset];
+      if (child.isNullAt(childIndex)) {
+        bits::setBit(rowBuffer, i, true);
+        continue;
+      }
+      if (childIsFixedWidth_[i]) {
+        child.serializeFixedWidth(childIndex, rowBuffer + fieldOffset);
+        continue;
+      }
+      auto& variableWidthOffset = variableWidthOffsets[row - offset];
+      const auto valueSize = child.serializeVariableWidth(
+          childIndex, rowBuffer + variableWidthOffset);
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | valueSize;
+      reinterpret_cast<uint64_t*>(rowBuffer + rowNullBytes_)[i] =
+          sizeAndOffset;
+      variableWidthOffset += alignBytes(valueSize);
+    }
+  }
+}
+
+// static
+bool UnsafeRowFast::supportsDeserialize(const RowTypePtr& rowType) {
+  for (const auto& child : rowType->children()) {
+    switch (child->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::TIMESTAMP:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+// Returns the nulls of 'field' in 'data' or nullptr if no row is null. The
+// null flags are gathered into a word of 64 rows at a time.
+BufferPtr readNulls(
+    const std::vector<std::string_view>& data,
+    int32_t field,
+    memory::MemoryPool* pool) {
+  const vector_size_t numRows = data.size();
+  BufferPtr nulls;
+  uint64_t* rawNulls = nullptr;
+  for (vector_size_t begin = 0; begin < numRows; begin += 64) {
+    const auto end = std::min(begin + 64, numRows);
+    uint64_t nullWord = 0;
+    for (auto row = begin; row < end; ++row) {
+      nullWord |= static_cast<uint64_t>(bits::isBitSet(
+                      reinterpret_cast<const uint8_t*>(data[row].data()),
+                      field))
+          << (row - begin);
+    }
+    if (nullWord == 0) {
+      continue;
+    }
+    if (rawNulls == nullptr) {
+      nulls = allocateNulls(numRows, pool);
+      rawNulls = nulls->asMutable<uint64_t>();
+    }
+    rawNulls[begin / 64] &= ~nullWord;
+  }
+  return nulls;
+}
+
+// Reads the value at 'fieldOffset' in each row of 'data'. The values of null
+// rows are zeros.
+template <TypeKind Kind>
+VectorPtr deserializeFixedWidth(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    size_t fieldOffset,
+    BufferPtr nulls,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const vector_size_t numRows = data.size();
+  auto values = AlignedBuffer::allocate<T>(numRows, pool);
+  for (auto row = 0; row < numRows; ++row) {
+    const auto* value = data[row].data() + fieldOffset;
+    if constexpr (std::is_same_v<T, bool>) {
+      bits::setBit(values->asMutable<uint64_t>(), row, *value != 0);
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      int64_t micros;
+      memcpy(&micros, value, sizeof(int64_t));
+      values->asMutable<T>()[row] = Timestamp::fromMicros(micros);
+    } else {
+      memcpy(values->asMutable<T>() + row, value, sizeof(T));
+    }
+  }
+  return std::make_shared<FlatVector<T>>(
+      pool,
+      type,
+      std::move(nulls),
+      numRows,
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+// Reads the string whose size and offset are at 'fieldOffset' in each row of
+// 'data'.
+VectorPtr deserializeStrings(
+    const TypePtr& type,
+    const std::vector<std::string_view>& data,
+    size_t fieldOffset,
+    const BufferPtr& nulls,
+    memory::MemoryPool* pool) {
+  const vector_size_t numRows = data.size();
+  auto flatVector =
+      BaseVector::create<FlatVector<StringView>>(type, numRows, pool);
+  const uint64_t* rawNulls = nullptr;
+  if (nulls != nullptr) {
+    flatVector->setNulls(nulls);
+    rawNulls = nulls->as<uint64_t>();
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    if (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) {
+      continue;
+    }
+    uint64_t sizeAndOffset;
+    memcpy(&sizeAndOffset, data[row].data() + fieldOffset, sizeof(uint64_t));
+    const int32_t valueOffset = sizeAndOffset >> 32;
+    const int32_t valueSize = sizeAndOffset & 0xffffffff;
+    flatVector->set(row, StringView(data[row].data() + valueOffset, valueSize));
+  }
+  return flatVector;
+}
+} // namespace
+
+// static
+RowVectorPtr UnsafeRowFast::deserialize(
+    const std::vector<std::string_view>& data,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK(
+      supportsDeserialize(rowType),
+      "Unsupported type for UnsafeRowFast::deserialize: {}",
+      rowType->toString());
+  const vector_size_t numRows = data.size();
+  const auto numFields = rowType->size();
+  const size_t nullBytes = alignBits(numFields);
+
+  std::vector<VectorPtr> fields;
+  fields.reserve(numFields);
+  for (auto i = 0; i < numFields; ++i) {
+    const auto& type = rowType->childAt(i);
+    auto nulls = readNulls(data, i, pool);
+    const size_t fieldOffset = nullBytes + i * kFieldWidth;
+    if (type->kind() == TypeKind::VARCHAR ||
+        type->kind() == TypeKind::VARBINARY) {
+      fields.push_back(
+          deserializeStrings(type, data, fieldOffset, nulls, pool));
+    } else {
+      fields.push_back(VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          deserializeFixedWidth,
+          type->kind(),
+          type,
+          data,
+          fieldOffset,
+          std::move(nulls),
+          pool));
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, nullptr, numRows, std::move(fields));
+}
 } // namespace facebook::velox::row
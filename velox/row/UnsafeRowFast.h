@@ -36,6 +36,29 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Serializes rows in [offset, offset + size) one column at a time. Row
+  /// 'offset + i' is written at 'buffer + rowOffsets[i]'. Writes the same
+  /// bytes as serialize(index, buffer) for each row. Flat fixed-width columns
+  /// are copied in one pass and their nulls are read a word at a time.
+  /// 'buffer' must have sufficient capacity and set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* rowOffsets,
+      char* buffer);
+
+  /// Returns true if all fields of 'rowType' are fixed-width or strings, so
+  /// that rows of 'rowType' can be read by deserialize().
+  static bool supportsDeserialize(const RowTypePtr& rowType);
+
+  /// Deserializes 'data' into a RowVector of 'rowType' one column at a time.
+  /// 'rowType' must be supported by supportsDeserialize(). For other types,
+  /// use UnsafeRowDeserializer.
+  static RowVectorPtr deserialize(
+      const std::vector<std::string_view>& data,
+      const RowTypePtr& rowType,
+      memory::MemoryPool* pool);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
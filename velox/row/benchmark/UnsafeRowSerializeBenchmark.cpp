@@ -40,6 +40,18 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    auto rowOffsets = computeRowOffsets(fast, rowType, data->size());
+    auto buffer = AlignedBuffer::allocate<char>(rowOffsets.back(), pool());
+    fast.serialize(
+        0, data->size(), rowOffsets.data(), buffer->asMutable<char>());
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -53,6 +65,31 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(copy->size(), data->size());
   }
 
+  // Reads the fields of all rows one column at a time if the types allow it.
+  // Otherwise, reads the rows like deserializeUnsafe().
+  void deserializeUnsafeColumnar(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    UnsafeRowFast fast(data);
+    auto totalSize = computeTotalSize(fast, rowType, data->size());
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool());
+    auto serialized = serialize(fast, data->size(), buffer);
+    std::vector<std::string_view> rows;
+    for (const auto& row : serialized) {
+      rows.push_back(row.value());
+    }
+    suspender.dismiss();
+
+    if (UnsafeRowFast::supportsDeserialize(rowType)) {
+      auto copy = UnsafeRowFast::deserialize(rows, rowType, pool());
+      VELOX_CHECK_EQ(copy->size(), data->size());
+    } else {
+      auto copy =
+          UnsafeRowDeserializer::deserialize(serialized, rowType, pool());
+      VELOX_CHECK_EQ(copy->size(), data->size());
+    }
+  }
+
   void serializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -65,6 +102,18 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    auto rowOffsets = computeRowOffsets(compact, rowType, data->size());
+    auto buffer = AlignedBuffer::allocate<char>(rowOffsets.back(), pool());
+    compact.serialize(
+        0, data->size(), rowOffsets.data(), buffer->asMutable<char>());
+  }
+
   void deserializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -118,6 +167,24 @@ class SerializeBenchmark {
     return fuzzer.fuzzInputRow(rowType);
   }
 
+  // Returns the offset of each row in the serialized buffer followed by the
+  // total size.
+  template <typename TRow>
+  std::vector<size_t> computeRowOffsets(
+      TRow& row,
+      const RowTypePtr& rowType,
+      vector_size_t numRows) {
+    std::vector<size_t> rowOffsets(numRows + 1);
+    const auto fixedRowSize = TRow::fixedRowSize(rowType);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      rowOffsets[i] = totalSize;
+      totalSize += fixedRowSize ? *fixedRowSize : row.rowSize(i);
+    }
+    rowOffsets[numRows] = totalSize;
+    return rowOffsets;
+  }
+
   size_t computeTotalSize(
       UnsafeRowFast& unsafeRow,
       const RowTypePtr& rowType,
@@ -205,35 +272,50 @@ class SerializeBenchmark {
       memory::memoryManager()->addLeafPool()};
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)                    \
+  BENCHMARK(unsafe_serialize_##name) {                     \
+    SerializeBenchmark benchmark;                          \
+    benchmark.serializeUnsafe(rowType);                    \
+  }                                                        \
+                                                           \
+  BENCHMARK_RELATIVE(unsafe_serialize_batch_##name) {      \
+    SerializeBenchmark benchmark;                          \
+    benchmark.serializeUnsafeBatch(rowType);               \
+  }                                                        \
+                                                           \
+  BENCHMARK(compact_serialize_##name) {                    \
+    SerializeBenchmark benchmark;                          \
+    benchmark.serializeCompact(rowType);                   \
+  }                                                        \
+                                                           \
+  BENCHMARK_RELATIVE(compact_serialize_batch_##name) {     \
+    SerializeBenchmark benchmark;                          \
+    benchmark.serializeCompactBatch(rowType);              \
+  }                                                        \
+                                                           \
+  BENCHMARK(container_serialize_##name) {                  \
+    SerializeBenchmark benchmark;                          \
+    benchmark.serializeContainer(rowType);                 \
+  }                                                        \
+                                                           \
+  BENCHMARK(unsafe_deserialize_##name) {                   \
+    SerializeBenchmark benchmark;                          \
+    benchmark.deserializeUnsafe(rowType);                  \
+  }                                                        \
+                                                           \
+  BENCHMARK_RELATIVE(unsafe_deserialize_columnar_##name) { \
+    SerializeBenchmark benchmark;                          \
+    benchmark.deserializeUnsafeColumnar(rowType);          \
+  }                                                        \
+                                                           \
+  BENCHMARK(compact_deserialize_##name) {                  \
+    SerializeBenchmark benchmark;                          \
+    benchmark.deserializeCompact(rowType);                 \
+  }                                                        \
+                                                           \
+  BENCHMARK(container_deserialize_##name) {                \
+    SerializeBenchmark benchmark;                          \
+    benchmark.deserializeContainer(rowType);               \
   }
 
 SERDE_BENCHMARKS(
@@ -76,6 +76,17 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     VELOX_CHECK_EQ(offset, totalSize);
 
+    // Serializing all rows at once one column at a time gives the same bytes.
+    std::vector<size_t> rowOffsets;
+    for (const auto& value : serialized) {
+      rowOffsets.push_back(value.data() - rawBuffer);
+    }
+    BufferPtr batch = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    row.serialize(0, numRows, rowOffsets.data(), batch->asMutable<char>());
+    ASSERT_EQ(
+        std::string_view(batch->as<char>(), totalSize),
+        std::string_view(rawBuffer, totalSize));
+
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
   }
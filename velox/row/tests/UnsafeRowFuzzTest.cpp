@@ -179,5 +179,93 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, batch) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      VARCHAR(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARBINARY(),
+      UNKNOWN(),
+      DECIMAL(20, 2),
+      DECIMAL(12, 4),
+      TIMESTAMP(),
+      DATE(),
+      ARRAY(BIGINT()),
+      MAP(VARCHAR(), ROW({INTEGER(), TIMESTAMP()})),
+  });
+  // Types that UnsafeRowFast::deserialize reads one column at a time.
+  auto scalarType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      VARCHAR(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARBINARY(),
+      DECIMAL(12, 4),
+      TIMESTAMP(),
+      DATE(),
+  });
+  ASSERT_FALSE(UnsafeRowFast::supportsDeserialize(rowType));
+  ASSERT_TRUE(UnsafeRowFast::supportsDeserialize(scalarType));
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = kNumBuffers;
+  opts.nullRatio = 0.1;
+  opts.dictionaryHasNulls = false;
+  opts.stringVariableLength = true;
+  opts.stringLength = 20;
+  opts.containerVariableLength = true;
+  opts.containerLength = 10;
+  opts.timestampPrecision =
+      VectorFuzzer::Options::TimestampPrecision::kMicroSeconds;
+  VectorFuzzer fuzzer(opts, pool_.get());
+
+  for (auto i = 0; i < 20; ++i) {
+    const auto seed = folly::Random::rand32();
+    LOG(INFO) << "seed: " << seed;
+    SCOPED_TRACE(fmt::format("seed: {}", seed));
+    fuzzer.reSeed(seed);
+
+    for (const auto& type : {rowType, scalarType}) {
+      clearBuffers();
+      auto data = fuzzer.fuzzInputRow(type);
+      UnsafeRowFast fast(data);
+
+      // Serializes the rows after 'offset' one column at a time.
+      const vector_size_t offset = 7;
+      const vector_size_t numRows = data->size() - offset;
+      std::vector<size_t> rowOffsets;
+      size_t totalSize = 0;
+      for (auto row = offset; row < data->size(); ++row) {
+        rowOffsets.push_back(totalSize);
+        totalSize += fast.rowSize(row);
+      }
+      std::string batch(totalSize, '\0');
+      fast.serialize(offset, numRows, rowOffsets.data(), batch.data());
+
+      std::vector<std::string_view> serialized;
+      for (auto row = 0; row < numRows; ++row) {
+        const auto rowSize = fast.serialize(offset + row, buffers_[row]);
+        serialized.emplace_back(batch.data() + rowOffsets[row], rowSize);
+        ASSERT_EQ(serialized.back(), std::string_view(buffers_[row], rowSize))
+            << row << ", " << data->toString(offset + row);
+      }
+
+      if (type == scalarType) {
+        auto copy = UnsafeRowFast::deserialize(serialized, type, pool_.get());
+        assertEqualVectors(data->slice(offset, numRows), copy);
+      }
+    }
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -38,41 +38,52 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
   void append(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges,
-      Scratch& scratch) override {
-    size_t totalSize = 0;
+      Scratch& /*scratch*/) override {
+    size_t numRows = 0;
+    for (const auto& range : ranges) {
+      numRows += range.size;
+    }
+    if (numRows == 0) {
+      return;
+    }
+
     row::CompactRow row(vector);
-    if (auto fixedRowSize =
-            row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
+    const auto fixedRowSize =
+        row::CompactRow::fixedRowSize(asRowType(vector->type()));
 
-    } else {
-      for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += row.rowSize(i) + sizeof(TRowSize);
-        }
+    // Offset of the size of each row in the buffer, followed by the total
+    // size.
+    rowOffsets_.resize(numRows + 1);
+    size_t totalSize = 0;
+    size_t index = 0;
+    for (const auto& range : ranges) {
+      for (auto i = range.begin; i < range.begin + range.size; ++i) {
+        rowOffsets_[index++] = totalSize;
+        totalSize += sizeof(TRowSize) +
+            (fixedRowSize ? *fixedRowSize : row.rowSize(i));
       }
     }
-
-    if (totalSize == 0) {
-      return;
-    }
+    rowOffsets_[numRows] = totalSize;
 
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool_, 0);
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
-    size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size = row.serialize(i, rawBuffer + offset + sizeof(TRowSize));
+    // Write raw sizes in big endian order and make 'rowOffsets_' point to the
+    // row data.
+    for (auto i = 0; i < numRows; ++i) {
+      const TRowSize size =
+          rowOffsets_[i + 1] - rowOffsets_[i] - sizeof(TRowSize);
+      *(TRowSize*)(rawBuffer + rowOffsets_[i]) = folly::Endian::big(size);
+      rowOffsets_[i] += sizeof(TRowSize);
+    }
 
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    // Write row data one column at a time.
+    index = 0;
+    for (const auto& range : ranges) {
+      row.serialize(
+          range.begin, range.size, rowOffsets_.data() + index, rawBuffer);
+      index += range.size;
     }
   }
 
@@ -91,9 +102,15 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
     buffers_.clear();
   }
 
+  void clear() override {
+    buffers_.clear();
+  }
+
  private:
   memory::MemoryPool* const FOLLY_NONNULL pool_;
   std::vector<BufferPtr> buffers_;
+  // Offsets of the rows of the current append in the last of 'buffers_'.
+  std::vector<size_t> rowOffsets_;
 };
 
 // Read from the stream until the full row is concatenated.
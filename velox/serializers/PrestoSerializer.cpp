@@ -19,6 +19,7 @@
 #include "velox/common/memory/ByteStream.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
 #include "velox/vector/DictionaryVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorTypeUtils.h"
@@ -228,6 +229,51 @@ int32_t checkValuesSize(
   return bufferSize;
 }
 
+// Keeps the memory of a deserialized stream alive for the Buffer views that
+// reference it.
+struct SourceReleaser {
+  explicit SourceReleaser(std::shared_ptr<const void> owner)
+      : owner_(std::move(owner)) {}
+
+  void addRef() const {}
+  void release() const {}
+
+ private:
+  const std::shared_ptr<const void> owner_;
+};
+
+// True if the serialized values of type T can be used as a values buffer
+// as is.
+template <typename T>
+constexpr bool kIsViewableValue = std::is_same_v<T, int8_t> ||
+    std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> ||
+    std::is_same_v<T, int64_t> || std::is_same_v<T, int128_t> ||
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Returns a Buffer view over the next 'size' bytes of 'source' if 'opts'
+// allow zero copy and the bytes are contiguous and aligned to 'alignment'.
+// Returns nullptr without consuming anything otherwise.
+BufferPtr readBytesAsView(
+    ByteInputStream* source,
+    int32_t size,
+    int32_t alignment,
+    const SerdeOpts& opts) {
+  if (!opts.zeroCopy || opts.sourceOwner == nullptr || size == 0) {
+    return nullptr;
+  }
+  const auto position = source->tellp();
+  const auto view = source->nextView(size);
+  if (view.size() != size ||
+      reinterpret_cast<uintptr_t>(view.data()) % alignment != 0) {
+    source->seekp(position);
+    return nullptr;
+  }
+  return BufferView<SourceReleaser>::create(
+      reinterpret_cast<const uint8_t*>(view.data()),
+      size,
+      SourceReleaser(opts.sourceOwner));
+}
+
 template <typename T>
 void readValues(
     ByteInputStream* source,
@@ -495,6 +541,22 @@ void read(
   auto nullCount = readNulls(
       source, size, resultOffset, incomingNulls, numIncomingNulls, *flatResult);
 
+  if constexpr (kIsViewableValue<T>) {
+    if (resultOffset == 0 && nullCount == 0 && !type->isLongDecimal()) {
+      if (auto values = readBytesAsView(
+              source, numNewValues * sizeof(T), alignof(T), opts)) {
+        result = std::make_shared<FlatVector<T>>(
+            pool,
+            type,
+            nullptr,
+            numNewValues,
+            std::move(values),
+            std::vector<BufferPtr>{});
+        return;
+      }
+    }
+  }
+
   BufferPtr values = flatResult->mutableValues(resultOffset + numNewValues);
   if constexpr (std::is_same_v<T, Timestamp>) {
     if (opts.useLosslessTimestamp) {
@@ -563,12 +625,17 @@ void read<StringView>(
     return;
   }
 
-  auto* rawStrings =
-      flatResult->getRawStringBufferWithSpace(dataSize, true /*exactSize*/);
-
-  source->readBytes(rawStrings, dataSize);
+  const char* rawChars;
+  if (auto strings = readBytesAsView(source, dataSize, 1, opts)) {
+    rawChars = strings->as<char>();
+    flatResult->addStringBuffer(strings);
+  } else {
+    auto* rawStrings =
+        flatResult->getRawStringBufferWithSpace(dataSize, true /*exactSize*/);
+    source->readBytes(rawStrings, dataSize);
+    rawChars = rawStrings;
+  }
   int32_t previousOffset = 0;
-  auto rawChars = reinterpret_cast<char*>(rawStrings);
   for (int32_t i = 0; i < numNewValues; ++i) {
     int32_t offset = rawValues[resultOffset + i].size();
     rawValues[resultOffset + i] =
@@ -1990,15 +2057,9 @@ void serializeDictionaryVector(
     return;
   }
 
-  // Cannot serialize dictionary as PrestoPage dictionary if it has nulls.
-  if (vector->nulls()) {
-    stream->flattenStream(vector, rangesTotalSize(ranges));
-    serializeWrapped(vector, ranges, stream, scratch);
-    return;
-  }
-
   using T = typename KindToFlatVector<Kind>::WrapperType;
   auto dictionaryVector = vector->as<DictionaryVector<T>>();
+  const auto* rawNulls = vector->rawNulls();
 
   // Create a bit set to track which values in the Dictionary are used.
   ScratchPtr<uint64_t, 64> usedIndicesHolder(scratch);
@@ -2006,12 +2067,19 @@ void serializeDictionaryVector(
       bits::nwords(dictionaryVector->valueVector()->size()));
   simd::memset(usedIndices, 0, usedIndicesHolder.size() * sizeof(uint64_t));
 
+  // The indices of the rows the dictionary adds nulls to are not read.
   auto* indices = dictionaryVector->indices()->template as<vector_size_t>();
   vector_size_t numRows = 0;
+  vector_size_t numNulls = 0;
   for (const auto& range : ranges) {
     numRows += range.size;
     for (auto i = 0; i < range.size; ++i) {
-      bits::setBit(usedIndices, indices[range.begin + i]);
+      const auto row = range.begin + i;
+      if (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) {
+        ++numNulls;
+        continue;
+      }
+      bits::setBit(usedIndices, indices[row]);
     }
   }
 
@@ -2022,15 +2090,17 @@ void serializeDictionaryVector(
   auto numUsed = simd::indicesOfSetBits(
       usedIndices, 0, selectedIndicesHolder.size(), mutableSelectedIndices);
 
+  // A Presto dictionary has no nulls of its own. The null rows refer to a
+  // null appended to the used values.
+  const vector_size_t numEntries = numUsed + (numNulls > 0 ? 1 : 0);
+
   // If the values are fixed width and we aren't getting enough reuse to justify
   // the dictionary, flatten it.
-  // For variable width types, rather than iterate over them computing their
-  // size, we simply assume we'll get a benefit.
   if constexpr (TypeTraits<Kind>::isFixedWidth) {
     // This calculation admittdely ignores some constants, but if they really
     // make a difference, they're small so there's not much difference either
     // way.
-    if (numUsed * vector->type()->cppSizeInBytes() +
+    if (numEntries * vector->type()->cppSizeInBytes() +
             numRows * sizeof(int32_t) >=
         numRows * vector->type()->cppSizeInBytes()) {
       stream->flattenStream(vector, numRows);
@@ -2039,9 +2109,40 @@ void serializeDictionaryVector(
     }
   }
 
+  // Strings are flattened unless the used values and the indices are smaller
+  // than the strings of all rows. For other variable width types, rather than
+  // iterate over them computing their size, we simply assume we'll get a
+  // benefit.
+  if constexpr (std::is_same_v<T, StringView>) {
+    if (auto* values = dictionaryVector->valueVector()
+                           ->template asFlatVector<StringView>()) {
+      const auto* rawValues = values->rawValues();
+      int64_t dictionarySize = numRows * sizeof(int32_t);
+      for (auto i = 0; i < numUsed; ++i) {
+        dictionarySize +=
+            rawValues[mutableSelectedIndices[i]].size() + sizeof(int32_t);
+      }
+      int64_t flatSize = 0;
+      for (const auto& range : ranges) {
+        for (auto i = 0; i < range.size; ++i) {
+          const auto row = range.begin + i;
+          if (rawNulls == nullptr || !bits::isBitNull(rawNulls, row)) {
+            flatSize += rawValues[indices[row]].size();
+          }
+          flatSize += sizeof(int32_t);
+        }
+      }
+      if (dictionarySize >= flatSize) {
+        stream->flattenStream(vector, numRows);
+        serializeWrapped(vector, ranges, stream, scratch);
+        return;
+      }
+    }
+  }
+
   // If every element is unique the dictionary isn't giving us any benefit,
   // flatten it.
-  if (numUsed == numRows) {
+  if (numEntries == numRows) {
     stream->flattenStream(vector, numRows);
     serializeWrapped(vector, ranges, stream, scratch);
     return;
@@ -2053,6 +2154,9 @@ void serializeDictionaryVector(
       folly::Range<const vector_size_t*>(mutableSelectedIndices, numUsed),
       stream->childAt(0),
       scratch);
+  if (numNulls > 0) {
+    stream->childAt(0)->appendNull();
+  }
 
   // Create a mapping from the original indices to the indices in the shrunk
   // Dictionary of just used values.
@@ -2068,7 +2172,12 @@ void serializeDictionaryVector(
   stream->appendNonNull(numRows);
   for (const auto& range : ranges) {
     for (auto i = 0; i < range.size; ++i) {
-      stream->appendOne(updatedIndices[indices[range.begin + i]]);
+      const auto row = range.begin + i;
+      if (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) {
+        stream->appendOne<int32_t>(numUsed);
+      } else {
+        stream->appendOne(updatedIndices[indices[row]]);
+      }
     }
   }
 }
@@ -3410,26 +3519,41 @@ void flushUncompressed(
   out->seekp(offset + size);
 }
 
+// Compression outcome and state of the pages flushed by an iterative
+// serializer.
+struct CompressionStats {
+  // Maximum number of pages in a row that are sent uncompressed without
+  // trying the codec.
+  static constexpr int32_t kMaxPagesToSkip = 64;
+
+  // Uncompressed size of the pages given to the codec.
+  int64_t compressionInputBytes{0};
+  // Size of the codec output for these pages.
+  int64_t compressedBytes{0};
+  // Size of the pages sent uncompressed without trying the codec.
+  int64_t compressionSkippedBytes{0};
+
+  // Number of pages to send uncompressed before trying the codec again.
+  int32_t numPagesToSkip{0};
+  // Value of 'numPagesToSkip' after the next page that does not compress
+  // well. Doubles with each such page and resets after a page that does.
+  int32_t nextNumPagesToSkip{1};
+};
+
 void flushCompressed(
     const std::vector<std::unique_ptr<VectorStream>>& streams,
     const StreamArena& arena,
     folly::io::Codec& codec,
     int32_t numRows,
     OutputStream* output,
-    PrestoOutputStreamListener* listener) {
-  char codecMask = kCompressedBitMask;
-  if (listener) {
-    codecMask |= kCheckSumBitMask;
-  }
-
+    PrestoOutputStreamListener* listener,
+    std::optional<float> minCompressionRatio,
+    CompressionStats* stats) {
   // Pause CRC computation
   if (listener) {
     listener->pause();
   }
 
-  writeInt32(output, numRows);
-  output->write(&codecMask, 1);
-
   IOBufOutputStream out(*(arena.pool()), nullptr, arena.size());
   writeInt32(&out, streams.size());
 
@@ -3442,19 +3566,45 @@ void flushCompressed(
       uncompressedSize,
       codec.maxUncompressedLength(),
       "UncompressedSize exceeds limit");
-  auto compressed = codec.compress(out.getIOBuf().get());
-  const int32_t compressedSize = compressed->length();
+  auto uncompressed = out.getIOBuf();
+  auto compressed = codec.compress(uncompressed.get());
+  if (stats) {
+    stats->compressionInputBytes += uncompressedSize;
+    stats->compressedBytes += compressed->length();
+  }
+
+  // A page that does not compress well is sent as is.
+  const bool useCompressed = !minCompressionRatio.has_value() ||
+      compressed->length() <= uncompressedSize * minCompressionRatio.value();
+  if (stats) {
+    if (useCompressed) {
+      stats->nextNumPagesToSkip = 1;
+    } else {
+      stats->numPagesToSkip = stats->nextNumPagesToSkip;
+      stats->nextNumPagesToSkip = std::min(
+          CompressionStats::kMaxPagesToSkip, stats->nextNumPagesToSkip * 2);
+    }
+  }
+  const auto& page = useCompressed ? compressed : uncompressed;
+
+  char codecMask = useCompressed ? kCompressedBitMask : 0;
+  if (listener) {
+    codecMask |= kCheckSumBitMask;
+  }
+  const int32_t pageSize = page->computeChainDataLength();
+  writeInt32(output, numRows);
+  output->write(&codecMask, 1);
   writeInt32(output, uncompressedSize);
-  writeInt32(output, compressedSize);
+  writeInt32(output, pageSize);
   const int32_t crcOffset = output->tellp();
   writeInt64(output, 0); // Write zero checksum
   // Number of columns and stream content. Unpause CRC.
   if (listener) {
     listener->resume();
   }
-  output->write(
-      reinterpret_cast<const char*>(compressed->writableData()),
-      compressed->length());
+  for (const auto& range : *page) {
+    output->write(reinterpret_cast<const char*>(range.data()), range.size());
+  }
   // Pause CRC computation
   if (listener) {
     listener->pause();
@@ -3463,20 +3613,27 @@ void flushCompressed(
   // Fill in crc
   int64_t crc = 0;
   if (listener) {
-    crc = computeChecksum(listener, codecMask, numRows, compressedSize);
+    crc = computeChecksum(listener, codecMask, numRows, pageSize);
   }
   output->seekp(crcOffset);
   writeInt64(output, crc);
   output->seekp(endSize);
 }
 
-// Writes the contents to 'out' in wire format
+// Writes the contents to 'out' in wire format. If 'minCompressionRatio' is
+// set, a page whose compressed size is above this fraction of its
+// uncompressed size is written uncompressed. If 'stats' is set, the
+// compression outcome is added to it, and after a page that does not
+// compress well the next 'stats->numPagesToSkip' pages are written
+// uncompressed without trying the codec.
 void flushStreams(
     const std::vector<std::unique_ptr<VectorStream>>& streams,
     int32_t numRows,
     const StreamArena& arena,
     folly::io::Codec& codec,
-    OutputStream* out) {
+    OutputStream* out,
+    std::optional<float> minCompressionRatio = std::nullopt,
+    CompressionStats* stats = nullptr) {
   auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
   // Reset CRC computation
   if (listener) {
@@ -3485,8 +3642,21 @@ void flushStreams(
 
   if (!needCompression(codec)) {
     flushUncompressed(streams, numRows, out, listener);
+  } else if (stats && stats->numPagesToSkip > 0) {
+    --stats->numPagesToSkip;
+    const auto offset = out->tellp();
+    flushUncompressed(streams, numRows, out, listener);
+    stats->compressionSkippedBytes += out->tellp() - offset - kHeaderSize;
   } else {
-    flushCompressed(streams, arena, codec, numRows, out, listener);
+    flushCompressed(
+        streams,
+        arena,
+        codec,
+        numRows,
+        out,
+        listener,
+        minCompressionRatio,
+        stats);
   }
 }
 
@@ -3520,7 +3690,13 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
       serializeColumn(vector->childAt(i), ranges, streams[i].get(), scratch);
     }
 
-    flushStreams(streams, numRows, arena, *codec_, stream);
+    flushStreams(
+        streams,
+        numRows,
+        arena,
+        *codec_,
+        stream,
+        opts_.minCompressionRatio);
   }
 
  private:
@@ -3536,16 +3712,12 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       int32_t numRows,
       StreamArena* streamArena,
       const SerdeOpts& opts)
-      : streamArena_(streamArena),
+      : rowType_(rowType),
+        initialNumRows_(numRows),
+        opts_(opts),
+        streamArena_(streamArena),
         codec_(common::compressionKindToCodec(opts.compressionKind)) {
-    const auto types = rowType->children();
-    const auto numTypes = types.size();
-    streams_.resize(numTypes);
-
-    for (int i = 0; i < numTypes; ++i) {
-      streams_[i] = std::make_unique<VectorStream>(
-          types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
-    }
+    createStreams();
   }
 
   void append(
@@ -3592,16 +3764,216 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // numRows(4) | codec(1) | uncompressedSize(4) | compressedSize(4) |
   // checksum(8) | data
   void flush(OutputStream* out) override {
-    flushStreams(streams_, numRows_, *streamArena_, *codec_, out);
-  }
+    flushStreams(
+        streams_,
+        numRows_,
+        *streamArena_,
+        *codec_,
+        out,
+        opts_.minCompressionRatio,
+        &compressionStats_);
+  }
+
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
+    if (!needCompression(*codec_)) {
+      return {};
+    }
+    return {
+        {"compressionInputBytes",
+         RuntimeCounter(
+             compressionStats_.compressionInputBytes,
+             RuntimeCounter::Unit::kBytes)},
+        {"compressedBytes",
+         RuntimeCounter(
+             compressionStats_.compressedBytes, RuntimeCounter::Unit::kBytes)},
+        {"compressionSkippedBytes",
+         RuntimeCounter(
+             compressionStats_.compressionSkippedBytes,
+             RuntimeCounter::Unit::kBytes)},
+    };
+  }
+
+  void clear() override {
+    numRows_ = 0;
+    createStreams();
+  }
+
+  static void scatter(
+      const RowVectorPtr& vector,
+      const uint32_t* destinations,
+      folly::Range<IterativeVectorSerializer* const*> serializers,
+      Scratch& scratch);
 
  private:
+  void createStreams() {
+    const auto& types = rowType_->children();
+    streams_.resize(types.size());
+    for (int i = 0; i < types.size(); ++i) {
+      streams_[i] = std::make_unique<VectorStream>(
+          types[i],
+          std::nullopt,
+          std::nullopt,
+          streamArena_,
+          initialNumRows_,
+          opts_);
+    }
+  }
+
+  const RowTypePtr rowType_;
+  const int32_t initialNumRows_;
+  const SerdeOpts opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
 
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
+
+  // Kept across clear() so that compression adapts over the pages.
+  CompressionStats compressionStats_;
 };
+
+// Appends row 'i' of 'decoded' to 'streams[destinations[i]]'.
+template <typename T, bool mayHaveNulls>
+void scatterScalar(
+    const DecodedVector& decoded,
+    vector_size_t size,
+    const uint32_t* destinations,
+    VectorStream* const* streams) {
+  for (vector_size_t row = 0; row < size; ++row) {
+    auto* stream = streams[destinations[row]];
+    if (mayHaveNulls && decoded.isNullAt(row)) {
+      stream->appendNull();
+      continue;
+    }
+    stream->appendNonNull();
+    const auto value = decoded.valueAt<T>(row);
+    if constexpr (std::is_same_v<T, StringView>) {
+      stream->appendLength(value.size());
+      stream->values().appendStringView(
+          std::string_view(value.data(), value.size()));
+    } else if constexpr (std::is_same_v<T, bool>) {
+      stream->appendOne<uint8_t>(value ? 1 : 0);
+    } else if constexpr (std::is_same_v<T, int128_t>) {
+      stream->appendOne(
+          stream->isLongDecimal() ? toJavaDecimalValue(value) : value);
+    } else {
+      stream->appendOne(value);
+    }
+  }
+}
+
+template <TypeKind kind>
+void scatterScalar(
+    const DecodedVector& decoded,
+    vector_size_t size,
+    const uint32_t* destinations,
+    VectorStream* const* streams) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if (decoded.mayHaveNulls()) {
+    scatterScalar<T, true>(decoded, size, destinations, streams);
+  } else {
+    scatterScalar<T, false>(decoded, size, destinations, streams);
+  }
+}
+
+// True for the types that scatterScalar() supports. Timestamps are excluded
+// since their wire format depends on the serde options.
+bool isScatterScalarType(const TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// static
+void PrestoIterativeVectorSerializer::scatter(
+    const RowVectorPtr& vector,
+    const uint32_t* destinations,
+    folly::Range<IterativeVectorSerializer* const*> serializers,
+    Scratch& scratch) {
+  const auto numRows = vector->size();
+  const auto numDestinations = serializers.size();
+  std::vector<PrestoIterativeVectorSerializer*> prestoSerializers(
+      numDestinations);
+  for (auto i = 0; i < numDestinations; ++i) {
+    prestoSerializers[i] =
+        static_cast<PrestoIterativeVectorSerializer*>(serializers[i]);
+  }
+
+  // The rows of each destination, for the columns that are appended per
+  // destination. 'offsets[i]' is the start of the rows of destination 'i'.
+  std::vector<vector_size_t> offsets;
+  std::vector<vector_size_t> destinationRows;
+  auto groupRows = [&]() {
+    if (!offsets.empty()) {
+      return;
+    }
+    offsets.resize(numDestinations + 1);
+    for (auto row = 0; row < numRows; ++row) {
+      ++offsets[destinations[row] + 1];
+    }
+    for (auto i = 0; i < numDestinations; ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+    destinationRows.resize(numRows);
+    std::vector<vector_size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (auto row = 0; row < numRows; ++row) {
+      destinationRows[fill[destinations[row]]++] = row;
+    }
+  };
+
+  for (auto row = 0; row < numRows; ++row) {
+    auto* serializer = prestoSerializers[destinations[row]];
+    VELOX_DCHECK_NOT_NULL(serializer);
+    ++serializer->numRows_;
+  }
+
+  std::vector<VectorStream*> streams(numDestinations);
+  DecodedVector decoded;
+  SelectivityVector allRows(numRows);
+  for (auto column = 0; column < vector->childrenSize(); ++column) {
+    for (auto i = 0; i < numDestinations; ++i) {
+      streams[i] = prestoSerializers[i] == nullptr
+          ? nullptr
+          : prestoSerializers[i]->streams_[column].get();
+    }
+    const auto child = BaseVector::loadedVectorShared(vector->childAt(column));
+    if (isScatterScalarType(child->typeKind())) {
+      decoded.decode(*child, allRows);
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          scatterScalar,
+          child->typeKind(),
+          decoded,
+          numRows,
+          destinations,
+          streams.data());
+      continue;
+    }
+    groupRows();
+    for (auto i = 0; i < numDestinations; ++i) {
+      if (offsets[i] == offsets[i + 1]) {
+        continue;
+      }
+      serializeColumn(
+          child,
+          folly::Range<const vector_size_t*>(
+              destinationRows.data() + offsets[i], offsets[i + 1] - offsets[i]),
+          streams[i],
+          scratch);
+    }
+  }
+}
 } // namespace
 
 void PrestoVectorSerde::estimateSerializedSize(
@@ -3631,6 +4003,15 @@ PrestoVectorSerde::createIterativeSerializer(
       type, numRows, streamArena, prestoOptions);
 }
 
+void PrestoVectorSerde::scatter(
+    const RowVectorPtr& vector,
+    const uint32_t* destinations,
+    folly::Range<IterativeVectorSerializer* const*> serializers,
+    Scratch& scratch) {
+  PrestoIterativeVectorSerializer::scatter(
+      vector, destinations, serializers, scratch);
+}
+
 std::unique_ptr<BatchVectorSerializer> PrestoVectorSerde::createBatchSerializer(
     memory::MemoryPool* pool,
     const Options* options) {
@@ -3745,14 +4126,15 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       header.checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  VELOX_CHECK_EQ(
-      needCompression(*codec),
-      isCompressedBitSet(header.pageCodecMarker),
+  // A serializer with a codec may send a page uncompressed if it does not
+  // compress well.
+  VELOX_CHECK(
+      needCompression(*codec) || !isCompressedBitSet(header.pageCodecMarker),
       "Compression kind {} should align with codec marker.",
       common::compressionKindToString(
           common::codecTypeToCompressionKind(codec->type())));
 
-  if (!needCompression(*codec)) {
+  if (!isCompressedBitSet(header.pageCodecMarker)) {
     readTopColumns(*source, type, pool, *result, resultOffset, prestoOptions);
   } else {
     auto compressBuf = folly::IOBuf::create(header.compressedSize);
@@ -3764,6 +4146,20 @@ void PrestoVectorSerde::deserialize(
         uncompress->writableData(), (int32_t)uncompress->length(), 0};
     ByteInputStream uncompressedSource({byteRange});
 
+    if (prestoOptions.zeroCopy) {
+      // The views of the uncompressed data own the uncompressed buffer.
+      auto uncompressedOptions = prestoOptions;
+      uncompressedOptions.sourceOwner =
+          std::shared_ptr<folly::IOBuf>(std::move(uncompress));
+      readTopColumns(
+          uncompressedSource,
+          type,
+          pool,
+          *result,
+          resultOffset,
+          uncompressedOptions);
+      return;
+    }
     readTopColumns(
         uncompressedSource, type, pool, *result, resultOffset, prestoOptions);
   }
@@ -68,6 +68,25 @@ class PrestoVectorSerde : public VectorSerde {
     /// TODO: Make Presto also serialize nulls before columns of
     /// structs.
     bool nullsFirst{false};
+
+    /// If true, fixed width values and string data that are contiguous in
+    /// the deserialized stream are referenced by Buffer views instead of
+    /// being copied into new buffers. The views keep 'sourceOwner' alive, so
+    /// it must own the memory of the ByteInputStream. Nothing is referenced
+    /// if 'sourceOwner' is not set, except for compressed pages, whose
+    /// views keep the uncompressed buffer alive. Values are copied when
+    /// they span ranges of the stream, have nulls or are appended at a
+    /// non-zero result offset. Used for deserializing exchange pages.
+    bool zeroCopy{false};
+
+    /// If set, a page whose compressed size is above this fraction of its
+    /// uncompressed size is sent uncompressed. An iterative serializer then
+    /// sends a number of the following pages uncompressed without trying to
+    /// compress them. The number doubles with each page that does not
+    /// compress well and resets after one that does.
+    std::optional<float> minCompressionRatio;
+
+    std::shared_ptr<const void> sourceOwner;
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
@@ -90,6 +109,18 @@ class PrestoVectorSerde : public VectorSerde {
       StreamArena* streamArena,
       const Options* options) override;
 
+  bool supportsScatter() const override {
+    return true;
+  }
+
+  /// Scalar columns are decoded once and each row is appended to the streams
+  /// of its destination. Other columns are appended per destination.
+  void scatter(
+      const RowVectorPtr& vector,
+      const uint32_t* destinations,
+      folly::Range<IterativeVectorSerializer* const*> serializers,
+      Scratch& scratch) override;
+
   /// Note that in addition to the differences highlighted in the VectorSerde
   /// interface, BatchVectorSerializer returned by this function can maintain
   /// the encodings of the input vectors recursively.
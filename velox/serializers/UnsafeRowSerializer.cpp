@@ -40,41 +40,51 @@ class UnsafeRowVectorSerializer : public IterativeVectorSerializer {
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges,
       Scratch& /*scratch*/) override {
-    size_t totalSize = 0;
+    size_t numRows = 0;
+    for (const auto& range : ranges) {
+      numRows += range.size;
+    }
+    if (numRows == 0) {
+      return;
+    }
+
     row::UnsafeRowFast unsafeRow(vector);
-    if (auto fixedRowSize =
-            row::UnsafeRowFast::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
+    const auto fixedRowSize =
+        row::UnsafeRowFast::fixedRowSize(asRowType(vector->type()));
 
-    } else {
-      for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += unsafeRow.rowSize(i) + sizeof(TRowSize);
-        }
+    // Offset of the size of each row in the buffer, followed by the total
+    // size.
+    rowOffsets_.resize(numRows + 1);
+    size_t totalSize = 0;
+    size_t index = 0;
+    for (const auto& range : ranges) {
+      for (auto i = range.begin; i < range.begin + range.size; ++i) {
+        rowOffsets_[index++] = totalSize;
+        totalSize += sizeof(TRowSize) +
+            (fixedRowSize ? *fixedRowSize : unsafeRow.rowSize(i));
       }
     }
-
-    if (totalSize == 0) {
-      return;
-    }
+    rowOffsets_[numRows] = totalSize;
 
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool_, 0);
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
-    size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size =
-            unsafeRow.serialize(i, rawBuffer + offset + sizeof(TRowSize));
+    // Write raw sizes in big endian order and make 'rowOffsets_' point to the
+    // row data.
+    for (auto i = 0; i < numRows; ++i) {
+      const TRowSize size =
+          rowOffsets_[i + 1] - rowOffsets_[i] - sizeof(TRowSize);
+      *(TRowSize*)(rawBuffer + rowOffsets_[i]) = folly::Endian::big(size);
+      rowOffsets_[i] += sizeof(TRowSize);
+    }
 
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    // Write row data one column at a time.
+    index = 0;
+    for (const auto& range : ranges) {
+      unsafeRow.serialize(
+          range.begin, range.size, rowOffsets_.data() + index, rawBuffer);
+      index += range.size;
     }
   }
 
@@ -93,9 +103,15 @@ class UnsafeRowVectorSerializer : public IterativeVectorSerializer {
     buffers_.clear();
   }
 
+  void clear() override {
+    buffers_.clear();
+  }
+
  private:
   memory::MemoryPool* const FOLLY_NONNULL pool_;
   std::vector<BufferPtr> buffers_;
+  // Offsets of the rows of the current append in the last of 'buffers_'.
+  std::vector<size_t> rowOffsets_;
 };
 
 // Read from the stream until the full row is concatenated.
@@ -137,7 +153,7 @@ void UnsafeRowVectorSerde::deserialize(
     RowTypePtr type,
     RowVectorPtr* result,
     const Options* /* options */) {
-  std::vector<std::optional<std::string_view>> serializedRows;
+  std::vector<std::string_view> serializedRows;
   std::vector<std::string> concatenatedRows;
 
   while (!source->atEnd()) {
@@ -162,9 +178,18 @@ void UnsafeRowVectorSerde::deserialize(
     return;
   }
 
+  if (velox::row::UnsafeRowFast::supportsDeserialize(type)) {
+    *result =
+        velox::row::UnsafeRowFast::deserialize(serializedRows, type, pool);
+    return;
+  }
+
   *result = std::dynamic_pointer_cast<RowVector>(
       velox::row::UnsafeRowDeserializer::deserialize(
-          serializedRows, type, pool));
+          std::vector<std::optional<std::string_view>>(
+              serializedRows.begin(), serializedRows.end()),
+          type,
+          pool));
 }
 
 // static
@@ -602,9 +602,11 @@ class PrestoSerializerTest
     // This factor is used to ensure we have some repetition in the dictionary
     // in each of the cases to ensure the serializer doesn't flatten the data.
     auto factor = alphabetSize <= numRows ? 2 : alphabetSize / numRows * 2;
-    // String is variable length, so this ensures the data isn't flattened.
+    // The strings are much longer than the indices, so this ensures the data
+    // isn't flattened.
     auto base = makeFlatVector<std::string>(
-        alphabetSize, [](vector_size_t row) { return fmt::format("{}", row); });
+        alphabetSize,
+        [](vector_size_t row) { return fmt::format("{:0>20}", row); });
     auto evenIndices = makeIndices(numRows, [alphabetSize, factor](auto row) {
       return (row * factor) % alphabetSize;
     });
@@ -849,6 +851,92 @@ TEST_P(PrestoSerializerTest, multiPage) {
   }
 }
 
+TEST_P(PrestoSerializerTest, minCompressionRatio) {
+  auto data = makeTestVector(1'000);
+  auto rowType = asRowType(data->type());
+  auto options = getParamSerdeOptions(nullptr);
+  // No page compresses to 0 bytes. The first page is tried and sent
+  // uncompressed. The second page is sent uncompressed without trying the
+  // codec and the third page is tried again.
+  options.minCompressionRatio = 0;
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto serializer = serde_->createIterativeSerializer(
+      rowType, data->size(), arena.get(), &options);
+  std::ostringstream output;
+  facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+  OStreamOutputStream out(&output, &listener);
+  constexpr int32_t kNumPages = 3;
+  for (auto i = 0; i < kNumPages; ++i) {
+    serializer->append(data);
+    serializer->flush(&out);
+    serializer->clear();
+  }
+
+  auto stats = serializer->runtimeStats();
+  if (options.compressionKind == common::CompressionKind_NONE) {
+    EXPECT_TRUE(stats.empty());
+  } else {
+    EXPECT_GT(stats.at("compressionInputBytes").value, 0);
+    EXPECT_GT(stats.at("compressedBytes").value, 0);
+    EXPECT_EQ(
+        stats.at("compressionSkippedBytes").value * 2,
+        stats.at("compressionInputBytes").value);
+  }
+
+  auto bytes = output.str();
+  auto byteStream = toByteStream(bytes);
+  for (auto i = 0; i < kNumPages; ++i) {
+    RowVectorPtr result;
+    serde_->deserialize(
+        &byteStream, pool_.get(), rowType, &result, 0, &options);
+    assertEqualVectors(data, result);
+  }
+  ASSERT_TRUE(byteStream.atEnd());
+}
+
+TEST_P(PrestoSerializerTest, zeroCopy) {
+  auto data = makeTestVector(1'000);
+  std::ostringstream out;
+  serialize(data, &out, nullptr);
+  auto page = std::make_shared<std::string>(out.str());
+  const bool compressed =
+      GetParam() != common::CompressionKind::CompressionKind_NONE;
+
+  auto options = getParamSerdeOptions(nullptr);
+  options.zeroCopy = true;
+  options.sourceOwner = page;
+  auto rowType = asRowType(data->type());
+
+  RowVectorPtr result;
+  auto byteStream = toByteStream(*page);
+  serde_->deserialize(
+      &byteStream, pool_.get(), rowType, &result, 0, &options);
+  assertEqualVectors(data, result);
+  auto* strings = result->childAt(2)->asFlatVector<StringView>();
+  ASSERT_EQ(strings->stringBuffers().size(), 1);
+  EXPECT_TRUE(strings->stringBuffers()[0]->isView());
+  // Uncompressed data is referenced in the page.
+  EXPECT_EQ(page.use_count() > 2, !compressed);
+  result.reset();
+  EXPECT_EQ(page.use_count(), 2);
+
+  // Data that spans ranges of the stream is copied.
+  std::vector<ByteRange> ranges;
+  constexpr int32_t kRangeSize = 100;
+  for (int32_t offset = 0; offset < page->size(); offset += kRangeSize) {
+    ranges.push_back(ByteRange{
+        reinterpret_cast<uint8_t*>(page->data()) + offset,
+        std::min<int32_t>(kRangeSize, page->size() - offset),
+        0});
+  }
+  ByteInputStream fragmentedStream(std::move(ranges));
+  serde_->deserialize(
+      &fragmentedStream, pool_.get(), rowType, &result, 0, &options);
+  assertEqualVectors(data, result);
+  strings = result->childAt(2)->asFlatVector<StringView>();
+  EXPECT_EQ(strings->stringBuffers()[0]->isView(), compressed);
+}
+
 TEST_P(PrestoSerializerTest, timestampWithNanosecondPrecision) {
   // Verify that nanosecond precision is preserved when the right options are
   // passed to the serde.
@@ -936,7 +1024,7 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
   auto bigintBase =
       makeFlatVector<int64_t>(32, [](vector_size_t row) { return row; });
   auto stringBase = makeFlatVector<std::string>(
-      32, [](vector_size_t row) { return fmt::format("{}", row); });
+      32, [](vector_size_t row) { return fmt::format("{:0>20}", row); });
   auto oneIndex = makeIndices(32, [](auto) { return 0; });
   auto quarterIndices = makeIndices(32, [](auto row) { return row % 8; });
   auto allButOneIndices = makeIndices(32, [](auto row) { return row % 31; });
@@ -954,13 +1042,13 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
       // enough benefit to outweigh the cost.
       BaseVector::wrapInDictionary(nullptr, allButOneIndices, 32, bigintBase),
       BaseVector::wrapInDictionary(nullptr, allIndices, 32, bigintBase),
-      // These should keep dictionary encoding because strings are variable
-      // length.
+      // These should keep dictionary encoding because the used strings and
+      // the indices are smaller than the strings of all rows.
       BaseVector::wrapInDictionary(nullptr, oneIndex, 32, stringBase),
       BaseVector::wrapInDictionary(nullptr, quarterIndices, 32, stringBase),
+      // These should be flattened because the used strings and the indices
+      // are larger than the flattened vector.
       BaseVector::wrapInDictionary(nullptr, allButOneIndices, 32, stringBase),
-      // This should be flattened because the alphabet is the same as the
-      // flattened vector.
       BaseVector::wrapInDictionary(nullptr, allIndices, 32, stringBase),
   });
 
@@ -995,12 +1083,40 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
   ASSERT_EQ(
       deserialized->childAt(7)->encoding(), VectorEncoding::Simple::DICTIONARY);
   // string + all but one indices
-  ASSERT_EQ(
-      deserialized->childAt(8)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(deserialized->childAt(8)->encoding(), VectorEncoding::Simple::FLAT);
   // string + all indices
   ASSERT_EQ(deserialized->childAt(9)->encoding(), VectorEncoding::Simple::FLAT);
 }
 
+// Test that a dictionary that adds nulls keeps its encoding, with the nulls
+// referring to a null appended to the serialized dictionary.
+TEST_P(PrestoSerializerTest, dictionaryEncodingWithNulls) {
+  auto longStrings = makeFlatVector<std::string>(
+      8, [](vector_size_t row) { return fmt::format("{:0>20}", row); });
+  auto bigints =
+      makeFlatVector<int64_t>(8, [](vector_size_t row) { return row; });
+  auto indices = makeIndices(100, [](auto row) { return row % 8; });
+  auto nulls = makeNulls(100, [](auto row) { return row % 3 == 0; });
+
+  auto rows = makeRowVector({
+      BaseVector::wrapInDictionary(nulls, indices, 100, longStrings),
+      BaseVector::wrapInDictionary(nulls, indices, 100, bigints),
+  });
+
+  std::ostringstream out;
+  serializeBatch(rows, &out, /*serdeOptions=*/nullptr);
+  auto deserialized = deserialize(
+      asRowType(rows->type()), out.str(), /*serdeOptions=*/nullptr);
+  assertEqualVectors(rows, deserialized);
+
+  for (auto i = 0; i < rows->childrenSize(); ++i) {
+    auto* dictionary = deserialized->childAt(i).get();
+    ASSERT_EQ(dictionary->encoding(), VectorEncoding::Simple::DICTIONARY);
+    // The 8 used values and a null.
+    ASSERT_EQ(dictionary->valueVector()->size(), 9);
+  }
+}
+
 TEST_P(PrestoSerializerTest, lazy) {
   constexpr int kSize = 1000;
   auto rowVector = makeTestVector(kSize);
@@ -1125,6 +1241,80 @@ TEST_P(PrestoSerializerTest, encodedConcatenation) {
   }
 }
 
+TEST_P(PrestoSerializerTest, scatter) {
+  VectorFuzzer::Options opts;
+  opts.timestampPrecision =
+      VectorFuzzer::Options::TimestampPrecision::kMilliSeconds;
+  opts.nullRatio = 0.1;
+  VectorFuzzer fuzzer(opts, pool_.get());
+  const auto paramOptions = getParamSerdeOptions(nullptr);
+  constexpr int32_t kNumDestinations = 7;
+
+  auto flush = [&](IterativeVectorSerializer& serializer) {
+    std::ostringstream output;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer.flush(&out);
+    return output.str();
+  };
+
+  for (auto i = 0; i < 20; ++i) {
+    auto rowType = ROW(
+        {"c0", "c1", "c2", "c3"},
+        {BIGINT(), VARCHAR(), BOOLEAN(), fuzzer.randType()});
+    auto data = fuzzer.fuzzRow(rowType);
+    std::mt19937 rng(i);
+    std::vector<uint32_t> destinations(data->size());
+    std::vector<std::vector<vector_size_t>> destinationRows(kNumDestinations);
+    for (auto row = 0; row < data->size(); ++row) {
+      destinations[row] = folly::Random::rand32(kNumDestinations, rng);
+      destinationRows[destinations[row]].push_back(row);
+    }
+
+    // Serializers for rows appended per destination and for scattered rows.
+    // The scattered ones are cleared and reused.
+    std::vector<std::unique_ptr<StreamArena>> arenas;
+    std::vector<std::unique_ptr<IterativeVectorSerializer>> expected;
+    std::vector<std::unique_ptr<IterativeVectorSerializer>> actual;
+    for (auto destination = 0; destination < kNumDestinations; ++destination) {
+      arenas.push_back(std::make_unique<StreamArena>(pool_.get()));
+      expected.push_back(serde_->createIterativeSerializer(
+          rowType, 10, arenas.back().get(), &paramOptions));
+      arenas.push_back(std::make_unique<StreamArena>(pool_.get()));
+      actual.push_back(serde_->createIterativeSerializer(
+          rowType, 10, arenas.back().get(), &paramOptions));
+    }
+    std::vector<IterativeVectorSerializer*> rawActual;
+    for (auto& serializer : actual) {
+      rawActual.push_back(serializer.get());
+    }
+
+    Scratch scratch;
+    serde_->scatter(
+        data,
+        destinations.data(),
+        folly::Range(rawActual.data(), rawActual.size()),
+        scratch);
+    for (auto destination = 0; destination < kNumDestinations; ++destination) {
+      flush(*actual[destination]);
+      arenas[destination * 2 + 1]->clear();
+      actual[destination]->clear();
+    }
+    serde_->scatter(
+        data,
+        destinations.data(),
+        folly::Range(rawActual.data(), rawActual.size()),
+        scratch);
+
+    for (auto destination = 0; destination < kNumDestinations; ++destination) {
+      const auto& rows = destinationRows[destination];
+      expected[destination]->append(
+          data, folly::Range(rows.data(), rows.size()), scratch);
+      ASSERT_EQ(flush(*expected[destination]), flush(*actual[destination]));
+    }
+  }
+}
+
 TEST_P(PrestoSerializerTest, emptyArrayOfRowVector) {
   // The value of nullCount_ + nonNullCount_ of the inner RowVector is 0.
   auto arrayOfRow = makeArrayOfRowVector(ROW({UNKNOWN()}), {{}});
@@ -21,6 +21,44 @@
 #include "velox/substrait/VeloxSubstraitSignature.h"
 
 namespace facebook::velox::substrait {
+namespace {
+// Returns the number of names the fields of the structs nested in 'type' take
+// in the names of a NamedStruct.
+int32_t countNestedNames(const TypePtr& type) {
+  int32_t count = type->kind() == TypeKind::ROW ? type->size() : 0;
+  for (auto i = 0; i < type->size(); ++i) {
+    count += countNestedNames(type->childAt(i));
+  }
+  return count;
+}
+
+// Returns 'type' with the fields of nested structs named from 'names',
+// starting at 'index', in depth-first order.
+TypePtr applyNestedNames(
+    const TypePtr& type,
+    const google::protobuf::RepeatedPtrField<std::string>& names,
+    int32_t& index) {
+  switch (type->kind()) {
+    case TypeKind::ROW: {
+      std::vector<std::string> fieldNames;
+      std::vector<TypePtr> fieldTypes;
+      for (auto i = 0; i < type->size(); ++i) {
+        fieldNames.push_back(names[index++]);
+        fieldTypes.push_back(applyNestedNames(type->childAt(i), names, index));
+      }
+      return ROW(std::move(fieldNames), std::move(fieldTypes));
+    }
+    case TypeKind::ARRAY:
+      return ARRAY(applyNestedNames(type->childAt(0), names, index));
+    case TypeKind::MAP: {
+      auto keyType = applyNestedNames(type->childAt(0), names, index);
+      return MAP(keyType, applyNestedNames(type->childAt(1), names, index));
+    }
+    default:
+      return type;
+  }
+}
+} // namespace
 
 TypePtr SubstraitParser::parseType(const ::substrait::Type& substraitType) {
   switch (substraitType.kind_case()) {
@@ -78,19 +116,36 @@ TypePtr SubstraitParser::parseType(const ::substrait::Type& substraitType) {
   }
 }
 
-std::vector<TypePtr> SubstraitParser::parseNamedStruct(
+RowTypePtr SubstraitParser::parseNamedStruct(
     const ::substrait::NamedStruct& namedStruct) {
-  // Nte that "names" are not used.
-
   // Parse Struct.
   const auto& substraitStruct = namedStruct.struct_();
   const auto& substraitTypes = substraitStruct.types();
   std::vector<TypePtr> typeList;
   typeList.reserve(substraitTypes.size());
+  int32_t numNames = 0;
   for (const auto& type : substraitTypes) {
     typeList.emplace_back(parseType(type));
+    numNames += 1 + countNestedNames(typeList.back());
+  }
+
+  const auto& names = namedStruct.names();
+  const bool hasNestedNames = names.size() == numNames;
+  VELOX_CHECK(
+      hasNestedNames || names.size() == typeList.size(),
+      "NamedStruct has {} names for {} columns",
+      names.size(),
+      typeList.size());
+  std::vector<std::string> nameList;
+  nameList.reserve(typeList.size());
+  int32_t index = 0;
+  for (auto& type : typeList) {
+    nameList.emplace_back(names[index++]);
+    if (hasNestedNames) {
+      type = applyNestedNames(type, names, index);
+    }
   }
-  return typeList;
+  return ROW(std::move(nameList), std::move(typeList));
 }
 
 int32_t SubstraitParser::parseReferenceSegment(
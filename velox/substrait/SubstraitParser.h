@@ -33,9 +33,10 @@ namespace facebook::velox::substrait {
 /// components, and convert them into recognizable representations.
 class SubstraitParser {
  public:
-  /// Parse Substrait NamedStruct.
-  std::vector<TypePtr> parseNamedStruct(
-      const ::substrait::NamedStruct& namedStruct);
+  /// Parse Substrait NamedStruct. The names list the top-level columns and,
+  /// optionally, the fields of nested structs in depth-first order. Without
+  /// the latter, nested fields are named col_<n> as in parseType().
+  RowTypePtr parseNamedStruct(const ::substrait::NamedStruct& namedStruct);
 
   /// Parse Substrait Type.
   TypePtr parseType(const ::substrait::Type& substraitType);
@@ -164,20 +164,36 @@ SubstraitVeloxExprConverter::toVeloxExpr(
   switch (typeCase) {
     case ::substrait::Expression::FieldReference::ReferenceTypeCase::
         kDirectReference: {
-      const auto& directRef = substraitField.direct_reference();
-      int32_t colIdx = substraitParser_.parseReferenceSegment(directRef);
+      const auto* segment = &substraitField.direct_reference();
+      int32_t colIdx = substraitParser_.parseReferenceSegment(*segment);
       const auto& inputNames = inputType->names();
       const int64_t inputSize = inputNames.size();
-      if (colIdx <= inputSize) {
-        const auto& inputTypes = inputType->children();
-        // Convert type to row.
-        return std::make_shared<core::FieldAccessTypedExpr>(
-            inputTypes[colIdx],
-            std::make_shared<core::InputTypedExpr>(inputTypes[colIdx]),
-            inputNames[colIdx]);
-      } else {
+      if (colIdx >= inputSize) {
         VELOX_FAIL("Missing the column with id '{}' .", colIdx);
       }
+      const auto& inputTypes = inputType->children();
+      // Convert type to row.
+      auto field = std::make_shared<const core::FieldAccessTypedExpr>(
+          inputTypes[colIdx],
+          std::make_shared<core::InputTypedExpr>(inputTypes[colIdx]),
+          inputNames[colIdx]);
+      // A child segment selects a field of the struct selected so far, e.g.
+      // c0.a.b. Each level becomes a field access over the previous one.
+      while (segment->has_struct_field() &&
+             segment->struct_field().has_child()) {
+        segment = &segment->struct_field().child();
+        const auto* rowType = dynamic_cast<const RowType*>(field->type().get());
+        VELOX_CHECK_NOT_NULL(
+            rowType,
+            "Nested reference into non-struct type {}",
+            field->type()->toString());
+        colIdx = substraitParser_.parseReferenceSegment(*segment);
+        VELOX_CHECK_LT(
+            colIdx, rowType->size(), "Missing the field with id '{}'.", colIdx);
+        field = std::make_shared<const core::FieldAccessTypedExpr>(
+            rowType->childAt(colIdx), field, rowType->nameOf(colIdx));
+      }
+      return field;
     }
     default:
       VELOX_NYI(
@@ -195,10 +211,19 @@ core::TypedExprPtr SubstraitVeloxExprConverter::toVeloxExpr(
   }
   const auto& veloxFunction = substraitParser_.findVeloxFunction(
       functionMap_, substraitFunc.function_reference());
+  auto outputType = substraitParser_.parseType(substraitFunc.output_type());
+  if (veloxFunction == "is_not_null") {
+    // Velox has no is_not_null. not(is_null()) is also what filter pushdown
+    // recognizes.
+    return std::make_shared<const core::CallTypedExpr>(
+        outputType,
+        std::vector<core::TypedExprPtr>{
+            std::make_shared<const core::CallTypedExpr>(
+                outputType, std::move(params), "is_null")},
+        "not");
+  }
   return std::make_shared<const core::CallTypedExpr>(
-      substraitParser_.parseType(substraitFunc.output_type()),
-      std::move(params),
-      veloxFunction);
+      outputType, std::move(params), veloxFunction);
 }
 
 std::shared_ptr<const core::ConstantTypedExpr>
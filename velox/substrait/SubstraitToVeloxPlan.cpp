@@ -15,12 +15,75 @@
  */
 
 #include "velox/substrait/SubstraitToVeloxPlan.h"
+
+#include <mutex>
+
+#include <folly/ScopeGuard.h>
+#include <folly/hash/SpookyHashV2.h>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/connectors/hive/HiveDataSource.h"
+#include "velox/expression/Expr.h"
 #include "velox/substrait/TypeUtils.h"
 #include "velox/substrait/VariantToVectorConverter.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::substrait {
 namespace {
+// Number of plans kept by toVeloxPlanCached().
+constexpr int32_t kMaxCachedPlans = 1'000;
+
+struct CachedPlan {
+  core::PlanNodePtr plan;
+  std::unordered_map<
+      core::PlanNodeId,
+      std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>
+      splitInfos;
+  std::unordered_map<uint64_t, std::string> functionMap;
+  int planNodeId;
+};
+
+class PlanCache {
+ public:
+  static PlanCache& instance() {
+    static PlanCache cache;
+    return cache;
+  }
+
+  std::optional<CachedPlan> get(const std::string& key) {
+    std::lock_guard<std::mutex> l(mutex_);
+    return plans_.get(key);
+  }
+
+  void add(const std::string& key, const CachedPlan& plan) {
+    std::lock_guard<std::mutex> l(mutex_);
+    plans_.add(key, plan);
+  }
+
+  // Pool for the constants of cached plans, which outlive the converters that
+  // made them.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+ private:
+  PlanCache()
+      : pool_(memory::memoryManager()->addLeafPool("substraitPlanCache")),
+        plans_(kMaxCachedPlans) {}
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  std::mutex mutex_;
+  SimpleLRUCache<std::string, CachedPlan> plans_;
+};
+
+std::string planKey(const ::substrait::Plan& substraitPlan) {
+  const auto text = substraitPlan.SerializeAsString();
+  uint64_t hash1 = 0;
+  uint64_t hash2 = 0;
+  folly::hash::SpookyHashV2::Hash128(text.data(), text.size(), &hash1, &hash2);
+  return fmt::format("{:016x}{:016x}", hash1, hash2);
+}
+
 core::AggregationNode::Step toAggregationStep(
     const ::substrait::AggregateRel& sAgg) {
   if (sAgg.measures().size() == 0) {
@@ -366,12 +429,10 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   std::vector<std::string> colNameList;
   std::vector<TypePtr> veloxTypeList;
   if (readRel.has_base_schema()) {
-    const auto& baseSchema = readRel.base_schema();
-    colNameList.reserve(baseSchema.names().size());
-    for (const auto& name : baseSchema.names()) {
-      colNameList.emplace_back(name);
-    }
-    veloxTypeList = substraitParser_->parseNamedStruct(baseSchema);
+    auto baseSchema =
+        substraitParser_->parseNamedStruct(readRel.base_schema());
+    colNameList = baseSchema->names();
+    veloxTypeList = baseSchema->children();
   }
 
   // Parse local files
@@ -406,26 +467,19 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   // Velox requires Filter Pushdown must being enabled.
   bool filterPushdownEnabled = true;
-  std::shared_ptr<connector::hive::HiveTableHandle> tableHandle;
-  if (!readRel.has_filter()) {
-    tableHandle = std::make_shared<connector::hive::HiveTableHandle>(
-        kHiveConnectorId,
-        "hive_table",
-        filterPushdownEnabled,
-        connector::hive::SubfieldFilters{},
-        nullptr,
-        nullptr);
-  } else {
-    connector::hive::SubfieldFilters filters =
-        toVeloxFilter(colNameList, veloxTypeList, readRel.filter());
-    tableHandle = std::make_shared<connector::hive::HiveTableHandle>(
-        kHiveConnectorId,
-        "hive_table",
-        filterPushdownEnabled,
-        std::move(filters),
-        nullptr,
-        nullptr);
-  }
+  connector::hive::SubfieldFilters filters;
+  core::TypedExprPtr remainingFilter;
+  if (readRel.has_filter()) {
+    remainingFilter = toVeloxFilter(
+        colNameList, veloxTypeList, readRel.filter(), filters);
+  }
+  auto tableHandle = std::make_shared<connector::hive::HiveTableHandle>(
+      kHiveConnectorId,
+      "hive_table",
+      filterPushdownEnabled,
+      std::move(filters),
+      std::move(remainingFilter),
+      nullptr);
 
   // Get assignments and out names.
   std::vector<std::string> outNames;
@@ -578,178 +632,85 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   VELOX_FAIL("RelRoot or Rel is expected in Plan.");
 }
 
+core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlanCached(
+    const ::substrait::Plan& substraitPlan) {
+  VELOX_CHECK_EQ(
+      planNodeId_, 0, "Plans are cached only by the first conversion");
+  auto& cache = PlanCache::instance();
+  const auto key = planKey(substraitPlan);
+  if (auto cached = cache.get(key)) {
+    // The caller may modify the split infos.
+    for (const auto& [id, splitInfo] : cached->splitInfos) {
+      splitInfoMap_[id] = std::make_shared<SplitInfo>(*splitInfo);
+    }
+    functionMap_ = std::move(cached->functionMap);
+    planNodeId_ = cached->planNodeId;
+    return cached->plan;
+  }
+
+  // The constants of the plan are allocated from the pool of the cache.
+  auto* pool = pool_;
+  pool_ = cache.pool();
+  SCOPE_EXIT {
+    pool_ = pool;
+  };
+  auto plan = toVeloxPlan(substraitPlan);
+  CachedPlan cached{plan, {}, functionMap_, planNodeId_};
+  for (const auto& [id, splitInfo] : splitInfoMap_) {
+    cached.splitInfos[id] = std::make_shared<SplitInfo>(*splitInfo);
+  }
+  cache.add(key, cached);
+  return plan;
+}
+
 std::string SubstraitVeloxPlanConverter::nextPlanNodeId() {
   auto id = fmt::format("{}", planNodeId_);
   planNodeId_++;
   return id;
 }
 
-// This class contains the needed infos for Filter Pushdown.
-// TODO: Support different types here.
-class FilterInfo {
- public:
-  // Used to set the left bound.
-  void setLeft(double left, bool isExclusive) {
-    left_ = left;
-    leftExclusive_ = isExclusive;
-    if (!isInitialized_) {
-      isInitialized_ = true;
-    }
-  }
-
-  // Used to set the right bound.
-  void setRight(double right, bool isExclusive) {
-    right_ = right;
-    rightExclusive_ = isExclusive;
-    if (!isInitialized_) {
-      isInitialized_ = true;
-    }
-  }
-
-  // Will fordis Null value if called once.
-  void forbidsNull() {
-    nullAllowed_ = false;
-    if (!isInitialized_) {
-      isInitialized_ = true;
-    }
-  }
-
-  // Return the initialization status.
-  bool isInitialized() {
-    return isInitialized_ ? true : false;
-  }
-
-  // The left bound.
-  std::optional<double> left_ = std::nullopt;
-  // The right bound.
-  std::optional<double> right_ = std::nullopt;
-  // The Null allowing.
-  bool nullAllowed_ = true;
-  // If true, left bound will be exclusive.
-  bool leftExclusive_ = false;
-  // If true, right bound will be exclusive.
-  bool rightExclusive_ = false;
-
- private:
-  bool isInitialized_ = false;
-};
-
-connector::hive::SubfieldFilters SubstraitVeloxPlanConverter::toVeloxFilter(
+core::TypedExprPtr SubstraitVeloxPlanConverter::toVeloxFilter(
     const std::vector<std::string>& inputNameList,
     const std::vector<TypePtr>& inputTypeList,
-    const ::substrait::Expression& substraitFilter) {
-  connector::hive::SubfieldFilters filters;
-  // A map between the column index and the FilterInfo for that column.
-  std::unordered_map<int, std::shared_ptr<FilterInfo>> colInfoMap;
-  for (int idx = 0; idx < inputNameList.size(); idx++) {
-    colInfoMap[idx] = std::make_shared<FilterInfo>();
-  }
-
-  std::vector<::substrait::Expression_ScalarFunction> scalarFunctions;
-  flattenConditions(substraitFilter, scalarFunctions);
-  // Construct the FilterInfo for the related column.
-  for (const auto& scalarFunction : scalarFunctions) {
-    auto filterNameSpec = substraitParser_->findFunctionSpec(
-        functionMap_, scalarFunction.function_reference());
-    auto filterName = getNameBeforeDelimiter(filterNameSpec, ":");
-    int32_t colIdx;
-    // TODO: Add different types' support here.
-    double val;
-    for (auto& arg : scalarFunction.arguments()) {
-      auto argExpr = arg.value();
-      auto typeCase = argExpr.rex_type_case();
-      switch (typeCase) {
-        case ::substrait::Expression::RexTypeCase::kSelection: {
-          auto sel = argExpr.selection();
-          // TODO: Only direct reference is considered here.
-          auto dRef = sel.direct_reference();
-          colIdx = substraitParser_->parseReferenceSegment(dRef);
-          break;
-        }
-        case ::substrait::Expression::RexTypeCase::kLiteral: {
-          auto sLit = argExpr.literal();
-          // TODO: Only double is considered here.
-          val = sLit.fp64();
-          break;
-        }
-        default:
-          VELOX_NYI(
-              "Substrait conversion not supported for arg type '{}'", typeCase);
-      }
-    }
-    if (filterName == "is_not_null") {
-      colInfoMap[colIdx]->forbidsNull();
-    } else if (filterName == "gte") {
-      colInfoMap[colIdx]->setLeft(val, false);
-    } else if (filterName == "gt") {
-      colInfoMap[colIdx]->setLeft(val, true);
-    } else if (filterName == "lte") {
-      colInfoMap[colIdx]->setRight(val, false);
-    } else if (filterName == "lt") {
-      colInfoMap[colIdx]->setRight(val, true);
-    } else {
-      VELOX_NYI(
-          "Substrait conversion not supported for filter name '{}'",
-          filterName);
+    const ::substrait::Expression& substraitFilter,
+    connector::hive::SubfieldFilters& filters) {
+  auto filter = exprConverter_->toVeloxExpr(
+      substraitFilter, ROW(inputNameList, inputTypeList));
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConditions(filter, conjuncts);
+
+  // Folds the constant expressions in the filter, e.g. casts of literals.
+  core::QueryCtx queryCtx;
+  exec::SimpleExpressionEvaluator evaluator(&queryCtx, pool_);
+  std::vector<core::TypedExprPtr> remaining;
+  for (const auto& conjunct : conjuncts) {
+    if (auto rest =
+            connector::hive::HiveDataSource::extractFiltersFromRemainingFilter(
+                conjunct, &evaluator, false, filters)) {
+      remaining.push_back(std::move(rest));
     }
   }
-
-  // Construct the Filters.
-  for (int idx = 0; idx < inputNameList.size(); idx++) {
-    auto filterInfo = colInfoMap[idx];
-    double leftBound;
-    double rightBound;
-    bool leftUnbounded = true;
-    bool rightUnbounded = true;
-    bool leftExclusive = false;
-    bool rightExclusive = false;
-    if (filterInfo->isInitialized()) {
-      if (filterInfo->left_) {
-        leftUnbounded = false;
-        leftBound = filterInfo->left_.value();
-        leftExclusive = filterInfo->leftExclusive_;
-      }
-      if (filterInfo->right_) {
-        rightUnbounded = false;
-        rightBound = filterInfo->right_.value();
-        rightExclusive = filterInfo->rightExclusive_;
-      }
-      bool nullAllowed = filterInfo->nullAllowed_;
-      filters[common::Subfield(inputNameList[idx])] =
-          std::make_unique<common::DoubleRange>(
-              leftBound,
-              leftUnbounded,
-              leftExclusive,
-              rightBound,
-              rightUnbounded,
-              rightExclusive,
-              nullAllowed);
-    }
+  if (remaining.empty()) {
+    return nullptr;
   }
-  return filters;
+  if (remaining.size() == 1) {
+    return remaining[0];
+  }
+  return std::make_shared<const core::CallTypedExpr>(
+      BOOLEAN(), std::move(remaining), "and");
 }
 
 void SubstraitVeloxPlanConverter::flattenConditions(
-    const ::substrait::Expression& substraitFilter,
-    std::vector<::substrait::Expression_ScalarFunction>& scalarFunctions) {
-  auto typeCase = substraitFilter.rex_type_case();
-  switch (typeCase) {
-    case ::substrait::Expression::RexTypeCase::kScalarFunction: {
-      auto sFunc = substraitFilter.scalar_function();
-      auto filterNameSpec = substraitParser_->findFunctionSpec(
-          functionMap_, sFunc.function_reference());
-      // TODO: Only and relation is supported here.
-      if (getNameBeforeDelimiter(filterNameSpec, ":") == "and") {
-        for (const auto& sCondition : sFunc.arguments()) {
-          flattenConditions(sCondition.value(), scalarFunctions);
-        }
-      } else {
-        scalarFunctions.emplace_back(sFunc);
-      }
-      break;
+    const core::TypedExprPtr& filter,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  // Substrait 'and' may have any number of arguments.
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(filter.get());
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConditions(input, conjuncts);
     }
-    default:
-      VELOX_NYI("GetFlatConditions not supported for type '{}'", typeCase);
+  } else {
+    conjuncts.push_back(filter);
   }
 }
 
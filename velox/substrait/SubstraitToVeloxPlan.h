@@ -84,6 +84,13 @@ class SubstraitVeloxPlanConverter {
   /// Convert Substrait Plan into Velox PlanNode.
   core::PlanNodePtr toVeloxPlan(const ::substrait::Plan& substraitPlan);
 
+  /// Same as toVeloxPlan(substraitPlan) but returns the plan converted before
+  /// from an identical 'substraitPlan' if there is one, so that tasks running
+  /// the same plan convert it once. Plans are cached process-wide, keyed on a
+  /// hash of the serialized proto, and splitInfos() is set as if the plan was
+  /// converted. Must be the first conversion done by this converter.
+  core::PlanNodePtr toVeloxPlanCached(const ::substrait::Plan& substraitPlan);
+
   /// Check the Substrait type extension only has one unknown extension.
   bool checkTypeExtension(const ::substrait::Plan& substraitPlan);
 
@@ -124,19 +131,22 @@ class SubstraitVeloxPlanConverter {
   std::string nextPlanNodeId();
 
   /// Used to convert Substrait Filter into Velox SubfieldFilters which will
-  /// be used in TableScan.
-  connector::hive::SubfieldFilters toVeloxFilter(
+  /// be used in TableScan. Each conjunct that HiveDataSource can push down,
+  /// including ORs over one column and conditions on nested fields, is added
+  /// to 'filters'. Returns the conjunction of the other conjuncts, nullptr if
+  /// there are none.
+  core::TypedExprPtr toVeloxFilter(
       const std::vector<std::string>& inputNameList,
       const std::vector<TypePtr>& inputTypeList,
-      const ::substrait::Expression& substraitFilter);
+      const ::substrait::Expression& substraitFilter,
+      connector::hive::SubfieldFilters& filters);
 
-  /// Multiple conditions are connected to a binary tree structure with
-  /// the relation key words, including AND, OR, and etc. Currently, only
-  /// AND is supported. This function is used to extract all the Substrait
-  /// conditions in the binary tree structure into a vector.
+  /// Multiple conditions are connected with AND, which may have any number
+  /// of arguments. This function is used to extract the conjuncts of
+  /// 'filter' into 'conjuncts'.
   void flattenConditions(
-      const ::substrait::Expression& substraitFilter,
-      std::vector<::substrait::Expression_ScalarFunction>& scalarFunctions);
+      const core::TypedExprPtr& filter,
+      std::vector<core::TypedExprPtr>& conjuncts);
 
   /// The Substrait parser used to convert Substrait representations into
   /// recognizable representations.
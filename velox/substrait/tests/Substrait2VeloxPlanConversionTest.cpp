@@ -291,3 +291,151 @@ TEST_F(Substrait2VeloxPlanConversionTest, DISABLED_q6) {
       .splits(makeSplits(planConverter, planNode))
       .assertResults(expectedResult);
 }
+
+namespace {
+::substrait::Expression makeField(const std::vector<int32_t>& path) {
+  ::substrait::Expression expr;
+  auto* segment = expr.mutable_selection()->mutable_direct_reference();
+  for (auto i = 0; i < path.size(); ++i) {
+    if (i > 0) {
+      segment = segment->mutable_struct_field()->mutable_child();
+    }
+    segment->mutable_struct_field()->set_field(path[i]);
+  }
+  return expr;
+}
+
+::substrait::Expression makeCall(
+    uint32_t functionAnchor,
+    std::vector<::substrait::Expression> args,
+    bool isBoolean = true) {
+  ::substrait::Expression expr;
+  auto* function = expr.mutable_scalar_function();
+  function->set_function_reference(functionAnchor);
+  for (auto& arg : args) {
+    *function->add_arguments()->mutable_value() = std::move(arg);
+  }
+  if (isBoolean) {
+    function->mutable_output_type()->mutable_bool_();
+  } else {
+    function->mutable_output_type()->mutable_i64();
+  }
+  return expr;
+}
+
+template <typename T>
+::substrait::Expression makeLiteral(T value) {
+  ::substrait::Expression expr;
+  if constexpr (std::is_same_v<T, double>) {
+    expr.mutable_literal()->set_fp64(value);
+  } else {
+    expr.mutable_literal()->set_i64(value);
+  }
+  return expr;
+}
+
+// Returns a plan that reads c0 DOUBLE, c1 BIGINT and s ROW(a BIGINT) from
+// one file with:
+//
+//  WHERE (c0 < 1 OR c0 > 5) AND s.a > 10 AND c1 * c1 > 10
+::substrait::Plan makeFilteredScan() {
+  ::substrait::Plan plan;
+  const std::vector<std::string> functions = {
+      "and:bool_bool",
+      "or:bool_bool",
+      "lt:fp64_fp64",
+      "gt:fp64_fp64",
+      "gt:i64_i64",
+      "multiply:i64_i64"};
+  for (auto i = 0; i < functions.size(); ++i) {
+    auto* function = plan.add_extensions()->mutable_extension_function();
+    function->set_function_anchor(i);
+    function->set_name(functions[i]);
+  }
+
+  auto* read = plan.add_relations()->mutable_root()->mutable_input();
+  auto* readRel = read->mutable_read();
+  auto* schema = readRel->mutable_base_schema();
+  for (const auto* name : {"c0", "c1", "s", "a"}) {
+    schema->add_names(name);
+  }
+  auto* types = schema->mutable_struct_();
+  types->add_types()->mutable_fp64();
+  types->add_types()->mutable_i64();
+  types->add_types()->mutable_struct_()->add_types()->mutable_i64();
+
+  auto* file = readRel->mutable_local_files()->add_items();
+  file->set_uri_file("/data.orc");
+  file->mutable_orc();
+
+  *readRel->mutable_filter() = makeCall(
+      0,
+      {makeCall(
+           1,
+           {makeCall(2, {makeField({0}), makeLiteral(1.0)}),
+            makeCall(3, {makeField({0}), makeLiteral(5.0)})}),
+       makeCall(4, {makeField({2, 0}), makeLiteral<int64_t>(10)}),
+       makeCall(
+           4,
+           {makeCall(5, {makeField({1}), makeField({1})}, false),
+            makeLiteral<int64_t>(10)})});
+  return plan;
+}
+} // namespace
+
+TEST_F(Substrait2VeloxPlanConversionTest, filterPushdown) {
+  facebook::velox::substrait::SubstraitVeloxPlanConverter planConverter(
+      pool_.get());
+  auto planNode = planConverter.toVeloxPlan(makeFilteredScan());
+  auto scan = std::dynamic_pointer_cast<const core::TableScanNode>(planNode);
+  ASSERT_TRUE(scan != nullptr);
+  auto tableHandle =
+      std::dynamic_pointer_cast<const HiveTableHandle>(scan->tableHandle());
+  ASSERT_TRUE(tableHandle != nullptr);
+
+  const auto& filters = tableHandle->subfieldFilters();
+  ASSERT_EQ(2, filters.size());
+  const auto& c0Filter = filters.at(common::Subfield("c0"));
+  EXPECT_TRUE(c0Filter->testDouble(0.5));
+  EXPECT_FALSE(c0Filter->testDouble(3));
+  EXPECT_TRUE(c0Filter->testDouble(6));
+  const auto& nestedFilter = filters.at(common::Subfield("s.a"));
+  EXPECT_TRUE(nestedFilter->testInt64(11));
+  EXPECT_FALSE(nestedFilter->testInt64(10));
+
+  ASSERT_TRUE(tableHandle->remainingFilter() != nullptr);
+  EXPECT_EQ(
+      "gt(multiply(ROW[\"c1\"],ROW[\"c1\"]),10)",
+      tableHandle->remainingFilter()->toString());
+}
+
+TEST_F(Substrait2VeloxPlanConversionTest, planCache) {
+  const auto plan = makeFilteredScan();
+  facebook::velox::substrait::SubstraitVeloxPlanConverter converter(
+      pool_.get());
+  auto planNode = converter.toVeloxPlanCached(plan);
+  ASSERT_EQ(1, converter.splitInfos().size());
+
+  // A converter of the same plan gets the same plan nodes and its own split
+  // infos.
+  facebook::velox::substrait::SubstraitVeloxPlanConverter otherConverter(
+      pool_.get());
+  EXPECT_EQ(planNode, otherConverter.toVeloxPlanCached(plan));
+  const auto& splitInfo = otherConverter.splitInfos().at(planNode->id());
+  EXPECT_NE(splitInfo, converter.splitInfos().at(planNode->id()));
+  EXPECT_EQ(std::vector<std::string>{"/data.orc"}, splitInfo->paths);
+
+  auto otherPlan = plan;
+  otherPlan.mutable_relations(0)
+      ->mutable_root()
+      ->mutable_input()
+      ->mutable_read()
+      ->clear_filter();
+  facebook::velox::substrait::SubstraitVeloxPlanConverter thirdConverter(
+      pool_.get());
+  EXPECT_NE(planNode, thirdConverter.toVeloxPlanCached(otherPlan));
+
+  VELOX_ASSERT_THROW(
+      converter.toVeloxPlanCached(plan),
+      "Plans are cached only by the first conversion");
+}
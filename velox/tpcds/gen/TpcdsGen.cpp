@@ -0,0 +1,755 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+#include "velox/vector/FlatVector.h"
+
+#include <array>
+#include <cmath>
+
+namespace facebook::velox::tpcds {
+
+namespace {
+
+// d_date_sk of the first row of date_dim, 1900-01-02. Date surrogate keys are
+// Julian day numbers.
+constexpr int64_t kFirstDateSk = 2'415'022;
+// Days since epoch of 1900-01-02.
+constexpr int32_t kFirstDate = -25'566;
+constexpr size_t kNumDates = 73'049;
+
+// Range of ss_sold_date_sk, 1998-01-02 to 2003-01-02.
+constexpr int64_t kFirstSaleDateSk = 2'450'816;
+constexpr int64_t kLastSaleDateSk = 2'452'642;
+
+// Size of the cross product of the customer_demographics attributes.
+constexpr size_t kNumDemographics = 1'920'800;
+
+constexpr std::array<std::string_view, 10> kCategories = {
+    "Women",
+    "Men",
+    "Children",
+    "Shoes",
+    "Music",
+    "Jewelry",
+    "Home",
+    "Sports",
+    "Books",
+    "Electronics"};
+
+constexpr std::array<std::string_view, 16> kClasses = {
+    "accessories",
+    "athletic",
+    "classical",
+    "country",
+    "dresses",
+    "fiction",
+    "furniture",
+    "history",
+    "infants",
+    "kids",
+    "mens",
+    "pants",
+    "pop",
+    "rock",
+    "shirts",
+    "womens"};
+
+constexpr std::array<std::string_view, 8> kBrandStems = {
+    "amalgamalg",
+    "amalgexporti",
+    "edu packimporto",
+    "exportiunivamalg",
+    "importoamalg",
+    "maxinameless",
+    "scholaramalgamalg",
+    "univbrand"};
+
+constexpr std::array<std::string_view, 5> kStates = {
+    "TN",
+    "GA",
+    "AL",
+    "SD",
+    "OH"};
+
+constexpr std::array<std::string_view, 7> kDayNames = {
+    "Sunday",
+    "Monday",
+    "Tuesday",
+    "Wednesday",
+    "Thursday",
+    "Friday",
+    "Saturday"};
+
+constexpr std::array<std::string_view, 2> kGenders = {"M", "F"};
+constexpr std::array<std::string_view, 5> kMaritalStatuses =
+    {"M", "S", "D", "W", "U"};
+constexpr std::array<std::string_view, 7> kEducationStatuses = {
+    "Primary",
+    "Secondary",
+    "College",
+    "2 yr Degree",
+    "4 yr Degree",
+    "Advanced Degree",
+    "Unknown"};
+constexpr std::array<std::string_view, 4> kCreditRatings =
+    {"Good", "High Risk", "Low Risk", "Unknown"};
+
+// Returns a pseudo random number that depends only on 'table', 'column' and
+// 'row'. This is the splitmix64 finalizer.
+uint64_t random(Table table, int32_t column, uint64_t row) {
+  uint64_t x = (static_cast<uint64_t>(table) << 56) ^
+      (static_cast<uint64_t>(column) << 48) ^ row;
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Returns a pseudo random number in [low, high].
+int64_t randomInRange(
+    Table table,
+    int32_t column,
+    uint64_t row,
+    int64_t low,
+    int64_t high) {
+  return low + random(table, column, row) % (high - low + 1);
+}
+
+double roundToCents(double value) {
+  return std::round(value * 100) / 100;
+}
+
+// Returns a 16 character business key like the *_id columns of the spec.
+std::string makeBusinessKey(uint64_t key) {
+  std::string id(16, 'A');
+  for (auto i = 15; i >= 0 && key > 0; --i) {
+    id[i] = 'A' + key % 16;
+    key /= 16;
+  }
+  return id;
+}
+
+// Converts days since epoch to year, month and day.
+void civilFromDays(int32_t days, int32_t& year, int32_t& month, int32_t& day) {
+  const int64_t z = days + 719'468;
+  const int64_t era = (z >= 0 ? z : z - 146'096) / 146'097;
+  const int64_t dayOfEra = z - era * 146'097;
+  const int64_t yearOfEra = (dayOfEra - dayOfEra / 1'460 +
+                             dayOfEra / 36'524 - dayOfEra / 146'096) /
+      365;
+  const int64_t dayOfYear =
+      dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  const int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+  day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+  month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+  year = yearOfEra + era * 400 + (month <= 2);
+}
+
+size_t scaledRowCount(size_t rowsAtScaleFactor1, double scaleFactor) {
+  return std::max<size_t>(1, rowsAtScaleFactor1 * scaleFactor);
+}
+
+size_t getVectorSize(size_t rowCount, size_t maxRows, size_t offset) {
+  if (offset >= rowCount) {
+    return 0;
+  }
+  return std::min(rowCount - offset, maxRows);
+}
+
+std::vector<VectorPtr> allocateVectors(
+    const RowTypePtr& type,
+    size_t vectorSize,
+    memory::MemoryPool* pool) {
+  std::vector<VectorPtr> vectors;
+  vectors.reserve(type->size());
+
+  for (const auto& childType : type->children()) {
+    vectors.emplace_back(BaseVector::create(childType, vectorSize, pool));
+  }
+  return vectors;
+}
+
+// Copies 'value' into 'vector' at 'i'.
+void setString(
+    FlatVector<StringView>* vector,
+    size_t i,
+    const std::string& value) {
+  vector->set(i, StringView(value));
+}
+
+template <typename T>
+FlatVector<T>* flat(const VectorPtr& vector) {
+  return vector->asFlatVector<T>();
+}
+
+void genStoreSales(
+    const std::vector<VectorPtr>& children,
+    size_t vectorSize,
+    size_t offset,
+    double scaleFactor) {
+  constexpr auto kTable = Table::TBL_STORE_SALES;
+  const auto numItems = getRowCount(Table::TBL_ITEM, scaleFactor);
+  const auto numStores = getRowCount(Table::TBL_STORE, scaleFactor);
+  const auto numPromotions = getRowCount(Table::TBL_PROMOTION, scaleFactor);
+  const auto numDemographics =
+      getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, scaleFactor);
+
+  auto* soldDate = flat<int64_t>(children[0]);
+  auto* item = flat<int64_t>(children[1]);
+  auto* demographics = flat<int64_t>(children[2]);
+  auto* store = flat<int64_t>(children[3]);
+  auto* promotion = flat<int64_t>(children[4]);
+  auto* ticket = flat<int64_t>(children[5]);
+  auto* quantity = flat<int32_t>(children[6]);
+  auto* wholesaleCost = flat<double>(children[7]);
+  auto* listPrice = flat<double>(children[8]);
+  auto* salesPrice = flat<double>(children[9]);
+  auto* extDiscount = flat<double>(children[10]);
+  auto* extSalesPrice = flat<double>(children[11]);
+  auto* extWholesaleCost = flat<double>(children[12]);
+  auto* extListPrice = flat<double>(children[13]);
+  auto* coupon = flat<double>(children[14]);
+  auto* netPaid = flat<double>(children[15]);
+  auto* netProfit = flat<double>(children[16]);
+
+  // Sets 'vector' at 'i' to a random key in [1, 'numKeys'] or to null for
+  // about 1 in 64 rows, like the foreign keys of the fact tables in dsdgen.
+  auto setForeignKey = [&](FlatVector<int64_t>* vector,
+                           int32_t column,
+                           size_t i,
+                           uint64_t row,
+                           int64_t low,
+                           int64_t high) {
+    const auto value = random(kTable, column, row);
+    if (value % 64 == 0) {
+      vector->setNull(i, true);
+    } else {
+      vector->set(i, low + (value >> 6) % (high - low + 1));
+    }
+  };
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const uint64_t row = offset + i;
+    setForeignKey(soldDate, 0, i, row, kFirstSaleDateSk, kLastSaleDateSk);
+    item->set(i, randomInRange(kTable, 1, row, 1, numItems));
+    setForeignKey(demographics, 2, i, row, 1, numDemographics);
+    setForeignKey(store, 3, i, row, 1, numStores);
+    setForeignKey(promotion, 4, i, row, 1, numPromotions);
+    // About 12 line items per ticket.
+    ticket->set(i, row / 12 + 1);
+
+    const auto numUnits = randomInRange(kTable, 6, row, 1, 100);
+    const auto wholesale =
+        randomInRange(kTable, 7, row, 100, 10'000) / 100.0;
+    const auto list = roundToCents(
+        wholesale * (1 + randomInRange(kTable, 8, row, 0, 200) / 100.0));
+    const auto sales = roundToCents(
+        list * (1 - randomInRange(kTable, 9, row, 0, 90) / 100.0));
+    const auto extSales = roundToCents(sales * numUnits);
+    const auto extWholesale = roundToCents(wholesale * numUnits);
+    const auto couponAmount = randomInRange(kTable, 14, row, 0, 4) == 0
+        ? roundToCents(extSales * randomInRange(kTable, 15, row, 0, 100) / 100)
+        : 0.0;
+    quantity->set(i, numUnits);
+    wholesaleCost->set(i, wholesale);
+    listPrice->set(i, list);
+    salesPrice->set(i, sales);
+    extDiscount->set(i, roundToCents((list - sales) * numUnits));
+    extSalesPrice->set(i, extSales);
+    extWholesaleCost->set(i, extWholesale);
+    extListPrice->set(i, roundToCents(list * numUnits));
+    coupon->set(i, couponAmount);
+    netPaid->set(i, roundToCents(extSales - couponAmount));
+    netProfit->set(i, roundToCents(extSales - couponAmount - extWholesale));
+  }
+}
+
+void genDateDim(
+    const std::vector<VectorPtr>& children,
+    size_t vectorSize,
+    size_t offset) {
+  auto* dateSk = flat<int64_t>(children[0]);
+  auto* dateId = flat<StringView>(children[1]);
+  auto* date = flat<int32_t>(children[2]);
+  auto* monthSeq = flat<int32_t>(children[3]);
+  auto* weekSeq = flat<int32_t>(children[4]);
+  auto* year = flat<int32_t>(children[5]);
+  auto* dayOfWeek = flat<int32_t>(children[6]);
+  auto* monthOfYear = flat<int32_t>(children[7]);
+  auto* dayOfMonth = flat<int32_t>(children[8]);
+  auto* quarterOfYear = flat<int32_t>(children[9]);
+  auto* dayName = flat<StringView>(children[10]);
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const auto row = offset + i;
+    const int64_t sk = kFirstDateSk + row;
+    const int32_t days = kFirstDate + row;
+    int32_t y;
+    int32_t m;
+    int32_t d;
+    civilFromDays(days, y, m, d);
+    // 1970-01-01 is a Thursday.
+    const auto dow = ((days + 4) % 7 + 7) % 7;
+
+    dateSk->set(i, sk);
+    setString(dateId, i, makeBusinessKey(sk));
+    date->set(i, days);
+    monthSeq->set(i, (y - 1900) * 12 + m - 1);
+    // 1900-01-01 is a Monday and starts week 1.
+    weekSeq->set(i, (row + 1) / 7 + 1);
+    year->set(i, y);
+    dayOfWeek->set(i, dow);
+    monthOfYear->set(i, m);
+    dayOfMonth->set(i, d);
+    quarterOfYear->set(i, (m - 1) / 3 + 1);
+    dayName->set(i, StringView(kDayNames[dow]));
+  }
+}
+
+void genItem(
+    const std::vector<VectorPtr>& children,
+    size_t vectorSize,
+    size_t offset) {
+  constexpr auto kTable = Table::TBL_ITEM;
+  auto* itemSk = flat<int64_t>(children[0]);
+  auto* itemId = flat<StringView>(children[1]);
+  auto* itemDesc = flat<StringView>(children[2]);
+  auto* currentPrice = flat<double>(children[3]);
+  auto* brandId = flat<int32_t>(children[4]);
+  auto* brand = flat<StringView>(children[5]);
+  auto* classId = flat<int32_t>(children[6]);
+  auto* className = flat<StringView>(children[7]);
+  auto* categoryId = flat<int32_t>(children[8]);
+  auto* category = flat<StringView>(children[9]);
+  auto* manufactId = flat<int32_t>(children[10]);
+  auto* manufact = flat<StringView>(children[11]);
+  auto* managerId = flat<int32_t>(children[12]);
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const auto row = offset + i;
+    const int64_t sk = row + 1;
+    const auto categoryIndex = randomInRange(kTable, 9, row, 0, 9);
+    const auto classIndex = randomInRange(kTable, 7, row, 0, 15);
+    const auto brandNumber = randomInRange(kTable, 4, row, 1, 10);
+    const auto brandStem =
+        kBrandStems[(categoryIndex * 16 + classIndex) % kBrandStems.size()];
+    // The ids that the queries filter on cycle through their domain so that
+    // each value is present at small scale factors.
+    const int32_t manufacturer = (sk - 1) % 1'000 + 1;
+
+    itemSk->set(i, sk);
+    setString(itemId, i, makeBusinessKey(sk));
+    setString(
+        itemDesc,
+        i,
+        fmt::format(
+            "{} {} item number {}",
+            kCategories[categoryIndex],
+            kClasses[classIndex],
+            sk));
+    currentPrice->set(i, randomInRange(kTable, 3, row, 9, 9'999) / 100.0);
+    brandId->set(
+        i,
+        (categoryIndex + 1) * 1'000'000 + (classIndex + 1) * 1'000 +
+            brandNumber);
+    setString(brand, i, fmt::format("{} #{}", brandStem, brandNumber));
+    classId->set(i, classIndex + 1);
+    className->set(i, StringView(kClasses[classIndex]));
+    categoryId->set(i, categoryIndex + 1);
+    category->set(i, StringView(kCategories[categoryIndex]));
+    manufactId->set(i, manufacturer);
+    setString(manufact, i, fmt::format("manufact#{}", manufacturer));
+    managerId->set(i, sk * 37 % 100 + 1);
+  }
+}
+
+void genStore(
+    const std::vector<VectorPtr>& children,
+    size_t vectorSize,
+    size_t offset) {
+  auto* storeSk = flat<int64_t>(children[0]);
+  auto* storeId = flat<StringView>(children[1]);
+  auto* storeName = flat<StringView>(children[2]);
+  auto* numEmployees = flat<int32_t>(children[3]);
+  auto* city = flat<StringView>(children[4]);
+  auto* state = flat<StringView>(children[5]);
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const auto row = offset + i;
+    const int64_t sk = row + 1;
+    storeSk->set(i, sk);
+    setString(storeId, i, makeBusinessKey(sk));
+    setString(storeName, i, fmt::format("store#{}", sk));
+    numEmployees->set(i, randomInRange(Table::TBL_STORE, 3, row, 200, 300));
+    setString(city, i, fmt::format("city#{}", sk % 20));
+    // Most stores are in TN as in dsdgen at scale factor 1.
+    const auto stateIndex = row % 3 == 2 ? sk % kStates.size() : 0;
+    state->set(i, StringView(kStates[stateIndex]));
+  }
+}
+
+void genCustomerDemographics(
+    const std::vector<VectorPtr>& children,
+    size_t vectorSize,
+    size_t offset) {
+  auto* demoSk = flat<int64_t>(children[0]);
+  auto* gender = flat<StringView>(children[1]);
+  auto* maritalStatus = flat<StringView>(children[2]);
+  auto* educationStatus = flat<StringView>(children[3]);
+  auto* purchaseEstimate = flat<int32_t>(children[4]);
+  auto* creditRating = flat<StringView>(children[5]);
+  auto* depCount = flat<int32_t>(children[6]);
+  auto* depEmployedCount = flat<int32_t>(children[7]);
+  auto* depCollegeCount = flat<int32_t>(children[8]);
+
+  // The rows enumerate the cross product of the attributes with the gender
+  // varying fastest.
+  for (size_t i = 0; i < vectorSize; ++i) {
+    auto row = offset + i;
+    demoSk->set(i, row + 1);
+    gender->set(i, StringView(kGenders[row % kGenders.size()]));
+    row /= kGenders.size();
+    maritalStatus->set(
+        i, StringView(kMaritalStatuses[row % kMaritalStatuses.size()]));
+    row /= kMaritalStatuses.size();
+    educationStatus->set(
+        i, StringView(kEducationStatuses[row % kEducationStatuses.size()]));
+    row /= kEducationStatuses.size();
+    purchaseEstimate->set(i, (row % 20 + 1) * 500);
+    row /= 20;
+    creditRating->set(
+        i, StringView(kCreditRatings[row % kCreditRatings.size()]));
+    row /= kCreditRatings.size();
+    depCount->set(i, row % 7);
+    row /= 7;
+    depEmployedCount->set(i, row % 7);
+    row /= 7;
+    depCollegeCount->set(i, row % 7);
+  }
+}
+
+void genPromotion(
+    const std::vector<VectorPtr>& children,
+    size_t vectorSize,
+    size_t offset) {
+  constexpr auto kTable = Table::TBL_PROMOTION;
+  auto* promoSk = flat<int64_t>(children[0]);
+  auto* promoId = flat<StringView>(children[1]);
+  auto* promoName = flat<StringView>(children[2]);
+  auto* channelEmail = flat<StringView>(children[3]);
+  auto* channelEvent = flat<StringView>(children[4]);
+  auto* channelTv = flat<StringView>(children[5]);
+
+  auto yesNo = [&](int32_t column, uint64_t row) {
+    return StringView(randomInRange(kTable, column, row, 0, 1) ? "Y" : "N");
+  };
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const auto row = offset + i;
+    const int64_t sk = row + 1;
+    promoSk->set(i, sk);
+    setString(promoId, i, makeBusinessKey(sk));
+    setString(promoName, i, fmt::format("promo#{}", sk % 10));
+    channelEmail->set(i, yesNo(3, row));
+    channelEvent->set(i, yesNo(4, row));
+    channelTv->set(i, yesNo(5, row));
+  }
+}
+
+} // namespace
+
+std::string_view toTableName(Table table) {
+  switch (table) {
+    case Table::TBL_STORE_SALES:
+      return "store_sales";
+    case Table::TBL_DATE_DIM:
+      return "date_dim";
+    case Table::TBL_ITEM:
+      return "item";
+    case Table::TBL_STORE:
+      return "store";
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return "customer_demographics";
+    case Table::TBL_PROMOTION:
+      return "promotion";
+  }
+  return ""; // make gcc happy.
+}
+
+Table fromTableName(std::string_view tableName) {
+  static std::unordered_map<std::string_view, Table> map{
+      {"store_sales", Table::TBL_STORE_SALES},
+      {"date_dim", Table::TBL_DATE_DIM},
+      {"item", Table::TBL_ITEM},
+      {"store", Table::TBL_STORE},
+      {"customer_demographics", Table::TBL_CUSTOMER_DEMOGRAPHICS},
+      {"promotion", Table::TBL_PROMOTION},
+  };
+
+  auto it = map.find(tableName);
+  if (it != map.end()) {
+    return it->second;
+  }
+  throw std::invalid_argument(
+      fmt::format("Invalid TPC-DS table name: '{}'", tableName));
+}
+
+size_t getRowCount(Table table, double scaleFactor) {
+  VELOX_CHECK_GE(scaleFactor, 0, "Tpcds scale factor must be non-negative");
+  switch (table) {
+    case Table::TBL_STORE_SALES:
+      return 2'880'404 * scaleFactor;
+    case Table::TBL_DATE_DIM:
+      return kNumDates;
+    case Table::TBL_ITEM:
+      return scaledRowCount(18'000, scaleFactor);
+    case Table::TBL_STORE:
+      return scaledRowCount(12, scaleFactor);
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      // The cross product of the attributes does not grow beyond scale factor
+      // 1. Smaller scale factors take a prefix of it.
+      return scaledRowCount(kNumDemographics, std::min(scaleFactor, 1.0));
+    case Table::TBL_PROMOTION:
+      return scaledRowCount(300, scaleFactor);
+  }
+  return 0; // make gcc happy.
+}
+
+RowTypePtr getTableSchema(Table table) {
+  switch (table) {
+    case Table::TBL_STORE_SALES: {
+      static RowTypePtr type = ROW(
+          {
+              "ss_sold_date_sk",
+              "ss_item_sk",
+              "ss_cdemo_sk",
+              "ss_store_sk",
+              "ss_promo_sk",
+              "ss_ticket_number",
+              "ss_quantity",
+              "ss_wholesale_cost",
+              "ss_list_price",
+              "ss_sales_price",
+              "ss_ext_discount_amt",
+              "ss_ext_sales_price",
+              "ss_ext_wholesale_cost",
+              "ss_ext_list_price",
+              "ss_coupon_amt",
+              "ss_net_paid",
+              "ss_net_profit",
+          },
+          {
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              INTEGER(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+          });
+      return type;
+    }
+
+    case Table::TBL_DATE_DIM: {
+      static RowTypePtr type = ROW(
+          {
+              "d_date_sk",
+              "d_date_id",
+              "d_date",
+              "d_month_seq",
+              "d_week_seq",
+              "d_year",
+              "d_dow",
+              "d_moy",
+              "d_dom",
+              "d_qoy",
+              "d_day_name",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              DATE(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_ITEM: {
+      static RowTypePtr type = ROW(
+          {
+              "i_item_sk",
+              "i_item_id",
+              "i_item_desc",
+              "i_current_price",
+              "i_brand_id",
+              "i_brand",
+              "i_class_id",
+              "i_class",
+              "i_category_id",
+              "i_category",
+              "i_manufact_id",
+              "i_manufact",
+              "i_manager_id",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              DOUBLE(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+          });
+      return type;
+    }
+
+    case Table::TBL_STORE: {
+      static RowTypePtr type = ROW(
+          {
+              "s_store_sk",
+              "s_store_id",
+              "s_store_name",
+              "s_number_employees",
+              "s_city",
+              "s_state",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS: {
+      static RowTypePtr type = ROW(
+          {
+              "cd_demo_sk",
+              "cd_gender",
+              "cd_marital_status",
+              "cd_education_status",
+              "cd_purchase_estimate",
+              "cd_credit_rating",
+              "cd_dep_count",
+              "cd_dep_employed_count",
+              "cd_dep_college_count",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+          });
+      return type;
+    }
+
+    case Table::TBL_PROMOTION: {
+      static RowTypePtr type = ROW(
+          {
+              "p_promo_sk",
+              "p_promo_id",
+              "p_promo_name",
+              "p_channel_email",
+              "p_channel_event",
+              "p_channel_tv",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+          });
+      return type;
+    }
+  }
+  return nullptr; // make gcc happy.
+}
+
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName) {
+  return getTableSchema(table)->findChild(columnName);
+}
+
+RowVectorPtr genTpcdsData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  const auto rowType = getTableSchema(table);
+  const size_t vectorSize =
+      getVectorSize(getRowCount(table, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(rowType, vectorSize, pool);
+
+  switch (table) {
+    case Table::TBL_STORE_SALES:
+      genStoreSales(children, vectorSize, offset, scaleFactor);
+      break;
+    case Table::TBL_DATE_DIM:
+      genDateDim(children, vectorSize, offset);
+      break;
+    case Table::TBL_ITEM:
+      genItem(children, vectorSize, offset);
+      break;
+    case Table::TBL_STORE:
+      genStore(children, vectorSize, offset);
+      break;
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      genCustomerDemographics(children, vectorSize, offset);
+      break;
+    case Table::TBL_PROMOTION:
+      genPromotion(children, vectorSize, offset);
+      break;
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+} // namespace facebook::velox::tpcds
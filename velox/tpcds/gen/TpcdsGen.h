@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::tpcds {
+
+/// Generates data for a subset of the TPC-DS tables encoded using Velox
+/// Vectors. The subset covers the store sales star schema used by the queries
+/// in TpcdsQueryBuilder.
+///
+/// Like TpchGen, the API takes the table, the scale factor, the maximum batch
+/// size and the offset of the first row. Each value is a function of the
+/// table, the column and the row number, so that different slices of the
+/// range "[0, getRowCount(Table, scaleFactor)[" can be generated in parallel
+/// and give the same data as a single pass.
+///
+/// The schemas, keys and value domains follow the TPC-DS spec available at
+/// https://www.tpc.org/tpcds/ but the data is not made by dsdgen, so the
+/// distributions and the query results differ from the official ones. Row
+/// counts at scale factor 1 are those of the spec. The fact table and the
+/// dimensions that grow with the scale factor are scaled linearly.
+///
+/// Data is always returned in a RowVector.
+
+enum class Table : uint8_t {
+  TBL_STORE_SALES,
+  TBL_DATE_DIM,
+  TBL_ITEM,
+  TBL_STORE,
+  TBL_CUSTOMER_DEMOGRAPHICS,
+  TBL_PROMOTION,
+};
+
+static constexpr auto tables = {
+    tpcds::Table::TBL_STORE_SALES,
+    tpcds::Table::TBL_DATE_DIM,
+    tpcds::Table::TBL_ITEM,
+    tpcds::Table::TBL_STORE,
+    tpcds::Table::TBL_CUSTOMER_DEMOGRAPHICS,
+    tpcds::Table::TBL_PROMOTION};
+
+/// Returns table name as a string.
+std::string_view toTableName(Table table);
+
+/// Returns the table enum value given a table name.
+Table fromTableName(std::string_view tableName);
+
+/// Returns the row count for a particular TPC-DS table given a scale factor.
+size_t getRowCount(Table table, double scaleFactor);
+
+/// Returns the schema (RowType) for a particular TPC-DS table.
+RowTypePtr getTableSchema(Table table);
+
+/// Returns the type of a particular table:column pair. Throws if `columnName`
+/// does not exist in `table`.
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName);
+
+/// Returns a row vector containing at most `maxRows` rows of `table`,
+/// starting at `offset`, and given the scale factor. The row vector has the
+/// schema returned by getTableSchema().
+RowVectorPtr genTpcdsData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+} // namespace facebook::velox::tpcds
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gtest/gtest.h"
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+#include "velox/vector/FlatVector.h"
+
+namespace {
+
+using namespace facebook::velox;
+using namespace facebook::velox::tpcds;
+
+class TpcdsGenTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    pool_ = memory::memoryManager()->addLeafPool("TpcdsGenTest");
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+TEST_F(TpcdsGenTest, rowCounts) {
+  EXPECT_EQ(2'880'404, getRowCount(Table::TBL_STORE_SALES, 1));
+  EXPECT_EQ(73'049, getRowCount(Table::TBL_DATE_DIM, 1));
+  EXPECT_EQ(73'049, getRowCount(Table::TBL_DATE_DIM, 100));
+  EXPECT_EQ(18'000, getRowCount(Table::TBL_ITEM, 1));
+  EXPECT_EQ(12, getRowCount(Table::TBL_STORE, 1));
+  EXPECT_EQ(1, getRowCount(Table::TBL_STORE, 0.01));
+  EXPECT_EQ(1'920'800, getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, 10));
+  EXPECT_EQ(300, getRowCount(Table::TBL_PROMOTION, 1));
+
+  for (const auto table : tables) {
+    EXPECT_EQ(table, fromTableName(toTableName(table)));
+  }
+  EXPECT_THROW(fromTableName("lineitem"), std::invalid_argument);
+}
+
+TEST_F(TpcdsGenTest, dateDim) {
+  auto rowVector = genTpcdsData(Table::TBL_DATE_DIM, pool_.get(), 10, 0);
+  ASSERT_EQ(10, rowVector->size());
+  ASSERT_EQ(
+      "{2415022, AAAAAAAAAACENJKO, 1900-01-02, 0, 1, 1900, 2, 1, 2, 1, Tuesday}",
+      rowVector->toString(0));
+
+  // ss_sold_date_sk starts at 1998-01-02.
+  rowVector =
+      genTpcdsData(Table::TBL_DATE_DIM, pool_.get(), 1, 2'450'816 - 2'415'022);
+  ASSERT_EQ(
+      DATE()->toDays("1998-01-02"),
+      rowVector->childAt(2)->asFlatVector<int32_t>()->valueAt(0));
+  ASSERT_EQ(1998, rowVector->childAt(5)->asFlatVector<int32_t>()->valueAt(0));
+
+  // The last batch is short.
+  rowVector = genTpcdsData(Table::TBL_DATE_DIM, pool_.get(), 10, 73'045);
+  ASSERT_EQ(4, rowVector->size());
+}
+
+TEST_F(TpcdsGenTest, customerDemographics) {
+  auto rowVector =
+      genTpcdsData(Table::TBL_CUSTOMER_DEMOGRAPHICS, pool_.get(), 100, 0, 1);
+  ASSERT_EQ("{1, M, M, Primary, 500, Good, 0, 0, 0}", rowVector->toString(0));
+  ASSERT_EQ("{2, F, M, Primary, 500, Good, 0, 0, 0}", rowVector->toString(1));
+  ASSERT_EQ("{3, M, S, Primary, 500, Good, 0, 0, 0}", rowVector->toString(2));
+  ASSERT_EQ(
+      "{71, M, M, Primary, 1000, Good, 0, 0, 0}", rowVector->toString(70));
+
+  rowVector = genTpcdsData(
+      Table::TBL_CUSTOMER_DEMOGRAPHICS, pool_.get(), 100, 1'920'799, 1);
+  ASSERT_EQ(
+      "{1920800, F, U, Unknown, 10000, Unknown, 6, 6, 6}",
+      rowVector->toString(0));
+}
+
+TEST_F(TpcdsGenTest, storeSales) {
+  constexpr double kScaleFactor = 0.01;
+  const auto numItems = getRowCount(Table::TBL_ITEM, kScaleFactor);
+  auto rowVector = genTpcdsData(
+      Table::TBL_STORE_SALES, pool_.get(), 10'000, 0, kScaleFactor);
+  ASSERT_EQ(10'000, rowVector->size());
+
+  auto* soldDate = rowVector->childAt(0)->asFlatVector<int64_t>();
+  auto* item = rowVector->childAt(1)->asFlatVector<int64_t>();
+  auto* quantity = rowVector->childAt(6)->asFlatVector<int32_t>();
+  auto* salesPrice = rowVector->childAt(9)->asFlatVector<double>();
+  auto* extSalesPrice = rowVector->childAt(11)->asFlatVector<double>();
+  int32_t numNullDates = 0;
+  for (auto i = 0; i < rowVector->size(); ++i) {
+    if (soldDate->isNullAt(i)) {
+      ++numNullDates;
+    } else {
+      ASSERT_GE(soldDate->valueAt(i), 2'450'816);
+      ASSERT_LE(soldDate->valueAt(i), 2'452'642);
+    }
+    ASSERT_GE(item->valueAt(i), 1);
+    ASSERT_LE(item->valueAt(i), numItems);
+    ASSERT_NEAR(
+        salesPrice->valueAt(i) * quantity->valueAt(i),
+        extSalesPrice->valueAt(i),
+        0.01);
+  }
+  // About 1 in 64 foreign keys are null.
+  ASSERT_GT(numNullDates, 100);
+  ASSERT_LT(numNullDates, 220);
+}
+
+TEST_F(TpcdsGenTest, reproducible) {
+  for (const auto table : tables) {
+    SCOPED_TRACE(toTableName(table));
+    auto rowVector1 = genTpcdsData(table, pool_.get(), 100, 0, 0.1);
+    auto rowVector2 = genTpcdsData(table, pool_.get(), 100, 0, 0.1);
+    ASSERT_EQ(rowVector1->size(), rowVector2->size());
+    for (size_t i = 0; i < rowVector1->size(); ++i) {
+      ASSERT_TRUE(rowVector1->equalValueAt(rowVector2.get(), i, i));
+    }
+
+    // Batches starting at different offsets have the same rows.
+    auto rowVector3 = genTpcdsData(table, pool_.get(), 90, 10, 0.1);
+    for (size_t i = 0; i < rowVector3->size(); ++i) {
+      ASSERT_TRUE(rowVector3->equalValueAt(rowVector1.get(), i, i + 10));
+    }
+  }
+}
+
+} // namespace
@@ -18,9 +18,11 @@
 
 #include <folly/Conv.h>
 #include <cctype>
+#include <cstring>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 #include "velox/type/TimestampConversion.h"
 #include "velox/type/Type.h"
 
@@ -48,6 +50,114 @@ struct TruncateLegacyCastPolicy {
   static constexpr bool legacyCast = true;
 };
 
+namespace detail {
+
+// Returns true if the 8 bytes of 'chunk' are all ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+// Returns the value of 8 ASCII digits loaded in little-endian order. Combines
+// pairs of digits, then pairs of 2-digit and 4-digit values with
+// multiplications instead of a loop over the digits.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (1'000'000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10'000ULL << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk =
+      (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32;
+  return static_cast<uint32_t>(chunk);
+}
+
+// Parses an integer of the form [-]digits with at most 18 digits into
+// 'result'. Returns false if 'data' has another form or the value does not
+// fit in T, so that the caller falls back to the general conversion and its
+// error messages.
+template <typename T>
+bool tryParseSimpleInteger(const char* data, size_t size, T& result) {
+  static_assert(sizeof(T) <= sizeof(int64_t));
+  size_t pos = 0;
+  bool negative = false;
+  if (size > 0 && data[0] == '-') {
+    negative = true;
+    pos = 1;
+  }
+  if (size == pos || size - pos > 18) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (; pos + 8 <= size; pos += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data + pos, sizeof(chunk));
+    if (!isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; pos < size; ++pos) {
+    const uint8_t digit = data[pos] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  if (value >
+      static_cast<uint64_t>(std::numeric_limits<T>::max()) + negative) {
+    return false;
+  }
+  result = negative ? static_cast<T>(-static_cast<int64_t>(value))
+                    : static_cast<T>(value);
+  return true;
+}
+
+// Parses a decimal of the form [-]digits[.digits] with at most 15 digits
+// into 'result'. Returns false for other forms, e.g. exponents, infinity and
+// NaN, that the caller converts with the general conversion. The digits form
+// an integer below 2^53 and the divisor is a power of 10 up to 10^15, both
+// are exact doubles and the single division rounds correctly.
+inline bool
+tryParseSimpleDouble(const char* data, size_t size, double& result) {
+  static constexpr double kPowersOf10[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+      1e13, 1e14, 1e15};
+  size_t pos = 0;
+  bool negative = false;
+  if (size > 0 && data[0] == '-') {
+    negative = true;
+    pos = 1;
+  }
+  uint64_t mantissa = 0;
+  int32_t numDigits = 0;
+  int32_t numFractionDigits = 0;
+  bool hasPoint = false;
+  for (; pos < size; ++pos) {
+    const uint8_t digit = data[pos] - '0';
+    if (digit <= 9) {
+      mantissa = mantissa * 10 + digit;
+      ++numDigits;
+      numFractionDigits += hasPoint;
+    } else if (data[pos] == '.' && !hasPoint && numDigits > 0) {
+      hasPoint = true;
+    } else {
+      return false;
+    }
+  }
+  if (numDigits == 0 || numDigits > 15 ||
+      (hasPoint && numFractionDigits == 0)) {
+    return false;
+  }
+  const double value =
+      static_cast<double>(mantissa) / kPowersOf10[numFractionDigits];
+  result = negative ? -value : value;
+  return true;
+}
+
+} // namespace detail
+
 template <TypeKind KIND, typename = void, typename TPolicy = DefaultCastPolicy>
 struct Converter {
   template <typename T>
@@ -81,6 +191,17 @@ struct Converter<TypeKind::BOOLEAN, void, TPolicy> {
     return folly::to<T>(v);
   }
 
+  /// Same as cast() of a string but returns an error instead of throwing.
+  static Status tryCast(folly::StringPiece v, T& result) {
+    auto parsed = folly::tryTo<T>(v);
+    if (parsed.hasError()) {
+      return Status::UserError(
+          "{}", folly::makeConversionError(parsed.error(), v).what());
+    }
+    result = parsed.value();
+    return Status::OK();
+  }
+
   static T cast(const bool& v) {
     return folly::to<T>(v);
   }
@@ -161,13 +282,14 @@ struct Converter<
         "Conversion to {} is not supported", TypeTraits<KIND>::name);
   }
 
-  static T convertStringToInt(const folly::StringPiece v) {
+  static Status tryConvertStringToInt(const folly::StringPiece v, T& out) {
     // Handling integer target cases
     T result = 0;
     int index = 0;
     int len = v.size();
     if (len == 0) {
-      VELOX_USER_FAIL("Cannot cast an empty string to an integral value.");
+      return Status::UserError(
+          "Cannot cast an empty string to an integral value.");
     }
 
     // Setting negative flag
@@ -176,7 +298,7 @@ struct Converter<
     bool decimalPoint = false;
     if (v[0] == '-' || v[0] == '+') {
       if (len == 1) {
-        VELOX_USER_FAIL(
+        return Status::UserError(
             "Cannot cast an '{}' string to an integral value.", v[0]);
       }
       negative = v[0] == '-';
@@ -192,14 +314,14 @@ struct Converter<
           }
         }
         if (!std::isdigit(v[index])) {
-          VELOX_USER_FAIL("Encountered a non-digit character");
+          return Status::UserError("Encountered a non-digit character");
         }
         if (!decimalPoint) {
           result = result * 10 - (v[index] - '0');
         }
         // Overflow check
         if (result > 0) {
-          VELOX_USER_FAIL("Value is too large for type");
+          return Status::UserError("Value is too large for type");
         }
       }
     } else {
@@ -212,43 +334,75 @@ struct Converter<
           }
         }
         if (!std::isdigit(v[index])) {
-          VELOX_USER_FAIL("Encountered a non-digit character");
+          return Status::UserError("Encountered a non-digit character");
         }
         if (!decimalPoint) {
           result = result * 10 + (v[index] - '0');
         }
         // Overflow check
         if (result < 0) {
-          VELOX_USER_FAIL("Value is too large for type");
+          return Status::UserError("Value is too large for type");
         }
       }
     }
     // Final result
+    out = result;
+    return Status::OK();
+  }
+
+  static T convertStringToInt(const folly::StringPiece v) {
+    T result;
+    auto status = tryConvertStringToInt(v, result);
+    if (!status.ok()) {
+      VELOX_USER_FAIL("{}", status.message());
+    }
     return result;
   }
 
-  static T cast(folly::StringPiece v) {
+  static T convertString(const folly::StringPiece v) {
     if constexpr (TPolicy::truncate) {
       return convertStringToInt(v);
     } else {
+      if constexpr (sizeof(T) <= sizeof(int64_t)) {
+        T result;
+        if (detail::tryParseSimpleInteger(v.data(), v.size(), result)) {
+          return result;
+        }
+      }
       return folly::to<T>(v);
     }
   }
 
-  static T cast(const StringView& v) {
+  /// Same as cast() of a string but returns an error instead of throwing.
+  static Status tryCast(const folly::StringPiece v, T& result) {
     if constexpr (TPolicy::truncate) {
-      return convertStringToInt(folly::StringPiece(v));
+      return tryConvertStringToInt(v, result);
     } else {
-      return folly::to<T>(folly::StringPiece(v));
+      if constexpr (sizeof(T) <= sizeof(int64_t)) {
+        if (detail::tryParseSimpleInteger(v.data(), v.size(), result)) {
+          return Status::OK();
+        }
+      }
+      auto parsed = folly::tryTo<T>(v);
+      if (parsed.hasError()) {
+        return Status::UserError(
+            "{}", folly::makeConversionError(parsed.error(), v).what());
+      }
+      result = parsed.value();
+      return Status::OK();
     }
   }
 
+  static T cast(folly::StringPiece v) {
+    return convertString(v);
+  }
+
+  static T cast(const StringView& v) {
+    return convertString(folly::StringPiece(v));
+  }
+
   static T cast(const std::string& v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(v);
-    } else {
-      return folly::to<T>(v);
-    }
+    return convertString(v);
   }
 
   static T cast(const bool& v) {
@@ -384,16 +538,45 @@ struct Converter<
     return folly::to<T>(v);
   }
 
-  static T cast(folly::StringPiece v) {
+  static T convertString(const folly::StringPiece v) {
+    // REAL is left to folly so that its rounding is unchanged.
+    if constexpr (KIND == TypeKind::DOUBLE) {
+      double result;
+      if (detail::tryParseSimpleDouble(v.data(), v.size(), result)) {
+        return result;
+      }
+    }
     return cast<folly::StringPiece>(v);
   }
 
+  /// Same as cast() of a string but returns an error instead of throwing.
+  static Status tryCast(const folly::StringPiece v, T& result) {
+    if constexpr (KIND == TypeKind::DOUBLE) {
+      double parsed;
+      if (detail::tryParseSimpleDouble(v.data(), v.size(), parsed)) {
+        result = parsed;
+        return Status::OK();
+      }
+    }
+    auto parsed = folly::tryTo<T>(v);
+    if (parsed.hasError()) {
+      return Status::UserError(
+          "{}", folly::makeConversionError(parsed.error(), v).what());
+    }
+    result = parsed.value();
+    return Status::OK();
+  }
+
+  static T cast(folly::StringPiece v) {
+    return convertString(v);
+  }
+
   static T cast(const StringView& v) {
-    return cast<folly::StringPiece>(folly::StringPiece(v));
+    return convertString(folly::StringPiece(v));
   }
 
   static T cast(const std::string& v) {
-    return cast<std::string>(v);
+    return convertString(v);
   }
 
   static T cast(const bool& v) {
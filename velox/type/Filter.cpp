@@ -20,6 +20,8 @@
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +96,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBloomFilterValues:
+      strKind = "BloomFilterValues";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +136,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBloomFilterValues, "kBloomFilterValues"},
   };
 }
 
@@ -198,6 +204,7 @@ void Filter::registerSerDe() {
   registry.Register("BigintMultiRange", BigintMultiRange::create);
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
+  registry.Register("BloomFilterValues", BloomFilterValues::create);
   registry.Register("TimestampRange", TimestampRange::create);
 }
 
@@ -757,6 +764,48 @@ bool MultiRange::testingEquals(const Filter& other) const {
   return true;
 }
 
+folly::dynamic BloomFilterValues::serialize() const {
+  auto obj = Filter::serializeBase("BloomFilterValues");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = folly::hexlify(bits);
+  return obj;
+}
+
+FilterPtr BloomFilterValues::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  std::string bits;
+  VELOX_CHECK(folly::unhexlify(obj["bloomFilter"].asString(), bits));
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+  return std::make_unique<BloomFilterValues>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BloomFilterValues::testingEquals(const Filter& other) const {
+  auto otherBloomFilter = dynamic_cast<const BloomFilterValues*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloomFilter->min_ || max_ != otherBloomFilter->max_) {
+    return false;
+  }
+  if (bloomFilter_ == otherBloomFilter->bloomFilter_) {
+    return true;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloomFilter->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bits(size, '\0');
+  std::string otherBits(size, '\0');
+  bloomFilter_->serialize(bits.data());
+  otherBloomFilter->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
 BigintValuesUsingBitmask::BigintValuesUsingBitmask(
     int64_t min,
     int64_t max,
@@ -1211,6 +1260,7 @@ BigintMultiRange::BigintMultiRange(
   VELOX_CHECK(ranges_.size() > 1, "should contain at least 2 ranges");
   for (const auto& range : ranges_) {
     lowerBounds_.push_back(range->lower());
+    upperBounds_.push_back(range->upper());
   }
   for (int i = 1; i < lowerBounds_.size(); i++) {
     VELOX_CHECK(
@@ -1415,6 +1465,35 @@ bool BigintMultiRange::testInt64(int64_t value) const {
   return ranges_[place - 1]->testInt64(value);
 }
 
+xsimd::batch_bool<int64_t> BigintMultiRange::testValues(
+    xsimd::batch<int64_t> x) const {
+  // Finds the last range with the lower bound <= x in all lanes at a time by
+  // a branch free binary search over 'lowerBounds_'.
+  const int64_t numRanges = lowerBounds_.size();
+  const auto maxIndex = xsimd::broadcast<int64_t>(numRanges);
+  auto index = xsimd::broadcast<int64_t>(0);
+  for (int64_t step = bits::nextPowerOfTwo(numRanges) / 2; step > 0;
+       step /= 2) {
+    const auto candidate = index + step;
+    const auto inRange = candidate < maxIndex;
+    const auto lower =
+        simd::maskGather(x, inRange, lowerBounds_.data(), candidate);
+    index = xsimd::select(inRange & (lower <= x), candidate, index);
+  }
+  const xsimd::batch_bool<int64_t> allLanes(true);
+  const auto lower = simd::maskGather(x, allLanes, lowerBounds_.data(), index);
+  const auto upper = simd::maskGather(x, allLanes, upperBounds_.data(), index);
+  return (x >= lower) & (x <= upper);
+}
+
+xsimd::batch_bool<int32_t> BigintMultiRange::testValues(
+    xsimd::batch<int32_t> x) const {
+  auto first = simd::toBitMask(testValues(simd::getHalf<int64_t, 0>(x)));
+  auto second = simd::toBitMask(testValues(simd::getHalf<int64_t, 1>(x)));
+  return simd::fromBitMask<int32_t>(
+      first | (second << xsimd::batch<int64_t>::size));
+}
+
 bool BigintMultiRange::testInt64Range(int64_t min, int64_t max, bool hasNull)
     const {
   if (hasNull && nullAllowed_) {
@@ -2644,4 +2723,106 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+BloomFilterValues::BloomFilterValues(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)) {
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "Bloom filter must be initialized");
+  VELOX_CHECK_LE(min_, max_);
+}
+
+bool BloomFilterValues::testInt64Range(int64_t min, int64_t max, bool hasNull)
+    const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min == max) {
+    return mayContain(min);
+  }
+  return !(min > max_ || max < min_);
+}
+
+bool BloomFilterValues::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return bloomFilter_->mayContain(hash(min.value()));
+  }
+  return true;
+}
+
+std::unique_ptr<Filter> BloomFilterValues::mergeWith(
+    const Filter* other) const {
+  const bool bothNullAllowed = nullAllowed_ && other->testNull();
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return clone(false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      const auto min = std::max(min_, otherRange->lower());
+      const auto max = std::min(max_, otherRange->upper());
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BloomFilterValues>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBloomFilterValues: {
+      // The Bloom filters may not have the same size. Keeps the one of 'this'
+      // with the intersection of the ranges.
+      auto otherBloomFilter = static_cast<const BloomFilterValues*>(other);
+      const auto min = std::max(min_, otherBloomFilter->min_);
+      const auto max = std::min(max_, otherBloomFilter->max_);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BloomFilterValues>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask: {
+      const auto values =
+          other->kind() == FilterKind::kBigintValuesUsingHashTable
+          ? static_cast<const BigintValuesUsingHashTable*>(other)->values()
+          : static_cast<const BigintValuesUsingBitmask*>(other)->values();
+      std::vector<int64_t> valuesToKeep;
+      valuesToKeep.reserve(values.size());
+      for (auto value : values) {
+        if (mayContain(value)) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      return createBigintValues(valuesToKeep, bothNullAllowed);
+    }
+    case FilterKind::kBytesValues: {
+      std::vector<std::string> valuesToKeep;
+      for (const auto& value :
+           static_cast<const BytesValues*>(other)->values()) {
+        if (bloomFilter_->mayContain(hash(value))) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      if (valuesToKeep.empty()) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BytesValues>(valuesToKeep, bothNullAllowed);
+    }
+    default:
+      return other->clone(bothNullAllowed);
+  }
+}
 } // namespace facebook::velox::common
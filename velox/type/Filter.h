@@ -16,6 +16,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <memory>
 #include <sstream>
@@ -24,7 +25,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +59,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBloomFilterValues,
 };
 
 class Filter;
@@ -1854,6 +1858,10 @@ class BytesValues final : public Filter {
     for (const auto& value : values) {
       lengths_.insert(value.size());
       values_.insert(value);
+      if (value.size() < 64) {
+        lengthBits_ |= 1UL << value.size();
+      }
+      bits::setBit(prefixBits_.data(), prefixBit(value.data(), value.size()));
     }
 
     lower_ = *std::min_element(values_.begin(), values_.end());
@@ -1865,7 +1873,9 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        lengthBits_(other.lengthBits_),
+        prefixBits_(other.prefixBits_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1881,12 +1891,16 @@ class BytesValues final : public Filter {
   }
 
   bool testLength(int32_t length) const final {
+    if (length < 64) {
+      return lengthBits_ & (1UL << length);
+    }
     return lengths_.contains(length);
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    return testLength(length) &&
+        bits::isBitSet(prefixBits_.data(), prefixBit(value, length)) &&
+        values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
@@ -1903,10 +1917,27 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  static constexpr int32_t kPrefixBitsLog2 = 12;
+  static constexpr int32_t kPrefixBits = 1 << kPrefixBitsLog2;
+
+  // Returns the bit in 'prefixBits_' for a value with 'length' bytes
+  // starting with the bytes at 'value'. Hashes the length and up to the
+  // first 4 bytes.
+  static int32_t prefixBit(const char* value, int32_t length) {
+    uint32_t prefix = 0;
+    memcpy(&prefix, value, std::min(length, 4));
+    return ((prefix ^ length) * 0x9E3779B1U) >> (32 - kPrefixBitsLog2);
+  }
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+  // Bit 'n' is set if a value has 'n' bytes, for lengths below 64.
+  uint64_t lengthBits_{0};
+  // Bits of prefixBit() for 'values_'. Rejects most of the values not in
+  // 'values_' without hashing the whole value.
+  std::array<uint64_t, kPrefixBits / 64> prefixBits_{};
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -1932,6 +1963,12 @@ class BigintMultiRange final : public Filter {
 
   bool testInt64(int64_t value) const final;
 
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t>) const final;
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t>) const final;
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return Filter::testValues(x);
+  }
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1955,6 +1992,7 @@ class BigintMultiRange final : public Filter {
  private:
   const std::vector<std::unique_ptr<BigintRange>> ranges_;
   std::vector<int64_t> lowerBounds_;
+  std::vector<int64_t> upperBounds_;
 };
 
 /// NOT IN-list filter for string data type.
@@ -2071,6 +2109,119 @@ class MultiRange final : public Filter {
   const bool nanAllowed_;
 };
 
+/// Filter on the integral or string values of a hash join key made from the
+/// keys of the build side. Passes the values that may be in 'bloomFilter' and,
+/// for integral values, are within [min, max]. Values not on the build side
+/// may pass, so this can only be used to prefilter the probe side of a join.
+/// Copies share the immutable Bloom filter.
+class BloomFilterValues final : public Filter {
+ public:
+  /// @param min Minimum integral value. std::numeric_limits<int64_t>::min() for
+  /// strings.
+  /// @param max Maximum integral value. std::numeric_limits<int64_t>::max()
+  /// for strings.
+  /// @param bloomFilter Bloom filter of hash() of the values, not null.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BloomFilterValues(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed);
+
+  BloomFilterValues(const BloomFilterValues& other, bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Hashes of the values inserted in and probed against the Bloom filter.
+  static uint64_t hash(int64_t value) {
+    return folly::hash::twang_mix64(value);
+  }
+
+  static uint64_t hash(std::string_view value) {
+    return folly::hasher<std::string_view>()(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  /// The copy counts its own rejected values.
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BloomFilterValues>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  bool testInt64(int64_t value) const final {
+    if (mayContain(value)) {
+      return true;
+    }
+    ++numRejected_;
+    return false;
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    if (bloomFilter_->mayContain(hash(std::string_view(value, length)))) {
+      return true;
+    }
+    ++numRejected_;
+    return false;
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  /// Returns the AND of 'this' and 'other'. Since 'this' only prefilters a
+  /// join, the Bloom filter is dropped when it can't be combined with
+  /// 'other'.
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  const BloomFilter<>& bloomFilter() const {
+    return *bloomFilter_;
+  }
+
+  /// Number of values rejected by testInt64() and testBytes() on 'this'.
+  uint64_t numRejected() const {
+    return numRejected_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BloomFilterValues: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  bool mayContain(int64_t value) const {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hash(value));
+  }
+
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+  // A filter is tested by one thread at a time.
+  mutable uint64_t numRejected_{0};
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
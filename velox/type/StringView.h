@@ -17,6 +17,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -157,12 +158,27 @@ struct StringView {
   //       < 0, if this < other
   //       > 0, if this > other
   int32_t compare(const StringView& other) const {
+    if (auto result = compareInlinePart(other)) {
+      return *result;
+    }
+    const int32_t size = std::min(size_, other.size_) - kPrefixSize;
+    int32_t result =
+        memcmp(data() + kPrefixSize, other.data() + kPrefixSize, size);
+    return (result != 0) ? result : size_ - other.size_;
+  }
+
+  /// Returns the result of compare() if it is decided by the sizes, the
+  /// prefixes and the inlined bytes, std::nullopt if the out of line data
+  /// must be compared. Does not read the out of line data. This lets callers
+  /// whose out of line data may be in pieces, e.g. strings in a RowContainer,
+  /// skip making them contiguous for most comparisons.
+  std::optional<int32_t> compareInlinePart(const StringView& other) const {
     if (prefixAsInt() != other.prefixAsInt()) {
       // The result is decided on prefix. The shorter will be less
       // because the prefix is padded with zeros.
       return memcmp(prefix_, other.prefix_, kPrefixSize);
     }
-    int32_t size = std::min(size_, other.size_) - kPrefixSize;
+    const int32_t size = std::min(size_, other.size_) - kPrefixSize;
     if (size <= 0) {
       // One ends within the prefix.
       return size_ - other.size_;
@@ -171,9 +187,7 @@ struct StringView {
       int32_t result = memcmp(value_.inlined, other.value_.inlined, size);
       return (result != 0) ? result : size_ - other.size_;
     }
-    int32_t result =
-        memcmp(data() + kPrefixSize, other.data() + kPrefixSize, size);
-    return (result != 0) ? result : size_ - other.size_;
+    return std::nullopt;
   }
 
   bool operator<(const StringView& other) const {
@@ -17,6 +17,7 @@
 #include <chrono>
 #include "velox/external/date/tz.h"
 #include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneOffsets.h"
 
 namespace facebook::velox {
 namespace {
@@ -56,21 +57,7 @@ void Timestamp::toGMT(const date::time_zone& zone) {
       kMaxSeconds,
       "Timestamp seconds out of range for time zone adjustment");
 
-  date::local_time<std::chrono::seconds> localTime{
-      std::chrono::seconds(seconds_)};
-  std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
-      sysTime;
-  try {
-    sysTime = zone.to_sys(localTime);
-  } catch (const date::ambiguous_local_time&) {
-    // If the time is ambiguous, pick the earlier possibility to be consistent
-    // with Presto.
-    sysTime = zone.to_sys(localTime, date::choose::earliest);
-  } catch (const date::nonexistent_local_time& error) {
-    // If the time does not exist, fail the conversion.
-    VELOX_USER_FAIL(error.what());
-  }
-  seconds_ = sysTime.time_since_epoch().count();
+  seconds_ = util::TimeZoneOffsets::get(zone).toUtc(seconds_);
 }
 
 void Timestamp::toGMT(int16_t tzID) {
@@ -80,7 +67,7 @@ void Timestamp::toGMT(int16_t tzID) {
     seconds_ -= getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toGMT(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toGMT(util::TimeZoneOffsets::get(tzID).zone());
   }
 }
 
@@ -117,6 +104,11 @@ Timestamp::toTimePoint(bool allowOverflow) const {
 }
 
 void Timestamp::toTimezone(const date::time_zone& zone) {
+  if (seconds_ >= util::TimeZoneOffsets::kMinSeconds &&
+      seconds_ < util::TimeZoneOffsets::kMaxSeconds) {
+    seconds_ = util::TimeZoneOffsets::get(zone).toLocal(seconds_);
+    return;
+  }
   auto tp = toTimePoint();
   auto epoch = zone.to_local(tp).time_since_epoch();
   // NOTE: Round down to get the seconds of the current time point.
@@ -130,7 +122,7 @@ void Timestamp::toTimezone(int16_t tzID) {
     seconds_ += getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toTimezone(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toTimezone(util::TimeZoneOffsets::get(tzID).zone());
   }
 }
 
@@ -134,6 +134,15 @@ struct Timestamp {
     }
   }
 
+  /// Sets 'nanos' to the number of nanoseconds since the epoch and returns
+  /// true if it fits in int64_t, i.e. for timestamps between 1677-09-21 and
+  /// 2262-04-11. The result orders like the timestamp and is used as a packed
+  /// 64-bit key in hashing. Returns false without throwing otherwise.
+  bool tryToNanos(int64_t& nanos) const {
+    return !__builtin_mul_overflow(seconds_, (int64_t)1'000'000'000, &nanos) &&
+        !__builtin_add_overflow(nanos, (int64_t)nanos_, &nanos);
+  }
+
   // Keep it in header for getting inlined.
   int64_t toMillis() const {
     // We use int128_t to make sure the computation does not overflows since
@@ -291,6 +300,16 @@ struct Timestamp {
   /// A default time zone that is same across the process.
   static const date::time_zone& defaultTimezone();
 
+  /// Returns a negative, zero or positive value if 'a' is less than, equal to
+  /// or greater than 'b'. Compares one 128-bit key instead of seconds and nanos
+  /// separately, which avoids the branches of the relational operators. Nanos
+  /// are below 2^30, so they fit below the seconds in the key.
+  static int compare(const Timestamp& a, const Timestamp& b) {
+    const auto left = packForCompare(a);
+    const auto right = packForCompare(b);
+    return (left > right) - (left < right);
+  }
+
   bool operator==(const Timestamp& b) const {
     return seconds_ == b.seconds_ && nanos_ == b.nanos_;
   }
@@ -375,6 +394,10 @@ struct Timestamp {
   }
 
  private:
+  static __int128_t packForCompare(const Timestamp& ts) {
+    return ((__int128_t)ts.seconds_ << 30) | (__int128_t)ts.nanos_;
+  }
+
   int64_t seconds_;
   uint64_t nanos_;
 };
@@ -143,6 +143,69 @@ bool parseDoubleDigit(
   return false;
 }
 
+// Returns the value of the 'n' digits at 'buf' or -1 if a character is not
+// a digit.
+inline int32_t parseFixedDigits(const char* buf, int32_t n) {
+  int32_t result = 0;
+  for (auto i = 0; i < n; ++i) {
+    const uint8_t digit = buf[i] - '0';
+    if (digit > 9) {
+      return -1;
+    }
+    result = result * 10 + digit;
+  }
+  return result;
+}
+
+// Parses a date in the fixed format YYYY-MM-DD, which most inputs have, at
+// the start of 'buf' without the general parser. Returns false if 'buf' has
+// another format or the date is not valid, so that the caller falls back to
+// the general parser and its errors.
+inline bool
+tryParseIsoDate(const char* buf, size_t len, int64_t& daysSinceEpoch) {
+  if (len < 10 || buf[4] != '-' || buf[7] != '-') {
+    return false;
+  }
+  const auto year = parseFixedDigits(buf, 4);
+  const auto month = parseFixedDigits(buf + 5, 2);
+  const auto day = parseFixedDigits(buf + 8, 2);
+  if (year < 0 || month < 0 || day < 0 || !isValidDate(year, month, day)) {
+    return false;
+  }
+  daysSinceEpoch = daysSinceEpochFromDate(year, month, day);
+  return true;
+}
+
+// Parses a time in the fixed format HH:MM:SS[.fraction] with up to 6 digits
+// of fraction that spans all of 'buf'. Returns false for other formats.
+inline bool
+tryParseIsoTime(const char* buf, size_t len, int64_t& microsSinceMidnight) {
+  if (len < 8 || buf[2] != ':' || buf[5] != ':' ||
+      (len > 8 && (buf[8] != '.' || len == 9 || len > 15))) {
+    return false;
+  }
+  const auto hour = parseFixedDigits(buf, 2);
+  const auto minute = parseFixedDigits(buf + 3, 2);
+  const auto second = parseFixedDigits(buf + 6, 2);
+  if (hour < 0 || hour >= 24 || minute < 0 || minute >= 60 || second < 0 ||
+      second > 60) {
+    return false;
+  }
+  int32_t micros = 0;
+  if (len > 8) {
+    const int32_t numDigits = len - 9;
+    micros = parseFixedDigits(buf + 9, numDigits);
+    if (micros < 0) {
+      return false;
+    }
+    for (auto i = numDigits; i < 6; ++i) {
+      micros *= 10;
+    }
+  }
+  microsSinceMidnight = fromTime(hour, minute, second, micros);
+  return true;
+}
+
 bool isValidWeekDate(int32_t weekYear, int32_t weekOfYear, int32_t dayOfWeek) {
   if (dayOfWeek < 1 || dayOfWeek > 7) {
     return false;
@@ -589,6 +652,10 @@ int32_t castFromDateString(const char* str, size_t len, bool isIso8601) {
   int64_t daysSinceEpoch;
   size_t pos = 0;
 
+  if (len == 10 && tryParseIsoDate(str, len, daysSinceEpoch)) {
+    return daysSinceEpoch;
+  }
+
   auto mode =
       isIso8601 ? ParseMode::kStandardCast : ParseMode::kNonStandardCast;
   if (!tryParseDateString(str, len, pos, daysSinceEpoch, mode)) {
@@ -685,6 +752,17 @@ Timestamp fromTimestampString(const char* str, size_t len) {
   int64_t daysSinceEpoch;
   int64_t microsSinceMidnight;
 
+  // Fast path for YYYY-MM-DD and YYYY-MM-DD HH:MM:SS[.fraction].
+  if (tryParseIsoDate(str, len, daysSinceEpoch)) {
+    if (len == 10) {
+      return fromDatetime(daysSinceEpoch, 0);
+    }
+    if ((str[10] == ' ' || str[10] == 'T') &&
+        tryParseIsoTime(str + 11, len - 11, microsSinceMidnight)) {
+      return fromDatetime(daysSinceEpoch, microsSinceMidnight);
+    }
+  }
+
   if (!tryParseDateString(
           str, len, pos, daysSinceEpoch, ParseMode::kNonStrict)) {
     parserError(str, len);
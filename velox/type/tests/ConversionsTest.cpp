@@ -581,6 +581,68 @@ TEST_F(ConversionsTest, toIntegeralTypes) {
   }
 }
 
+TEST_F(ConversionsTest, stringToNumberFastPath) {
+  // Inputs around the limits of the digit parsing that does not go through
+  // folly.
+  testConversion<std::string, int64_t>(
+      {
+          "0",
+          "-0",
+          "007",
+          "12345678",
+          "-123456789",
+          "123456789012345678",
+          "-123456789012345678",
+          "9223372036854775807",
+          "-9223372036854775808",
+      },
+      {
+          0,
+          0,
+          7,
+          12345678,
+          -123456789,
+          123456789012345678,
+          -123456789012345678,
+          std::numeric_limits<int64_t>::max(),
+          std::numeric_limits<int64_t>::min(),
+      });
+  testConversion<std::string, int8_t>(
+      {"127", "-128", "-0012"}, {127, -128, -12});
+  testConversion<std::string, int8_t>(
+      {"128", "-129", "1.5", "12a", "-", "9223372036854775808"},
+      {},
+      /*truncate*/ false,
+      false,
+      /*expectError*/ true);
+
+  testConversion<std::string, double>(
+      {
+          "0.1",
+          "-0.25",
+          "123456.789012345",
+          "1234567890.1234567",
+          "-0",
+          "1.",
+          "1e3",
+      },
+      {
+          0.1,
+          -0.25,
+          123456.789012345,
+          1234567890.1234567,
+          -0.0,
+          1.0,
+          1000.0,
+      });
+  testConversion<std::string, double>(
+      {"1.2.3", "-", "1-"},
+      {},
+      /*truncate*/ false,
+      false,
+      /*expectError*/ true);
+}
+
 TEST_F(ConversionsTest, toString) {
   // From integral types.
   {
@@ -163,3 +163,13 @@ TEST_F(FilterSerDeTest, timestampFilter) {
   testSerde(TimestampRange(lo, hi, true));
   testSerde(TimestampRange(lo, hi, false));
 }
+
+TEST_F(FilterSerDeTest, bloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bloomFilter->insert(BloomFilterValues::hash(i * 3));
+  }
+  testSerde(BloomFilterValues(0, 297, bloomFilter, true));
+  testSerde(BloomFilterValues(0, 297, bloomFilter, false));
+}
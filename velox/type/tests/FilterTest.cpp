@@ -590,6 +590,32 @@ TEST(FilterTest, bigintMultiRange) {
   EXPECT_TRUE(filter->testInt64Range(105, 115, true));
   EXPECT_FALSE(filter->testInt64Range(15, 45, false));
   EXPECT_FALSE(filter->testInt64Range(15, 45, true));
+
+  auto testInt64 = [&](int64_t x) { return filter->testInt64(x); };
+  {
+    int64_t n4[] = {0, 1, 50, 120};
+    checkSimd(filter.get(), n4, testInt64);
+    int32_t n8[] = {-5, 10, 11, 99, 100, 121, 5, 110};
+    checkSimd(filter.get(), n8, testInt64);
+  }
+
+  // A number of ranges that is not a power of 2.
+  std::vector<std::unique_ptr<BigintRange>> ranges;
+  for (auto i = 0; i < 7; ++i) {
+    ranges.push_back(
+        std::make_unique<BigintRange>(i * 100, i * 100 + 10, false));
+  }
+  filter = std::make_unique<BigintMultiRange>(std::move(ranges), false);
+  for (int64_t base = -100; base < 800; base += 4) {
+    int64_t n4[] = {base, base + 1, base + 5, base + 3};
+    checkSimd(filter.get(), n4, testInt64);
+  }
+  int64_t extremes[] = {
+      std::numeric_limits<int64_t>::min(),
+      std::numeric_limits<int64_t>::max(),
+      610,
+      611};
+  checkSimd(filter.get(), extremes, testInt64);
 }
 
 TEST(FilterTest, boolValue) {
@@ -935,6 +961,25 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testLength(5));
   EXPECT_FALSE(filter->testLength(125));
 
+  {
+    // Values that share prefixes and lengths and values longer than 64 bytes.
+    const std::string longValue(100, 'x');
+    auto prefixes =
+        in(std::vector<std::string>{"abcd1", "abcd2", "ab", "", longValue});
+    EXPECT_TRUE(prefixes->testBytes("abcd1", 5));
+    EXPECT_TRUE(prefixes->testBytes("abcd2", 5));
+    EXPECT_TRUE(prefixes->testBytes("ab", 2));
+    EXPECT_TRUE(prefixes->testBytes("", 0));
+    EXPECT_TRUE(prefixes->testBytes(longValue.data(), 100));
+    EXPECT_TRUE(prefixes->testLength(100));
+    EXPECT_FALSE(prefixes->testLength(99));
+    EXPECT_FALSE(prefixes->testBytes("abcd3", 5));
+    EXPECT_FALSE(prefixes->testBytes("abc", 3));
+    EXPECT_FALSE(prefixes->testBytes(longValue.data(), 99));
+    EXPECT_FALSE(prefixes->clone(true)->testBytes("abcd3", 5));
+    EXPECT_TRUE(prefixes->clone(true)->testBytes("abcd2", 5));
+  }
+
   EXPECT_TRUE(filter->testBytesRange("natura", "naturel", false));
   EXPECT_TRUE(filter->testBytesRange("igloo", "ocean", false));
   EXPECT_FALSE(filter->testBytesRange("igloo", "igloo", false));
@@ -1878,3 +1923,92 @@ TEST(FilterTest, timestampRange) {
   EXPECT_TRUE(filter->testTimestampRange(
       Timestamp(5, 123000000), Timestamp(30, 123000000), true));
 }
+
+TEST(FilterTest, bloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(BloomFilterValues::hash(i * 10));
+    bloomFilter->insert(BloomFilterValues::hash(std::to_string(i * 10)));
+  }
+  auto filter =
+      std::make_unique<BloomFilterValues>(0, 9'990, bloomFilter, false);
+  EXPECT_FALSE(filter->testNull());
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(filter->testInt64(i * 10));
+    const auto value = std::to_string(i * 10);
+    EXPECT_TRUE(filter->testBytes(value.data(), value.size()));
+  }
+  EXPECT_EQ(filter->numRejected(), 0);
+
+  // Values outside of the range are always rejected.
+  EXPECT_FALSE(filter->testInt64(-10));
+  EXPECT_FALSE(filter->testInt64(10'000));
+  EXPECT_EQ(filter->numRejected(), 2);
+
+  // Most of the values not in the Bloom filter are rejected.
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    numPassed += filter->testInt64(i * 10 + 5);
+  }
+  EXPECT_LT(numPassed, 50);
+  EXPECT_EQ(filter->numRejected(), 2 + 1'000 - numPassed);
+
+  EXPECT_TRUE(filter->testInt64Range(-100, 100, false));
+  EXPECT_TRUE(filter->testInt64Range(9'990, 9'990, false));
+  EXPECT_FALSE(filter->testInt64Range(10'000, 20'000, false));
+  EXPECT_FALSE(filter->testInt64Range(10'000, 20'000, true));
+  EXPECT_TRUE(filter->testBytesRange("10", "10", false));
+  EXPECT_TRUE(filter->testBytesRange("a", "b", false));
+
+  // Copies share the Bloom filter and count their own rejected values.
+  auto copy = filter->clone(true);
+  EXPECT_TRUE(copy->testNull());
+  EXPECT_TRUE(copy->testInt64Range(10'000, 20'000, true));
+  EXPECT_FALSE(copy->testInt64(-10));
+  EXPECT_EQ(static_cast<BloomFilterValues*>(copy.get())->numRejected(), 1);
+  EXPECT_EQ(filter->numRejected(), 2 + 1'000 - numPassed);
+}
+
+TEST(FilterTest, mergeWithBloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bloomFilter->insert(BloomFilterValues::hash(i * 10));
+    bloomFilter->insert(BloomFilterValues::hash(std::to_string(i * 10)));
+  }
+  BloomFilterValues filter(0, 990, bloomFilter, true);
+
+  auto merged = filter.mergeWith(between(500, 2'000).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_FALSE(merged->testNull());
+  EXPECT_FALSE(merged->testInt64(490));
+  EXPECT_TRUE(merged->testInt64(500));
+  EXPECT_TRUE(merged->testInt64(990));
+
+  merged = filter.mergeWith(between(1'000, 2'000).get());
+  EXPECT_EQ(merged->kind(), FilterKind::kAlwaysFalse);
+
+  merged = filter.mergeWith(in({10, 20, 1'000}).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBitmask);
+  EXPECT_TRUE(merged->testInt64(10));
+  EXPECT_TRUE(merged->testInt64(20));
+  EXPECT_FALSE(merged->testInt64(1'000));
+
+  merged = filter.mergeWith(in({"10", "990"}).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBytesValues);
+  EXPECT_TRUE(merged->testBytes("10", 2));
+  EXPECT_TRUE(merged->testBytes("990", 3));
+
+  merged = filter.mergeWith(isNotNull().get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_FALSE(merged->testNull());
+
+  merged = filter.mergeWith(isNull().get());
+  EXPECT_EQ(merged->kind(), FilterKind::kIsNull);
+
+  // The Bloom filter is dropped if it can't be merged with the other filter.
+  merged = filter.mergeWith(lessThan("abc").get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBytesRange);
+  EXPECT_FALSE(merged->testNull());
+}
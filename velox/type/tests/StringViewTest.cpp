@@ -58,6 +58,24 @@ TEST(StringView, comparison) {
       StringView("in hoc signo vinces, Constantinus"));
 }
 
+TEST(StringView, compareInlinePart) {
+  auto inlinePart = [](const char* left, const char* right) {
+    return StringView(left).compareInlinePart(StringView(right));
+  };
+  // Decided on the prefix, the size or the inlined part.
+  EXPECT_LT(inlinePart(" ab", "ab").value(), 0);
+  EXPECT_LT(inlinePart("ab", "abc").value(), 0);
+  EXPECT_GT(inlinePart("In hoc signo", "In hoc signO").value(), 0);
+  EXPECT_EQ(inlinePart("In hoc signo", "In hoc signo").value(), 0);
+  EXPECT_GT(
+      inlinePart("in hoc signo vinces", "In hoc signo vinces").value(), 0);
+
+  // Out of line strings with the same prefix need the out of line data.
+  EXPECT_FALSE(inlinePart("In hoc signo vinces", "In hoc signo").has_value());
+  EXPECT_FALSE(
+      inlinePart("In hoc signo vinces", "In hoc signo Vinces").has_value());
+}
+
 TEST(StringView, container) {
   std::vector<std::string> strings = {
       "May",
@@ -246,6 +246,31 @@ TEST(DateTimeUtilTest, fromTimestampString) {
       fromTimestampString("2020-04-23 04:23:37+09:00"));
 }
 
+TEST(DateTimeUtilTest, fromTimestampStringFraction) {
+  EXPECT_EQ(
+      Timestamp(946729316, 100'000'000),
+      fromTimestampString("2000-01-01 12:21:56.1"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'000'000),
+      fromTimestampString("2000-01-01 12:21:56.123"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'456'000),
+      fromTimestampString("2000-01-01T12:21:56.123456"));
+  // Digits after the microseconds are ignored.
+  EXPECT_EQ(
+      Timestamp(946729316, 123'456'000),
+      fromTimestampString("2000-01-01 12:21:56.1234567"));
+  EXPECT_EQ(
+      Timestamp(946729316, 0), fromTimestampString("2000-01-01 12:21:56."));
+  EXPECT_EQ(
+      Timestamp(946729320, 500'000'000),
+      fromTimestampString("2000-01-01 12:21:60.5"));
+
+  EXPECT_THROW(fromTimestampString("2000-02-30 12:21:56"), VeloxUserError);
+  EXPECT_THROW(fromTimestampString("2000-01-01 24:21:56"), VeloxUserError);
+  EXPECT_THROW(fromTimestampString("2000-01-01 12:21:56.1a"), VeloxUserError);
+}
+
 TEST(DateTimeUtilTest, fromTimestampStrInvalid) {
   // Needs at least a date.
   EXPECT_THROW(fromTimestampString(""), VeloxUserError);
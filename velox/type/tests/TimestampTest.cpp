@@ -128,6 +128,35 @@ TEST(TimestampTest, arithmeticOverflow) {
   ASSERT_NO_THROW(Timestamp::maxMillis().toMillis());
 }
 
+TEST(TimestampTest, tryToNanos) {
+  int64_t nanos;
+  ASSERT_TRUE(Timestamp(1, 2).tryToNanos(nanos));
+  ASSERT_EQ(nanos, 1'000'000'002);
+  ASSERT_TRUE(Timestamp(-1, 999'999'999).tryToNanos(nanos));
+  ASSERT_EQ(nanos, -1);
+  Timestamp max(Timestamp::kMaxSeconds, Timestamp::kMaxNanos);
+  ASSERT_FALSE(max.tryToNanos(nanos));
+  ASSERT_FALSE(Timestamp(Timestamp::kMinSeconds, 0).tryToNanos(nanos));
+}
+
+TEST(TimestampTest, compare) {
+  const std::vector<Timestamp> timestamps = {
+      Timestamp(Timestamp::kMinSeconds, 0),
+      Timestamp(-1, 0),
+      Timestamp(-1, Timestamp::kMaxNanos),
+      Timestamp(0, 0),
+      Timestamp(0, 1),
+      Timestamp(1, 0),
+      Timestamp(Timestamp::kMaxSeconds, Timestamp::kMaxNanos)};
+  for (const auto& left : timestamps) {
+    for (const auto& right : timestamps) {
+      const auto expected = left < right ? -1 : (left == right ? 0 : 1);
+      ASSERT_EQ(Timestamp::compare(left, right), expected)
+          << left.toString() << " vs " << right.toString();
+    }
+  }
+}
+
 TEST(TimestampTest, toAppend) {
   std::string tsStringZeroValue;
   toAppend(Timestamp(0, 0), &tsStringZeroValue);
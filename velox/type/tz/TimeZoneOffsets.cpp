@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/type/tz/TimeZoneOffsets.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <algorithm>
+#include <atomic>
+#include "velox/common/base/Exceptions.h"
+#include "velox/external/date/tz.h"
+#include "velox/type/tz/TimeZoneMap.h"
+
+namespace facebook::velox::util {
+
+// Defined on TimeZoneDatabase.cpp
+extern const std::unordered_map<int64_t, std::string>& getTimeZoneDB();
+
+namespace {
+
+using Slot = std::atomic<const TimeZoneOffsets*>;
+
+// The tables of the zones of the tz database are found by the position of
+// the zone in the database, the others by address.
+struct Registry {
+  Registry()
+      : zones(date::get_tzdb().zones.data()),
+        numZones(date::get_tzdb().zones.size()),
+        byZone(new Slot[numZones]) {
+    for (const auto& [id, name] : getTimeZoneDB()) {
+      maxTimeZoneID = std::max(maxTimeZoneID, id);
+    }
+    byID.reset(new Slot[maxTimeZoneID + 1]);
+    for (auto i = 0; i < numZones; ++i) {
+      byZone[i] = nullptr;
+    }
+    for (auto i = 0; i <= maxTimeZoneID; ++i) {
+      byID[i] = nullptr;
+    }
+  }
+
+  // Returns the slot for 'zone' or nullptr if 'zone' is not in 'zones'.
+  Slot* slot(const date::time_zone* zone) {
+    const auto address = reinterpret_cast<uintptr_t>(zone);
+    const auto begin = reinterpret_cast<uintptr_t>(zones);
+    if (address < begin || address >= begin + numZones * sizeof(*zone)) {
+      return nullptr;
+    }
+    return &byZone[zone - zones];
+  }
+
+  const date::time_zone* const zones;
+  const size_t numZones;
+  std::unique_ptr<Slot[]> byZone;
+  int64_t maxTimeZoneID{0};
+  std::unique_ptr<Slot[]> byID;
+  folly::Synchronized<folly::F14FastMap<
+      const date::time_zone*,
+      std::unique_ptr<const TimeZoneOffsets>>>
+      others;
+};
+
+Registry& registry() {
+  static Registry* instance = new Registry();
+  return *instance;
+}
+
+} // namespace
+
+// static
+const TimeZoneOffsets& TimeZoneOffsets::get(const date::time_zone& zone) {
+  auto& zones = registry();
+  auto* slot = zones.slot(&zone);
+  if (slot == nullptr) {
+    return *zones.others.withWLock([&](auto& others) {
+      auto& offsets = others[&zone];
+      if (offsets == nullptr) {
+        offsets.reset(new TimeZoneOffsets(&zone));
+      }
+      return offsets.get();
+    });
+  }
+  const auto* offsets = slot->load(std::memory_order_acquire);
+  if (offsets != nullptr) {
+    return *offsets;
+  }
+  auto* made = new TimeZoneOffsets(&zone);
+  if (slot->compare_exchange_strong(offsets, made)) {
+    return *made;
+  }
+  // Another thread made the table first.
+  delete made;
+  return *offsets;
+}
+
+// static
+const TimeZoneOffsets& TimeZoneOffsets::get(int64_t timeZoneID) {
+  auto& zones = registry();
+  if (timeZoneID < 0 || timeZoneID > zones.maxTimeZoneID) {
+    return get(*date::locate_zone(getTimeZoneName(timeZoneID)));
+  }
+  auto& slot = zones.byID[timeZoneID];
+  const auto* offsets = slot.load(std::memory_order_acquire);
+  if (offsets == nullptr) {
+    offsets = &get(*date::locate_zone(getTimeZoneName(timeZoneID)));
+    slot.store(offsets, std::memory_order_release);
+  }
+  return *offsets;
+}
+
+TimeZoneOffsets::TimeZoneOffsets(const date::time_zone* zone) : zone_(zone) {
+  auto info = zone_->get_info(
+      date::sys_seconds(std::chrono::seconds(kMinSeconds)));
+  offsets_.push_back(info.offset.count());
+  while (info.end.time_since_epoch().count() < kMaxSeconds) {
+    const int64_t transition = info.end.time_since_epoch().count();
+    info = zone_->get_info(info.end);
+    const int64_t previous = offsets_.back();
+    const int64_t offset = info.offset.count();
+    if (offset == previous) {
+      // Only the abbreviation or the daylight saving flag changes.
+      continue;
+    }
+    transitions_.push_back(transition);
+    offsets_.push_back(offset);
+    localBegins_.push_back(transition + std::min(previous, offset));
+    localEnds_.push_back(transition + std::max(previous, offset));
+  }
+}
+
+int32_t TimeZoneOffsets::utcInterval(int64_t utcSeconds) const {
+  return std::upper_bound(
+             transitions_.begin(), transitions_.end(), utcSeconds) -
+      transitions_.begin();
+}
+
+int32_t TimeZoneOffsets::localInterval(int64_t localSeconds) const {
+  const int32_t index =
+      std::upper_bound(localBegins_.begin(), localBegins_.end(), localSeconds) -
+      localBegins_.begin();
+  if (index > 0 && localSeconds < localEnds_[index - 1]) {
+    return -1;
+  }
+  return index;
+}
+
+int64_t TimeZoneOffsets::toLocal(int64_t utcSeconds) const {
+  if (inRange(utcSeconds)) {
+    return utcSeconds + offsets_[utcInterval(utcSeconds)];
+  }
+  return zone_->to_local(date::sys_seconds(std::chrono::seconds(utcSeconds)))
+      .time_since_epoch()
+      .count();
+}
+
+int64_t TimeZoneOffsets::toUtc(int64_t localSeconds) const {
+  if (inRange(localSeconds)) {
+    const auto index = localInterval(localSeconds);
+    if (index >= 0) {
+      return localSeconds - offsets_[index];
+    }
+  }
+  return toUtcSlow(localSeconds);
+}
+
+int64_t TimeZoneOffsets::toUtcSlow(int64_t localSeconds) const {
+  date::local_seconds localTime{std::chrono::seconds(localSeconds)};
+  date::sys_seconds sysTime;
+  try {
+    sysTime = zone_->to_sys(localTime);
+  } catch (const date::ambiguous_local_time&) {
+    // If the time is ambiguous, pick the earlier possibility to be consistent
+    // with Presto.
+    sysTime = zone_->to_sys(localTime, date::choose::earliest);
+  } catch (const date::nonexistent_local_time& error) {
+    // If the time does not exist, fail the conversion.
+    VELOX_USER_FAIL(error.what());
+  }
+  return sysTime.time_since_epoch().count();
+}
+
+void TimeZoneOffsets::toLocal(
+    const int64_t* utcSeconds,
+    int32_t size,
+    int64_t* localSeconds) const {
+  // The interval of the previous time. Starts empty.
+  int64_t begin = 0;
+  int64_t end = 0;
+  int64_t offset = 0;
+  for (auto i = 0; i < size; ++i) {
+    const auto seconds = utcSeconds[i];
+    if (seconds >= begin && seconds < end) {
+      localSeconds[i] = seconds + offset;
+      continue;
+    }
+    if (!inRange(seconds)) {
+      localSeconds[i] = toLocal(seconds);
+      continue;
+    }
+    const auto index = utcInterval(seconds);
+    begin = index == 0 ? kMinSeconds : transitions_[index - 1];
+    end = index == transitions_.size() ? kMaxSeconds : transitions_[index];
+    offset = offsets_[index];
+    localSeconds[i] = seconds + offset;
+  }
+}
+
+void TimeZoneOffsets::toUtc(
+    const int64_t* localSeconds,
+    int32_t size,
+    int64_t* utcSeconds) const {
+  int64_t begin = 0;
+  int64_t end = 0;
+  int64_t offset = 0;
+  for (auto i = 0; i < size; ++i) {
+    const auto seconds = localSeconds[i];
+    if (seconds >= begin && seconds < end) {
+      utcSeconds[i] = seconds - offset;
+      continue;
+    }
+    const auto index = inRange(seconds) ? localInterval(seconds) : -1;
+    if (index < 0) {
+      utcSeconds[i] = toUtcSlow(seconds);
+      continue;
+    }
+    begin = index == 0 ? kMinSeconds : localEnds_[index - 1];
+    end = index == localBegins_.size() ? kMaxSeconds : localBegins_[index];
+    offset = offsets_[index];
+    utcSeconds[i] = seconds - offset;
+  }
+}
+
+} // namespace facebook::velox::util
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace date {
+class time_zone;
+} // namespace date
+
+namespace facebook::velox::util {
+
+/// Precomputed UTC offsets of a time zone between kMinSeconds and kMaxSeconds.
+/// Converting a time in this range is a binary search over the transitions
+/// of the zone without the allocations and the range checks of
+/// date::time_zone. Times outside of the range are converted by
+/// date::time_zone. The tables are built on first use and kept for the life
+/// of the process.
+class TimeZoneOffsets {
+ public:
+  /// 1900-01-01 00:00:00 UTC.
+  static constexpr int64_t kMinSeconds = -2'208'988'800;
+  /// 2100-01-01 00:00:00 UTC.
+  static constexpr int64_t kMaxSeconds = 4'102'444'800;
+
+  /// Returns the offsets of 'zone'.
+  static const TimeZoneOffsets& get(const date::time_zone& zone);
+
+  /// Returns the offsets of the zone with 'timeZoneID' from TimeZoneMap.h.
+  /// Throws if the zone can't be found.
+  static const TimeZoneOffsets& get(int64_t timeZoneID);
+
+  const date::time_zone& zone() const {
+    return *zone_;
+  }
+
+  /// Returns the local time at 'zone()' for 'utcSeconds' since the epoch.
+  int64_t toLocal(int64_t utcSeconds) const;
+
+  /// Returns the UTC time for the local time 'localSeconds' at 'zone()'. An
+  /// ambiguous local time is resolved to the earlier UTC time. Throws a user
+  /// error if the local time does not exist.
+  int64_t toUtc(int64_t localSeconds) const;
+
+  /// Converts 'size' UTC times from 'utcSeconds' to local times in
+  /// 'localSeconds'. The arrays may be the same. Consecutive times in the
+  /// same interval of the zone are converted without a search.
+  void toLocal(const int64_t* utcSeconds, int32_t size, int64_t* localSeconds)
+      const;
+
+  /// Converts 'size' local times from 'localSeconds' to UTC times in
+  /// 'utcSeconds' like toUtc(). The arrays may be the same.
+  void toUtc(const int64_t* localSeconds, int32_t size, int64_t* utcSeconds)
+      const;
+
+  /// Number of transitions between kMinSeconds and kMaxSeconds.
+  int32_t numTransitions() const {
+    return transitions_.size();
+  }
+
+ private:
+  explicit TimeZoneOffsets(const date::time_zone* zone);
+
+  static bool inRange(int64_t seconds) {
+    return seconds >= kMinSeconds && seconds < kMaxSeconds;
+  }
+
+  // Returns the index in 'offsets_' of the interval of 'utcSeconds'.
+  int32_t utcInterval(int64_t utcSeconds) const;
+
+  // Returns the index in 'offsets_' of the interval of 'localSeconds' or -1
+  // if the local time is ambiguous or does not exist.
+  int32_t localInterval(int64_t localSeconds) const;
+
+  // Converts 'localSeconds' with 'zone_'.
+  int64_t toUtcSlow(int64_t localSeconds) const;
+
+  const date::time_zone* const zone_;
+
+  // UTC times of the transitions in ascending order.
+  std::vector<int64_t> transitions_;
+
+  // Offset in seconds before the first transition and after each
+  // transition. Has one more element than 'transitions_'.
+  std::vector<int64_t> offsets_;
+
+  // Local times where each transition starts and ends being ambiguous or
+  // nonexistent, i.e. the transition time plus the smaller and the larger of
+  // the offsets before and after it.
+  std::vector<int64_t> localBegins_;
+  std::vector<int64_t> localEnds_;
+};
+
+} // namespace facebook::velox::util
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/external/date/tz.h"
+#include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneOffsets.h"
+
+namespace facebook::velox::util {
+namespace {
+
+int64_t expectedLocal(const date::time_zone& zone, int64_t utcSeconds) {
+  return zone.to_local(date::sys_seconds(std::chrono::seconds(utcSeconds)))
+      .time_since_epoch()
+      .count();
+}
+
+TEST(TimeZoneOffsetsTest, toLocal) {
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/Moscow",
+        "America/Sao_Paulo",
+        "Australia/Lord_Howe",
+        "Asia/Kolkata",
+        "UTC"}) {
+    SCOPED_TRACE(name);
+    const auto& zone = *date::locate_zone(name);
+    const auto& offsets = TimeZoneOffsets::get(zone);
+    ASSERT_EQ(&offsets, &TimeZoneOffsets::get(zone));
+    ASSERT_EQ(&offsets.zone(), &zone);
+    // Steps of a prime number of seconds hit all times of day.
+    for (int64_t seconds = TimeZoneOffsets::kMinSeconds - 1'000'000;
+         seconds < TimeZoneOffsets::kMaxSeconds + 1'000'000;
+         seconds += 86'413) {
+      ASSERT_EQ(offsets.toLocal(seconds), expectedLocal(zone, seconds))
+          << seconds;
+    }
+  }
+}
+
+TEST(TimeZoneOffsetsTest, toUtc) {
+  const auto& zone = *date::locate_zone("America/Los_Angeles");
+  const auto& offsets = TimeZoneOffsets::get(zone);
+  ASSERT_GT(offsets.numTransitions(), 100);
+  for (int64_t seconds = TimeZoneOffsets::kMinSeconds;
+       seconds < TimeZoneOffsets::kMaxSeconds;
+       seconds += 86'413) {
+    // Times that exist once convert back to the same UTC time.
+    const auto local = expectedLocal(zone, seconds);
+    const auto info =
+        zone.get_info(date::local_seconds(std::chrono::seconds(local)));
+    if (info.result == date::local_info::unique) {
+      ASSERT_EQ(offsets.toUtc(local), seconds) << seconds;
+    }
+  }
+
+  // 2019-11-03 01:00:00 is ambiguous and resolves to the earlier UTC time,
+  // 2019-11-03 08:00:00.
+  ASSERT_EQ(offsets.toUtc(1'572'742'800), 1'572'768'000);
+  // 2019-03-10 02:00:00 does not exist.
+  VELOX_ASSERT_THROW(offsets.toUtc(1'552'183'200), "");
+}
+
+TEST(TimeZoneOffsetsTest, batch) {
+  const auto& offsets = TimeZoneOffsets::get(getTimeZoneID("Europe/Berlin"));
+  ASSERT_EQ(offsets.zone().name(), "Europe/Berlin");
+  std::vector<int64_t> utc;
+  // Mostly increasing times with a few out of the range of the table.
+  for (int64_t seconds = 1'500'000'000; seconds < 1'700'000'000;
+       seconds += 3'607) {
+    utc.push_back(seconds);
+  }
+  utc.push_back(TimeZoneOffsets::kMaxSeconds + 10);
+  utc.push_back(1'600'000'000);
+  utc.push_back(TimeZoneOffsets::kMinSeconds - 10);
+
+  std::vector<int64_t> local(utc.size());
+  offsets.toLocal(utc.data(), utc.size(), local.data());
+  for (auto i = 0; i < utc.size(); ++i) {
+    ASSERT_EQ(local[i], expectedLocal(offsets.zone(), utc[i])) << i;
+  }
+
+  // Converts back in place, leaving out the ambiguous local times.
+  std::vector<int64_t> expected;
+  std::vector<int64_t> values;
+  for (auto i = 0; i < utc.size(); ++i) {
+    const auto info = offsets.zone().get_info(
+        date::local_seconds(std::chrono::seconds(local[i])));
+    if (info.result == date::local_info::unique) {
+      expected.push_back(utc[i]);
+      values.push_back(local[i]);
+    }
+  }
+  offsets.toUtc(values.data(), values.size(), values.data());
+  ASSERT_EQ(values, expected);
+}
+
+} // namespace
+} // namespace facebook::velox::util
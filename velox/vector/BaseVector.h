@@ -816,6 +816,18 @@ class BaseVector {
     memoDisabled_ = true;
   }
 
+  bool memoOnFirstUse() const {
+    return memoOnFirstUse_;
+  }
+
+  /// Marks 'this' as the values of dictionaries that are produced for many
+  /// batches, e.g. a stripe dictionary of a string column. Expressions over
+  /// such dictionaries cache their results for the referenced values the
+  /// first time they see 'this' instead of waiting for it to repeat.
+  void enableMemoOnFirstUse() {
+    memoOnFirstUse_ = true;
+  }
+
   /// Used to check internal state of a vector like sizes of the buffers,
   /// enclosed child vectors, values in indices. Currently, its only used in
   /// debug builds to check the result of expressions and some interim results.
@@ -942,6 +954,10 @@ class BaseVector {
   // values are not going to be reused (e.g. result of filtering), so that we
   // don't need to reallocate the result for every batch.
   bool memoDisabled_{false};
+
+  // Whether Expr::evalWithMemo caches the results for this vector the first
+  // time it is seen as dictionary values.
+  bool memoOnFirstUse_{false};
 };
 
 /// Loops over rows in 'ranges' and invokes 'func' for each row.
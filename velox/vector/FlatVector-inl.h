@@ -144,18 +144,20 @@ void FlatVector<T>::copyValuesAndNulls(
   VELOX_CHECK_GE(BaseVector::length_, rows.end());
   if (!toSourceRow) {
     VELOX_CHECK_GE(source->size(), rows.end());
+    if (rows.begin() == 0 && rows.end() == BaseVector::length_ &&
+        rows.isAllSelected() && shareValuesAndNulls(source)) {
+      return;
+    }
   }
   const uint64_t* sourceNulls = source->rawNulls();
   uint64_t* rawNulls = const_cast<uint64_t*>(BaseVector::rawNulls_);
-  if (source->mayHaveNulls()) {
+  if (BaseVector::nulls_ || source->mayHaveNulls()) {
     rawNulls = BaseVector::mutableRawNulls();
   }
 
-  // Allocate values buffer if not allocated yet. This may happen if vector
-  // contains only null values.
-  if (!values_) {
-    mutableRawValues();
-  }
+  // Allocate values buffer if not allocated yet or copy it if it is shared.
+  // The buffer is not allocated if vector contains only null values.
+  mutableRawValues();
 
   if (source->isFlatEncoding()) {
     auto* flatSource = source->asUnchecked<FlatVector<T>>();
@@ -264,6 +266,22 @@ void FlatVector<T>::copyValuesAndNulls(
   }
 }
 
+template <typename T>
+bool FlatVector<T>::shareValuesAndNulls(const BaseVector* source) {
+  if (!source->isFlatEncoding() || source->size() != BaseVector::length_ ||
+      source->pool() != BaseVector::pool_) {
+    return false;
+  }
+  auto* flatSource = source->asUnchecked<FlatVector<T>>();
+  if (flatSource->values() == nullptr) {
+    return false;
+  }
+  values_ = flatSource->values();
+  rawValues_ = const_cast<T*>(flatSource->rawValues());
+  BaseVector::setNulls(flatSource->nulls());
+  return true;
+}
+
 template <typename T>
 void FlatVector<T>::copyRanges(
     const BaseVector* source,
@@ -295,17 +313,21 @@ void FlatVector<T>::copyRanges(
     acquireSharedStringBuffers(source);
   }
 
+  if (ranges.size() == 1 && ranges[0].sourceIndex == 0 &&
+      ranges[0].targetIndex == 0 && ranges[0].count == BaseVector::length_ &&
+      shareValuesAndNulls(source)) {
+    return;
+  }
+
   const uint64_t* sourceRawNulls = source->rawNulls();
   uint64_t* rawNulls = const_cast<uint64_t*>(BaseVector::rawNulls_);
-  if (source->mayHaveNulls()) {
+  if (BaseVector::nulls_ || source->mayHaveNulls()) {
     rawNulls = BaseVector::mutableRawNulls();
   }
 
-  // Allocate values buffer if not allocated yet. This may happen if vector
-  // contains only null values.
-  if (!values_) {
-    mutableRawValues();
-  }
+  // Allocate values buffer if not allocated yet or copy it if it is shared.
+  // The buffer is not allocated if vector contains only null values.
+  mutableRawValues();
 
   if (source->isFlatEncoding()) {
     auto* flatSource = source->asUnchecked<FlatVector<T>>();
@@ -501,9 +523,8 @@ template <typename T>
 void FlatVector<T>::resizeValues(
     vector_size_t newSize,
     const std::optional<T>& initialValue) {
-  // TODO: change this to isMutable(). See
-  // https://github.com/facebookincubator/velox/issues/6562.
-  if (values_ && !values_->isView()) {
+  // Shared buffers are copied so that other vectors keep their values.
+  if (values_ && values_->isMutable()) {
     const uint64_t newByteSize = BaseVector::byteSize<T>(newSize);
     if (values_->capacity() < newByteSize) {
       AlignedBuffer::reallocate<T>(&values_, newSize, initialValue);
@@ -524,7 +545,7 @@ void FlatVector<T>::resizeValues(
       memcpy(dst, src, len);
     } else {
       const vector_size_t previousSize = BaseVector::length_;
-      auto* rawOldValues = newValues->asMutable<T>();
+      auto* rawOldValues = values_->as<T>();
       auto* rawNewValues = newValues->asMutable<T>();
       const auto len = std::min<vector_size_t>(newSize, previousSize);
       for (vector_size_t row = 0; row < len; ++row) {
@@ -540,9 +561,8 @@ template <>
 inline void FlatVector<bool>::resizeValues(
     vector_size_t newSize,
     const std::optional<bool>& initialValue) {
-  // TODO: change this to isMutable(). See
-  // https://github.com/facebookincubator/velox/issues/6562.
-  if (values_ && !values_->isView()) {
+  // Shared buffers are copied so that other vectors keep their values.
+  if (values_ && values_->isMutable()) {
     const uint64_t newByteSize = BaseVector::byteSize<bool>(newSize);
     if (values_->size() < newByteSize) {
       AlignedBuffer::reallocate<bool>(&values_, newSize, initialValue);
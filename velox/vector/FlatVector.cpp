@@ -281,9 +281,10 @@ void FlatVector<StringView>::copy(
   } else {
     DecodedVector decoded(*source);
     uint64_t* rawNulls = const_cast<uint64_t*>(BaseVector::rawNulls_);
-    if (decoded.mayHaveNulls()) {
+    if (BaseVector::nulls_ || decoded.mayHaveNulls()) {
       rawNulls = BaseVector::mutableRawNulls();
     }
+    mutableRawValues();
 
     size_t totalBytes = 0;
     rows.applyToSelected([&](vector_size_t row) {
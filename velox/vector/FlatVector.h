@@ -496,12 +496,20 @@ class FlatVector final : public SimpleVector<T> {
   }
 
  private:
+  // Allocates the values buffer if it is not allocated and copies it if it is
+  // shared with other vectors, so that writes do not change their values.
   void ensureValues() {
-    if (rawValues_ == nullptr) {
+    if (rawValues_ == nullptr || !values_->isMutable()) {
       mutableRawValues();
     }
   }
 
+  // Makes 'this' refer to the values and nulls buffers of 'source' instead of
+  // copying them if 'source' is flat and has the same size and pool. Writes
+  // to either vector copy the shared buffers first. Returns true if the
+  // buffers are shared.
+  bool shareValuesAndNulls(const BaseVector* source);
+
   void copyValuesAndNulls(
       const BaseVector* source,
       const SelectivityVector& rows,
@@ -358,6 +358,9 @@ class SimpleVector : public BaseVector {
         return -1;
       }
     }
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      return Timestamp::compare(left, right);
+    }
     return left < right ? -1 : left == right ? 0 : 1;
   }
 
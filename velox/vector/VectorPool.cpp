@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorPool.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox {
 
@@ -47,29 +48,70 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+bool isComplexType(const TypePtr& type) {
+  return type->kind() == TypeKind::ARRAY || type->kind() == TypeKind::MAP ||
+      type->kind() == TypeKind::ROW;
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    TypePool* typePool = nullptr;
+    auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0) {
+      typePool = &vectors_[cacheIndex];
+    } else if (isComplexType(type)) {
+      typePool = complexTypePool(type, false);
+    }
+    if (typePool != nullptr) {
+      if (auto vector = typePool->pop(size)) {
+        ++stats_.numHits;
+        return vector;
+      }
+    }
   }
+  ++stats_.numMisses;
   return BaseVector::create(type, size, pool_);
 }
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool add) {
+  for (auto& [poolType, typePool] : complexVectors_) {
+    if (poolType == type || *poolType == *type) {
+      return &typePool;
+    }
+  }
+  if (!add || complexVectors_.size() >= kMaxComplexTypes) {
+    return nullptr;
+  }
+  complexVectors_.emplace_back(type, TypePool{});
+  return &complexVectors_.back().second;
+}
+
 bool VectorPool::release(VectorPtr& vector) {
   if (FOLLY_UNLIKELY(vector == nullptr)) {
     return false;
   }
-  if (!vector.unique() || vector->size() > kMaxRecycleSize) {
+  // A vector from another pool might outlive that pool if kept here.
+  if (!vector.unique() || vector->size() > kMaxRecycleSize ||
+      vector->pool() != pool_) {
     return false;
   }
 
+  TypePool* typePool = nullptr;
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  if (cacheIndex >= 0) {
+    typePool = &vectors_[cacheIndex];
+  } else if (isComplexType(vector->type())) {
+    typePool = complexTypePool(vector->type(), true);
+  }
+  if (typePool == nullptr || !typePool->maybePushBack(vector)) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  ++stats_.numReleased;
+  return true;
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -86,8 +128,22 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer. An
+  // array, map or row vector must be recursively writable.
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (!vector->values()) {
+        return false;
+      }
+      break;
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+    case VectorEncoding::Simple::ROW:
+      break;
+    default:
+      return false;
+  }
+  if (!vector->isWritable()) {
     return false;
   }
   if (size >= kNumPerType) {
@@ -99,10 +155,7 @@ bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   return true;
 }
 
-VectorPtr VectorPool::TypePool::pop(
-    const TypePtr& type,
-    vector_size_t vectorSize,
-    memory::MemoryPool& pool) {
+VectorPtr VectorPool::TypePool::pop(vector_size_t vectorSize) {
   if (size) {
     auto result = std::move(vectors[--size]);
     if (UNLIKELY(result->rawNulls() != nullptr)) {
@@ -123,8 +176,17 @@ VectorPtr VectorPool::TypePool::pop(
     if (result->size() != vectorSize) {
       result->resize(vectorSize);
     }
+    if (UNLIKELY(result->typeKind() == TypeKind::ROW)) {
+      // The children are reset to size 0 on release. A new row vector has
+      // children of its size.
+      for (auto& child : result->asUnchecked<RowVector>()->children()) {
+        if (child != nullptr && child->size() != vectorSize) {
+          child->resize(vectorSize);
+        }
+      }
+    }
     return result;
   }
-  return BaseVector::create(type, vectorSize, &pool);
+  return nullptr;
 }
 } // namespace facebook::velox
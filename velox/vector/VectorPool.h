@@ -20,15 +20,29 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
+/// A thread-level cache of pre-allocated vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// recyclable if it is flat, array, map or row, recursively
+/// singly-referenced and allocated from 'pool_'. Singleton built-in scalar
+/// types and up to 16 distinct array, map and row types are supported.
+/// Decimal types, fixed-size array type and custom scalar types are not
+/// supported. Calling 'get' for an unsupported type already returns a newly
+/// allocated vector. Calling 'release' for an unsupported type is a no-op.
+/// Recycled string vectors keep one of their string buffers for the values
+/// written after recycling.
 class VectorPool {
  public:
+  struct Stats {
+    /// Number of calls to 'get' that returned a recycled vector.
+    uint64_t numHits{0};
+
+    /// Number of calls to 'get' that allocated a new vector.
+    uint64_t numMisses{0};
+
+    /// Number of vectors moved into 'this' by 'release'.
+    uint64_t numReleased{0};
+  };
+
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
@@ -42,11 +56,16 @@ class VectorPool {
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  const Stats& stats() const {
+    return stats_;
+  }
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  static constexpr int32_t kMaxComplexTypes = 16;
 
   struct TypePool {
     int32_t size{0};
@@ -54,12 +73,14 @@ class VectorPool {
 
     bool maybePushBack(VectorPtr& vector);
 
-    VectorPtr pop(
-        const TypePtr& type,
-        vector_size_t vectorSize,
-        memory::MemoryPool& pool);
+    // Returns a recycled vector of 'vectorSize' or nullptr if there is none.
+    VectorPtr pop(vector_size_t vectorSize);
   };
 
+  // Returns the cache for array, map or row 'type'. Adds the cache if there
+  // is space and 'add' is true. Returns nullptr otherwise.
+  TypePool* complexTypePool(const TypePtr& type, bool add);
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +88,11 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated array, map and row vectors by type.
+  std::vector<std::pair<TypePtr, TypePool>> complexVectors_;
+
+  Stats stats_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -169,6 +169,43 @@ void VectorStreamGroup::flush(OutputStream* out) {
   serializer_->flush(out);
 }
 
+void VectorStreamGroup::clear() {
+  StreamArena::clear();
+  serializer_->clear();
+}
+
+std::unordered_map<std::string, RuntimeCounter>
+VectorStreamGroup::runtimeStats() {
+  return serializer_->runtimeStats();
+}
+
+// static
+void VectorStreamGroup::scatter(
+    const RowVectorPtr& vector,
+    const uint32_t* destinations,
+    folly::Range<VectorStreamGroup* const*> groups,
+    Scratch& scratch) {
+  VectorSerde* serde = nullptr;
+  std::vector<IterativeVectorSerializer*> serializers(groups.size());
+  for (auto i = 0; i < groups.size(); ++i) {
+    if (groups[i] == nullptr) {
+      continue;
+    }
+    VELOX_CHECK(serde == nullptr || serde == groups[i]->serde_);
+    serde = groups[i]->serde_;
+    serializers[i] = groups[i]->serializer_.get();
+  }
+  if (serde == nullptr) {
+    return;
+  }
+  serde->scatter(
+      vector,
+      destinations,
+      folly::Range<IterativeVectorSerializer* const*>(
+          serializers.data(), serializers.size()),
+      scratch);
+}
+
 // static
 void VectorStreamGroup::estimateSerializedSize(
     VectorPtr vector,
@@ -17,6 +17,7 @@
 
 #include <folly/Range.h>
 #include "velox/buffer/Buffer.h"
+#include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/Scratch.h"
 #include "velox/common/memory/ByteStream.h"
 #include "velox/common/memory/Memory.h"
@@ -86,6 +87,18 @@ class IterativeVectorSerializer {
 
   /// Write serialized data to 'stream'.
   virtual void flush(OutputStream* stream) = 0;
+
+  /// Resets 'this' to the state after construction so that it can be reused
+  /// for the next batch of rows. The arena must have been cleared.
+  virtual void clear() {
+    VELOX_UNSUPPORTED();
+  }
+
+  /// Returns serializer-specific counters accumulated over all the flushes,
+  /// e.g. the compressed and uncompressed sizes of the pages.
+  virtual std::unordered_map<std::string, RuntimeCounter> runtimeStats() {
+    return {};
+  }
 };
 
 /// Serializer that writes a subset of rows from a single RowVector to the
@@ -177,6 +190,25 @@ class VectorSerde {
       StreamArena* streamArena,
       const Options* options = nullptr) = 0;
 
+  /// Returns true if implements 'scatter'.
+  virtual bool supportsScatter() const {
+    return false;
+  }
+
+  /// Appends each row of 'vector' to one of 'serializers'. Row 'i' is
+  /// appended to 'serializers[destinations[i]]'. The serializers must have been
+  /// created by 'this' for the type of 'vector'. A serializer may be nullptr if
+  /// no row goes to it. This decodes each column once for all the
+  /// destinations, which is faster than an append() per serializer when there
+  /// are many serializers and few rows go to each.
+  virtual void scatter(
+      const RowVectorPtr& vector,
+      const uint32_t* destinations,
+      folly::Range<IterativeVectorSerializer* const*> serializers,
+      Scratch& scratch) {
+    VELOX_UNSUPPORTED();
+  }
+
   /// Creates a Vector Serializer that writes a subset of rows from a single
   /// RowVector to the OutputStream via a single serialize API.
   ///
@@ -298,9 +330,32 @@ class VectorStreamGroup : public StreamArena {
 
   void append(const RowVectorPtr& vector);
 
+  /// True if scatter() can be used with 'this'. createStreamTree() must have
+  /// been called.
+  bool supportsScatter() const {
+    return serde_->supportsScatter();
+  }
+
+  /// Appends row 'i' of 'vector' to 'groups[destinations[i]]'. 'groups' that
+  /// get rows must have stream trees for the type of 'vector' made with the
+  /// same serde. See VectorSerde::scatter().
+  static void scatter(
+      const RowVectorPtr& vector,
+      const uint32_t* destinations,
+      folly::Range<VectorStreamGroup* const*> groups,
+      Scratch& scratch);
+
   // Writes the contents to 'stream' in wire format.
   void flush(OutputStream* stream);
 
+  /// Frees the memory and resets the stream tree so that 'this' can be reused
+  /// for the next batch of rows without creating the stream tree again.
+  void clear();
+
+  /// Returns the counters of the serializer. See
+  /// IterativeVectorSerializer::runtimeStats().
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats();
+
   // Reads data in wire format. Returns the RowVector in 'result'.
   static void read(
       ByteInputStream* source,
@@ -16,6 +16,9 @@
 
 #include "velox/vector/arrow/Bridge.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CheckedArithmetic.h"
@@ -31,17 +34,38 @@ namespace facebook::velox {
 namespace {
 
 // The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// and one for offsets (2). String views use a variable number of buffers, see
+// VeloxToArrowBridgeHolder::resizeBuffers().
 static constexpr size_t kMaxBuffers{3};
 
+// Layout of a value of Arrow Utf8View and BinaryView. Values of up to 12
+// bytes are inlined after 'size' the same way as in StringView. Longer values
+// are at 'offset' in the data buffer at 'bufferIndex'.
+struct ArrowStringView {
+  int32_t size;
+  char prefix[4];
+  int32_t bufferIndex;
+  int32_t offset;
+
+  const char* inlined() const {
+    return prefix;
+  }
+};
+
+static_assert(sizeof(ArrowStringView) == sizeof(StringView));
+
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers, nullptr), bufferPtrs_(kMaxBuffers) {}
+
+  // Allows for 'numBuffers' buffers instead of kMaxBuffers. Invalidates the
+  // result of getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers, nullptr);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -58,7 +82,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -89,11 +113,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -215,7 +239,8 @@ static void releaseArrowSchema(ArrowSchema* arrowSchema) {
 // Returns the Arrow C data interface format type for a given Velox type.
 const char* exportArrowFormatStr(
     const TypePtr& type,
-    std::string& formatBuffer) {
+    std::string& formatBuffer,
+    const ArrowOptions& options) {
   if (type->isDecimal()) {
     // Decimal types encode the precision, scale values.
     const auto& [precision, scale] = getDecimalPrecisionScale(*type);
@@ -242,12 +267,12 @@ const char* exportArrowFormatStr(
       return "f"; // float32
     case TypeKind::DOUBLE:
       return "g"; // float64
-    // We always map VARCHAR and VARBINARY to the "small" version (lower case
-    // format string), which uses 32 bit offsets.
+    // We map VARCHAR and VARBINARY to the "small" version (lower case format
+    // string), which uses 32 bit offsets, unless string views are requested.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
     case TypeKind::UNKNOWN:
       return "n"; // NullType
 
@@ -472,6 +497,69 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Imports Arrow Utf8View and BinaryView. The views are translated to
+// StringViews and the data buffers are wrapped without copying. The buffers
+// are the nulls, the views, the data buffers and the sizes of the data
+// buffers.
+VectorPtr createStringFlatVectorFromViews(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto length = arrowArray.length;
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* views =
+      static_cast<const ArrowStringView*>(arrowArray.buffers[1]);
+  const auto* dataBufferSizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto rawStringViews = stringViews->asMutable<StringView>();
+  std::vector<bool> usedDataBuffers(numDataBuffers);
+
+  for (size_t i = 0; i < length; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawStringViews[i] = StringView();
+      continue;
+    }
+    const auto& view = views[i];
+    if (StringView::isInline(view.size)) {
+      rawStringViews[i] = StringView(view.inlined(), view.size);
+      continue;
+    }
+    VELOX_USER_CHECK_LT(view.bufferIndex, numDataBuffers);
+    const auto* data =
+        static_cast<const char*>(arrowArray.buffers[2 + view.bufferIndex]);
+    rawStringViews[i] = StringView(data + view.offset, view.size);
+    usedDataBuffers[view.bufferIndex] = true;
+  }
+
+  std::vector<BufferPtr> stringViewBuffers;
+  for (int64_t i = 0; i < numDataBuffers; ++i) {
+    if (usedDataBuffers[i]) {
+      stringViewBuffers.emplace_back(
+          wrapInBufferView(arrowArray.buffers[2 + i], dataBufferSizes[i]));
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b) the
 // validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -582,12 +670,114 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Exports strings as Arrow Utf8View or BinaryView. The string buffers of
+// 'vec' become the data buffers of the views, so that only the views are
+// rewritten. Values that are not in the string buffers, e.g. of a constant
+// wrapped by exportConstantValue(), are copied to one more data buffer. The
+// sizes of the data buffers go in the last buffer.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+  const int32_t numStringBuffers = stringBuffers.size();
+
+  // Indices of 'stringBuffers' sorted by address to find the buffer of a
+  // value.
+  std::vector<int32_t> sortedBuffers(numStringBuffers);
+  std::iota(sortedBuffers.begin(), sortedBuffers.end(), 0);
+  std::sort(
+      sortedBuffers.begin(), sortedBuffers.end(), [&](int32_t a, int32_t b) {
+        return stringBuffers[a]->as<char>() < stringBuffers[b]->as<char>();
+      });
+  auto findBuffer = [&](const StringView& value) -> int32_t {
+    auto it = std::upper_bound(
+        sortedBuffers.begin(),
+        sortedBuffers.end(),
+        value.data(),
+        [&](const char* data, int32_t index) {
+          return data < stringBuffers[index]->as<char>();
+        });
+    if (it == sortedBuffers.begin()) {
+      return -1;
+    }
+    const auto& buffer = stringBuffers[*(it - 1)];
+    if (value.data() + value.size() > buffer->as<char>() + buffer->size() ||
+        buffer->size() > std::numeric_limits<int32_t>::max()) {
+      return -1;
+    }
+    return *(it - 1);
+  };
+
+  auto views = AlignedBuffer::allocate<ArrowStringView>(out.length, pool);
+  auto* rawViews = views->asMutable<ArrowStringView>();
+  std::vector<std::pair<vector_size_t, StringView>> copied;
+  size_t copiedSize = 0;
+  vector_size_t index = 0;
+  rows.apply([&](vector_size_t i) {
+    auto& view = rawViews[index++];
+    memset(&view, 0, sizeof(ArrowStringView));
+    if (vec.isNullAt(i)) {
+      return;
+    }
+    const auto value = vec.valueAtFast(i);
+    view.size = value.size();
+    if (value.isInline()) {
+      memcpy(view.prefix, value.data(), value.size());
+      return;
+    }
+    memcpy(view.prefix, value.data(), sizeof(view.prefix));
+    const auto bufferIndex = findBuffer(value);
+    if (bufferIndex < 0) {
+      copied.emplace_back(index - 1, value);
+      copiedSize += value.size();
+      return;
+    }
+    view.bufferIndex = bufferIndex;
+    view.offset = value.data() - stringBuffers[bufferIndex]->as<char>();
+  });
+
+  BufferPtr copiedBuffer;
+  if (!copied.empty()) {
+    VELOX_CHECK_LE(copiedSize, std::numeric_limits<int32_t>::max());
+    copiedBuffer = AlignedBuffer::allocate<char>(copiedSize, pool);
+    auto* rawCopied = copiedBuffer->asMutable<char>();
+    int32_t offset = 0;
+    for (const auto& [row, value] : copied) {
+      memcpy(rawCopied + offset, value.data(), value.size());
+      rawViews[row].bufferIndex = numStringBuffers;
+      rawViews[row].offset = offset;
+      offset += value.size();
+    }
+  }
+
+  const int32_t numDataBuffers = numStringBuffers + (copiedBuffer ? 1 : 0);
+  out.n_buffers = 3 + numDataBuffers;
+  holder.resizeBuffers(out.n_buffers);
+  out.buffers = holder.getArrowBuffers();
+  holder.setBuffer(1, views);
+  auto sizes = AlignedBuffer::allocate<int64_t>(numDataBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (int32_t i = 0; i < numStringBuffers; ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+    rawSizes[i] = stringBuffers[i]->size();
+  }
+  if (copiedBuffer) {
+    holder.setBuffer(2 + numStringBuffers, copiedBuffer);
+    rawSizes[numStringBuffers] = copiedSize;
+  }
+  holder.setBuffer(2 + numDataBuffers, sizes);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   out.n_children = 0;
   out.children = nullptr;
   switch (vec.typeKind()) {
@@ -605,8 +795,19 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      options.exportToStringView
+          ? exportStringViews(
+                *vec.asUnchecked<FlatVector<StringView>>(),
+                rows,
+                out,
+                pool,
+                holder)
+          : exportStrings(
+                *vec.asUnchecked<FlatVector<StringView>>(),
+                rows,
+                out,
+                pool,
+                holder);
       break;
     default:
       VELOX_NYI(
@@ -743,7 +944,8 @@ void flattenAndExport(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   using NativeType = typename velox::TypeTraits<kind>::NativeType;
   SelectivityVector allRows(vec.size());
   DecodedVector decoded(vec, allRows);
@@ -759,21 +961,31 @@ void flattenAndExport(
       }
     });
     exportValidityBitmap(*flatVector, rows, out, pool, holder);
-    exportFlat(*flatVector, rows, out, pool, holder);
+    exportFlat(*flatVector, rows, out, pool, holder, options);
   } else {
     allRows.applyToSelected([&](vector_size_t row) {
       flatVector->set(row, decoded.valueAt<NativeType>(row));
     });
-    exportFlat(*flatVector, rows, out, pool, holder);
+    exportFlat(*flatVector, rows, out, pool, holder, options);
   }
 }
 
+// Returns the options for exporting the values of a dictionary or constant
+// vector. Only the layout of strings carries over, the values keep their own
+// encoding.
+ArrowOptions valuesOptions(const ArrowOptions& options) {
+  ArrowOptions result;
+  result.exportToStringView = options.exportToStringView;
+  return result;
+}
+
 void exportDictionary(
     const BaseVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   out.n_buffers = 2;
   out.n_children = 0;
   if (rows.changed()) {
@@ -786,7 +998,11 @@ void exportDictionary(
   auto& values = *vec.valueVector()->loadedVector();
   out.dictionary = holder.allocateDictionary();
   exportToArrowImpl(
-      values, Selection(values.size()), *out.dictionary, pool, ArrowOptions());
+      values,
+      Selection(values.size()),
+      *out.dictionary,
+      pool,
+      valuesOptions(options));
 }
 
 void exportFlattenedVector(
@@ -794,19 +1010,21 @@ void exportFlattenedVector(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   VELOX_CHECK(
       vec.valueVector() == nullptr || vec.wrappedVector()->isFlatEncoding(),
       "An unsupported nested encoding was found.");
   VELOX_CHECK(vec.isScalar(), "Flattening is only supported for scalar types.");
   VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
-      flattenAndExport, vec.typeKind(), vec, rows, out, pool, holder);
+      flattenAndExport, vec.typeKind(), vec, rows, out, pool, holder, options);
 }
 
 void exportConstantValue(
     const BaseVector& vec,
     ArrowArray& out,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
   VectorPtr valuesVector;
   Selection selection(1);
 
@@ -834,7 +1052,8 @@ void exportConstantValue(
         wrapInBufferViewAsViewer(vec.valuesAsVoid(), bufferSize),
         vec.mayHaveNulls() ? 1 : 0);
   }
-  exportToArrowImpl(*valuesVector, selection, out, pool, ArrowOptions());
+  exportToArrowImpl(
+      *valuesVector, selection, out, pool, valuesOptions(options));
 }
 
 // Velox constant vectors are exported as Arrow REE containing a single run
@@ -844,7 +1063,8 @@ void exportConstant(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   // As per Arrow spec, REE has zero buffers and two children, `run_ends` and
   // `values`.
   out.n_buffers = 0;
@@ -853,7 +1073,7 @@ void exportConstant(
   out.n_children = 2;
   holder.resizeChildren(2);
   out.children = holder.getChildrenArrays();
-  exportConstantValue(vec, *holder.allocateChild(1), pool);
+  exportConstantValue(vec, *holder.allocateChild(1), pool, options);
 
   // Create the run ends child.
   auto* runEnds = holder.allocateChild(0);
@@ -892,7 +1112,7 @@ void exportToArrowImpl(
 
   switch (vec.encoding()) {
     case VectorEncoding::Simple::FLAT:
-      exportFlat(vec, rows, out, pool, *holder);
+      exportFlat(vec, rows, out, pool, *holder, options);
       break;
     case VectorEncoding::Simple::ROW:
       exportRows(
@@ -908,13 +1128,13 @@ void exportToArrowImpl(
       break;
     case VectorEncoding::Simple::DICTIONARY:
       options.flattenDictionary
-          ? exportFlattenedVector(vec, rows, out, pool, *holder)
-          : exportDictionary(vec, rows, out, pool, *holder);
+          ? exportFlattenedVector(vec, rows, out, pool, *holder, options)
+          : exportDictionary(vec, rows, out, pool, *holder, options);
       break;
     case VectorEncoding::Simple::CONSTANT:
       options.flattenConstant
-          ? exportFlattenedVector(vec, rows, out, pool, *holder)
-          : exportConstant(vec, rows, out, pool, *holder);
+          ? exportFlattenedVector(vec, rows, out, pool, *holder, options)
+          : exportConstant(vec, rows, out, pool, *holder, options);
       break;
     default:
       VELOX_NYI("{} cannot be exported to Arrow yet.", vec.encoding());
@@ -956,6 +1176,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // Utf8View and BinaryView.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       // Mapping it to ttn for now.
       if (format[1] == 't' && format[2] == 'n') {
@@ -1077,12 +1307,13 @@ void exportToArrow(
       // Dictionary data is flattened. Set the underlying data types.
       arrowSchema.dictionary = nullptr;
       arrowSchema.format =
-          exportArrowFormatStr(type, bridgeHolder->formatBuffer);
+          exportArrowFormatStr(type, bridgeHolder->formatBuffer, options);
     } else {
       arrowSchema.format = "i";
       bridgeHolder->dictionary = std::make_unique<ArrowSchema>();
       arrowSchema.dictionary = bridgeHolder->dictionary.get();
-      exportToArrow(vec->valueVector(), *arrowSchema.dictionary);
+      exportToArrow(
+          vec->valueVector(), *arrowSchema.dictionary, valuesOptions(options));
     }
   } else if (
       vec->encoding() == VectorEncoding::Simple::CONSTANT &&
@@ -1101,7 +1332,7 @@ void exportToArrow(
       exportToArrow(valueVector, *valuesChild, options);
     } else {
       valuesChild->format =
-          exportArrowFormatStr(type, bridgeHolder->formatBuffer);
+          exportArrowFormatStr(type, bridgeHolder->formatBuffer, options);
     }
     valuesChild->name = "values";
 
@@ -1109,7 +1340,8 @@ void exportToArrow(
         0, newArrowSchema("i", "run_ends"), arrowSchema);
     bridgeHolder->setChildAtIndex(1, std::move(valuesChild), arrowSchema);
   } else {
-    arrowSchema.format = exportArrowFormatStr(type, bridgeHolder->formatBuffer);
+    arrowSchema.format =
+        exportArrowFormatStr(type, bridgeHolder->formatBuffer, options);
     arrowSchema.dictionary = nullptr;
 
     if (type->kind() == TypeKind::MAP) {
@@ -1421,6 +1653,10 @@ bool isREE(const ArrowSchema& arrowSchema) {
   return arrowSchema.format[0] == '+' && arrowSchema.format[1] == 'r';
 }
 
+bool isStringView(const ArrowSchema& arrowSchema) {
+  return arrowSchema.format[0] == 'v';
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1472,6 +1708,12 @@ VectorPtr importFromArrowImpl(
     return createVectorFromReeArray(pool, arrowSchema, arrowArray, isViewer);
   }
 
+  // String views (Utf8View and BinaryView).
+  if (isStringView(arrowSchema)) {
+    return createStringFlatVectorFromViews(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  }
+
   // String data types (VARCHAR and VARBINARY).
   if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
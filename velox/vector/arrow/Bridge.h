@@ -28,6 +28,10 @@ struct ArrowSchema;
 struct ArrowOptions {
   bool flattenDictionary{false};
   bool flattenConstant{false};
+  // Export VARCHAR and VARBINARY as Arrow Utf8View and BinaryView ("vu" and
+  // "vz") instead of Utf8 and Binary. The string buffers of the vector are
+  // exported as the data buffers of the views without copying.
+  bool exportToStringView{false};
 };
 
 namespace facebook::velox {
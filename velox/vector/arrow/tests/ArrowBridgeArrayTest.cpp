@@ -529,6 +529,79 @@ TEST_F(ArrowBridgeArrayExportTest, flatString) {
   testFlatVector<std::string>({});
 }
 
+TEST_F(ArrowBridgeArrayExportTest, flatStringView) {
+  const std::vector<std::optional<std::string>> inputData = {
+      "inlined",
+      std::nullopt,
+      "a string that is too long to be inlined",
+      "",
+      "another string that is not inlined",
+  };
+  auto vector = vectorMaker_.flatVectorNullable(inputData);
+  const ArrowOptions options{.exportToStringView = true};
+  ArrowArray arrowArray;
+  velox::exportToArrow(vector, arrowArray, pool_.get(), options);
+
+  // The string buffers are exported without copying, followed by their
+  // sizes.
+  const auto& stringBuffers = vector->stringBuffers();
+  ASSERT_EQ(
+      3 + stringBuffers.size(), static_cast<size_t>(arrowArray.n_buffers));
+  const auto* sizes = static_cast<const int64_t*>(
+      arrowArray.buffers[arrowArray.n_buffers - 1]);
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    EXPECT_EQ(stringBuffers[i]->as<void>(), arrowArray.buffers[2 + i]);
+    EXPECT_EQ(stringBuffers[i]->size(), static_cast<size_t>(sizes[i]));
+  }
+
+  // Each view is the size followed by the inlined value or by the prefix,
+  // buffer index and offset.
+  EXPECT_EQ(1, arrowArray.null_count);
+  const auto* views = static_cast<const int32_t*>(arrowArray.buffers[1]);
+  for (auto i = 0; i < inputData.size(); ++i) {
+    if (!inputData[i].has_value()) {
+      continue;
+    }
+    const auto* view = views + 4 * i;
+    const size_t size = view[0];
+    ASSERT_EQ(inputData[i]->size(), size);
+    const char* data = reinterpret_cast<const char*>(view + 1);
+    if (size > StringView::kInlineSize) {
+      data = static_cast<const char*>(arrowArray.buffers[2 + view[2]]) +
+          view[3];
+    }
+    EXPECT_EQ(*inputData[i], std::string(data, size));
+  }
+
+  ArrowSchema arrowSchema;
+  velox::exportToArrow(vector, arrowSchema, options);
+  EXPECT_STREQ("vu", arrowSchema.format);
+  auto imported =
+      importFromArrowAsViewer(arrowSchema, arrowArray, pool_.get());
+  assertEqualVectors(vector, imported);
+  imported.reset();
+
+  arrowSchema.release(&arrowSchema);
+  arrowArray.release(&arrowArray);
+  EXPECT_EQ(nullptr, arrowArray.release);
+  EXPECT_EQ(nullptr, arrowArray.private_data);
+
+  // A constant value is not in the string buffers of a vector and is copied.
+  auto constant = BaseVector::createConstant(
+      VARCHAR(), "a constant that is not inlined", 100, pool_.get());
+  velox::exportToArrow(constant, arrowArray, pool_.get(), options);
+  velox::exportToArrow(constant, arrowSchema, options);
+  ASSERT_EQ(2, arrowArray.n_children);
+  EXPECT_EQ(4, arrowArray.children[1]->n_buffers);
+  EXPECT_STREQ("vu", arrowSchema.children[1]->format);
+  imported = importFromArrowAsViewer(arrowSchema, arrowArray, pool_.get());
+  assertEqualVectors(constant, imported);
+  imported.reset();
+
+  arrowSchema.release(&arrowSchema);
+  arrowArray.release(&arrowArray);
+}
+
 TEST_F(ArrowBridgeArrayExportTest, rowVector) {
   std::vector<std::optional<int64_t>> col1 = {1, 2, 3, 4};
   std::vector<std::optional<double>> col2 = {99.9, 88.8, 77.7, std::nullopt};
@@ -1499,6 +1572,56 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     EXPECT_EQ(decoded.valueAt<int32_t>(61), 50);
   }
 
+  void testImportStringView() {
+    const std::vector<std::optional<std::string>> inputValues = {
+        "inlined",
+        std::nullopt,
+        "a string that is too long to be inlined",
+        "",
+        "another string that is not inlined",
+    };
+
+    // The values that are not inlined are in two data buffers.
+    const std::string data0 = "padding" + *inputValues[2];
+    const std::string data1 = *inputValues[4];
+    std::vector<int32_t> views(4 * inputValues.size(), 0);
+    auto setView = [&](int32_t row, int32_t bufferIndex, int32_t offset) {
+      const auto& value = *inputValues[row];
+      views[4 * row] = value.size();
+      if (value.size() <= StringView::kInlineSize) {
+        memcpy(&views[4 * row + 1], value.data(), value.size());
+        return;
+      }
+      memcpy(&views[4 * row + 1], value.data(), 4);
+      views[4 * row + 2] = bufferIndex;
+      views[4 * row + 3] = offset;
+    };
+    setView(0, 0, 0);
+    setView(2, 0, 7);
+    setView(3, 0, 0);
+    setView(4, 1, 0);
+
+    uint64_t nulls = bits::kNotNull64;
+    bits::setNull(&nulls, 1);
+    const int64_t sizes[] = {
+        static_cast<int64_t>(data0.size()), static_cast<int64_t>(data1.size())};
+    const void* buffers[] = {
+        &nulls, views.data(), data0.data(), data1.data(), sizes};
+
+    for (const auto* format : {"vu", "vz"}) {
+      auto arrowSchema = makeArrowSchema(format);
+      auto arrowArray = makeArrowArray(buffers, 5, inputValues.size(), 1);
+      auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+      assertVectorContent(inputValues, output, 1);
+
+      // The data buffers are wrapped without copying.
+      auto* flat = output->asFlatVector<StringView>();
+      EXPECT_EQ(data0.data() + 7, flat->valueAt(2).data());
+      EXPECT_EQ(data1.data(), flat->valueAt(4).data());
+      EXPECT_EQ(2, flat->stringBuffers().size());
+    }
+  }
+
   void testImportFailures() {
     ArrowSchema arrowSchema;
     ArrowArray arrowArray;
@@ -1587,6 +1710,10 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, row) {
   testImportRow();
 }
@@ -1638,6 +1765,10 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, row) {
   testImportRow();
 }
@@ -199,6 +199,25 @@ TEST_F(ArrowBridgeSchemaExportTest, scalar) {
   testScalarType(UNKNOWN(), "n");
 }
 
+TEST_F(ArrowBridgeSchemaExportTest, stringView) {
+  const ArrowOptions options{.exportToStringView = true};
+  for (const auto& [type, format] :
+       {std::pair{VARCHAR(), "vu"}, std::pair{VARBINARY(), "vz"}}) {
+    ArrowSchema arrowSchema;
+    velox::exportToArrow(
+        BaseVector::create(type, 0, pool_.get()), arrowSchema, options);
+    verifyScalarType(arrowSchema, format);
+    arrowSchema.release(&arrowSchema);
+
+    // Strings in nested types are exported as views too.
+    velox::exportToArrow(
+        BaseVector::create(ARRAY(type), 0, pool_.get()), arrowSchema, options);
+    EXPECT_STREQ("+l", arrowSchema.format);
+    EXPECT_STREQ(format, arrowSchema.children[0]->format);
+    arrowSchema.release(&arrowSchema);
+  }
+}
+
 TEST_F(ArrowBridgeSchemaExportTest, nested) {
   // Array.
   testNestedType(ARRAY(INTEGER()));
@@ -358,6 +377,8 @@ TEST_F(ArrowBridgeSchemaImportTest, scalar) {
   EXPECT_EQ(*VARCHAR(), *testSchemaImport("U"));
   EXPECT_EQ(*VARBINARY(), *testSchemaImport("z"));
   EXPECT_EQ(*VARBINARY(), *testSchemaImport("Z"));
+  EXPECT_EQ(*VARCHAR(), *testSchemaImport("vu"));
+  EXPECT_EQ(*VARBINARY(), *testSchemaImport("vz"));
 
   // Temporal.
   EXPECT_EQ(*TIMESTAMP(), *testSchemaImport("ttn"));
@@ -279,6 +279,53 @@ BENCHMARK_PARAM(BM_countSelected, 1000000);
 BENCHMARK_PARAM(BM_countSelected, 10000000);
 BENCHMARK_DRAW_LINE();
 
+// Sets every other row of 'vector' and deselects the first 3 rows so that
+// neither the all selected shortcut nor whole word bounds apply.
+void setHalfSelected(SelectivityVector& vector) {
+  for (size_t i = 0; i < vector.size(); ++i) {
+    vector.setValid(i, i % 2 == 0 && i >= 3);
+  }
+  vector.updateBounds();
+}
+
+void BM_countSelectedHalf(uint32_t iterations, size_t numEntries) {
+  folly::BenchmarkSuspender suspender;
+  SelectivityVector vector(numEntries);
+  setHalfSelected(vector);
+  suspender.dismiss();
+
+  for (uint32_t i = 0; i < iterations; ++i) {
+    folly::doNotOptimizeAway(vector.countSelected());
+  }
+
+  suspender.rehire();
+}
+
+BENCHMARK_PARAM(BM_countSelectedHalf, 1000);
+BENCHMARK_PARAM(BM_countSelectedHalf, 1000000);
+BENCHMARK_PARAM(BM_countSelectedHalf, 10000000);
+BENCHMARK_DRAW_LINE();
+
+void BM_deselectHalf(uint32_t iterations, size_t numEntries) {
+  folly::BenchmarkSuspender suspender;
+  SelectivityVector vectorA(numEntries);
+  SelectivityVector vectorB(numEntries);
+  setHalfSelected(vectorA);
+  vectorB.clearAll();
+  suspender.dismiss();
+
+  for (uint32_t i = 0; i < iterations; ++i) {
+    vectorA.deselect(vectorB);
+  }
+
+  suspender.rehire();
+}
+
+BENCHMARK_PARAM(BM_deselectHalf, 1000);
+BENCHMARK_PARAM(BM_deselectHalf, 1000000);
+BENCHMARK_PARAM(BM_deselectHalf, 10000000);
+BENCHMARK_DRAW_LINE();
+
 // operatorEquals test
 
 void BM_operatorEquals(uint32_t iterations, size_t numEntries) {
@@ -151,4 +151,74 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  const auto rowType = ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())});
+  auto vector = vectorPool.get(rowType, 1'000);
+  ASSERT_EQ(1'000, vector->size());
+  auto* rawVector = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+
+  // Recycled row vector has children of its size.
+  vector = vectorPool.get(ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())}), 500);
+  ASSERT_EQ(rawVector, vector.get());
+  ASSERT_EQ(500, vector->size());
+  for (const auto& child : vector->as<RowVector>()->children()) {
+    ASSERT_EQ(500, child->size());
+  }
+
+  // A row type with different names is a different type.
+  ASSERT_TRUE(vectorPool.release(vector));
+  vector = vectorPool.get(ROW({"x", "y"}, {BIGINT(), ARRAY(VARCHAR())}), 500);
+  ASSERT_NE(rawVector, vector.get());
+
+  auto arrayVector = makeArrayVector<int64_t>({{1, 2}, {3}});
+  auto* rawArrayVector = arrayVector.get();
+  ASSERT_TRUE(vectorPool.release(arrayVector));
+  arrayVector = vectorPool.get(ARRAY(BIGINT()), 10);
+  ASSERT_EQ(rawArrayVector, arrayVector.get());
+  ASSERT_EQ(10, arrayVector->size());
+  ASSERT_EQ(0, arrayVector->as<ArrayVector>()->sizeAt(0));
+
+  // Dictionary-encoded vectors are not recycled.
+  auto dictionary = wrapInDictionary(
+      makeIndices(2, [](auto row) { return row; }),
+      makeArrayVector<int64_t>({{1}, {2}}));
+  ASSERT_FALSE(vectorPool.release(dictionary));
+
+  // An array vector with shared elements is not recycled.
+  auto elements = makeFlatVector<int64_t>({1, 2, 3});
+  auto sharedElements = makeArrayVector({0, 1}, elements);
+  ASSERT_FALSE(vectorPool.release(sharedElements));
+}
+
+TEST_F(VectorPoolTest, stats) {
+  VectorPool vectorPool(pool());
+
+  auto vector = vectorPool.get(BIGINT(), 1'000);
+  ASSERT_TRUE(vectorPool.release(vector));
+  vector = vectorPool.get(BIGINT(), 1'000);
+  auto other = vectorPool.get(BIGINT(), 1'000);
+
+  // Unsupported types count as misses.
+  auto decimal = vectorPool.get(DECIMAL(10, 2), 100);
+
+  ASSERT_EQ(1, vectorPool.stats().numHits);
+  ASSERT_EQ(3, vectorPool.stats().numMisses);
+  ASSERT_EQ(1, vectorPool.stats().numReleased);
+}
+
+TEST_F(VectorPoolTest, otherPool) {
+  VectorPool vectorPool(pool());
+
+  // A vector from another pool is not recycled since it must not outlive its
+  // pool.
+  auto otherPool = rootPool_->addLeafChild("other");
+  auto vector = BaseVector::create(BIGINT(), 1'000, otherPool.get());
+  ASSERT_FALSE(vectorPool.release(vector));
+  ASSERT_NE(vector, nullptr);
+  ASSERT_EQ(0, vectorPool.stats().numReleased);
+}
 } // namespace facebook::velox::test
@@ -1233,6 +1233,57 @@ TEST_F(VectorTest, copyToAllNullsFlatVector) {
   }
 }
 
+TEST_F(VectorTest, copyAllRowsSharesBuffers) {
+  auto source = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; }, nullEvery(7));
+  auto expected = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; }, nullEvery(7));
+
+  auto target = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), source->size(), pool());
+  target->copy(source.get(), 0, 0, source->size());
+  ASSERT_EQ(target->values(), source->values());
+  ASSERT_EQ(target->nulls(), source->nulls());
+  assertEqualVectors(expected, target);
+
+  // Writes to either vector copy the shared buffers first.
+  target->set(1, -1);
+  target->setNull(2, true);
+  ASSERT_NE(target->values(), source->values());
+  ASSERT_NE(target->nulls(), source->nulls());
+  assertEqualVectors(expected, source);
+  ASSERT_EQ(target->valueAt(1), -1);
+  ASSERT_TRUE(target->isNullAt(2));
+
+  target = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), source->size(), pool());
+  target->copy(source.get(), SelectivityVector(source->size()), nullptr);
+  ASSERT_EQ(target->values(), source->values());
+  source->set(3, -1);
+  ASSERT_NE(target->values(), source->values());
+  ASSERT_EQ(target->valueAt(3), 3);
+
+  // A copy of part of the rows or into a larger vector does not share.
+  target = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), source->size(), pool());
+  target->copy(source.get(), 0, 0, source->size() - 1);
+  ASSERT_NE(target->values(), source->values());
+  target->resize(source->size() + 1);
+  target->copy(source.get(), 0, 0, source->size());
+  ASSERT_NE(target->values(), source->values());
+
+  // Resizing a vector with shared buffers does not change the other vector.
+  target = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), source->size(), pool());
+  target->copy(source.get(), 0, 0, source->size());
+  const auto sourceBytes = source->values()->size();
+  const auto sourceNullBytes = source->nulls()->size();
+  target->resize(10);
+  ASSERT_EQ(source->values()->size(), sourceBytes);
+  ASSERT_EQ(source->nulls()->size(), sourceNullBytes);
+  ASSERT_EQ(source->size(), 1'000);
+}
+
 template <TypeKind kind>
 static VectorPtr createAllNullsFlatVector(
     vector_size_t size,